@@ -167,9 +167,21 @@ class PYBIND11_EXPORT AABBTree
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Refit the node volumes to a new list of AABBs without changing the topology
+    inline void refit(const AABB* aabbs, unsigned int N);
+
+    //! Get the sum of the surface areas of all nodes
+    inline Scalar getSurfaceArea() const;
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
+    //! Get the number of particles the tree was built with
+    inline unsigned int getNumParticles() const
+        {
+        return (unsigned int)m_mapping.size();
+        }
+
     //! Get the number of nodes
     inline unsigned int getNumNodes() const
         {
@@ -354,6 +366,51 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle, indexed by particle
+    \param N Number of AABBs in the list (must match the number the tree was built with)
+
+    Recompute the AABB of every leaf node from the AABBs of its particles, then the AABBs of the
+   internal nodes from their children. Unlike update(), refit() also shrinks the nodes. The topology
+   is unchanged, so the query efficiency degrades as the particles move away from the positions the
+   tree was built with. Compare getSurfaceArea() to its value after buildTree() to decide when to
+   rebuild.
+*/
+inline void AABBTree::refit(const AABB* aabbs, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    // children are allocated after their parents, so a reverse pass visits children first
+    for (unsigned int i = m_num_nodes; i > 0; i--)
+        {
+        AABBNode& node = m_nodes[i - 1];
+        if (node.left == INVALID_NODE)
+            {
+            node.aabb = aabbs[node.particles[0]];
+            for (unsigned int j = 1; j < node.num_particles; j++)
+                node.aabb = merge(node.aabb, aabbs[node.particles[j]]);
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
+/*! \returns The sum of the surface areas of all nodes
+
+    The expected cost of a query is proportional to the surface areas of the nodes it visits.
+*/
+inline Scalar AABBTree::getSurfaceArea() const
+    {
+    Scalar area = 0;
+    for (unsigned int i = 0; i < m_num_nodes; i++)
+        {
+        vec3<Scalar> l = m_nodes[i].aabb.getUpper() - m_nodes[i].aabb.getLower();
+        area += Scalar(2.0) * (l.x * l.y + l.y * l.z + l.z * l.x);
+        }
+    return area;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -0,0 +1,447 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_ADIOS2
+
+#include "ADIOS2Writer.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+namespace py = pybind11;
+
+/*! \file ADIOS2Writer.cc
+    \brief Defines the ADIOS2Writer class
+*/
+
+/*! Constructs the ADIOS2Writer. The engine is not opened until analyze() is called.
+
+    \param sysdef SystemDefinition containing the ParticleData to write
+    \param fname File or stream name to write to
+    \param group Group of particles to include in the output
+    \param engine ADIOS2 engine type (e.g. "BP5", "SST", "HDF5")
+    \param parameters Engine parameters (string keys and values)
+*/
+ADIOS2Writer::ADIOS2Writer(std::shared_ptr<SystemDefinition> sysdef,
+                           const std::string& fname,
+                           std::shared_ptr<ParticleGroup> group,
+                           const std::string& engine,
+                           pybind11::dict parameters)
+    : Analyzer(sysdef), m_fname(fname), m_engine_type(engine), m_group(group),
+      m_write_attribute(false), m_write_property(false), m_write_momentum(false), m_nsteps(0),
+      m_n_global(0), m_offset(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ADIOS2Writer: " << fname << " " << engine
+                                << endl;
+
+    for (auto item : parameters)
+        m_parameters[py::cast<std::string>(item.first)] = py::cast<std::string>(item.second);
+
+    m_log_writer = pybind11::none();
+    }
+
+ADIOS2Writer::~ADIOS2Writer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ADIOS2Writer" << endl;
+
+    if (m_engine)
+        {
+        m_exec_conf->msg->notice(5) << "ADIOS2: close " << m_fname << endl;
+        m_engine.Close();
+        }
+    }
+
+pybind11::dict ADIOS2Writer::getParameters()
+    {
+    pybind11::dict result;
+    for (const auto& item : m_parameters)
+        result[pybind11::str(item.first)] = item.second;
+    return result;
+    }
+
+/*! Every rank opens the engine collectively.
+ */
+void ADIOS2Writer::initIO()
+    {
+    m_exec_conf->msg->notice(3) << "ADIOS2: open " << m_fname << " with the " << m_engine_type
+                                << " engine" << endl;
+
+#ifdef ENABLE_MPI
+    m_adios = std::unique_ptr<adios2::ADIOS>(
+        new adios2::ADIOS(m_exec_conf->getMPICommunicator()));
+#else
+    m_adios = std::unique_ptr<adios2::ADIOS>(new adios2::ADIOS());
+#endif
+
+    m_io = m_adios->DeclareIO("hoomd");
+    m_io.SetEngine(m_engine_type);
+    m_io.SetParameters(m_parameters);
+    m_engine = m_io.Open(m_fname, adios2::Mode::Write);
+    }
+
+/*! Set m_tags to the tags of the group members owned by this rank in ascending order and compute
+    the offset of this rank's block in the global arrays.
+*/
+void ADIOS2Writer::populateTags()
+    {
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    m_tags.resize(m_group->getNumMembers());
+    for (unsigned int group_idx = 0; group_idx < m_group->getNumMembers(); group_idx++)
+        m_tags[group_idx] = h_tag.data[m_group->getMemberIndex(group_idx)];
+    std::sort(m_tags.begin(), m_tags.end());
+
+    m_n_global = m_group->getNumMembersGlobal();
+    m_offset = 0;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        uint64_t n_local = m_tags.size();
+        MPI_Exscan(&n_local,
+                   &m_offset,
+                   1,
+                   MPI_UINT64_T,
+                   MPI_SUM,
+                   m_exec_conf->getMPICommunicator());
+
+        // MPI_Exscan leaves the result undefined on rank 0
+        if (m_exec_conf->getRank() == 0)
+            m_offset = 0;
+        }
+#endif
+    }
+
+/*! \param name Variable name
+    \param data Values of the local group members, M per particle
+    \param M Number of values per particle
+
+    The variable is a global array of shape {N_global} (or {N_global, M}). This rank puts its
+    block at m_offset.
+*/
+template<class T>
+void ADIOS2Writer::putParticleArray(const std::string& name, const std::vector<T>& data, size_t M)
+    {
+    adios2::Dims shape {m_n_global};
+    adios2::Dims start {m_offset};
+    adios2::Dims count {m_tags.size()};
+    if (M > 1)
+        {
+        shape.push_back(M);
+        start.push_back(0);
+        count.push_back(M);
+        }
+
+    adios2::Variable<T> var = m_io.InquireVariable<T>(name);
+    if (!var)
+        {
+        var = m_io.DefineVariable<T>(name, shape, start, count);
+        }
+    else
+        {
+        var.SetShape(shape);
+        var.SetSelection({start, count});
+        }
+
+    if (m_tags.size() > 0)
+        {
+        m_exec_conf->msg->notice(10) << "ADIOS2: writing " << name << endl;
+        m_engine.Put(var, data.data(), adios2::Mode::Sync);
+        }
+    }
+
+/*! \param snapshot Local particle data snapshot
+    \param map Map from tags to snapshot indices
+
+    Writes typeid, mass, charge, diameter, body, and moment_inertia in particles/.
+*/
+void ADIOS2Writer::writeAttributes(const SnapshotParticleData<float>& snapshot,
+                                   const std::map<unsigned int, unsigned int>& map)
+    {
+    size_t N = m_tags.size();
+    std::vector<uint32_t> type(N);
+    std::vector<float> mass(N);
+    std::vector<float> charge(N);
+    std::vector<float> diameter(N);
+    std::vector<int32_t> body(N);
+    std::vector<float> inertia(N * 3);
+
+    for (size_t group_idx = 0; group_idx < N; group_idx++)
+        {
+        auto it = map.find(m_tags[group_idx]);
+        assert(it != map.end());
+        unsigned int i = it->second;
+
+        type[group_idx] = uint32_t(snapshot.type[i]);
+        mass[group_idx] = snapshot.mass[i];
+        charge[group_idx] = snapshot.charge[i];
+        diameter[group_idx] = snapshot.diameter[i];
+        body[group_idx] = int32_t(snapshot.body[i]);
+        inertia[group_idx * 3 + 0] = snapshot.inertia[i].x;
+        inertia[group_idx * 3 + 1] = snapshot.inertia[i].y;
+        inertia[group_idx * 3 + 2] = snapshot.inertia[i].z;
+        }
+
+    putParticleArray("particles/typeid", type, 1);
+    putParticleArray("particles/mass", mass, 1);
+    putParticleArray("particles/charge", charge, 1);
+    putParticleArray("particles/diameter", diameter, 1);
+    putParticleArray("particles/body", body, 1);
+    putParticleArray("particles/moment_inertia", inertia, 3);
+    }
+
+/*! \param snapshot Local particle data snapshot
+    \param map Map from tags to snapshot indices
+
+    Writes position and orientation in particles/.
+*/
+void ADIOS2Writer::writeProperties(const SnapshotParticleData<float>& snapshot,
+                                   const std::map<unsigned int, unsigned int>& map)
+    {
+    size_t N = m_tags.size();
+    std::vector<float> position(N * 3);
+    std::vector<float> orientation(N * 4);
+
+    for (size_t group_idx = 0; group_idx < N; group_idx++)
+        {
+        auto it = map.find(m_tags[group_idx]);
+        assert(it != map.end());
+        unsigned int i = it->second;
+
+        position[group_idx * 3 + 0] = snapshot.pos[i].x;
+        position[group_idx * 3 + 1] = snapshot.pos[i].y;
+        position[group_idx * 3 + 2] = snapshot.pos[i].z;
+        orientation[group_idx * 4 + 0] = snapshot.orientation[i].s;
+        orientation[group_idx * 4 + 1] = snapshot.orientation[i].v.x;
+        orientation[group_idx * 4 + 2] = snapshot.orientation[i].v.y;
+        orientation[group_idx * 4 + 3] = snapshot.orientation[i].v.z;
+        }
+
+    putParticleArray("particles/position", position, 3);
+    putParticleArray("particles/orientation", orientation, 4);
+    }
+
+/*! \param snapshot Local particle data snapshot
+    \param map Map from tags to snapshot indices
+
+    Writes velocity, angmom, and image in particles/.
+*/
+void ADIOS2Writer::writeMomenta(const SnapshotParticleData<float>& snapshot,
+                                const std::map<unsigned int, unsigned int>& map)
+    {
+    size_t N = m_tags.size();
+    std::vector<float> velocity(N * 3);
+    std::vector<float> angmom(N * 4);
+    std::vector<int32_t> image(N * 3);
+
+    for (size_t group_idx = 0; group_idx < N; group_idx++)
+        {
+        auto it = map.find(m_tags[group_idx]);
+        assert(it != map.end());
+        unsigned int i = it->second;
+
+        velocity[group_idx * 3 + 0] = snapshot.vel[i].x;
+        velocity[group_idx * 3 + 1] = snapshot.vel[i].y;
+        velocity[group_idx * 3 + 2] = snapshot.vel[i].z;
+        angmom[group_idx * 4 + 0] = snapshot.angmom[i].s;
+        angmom[group_idx * 4 + 1] = snapshot.angmom[i].v.x;
+        angmom[group_idx * 4 + 2] = snapshot.angmom[i].v.y;
+        angmom[group_idx * 4 + 3] = snapshot.angmom[i].v.z;
+        image[group_idx * 3 + 0] = snapshot.image[i].x;
+        image[group_idx * 3 + 1] = snapshot.image[i].y;
+        image[group_idx * 3 + 2] = snapshot.image[i].z;
+        }
+
+    putParticleArray("particles/velocity", velocity, 3);
+    putParticleArray("particles/angmom", angmom, 4);
+    putParticleArray("particles/image", image, 3);
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    The first call opens the engine. Each call publishes one step.
+*/
+void ADIOS2Writer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_prof)
+        m_prof->push("ADIOS2");
+
+    bool root = true;
+#ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+#endif
+
+    if (!m_engine)
+        initIO();
+
+    // the snapshot holds only the particles on this rank, nothing is gathered
+    SnapshotParticleData<float> snapshot;
+    std::map<unsigned int, unsigned int> map = m_pdata->takeLocalSnapshot<float>(snapshot);
+    populateTags();
+
+    m_engine.BeginStep();
+
+    if (root)
+        {
+        adios2::Variable<uint64_t> step = m_io.InquireVariable<uint64_t>("configuration/step");
+        if (!step)
+            step = m_io.DefineVariable<uint64_t>("configuration/step");
+        m_engine.Put(step, timestep, adios2::Mode::Sync);
+
+        BoxDim box = m_pdata->getGlobalBox();
+        std::vector<float> box_a {(float)box.getL().x,
+                                  (float)box.getL().y,
+                                  (float)box.getL().z,
+                                  (float)box.getTiltFactorXY(),
+                                  (float)box.getTiltFactorXZ(),
+                                  (float)box.getTiltFactorYZ()};
+        adios2::Variable<float> box_var = m_io.InquireVariable<float>("configuration/box");
+        if (!box_var)
+            box_var = m_io.DefineVariable<float>("configuration/box", {6}, {0}, {6});
+        m_engine.Put(box_var, box_a.data(), adios2::Mode::Sync);
+
+        if (m_nsteps == 0)
+            {
+            adios2::Variable<uint8_t> dimensions
+                = m_io.DefineVariable<uint8_t>("configuration/dimensions");
+            m_engine.Put(dimensions,
+                         (uint8_t)m_sysdef->getNDimensions(),
+                         adios2::Mode::Sync);
+            m_io.DefineAttribute<std::string>("particles/types",
+                                              snapshot.type_mapping.data(),
+                                              snapshot.type_mapping.size());
+            }
+        }
+
+    putParticleArray("particles/tag", m_tags, 1);
+
+    // only write out data categories if requested, or in the first step
+    if (m_write_attribute || m_nsteps == 0)
+        writeAttributes(snapshot, map);
+    if (m_write_property || m_nsteps == 0)
+        writeProperties(snapshot, map);
+    if (m_write_momentum || m_nsteps == 0)
+        writeMomenta(snapshot, map);
+
+    if (!m_log_writer.is_none())
+        {
+        pybind11::gil_scoped_acquire acquire;
+        m_log_writer.attr("_write_frame")(this);
+        }
+
+    m_engine.EndStep();
+    m_nsteps++;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param name Variable name
+    \param arr Array to put
+
+    Zero dimensional arrays are single values, other arrays are global arrays of the same shape
+    written entirely by the root rank.
+*/
+template<class T> void ADIOS2Writer::putLogArray(const std::string& name, pybind11::array arr)
+    {
+    adios2::Variable<T> var = m_io.InquireVariable<T>(name);
+
+    if (arr.ndim() == 0)
+        {
+        if (!var)
+            var = m_io.DefineVariable<T>(name);
+        }
+    else
+        {
+        adios2::Dims shape(arr.shape(), arr.shape() + arr.ndim());
+        adios2::Dims start(arr.ndim(), 0);
+        if (!var)
+            {
+            var = m_io.DefineVariable<T>(name, shape, start, shape);
+            }
+        else
+            {
+            var.SetShape(shape);
+            var.SetSelection({start, shape});
+            }
+        }
+
+    m_engine.Put(var, static_cast<const T*>(arr.data()), adios2::Mode::Sync);
+    }
+
+void ADIOS2Writer::writeLogQuantities(pybind11::dict dict)
+    {
+    bool root = true;
+#ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+#endif
+
+    // only evaluate the numpy array on the root rank
+    if (!root)
+        return;
+
+    for (auto key_iter = dict.begin(); key_iter != dict.end(); ++key_iter)
+        {
+        std::string name = pybind11::cast<std::string>(key_iter->first);
+        m_exec_conf->msg->notice(10) << "ADIOS2: writing " << name << endl;
+
+        pybind11::array arr = pybind11::array::ensure(key_iter->second, pybind11::array::c_style);
+        if (arr.ndim() > 2)
+            throw invalid_argument("Invalid numpy dimension in ADIOS2 log data [" + name + "]");
+
+        auto dtype = arr.dtype();
+        if ((dtype.kind() == 'u' || dtype.kind() == 'b') && dtype.itemsize() == 1)
+            putLogArray<uint8_t>(name, arr);
+        else if (dtype.kind() == 'u' && dtype.itemsize() == 2)
+            putLogArray<uint16_t>(name, arr);
+        else if (dtype.kind() == 'u' && dtype.itemsize() == 4)
+            putLogArray<uint32_t>(name, arr);
+        else if (dtype.kind() == 'u' && dtype.itemsize() == 8)
+            putLogArray<uint64_t>(name, arr);
+        else if (dtype.kind() == 'i' && dtype.itemsize() == 1)
+            putLogArray<int8_t>(name, arr);
+        else if (dtype.kind() == 'i' && dtype.itemsize() == 2)
+            putLogArray<int16_t>(name, arr);
+        else if (dtype.kind() == 'i' && dtype.itemsize() == 4)
+            putLogArray<int32_t>(name, arr);
+        else if (dtype.kind() == 'i' && dtype.itemsize() == 8)
+            putLogArray<int64_t>(name, arr);
+        else if (dtype.kind() == 'f' && dtype.itemsize() == 4)
+            putLogArray<float>(name, arr);
+        else if (dtype.kind() == 'f' && dtype.itemsize() == 8)
+            putLogArray<double>(name, arr);
+        else
+            throw range_error("Invalid numpy array format in ADIOS2 log data [" + name
+                              + "]: " + string(pybind11::str(arr.dtype())));
+        }
+    }
+
+void export_ADIOS2Writer(py::module& m)
+    {
+    py::class_<ADIOS2Writer, Analyzer, std::shared_ptr<ADIOS2Writer>>(m, "ADIOS2Writer")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::string,
+                      std::shared_ptr<ParticleGroup>,
+                      std::string,
+                      py::dict>())
+        .def("setWriteAttribute", &ADIOS2Writer::setWriteAttribute)
+        .def("setWriteProperty", &ADIOS2Writer::setWriteProperty)
+        .def("setWriteMomentum", &ADIOS2Writer::setWriteMomentum)
+        .def("writeLogQuantities", &ADIOS2Writer::writeLogQuantities)
+        .def_property("log_writer", &ADIOS2Writer::getLogWriter, &ADIOS2Writer::setLogWriter)
+        .def_property_readonly("filename", &ADIOS2Writer::getFilename)
+        .def_property_readonly("engine", &ADIOS2Writer::getEngine)
+        .def_property_readonly("parameters", &ADIOS2Writer::getParameters)
+        .def_property_readonly("dynamic", &ADIOS2Writer::getDynamic)
+        .def_property_readonly("filter",
+                               [](const std::shared_ptr<ADIOS2Writer> writer)
+                               { return writer->getGroup()->getFilter(); });
+    }
+
+#endif // ENABLE_ADIOS2
@@ -0,0 +1,191 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_ADIOS2
+
+#include "Analyzer.h"
+#include "ParticleGroup.h"
+
+#include <adios2.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file ADIOS2Writer.h
+    \brief Declares the ADIOS2Writer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+//! Analyzer for streaming particle data through ADIOS2
+/*! ADIOS2Writer publishes one ADIOS2 step each time analyze() is called. The ADIOS2 engine
+    determines where the steps go: BP4 and BP5 write files, SST streams the steps to a concurrently
+    running reader (in-transit analysis), and HDF5 writes a parallel HDF5 file.
+
+    Particle quantities are global arrays with the same names and types as the GSD chunks written
+    by GSDDumpWriter (particles/position, particles/typeid, ...). Each rank puts the members of the
+    group that it owns as one block of the global arrays, so no particle data is communicated. The
+    blocks are not in tag order, particles/tag holds the tag of each particle in the global arrays.
+    The only collective operation is a prefix sum over the number of local members.
+
+    The quantity categories (attribute, property, momentum) select the quantities written in every
+    step, as in GSDDumpWriter. All categories are written in the first step. Topology is not
+    written.
+
+    Rank 0 writes configuration/step, configuration/box, configuration/dimensions and the log
+    quantities provided by the log writer as single values or global arrays.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT ADIOS2Writer : public Analyzer
+    {
+    public:
+    //! Construct the writer
+    ADIOS2Writer(std::shared_ptr<SystemDefinition> sysdef,
+                 const std::string& fname,
+                 std::shared_ptr<ParticleGroup> group,
+                 const std::string& engine,
+                 pybind11::dict parameters);
+
+    //! Destructor
+    ~ADIOS2Writer();
+
+    //! Publish the data for the current timestep
+    void analyze(uint64_t timestep);
+
+    //! Control attribute writes
+    void setWriteAttribute(bool b)
+        {
+        m_write_attribute = b;
+        }
+
+    //! Control property writes
+    void setWriteProperty(bool b)
+        {
+        m_write_property = b;
+        }
+
+    //! Control momentum writes
+    void setWriteMomentum(bool b)
+        {
+        m_write_momentum = b;
+        }
+
+    pybind11::tuple getDynamic()
+        {
+        pybind11::list result;
+        if (m_write_attribute)
+            result.append("attribute");
+        if (m_write_property)
+            result.append("property");
+        if (m_write_momentum)
+            result.append("momentum");
+
+        return pybind11::tuple(result);
+        }
+
+    std::string getFilename()
+        {
+        return m_fname;
+        }
+
+    std::string getEngine()
+        {
+        return m_engine_type;
+        }
+
+    //! Get the engine parameters
+    pybind11::dict getParameters();
+
+    std::shared_ptr<ParticleGroup> getGroup()
+        {
+        return m_group;
+        }
+
+    /// Write logged quantities
+    void writeLogQuantities(pybind11::dict dict);
+
+    /// Set the log writer
+    void setLogWriter(pybind11::object log_writer)
+        {
+        m_log_writer = log_writer;
+        }
+
+    /// Get the log writer
+    pybind11::object getLogWriter()
+        {
+        return m_log_writer;
+        }
+
+    /// Get needed pdata flags
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        PDataFlags flags;
+
+        if (!m_log_writer.is_none())
+            {
+            flags.set();
+            }
+
+        return flags;
+        }
+
+    private:
+    std::string m_fname;                             //!< The file or stream name
+    std::string m_engine_type;                       //!< The ADIOS2 engine
+    std::map<std::string, std::string> m_parameters; //!< Parameters passed to the engine
+    std::shared_ptr<ParticleGroup> m_group;          //!< Group to write out
+    bool m_write_attribute;                          //!< True if attributes should be written
+    bool m_write_property;                           //!< True if properties should be written
+    bool m_write_momentum;                           //!< True if momenta should be written
+    uint64_t m_nsteps;                               //!< Number of steps published
+
+    /// Callback to write log quantities
+    pybind11::object m_log_writer;
+
+    std::unique_ptr<adios2::ADIOS> m_adios; //!< ADIOS2 context, created on the first step
+    adios2::IO m_io;                        //!< IO object that holds the variables
+    adios2::Engine m_engine;                //!< Engine that publishes the steps
+
+    std::vector<unsigned int> m_tags; //!< Tags of the local group members in the current step
+    uint64_t m_n_global;              //!< Number of group members on all ranks
+    uint64_t m_offset;                //!< Offset of this rank's block in the global arrays
+
+    //! Open the engine
+    void initIO();
+
+    //! Set m_tags, m_n_global, and m_offset for the current step
+    void populateTags();
+
+    //! Put this rank's block of a global particle array
+    template<class T>
+    void putParticleArray(const std::string& name, const std::vector<T>& data, size_t M);
+
+    //! Put a log quantity from the root rank
+    template<class T> void putLogArray(const std::string& name, pybind11::array arr);
+
+    //! Write particle attributes
+    void writeAttributes(const SnapshotParticleData<float>& snapshot,
+                         const std::map<unsigned int, unsigned int>& map);
+
+    //! Write particle properties
+    void writeProperties(const SnapshotParticleData<float>& snapshot,
+                         const std::map<unsigned int, unsigned int>& map);
+
+    //! Write particle momenta
+    void writeMomenta(const SnapshotParticleData<float>& snapshot,
+                      const std::map<unsigned int, unsigned int>& map);
+    };
+
+//! Exports the ADIOS2Writer class to python
+void export_ADIOS2Writer(pybind11::module& m);
+
+#endif // ENABLE_ADIOS2
@@ -2,6 +2,8 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "Autotuner.h"
+#include "AutotunerCache.h"
+#include "HOOMDVersion.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -10,6 +12,7 @@
 #include <algorithm>
 #include <cfloat>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 using namespace std;
@@ -32,7 +35,8 @@ Autotuner::Autotuner(const std::vector<unsigned int>& parameters,
                      std::shared_ptr<const ExecutionConfiguration> exec_conf)
     : m_nsamples(nsamples), m_period(period), m_enabled(true), m_name(name),
       m_parameters(parameters), m_state(STARTUP), m_current_sample(0), m_current_element(0),
-      m_calls(0), m_exec_conf(exec_conf), m_mode(mode_median)
+      m_calls(0), m_exec_conf(exec_conf), m_mode(mode_median), m_initialized(false),
+      m_adaptive(false), m_current_candidate(0), m_challenger(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing Autotuner " << nsamples << " " << period << " "
                                 << name << endl;
@@ -88,7 +92,8 @@ Autotuner::Autotuner(unsigned int start,
                      std::shared_ptr<const ExecutionConfiguration> exec_conf)
     : m_nsamples(nsamples), m_period(period), m_enabled(true), m_name(name), m_state(STARTUP),
       m_current_sample(0), m_current_element(0), m_calls(0), m_current_param(0),
-      m_exec_conf(exec_conf), m_mode(mode_median)
+      m_exec_conf(exec_conf), m_mode(mode_median), m_initialized(false),
+      m_adaptive(false), m_current_candidate(0), m_challenger(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing Autotuner "
                                 << " " << start << " " << end << " " << step << " " << nsamples
@@ -146,6 +151,9 @@ Autotuner::~Autotuner()
 
 void Autotuner::begin()
     {
+    if (!m_initialized)
+        initialize();
+
     // skip if disabled
     if (!m_enabled)
         return;
@@ -174,6 +182,14 @@ void Autotuner::end()
         hipEventRecord(m_stop, 0);
         hipEventSynchronize(m_stop);
         hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
+
+        if (const std::shared_ptr<Tracer>& tracer = m_exec_conf->getTracer())
+            {
+            tracer->addEventEndingNow(
+                "Autotuner " + m_name + " (" + to_string(m_current_param) + ")",
+                Tracer::gpu_track,
+                int64_t(double(m_samples[m_current_element][m_current_sample]) * 1e6));
+            }
         m_exec_conf->msg->notice(9)
             << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
             << ") = " << m_samples[m_current_element][m_current_sample] << endl;
@@ -184,7 +200,35 @@ void Autotuner::end()
 #endif
 
     // handle state data updates and transitions
-    if (m_state == STARTUP)
+    if (m_adaptive && (m_state == STARTUP || m_state == SCANNING))
+        {
+        m_sample_count[m_current_element]++;
+        m_current_candidate++;
+
+        if (m_current_candidate >= m_candidates.size())
+            {
+            m_current_candidate = 0;
+            unsigned int n_samples = m_sample_count[m_candidates[0]];
+
+            if (m_state == STARTUP && n_samples < m_nsamples)
+                {
+                // start the next round with the faster half of the candidates
+                halveCandidates(n_samples);
+                selectCandidate();
+                }
+            else
+                {
+                m_state = IDLE;
+                m_current_param = computeOptimalParameter();
+                storeCachedParameter();
+                }
+            }
+        else
+            {
+            selectCandidate();
+            }
+        }
+    else if (m_state == STARTUP)
         {
         // move on to the next sample
         m_current_sample++;
@@ -202,6 +246,7 @@ void Autotuner::end()
                 m_current_element = 0;
                 m_state = IDLE;
                 m_current_param = computeOptimalParameter();
+                storeCachedParameter();
                 }
             else
                 {
@@ -223,6 +268,7 @@ void Autotuner::end()
             m_state = IDLE;
             m_current_param = computeOptimalParameter();
             m_current_sample = (m_current_sample + 1) % m_nsamples;
+            storeCachedParameter();
             }
         else
             {
@@ -241,7 +287,28 @@ void Autotuner::end()
             m_calls = 0;
 
             // initialize a scan
-            m_current_param = m_parameters[m_current_element];
+            if (m_adaptive)
+                {
+                // sample the current optimal parameter and the next challenger
+                unsigned int opt = (unsigned int)(std::find(m_parameters.begin(),
+                                                            m_parameters.end(),
+                                                            m_current_param)
+                                                  - m_parameters.begin());
+                if (m_challenger == opt)
+                    m_challenger = (m_challenger + 1) % m_parameters.size();
+
+                m_candidates.clear();
+                m_candidates.push_back(opt);
+                if (m_challenger != opt)
+                    m_candidates.push_back(m_challenger);
+                m_challenger = (m_challenger + 1) % m_parameters.size();
+                m_current_candidate = 0;
+                selectCandidate();
+                }
+            else
+                {
+                m_current_param = m_parameters[m_current_element];
+                }
             m_state = SCANNING;
             m_exec_conf->msg->notice(4)
                 << "Autotuner " << m_name << " - beginning scan" << std::endl;
@@ -273,52 +340,9 @@ unsigned int Autotuner::computeOptimalParameter()
     for (unsigned int i = 0; i < m_parameters.size(); i++)
         {
         v = m_samples[i];
-#ifdef ENABLE_MPI
-        if (m_sync && nranks)
-            {
-            // combine samples from all ranks on rank zero
-            std::vector<std::vector<float>> all_v;
-            MPI_Barrier(m_exec_conf->getMPICommunicator());
-            gather_v(v, all_v, 0, m_exec_conf->getMPICommunicator());
-            if (is_root)
-                {
-                v.clear();
-                assert(all_v.size() == nranks);
-                for (unsigned int j = 0; j < nranks; ++j)
-                    v.insert(v.end(), all_v[j].begin(), all_v[j].end());
-                }
-            }
-#endif
+        gatherSamples(v);
         if (is_root)
-            {
-            if (m_mode == mode_avg)
-                {
-                // compute average
-                float sum = 0.0f;
-                for (std::vector<float>::iterator it = v.begin(); it != v.end(); ++it)
-                    sum += *it;
-                m_sample_median[i] = sum / float(v.size());
-                }
-            else if (m_mode == mode_max)
-                {
-                // compute maximum
-                m_sample_median[i] = -FLT_MIN;
-                for (std::vector<float>::iterator it = v.begin(); it != v.end(); ++it)
-                    {
-                    if (*it > m_sample_median[i])
-                        {
-                        m_sample_median[i] = *it;
-                        }
-                    }
-                }
-            else
-                {
-                // compute median
-                size_t n = v.size() / 2;
-                nth_element(v.begin(), v.begin() + n, v.end());
-                m_sample_median[i] = v[n];
-                }
-            }
+            m_sample_median[i] = computeStatistic(v);
         }
 
     unsigned int opt = 0;
@@ -361,6 +385,214 @@ unsigned int Autotuner::computeOptimalParameter()
     return opt;
     }
 
+/*! \param v Samples of one element on this rank, replaced by the samples of all ranks on rank 0
+
+    Collective when the tuner is synchronized over MPI.
+*/
+void Autotuner::gatherSamples(std::vector<float>& v)
+    {
+#ifdef ENABLE_MPI
+    unsigned int nranks = m_exec_conf->getNRanks();
+    if (m_sync && nranks)
+        {
+        // combine samples from all ranks on rank zero
+        std::vector<std::vector<float>> all_v;
+        MPI_Barrier(m_exec_conf->getMPICommunicator());
+        gather_v(v, all_v, 0, m_exec_conf->getMPICommunicator());
+        if (!m_exec_conf->getRank())
+            {
+            v.clear();
+            assert(all_v.size() == nranks);
+            for (unsigned int j = 0; j < nranks; ++j)
+                v.insert(v.end(), all_v[j].begin(), all_v[j].end());
+            }
+        }
+#endif
+    }
+
+/*! \param v Samples (reordered by the median computation)
+    \returns The median, average, or maximum of the samples
+*/
+float Autotuner::computeStatistic(std::vector<float>& v) const
+    {
+    if (m_mode == mode_avg)
+        {
+        // compute average
+        float sum = 0.0f;
+        for (std::vector<float>::iterator it = v.begin(); it != v.end(); ++it)
+            sum += *it;
+        return sum / float(v.size());
+        }
+    else if (m_mode == mode_max)
+        {
+        // compute maximum
+        float max = -FLT_MIN;
+        for (std::vector<float>::iterator it = v.begin(); it != v.end(); ++it)
+            {
+            if (*it > max)
+                {
+                max = *it;
+                }
+            }
+        return max;
+        }
+    else
+        {
+        // compute median
+        size_t n = v.size() / 2;
+        nth_element(v.begin(), v.begin() + n, v.end());
+        return v[n];
+        }
+    }
+
+void Autotuner::initialize()
+    {
+    m_initialized = true;
+    m_adaptive = m_exec_conf->getAutotunerAdaptive();
+
+    if (m_adaptive && m_state == STARTUP)
+        {
+        for (unsigned int i = 0; i < m_parameters.size(); i++)
+            {
+            m_samples[i].assign(m_nsamples, FLT_MAX);
+            }
+        m_sample_count.assign(m_parameters.size(), 0);
+        m_candidates.resize(m_parameters.size());
+        for (unsigned int i = 0; i < m_parameters.size(); i++)
+            {
+            m_candidates[i] = i;
+            }
+        m_current_candidate = 0;
+        selectCandidate();
+        }
+
+    loadCachedParameter();
+    }
+
+/*! \param n_samples Number of samples taken of each candidate
+
+    The candidates are ranked by the statistic of their first \a n_samples samples. Ties keep the
+    element with the lower index.
+*/
+void Autotuner::halveCandidates(unsigned int n_samples)
+    {
+    bool is_root = true;
+#ifdef ENABLE_MPI
+    if (m_sync && m_exec_conf->getNRanks())
+        is_root = !m_exec_conf->getRank();
+#endif
+
+    std::vector<std::pair<float, unsigned int>> times;
+    for (unsigned int element : m_candidates)
+        {
+        std::vector<float> v(m_samples[element].begin(), m_samples[element].begin() + n_samples);
+        gatherSamples(v);
+        if (is_root)
+            times.push_back(std::make_pair(computeStatistic(v), element));
+        }
+
+    if (is_root)
+        {
+        std::stable_sort(times.begin(),
+                         times.end(),
+                         [](const std::pair<float, unsigned int>& a,
+                            const std::pair<float, unsigned int>& b) { return a.first < b.first; });
+
+        m_candidates.resize((m_candidates.size() + 1) / 2);
+        for (unsigned int i = 0; i < m_candidates.size(); i++)
+            {
+            m_candidates[i] = times[i].second;
+            }
+        std::sort(m_candidates.begin(), m_candidates.end());
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sync && m_exec_conf->getNRanks())
+        bcast(m_candidates, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    m_exec_conf->msg->notice(6) << "Autotuner " << m_name << " kept " << m_candidates.size()
+                                << " candidates after " << n_samples << " samples" << endl;
+    }
+
+void Autotuner::selectCandidate()
+    {
+    m_current_element = m_candidates[m_current_candidate];
+    m_current_sample = m_sample_count[m_current_element] % m_nsamples;
+    m_current_param = m_parameters[m_current_element];
+    }
+
+/*! The key identifies the tuner, its valid parameters, the hardware, and the simulated system.
+ */
+std::string Autotuner::getCacheKey() const
+    {
+    std::ostringstream s;
+    s << "HOOMD " << HOOMD_VERSION << " | " << m_name << " |";
+    for (unsigned int param : m_parameters)
+        s << " " << param;
+    s << " | mode " << m_mode << " | " << AutotunerCache::getSystemKey() << " | ranks "
+      << m_exec_conf->getNRanks();
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        s << " | " << m_exec_conf->dev_prop.name << " " << m_exec_conf->dev_prop.multiProcessorCount
+          << " SM x" << m_exec_conf->getNumActiveGPUs();
+        }
+#endif
+    return s.str();
+    }
+
+void Autotuner::loadCachedParameter()
+    {
+    if (AutotunerCache::getPath().empty() || m_state != STARTUP)
+        return;
+
+    unsigned int param = 0;
+    bool found = false;
+#ifdef ENABLE_MPI
+    if (m_sync && m_exec_conf->getNRanks() > 1)
+        {
+        // all ranks must start from the same parameter
+        if (m_exec_conf->getRank() == 0)
+            found = AutotunerCache::load(getCacheKey(), param);
+        bcast(found, 0, m_exec_conf->getMPICommunicator());
+        bcast(param, 0, m_exec_conf->getMPICommunicator());
+        }
+    else
+#endif
+        {
+        found = AutotunerCache::load(getCacheKey(), param);
+        }
+
+    auto it = std::find(m_parameters.begin(), m_parameters.end(), param);
+    if (!found || it == m_parameters.end())
+        return;
+
+    // the cached parameter wins until the periodic scans have sampled the others
+    size_t cached_element = it - m_parameters.begin();
+    for (size_t i = 0; i < m_parameters.size(); i++)
+        {
+        m_samples[i].assign(m_nsamples, i == cached_element ? 0.0f : FLT_MAX);
+        }
+
+    m_current_element = 0;
+    m_current_sample = 0;
+    m_calls = 0;
+    m_state = IDLE;
+    m_current_param = param;
+
+    m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " using cached parameter " << param
+                                << endl;
+    }
+
+void Autotuner::storeCachedParameter()
+    {
+    if (AutotunerCache::getPath().empty() || m_exec_conf->getRank() != 0)
+        return;
+
+    AutotunerCache::store(getCacheKey(), m_current_param);
+    }
+
 void export_Autotuner(py::module& m)
     {
     py::class_<Autotuner>(m, "Autotuner")
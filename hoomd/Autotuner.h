@@ -53,6 +53,24 @@
    is the index of the current parameter being sampled. m_samples stores the time of each sampled
    kernel launch, and m_sample_median stores the current median of each set of samples. When idle,
    the number of calls is counted in m_calls. m_state lists the current state in the state machine.
+
+    ** Adaptive search ** <br>
+    When ExecutionConfiguration::getAutotunerAdaptive() is true at the first call to begin(), the
+   tuner replaces the exhaustive scans with successive halving. The initial scan runs m_nsamples
+   rounds over the elements listed in m_candidates, taking one more sample of each per round.
+   After every round but the last, the slower half of the candidates is dropped. Elements store
+   their samples in their own circular buffer (m_sample_count counts the samples taken) and
+   unsampled slots hold FLT_MAX, so elements dropped early count as slow. The periodic scans then
+   sample only the current optimal parameter and one challenger, cycling through all elements,
+   which gradually refreshes the samples of every parameter.
+
+    ** Cache ** <br>
+    When AutotunerCache is enabled, the first call to begin() looks up the optimal parameter found
+   in a previous run with the same tuner name, parameters, GPU, and system size bucket. A cache hit
+   skips the initial scan: the tuner starts in the IDLE state with the cached parameter and the
+   periodic scans re-validate it. Until the periodic scans have collected enough samples of the
+   other parameters, their times count as infinitely slow. The optimal parameter is stored in the
+   cache (by rank 0) after every scan.
 */
 class PYBIND11_EXPORT Autotuner
     {
@@ -201,6 +219,30 @@ class PYBIND11_EXPORT Autotuner
     protected:
     unsigned int computeOptimalParameter();
 
+    //! Choose the search and look up the cache, called by the first begin()
+    void initialize();
+
+    //! Combine the samples of one element with the other ranks (when synchronized)
+    void gatherSamples(std::vector<float>& v);
+
+    //! Compute the median, average, or maximum of the samples (depending on m_mode)
+    float computeStatistic(std::vector<float>& v) const;
+
+    //! Drop the slower half of m_candidates
+    void halveCandidates(unsigned int n_samples);
+
+    //! Begin sampling the element m_candidates[m_current_candidate]
+    void selectCandidate();
+
+    //! Start from the cached optimal parameter, when there is one
+    void loadCachedParameter();
+
+    //! Store the current optimal parameter in the cache
+    void storeCachedParameter();
+
+    //! Get the key of this tuner in AutotunerCache
+    std::string getCacheKey() const;
+
     //! State names
     enum State
         {
@@ -233,8 +275,16 @@ class PYBIND11_EXPORT Autotuner
     hipEvent_t m_stop;  //!< CUDA event for recording end times
 #endif
 
-    bool m_sync;      //!< If true, synchronize results via MPI
-    mode_Enum m_mode; //!< The sampling mode
+    bool m_sync;        //!< If true, synchronize results via MPI
+    mode_Enum m_mode;   //!< The sampling mode
+    bool m_initialized; //!< True after the first call to begin()
+
+    // adaptive search
+    bool m_adaptive;                            //!< True when using the adaptive search
+    std::vector<unsigned int> m_sample_count;   //!< Number of samples taken of each element
+    std::vector<unsigned int> m_candidates;     //!< Elements sampled in the current scan
+    unsigned int m_current_candidate;           //!< Index in m_candidates of the current element
+    unsigned int m_challenger;                  //!< Element to sample in the next periodic scan
     };
 
 //! Export the Autotuner class to python
@@ -0,0 +1,149 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "AutotunerCache.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/*! \file AutotunerCache.cc
+    \brief Definition of AutotunerCache
+*/
+
+namespace
+    {
+//! Identifies the cache file format
+const char cache_magic[] = "HOOMD-AUTOTUNER-CACHE-1";
+
+//! The cache directory
+std::string& cachePath()
+    {
+    static std::string path = []()
+    {
+        const char* env = std::getenv("HOOMD_AUTOTUNER_CACHE_DIR");
+        return std::string(env ? env : "");
+    }();
+    return path;
+    }
+
+//! The description of the system
+std::string& systemKey()
+    {
+    static std::string key;
+    return key;
+    }
+
+//! 64-bit FNV-1a hash
+uint64_t hashKey(const std::string& key)
+    {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key)
+        {
+        hash ^= c;
+        hash *= 1099511628211ull;
+        }
+    return hash;
+    }
+
+//! Create a directory and its parents
+bool makeDirectories(const std::string& path)
+    {
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+        {
+        std::string parent = path.substr(0, pos);
+        if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+            return false;
+        }
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+    }
+    } // end anonymous namespace
+
+const std::string& AutotunerCache::getPath()
+    {
+    return cachePath();
+    }
+
+void AutotunerCache::setPath(const std::string& path)
+    {
+    cachePath() = path;
+    }
+
+void AutotunerCache::setSystem(unsigned int N, unsigned int n_types)
+    {
+    // round N down to a power of two so that small changes in N reuse the same entries
+    unsigned int N_bucket = 1;
+    while (N_bucket <= N / 2)
+        N_bucket *= 2;
+
+    std::ostringstream s;
+    s << "N>=" << N_bucket << " types=" << n_types;
+    systemKey() = s.str();
+    }
+
+const std::string& AutotunerCache::getSystemKey()
+    {
+    return systemKey();
+    }
+
+std::string AutotunerCache::getFilename(const std::string& key)
+    {
+    std::ostringstream s;
+    s << getPath() << "/" << std::hex << std::setw(16) << std::setfill('0') << hashKey(key)
+      << ".tune";
+    return s.str();
+    }
+
+bool AutotunerCache::load(const std::string& key, unsigned int& param)
+    {
+    if (getPath().empty())
+        return false;
+
+    std::ifstream in(getFilename(key));
+    if (!in)
+        return false;
+
+    std::string magic, stored_key;
+    if (!std::getline(in, magic) || magic != cache_magic || !std::getline(in, stored_key)
+        || stored_key != key)
+        return false;
+
+    return bool(in >> param);
+    }
+
+void AutotunerCache::store(const std::string& key, unsigned int param)
+    {
+    if (getPath().empty() || key.find('\n') != std::string::npos || !makeDirectories(getPath()))
+        return;
+
+    // write to a file unique to this process, then atomically move it into place
+    std::string filename = getFilename(key);
+    std::ostringstream tmp_name;
+    tmp_name << filename << ".tmp." << getpid();
+
+        {
+        std::ofstream out(tmp_name.str(), std::ios::trunc);
+        if (!out)
+            return;
+
+        out << cache_magic << "\n" << key << "\n" << param << "\n";
+
+        if (!out)
+            {
+            out.close();
+            std::remove(tmp_name.str().c_str());
+            return;
+            }
+        }
+
+    if (std::rename(tmp_name.str().c_str(), filename.c_str()) != 0)
+        std::remove(tmp_name.str().c_str());
+    }
@@ -0,0 +1,66 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _AUTOTUNER_CACHE_H_
+#define _AUTOTUNER_CACHE_H_
+
+/*! \file AutotunerCache.h
+    \brief Declaration of AutotunerCache
+*/
+
+#include <string>
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#endif
+
+//! On disk cache of the parameters found by Autotuner
+/*! Entries are stored in the directory named by the environment variable
+    HOOMD_AUTOTUNER_CACHE_DIR (the cache is disabled when it is unset or empty), one small text file
+    per entry named by a hash of the key. Each file also stores the full key, so a hash collision is
+    a cache miss. Entries are written to a temporary file and renamed into place, so any number of
+    processes may share one cache directory.
+
+    Autotuner builds the key from the tuner name, the valid parameters, the GPU model, and the
+    system description set with setSystem(): the global number of particles rounded down to a
+    power of two and the number of particle types.
+*/
+class PYBIND11_EXPORT AutotunerCache
+    {
+    public:
+    //! Get the cache directory, empty when the cache is disabled
+    static const std::string& getPath();
+
+    //! Set the cache directory, an empty path disables the cache
+    static void setPath(const std::string& path);
+
+    //! Describe the simulated system in the keys of subsequent lookups
+    /*! \param N Global number of particles
+        \param n_types Number of particle types
+    */
+    static void setSystem(unsigned int N, unsigned int n_types);
+
+    //! Get the description of the system set with setSystem()
+    static const std::string& getSystemKey();
+
+    //! Look up an entry
+    /*! \param key Key of the entry
+        \param param Set to the cached parameter when the entry is found
+        \returns true when the entry is found
+    */
+    static bool load(const std::string& key, unsigned int& param);
+
+    //! Store an entry
+    /*! \param key Key of the entry
+        \param param Parameter to cache
+
+        Failures to write the cache are silently ignored.
+    */
+    static void store(const std::string& key, unsigned int param);
+
+    private:
+    //! Get the file name of the entry with the given key
+    static std::string getFilename(const std::string& key);
+    };
+
+#endif // _AUTOTUNER_CACHE_H_
@@ -13,6 +13,8 @@
 
 #include <pybind11/numpy.h>
 
+#include <algorithm>
+
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -160,14 +162,33 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initialize()
     m_group_rtag.swap(group_rtag);
 
     // Lookup by particle index table
-    GPUVector<members_t> gpu_table(m_exec_conf);
+    // the tables are read by all GPUs that compute forces on a partition of the particles
+    GlobalVector<members_t> gpu_table(m_exec_conf);
     m_gpu_table.swap(gpu_table);
+    TAG_ALLOCATION(m_gpu_table);
 
-    GPUVector<unsigned int> gpu_pos_table(m_exec_conf);
+    GlobalVector<unsigned int> gpu_pos_table(m_exec_conf);
     m_gpu_pos_table.swap(gpu_pos_table);
+    TAG_ALLOCATION(m_gpu_pos_table);
 
-    GPUVector<unsigned int> n_groups(m_exec_conf);
+    GlobalVector<unsigned int> n_groups(m_exec_conf);
     m_gpu_n_groups.swap(n_groups);
+    TAG_ALLOCATION(m_gpu_n_groups);
+
+    // pending edits of the lookup table
+    m_table_patches.clear();
+
+    GPUVector<unsigned int> patch_row(m_exec_conf);
+    m_patch_row.swap(patch_row);
+
+    GPUVector<unsigned int> patch_offset(m_exec_conf);
+    m_patch_offset.swap(patch_offset);
+
+    GPUVector<members_t> patch_entry(m_exec_conf);
+    m_patch_entry.swap(patch_entry);
+
+    GPUVector<unsigned int> patch_pos(m_exec_conf);
+    m_patch_pos.swap(patch_pos);
 
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -205,6 +226,9 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initialize()
                                           access_mode::overwrite);
     *h_condition.data = 0;
     m_next_flag = 1;
+
+    GPUArray<unsigned int> patch_condition(1, m_exec_conf);
+    m_patch_condition.swap(patch_condition);
 #endif
 
     m_tag_set.clear();
@@ -301,6 +325,9 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
+    // the GPU table is still valid when there are no ghost groups to remove
+    bool patch = canPatchGPUTable();
+
     // we are changing the local number of groups, so remove ghosts
     removeAllGhostGroups();
 
@@ -418,8 +445,18 @@ unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBond
     m_nglobal++;
 
     // notify observers
+    m_group_change_signal.emit(member_tags, true);
     m_group_num_change_signal.emit();
-    notifyGroupReorder();
+
+    if (patch)
+        {
+        recordTablePatch(member_tags, typeval.type, true);
+        m_group_reorder_signal.emit();
+        }
+    else
+        {
+        notifyGroupReorder();
+        }
 
     return tag;
     }
@@ -555,6 +592,9 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::getMembersByIndex(
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGroup(unsigned int tag)
     {
+    // the GPU table is still valid when there are no ghost groups to remove
+    bool patch = canPatchGPUTable();
+
     // we are changing the local particle number, remove ghost groups
     removeAllGhostGroups();
 
@@ -574,6 +614,12 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGro
 
     bool is_available = is_local;
 
+    // member tags of the removed group
+    members_t member_tags;
+    for (unsigned int i = 0; i < group_size; ++i)
+        member_tags.tag[i] = is_local ? ((members_t)m_groups[id]).tag[i] : 0;
+    unsigned int type = is_local && has_type_mapping ? ((typeval_t)m_group_typeval[id]).type : 0;
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -584,6 +630,14 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGro
 
         assert((unsigned int)res <= group_size);
         is_available = res;
+
+        // make the member tags known on all processors
+        MPI_Allreduce(MPI_IN_PLACE,
+                      member_tags.tag,
+                      group_size,
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
         }
 #endif
 
@@ -635,8 +689,18 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGro
     m_nglobal--;
 
     // notify observers
+    m_group_change_signal.emit(member_tags, false);
     m_group_num_change_signal.emit();
-    notifyGroupReorder();
+
+    if (patch)
+        {
+        recordTablePatch(member_tags, type, false);
+        m_group_reorder_signal.emit();
+        }
+    else
+        {
+        notifyGroupReorder();
+        }
     }
 
 /*! \param name Type name
@@ -716,6 +780,299 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::maybe_rebuild_t
     m_invalid_cached_tags = false;
     }
 
+/*! The table of groups by particle index can be patched when it is valid for the current
+    particles and stores group types. Tables of groups without a type mapping store the local group
+    index, which changes when groups are removed. Ghost groups are removed when groups are added or
+    removed, so the table must also not include ghost groups.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+bool BondedGroupData<group_size, Group, name, has_type_mapping>::canPatchGPUTable()
+    {
+    if (!has_type_mapping || m_groups_dirty || m_n_ghost > 0)
+        return false;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        return false;
+#endif
+
+    unsigned int N = m_pdata->getN() + m_pdata->getNGhosts();
+    return m_gpu_table_indexer.getW() == N && m_gpu_n_groups.getNumElements() == N;
+    }
+
+/*! \param tags Member tags of the group
+    \param type Type of the group
+    \param add True if the group was added, false if it was removed
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::recordTablePatch(
+    const members_t& tags,
+    unsigned int type,
+    bool add)
+    {
+    if (!add)
+        {
+        // a group that is removed before the table is accessed again does not need to be added
+        for (auto it = m_table_patches.rbegin(); it != m_table_patches.rend(); ++it)
+            {
+            bool match = it->add && it->type == type;
+            for (unsigned int i = 0; i < group_size; ++i)
+                match = match && it->tags.tag[i] == tags.tag[i];
+
+            if (match)
+                {
+                m_table_patches.erase(std::next(it).base());
+                return;
+                }
+            }
+        }
+
+    table_patch_t patch;
+    patch.tags = tags;
+    patch.type = type;
+    patch.add = add;
+    m_table_patches.push_back(patch);
+    }
+
+/*! Each pending patch edits the table rows of all group members. The edits are sorted by row and
+    applied with one thread per row on the GPU, in the order they were recorded within each row.
+    A removed group is swapped with the last entry of the row and an added group is appended, so
+    the cost is independent of the number of groups. The table is rebuilt when a row is full.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::patchGPUTable()
+    {
+    if (m_prof)
+        m_prof->push("patch " + std::string(name) + " table");
+
+    unsigned int N = m_pdata->getN() + m_pdata->getNGhosts();
+    bool failed = false;
+    unsigned int n_rows = 0;
+
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        // expand the patches into edits of the rows of the members
+        std::vector<unsigned int> row;
+        std::vector<members_t> entry;
+        std::vector<unsigned int> pos;
+        for (const table_patch_t& patch : m_table_patches)
+            {
+            for (unsigned int i = 0; i < group_size; ++i)
+                {
+                members_t h;
+                h.idx[group_size - 1] = patch.type;
+
+                unsigned int n = 0;
+                for (unsigned int j = 0; j < group_size; ++j)
+                    {
+                    unsigned int idx = h_rtag.data[patch.tags.tag[j]];
+                    failed = failed || idx >= N;
+                    if (j != i)
+                        h.idx[n++] = idx;
+                    }
+
+                row.push_back(h_rtag.data[patch.tags.tag[i]]);
+                entry.push_back(h);
+                pos.push_back(patch.add ? (i | GROUP_PATCH_ADD) : i);
+                }
+            }
+        m_table_patches.clear();
+
+        // sort the edits by row, preserving the order of the edits of each row
+        std::vector<unsigned int> order(row.size());
+        for (unsigned int k = 0; k < order.size(); ++k)
+            order[k] = k;
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&row](unsigned int a, unsigned int b) { return row[a] < row[b]; });
+
+        m_patch_row.resize(order.size());
+        m_patch_offset.resize(order.size() + 1);
+        m_patch_entry.resize(order.size());
+        m_patch_pos.resize(order.size());
+
+        ArrayHandle<unsigned int> h_patch_row(m_patch_row,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_patch_offset(m_patch_offset,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        ArrayHandle<members_t> h_patch_entry(m_patch_entry,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        ArrayHandle<unsigned int> h_patch_pos(m_patch_pos,
+                                              access_location::host,
+                                              access_mode::overwrite);
+
+        for (unsigned int k = 0; k < order.size(); ++k)
+            {
+            if (k == 0 || row[order[k]] != row[order[k - 1]])
+                {
+                h_patch_row.data[n_rows] = row[order[k]];
+                h_patch_offset.data[n_rows] = k;
+                n_rows++;
+                }
+            h_patch_entry.data[k] = entry[order[k]];
+            h_patch_pos.data[k] = pos[order[k]];
+            }
+        h_patch_offset.data[n_rows] = (unsigned int)order.size();
+        }
+
+    if (!failed)
+        {
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+                {
+                ArrayHandle<unsigned int> h_patch_condition(m_patch_condition,
+                                                            access_location::host,
+                                                            access_mode::overwrite);
+                *h_patch_condition.data = 0;
+                }
+
+                {
+                ArrayHandle<unsigned int> d_patch_row(m_patch_row,
+                                                      access_location::device,
+                                                      access_mode::read);
+                ArrayHandle<unsigned int> d_patch_offset(m_patch_offset,
+                                                         access_location::device,
+                                                         access_mode::read);
+                ArrayHandle<members_t> d_patch_entry(m_patch_entry,
+                                                     access_location::device,
+                                                     access_mode::read);
+                ArrayHandle<unsigned int> d_patch_pos(m_patch_pos,
+                                                      access_location::device,
+                                                      access_mode::read);
+                ArrayHandle<unsigned int> d_n_groups(m_gpu_n_groups,
+                                                     access_location::device,
+                                                     access_mode::readwrite);
+                ArrayHandle<members_t> d_gpu_table(m_gpu_table,
+                                                   access_location::device,
+                                                   access_mode::readwrite);
+                ArrayHandle<unsigned int> d_gpu_pos_table(m_gpu_pos_table,
+                                                          access_location::device,
+                                                          access_mode::readwrite);
+                ArrayHandle<unsigned int> d_patch_condition(m_patch_condition,
+                                                            access_location::device,
+                                                            access_mode::readwrite);
+
+                gpu_patch_group_table<group_size, members_t>(n_rows,
+                                                             d_patch_row.data,
+                                                             d_patch_offset.data,
+                                                             d_patch_entry.data,
+                                                             d_patch_pos.data,
+                                                             d_n_groups.data,
+                                                             m_gpu_table_indexer.getH(),
+                                                             d_gpu_table.data,
+                                                             d_gpu_pos_table.data,
+                                                             m_gpu_table_indexer.getW(),
+                                                             d_patch_condition.data);
+                }
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            ArrayHandle<unsigned int> h_patch_condition(m_patch_condition,
+                                                        access_location::host,
+                                                        access_mode::read);
+            failed = *h_patch_condition.data;
+            }
+        else
+#endif
+            {
+            ArrayHandle<unsigned int> h_patch_row(m_patch_row,
+                                                  access_location::host,
+                                                  access_mode::read);
+            ArrayHandle<unsigned int> h_patch_offset(m_patch_offset,
+                                                     access_location::host,
+                                                     access_mode::read);
+            ArrayHandle<members_t> h_patch_entry(m_patch_entry,
+                                                 access_location::host,
+                                                 access_mode::read);
+            ArrayHandle<unsigned int> h_patch_pos(m_patch_pos,
+                                                  access_location::host,
+                                                  access_mode::read);
+            ArrayHandle<unsigned int> h_n_groups(m_gpu_n_groups,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+            ArrayHandle<members_t> h_gpu_table(m_gpu_table,
+                                               access_location::host,
+                                               access_mode::readwrite);
+            ArrayHandle<unsigned int> h_gpu_pos_table(m_gpu_pos_table,
+                                                      access_location::host,
+                                                      access_mode::readwrite);
+
+            for (unsigned int r = 0; r < n_rows && !failed; ++r)
+                {
+                unsigned int pidx = h_patch_row.data[r];
+                unsigned int n = h_n_groups.data[pidx];
+
+                for (unsigned int k = h_patch_offset.data[r];
+                     k < h_patch_offset.data[r + 1] && !failed;
+                     ++k)
+                    {
+                    const members_t& h = h_patch_entry.data[k];
+                    unsigned int gpos = h_patch_pos.data[k];
+
+                    if (gpos & GROUP_PATCH_ADD)
+                        {
+                        if (n == m_gpu_table_indexer.getH())
+                            {
+                            failed = true;
+                            break;
+                            }
+
+                        h_gpu_table.data[m_gpu_table_indexer(pidx, n)] = h;
+                        h_gpu_pos_table.data[m_gpu_table_indexer(pidx, n)]
+                            = gpos & ~GROUP_PATCH_ADD;
+                        n++;
+                        }
+                    else
+                        {
+                        unsigned int found = n;
+                        for (unsigned int j = 0; j < n && found == n; ++j)
+                            {
+                            const members_t& cur = h_gpu_table.data[m_gpu_table_indexer(pidx, j)];
+                            bool match
+                                = h_gpu_pos_table.data[m_gpu_table_indexer(pidx, j)] == gpos;
+                            for (unsigned int i = 0; i < group_size; ++i)
+                                match = match && cur.idx[i] == h.idx[i];
+
+                            if (match)
+                                found = j;
+                            }
+
+                        if (found == n)
+                            {
+                            failed = true;
+                            break;
+                            }
+
+                        // move the last entry into the hole
+                        unsigned int last = m_gpu_table_indexer(pidx, n - 1);
+                        h_gpu_table.data[m_gpu_table_indexer(pidx, found)]
+                            = h_gpu_table.data[last];
+                        h_gpu_pos_table.data[m_gpu_table_indexer(pidx, found)]
+                            = h_gpu_pos_table.data[last];
+                        n--;
+                        }
+                    }
+
+                h_n_groups.data[pidx] = n;
+                }
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    // fall back to a full rebuild when a row overflows or an edit does not match the table
+    if (failed)
+        rebuildGPUTable();
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable()
     {
@@ -216,6 +216,130 @@ void gpu_update_group_table(const unsigned int n_groups,
         }
     }
 
+//! Apply the edits of one row of the particle index group table per thread
+/*! The edits of each row are applied in the order they were recorded. A removed group is swapped
+    with the last entry of the row and an added group is appended. d_condition is set when a row
+    overflows or a removed entry is not found.
+ */
+template<unsigned int group_size, typename group_t>
+__global__ void gpu_patch_group_table_kernel(const unsigned int n_rows,
+                                             const unsigned int* d_patch_row,
+                                             const unsigned int* d_patch_offset,
+                                             const group_t* d_patch_entry,
+                                             const unsigned int* d_patch_pos,
+                                             unsigned int* d_n_groups,
+                                             const unsigned int max_n_groups,
+                                             group_t* d_pidx_group_table,
+                                             unsigned int* d_pidx_gpos_table,
+                                             const unsigned int pidx_group_table_pitch,
+                                             unsigned int* d_condition)
+    {
+    unsigned int row = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (row >= n_rows)
+        return;
+
+    unsigned int pidx = d_patch_row[row];
+    unsigned int n = d_n_groups[pidx];
+
+    for (unsigned int k = d_patch_offset[row]; k < d_patch_offset[row + 1]; ++k)
+        {
+        group_t entry = d_patch_entry[k];
+        unsigned int pos = d_patch_pos[k];
+
+        if (pos & GROUP_PATCH_ADD)
+            {
+            if (n == max_n_groups)
+                {
+                *d_condition = 1;
+                return;
+                }
+
+            d_pidx_group_table[n * pidx_group_table_pitch + pidx] = entry;
+            d_pidx_gpos_table[n * pidx_group_table_pitch + pidx] = pos & ~GROUP_PATCH_ADD;
+            n++;
+            }
+        else
+            {
+            unsigned int found = n;
+            for (unsigned int j = 0; j < n; ++j)
+                {
+                group_t cur = d_pidx_group_table[j * pidx_group_table_pitch + pidx];
+                bool match = d_pidx_gpos_table[j * pidx_group_table_pitch + pidx] == pos;
+                for (unsigned int i = 0; i < group_size; ++i)
+                    match = match && cur.idx[i] == entry.idx[i];
+
+                if (match)
+                    {
+                    found = j;
+                    break;
+                    }
+                }
+
+            if (found == n)
+                {
+                *d_condition = 1;
+                return;
+                }
+
+            // move the last entry into the hole
+            unsigned int last = (n - 1) * pidx_group_table_pitch + pidx;
+            d_pidx_group_table[found * pidx_group_table_pitch + pidx] = d_pidx_group_table[last];
+            d_pidx_gpos_table[found * pidx_group_table_pitch + pidx] = d_pidx_gpos_table[last];
+            n--;
+            }
+        }
+
+    d_n_groups[pidx] = n;
+    }
+
+/*! \param n_rows Number of table rows with edits
+    \param d_patch_row Particle index of each edited row
+    \param d_patch_offset Offset of the first edit of each row (n_rows + 1 elements)
+    \param d_patch_entry Table entry of each edit
+    \param d_patch_pos Position of the particle in the group, or'ed with GROUP_PATCH_ADD for added
+           groups
+    \param d_n_groups Number of groups per particle (updated)
+    \param max_n_groups Height of the table
+    \param d_pidx_group_table Table of groups by particle index (updated)
+    \param d_pidx_gpos_table Table of positions in group by particle index (updated)
+    \param pidx_group_table_pitch Pitch of the tables
+    \param d_condition Set to 1 when an edit cannot be applied, the caller must reset it
+ */
+template<unsigned int group_size, typename group_t>
+void gpu_patch_group_table(const unsigned int n_rows,
+                           const unsigned int* d_patch_row,
+                           const unsigned int* d_patch_offset,
+                           const group_t* d_patch_entry,
+                           const unsigned int* d_patch_pos,
+                           unsigned int* d_n_groups,
+                           const unsigned int max_n_groups,
+                           group_t* d_pidx_group_table,
+                           unsigned int* d_pidx_gpos_table,
+                           const unsigned int pidx_group_table_pitch,
+                           unsigned int* d_condition)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_rows / block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_patch_group_table_kernel<group_size>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_rows,
+                       d_patch_row,
+                       d_patch_offset,
+                       d_patch_entry,
+                       d_patch_pos,
+                       d_n_groups,
+                       max_n_groups,
+                       d_pidx_group_table,
+                       d_pidx_gpos_table,
+                       pidx_group_table_pitch,
+                       d_condition);
+    }
+
 /*
  * Explicit template instantiations
  */
@@ -279,3 +403,42 @@ template void gpu_update_group_table<4>(const unsigned int n_groups,
                                         unsigned int* d_offsets,
                                         bool has_type_mapping,
                                         CachedAllocator& alloc);
+
+//! BondData
+template void gpu_patch_group_table<2>(const unsigned int n_rows,
+                                       const unsigned int* d_patch_row,
+                                       const unsigned int* d_patch_offset,
+                                       const group_storage<2>* d_patch_entry,
+                                       const unsigned int* d_patch_pos,
+                                       unsigned int* d_n_groups,
+                                       const unsigned int max_n_groups,
+                                       group_storage<2>* d_pidx_group_table,
+                                       unsigned int* d_pidx_gpos_table,
+                                       const unsigned int pidx_group_table_pitch,
+                                       unsigned int* d_condition);
+
+//! AngleData
+template void gpu_patch_group_table<3>(const unsigned int n_rows,
+                                       const unsigned int* d_patch_row,
+                                       const unsigned int* d_patch_offset,
+                                       const group_storage<3>* d_patch_entry,
+                                       const unsigned int* d_patch_pos,
+                                       unsigned int* d_n_groups,
+                                       const unsigned int max_n_groups,
+                                       group_storage<3>* d_pidx_group_table,
+                                       unsigned int* d_pidx_gpos_table,
+                                       const unsigned int pidx_group_table_pitch,
+                                       unsigned int* d_condition);
+
+//! DihedralData and ImproperData
+template void gpu_patch_group_table<4>(const unsigned int n_rows,
+                                       const unsigned int* d_patch_row,
+                                       const unsigned int* d_patch_offset,
+                                       const group_storage<4>* d_patch_entry,
+                                       const unsigned int* d_patch_pos,
+                                       unsigned int* d_n_groups,
+                                       const unsigned int max_n_groups,
+                                       group_storage<4>* d_pidx_group_table,
+                                       unsigned int* d_pidx_gpos_table,
+                                       const unsigned int pidx_group_table_pitch,
+                                       unsigned int* d_condition);
@@ -17,6 +17,9 @@
 //! Sentinel value
 const unsigned int GROUP_NOT_LOCAL = 0xffffffff;
 
+//! Flag in the position of a GPU table patch that marks an added group
+const unsigned int GROUP_PATCH_ADD = 0x80000000;
+
 //! Storage for group members (GPU declaration)
 template<unsigned int group_size> union group_storage {
     unsigned int tag[group_size]; // access 'tags'
@@ -68,4 +71,17 @@ void gpu_update_group_table(const unsigned int n_groups,
                             unsigned int* d_offsets,
                             bool has_type_mapping,
                             CachedAllocator& alloc);
+
+template<unsigned int group_size, typename group_t>
+void gpu_patch_group_table(const unsigned int n_rows,
+                           const unsigned int* d_patch_row,
+                           const unsigned int* d_patch_offset,
+                           const group_t* d_patch_entry,
+                           const unsigned int* d_patch_pos,
+                           unsigned int* d_n_groups,
+                           const unsigned int max_n_groups,
+                           group_t* d_pidx_group_table,
+                           unsigned int* d_pidx_gpos_table,
+                           const unsigned int pidx_group_table_pitch,
+                           unsigned int* d_condition);
 #endif // __BONDED_GROUP_DATA_CUH__
@@ -17,6 +17,9 @@
 //! Sentinel value to indicate group is not present on this processor
 const unsigned int GROUP_NOT_LOCAL((unsigned int)0xffffffff);
 
+//! Flag in the position of a GPU table patch that marks an added group
+const unsigned int GROUP_PATCH_ADD((unsigned int)0x80000000);
+
 #include "ExecutionConfiguration.h"
 #include "GPUVector.h"
 #include "HOOMDMPI.h"
@@ -513,27 +516,19 @@ class BondedGroupData
      */
 
     //! Return GPU bonded groups list
-    const GPUVector<members_t>& getGPUTable()
+    const GlobalVector<members_t>& getGPUTable()
         {
-        // rebuild lookup table if necessary
-        if (m_groups_dirty)
-            {
-            rebuildGPUTable();
-            m_groups_dirty = false;
-            }
+        // rebuild or patch lookup table if necessary
+        checkUpdateGPUTable();
 
         return m_gpu_table;
         }
 
     //! Return GPU list of particle in group position
-    const GPUArray<unsigned>& getGPUPosTable()
+    const GlobalArray<unsigned>& getGPUPosTable()
         {
-        // rebuild lookup table if necessary
-        if (m_groups_dirty)
-            {
-            rebuildGPUTable();
-            m_groups_dirty = false;
-            }
+        // rebuild or patch lookup table if necessary
+        checkUpdateGPUTable();
 
         return m_gpu_pos_table;
         }
@@ -541,18 +536,14 @@ class BondedGroupData
     //! Return two-dimensional group-by-ptl-index lookup table
     const Index2D& getGPUTableIndexer()
         {
-        // rebuild lookup table if necessary
-        if (m_groups_dirty)
-            {
-            rebuildGPUTable();
-            m_groups_dirty = false;
-            }
+        // rebuild or patch lookup table if necessary
+        checkUpdateGPUTable();
 
         return m_gpu_table_indexer;
         }
 
     //! Return list of number of groups per particle
-    const GPUArray<unsigned int>& getNGroupsArray() const
+    const GlobalArray<unsigned int>& getNGroupsArray() const
         {
         return m_gpu_n_groups;
         }
@@ -585,6 +576,16 @@ class BondedGroupData
         return m_group_num_change_signal;
         }
 
+    //! Connects a function to be called every time a single bonded group is added or removed
+    /*! The slot receives the member tags of the group and true when the group was added, false
+        when it was removed. The signal is emitted before the group number change signal, so
+        subscribers can update their state incrementally and ignore the following number change.
+     */
+    Nano::Signal<void(const members_t&, bool)>& getGroupChangeSignal()
+        {
+        return m_group_change_signal;
+        }
+
     //! Connects a function to be called every time the local number of bonded groups changes
     Nano::Signal<void()>& getGroupReorderSignal()
         {
@@ -625,11 +626,11 @@ class BondedGroupData
     GPUVector<typeval_t> m_group_typeval; //!< List of group types/constraint values
     GPUVector<unsigned int> m_group_tag;  //!< List of group tags
     GPUVector<unsigned int> m_group_rtag; //!< Global reverse-lookup table for group tags
-    GPUVector<members_t>
+    GlobalVector<members_t>
         m_gpu_table; //!< Storage for groups by particle index for access on the GPU
-    GPUVector<unsigned int> m_gpu_pos_table; //!< Position of particle idx in group table
-    Index2D m_gpu_table_indexer;             //!< Indexer for GPU table
-    GPUVector<unsigned int> m_gpu_n_groups;  //!< Number of entries in lookup table per particle
+    GlobalVector<unsigned int> m_gpu_pos_table; //!< Position of particle idx in group table
+    Index2D m_gpu_table_indexer;                //!< Indexer for GPU table
+    GlobalVector<unsigned int> m_gpu_n_groups;  //!< Number of entries in lookup table per particle
     std::vector<std::string> m_type_mapping; //!< Mapping of types of bonded groups
 
     unsigned int m_n_groups; //!< Number of local groups
@@ -662,6 +663,22 @@ class BondedGroupData
                                                     //!< added or deleted (globally)
     Nano::Signal<void()> m_group_reorder_signal; //!< Signal that is triggered when groups are added
                                                  //!< or deleted locally
+    Nano::Signal<void(const members_t&, bool)>
+        m_group_change_signal; //!< Signal that is triggered when a single group is added or deleted
+
+    //! A pending edit of the GPU table
+    struct table_patch_t
+        {
+        members_t tags;    //!< Member tags of the group
+        unsigned int type; //!< Type of the group
+        bool add;          //!< True if the group was added, false if it was removed
+        };
+
+    std::vector<table_patch_t> m_table_patches; //!< Edits to apply to the valid GPU table
+    GPUVector<unsigned int> m_patch_row;        //!< Table rows edited by the pending patches
+    GPUVector<unsigned int> m_patch_offset;     //!< Offset of the first edit of each row
+    GPUVector<members_t> m_patch_entry;         //!< Table entry of each edit, sorted by row
+    GPUVector<unsigned int> m_patch_pos;        //!< Position in group and GROUP_PATCH_ADD flag
 
     //! Initialize internal memory
     void initialize();
@@ -672,6 +689,30 @@ class BondedGroupData
     //! Helper function to rebuild lookup by index table
     void rebuildGPUTable();
 
+    //! Rebuild the lookup by index table or apply the pending patches to it
+    void checkUpdateGPUTable()
+        {
+        if (m_groups_dirty)
+            {
+            rebuildGPUTable();
+            m_groups_dirty = false;
+            m_table_patches.clear();
+            }
+        else if (!m_table_patches.empty())
+            {
+            patchGPUTable();
+            }
+        }
+
+    //! Test if a group added or removed now can be patched into the GPU table
+    bool canPatchGPUTable();
+
+    //! Record a GPU table patch for a group added or removed on all processors
+    void recordTablePatch(const members_t& tags, unsigned int type, bool add);
+
+    //! Apply the pending patches to the GPU table, or rebuild it when a patch fails
+    void patchGPUTable();
+
     //! Resize internal tables
     /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
      */
@@ -694,6 +735,8 @@ class BondedGroupData
 
     GPUArray<unsigned int> m_condition; //!< Condition variable for rebuilding GPU table on the GPU
     unsigned int m_next_flag;           //!< Next flag value for GPU table rebuild
+
+    GPUArray<unsigned int> m_patch_condition; //!< Set on the GPU when a table patch fails
 #endif
     };
 
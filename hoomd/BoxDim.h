@@ -60,6 +60,10 @@
      - wrap() wraps a vector back into the box and updates an image flag variable appropriately when
    particles cross box boundaries. It does this only for dimensions that are set periodic
 
+    With a nonzero Lees-Edwards offset (setLeesEdwardsOffset()), the periodic images along y are
+   displaced in x by the offset in addition to the xy tilt. minImage(), wrap() and
+   getLatticeVector() apply the offset, makeFraction() and makeCoordinates() do not.
+
     \note minImage() and wrap() only work for particles that have moved up to 1 box image out of the
    box.
 */
@@ -77,6 +81,7 @@ struct
         {
         m_lo = m_hi = m_Linv = m_L = make_scalar3(0, 0, 0);
         m_xz = m_xy = m_yz = Scalar(0.0);
+        m_le_offset = Scalar(0.0);
         m_periodic = make_uchar3(1, 1, 1);
         }
 
@@ -90,6 +95,7 @@ struct
         setL(make_scalar3(Len, Len, Len));
         m_periodic = make_uchar3(1, 1, 1);
         m_xz = m_xy = m_yz = Scalar(0.0);
+        m_le_offset = Scalar(0.0);
         }
 
     //! Constructs a box from -Len_x/2 to Len_x/2 for each dimension
@@ -103,6 +109,7 @@ struct
         setL(make_scalar3(Len_x, Len_y, Len_z));
         m_periodic = make_uchar3(1, 1, 1);
         m_xz = m_xy = m_yz = Scalar(0.0);
+        m_le_offset = Scalar(0.0);
         }
 
     //! Constructs a box from -L/2 to L/2 for each dimension
@@ -114,6 +121,7 @@ struct
         setL(L);
         m_periodic = make_uchar3(1, 1, 1);
         m_xz = m_xy = m_yz = Scalar(0.0);
+        m_le_offset = Scalar(0.0);
         }
 
     //! Constructs a tilted box with edges of length len for each dimension
@@ -126,6 +134,7 @@ struct
         {
         setL(make_scalar3(Len, Len, Len));
         setTiltFactors(xy, xz, yz);
+        m_le_offset = Scalar(0.0);
         m_periodic = make_uchar3(1, 1, 1);
         }
 
@@ -139,6 +148,7 @@ struct
         setLoHi(lo, hi);
         m_periodic = periodic;
         m_xz = m_xy = m_yz = Scalar(0.0);
+        m_le_offset = Scalar(0.0);
         }
 
     //! Get the periodic flags
@@ -250,6 +260,24 @@ struct
         return m_yz;
         }
 
+    //! Set the Lees-Edwards offset
+    /*! \param offset Displacement in x of the periodic image at +y, in addition to the xy tilt
+
+        A nonzero offset shifts the periodic images along y in x by \a offset (Lees-Edwards
+        boundary conditions). Unlike a change of the xy tilt factor, the offset does not change
+        the shape of the box, so steady shear can continue indefinitely without remapping the tilt.
+    */
+    HOSTDEVICE void setLeesEdwardsOffset(const Scalar offset)
+        {
+        m_le_offset = offset;
+        }
+
+    //! Returns the Lees-Edwards offset
+    HOSTDEVICE Scalar getLeesEdwardsOffset() const
+        {
+        return m_le_offset;
+        }
+
     //! Compute fractional coordinates, allowing for a ghost layer
     /*! \param v Vector to scale
         \param ghost_width Width of extra ghost padding layer to take into account (along reciprocal
@@ -316,7 +344,7 @@ struct
             {
             Scalar img = rint(w.y * m_Linv.y);
             w.y -= L.y * img;
-            w.x -= L.y * m_xy * img;
+            w.x -= (L.y * m_xy + m_le_offset) * img;
             }
 
         if (m_periodic.x)
@@ -347,13 +375,13 @@ struct
                 {
                 int i = int(w.y * m_Linv.y + Scalar(0.5));
                 w.y -= (Scalar)i * L.y;
-                w.x -= (Scalar)i * L.y * m_xy;
+                w.x -= (Scalar)i * (L.y * m_xy + m_le_offset);
                 }
             else if (w.y < m_lo.y)
                 {
                 int i = int(-w.y * m_Linv.y + Scalar(0.5));
                 w.y += (Scalar)i * L.y;
-                w.x += (Scalar)i * L.y * m_xy;
+                w.x += (Scalar)i * (L.y * m_xy + m_le_offset);
                 }
             }
 
@@ -427,15 +455,31 @@ struct
             if (((w.y >= m_hi.y + tilt_y) && !flags.y) || flags.y == 1)
                 {
                 w.y -= L.y;
-                w.x -= L.y * m_xy;
+                w.x -= L.y * m_xy + m_le_offset;
                 img.y++;
                 }
             else if (((w.y < m_lo.y + tilt_y) && !flags.y) || flags.y == -1)
                 {
                 w.y += L.y;
-                w.x += L.y * m_xy;
+                w.x += L.y * m_xy + m_le_offset;
                 img.y--;
                 }
+
+            // the Lees-Edwards offset may move the vector out of the box along x
+            if (m_le_offset != Scalar(0.0) && m_periodic.x && !flags.x)
+                {
+                Scalar tilt_x = (m_xz - m_xy * m_yz) * (w.z - origin.z) + m_xy * (w.y - origin.y);
+                if (w.x >= m_hi.x + tilt_x)
+                    {
+                    w.x -= L.x;
+                    img.x++;
+                    }
+                else if (w.x < m_lo.x + tilt_x)
+                    {
+                    w.x += L.x;
+                    img.x--;
+                    }
+                }
             }
 
         if (m_periodic.z)
@@ -576,7 +620,7 @@ struct
             }
         else if (i == 1)
             {
-            return make_scalar3(m_L.y * m_xy, m_L.y, 0.0);
+            return make_scalar3(m_L.y * m_xy + m_le_offset, m_L.y, 0.0);
             }
         else if (i == 2)
             {
@@ -598,7 +642,8 @@ struct
         Scalar yz1 = getTiltFactorYZ();
         Scalar yz2 = other.getTiltFactorYZ();
 
-        return L1 == L2 && xy1 == xy2 && xz1 == xz2 && yz1 == yz2;
+        return L1 == L2 && xy1 == xy2 && xz1 == xz2 && yz1 == yz2
+               && m_le_offset == other.m_le_offset;
         }
 
     HOSTDEVICE bool operator!=(const BoxDim& other) const
@@ -624,6 +669,7 @@ struct
         ar& m_xy;
         ar& m_xz;
         ar& m_yz;
+        ar& m_le_offset;
         ar& m_periodic.x;
         ar& m_periodic.y;
         ar& m_periodic.z;
@@ -631,14 +677,15 @@ struct
 #endif
 
     private:
-    Scalar3 m_lo;      //!< Minimum coords in the box
-    Scalar3 m_hi;      //!< Maximum coords in the box
-    Scalar3 m_L;       //!< L precomputed (used to avoid subtractions in boundary conditions)
-    Scalar3 m_Linv;    //!< 1/L precomputed (used to avoid divisions in boundary conditions)
-    Scalar m_xy;       //!< xy tilt factor
-    Scalar m_xz;       //!< xz tilt factor
-    Scalar m_yz;       //!< yz tilt factor
-    uchar3 m_periodic; //!< 0/1 in each direction to tell if the box is periodic in that direction
+    Scalar3 m_lo;       //!< Minimum coords in the box
+    Scalar3 m_hi;       //!< Maximum coords in the box
+    Scalar3 m_L;        //!< L precomputed (used to avoid subtractions in boundary conditions)
+    Scalar3 m_Linv;     //!< 1/L precomputed (used to avoid divisions in boundary conditions)
+    Scalar m_xy;        //!< xy tilt factor
+    Scalar m_xz;        //!< xz tilt factor
+    Scalar m_yz;        //!< yz tilt factor
+    Scalar m_le_offset; //!< Lees-Edwards offset of the periodic image at +y
+    uchar3 m_periodic;  //!< 0/1 in each direction to tell if the box is periodic in that direction
     };
 
 // undefine HOSTDEVICE so we don't interfere with other headers
@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.cc
+    \brief Defines the BoxResizeUpdaterGPU class
+*/
+
+#include "BoxResizeUpdaterGPU.h"
+#include "BoxResizeUpdaterGPU.cuh"
+
+#include <vector>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition containing the particle data to set the box size on
+    \param box1 Box at the minimum of the variant
+    \param box2 Box at the maximum of the variant
+    \param variant Variant that interpolates between the boxes
+    \param group Particles to scale with the box
+*/
+BoxResizeUpdaterGPU::BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                         pybind11::object box1,
+                                         pybind11::object box2,
+                                         std::shared_ptr<Variant> variant,
+                                         std::shared_ptr<ParticleGroup> group)
+    : BoxResizeUpdater(sysdef, box1, box2, variant, group)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cannot initialize BoxResizeUpdaterGPU on a CPU device.");
+        }
+
+    // initialize autotuners
+    std::vector<unsigned int> valid_params;
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+        valid_params.push_back(block_size);
+
+    m_tuner_scale.reset(
+        new Autotuner(valid_params, 5, 100000, "box_resize_scale", this->m_exec_conf));
+    m_tuner_wrap.reset(
+        new Autotuner(valid_params, 5, 100000, "box_resize_wrap", this->m_exec_conf));
+    }
+
+BoxResizeUpdaterGPU::~BoxResizeUpdaterGPU() { }
+
+/** \param cur_box Global box before the resize
+    \param new_box Global box after the resize
+*/
+void BoxResizeUpdaterGPU::scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box)
+    {
+    std::shared_ptr<ParticleGroup> group = getGroup();
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<int3> d_image(m_pdata->getImages(),
+                              access_location::device,
+                              access_mode::readwrite);
+
+        {
+        ArrayHandle<unsigned int> d_group_members(group->getIndexArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+
+        m_tuner_scale->begin();
+        gpu_box_resize_scale(d_pos.data,
+                             d_group_members.data,
+                             group->getNumMembers(),
+                             cur_box,
+                             new_box,
+                             m_tuner_scale->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_scale->end();
+        }
+
+    m_tuner_wrap->begin();
+    gpu_box_resize_wrap(m_pdata->getN(),
+                        d_pos.data,
+                        d_image.data,
+                        m_pdata->getBox(),
+                        m_tuner_wrap->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_wrap->end();
+    }
+
+void export_BoxResizeUpdaterGPU(py::module& m)
+    {
+    py::class_<BoxResizeUpdaterGPU, BoxResizeUpdater, std::shared_ptr<BoxResizeUpdaterGPU>>(
+        m,
+        "BoxResizeUpdaterGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            pybind11::object,
+                            pybind11::object,
+                            std::shared_ptr<Variant>,
+                            std::shared_ptr<ParticleGroup>>());
+    }
@@ -0,0 +1,31 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __BOX_RESIZE_UPDATER_GPU_CUH__
+#define __BOX_RESIZE_UPDATER_GPU_CUH__
+
+#include "BoxDim.h"
+#include "HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file BoxResizeUpdaterGPU.cuh
+    \brief Declares the GPU kernel drivers used by BoxResizeUpdaterGPU
+*/
+
+//! Scale the positions of the particles in a group from one box to another
+hipError_t gpu_box_resize_scale(Scalar4* d_pos,
+                                const unsigned int* d_group_members,
+                                const unsigned int group_size,
+                                const BoxDim& cur_box,
+                                const BoxDim& new_box,
+                                const unsigned int block_size);
+
+//! Wrap the particles into the local box
+hipError_t gpu_box_resize_wrap(const unsigned int N,
+                               Scalar4* d_pos,
+                               int3* d_image,
+                               const BoxDim& local_box,
+                               const unsigned int block_size);
+
+#endif // __BOX_RESIZE_UPDATER_GPU_CUH__
@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.h
+    \brief Declares the GPU implementation of BoxResizeUpdater
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_HIP
+
+#include "Autotuner.h"
+#include "BoxResizeUpdater.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __BOXRESIZEUPDATER_GPU_H__
+#define __BOXRESIZEUPDATER_GPU_H__
+
+/// Updates the simulation box over time on the GPU
+/** BoxResizeUpdaterGPU scales and wraps the particles in device memory, so box resizes do not
+ * copy the particle data to the host.
+ * \ingroup updaters
+ */
+class PYBIND11_EXPORT BoxResizeUpdaterGPU : public BoxResizeUpdater
+    {
+    public:
+    /// Constructor
+    BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                        pybind11::object box1,
+                        pybind11::object box2,
+                        std::shared_ptr<Variant> variant,
+                        std::shared_ptr<ParticleGroup> group);
+
+    /// Destructor
+    virtual ~BoxResizeUpdaterGPU();
+
+    /// Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        BoxResizeUpdater::setAutotunerParams(enable, period);
+        m_tuner_scale->setPeriod(period);
+        m_tuner_scale->setEnabled(enable);
+        m_tuner_wrap->setPeriod(period);
+        m_tuner_wrap->setEnabled(enable);
+        }
+
+    protected:
+    /// Scale the particles in the group to the new box and wrap all particles into the local box
+    virtual void scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box);
+
+    private:
+    std::unique_ptr<Autotuner> m_tuner_scale; //!< Autotuner for block size (scale kernel)
+    std::unique_ptr<Autotuner> m_tuner_wrap;  //!< Autotuner for block size (wrap kernel)
+    };
+
+/// Export the BoxResizeUpdaterGPU to python
+void export_BoxResizeUpdaterGPU(pybind11::module& m);
+
+#endif // __BOXRESIZEUPDATER_GPU_H__
+
+#endif // ENABLE_HIP
@@ -15,28 +15,17 @@
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
 
+#include "MemoryPool.h"
+
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <stdexcept>
 
-//! Need to define an error checking macro that can be used in .cu files
-#define CHECK_CUDA()                                                         \
-        {                                                                    \
-        hipError_t err = hipDeviceSynchronize();                             \
-        if (err != hipSuccess)                                               \
-            {                                                                \
-            throw std::runtime_error("CUDA Error in CachedAllocator "        \
-                                     + std::string(hipGetErrorString(err))); \
-            }                                                                \
-        err = hipGetLastError();                                             \
-        if (err != hipSuccess)                                               \
-            {                                                                \
-            throw std::runtime_error("CUDA Error in CachedAllocator "        \
-                                     + std::string(hipGetErrorString(err))); \
-            }                                                                \
-        }
-
 //! CachedAllocator: a simple allocator for caching allocation requests
+/*! The cached blocks are drawn from a MemoryPool, which also serves GPUArray and GlobalArray.
+    Blocks evicted from the cache return to the pool.
+*/
 class __attribute__((visibility("default"))) CachedAllocator
     {
     public:
@@ -44,14 +33,15 @@ class __attribute__((visibility("default"))) CachedAllocator
     typedef char value_type;
 
     //! Constructor
-    /*  \param max_cached_bytes Maximum size of cache
+    /*  \param pool Memory pool to allocate from
+     *   \param max_cached_bytes Maximum size of cache
      *   \param cache_reltol Relative tolerance for cache hits
      */
-    CachedAllocator(bool managed,
+    CachedAllocator(MemoryPool& pool,
                     unsigned int max_cached_bytes = 100u * 1024u * 1024u,
                     float cache_reltol = 0.1f)
-        : m_managed(managed), m_num_bytes_tot(0), m_max_cached_bytes(max_cached_bytes),
-          m_cache_reltol(cache_reltol)
+        : m_pool(pool), m_num_bytes_tot(0), m_peak_bytes_tot(0),
+          m_max_cached_bytes(max_cached_bytes), m_cache_reltol(cache_reltol)
         {
         }
 
@@ -67,6 +57,18 @@ class __attribute__((visibility("default"))) CachedAllocator
         m_max_cached_bytes = max_cached_bytes;
         }
 
+    //! Get the number of bytes held in the cache and by outstanding blocks
+    size_t getNumBytes() const
+        {
+        return m_num_bytes_tot;
+        }
+
+    //! Get the largest number of bytes held at once
+    size_t getPeakNumBytes() const
+        {
+        return m_peak_bytes_tot;
+        }
+
     //! Destructor
     virtual ~CachedAllocator()
         {
@@ -106,9 +108,10 @@ class __attribute__((visibility("default"))) CachedAllocator
     typedef std::multimap<std::ptrdiff_t, char*> free_blocks_type;
     typedef std::map<char*, std::ptrdiff_t> allocated_blocks_type;
 
-    bool m_managed; //! True if we use unified memory
+    MemoryPool& m_pool; //! The pool to allocate from
 
     size_t m_num_bytes_tot;
+    size_t m_peak_bytes_tot;
     size_t m_max_cached_bytes;
     float m_cache_reltol;
 
@@ -124,16 +127,14 @@ class __attribute__((visibility("default"))) CachedAllocator
         // deallocate all outstanding blocks in both lists
         for (free_blocks_type::iterator i = m_free_blocks.begin(); i != m_free_blocks.end(); ++i)
             {
-            hipFree((void*)i->second);
-            CHECK_CUDA();
+            m_pool.deallocate((void*)i->second);
             }
 
         for (allocated_blocks_type::iterator i = m_allocated_blocks.begin();
              i != m_allocated_blocks.end();
              ++i)
             {
-            hipFree((void*)i->first);
-            CHECK_CUDA();
+            m_pool.deallocate((void*)i->first);
             }
         }
     };
@@ -197,17 +198,14 @@ template<typename T> T* CachedAllocator::getTemporaryBuffer(size_t num_elements)
     else
         {
         // no allocation of the right size exists
-        // create a new one with cudaMalloc
+        // draw a new one from the pool
         //        m_exec_conf->msg->notice(10) << "CachedAllocator: no free block found;"
         //            << " allocating " << float(num_bytes)/1024.0f/1024.0f << " MB" << std::endl;
 
-        if (m_managed)
-            hipMallocManaged((void**)&result, num_bytes);
-        else
-            hipMalloc((void**)&result, num_bytes);
-        CHECK_CUDA();
+        result = (char*)m_pool.allocate(num_bytes);
 
         m_num_bytes_tot += num_bytes;
+        m_peak_bytes_tot = std::max(m_peak_bytes_tot, m_num_bytes_tot);
 
         while (m_num_bytes_tot > m_max_cached_bytes && m_free_blocks.size())
             {
@@ -218,9 +216,7 @@ template<typename T> T* CachedAllocator::getTemporaryBuffer(size_t num_elements)
             //                << "reached; removing unused block ("
             //                << float(i->first)/1024.0f/1024.0f << " MB)" << std::endl;
 
-            hipFree((void*)i->second);
-
-            CHECK_CUDA();
+            m_pool.deallocate((void*)i->second);
             m_num_bytes_tot -= i->first;
 
             m_free_blocks.erase((++i).base());
@@ -246,6 +242,5 @@ template<typename T> ScopedAllocation<T>::~ScopedAllocation()
     m_alloc.deallocate((char*)data);
     }
 
-#undef CHECK_CUDA
 #endif // ENABLE_HIP
 #endif // __CACHED_ALLOCATOR_H__
@@ -39,6 +39,7 @@ CallbackAnalyzer::~CallbackAnalyzer()
 void CallbackAnalyzer::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
+    py::gil_scoped_acquire acquire;
     callback(timestep);
     }
 
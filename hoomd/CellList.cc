@@ -12,6 +12,11 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -45,6 +50,8 @@ CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
 
     m_actual_width = make_scalar3(0.0, 0.0, 0.0);
     m_ghost_width = make_scalar3(0.0, 0.0, 0.0);
+    m_lees_edwards = false;
+    m_lees_edwards_shift = make_int2(0, 0);
 
     m_pdata->getParticleSortSignal().connect<CellList, &CellList::slotParticlesSorted>(this);
     m_pdata->getBoxChangeSignal().connect<CellList, &CellList::slotBoxChanged>(this);
@@ -159,7 +166,21 @@ void CellList::compute(uint64_t timestep)
         if (new_dim.x == m_dim.x && new_dim.y == m_dim.y && new_dim.z == m_dim.z)
             {
             // number of bins has not changed, only need to update width
+            bool lees_edwards = m_lees_edwards;
+            int2 lees_edwards_shift = m_lees_edwards_shift;
             initializeWidth();
+
+            // a change of the Lees-Edwards offset changes the neighbors across the y boundary
+            if (m_compute_adj_list && m_lees_edwards != lees_edwards)
+                {
+                initializeMemory();
+                }
+            else if (m_compute_adj_list && m_lees_edwards
+                     && (m_lees_edwards_shift.x != lees_edwards_shift.x
+                         || m_lees_edwards_shift.y != lees_edwards_shift.y))
+                {
+                initializeCellAdj();
+                }
             }
         else
             {
@@ -263,6 +284,19 @@ void CellList::initializeWidth()
                                   (L.y + Scalar(2.0) * m_ghost_width.y) / Scalar(m_dim.y),
                                   (L.z + Scalar(2.0) * m_ghost_width.z) / Scalar(m_dim.z));
 
+    // the periodic images along y are displaced by the Lees-Edwards offset, in units of cells
+    // (a nonzero offset requires that the box is not decomposed along x)
+    m_lees_edwards = box.getPeriodic().y && box.getLeesEdwardsOffset() != Scalar(0.0);
+    if (m_lees_edwards)
+        {
+        Scalar offset = box.getLeesEdwardsOffset() * Scalar(m_dim.x) / box.getL().x;
+        m_lees_edwards_shift = make_int2(int(floor(-offset)), int(floor(offset)));
+        }
+    else
+        {
+        m_lees_edwards_shift = make_int2(0, 0);
+        }
+
     // signal that the width has changed
     m_width_change.emit();
 
@@ -306,6 +340,16 @@ void CellList::initializeMemory()
         n_unique_neighbors.x = n_unique_neighbors.x > m_radius * 2 + 1
                                    ? m_radius * 2 + 1
                                    : (unsigned int)n_unique_neighbors.x;
+
+        // the Lees-Edwards offset shifts the rows across the y boundary by a fraction of a cell,
+        // so the rows need one more column (or all of them when a row is reached more than once)
+        if (m_lees_edwards)
+            {
+            if (m_dim.y < m_radius * 2 + 1 || m_dim.x < m_radius * 2 + 2)
+                n_unique_neighbors.x = m_dim.x;
+            else
+                n_unique_neighbors.x = m_radius * 2 + 2;
+            }
         n_unique_neighbors.y = n_unique_neighbors.y > m_radius * 2 + 1
                                    ? m_radius * 2 + 1
                                    : (unsigned int)n_unique_neighbors.y;
@@ -425,7 +469,29 @@ void CellList::initializeCellAdj()
 
                 for (int nk = k - rk; nk <= k + rk; nk++)
                     for (int nj = j - r; nj <= j + r; nj++)
-                        for (int ni = i - r; ni <= i + r; ni++)
+                        {
+                        // rows across the y boundary are shifted by the Lees-Edwards offset,
+                        // every row lists the same number of columns so that all cells have
+                        // the same number of neighbors
+                        int ni_begin = i - r;
+                        int ni_end = i + r;
+                        if (m_lees_edwards && my < 2 * r + 1)
+                            {
+                            ni_begin = 0;
+                            ni_end = mx - 1;
+                            }
+                        else if (m_lees_edwards)
+                            {
+                            int shift = 0;
+                            if (nj >= my)
+                                shift = m_lees_edwards_shift.x;
+                            else if (nj < 0)
+                                shift = m_lees_edwards_shift.y;
+                            ni_begin += shift;
+                            ni_end += shift + 1;
+                            }
+
+                        for (int ni = ni_begin; ni <= ni_end; ni++)
                             {
                             int wrapi = ni % mx;
                             if (wrapi < 0)
@@ -442,6 +508,7 @@ void CellList::initializeCellAdj()
                             unsigned int neigh_cell = m_cell_indexer(wrapi, wrapj, wrapk);
                             adj.push_back(neigh_cell);
                             }
+                        }
 
                 // sort the adj list for each cell
                 sort(adj.begin(), adj.end());
@@ -503,13 +570,15 @@ void CellList::computeCellList()
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
-        {
+    // Find the bin of particle n, or return NOT_BINNED after setting the appropriate condition.
+    const unsigned int NOT_BINNED = 0xffffffff;
+    auto find_bin = [&](unsigned int n, uint3& cond) -> unsigned int
+    {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
             {
-            conditions.y = n + 1;
-            continue;
+            cond.y = n + 1;
+            return NOT_BINNED;
             }
 
         // find the bin each particle belongs in
@@ -525,8 +594,8 @@ void CellList::computeCellList()
             {
             // if a ghost particle is out of bounds, silently ignore it
             if (n < m_pdata->getN())
-                conditions.z = n + 1;
-            continue;
+                cond.z = n + 1;
+            return NOT_BINNED;
             }
 
         // need to handle the case where the particle is exactly at the box hi
@@ -541,19 +610,23 @@ void CellList::computeCellList()
         assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z))
                || n >= m_pdata->getN());
 
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
         // all particles should be in a valid cell
         if (ib < 0 || ib >= (int)m_dim.x || jb < 0 || jb >= (int)m_dim.y || kb < 0
             || kb >= (int)m_dim.z)
             {
             // but ghost particles that are out of range should not produce an error
             if (n < m_pdata->getN())
-                conditions.z = n + 1;
-            continue;
+                cond.z = n + 1;
+            return NOT_BINNED;
             }
 
+        // record its bin
+        return ci(ib, jb, kb);
+    };
+
+    // Store particle n at position offset in the given bin
+    auto store = [&](unsigned int n, unsigned int bin, unsigned int offset, uint3& cond)
+    {
         // setup the flag value to store
         Scalar flag;
         if (m_flag_charge)
@@ -564,8 +637,6 @@ void CellList::computeCellList()
             flag = __int_as_scalar(n);
 
         // store the bin entries
-        unsigned int offset = h_cell_size.data[bin];
-
         if (offset < m_Nmax)
             {
             if (m_compute_xyzf)
@@ -594,11 +665,112 @@ void CellList::computeCellList()
             }
         else
             {
-            conditions.x = max((unsigned int)conditions.x, offset + 1);
+            cond.x = max((unsigned int)cond.x, offset + 1);
             }
+    };
+
+#ifdef ENABLE_TBB
+    // Split the particles into contiguous chunks. Each chunk counts its members per cell, the
+    // counts are scanned over chunks to give every chunk its own write offset in each cell, and the
+    // chunks then scatter in parallel. Particles end up in index order within each cell, exactly as
+    // in the serial loop. Limit the number of chunks so the per chunk counters use no more memory
+    // than one entry per particle.
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(),
+                                     std::max(n_tot_particles / std::max(n_cells, 1u), 1u));
+
+    if (n_chunks > 1)
+        {
+        const unsigned int chunk_size = (n_tot_particles + n_chunks - 1) / n_chunks;
+        m_bin.resize(n_tot_particles);
+        m_chunk_cell_offset.assign(size_t(n_chunks) * n_cells, 0);
+        std::vector<uint3> chunk_conditions(n_chunks, make_uint3(0, 0, 0));
 
-        // increment the cell occupancy counter
-        h_cell_size.data[bin]++;
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                            {
+                            unsigned int* count
+                                = m_chunk_cell_offset.data() + size_t(chunk) * n_cells;
+                            unsigned int last = std::min((chunk + 1) * chunk_size, n_tot_particles);
+                            for (unsigned int n = chunk * chunk_size; n < last; n++)
+                                {
+                                unsigned int bin = find_bin(n, chunk_conditions[chunk]);
+                                m_bin[n] = bin;
+                                if (bin != NOT_BINNED)
+                                    count[bin]++;
+                                }
+                            }
+                    },
+                    tbb::simple_partitioner());
+
+                // exclusive scan of the counts over chunks, per cell
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int bin = r.begin(); bin != r.end(); ++bin)
+                                          {
+                                          unsigned int offset = 0;
+                                          for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+                                              {
+                                              unsigned int& c
+                                                  = m_chunk_cell_offset[size_t(chunk) * n_cells
+                                                                        + bin];
+                                              unsigned int count = c;
+                                              c = offset;
+                                              offset += count;
+                                              }
+                                          h_cell_size.data[bin] = offset;
+                                          }
+                                  });
+
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                            {
+                            unsigned int* offset
+                                = m_chunk_cell_offset.data() + size_t(chunk) * n_cells;
+                            unsigned int last = std::min((chunk + 1) * chunk_size, n_tot_particles);
+                            for (unsigned int n = chunk * chunk_size; n < last; n++)
+                                {
+                                unsigned int bin = m_bin[n];
+                                if (bin != NOT_BINNED)
+                                    store(n, bin, offset[bin]++, chunk_conditions[chunk]);
+                                }
+                            }
+                    },
+                    tbb::simple_partitioner());
+            });
+
+        // the serial loop keeps the condition from the last particle, which has the largest index
+        for (const uint3& c : chunk_conditions)
+            {
+            conditions.x = max(conditions.x, c.x);
+            conditions.y = max(conditions.y, c.y);
+            conditions.z = max(conditions.z, c.z);
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int n = 0; n < n_tot_particles; n++)
+            {
+            unsigned int bin = find_bin(n, conditions);
+            if (bin == NOT_BINNED)
+                continue;
+
+            store(n, bin, h_cell_size.data[bin], conditions);
+
+            // increment the cell occupancy counter
+            h_cell_size.data[bin]++;
+            }
         }
 
         {
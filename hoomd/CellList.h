@@ -11,6 +11,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 /*! \file CellList.h
     \brief Declares the CellList class
@@ -244,6 +245,18 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_dim;
         }
 
+    //! Get the Lees-Edwards shift of the cell columns
+    /*! \returns The shift of the cell columns of the periodic image at +y (x) and at -y (y)
+
+        When the box has a Lees-Edwards offset along a periodic y direction, the cells in column
+        \a i of one row neighbor the columns \a i + shift to \a i + shift + 1 of the adjacent
+        row across the y boundary. The shift is 0 without an offset.
+    */
+    const int2& getLeesEdwardsShift() const
+        {
+        return m_lees_edwards_shift;
+        }
+
     //! Get an indexer to identify cell indices
     const Index3D& getCellIndexer() const
         {
@@ -384,6 +397,8 @@ class PYBIND11_EXPORT CellList : public Compute
     unsigned int m_Nmax;         //!< Numer of spaces reserved for particles in each cell
     Scalar3 m_actual_width;      //!< Actual width of a cell in each direction
     Scalar3 m_ghost_width;       //!< Width of ghost layer sized for (on one side only)
+    bool m_lees_edwards;         //!< True if the box has a Lees-Edwards offset along periodic y
+    int2 m_lees_edwards_shift;   //!< Shift of the cell columns across the y boundary
 
     // values computed by compute()
     GlobalArray<unsigned int> m_cell_size; //!< Number of members in each cell
@@ -397,6 +412,11 @@ class PYBIND11_EXPORT CellList : public Compute
     bool m_sort_cell_list;   //!< If true, sort cell list
     bool m_compute_adj_list; //!< If true, compute the cell adjacency lists
 
+#ifdef ENABLE_TBB
+    std::vector<unsigned int> m_bin;               //!< Bin of each particle (threaded build)
+    std::vector<unsigned int> m_chunk_cell_offset; //!< Per chunk cell counts/offsets
+#endif
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
@@ -69,6 +69,11 @@ void CellListStencil::compute(uint64_t timestep)
     const BoxDim& box = m_pdata->getBox();
     const uchar3 periodic = box.getPeriodic();
 
+    // the rows across the y boundary are shifted by a fraction of a cell with a Lees-Edwards
+    // offset, the stencils include one more cell in +x that covers the fractional part
+    const bool lees_edwards = periodic.y && box.getLeesEdwardsOffset() != Scalar(0.0);
+    const int lees_edwards_extra = lees_edwards ? 1 : 0;
+
     Scalar rstencil_max = *std::max_element(m_rstencil.begin(), m_rstencil.end());
     int3 max_stencil_size = make_int3(static_cast<int>(ceil(rstencil_max / cell_size.x)),
                                       static_cast<int>(ceil(rstencil_max / cell_size.y)),
@@ -87,8 +92,8 @@ void CellListStencil::compute(uint64_t timestep)
         }
 
     // compute the maximum number of bins in the stencil
-    unsigned int max_n_stencil = (2 * max_stencil_size.x + 1) * (2 * max_stencil_size.y + 1)
-                                 * (2 * max_stencil_size.z + 1);
+    unsigned int max_n_stencil = (2 * max_stencil_size.x + 1 + lees_edwards_extra)
+                                 * (2 * max_stencil_size.y + 1) * (2 * max_stencil_size.z + 1);
 
     // reallocate the stencil memory if needed
     if (max_n_stencil * m_pdata->getNTypes() > m_stencil.getNumElements())
@@ -144,7 +149,7 @@ void CellListStencil::compute(uint64_t timestep)
                 if (periodic.y && ((origin.y + j) < 0 || (origin.y + j) >= (int)dim.y))
                     continue;
 
-                for (int i = -stencil_size.x; i <= stencil_size.x; ++i)
+                for (int i = -stencil_size.x; i <= stencil_size.x + lees_edwards_extra; ++i)
                     {
                     if (periodic.z && ((origin.x + i) < 0 || (origin.x + i) >= (int)dim.x))
                         continue;
@@ -155,8 +160,8 @@ void CellListStencil::compute(uint64_t timestep)
 
                     // compute the distance to the closest point in the bin
                     Scalar3 dr = make_scalar3(0.0, 0.0, 0.0);
-                    if (i > 0)
-                        dr.x = (i - 1) * cell_size.x;
+                    if (i > lees_edwards_extra)
+                        dr.x = (i - 1 - lees_edwards_extra) * cell_size.x;
                     else if (i < 0)
                         dr.x = (i + 1) * cell_size.x;
 
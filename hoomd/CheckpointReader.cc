@@ -0,0 +1,643 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointReader.cc
+    \brief Defines the CheckpointReader class
+*/
+
+#include "CheckpointReader.h"
+#include "CheckpointWriter.h"
+#include "GSD.h"
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace hoomd::detail;
+
+namespace py = pybind11;
+
+//! Read a chunk of a checkpoint file
+/*! \param handle Open file
+    \param fname File name for error messages
+    \param name Name of the chunk
+    \param data Buffer to read into
+    \param expected_size Expected size of the chunk in bytes
+
+    Checkpoints always contain every chunk, so a missing chunk or a chunk of the wrong size is an
+    error. Chunks with no elements are not read.
+*/
+static void read_chunk(gsd_handle& handle,
+                       const std::string& fname,
+                       const char* name,
+                       void* data,
+                       size_t expected_size)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&handle, 0, name);
+    if (entry == NULL)
+        throw std::runtime_error("Checkpoint " + fname + " has no chunk " + std::string(name));
+
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != expected_size)
+        {
+        throw std::runtime_error("Checkpoint " + fname + ": expecting "
+                                 + std::to_string(expected_size) + " bytes in " + name
+                                 + " but found " + std::to_string(actual_size));
+        }
+
+    if (actual_size > 0)
+        {
+        int retval = gsd_read_chunk(&handle, data, entry);
+        GSDUtils::checkError(retval, fname);
+        }
+    }
+
+//! Get the number of elements in a chunk of a checkpoint file
+static uint64_t chunk_size(gsd_handle& handle, const std::string& fname, const char* name)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&handle, 0, name);
+    if (entry == NULL)
+        throw std::runtime_error("Checkpoint " + fname + " has no chunk " + std::string(name));
+    return entry->N;
+    }
+
+//! Read a list of names written by CheckpointWriter::writeNames
+static std::vector<std::string>
+read_names(gsd_handle& handle, const std::string& fname, const char* name)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&handle, 0, name);
+    if (entry == NULL)
+        throw std::runtime_error("Checkpoint " + fname + " has no chunk " + std::string(name));
+
+    std::vector<char> data(entry->N * entry->M);
+    read_chunk(handle, fname, name, data.data(), data.size());
+
+    std::vector<std::string> names;
+    for (unsigned int i = 0; i < entry->N; i++)
+        {
+        size_t l = strnlen(&data[i * entry->M], entry->M);
+        names.push_back(std::string(&data[i * entry->M], l));
+        }
+    return names;
+    }
+
+//! Read a chunk of single values into a vector sized to the chunk
+template<class T>
+static void
+read_vector(gsd_handle& handle, const std::string& fname, const char* name, std::vector<T>& data)
+    {
+    data.resize(chunk_size(handle, fname, name));
+    read_chunk(handle, fname, name, data.data(), data.size() * sizeof(T));
+    }
+
+//! Read a bonded group snapshot
+template<class Snapshot>
+static void read_groups(gsd_handle& handle,
+                        const std::string& fname,
+                        const std::string& prefix,
+                        Snapshot& snapshot)
+    {
+    snapshot.type_mapping = read_names(handle, fname, (prefix + "/types").c_str());
+    unsigned int N = (unsigned int)chunk_size(handle, fname, (prefix + "/typeid").c_str());
+    snapshot.resize(N);
+    read_chunk(handle,
+               fname,
+               (prefix + "/typeid").c_str(),
+               snapshot.type_id.data(),
+               N * sizeof(unsigned int));
+    read_chunk(handle,
+               fname,
+               (prefix + "/group").c_str(),
+               snapshot.groups.data(),
+               N * sizeof(snapshot.groups[0]));
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname Base file name of the checkpoint
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                   const std::string& fname)
+    : m_exec_conf(exec_conf), m_fname(fname), m_timestep(0), m_dimensions(3), m_seed(0),
+      m_n_ranks(1), m_N_global(0), m_contiguous_tags(true)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointReader: " << fname << std::endl;
+    m_grid[0] = m_grid[1] = m_grid[2] = 1;
+
+    // report errors on all ranks so that no rank waits for the broadcast
+    std::string error;
+    if (m_exec_conf->isRoot())
+        {
+        try
+            {
+            readRoot();
+            }
+        catch (const std::exception& e)
+            {
+            error = e.what();
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        MPI_Comm comm = m_exec_conf->getMPICommunicator();
+        bcast(error, 0, comm);
+        if (error.empty())
+            {
+            bcast(m_timestep, 0, comm);
+            bcast(m_dimensions, 0, comm);
+            bcast(m_box, 0, comm);
+            bcast(m_seed, 0, comm);
+            bcast(m_n_ranks, 0, comm);
+            for (unsigned int dir = 0; dir < 3; dir++)
+                {
+                bcast(m_grid[dir], 0, comm);
+                bcast(m_fractions[dir], 0, comm);
+                }
+            bcast(m_N_global, 0, comm);
+            bcast(m_contiguous_tags, 0, comm);
+            bcast(m_types, 0, comm);
+            bcast(m_operation_state, 0, comm);
+            }
+        }
+#endif
+
+    if (!error.empty())
+        {
+        m_exec_conf->msg->error() << "read.checkpoint: " << error << std::endl;
+        throw std::runtime_error("Error reading checkpoint");
+        }
+    }
+
+/*! \param handle Handle to open
+    \param fname Name of the file
+*/
+void CheckpointReader::open(gsd_handle& handle, const std::string& fname)
+    {
+    m_exec_conf->msg->notice(3) << "read.checkpoint: open " << fname << std::endl;
+    int retval = gsd_open(&handle, fname.c_str(), GSD_OPEN_READONLY);
+    GSDUtils::checkError(retval, fname);
+
+    if (std::string(handle.header.schema) != std::string("hoomd_checkpoint")
+        || handle.header.schema_version >= gsd_make_version(2, 0))
+        {
+        gsd_close(&handle);
+        throw std::runtime_error("Invalid schema in " + fname);
+        }
+
+    uint8_t precision = 0;
+    const struct gsd_index_entry* entry = gsd_find_chunk(&handle, 0, "checkpoint/precision");
+    if (entry != NULL && entry->N == 1 && entry->type == GSD_TYPE_UINT8)
+        {
+        retval = gsd_read_chunk(&handle, &precision, entry);
+        GSDUtils::checkError(retval, fname);
+        }
+    if (precision != sizeof(Scalar))
+        {
+        gsd_close(&handle);
+        throw std::runtime_error("Checkpoint " + fname
+                                 + " was written in a different precision than this build");
+        }
+    }
+
+void CheckpointReader::readRoot()
+    {
+    std::string fname = CheckpointWriter::getRankFilename(m_fname, 0);
+    gsd_handle handle;
+    open(handle, fname);
+
+    try
+        {
+        read_chunk(handle, fname, "configuration/step", &m_timestep, 8);
+
+        uint8_t dimensions = 3;
+        read_chunk(handle, fname, "configuration/dimensions", &dimensions, 1);
+        m_dimensions = dimensions;
+
+        m_box.resize(6);
+        read_chunk(handle, fname, "configuration/box", m_box.data(), 6 * sizeof(Scalar));
+
+        read_chunk(handle, fname, "checkpoint/seed", &m_seed, 2);
+        uint32_t n_ranks = 1;
+        read_chunk(handle, fname, "checkpoint/n_ranks", &n_ranks, 4);
+        m_n_ranks = n_ranks;
+        uint32_t grid[3];
+        read_chunk(handle, fname, "checkpoint/domain_grid", grid, 12);
+        const char* fraction_names[3]
+            = {"checkpoint/fractions/x", "checkpoint/fractions/y", "checkpoint/fractions/z"};
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            m_grid[dir] = grid[dir];
+            read_vector(handle, fname, fraction_names[dir], m_fractions[dir]);
+            }
+
+        uint32_t N_global = 0;
+        read_chunk(handle, fname, "checkpoint/N_global", &N_global, 4);
+        m_N_global = N_global;
+        uint8_t contiguous_tags = 1;
+        read_chunk(handle, fname, "checkpoint/contiguous_tags", &contiguous_tags, 1);
+        m_contiguous_tags = contiguous_tags;
+
+        m_types = read_names(handle, fname, "particles/types");
+
+        read_groups(handle, fname, "bonds", m_topology.bond_data);
+        read_groups(handle, fname, "angles", m_topology.angle_data);
+        read_groups(handle, fname, "dihedrals", m_topology.dihedral_data);
+        read_groups(handle, fname, "impropers", m_topology.improper_data);
+        read_groups(handle, fname, "pairs", m_topology.pair_data);
+
+        unsigned int n_constraints
+            = (unsigned int)chunk_size(handle, fname, "constraints/value");
+        m_topology.constraint_data.resize(n_constraints);
+        read_chunk(handle,
+                   fname,
+                   "constraints/value",
+                   m_topology.constraint_data.val.data(),
+                   n_constraints * sizeof(Scalar));
+        read_chunk(handle,
+                   fname,
+                   "constraints/group",
+                   m_topology.constraint_data.groups.data(),
+                   n_constraints * sizeof(m_topology.constraint_data.groups[0]));
+
+        uint32_t n_integrators = 0;
+        read_chunk(handle, fname, "integrator/N", &n_integrators, 4);
+        m_integrator_variables.resize(n_integrators);
+        for (unsigned int i = 0; i < n_integrators; i++)
+            {
+            std::string prefix = "integrator/" + std::to_string(i);
+            std::vector<std::string> type = read_names(handle, fname, (prefix + "/type").c_str());
+            m_integrator_variables[i].type = type.empty() ? "" : type[0];
+            read_vector(handle,
+                        fname,
+                        (prefix + "/variables").c_str(),
+                        m_integrator_variables[i].variable);
+            }
+
+        // checkpoints written without a state writer have no operation state
+        if (gsd_find_chunk(&handle, 0, "state/names") != NULL)
+            {
+            for (const auto& name : read_names(handle, fname, "state/names"))
+                read_vector(handle, fname, ("state/" + name).c_str(), m_operation_state[name]);
+            }
+        }
+    catch (...)
+        {
+        gsd_close(&handle);
+        throw;
+        }
+
+    gsd_close(&handle);
+    }
+
+/*! \param handle Open file
+    \param fname Name of the file
+    \param particles Output particles in the order of the file
+    \param accel_set Output flag, true if the accelerations are valid
+*/
+void CheckpointReader::readParticles(gsd_handle& handle,
+                                     const std::string& fname,
+                                     std::vector<pdata_element>& particles,
+                                     bool& accel_set)
+    {
+    uint32_t N = 0;
+    read_chunk(handle, fname, "particles/N", &N, 4);
+    uint8_t accel_set_data = 0;
+    read_chunk(handle, fname, "particles/accel_set", &accel_set_data, 1);
+    accel_set = accel_set_data;
+
+    std::vector<uint32_t> tag(N), typeid_data(N), body(N);
+    std::vector<int3> image(N);
+    std::vector<Scalar> charge(N), diameter(N), mass(N);
+    std::vector<Scalar3> position(N), velocity(N), accel(N), inertia(N);
+    std::vector<Scalar4> orientation(N), angmom(N);
+
+    read_chunk(handle, fname, "particles/tag", tag.data(), N * 4);
+    read_chunk(handle, fname, "particles/typeid", typeid_data.data(), N * 4);
+    read_chunk(handle, fname, "particles/body", body.data(), N * 4);
+    read_chunk(handle, fname, "particles/image", image.data(), N * sizeof(int3));
+    read_chunk(handle, fname, "particles/charge", charge.data(), N * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/diameter", diameter.data(), N * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/mass", mass.data(), N * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/position", position.data(), N * 3 * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/velocity", velocity.data(), N * 3 * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/acceleration", accel.data(), N * 3 * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/moment_inertia", inertia.data(), N * 3 * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/orientation", orientation.data(), N * 4 * sizeof(Scalar));
+    read_chunk(handle, fname, "particles/angmom", angmom.data(), N * 4 * sizeof(Scalar));
+
+    particles.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        pdata_element& p = particles[i];
+        p.pos = make_scalar4(position[i].x,
+                             position[i].y,
+                             position[i].z,
+                             __int_as_scalar(typeid_data[i]));
+        p.vel = make_scalar4(velocity[i].x, velocity[i].y, velocity[i].z, mass[i]);
+        p.accel = accel[i];
+        p.charge = charge[i];
+        p.diameter = diameter[i];
+        p.image = image[i];
+        p.body = body[i];
+        p.orientation = orientation[i];
+        p.angmom = angmom[i];
+        p.inertia = inertia[i];
+        p.tag = tag[i];
+        }
+    }
+
+/*! \param dir Direction (0, 1, or 2 for x, y, or z)
+    \returns The fraction of the box in each domain, in the form taken by the domain_decomposition
+             argument of the Python State
+*/
+std::vector<Scalar> CheckpointReader::getFractions(unsigned int dir) const
+    {
+    if (dir >= 3)
+        throw std::invalid_argument("Direction must be 0, 1, or 2");
+
+    std::vector<Scalar> fractions;
+    for (unsigned int i = 1; i < m_fractions[dir].size(); i++)
+        fractions.push_back(m_fractions[dir][i] - m_fractions[dir][i - 1]);
+    return fractions;
+    }
+
+/*! Each rank can read its own file when the checkpoint was written by the same number of ranks
+    and the particle tags need not be compacted.
+*/
+bool CheckpointReader::canRestoreLocal() const
+    {
+    return m_n_ranks == m_exec_conf->getNRanks() && m_contiguous_tags;
+    }
+
+/*! \param with_particles When true, read the particles of all ranks on the root rank
+    \returns A snapshot of the checkpoint
+
+    Without particles, the snapshot holds the box and the type names of the particles and the
+    bonded groups, which is enough to set up the domain decomposition before restoreLocal().
+
+    With particles, the snapshot is complete. Particles are ordered by tag and the bonded groups
+    refer to the particles by their snapshot index, as in SystemDefinition::takeSnapshot().
+*/
+std::shared_ptr<SnapshotSystemData<Scalar>> CheckpointReader::getSnapshot(bool with_particles)
+    {
+    auto snapshot = std::make_shared<SnapshotSystemData<Scalar>>();
+    snapshot->dimensions = m_dimensions;
+    if (m_box.size() == 6)
+        {
+        snapshot->global_box = BoxDim(m_box[0], m_box[1], m_box[2]);
+        snapshot->global_box.setTiltFactors(m_box[3], m_box[4], m_box[5]);
+        }
+    snapshot->particle_data.type_mapping = m_types;
+
+    if (!m_exec_conf->isRoot())
+        return snapshot;
+
+    if (!with_particles)
+        {
+        snapshot->bond_data.type_mapping = m_topology.bond_data.type_mapping;
+        snapshot->angle_data.type_mapping = m_topology.angle_data.type_mapping;
+        snapshot->dihedral_data.type_mapping = m_topology.dihedral_data.type_mapping;
+        snapshot->improper_data.type_mapping = m_topology.improper_data.type_mapping;
+        snapshot->pair_data.type_mapping = m_topology.pair_data.type_mapping;
+        return snapshot;
+        }
+
+    std::vector<pdata_element> all_particles;
+    bool accel_set = false;
+    Scalar3 origin = make_scalar3(0, 0, 0);
+    int3 origin_image = make_int3(0, 0, 0);
+    for (unsigned int rank = 0; rank < m_n_ranks; rank++)
+        {
+        std::string fname = CheckpointWriter::getRankFilename(m_fname, rank);
+        gsd_handle handle;
+        open(handle, fname);
+        try
+            {
+            std::vector<pdata_element> particles;
+            readParticles(handle, fname, particles, accel_set);
+            all_particles.insert(all_particles.end(), particles.begin(), particles.end());
+            read_chunk(handle, fname, "checkpoint/origin", &origin, sizeof(Scalar3));
+            read_chunk(handle, fname, "checkpoint/origin_image", &origin_image, sizeof(int3));
+            }
+        catch (...)
+            {
+            gsd_close(&handle);
+            throw;
+            }
+        gsd_close(&handle);
+        }
+
+    if (all_particles.size() != m_N_global)
+        {
+        throw std::runtime_error("Checkpoint " + m_fname + " holds "
+                                 + std::to_string(all_particles.size()) + " particles, expected "
+                                 + std::to_string(m_N_global));
+        }
+
+    std::sort(all_particles.begin(),
+              all_particles.end(),
+              [](const pdata_element& a, const pdata_element& b) { return a.tag < b.tag; });
+
+    // snapshot index of each tag, only needed when tags are unused
+    std::map<unsigned int, unsigned int> index;
+
+    SnapshotParticleData<Scalar>& pdata = snapshot->particle_data;
+    pdata.resize(m_N_global);
+    pdata.is_accel_set = accel_set;
+    const BoxDim& box = snapshot->global_box;
+    for (unsigned int i = 0; i < m_N_global; i++)
+        {
+        const pdata_element& p = all_particles[i];
+        if (!m_contiguous_tags)
+            index[p.tag] = i;
+
+        // undo the shift of the origin, as in ParticleData::takeSnapshot()
+        Scalar3 pos = make_scalar3(p.pos.x, p.pos.y, p.pos.z) - origin;
+        int3 image = p.image;
+        image.x -= origin_image.x;
+        image.y -= origin_image.y;
+        image.z -= origin_image.z;
+        box.wrap(pos, image);
+
+        pdata.pos[i] = vec3<Scalar>(pos);
+        pdata.vel[i] = vec3<Scalar>(p.vel.x, p.vel.y, p.vel.z);
+        pdata.accel[i] = vec3<Scalar>(p.accel);
+        pdata.type[i] = __scalar_as_int(p.pos.w);
+        pdata.mass[i] = p.vel.w;
+        pdata.charge[i] = p.charge;
+        pdata.diameter[i] = p.diameter;
+        pdata.image[i] = image;
+        pdata.body[i] = p.body;
+        pdata.orientation[i] = quat<Scalar>(p.orientation);
+        pdata.angmom[i] = quat<Scalar>(p.angmom);
+        pdata.inertia[i] = vec3<Scalar>(p.inertia);
+        }
+
+    snapshot->bond_data = m_topology.bond_data;
+    snapshot->angle_data = m_topology.angle_data;
+    snapshot->dihedral_data = m_topology.dihedral_data;
+    snapshot->improper_data = m_topology.improper_data;
+    snapshot->constraint_data = m_topology.constraint_data;
+    snapshot->pair_data = m_topology.pair_data;
+
+    if (!m_contiguous_tags)
+        {
+        // rigid bodies and bonded groups refer to particles by tag
+        for (unsigned int i = 0; i < m_N_global; i++)
+            {
+            if (pdata.body[i] < MIN_FLOPPY)
+                pdata.body[i] = index.at(pdata.body[i]);
+            }
+
+        auto remap = [&index](auto& groups, unsigned int group_size)
+        {
+            for (auto& g : groups)
+                for (unsigned int j = 0; j < group_size; j++)
+                    g.tag[j] = index.at(g.tag[j]);
+        };
+        remap(snapshot->bond_data.groups, 2);
+        remap(snapshot->angle_data.groups, 3);
+        remap(snapshot->dihedral_data.groups, 4);
+        remap(snapshot->improper_data.groups, 4);
+        remap(snapshot->constraint_data.groups, 2);
+        remap(snapshot->pair_data.groups, 2);
+        }
+
+    return snapshot;
+    }
+
+/*! \param sysdef System definition to restore. It must have the domain decomposition of the
+           checkpoint.
+
+    Collective call. Each rank reads the particles from its own file, so the particles are in
+    the domain of the rank that wrote them, up to the rounding of the domain boundaries. The
+    Communicator moves any particles that are not before the first step.
+*/
+void CheckpointReader::restoreLocal(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    if (!canRestoreLocal())
+        {
+        throw std::runtime_error("The ranks cannot read their own particles from this checkpoint");
+        }
+
+    unsigned int rank = m_exec_conf->getRank();
+    std::string fname = CheckpointWriter::getRankFilename(m_fname, rank);
+    std::vector<pdata_element> particles;
+    bool accel_set = false;
+    Scalar3 origin = make_scalar3(0, 0, 0);
+    int3 origin_image = make_int3(0, 0, 0);
+
+    std::string error;
+    try
+        {
+        gsd_handle handle;
+        open(handle, fname);
+        try
+            {
+            uint32_t file_rank = 0;
+            read_chunk(handle, fname, "checkpoint/rank", &file_rank, 4);
+            if (file_rank != rank)
+                throw std::runtime_error("Checkpoint " + fname + " was written by another rank");
+
+            readParticles(handle, fname, particles, accel_set);
+            read_chunk(handle, fname, "checkpoint/origin", &origin, sizeof(Scalar3));
+            read_chunk(handle, fname, "checkpoint/origin_image", &origin_image, sizeof(int3));
+            }
+        catch (...)
+            {
+            gsd_close(&handle);
+            throw;
+            }
+        gsd_close(&handle);
+
+        for (const auto& p : particles)
+            {
+            if (p.tag >= m_N_global)
+                throw std::runtime_error("Checkpoint " + fname + " has invalid particle tags");
+            }
+        }
+    catch (const std::exception& e)
+        {
+        error = e.what();
+        }
+
+    // stop on all ranks when any rank failed to read its file
+    int failed = !error.empty();
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &failed,
+                      1,
+                      MPI_INT,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    if (failed)
+        {
+        if (!error.empty())
+            m_exec_conf->msg->error() << "read.checkpoint: " << error << std::endl;
+        throw std::runtime_error("Error reading checkpoint");
+        }
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->initializeFromLocalParticles(particles, m_N_global, accel_set);
+    pdata->setOrigin(origin, origin_image);
+
+    // the topology is broadcast from the root rank, each rank keeps the groups of its particles
+    sysdef->getBondData()->initializeFromSnapshot(m_topology.bond_data);
+    sysdef->getAngleData()->initializeFromSnapshot(m_topology.angle_data);
+    sysdef->getDihedralData()->initializeFromSnapshot(m_topology.dihedral_data);
+    sysdef->getImproperData()->initializeFromSnapshot(m_topology.improper_data);
+    sysdef->getConstraintData()->initializeFromSnapshot(m_topology.constraint_data);
+    sysdef->getPairData()->initializeFromSnapshot(m_topology.pair_data);
+    }
+
+/*! \param sysdef System definition to restore
+
+    Collective call. Integrators that register with the IntegratorData of \a sysdef after this
+    call read the variables of the checkpoint.
+*/
+void CheckpointReader::restoreIntegratorData(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::vector<IntegratorVariables> variables = m_integrator_variables;
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        bcast(variables, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    std::shared_ptr<IntegratorData> integrator_data = sysdef->getIntegratorData();
+    integrator_data->load((unsigned int)variables.size());
+    for (unsigned int i = 0; i < variables.size(); i++)
+        integrator_data->setIntegratorVariables(i, variables[i]);
+    }
+
+/*! \returns A dict of names and lists of floats
+ */
+py::dict CheckpointReader::getOperationState() const
+    {
+    py::dict state;
+    for (const auto& item : m_operation_state)
+        state[py::str(item.first)] = py::cast(item.second);
+    return state;
+    }
+
+void export_CheckpointReader(py::module& m)
+    {
+    py::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(m, "CheckpointReader")
+        .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const std::string&>())
+        .def("getTimeStep", &CheckpointReader::getTimeStep)
+        .def("getSeed", &CheckpointReader::getSeed)
+        .def("getNRanks", &CheckpointReader::getNRanks)
+        .def("getDomainGrid", &CheckpointReader::getDomainGrid)
+        .def("getFractions", &CheckpointReader::getFractions)
+        .def("canRestoreLocal", &CheckpointReader::canRestoreLocal)
+        .def("getSnapshot", &CheckpointReader::getSnapshot)
+        .def("restoreLocal", &CheckpointReader::restoreLocal)
+        .def("restoreIntegratorData", &CheckpointReader::restoreIntegratorData)
+        .def("getOperationState", &CheckpointReader::getOperationState);
+    }
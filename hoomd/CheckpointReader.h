@@ -0,0 +1,131 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file CheckpointReader.h
+    \brief Declares the CheckpointReader class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "IntegratorData.h"
+#include "SnapshotSystemData.h"
+#include "SystemDefinition.h"
+#include "hoomd/extern/gsd.h"
+
+#include <map>
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+//! Read checkpoints written by CheckpointWriter
+/*! The constructor reads the global configuration, the topology, the integrator variables, and
+    the operation state from the file of rank 0 on the root rank and broadcasts the global
+    configuration and the operation state.
+
+    When the checkpoint was written by the same number of ranks as the current execution
+    configuration (canRestoreLocal()), put the state together with getSnapshot(false), which holds
+    the box and the type names but no particles or groups, and the domain decomposition from
+    getDomainGrid() and getFractions(). restoreLocal() then reads the particles of each rank from
+    its own file and places them without communicating particle data. Only the topology is
+    broadcast, as in any initialization from a snapshot.
+
+    Otherwise, getSnapshot(true) reads the particles of all ranks on the root rank into a complete
+    snapshot, and the usual initialization from the snapshot distributes them to the new domains.
+
+    In both cases, call restoreIntegratorData() before the integrators are created.
+*/
+class PYBIND11_EXPORT CheckpointReader
+    {
+    public:
+    //! Constructor
+    /*! \param exec_conf Execution configuration
+        \param fname Base file name of the checkpoint
+     */
+    CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                     const std::string& fname);
+
+    //! Get the time step of the checkpoint
+    uint64_t getTimeStep() const
+        {
+        return m_timestep;
+        }
+
+    //! Get the random number seed of the checkpoint
+    uint16_t getSeed() const
+        {
+        return m_seed;
+        }
+
+    //! Get the number of ranks that wrote the checkpoint
+    unsigned int getNRanks() const
+        {
+        return m_n_ranks;
+        }
+
+    //! Get the number of domains in the x, y, and z directions
+    pybind11::tuple getDomainGrid() const
+        {
+        return pybind11::make_tuple(m_grid[0], m_grid[1], m_grid[2]);
+        }
+
+    //! Get the fraction of the box in each domain along a direction
+    std::vector<Scalar> getFractions(unsigned int dir) const;
+
+    //! Test if the ranks can read their own particles
+    bool canRestoreLocal() const;
+
+    //! Get a snapshot of the checkpoint
+    std::shared_ptr<SnapshotSystemData<Scalar>> getSnapshot(bool with_particles);
+
+    //! Read the particles of each rank and the topology into the system
+    void restoreLocal(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Set the integrator variables of the checkpoint
+    void restoreIntegratorData(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Get the operation state written by the state writer
+    pybind11::dict getOperationState() const;
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+    std::string m_fname;                                       //!< Base file name
+
+    uint64_t m_timestep;                //!< Time step of the checkpoint
+    unsigned int m_dimensions;          //!< Dimensionality of the system
+    std::vector<Scalar> m_box;          //!< Box lengths and tilt factors
+    uint16_t m_seed;                    //!< Random number seed
+    unsigned int m_n_ranks;             //!< Number of ranks that wrote the checkpoint
+    unsigned int m_grid[3];             //!< Domain grid
+    std::vector<Scalar> m_fractions[3]; //!< Cumulative domain fractions
+    unsigned int m_N_global;            //!< Global number of particles
+    bool m_contiguous_tags;             //!< True when the particle tags are 0 to N_global - 1
+    std::vector<std::string> m_types;   //!< Particle type names
+
+    //! Topology of the checkpoint, only on the root rank
+    SnapshotSystemData<Scalar> m_topology;
+
+    //! Integrator variables, only on the root rank
+    std::vector<IntegratorVariables> m_integrator_variables;
+
+    //! Operation state
+    std::map<std::string, std::vector<double>> m_operation_state;
+
+    //! Open the file of a rank and check its schema and precision
+    void open(gsd_handle& handle, const std::string& fname);
+
+    //! Read the header, topology, and state from the file of rank 0
+    void readRoot();
+
+    //! Read the particles of one file
+    void readParticles(gsd_handle& handle,
+                       const std::string& fname,
+                       std::vector<pdata_element>& particles,
+                       bool& accel_set);
+    };
+
+//! Exports the CheckpointReader class to python
+void export_CheckpointReader(pybind11::module& m);
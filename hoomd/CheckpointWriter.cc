@@ -0,0 +1,395 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointWriter.cc
+    \brief Defines the CheckpointWriter class
+*/
+
+#include "CheckpointWriter.h"
+#include "GSD.h"
+#include "HOOMDVersion.h"
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+using namespace hoomd::detail;
+
+namespace py = pybind11;
+
+#ifdef SINGLE_PRECISION
+static const gsd_type gsd_scalar_type = GSD_TYPE_FLOAT;
+#else
+static const gsd_type gsd_scalar_type = GSD_TYPE_DOUBLE;
+#endif
+
+/*! \param sysdef System definition to write
+    \param fname Base file name of the checkpoint
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                   const std::string& fname)
+    : Analyzer(sysdef), m_fname(fname), m_num_writes(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << fname << std::endl;
+    m_state_writer = py::none();
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << std::endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    All ranks must call analyze(), as the topology is gathered on the root rank.
+*/
+void CheckpointWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    if (m_prof)
+        m_prof->push("Checkpoint");
+
+    bool root = m_exec_conf->isRoot();
+    std::string fname = getRankFilename(m_fname, m_exec_conf->getRank());
+    m_tmp_fname = fname + ".tmp";
+
+    std::ostringstream application;
+    application << "HOOMD-blue " << HOOMD_VERSION;
+    int retval = gsd_create_and_open(&m_handle,
+                                     m_tmp_fname.c_str(),
+                                     application.str().c_str(),
+                                     "hoomd_checkpoint",
+                                     gsd_make_version(1, 0),
+                                     GSD_OPEN_APPEND,
+                                     0);
+    GSDUtils::checkError(retval, m_tmp_fname);
+
+    writeConfiguration(timestep);
+    writeParticles();
+
+    // all ranks take part in gathering the topology
+    writeTopology(root);
+
+    if (root)
+        {
+        writeIntegratorVariables();
+        writeOperationState();
+        }
+
+    retval = gsd_end_frame(&m_handle);
+    GSDUtils::checkError(retval, m_tmp_fname);
+    retval = gsd_close(&m_handle);
+    GSDUtils::checkError(retval, m_tmp_fname);
+
+    // replace the previous checkpoint only once the new one is complete
+    if (std::rename(m_tmp_fname.c_str(), fname.c_str()) != 0)
+        {
+        throw std::runtime_error("Checkpoint: " + std::string(strerror(errno)) + " - " + fname);
+        }
+
+    m_num_writes++;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void CheckpointWriter::writeChunk(const char* name,
+                                  gsd_type type,
+                                  uint64_t N,
+                                  uint32_t M,
+                                  const void* data)
+    {
+    m_exec_conf->msg->notice(10) << "Checkpoint: writing " << name << std::endl;
+    int retval = gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+    GSDUtils::checkError(retval, m_tmp_fname);
+    }
+
+/*! Names are stored as rows of a character matrix, as in the GSD HOOMD schema.
+ */
+void CheckpointWriter::writeNames(const char* name, const std::vector<std::string>& names)
+    {
+    size_t max_len = 0;
+    for (const auto& s : names)
+        max_len = std::max(max_len, s.size());
+    max_len += 1; // for null
+
+    std::vector<char> data(max_len * names.size(), 0);
+    for (unsigned int i = 0; i < names.size(); i++)
+        strncpy(&data[max_len * i], names[i].c_str(), max_len);
+    writeChunk(name, GSD_TYPE_UINT8, names.size(), (uint32_t)max_len, data.data());
+    }
+
+void CheckpointWriter::writeConfiguration(uint64_t timestep)
+    {
+    writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, &timestep);
+
+    uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
+    writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, &dimensions);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    Scalar3 L = box.getL();
+    Scalar box_data[6] = {L.x,
+                          L.y,
+                          L.z,
+                          box.getTiltFactorXY(),
+                          box.getTiltFactorXZ(),
+                          box.getTiltFactorYZ()};
+    writeChunk("configuration/box", gsd_scalar_type, 6, 1, box_data);
+
+    uint8_t precision = (uint8_t)sizeof(Scalar);
+    writeChunk("checkpoint/precision", GSD_TYPE_UINT8, 1, 1, &precision);
+
+    uint32_t rank = m_exec_conf->getRank();
+    uint32_t n_ranks = m_exec_conf->getNRanks();
+    writeChunk("checkpoint/rank", GSD_TYPE_UINT32, 1, 1, &rank);
+    writeChunk("checkpoint/n_ranks", GSD_TYPE_UINT32, 1, 1, &n_ranks);
+
+    uint32_t grid[3] = {1, 1, 1};
+    std::vector<Scalar> fractions[3];
+#ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid_size = decomposition->getGridSize();
+        grid[0] = grid_size.x;
+        grid[1] = grid_size.y;
+        grid[2] = grid_size.z;
+        for (unsigned int dir = 0; dir < 3; dir++)
+            fractions[dir] = decomposition->getCumulativeFractions(dir);
+        }
+#endif
+    writeChunk("checkpoint/domain_grid", GSD_TYPE_UINT32, 3, 1, grid);
+    const char* fraction_names[3]
+        = {"checkpoint/fractions/x", "checkpoint/fractions/y", "checkpoint/fractions/z"};
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        if (fractions[dir].empty())
+            fractions[dir] = {0, 1};
+        writeChunk(fraction_names[dir],
+                   gsd_scalar_type,
+                   fractions[dir].size(),
+                   1,
+                   fractions[dir].data());
+        }
+
+    // positions are stored relative to the origin, which the reader restores
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 origin_image = m_pdata->getOriginImage();
+    writeChunk("checkpoint/origin", gsd_scalar_type, 1, 3, &origin);
+    writeChunk("checkpoint/origin_image", GSD_TYPE_INT32, 1, 3, &origin_image);
+
+    uint16_t seed = m_sysdef->getSeed();
+    writeChunk("checkpoint/seed", GSD_TYPE_UINT16, 1, 1, &seed);
+
+    uint32_t N_global = m_pdata->getNGlobal();
+    writeChunk("checkpoint/N_global", GSD_TYPE_UINT32, 1, 1, &N_global);
+
+    // the reader can only place the particles on their ranks when no tags are unused
+    uint8_t contiguous_tags = N_global == 0 || m_pdata->getMaximumTag() + 1 == N_global;
+    writeChunk("checkpoint/contiguous_tags", GSD_TYPE_UINT8, 1, 1, &contiguous_tags);
+    }
+
+void CheckpointWriter::writeParticles()
+    {
+    unsigned int N = m_pdata->getN();
+    uint32_t N_local = N;
+    writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, &N_local);
+    writeNames("particles/types", m_pdata->getTypeMapping());
+
+    uint8_t accel_set = m_pdata->isAccelSet();
+    writeChunk("particles/accel_set", GSD_TYPE_UINT8, 1, 1, &accel_set);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
+                                 access_location::host,
+                                 access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // the arrays without packed values are written directly
+    writeChunk("particles/tag", GSD_TYPE_UINT32, N, 1, h_tag.data);
+    writeChunk("particles/charge", gsd_scalar_type, N, 1, h_charge.data);
+    writeChunk("particles/diameter", gsd_scalar_type, N, 1, h_diameter.data);
+    writeChunk("particles/body", GSD_TYPE_UINT32, N, 1, h_body.data);
+    writeChunk("particles/image", GSD_TYPE_INT32, N, 3, h_image.data);
+    writeChunk("particles/orientation", gsd_scalar_type, N, 4, h_orientation.data);
+    writeChunk("particles/angmom", gsd_scalar_type, N, 4, h_angmom.data);
+
+    std::vector<Scalar> vec3_data(N * 3);
+    std::vector<Scalar> scalar_data(N);
+    std::vector<uint32_t> typeid_data(N);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3_data[i * 3 + 0] = h_pos.data[i].x;
+        vec3_data[i * 3 + 1] = h_pos.data[i].y;
+        vec3_data[i * 3 + 2] = h_pos.data[i].z;
+        typeid_data[i] = __scalar_as_int(h_pos.data[i].w);
+        }
+    writeChunk("particles/position", gsd_scalar_type, N, 3, vec3_data.data());
+    writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, typeid_data.data());
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3_data[i * 3 + 0] = h_vel.data[i].x;
+        vec3_data[i * 3 + 1] = h_vel.data[i].y;
+        vec3_data[i * 3 + 2] = h_vel.data[i].z;
+        scalar_data[i] = h_vel.data[i].w;
+        }
+    writeChunk("particles/velocity", gsd_scalar_type, N, 3, vec3_data.data());
+    writeChunk("particles/mass", gsd_scalar_type, N, 1, scalar_data.data());
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3_data[i * 3 + 0] = h_accel.data[i].x;
+        vec3_data[i * 3 + 1] = h_accel.data[i].y;
+        vec3_data[i * 3 + 2] = h_accel.data[i].z;
+        }
+    writeChunk("particles/acceleration", gsd_scalar_type, N, 3, vec3_data.data());
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3_data[i * 3 + 0] = h_inertia.data[i].x;
+        vec3_data[i * 3 + 1] = h_inertia.data[i].y;
+        vec3_data[i * 3 + 2] = h_inertia.data[i].z;
+        }
+    writeChunk("particles/moment_inertia", gsd_scalar_type, N, 3, vec3_data.data());
+    }
+
+/*! \param root True on the root rank, which writes the gathered groups
+ */
+void CheckpointWriter::writeTopology(bool root)
+    {
+    BondData::Snapshot bond_data;
+    AngleData::Snapshot angle_data;
+    DihedralData::Snapshot dihedral_data;
+    ImproperData::Snapshot improper_data;
+    ConstraintData::Snapshot constraint_data;
+    PairData::Snapshot pair_data;
+
+    m_sysdef->getBondData()->takeSnapshot(bond_data);
+    m_sysdef->getAngleData()->takeSnapshot(angle_data);
+    m_sysdef->getDihedralData()->takeSnapshot(dihedral_data);
+    m_sysdef->getImproperData()->takeSnapshot(improper_data);
+    m_sysdef->getConstraintData()->takeSnapshot(constraint_data);
+    m_sysdef->getPairData()->takeSnapshot(pair_data);
+
+    if (!root)
+        return;
+
+    writeNames("bonds/types", bond_data.type_mapping);
+    writeChunk("bonds/typeid", GSD_TYPE_UINT32, bond_data.size, 1, bond_data.type_id.data());
+    writeChunk("bonds/group", GSD_TYPE_UINT32, bond_data.size, 2, bond_data.groups.data());
+
+    writeNames("angles/types", angle_data.type_mapping);
+    writeChunk("angles/typeid", GSD_TYPE_UINT32, angle_data.size, 1, angle_data.type_id.data());
+    writeChunk("angles/group", GSD_TYPE_UINT32, angle_data.size, 3, angle_data.groups.data());
+
+    writeNames("dihedrals/types", dihedral_data.type_mapping);
+    writeChunk("dihedrals/typeid",
+               GSD_TYPE_UINT32,
+               dihedral_data.size,
+               1,
+               dihedral_data.type_id.data());
+    writeChunk("dihedrals/group",
+               GSD_TYPE_UINT32,
+               dihedral_data.size,
+               4,
+               dihedral_data.groups.data());
+
+    writeNames("impropers/types", improper_data.type_mapping);
+    writeChunk("impropers/typeid",
+               GSD_TYPE_UINT32,
+               improper_data.size,
+               1,
+               improper_data.type_id.data());
+    writeChunk("impropers/group",
+               GSD_TYPE_UINT32,
+               improper_data.size,
+               4,
+               improper_data.groups.data());
+
+    writeChunk("constraints/value",
+               gsd_scalar_type,
+               constraint_data.size,
+               1,
+               constraint_data.val.data());
+    writeChunk("constraints/group",
+               GSD_TYPE_UINT32,
+               constraint_data.size,
+               2,
+               constraint_data.groups.data());
+
+    writeNames("pairs/types", pair_data.type_mapping);
+    writeChunk("pairs/typeid", GSD_TYPE_UINT32, pair_data.size, 1, pair_data.type_id.data());
+    writeChunk("pairs/group", GSD_TYPE_UINT32, pair_data.size, 2, pair_data.groups.data());
+    }
+
+void CheckpointWriter::writeIntegratorVariables()
+    {
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    uint32_t n = integrator_data->getNumIntegrators();
+    writeChunk("integrator/N", GSD_TYPE_UINT32, 1, 1, &n);
+
+    for (unsigned int i = 0; i < n; i++)
+        {
+        const IntegratorVariables& v = integrator_data->getIntegratorVariables(i);
+        std::string prefix = "integrator/" + std::to_string(i);
+        writeNames((prefix + "/type").c_str(), {v.type});
+        writeChunk((prefix + "/variables").c_str(),
+                   gsd_scalar_type,
+                   v.variable.size(),
+                   1,
+                   v.variable.data());
+        }
+    }
+
+void CheckpointWriter::writeOperationState()
+    {
+    py::gil_scoped_acquire acquire;
+    if (m_state_writer.is_none())
+        return;
+
+    py::dict state = m_state_writer.attr("state")();
+    std::vector<std::string> names;
+    for (auto item : state)
+        {
+        std::string name = py::cast<std::string>(item.first);
+        std::vector<double> values = py::cast<std::vector<double>>(item.second);
+        writeChunk(("state/" + name).c_str(), GSD_TYPE_DOUBLE, values.size(), 1, values.data());
+        names.push_back(name);
+        }
+    writeNames("state/names", names);
+    }
+
+void export_CheckpointWriter(py::module& m)
+    {
+    py::class_<CheckpointWriter, Analyzer, std::shared_ptr<CheckpointWriter>>(m,
+                                                                              "CheckpointWriter")
+        .def(py::init<std::shared_ptr<SystemDefinition>, std::string>())
+        .def_property("state_writer",
+                      &CheckpointWriter::getStateWriter,
+                      &CheckpointWriter::setStateWriter)
+        .def_property_readonly("num_writes", &CheckpointWriter::getNumWrites)
+        .def_static("getRankFilename", &CheckpointWriter::getRankFilename);
+    }
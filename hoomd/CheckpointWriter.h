@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file CheckpointWriter.h
+    \brief Declares the CheckpointWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+#include "hoomd/extern/gsd.h"
+
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+//! Write checkpoints that each rank saves and restores on its own
+/*! Writing a checkpoint with GSDDumpWriter gathers all particles on the root rank and converts them
+    to single precision. CheckpointWriter instead writes the particles owned by each rank to the
+    file getRankFilename() without communicating particle data. The files hold the particle data in
+    the precision of the simulation, together with the domain decomposition, the origin of the box,
+    and the global number of particles, so that CheckpointReader reproduces the state exactly.
+
+    The file of the root rank also stores the topology (the only data gathered), the integrator
+    variables, the random number seed, and the operation state that the state writer provides.
+    The state writer is a Python object with a method state() that returns a dict of names and
+    lists of floats, such as the HPMC move sizes.
+
+    Each rank writes its checkpoint to a temporary file and renames it over the previous one, so
+    an interrupted write leaves the previous checkpoint intact.
+
+    The files use the GSD container format with the schema hoomd_checkpoint. They are not HOOMD
+    schema GSD files and cannot be read with GSDReader.
+*/
+class PYBIND11_EXPORT CheckpointWriter : public Analyzer
+    {
+    public:
+    //! Constructor
+    /*! \param sysdef System definition to write
+        \param fname Base file name of the checkpoint
+     */
+    CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname);
+
+    //! Destructor
+    ~CheckpointWriter();
+
+    //! Write a checkpoint
+    void analyze(uint64_t timestep);
+
+    //! Set the Python object that provides the operation state
+    void setStateWriter(pybind11::object state_writer)
+        {
+        m_state_writer = state_writer;
+        }
+
+    //! Get the Python object that provides the operation state
+    pybind11::object getStateWriter()
+        {
+        return m_state_writer;
+        }
+
+    //! Get the file name of the checkpoint of a rank
+    static std::string getRankFilename(const std::string& fname, unsigned int rank)
+        {
+        return fname + "." + std::to_string(rank);
+        }
+
+    //! Get the number of checkpoints written
+    uint64_t getNumWrites()
+        {
+        return m_num_writes;
+        }
+
+    private:
+    std::string m_fname;             //!< Base file name
+    pybind11::object m_state_writer; //!< Provides the operation state
+    gsd_handle m_handle;             //!< Handle of the file being written
+    std::string m_tmp_fname;         //!< Name of the file being written
+    uint64_t m_num_writes;           //!< Number of checkpoints written
+
+    //! Write a chunk to the file
+    void writeChunk(const char* name, gsd_type type, uint64_t N, uint32_t M, const void* data);
+
+    //! Write a list of names
+    void writeNames(const char* name, const std::vector<std::string>& names);
+
+    //! Write the global configuration and the domain decomposition
+    void writeConfiguration(uint64_t timestep);
+
+    //! Write the particles owned by this rank
+    void writeParticles();
+
+    //! Write the bonded groups, gathered on the root rank
+    void writeTopology(bool root);
+
+    //! Write the integrator variables
+    void writeIntegratorVariables();
+
+    //! Write the operation state from the state writer
+    void writeOperationState();
+    };
+
+//! Exports the CheckpointWriter class to python
+void export_CheckpointWriter(pybind11::module& m);
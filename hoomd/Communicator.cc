@@ -13,7 +13,9 @@
 #include "System.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <numeric>
 #include <pybind11/stl.h>
 
 using namespace std;
@@ -31,795 +33,545 @@ Communicator::GroupCommunicator<group_data>::GroupCommunicator(Communicator& com
     }
 
 template<class group_data>
-void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
-                                                                bool local_multiple)
+void Communicator::GroupCommunicator<group_data>::packRanks(bool incomplete,
+                                                            GroupExchangeBuffer& buf)
     {
-    if (m_gdata->getNGlobal())
         {
-        if (m_comm.m_prof)
+        // wipe out reverse-lookup tag -> idx for old ghost groups
+        ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
+                                               access_location::host,
+                                               access_mode::readwrite);
+        for (unsigned int i = 0; i < m_gdata->getNGhosts(); i++)
             {
-            m_comm.m_prof->push(m_exec_conf, m_gdata->getName());
+            unsigned int idx = m_gdata->getN() + i;
+            h_group_rtag.data[h_group_tag.data[idx]] = GROUP_NOT_LOCAL;
             }
+        }
 
-            {
-            // wipe out reverse-lookup tag -> idx for old ghost groups
-            ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
-                                                  access_location::host,
-                                                  access_mode::read);
-            ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
-                                                   access_location::host,
-                                                   access_mode::readwrite);
-            for (unsigned int i = 0; i < m_gdata->getNGhosts(); i++)
-                {
-                unsigned int idx = m_gdata->getN() + i;
-                h_group_rtag.data[h_group_tag.data[idx]] = GROUP_NOT_LOCAL;
-                }
-            }
+    // remove ghost groups
+    m_gdata->removeAllGhostGroups();
 
-        // remove ghost groups
-        m_gdata->removeAllGhostGroups();
+    // send map for rank updates
+    typedef std::multimap<unsigned int, rank_element_t> map_t;
+    map_t send_map;
 
-        // send map for rank updates
-        typedef std::multimap<unsigned int, rank_element_t> map_t;
-        map_t send_map;
+        {
+        ArrayHandle<unsigned int> h_comm_flags(m_comm.m_pdata->getCommFlags(),
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<typename group_data::members_t> h_members(m_gdata->getMembersArray(),
+                                                              access_location::host,
+                                                              access_mode::read);
+        ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
+                                                                access_location::host,
+                                                                access_mode::readwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_comm.m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
 
-            {
-            ArrayHandle<unsigned int> h_comm_flags(m_comm.m_pdata->getCommFlags(),
-                                                   access_location::host,
-                                                   access_mode::read);
-            ArrayHandle<typename group_data::members_t> h_members(m_gdata->getMembersArray(),
-                                                                  access_location::host,
-                                                                  access_mode::read);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
-                                                                    access_location::host,
-                                                                    access_mode::readwrite);
-            ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
-                                                  access_location::host,
-                                                  access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_comm.m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+        ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
+                                                     access_location::host,
+                                                     access_mode::read);
 
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
+        ArrayHandle<unsigned int> h_cart_ranks(
+            m_comm.m_pdata->getDomainDecomposition()->getCartRanks(),
+            access_location::host,
+            access_mode::read);
 
-            ArrayHandle<unsigned int> h_cart_ranks(
-                m_comm.m_pdata->getDomainDecomposition()->getCartRanks(),
-                access_location::host,
-                access_mode::read);
+        Index3D di = m_comm.m_pdata->getDomainDecomposition()->getDomainIndexer();
+        uint3 my_pos = m_comm.m_pdata->getDomainDecomposition()->getGridPos();
+        unsigned int my_rank = m_exec_conf->getRank();
 
-            Index3D di = m_comm.m_pdata->getDomainDecomposition()->getDomainIndexer();
-            uint3 my_pos = m_comm.m_pdata->getDomainDecomposition()->getGridPos();
-            unsigned int my_rank = m_exec_conf->getRank();
+        // mark groups whose member ranks need to be updated
+        unsigned int n_groups = m_gdata->getN();
+        for (unsigned int group_idx = 0; group_idx < n_groups; group_idx++)
+            {
+            typename group_data::members_t g = h_members.data[group_idx];
+            typename group_data::ranks_t r = h_group_ranks.data[group_idx];
 
-            // mark groups whose member ranks need to be updated
-            unsigned int n_groups = m_gdata->getN();
-            for (unsigned int group_idx = 0; group_idx < n_groups; group_idx++)
-                {
-                typename group_data::members_t g = h_members.data[group_idx];
-                typename group_data::ranks_t r = h_group_ranks.data[group_idx];
+            // initialize bit field
+            unsigned int mask = 0;
 
-                // initialize bit field
-                unsigned int mask = 0;
+            bool update = false;
 
-                bool update = false;
+            // iterate over group members
+            for (unsigned int i = 0; i < group_data::size; i++)
+                {
+                unsigned int tag = g.tag[i];
+                unsigned int pidx = h_rtag.data[tag];
 
-                // iterate over group members
-                for (unsigned int i = 0; i < group_data::size; i++)
+                if (pidx == NOT_LOCAL)
                     {
-                    unsigned int tag = g.tag[i];
-                    unsigned int pidx = h_rtag.data[tag];
-
-                    if (pidx == NOT_LOCAL)
+                    // if any ptl is non-local, send
+                    update = true;
+                    }
+                else
+                    {
+                    if (incomplete)
                         {
-                        // if any ptl is non-local, send
-                        update = true;
+                        // initially, update rank information
+                        r.idx[i] = my_rank;
+                        mask |= (1 << i);
                         }
-                    else
-                        {
-                        if (incomplete)
-                            {
-                            // initially, update rank information
-                            r.idx[i] = my_rank;
-                            mask |= (1 << i);
-                            }
-
-                        unsigned int flags = h_comm_flags.data[pidx];
 
-                        if (flags)
-                            {
-                            // particle is sent to a different domain
-                            mask |= (1 << i);
-
-                            int ix, iy, iz;
-                            ix = iy = iz = 0;
-
-                            if (flags & send_east)
-                                ix = 1;
-                            else if (flags & send_west)
-                                ix = -1;
-
-                            if (flags & send_north)
-                                iy = 1;
-                            else if (flags & send_south)
-                                iy = -1;
-
-                            if (flags & send_up)
-                                iz = 1;
-                            else if (flags & send_down)
-                                iz = -1;
-
-                            int ni = my_pos.x;
-                            int nj = my_pos.y;
-                            int nk = my_pos.z;
-
-                            ni += ix;
-                            if (ni == (int)di.getW())
-                                ni = 0;
-                            else if (ni < 0)
-                                ni += di.getW();
-
-                            nj += iy;
-                            if (nj == (int)di.getH())
-                                nj = 0;
-                            else if (nj < 0)
-                                nj += di.getH();
-
-                            nk += iz;
-                            if (nk == (int)di.getD())
-                                nk = 0;
-                            else if (nk < 0)
-                                nk += di.getD();
-
-                            // update ranks
-                            r.idx[i] = h_cart_ranks.data[di(ni, nj, nk)];
-
-                            update = true;
-                            }
-                        }
-                    } // end loop over group members
+                    unsigned int flags = h_comm_flags.data[pidx];
 
-                h_group_ranks.data[group_idx] = r;
+                    if (flags)
+                        {
+                        // particle is sent to a different domain
+                        mask |= (1 << i);
 
-                // a group that is purely local is not sent
-                if (!update)
-                    mask = 0;
+                        int ix, iy, iz;
+                        ix = iy = iz = 0;
+
+                        if (flags & send_east)
+                            ix = 1;
+                        else if (flags & send_west)
+                            ix = -1;
+
+                        if (flags & send_north)
+                            iy = 1;
+                        else if (flags & send_south)
+                            iy = -1;
+
+                        if (flags & send_up)
+                            iz = 1;
+                        else if (flags & send_down)
+                            iz = -1;
+
+                        int ni = my_pos.x;
+                        int nj = my_pos.y;
+                        int nk = my_pos.z;
+
+                        ni += ix;
+                        if (ni == (int)di.getW())
+                            ni = 0;
+                        else if (ni < 0)
+                            ni += di.getW();
+
+                        nj += iy;
+                        if (nj == (int)di.getH())
+                            nj = 0;
+                        else if (nj < 0)
+                            nj += di.getH();
+
+                        nk += iz;
+                        if (nk == (int)di.getD())
+                            nk = 0;
+                        else if (nk < 0)
+                            nk += di.getD();
+
+                        // update ranks
+                        r.idx[i] = h_cart_ranks.data[di(ni, nj, nk)];
 
-                if (mask)
-                    {
-                    // add to sorted output buffer
-                    rank_element_t el;
-                    el.ranks = r;
-                    el.mask = mask;
-                    el.tag = h_group_tag.data[group_idx];
-                    if (incomplete)
-                        // in initialization, send to all neighbors
-                        for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                            send_map.insert(std::make_pair(h_unique_neighbors.data[ineigh], el));
-                    else
-                        // send to other ranks owning the bonded group
-                        for (unsigned int j = 0; j < group_data::size; ++j)
-                            {
-                            unsigned int rank = r.idx[j];
-                            bool rank_updated = mask & (1 << j);
-                            // send out to ranks different from ours
-                            if (rank != my_rank && !rank_updated)
-                                send_map.insert(std::make_pair(rank, el));
-                            }
+                        update = true;
+                        }
                     }
-                } // end loop over groups
-            }     // end ArrayHandle scope
+                } // end loop over group members
 
-        // clear send buffer
-        m_ranks_sendbuf.clear();
-
-            {
-            // output send data sorted by rank
-            for (typename map_t::iterator it = send_map.begin(); it != send_map.end(); ++it)
-                {
-                m_ranks_sendbuf.push_back(it->second);
-                }
+            h_group_ranks.data[group_idx] = r;
 
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::overwrite);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end,
-                                            access_location::host,
-                                            access_mode::overwrite);
+            // a group that is purely local is not sent
+            if (!update)
+                mask = 0;
 
-            // Find start and end indices
-            for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
+            if (mask)
                 {
-                typename map_t::iterator lower = send_map.lower_bound(h_unique_neighbors.data[i]);
-                typename map_t::iterator upper = send_map.upper_bound(h_unique_neighbors.data[i]);
-                h_begin.data[i] = (unsigned int)std::distance(send_map.begin(), lower);
-                h_end.data[i] = (unsigned int)std::distance(send_map.begin(), upper);
+                // add to sorted output buffer
+                rank_element_t el;
+                el.ranks = r;
+                el.mask = mask;
+                el.tag = h_group_tag.data[group_idx];
+                if (incomplete)
+                    // in initialization, send to all neighbors
+                    for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
+                        send_map.insert(std::make_pair(h_unique_neighbors.data[ineigh], el));
+                else
+                    // send to other ranks owning the bonded group
+                    for (unsigned int j = 0; j < group_data::size; ++j)
+                        {
+                        unsigned int rank = r.idx[j];
+                        bool rank_updated = mask & (1 << j);
+                        // send out to ranks different from ours
+                        if (rank != my_rank && !rank_updated)
+                            send_map.insert(std::make_pair(rank, el));
+                        }
                 }
-            }
+            } // end loop over groups
+        }     // end ArrayHandle scope
 
-        /*
-         * communicate rank information (phase 1)
-         */
-        unsigned int n_send_groups[m_comm.m_n_unique_neigh];
-        unsigned int n_recv_groups[m_comm.m_n_unique_neigh];
-        unsigned int offs[m_comm.m_n_unique_neigh];
-        unsigned int n_recv_tot = 0;
+    // clear send buffer
+    m_ranks_sendbuf.clear();
 
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
+    // output send data sorted by rank
+    for (typename map_t::iterator it = send_map.begin(); it != send_map.end(); ++it)
+        {
+        m_ranks_sendbuf.push_back(it->second);
+        }
 
-            // compute send counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
+    setSendRanges(send_map);
 
-            MPI_Request req[2 * m_comm.m_n_unique_neigh];
-            MPI_Status stat[2 * m_comm.m_n_unique_neigh];
+    buf.send = reinterpret_cast<const char*>(m_ranks_sendbuf.data());
+    buf.send_begin = m_send_begin.data();
+    buf.n_send = m_n_send.data();
+    buf.n_recv = m_n_recv.data();
+    buf.recv = nullptr;
+    buf.element_size = sizeof(rank_element_t);
+    }
 
-            unsigned int nreq = 0;
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::allocateRanksRecv(GroupExchangeBuffer& buf)
+    {
+    m_ranks_recvbuf.resize(std::accumulate(m_n_recv.begin(), m_n_recv.end(), 0u));
+    buf.recv = reinterpret_cast<char*>(m_ranks_recvbuf.data());
+    }
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+template<class group_data> void Communicator::GroupCommunicator<group_data>::unpackRanks()
+    {
+    unsigned int n_recv_tot = (unsigned int)m_ranks_recvbuf.size();
 
-                MPI_Isend(&n_send_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
+        {
+        // access receive buffers
+        ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
+                                                                access_location::host,
+                                                                access_mode::readwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
+                                               access_location::host,
+                                               access_mode::read);
 
-            MPI_Waitall(nreq, req, stat);
+        for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; ++recv_idx)
+            {
+            rank_element_t el = m_ranks_recvbuf[recv_idx];
+            unsigned int tag = el.tag;
+            unsigned int gidx = h_group_rtag.data[tag];
 
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
+            if (gidx != GROUP_NOT_LOCAL)
                 {
-                if (ineigh == 0)
-                    offs[ineigh] = 0;
-                else
-                    offs[ineigh] = offs[ineigh - 1] + n_recv_groups[ineigh - 1];
+                typename group_data::ranks_t new_ranks = el.ranks;
+                unsigned int mask = el.mask;
 
-                n_recv_tot += n_recv_groups[ineigh];
-                }
+                for (unsigned int i = 0; i < group_data::size; ++i)
+                    {
+                    bool update = mask & (1 << i);
 
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
+                    if (update)
+                        h_group_ranks.data[gidx].idx[i] = new_ranks.idx[i];
+                    }
+                }
             }
+        }
+    }
 
-        // Resize receive buffer
-        m_ranks_recvbuf.resize(n_recv_tot);
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::packGroups(bool local_multiple,
+                                                             GroupExchangeBuffer& buf)
+    {
+    // send map for groups
+    typedef std::multimap<unsigned int, group_element_t> group_map_t;
+    group_map_t group_send_map;
 
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
+        {
+        ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
+                                                             access_location::host,
+                                                             access_mode::read);
+        ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
                                               access_location::host,
                                               access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
+        ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
+                                               access_location::host,
+                                               access_mode::readwrite);
+        ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
+                                                                access_location::host,
+                                                                access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_comm.m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_comm_flags(m_comm.m_pdata->getCommFlags(),
+                                               access_location::host,
+                                               access_mode::read);
 
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
+        unsigned int ngroups = m_gdata->getN();
 
-            std::vector<MPI_Request> reqs;
-            MPI_Request req;
+        for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
+            {
+            unsigned int mask = 0;
 
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
+            typename group_data::members_t members = h_groups.data[group_idx];
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
+            bool send = false;
+            for (unsigned int i = 0; i < group_data::size; ++i)
                 {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+                unsigned int tag = members.tag[i];
+                unsigned int pidx = h_rtag.data[tag];
 
-                // exchange particle data
-                if (n_send_groups[ineigh])
+                if (pidx != NOT_LOCAL && h_comm_flags.data[pidx])
                     {
-                    MPI_Isend(&m_ranks_sendbuf.front() + h_begin.data[ineigh],
-                              int(n_send_groups[ineigh] * sizeof(rank_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
+                    mask |= (1 << i);
+                    send = true;
                     }
-                send_bytes += (unsigned int)(n_send_groups[ineigh] * sizeof(rank_element_t));
-
-                if (n_recv_groups[ineigh])
-                    {
-                    MPI_Irecv(&m_ranks_recvbuf.front() + offs[ineigh],
-                              int(n_recv_groups[ineigh] * sizeof(rank_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                recv_bytes += (unsigned int)(n_recv_groups[ineigh] * sizeof(rank_element_t));
                 }
 
-            std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
-
-            {
-            // access receive buffers
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
-                                                                    access_location::host,
-                                                                    access_mode::readwrite);
-            ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
-                                                   access_location::host,
-                                                   access_mode::read);
-
-            for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; ++recv_idx)
+            if (send)
                 {
-                rank_element_t el = m_ranks_recvbuf[recv_idx];
-                unsigned int tag = el.tag;
-                unsigned int gidx = h_group_rtag.data[tag];
-
-                if (gidx != GROUP_NOT_LOCAL)
-                    {
-                    typename group_data::ranks_t new_ranks = el.ranks;
-                    unsigned int mask = el.mask;
-
-                    for (unsigned int i = 0; i < group_data::size; ++i)
-                        {
-                        bool update = mask & (1 << i);
-
-                        if (update)
-                            h_group_ranks.data[gidx].idx[i] = new_ranks.idx[i];
-                        }
-                    }
-                }
-            }
-
-        // send map for groups
-        typedef std::multimap<unsigned int, group_element_t> group_map_t;
-        group_map_t group_send_map;
-
-            {
-            ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
-                                                                 access_location::host,
-                                                                 access_mode::read);
-            ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
-                                                   access_location::host,
-                                                   access_mode::read);
-            ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
-                                                  access_location::host,
-                                                  access_mode::read);
-            ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
-                                                   access_location::host,
-                                                   access_mode::readwrite);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
-                                                                    access_location::host,
-                                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_comm.m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
-            ArrayHandle<unsigned int> h_comm_flags(m_comm.m_pdata->getCommFlags(),
-                                                   access_location::host,
-                                                   access_mode::read);
+                // insert into send map
+                typename group_data::packed_t el;
+                el.tags = h_groups.data[group_idx];
+                el.typeval = h_group_typeval.data[group_idx];
+                el.group_tag = h_group_tag.data[group_idx];
+                el.ranks = h_group_ranks.data[group_idx];
 
-            unsigned int ngroups = m_gdata->getN();
-
-            for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
-                {
-                unsigned int mask = 0;
+                for (unsigned int i = 0; i < group_data::size; ++i)
+                    // are we sending to this rank?
+                    if (mask & (1 << i))
+                        group_send_map.insert(std::make_pair(el.ranks.idx[i], el));
 
-                typename group_data::members_t members = h_groups.data[group_idx];
+                // does this group still have local members
+                bool is_local = false;
 
-                bool send = false;
                 for (unsigned int i = 0; i < group_data::size; ++i)
                     {
                     unsigned int tag = members.tag[i];
                     unsigned int pidx = h_rtag.data[tag];
 
-                    if (pidx != NOT_LOCAL && h_comm_flags.data[pidx])
-                        {
-                        mask |= (1 << i);
-                        send = true;
-                        }
-                    }
-
-                if (send)
-                    {
-                    // insert into send map
-                    typename group_data::packed_t el;
-                    el.tags = h_groups.data[group_idx];
-                    el.typeval = h_group_typeval.data[group_idx];
-                    el.group_tag = h_group_tag.data[group_idx];
-                    el.ranks = h_group_ranks.data[group_idx];
-
-                    for (unsigned int i = 0; i < group_data::size; ++i)
-                        // are we sending to this rank?
-                        if (mask & (1 << i))
-                            group_send_map.insert(std::make_pair(el.ranks.idx[i], el));
-
-                    // does this group still have local members
-                    bool is_local = false;
-
-                    for (unsigned int i = 0; i < group_data::size; ++i)
+                    if (pidx != NOT_LOCAL && !h_comm_flags.data[pidx])
                         {
-                        unsigned int tag = members.tag[i];
-                        unsigned int pidx = h_rtag.data[tag];
-
-                        if (pidx != NOT_LOCAL && !h_comm_flags.data[pidx])
+                        if (local_multiple || i == 0)
                             {
-                            if (local_multiple || i == 0)
-                                {
-                                is_local = true;
-                                }
+                            is_local = true;
                             }
                         }
-
-                    // if group is no longer local, flag for removal
-                    if (!is_local)
-                        h_group_rtag.data[el.group_tag] = GROUP_NOT_LOCAL;
                     }
-                } // end loop over groups
-            }
 
-        unsigned int new_ngroups;
-            {
-            ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
+                // if group is no longer local, flag for removal
+                if (!is_local)
+                    h_group_rtag.data[el.group_tag] = GROUP_NOT_LOCAL;
+                }
+            } // end loop over groups
+        }
+
+    unsigned int new_ngroups;
+        {
+        ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
+                                                             access_location::host,
+                                                             access_mode::read);
+        ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
+                                                                access_location::host,
+                                                                access_mode::read);
+
+        // access alternate arrays to write to
+        ArrayHandle<typename group_data::members_t> h_groups_alt(m_gdata->getAltMembersArray(),
                                                                  access_location::host,
-                                                                 access_mode::read);
-            ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
+                                                                 access_mode::overwrite);
+        ArrayHandle<typeval_t> h_group_typeval_alt(m_gdata->getAltTypeValArray(),
                                                    access_location::host,
-                                                   access_mode::read);
-            ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
+                                                   access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag_alt(m_gdata->getAltTags(),
                                                   access_location::host,
-                                                  access_mode::read);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
+                                                  access_mode::overwrite);
+        ArrayHandle<typename group_data::ranks_t> h_group_ranks_alt(m_gdata->getAltRanksArray(),
                                                                     access_location::host,
-                                                                    access_mode::read);
+                                                                    access_mode::overwrite);
 
-            // access alternate arrays to write to
-            ArrayHandle<typename group_data::members_t> h_groups_alt(m_gdata->getAltMembersArray(),
-                                                                     access_location::host,
-                                                                     access_mode::overwrite);
-            ArrayHandle<typeval_t> h_group_typeval_alt(m_gdata->getAltTypeValArray(),
-                                                       access_location::host,
-                                                       access_mode::overwrite);
-            ArrayHandle<unsigned int> h_group_tag_alt(m_gdata->getAltTags(),
-                                                      access_location::host,
-                                                      access_mode::overwrite);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks_alt(m_gdata->getAltRanksArray(),
-                                                                        access_location::host,
-                                                                        access_mode::overwrite);
+        // access rtags
+        ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
+                                               access_location::host,
+                                               access_mode::readwrite);
 
-            // access rtags
-            ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
-                                                   access_location::host,
-                                                   access_mode::readwrite);
+        unsigned int ngroups = m_gdata->getN();
+        unsigned int n = 0;
+        for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
+            {
+            unsigned int group_tag = h_group_tag.data[group_idx];
+            bool keep = h_group_rtag.data[group_tag] != GROUP_NOT_LOCAL;
 
-            unsigned int ngroups = m_gdata->getN();
-            unsigned int n = 0;
-            for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
+            if (keep)
                 {
-                unsigned int group_tag = h_group_tag.data[group_idx];
-                bool keep = h_group_rtag.data[group_tag] != GROUP_NOT_LOCAL;
+                h_groups_alt.data[n] = h_groups.data[group_idx];
+                h_group_typeval_alt.data[n] = h_group_typeval.data[group_idx];
+                h_group_tag_alt.data[n] = group_tag;
+                h_group_ranks_alt.data[n] = h_group_ranks.data[group_idx];
 
-                if (keep)
-                    {
-                    h_groups_alt.data[n] = h_groups.data[group_idx];
-                    h_group_typeval_alt.data[n] = h_group_typeval.data[group_idx];
-                    h_group_tag_alt.data[n] = group_tag;
-                    h_group_ranks_alt.data[n] = h_group_ranks.data[group_idx];
-
-                    // rebuild rtags
-                    h_group_rtag.data[group_tag] = n++;
-                    }
+                // rebuild rtags
+                h_group_rtag.data[group_tag] = n++;
                 }
-
-            new_ngroups = n;
             }
 
-        // make alternate arrays current
-        m_gdata->swapMemberArrays();
-        m_gdata->swapTypeArrays();
-        m_gdata->swapTagArrays();
-        m_gdata->swapRankArrays();
-
-        assert(new_ngroups <= m_gdata->getN());
+        new_ngroups = n;
+        }
 
-        // resize group arrays
-        m_gdata->removeGroups(m_gdata->getN() - new_ngroups);
+    // make alternate arrays current
+    m_gdata->swapMemberArrays();
+    m_gdata->swapTypeArrays();
+    m_gdata->swapTagArrays();
+    m_gdata->swapRankArrays();
 
-        assert(m_gdata->getN() == new_ngroups);
+    assert(new_ngroups <= m_gdata->getN());
 
-        // reset send buf
-        m_groups_sendbuf.clear();
+    // resize group arrays
+    m_gdata->removeGroups(m_gdata->getN() - new_ngroups);
 
-        // output groups to send buffer in rank-sorted order
-        for (typename group_map_t::iterator it = group_send_map.begin(); it != group_send_map.end();
-             ++it)
-            {
-            m_groups_sendbuf.push_back(it->second);
-            }
-
-            {
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::overwrite);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end,
-                                            access_location::host,
-                                            access_mode::overwrite);
+    assert(m_gdata->getN() == new_ngroups);
 
-            // Find start and end indices
-            for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
-                {
-                typename group_map_t::iterator lower
-                    = group_send_map.lower_bound(h_unique_neighbors.data[i]);
-                typename group_map_t::iterator upper
-                    = group_send_map.upper_bound(h_unique_neighbors.data[i]);
-                h_begin.data[i] = (unsigned int)std::distance(group_send_map.begin(), lower);
-                h_end.data[i] = (unsigned int)std::distance(group_send_map.begin(), upper);
-                }
-            }
+    // reset send buf
+    m_groups_sendbuf.clear();
 
-        /*
-         * communicate groups (phase 2)
-         */
+    // output groups to send buffer in rank-sorted order
+    for (typename group_map_t::iterator it = group_send_map.begin(); it != group_send_map.end();
+         ++it)
+        {
+        m_groups_sendbuf.push_back(it->second);
+        }
 
-        n_recv_tot = 0;
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
+    setSendRanges(group_send_map);
 
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
+    buf.send = reinterpret_cast<const char*>(m_groups_sendbuf.data());
+    buf.send_begin = m_send_begin.data();
+    buf.n_send = m_n_send.data();
+    buf.n_recv = m_n_recv.data();
+    buf.recv = nullptr;
+    buf.element_size = sizeof(group_element_t);
+    }
 
-            // compute send counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::allocateGroupsRecv(GroupExchangeBuffer& buf)
+    {
+    m_groups_recvbuf.resize(std::accumulate(m_n_recv.begin(), m_n_recv.end(), 0u));
+    buf.recv = reinterpret_cast<char*>(m_groups_recvbuf.data());
+    }
 
-            MPI_Request req[2 * m_comm.m_n_unique_neigh];
-            MPI_Status stat[2 * m_comm.m_n_unique_neigh];
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::unpackGroups(bool local_multiple)
+    {
+    unsigned int n_recv_tot = (unsigned int)m_groups_recvbuf.size();
 
-            unsigned int nreq = 0;
+    // use a std::map, i.e. single-key, to filter out duplicate groups in input buffer
+    typedef std::map<unsigned int, group_element_t> recv_map_t;
+    recv_map_t recv_map;
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+    for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; recv_idx++)
+        {
+        group_element_t el = m_groups_recvbuf[recv_idx];
+        unsigned int tag = el.group_tag;
+        recv_map.insert(std::make_pair(tag, el));
+        }
 
-                MPI_Isend(&n_send_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
+    unsigned int n_recv_unique = (unsigned int)recv_map.size();
 
-            MPI_Waitall(nreq, req, stat);
+    unsigned int old_ngroups = m_gdata->getN();
 
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                if (ineigh == 0)
-                    offs[ineigh] = 0;
-                else
-                    offs[ineigh] = offs[ineigh - 1] + n_recv_groups[ineigh - 1];
+    // resize group arrays to accommodate additional groups (there can still be duplicates with
+    // local groups)
+    m_gdata->addGroups(n_recv_unique);
 
-                n_recv_tot += n_recv_groups[ineigh];
-                }
+    auto& groups_array = m_gdata->getMembersArray();
+    auto& group_typeval_array = m_gdata->getTypeValArray();
+    auto& group_tag_array = m_gdata->getTags();
+    auto& group_ranks_array = m_gdata->getRanksArray();
 
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
+    unsigned int nremove = 0;
 
-        // Resize receive buffer
-        m_groups_recvbuf.resize(n_recv_tot);
+    unsigned int myrank = m_exec_conf->getRank();
 
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
+        {
+        ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
+                                               access_location::host,
+                                               access_mode::readwrite);
+        ArrayHandle<typename group_data::members_t> h_groups(groups_array,
+                                                             access_location::host,
+                                                             access_mode::readwrite);
+        ArrayHandle<typeval_t> h_group_typeval(group_typeval_array,
+                                               access_location::host,
+                                               access_mode::readwrite);
+        ArrayHandle<unsigned int> h_group_tag(group_tag_array,
                                               access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
+                                              access_mode::readwrite);
+        ArrayHandle<typename group_data::ranks_t> h_group_ranks(group_ranks_array,
+                                                                access_location::host,
+                                                                access_mode::readwrite);
 
-            std::vector<MPI_Request> reqs;
-            MPI_Request req;
+        // add non-duplicate groups to group data
+        unsigned int add_idx = old_ngroups;
+        for (typename recv_map_t::iterator it = recv_map.begin(); it != recv_map.end(); ++it)
+            {
+            typename group_data::packed_t el = it->second;
 
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
+            unsigned int tag = el.group_tag;
+            unsigned int group_rtag = h_group_rtag.data[tag];
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
+            bool remove = false;
+            if (!local_multiple)
                 {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (n_send_groups[ineigh])
-                    {
-                    MPI_Isend(&m_groups_sendbuf.front() + h_begin.data[ineigh],
-                              int(n_send_groups[ineigh] * sizeof(group_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                send_bytes += (unsigned int)(n_send_groups[ineigh] * sizeof(group_element_t));
-
-                if (n_recv_groups[ineigh])
+                // only add if we own the first particle
+                assert(group_data::size);
+                if (el.ranks.idx[0] != myrank)
                     {
-                    MPI_Irecv(&m_groups_recvbuf.front() + offs[ineigh],
-                              int(n_recv_groups[ineigh] * sizeof(group_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
+                    remove = true;
                     }
-                recv_bytes += (unsigned int)(n_recv_groups[ineigh] * sizeof(group_element_t));
                 }
 
-            std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
-
-        // use a std::map, i.e. single-key, to filter out duplicate groups in input buffer
-        typedef std::map<unsigned int, group_element_t> recv_map_t;
-        recv_map_t recv_map;
-
-        for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; recv_idx++)
-            {
-            group_element_t el = m_groups_recvbuf[recv_idx];
-            unsigned int tag = el.group_tag;
-            recv_map.insert(std::make_pair(tag, el));
-            }
-
-        unsigned int n_recv_unique = (unsigned int)recv_map.size();
-
-        unsigned int old_ngroups = m_gdata->getN();
-
-        // resize group arrays to accommodate additional groups (there can still be duplicates with
-        // local groups)
-        m_gdata->addGroups(n_recv_unique);
-
-        auto& groups_array = m_gdata->getMembersArray();
-        auto& group_typeval_array = m_gdata->getTypeValArray();
-        auto& group_tag_array = m_gdata->getTags();
-        auto& group_ranks_array = m_gdata->getRanksArray();
-
-        unsigned int nremove = 0;
-
-        unsigned int myrank = m_exec_conf->getRank();
-
-            {
-            ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
-                                                   access_location::host,
-                                                   access_mode::readwrite);
-            ArrayHandle<typename group_data::members_t> h_groups(groups_array,
-                                                                 access_location::host,
-                                                                 access_mode::readwrite);
-            ArrayHandle<typeval_t> h_group_typeval(group_typeval_array,
-                                                   access_location::host,
-                                                   access_mode::readwrite);
-            ArrayHandle<unsigned int> h_group_tag(group_tag_array,
-                                                  access_location::host,
-                                                  access_mode::readwrite);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks(group_ranks_array,
-                                                                    access_location::host,
-                                                                    access_mode::readwrite);
-
-            // add non-duplicate groups to group data
-            unsigned int add_idx = old_ngroups;
-            for (typename recv_map_t::iterator it = recv_map.begin(); it != recv_map.end(); ++it)
+            if (!remove)
                 {
-                typename group_data::packed_t el = it->second;
-
-                unsigned int tag = el.group_tag;
-                unsigned int group_rtag = h_group_rtag.data[tag];
-
-                bool remove = false;
-                if (!local_multiple)
+                if (group_rtag == GROUP_NOT_LOCAL)
                     {
-                    // only add if we own the first particle
-                    assert(group_data::size);
-                    if (el.ranks.idx[0] != myrank)
-                        {
-                        remove = true;
-                        }
-                    }
-
-                if (!remove)
-                    {
-                    if (group_rtag == GROUP_NOT_LOCAL)
-                        {
-                        h_groups.data[add_idx] = el.tags;
-                        h_group_typeval.data[add_idx] = el.typeval;
-                        h_group_tag.data[add_idx] = tag;
-                        h_group_ranks.data[add_idx] = el.ranks;
+                    h_groups.data[add_idx] = el.tags;
+                    h_group_typeval.data[add_idx] = el.typeval;
+                    h_group_tag.data[add_idx] = tag;
+                    h_group_ranks.data[add_idx] = el.ranks;
 
-                        // update reverse-lookup table
-                        h_group_rtag.data[tag] = add_idx++;
-                        }
-                    else
-                        {
-                        remove = true;
-                        }
+                    // update reverse-lookup table
+                    h_group_rtag.data[tag] = add_idx++;
                     }
-
-                if (remove)
+                else
                     {
-                    nremove++;
+                    remove = true;
                     }
                 }
+
+            if (remove)
+                {
+                nremove++;
+                }
             }
+        }
 
-        // resize arrays to final size
-        m_gdata->removeGroups(nremove);
+    // resize arrays to final size
+    m_gdata->removeGroups(nremove);
+    }
 
-        if (m_comm.m_prof)
-            m_comm.m_prof->pop();
+template<class group_data>
+template<class map_t>
+void Communicator::GroupCommunicator<group_data>::setSendRanges(const map_t& send_map)
+    {
+    ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    m_send_begin.resize(m_comm.m_n_unique_neigh);
+    m_n_send.resize(m_comm.m_n_unique_neigh);
+    m_n_recv.resize(m_comm.m_n_unique_neigh);
+
+    // Find start and end indices
+    for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
+        {
+        auto lower = send_map.lower_bound(h_unique_neighbors.data[i]);
+        auto upper = send_map.upper_bound(h_unique_neighbors.data[i]);
+        m_send_begin[i] = (unsigned int)std::distance(send_map.begin(), lower);
+        m_n_send[i] = (unsigned int)std::distance(lower, upper);
         }
     }
 
@@ -1225,6 +977,231 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
         } // end if groups exist
     }
 
+/*! \param buffers Buffers of the group types in the exchange, \a n_send is read and \a n_recv is
+    written for every unique neighbor
+
+    Sends one message per unique neighbor with the element counts of all group types.
+*/
+void Communicator::exchangeGroupCounts(std::vector<GroupExchangeBuffer>& buffers)
+    {
+    const unsigned int n_types = (unsigned int)buffers.size();
+    std::vector<unsigned int> n_send(m_n_unique_neigh * n_types);
+    std::vector<unsigned int> n_recv(m_n_unique_neigh * n_types);
+
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        for (unsigned int t = 0; t < n_types; ++t)
+            n_send[ineigh * n_types + t] = buffers[t].n_send[ineigh];
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    std::vector<MPI_Request> reqs(2 * m_n_unique_neigh);
+    std::vector<MPI_Status> stats(2 * m_n_unique_neigh);
+
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        {
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+        MPI_Isend(&n_send[ineigh * n_types],
+                  n_types,
+                  MPI_UNSIGNED,
+                  neighbor,
+                  0,
+                  m_mpi_comm,
+                  &reqs[2 * ineigh]);
+        MPI_Irecv(&n_recv[ineigh * n_types],
+                  n_types,
+                  MPI_UNSIGNED,
+                  neighbor,
+                  0,
+                  m_mpi_comm,
+                  &reqs[2 * ineigh + 1]);
+        }
+
+    MPI_Waitall((unsigned int)reqs.size(), reqs.data(), stats.data());
+
+    if (m_prof)
+        m_prof->pop(0, (unsigned int)(2 * n_send.size() * sizeof(unsigned int)));
+
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        for (unsigned int t = 0; t < n_types; ++t)
+            buffers[t].n_recv[ineigh] = n_recv[ineigh * n_types + t];
+    }
+
+/*! \param buffers Buffers of the group types in the exchange, with counts from
+        exchangeGroupCounts() and allocated receive buffers
+
+    The elements of all group types sent to a neighbor are described by a single MPI datatype
+    with absolute addresses, so every neighbor receives one message without packing them into a
+    contiguous buffer first.
+*/
+void Communicator::exchangeGroupElements(const std::vector<GroupExchangeBuffer>& buffers)
+    {
+    const unsigned int n_types = (unsigned int)buffers.size();
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    std::vector<MPI_Request> reqs;
+    std::vector<MPI_Datatype> types;
+    std::vector<size_t> recv_offset(n_types, 0);
+
+    std::vector<int> lengths;
+    std::vector<MPI_Aint> displacements;
+
+    unsigned int send_bytes = 0;
+    unsigned int recv_bytes = 0;
+
+    // build a datatype from the blocks of every group type and post the message
+    auto post = [&](bool send, unsigned int ineigh, unsigned int neighbor)
+    {
+        lengths.clear();
+        displacements.clear();
+
+        for (unsigned int t = 0; t < n_types; ++t)
+            {
+            const GroupExchangeBuffer& buf = buffers[t];
+            unsigned int n = send ? buf.n_send[ineigh] : buf.n_recv[ineigh];
+            if (!n)
+                continue;
+
+            const char* ptr = send ? buf.send + buf.send_begin[ineigh] * buf.element_size
+                                   : buf.recv + recv_offset[t];
+            MPI_Aint address;
+            MPI_Get_address(ptr, &address);
+
+            lengths.push_back(int(n * buf.element_size));
+            displacements.push_back(address);
+
+            if (!send)
+                recv_offset[t] += n * buf.element_size;
+            }
+
+        if (lengths.empty())
+            return;
+
+        MPI_Datatype type;
+        MPI_Type_create_hindexed((int)lengths.size(),
+                                 lengths.data(),
+                                 displacements.data(),
+                                 MPI_BYTE,
+                                 &type);
+        MPI_Type_commit(&type);
+        types.push_back(type);
+
+        unsigned int bytes = std::accumulate(lengths.begin(), lengths.end(), 0u);
+        MPI_Request req;
+        if (send)
+            {
+            MPI_Isend(MPI_BOTTOM, 1, type, neighbor, 1, m_mpi_comm, &req);
+            send_bytes += bytes;
+            }
+        else
+            {
+            MPI_Irecv(MPI_BOTTOM, 1, type, neighbor, 1, m_mpi_comm, &req);
+            recv_bytes += bytes;
+            }
+        reqs.push_back(req);
+    };
+
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        {
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+        post(true, ineigh, neighbor);
+        post(false, ineigh, neighbor);
+        }
+
+    std::vector<MPI_Status> stats(reqs.size());
+    MPI_Waitall((unsigned int)reqs.size(), reqs.data(), stats.data());
+
+    for (MPI_Datatype& type : types)
+        MPI_Type_free(&type);
+
+    if (m_prof)
+        m_prof->pop(0, send_bytes + recv_bytes);
+    }
+
+/*! All bonded group types with members update their member ranks and then migrate the groups whose
+    members leave this domain. Both steps exchange the groups of all types together, with one
+    message per unique neighbor for the counts and one for the elements.
+*/
+void Communicator::migrateBondedGroups()
+    {
+    // apply f to the communicator of every group type that has members
+    auto for_each_group = [this](auto f)
+    {
+        if (m_bond_comm.hasGroups())
+            f(m_bond_comm, m_bonds_changed);
+        if (m_pair_comm.hasGroups())
+            f(m_pair_comm, m_pairs_changed);
+        if (m_angle_comm.hasGroups())
+            f(m_angle_comm, m_angles_changed);
+        if (m_dihedral_comm.hasGroups())
+            f(m_dihedral_comm, m_dihedrals_changed);
+        if (m_improper_comm.hasGroups())
+            f(m_improper_comm, m_impropers_changed);
+        if (m_constraint_comm.hasGroups())
+            f(m_constraint_comm, m_constraints_changed);
+    };
+
+    std::vector<GroupExchangeBuffer> buffers;
+    for_each_group(
+        [&buffers](auto& group_comm, bool incomplete)
+        {
+            buffers.emplace_back();
+            group_comm.packRanks(incomplete, buffers.back());
+        });
+
+    if (!buffers.empty())
+        {
+        if (m_prof)
+            m_prof->push(m_exec_conf, "bonded groups");
+
+        /*
+         * communicate rank information (phase 1)
+         */
+        exchangeGroupCounts(buffers);
+
+        unsigned int i = 0;
+        for_each_group([&](auto& group_comm, bool) { group_comm.allocateRanksRecv(buffers[i++]); });
+
+        exchangeGroupElements(buffers);
+        for_each_group([](auto& group_comm, bool) { group_comm.unpackRanks(); });
+
+        /*
+         * communicate groups (phase 2)
+         */
+        i = 0;
+        for_each_group([&](auto& group_comm, bool) { group_comm.packGroups(true, buffers[i++]); });
+        exchangeGroupCounts(buffers);
+
+        i = 0;
+        for_each_group([&](auto& group_comm, bool)
+                       { group_comm.allocateGroupsRecv(buffers[i++]); });
+
+        exchangeGroupElements(buffers);
+        for_each_group([](auto& group_comm, bool) { group_comm.unpackGroups(true); });
+
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    m_bonds_changed = false;
+    m_pairs_changed = false;
+    m_angles_changed = false;
+    m_dihedrals_changed = false;
+    m_impropers_changed = false;
+    m_constraints_changed = false;
+    }
+
 //! Constructor
 Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<DomainDecomposition> decomposition)
@@ -1238,13 +1215,15 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
       m_netvirial_copybuf(m_exec_conf), m_netvirial_recvbuf(m_exec_conf), m_plan(m_exec_conf),
       m_plan_reverse(m_exec_conf), m_tag_reverse(m_exec_conf),
       m_netforce_reverse_copybuf(m_exec_conf), m_netforce_reverse_recvbuf(m_exec_conf),
-      m_r_ghost_max(Scalar(0.0)), m_r_extra_ghost_max(Scalar(0.0)), m_ghosts_added(0),
-      m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
-      m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
+      m_r_ghost_max(Scalar(0.0)), m_r_extra_ghost_max(Scalar(0.0)),
+      m_r_ghost_combined_max(Scalar(0.0)), m_ghosts_added(0), m_has_ghost_particles(false),
+      m_last_flags(0), m_comm_pending(false), m_bond_comm(*this, m_sysdef->getBondData()),
+      m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
       m_constraint_comm(*this, m_sysdef->getConstraintData()),
-      m_pair_comm(*this, m_sysdef->getPairData())
+      m_pair_comm(*this, m_sysdef->getPairData()), m_pos_packed_copybuf(m_exec_conf),
+      m_pos_packed_recvbuf(m_exec_conf)
     {
     // initialize array of neighbor processor ids
     assert(m_mpi_comm);
@@ -1261,6 +1240,8 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
         {
         GlobalVector<unsigned int> copy_ghosts(m_exec_conf);
         m_copy_ghosts[dir].swap(copy_ghosts);
+        GlobalVector<unsigned int> copy_ghosts_idx(m_exec_conf);
+        m_copy_ghosts_idx[dir].swap(copy_ghosts_idx);
         m_num_copy_ghosts[dir] = 0;
         m_num_recv_ghosts[dir] = 0;
         }
@@ -1348,15 +1329,16 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     initializeNeighborArrays();
 
     /* create a type for pdata_element */
-    const int nitems = 14;
-    int blocklengths[14] = {4, 4, 3, 1, 1, 3, 1, 4, 4, 3, 1, 4, 4, 6};
-    MPI_Datatype types[14] = {MPI_HOOMD_SCALAR,
+    const int nitems = 15;
+    int blocklengths[15] = {4, 4, 3, 1, 1, 3, 1, 1, 4, 4, 3, 1, 4, 4, 6};
+    MPI_Datatype types[15] = {MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
                               MPI_INT,
                               MPI_UNSIGNED,
+                              MPI_UNSIGNED,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
@@ -1364,7 +1346,7 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR,
                               MPI_HOOMD_SCALAR};
-    MPI_Aint offsets[14];
+    MPI_Aint offsets[15];
 
     offsets[0] = offsetof(pdata_element, pos);
     offsets[1] = offsetof(pdata_element, vel);
@@ -1373,13 +1355,14 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     offsets[4] = offsetof(pdata_element, diameter);
     offsets[5] = offsetof(pdata_element, image);
     offsets[6] = offsetof(pdata_element, body);
-    offsets[7] = offsetof(pdata_element, orientation);
-    offsets[8] = offsetof(pdata_element, angmom);
-    offsets[9] = offsetof(pdata_element, inertia);
-    offsets[10] = offsetof(pdata_element, tag);
-    offsets[11] = offsetof(pdata_element, net_force);
-    offsets[12] = offsetof(pdata_element, net_torque);
-    offsets[13] = offsetof(pdata_element, net_virial);
+    offsets[7] = offsetof(pdata_element, group_bits);
+    offsets[8] = offsetof(pdata_element, orientation);
+    offsets[9] = offsetof(pdata_element, angmom);
+    offsets[10] = offsetof(pdata_element, inertia);
+    offsets[11] = offsetof(pdata_element, tag);
+    offsets[12] = offsetof(pdata_element, net_force);
+    offsets[13] = offsetof(pdata_element, net_torque);
+    offsets[14] = offsetof(pdata_element, net_virial);
 
     MPI_Datatype tmp;
     MPI_Type_create_struct(nitems, blocklengths, offsets, types, &tmp);
@@ -1394,6 +1377,12 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
 Communicator::~Communicator()
     {
     m_exec_conf->msg->notice(5) << "Destroying Communicator" << std::endl;
+
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (!finalized)
+        freeGhostUpdateRequests();
+
     m_pdata->getParticleSortSignal().disconnect<Communicator, &Communicator::forceMigrate>(this);
     m_pdata->getGhostParticlesRemovedSignal()
         .disconnect<Communicator, &Communicator::slotGhostParticlesRemoved>(this);
@@ -1525,16 +1514,20 @@ void Communicator::initializeNeighborArrays()
     }
 
 //! Interface to the communication methods.
-void Communicator::communicate(uint64_t timestep)
+void Communicator::communicate(uint64_t timestep, bool overlap_ghost_update)
     {
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
+    // complete a ghost update left pending by the previous call
+    finishUpdateGhosts(timestep);
+
     // update ghost communication flags
     m_flags = CommFlags(0);
     m_requested_flags.emit_accumulate([&](CommFlags f) { m_flags |= f; }, timestep);
 
-    if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
+    if (!overlap_ghost_update && !m_force_migrate && !m_compute_callbacks.empty()
+        && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
         beginUpdateGhosts(timestep);
@@ -1559,11 +1552,13 @@ void Communicator::communicate(uint64_t timestep)
     bool migrate = migrate_request || m_force_migrate || !m_has_ghost_particles;
 
     // Update ghosts if we are not migrating
-    if (!migrate && m_compute_callbacks.empty())
+    if (!migrate && (m_compute_callbacks.empty() || overlap_ghost_update))
         {
         beginUpdateGhosts(timestep);
 
-        finishUpdateGhosts(timestep);
+        // the caller overlaps the rest of the update with computation
+        if (!overlap_ghost_update)
+            finishUpdateGhosts(timestep);
         }
 
     // Check if migration of particles is requested
@@ -1652,29 +1647,7 @@ void Communicator::migrateParticles()
         /*
          * Bonded group communication, determine groups to be sent
          */
-        // Bonds
-        m_bond_comm.migrateGroups(m_bonds_changed, true);
-        m_bonds_changed = false;
-
-        // Special pairs
-        m_pair_comm.migrateGroups(m_pairs_changed, true);
-        m_pairs_changed = false;
-
-        // Angles
-        m_angle_comm.migrateGroups(m_angles_changed, true);
-        m_angles_changed = false;
-
-        // Dihedrals
-        m_dihedral_comm.migrateGroups(m_dihedrals_changed, true);
-        m_dihedrals_changed = false;
-
-        // Dihedrals
-        m_improper_comm.migrateGroups(m_impropers_changed, true);
-        m_impropers_changed = false;
-
-        // Constraints
-        m_constraint_comm.migrateGroups(m_constraints_changed, true);
-        m_constraints_changed = false;
+        migrateBondedGroups();
 
         // fill send buffer
         std::vector<unsigned int> comm_flag_out; // not currently used
@@ -1805,11 +1778,56 @@ void Communicator::updateGhostWidth()
                 },
                 cur_type);
 
-            h_r_ghost_body.data[cur_type] = r_extra_ghost_i;
-            if (r_extra_ghost_i > r_extra_ghost_max)
-                r_extra_ghost_max = r_extra_ghost_i;
-            }
-        m_r_extra_ghost_max = r_extra_ghost_max;
+            h_r_ghost_body.data[cur_type] = r_extra_ghost_i;
+            if (r_extra_ghost_i > r_extra_ghost_max)
+                r_extra_ghost_max = r_extra_ghost_i;
+            }
+        m_r_extra_ghost_max = r_extra_ghost_max;
+        }
+
+    // the extra width applies on top of the ghost layer width of the same type only
+    ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body, access_location::host, access_mode::read);
+    m_r_ghost_combined_max = Scalar(0.0);
+    for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+        {
+        m_r_ghost_combined_max
+            = std::max(m_r_ghost_combined_max,
+                       h_r_ghost.data[cur_type] + h_r_ghost_body.data[cur_type]);
+        }
+    }
+
+/*! The window of 2^bits quantization steps in every direction spans the widest domain of the
+    decomposition and twice the ghost layer width on either side, which also covers the
+    displacement of the ghosts until the next exchange. All ranks compute the same number of steps
+    from the cumulative fractions of the decomposition.
+*/
+void Communicator::updateGhostPositionPacking()
+    {
+    m_ghost_packing.bits = m_ghost_position_bits;
+    if (!m_ghost_packing.bits)
+        return;
+
+    const Scalar3 npd = m_pdata->getGlobalBox().getNearestPlaneDistance();
+    const Scalar distance[3] = {npd.x, npd.y, npd.z};
+    const uint3 grid_pos = m_decomposition->getGridPos();
+    const unsigned int grid_idx[3] = {grid_pos.x, grid_pos.y, grid_pos.z};
+    const Scalar r_ghost = getGhostLayerMaxWidth();
+
+    for (unsigned int d = 0; d < 3; ++d)
+        {
+        std::vector<Scalar> fractions = m_decomposition->getCumulativeFractions(d);
+
+        double max_width = 0.0;
+        for (unsigned int i = 0; i + 1 < fractions.size(); ++i)
+            max_width = std::max(max_width, double(fractions[i + 1] - fractions[i]));
+
+        double window = max_width + 4.0 * r_ghost / distance[d];
+        int exponent = int(m_ghost_packing.bits) - int(std::ceil(std::log2(window)));
+        m_ghost_packing.steps[d] = std::ldexp(1.0, exponent);
+
+        double center = 0.5 * (fractions[grid_idx[d]] + fractions[grid_idx[d] + 1]);
+        m_ghost_packing.center[d] = (int64_t)std::floor(center * m_ghost_packing.steps[d] + 0.5);
         }
     }
 
@@ -1847,6 +1865,7 @@ void Communicator::exchangeGhosts()
      * Mark non-bonded atoms for sending
      */
     updateGhostWidth();
+    updateGhostPositionPacking();
 
     // compute the ghost layer widths as fractions
     ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
@@ -1939,6 +1958,10 @@ void Communicator::exchangeGhosts()
     // ghost particle flags
     CommFlags flags = getFlags();
 
+    // the compute callbacks after each ghost update rebuild the constituents of rigid bodies
+    m_rigid_ghosts_rebuilt = m_rebuild_rigid_ghosts && flags[comm_flag::body]
+                             && flags[comm_flag::orientation] && !m_compute_callbacks.empty();
+
     for (unsigned int dir = 0; dir < 6; dir++)
         {
         if (!isCommunicating(dir))
@@ -1949,6 +1972,7 @@ void Communicator::exchangeGhosts()
         // resize array of ghost particle tags
         unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
         m_copy_ghosts[dir].resize(max_copy_ghosts);
+        m_copy_ghosts_idx[dir].resize(max_copy_ghosts);
 
         // resize buffers
         m_plan_copybuf.resize(max_copy_ghosts);
@@ -2002,11 +2026,17 @@ void Communicator::exchangeGhosts()
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
                                             access_location::host,
                                             access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                             access_location::host,
+                                             access_mode::read);
             ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
 
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
                                                     access_location::host,
                                                     access_mode::overwrite);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::overwrite);
             ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf,
                                                      access_location::host,
                                                      access_mode::overwrite);
@@ -2032,30 +2062,64 @@ void Communicator::exchangeGhosts()
                                                        access_location::host,
                                                        access_mode::overwrite);
 
-            for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
+            // send with next message
+            auto copy_ghost = [&](unsigned int idx)
+            {
+                if (flags[comm_flag::position])
+                    h_pos_copybuf.data[m_num_copy_ghosts[dir]] = h_pos.data[idx];
+                if (flags[comm_flag::charge])
+                    h_charge_copybuf.data[m_num_copy_ghosts[dir]] = h_charge.data[idx];
+                if (flags[comm_flag::diameter])
+                    h_diameter_copybuf.data[m_num_copy_ghosts[dir]] = h_diameter.data[idx];
+                if (flags[comm_flag::body])
+                    h_body_copybuf.data[m_num_copy_ghosts[dir]] = h_body.data[idx];
+                if (flags[comm_flag::image])
+                    h_image_copybuf.data[m_num_copy_ghosts[dir]] = h_image.data[idx];
+                if (flags[comm_flag::velocity])
+                    h_velocity_copybuf.data[m_num_copy_ghosts[dir]] = h_vel.data[idx];
+                if (flags[comm_flag::orientation])
+                    h_orientation_copybuf.data[m_num_copy_ghosts[dir]] = h_orientation.data[idx];
+                h_plan_copybuf.data[m_num_copy_ghosts[dir]] = h_plan.data[idx];
+
+                h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
+                h_copy_ghosts_idx.data[m_num_copy_ghosts[dir]] = idx;
+                m_num_copy_ghosts[dir]++;
+            };
+
+            // A constituent can be rebuilt on the receiving rank when its central particle is sent
+            // in this direction and also goes everywhere the constituent is forwarded to next.
+            // The forwarding ranks then skip it again.
+            const unsigned int later_dirs = 0x3f & ~((2u << dir) - 1);
+            auto rebuilt_from_central = [&](unsigned int idx)
+            {
+                const unsigned int central_tag = h_body.data[idx];
+                if (central_tag >= MIN_FLOPPY || central_tag == h_tag.data[idx])
+                    return false;
+
+                const unsigned int central_idx = h_rtag.data[central_tag];
+                if (central_idx == NOT_LOCAL || !(h_plan.data[central_idx] & (1 << dir)))
+                    return false;
+
+                return (h_plan.data[idx] & later_dirs & ~h_plan.data[central_idx]) == 0;
+            };
+
+            // the ghosts sent in ghost updates come first
+            const unsigned int n_candidates = m_pdata->getN() + m_pdata->getNGhosts();
+            for (unsigned int idx = 0; idx < n_candidates; idx++)
+                {
+                if ((h_plan.data[idx] & (1 << dir))
+                    && !(m_rigid_ghosts_rebuilt && rebuilt_from_central(idx)))
+                    copy_ghost(idx);
+                }
+
+            m_num_copy_ghosts_update[dir] = m_num_copy_ghosts[dir];
+
+            if (m_rigid_ghosts_rebuilt)
                 {
-                if (h_plan.data[idx] & (1 << dir))
+                for (unsigned int idx = 0; idx < n_candidates; idx++)
                     {
-                    // send with next message
-                    if (flags[comm_flag::position])
-                        h_pos_copybuf.data[m_num_copy_ghosts[dir]] = h_pos.data[idx];
-                    if (flags[comm_flag::charge])
-                        h_charge_copybuf.data[m_num_copy_ghosts[dir]] = h_charge.data[idx];
-                    if (flags[comm_flag::diameter])
-                        h_diameter_copybuf.data[m_num_copy_ghosts[dir]] = h_diameter.data[idx];
-                    if (flags[comm_flag::body])
-                        h_body_copybuf.data[m_num_copy_ghosts[dir]] = h_body.data[idx];
-                    if (flags[comm_flag::image])
-                        h_image_copybuf.data[m_num_copy_ghosts[dir]] = h_image.data[idx];
-                    if (flags[comm_flag::velocity])
-                        h_velocity_copybuf.data[m_num_copy_ghosts[dir]] = h_vel.data[idx];
-                    if (flags[comm_flag::orientation])
-                        h_orientation_copybuf.data[m_num_copy_ghosts[dir]]
-                            = h_orientation.data[idx];
-                    h_plan_copybuf.data[m_num_copy_ghosts[dir]] = h_plan.data[idx];
-
-                    h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
-                    m_num_copy_ghosts[dir]++;
+                    if ((h_plan.data[idx] & (1 << dir)) && rebuilt_from_central(idx))
+                        copy_ghost(idx);
                     }
                 }
             }
@@ -2092,7 +2156,24 @@ void Communicator::exchangeGhosts()
                   &req);
         m_reqs.push_back(req);
 
-        m_stats.resize(2);
+        MPI_Isend(&m_num_copy_ghosts_update[dir],
+                  sizeof(unsigned int),
+                  MPI_BYTE,
+                  send_neighbor,
+                  10,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+        MPI_Irecv(&m_num_recv_ghosts_update[dir],
+                  sizeof(unsigned int),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  10,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+
+        m_stats.resize(m_reqs.size());
         MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
         if (m_prof)
@@ -2690,10 +2771,32 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
-    // update data in these arrays
+    // update data in these arrays. Positions and orientations are sent for the first
+    // m_num_copy_ghosts_update ghosts of each direction, the others are rigid body constituents
+    // that the compute callbacks rebuild (see setRebuildRigidGhosts()).
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
+    // find the last direction to communicate along
+    unsigned int last_dir = 0;
+    unsigned int max_copy_ghosts = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (isCommunicating(dir))
+            {
+            last_dir = dir;
+            max_copy_ghosts = std::max(max_copy_ghosts, m_num_copy_ghosts[dir]);
+            }
+        }
+
+    // the packed buffers keep their size (and address) until the next ghost exchange
+    const bool pack_positions = m_ghost_packing.bits && getFlags()[comm_flag::position];
+    if (pack_positions)
+        {
+        m_pos_packed_copybuf.resize(max_copy_ghosts);
+        m_pos_packed_recvbuf.resize(m_pdata->getNGhosts());
+        }
+
     for (unsigned int dir = 0; dir < 6; dir++)
         {
         if (!isCommunicating(dir))
@@ -2701,7 +2804,32 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
         CommFlags flags = getFlags();
 
-        if (flags[comm_flag::position])
+        if (pack_positions)
+            {
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+            ArrayHandle<uint3> h_pos_packed_copybuf(m_pos_packed_copybuf,
+                                                    access_location::host,
+                                                    access_mode::overwrite);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
+
+            // pack positions of ghost particles
+            const BoxDim& global_box = m_pdata->getGlobalBox();
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts_update[dir];
+                 ghost_idx++)
+                {
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
+
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                h_pos_packed_copybuf.data[ghost_idx]
+                    = packGhostPosition(m_ghost_packing, global_box, h_pos.data[idx]);
+                }
+            }
+        else if (flags[comm_flag::position])
             {
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
@@ -2709,17 +2837,15 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
             ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
                                                access_location::host,
                                                access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
 
             // copy positions of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts_update[dir];
+                 ghost_idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -2736,17 +2862,14 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
             ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
                                                     access_location::host,
                                                     access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
 
             // copy velocity of ghost particles
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -2763,17 +2886,15 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
                                                        access_location::host,
                                                        access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
 
             // copy orientation of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts_update[dir];
+                 ghost_idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -2801,13 +2922,33 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         num_tot_recv_ghosts += m_num_recv_ghosts[dir];
 
         size_t sz = 0;
+        m_reqs.clear();
+
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
+        if (pack_positions)
+            {
+            ArrayHandle<uint3> h_pos_packed_copybuf(m_pos_packed_copybuf,
+                                                    access_location::host,
+                                                    access_mode::read);
+            ArrayHandle<uint3> h_pos_packed_recvbuf(m_pos_packed_recvbuf,
+                                                    access_location::host,
+                                                    access_mode::readwrite);
+
+            // the received positions are unpacked into the particle data on completion
+            postGhostUpdate(dir,
+                            1,
+                            h_pos_packed_copybuf.data,
+                            (unsigned int)(m_num_copy_ghosts_update[dir] * sizeof(uint3)),
+                            send_neighbor,
+                            h_pos_packed_recvbuf.data + start_idx - m_pdata->getN(),
+                            (unsigned int)(m_num_recv_ghosts_update[dir] * sizeof(uint3)),
+                            recv_neighbor);
+
+            sz += sizeof(uint3);
+            }
+        else if (flags[comm_flag::position])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
                                        access_mode::readwrite);
@@ -2816,30 +2957,20 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                                                access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data,
-                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      send_neighbor,
-                      1,
-                      m_mpi_comm,
-                      &m_reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx,
-                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      recv_neighbor,
-                      1,
-                      m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postGhostUpdate(dir,
+                            1,
+                            h_pos_copybuf.data,
+                            (unsigned int)(m_num_copy_ghosts_update[dir] * sizeof(Scalar4)),
+                            send_neighbor,
+                            h_pos.data + start_idx,
+                            (unsigned int)(m_num_recv_ghosts_update[dir] * sizeof(Scalar4)),
+                            recv_neighbor);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::velocity])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                        access_location::host,
                                        access_mode::readwrite);
@@ -2848,30 +2979,20 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                                                access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data,
-                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      send_neighbor,
-                      2,
-                      m_mpi_comm,
-                      &m_reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx,
-                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      recv_neighbor,
-                      2,
-                      m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postGhostUpdate(dir,
+                            2,
+                            h_vel_copybuf.data,
+                            (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
+                            send_neighbor,
+                            h_vel.data + start_idx,
+                            (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
+                            recv_neighbor);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::orientation])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                                access_location::host,
                                                access_mode::readwrite);
@@ -2880,52 +3001,197 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                                                        access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data,
-                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      send_neighbor,
-                      3,
-                      m_mpi_comm,
-                      &m_reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx,
-                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      recv_neighbor,
-                      3,
-                      m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postGhostUpdate(dir,
+                            3,
+                            h_orientation_copybuf.data,
+                            (unsigned int)(m_num_copy_ghosts_update[dir] * sizeof(Scalar4)),
+                            send_neighbor,
+                            h_orientation.data + start_idx,
+                            (unsigned int)(m_num_recv_ghosts_update[dir] * sizeof(Scalar4)),
+                            recv_neighbor);
 
             sz += sizeof(Scalar4);
             }
 
+        if (dir == last_dir)
+            {
+            // the ghosts received in the last direction are not forwarded, finishUpdateGhosts()
+            // completes their communication
+            m_comm_pending = true;
+            m_pending_ghosts_begin = start_idx;
+            m_pending_ghosts_end = start_idx + m_num_recv_ghosts_update[dir];
+            }
+        else
+            {
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall((int)m_reqs.size(), m_reqs.data(), m_stats.data());
+            }
+
         if (m_prof)
             m_prof->pop(0, (m_num_recv_ghosts[dir] + m_num_copy_ghosts[dir]) * sz);
 
         // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
+        if (dir != last_dir && flags[comm_flag::position])
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::readwrite);
+            // the skipped constituents are rebuilt from their central particles
+            const unsigned int end_idx = start_idx + m_num_recv_ghosts_update[dir];
+            if (pack_positions)
+                unpackGhostPositions(start_idx, end_idx);
+            wrapGhostPositions(start_idx, end_idx);
+            }
+        } // end dir loop
 
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
+    if (m_prof)
+        m_prof->pop();
+    }
 
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0, 0, 0);
-                shifted_box.wrap(pos, img);
+/*! \param dir Direction of the ghost update
+    \param tag MPI tag, 1 (position), 2 (velocity), or 3 (orientation)
+    \param send_buf Buffer to send
+    \param send_bytes Number of bytes to send
+    \param send_neighbor Rank to send to
+    \param recv_buf Buffer to receive into
+    \param recv_bytes Number of bytes to receive
+    \param recv_neighbor Rank to receive from
+
+    Appends the requests to m_reqs. When m_persistent_ghost_update is set, the persistent requests
+    of this direction and field are started, and created again first when the buffers or sizes
+    differ from those they were created with.
+*/
+void Communicator::postGhostUpdate(unsigned int dir,
+                                   unsigned int tag,
+                                   const void* send_buf,
+                                   unsigned int send_bytes,
+                                   unsigned int send_neighbor,
+                                   void* recv_buf,
+                                   unsigned int recv_bytes,
+                                   unsigned int recv_neighbor)
+    {
+    MPI_Request req;
+    if (!m_persistent_ghost_update)
+        {
+        MPI_Isend(send_buf, send_bytes, MPI_BYTE, send_neighbor, tag, m_mpi_comm, &req);
+        m_reqs.push_back(req);
+        MPI_Irecv(recv_buf, recv_bytes, MPI_BYTE, recv_neighbor, tag, m_mpi_comm, &req);
+        m_reqs.push_back(req);
+        return;
+        }
+
+    GhostUpdateRequest& r = m_ghost_update_reqs[dir][tag - 1];
+    if (!r.valid || r.send_buf != send_buf || r.recv_buf != recv_buf || r.send_bytes != send_bytes
+        || r.recv_bytes != recv_bytes)
+        {
+        if (r.valid)
+            {
+            MPI_Request_free(&r.send_req);
+            MPI_Request_free(&r.recv_req);
+            }
+
+        MPI_Send_init(send_buf, send_bytes, MPI_BYTE, send_neighbor, tag, m_mpi_comm, &r.send_req);
+        MPI_Recv_init(recv_buf, recv_bytes, MPI_BYTE, recv_neighbor, tag, m_mpi_comm, &r.recv_req);
+        r.valid = true;
+        r.send_buf = send_buf;
+        r.recv_buf = recv_buf;
+        r.send_bytes = send_bytes;
+        r.recv_bytes = recv_bytes;
+        }
+
+    // a completed persistent request becomes inactive and keeps its handle
+    MPI_Start(&r.send_req);
+    m_reqs.push_back(r.send_req);
+    MPI_Start(&r.recv_req);
+    m_reqs.push_back(r.recv_req);
+    }
+
+void Communicator::freeGhostUpdateRequests()
+    {
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        for (GhostUpdateRequest& r : m_ghost_update_reqs[dir])
+            {
+            if (r.valid)
+                {
+                MPI_Request_free(&r.send_req);
+                MPI_Request_free(&r.recv_req);
+                r.valid = false;
                 }
             }
+        }
+    }
 
-        } // end dir loop
+/*! \param timestep The time step
+
+    Waits for the ghosts of the last direction to arrive and wraps their positions.
+*/
+void Communicator::finishUpdateGhosts(uint64_t timestep)
+    {
+    if (!m_comm_pending)
+        return;
+
+    m_comm_pending = false;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((int)m_reqs.size(), m_reqs.data(), m_stats.data());
+
+    if (getFlags()[comm_flag::position])
+        {
+        if (m_ghost_packing.bits)
+            unpackGhostPositions(m_pending_ghosts_begin, m_pending_ghosts_end);
+        wrapGhostPositions(m_pending_ghosts_begin, m_pending_ghosts_end);
+        }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param first Index of the first received ghost
+    \param last Index one past the last received ghost
+
+    Wraps the positions of ghosts that were received across a global boundary.
+*/
+void Communicator::wrapGhostPositions(unsigned int first, unsigned int last)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    const BoxDim shifted_box = getShiftedBox();
+    for (unsigned int idx = first; idx < last; idx++)
+        {
+        Scalar4& pos = h_pos.data[idx];
+
+        // wrap particles received across a global boundary
+        int3 img = make_int3(0, 0, 0);
+        shifted_box.wrap(pos, img);
+        }
+    }
+
+/*! \param first Index of the first received ghost
+    \param last Index one past the last received ghost
+
+    Decodes the packed positions of the received ghosts in m_pos_packed_recvbuf.
+*/
+void Communicator::unpackGhostPositions(unsigned int first, unsigned int last)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<uint3> h_pos_packed_recvbuf(m_pos_packed_recvbuf,
+                                            access_location::host,
+                                            access_mode::read);
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const unsigned int N = m_pdata->getN();
+    for (unsigned int idx = first; idx < last; idx++)
+        {
+        h_pos.data[idx]
+            = unpackGhostPosition(m_ghost_packing, global_box, h_pos_packed_recvbuf.data[idx - N]);
+        }
+    }
+
 void Communicator::updateNetForce(uint64_t timestep)
     {
     CommFlags flags = getFlags();
@@ -3026,17 +3292,14 @@ void Communicator::updateNetForce(uint64_t timestep)
             ArrayHandle<Scalar4> h_netforce_copybuf(m_netforce_copybuf,
                                                     access_location::host,
                                                     access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
 
             // copy net forces of ghost particles
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -3096,17 +3359,14 @@ void Communicator::updateNetForce(uint64_t timestep)
             ArrayHandle<Scalar4> h_nettorque_copybuf(m_nettorque_copybuf,
                                                      access_location::host,
                                                      access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
 
             // copy net torques of ghost particles
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -3122,19 +3382,16 @@ void Communicator::updateNetForce(uint64_t timestep)
             ArrayHandle<Scalar> h_netvirial_copybuf(m_netvirial_copybuf,
                                                     access_location::host,
                                                     access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_idx(m_copy_ghosts_idx[dir],
+                                                        access_location::host,
+                                                        access_mode::read);
 
             unsigned int pitch = (unsigned int)m_pdata->getNetVirial().getPitch();
 
             // copy net torques of ghost particles
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                unsigned int idx = h_copy_ghosts_idx.data[ghost_idx];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -3489,6 +3746,11 @@ const BoxDim Communicator::getShiftedBox() const
     periodic.y = isCommunicating(face_north) ? 1 : 0;
     periodic.z = isCommunicating(face_up) ? 1 : 0;
 
+    // particles wrapped along y by a Lees-Edwards offset are wrapped back into the box along x,
+    // which requires that the box is not decomposed along x
+    if (periodic.y && shifted_box.getLeesEdwardsOffset() != Scalar(0.0))
+        periodic.x = 1;
+
     shifted_box.setPeriodic(periodic);
 
     return shifted_box;
@@ -3499,6 +3761,16 @@ void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator>>(m, "Communicator")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition>>())
-        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
+        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition)
+        .def_property("persistent_ghost_update",
+                      &Communicator::getPersistentGhostUpdate,
+                      &Communicator::setPersistentGhostUpdate)
+        .def_property("ghost_position_bits",
+                      &Communicator::getGhostPositionBits,
+                      &Communicator::setGhostPositionBits)
+        .def_property("rebuild_rigid_ghosts",
+                      &Communicator::getRebuildRigidGhosts,
+                      &Communicator::setRebuildRigidGhosts)
+        .def_property_readonly("rigid_ghosts_rebuilt", &Communicator::isRebuildingRigidGhosts);
     }
 #endif // ENABLE_MPI
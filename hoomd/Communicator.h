@@ -15,12 +15,14 @@
 #include "BondedGroupData.h"
 #include "DomainDecomposition.h"
 #include "GPUVector.h"
+#include "GhostPositionPacking.h"
 #include "GlobalArray.h"
 #include "HOOMDMath.h"
 #include "ParticleData.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <stdexcept>
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -114,6 +116,9 @@ template<typename ranks_t> struct rank_element
  * <br> If it is not necessary to renew the list of ghost particles (i.e. when no particle in the
  * global system has moved more than a distance \f$ r_{\mathrm{buff}}/2 \f$), we use the current
  * ghost particle list to update the ghost positions on the neighboring processors.
+ * The particles are not reordered between two ghost exchanges (a sort or a change of the particle
+ * number forces a migration), so the ghost update reads the particles to send by the local indices
+ * that exchangeGhosts() cached and does not look up the tags.
  *
  * Stages \b one and \b two are performed before every neighbor list build, stage \b three is
  * executed in all other steps (before the calculation of forces).
@@ -262,9 +267,12 @@ class PYBIND11_EXPORT Communicator
         }
 
     //! Get the current maximum ghost layer width
+    /*! The maximum is taken over the sum of the ghost layer width and the extra width of each
+        type, a type with a wide ghost layer and another type with a large extra width do not add.
+    */
     Scalar getGhostLayerMaxWidth() const
         {
-        return m_r_ghost_max + m_r_extra_ghost_max;
+        return m_r_ghost_combined_max;
         }
 
     //! Set the ghost communication flags
@@ -283,8 +291,14 @@ class PYBIND11_EXPORT Communicator
     /*! Interface to the communication methods.
      * This method is supposed to be called every time step and automatically performs all necessary
      * communication steps.
+     *
+     * \param timestep The time step
+     * \param overlap_ghost_update When true and the particles do not migrate, begin the ghost
+     *        update and return without waiting for it. The caller must complete it with
+     *        finishUpdateGhosts() before it accesses ghost particles. The compute callbacks are not
+     *        called in this case, so only request it when they have nothing to do.
      */
-    void communicate(uint64_t timestep);
+    void communicate(uint64_t timestep, bool overlap_ghost_update = false);
 
     //@}
 
@@ -314,11 +328,93 @@ class PYBIND11_EXPORT Communicator
     /*! Finish ghost update
      *
      * \param timestep The time step
+     *
+     * Does nothing when no ghost update is pending.
      */
-    virtual void finishUpdateGhosts(uint64_t timestep)
+    virtual void finishUpdateGhosts(uint64_t timestep);
+
+    //! Returns true if a ghost update has begun and not yet finished
+    bool isGhostUpdatePending() const
+        {
+        return m_comm_pending;
+        }
+
+    //! Set whether ghost updates use persistent MPI requests
+    /*! \param persistent True to reuse persistent requests, false to post new requests every step
+
+        The persistent requests are created on the first ghost update after a ghost exchange
+        changes the buffers or the number of ghosts, and are reused until then.
+    */
+    void setPersistentGhostUpdate(bool persistent)
+        {
+        if (m_comm_pending)
+            throw std::runtime_error("Cannot change persistent_ghost_update during a ghost update");
+        if (!persistent)
+            freeGhostUpdateRequests();
+        m_persistent_ghost_update = persistent;
+        }
+
+    //! Get whether ghost updates use persistent MPI requests
+    bool getPersistentGhostUpdate() const
+        {
+        return m_persistent_ghost_update;
+        }
+
+    //! Set the number of bits per component of the ghost positions sent in ghost updates
+    /*! \param bits 0 to send ghost positions as Scalar4, or 8 to 21 to send them as fixed-point
+            offsets (see GhostPositionPacking)
+
+        Orientations and velocities are always sent at full precision, and ghost exchanges always
+        send full positions. The pair forces between local and ghost particles are no longer
+        exactly antisymmetric across domains with the reduced precision.
+
+        Takes effect at the next ghost exchange. Collective call.
+    */
+    void setGhostPositionBits(unsigned int bits)
         {
-        // the base class implementation is currently empty
-        m_comm_pending = false;
+        if (bits != 0 && (bits < 8 || bits > 21))
+            throw std::invalid_argument("ghost_position_bits must be 0 or between 8 and 21");
+        m_ghost_position_bits = bits;
+        forceMigrate();
+        }
+
+    //! Get the number of bits per component of the ghost positions sent in ghost updates
+    unsigned int getGhostPositionBits() const
+        {
+        return m_ghost_position_bits;
+        }
+
+    //! Set whether ghost updates skip the constituent particles of rigid bodies
+    /*! \param rebuild True to send only the positions and orientations of the central particles
+            and the constituents that cannot be rebuilt on the receiving rank
+
+        A constituent is skipped when its central particle travels in the same direction and
+        further along all of its remaining route. The compute callbacks that follow the ghost
+        update (ForceComposite::updateCompositeParticles()) place the skipped constituents
+        relative to their central particles. Velocities are always sent, and ghost exchanges
+        always send all particles.
+
+        The mode is active only while rigid bodies request the body and orientation flags and a
+        compute callback is connected. CommunicatorGPU always sends the constituents.
+
+        Takes effect at the next ghost exchange. Collective call.
+    */
+    void setRebuildRigidGhosts(bool rebuild)
+        {
+        m_rebuild_rigid_ghosts = rebuild;
+        forceMigrate();
+        }
+
+    //! Get whether ghost updates skip the constituent particles of rigid bodies
+    bool getRebuildRigidGhosts() const
+        {
+        return m_rebuild_rigid_ghosts;
+        }
+
+    //! Returns true if the ghost updates since the last exchange skip rigid body constituents
+    bool isRebuildingRigidGhosts() const
+        {
+        return m_rigid_ghosts_rebuilt;
         }
 
     /*! Communicate the net particle force
@@ -387,7 +483,23 @@ class PYBIND11_EXPORT Communicator
     virtual void setAutotunerParams(bool enable, unsigned int period) { }
 
     protected:
+    //! Send and receive buffers of one group type in a batched exchange of bonded groups
+    struct GroupExchangeBuffer
+        {
+        const char* send;               //!< Elements to send, sorted by destination rank
+        const unsigned int* send_begin; //!< First element sent to each unique neighbor
+        const unsigned int* n_send;     //!< Number of elements sent to each unique neighbor
+        unsigned int* n_recv;           //!< Number of elements received from each unique neighbor
+        char* recv;                     //!< Received elements, in the order of the unique neighbors
+        size_t element_size;            //!< Size of one element in bytes
+        };
+
     //! Helper class to perform the communication tasks related to bonded groups
+    /*! Migration is split into stages so that the Communicator can exchange the groups of all types
+        together: packRanks(), allocateRanksRecv(), and unpackRanks() update the member ranks of the
+        groups that are split across domains (phase 1), then packGroups(), allocateGroupsRecv(), and
+        unpackGroups() move the groups whose members leave this domain (phase 2).
+    */
     template<class group_data> class GroupCommunicator
         {
         public:
@@ -397,15 +509,42 @@ class PYBIND11_EXPORT Communicator
         //! Constructor
         GroupCommunicator(Communicator& comm, std::shared_ptr<group_data> gdata);
 
-        //! Migrate groups
+        //! Returns true if there are groups of this type in the system
+        bool hasGroups() const
+            {
+            return m_gdata->getNGlobal() > 0;
+            }
+
+        //! Pack the rank information of groups that need to be updated
         /*! \param incomplete If true, mark all groups that have non-local members and update local
          *         member rank information. Otherwise, mark only groups flagged for communication
          *         in particle data
-         *  \param local_multiple If true, a group may be split across several ranks
+         *  \param buf Buffer description to fill in for the exchange
+         */
+        void packRanks(bool incomplete, GroupExchangeBuffer& buf);
+
+        //! Resize the rank receive buffer to the received counts in \a buf
+        void allocateRanksRecv(GroupExchangeBuffer& buf);
+
+        //! Update the member ranks from the received rank information
+        void unpackRanks();
+
+        //! Remove groups that are no longer local and pack the groups to send
+        /*! \param local_multiple If true, a group may be split across several ranks
+         *  \param buf Buffer description to fill in for the exchange
+         *
          * A group is marked for sending by setting its rtag to GROUP_NOT_LOCAL, and by updating
          * the rank information with the destination ranks (or the local ranks if incomplete=true)
          */
-        void migrateGroups(bool incomplete, bool local_multiple);
+        void packGroups(bool local_multiple, GroupExchangeBuffer& buf);
+
+        //! Resize the group receive buffer to the received counts in \a buf
+        void allocateGroupsRecv(GroupExchangeBuffer& buf);
+
+        //! Add the received groups
+        /*! \param local_multiple If true, a group may be split across several ranks
+         */
+        void unpackGroups(bool local_multiple);
 
         //! Mark ghost particles
         /* All particles that need to be sent as ghosts because they are members
@@ -436,8 +575,24 @@ class PYBIND11_EXPORT Communicator
             m_groups_sendbuf; //!< Send buffer for group elements
         std::vector<typename group_data::packed_t>
             m_groups_recvbuf; //!< Receive buffer for group elements
+
+        std::vector<unsigned int> m_send_begin; //!< First element sent to each unique neighbor
+        std::vector<unsigned int> m_n_send;     //!< Number of elements sent to each neighbor
+        std::vector<unsigned int> m_n_recv;     //!< Number of elements received from each neighbor
+
+        //! Set the send ranges of the unique neighbors from a send map sorted by rank
+        template<class map_t> void setSendRanges(const map_t& send_map);
         };
 
+    //! Migrate the bonded groups of all types together
+    void migrateBondedGroups();
+
+    //! Exchange the element counts of several group types with the unique neighbors
+    void exchangeGroupCounts(std::vector<GroupExchangeBuffer>& buffers);
+
+    //! Exchange the elements of several group types with the unique neighbors
+    void exchangeGroupElements(const std::vector<GroupExchangeBuffer>& buffers);
+
     //! Returns true if we are communicating particles along a given direction
     /*! \param dir Direction to return dimensions for
      */
@@ -498,10 +653,20 @@ class PYBIND11_EXPORT Communicator
 
     GlobalVector<unsigned int>
         m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
+    GlobalVector<unsigned int>
+        m_copy_ghosts_idx[6]; //!< Local indices of the particles in m_copy_ghosts
     unsigned int
         m_num_copy_ghosts[6]; //!< Number of local particles that are sent to neighboring processors
     unsigned int m_num_recv_ghosts[6]; //!< Number of ghosts received per direction
 
+    /// Number of ghosts per direction whose positions and orientations are sent in ghost updates
+    /** The ghosts that are rebuilt from their central particles follow these in m_copy_ghosts.
+     */
+    unsigned int m_num_copy_ghosts_update[6] = {};
+
+    /// Number of ghosts per direction whose positions and orientations are received in updates
+    unsigned int m_num_recv_ghosts_update[6] = {};
+
     GlobalVector<unsigned int>
         m_plan; //!< Array of per-direction flags that determine the sending route
 
@@ -552,15 +717,25 @@ class PYBIND11_EXPORT Communicator
     GlobalArray<Scalar> m_r_ghost_body; //!< Extra ghost width for rigid bodies
     Scalar m_r_ghost_max;               //!< Maximum ghost layer width
     Scalar m_r_extra_ghost_max;         //!< Maximum extra ghost layer width
+    Scalar m_r_ghost_combined_max;      //!< Maximum ghost layer width including the extra width
 
     unsigned int m_ghosts_added; //!< Number of ghosts added
     bool m_has_ghost_particles;  //!< True if we have a current copy of ghost particles
 
+    unsigned int m_ghost_position_bits = 0;    //!< Requested bits per ghost position component
+    GhostPositionPacking m_ghost_packing = {}; //!< Ghost position encoding of the last exchange
+
+    bool m_rebuild_rigid_ghosts = false; //!< True to skip rebuildable constituents in updates
+    bool m_rigid_ghosts_rebuilt = false; //!< True if the last exchange skipped constituents
+
     MPI_Datatype m_mpi_pdata_element; //!< A datatype for the (non-packed) pdata_element struct
 
     //! Update the ghost width array
     void updateGhostWidth();
 
+    //! Compute the ghost position encoding for the decomposition and the ghost layer width
+    void updateGhostPositionPacking();
+
     Nano::Signal<bool(uint64_t timestep)>
         m_migrate_requests; //!< List of functions that may request particle migration
 
@@ -689,9 +864,51 @@ class PYBIND11_EXPORT Communicator
     GroupCommunicator<PairData> m_pair_comm; //!< Communication helper for special pairs
     friend class GroupCommunicator<PairData>;
 
+    unsigned int m_pending_ghosts_begin = 0; //!< First ghost of the pending update
+    unsigned int m_pending_ghosts_end = 0;   //!< One past the last ghost of the pending update
+
+    //! Persistent send and receive of one field in one direction of the ghost update
+    struct GhostUpdateRequest
+        {
+        bool valid = false;             //!< True when the requests have been created
+        const void* send_buf = nullptr; //!< Send buffer the requests were created with
+        void* recv_buf = nullptr;       //!< Receive buffer the requests were created with
+        unsigned int send_bytes = 0;    //!< Size of the send
+        unsigned int recv_bytes = 0;    //!< Size of the receive
+        MPI_Request send_req;           //!< Persistent send request
+        MPI_Request recv_req;           //!< Persistent receive request
+        };
+
+    bool m_persistent_ghost_update = true; //!< True to use persistent requests in ghost updates
+
+    /// Persistent requests per direction and field (position, velocity, orientation)
+    GhostUpdateRequest m_ghost_update_reqs[6][3];
+
+    GlobalVector<uint3> m_pos_packed_copybuf; //!< Send buffer for packed ghost positions
+    GlobalVector<uint3> m_pos_packed_recvbuf; //!< Receive buffer for packed ghost positions
+
+    //! Unpack the received positions of ghosts into the particle data
+    void unpackGhostPositions(unsigned int first, unsigned int last);
+
+    //! Post the send and receive of one field in one direction of the ghost update
+    void postGhostUpdate(unsigned int dir,
+                         unsigned int tag,
+                         const void* send_buf,
+                         unsigned int send_bytes,
+                         unsigned int send_neighbor,
+                         void* recv_buf,
+                         unsigned int recv_bytes,
+                         unsigned int recv_neighbor);
+
+    //! Free the persistent ghost update requests
+    void freeGhostUpdateRequests();
+
     //! Helper function to initialize adjacency arrays
     void initializeNeighborArrays();
 
+    //! Wrap the positions of received ghost particles
+    void wrapGhostPositions(unsigned int first, unsigned int last);
+
     //! Method that is called when ghost particles are requested to be removed
     void slotGhostParticlesRemoved()
         {
@@ -16,11 +16,18 @@
 
 namespace py = pybind11;
 #include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef OPEN_MPI
+#include <mpi-ext.h>
+#endif
 
 //! Constructor
 CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
                                  std::shared_ptr<DomainDecomposition> decomposition)
-    : Communicator(sysdef, decomposition), m_max_stages(1), m_num_stages(0), m_comm_mask(0),
+    : Communicator(sysdef, decomposition), m_max_stages(1), m_gpu_direct(false), m_num_stages(0),
+      m_comm_mask(0),
       m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
@@ -35,6 +42,15 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
             << std::endl;
         }
 
+#ifdef ENABLE_MPI_CUDA
+    m_gpu_direct = isMPIDeviceAware();
+    if (!m_gpu_direct)
+        {
+        m_exec_conf->msg->notice(2) << "The MPI library does not support device memory, staging "
+                                    << "communication through host memory." << std::endl;
+        }
+#endif
+
     // allocate memory
     allocateBuffers();
 
@@ -50,6 +66,38 @@ CommunicatorGPU::~CommunicatorGPU()
     {
     m_exec_conf->msg->notice(5) << "Destroying CommunicatorGPU";
     hipEventDestroy(m_event);
+
+    // the graph communicators can only be freed before MPI_Finalize
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized)
+        freeNeighborGraphs();
+    }
+
+/*! \returns false when the MPI library reports that it cannot access device memory, true
+    otherwise
+
+    Open MPI reports its support at runtime. MVAPICH2 and Cray MPICH enable support with environment
+    variables. Other MPI libraries are assumed to support device memory as configured at build time.
+*/
+bool CommunicatorGPU::isMPIDeviceAware()
+    {
+#if defined(__HIP_PLATFORM_NVCC__) && defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+    return MPIX_Query_cuda_support() == 1;
+#elif defined(__HIP_PLATFORM_HCC__) && defined(MPIX_ROCM_AWARE_SUPPORT) && MPIX_ROCM_AWARE_SUPPORT
+    return MPIX_Query_rocm_support() == 1;
+#elif defined(OPEN_MPI) && defined(__HIP_PLATFORM_NVCC__)
+    // Open MPI built without CUDA support
+    return false;
+#else
+    for (const char* var : {"MV2_USE_CUDA", "MPICH_GPU_SUPPORT_ENABLED"})
+        {
+        const char* value = getenv(var);
+        if (value != NULL)
+            return std::string(value) == "1";
+        }
+    return true;
+#endif
     }
 
 void CommunicatorGPU::allocateBuffers()
@@ -87,6 +135,12 @@ void CommunicatorGPU::allocateBuffers()
     GlobalVector<Scalar4> pos_ghost_recvbuf(m_exec_conf);
     m_pos_ghost_recvbuf.swap(pos_ghost_recvbuf);
 
+    GlobalVector<uint3> pos_packed_ghost_sendbuf(m_exec_conf);
+    m_pos_packed_ghost_sendbuf.swap(pos_packed_ghost_sendbuf);
+
+    GlobalVector<uint3> pos_packed_ghost_recvbuf(m_exec_conf);
+    m_pos_packed_ghost_recvbuf.swap(pos_packed_ghost_recvbuf);
+
     GlobalVector<Scalar4> vel_ghost_sendbuf(m_exec_conf);
     m_vel_ghost_sendbuf.swap(vel_ghost_sendbuf);
 
@@ -279,6 +333,135 @@ void CommunicatorGPU::initializeCommunicationStages()
 
     m_exec_conf->msg->notice(4) << "CommunicatorGPU: Using " << m_num_stages
                                 << " communication stage(s)." << std::endl;
+
+    // the neighborhood of every stage changes with the stages
+    if (m_neighbor_collectives)
+        initializeNeighborGraphs();
+    }
+
+void CommunicatorGPU::setNeighborCollectives(bool neighbor_collectives)
+    {
+    if (m_comm_pending)
+        throw std::runtime_error("Cannot change neighbor_collectives during a ghost update.");
+
+    if (neighbor_collectives == m_neighbor_collectives)
+        return;
+
+    m_neighbor_collectives = neighbor_collectives;
+
+    if (m_neighbor_collectives)
+        initializeNeighborGraphs();
+    else
+        freeNeighborGraphs();
+    }
+
+/*! One distributed graph communicator per stage connects this rank to the unique neighbors it
+    exchanges ghosts with in that stage. Every neighbor is both a source and a destination and the
+    ranks are not reordered, so the neighbor order in a graph is the order in m_stage_neighbors.
+*/
+void CommunicatorGPU::initializeNeighborGraphs()
+    {
+    freeNeighborGraphs();
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    m_stage_neighbors.resize(m_num_stages);
+    m_stage_comms.resize(m_num_stages, MPI_COMM_NULL);
+
+    for (unsigned int stage = 0; stage < m_num_stages; ++stage)
+        {
+        std::vector<int> ranks;
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            {
+            if (m_stages[ineigh] == (int)stage)
+                {
+                m_stage_neighbors[stage].push_back(ineigh);
+                ranks.push_back(h_unique_neighbors.data[ineigh]);
+                }
+            }
+
+        MPI_Dist_graph_create_adjacent(m_mpi_comm,
+                                       (int)ranks.size(),
+                                       ranks.data(),
+                                       MPI_UNWEIGHTED,
+                                       (int)ranks.size(),
+                                       ranks.data(),
+                                       MPI_UNWEIGHTED,
+                                       MPI_INFO_NULL,
+                                       0,
+                                       &m_stage_comms[stage]);
+        }
+    }
+
+void CommunicatorGPU::freeNeighborGraphs()
+    {
+    for (auto& comm : m_stage_comms)
+        {
+        if (comm != MPI_COMM_NULL)
+            MPI_Comm_free(&comm);
+        }
+
+    m_stage_comms.clear();
+    m_stage_neighbors.clear();
+    }
+
+/*! \param stage Communication stage
+    \param sendbuf Send buffer of the field
+    \param send_begin Offset of the first element sent to every unique neighbor
+    \param recvbuf Position of the first ghost received in this stage
+    \param element_size Size of one element of the field in bytes
+    \param reqs Request list to append the request of the collective to
+    \param send_bytes Number of bytes sent (incremented)
+    \param recv_bytes Number of bytes received (incremented)
+
+    The element counts come from m_n_send_ghosts and m_n_recv_ghosts, the receive offsets from
+    m_ghost_offs. The collective is non-blocking, its counts and displacements are kept in
+    m_collective_args until the next exchange.
+*/
+void CommunicatorGPU::neighborAlltoallv(unsigned int stage,
+                                        const void* sendbuf,
+                                        const unsigned int* send_begin,
+                                        void* recvbuf,
+                                        size_t element_size,
+                                        std::vector<MPI_Request>& reqs,
+                                        unsigned int& send_bytes,
+                                        unsigned int& recv_bytes)
+    {
+    const std::vector<unsigned int>& neighbors = m_stage_neighbors[stage];
+    const unsigned int n = (unsigned int)neighbors.size();
+
+    m_collective_args.emplace_back(4 * n);
+    int* send_counts = m_collective_args.back().data();
+    int* send_displs = send_counts + n;
+    int* recv_counts = send_displs + n;
+    int* recv_displs = recv_counts + n;
+
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        unsigned int ineigh = neighbors[i];
+        send_counts[i] = (int)(m_n_send_ghosts[stage][ineigh] * element_size);
+        send_displs[i] = (int)(send_begin[ineigh] * element_size);
+        recv_counts[i] = (int)(m_n_recv_ghosts[stage][ineigh] * element_size);
+        recv_displs[i] = (int)(m_ghost_offs[stage][ineigh] * element_size);
+
+        send_bytes += send_counts[i];
+        recv_bytes += recv_counts[i];
+        }
+
+    MPI_Request req;
+    MPI_Ineighbor_alltoallv(sendbuf,
+                            send_counts,
+                            send_displs,
+                            MPI_BYTE,
+                            recvbuf,
+                            recv_counts,
+                            recv_displs,
+                            MPI_BYTE,
+                            m_stage_comms[stage],
+                            &req);
+    reqs.push_back(req);
     }
 
 //! Select a particle for migration
@@ -549,8 +732,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
                 CHECK_CUDA_ERROR();
             }
 
-#if defined(ENABLE_MPI_CUDA) && 0
-#else
         // fill host send buffers on host
         unsigned int my_rank = m_exec_conf->getRank();
 
@@ -625,7 +806,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
                 h_end.data[i] = (unsigned int)(std::distance(send_map.begin(), upper));
                 }
             }
-#endif
 
         /*
          * communicate rank information (phase 1)
@@ -718,24 +898,12 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             if (m_gpu_comm.m_prof)
                 m_gpu_comm.m_prof->push(m_exec_conf, "MPI send/recv");
 
-#ifdef ENABLE_MPI_CUDA
-            ArrayHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf,
-                                                             access_location::device,
-                                                             access_mode::read);
-            ArrayHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf,
-                                                             access_location::device,
-                                                             access_mode::overwrite);
-
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-#else
             ArrayHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf,
                                                              access_location::host,
                                                              access_mode::read);
             ArrayHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf,
                                                              access_location::host,
                                                              access_mode::overwrite);
-#endif
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -941,8 +1109,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
         m_gdata->removeGroups(m_gdata->getN() - new_ngroups);
         assert(m_gdata->getN() == new_ngroups);
 
-#if defined(ENABLE_MPI_CUDA) && 0
-#else
         // fill host send buffers on host
         typedef std::multimap<unsigned int, group_element_t> group_map_t;
         group_map_t group_send_map;
@@ -1011,7 +1177,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
                 h_end.data[i] = (unsigned int)std::distance(group_send_map.begin(), upper);
                 }
             }
-#endif
 
         /*
          * communicate groups (phase 2)
@@ -1101,15 +1266,12 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             if (m_gpu_comm.m_prof)
                 m_gpu_comm.m_prof->push(m_exec_conf, "MPI send/recv");
 
-#if defined(ENABLE_MPI_CUDA) && 0
-#else
             ArrayHandle<group_element_t> groups_sendbuf_handle(m_groups_sendbuf,
                                                                access_location::host,
                                                                access_mode::read);
             ArrayHandle<group_element_t> groups_recvbuf_handle(m_groups_recvbuf,
                                                                access_location::host,
                                                                access_mode::overwrite);
-#endif
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -1159,8 +1321,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             }
 
         unsigned int n_recv_unique = 0;
-#if defined(ENABLE_MPI_CUDA) && 0
-#else
             {
             ArrayHandle<group_element_t> h_groups_recvbuf(m_groups_recvbuf,
                                                           access_location::host,
@@ -1188,7 +1348,6 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
                 h_groups_in.data[n_recv_unique++] = it->second;
             assert(n_recv_unique == recv_map.size());
             }
-#endif
 
         unsigned int old_ngroups = m_gdata->getN();
 
@@ -1974,21 +2133,23 @@ void CommunicatorGPU::migrateParticles()
             if (m_prof)
                 m_prof->push(m_exec_conf, "MPI send/recv");
 
-#if defined(ENABLE_MPI_CUDA)
-            ArrayHandle<pdata_element> gpu_sendbuf_handle(m_gpu_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf,
-                                                          access_location::device,
-                                                          access_mode::overwrite);
-#else
+            // with GPU-direct MPI, pass device pointers to the MPI library
+            const access_location::Enum mpi_location
+                = m_gpu_direct ? access_location::device : access_location::host;
             ArrayHandle<pdata_element> gpu_sendbuf_handle(m_gpu_sendbuf,
-                                                          access_location::host,
+                                                          mpi_location,
                                                           access_mode::read);
             ArrayHandle<pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf,
-                                                          access_location::host,
+                                                          mpi_location,
                                                           access_mode::overwrite);
-#endif
+
+            // not all MPI libraries support derived datatypes in device memory
+            MPI_Datatype mpi_type = m_gpu_direct ? MPI_BYTE : m_mpi_pdata_element;
+            unsigned int mpi_type_size = m_gpu_direct ? (unsigned int)sizeof(pdata_element) : 1;
+
+            // MPI library may use non-zero stream
+            if (m_gpu_direct)
+                hipDeviceSynchronize();
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -2006,13 +2167,8 @@ void CommunicatorGPU::migrateParticles()
                 if (n_send_ptls[ineigh])
                     {
                     MPI_Isend(gpu_sendbuf_handle.data + h_begin.data[ineigh],
-#ifndef ENABLE_MPI_CUDA
-                              n_send_ptls[ineigh],
-                              m_mpi_pdata_element,
-#else
-                              n_send_ptls[ineigh] * sizeof(pdata_element),
-                              MPI_BYTE,
-#endif
+                              n_send_ptls[ineigh] * mpi_type_size,
+                              mpi_type,
                               neighbor,
                               1,
                               m_mpi_comm,
@@ -2024,13 +2180,8 @@ void CommunicatorGPU::migrateParticles()
                 if (n_recv_ptls[ineigh])
                     {
                     MPI_Irecv(gpu_recvbuf_handle.data + offs[ineigh],
-#ifndef ENABLE_MPI_CUDA
-                              n_recv_ptls[ineigh],
-                              m_mpi_pdata_element,
-#else
-                              n_recv_ptls[ineigh] * sizeof(pdata_element),
-                              MPI_BYTE,
-#endif
+                              n_recv_ptls[ineigh] * mpi_type_size,
+                              mpi_type,
                               neighbor,
                               1,
                               m_mpi_comm,
@@ -2112,6 +2263,7 @@ void CommunicatorGPU::exchangeGhosts()
 
     // update the subscribed ghost layer width
     updateGhostWidth();
+    updateGhostPositionPacking();
 
     // resize arrays
     m_n_send_ghosts.resize(m_num_stages);
@@ -2442,45 +2594,81 @@ void CommunicatorGPU::exchangeGhosts()
                     = h_ghost_end.data[ineigh + stage * m_n_unique_neigh]
                       - h_ghost_begin.data[ineigh + stage * m_n_unique_neigh];
 
-            MPI_Request req[2 * m_n_unique_neigh];
-            MPI_Status stat[2 * m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            if (m_neighbor_collectives)
                 {
-                if (m_stages[ineigh] != (int)stage)
+                const std::vector<unsigned int>& neighbors = m_stage_neighbors[stage];
+                std::vector<unsigned int> send_counts(neighbors.size());
+                std::vector<unsigned int> recv_counts(neighbors.size());
+
+                // skip neighbors not participating in this communication stage
+                for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
                     {
-                    // skip neighbor if not participating in this communication stage
-                    m_n_send_ghosts[stage][ineigh] = 0;
-                    m_n_recv_ghosts[stage][ineigh] = 0;
-                    continue;
+                    if (m_stages[ineigh] != (int)stage)
+                        {
+                        m_n_send_ghosts[stage][ineigh] = 0;
+                        m_n_recv_ghosts[stage][ineigh] = 0;
+                        }
                     }
 
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+                for (unsigned int i = 0; i < neighbors.size(); ++i)
+                    send_counts[i] = m_n_send_ghosts[stage][neighbors[i]];
 
-                MPI_Isend(&m_n_send_ghosts[stage][ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&m_n_recv_ghosts[stage][ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_mpi_comm,
-                          &req[nreq++]);
+                MPI_Neighbor_alltoall(send_counts.data(),
+                                      1,
+                                      MPI_UNSIGNED,
+                                      recv_counts.data(),
+                                      1,
+                                      MPI_UNSIGNED,
+                                      m_stage_comms[stage]);
 
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
+                for (unsigned int i = 0; i < neighbors.size(); ++i)
+                    m_n_recv_ghosts[stage][neighbors[i]] = recv_counts[i];
+
+                send_bytes += (unsigned int)(neighbors.size() * sizeof(unsigned int));
+                recv_bytes += (unsigned int)(neighbors.size() * sizeof(unsigned int));
                 }
+            else
+                {
+                MPI_Request req[2 * m_n_unique_neigh];
+                MPI_Status stat[2 * m_n_unique_neigh];
 
-            MPI_Waitall(nreq, req, stat);
+                unsigned int nreq = 0;
+
+                // loop over neighbors
+                for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+                    {
+                    if (m_stages[ineigh] != (int)stage)
+                        {
+                        // skip neighbor if not participating in this communication stage
+                        m_n_send_ghosts[stage][ineigh] = 0;
+                        m_n_recv_ghosts[stage][ineigh] = 0;
+                        continue;
+                        }
+
+                    // rank of neighbor processor
+                    unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+                    MPI_Isend(&m_n_send_ghosts[stage][ineigh],
+                              1,
+                              MPI_UNSIGNED,
+                              neighbor,
+                              0,
+                              m_mpi_comm,
+                              &req[nreq++]);
+                    MPI_Irecv(&m_n_recv_ghosts[stage][ineigh],
+                              1,
+                              MPI_UNSIGNED,
+                              neighbor,
+                              0,
+                              m_mpi_comm,
+                              &req[nreq++]);
+
+                    send_bytes += (unsigned int)sizeof(unsigned int);
+                    recv_bytes += (unsigned int)sizeof(unsigned int);
+                    }
+
+                MPI_Waitall(nreq, req, stat);
+                }
 
             // total up receive counts
             for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
@@ -2528,118 +2716,76 @@ void CommunicatorGPU::exchangeGhosts()
         m_pdata->addGhostParticles(m_n_recv_ghosts_tot[stage]);
 
             {
-            unsigned int offs = 0;
-#ifdef ENABLE_MPI_CUDA
-            // recv buffers, write directly into particle data arrays
-            offs = first_idx;
-            ArrayHandle<unsigned int> tag_ghost_recvbuf_handle(m_pdata->getTags(),
-                                                               access_location::device,
-                                                               access_mode::readwrite);
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pdata->getPositions(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_pdata->getVelocities(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar> charge_ghost_recvbuf_handle(m_pdata->getCharges(),
-                                                            access_location::device,
-                                                            access_mode::readwrite);
-            ArrayHandle<Scalar> diameter_ghost_recvbuf_handle(m_pdata->getDiameters(),
-                                                              access_location::device,
-                                                              access_mode::readwrite);
-            ArrayHandle<unsigned int> body_ghost_recvbuf_handle(m_pdata->getBodies(),
-                                                                access_location::device,
-                                                                access_mode::readwrite);
-            ArrayHandle<int3> image_ghost_recvbuf_handle(m_pdata->getImages(),
-                                                         access_location::device,
-                                                         access_mode::readwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_pdata->getOrientationArray(),
-                                                                  access_location::device,
-                                                                  access_mode::readwrite);
-
-            // send buffers
-            ArrayHandle<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf,
-                                                               access_location::device,
-                                                               access_mode::read);
-            ArrayHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf,
-                                                            access_location::device,
-                                                            access_mode::read);
-            ArrayHandle<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf,
-                                                                access_location::device,
-                                                                access_mode::read);
-            ArrayHandle<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf,
-                                                         access_location::device,
-                                                         access_mode::read);
-            ArrayHandle<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf,
-                                                              access_location::device,
-                                                              access_mode::read);
-            ArrayHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                  access_location::device,
-                                                                  access_mode::read);
+            // with GPU-direct MPI, receive directly into the particle data arrays
+            unsigned int offs = m_gpu_direct ? first_idx : 0;
+            const access_location::Enum mpi_location
+                = m_gpu_direct ? access_location::device : access_location::host;
+            const access_mode::Enum recv_mode
+                = m_gpu_direct ? access_mode::readwrite : access_mode::overwrite;
 
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-#else
             // recv buffers
-            ArrayHandleAsync<unsigned int> tag_ghost_recvbuf_handle(m_tag_ghost_recvbuf,
-                                                                    access_location::host,
-                                                                    access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(m_pos_ghost_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(m_vel_ghost_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-            ArrayHandleAsync<Scalar> charge_ghost_recvbuf_handle(m_charge_ghost_recvbuf,
-                                                                 access_location::host,
-                                                                 access_mode::overwrite);
-            ArrayHandleAsync<unsigned int> body_ghost_recvbuf_handle(m_body_ghost_recvbuf,
-                                                                     access_location::host,
-                                                                     access_mode::overwrite);
-            ArrayHandleAsync<int3> image_ghost_recvbuf_handle(m_image_ghost_recvbuf,
-                                                              access_location::host,
-                                                              access_mode::overwrite);
-            ArrayHandleAsync<Scalar> diameter_ghost_recvbuf_handle(m_diameter_ghost_recvbuf,
-                                                                   access_location::host,
-                                                                   access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(m_orientation_ghost_recvbuf,
-                                                                       access_location::host,
-                                                                       access_mode::overwrite);
+            ArrayHandleAsync<unsigned int> tag_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getTags() : m_tag_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getPositions() : m_pos_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getVelocities() : m_vel_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar> charge_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getCharges() : m_charge_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar> diameter_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getDiameters() : m_diameter_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<unsigned int> body_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getBodies() : m_body_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<int3> image_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getImages() : m_image_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getOrientationArray() : m_orientation_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+
             // send buffers
             ArrayHandleAsync<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf,
-                                                                    access_location::host,
+                                                                    mpi_location,
                                                                     access_mode::read);
             ArrayHandleAsync<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf,
-                                                                 access_location::host,
+                                                                 mpi_location,
                                                                  access_mode::read);
+            ArrayHandleAsync<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf,
+                                                                   mpi_location,
+                                                                   access_mode::read);
             ArrayHandleAsync<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf,
-                                                                     access_location::host,
+                                                                     mpi_location,
                                                                      access_mode::read);
             ArrayHandleAsync<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf,
-                                                              access_location::host,
+                                                              mpi_location,
                                                               access_mode::read);
-            ArrayHandleAsync<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf,
-                                                                   access_location::host,
-                                                                   access_mode::read);
             ArrayHandleAsync<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                       access_location::host,
+                                                                       mpi_location,
                                                                        access_mode::read);
 
-            // lump together into one synchronization call
+            // lump together into one synchronization call, the MPI library may also use a
+            // non-zero stream
             hipDeviceSynchronize();
-#endif
 
             ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
                                                          access_location::host,
@@ -2657,259 +2803,349 @@ void CommunicatorGPU::exchangeGhosts()
             std::vector<MPI_Request> reqs;
             MPI_Request req;
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            if (m_neighbor_collectives)
                 {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
+                // exchange every field with all neighbors of the stage in one collective
+                m_collective_args.clear();
+                const unsigned int* send_begin = h_ghost_begin.data + stage * m_n_unique_neigh;
                 if (flags[comm_flag::tag])
+                    neighborAlltoallv(stage,
+                                      tag_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      tag_ghost_recvbuf_handle.data + offs,
+                                      sizeof(unsigned int),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::position])
+                    neighborAlltoallv(stage,
+                                      pos_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      pos_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar4),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::velocity])
+                    neighborAlltoallv(stage,
+                                      vel_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      vel_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar4),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::charge])
+                    neighborAlltoallv(stage,
+                                      charge_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      charge_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::diameter])
+                    neighborAlltoallv(stage,
+                                      diameter_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      diameter_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::orientation])
+                    neighborAlltoallv(stage,
+                                      orientation_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      orientation_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar4),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::body])
+                    neighborAlltoallv(stage,
+                                      body_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      body_ghost_recvbuf_handle.data + offs,
+                                      sizeof(unsigned int),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::image])
+                    neighborAlltoallv(stage,
+                                      image_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      image_ghost_recvbuf_handle.data + offs,
+                                      sizeof(int3),
+                                      reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                }
+            else
+                {
+                // loop over neighbors
+                for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
                     {
-                    // when sending/receiving 0 ptls, the send/recv buffer may be uninitialized
-                    if (m_n_send_ghosts[stage][ineigh])
+                    // rank of neighbor processor
+                    unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+                    if (flags[comm_flag::tag])
                         {
-                        MPI_Isend(tag_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(unsigned int)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  1,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        // when sending/receiving 0 ptls, the send/recv buffer may be uninitialized
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(tag_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(unsigned int)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      1,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(unsigned int));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(tag_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      1,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(unsigned int));
                         }
-                    send_bytes
-                        += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(unsigned int));
-                    if (m_n_recv_ghosts[stage][ineigh])
+
+                    if (flags[comm_flag::position])
                         {
-                        MPI_Irecv(tag_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  1,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        MPI_Request req;
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(pos_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      2,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      2,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(unsigned int));
                         }
-                    recv_bytes
-                        += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int));
-                    }
 
-                if (flags[comm_flag::position])
-                    {
-                    MPI_Request req;
-                    if (m_n_send_ghosts[stage][ineigh])
+                    if (flags[comm_flag::velocity])
                         {
-                        MPI_Isend(pos_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  2,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  2,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    recv_bytes
-                        += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int));
-                    }
-
-                if (flags[comm_flag::velocity])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
-                        {
-                        MPI_Isend(vel_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  3,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(vel_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      3,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      3,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  3,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
 
-                if (flags[comm_flag::charge])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
-                        {
-                        MPI_Isend(charge_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  4,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar));
-                    if (m_n_recv_ghosts[stage][ineigh])
+                    if (flags[comm_flag::charge])
                         {
-                        MPI_Irecv(charge_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  4,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(charge_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      4,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(charge_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      4,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar));
-                    }
 
-                if (flags[comm_flag::diameter])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
-                        {
-                        MPI_Isend(diameter_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  5,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar));
-                    if (m_n_recv_ghosts[stage][ineigh])
+                    if (flags[comm_flag::diameter])
                         {
-                        MPI_Irecv(diameter_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  5,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(diameter_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      5,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(diameter_ghost_recvbuf_handle.data
+                                          + m_ghost_offs[stage][ineigh] + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      5,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar));
-                    }
 
-                if (flags[comm_flag::orientation])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
+                    if (flags[comm_flag::orientation])
                         {
-                        MPI_Isend(orientation_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  6,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(orientation_ghost_recvbuf_handle.data
-                                      + m_ghost_offs[stage][ineigh] + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  6,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(orientation_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      6,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(orientation_ghost_recvbuf_handle.data
+                                          + m_ghost_offs[stage][ineigh] + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      6,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
 
-                if (flags[comm_flag::body])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
+                    if (flags[comm_flag::body])
                         {
-                        MPI_Isend(body_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(unsigned int)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  7,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    send_bytes
-                        += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(unsigned int));
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(body_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  7,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(body_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(unsigned int)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      7,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(unsigned int));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(body_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      7,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(unsigned int));
                         }
-                    recv_bytes
-                        += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(unsigned int));
-                    }
 
-                if (flags[comm_flag::image])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
+                    if (flags[comm_flag::image])
                         {
-                        MPI_Isend(image_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(int3)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  8,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(image_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(int3)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      8,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(int3));
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(image_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(int3)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      8,
+                                      m_mpi_comm,
+                                      &req);
+                            reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(int3));
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(int3));
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(image_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(int3)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  8,
-                                  m_mpi_comm,
-                                  &req);
-                        reqs.push_back(req);
-                        }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(int3));
-                    }
-                } // end neighbor loop
+                    } // end neighbor loop
+                }
 
             std::vector<MPI_Status> stats(reqs.size());
             MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
@@ -2918,11 +3154,12 @@ void CommunicatorGPU::exchangeGhosts()
                 m_prof->pop(m_exec_conf, 0, send_bytes + recv_bytes);
             } // end ArrayHandle scope
 
-#ifdef ENABLE_MPI_CUDA
-        // MPI library may use non-zero stream
-        hipDeviceSynchronize();
-#else
-        // only unpack in non-CUDA MPI builds
+        if (m_gpu_direct)
+            {
+            // MPI library may use non-zero stream
+            hipDeviceSynchronize();
+            }
+        else
             {
             // access receive buffers
             ArrayHandle<unsigned int> d_tag_ghost_recvbuf(m_tag_ghost_recvbuf,
@@ -3005,7 +3242,6 @@ void CommunicatorGPU::exchangeGhosts()
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
             }
-#endif
 
         if (flags[comm_flag::tag])
             {
@@ -3047,6 +3283,9 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
 
     CommFlags flags = getFlags();
 
+    // send fixed-point ghost positions
+    const bool pack_positions = m_ghost_packing.bits && flags[comm_flag::position];
+
     // main communication loop
     for (unsigned int stage = 0; stage < m_num_stages; ++stage)
         {
@@ -3055,6 +3294,12 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             m_prof->push(m_exec_conf, "pack");
             }
 
+        if (pack_positions)
+            {
+            m_pos_packed_ghost_sendbuf.resize(m_n_send_ghosts_tot[stage]);
+            m_pos_packed_ghost_recvbuf.resize(m_n_recv_ghosts_tot[stage]);
+            }
+
             {
             // access particle data
             ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
@@ -3123,6 +3368,22 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
+
+            if (pack_positions)
+                {
+                ArrayHandle<uint3> d_pos_packed_ghost_sendbuf(m_pos_packed_ghost_sendbuf,
+                                                              access_location::device,
+                                                              access_mode::overwrite);
+
+                gpu_pack_ghost_positions(m_n_send_ghosts_tot[stage],
+                                         d_pos_ghost_sendbuf.data,
+                                         d_pos_packed_ghost_sendbuf.data,
+                                         global_box,
+                                         m_ghost_packing);
+
+                if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
             }
         if (m_prof)
             m_prof->pop(m_exec_conf);
@@ -3141,64 +3402,46 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             }
 
             {
-            unsigned int offs = 0;
-// access particle data
-#ifdef ENABLE_MPI_CUDA
-            offs = first_idx;
-            // recv buffers, directly write into particle data arrays
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pdata->getPositions(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_pdata->getVelocities(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_pdata->getOrientationArray(),
-                                                                  access_location::device,
-                                                                  access_mode::readwrite);
-
-            // send buffers
-            ArrayHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                  access_location::device,
-                                                                  access_mode::read);
-
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            ArrayHandle<unsigned int> h_ghost_begin(m_ghost_begin,
-                                                    access_location::host,
-                                                    access_mode::read);
+            // with GPU-direct MPI, receive directly into the particle data arrays
+            unsigned int offs = m_gpu_direct ? first_idx : 0;
+            const access_location::Enum mpi_location
+                = m_gpu_direct ? access_location::device : access_location::host;
+            const access_mode::Enum recv_mode
+                = m_gpu_direct ? access_mode::readwrite : access_mode::overwrite;
 
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-#else
             // recv buffers
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pos_ghost_recvbuf,
-                                                          access_location::host,
-                                                          access_mode::overwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_vel_ghost_recvbuf,
-                                                          access_location::host,
-                                                          access_mode::overwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_orientation_ghost_recvbuf,
-                                                                  access_location::host,
-                                                                  access_mode::overwrite);
+            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getPositions() : m_pos_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getVelocities() : m_vel_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(
+                m_gpu_direct ? m_pdata->getOrientationArray() : m_orientation_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
 
             // send buffers
             ArrayHandleAsync<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                       access_location::host,
+                                                                       mpi_location,
                                                                        access_mode::read);
 
+            // packed positions are received into their own buffer and unpacked on completion
+            ArrayHandleAsync<uint3> pos_packed_ghost_recvbuf_handle(m_pos_packed_ghost_recvbuf,
+                                                                    mpi_location,
+                                                                    access_mode::overwrite);
+            ArrayHandleAsync<uint3> pos_packed_ghost_sendbuf_handle(m_pos_packed_ghost_sendbuf,
+                                                                    mpi_location,
+                                                                    access_mode::read);
+
             ArrayHandleAsync<unsigned int> h_unique_neighbors(m_unique_neighbors,
                                                               access_location::host,
                                                               access_mode::read);
@@ -3206,10 +3449,17 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
                                                          access_location::host,
                                                          access_mode::read);
 
-            // lump together into one synchronization call
-            hipEventRecord(m_event);
-            hipEventSynchronize(m_event);
-#endif
+            if (m_gpu_direct)
+                {
+                // MPI library may use non-zero stream
+                hipDeviceSynchronize();
+                }
+            else
+                {
+                // lump together into one synchronization call
+                hipEventRecord(m_event);
+                hipEventSynchronize(m_event);
+                }
 
             // access send buffers
             if (m_prof)
@@ -3221,105 +3471,188 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             unsigned int send_bytes = 0;
             unsigned int recv_bytes = 0;
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            if (m_neighbor_collectives)
                 {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                if (flags[comm_flag::position])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
-                        {
-                        MPI_Isend(pos_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  2,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
-
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  2,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
-                        }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
-
+                // exchange every field with all neighbors of the stage in one collective
+                m_collective_args.clear();
+                const unsigned int* send_begin = h_ghost_begin.data + stage * m_n_unique_neigh;
+                if (pack_positions)
+                    neighborAlltoallv(stage,
+                                      pos_packed_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      pos_packed_ghost_recvbuf_handle.data,
+                                      sizeof(uint3),
+                                      m_reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                else if (flags[comm_flag::position])
+                    neighborAlltoallv(stage,
+                                      pos_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      pos_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar4),
+                                      m_reqs,
+                                      send_bytes,
+                                      recv_bytes);
                 if (flags[comm_flag::velocity])
+                    neighborAlltoallv(stage,
+                                      vel_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      vel_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar4),
+                                      m_reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                if (flags[comm_flag::orientation])
+                    neighborAlltoallv(stage,
+                                      orientation_ghost_sendbuf_handle.data,
+                                      send_begin,
+                                      orientation_ghost_recvbuf_handle.data + offs,
+                                      sizeof(Scalar4),
+                                      m_reqs,
+                                      send_bytes,
+                                      recv_bytes);
+                }
+            else
+                {
+                // loop over neighbors
+                for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
                     {
-                    if (m_n_send_ghosts[stage][ineigh])
+                    // rank of neighbor processor
+                    unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+                    if (pack_positions)
                         {
-                        MPI_Isend(vel_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  3,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(pos_packed_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(uint3)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      2,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        send_bytes
+                            += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(uint3));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(pos_packed_ghost_recvbuf_handle.data
+                                          + m_ghost_offs[stage][ineigh],
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(uint3)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      2,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        recv_bytes
+                            += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(uint3));
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
-
-                    if (m_n_recv_ghosts[stage][ineigh])
+                    else if (flags[comm_flag::position])
                         {
-                        MPI_Irecv(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  3,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(pos_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      2,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      2,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
 
-                if (flags[comm_flag::orientation])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
+                    if (flags[comm_flag::velocity])
                         {
-                        MPI_Isend(orientation_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  6,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(vel_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      3,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
+                                          + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      3,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
 
-                    if (m_n_recv_ghosts[stage][ineigh])
+                    if (flags[comm_flag::orientation])
                         {
-                        MPI_Irecv(orientation_ghost_recvbuf_handle.data
-                                      + m_ghost_offs[stage][ineigh] + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  6,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Isend(orientation_ghost_sendbuf_handle.data
+                                          + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                                      int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      6,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Irecv(orientation_ghost_recvbuf_handle.data
+                                          + m_ghost_offs[stage][ineigh] + offs,
+                                      int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                      MPI_BYTE,
+                                      neighbor,
+                                      6,
+                                      m_mpi_comm,
+                                      &req);
+                            m_reqs.push_back(req);
+                            }
+                        recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh]
+                                                     * sizeof(Scalar4));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
-                } // end neighbor loop
+                    } // end neighbor loop
+                }
 
             if (m_num_stages == 1)
                 {
@@ -3339,10 +3672,9 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
                 }
             } // end ArrayHandle scope
 
-        if (!m_comm_pending)
+        // with GPU-direct MPI, the ghosts were received into the particle data already
+        if (!m_comm_pending && !m_gpu_direct)
             {
-#ifndef ENABLE_MPI_CUDA
-            // only unpack in non-CUDA MPI builds
             if (m_prof)
                 {
                 m_prof->push(m_exec_conf, "unpack");
@@ -3389,7 +3721,7 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
                                              NULL,
                                              d_orientation.data + first_idx,
                                              false,
-                                             flags[comm_flag::position],
+                                             flags[comm_flag::position] && !pack_positions,
                                              flags[comm_flag::velocity],
                                              false,
                                              false,
@@ -3402,8 +3734,10 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
                 }
             if (m_prof)
                 m_prof->pop(m_exec_conf);
-#endif
             }
+
+        if (!m_comm_pending && pack_positions)
+            unpackPackedGhostPositions(first_idx, m_n_recv_ghosts_tot[stage]);
         } // end main communication loop
 
     if (m_prof)
@@ -3433,81 +3767,111 @@ void CommunicatorGPU::finishUpdateGhosts(uint64_t timestep)
             m_prof->pop(m_exec_conf);
             }
 
-#ifdef ENABLE_MPI_CUDA
-        // MPI library may use non-zero stream
-        hipDeviceSynchronize();
-#else
-        // only unpack in non-CUDA-MPI builds
-        assert(m_num_stages == 1);
-        unsigned int stage = 0;
-        unsigned int first_idx = m_pdata->getN();
         CommFlags flags = m_last_flags;
-        if (m_prof)
+        const bool pack_positions = m_ghost_packing.bits && flags[comm_flag::position];
+
+        if (m_gpu_direct)
             {
-            m_prof->push(m_exec_conf, "unpack");
+            // MPI library may use non-zero stream
+            hipDeviceSynchronize();
             }
-
+        else
             {
-            // access receive buffers
-            ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf,
-                                                     access_location::device,
-                                                     access_mode::read);
-            ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf,
-                                                     access_location::device,
-                                                     access_mode::read);
-            ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf,
-                                                             access_location::device,
-                                                             access_mode::read);
-            // access particle data
-            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                               access_location::device,
-                                               access_mode::readwrite);
+            // unpack the host-staged receive buffers
+            assert(m_num_stages == 1);
+            unsigned int stage = 0;
+            unsigned int first_idx = m_pdata->getN();
+            if (m_prof)
+                {
+                m_prof->push(m_exec_conf, "unpack");
+                }
 
-            // copy recv buf into particle data
-            gpu_exchange_ghosts_copy_buf(m_n_recv_ghosts_tot[stage],
-                                         NULL,
-                                         d_pos_ghost_recvbuf.data,
-                                         d_vel_ghost_recvbuf.data,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         d_orientation_ghost_recvbuf.data,
-                                         NULL,
-                                         d_pos.data + first_idx,
-                                         d_vel.data + first_idx,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         d_orientation.data + first_idx,
-                                         false,
-                                         flags[comm_flag::position],
-                                         flags[comm_flag::velocity],
-                                         false,
-                                         false,
-                                         false,
-                                         false,
-                                         flags[comm_flag::orientation]);
+                {
+                // access receive buffers
+                ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf,
+                                                         access_location::device,
+                                                         access_mode::read);
+                ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf,
+                                                         access_location::device,
+                                                         access_mode::read);
+                ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf,
+                                                                 access_location::device,
+                                                                 access_mode::read);
+                // access particle data
+                ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+                ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                                   access_location::device,
+                                                   access_mode::readwrite);
 
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
+                // copy recv buf into particle data
+                gpu_exchange_ghosts_copy_buf(m_n_recv_ghosts_tot[stage],
+                                             NULL,
+                                             d_pos_ghost_recvbuf.data,
+                                             d_vel_ghost_recvbuf.data,
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             d_orientation_ghost_recvbuf.data,
+                                             NULL,
+                                             d_pos.data + first_idx,
+                                             d_vel.data + first_idx,
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             d_orientation.data + first_idx,
+                                             false,
+                                             flags[comm_flag::position] && !pack_positions,
+                                             flags[comm_flag::velocity],
+                                             false,
+                                             false,
+                                             false,
+                                             false,
+                                             flags[comm_flag::orientation]);
+
+                if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
+            if (m_prof)
+                m_prof->pop(m_exec_conf);
             }
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
-#endif
+
+        if (pack_positions)
+            unpackPackedGhostPositions(m_pdata->getN(), m_n_recv_ghosts_tot[0]);
 
         if (m_prof)
             m_prof->pop(m_exec_conf);
         }
     }
 
+/*! \param first_idx Index of the first ghost received in the stage
+    \param n_ghosts Number of ghosts received in the stage
+*/
+void CommunicatorGPU::unpackPackedGhostPositions(unsigned int first_idx, unsigned int n_ghosts)
+    {
+    ArrayHandle<uint3> d_pos_packed_ghost_recvbuf(m_pos_packed_ghost_recvbuf,
+                                                  access_location::device,
+                                                  access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                               access_location::device,
+                               access_mode::readwrite);
+
+    gpu_unpack_ghost_positions(n_ghosts,
+                               d_pos_packed_ghost_recvbuf.data,
+                               d_pos.data + first_idx,
+                               m_pdata->getGlobalBox(),
+                               m_ghost_packing);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 //! Perform ghosts update
 void CommunicatorGPU::updateNetForce(uint64_t timestep)
     {
@@ -3907,7 +4271,13 @@ void export_CommunicatorGPU(py::module& m)
     py::class_<CommunicatorGPU, Communicator, std::shared_ptr<CommunicatorGPU>>(m,
                                                                                 "CommunicatorGPU")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition>>())
-        .def("setMaxStages", &CommunicatorGPU::setMaxStages);
+        .def("setMaxStages", &CommunicatorGPU::setMaxStages)
+        .def_property("gpu_direct",
+                      &CommunicatorGPU::getGPUDirect,
+                      &CommunicatorGPU::setGPUDirect)
+        .def_property("neighbor_collectives",
+                      &CommunicatorGPU::getNeighborCollectives,
+                      &CommunicatorGPU::setNeighborCollectives);
     }
 
 #endif // ENABLE_HIP
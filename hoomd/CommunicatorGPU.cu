@@ -869,6 +869,10 @@ __global__ void gpu_pack_wrap_kernel(unsigned int n_out,
             }
         }
 
+    // ghosts wrapped along y by a Lees-Edwards offset are wrapped back into the box along x
+    if (periodic.y && box.getLeesEdwardsOffset() != Scalar(0.0))
+        periodic.x = 1;
+
     box.setPeriodic(periodic);
     int3 img = make_int3(0, 0, 0);
     if (d_img)
@@ -1481,6 +1485,70 @@ void gpu_exchange_ghost_groups_copy_buf(unsigned int nrecv,
                        d_scan);
     }
 
+__global__ void gpu_pack_ghost_positions_kernel(unsigned int n,
+                                                const Scalar4* d_pos,
+                                                uint3* d_packed,
+                                                const BoxDim global_box,
+                                                const GhostPositionPacking packing)
+    {
+    unsigned int buf_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (buf_idx >= n)
+        return;
+    d_packed[buf_idx] = packGhostPosition(packing, global_box, d_pos[buf_idx]);
+    }
+
+__global__ void gpu_unpack_ghost_positions_kernel(unsigned int n,
+                                                  const uint3* d_packed,
+                                                  Scalar4* d_pos,
+                                                  const BoxDim global_box,
+                                                  const GhostPositionPacking packing)
+    {
+    unsigned int buf_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (buf_idx >= n)
+        return;
+    d_pos[buf_idx] = unpackGhostPosition(packing, global_box, d_packed[buf_idx]);
+    }
+
+void gpu_pack_ghost_positions(unsigned int n,
+                              const Scalar4* d_pos,
+                              uint3* d_packed,
+                              const BoxDim& global_box,
+                              const GhostPositionPacking& packing)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n / block_size + 1;
+    hipLaunchKernelGGL(gpu_pack_ghost_positions_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n,
+                       d_pos,
+                       d_packed,
+                       global_box,
+                       packing);
+    }
+
+void gpu_unpack_ghost_positions(unsigned int n,
+                                const uint3* d_packed,
+                                Scalar4* d_pos,
+                                const BoxDim& global_box,
+                                const GhostPositionPacking& packing)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n / block_size + 1;
+    hipLaunchKernelGGL(gpu_unpack_ghost_positions_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n,
+                       d_packed,
+                       d_pos,
+                       global_box,
+                       packing);
+    }
+
 void gpu_compute_ghost_rtags(unsigned int first_idx,
                              unsigned int n_ghost,
                              const unsigned int* d_tag,
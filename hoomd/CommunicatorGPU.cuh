@@ -10,6 +10,7 @@
 #ifdef ENABLE_MPI
 
 #include "BondedGroupData.cuh"
+#include "GhostPositionPacking.h"
 #include "ParticleData.cuh"
 
 #include "Index1D.h"
@@ -173,6 +174,20 @@ void gpu_exchange_ghosts_copy_buf(unsigned int n_recv,
                                   bool send_image,
                                   bool send_orientation);
 
+//! Encode ghost positions in the fixed-point format of GhostPositionPacking
+void gpu_pack_ghost_positions(unsigned int n,
+                              const Scalar4* d_pos,
+                              uint3* d_packed,
+                              const BoxDim& global_box,
+                              const GhostPositionPacking& packing);
+
+//! Decode fixed-point ghost positions
+void gpu_unpack_ghost_positions(unsigned int n,
+                                const uint3* d_packed,
+                                Scalar4* d_pos,
+                                const BoxDim& global_box,
+                                const GhostPositionPacking& packing);
+
 //! Compute ghost rtags
 void gpu_compute_ghost_rtags(unsigned int first_idx,
                              unsigned int n_ghost,
@@ -21,6 +21,9 @@
 #include "GPUFlags.h"
 #include "GPUVector.h"
 
+#include <deque>
+#include <vector>
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #endif
@@ -79,6 +82,45 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
         forceMigrate();
         }
 
+    //! Set whether to pass device memory to MPI
+    /*! \param gpu_direct True to communicate directly from and into device memory, false to stage
+            the buffers through host memory
+
+        GPU-direct communication requires an MPI library that can access device memory (CUDA-aware
+        MPI).
+    */
+    void setGPUDirect(bool gpu_direct)
+        {
+        if (m_comm_pending)
+            throw std::runtime_error("Cannot change GPU-direct mode during a ghost update.");
+        m_gpu_direct = gpu_direct;
+        }
+
+    //! Get whether to pass device memory to MPI
+    bool getGPUDirect() const
+        {
+        return m_gpu_direct;
+        }
+
+    //! Determine whether the MPI library supports device memory
+    static bool isMPIDeviceAware();
+
+    //! Set whether to exchange ghosts with neighborhood collectives
+    /*! \param neighbor_collectives True to exchange ghost particles with MPI_Ineighbor_alltoallv on
+            a distributed graph topology of the neighbors in each communication stage, false to
+            send point-to-point messages to every neighbor
+
+        Collective call. With GPU-direct communication, the MPI library must also support device
+        memory in neighborhood collectives.
+    */
+    void setNeighborCollectives(bool neighbor_collectives);
+
+    //! Get whether to exchange ghosts with neighborhood collectives
+    bool getNeighborCollectives() const
+        {
+        return m_neighbor_collectives;
+        }
+
     protected:
     //! Helper class to perform the communication tasks related to bonded groups
     template<class group_data> class GroupCommunicatorGPU
@@ -159,6 +201,7 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     private:
     /* General communication */
     unsigned int m_max_stages;             //!< Maximum number of (dependent) communication stages
+    bool m_gpu_direct;                     //!< True if MPI directly accesses device memory
     unsigned int m_num_stages;             //!< Number of stages
     std::vector<unsigned int> m_comm_mask; //!< Communication mask per stage
     std::vector<int> m_stages;             //!< Communication stage per unique neighbor
@@ -197,6 +240,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     GlobalVector<Scalar4> m_pos_ghost_sendbuf; //<! Buffer for sending ghost positions
     GlobalVector<Scalar4> m_pos_ghost_recvbuf; //<! Buffer for receiving ghost positions
 
+    GlobalVector<uint3> m_pos_packed_ghost_sendbuf; //!< Buffer for sending packed ghost positions
+    GlobalVector<uint3> m_pos_packed_ghost_recvbuf; //!< Buffer for receiving packed positions
+
     GlobalVector<Scalar4> m_vel_ghost_sendbuf; //<! Buffer for sending ghost velocities
     GlobalVector<Scalar4> m_vel_ghost_recvbuf; //<! Buffer for receiving ghost velocities
 
@@ -250,11 +296,39 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
 
     hipEvent_t m_event; //!< CUDA event for synchronization
 
+    bool m_neighbor_collectives = false; //!< True to exchange ghosts with neighborhood collectives
+    std::vector<MPI_Comm> m_stage_comms; //!< Distributed graph of the neighbors in every stage
+
+    /// Indices into m_unique_neighbors of the neighbors in every stage, in graph order
+    std::vector<std::vector<unsigned int>> m_stage_neighbors;
+
+    /// Counts and displacements of the neighborhood collectives in flight
+    std::deque<std::vector<int>> m_collective_args;
+
     //! Helper function to allocate various buffers
     void allocateBuffers();
 
     //! Helper function to set up communication stages
     void initializeCommunicationStages();
+
+    //! Create the distributed graph communicators of the communication stages
+    void initializeNeighborGraphs();
+
+    //! Free the distributed graph communicators
+    void freeNeighborGraphs();
+
+    //! Decode the packed positions received in a stage into the particle data
+    void unpackPackedGhostPositions(unsigned int first_idx, unsigned int n_ghosts);
+
+    //! Exchange a ghost field with the neighbors of a stage using a neighborhood collective
+    void neighborAlltoallv(unsigned int stage,
+                           const void* sendbuf,
+                           const unsigned int* send_begin,
+                           void* recvbuf,
+                           size_t element_size,
+                           std::vector<MPI_Request>& reqs,
+                           unsigned int& send_bytes,
+                           unsigned int& recv_bytes);
     };
 
 //! Export CommunicatorGPU class to python
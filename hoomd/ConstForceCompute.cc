@@ -249,8 +249,9 @@ void ConstForceCompute::computeForces(uint64_t timestep)
         rearrangeForces();
 
     // execute python callback to update the forces, if present
-    if (m_callback && !m_callback.is(py::none()))
+    if (m_callback && !m_callback.is_none())
         {
+        py::gil_scoped_acquire acquire;
         m_callback(timestep);
         }
     }
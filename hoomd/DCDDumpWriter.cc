@@ -15,6 +15,7 @@
 #include "Communicator.h"
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 
@@ -36,6 +37,27 @@ static void write_int(fstream& file, unsigned int val)
     file.write((char*)&val, sizeof(unsigned int));
     }
 
+//! simple helper function to append an integer to a buffer
+/*! \param buffer buffer to append to
+    \param val integer to append
+*/
+static void append_int(std::vector<char>& buffer, unsigned int val)
+    {
+    const char* ptr = reinterpret_cast<const char*>(&val);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(unsigned int));
+    }
+
+//! simple helper function to append raw data to a buffer
+/*! \param buffer buffer to append to
+    \param data data to append
+    \param size number of bytes to append
+*/
+static void append_data(std::vector<char>& buffer, const void* data, size_t size)
+    {
+    const char* ptr = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), ptr, ptr + size);
+    }
+
 //! simple helper function to read in integer
 /*! \param file file to read from
     \returns integer read
@@ -68,7 +90,8 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                              bool overwrite)
     : Analyzer(sysdef), m_fname(fname), m_start_timestep(0), m_period(period), m_group(group),
       m_num_frames_written(0), m_last_written_step(0), m_appending(false), m_unwrap_full(false),
-      m_unwrap_rigid(false), m_angle(false), m_overwrite(overwrite), m_is_initialized(false)
+      m_unwrap_rigid(false), m_angle(false), m_overwrite(overwrite), m_is_initialized(false),
+      m_header_update_period(1), m_frames_since_header_update(0), m_last_timestep(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing DCDDumpWriter: " << fname << " " << period << " "
                                 << overwrite << endl;
@@ -77,7 +100,6 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
 //! Initializes the output file for writing
 void DCDDumpWriter::initFileIO(uint64_t timestep)
     {
-    m_staging_buffer = new float[m_pdata->getNGlobal()];
     m_is_initialized = true;
 
     m_nglobal = m_pdata->getNGlobal();
@@ -134,11 +156,24 @@ DCDDumpWriter::~DCDDumpWriter()
 
     if (m_is_initialized)
         {
+        flush();
         m_file.close();
-        delete[] m_staging_buffer;
         }
     }
 
+/*! Write the number of frames and the last time step to the file header. Only the root rank has
+    the file open, calling flush() on other ranks has no effect.
+*/
+void DCDDumpWriter::flush()
+    {
+    if (!m_is_initialized)
+        return;
+
+    if (m_frames_since_header_update > 0)
+        write_updated_header(m_file, m_last_timestep);
+    m_file.flush();
+    }
+
 /*! \param timestep Current time step of the simulation
     The very first call to analyze() will result in the creation (or overwriting) of the
     file fname and the writing of the current timestep snapshot. After that, each call to analyze
@@ -150,10 +185,8 @@ void DCDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump DCD");
 
-    // take particle data snapshot
-    SnapshotParticleData<Scalar> snapshot;
-
-    m_pdata->takeSnapshot(snapshot);
+    // gather the coordinates of the group members to the root
+    gatherPositions();
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -195,14 +228,27 @@ void DCDDumpWriter::analyze(uint64_t timestep)
             << " which is not specified in the period of the DCD file: " << m_start_timestep
             << " + i * " << m_period << endl;
 
-    // write the data for the current time step
+    // assemble the frame and write it to the end of the file with one call
+    m_frame_buffer.clear();
+    write_frame_header(m_frame_buffer);
+    write_frame_data(m_frame_buffer);
+
     m_file.seekp(0, std::ios_base::end);
-    write_frame_header(m_file);
-    write_frame_data(m_file, snapshot);
+    m_file.write(m_frame_buffer.data(), m_frame_buffer.size());
+
+    // check for errors
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "I/O error while writing DCD frame data" << endl;
+        throw runtime_error("Error writing DCD file");
+        }
 
     // update the header with the number of frames written
     m_num_frames_written++;
-    write_updated_header(m_file, timestep);
+    m_frames_since_header_update++;
+    m_last_timestep = timestep;
+    if (m_frames_since_header_update >= m_header_update_period)
+        write_updated_header(m_file, timestep);
 
     if (m_prof)
         m_prof->pop();
@@ -279,11 +325,11 @@ void DCDDumpWriter::write_file_header(std::fstream& file)
         }
     }
 
-/*! \param file File to write to
+/*! \param buffer Buffer to append to
     Writes the header that precedes each snapshot in the file. This header
     includes information on the box size of the simulation.
 */
-void DCDDumpWriter::write_frame_header(std::fstream& file)
+void DCDDumpWriter::write_frame_header(std::vector<char>& buffer)
     {
     double unitcell[6];
     BoxDim box = m_pdata->getGlobalBox();
@@ -307,106 +353,218 @@ void DCDDumpWriter::write_frame_header(std::fstream& file)
     unitcell[3] = beta;
     unitcell[4] = alpha;
 
-    write_int(file, 48);
-    file.write((char*)unitcell, 48);
-    write_int(file, 48);
-
-    // check for errors
-    if (!file.good())
-        {
-        m_exec_conf->msg->error() << "DCD: I/O error while writing DCD frame header" << endl;
-        throw runtime_error("Error writing DCD file");
-        }
+    append_int(buffer, 48);
+    append_data(buffer, unitcell, 48);
+    append_int(buffer, 48);
     }
 
-/*! \param file File to write to
-    \param snapshot Snapshot to write
-    Writes the actual particle positions for all particles at the current time step
+/*! Fill m_staging_buffer on the root rank with the x, y, and z coordinates of the group members in
+    tag order. Collective call.
+
+    Each rank computes the coordinates of its local group members in single precision and only
+    those are gathered to the root.
 */
-void DCDDumpWriter::write_frame_data(std::fstream& file,
-                                     const SnapshotParticleData<Scalar>& snapshot)
+void DCDDumpWriter::gatherPositions()
     {
-    // we need to unsort the positions and write in tag order
-    assert(m_staging_buffer);
+    // the images of the central particles of rigid bodies may be on other ranks
+    if (m_unwrap_rigid && !m_unwrap_full)
+        {
+        gatherPositionsFromSnapshot();
+        return;
+        }
 
     BoxDim box = m_pdata->getGlobalBox();
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 origin_image = m_pdata->getOriginImage();
+    unsigned int n_local = m_group->getNumMembers();
+    m_local_tags.resize(n_local);
+    m_local_pos.resize(n_local * 3);
 
-    unsigned int nparticles = m_group->getNumMembersGlobal();
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+
+        for (unsigned int group_idx = 0; group_idx < n_local; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+
+            // positions relative to the origin, wrapped into the global box as in a snapshot
+            Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z) - origin;
+            int3 image = make_int3(h_image.data[j].x - origin_image.x,
+                                   h_image.data[j].y - origin_image.y,
+                                   h_image.data[j].z - origin_image.z);
+            box.wrap(pos, image);
+
+            if (m_unwrap_full)
+                pos = box.shift(pos, image);
+
+            m_local_tags[group_idx] = h_tag.data[j];
+            m_local_pos[group_idx * 3] = float(pos.x);
+            m_local_pos[group_idx * 3 + 1] = float(pos.y);
+            m_local_pos[group_idx * 3 + 2] = float(pos.z);
+
+            // m_angle set to True turns on a hack where the particle orientation angle is written
+            // out to the z component this only works in 2D simulations, obviously
+            if (m_angle)
+                {
+                m_local_pos[group_idx * 3 + 2]
+                    = float(atan2(h_orientation.data[j].w, h_orientation.data[j].x) * 2);
+                }
+            }
+        }
 
-    // Create a tmp copy of the particle data and unwrap particles
-    std::vector<vec3<Scalar>> tmp_pos(snapshot.pos);
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+    std::vector<unsigned int> tags;
+    std::vector<float> pos;
+    std::vector<unsigned int>* all_tags = &m_local_tags;
+    std::vector<float>* all_pos = &m_local_pos;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        bool root = m_exec_conf->isRoot();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+
+        std::vector<int> counts(root ? n_ranks : 0);
+        std::vector<int> displs(root ? n_ranks : 0);
+        int send_count = int(n_local);
+        MPI_Gather(&send_count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi_comm);
 
-        if (m_unwrap_full)
+        if (root)
             {
-            tmp_pos[i] = box.shift(tmp_pos[i], snapshot.image[i]);
+            int total = 0;
+            for (unsigned int i = 0; i < n_ranks; i++)
+                {
+                displs[i] = total;
+                total += counts[i];
+                }
+            tags.resize(total);
+            pos.resize(total * 3);
             }
-        else if (m_unwrap_rigid && snapshot.body[i] < MIN_FLOPPY)
-            {
-            unsigned int central_ptl_tag = snapshot.body[i];
-            int body_ix = snapshot.image[central_ptl_tag].x;
-            int body_iy = snapshot.image[central_ptl_tag].y;
-            int body_iz = snapshot.image[central_ptl_tag].z;
-            int3 particle_img = snapshot.image[i];
-            int3 img_diff = make_int3(particle_img.x - body_ix,
-                                      particle_img.y - body_iy,
-                                      particle_img.z - body_iz);
 
-            tmp_pos[i] = box.shift(tmp_pos[i], img_diff);
-            }
+        MPI_Gatherv(m_local_tags.data(),
+                    send_count,
+                    MPI_UNSIGNED,
+                    tags.data(),
+                    counts.data(),
+                    displs.data(),
+                    MPI_UNSIGNED,
+                    0,
+                    mpi_comm);
+
+        // gather the coordinates in units of 3 floats
+        MPI_Datatype float3_type;
+        MPI_Type_contiguous(3, MPI_FLOAT, &float3_type);
+        MPI_Type_commit(&float3_type);
+        MPI_Gatherv(m_local_pos.data(),
+                    send_count,
+                    float3_type,
+                    pos.data(),
+                    counts.data(),
+                    displs.data(),
+                    float3_type,
+                    0,
+                    mpi_comm);
+        MPI_Type_free(&float3_type);
+
+        if (!root)
+            return;
+
+        all_tags = &tags;
+        all_pos = &pos;
         }
+#endif
 
-    // prepare x coords for writing, looping in tag order
+    // the group members are in ascending tag order, sort the gathered members the same way
+    unsigned int nparticles = (unsigned int)all_tags->size();
+    std::vector<unsigned int> order(nparticles);
+    for (unsigned int i = 0; i < nparticles; i++)
+        order[i] = i;
+    std::sort(order.begin(),
+              order.end(),
+              [all_tags](unsigned int a, unsigned int b)
+              { return (*all_tags)[a] < (*all_tags)[b]; });
+
+    m_staging_buffer.resize(nparticles * 3);
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].x);
+        unsigned int i = order[group_idx];
+        m_staging_buffer[group_idx] = (*all_pos)[i * 3];
+        m_staging_buffer[nparticles + group_idx] = (*all_pos)[i * 3 + 1];
+        m_staging_buffer[2 * nparticles + group_idx] = (*all_pos)[i * 3 + 2];
         }
+    }
 
-    // write x coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+/*! Fill m_staging_buffer on the root rank from a single precision snapshot of all particles, which
+    has the images of the central particles needed to unwrap rigid bodies. Collective call.
+*/
+void DCDDumpWriter::gatherPositionsFromSnapshot()
+    {
+    SnapshotParticleData<float> snapshot;
+    std::map<unsigned int, unsigned int> map = m_pdata->takeSnapshot<float>(snapshot);
 
-    // prepare y coords for writing
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].y);
-        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed() && !m_exec_conf->isRoot())
+        return;
+#endif
 
-    // write y coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+    BoxDim box = m_pdata->getGlobalBox();
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    m_staging_buffer.resize(nparticles * 3);
 
-    // prepare z coords for writing
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].z);
+        unsigned int i = map[m_group->getMemberTag(group_idx)];
+        Scalar3 pos = vec_to_scalar3(vec3<Scalar>(snapshot.pos[i]));
+
+        if (snapshot.body[i] < MIN_FLOPPY)
+            {
+            unsigned int central_ptl = map[snapshot.body[i]];
+            int3 body_image = snapshot.image[central_ptl];
+            int3 particle_img = snapshot.image[i];
+            int3 img_diff = make_int3(particle_img.x - body_image.x,
+                                      particle_img.y - body_image.y,
+                                      particle_img.z - body_image.z);
+
+            pos = box.shift(pos, img_diff);
+            }
+
+        m_staging_buffer[group_idx] = float(pos.x);
+        m_staging_buffer[nparticles + group_idx] = float(pos.y);
+        m_staging_buffer[2 * nparticles + group_idx] = float(pos.z);
 
         // m_angle set to True turns on a hack where the particle orientation angle is written out
         // to the z component this only works in 2D simulations, obviously
         if (m_angle)
             {
-            m_staging_buffer[group_idx]
+            m_staging_buffer[2 * nparticles + group_idx]
                 = float(atan2(snapshot.orientation[i].v.z, snapshot.orientation[i].s) * 2);
             }
         }
+    }
 
-    // write z coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+/*! \param buffer Buffer to append to
+    Writes the actual particle positions for all particles at the current time step
+*/
+void DCDDumpWriter::write_frame_data(std::vector<char>& buffer)
+    {
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    assert(m_staging_buffer.size() == nparticles * 3);
 
-    // check for errors
-    if (!file.good())
+    // write the x, y, and z coords
+    for (unsigned int d = 0; d < 3; d++)
         {
-        m_exec_conf->msg->error() << "I/O error while writing DCD frame data" << endl;
-        throw runtime_error("Error writing DCD file");
+        append_int(buffer, (unsigned int)(nparticles * sizeof(float)));
+        append_data(buffer, m_staging_buffer.data() + d * nparticles, nparticles * sizeof(float));
+        append_int(buffer, (unsigned int)(nparticles * sizeof(float)));
         }
     }
 
@@ -423,6 +581,7 @@ void DCDDumpWriter::write_updated_header(std::fstream& file, uint64_t timestep)
 
     file.seekp(NSTEP_POS);
     write_int(file, static_cast<uint32_t>(timestep));
+    m_frames_since_header_update = 0;
 
     if (timestep > std::numeric_limits<uint32_t>::max())
         m_exec_conf->msg->warning() << "DCD: Truncating timestep to lower 32 bits" << endl;
@@ -441,5 +600,9 @@ void export_DCDDumpWriter(py::module& m)
                       &DCDDumpWriter::getUnwrapRigid,
                       &DCDDumpWriter::setUnwrapRigid)
         .def_property("angle_z", &DCDDumpWriter::getAngleZ, &DCDDumpWriter::setAngleZ)
+        .def_property("header_update_period",
+                      &DCDDumpWriter::getHeaderUpdatePeriod,
+                      &DCDDumpWriter::setHeaderUpdatePeriod)
+        .def("flush", &DCDDumpWriter::flush)
         .def_property_readonly("overwrite", &DCDDumpWriter::getOverwrite);
     }
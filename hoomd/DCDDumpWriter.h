@@ -11,7 +11,9 @@
 
 #include <fstream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 /*! \file DCDDumpWriter.h
     \brief Declares the DCDDumpWriter class
@@ -45,6 +47,17 @@
     Due to a limitation in the DCD format, the time step period between calls to
     analyze() \b must be specified up front. If analyze() detects that this period is
     not being maintained, it will print a warning but continue.
+
+    Each rank converts the positions of its local group members to single precision and the root
+    rank gathers only those, so the cost of a frame scales with the size of the group rather than
+    the size of the system. Unwrapping rigid bodies needs the image of each body's central particle,
+    which may be owned by another rank, so it falls back to a single precision snapshot of all
+    particles. The root rank assembles each frame in memory and writes it with one call.
+
+    The number of frames and the last time step in the file header are updated every
+    header_update_period frames and when the writer is flushed or destroyed. Readers of a file that
+    is being written may not see the most recent frames until then.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
@@ -101,6 +114,23 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
         return m_overwrite;
         }
 
+    //! Set the number of frames between updates of the file header
+    void setHeaderUpdatePeriod(unsigned int period)
+        {
+        if (period == 0)
+            throw std::invalid_argument("DCD: header_update_period must be positive");
+        m_header_update_period = period;
+        }
+
+    //! Get the number of frames between updates of the file header
+    unsigned int getHeaderUpdatePeriod()
+        {
+        return m_header_update_period;
+        }
+
+    //! Update the file header with the frames written so far
+    void flush();
+
     private:
     std::string m_fname;                    //!< The file name we are writing to
     uint64_t m_start_timestep;              //!< First time step written to the file
@@ -117,17 +147,28 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
     bool m_is_initialized;  //!< True if file IO has been initialized
     unsigned int m_nglobal; //!< Initial number of particles
 
-    float* m_staging_buffer; //!< Buffer for staging particle positions in tag order
-    std::fstream m_file;     //!< The file object
+    unsigned int m_header_update_period;       //!< Number of frames between header updates
+    unsigned int m_frames_since_header_update; //!< Frames written since the last header update
+    uint64_t m_last_timestep;                  //!< Time step of the last frame written
+
+    std::vector<float> m_staging_buffer;    //!< x, y, then z coordinates of the group in tag order
+    std::vector<char> m_frame_buffer;       //!< Frame assembled for writing
+    std::vector<unsigned int> m_local_tags; //!< Tags of the local group members
+    std::vector<float> m_local_pos;         //!< Coordinates of the local group members
+    std::fstream m_file;                    //!< The file object
 
     // helper functions
 
     //! Initializes the file header
     void write_file_header(std::fstream& file);
+    //! Gather the coordinates of the group members to the root rank
+    void gatherPositions();
+    //! Compute the coordinates of the group members from a snapshot
+    void gatherPositionsFromSnapshot();
     //! Writes the frame header
-    void write_frame_header(std::fstream& file);
+    void write_frame_header(std::vector<char>& buffer);
     //! Writes the particle positions for a frame
-    void write_frame_data(std::fstream& file, const SnapshotParticleData<Scalar>& snapshot);
+    void write_frame_data(std::vector<char>& buffer);
     //! Updates the file header
     void write_updated_header(std::fstream& file, uint64_t timestep);
     //! Initializes the output file for writing
@@ -20,16 +20,29 @@
 namespace py = pybind11;
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <thread>
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_observer.h>
+#endif
+
 using namespace std;
 
 #if defined(ENABLE_HIP)
 #include "CachedAllocator.h"
+#include "MemoryPool.h"
 #endif
 
 /*! \file ExecutionConfiguration.cc
@@ -38,9 +51,56 @@ using namespace std;
 
 // initialize static variables
 bool ExecutionConfiguration::s_gpu_scan_complete = false;
+
+#ifdef ENABLE_TBB
+//! Pins the threads that enter a task arena to the cores of this rank
+/*! Thread slot i of the arena (the slot of the thread that calls execute() is 0) is pinned to core
+    i modulo the number of cores.
+*/
+class ThreadPinningObserver : public tbb::task_scheduler_observer
+    {
+    public:
+    //! Constructor
+    /*! \param arena Task arena to observe
+        \param cores Cores to pin the threads to
+    */
+    ThreadPinningObserver(tbb::task_arena& arena, const std::vector<int>& cores)
+        : tbb::task_scheduler_observer(arena), m_cores(cores)
+        {
+        observe(true);
+        }
+
+    //! Destructor
+    virtual ~ThreadPinningObserver()
+        {
+        observe(false);
+        }
+
+    //! Pin the thread entering the arena
+    virtual void on_scheduler_entry(bool is_worker)
+        {
+#ifdef __linux__
+        int slot = tbb::this_task_arena::current_thread_index();
+        if (slot < 0 || m_cores.empty())
+            return;
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(m_cores[slot % m_cores.size()], &mask);
+        sched_setaffinity(0, sizeof(mask), &mask);
+#endif
+        }
+
+    private:
+    std::vector<int> m_cores; //!< Cores to pin the threads to
+    };
+#endif
 std::vector<std::string> ExecutionConfiguration::s_gpu_scan_messages;
 std::vector<int> ExecutionConfiguration::s_capable_gpu_ids;
 std::vector<std::string> ExecutionConfiguration::s_capable_gpu_descriptions;
+#ifdef ENABLE_HIP
+std::vector<hipDeviceProp_t> ExecutionConfiguration::s_capable_gpu_props;
+#endif
 
 /*! \param mode Execution mode to set (cpu or gpu)
     \param gpu_id List of GPU IDs on which to run, or empty for automatic selection
@@ -54,7 +114,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                                                std::vector<int> gpu_id,
                                                std::shared_ptr<MPIConfiguration> mpi_config,
                                                std::shared_ptr<Messenger> _msg)
-    : msg(_msg), m_hip_error_checking(false), m_mpi_config(mpi_config)
+    : msg(_msg), m_hip_error_checking(false), m_autotuner_adaptive(false),
+      m_mpi_config(mpi_config)
     {
     if (!m_mpi_config)
         {
@@ -181,11 +242,11 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         hipError_t err_sync = hipGetLastError();
         handleHIPError(err_sync, __FILE__, __LINE__);
 
-        // initialize cached allocator, max allocation 0.5*global mem
-        m_cached_alloc.reset(
-            new CachedAllocator(false, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
-        m_cached_alloc_managed.reset(
-            new CachedAllocator(true, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
+        // initialize the memory pools, cache at most 0.25*global mem in free blocks
+        m_memory_pool.reset(new MemoryPool(false, dev_prop.totalGlobalMem / 4));
+        m_memory_pool_managed.reset(new MemoryPool(true, dev_prop.totalGlobalMem / 4));
+
+        // the cached allocators and the streams are created on first use
         }
 #endif
 
@@ -210,8 +271,12 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         }
 #endif
 
+    findRankCores();
+
 #ifdef ENABLE_TBB
-    unsigned int num_threads = std::thread::hardware_concurrency();
+    // use one thread per core of this rank, so that ranks sharing a node do not oversubscribe it
+    unsigned int num_threads = m_rank_cores.empty() ? std::thread::hardware_concurrency()
+                                                    : (unsigned int)m_rank_cores.size();
 
     char* env;
     if ((env = getenv("OMP_NUM_THREADS")) != NULL)
@@ -235,6 +300,48 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
 #endif
     }
 
+/*! The cores of this rank are the cores in the process affinity mask set by the MPI launcher. When
+    the launcher does not bind the ranks (every core is in the mask) and several ranks share the
+    node, each takes a contiguous 1/N share of the cores so that hybrid MPI + TBB runs with a few
+    ranks per node use all cores without oversubscription.
+*/
+void ExecutionConfiguration::findRankCores()
+    {
+    m_rank_cores.clear();
+#ifdef __linux__
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+        return;
+
+    for (int core = 0; core < CPU_SETSIZE; ++core)
+        {
+        if (CPU_ISSET(core, &mask))
+            m_rank_cores.push_back(core);
+        }
+
+    const unsigned int n_node_ranks = m_mpi_config->getNRanksPerNode();
+    if (n_node_ranks > 1 && m_rank_cores.size() == std::thread::hardware_concurrency()
+        && m_rank_cores.size() >= n_node_ranks)
+        {
+        const size_t n_cores = m_rank_cores.size() / n_node_ranks;
+        const size_t first = m_mpi_config->getNodeRank() * n_cores;
+        m_rank_cores = std::vector<int>(m_rank_cores.begin() + first,
+                                        m_rank_cores.begin() + first + n_cores);
+        }
+#endif
+    }
+
+#ifdef ENABLE_TBB
+void ExecutionConfiguration::updateThreadPinning()
+    {
+    m_pinning_observer.reset();
+    if (m_pin_threads && m_task_arena)
+        {
+        m_pinning_observer = std::make_shared<ThreadPinningObserver>(*m_task_arena, m_rank_cores);
+        }
+    }
+#endif
+
 ExecutionConfiguration::~ExecutionConfiguration()
     {
     msg->notice(5) << "Destroying ExecutionConfiguration" << endl;
@@ -244,17 +351,43 @@ ExecutionConfiguration::~ExecutionConfiguration()
         {
         hipEventDestroy(m_events[idev]);
         }
+
+    for (auto stream : m_streams)
+        hipStreamDestroy(stream);
 #endif
 
 #if defined(ENABLE_HIP)
     // the destructors of these objects can issue hip calls, so free them before the device reset
     m_cached_alloc.reset();
     m_cached_alloc_managed.reset();
+    m_memory_pool.reset();
+    m_memory_pool_managed.reset();
 #endif
     }
 
 #if defined(ENABLE_HIP)
 
+/*! Multi-GPU operations use the default stream, so the streams are created on the single active
+    GPU, which is the current device.
+*/
+void ExecutionConfiguration::createStreams() const
+    {
+    m_streams.resize(s_n_streams);
+    for (unsigned int i = 0; i < s_n_streams; ++i)
+        hipStreamCreate(&m_streams[i]);
+    }
+
+/*! The cached allocators allocate at most 0.5*global mem from the memory pools.
+ */
+void ExecutionConfiguration::createCachedAllocators() const
+    {
+    m_cached_alloc.reset(
+        new CachedAllocator(*m_memory_pool, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
+    m_cached_alloc_managed.reset(
+        new CachedAllocator(*m_memory_pool_managed,
+                            (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
+    }
+
 std::pair<unsigned int, unsigned int>
 ExecutionConfiguration::getComputeCapability(unsigned int idev) const
     {
@@ -437,6 +570,7 @@ void ExecutionConfiguration::scanGPUs()
 
         s_capable_gpu_descriptions.push_back(describeGPU((int)s_capable_gpu_ids.size(), prop));
         s_capable_gpu_ids.push_back(dev);
+        s_capable_gpu_props.push_back(prop);
         }
     }
 
@@ -444,6 +578,111 @@ void ExecutionConfiguration::scanGPUs()
 
 /*! Print out GPU stats if running on the GPU, otherwise determine and print out the CPU stats
  */
+/*! \returns A dict that maps each owner to a dict with the keys host_bytes, device_bytes,
+    peak_host_bytes, and peak_device_bytes
+
+    Adds the temporary buffers of the cached allocators and the free blocks of the memory pools to
+    the usage in MemoryAccounting.
+*/
+pybind11::dict ExecutionConfiguration::getMemoryUsage() const
+    {
+    py::dict usage = m_memory_accounting.getUsage();
+
+#if defined(ENABLE_HIP)
+    auto add_cache = [&usage](const std::string& name, const CachedAllocator* alloc)
+    {
+        if (!alloc)
+            return;
+
+        py::dict entry;
+        entry["host_bytes"] = 0;
+        entry["device_bytes"] = alloc->getNumBytes();
+        entry["peak_host_bytes"] = 0;
+        entry["peak_device_bytes"] = alloc->getPeakNumBytes();
+        usage[py::str(name)] = entry;
+    };
+    add_cache("CachedAllocator", m_cached_alloc.get());
+    add_cache("CachedAllocator (managed)", m_cached_alloc_managed.get());
+
+    auto add_pool = [&usage](const std::string& name, const MemoryPool* pool)
+    {
+        if (!pool)
+            return;
+
+        py::dict entry;
+        entry["host_bytes"] = 0;
+        entry["device_bytes"] = pool->getCachedBytes();
+        entry["peak_host_bytes"] = 0;
+        entry["peak_device_bytes"] = pool->getPeakCachedBytes();
+        usage[py::str(name)] = entry;
+    };
+    add_pool("MemoryPool", m_memory_pool.get());
+    add_pool("MemoryPool (managed)", m_memory_pool_managed.get());
+#endif
+
+    return usage;
+    }
+
+//! Size of a transparent huge page
+static const size_t huge_page_bytes = 2 * 1024 * 1024;
+
+/*! Allocations of at least one huge page are aligned to the huge page size when huge pages are
+    enabled, so that the kernel can back them with whole huge pages.
+*/
+void* ExecutionConfiguration::allocateHostMemory(size_t num_bytes) const
+    {
+    // at minimum, alignment needs to be 32 bytes for AVX
+    bool huge = m_huge_pages && num_bytes >= huge_page_bytes;
+    size_t alignment = huge ? huge_page_bytes : 32;
+
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, num_bytes) != 0)
+        return nullptr;
+
+#ifdef MADV_HUGEPAGE
+    // the advice is a hint, the kernel falls back to small pages when it cannot follow it
+    if (huge)
+        madvise(ptr, num_bytes, MADV_HUGEPAGE);
+#endif
+
+    return ptr;
+    }
+
+/*! The first write to a page places it on the NUMA node of the writing thread. With NUMA first
+    touch enabled, the threads of the task arena clear contiguous ranges of pages, so that the pages
+    of large arrays are spread over the nodes the threads run on instead of the node of the thread
+    that allocates the array. Arrays smaller than a huge page are cleared by the calling thread.
+*/
+void ExecutionConfiguration::clearHostMemory(void* ptr, size_t num_bytes) const
+    {
+#ifdef ENABLE_TBB
+    if (m_numa_first_touch && m_task_arena && num_bytes >= huge_page_bytes)
+        {
+        // clear whole pages in each task so that no page is touched by two threads
+        const size_t page_bytes = m_huge_pages ? huge_page_bytes : 4096;
+        const size_t n_pages = (num_bytes + page_bytes - 1) / page_bytes;
+        char* data = reinterpret_cast<char*>(ptr);
+
+        m_task_arena->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<size_t>(0, n_pages),
+                    [&](const tbb::blocked_range<size_t>& r)
+                    {
+                        size_t begin = r.begin() * page_bytes;
+                        size_t end = std::min(r.end() * page_bytes, num_bytes);
+                        memset(data + begin, 0, end - begin);
+                    },
+                    tbb::static_partitioner());
+            });
+        return;
+        }
+#endif
+
+    memset(ptr, 0, num_bytes);
+    }
+
 void ExecutionConfiguration::setupStats()
     {
 #if defined(ENABLE_HIP)
@@ -454,13 +693,23 @@ void ExecutionConfiguration::setupStats()
         for (int idev = (unsigned int)(m_gpu_id.size() - 1); idev >= 0; idev--)
             {
             hipSetDevice(m_gpu_id[idev]);
-            hipGetDeviceProperties(&m_dev_prop[idev], m_gpu_id[idev]);
+
+            // reuse the properties from the device scan, querying them is slow
+            auto capable = std::find(s_capable_gpu_ids.begin(),
+                                     s_capable_gpu_ids.end(),
+                                     (int)m_gpu_id[idev]);
+            if (capable != s_capable_gpu_ids.end())
+                m_dev_prop[idev] = s_capable_gpu_props[capable - s_capable_gpu_ids.begin()];
+            else
+                hipGetDeviceProperties(&m_dev_prop[idev], m_gpu_id[idev]);
 
 #if defined(__HIP_PLATFORM_NVCC__)
             // hip doesn't currently have the concurrentManagedAccess property, so resort to the
-            // CUDA API
-            cudaDeviceProp cuda_prop;
-            cudaError_t error = cudaGetDeviceProperties(&cuda_prop, m_gpu_id[idev]);
+            // CUDA API. Query the single attribute, not all device properties.
+            int concurrent_managed_access = 0;
+            cudaError_t error = cudaDeviceGetAttribute(&concurrent_managed_access,
+                                                       cudaDevAttrConcurrentManagedAccess,
+                                                       m_gpu_id[idev]);
             if (error != cudaSuccess)
                 {
                 msg->errorAllRanks() << "" << endl;
@@ -468,7 +717,7 @@ void ExecutionConfiguration::setupStats()
                                     + string(cudaGetErrorString(error)));
                 }
 
-            if (cuda_prop.concurrentManagedAccess)
+            if (concurrent_managed_access)
                 {
                 // leave m_concurrent unmodified
                 }
@@ -614,6 +863,22 @@ int ExecutionConfiguration::guessLocalRank(bool& found)
             }
         }
 
+#if MPI_VERSION >= 3
+    // the ranks that can share memory run on the same node
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(m_mpi_config->getHOOMDWorldCommunicator(),
+                        MPI_COMM_TYPE_SHARED,
+                        0,
+                        MPI_INFO_NULL,
+                        &node_comm);
+    int node_rank;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_free(&node_comm);
+
+    msg->notice(3) << "Found local rank in: shared memory communicator" << std::endl;
+    found = true;
+    return node_rank;
+#else
     // try SLURM_LOCALID
     if (((env = getenv("SLURM_LOCALID"))) != NULL)
         {
@@ -650,6 +915,7 @@ int ExecutionConfiguration::guessLocalRank(bool& found)
     MPI_Comm_rank(MPI_COMM_WORLD, &global_rank);
     found = true;
     return global_rank;
+#endif
 #else
     return 0;
 #endif
@@ -668,6 +934,8 @@ void export_ExecutionConfiguration(py::module& m)
         .def("isCUDAEnabled", &ExecutionConfiguration::isCUDAEnabled)
         .def("setCUDAErrorChecking", &ExecutionConfiguration::setCUDAErrorChecking)
         .def("isCUDAErrorCheckingEnabled", &ExecutionConfiguration::isCUDAErrorCheckingEnabled)
+        .def("setAutotunerAdaptive", &ExecutionConfiguration::setAutotunerAdaptive)
+        .def("getAutotunerAdaptive", &ExecutionConfiguration::getAutotunerAdaptive)
         .def("getNumActiveGPUs", &ExecutionConfiguration::getNumActiveGPUs)
         .def_readonly("msg", &ExecutionConfiguration::msg)
 #if defined(ENABLE_HIP)
@@ -680,11 +948,22 @@ void export_ExecutionConfiguration(py::module& m)
         .def("getRank", &ExecutionConfiguration::getRank)
 #ifdef ENABLE_TBB
         .def("setNumThreads", &ExecutionConfiguration::setNumThreads)
+        .def("setThreadPinning", &ExecutionConfiguration::setThreadPinning)
 #endif
         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
+        .def("getThreadPinning", &ExecutionConfiguration::getThreadPinning)
+        .def("getRankCores", &ExecutionConfiguration::getRankCores)
+        .def("setHugePages", &ExecutionConfiguration::setHugePages)
+        .def("getHugePages", &ExecutionConfiguration::getHugePages)
+        .def("setNUMAFirstTouch", &ExecutionConfiguration::setNUMAFirstTouch)
+        .def("getNUMAFirstTouch", &ExecutionConfiguration::getNUMAFirstTouch)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
+        .def("getMemoryUsage", &ExecutionConfiguration::getMemoryUsage)
+        .def("setTracing", &ExecutionConfiguration::setTracing)
+        .def("tracingEnabled", &ExecutionConfiguration::tracingEnabled)
+        .def("writeTrace", &ExecutionConfiguration::writeTrace)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
         .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices);
@@ -30,10 +30,14 @@
 
 #ifdef ENABLE_TBB
 #include <tbb/task_arena.h>
+
+class ThreadPinningObserver;
 #endif
 
+#include "MemoryAccounting.h"
 #include "MemoryTraceback.h"
 #include "Messenger.h"
+#include "Tracer.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -49,6 +53,7 @@
 #if defined(ENABLE_HIP)
 //! Forward declaration
 class CachedAllocator;
+class MemoryPool;
 #endif
 
 //! Defines the execution configuration for the simulation
@@ -133,6 +138,20 @@ class PYBIND11_EXPORT ExecutionConfiguration
         m_hip_error_checking = hip_error_checking;
         }
 
+    //! Returns true if autotuners use the adaptive search
+    bool getAutotunerAdaptive() const
+        {
+        return m_autotuner_adaptive;
+        }
+
+    //! Choose between the adaptive and exhaustive autotuner searches
+    /*! Applies to autotuners that have not started tuning.
+     */
+    void setAutotunerAdaptive(bool adaptive)
+        {
+        m_autotuner_adaptive = adaptive;
+        }
+
     //! Get the number of active GPUs
     unsigned int getNumActiveGPUs() const
         {
@@ -261,10 +280,90 @@ class PYBIND11_EXPORT ExecutionConfiguration
     //! set number of TBB threads
     void setNumThreads(unsigned int num_threads)
         {
+        // the observer refers to the arena and must be destroyed first
+        m_pinning_observer.reset();
         m_task_arena = std::make_shared<tbb::task_arena>(num_threads);
         m_num_threads = num_threads;
+        updateThreadPinning();
+        }
+
+    //! Pin the TBB threads to the cores of this rank
+    /*! \param pin Set to true to pin each thread of the task arena to one core
+
+        The cores of a rank are the cores in the CPU affinity mask of the process when the
+        ExecutionConfiguration is constructed. When the MPI launcher does not bind the ranks, the
+        ranks on a node split its cores evenly. Threads that already ran in the arena keep their
+        affinity when pinning is disabled.
+    */
+    void setThreadPinning(bool pin)
+        {
+        m_pin_threads = pin;
+        updateThreadPinning();
+        }
+#endif
+
+    //! Return true when the TBB threads are pinned to cores
+    bool getThreadPinning() const
+        {
+#ifdef ENABLE_TBB
+        return m_pin_threads;
+#else
+        return false;
+#endif
+        }
+
+    //! Back large host arrays with transparent huge pages
+    /*! \param huge_pages Set to true to align host allocations of at least 2 MiB to 2 MiB and ask
+        the kernel to back them with transparent huge pages. Applies to arrays allocated afterwards.
+    */
+    void setHugePages(bool huge_pages)
+        {
+        m_huge_pages = huge_pages;
+        }
+
+    //! Return true when large host arrays are backed with huge pages
+    bool getHugePages() const
+        {
+        return m_huge_pages;
+        }
+
+    //! Spread the pages of host arrays over the threads that first touch them
+    /*! \param first_touch Set to true to clear newly allocated host arrays with all threads of
+        the task arena, so that the pages are placed on the NUMA nodes of the threads. Pin the
+        threads to keep them on those nodes.
+    */
+    void setNUMAFirstTouch(bool first_touch)
+        {
+        m_numa_first_touch = first_touch;
+        }
+
+    //! Return true when host arrays are cleared by all threads
+    bool getNUMAFirstTouch() const
+        {
+        return m_numa_first_touch;
         }
 
+    //! Allocate host memory for an array
+    /*! \param num_bytes Size of the allocation
+        \returns The allocation, aligned to at least 32 bytes, or nullptr on failure. Free it with
+            free().
+    */
+    void* allocateHostMemory(size_t num_bytes) const;
+
+    //! Set host memory to zero
+    /*! \param ptr Start of the memory
+        \param num_bytes Number of bytes to clear
+    */
+    void clearHostMemory(void* ptr, size_t num_bytes) const;
+
+    //! Get the cores assigned to this rank
+    const std::vector<int>& getRankCores() const
+        {
+        return m_rank_cores;
+        }
+
+#ifdef ENABLE_TBB
+
     std::shared_ptr<tbb::task_arena> getTaskArena() const
         {
         if (!m_task_arena)
@@ -284,15 +383,58 @@ class PYBIND11_EXPORT ExecutionConfiguration
         }
 
 #if defined(ENABLE_HIP)
+    //! Returns the pool that device arrays allocate from
+    MemoryPool& getMemoryPool() const
+        {
+        return *m_memory_pool;
+        }
+
+    //! Returns the pool that managed arrays allocate from
+    MemoryPool& getMemoryPoolManaged() const
+        {
+        return *m_memory_pool_managed;
+        }
+
+    //! Get the number of streams available to run independent operations concurrently
+    /*! Multi-GPU execution uses the default stream only.
+     */
+    unsigned int getNumStreams() const
+        {
+        return m_gpu_id.size() == 1 ? s_n_streams : 0;
+        }
+
+    //! Get a stream to run an independent operation on
+    /*! \param i Index of the operation
+        \returns One of the streams in round-robin order, or the default stream when there are
+            none
+
+        The streams block on the default stream, so every operation issued to the default stream,
+        such as the copies made by ArrayHandle, waits for the work queued on them and the work
+        queued on them waits for prior work on the default stream. Kernels on different streams
+        run concurrently only while no operation is issued to the default stream in between.
+    */
+    hipStream_t getStream(unsigned int i) const
+        {
+        if (getNumStreams() == 0)
+            return 0;
+        if (m_streams.empty())
+            createStreams();
+        return m_streams[i % m_streams.size()];
+        }
+
     //! Returns the cached allocator for temporary allocations
     CachedAllocator& getCachedAllocator() const
         {
+        if (!m_cached_alloc)
+            createCachedAllocators();
         return *m_cached_alloc;
         }
 
     //! Returns the cached allocator for temporary allocations
     CachedAllocator& getCachedAllocatorManaged() const
         {
+        if (!m_cached_alloc_managed)
+            createCachedAllocators();
         return *m_cached_alloc_managed;
         }
 #endif
@@ -317,6 +459,45 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get() != nullptr;
         }
 
+    //! Returns the registry that sums the memory allocated by each owner
+    const MemoryAccounting* getMemoryAccounting() const
+        {
+        return &m_memory_accounting;
+        }
+
+    //! Get the memory usage of each owner on this rank, including the cached allocators
+    pybind11::dict getMemoryUsage() const;
+
+    //! Start or stop recording a timeline
+    /*! Starting discards any previous timeline.
+     */
+    void setTracing(bool enable)
+        {
+        if (enable)
+            m_tracer = std::make_shared<Tracer>();
+        else
+            m_tracer = std::shared_ptr<Tracer>();
+        }
+
+    //! Returns the timeline tracer (null when tracing is disabled)
+    const std::shared_ptr<Tracer>& getTracer() const
+        {
+        return m_tracer;
+        }
+
+    bool tracingEnabled() const
+        {
+        return m_tracer.get() != nullptr;
+        }
+
+    //! Write the timeline of all ranks to a file (collective)
+    void writeTrace(const std::string& filename) const
+        {
+        if (!m_tracer)
+            throw std::runtime_error("Tracing is not enabled.");
+        m_tracer->write(filename, m_mpi_config);
+        }
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -349,8 +530,9 @@ class PYBIND11_EXPORT ExecutionConfiguration
 
     private:
     //! Guess local rank of this processor, used for GPU initialization
-    /*! \returns Local rank guessed from common environment variables
-                 or falls back to the global rank if no information is available
+    /*! \returns Local rank guessed from common environment variables or the rank in a
+                 shared memory communicator, or falls back to the global rank if no
+                 information is available
         \param found [output] True if a local rank was found, false otherwise
      */
     int guessLocalRank(bool& found);
@@ -366,8 +548,8 @@ class PYBIND11_EXPORT ExecutionConfiguration
 
         Determine which GPUs are available for use by HOOMD.
 
-        @post Populate s_gpu_scan_complete, s_gpu_scan_messages, s_gpu_list, and
-        s_capable_gpu_descriptions.
+        @post Populate s_gpu_scan_complete, s_gpu_scan_messages, s_gpu_list,
+        s_capable_gpu_descriptions, and s_capable_gpu_props.
     */
     static void scanGPUs();
 
@@ -386,6 +568,9 @@ class PYBIND11_EXPORT ExecutionConfiguration
     /// True when GPU error checking is enabled
     bool m_hip_error_checking;
 
+    /// True when autotuners use the adaptive search
+    bool m_autotuner_adaptive;
+
     /// The MPI configuration
     std::shared_ptr<MPIConfiguration> m_mpi_config;
 
@@ -401,6 +586,11 @@ class PYBIND11_EXPORT ExecutionConfiguration
     /// Description of the GPU devices
     static std::vector<std::string> s_capable_gpu_descriptions;
 
+#ifdef ENABLE_HIP
+    /// Properties of the capable devices, queried once per process by scanGPUs()
+    static std::vector<hipDeviceProp_t> s_capable_gpu_props;
+#endif
+
     /// Descriptions of the active devices
     std::vector<std::string> m_active_device_descriptions;
 
@@ -409,20 +599,52 @@ class PYBIND11_EXPORT ExecutionConfiguration
     mutable bool m_in_multigpu_block; //!< Tracks whether we are in a multi-GPU block
 
 #if defined(ENABLE_HIP)
-    std::unique_ptr<CachedAllocator> m_cached_alloc; //!< Cached allocator for temporary allocations
-    std::unique_ptr<CachedAllocator>
-        m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
+    std::unique_ptr<MemoryPool> m_memory_pool;         //!< Pool of device memory
+    std::unique_ptr<MemoryPool> m_memory_pool_managed; //!< Pool of managed memory
+
+    /// Number of streams for independent operations
+    static const unsigned int s_n_streams = 4;
+
+    /// Streams for independent operations, created on first use
+    mutable std::vector<hipStream_t> m_streams;
+
+    /// Cached allocator for temporary allocations, created on first use
+    mutable std::unique_ptr<CachedAllocator> m_cached_alloc;
+
+    /// Cached allocator for temporary allocations in managed memory, created on first use
+    mutable std::unique_ptr<CachedAllocator> m_cached_alloc_managed;
+
+    /// Create the streams for independent operations
+    void createStreams() const;
+
+    /// Create the cached allocators
+    void createCachedAllocators() const;
 #endif
 
+    std::vector<int> m_rank_cores; //!< Cores assigned to this rank
+
+    bool m_huge_pages = false;       //!< True to back large host arrays with huge pages
+    bool m_numa_first_touch = false; //!< True to clear host arrays with all threads
+
 #ifdef ENABLE_TBB
     std::shared_ptr<tbb::task_arena> m_task_arena; //!< The TBB task arena
     unsigned int m_num_threads;                    //!<  The number of TBB threads used
+    bool m_pin_threads = false;                    //!< True when the threads are pinned to cores
+    std::shared_ptr<ThreadPinningObserver> m_pinning_observer; //!< Pins threads entering the arena
+
+    //! Create or destroy the observer that pins the threads of the arena
+    void updateThreadPinning();
 #endif
 
+    //! Find the cores assigned to this rank
+    void findRankCores();
+
     //! Setup and print out stats on the chosen CPUs/GPUs
     void setupStats();
 
+    MemoryAccounting m_memory_accounting;                //!< Sums the allocations by owner
     std::unique_ptr<MemoryTraceback> m_memory_traceback; //!< Keeps track of allocations
+    std::shared_ptr<Tracer> m_tracer;                    //!< Records a timeline when tracing
     };
 
 #if defined(ENABLE_HIP)
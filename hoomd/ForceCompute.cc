@@ -29,6 +29,10 @@ namespace py = pybind11;
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
     : Compute(sysdef), m_particles_sorted(false)
+#ifdef ENABLE_HIP
+      ,
+      m_stream(0)
+#endif
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -133,42 +137,61 @@ void ForceCompute::updateGPUAdvice()
         {
         auto gpu_map = m_exec_conf->getGPUIds();
 
-        // split preferred location of particle data across GPUs
-        const GPUPartition& gpu_partition = m_pdata->getGPUPartition();
-
-        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
+        if (m_overlap_host)
+            {
+            // the force computes on the host, the net force kernels read the arrays remotely
+            cudaMemAdvise(m_force.get(),
+                          sizeof(Scalar4) * m_force.getNumElements(),
+                          cudaMemAdviseSetPreferredLocation,
+                          cudaCpuDeviceId);
+            cudaMemAdvise(m_virial.get(),
+                          sizeof(Scalar) * m_virial.getNumElements(),
+                          cudaMemAdviseSetPreferredLocation,
+                          cudaCpuDeviceId);
+            cudaMemAdvise(m_torque.get(),
+                          sizeof(Scalar4) * m_torque.getNumElements(),
+                          cudaMemAdviseSetPreferredLocation,
+                          cudaCpuDeviceId);
+            }
+        else
             {
-            // set preferred location
-            auto range = gpu_partition.getRange(idev);
-            unsigned int nelem = range.second - range.first;
+            // split preferred location of particle data across GPUs
+            const GPUPartition& gpu_partition = m_pdata->getGPUPartition();
 
-            if (!nelem)
-                continue;
+            for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
+                {
+                // set preferred location
+                auto range = gpu_partition.getRange(idev);
+                unsigned int nelem = range.second - range.first;
 
-            cudaMemAdvise(m_force.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemAdvise(m_virial.get() + i * m_virial.getPitch() + range.first,
-                              sizeof(Scalar) * nelem,
+                if (!nelem)
+                    continue;
+
+                cudaMemAdvise(m_force.get() + range.first,
+                              sizeof(Scalar4) * nelem,
+                              cudaMemAdviseSetPreferredLocation,
+                              gpu_map[idev]);
+                for (unsigned int i = 0; i < 6; ++i)
+                    cudaMemAdvise(m_virial.get() + i * m_virial.getPitch() + range.first,
+                                  sizeof(Scalar) * nelem,
+                                  cudaMemAdviseSetPreferredLocation,
+                                  gpu_map[idev]);
+                cudaMemAdvise(m_torque.get() + range.first,
+                              sizeof(Scalar4) * nelem,
                               cudaMemAdviseSetPreferredLocation,
                               gpu_map[idev]);
-            cudaMemAdvise(m_torque.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
 
-            cudaMemPrefetchAsync(m_force.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemPrefetchAsync(m_virial.get() + i * m_virial.getPitch() + range.first,
-                                     sizeof(Scalar) * nelem,
+                cudaMemPrefetchAsync(m_force.get() + range.first,
+                                     sizeof(Scalar4) * nelem,
                                      gpu_map[idev]);
-            cudaMemPrefetchAsync(m_torque.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
+                for (unsigned int i = 0; i < 6; ++i)
+                    cudaMemPrefetchAsync(m_virial.get() + i * m_virial.getPitch() + range.first,
+                                         sizeof(Scalar) * nelem,
+                                         gpu_map[idev]);
+                cudaMemPrefetchAsync(m_torque.get() + range.first,
+                                     sizeof(Scalar4) * nelem,
+                                     gpu_map[idev]);
+                }
             }
         CHECK_CUDA_ERROR();
 
@@ -513,21 +536,46 @@ pybind11::object ForceCompute::getVirialsPython()
 void ForceCompute::compute(uint64_t timestep)
     {
     Compute::compute(timestep);
-    // recompute forces if the particles were sorted, this is a new timestep, or the particle data
-    // flags do not match
-    if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags)
+    // recompute forces if the particles were sorted, this is a new timestep, the particle data
+    // flags do not match, or the last computation did not fill the force arrays
+    if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags
+        || m_forces_in_net)
         {
         computeForces(timestep);
         }
 
     m_particles_sorted = false;
+    m_forces_in_net = false;
     m_computed_flags = m_pdata->getFlags();
     }
 
+/*! \param timestep Current time step of the simulation
+    \returns True when the forces were added to the net force arrays, false when the force compute
+        does not support this and compute() must be called instead
+
+    The forces are always computed and added to the net force, torque, and virial arrays. The force
+    arrays of this ForceCompute are not valid afterwards, a later call to compute() computes them
+    again.
+*/
+bool ForceCompute::computeIntoNet(uint64_t timestep)
+    {
+    Compute::compute(timestep);
+    if (!computeForcesIntoNet(timestep))
+        return false;
+
+    // the next call to compute() at a new time step proceeds as usual
+    shouldCompute(timestep);
+    m_particles_sorted = false;
+    m_forces_in_net = true;
+    m_computed_flags = m_pdata->getFlags();
+    return true;
+    }
+
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
-    Calls computeForces repeatedly to benchmark the force compute.
+    Calls computeForces repeatedly to benchmark the force compute. In MPI simulations, all ranks
+    return the time of the slowest rank.
 */
 
 double ForceCompute::benchmark(unsigned int num_iters)
@@ -556,7 +604,21 @@ double ForceCompute::benchmark(unsigned int num_iters)
     uint64_t total_time_ns = t.getTime() - start_time;
 
     // convert the run time to milliseconds
-    return double(total_time_ns) / 1e6 / double(num_iters);
+    double result = double(total_time_ns) / 1e6 / double(num_iters);
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &result,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return result;
     }
 
 /*! \param tag Global particle tag
@@ -674,5 +736,6 @@ void export_ForceCompute(py::module& m)
         .def("getEnergies", &ForceCompute::getEnergiesPython)
         .def("getForces", &ForceCompute::getForcesPython)
         .def("getTorques", &ForceCompute::getTorquesPython)
-        .def("getVirials", &ForceCompute::getVirialsPython);
+        .def("getVirials", &ForceCompute::getVirialsPython)
+        .def_property("overlap_host", &ForceCompute::getOverlapHost, &ForceCompute::setOverlapHost);
     }
@@ -75,6 +75,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     //! Computes the forces
     virtual void compute(uint64_t timestep);
 
+    //! Computes the forces and adds them to the net force arrays of the particle data
+    bool computeIntoNet(uint64_t timestep);
+
     //! Benchmark the force compute
     virtual double benchmark(unsigned int num_iters);
 
@@ -167,8 +170,34 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         flags[comm_flag::net_force] = 1; // only used if constraints are present
         return flags;
         }
+
+    //! Returns true if computeForces() completes a pending ghost update itself
+    /*! Such force computes start on the particles without ghost neighbors while the ghost
+        positions are in flight (see Communicator::communicate()).
+    */
+    virtual bool overlapsGhostUpdate()
+        {
+        return false;
+        }
 #endif
 
+    //! Returns true if compute() may run concurrently with other force computes on the host
+    /*! After prepareConcurrentCompute(), such force computes read the particle data and their
+        inputs on the host without modifying them and write only to their own force arrays.
+    */
+    virtual bool supportsConcurrentCompute()
+        {
+        return false;
+        }
+
+    //! Bring the shared inputs of compute() up to date before concurrent force computes run
+    /*! Integrator calls this on the main thread for each force compute that supports concurrent
+        computes, in order, so that dependencies such as neighbor lists and cached copies of the
+        particle data are built once and only read while the forces run.
+        \param timestep Current time step
+    */
+    virtual void prepareConcurrentCompute(uint64_t timestep) { }
+
     //! Returns true if this ForceCompute requires anisotropic integration
     virtual bool isAnisotropic()
         {
@@ -176,9 +205,41 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         return false;
         }
 
+#ifdef ENABLE_HIP
+    //! Set the stream to launch the force kernels on
+    /*! Integrator assigns each active force its own stream so that independent force kernels
+        run concurrently. Subclasses that launch all kernels on the default stream ignore it.
+    */
+    void setStream(hipStream_t stream)
+        {
+        m_stream = stream;
+        }
+#endif
+
+    //! Set whether the force computes on the host while the kernels of the other forces run
+    /*! Only host implementations of a force may be marked. Integrator computes the marked forces
+        after it launches the kernels of all other forces. With managed memory, the force arrays
+        prefer host memory.
+    */
+    void setOverlapHost(bool overlap_host)
+        {
+        m_overlap_host = overlap_host;
+        updateGPUAdvice();
+        }
+
+    //! Get whether the force computes on the host while the kernels of the other forces run
+    bool getOverlapHost()
+        {
+        return m_overlap_host;
+        }
+
     protected:
     bool m_particles_sorted; //!< Flag set to true when particles are resorted in memory
 
+#ifdef ENABLE_HIP
+    hipStream_t m_stream; //!< Stream to launch the force kernels on
+#endif
+
     //! Helper function called when particles are sorted
     /*! setParticlesSorted() is passed as a slot to the particle sort signal.
         It is used to flag \c m_particles_sorted so that a second call to compute
@@ -217,12 +278,28 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
+    /// True when the last computation added the forces to the net force arrays instead of m_force
+    bool m_forces_in_net = false;
+
+    /// True when the force computes on the host while the kernels of the other forces run
+    bool m_overlap_host = false;
+
     //! Actually perform the computation of the forces
     /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
         the base class compute() when the forces need to be computed.
         \param timestep Current time step
     */
     virtual void computeForces(uint64_t timestep) { }
+
+    //! Add the forces to the net force arrays instead of computing them in m_force
+    /*! Sub-classes that support it add their forces, energies, and virials to the net force,
+        torque, and virial arrays of the particle data and return true. The default returns false.
+        \param timestep Current time step
+    */
+    virtual bool computeForcesIntoNet(uint64_t timestep)
+        {
+        return false;
+        }
     };
 
 //! Exports the ForceCompute class to python
@@ -19,11 +19,14 @@
 
 // for vector types
 #ifdef ENABLE_HIP
+#include "MemoryPool.h"
 #include <hip/hip_runtime.h>
 #endif
 
 #include "ExecutionConfiguration.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -78,6 +81,36 @@ namespace hoomd
     {
 namespace detail
     {
+//! Allocate host memory for an array
+/*! \param exec_conf Execution configuration, may be null
+    \param num_bytes Size of the allocation
+    \returns The allocation, or nullptr on failure
+*/
+inline void* host_allocate(const ExecutionConfiguration* exec_conf, size_t num_bytes)
+    {
+    if (exec_conf)
+        return exec_conf->allocateHostMemory(num_bytes);
+
+    // at minimum, alignment needs to be 32 bytes for AVX
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, 32, num_bytes) != 0)
+        return nullptr;
+    return ptr;
+    }
+
+//! Set host memory of an array to zero
+/*! \param exec_conf Execution configuration, may be null
+    \param ptr Start of the memory
+    \param num_bytes Number of bytes to clear
+*/
+inline void host_clear(const ExecutionConfiguration* exec_conf, void* ptr, size_t num_bytes)
+    {
+    if (exec_conf)
+        exec_conf->clearHostMemory(ptr, num_bytes);
+    else
+        memset(ptr, 0, num_bytes);
+    }
+
 template<class T> class device_deleter
     {
     public:
@@ -109,11 +142,11 @@ template<class T> class device_deleter
             assert(m_exec_conf);
             this->m_exec_conf->msg->notice(10)
                 << "Freeing " << m_N * sizeof(T) << " bytes of CUDA memory." << std::endl;
+            this->m_exec_conf->getMemoryAccounting()->unregisterAllocation(ptr);
 
 #ifdef ENABLE_HIP
-            hipFree(ptr);
+            this->m_exec_conf->getMemoryPool().deallocate(ptr);
 #endif
-            CHECK_CUDA_ERROR();
             }
         }
 
@@ -150,8 +183,11 @@ template<class T> class host_deleter
             return;
 
         if (m_exec_conf)
+            {
             m_exec_conf->msg->notice(10)
                 << "Freeing " << m_N * sizeof(T) << " bytes of host memory." << std::endl;
+            m_exec_conf->getMemoryAccounting()->unregisterAllocation(ptr);
+            }
 
         if (m_use_device)
             {
@@ -242,6 +278,16 @@ template<class T, class Derived> class GPUArrayBase
         static_cast<Derived&>(*this).resize(width, height);
         }
 
+    //! Get the number of times the array has been acquired with write access
+    /*! The count is incremented by every acquire with a mode other than access_mode::read. Classes
+        that keep derived copies of the array contents compare it against the value recorded when
+        the copy was made to detect modifications. The count is not exchanged by swap().
+    */
+    uint64_t getWriteCount() const
+        {
+        return m_write_count;
+        }
+
     protected:
     //! Acquires the data pointer for use
     inline ArrayHandleDispatch<T> acquire(const access_location::Enum location,
@@ -252,6 +298,9 @@ template<class T, class Derived> class GPUArrayBase
 #endif
     ) const
         {
+        if (mode != access_mode::read)
+            m_write_count++;
+
         return static_cast<Derived const&>(*this).acquire(location,
                                                           mode
 #ifdef ENABLE_HIP
@@ -278,6 +327,8 @@ template<class T, class Derived> class GPUArrayBase
     friend class ArrayHandleAsync<T>;
 
     private:
+    mutable uint64_t m_write_count = 0; //!< Number of acquires with write access
+
     // Make constructor private to prevent mistakes
     GPUArrayBase() {};
     friend Derived;
@@ -532,6 +583,22 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Resize a 2D GPUArray
     void resize(size_t width, size_t height);
 
+    //! Set an optional tag for memory accounting
+    /*! \param tag The name of this allocation
+     */
+    void setTag(const std::string& tag)
+        {
+        m_tag = tag;
+        if (!m_exec_conf)
+            return;
+
+        const MemoryAccounting* accounting = m_exec_conf->getMemoryAccounting();
+        accounting->updateTag(h_data.get(), m_tag);
+#ifdef ENABLE_HIP
+        accounting->updateTag(d_data.get(), m_tag);
+#endif
+        }
+
     //! Return a string representation of this array
     std::string getRepresentation() const
         {
@@ -585,13 +652,19 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Release the data pointer
     inline void release() const
         {
-        m_acquired = false;
+        // shared host readers release one at a time
+        int acquired = m_acquired.load();
+        while (acquired > 0 && !m_acquired.compare_exchange_weak(acquired, acquired - 1))
+            {
+            }
+        if (acquired <= 0)
+            m_acquired = 0;
         }
 
     //! Returns the acquire state
     inline bool isAcquired() const
         {
-        return m_acquired;
+        return m_acquired.load() != 0;
         }
 
     //! Need to be friend with dispatch
@@ -608,11 +681,16 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     size_t m_pitch;        //!< Pitch of the rows in elements
     size_t m_height;       //!< Number of allocated rows
 
-    mutable bool m_acquired;                     //!< Tracks whether the data has been acquired
+    //! Tracks whether the data has been acquired
+    /*! 0 when free, -1 when acquired exclusively, and the number of readers when acquired for
+        reading on the host by one or more threads.
+    */
+    mutable std::atomic<int> m_acquired;
     mutable data_location::Enum m_data_location; //!< Tracks the current location of the data
 #ifdef ENABLE_HIP
     bool m_mapped; //!< True if we are using mapped memory
 #endif
+    std::string m_tag; //!< Name of the array for memory accounting
 
     // ok, this looks weird, but I want m_exec_conf to be protected and not have to go reorder all
     // of the initializers
@@ -631,6 +709,9 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Helper function to allocate memory
     inline void allocate();
 
+    //! Register the host and device allocations for memory accounting
+    inline void registerAllocations();
+
 #ifdef ENABLE_HIP
     //! Helper function to copy memory from the device to host
     inline void memcpyDeviceToHost(bool async) const;
@@ -707,7 +788,7 @@ template<class T> class GPUArrayDispatch : public ArrayHandleDispatch<T>
 
 template<class T>
 GPUArray<T>::GPUArray()
-    : m_num_elements(0), m_pitch(0), m_height(0), m_acquired(false),
+    : m_num_elements(0), m_pitch(0), m_height(0), m_acquired(0),
       m_data_location(data_location::host)
 #ifdef ENABLE_HIP
       ,
@@ -718,7 +799,7 @@ GPUArray<T>::GPUArray()
 
 template<class T>
 GPUArray<T>::GPUArray(std::shared_ptr<const ExecutionConfiguration> exec_conf)
-    : m_num_elements(0), m_pitch(0), m_height(0), m_acquired(false),
+    : m_num_elements(0), m_pitch(0), m_height(0), m_acquired(0),
       m_data_location(data_location::host),
 #ifdef ENABLE_HIP
       m_mapped(false),
@@ -733,7 +814,7 @@ GPUArray<T>::GPUArray(std::shared_ptr<const ExecutionConfiguration> exec_conf)
 */
 template<class T>
 GPUArray<T>::GPUArray(size_t num_elements, std::shared_ptr<const ExecutionConfiguration> exec_conf)
-    : m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(false),
+    : m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(0),
       m_data_location(data_location::host),
 #ifdef ENABLE_HIP
       m_mapped(false),
@@ -754,7 +835,7 @@ template<class T>
 GPUArray<T>::GPUArray(size_t width,
                       size_t height,
                       std::shared_ptr<const ExecutionConfiguration> exec_conf)
-    : m_height(height), m_acquired(false), m_data_location(data_location::host),
+    : m_height(height), m_acquired(0), m_data_location(data_location::host),
 #ifdef ENABLE_HIP
       m_mapped(false),
 #endif
@@ -780,7 +861,7 @@ template<class T>
 GPUArray<T>::GPUArray(size_t num_elements,
                       std::shared_ptr<const ExecutionConfiguration> exec_conf,
                       bool mapped)
-    : m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(false),
+    : m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(0),
       m_data_location(data_location::host), m_mapped(mapped), m_exec_conf(exec_conf)
     {
     // allocate and clear memory
@@ -798,7 +879,7 @@ GPUArray<T>::GPUArray(size_t width,
                       size_t height,
                       std::shared_ptr<const ExecutionConfiguration> exec_conf,
                       bool mapped)
-    : m_height(height), m_acquired(false), m_data_location(data_location::host), m_mapped(mapped),
+    : m_height(height), m_acquired(0), m_data_location(data_location::host), m_mapped(mapped),
       m_exec_conf(exec_conf)
     {
     // make m_pitch the next multiple of 16 larger or equal to the given width
@@ -816,11 +897,11 @@ GPUArray<T>::GPUArray(size_t width,
 template<class T>
 GPUArray<T>::GPUArray(const GPUArray& from) noexcept
     : m_num_elements(from.m_num_elements), m_pitch(from.m_pitch), m_height(from.m_height),
-      m_acquired(false), m_data_location(data_location::host),
+      m_acquired(0), m_data_location(data_location::host),
 #ifdef ENABLE_HIP
       m_mapped(from.m_mapped),
 #endif
-      m_exec_conf(from.m_exec_conf)
+      m_tag(from.m_tag), m_exec_conf(from.m_exec_conf)
     {
     // allocate and clear new memory the same size as the data in from
     allocate();
@@ -846,6 +927,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
         m_pitch = rhs.m_pitch;
         m_height = rhs.m_height;
         m_exec_conf = rhs.m_exec_conf;
+        m_tag = rhs.m_tag;
 #ifdef ENABLE_HIP
         m_mapped = rhs.m_mapped;
 #endif
@@ -879,10 +961,14 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
 template<class T>
 GPUArray<T>::GPUArray(GPUArray&& from) noexcept
     : m_num_elements(std::move(from.m_num_elements)), m_pitch(std::move(from.m_pitch)),
-      m_height(std::move(from.m_height)), m_acquired(std::move(from.m_acquired)),
+      m_height(std::move(from.m_height)), m_acquired(from.m_acquired.load()),
       m_data_location(std::move(from.m_data_location)),
 #ifdef ENABLE_HIP
-      m_mapped(std::move(from.m_mapped)), d_data(std::move(from.d_data)),
+      m_mapped(std::move(from.m_mapped)),
+#endif
+      m_tag(std::move(from.m_tag)),
+#ifdef ENABLE_HIP
+      d_data(std::move(from.d_data)),
 #endif
       h_data(std::move(from.h_data)), m_exec_conf(std::move(from.m_exec_conf))
     {
@@ -897,13 +983,14 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
         m_pitch = std::move(rhs.m_pitch);
         m_height = std::move(rhs.m_height);
         m_exec_conf = std::move(rhs.m_exec_conf);
+        m_tag = std::move(rhs.m_tag);
 #ifdef ENABLE_HIP
         m_mapped = std::move(rhs.m_mapped);
         d_data = std::move(rhs.d_data);
 #endif
         h_data = std::move(rhs.h_data);
         m_data_location = std::move(rhs.m_data_location);
-        m_acquired = std::move(rhs.m_acquired);
+        m_acquired = rhs.m_acquired.load();
         }
 
     return *this;
@@ -931,9 +1018,12 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_num_elements, from.m_num_elements);
     std::swap(m_pitch, from.m_pitch);
     std::swap(m_height, from.m_height);
-    std::swap(m_acquired, from.m_acquired);
+    int acquired = m_acquired.load();
+    m_acquired = from.m_acquired.load();
+    from.m_acquired = acquired;
     std::swap(m_data_location, from.m_data_location);
     std::swap(m_exec_conf, from.m_exec_conf);
+    std::swap(m_tag, from.m_tag);
 #ifdef ENABLE_HIP
     std::swap(d_data, from.d_data);
     std::swap(m_mapped, from.m_mapped);
@@ -975,12 +1065,9 @@ template<class T> void GPUArray<T>::allocate()
             << "GPUArray: Allocating " << float(m_num_elements * sizeof(T)) / 1024.0f / 1024.0f
             << " MB" << std::endl;
 
-    void* host_ptr = nullptr;
-
     // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign(&host_ptr, 32, m_num_elements * sizeof(T));
-    if (retval != 0)
+    void* host_ptr = hoomd::detail::host_allocate(m_exec_conf.get(), m_num_elements * sizeof(T));
+    if (!host_ptr)
         {
         if (m_exec_conf)
             m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
@@ -1022,9 +1109,8 @@ template<class T> void GPUArray<T>::allocate()
         else
             {
 #ifdef ENABLE_HIP
-            hipMalloc(&device_ptr, m_num_elements * sizeof(T));
+            device_ptr = m_exec_conf->getMemoryPool().allocate(m_num_elements * sizeof(T));
 #endif
-            CHECK_CUDA_ERROR();
             }
 
         // store in smart pointer with custom deleter
@@ -1037,6 +1123,24 @@ template<class T> void GPUArray<T>::allocate()
                                                                    device_deleter);
         }
 #endif
+
+    registerAllocations();
+    }
+
+/*! Registers the host allocation and, unless the memory is mapped, the device allocation with the
+    MemoryAccounting of the execution configuration.
+*/
+template<class T> void GPUArray<T>::registerAllocations()
+    {
+    if (!m_exec_conf)
+        return;
+
+    const MemoryAccounting* accounting = m_exec_conf->getMemoryAccounting();
+    accounting->registerAllocation(h_data.get(), sizeof(T) * m_num_elements, false, m_tag);
+#ifdef ENABLE_HIP
+    if (!m_mapped)
+        accounting->registerAllocation(d_data.get(), sizeof(T) * m_num_elements, true, m_tag);
+#endif
     }
 
 /*! \pre allocate() has been called
@@ -1052,7 +1156,9 @@ template<class T> void GPUArray<T>::memclear(size_t first)
     assert(first < m_num_elements);
 
     // clear memory
-    memset((void*)(h_data.get() + first), 0, sizeof(T) * (m_num_elements - first));
+    hoomd::detail::host_clear(m_exec_conf.get(),
+                              (void*)(h_data.get() + first),
+                              sizeof(T) * (m_num_elements - first));
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1161,11 +1267,31 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
 #endif
 ) const
     {
-    if (m_acquired)
+    // Threads may share read access on the host when the data is already there, as no copy or
+    // state change is needed. Any other access is exclusive.
+    bool host_valid = m_data_location == data_location::host;
+#ifdef ENABLE_HIP
+    host_valid = host_valid || m_data_location == data_location::hostdevice;
+#endif
+    if (location == access_location::host && mode == access_mode::read && host_valid)
+        {
+        int acquired = m_acquired.load();
+        do
+            {
+            if (acquired < 0)
+                {
+                throw std::runtime_error("Cannot acquire access to array in use.");
+                }
+            } while (!m_acquired.compare_exchange_weak(acquired, acquired + 1));
+        }
+    else
         {
-        throw std::runtime_error("Cannot acquire access to array in use.");
+        int expected = 0;
+        if (!m_acquired.compare_exchange_strong(expected, -1))
+            {
+            throw std::runtime_error("Cannot acquire access to array in use.");
+            }
         }
-    m_acquired = true;
 
     // base case - handle acquiring a NULL GPUArray by simply returning NULL to prevent any memcpys
     // from being attempted
@@ -1339,12 +1465,9 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
         return NULL;
 
     // allocate resized array
-    T* h_tmp = NULL;
-
-    // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_tmp, 32, num_elements * sizeof(T));
-    if (retval != 0)
+    T* h_tmp = reinterpret_cast<T*>(
+        hoomd::detail::host_allocate(m_exec_conf.get(), num_elements * sizeof(T)));
+    if (!h_tmp)
         {
         if (m_exec_conf)
             m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
@@ -1363,7 +1486,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
         }
 #endif
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * num_elements);
+    hoomd::detail::host_clear(m_exec_conf.get(), (void*)h_tmp, sizeof(T) * num_elements);
 
     // copy over data
     size_t num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
@@ -1404,13 +1527,9 @@ template<class T>
 T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height, size_t new_height)
     {
     // allocate resized array
-    T* h_tmp = NULL;
-
-    // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
     size_t size = new_pitch * new_height * sizeof(T);
-    int retval = posix_memalign((void**)&h_tmp, 32, size);
-    if (retval != 0)
+    T* h_tmp = reinterpret_cast<T*>(hoomd::detail::host_allocate(m_exec_conf.get(), size));
+    if (!h_tmp)
         {
         if (m_exec_conf)
             m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
@@ -1428,7 +1547,7 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
 #endif
 
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * new_pitch * new_height);
+    hoomd::detail::host_clear(m_exec_conf.get(), (void*)h_tmp, size);
 
     // copy over data
     // every column is copied separately such as to align with the new pitch
@@ -1480,11 +1599,9 @@ template<class T> T* GPUArray<T>::resizeDeviceArray(size_t num_elements)
     // allocate resized array
     T* d_tmp;
 #ifdef ENABLE_HIP
-    hipMalloc(&d_tmp, num_elements * sizeof(T));
+    d_tmp = reinterpret_cast<T*>(m_exec_conf->getMemoryPool().allocate(num_elements * sizeof(T)));
 #endif
 
-    CHECK_CUDA_ERROR();
-
     assert(d_tmp);
 
 // clear memory
@@ -1530,9 +1647,9 @@ T* GPUArray<T>::resize2DDeviceArray(size_t pitch,
     // allocate resized array
     T* d_tmp;
 #ifdef ENABLE_HIP
-    hipMalloc(&d_tmp, new_pitch * new_height * sizeof(T));
+    d_tmp = reinterpret_cast<T*>(
+        m_exec_conf->getMemoryPool().allocate(new_pitch * new_height * sizeof(T)));
 #endif
-    CHECK_CUDA_ERROR();
     assert(d_tmp);
 
 // clear memory
@@ -1608,6 +1725,8 @@ template<class T> void GPUArray<T>::resize(size_t num_elements)
 #endif
     m_num_elements = num_elements;
     m_pitch = num_elements;
+
+    registerAllocations();
     }
 
 /*! \param width new width of array
@@ -1654,5 +1773,7 @@ template<class T> void GPUArray<T>::resize(size_t width, size_t height)
     m_height = height;
     m_pitch = new_pitch;
     m_num_elements = m_pitch * m_height;
+
+    registerAllocations();
     }
 #endif
@@ -0,0 +1,304 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file GSDCompression.cc
+    \brief Defines the GSDCompression class
+*/
+
+#include "GSDCompression.h"
+#include "GSD.h"
+
+#include "hoomd/extern/libgetar/src/lz4.h"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace hoomd
+    {
+namespace detail
+    {
+namespace
+    {
+//! Identifies the compressed chunk format
+const char compressed_magic[4] = {'H', 'C', 'C', '1'};
+
+//! Codecs of compressed chunks
+enum class Codec : uint8_t
+    {
+    lossless = 0, //!< Byte shuffle and LZ4
+    quantized = 1 //!< Quantization, delta and zigzag encoding, byte shuffle, and LZ4
+    };
+
+//! Header of a compressed chunk
+struct CompressedChunkHeader
+    {
+    char magic[4];     //!< compressed_magic
+    uint8_t codec;     //!< Codec
+    uint8_t type;      //!< Type of the original chunk
+    uint16_t reserved; //!< Unused
+    uint32_t M;        //!< Number of columns of the original chunk
+    uint64_t N;        //!< Number of rows of the original chunk
+    uint64_t raw_size; //!< Number of bytes before LZ4 compression
+    double precision;  //!< Quantization precision
+    };
+
+//! Group the i-th bytes of all elements together
+void shuffle(char* out, const char* in, size_t n, size_t element_size)
+    {
+    for (size_t i = 0; i < n; i++)
+        for (size_t b = 0; b < element_size; b++)
+            out[b * n + i] = in[i * element_size + b];
+    }
+
+//! Reverse shuffle()
+void unshuffle(char* out, const char* in, size_t n, size_t element_size)
+    {
+    for (size_t i = 0; i < n; i++)
+        for (size_t b = 0; b < element_size; b++)
+            out[i * element_size + b] = in[b * n + i];
+    }
+
+//! Quantize, delta encode, and zigzag encode floating point data
+/*! \returns false when a value does not fit in the quantized range
+ */
+template<class Real>
+bool quantize(std::vector<uint32_t>& out, const Real* in, uint64_t N, uint32_t M, double precision)
+    {
+    // values must fit in 31 bits so that their differences fit in 32 bits
+    const double limit = double(1 << 30);
+
+    out.resize(N * M);
+    std::vector<int32_t> previous(M, 0);
+    for (uint64_t i = 0; i < N; i++)
+        {
+        for (uint32_t j = 0; j < M; j++)
+            {
+            double q = std::nearbyint(double(in[i * M + j]) / precision);
+            if (!(std::fabs(q) < limit))
+                return false;
+
+            int32_t value = int32_t(q);
+            int32_t delta = value - previous[j];
+            previous[j] = value;
+            out[i * M + j] = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+            }
+        }
+    return true;
+    }
+
+//! Reverse quantize()
+template<class Real>
+void dequantize(Real* out, const uint32_t* in, uint64_t N, uint32_t M, double precision)
+    {
+    std::vector<int32_t> previous(M, 0);
+    for (uint64_t i = 0; i < N; i++)
+        {
+        for (uint32_t j = 0; j < M; j++)
+            {
+            uint32_t z = in[i * M + j];
+            int32_t delta = int32_t(z >> 1) ^ -int32_t(z & 1);
+            previous[j] += delta;
+            out[i * M + j] = Real(double(previous[j]) * precision);
+            }
+        }
+    }
+    } // end anonymous namespace
+
+bool GSDCompression::compress(std::vector<char>& out,
+                              gsd_type type,
+                              uint64_t N,
+                              uint32_t M,
+                              const void* data,
+                              double precision)
+    {
+    size_t element_size = gsd_sizeof_type(type);
+    size_t n = N * M;
+    if (n == 0 || element_size == 0)
+        return false;
+
+    CompressedChunkHeader header;
+    memcpy(header.magic, compressed_magic, sizeof(compressed_magic));
+    header.codec = uint8_t(Codec::lossless);
+    header.type = uint8_t(type);
+    header.reserved = 0;
+    header.M = M;
+    header.N = N;
+    header.precision = 0;
+
+    std::vector<char> raw;
+    if (precision > 0 && (type == GSD_TYPE_FLOAT || type == GSD_TYPE_DOUBLE))
+        {
+        std::vector<uint32_t> quantized;
+        bool valid = type == GSD_TYPE_FLOAT
+                         ? quantize(quantized, static_cast<const float*>(data), N, M, precision)
+                         : quantize(quantized, static_cast<const double*>(data), N, M, precision);
+        if (valid)
+            {
+            header.codec = uint8_t(Codec::quantized);
+            header.precision = precision;
+            raw.resize(n * sizeof(uint32_t));
+            shuffle(raw.data(), reinterpret_cast<const char*>(quantized.data()), n, 4);
+            }
+        }
+
+    if (header.codec == uint8_t(Codec::lossless))
+        {
+        raw.resize(n * element_size);
+        shuffle(raw.data(), static_cast<const char*>(data), n, element_size);
+        }
+
+    if (raw.size() > size_t(LZ4_MAX_INPUT_SIZE))
+        return false;
+    header.raw_size = raw.size();
+
+    int bound = LZ4_compressBound(int(raw.size()));
+    out.resize(sizeof(CompressedChunkHeader) + bound);
+    int bytes = LZ4_compress_default(raw.data(),
+                                     out.data() + sizeof(CompressedChunkHeader),
+                                     int(raw.size()),
+                                     bound);
+    if (bytes <= 0)
+        return false;
+
+    // lossless compression is only worthwhile when it saves space
+    out.resize(sizeof(CompressedChunkHeader) + bytes);
+    if (header.codec == uint8_t(Codec::lossless) && out.size() >= n * element_size)
+        return false;
+
+    memcpy(out.data(), &header, sizeof(CompressedChunkHeader));
+    return true;
+    }
+
+/*! \param out Set to the decompressed data
+    \param type Set to the type of the chunk
+    \param N Set to the number of rows
+    \param M Set to the number of columns
+    \param in Compressed chunk
+    \param size Size of the compressed chunk in bytes
+*/
+void GSDCompression::decompress(std::vector<char>& out,
+                                gsd_type& type,
+                                uint64_t& N,
+                                uint32_t& M,
+                                const char* in,
+                                size_t size)
+    {
+    CompressedChunkHeader header;
+    if (size < sizeof(CompressedChunkHeader))
+        throw std::runtime_error("Invalid compressed GSD chunk");
+    memcpy(&header, in, sizeof(CompressedChunkHeader));
+    if (memcmp(header.magic, compressed_magic, sizeof(compressed_magic)) != 0
+        || header.raw_size > size_t(LZ4_MAX_INPUT_SIZE))
+        throw std::runtime_error("Invalid compressed GSD chunk");
+
+    type = gsd_type(header.type);
+    N = header.N;
+    M = header.M;
+    size_t n = N * M;
+    size_t element_size = gsd_sizeof_type(type);
+
+    std::vector<char> raw(header.raw_size);
+    int bytes = LZ4_decompress_safe(in + sizeof(CompressedChunkHeader),
+                                    raw.data(),
+                                    int(size - sizeof(CompressedChunkHeader)),
+                                    int(raw.size()));
+    if (bytes < 0 || size_t(bytes) != raw.size())
+        throw std::runtime_error("Invalid compressed GSD chunk");
+
+    out.resize(n * element_size);
+    if (header.codec == uint8_t(Codec::lossless) && raw.size() == n * element_size)
+        {
+        unshuffle(out.data(), raw.data(), n, element_size);
+        }
+    else if (header.codec == uint8_t(Codec::quantized) && raw.size() == n * sizeof(uint32_t)
+             && (type == GSD_TYPE_FLOAT || type == GSD_TYPE_DOUBLE))
+        {
+        std::vector<uint32_t> quantized(n);
+        unshuffle(reinterpret_cast<char*>(quantized.data()), raw.data(), n, 4);
+        if (type == GSD_TYPE_FLOAT)
+            dequantize(reinterpret_cast<float*>(out.data()),
+                       quantized.data(),
+                       N,
+                       M,
+                       header.precision);
+        else
+            dequantize(reinterpret_cast<double*>(out.data()),
+                       quantized.data(),
+                       N,
+                       M,
+                       header.precision);
+        }
+    else
+        {
+        throw std::runtime_error("Invalid compressed GSD chunk");
+        }
+    }
+
+/*! \param handle Handle to the open file
+    \param frame Frame index to look in
+    \param name Name of the uncompressed chunk
+    \param compressed Set to true when the found chunk is compressed
+
+    Follows the rules for missing chunks of GSD: a chunk missing from the frame is looked up in
+    frame 0.
+
+    \returns The entry of the chunk or NULL when it is not found
+*/
+const gsd_index_entry*
+GSDCompression::findChunk(gsd_handle& handle, uint64_t frame, const char* name, bool& compressed)
+    {
+    std::string compressed_name = getCompressedName(name);
+    for (uint64_t f : {frame, uint64_t(0)})
+        {
+        const gsd_index_entry* entry = gsd_find_chunk(&handle, f, compressed_name.c_str());
+        if (entry != NULL)
+            {
+            compressed = true;
+            return entry;
+            }
+
+        entry = gsd_find_chunk(&handle, f, name);
+        if (entry != NULL)
+            {
+            compressed = false;
+            return entry;
+            }
+        }
+
+    compressed = false;
+    return NULL;
+    }
+
+/*! \param handle Handle to the open file
+    \param entry Entry of the compressed chunk
+    \param fname File name, for error messages
+    \param out Set to the decompressed data
+    \param type Set to the type of the chunk
+    \param N Set to the number of rows
+    \param M Set to the number of columns
+*/
+void GSDCompression::readChunk(gsd_handle& handle,
+                               const gsd_index_entry* entry,
+                               const std::string& fname,
+                               std::vector<char>& out,
+                               gsd_type& type,
+                               uint64_t& N,
+                               uint32_t& M)
+    {
+    std::vector<char> compressed(entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type));
+    int retval = gsd_read_chunk(&handle, compressed.data(), entry);
+    GSDUtils::checkError(retval, fname);
+
+    try
+        {
+        decompress(out, type, N, M, compressed.data(), compressed.size());
+        }
+    catch (const std::exception& e)
+        {
+        throw std::runtime_error(std::string(e.what()) + " in " + fname);
+        }
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
@@ -0,0 +1,91 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file GSDCompression.h
+    \brief Declares the GSDCompression class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/extern/gsd.h"
+
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Compress and decompress chunks of GSD files
+/*! The GSD file format does not compress data. GSDDumpWriter stores a compressed chunk as a uint8
+    chunk whose name is the original name prefixed with "compressed/" and omits the original chunk.
+    GSDReader and GSDStateReader read either form transparently. Other GSD readers see only the
+    uncompressed chunks.
+
+    A compressed chunk starts with a header that records the type and shape of the original chunk
+    and the codec, followed by the LZ4 compressed payload:
+
+    - Lossless: the bytes of the elements are shuffled (the first byte of every element, then the
+      second byte, ...) so that the often constant high bytes compress well.
+    - Quantized (floating point chunks only): every value is rounded to the nearest integer multiple
+      of the precision, so the error is at most half the precision, as in the xtc format. The
+      integers are delta encoded from one row (particle) to the next, zigzag encoded so that small
+      negative numbers become small positive numbers, and byte shuffled.
+
+    Chunks that do not compress fall back to the uncompressed form.
+*/
+class PYBIND11_EXPORT GSDCompression
+    {
+    public:
+    //! Get the name of the compressed form of a chunk
+    static std::string getCompressedName(const std::string& name)
+        {
+        return "compressed/" + name;
+        }
+
+    //! Compress a chunk
+    /*! \param out Set to the compressed chunk
+        \param type Type of the chunk
+        \param N Number of rows
+        \param M Number of columns
+        \param data Chunk data
+        \param precision Quantize floating point data to this precision, 0 for lossless
+
+        \returns false when the chunk should be written uncompressed
+    */
+    static bool compress(std::vector<char>& out,
+                         gsd_type type,
+                         uint64_t N,
+                         uint32_t M,
+                         const void* data,
+                         double precision);
+
+    //! Decompress a chunk
+    static void decompress(std::vector<char>& out,
+                           gsd_type& type,
+                           uint64_t& N,
+                           uint32_t& M,
+                           const char* in,
+                           size_t size);
+
+    //! Find a chunk in either form, falling back to frame 0
+    static const gsd_index_entry*
+    findChunk(gsd_handle& handle, uint64_t frame, const char* name, bool& compressed);
+
+    //! Read and decompress a compressed chunk
+    static void readChunk(gsd_handle& handle,
+                          const gsd_index_entry* entry,
+                          const std::string& fname,
+                          std::vector<char>& out,
+                          gsd_type& type,
+                          uint64_t& N,
+                          uint32_t& M);
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
@@ -4,6 +4,7 @@
 #include "GSDDumpWriter.h"
 #include "Filesystem.h"
 #include "GSD.h"
+#include "GSDCompression.h"
 #include "HOOMDVersion.h"
 
 #ifdef ENABLE_MPI
@@ -13,6 +14,7 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl_bind.h>
 
+#include <algorithm>
 #include <limits>
 #include <list>
 #include <sstream>
@@ -42,6 +44,8 @@ std::list<std::string> GSDDumpWriter::particle_chunks {"particles/typeid",
     \param mode File open mode ("wb", "xb", or "ab")
     \param truncate If true, truncate the file to 0 frames every time analyze() called, then write
    out one frame
+    \param shard If true, each rank writes the particles it owns to its own file (see
+   getShardFilename())
 
     If the group does not include all particles, then topology information cannot be written to the
    file.
@@ -50,9 +54,14 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                              const std::string& fname,
                              std::shared_ptr<ParticleGroup> group,
                              std::string mode,
-                             bool truncate)
-    : Analyzer(sysdef), m_fname(fname), m_mode(mode), m_truncate(truncate), m_is_initialized(false),
-      m_group(group)
+                             bool truncate,
+                             bool shard)
+    : Analyzer(sysdef), m_fname(fname), m_mode(mode), m_truncate(truncate), m_shard(shard),
+      m_output_fname(shard ? getShardFilename(fname, m_exec_conf->getRank()) : fname),
+      m_is_initialized(false), m_nframes(0), m_incremental(false), m_topology_changed(false),
+      m_group(group), m_write_signal_used(false), m_asynchronous(false),
+      m_max_queue_depth(2), m_stop_io_thread(false), m_io_error(GSD_SUCCESS),
+      m_compression {false, 0.0, 0.0}
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << mode << " "
                                 << truncate << endl;
@@ -61,26 +70,57 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
         throw std::invalid_argument("Invalid GSD file mode: " + mode);
         }
     m_log_writer = pybind11::none();
+
+    // track changes to the topology for incremental frames
+    m_sysdef->getBondData()
+        ->getGroupNumChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getAngleData()
+        ->getGroupNumChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getDihedralData()
+        ->getGroupNumChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getImproperData()
+        ->getGroupNumChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getConstraintData()
+        ->getGroupNumChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getPairData()
+        ->getGroupNumChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .connect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    }
+
+/*! \param fname Base file name
+    \param rank Rank that writes the shard
+    \returns The name of the file that \a rank writes in shard mode
+*/
+std::string GSDDumpWriter::getShardFilename(const std::string& fname, unsigned int rank)
+    {
+    return fname + "." + std::to_string(rank);
     }
 
 //! Initializes the output file for writing
 void GSDDumpWriter::initFileIO()
     {
     // create a new file or overwrite an existing one
-    if (m_mode == "wb" || m_mode == "xb" || (m_mode == "ab" && !filesystem::exists(m_fname)))
+    if (m_mode == "wb" || m_mode == "xb" || (m_mode == "ab" && !filesystem::exists(m_output_fname)))
         {
         ostringstream o;
         o << "HOOMD-blue " << HOOMD_VERSION;
 
-        m_exec_conf->msg->notice(3) << "GSD: create or overwrite gsd file " << m_fname << endl;
+        m_exec_conf->msg->notice(3) << "GSD: create or overwrite gsd file " << m_output_fname << endl;
         int retval = gsd_create_and_open(&m_handle,
-                                         m_fname.c_str(),
+                                         m_output_fname.c_str(),
                                          o.str().c_str(),
                                          "hoomd",
                                          gsd_make_version(1, 4),
                                          GSD_OPEN_APPEND,
                                          m_mode == "xb");
-        GSDUtils::checkError(retval, m_fname);
+        GSDUtils::checkError(retval, m_output_fname);
 
         // in a created or overwritten file, all quantities are default
         for (auto const& chunk : particle_chunks)
@@ -94,23 +134,23 @@ void GSDDumpWriter::initFileIO()
         populateNonDefault();
 
         // open the file in append mode
-        m_exec_conf->msg->notice(3) << "GSD: open gsd file " << m_fname << endl;
-        int retval = gsd_open(&m_handle, m_fname.c_str(), GSD_OPEN_APPEND);
-        GSDUtils::checkError(retval, m_fname);
+        m_exec_conf->msg->notice(3) << "GSD: open gsd file " << m_output_fname << endl;
+        int retval = gsd_open(&m_handle, m_output_fname.c_str(), GSD_OPEN_APPEND);
+        GSDUtils::checkError(retval, m_output_fname);
 
         // validate schema
         if (string(m_handle.header.schema) != string("hoomd"))
             {
             std::ostringstream s;
             s << "GSD: "
-              << "Invalid schema in " << m_fname;
+              << "Invalid schema in " << m_output_fname;
             throw runtime_error("Error opening GSD file");
             }
         if (m_handle.header.schema_version >= gsd_make_version(2, 0))
             {
             std::ostringstream s;
             s << "GSD: "
-              << "Invalid schema version in " << m_fname;
+              << "Invalid schema version in " << m_output_fname;
             throw runtime_error("Error opening GSD file");
             }
         }
@@ -119,21 +159,50 @@ void GSDDumpWriter::initFileIO()
         throw std::invalid_argument("Invalid GSD file mode: " + m_mode);
         }
 
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
+
+    // the topology in frame 0 of an existing file is unknown
+    if (m_nframes > 0)
+        m_topology_changed = true;
     }
 
 GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
 
+    m_sysdef->getBondData()
+        ->getGroupNumChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getAngleData()
+        ->getGroupNumChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getDihedralData()
+        ->getGroupNumChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getImproperData()
+        ->getGroupNumChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getConstraintData()
+        ->getGroupNumChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_sysdef->getPairData()
+        ->getGroupNumChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .disconnect<GSDDumpWriter, &GSDDumpWriter::slotTopologyChanged>(this);
+
     bool root = true;
 #ifdef ENABLE_MPI
     root = m_exec_conf->isRoot();
 #endif
 
-    if (root && m_is_initialized)
+    // write out any frames still in the queue
+    stopIOThread();
+
+    if ((root || m_shard) && m_is_initialized)
         {
-        m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
+        m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_output_fname << endl;
         gsd_close(&m_handle);
         }
     }
@@ -153,57 +222,88 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
+    // take particle data snapshot, gathered to the root or local to each shard
     SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
+    std::map<unsigned int, unsigned int> map;
+    if (m_shard)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: taking local particle data snapshot" << endl;
+        map = m_pdata->takeLocalSnapshot<float>(snapshot);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
+        map = m_pdata->takeSnapshot<float>(snapshot);
+        }
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
 #endif
 
+    // in shard mode, every rank writes the particles it owns to its own file
+    bool io_rank = root || m_shard;
+
     // open the file if it is not yet opened
-    if (!m_is_initialized && root)
+    if (!m_is_initialized && io_rank)
         initFileIO();
 
+    // stage the frame in a buffer for the I/O thread to write in asynchronous mode
+    if (m_asynchronous && io_rank)
+        beginStagedFrame();
+
     // truncate the file if requested
-    if (m_truncate && root)
+    if (m_truncate && io_rank)
         {
         m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_staged_frame)
+            {
+            m_staged_frame->truncate = true;
+            }
+        else
+            {
+            retval = gsd_truncate(&m_handle);
+            GSDUtils::checkError(retval, m_output_fname);
+            }
+        m_nframes = 0;
         }
 
     uint64_t nframes = 0;
-    if (root)
+    if (io_rank)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10)
-            << "GSD: " << m_fname << " has " << nframes << " frames" << endl;
+            << "GSD: " << m_output_fname << " has " << nframes << " frames" << endl;
         }
 
 #ifdef ENABLE_MPI
     bcast(nframes, 0, m_exec_conf->getMPICommunicator());
 #endif
 
-    if (root)
+    if (io_rank)
         {
+        populateTags();
+
         // write out the frame header on all frames
         writeFrameHeader(timestep);
 
-        // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
+        // only write out data chunk categories if requested, or if on frame 0. The particles in a
+        // shard change from frame to frame, so shards write all categories in every frame.
+        if (m_write_attribute || nframes == 0 || m_shard)
             writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
+        if (m_write_property || nframes == 0 || m_shard)
             writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
+        if (m_write_momentum || nframes == 0 || m_shard)
             writeMomenta(snapshot, map);
         }
 
+    // incremental frames omit the topology unless it changed since frame 0
+    bool write_topology = m_write_topology || nframes == 0;
+    if (write_topology && nframes > 0 && m_incremental && !m_truncate)
+        write_topology = topologyChanged();
+
     // topology is only meaningful if this is the all group
-    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
-        && (m_write_topology || nframes == 0))
+    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && write_topology)
         {
         BondData::Snapshot bdata_snapshot;
         m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
@@ -230,27 +330,380 @@ void GSDDumpWriter::analyze(uint64_t timestep)
                           idata_snapshot,
                           cdata_snapshot,
                           pdata_snapshot);
+
+        // later frames compare to the topology in frame 0
+        if (nframes == 0)
+            {
+            m_topology_changed = false;
+            m_topology_type_names = getTopologyTypeNames();
+            }
         }
 
+    // slots write to the handle directly, wait until the I/O thread is done with it
+    if (m_write_signal_used && io_rank)
+        waitForQueue(0);
+
     // emit on all ranks, the slot needs to handle the mpi logic.
     m_write_signal.emit(m_handle);
 
     if (!m_log_writer.is_none())
         {
+        pybind11::gil_scoped_acquire acquire;
         m_log_writer.attr("_write_frame")(this);
         }
 
-    if (root)
+    if (io_rank)
         {
-        m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_staged_frame)
+            {
+            m_exec_conf->msg->notice(10) << "GSD: queueing frame" << endl;
+            queueStagedFrame();
+            }
+        else
+            {
+            m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
+            retval = gsd_end_frame(&m_handle);
+            GSDUtils::checkError(retval, m_output_fname);
+            }
+        m_nframes++;
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param name Name of the chunk
+    \param type Type of the data
+    \param N Number of rows
+    \param M Number of columns
+    \param data Data to write
+
+    Write the chunk to the file immediately, or copy it into the staged frame when one is open.
+*/
+void GSDDumpWriter::writeChunk(const char* name,
+                               gsd_type type,
+                               uint64_t N,
+                               uint32_t M,
+                               const void* data)
+    {
+    // incremental frames omit particle chunks that are identical to frame 0
+    if (m_incremental && !m_truncate && !m_shard && isIncrementalChunk(name))
+        {
+        size_t size = N * M * gsd_sizeof_type(type);
+        if (m_nframes == 0)
+            {
+            Chunk& chunk = m_frame0_chunks[name];
+            chunk.name = name;
+            chunk.type = type;
+            chunk.N = N;
+            chunk.M = M;
+            chunk.data.assign((const char*)data, (const char*)data + size);
+            }
+        else
+            {
+            auto it = m_frame0_chunks.find(name);
+            if (it != m_frame0_chunks.end() && it->second.type == type && it->second.N == N
+                && it->second.M == M && memcmp(it->second.data.data(), data, size) == 0)
+                {
+                m_exec_conf->msg->notice(10) << "GSD: " << name << " unchanged" << endl;
+                return;
+                }
+            }
+        }
+
+    if (!m_staged_frame)
+        {
+        int retval
+            = writeFileChunk(name, type, N, M, data, m_compression, m_compression_buffer);
+        GSDUtils::checkError(retval, m_output_fname);
+        return;
+        }
+
+    // reuse the chunk buffers of previously written frames to avoid reallocation
+    if (m_staged_frame->n_chunks == m_staged_frame->chunks.size())
+        m_staged_frame->chunks.emplace_back();
+
+    Chunk& chunk = m_staged_frame->chunks[m_staged_frame->n_chunks++];
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    size_t size = N * M * gsd_sizeof_type(type);
+    chunk.data.resize(size);
+    if (size > 0)
+        memcpy(chunk.data.data(), data, size);
+    }
+
+/*! \param name Name of the chunk
+    \param type Type of the data
+    \param N Number of rows
+    \param M Number of columns
+    \param data Data to write
+    \param compression Compression settings
+    \param buffer Buffer for the compressed chunk
+
+    Called from both the main thread and the I/O thread, so it must not access members other than
+    the file handle.
+
+    \returns The GSD error code
+*/
+int GSDDumpWriter::writeFileChunk(const char* name,
+                                  gsd_type type,
+                                  uint64_t N,
+                                  uint32_t M,
+                                  const void* data,
+                                  const CompressionSettings& compression,
+                                  std::vector<char>& buffer)
+    {
+    if (compression.compress && strncmp(name, "particles/", 10) == 0
+        && strcmp(name, "particles/N") != 0 && strcmp(name, "particles/types") != 0)
+        {
+        double precision = 0;
+        if (strcmp(name, "particles/position") == 0)
+            precision = compression.position_precision;
+        else if (strcmp(name, "particles/velocity") == 0)
+            precision = compression.velocity_precision;
+
+        if (GSDCompression::compress(buffer, type, N, M, data, precision))
+            {
+            std::string compressed_name = GSDCompression::getCompressedName(name);
+            return gsd_write_chunk(&m_handle,
+                                   compressed_name.c_str(),
+                                   GSD_TYPE_UINT8,
+                                   buffer.size(),
+                                   1,
+                                   0,
+                                   buffer.data());
+            }
+        }
+
+    return gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+    }
+
+/*! \param name Name of the chunk
+    \returns true when incremental frames may omit the chunk
+
+    The tags and number of particles are always written.
+*/
+bool GSDDumpWriter::isIncrementalChunk(const char* name)
+    {
+    return strncmp(name, "particles/", 10) == 0 && strcmp(name, "particles/N") != 0
+           && strcmp(name, "particles/tag") != 0;
+    }
+
+//! Get the type names of all bonded groups
+std::vector<std::string> GSDDumpWriter::getTopologyTypeNames()
+    {
+    std::vector<std::string> names;
+    auto append = [&names](auto group_data)
+    {
+        for (unsigned int i = 0; i < group_data->getNTypes(); i++)
+            names.push_back(group_data->getNameByType(i));
+    };
+    append(m_sysdef->getBondData());
+    append(m_sysdef->getAngleData());
+    append(m_sysdef->getDihedralData());
+    append(m_sysdef->getImproperData());
+    append(m_sysdef->getPairData());
+    return names;
+    }
+
+/*! \returns true when the topology may have changed since frame 0. Collective call.
+
+    The group number change signals flag additions and removals of bonded groups. Renamed types do
+    not emit a signal, so compare the type names as well.
+*/
+bool GSDDumpWriter::topologyChanged()
+    {
+    int changed = m_topology_changed || getTopologyTypeNames() != m_topology_type_names;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &changed,
+                      1,
+                      MPI_INT,
+                      MPI_LOR,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return changed;
+    }
+
+/*! Take a frame from the pool (or allocate one) and direct writeChunk() to it. Starts the I/O
+    thread when needed.
+*/
+void GSDDumpWriter::beginStagedFrame()
+    {
+    if (!m_io_thread.joinable())
+        {
+        m_stop_io_thread = false;
+        m_io_thread = std::thread(&GSDDumpWriter::ioThread, this);
+        }
+
+    // wait until there is room in the queue, rethrow errors from previous frames
+    waitForQueue(m_max_queue_depth - 1);
+
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        if (m_frame_pool.empty())
+            {
+            m_staged_frame = std::unique_ptr<Frame>(new Frame);
+            }
+        else
+            {
+            m_staged_frame = std::move(m_frame_pool.back());
+            m_frame_pool.pop_back();
+            }
+        }
+
+    m_staged_frame->truncate = false;
+    m_staged_frame->compression = m_compression;
+    m_staged_frame->n_chunks = 0;
+    }
+
+//! Pass the staged frame to the I/O thread
+void GSDDumpWriter::queueStagedFrame()
+    {
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_queue.push_back(std::move(m_staged_frame));
+        }
+    m_queue_cv.notify_all();
+    }
+
+/*! \param depth Wait until there are no more than this many frames in the queue
+
+    Rethrows any error encountered by the I/O thread.
+*/
+void GSDDumpWriter::waitForQueue(unsigned int depth)
+    {
+    int retval;
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue_cv.wait(lock, [this, depth] { return m_queue.size() <= depth || m_io_error; });
+        retval = m_io_error;
+        m_io_error = GSD_SUCCESS;
+        }
+    GSDUtils::checkError(retval, m_output_fname);
+    }
+
+/*! Write queued frames to the file in order until stopped. Frames are returned to the pool only
+    after they are written so that waitForQueue() guarantees the file is up to date.
+*/
+void GSDDumpWriter::ioThread()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    while (true)
+        {
+        m_queue_cv.wait(lock, [this] { return !m_queue.empty() || m_stop_io_thread; });
+        if (m_queue.empty())
+            return;
+
+        Frame& frame = *m_queue.front();
+        lock.unlock();
+
+        int retval = GSD_SUCCESS;
+        if (frame.truncate)
+            retval = gsd_truncate(&m_handle);
+        for (size_t i = 0; i < frame.n_chunks && retval == GSD_SUCCESS; i++)
+            {
+            const Chunk& chunk = frame.chunks[i];
+            retval = writeFileChunk(chunk.name.c_str(),
+                                    chunk.type,
+                                    chunk.N,
+                                    chunk.M,
+                                    chunk.data.data(),
+                                    frame.compression,
+                                    m_io_compression_buffer);
+            }
+        if (retval == GSD_SUCCESS)
+            retval = gsd_end_frame(&m_handle);
+
+        lock.lock();
+        if (retval != GSD_SUCCESS)
+            m_io_error = retval;
+        m_frame_pool.push_back(std::move(m_queue.front()));
+        m_queue.pop_front();
+        m_queue_cv.notify_all();
+        }
+    }
+
+//! Write all queued frames and stop the I/O thread
+void GSDDumpWriter::stopIOThread()
+    {
+    if (m_io_thread.joinable())
+        {
+            {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_stop_io_thread = true;
+            }
+        m_queue_cv.notify_all();
+        m_io_thread.join();
+        }
+    }
+
+/*! Block until the I/O thread has written all queued frames to the file. Collective call.
+ */
+void GSDDumpWriter::flush()
+    {
+    if (m_io_thread.joinable())
+        waitForQueue(0);
+    }
+
+/*! \param asynchronous true to write frames in a background thread
+
+    Writes all queued frames when switching to synchronous mode.
+*/
+void GSDDumpWriter::setAsynchronous(bool asynchronous)
+    {
+    if (!asynchronous)
+        {
+        stopIOThread();
+        int retval = m_io_error;
+        m_io_error = GSD_SUCCESS;
+        GSDUtils::checkError(retval, m_output_fname);
+        }
+    m_asynchronous = asynchronous;
+    }
+
+//! Set the maximum number of frames waiting to be written
+void GSDDumpWriter::setMaxQueueDepth(unsigned int depth)
+    {
+    if (depth == 0)
+        throw std::invalid_argument("GSD: max_queue_depth must be positive");
+    m_max_queue_depth = depth;
+    }
+
+/*! \param compress true to compress particle chunks
+
+    Shards are merged with the gsd Python package, which cannot read compressed chunks.
+*/
+void GSDDumpWriter::setCompress(bool compress)
+    {
+    if (compress && m_shard)
+        throw std::invalid_argument("GSD: compression is not supported in shard mode");
+    m_compression.compress = compress;
+    }
+
+//! Set the quantization precision of positions
+void GSDDumpWriter::setPositionPrecision(double precision)
+    {
+    if (!(precision >= 0))
+        throw std::invalid_argument("GSD: position_precision must be positive");
+    m_compression.position_precision = precision;
+    }
+
+//! Set the quantization precision of velocities
+void GSDDumpWriter::setVelocityPrecision(double precision)
+    {
+    if (!(precision >= 0))
+        throw std::invalid_argument("GSD: velocity_precision must be positive");
+    m_compression.velocity_precision = precision;
+    }
+
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping)
     {
     int max_len = 0;
@@ -265,14 +718,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len * i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle,
-                                     chunk.c_str(),
-                                     GSD_TYPE_UINT8,
-                                     type_mapping.size(),
-                                     max_len,
-                                     0,
-                                     (void*)&types[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, (void*)&types[0]);
         }
     }
 
@@ -286,25 +732,15 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
 */
 void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     {
-    int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval
-        = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void*)&step);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void*)&step);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/dimensions",
-                                 GSD_TYPE_UINT8,
-                                 1,
-                                 1,
-                                 0,
-                                 (void*)&dimensions);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, (void*)&dimensions);
         }
 
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/box" << endl;
@@ -316,13 +752,42 @@ void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     box_a[3] = (float)box.getTiltFactorXY();
     box_a[4] = (float)box.getTiltFactorXZ();
     box_a[5] = (float)box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void*)box_a);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, (void*)box_a);
 
     m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
-    uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-    GSDUtils::checkError(retval, m_fname);
+    uint32_t N = (uint32_t)m_tags.size();
+    writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
+
+    // shards store the tags of their particles so that they can be merged
+    if (m_shard)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: writing particles/tag" << endl;
+        writeChunk("particles/tag", GSD_TYPE_UINT32, N, 1, (void*)m_tags.data());
+        }
+    }
+
+/*! Set m_tags to the tags of the particles to write in ascending order: all members of the group,
+    or the members of the group owned by this rank in shard mode.
+*/
+void GSDDumpWriter::populateTags()
+    {
+    if (m_shard)
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        m_tags.resize(m_group->getNumMembers());
+        for (unsigned int group_idx = 0; group_idx < m_group->getNumMembers(); group_idx++)
+            m_tags[group_idx] = h_tag.data[m_group->getMemberIndex(group_idx)];
+        std::sort(m_tags.begin(), m_tags.end());
+        }
+    else
+        {
+        m_tags.resize(m_group->getNumMembersGlobal());
+        for (unsigned int group_idx = 0; group_idx < m_group->getNumMembersGlobal(); group_idx++)
+            m_tags[group_idx] = m_group->getMemberTag(group_idx);
+        }
     }
 
 /*! \param snapshot particle data snapshot to write out to the file
@@ -333,9 +798,8 @@ void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
 void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
                                     const std::map<unsigned int, unsigned int>& map)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint32_t N = (uint32_t)m_tags.size();
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -346,7 +810,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -361,14 +825,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/typeid",
-                                     GSD_TYPE_UINT32,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&type[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&type[0]);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
             }
@@ -381,7 +838,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -396,14 +853,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/mass",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
             }
@@ -412,7 +862,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -426,14 +876,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/charge",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
             }
@@ -442,7 +885,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -457,14 +900,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/diameter",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
             }
@@ -477,7 +913,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -492,14 +928,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/body",
-                                     GSD_TYPE_INT32,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&body[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/body", GSD_TYPE_INT32, N, 1, (void*)&body[0]);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
             }
@@ -512,7 +941,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -533,14 +962,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/moment_inertia",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
             }
@@ -554,9 +976,8 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
                                     const std::map<unsigned int, unsigned int>& map)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint32_t N = (uint32_t)m_tags.size();
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N) * 3);
@@ -564,7 +985,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -576,14 +997,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/position",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&data[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
         }
 
         {
@@ -593,7 +1007,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -616,14 +1030,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/orientation",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     4,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
             }
@@ -637,9 +1044,8 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
                                  const std::map<unsigned int, unsigned int>& map)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint32_t N = (uint32_t)m_tags.size();
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N) * 3);
@@ -648,7 +1054,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -668,14 +1074,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/velocity",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
             }
@@ -688,7 +1087,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -711,14 +1110,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/angmom",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     4,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
             }
@@ -731,7 +1123,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = m_tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -751,14 +1143,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/image",
-                                     GSD_TYPE_INT32,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/image", GSD_TYPE_INT32, N, 3, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
             }
@@ -785,126 +1170,64 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&bond.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, (void*)&bond.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&bond.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, (void*)&bond.groups[0]);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&angle.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&angle.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&angle.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, (void*)&angle.groups[0]);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&dihedral.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, (void*)&dihedral.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&dihedral.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, (void*)&dihedral.groups[0]);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&improper.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, (void*)&improper.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&improper.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, (void*)&improper.groups[0]);
         }
 
     if (constraint.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval
-            = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
             {
@@ -913,55 +1236,26 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle,
-                                     "constraints/value",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "constraints/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&constraint.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, (void*)&constraint.groups[0]);
         }
 
     if (pair.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&pair.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, (void*)&pair.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&pair.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, (void*)&pair.groups[0]);
         }
     }
 
@@ -1061,14 +1355,7 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
                 throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle,
-                                         name.c_str(),
-                                         type,
-                                         N,
-                                         (uint32_t)M,
-                                         0,
-                                         (void*)arr.data());
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk(name.c_str(), type, N, (uint32_t)M, (void*)arr.data());
             }
         }
     }
@@ -1081,32 +1368,79 @@ void GSDDumpWriter::populateNonDefault()
     int retval;
 
     // open the file in read only mode
-    m_exec_conf->msg->notice(3) << "GSD: check frame 0 in gsd file " << m_fname << endl;
-    retval = gsd_open(&m_handle, m_fname.c_str(), GSD_OPEN_READONLY);
-    GSDUtils::checkError(retval, m_fname);
+    m_exec_conf->msg->notice(3) << "GSD: check frame 0 in gsd file " << m_output_fname << endl;
+    retval = gsd_open(&m_handle, m_output_fname.c_str(), GSD_OPEN_READONLY);
+    GSDUtils::checkError(retval, m_output_fname);
 
     // validate schema
     if (string(m_handle.header.schema) != string("hoomd"))
         {
         std::ostringstream s;
         s << "GSD: "
-          << "Invalid schema in " << m_fname;
+          << "Invalid schema in " << m_output_fname;
         throw runtime_error("Error opening GSD file");
         }
     if (m_handle.header.schema_version >= gsd_make_version(2, 0))
         {
         std::ostringstream s;
         s << "GSD: "
-          << "Invalid schema version in " << m_fname;
+          << "Invalid schema version in " << m_output_fname;
         throw runtime_error("Error opening GSD file");
         }
 
     for (auto const& chunk : particle_chunks)
         {
-        const gsd_index_entry* entry = gsd_find_chunk(&m_handle, 0, chunk.c_str());
+        bool compressed;
+        const gsd_index_entry* entry
+            = GSDCompression::findChunk(m_handle, 0, chunk.c_str(), compressed);
         m_nondefault[chunk] = (entry != nullptr);
         }
 
+    // read the particle chunks in frame 0 to compare to in incremental frames
+    m_frame0_chunks.clear();
+    if (m_incremental && !m_truncate && !m_shard)
+        {
+        const char* chunk_name = gsd_find_matching_chunk_name(&m_handle, "particles/", nullptr);
+        while (chunk_name != nullptr)
+            {
+            const gsd_index_entry* entry = gsd_find_chunk(&m_handle, 0, chunk_name);
+            if (entry != nullptr && isIncrementalChunk(chunk_name))
+                {
+                Chunk& chunk = m_frame0_chunks[chunk_name];
+                chunk.name = chunk_name;
+                chunk.type = (gsd_type)entry->type;
+                chunk.N = entry->N;
+                chunk.M = entry->M;
+                chunk.data.resize(entry->N * entry->M * gsd_sizeof_type(chunk.type));
+                retval = gsd_read_chunk(&m_handle, chunk.data.data(), entry);
+                GSDUtils::checkError(retval, m_output_fname);
+                }
+            chunk_name = gsd_find_matching_chunk_name(&m_handle, "particles/", chunk_name);
+            }
+
+        // decompress the compressed particle chunks, lossy chunks never compare equal
+        chunk_name = gsd_find_matching_chunk_name(&m_handle, "compressed/particles/", nullptr);
+        while (chunk_name != nullptr)
+            {
+            const gsd_index_entry* entry = gsd_find_chunk(&m_handle, 0, chunk_name);
+            const char* name = chunk_name + strlen("compressed/");
+            if (entry != nullptr && isIncrementalChunk(name))
+                {
+                Chunk& chunk = m_frame0_chunks[name];
+                chunk.name = name;
+                GSDCompression::readChunk(m_handle,
+                                          entry,
+                                          m_output_fname,
+                                          chunk.data,
+                                          chunk.type,
+                                          chunk.N,
+                                          chunk.M);
+                }
+            chunk_name
+                = gsd_find_matching_chunk_name(&m_handle, "compressed/particles/", chunk_name);
+            }
+        }
+
     // close the file
     gsd_close(&m_handle);
     }
@@ -1120,17 +1454,48 @@ void export_GSDDumpWriter(py::module& m)
                       std::string,
                       std::shared_ptr<ParticleGroup>,
                       std::string,
+                      bool,
                       bool>())
         .def("setWriteAttribute", &GSDDumpWriter::setWriteAttribute)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
         .def("writeLogQuantities", &GSDDumpWriter::writeLogQuantities)
+        .def("flush", &GSDDumpWriter::flush)
+        .def_property("asynchronous",
+                      &GSDDumpWriter::getAsynchronous,
+                      &GSDDumpWriter::setAsynchronous)
+        .def_property("incremental",
+                      &GSDDumpWriter::getIncremental,
+                      &GSDDumpWriter::setIncremental)
+        .def_property("max_queue_depth",
+                      &GSDDumpWriter::getMaxQueueDepth,
+                      &GSDDumpWriter::setMaxQueueDepth)
+        .def_property("compress", &GSDDumpWriter::getCompress, &GSDDumpWriter::setCompress)
+        .def_property(
+            "position_precision",
+            [](GSDDumpWriter& gsd) -> py::object
+            {
+                double precision = gsd.getPositionPrecision();
+                return precision > 0 ? py::object(py::float_(precision)) : py::object(py::none());
+            },
+            [](GSDDumpWriter& gsd, py::object precision)
+            { gsd.setPositionPrecision(precision.is_none() ? 0.0 : precision.cast<double>()); })
+        .def_property(
+            "velocity_precision",
+            [](GSDDumpWriter& gsd) -> py::object
+            {
+                double precision = gsd.getVelocityPrecision();
+                return precision > 0 ? py::object(py::float_(precision)) : py::object(py::none());
+            },
+            [](GSDDumpWriter& gsd, py::object precision)
+            { gsd.setVelocityPrecision(precision.is_none() ? 0.0 : precision.cast<double>()); })
         .def_property("log_writer", &GSDDumpWriter::getLogWriter, &GSDDumpWriter::setLogWriter)
         .def_property_readonly("filename", &GSDDumpWriter::getFilename)
         .def_property_readonly("mode", &GSDDumpWriter::getMode)
         .def_property_readonly("dynamic", &GSDDumpWriter::getDynamic)
         .def_property_readonly("truncate", &GSDDumpWriter::getTruncate)
+        .def_property_readonly("shard", &GSDDumpWriter::getShard)
         .def_property_readonly("filter",
                                [](const std::shared_ptr<GSDDumpWriter> gsd)
                                { return gsd->getGroup()->getFilter(); });
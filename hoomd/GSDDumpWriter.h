@@ -8,8 +8,13 @@
 #include "SharedSignal.h"
 
 #include "hoomd/extern/gsd.h"
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -28,6 +33,32 @@
 
     The file is not opened until the first call to analyze().
 
+    In incremental mode, frames after frame 0 omit particle chunks that are identical to the chunks
+    in frame 0, and omit the topology when no bonded groups have been added or removed since frame
+    0. Readers fall back to frame 0 for missing chunks. ParticleData has no signal for changes to
+    particle attributes, so the writer keeps a copy of the frame 0 particle chunks and compares the
+    data. The group number change signals of the bonded group data track changes to the topology,
+    which avoids gathering the bonded groups when they are unchanged.
+
+    In shard mode, each rank writes the group members it owns to its own file (getShardFilename())
+    and no particle data is communicated. Each frame of a shard stores the tags of its particles in
+    particles/tag and all particle chunks, as the number of particles in a shard changes over time.
+    The root rank's shard also stores the topology, log quantities, and the chunks written by the
+    write signal's slots. hoomd.write.GSD.merge_shards() combines the shards into one file.
+
+    In asynchronous mode, analyze() copies the chunks of each frame into a staging buffer and a
+    background I/O thread writes them to the file. Staging buffers are pooled and reused from frame
+    to frame. At most max_queue_depth frames wait to be written, analyze() blocks until there is
+    room in the queue. flush() blocks until all queued frames are in the file. Slots connected to
+    the write signal write to the file handle directly, so analyze() waits for the queue to empty
+    before emitting the signal once any slot has been connected.
+
+    With compression enabled, the particle chunks (except particles/N and particles/types) are
+    stored in the compressed form described in GSDCompression. Positions and velocities are
+    quantized when a precision is set and stored losslessly otherwise. In asynchronous mode, the I/O
+    thread compresses the chunks, so compression does not slow down analyze(). Each staged frame
+    carries a copy of the compression settings in effect when it was staged.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -38,7 +69,8 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
                   const std::string& fname,
                   std::shared_ptr<ParticleGroup> group,
                   std::string mode = "ab",
-                  bool truncate = false);
+                  bool truncate = false,
+                  bool shard = false);
 
     //! Control attribute writes
     void setWriteAttribute(bool b)
@@ -79,6 +111,14 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         return m_truncate;
         }
 
+    bool getShard()
+        {
+        return m_shard;
+        }
+
+    //! Get the file name of the shard that a rank writes
+    static std::string getShardFilename(const std::string& fname, unsigned int rank);
+
     std::shared_ptr<ParticleGroup> getGroup()
         {
         return m_group;
@@ -107,9 +147,70 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
     hoomd::detail::SharedSignal<int(gsd_handle&)>& getWriteSignal()
         {
+        m_write_signal_used = true;
         return m_write_signal;
         }
 
+    //! Write frames in a background thread
+    void setAsynchronous(bool asynchronous);
+
+    //! Get whether frames are written in a background thread
+    bool getAsynchronous()
+        {
+        return m_asynchronous;
+        }
+
+    //! Set the maximum number of frames waiting to be written
+    void setMaxQueueDepth(unsigned int depth);
+
+    //! Get the maximum number of frames waiting to be written
+    unsigned int getMaxQueueDepth()
+        {
+        return m_max_queue_depth;
+        }
+
+    //! Wait for all queued frames to be written to the file
+    void flush();
+
+    //! Omit chunks that are unchanged since frame 0
+    void setIncremental(bool incremental)
+        {
+        m_incremental = incremental;
+        }
+
+    //! Get whether chunks that are unchanged since frame 0 are omitted
+    bool getIncremental()
+        {
+        return m_incremental;
+        }
+
+    //! Compress particle chunks
+    void setCompress(bool compress);
+
+    //! Get whether particle chunks are compressed
+    bool getCompress()
+        {
+        return m_compression.compress;
+        }
+
+    //! Set the quantization precision of positions, 0 for lossless compression
+    void setPositionPrecision(double precision);
+
+    //! Get the quantization precision of positions
+    double getPositionPrecision()
+        {
+        return m_compression.position_precision;
+        }
+
+    //! Set the quantization precision of velocities, 0 for lossless compression
+    void setVelocityPrecision(double precision);
+
+    //! Get the quantization precision of velocities
+    double getVelocityPrecision()
+        {
+        return m_compression.velocity_precision;
+        }
+
     /// Write a logged quantities
     void writeLogQuantities(pybind11::dict dict);
 
@@ -139,15 +240,20 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         }
 
     private:
-    std::string m_fname;    //!< The file name we are writing to
-    std::string m_mode;     //!< The file open mode
-    bool m_truncate;        //!< True if we should truncate the file on every analyze()
-    bool m_is_initialized;  //!< True if the file is open
-    bool m_write_attribute; //!< True if attributes should be written
-    bool m_write_property;  //!< True if properties should be written
-    bool m_write_momentum;  //!< True if momenta should be written
-    bool m_write_topology;  //!< True if topology should be written
-    gsd_handle m_handle;    //!< Handle to the file
+    std::string m_fname;        //!< The file name we are writing to
+    std::string m_mode;         //!< The file open mode
+    bool m_truncate;            //!< True if we should truncate the file on every analyze()
+    bool m_shard;               //!< True if each rank writes its own file
+    std::string m_output_fname; //!< The file this rank writes
+    bool m_is_initialized;      //!< True if the file is open
+    bool m_write_attribute;     //!< True if attributes should be written
+    bool m_write_property;      //!< True if properties should be written
+    bool m_write_momentum;      //!< True if momenta should be written
+    bool m_write_topology;      //!< True if topology should be written
+    gsd_handle m_handle;        //!< Handle to the file
+    uint64_t m_nframes;         //!< Number of frames in the file, including queued frames
+    bool m_incremental;         //!< True if chunks unchanged since frame 0 are omitted
+    bool m_topology_changed;    //!< True if the topology may have changed since frame 0
 
     static std::list<std::string> particle_chunks;
 
@@ -157,8 +263,97 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     std::shared_ptr<ParticleGroup> m_group; //!< Group to write out to the file
     std::map<std::string, bool>
         m_nondefault; //!< Map of quantities (true when non-default in frame 0)
+    std::vector<unsigned int> m_tags; //!< Tags of the particles written in the current frame
 
     hoomd::detail::SharedSignal<int(gsd_handle&)> m_write_signal;
+    bool m_write_signal_used; //!< True when slots may be connected to m_write_signal
+
+    //! A data chunk copied for the I/O thread
+    struct Chunk
+        {
+        std::string name;
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        std::vector<char> data;
+        };
+
+    //! Compression settings
+    struct CompressionSettings
+        {
+        bool compress;             //!< True when particle chunks are compressed
+        double position_precision; //!< Quantization precision of positions, 0 for lossless
+        double velocity_precision; //!< Quantization precision of velocities, 0 for lossless
+        };
+
+    //! A frame staged for the I/O thread
+    struct Frame
+        {
+        bool truncate;                   //!< Truncate the file before writing the frame
+        CompressionSettings compression; //!< Compression settings when the frame was staged
+        std::vector<Chunk> chunks;       //!< Chunk buffers, reused between frames
+        size_t n_chunks;                 //!< Number of chunks in use
+        };
+
+    std::map<std::string, Chunk> m_frame0_chunks;   //!< Particle chunks written in frame 0
+    std::vector<std::string> m_topology_type_names; //!< Bonded group type names in frame 0
+
+    bool m_asynchronous;                              //!< True when writing in the I/O thread
+    unsigned int m_max_queue_depth;                   //!< Maximum number of queued frames
+    std::unique_ptr<Frame> m_staged_frame;            //!< Frame being staged (null if synchronous)
+    std::deque<std::unique_ptr<Frame>> m_queue;       //!< Frames waiting to be written
+    std::vector<std::unique_ptr<Frame>> m_frame_pool; //!< Written frames available for reuse
+    std::thread m_io_thread;                          //!< Thread that writes queued frames
+    std::mutex m_queue_mutex;                         //!< Protects the queue and the pool
+    std::condition_variable m_queue_cv;               //!< Signals changes to the queue
+    bool m_stop_io_thread;                            //!< Set to stop the I/O thread
+    int m_io_error;                                   //!< Error returned in the I/O thread
+
+    CompressionSettings m_compression;         //!< Current compression settings
+    std::vector<char> m_compression_buffer;    //!< Compressed chunk written synchronously
+    std::vector<char> m_io_compression_buffer; //!< Compressed chunk written in the I/O thread
+
+    //! Write a chunk to the file or the staged frame
+    void writeChunk(const char* name, gsd_type type, uint64_t N, uint32_t M, const void* data);
+
+    //! Write a chunk to the file, compressing it when requested
+    int writeFileChunk(const char* name,
+                       gsd_type type,
+                       uint64_t N,
+                       uint32_t M,
+                       const void* data,
+                       const CompressionSettings& compression,
+                       std::vector<char>& buffer);
+
+    //! Test whether incremental frames may omit a chunk
+    static bool isIncrementalChunk(const char* name);
+
+    //! Get the type names of all bonded groups
+    std::vector<std::string> getTopologyTypeNames();
+
+    //! Test whether the topology changed since frame 0
+    bool topologyChanged();
+
+    //! Flag a change to the topology
+    void slotTopologyChanged()
+        {
+        m_topology_changed = true;
+        }
+
+    //! Start staging a frame for the I/O thread
+    void beginStagedFrame();
+
+    //! Add the staged frame to the queue
+    void queueStagedFrame();
+
+    //! Wait until the queue holds at most depth frames
+    void waitForQueue(unsigned int depth);
+
+    //! Body of the I/O thread
+    void ioThread();
+
+    //! Write the queued frames and join the I/O thread
+    void stopIOThread();
 
     //! Write a type mapping out to the file
     void writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping);
@@ -166,6 +361,9 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     //! Initializes the output file for writing
     void initFileIO();
 
+    //! Set the tags of the particles to write in this frame
+    void populateTags();
+
     //! Write frame header
     void writeFrameHeader(uint64_t timestep);
 
@@ -4,10 +4,13 @@
 #include "GSDReader.h"
 #include "ExecutionConfiguration.h"
 #include "GSD.h"
+#include "GSDCompression.h"
 #include "SnapshotSystemData.h"
 #include "hoomd/extern/gsd.h"
+#include <algorithm>
 #include <sstream>
 #include <string.h>
+#include <unistd.h>
 
 #include <stdexcept>
 using namespace std;
@@ -15,10 +18,283 @@ using namespace hoomd::detail;
 
 namespace py = pybind11;
 
+namespace
+    {
+//! Read and decompress a compressed per particle chunk
+/*! \param handle Handle to the open file
+    \param fname File name, for error messages
+    \param entry Entry of the compressed chunk
+    \param name Name of the data chunk
+    \param element_size Expected size of one element in bytes
+    \param N Number of particles in the frame
+    \param chunk Set to the decompressed chunk
+
+    \returns false when the chunk does not have N elements
+*/
+bool readCompressedChunk(gsd_handle& handle,
+                         const std::string& fname,
+                         const struct gsd_index_entry* entry,
+                         const char* name,
+                         size_t element_size,
+                         unsigned int N,
+                         std::vector<char>& chunk)
+    {
+    gsd_type type;
+    uint64_t chunk_N;
+    uint32_t chunk_M;
+    GSDCompression::readChunk(handle, entry, fname, chunk, type, chunk_N, chunk_M);
+    if (chunk_N != N)
+        return false;
+
+    size_t actual_size = chunk_M * gsd_sizeof_type(type);
+    if (actual_size != element_size)
+        {
+        ostringstream s;
+        s << "Expecting " << element_size << " bytes per particle in " << name << " but found "
+          << actual_size << " in " << fname;
+        throw runtime_error(s.str());
+        }
+    return true;
+    }
+
+//! Read the elements [first, first + count) of a per particle chunk
+/*! \param handle Handle to the open file
+    \param fname File name, for error messages
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param data Pointer to data to read into
+    \param element_size Expected size of one element in bytes
+    \param N Number of particles in the frame
+    \param first Index of the first element to read
+    \param count Number of elements to read
+
+    Follows the same rules as GSDReader::readChunk(): a chunk missing from the frame is read from
+    frame 0, and a chunk that is missing or does not have N elements leaves the defaults in place.
+    GSD stores chunks uncompressed, so the range is read directly from its offset in the file.
+    Compressed chunks (see GSDCompression) are read whole and the range copied out.
+
+    \returns true if data is actually read from the file
+*/
+bool readChunkRange(gsd_handle& handle,
+                    const std::string& fname,
+                    uint64_t frame,
+                    const char* name,
+                    void* data,
+                    size_t element_size,
+                    unsigned int N,
+                    uint64_t first,
+                    uint64_t count)
+    {
+    bool compressed;
+    const struct gsd_index_entry* entry
+        = GSDCompression::findChunk(handle, frame, name, compressed);
+    if (entry != NULL && compressed)
+        {
+        std::vector<char> chunk;
+        if (!readCompressedChunk(handle, fname, entry, name, element_size, N, chunk))
+            return false;
+        if (count > 0)
+            memcpy(data, chunk.data() + first * element_size, count * element_size);
+        return true;
+        }
+
+    if (entry == NULL || entry->N != N)
+        return false;
+
+    size_t actual_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != element_size)
+        {
+        ostringstream s;
+        s << "Expecting " << element_size << " bytes per particle in " << name << " but found "
+          << actual_size << " in " << fname;
+        throw runtime_error(s.str());
+        }
+
+    char* ptr = static_cast<char*>(data);
+    size_t remaining = count * element_size;
+    int64_t offset = entry->location + int64_t(first * element_size);
+    while (remaining > 0)
+        {
+        ssize_t bytes = ::pread(handle.fd, ptr, remaining, offset);
+        if (bytes <= 0)
+            throw runtime_error("Error reading " + string(name) + " from " + fname);
+        ptr += bytes;
+        remaining -= bytes;
+        offset += bytes;
+        }
+
+    return true;
+    }
+
+#ifdef ENABLE_MPI
+//! Find the particles in the domain of each rank
+/*! \param indices Indices of the particles read by this rank, replaced by the sorted indices of
+           the particles in its domain
+    \param pos Positions of the particles read by this rank
+    \param global_box The global simulation box
+    \param decomposition The domain decomposition
+    \param mpi_comm The MPI communicator
+
+    Only the particle indices are communicated.
+*/
+void exchangeIndices(std::vector<unsigned int>& indices,
+                     const std::vector<Scalar3>& pos,
+                     const BoxDim& global_box,
+                     std::shared_ptr<DomainDecomposition> decomposition,
+                     const MPI_Comm mpi_comm)
+    {
+    int n_ranks;
+    MPI_Comm_size(mpi_comm, &n_ranks);
+
+    // determine the destination of every particle
+    std::vector<unsigned int> dest(indices.size());
+    std::vector<int> send_counts(n_ranks, 0);
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+        for (size_t i = 0; i < indices.size(); i++)
+            {
+            dest[i] = decomposition->placeParticle(global_box, pos[i], h_cart_ranks.data);
+            send_counts[dest[i]]++;
+            }
+        }
+
+    // order the indices by destination
+    std::vector<int> send_displs(n_ranks, 0);
+    for (int r = 1; r < n_ranks; r++)
+        send_displs[r] = send_displs[r - 1] + send_counts[r - 1];
+
+    std::vector<unsigned int> send_buf(indices.size());
+    std::vector<int> offset(send_displs);
+    for (size_t i = 0; i < indices.size(); i++)
+        send_buf[offset[dest[i]]++] = indices[i];
+
+    std::vector<int> recv_counts(n_ranks, 0);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    std::vector<int> recv_displs(n_ranks, 0);
+    for (int r = 1; r < n_ranks; r++)
+        recv_displs[r] = recv_displs[r - 1] + recv_counts[r - 1];
+
+    indices.resize(recv_displs[n_ranks - 1] + recv_counts[n_ranks - 1]);
+    MPI_Alltoallv(send_buf.data(),
+                  send_counts.data(),
+                  send_displs.data(),
+                  MPI_UNSIGNED,
+                  indices.data(),
+                  recv_counts.data(),
+                  recv_displs.data(),
+                  MPI_UNSIGNED,
+                  mpi_comm);
+
+    std::sort(indices.begin(), indices.end());
+    }
+
+//! Read the elements at the given indices of a per particle chunk with collective MPI-IO
+/*! \param fh The file, opened on all ranks of the communicator
+    \param handle Handle to the open file
+    \param fname File name, for error messages
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param data Pointer to data to read into
+    \param element_size Expected size of one element in bytes
+    \param N Number of particles in the frame
+    \param indices Sorted indices of the elements to read on this rank
+
+    Collective call, follows the same rules as readChunkRange(). Runs of consecutive indices are
+    read as one block, and the MPI library combines the requests of all ranks into large
+    contiguous reads. Every rank reads compressed chunks whole, without collective I/O.
+
+    \returns true if data is actually read from the file
+*/
+bool readChunkIndices(MPI_File fh,
+                      gsd_handle& handle,
+                      const std::string& fname,
+                      uint64_t frame,
+                      const char* name,
+                      void* data,
+                      size_t element_size,
+                      unsigned int N,
+                      const std::vector<unsigned int>& indices)
+    {
+    bool compressed;
+    const struct gsd_index_entry* entry
+        = GSDCompression::findChunk(handle, frame, name, compressed);
+    if (entry != NULL && compressed)
+        {
+        std::vector<char> chunk;
+        if (!readCompressedChunk(handle, fname, entry, name, element_size, N, chunk))
+            return false;
+        char* ptr = static_cast<char*>(data);
+        for (size_t i = 0; i < indices.size(); i++)
+            memcpy(ptr + i * element_size, chunk.data() + indices[i] * element_size, element_size);
+        return true;
+        }
+
+    if (entry == NULL || entry->N != N)
+        return false;
+
+    size_t actual_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != element_size)
+        {
+        ostringstream s;
+        s << "Expecting " << element_size << " bytes per particle in " << name << " but found "
+          << actual_size << " in " << fname;
+        throw runtime_error(s.str());
+        }
+
+    // blocks of consecutive elements, in units of elements
+    std::vector<int> block_lengths;
+    std::vector<MPI_Aint> block_displs;
+    for (size_t i = 0; i < indices.size(); i++)
+        {
+        if (i > 0 && indices[i] == indices[i - 1] + 1)
+            block_lengths.back()++;
+        else
+            {
+            block_lengths.push_back(1);
+            block_displs.push_back(MPI_Aint(indices[i]) * MPI_Aint(element_size));
+            }
+        }
+
+    MPI_Datatype element_type, file_type;
+    MPI_Type_contiguous(int(element_size), MPI_BYTE, &element_type);
+    MPI_Type_commit(&element_type);
+    MPI_Type_create_hindexed(int(block_lengths.size()),
+                             block_lengths.data(),
+                             block_displs.data(),
+                             element_type,
+                             &file_type);
+    MPI_Type_commit(&file_type);
+
+    char datarep[] = "native";
+    int retval = MPI_File_set_view(fh,
+                                   MPI_Offset(entry->location),
+                                   element_type,
+                                   file_type,
+                                   datarep,
+                                   MPI_INFO_NULL);
+    MPI_Status status;
+    if (retval == MPI_SUCCESS)
+        retval = MPI_File_read_all(fh, data, int(indices.size()), element_type, &status);
+
+    MPI_Type_free(&file_type);
+    MPI_Type_free(&element_type);
+
+    if (retval != MPI_SUCCESS)
+        throw runtime_error("Error reading " + string(name) + " from " + fname);
+
+    return true;
+    }
+#endif
+    } // end anonymous namespace
+
 /*! \param exec_conf The execution configuration
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Leave the particles in the file for readLocal()
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file
    into memory (on the root rank).
@@ -26,8 +302,10 @@ namespace py = pybind11;
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string& name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame),
+      m_distributed(distributed), m_N(0)
     {
     m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
 
@@ -73,8 +351,30 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
-    readParticles();
-    readTopology();
+    if (m_distributed)
+        {
+        // keep the type names and move the bonded groups aside, readLocal() reads the rest
+        m_N = m_snapshot->particle_data.size;
+        m_snapshot->particle_data.resize(0);
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+
+        readTopology();
+        m_topology = m_snapshot;
+        m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
+        m_snapshot->dimensions = m_topology->dimensions;
+        m_snapshot->global_box = m_topology->global_box;
+        m_snapshot->particle_data.type_mapping = m_topology->particle_data.type_mapping;
+        m_snapshot->bond_data.type_mapping = m_topology->bond_data.type_mapping;
+        m_snapshot->angle_data.type_mapping = m_topology->angle_data.type_mapping;
+        m_snapshot->dihedral_data.type_mapping = m_topology->dihedral_data.type_mapping;
+        m_snapshot->improper_data.type_mapping = m_topology->improper_data.type_mapping;
+        m_snapshot->pair_data.type_mapping = m_topology->pair_data.type_mapping;
+        }
+    else
+        {
+        readParticles();
+        readTopology();
+        }
     }
 
 GSDReader::~GSDReader()
@@ -110,9 +410,31 @@ bool GSDReader::readChunk(void* data,
                           size_t expected_size,
                           unsigned int cur_n)
     {
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
-    if (entry == NULL && frame != 0)
-        entry = gsd_find_chunk(&m_handle, 0, name);
+    bool compressed;
+    const struct gsd_index_entry* entry
+        = GSDCompression::findChunk(m_handle, frame, name, compressed);
+
+    if (entry != NULL && compressed)
+        {
+        m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading compressed chunk " << name
+                                    << endl;
+        std::vector<char> chunk;
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        GSDCompression::readChunk(m_handle, entry, m_name, chunk, type, N, M);
+        if (cur_n != 0 && N != cur_n)
+            return false;
+        if (chunk.size() != expected_size)
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: "
+                                      << "Expecting " << expected_size << " bytes in " << name
+                                      << " but found " << chunk.size() << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+        memcpy(data, chunk.data(), expected_size);
+        return true;
+        }
 
     if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
         {
@@ -307,6 +629,243 @@ void GSDReader::readTopology()
         }
     }
 
+/*! \param sysdef System definition to read into, initialized from the snapshot of a distributed
+           reader
+
+    Collective call. In a first pass, rank r of P reads the positions of the particles with the
+    indices N*r/P to N*(r+1)/P - 1 of the frame and the ranks exchange the indices of the particles
+    so that each rank knows the particles in its domain. Each rank then reads only the elements of
+    its particles from every per particle chunk with collective MPI-IO. The particle index becomes
+    the tag, as in the initialization from a snapshot. The topology is broadcast from the root rank.
+*/
+void GSDReader::readLocal(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    if (!m_distributed)
+        {
+        throw runtime_error("GSDReader::readLocal requires a distributed reader");
+        }
+
+    uint64_t frame = m_frame;
+    unsigned int N = m_N;
+    unsigned int rank = m_exec_conf->getRank();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+#ifdef ENABLE_MPI
+    if (n_ranks > 1)
+        {
+        bcast(frame, 0, m_exec_conf->getMPICommunicator());
+        bcast(N, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    uint64_t first = uint64_t(N) * rank / n_ranks;
+    uint64_t count = uint64_t(N) * (rank + 1) / n_ranks - first;
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const BoxDim global_box = pdata->getGlobalBox();
+    unsigned int n_types = pdata->getNTypes();
+#ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+#endif
+
+    // stop on all ranks when any rank failed
+    auto check_error = [this, n_ranks](const std::string& error)
+    {
+        int failed = !error.empty();
+#ifdef ENABLE_MPI
+        if (n_ranks > 1)
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &failed,
+                          1,
+                          MPI_INT,
+                          MPI_MAX,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+        if (failed)
+            {
+            if (!error.empty())
+                m_exec_conf->msg->error() << "data.gsd_snapshot: " << error << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+    };
+
+    gsd_handle handle;
+    std::string error;
+    try
+        {
+        int retval = gsd_open(&handle, m_name.c_str(), GSD_OPEN_READONLY);
+        GSDUtils::checkError(retval, m_name);
+        }
+    catch (const std::exception& e)
+        {
+        error = e.what();
+        }
+    check_error(error);
+
+    // indices of the particles in the local domain, the first pass reads the positions
+    std::vector<unsigned int> indices(count);
+    for (uint64_t i = 0; i < count; i++)
+        indices[i] = (unsigned int)(first + i);
+
+#ifdef ENABLE_MPI
+    MPI_File fh = MPI_FILE_NULL;
+    if (decomposition)
+        {
+        std::vector<Scalar3> positions(count);
+        try
+            {
+            std::vector<float> pos(count * 3, 0.0f);
+            readChunkRange(handle,
+                           m_name,
+                           frame,
+                           "particles/position",
+                           pos.data(),
+                           12,
+                           N,
+                           first,
+                           count);
+            for (uint64_t i = 0; i < count; i++)
+                {
+                positions[i] = make_scalar3(pos[i * 3], pos[i * 3 + 1], pos[i * 3 + 2]);
+                int3 img = make_int3(0, 0, 0);
+                global_box.wrap(positions[i], img);
+                }
+            }
+        catch (const std::exception& e)
+            {
+            error = e.what();
+            }
+        if (!error.empty())
+            gsd_close(&handle);
+        check_error(error);
+
+        exchangeIndices(indices,
+                        positions,
+                        global_box,
+                        decomposition,
+                        m_exec_conf->getMPICommunicator());
+
+        std::vector<char> fname(m_name.begin(), m_name.end());
+        fname.push_back(0);
+        if (MPI_File_open(m_exec_conf->getMPICommunicator(),
+                          fname.data(),
+                          MPI_MODE_RDONLY,
+                          MPI_INFO_NULL,
+                          &fh)
+            != MPI_SUCCESS)
+            {
+            error = "Error opening " + m_name + " with MPI-IO";
+            }
+        if (!error.empty())
+            gsd_close(&handle);
+        check_error(error);
+        }
+#endif
+
+    size_t n_local = indices.size();
+    std::vector<pdata_element> particles(n_local);
+    try
+        {
+        // defaults per the GSD HOOMD schema
+        std::vector<uint32_t> type(n_local, 0);
+        std::vector<float> mass(n_local, 1.0f);
+        std::vector<float> charge(n_local, 0.0f);
+        std::vector<float> diameter(n_local, 1.0f);
+        std::vector<int32_t> body(n_local, -1);
+        std::vector<float> inertia(n_local * 3, 0.0f);
+        std::vector<float> pos(n_local * 3, 0.0f);
+        std::vector<float> orientation(n_local * 4, 0.0f);
+        std::vector<float> vel(n_local * 3, 0.0f);
+        std::vector<float> angmom(n_local * 4, 0.0f);
+        std::vector<int32_t> image(n_local * 3, 0);
+        for (size_t i = 0; i < n_local; i++)
+            orientation[i * 4] = 1.0f;
+
+        // every rank reads the same chunks, so the collective reads match up
+        auto read = [&](const char* name, void* data, size_t element_size)
+        {
+#ifdef ENABLE_MPI
+            if (fh != MPI_FILE_NULL)
+                {
+                readChunkIndices(fh, handle, m_name, frame, name, data, element_size, N, indices);
+                return;
+                }
+#endif
+            readChunkRange(handle, m_name, frame, name, data, element_size, N, first, count);
+        };
+
+        read("particles/typeid", type.data(), 4);
+        read("particles/mass", mass.data(), 4);
+        read("particles/charge", charge.data(), 4);
+        read("particles/diameter", diameter.data(), 4);
+        read("particles/body", body.data(), 4);
+        read("particles/moment_inertia", inertia.data(), 12);
+        read("particles/position", pos.data(), 12);
+        read("particles/orientation", orientation.data(), 16);
+        read("particles/velocity", vel.data(), 12);
+        read("particles/angmom", angmom.data(), 16);
+        read("particles/image", image.data(), 12);
+
+        for (size_t i = 0; i < n_local; i++)
+            {
+            if (type[i] >= n_types)
+                {
+                ostringstream s;
+                s << "Particle typeid " << type[i] << " is invalid in a system with " << n_types
+                  << " types.";
+                throw runtime_error(s.str());
+                }
+
+            Scalar3 p = make_scalar3(pos[i * 3], pos[i * 3 + 1], pos[i * 3 + 2]);
+            int3 img = make_int3(image[i * 3], image[i * 3 + 1], image[i * 3 + 2]);
+            global_box.wrap(p, img);
+
+            pdata_element& element = particles[i];
+            element.pos = make_scalar4(p.x, p.y, p.z, __int_as_scalar(type[i]));
+            element.vel = make_scalar4(vel[i * 3], vel[i * 3 + 1], vel[i * 3 + 2], mass[i]);
+            element.charge = charge[i];
+            element.diameter = diameter[i];
+            element.image = img;
+            element.body = (unsigned int)body[i];
+            element.orientation = make_scalar4(orientation[i * 4],
+                                               orientation[i * 4 + 1],
+                                               orientation[i * 4 + 2],
+                                               orientation[i * 4 + 3]);
+            element.angmom = make_scalar4(angmom[i * 4],
+                                          angmom[i * 4 + 1],
+                                          angmom[i * 4 + 2],
+                                          angmom[i * 4 + 3]);
+            element.inertia = make_scalar3(inertia[i * 3], inertia[i * 3 + 1], inertia[i * 3 + 2]);
+            element.tag = indices[i];
+            }
+        }
+    catch (const std::exception& e)
+        {
+        error = e.what();
+        }
+
+#ifdef ENABLE_MPI
+    if (fh != MPI_FILE_NULL)
+        MPI_File_close(&fh);
+#endif
+    gsd_close(&handle);
+    check_error(error);
+
+    pdata->initializeFromLocalParticles(particles, N, false);
+
+    // the topology is broadcast from the root rank, each rank keeps the groups of its particles
+    if (!m_topology)
+        m_topology = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
+    sysdef->getBondData()->initializeFromSnapshot(m_topology->bond_data);
+    sysdef->getAngleData()->initializeFromSnapshot(m_topology->angle_data);
+    sysdef->getDihedralData()->initializeFromSnapshot(m_topology->dihedral_data);
+    sysdef->getImproperData()->initializeFromSnapshot(m_topology->improper_data);
+    sysdef->getConstraintData()->initializeFromSnapshot(m_topology->constraint_data);
+    sysdef->getPairData()->initializeFromSnapshot(m_topology->pair_data);
+    m_topology.reset();
+    }
+
 pybind11::list GSDReader::readTypeShapesPy(uint64_t frame)
     {
     std::vector<std::string> type_mapping = this->readTypes(frame, "particles/type_shapes");
@@ -388,70 +947,122 @@ std::vector<std::string> GSDStateReader::getAvailableChunks(const std::string& b
     return result;
     }
 
-pybind11::array GSDStateReader::readChunk(const std::string& name)
+/*! \param name Name of the chunk
+    \param compressed Set to true when the chunk is compressed (see GSDCompression)
+
+    \returns The entry of the chunk in the current frame, or in frame 0 if it is not present in the
+    current frame
+*/
+const struct gsd_index_entry* GSDStateReader::findChunk(const std::string& name, bool& compressed)
     {
-    pybind11::array result;
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name.c_str());
-    if (entry == NULL && m_frame != 0)
-        {
-        entry = gsd_find_chunk(&m_handle, 0, name.c_str());
-        }
+    const struct gsd_index_entry* entry
+        = GSDCompression::findChunk(m_handle, m_frame, name.c_str(), compressed);
     if (entry == NULL)
         {
         throw runtime_error("Could not find GSD chunk: " + name);
         }
+    return entry;
+    }
 
-    std::vector<size_t> dims;
-    dims.push_back(entry->N);
-    if (entry->M > 1)
-        {
-        dims.push_back(entry->M);
-        }
+/*! \param type GSD type id
 
-    if (entry->type == GSD_TYPE_UINT8)
+    \returns The numpy dtype of the GSD type
+*/
+pybind11::dtype GSDStateReader::getDtype(uint8_t type)
+    {
+    if (type == GSD_TYPE_UINT8)
         {
-        result = pybind11::array(pybind11::dtype::of<uint8_t>(), dims);
+        return pybind11::dtype::of<uint8_t>();
         }
-    else if (entry->type == GSD_TYPE_UINT16)
+    else if (type == GSD_TYPE_UINT16)
         {
-        result = pybind11::array(pybind11::dtype::of<uint16_t>(), dims);
+        return pybind11::dtype::of<uint16_t>();
         }
-    else if (entry->type == GSD_TYPE_UINT32)
+    else if (type == GSD_TYPE_UINT32)
         {
-        result = pybind11::array(pybind11::dtype::of<uint32_t>(), dims);
+        return pybind11::dtype::of<uint32_t>();
         }
-    else if (entry->type == GSD_TYPE_UINT64)
+    else if (type == GSD_TYPE_UINT64)
         {
-        result = pybind11::array(pybind11::dtype::of<uint64_t>(), dims);
+        return pybind11::dtype::of<uint64_t>();
         }
-    else if (entry->type == GSD_TYPE_INT8)
+    else if (type == GSD_TYPE_INT8)
         {
-        result = pybind11::array(pybind11::dtype::of<int8_t>(), dims);
+        return pybind11::dtype::of<int8_t>();
         }
-    else if (entry->type == GSD_TYPE_INT16)
+    else if (type == GSD_TYPE_INT16)
         {
-        result = pybind11::array(pybind11::dtype::of<int16_t>(), dims);
+        return pybind11::dtype::of<int16_t>();
         }
-    else if (entry->type == GSD_TYPE_INT32)
+    else if (type == GSD_TYPE_INT32)
         {
-        result = pybind11::array(pybind11::dtype::of<int32_t>(), dims);
+        return pybind11::dtype::of<int32_t>();
         }
-    else if (entry->type == GSD_TYPE_INT64)
+    else if (type == GSD_TYPE_INT64)
         {
-        result = pybind11::array(pybind11::dtype::of<int64_t>(), dims);
+        return pybind11::dtype::of<int64_t>();
         }
-    else if (entry->type == GSD_TYPE_FLOAT)
+    else if (type == GSD_TYPE_FLOAT)
         {
-        result = pybind11::array(pybind11::dtype::of<float>(), dims);
+        return pybind11::dtype::of<float>();
         }
-    else if (entry->type == GSD_TYPE_DOUBLE)
+    else if (type == GSD_TYPE_DOUBLE)
         {
-        result = pybind11::array(pybind11::dtype::of<double>(), dims);
+        return pybind11::dtype::of<double>();
         }
     else
         {
         throw runtime_error("Invalid GSD type");
         }
+    }
+
+//! Get the shape of the numpy array that holds a chunk
+static std::vector<size_t> chunk_shape(const struct gsd_index_entry* entry)
+    {
+    std::vector<size_t> dims;
+    dims.push_back(entry->N);
+    if (entry->M > 1)
+        {
+        dims.push_back(entry->M);
+        }
+    return dims;
+    }
+
+/*! \param entry Entry of the compressed chunk
+
+    \returns A numpy array with the decompressed chunk
+*/
+pybind11::array GSDStateReader::readCompressedChunk(const struct gsd_index_entry* entry)
+    {
+    std::vector<char> data;
+    gsd_type type;
+    uint64_t N;
+    uint32_t M;
+    GSDCompression::readChunk(m_handle, entry, m_name, data, type, N, M);
+
+    std::vector<size_t> dims;
+    dims.push_back(N);
+    if (M > 1)
+        {
+        dims.push_back(M);
+        }
+
+    pybind11::array result(getDtype(type), dims);
+    if (!data.empty())
+        memcpy(result.mutable_data(), data.data(), data.size());
+    return result;
+    }
+
+pybind11::array GSDStateReader::readChunk(const std::string& name)
+    {
+    bool compressed;
+    const struct gsd_index_entry* entry = findChunk(name, compressed);
+    if (compressed)
+        {
+        return readCompressedChunk(entry);
+        }
+
+    pybind11::array result(getDtype(entry->type), chunk_shape(entry));
 
     int retval = gsd_read_chunk(&m_handle, result.mutable_data(), entry);
     GSDUtils::checkError(retval, m_name);
@@ -459,20 +1070,63 @@ pybind11::array GSDStateReader::readChunk(const std::string& name)
     return result;
     }
 
+/*! \param name Name of the chunk
+
+    \returns A read only numpy array that views the chunk mapped into memory
+
+    The data is not copied. The mapping is released when the array and all views of it are deleted,
+    which may be after the reader is deleted. Compressed chunks are decompressed into a new array.
+*/
+pybind11::array GSDStateReader::mapChunk(const std::string& name)
+    {
+    bool compressed;
+    const struct gsd_index_entry* entry = findChunk(name, compressed);
+    if (compressed)
+        {
+        pybind11::array result = readCompressedChunk(entry);
+        result.attr("flags").attr("writeable") = false;
+        return result;
+        }
+    pybind11::dtype dtype = getDtype(entry->type);
+
+    gsd_chunk_map* map = new gsd_chunk_map;
+    int retval = gsd_map_chunk(&m_handle, entry, map);
+    if (retval != GSD_SUCCESS)
+        {
+        delete map;
+        GSDUtils::checkError(retval, m_name);
+        }
+
+    pybind11::capsule owner(map,
+                            [](void* ptr)
+                            {
+                                gsd_chunk_map* map = static_cast<gsd_chunk_map*>(ptr);
+                                gsd_unmap_chunk(map);
+                                delete map;
+                            });
+
+    pybind11::array result(dtype, chunk_shape(entry), map->data, owner);
+    result.attr("flags").attr("writeable") = false;
+    return result;
+    }
+
 void export_GSDReader(py::module& m)
     {
     py::class_<GSDReader, std::shared_ptr<GSDReader>>(m, "GSDReader")
         .def(py::init<std::shared_ptr<const ExecutionConfiguration>,
                       const string&,
                       const uint64_t,
+                      bool,
                       bool>())
         .def("getTimeStep", &GSDReader::getTimeStep)
         .def("getSnapshot", &GSDReader::getSnapshot)
         .def("clearSnapshot", &GSDReader::clearSnapshot)
-        .def("readTypeShapesPy", &GSDReader::readTypeShapesPy);
+        .def("readTypeShapesPy", &GSDReader::readTypeShapesPy)
+        .def("readLocal", &GSDReader::readLocal);
 
     py::class_<GSDStateReader, std::shared_ptr<GSDStateReader>>(m, "GSDStateReader")
         .def(py::init<const std::string&, int64_t>())
         .def("getAvailableChunks", &GSDStateReader::getAvailableChunks)
-        .def("readChunk", &GSDStateReader::readChunk);
+        .def("readChunk", &GSDStateReader::readChunk)
+        .def("mapChunk", &GSDStateReader::mapChunk);
     }
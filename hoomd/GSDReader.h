@@ -6,6 +6,7 @@
 #endif
 
 #include "ParticleData.h"
+#include "SystemDefinition.h"
 #include "hoomd/extern/gsd.h"
 #include <string>
 
@@ -22,6 +23,13 @@ template<class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    By default, the root rank reads the frame into a complete snapshot. With \a distributed, the
+    root rank reads only the box, the type names, and the topology, and getSnapshot() returns a
+    snapshot without particles or bonded groups that sets up the domain decomposition. The
+    collective readLocal() then reads the particles into the system: a first pass over the
+    positions assigns the particles to domains, and each rank then reads only the elements of its
+    own particles from every chunk with MPI-IO, so no rank ever holds all of the particles.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -31,7 +39,8 @@ class PYBIND11_EXPORT GSDReader
     GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
               const std::string& name,
               const uint64_t frame,
-              bool from_end);
+              bool from_end,
+              bool distributed = false);
 
     //! Destructor
     ~GSDReader();
@@ -83,6 +92,9 @@ class PYBIND11_EXPORT GSDReader
 
     pybind11::list readTypeShapesPy(uint64_t frame);
 
+    //! Read the particles of the frame in parallel and the topology into the system
+    void readLocal(std::shared_ptr<SystemDefinition> sysdef);
+
     private:
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
     uint64_t m_timestep;                                       //!< Timestep at the selected frame
@@ -90,6 +102,11 @@ class PYBIND11_EXPORT GSDReader
     uint64_t m_frame;                                          //!< Cached frame
     std::shared_ptr<SnapshotSystemData<float>> m_snapshot;     //!< The snapshot to read
     gsd_handle m_handle;                                       //!< Handle to the file
+    bool m_distributed;                                        //!< Ranks read their own particles
+    unsigned int m_N;                                          //!< Number of particles in the frame
+
+    //! Topology of the frame when distributed, only on the root rank
+    std::shared_ptr<SnapshotSystemData<float>> m_topology;
 
     //! Helper function to read a type list from the file
     std::vector<std::string> readTypes(uint64_t frame, const char* name);
@@ -103,7 +120,7 @@ class PYBIND11_EXPORT GSDReader
 /** Read state information from a GSD file
 
     GSDStateReader provides an interface for ``from_state`` methods to discover and read state data
-    from a GSD file.
+    from a GSD file. mapChunk() provides zero copy access to large chunks for analysis.
 */
 class PYBIND11_EXPORT GSDStateReader
     {
@@ -124,6 +141,9 @@ class PYBIND11_EXPORT GSDStateReader
     /// Read a chunk and return as a numpy array
     pybind11::array readChunk(const std::string& name);
 
+    /// Map a chunk into memory and return a read only numpy array that views it
+    pybind11::array mapChunk(const std::string& name);
+
     private:
     /// Store the filename
     std::string m_name;
@@ -133,6 +153,15 @@ class PYBIND11_EXPORT GSDStateReader
 
     /// Handle to the file
     gsd_handle m_handle;
+
+    /// Find a chunk, in either form, in the frame or in frame 0
+    const struct gsd_index_entry* findChunk(const std::string& name, bool& compressed);
+
+    /// Read and decompress a compressed chunk
+    pybind11::array readCompressedChunk(const struct gsd_index_entry* entry);
+
+    /// Get the numpy dtype of a GSD type
+    static pybind11::dtype getDtype(uint8_t type);
     };
 
 /// Exports GSDReader and GSDStateReader to python
@@ -5,8 +5,10 @@
 #include "GetarDumpIterators.h"
 #include "ParticleData.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
+#include <numeric>
 
 namespace py = pybind11;
 
@@ -46,7 +48,7 @@ template<typename T> T lcm(T x, T y)
     return x * y / gcd<T>(x, y);
     }
 
-// return true if a prop needs particle data snapshots
+// return true if a prop needs the given part of the system snapshot
 bool needSnapshot(NeedSnapshotIdx idx, Property prop)
     {
     switch (idx)
@@ -60,6 +62,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedPData:
         switch (prop)
             {
@@ -79,6 +82,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedBond:
         switch (prop)
             {
@@ -89,6 +93,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedAngle:
         switch (prop)
             {
@@ -99,6 +104,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedDihedral:
         switch (prop)
             {
@@ -109,6 +115,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedImproper:
         switch (prop)
             {
@@ -119,6 +126,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedPair:
         switch (prop)
             {
@@ -129,6 +137,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedRigid:
         switch (prop)
             {
@@ -140,6 +149,7 @@ bool needSnapshot(NeedSnapshotIdx idx, Property prop)
         default:
             break;
             }
+        break;
     case NeedIntegrator:
         switch (prop)
             {
@@ -295,7 +305,8 @@ GetarDumpWriter::GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                                  unsigned int offset)
     : Analyzer(sysdef), m_archive(), m_periods(), m_offset(offset), m_staticRecords(),
       m_operationMode(operationMode), m_filename(filename), m_tempName(), m_systemSnap(),
-      m_neededSnapshots()
+      m_neededSnapshots(), m_staticSnapshots(), m_asynchronous(false), m_maxQueueDepth(2),
+      m_stopIOThread(false)
     {
     if (m_operationMode == getardump::OneShot)
         {
@@ -324,19 +335,191 @@ GetarDumpWriter::GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     m_systemSnap = takeSystemSnapshot(m_sysdef);
     }
 
-GetarDumpWriter::~GetarDumpWriter() { }
+GetarDumpWriter::~GetarDumpWriter()
+    {
+    stopIOThread();
+    }
 
 void GetarDumpWriter::close()
     {
+    flush();
     if (m_archive)
         m_archive->close();
     }
 
+// Block until the I/O thread has written all queued frames, rethrow its errors
+void GetarDumpWriter::flush()
+    {
+    if (m_ioThread.joinable())
+        waitForQueue(0);
+    }
+
+// Writes all queued frames when switching to synchronous mode
+void GetarDumpWriter::setAsynchronous(bool asynchronous)
+    {
+    if (!asynchronous)
+        {
+        stopIOThread();
+        std::exception_ptr error(m_ioError);
+        m_ioError = nullptr;
+        if (error)
+            std::rethrow_exception(error);
+        }
+    m_asynchronous = asynchronous;
+    }
+
+void GetarDumpWriter::setMaxQueueDepth(unsigned int depth)
+    {
+    if (depth == 0)
+        throw std::invalid_argument("GetarDumpWriter: max queue depth must be positive");
+    m_maxQueueDepth = depth;
+    }
+
+// Rethrows any error encountered by the I/O thread
+void GetarDumpWriter::waitForQueue(unsigned int depth)
+    {
+    std::exception_ptr error;
+        {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_queueCV.wait(lock, [this, depth] { return m_queue.size() <= depth || m_ioError; });
+        error = m_ioError;
+        m_ioError = nullptr;
+        }
+    if (error)
+        std::rethrow_exception(error);
+    }
+
+// Write queued frames to the archive in order until stopped. Frames are
+// removed from the queue only after they are written so that
+// waitForQueue() guarantees the archive is up to date.
+void GetarDumpWriter::ioThread()
+    {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    while (true)
+        {
+        m_queueCV.wait(lock, [this] { return !m_queue.empty() || m_stopIOThread; });
+        if (m_queue.empty())
+            return;
+
+        const Frame& frame = *m_queue.front();
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+            {
+            writeFrame(frame);
+            }
+        catch (...)
+            {
+            error = std::current_exception();
+            }
+
+        lock.lock();
+        if (error)
+            m_ioError = error;
+        m_queue.pop_front();
+        m_queueCV.notify_all();
+        }
+    }
+
+void GetarDumpWriter::stopIOThread()
+    {
+    if (m_ioThread.joinable())
+        {
+            {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_stopIOThread = true;
+            }
+        m_queueCV.notify_all();
+        m_ioThread.join();
+        m_stopIOThread = false;
+        }
+    }
+
+// Take only the parts of the system snapshot that are needed. Collective
+// call, every rank needs the same parts.
+shared_ptr<SystemSnapshot> GetarDumpWriter::takeSnapshots(const NeedSnapshots& needed)
+    {
+    shared_ptr<SystemSnapshot> snap(new SystemSnapshot);
+    snap->dimensions = m_sysdef->getNDimensions();
+    snap->global_box = m_pdata->getGlobalBox();
+
+    if (needed[NeedPData])
+        snap->map = m_pdata->takeSnapshot(snap->particle_data);
+    if (needed[NeedBond])
+        m_sysdef->getBondData()->takeSnapshot(snap->bond_data);
+    if (needed[NeedAngle])
+        m_sysdef->getAngleData()->takeSnapshot(snap->angle_data);
+    if (needed[NeedDihedral])
+        m_sysdef->getDihedralData()->takeSnapshot(snap->dihedral_data);
+    if (needed[NeedImproper])
+        m_sysdef->getImproperData()->takeSnapshot(snap->improper_data);
+    if (needed[NeedPair])
+        m_sysdef->getPairData()->takeSnapshot(snap->pair_data);
+
+    return snap;
+    }
+
+// Copy the box and the per-particle quantities that are read from the
+// particle data, so that the frame can be written after the simulation
+// has moved on
+void GetarDumpWriter::gatherFrame(Frame& frame)
+    {
+    frame.box = m_pdata->getGlobalBox();
+
+    bool needEnergy(false), needVirial(false);
+    for (const vector<GetarDumpDescription>* records : {&frame.records, &frame.staticRecords})
+        for (vector<GetarDumpDescription>::const_iterator iter(records->begin());
+             iter != records->end();
+             ++iter)
+            {
+            needEnergy |= iter->m_prop == PotentialEnergy;
+            needVirial |= iter->m_prop == Virial;
+            }
+
+    if (!needEnergy && !needVirial)
+        return;
+
+    ArrayHandle<unsigned int> tags(m_pdata->getTags(), access_location::host, access_mode::read);
+    const unsigned int N(m_pdata->getN());
+
+    // local particle indices sorted by tag
+    vector<unsigned int> sorted(N);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [&tags](unsigned int i, unsigned int j) { return tags.data[i] < tags.data[j]; });
+
+    if (needEnergy)
+        {
+        ArrayHandle<Scalar4> handle(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::read);
+        frame.potentialEnergy.resize(N);
+        for (unsigned int i(0); i < N; ++i)
+            frame.potentialEnergy[i] = float(handle.data[sorted[i]].w);
+        }
+
+    if (needVirial)
+        {
+        ArrayHandle<Scalar> handle(m_pdata->getNetVirial(),
+                                   access_location::host,
+                                   access_mode::read);
+        size_t virialPitch(m_pdata->getNetVirial().getPitch());
+
+        // Produce elements in the following order: xx, xy, xz, yy, yz, zz
+        frame.virial.resize(6 * N);
+        for (unsigned int i(0); i < N; ++i)
+            for (unsigned int j(0); j < 6; ++j)
+                frame.virial[6 * i + j] = float(handle.data[j * virialPitch + sorted[i]]);
+        }
+    }
+
 void GetarDumpWriter::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
     const uint64_t shiftedTimestep(timestep - m_offset);
-    bool neededSnapshots[9] = {false, false, false, false, false, false, false, false, false};
+    NeedSnapshots neededSnapshots;
     bool ranThisStep(false);
 
     for (NeedSnapshotMap::iterator pIter(m_neededSnapshots.begin());
@@ -345,13 +528,22 @@ void GetarDumpWriter::analyze(uint64_t timestep)
         {
         if (!(shiftedTimestep % pIter->first))
             {
+            ranThisStep = true;
             for (unsigned int i(0); i < 9; ++i)
                 neededSnapshots[i] |= pIter->second[i];
             }
         }
 
-    if (neededSnapshots[NeedSystem])
-        m_systemSnap = takeSystemSnapshot(m_sysdef);
+    if (!ranThisStep)
+        return;
+
+    // one-shot mode rewrites the static records in every frame
+    if (m_operationMode == OneShot)
+        for (unsigned int i(0); i < 9; ++i)
+            neededSnapshots[i] |= m_staticSnapshots[i];
+
+    // skip the snapshots that no property due at this timestep needs
+    shared_ptr<SystemSnapshot> snapshot(takeSnapshots(neededSnapshots));
 
 #ifdef ENABLE_MPI
     // only open archive on root processor
@@ -359,103 +551,106 @@ void GetarDumpWriter::analyze(uint64_t timestep)
         return;
 #endif
 
+    if (m_operationMode != OneShot && !m_archive)
+        return;
+
+    std::unique_ptr<Frame> frame(new Frame);
+    frame->timestep = timestep;
+    frame->snapshot = snapshot;
+    for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
+        if (!(shiftedTimestep % pIter->first))
+            frame->records.insert(frame->records.end(),
+                                  pIter->second.begin(),
+                                  pIter->second.end());
     if (m_operationMode == OneShot)
+        frame->staticRecords = m_staticRecords;
+    gatherFrame(*frame);
+
+    if (!m_asynchronous)
+        {
+        writeFrame(*frame);
+        return;
+        }
+
+    if (!m_ioThread.joinable())
+        m_ioThread = std::thread(&GetarDumpWriter::ioThread, this);
+
+    // wait until there is room in the queue, rethrow errors from previous frames
+    waitForQueue(m_maxQueueDepth - 1);
+
         {
-        for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
-            if (!(shiftedTimestep % pIter->first))
-                ranThisStep = true;
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.push_back(std::move(frame));
+        }
+    m_queueCV.notify_all();
+    }
 
-        if (ranThisStep)
+void GetarDumpWriter::writeFrame(const Frame& frame)
+    {
+    if (m_operationMode == OneShot)
+        {
+        m_archive.reset(new GTAR(m_tempName, gtar::Write));
             {
-            m_archive.reset(new GTAR(m_tempName, gtar::Write));
-                {
-                GTAR::BulkWriter writer(*m_archive);
-
-                for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end();
-                     ++pIter)
-                    {
-                    if (!(shiftedTimestep % pIter->first))
-                        {
-                        for (vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
-                             dIter != pIter->second.end();
-                             ++dIter)
-                            {
-                            write(writer, *dIter, timestep);
-                            // const Property prop(dIter->m_prop);
-                            // const Resolution res(dIter->m_res);
-
-                            // string path(dIter->getFormattedPath(timestep));
-                            }
-                        }
-                    }
-
-                for (vector<GetarDumpDescription>::const_iterator iter(m_staticRecords.begin());
-                     iter != m_staticRecords.end();
-                     ++iter)
-                    write(writer, *iter, 0);
-                }
+            GTAR::BulkWriter writer(*m_archive);
 
-            m_archive.reset();
-            int result(rename(m_tempName.c_str(), m_filename.c_str()));
+            for (vector<GetarDumpDescription>::const_iterator iter(frame.records.begin());
+                 iter != frame.records.end();
+                 ++iter)
+                write(writer, *iter, frame, frame.timestep);
 
-            if (result)
-                {
-                stringstream msg;
-                msg << "Error " << result << " in one-shot file: " << strerror(result);
-                m_exec_conf->msg->error() << msg.str() << endl;
-                throw runtime_error(msg.str());
-                }
+            for (vector<GetarDumpDescription>::const_iterator iter(frame.staticRecords.begin());
+                 iter != frame.staticRecords.end();
+                 ++iter)
+                write(writer, *iter, frame, 0);
+            }
+
+        m_archive.reset();
+        int result(rename(m_tempName.c_str(), m_filename.c_str()));
+
+        if (result)
+            {
+            stringstream msg;
+            msg << "Error " << result << " in one-shot file: " << strerror(result);
+            throw runtime_error(msg.str());
             }
         }
     else if (m_archive)
         {
         GTAR::BulkWriter writer(*m_archive);
 
-        for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
-            {
-            if (!(shiftedTimestep % pIter->first))
-                {
-                ranThisStep = true;
-
-                for (vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
-                     dIter != pIter->second.end();
-                     ++dIter)
-                    {
-                    write(writer, *dIter, timestep);
-                    // const Property prop(dIter->m_prop);
-                    // const Resolution res(dIter->m_res);
-
-                    // string path(dIter->getFormattedPath(timestep));
-                    }
-                }
-            }
+        for (vector<GetarDumpDescription>::const_iterator iter(frame.records.begin());
+             iter != frame.records.end();
+             ++iter)
+            write(writer, *iter, frame, frame.timestep);
         }
     }
 
 void GetarDumpWriter::write(GTAR::BulkWriter& writer,
                             const GetarDumpDescription& desc,
+                            const Frame& frame,
                             uint64_t timestep)
     {
     if (!m_archive)
         return;
 
     if (desc.m_res == Individual)
-        writeIndividual(writer, desc, timestep);
+        writeIndividual(writer, desc, frame, timestep);
     else if (desc.m_res == Text)
-        writeText(writer, desc, timestep);
+        writeText(writer, desc, frame, timestep);
     else if (desc.m_res == Uniform)
-        writeUniform(writer, desc, timestep);
+        writeUniform(writer, desc, frame, timestep);
     }
 
 void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
                                       const GetarDumpDescription& desc,
+                                      const Frame& frame,
                                       uint64_t timestep)
     {
     if (desc.m_prop == AngularMomentum)
         {
         typedef QuatsxyzIterator<float, vector<quat<Scalar>>::iterator> iter_t;
-        iter_t begin(m_systemSnap->particle_data.angmom.begin());
-        iter_t end(m_systemSnap->particle_data.angmom.end());
+        iter_t begin(frame.snapshot->particle_data.angmom.begin());
+        iter_t end(frame.snapshot->particle_data.angmom.end());
         writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                               begin,
                                               end,
@@ -463,13 +658,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == AngleNames)
         {
-        string json(makeTypeList(m_systemSnap->angle_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->angle_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == AngleTags)
         {
-        GroupTagIterator<3> begin(m_systemSnap->angle_data.groups.begin());
-        GroupTagIterator<3> end(m_systemSnap->angle_data.groups.end());
+        GroupTagIterator<3> begin(frame.snapshot->angle_data.groups.begin());
+        GroupTagIterator<3> end(frame.snapshot->angle_data.groups.end());
         writer.writeIndividual<GroupTagIterator<3>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -477,8 +672,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == AngleTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->angle_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->angle_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->angle_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->angle_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -487,8 +682,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Body)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->particle_data.body.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->particle_data.body.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->particle_data.body.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->particle_data.body.end());
         writer.writeIndividual<vector<unsigned int>::iterator, int32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -497,13 +692,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == BondNames)
         {
-        string json(makeTypeList(m_systemSnap->bond_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->bond_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == BondTags)
         {
-        GroupTagIterator<2> begin(m_systemSnap->bond_data.groups.begin());
-        GroupTagIterator<2> end(m_systemSnap->bond_data.groups.end());
+        GroupTagIterator<2> begin(frame.snapshot->bond_data.groups.begin());
+        GroupTagIterator<2> end(frame.snapshot->bond_data.groups.end());
         writer.writeIndividual<GroupTagIterator<2>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -511,8 +706,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == BondTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->bond_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->bond_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->bond_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->bond_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -521,8 +716,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Charge)
         {
-        vector<Scalar>::iterator begin(m_systemSnap->particle_data.charge.begin());
-        vector<Scalar>::iterator end(m_systemSnap->particle_data.charge.end());
+        vector<Scalar>::iterator begin(frame.snapshot->particle_data.charge.begin());
+        vector<Scalar>::iterator end(frame.snapshot->particle_data.charge.end());
         writer.writeIndividual<vector<Scalar>::iterator, float>(desc.getFormattedPath(timestep),
                                                                 begin,
                                                                 end,
@@ -530,8 +725,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Diameter)
         {
-        vector<Scalar>::iterator begin(m_systemSnap->particle_data.diameter.begin());
-        vector<Scalar>::iterator end(m_systemSnap->particle_data.diameter.end());
+        vector<Scalar>::iterator begin(frame.snapshot->particle_data.diameter.begin());
+        vector<Scalar>::iterator end(frame.snapshot->particle_data.diameter.end());
         writer.writeIndividual<vector<Scalar>::iterator, float>(desc.getFormattedPath(timestep),
                                                                 begin,
                                                                 end,
@@ -539,13 +734,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == DihedralNames)
         {
-        string json(makeTypeList(m_systemSnap->dihedral_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->dihedral_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == DihedralTags)
         {
-        GroupTagIterator<4> begin(m_systemSnap->dihedral_data.groups.begin());
-        GroupTagIterator<4> end(m_systemSnap->dihedral_data.groups.end());
+        GroupTagIterator<4> begin(frame.snapshot->dihedral_data.groups.begin());
+        GroupTagIterator<4> end(frame.snapshot->dihedral_data.groups.end());
         writer.writeIndividual<GroupTagIterator<4>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -553,8 +748,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == DihedralTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->dihedral_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->dihedral_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->dihedral_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->dihedral_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -564,8 +759,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
     else if (desc.m_prop == Image)
         {
         typedef Int3xyzIterator<vector<int3>::iterator> iter_t;
-        iter_t begin(m_systemSnap->particle_data.image.begin());
-        iter_t end(m_systemSnap->particle_data.image.end());
+        iter_t begin(frame.snapshot->particle_data.image.begin());
+        iter_t end(frame.snapshot->particle_data.image.end());
         writer.writeIndividual<iter_t, int32_t>(desc.getFormattedPath(timestep),
                                                 begin,
                                                 end,
@@ -573,13 +768,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == ImproperNames)
         {
-        string json(makeTypeList(m_systemSnap->improper_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->improper_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == ImproperTags)
         {
-        GroupTagIterator<4> begin(m_systemSnap->improper_data.groups.begin());
-        GroupTagIterator<4> end(m_systemSnap->improper_data.groups.end());
+        GroupTagIterator<4> begin(frame.snapshot->improper_data.groups.begin());
+        GroupTagIterator<4> end(frame.snapshot->improper_data.groups.end());
         writer.writeIndividual<GroupTagIterator<4>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -587,8 +782,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == ImproperTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->improper_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->improper_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->improper_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->improper_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -597,13 +792,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == PairNames)
         {
-        string json(makeTypeList(m_systemSnap->pair_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->pair_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == PairTags)
         {
-        GroupTagIterator<2> begin(m_systemSnap->pair_data.groups.begin());
-        GroupTagIterator<2> end(m_systemSnap->pair_data.groups.end());
+        GroupTagIterator<2> begin(frame.snapshot->pair_data.groups.begin());
+        GroupTagIterator<2> end(frame.snapshot->pair_data.groups.end());
         writer.writeIndividual<GroupTagIterator<2>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -611,8 +806,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == PairTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->pair_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->pair_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->pair_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->pair_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -621,8 +816,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Mass)
         {
-        vector<Scalar>::iterator begin(m_systemSnap->particle_data.mass.begin());
-        vector<Scalar>::iterator end(m_systemSnap->particle_data.mass.end());
+        vector<Scalar>::iterator begin(frame.snapshot->particle_data.mass.begin());
+        vector<Scalar>::iterator end(frame.snapshot->particle_data.mass.end());
         writer.writeIndividual<vector<Scalar>::iterator, float>(desc.getFormattedPath(timestep),
                                                                 begin,
                                                                 end,
@@ -631,8 +826,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
     else if (desc.m_prop == MomentInertia)
         {
         typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
-        iter_t begin(m_systemSnap->particle_data.inertia.begin());
-        iter_t end(m_systemSnap->particle_data.inertia.end());
+        iter_t begin(frame.snapshot->particle_data.inertia.begin());
+        iter_t end(frame.snapshot->particle_data.inertia.end());
         writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                               begin,
                                               end,
@@ -643,8 +838,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         if (desc.m_highPrecision == false)
             {
             typedef QuatsxyzIterator<float, vector<quat<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.orientation.begin());
-            iter_t end(m_systemSnap->particle_data.orientation.end());
+            iter_t begin(frame.snapshot->particle_data.orientation.begin());
+            iter_t end(frame.snapshot->particle_data.orientation.end());
             writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                                   begin,
                                                   end,
@@ -653,8 +848,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         else
             {
             typedef QuatsxyzIterator<double, vector<quat<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.orientation.begin());
-            iter_t end(m_systemSnap->particle_data.orientation.end());
+            iter_t begin(frame.snapshot->particle_data.orientation.begin());
+            iter_t end(frame.snapshot->particle_data.orientation.end());
             writer.writeIndividual<iter_t, double>(desc.getFormattedPath(timestep),
                                                    begin,
                                                    end,
@@ -666,8 +861,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         if (desc.m_highPrecision == false)
             {
             typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.pos.begin());
-            iter_t end(m_systemSnap->particle_data.pos.end());
+            iter_t begin(frame.snapshot->particle_data.pos.begin());
+            iter_t end(frame.snapshot->particle_data.pos.end());
             writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                                   begin,
                                                   end,
@@ -676,8 +871,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         else
             {
             typedef Scalar3xyzIterator<double, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.pos.begin());
-            iter_t end(m_systemSnap->particle_data.pos.end());
+            iter_t begin(frame.snapshot->particle_data.pos.begin());
+            iter_t end(frame.snapshot->particle_data.pos.end());
             writer.writeIndividual<iter_t, double>(desc.getFormattedPath(timestep),
                                                    begin,
                                                    end,
@@ -686,30 +881,18 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == PotentialEnergy)
         {
-        ArrayHandle<unsigned int> tags(m_pdata->getTags(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<Scalar4> handle(m_pdata->getNetForce(),
-                                    access_location::host,
-                                    access_mode::read);
-        const unsigned int N(m_pdata->getN());
-
-        map<unsigned int, Scalar4> sorted;
-        for (unsigned int i(0); i < N; ++i)
-            sorted[tags.data[i]] = handle.data[i];
-
-        typedef Scalar4wIterator<MapValueIterator<unsigned int, Scalar4>> iter_t;
-        iter_t begin(sorted.begin());
-        iter_t end(sorted.end());
-        writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
-                                              begin,
-                                              end,
-                                              desc.m_compression);
+        vector<float>::const_iterator begin(frame.potentialEnergy.begin());
+        vector<float>::const_iterator end(frame.potentialEnergy.end());
+        writer.writeIndividual<vector<float>::const_iterator, float>(
+            desc.getFormattedPath(timestep),
+            begin,
+            end,
+            desc.m_compression);
         }
     else if (desc.m_prop == Type)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->particle_data.type.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->particle_data.type.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->particle_data.type.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->particle_data.type.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -721,8 +904,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         if (desc.m_highPrecision == false)
             {
             typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.vel.begin());
-            iter_t end(m_systemSnap->particle_data.vel.end());
+            iter_t begin(frame.snapshot->particle_data.vel.begin());
+            iter_t end(frame.snapshot->particle_data.vel.end());
             writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                                   begin,
                                                   end,
@@ -731,8 +914,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         else
             {
             typedef Scalar3xyzIterator<double, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.vel.begin());
-            iter_t end(m_systemSnap->particle_data.vel.end());
+            iter_t begin(frame.snapshot->particle_data.vel.begin());
+            iter_t end(frame.snapshot->particle_data.vel.end());
             writer.writeIndividual<iter_t, double>(desc.getFormattedPath(timestep),
                                                    begin,
                                                    end,
@@ -741,38 +924,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Virial)
         {
-        ArrayHandle<unsigned int> tags(m_pdata->getTags(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<Scalar> handle(m_pdata->getNetVirial(),
-                                   access_location::host,
-                                   access_mode::read);
-
-        const unsigned int N(m_pdata->getN());
-        size_t virialPitch(m_pdata->getNetVirial().getPitch());
-
-        map<unsigned int, Scalar> sorted[6];
-        for (unsigned int i(0); i < N; ++i)
-            for (unsigned int j(0); j < 6; ++j)
-                sorted[j][tags.data[i]] = handle.data[j * virialPitch + i];
-
-        typedef VirialIterator<float, MapValueIterator<unsigned int, Scalar>> iter_t;
-        typedef MapValueIterator<unsigned int, Scalar> map_iter_t;
-
-        // Produce elements in the following order: xx, xy, xz, yy, yz, zz
-        map_iter_t begins[6];
-        map_iter_t ends[6];
-        for (unsigned int i(0); i < 6; ++i)
-            {
-            begins[i] = map_iter_t(sorted[i].begin());
-            ends[i] = map_iter_t(sorted[i].end());
-            }
-        iter_t begin(begins);
-        iter_t end(ends);
-        writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
-                                              begin,
-                                              end,
-                                              desc.m_compression);
+        vector<float>::const_iterator begin(frame.virial.begin());
+        vector<float>::const_iterator end(frame.virial.end());
+        writer.writeIndividual<vector<float>::const_iterator, float>(
+            desc.getFormattedPath(timestep),
+            begin,
+            end,
+            desc.m_compression);
         }
     else
         {
@@ -785,20 +943,21 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
 
 void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
                                    const GetarDumpDescription& desc,
+                                   const Frame& frame,
                                    uint64_t timestep)
     {
     if (desc.m_prop == Box)
         {
-        Scalar3 box(m_pdata->getGlobalBox().getL());
+        Scalar3 box(frame.box.getL());
 
         if (desc.m_highPrecision == false)
             {
             float arr[] = {float(box.x),
                            float(box.y),
                            float(box.z),
-                           float(m_pdata->getGlobalBox().getTiltFactorXY()),
-                           float(m_pdata->getGlobalBox().getTiltFactorXZ()),
-                           float(m_pdata->getGlobalBox().getTiltFactorYZ())};
+                           float(frame.box.getTiltFactorXY()),
+                           float(frame.box.getTiltFactorXZ()),
+                           float(frame.box.getTiltFactorYZ())};
             writer.writeIndividual<float*, float>(desc.getFormattedPath(timestep),
                                                   arr,
                                                   &arr[6],
@@ -809,9 +968,9 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
             double arr[] = {box.x,
                             box.y,
                             box.z,
-                            m_pdata->getGlobalBox().getTiltFactorXY(),
-                            m_pdata->getGlobalBox().getTiltFactorXZ(),
-                            m_pdata->getGlobalBox().getTiltFactorYZ()};
+                            frame.box.getTiltFactorXY(),
+                            frame.box.getTiltFactorXZ(),
+                            frame.box.getTiltFactorYZ()};
             writer.writeIndividual<double*, double>(desc.getFormattedPath(timestep),
                                                     arr,
                                                     &arr[6],
@@ -821,7 +980,7 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
     else if (desc.m_prop == Dimensions)
         {
         writer.writeUniform<unsigned int>(desc.getFormattedPath(timestep),
-                                          m_systemSnap->dimensions);
+                                          frame.snapshot->dimensions);
         }
     else
         {
@@ -833,36 +992,37 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
 
 void GetarDumpWriter::writeText(GTAR::BulkWriter& writer,
                                 const GetarDumpDescription& desc,
+                                const Frame& frame,
                                 uint64_t timestep)
     {
     if (desc.m_prop == TypeNames)
         {
-        string json(makeTypeList(m_systemSnap->particle_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->particle_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == AngleNames)
         {
-        string json(makeTypeList(m_systemSnap->angle_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->angle_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == BondNames)
         {
-        string json(makeTypeList(m_systemSnap->bond_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->bond_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == DihedralNames)
         {
-        string json(makeTypeList(m_systemSnap->dihedral_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->dihedral_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == ImproperNames)
         {
-        string json(makeTypeList(m_systemSnap->improper_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->improper_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == PairNames)
         {
-        string json(makeTypeList(m_systemSnap->pair_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->pair_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else
@@ -904,10 +1064,24 @@ void GetarDumpWriter::setPeriod(Property prop,
     if (behavior == Constant)
         {
         m_staticRecords.push_back(desc);
+        for (unsigned int i(1); i < 9; ++i)
+            {
+            m_staticSnapshots[i] |= needSnapshot((NeedSnapshotIdx)i, prop);
+            m_staticSnapshots[0] |= m_staticSnapshots[i];
+            }
+
+        // the I/O thread replaces the archive in one-shot mode
+        flush();
         if (m_archive)
             {
+            Frame frame;
+            frame.timestep = 0;
+            frame.snapshot = m_systemSnap;
+            frame.records.push_back(desc);
+            gatherFrame(frame);
+
             GTAR::BulkWriter writer(*m_archive);
-            write(writer, desc, 0);
+            write(writer, desc, frame, 0);
             }
         }
     else if (behavior == Discrete)
@@ -975,7 +1149,10 @@ void GetarDumpWriter::writeStr(const std::string& name,
     // only write on root rank
     if (m_exec_conf->isRoot())
 #endif
+        {
+        flush();
         m_archive->writeString(rec.getPath(), contents, gtar::FastCompress);
+        }
     }
 
 void export_GetarDumpWriter(py::module& m)
@@ -986,6 +1163,13 @@ void export_GetarDumpWriter(py::module& m)
                       getardump::GetarDumpMode,
                       unsigned int>())
         .def("close", &GetarDumpWriter::close)
+        .def("flush", &GetarDumpWriter::flush)
+        .def_property("asynchronous",
+                      &GetarDumpWriter::getAsynchronous,
+                      &GetarDumpWriter::setAsynchronous)
+        .def_property("max_queue_depth",
+                      &GetarDumpWriter::getMaxQueueDepth,
+                      &GetarDumpWriter::setMaxQueueDepth)
         .def("getPeriod", &GetarDumpWriter::getPeriod)
         .def("setPeriod", &GetarDumpWriter::setPeriod)
         .def("removeDump", &GetarDumpWriter::removeDump)
@@ -11,8 +11,13 @@
 #include "hoomd/extern/libgetar/src/Record.hpp"
 #include <memory>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifndef __HIPCC__
@@ -219,6 +224,16 @@ class GetarDumpDescription
     };
 
 /// HOOMD analyzer which periodically dumps a set of properties
+///
+/// analyze() gathers only the snapshots needed by the properties that
+/// are due at the current timestep. The gathered data is stored in a
+/// Frame, which holds everything needed to write the records. In
+/// asynchronous mode, a background thread compresses and writes the
+/// frames to the archive so that the simulation continues while the
+/// archive is written. At most maxQueueDepth frames wait to be
+/// written, analyze() blocks until there is room in the queue. Every
+/// direct access to the archive (static records, writeStr(), close())
+/// first waits for the queued frames to be written.
 class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     {
     public:
@@ -242,6 +257,27 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     /// Close the getar file manually after finalizing any IO
     void close();
 
+    /// Block until all queued frames are written to the archive
+    void flush();
+
+    /// Set whether frames are written in a background thread
+    void setAsynchronous(bool asynchronous);
+
+    /// Get whether frames are written in a background thread
+    bool getAsynchronous() const
+        {
+        return m_asynchronous;
+        }
+
+    /// Set the maximum number of frames waiting to be written
+    void setMaxQueueDepth(unsigned int depth);
+
+    /// Get the maximum number of frames waiting to be written
+    unsigned int getMaxQueueDepth() const
+        {
+        return m_maxQueueDepth;
+        }
+
     /// Get needed pdata flags
     virtual PDataFlags getRequestedPDataFlags()
         {
@@ -284,19 +320,59 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     void writeStr(const std::string& name, const std::string& contents, uint64_t timestep);
 
     private:
+    /// Data gathered at one timestep, everything needed to write its records
+    struct Frame
+        {
+        /// Timestep of the frame
+        uint64_t timestep;
+        /// Snapshot holding the parts of the system that the records need
+        std::shared_ptr<SystemSnapshot> snapshot;
+        /// Global simulation box
+        BoxDim box;
+        /// Per-particle potential energy, sorted by tag
+        std::vector<float> potentialEnergy;
+        /// Per-particle virial (xx, xy, xz, yy, yz, zz), sorted by tag
+        std::vector<float> virial;
+        /// Records to write at the timestep
+        std::vector<GetarDumpDescription> records;
+        /// Static records to rewrite in one-shot mode
+        std::vector<GetarDumpDescription> staticRecords;
+        };
+
+    /// Take the parts of a system snapshot that are needed
+    std::shared_ptr<SystemSnapshot> takeSnapshots(const NeedSnapshots& needed);
+    /// Gather the per-particle quantities needed by the records of a frame
+    void gatherFrame(Frame& frame);
+    /// Write the records of a frame to the archive
+    void writeFrame(const Frame& frame);
+
+    /// Wait until the queue holds at most depth frames
+    void waitForQueue(unsigned int depth);
+    /// Body of the I/O thread
+    void ioThread();
+    /// Write the queued frames and join the I/O thread
+    void stopIOThread();
+
     /// Write any GetarDumpDescription for the given timestep
-    void write(gtar::GTAR::BulkWriter& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    void write(gtar::GTAR::BulkWriter& writer,
+               const GetarDumpDescription& desc,
+               const Frame& frame,
+               uint64_t timestep);
     /// Write an individual GetarDumpDescription for the given timestep
     void writeIndividual(gtar::GTAR::BulkWriter& writer,
                          const GetarDumpDescription& desc,
+                         const Frame& frame,
                          uint64_t timestep);
     /// Write a uniform GetarDumpDescription for the given timestep
     void writeUniform(gtar::GTAR::BulkWriter& writer,
                       const GetarDumpDescription& desc,
+                      const Frame& frame,
                       uint64_t timestep);
     /// Write a text GetarDumpDescription for the given timestep
-    void
-    writeText(gtar::GTAR::BulkWriter& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    void writeText(gtar::GTAR::BulkWriter& writer,
+                   const GetarDumpDescription& desc,
+                   const Frame& frame,
+                   uint64_t timestep);
 
     /// File archive interface
     std::shared_ptr<gtar::GTAR> m_archive;
@@ -317,6 +393,25 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     std::shared_ptr<SystemSnapshot> m_systemSnap;
     /// Map detailing when we need which snapshots
     NeedSnapshotMap m_neededSnapshots;
+    /// Snapshots needed by the static records
+    NeedSnapshots m_staticSnapshots;
+
+    /// True when writing in the I/O thread
+    bool m_asynchronous;
+    /// Maximum number of queued frames
+    unsigned int m_maxQueueDepth;
+    /// Frames waiting to be written
+    std::deque<std::unique_ptr<Frame>> m_queue;
+    /// Thread that writes queued frames
+    std::thread m_ioThread;
+    /// Protects the queue
+    std::mutex m_queueMutex;
+    /// Signals changes to the queue
+    std::condition_variable m_queueCV;
+    /// Set to stop the I/O thread
+    bool m_stopIOThread;
+    /// Error raised in the I/O thread
+    std::exception_ptr m_ioError;
     };
 
 void export_GetarDumpWriter(pybind11::module& m);
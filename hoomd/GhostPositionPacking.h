@@ -0,0 +1,98 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file GhostPositionPacking.h
+    \brief Defines the fixed-point encoding of ghost particle positions
+*/
+
+#pragma once
+
+#include "BoxDim.h"
+#include "HOOMDMath.h"
+
+#include <stdint.h>
+
+// need to declare these functions with __device__ qualifiers when building in nvcc
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__ inline
+#else
+#define HOSTDEVICE inline __attribute__((always_inline))
+#endif
+
+//! Parameters of the fixed-point encoding of ghost positions
+/*! A ghost position is sent as the low \a bits bits of its fractional coordinate in the global box
+    quantized to \a steps steps per box length, and the type. The receiver restores the high bits
+    from the quantized center of its own domain: the window of 2^bits steps is chosen (by the
+    Communicator, identically on all ranks) to be wider than the widest domain including twice
+    its ghost layers, so every ghost lies within half a window of the center of the domain that
+    receives it. The steps are a multiple of 2^bits in every decomposed direction, so the encoding
+    does not depend on the periodic image the sender wraps the ghost into.
+
+    The resolution is the width of the window divided by 2^bits, less than twice the width of the
+    ghost layer box divided by 2^bits.
+*/
+struct GhostPositionPacking
+    {
+    unsigned int bits; //!< Bits per component, 0 when positions are sent as Scalar4
+    double steps[3];   //!< Quantization steps per global box length (a power of two)
+    int64_t center[3]; //!< Quantized fractional coordinate of the center of this domain
+    };
+
+//! Encode a ghost position
+/*! \param p Encoding parameters
+    \param global_box The global simulation box
+    \param pos Position and type of the ghost
+    \returns The packed components (x and y) and the type (z)
+*/
+HOSTDEVICE uint3 packGhostPosition(const GhostPositionPacking& p,
+                                   const BoxDim& global_box,
+                                   const Scalar4& pos)
+    {
+    Scalar3 f = global_box.makeFraction(make_scalar3(pos.x, pos.y, pos.z));
+    const double fd[3] = {f.x, f.y, f.z};
+    const uint64_t mask = (uint64_t(1) << p.bits) - 1;
+
+    uint64_t packed = 0;
+    for (unsigned int d = 0; d < 3; ++d)
+        {
+        int64_t q = (int64_t)floor(fd[d] * p.steps[d] + 0.5);
+        packed |= (uint64_t(q) & mask) << (d * p.bits);
+        }
+
+    return make_uint3((unsigned int)packed,
+                      (unsigned int)(packed >> 32),
+                      __scalar_as_int(pos.w));
+    }
+
+//! Decode a ghost position
+/*! \param p Encoding parameters of the receiving domain
+    \param global_box The global simulation box
+    \param packed Packed position from packGhostPosition()
+    \returns The position and type of the ghost, in the periodic image closest to this domain
+*/
+HOSTDEVICE Scalar4 unpackGhostPosition(const GhostPositionPacking& p,
+                                       const BoxDim& global_box,
+                                       const uint3& packed)
+    {
+    const uint64_t r = uint64_t(packed.x) | (uint64_t(packed.y) << 32);
+    const uint64_t mask = (uint64_t(1) << p.bits) - 1;
+    const int64_t half = int64_t(1) << (p.bits - 1);
+
+    double fd[3];
+    for (unsigned int d = 0; d < 3; ++d)
+        {
+        // offset from the center of the domain in [-half, half)
+        int64_t delta = int64_t(((r >> (d * p.bits)) - uint64_t(p.center[d])) & mask);
+        if (delta >= half)
+            delta -= 2 * half;
+
+        fd[d] = double(p.center[d] + delta) / p.steps[d];
+        }
+
+    Scalar3 v
+        = global_box.makeCoordinates(make_scalar3(Scalar(fd[0]), Scalar(fd[1]), Scalar(fd[2])));
+    return make_scalar4(v.x, v.y, v.z, __int_as_scalar(packed.z));
+    }
+
+// undefine HOSTDEVICE so we don't interfere with other headers
+#undef HOSTDEVICE
@@ -35,6 +35,7 @@
 #include <memory>
 
 #include "GPUArray.h"
+#include "MemoryAccounting.h"
 #include "MemoryTraceback.h"
 
 #include <cxxabi.h>
@@ -46,9 +47,9 @@
 #include <unistd.h>
 #include <vector>
 
-#define TAG_ALLOCATION(array)              \
-        {                                  \
-        array.setTag(std::string(#array)); \
+#define TAG_ALLOCATION(array)                                                             \
+        {                                                                                 \
+        array.setTag(hoomd::detail::allocation_owner(this) + "::" + std::string(#array)); \
         }
 
 namespace hoomd
@@ -137,15 +138,17 @@ template<class T> class managed_deleter
 #ifdef ENABLE_HIP
         if (m_use_device)
             {
-            std::ostringstream oss;
-            oss << "Freeing " << m_allocation_bytes << " bytes of managed memory";
-            if (m_tag != "")
-                oss << " [" << m_tag << "]";
-            oss << std::endl;
-            this->m_exec_conf->msg->notice(10) << oss.str();
-
-            hipFree(m_allocation_ptr);
-            CHECK_CUDA_ERROR();
+            if (this->m_exec_conf->msg->isNoticeEnabled(10))
+                {
+                std::ostringstream oss;
+                oss << "Freeing " << m_allocation_bytes << " bytes of managed memory";
+                if (m_tag != "")
+                    oss << " [" << m_tag << "]";
+                oss << std::endl;
+                this->m_exec_conf->msg->notice(10) << oss.str();
+                }
+
+            this->m_exec_conf->getMemoryPoolManaged().deallocate(m_allocation_ptr);
             }
         else
 #endif
@@ -158,6 +161,8 @@ template<class T> class managed_deleter
             this->m_exec_conf->getMemoryTracer()->unregisterAllocation(
                 reinterpret_cast<const void*>(ptr),
                 sizeof(T) * m_N);
+        m_exec_conf->getMemoryAccounting()->unregisterAllocation(
+            reinterpret_cast<const void*>(ptr));
         }
 
     std::pair<const void*, const void*> getAllocationRange() const
@@ -249,7 +254,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         {
 #ifndef ALWAYS_USE_MANAGED_MEMORY
         if (!(m_is_managed))
+            {
+            m_fallback.setTag(m_tag);
             return;
+            }
 #endif
 
         assert(this->m_exec_conf);
@@ -652,6 +660,16 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                                                             sizeof(T) * m_num_elements,
                                                             m_tag);
 
+        // the fallback GPUArray accounts for its own allocations
+#ifndef ALWAYS_USE_MANAGED_MEMORY
+        if (!m_is_managed)
+            m_fallback.setTag(tag);
+#endif
+        if (this->m_exec_conf && m_data)
+            this->m_exec_conf->getMemoryAccounting()->updateTag(
+                reinterpret_cast<const void*>(m_data.get()),
+                m_tag);
+
         // set tag on deleter so it can be displayed upon free
         if (!isNull() && m_data)
             m_data.get_deleter().setTag(tag);
@@ -788,8 +806,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
             this->m_exec_conf->msg->notice(10)
                 << "Allocating " << allocation_bytes << " bytes of managed memory." << std::endl;
 
-            hipMallocManaged(&ptr, allocation_bytes, hipMemAttachGlobal);
-            CHECK_CUDA_ERROR();
+            ptr = this->m_exec_conf->getMemoryPoolManaged().allocate(allocation_bytes);
 
             allocation_ptr = ptr;
 
@@ -812,8 +829,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         else
 #endif
             {
-            int retval = posix_memalign((void**)&ptr, 32, m_num_elements * sizeof(T));
-            if (retval != 0)
+            ptr = hoomd::detail::host_allocate(this->m_exec_conf.get(), m_num_elements * sizeof(T));
+            if (!ptr)
                 {
                 throw std::runtime_error("Error allocating aligned memory");
                 }
@@ -859,6 +876,11 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                 sizeof(T) * m_num_elements,
                 typeid(T).name(),
                 m_tag);
+        this->m_exec_conf->getMemoryAccounting()->registerAllocation(
+            reinterpret_cast<const void*>(m_data.get()),
+            sizeof(T) * m_num_elements,
+            use_device,
+            m_tag);
 
         // display representation for debugging
         if (m_tag != "")
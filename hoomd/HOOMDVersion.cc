@@ -31,6 +31,9 @@ std::string BuildInfo::getCompileFlags()
 
 #ifdef SINGLE_PRECISION
     o << "SINGLE ";
+#ifdef ENABLE_MD_MIXED_PRECISION
+    o << "MD_MIXED ";
+#endif
 #else
     o << "DOUBLE ";
 #ifdef ENABLE_HPMC_MIXED_PRECISION
@@ -38,6 +41,10 @@ std::string BuildInfo::getCompileFlags()
 #endif
 #endif
 
+#ifdef ENABLE_MD_FIXED_POINT_FORCES
+    o << "MD_FIXED_POINT ";
+#endif
+
 #ifdef ENABLE_MPI
     o << "MPI ";
 #endif
@@ -50,6 +57,14 @@ std::string BuildInfo::getCompileFlags()
     o << "TBB ";
 #endif
 
+#ifdef ENABLE_ADIOS2
+    o << "ADIOS2 ";
+#endif
+
+#ifdef ENABLE_PAPI
+    o << "PAPI ";
+#endif
+
 #ifdef __SSE__
     o << "SSE ";
 #endif
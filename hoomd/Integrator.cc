@@ -13,6 +13,11 @@ namespace py = pybind11;
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/flow_graph.h>
+#endif
+
+#include <memory>
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<ForceConstraint>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<ForceCompute>>);
@@ -85,6 +90,11 @@ void Integrator::setDeltaT(Scalar deltaT)
         force->setDeltaT(deltaT);
         }
 
+    for (auto& force : m_outer_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(deltaT);
@@ -115,6 +125,25 @@ Scalar Integrator::getNDOFRemoved(std::shared_ptr<ParticleGroup> query)
     return n;
     }
 
+/** @param timestep Time step the forces are evaluated at
+
+    The outer forces are included with the weight m_outer_period on the steps that are a multiple of
+    m_outer_period and left out on all other steps.
+*/
+void Integrator::collectActiveForces(uint64_t timestep)
+    {
+    m_active_forces.assign(m_forces.begin(), m_forces.end());
+    m_active_weights.assign(m_forces.size(), Scalar(1.0));
+
+    if (isOuterStep(timestep))
+        {
+        m_active_forces.insert(m_active_forces.end(), m_outer_forces.begin(), m_outer_forces.end());
+        m_active_weights.insert(m_active_weights.end(),
+                                m_outer_forces.size(),
+                                Scalar(m_outer_period));
+        }
+    }
+
 /** @param timestep Current timestep
     \post \c h_accel.data[i] is set based on the forces computed by the ForceComputes
 */
@@ -206,6 +235,90 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
     return Scalar(p_tot);
     }
 
+/** @param force Force compute to evaluate
+    @param timestep Current time step of the simulation
+    @param into_net Add the forces to the net force arrays when the force compute supports it
+    @returns True when the forces were added to the net force arrays
+
+    The neighbor list is computed inside the force compute that uses it, so its time is included.
+    Completing the ghost update is not part of the force compute and is not timed.
+*/
+bool Integrator::computeForce(ForceCompute& force, uint64_t timestep, bool into_net)
+    {
+    int64_t start = m_force_timing ? startForceTimer() : 0;
+
+    bool in_net = into_net && force.computeIntoNet(timestep);
+    if (!in_net)
+        force.compute(timestep);
+
+    if (m_force_timing)
+        stopForceTimer(start);
+    return in_net;
+    }
+
+#ifdef ENABLE_TBB
+/** @param timestep Current time step of the simulation
+
+    Each force compute is a node of a TBB flow graph that runs in the task arena of the execution
+    configuration. Idle threads steal the nodes, and the parallel loops inside the force computes
+    share the same threads, so the load balances across forces of different cost. The shared
+    dependencies of the forces (neighbor lists and cached copies of the particle data) are brought
+    up to date on the calling thread first, because building them may communicate with MPI and
+    modify the particle data. The nodes then only read them.
+
+    The forces are computed into their own force arrays and summed in order afterwards, so the net
+    force does not depend on the order in which the nodes complete.
+*/
+void Integrator::computeConcurrentForces(uint64_t timestep)
+    {
+    for (unsigned int i = 0; i < m_active_forces.size(); i++)
+        {
+        if (m_active_concurrent[i])
+            m_active_forces[i]->prepareConcurrentCompute(timestep);
+        }
+
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            typedef tbb::flow::continue_node<tbb::flow::continue_msg> force_node;
+
+            tbb::flow::graph graph;
+            tbb::flow::broadcast_node<tbb::flow::continue_msg> start(graph);
+            std::vector<std::unique_ptr<force_node>> nodes;
+            for (unsigned int i = 0; i < m_active_forces.size(); i++)
+                {
+                if (!m_active_concurrent[i])
+                    continue;
+
+                ForceCompute* force = m_active_forces[i].get();
+                nodes.emplace_back(
+                    new force_node(graph,
+                                   [force, timestep](const tbb::flow::continue_msg&)
+                                   { force->compute(timestep); }));
+                tbb::flow::make_edge(start, *nodes.back());
+                }
+
+            start.try_put(tbb::flow::continue_msg());
+            graph.wait_for_all();
+        });
+    }
+#endif
+
+/** @param start Time returned by startForceTimer()
+
+    Synchronizes with the device so that the time includes the kernels that have been launched.
+*/
+void Integrator::stopForceTimer(int64_t start)
+    {
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipDeviceSynchronize();
+        }
+#endif
+    m_force_time += m_force_clock.getTime() - start;
+    }
+
 /** @param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and
    \a m_net_virial \note The summation step is performed <b>on the CPU</b> and will result in a lot
@@ -214,11 +327,89 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
 */
 void Integrator::computeNetForce(uint64_t timestep)
     {
-    for (auto& force : m_forces)
+    collectActiveForces(timestep);
+
+    // forces with unit weight add to the net force directly unless an operation reads the force
+    // arrays of the individual force computes on this step
+    const bool into_net
+        = m_accumulate_net_force && !m_pdata->getFlags()[pdata_flag::force_arrays];
+    if (into_net)
         {
-        force->compute(timestep);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+        memset((void*)h_net_force.data,
+               0,
+               sizeof(Scalar4) * m_pdata->getNetForce().getNumElements());
+        memset((void*)h_net_virial.data,
+               0,
+               sizeof(Scalar) * m_pdata->getNetVirial().getNumElements());
         }
 
+    Tracer* tracer = m_exec_conf->getTracer().get();
+    if (tracer)
+        tracer->begin("Forces");
+
+    m_active_in_net.assign(m_active_forces.size(), 0);
+
+    // with several CPU threads, the forces that support it are computed concurrently after the
+    // others, unless the profiler, tracer, or force timers (which are not thread safe) are active.
+    // GPU executions launch kernels and access the device arrays from the main thread only.
+    m_active_concurrent.assign(m_active_forces.size(), 0);
+#ifdef ENABLE_TBB
+    unsigned int n_concurrent = 0;
+    if (m_exec_conf->getNumThreads() > 1 && !m_exec_conf->isCUDAEnabled() && !m_prof && !tracer
+        && !m_force_timing)
+        {
+        for (unsigned int i = 0; i < m_active_forces.size(); i++)
+            {
+            if (m_active_forces[i]->supportsConcurrentCompute())
+                {
+                m_active_concurrent[i] = 1;
+                n_concurrent++;
+                }
+            }
+
+        // a single force uses all threads in its own parallel loops
+        if (n_concurrent < 2)
+            {
+            m_active_concurrent.assign(m_active_forces.size(), 0);
+            n_concurrent = 0;
+            }
+        }
+#endif
+
+    for (unsigned int i = 0; i < m_active_forces.size(); i++)
+        {
+        if (m_active_concurrent[i])
+            continue;
+
+        auto& force = m_active_forces[i];
+#ifdef ENABLE_MPI
+        // complete a pending ghost update before forces that need the ghosts from the start
+        if (m_comm && !force->overlapsGhostUpdate())
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+        m_active_in_net[i]
+            = computeForce(*force, timestep, into_net && m_active_weights[i] == Scalar(1.0));
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        m_comm->finishUpdateGhosts(timestep);
+#endif
+
+#ifdef ENABLE_TBB
+    if (n_concurrent > 0)
+        computeConcurrentForces(timestep);
+#endif
+
+    if (tracer)
+        tracer->end();
+
     if (m_prof)
         {
         m_prof->push("Integrate");
@@ -232,15 +423,21 @@ void Integrator::computeNetForce(uint64_t timestep)
         const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
         const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
         const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
-        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
+        const access_mode::Enum net_mode = into_net ? access_mode::readwrite
+                                                    : access_mode::overwrite;
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, net_mode);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, net_mode);
         ArrayHandle<Scalar4> h_net_torque(net_torque,
                                           access_location::host,
                                           access_mode::overwrite);
 
-        // start by zeroing the net force and virial arrays
-        memset((void*)h_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
-        memset((void*)h_net_virial.data, 0, sizeof(Scalar) * net_virial.getNumElements());
+        // start by zeroing the net force and virial arrays, the forces computed into the net
+        // force arrays zeroed them above
+        if (!into_net)
+            {
+            memset((void*)h_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
+            memset((void*)h_net_virial.data, 0, sizeof(Scalar) * net_virial.getNumElements());
+            }
         memset((void*)h_net_torque.data, 0, sizeof(Scalar4) * net_torque.getNumElements());
 
         for (unsigned int i = 0; i < 6; ++i)
@@ -257,8 +454,22 @@ void Integrator::computeNetForce(uint64_t timestep)
         assert(6 * nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (const auto& force : m_forces)
+        for (unsigned int i = 0; i < m_active_forces.size(); i++)
             {
+            const auto& force = m_active_forces[i];
+            Scalar weight = m_active_weights[i];
+
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                external_virial[k] += force->getExternalVirial(k);
+                }
+
+            external_energy += force->getExternalEnergy();
+
+            // the force compute added its forces to the net force already
+            if (m_active_in_net[i])
+                continue;
+
             GlobalArray<Scalar4>& h_force_array = force->getForceArray();
             GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
@@ -274,14 +485,14 @@ void Integrator::computeNetForce(uint64_t timestep)
             size_t virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += weight * h_force.data[j].x;
+                h_net_force.data[j].y += weight * h_force.data[j].y;
+                h_net_force.data[j].z += weight * h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += weight * h_torque.data[j].x;
+                h_net_torque.data[j].y += weight * h_torque.data[j].y;
+                h_net_torque.data[j].z += weight * h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
                 for (unsigned int k = 0; k < 6; k++)
@@ -290,13 +501,6 @@ void Integrator::computeNetForce(uint64_t timestep)
                         += h_virial.data[k * virial_pitch + j];
                     }
                 }
-
-            for (unsigned int k = 0; k < 6; k++)
-                {
-                external_virial[k] += force->getExternalVirial(k);
-                }
-
-            external_energy += force->getExternalEnergy();
             }
         }
 
@@ -313,18 +517,19 @@ void Integrator::computeNetForce(uint64_t timestep)
         m_prof->pop();
         }
 
-    // return early if there are no constraint forces or no HalfStepHook set
-    if (m_constraint_forces.size() == 0)
-        return;
-
 #ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
+    // communicate the net force, adding the forces on ghosts to their owners when requested
+    if (m_sysdef->isDomainDecomposed()
+        && (m_constraint_forces.size() > 0 || m_comm->getFlags()[comm_flag::reverse_net_force]))
         {
-        // communicate the net force
         m_comm->updateNetForce(timestep);
         }
 #endif
 
+    // return early if there are no constraint forces or no HalfStepHook set
+    if (m_constraint_forces.size() == 0)
+        return;
+
     // compute all the constraint forces next
     // constraint forces only apply a force, not a torque
     for (auto& constraint_force : m_constraint_forces)
@@ -424,12 +629,65 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         }
 
     // compute all the normal forces first
+    collectActiveForces(timestep);
 
-    for (auto& force : m_forces)
+    Tracer* tracer = m_exec_conf->getTracer().get();
+    if (tracer)
+        tracer->begin("Forces");
+
+    // independent forces run on separate streams, the net force sum on the default stream waits
+    // for all of them
+    for (unsigned int i = 0; i < m_active_forces.size(); ++i)
+        m_active_forces[i]->setStream(m_exec_conf->getStream(i));
+
+    // forces that compute on the host run after the kernels of the other forces are launched
+    bool have_host_forces = false;
+    for (auto& force : m_active_forces)
+        have_host_forces = have_host_forces || force->getOverlapHost();
+
+    if (have_host_forces)
+        {
+#ifdef ENABLE_MPI
+        // the host forces need the ghosts
+        if (m_comm)
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+
+        // copy the positions to the host before the kernels are launched, the kernels only read
+        // them so both copies stay valid while the host forces run
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        }
+
+    for (auto& force : m_active_forces)
+        {
+        if (force->getOverlapHost())
+            continue;
+
+#ifdef ENABLE_MPI
+        // complete a pending ghost update before forces that need the ghosts from the start
+        if (m_comm && !force->overlapsGhostUpdate())
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+        computeForce(*force, timestep);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        m_comm->finishUpdateGhosts(timestep);
+#endif
+
+    // compute the host forces while the kernels run
+    for (auto& force : m_active_forces)
         {
-        force->compute(timestep);
+        if (force->getOverlapHost())
+            computeForce(*force, timestep);
         }
 
+    if (tracer)
+        tracer->end();
+
     if (m_prof)
         {
         m_prof->push(m_exec_conf, "Integrate");
@@ -471,7 +729,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the
         // addition kernel will do that ahh!, but we do need to zer out the net force and virial if
         // there are 0 forces!
-        if (m_forces.size() == 0)
+        if (m_active_forces.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             hipMemset(d_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
@@ -484,20 +742,23 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < m_active_forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GlobalArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GlobalArray<Scalar4>& d_force_array0
+                = m_active_forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,
                                           access_location::device,
                                           access_mode::read);
-            const GlobalArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GlobalArray<Scalar>& d_virial_array0
+                = m_active_forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,
                                           access_location::device,
                                           access_mode::read);
-            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GlobalArray<Scalar4>& d_torque_array0
+                = m_active_forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,
                                            access_location::device,
                                            access_mode::read);
@@ -505,21 +766,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = m_active_weights[cur_force];
 
-            if (cur_force + 1 < m_forces.size())
+            if (cur_force + 1 < m_active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array1
-                    = m_forces[cur_force + 1]->getForceArray();
+                    = m_active_forces[cur_force + 1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array1
-                    = m_forces[cur_force + 1]->getVirialArray();
+                    = m_active_forces[cur_force + 1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array1
-                    = m_forces[cur_force + 1]->getTorqueArray();
+                    = m_active_forces[cur_force + 1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,
                                                access_location::device,
                                                access_mode::read);
@@ -527,21 +789,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = m_active_weights[cur_force + 1];
                 }
-            if (cur_force + 2 < m_forces.size())
+            if (cur_force + 2 < m_active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array2
-                    = m_forces[cur_force + 2]->getForceArray();
+                    = m_active_forces[cur_force + 2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array2
-                    = m_forces[cur_force + 2]->getVirialArray();
+                    = m_active_forces[cur_force + 2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array2
-                    = m_forces[cur_force + 2]->getTorqueArray();
+                    = m_active_forces[cur_force + 2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,
                                                access_location::device,
                                                access_mode::read);
@@ -549,21 +812,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = m_active_weights[cur_force + 2];
                 }
-            if (cur_force + 3 < m_forces.size())
+            if (cur_force + 3 < m_active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array3
-                    = m_forces[cur_force + 3]->getForceArray();
+                    = m_active_forces[cur_force + 3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array3
-                    = m_forces[cur_force + 3]->getVirialArray();
+                    = m_active_forces[cur_force + 3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array3
-                    = m_forces[cur_force + 3]->getTorqueArray();
+                    = m_active_forces[cur_force + 3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,
                                                access_location::device,
                                                access_mode::read);
@@ -571,21 +835,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = m_active_weights[cur_force + 3];
                 }
-            if (cur_force + 4 < m_forces.size())
+            if (cur_force + 4 < m_active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array4
-                    = m_forces[cur_force + 4]->getForceArray();
+                    = m_active_forces[cur_force + 4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array4
-                    = m_forces[cur_force + 4]->getVirialArray();
+                    = m_active_forces[cur_force + 4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array4
-                    = m_forces[cur_force + 4]->getTorqueArray();
+                    = m_active_forces[cur_force + 4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,
                                                access_location::device,
                                                access_mode::read);
@@ -593,21 +858,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = m_active_weights[cur_force + 4];
                 }
-            if (cur_force + 5 < m_forces.size())
+            if (cur_force + 5 < m_active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array5
-                    = m_forces[cur_force + 5]->getForceArray();
+                    = m_active_forces[cur_force + 5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array5
-                    = m_forces[cur_force + 5]->getVirialArray();
+                    = m_active_forces[cur_force + 5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array5
-                    = m_forces[cur_force + 5]->getTorqueArray();
+                    = m_active_forces[cur_force + 5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,
                                                access_location::device,
                                                access_mode::read);
@@ -615,6 +881,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = m_active_weights[cur_force + 5];
                 }
 
             // clear on the first iteration only
@@ -643,7 +910,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         }
 
     // add up external virials and energies
-    for (const auto& force : m_forces)
+    for (const auto& force : m_active_forces)
         {
         for (unsigned int k = 0; k < 6; k++)
             external_virial[k] += force->getExternalVirial(k);
@@ -661,18 +928,19 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         m_prof->pop(m_exec_conf);
         }
 
-    // return early if there are no constraint forces or no HalfStepHook set
-    if (m_constraint_forces.size() == 0)
-        return;
-
 #ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
+    // communicate the net force, adding the forces on ghosts to their owners when requested
+    if (m_sysdef->isDomainDecomposed()
+        && (m_constraint_forces.size() > 0 || m_comm->getFlags()[comm_flag::reverse_net_force]))
         {
-        // communicate the net force
         m_comm->updateNetForce(timestep);
         }
 #endif
 
+    // return early if there are no constraint forces or no HalfStepHook set
+    if (m_constraint_forces.size() == 0)
+        return;
+
     // compute all the constraint forces next
     for (auto& constraint_force : m_constraint_forces)
         {
@@ -844,7 +1112,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 }
 
             // clear only on the first iteration AND if there are zero forces
-            bool clear = (cur_force == 0) && (m_forces.size() == 0);
+            bool clear = (cur_force == 0) && (m_active_forces.size() == 0);
 
             // access flags
             PDataFlags flags = this->m_pdata->getFlags();
@@ -904,6 +1172,11 @@ void Integrator::update(uint64_t timestep)
         force->setDeltaT(m_deltaT);
         }
 
+    for (auto& force : m_outer_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(m_deltaT);
@@ -937,6 +1210,14 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
         flags |= force->getRequestedCommFlags(timestep);
         }
 
+    if (isOuterStep(timestep))
+        {
+        for (const auto& force : m_outer_forces)
+            {
+            flags |= force->getRequestedCommFlags(timestep);
+            }
+        }
+
     // query all constraints
     for (const auto& constraint_force : m_constraint_forces)
         {
@@ -949,7 +1230,8 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
 void Integrator::computeCallback(uint64_t timestep)
     {
     // pre-compute all active forces
-    for (auto& force : m_forces)
+    collectActiveForces(timestep);
+    for (auto& force : m_active_forces)
         {
         force->preCompute(timestep);
         }
@@ -965,6 +1247,11 @@ bool Integrator::areForcesAnisotropic()
         aniso |= force->isAnisotropic();
         }
 
+    for (auto& force : m_outer_forces)
+        {
+        aniso |= force->isAnisotropic();
+        }
+
     for (const auto& constraint_force : m_constraint_forces)
         {
         aniso |= constraint_force->isAnisotropic();
@@ -983,5 +1270,10 @@ void export_Integrator(py::module& m)
         .def("updateGroupDOF", &Integrator::updateGroupDOF)
         .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
         .def_property_readonly("forces", &Integrator::getForces)
+        .def_property_readonly("outer_forces", &Integrator::getOuterForces)
+        .def_property("outer_period", &Integrator::getOuterPeriod, &Integrator::setOuterPeriod)
+        .def_property("accumulate_net_force",
+                      &Integrator::getAccumulateNetForce,
+                      &Integrator::setAccumulateNetForce)
         .def_property_readonly("constraints", &Integrator::getConstraintForces);
     }
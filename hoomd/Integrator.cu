@@ -21,6 +21,7 @@ __device__ void add_force_total(Scalar4& net_force,
                                 Scalar* d_v,
                                 const size_t virial_pitch,
                                 Scalar4* d_t,
+                                Scalar s,
                                 int idx)
     {
     if (d_f != NULL && d_v != NULL && d_t != NULL)
@@ -28,9 +29,9 @@ __device__ void add_force_total(Scalar4& net_force,
         Scalar4 f = d_f[idx];
         Scalar4 t = d_t[idx];
 
-        net_force.x += f.x;
-        net_force.y += f.y;
-        net_force.z += f.z;
+        net_force.x += s * f.x;
+        net_force.y += s * f.y;
+        net_force.z += s * f.z;
         net_force.w += f.w;
 
         if (compute_virial)
@@ -39,9 +40,9 @@ __device__ void add_force_total(Scalar4& net_force,
                 net_virial[i] += d_v[i * virial_pitch + idx];
             }
 
-        net_torque.x += t.x;
-        net_torque.y += t.y;
-        net_torque.z += t.z;
+        net_torque.x += s * t.x;
+        net_torque.y += s * t.y;
+        net_torque.z += s * t.z;
         net_torque.w += t.w;
         }
     }
@@ -113,6 +114,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v0,
                                         force_list.vpitch0,
                                         force_list.t0,
+                                        force_list.s0,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -121,6 +123,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v1,
                                         force_list.vpitch1,
                                         force_list.t1,
+                                        force_list.s1,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -129,6 +132,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v2,
                                         force_list.vpitch2,
                                         force_list.t2,
+                                        force_list.s2,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -137,6 +141,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v3,
                                         force_list.vpitch3,
                                         force_list.t3,
+                                        force_list.s3,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -145,6 +150,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v4,
                                         force_list.vpitch4,
                                         force_list.t4,
+                                        force_list.s4,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -153,6 +159,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v5,
                                         force_list.vpitch5,
                                         force_list.t5,
+                                        force_list.s5,
                                         idx);
 
         // write out the final result
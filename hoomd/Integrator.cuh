@@ -19,6 +19,9 @@
    are packed up in this struct for addition to the net force/virial in a single kernel call. If
    there is not a multiple of 5 forces to sum, set some of the pointers to NULL and they will be
    ignored.
+
+    The forces and torques of each array are multiplied by its weight s0 through s5 before they are
+   added. Energies and virials are added unscaled.
 */
 struct gpu_force_list
     {
@@ -26,7 +29,8 @@ struct gpu_force_list
     gpu_force_list()
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL), t0(NULL), t1(NULL), t2(NULL),
           t3(NULL), t4(NULL), t5(NULL), v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0), s0(1.0), s1(1.0),
+          s2(1.0), s3(1.0), s4(1.0), s5(1.0)
         {
         }
 
@@ -57,6 +61,13 @@ struct gpu_force_list
     size_t vpitch3; //!< Pitch of virial array 3
     size_t vpitch4; //!< Pitch of virial array 4
     size_t vpitch5; //!< Pitch of virial array 5
+
+    Scalar s0; //!< Weight of force and torque array 0
+    Scalar s1; //!< Weight of force and torque array 1
+    Scalar s2; //!< Weight of force and torque array 2
+    Scalar s3; //!< Weight of force and torque array 3
+    Scalar s4; //!< Weight of force and torque array 4
+    Scalar s5; //!< Weight of force and torque array 5
     };
 
 //! Driver for gpu_integrator_sum_net_force_kernel()
@@ -21,6 +21,8 @@
 #include <hip/hip_runtime.h>
 #endif
 
+#include "ClockSource.h"
+
 /// Base class that defines an integrator
 /** An Integrator steps the entire simulation forward one time step in time.
     Prior to calling update(timestep), the system is at time step \a timestep.
@@ -44,6 +46,12 @@
     convenience in derived classes implementing correct counting in getTranslationalDOF() and
     getRotationalDOF().
 
+    Forces in m_outer_forces are evaluated only every m_outer_period time steps, on the steps that
+    are a multiple of the period. Their forces and torques are scaled by the period on those steps
+    and left out on the others. With a velocity Verlet method this applies the outer forces as
+    impulses at the end of each outer step, which is the impulse (Verlet-I / r-RESPA) multiple time
+    step scheme. Their energies and virials are summed unscaled, and only on the outer steps.
+
     Integrators take "ownership" of the particle's accelerations. Any other updater that modifies
     the particles accelerations will produce undefined results. If accelerations are to be modified,
     they must be done through forces, and added to an Integrator via the m_forces std::vector.
@@ -74,6 +82,41 @@ class PYBIND11_EXPORT Integrator : public Updater
         return m_forces;
         }
 
+    /// Get the list of force computes evaluated every outer period
+    std::vector<std::shared_ptr<ForceCompute>>& getOuterForces()
+        {
+        return m_outer_forces;
+        }
+
+    /// Set the number of time steps between evaluations of the outer forces
+    void setOuterPeriod(unsigned int period)
+        {
+        if (period == 0)
+            throw std::domain_error("outer_period must be positive");
+        m_outer_period = period;
+        }
+
+    /// Get the number of time steps between evaluations of the outer forces
+    unsigned int getOuterPeriod() const
+        {
+        return m_outer_period;
+        }
+
+    /// Set whether forces add to the net force directly
+    /** @param accumulate When true, force computes that support it add their forces to the net
+        force arrays on the steps where no operation requests pdata_flag::force_arrays.
+    */
+    void setAccumulateNetForce(bool accumulate)
+        {
+        m_accumulate_net_force = accumulate;
+        }
+
+    /// Get whether forces add to the net force directly
+    bool getAccumulateNetForce() const
+        {
+        return m_accumulate_net_force;
+        }
+
     /// Get the list of force computes
     std::vector<std::shared_ptr<ForceConstraint>>& getConstraintForces()
         {
@@ -129,11 +172,57 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Prepare for the run
     virtual void prepRun(uint64_t timestep);
 
+    /// Test whether System::run() should return before completing the requested steps
+    /*! System checks this after each step. Integrators that reach a final state, such as a converged
+        energy minimization, override it.
+    */
+    virtual bool isRunComplete()
+        {
+        return false;
+        }
+
+    using Updater::getRequestedPDataFlags;
+
+    /// Get needed pdata flags on a given time step
+    /*! \param timestep Time step the flags are needed on
+
+        System sets the flags for each step from this method. Integrators that need some fields
+        only on some steps override it. The default returns getRequestedPDataFlags().
+    */
+    virtual PDataFlags getRequestedPDataFlags(uint64_t timestep)
+        {
+        return getRequestedPDataFlags();
+        }
+
 #ifdef ENABLE_MPI
     /// Callback for pre-computing the forces
     void computeCallback(uint64_t timestep);
 #endif
 
+    /// Enable or disable timing of the force computes
+    /** @param enable Set to true to accumulate the time spent in ForceCompute::compute()
+
+        When the GPU is active, timing synchronizes with the device after every force compute.
+    */
+    void setForceTiming(bool enable)
+        {
+        m_force_timing = enable;
+        }
+
+    /// Get whether the force computes are timed
+    bool getForceTiming() const
+        {
+        return m_force_timing;
+        }
+
+    /// Get the time spent computing forces (including neighbor lists) on this rank
+    /** @returns Accumulated time in nanoseconds while force timing was enabled
+     */
+    int64_t getForceTime() const
+        {
+        return m_force_time;
+        }
+
     protected:
     /// The step size
     Scalar m_deltaT;
@@ -141,9 +230,39 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// List of all the force computes
     std::vector<std::shared_ptr<ForceCompute>> m_forces;
 
+    /// List of the force computes evaluated every outer period
+    std::vector<std::shared_ptr<ForceCompute>> m_outer_forces;
+
+    /// Number of time steps between evaluations of the outer forces
+    unsigned int m_outer_period = 1;
+
     /// List of all the constraints
     std::vector<std::shared_ptr<ForceConstraint>> m_constraint_forces;
 
+    /// Force computes evaluated at the current time step
+    std::vector<std::shared_ptr<ForceCompute>> m_active_forces;
+
+    /// Weights of the forces in m_active_forces
+    std::vector<Scalar> m_active_weights;
+
+    /// True when force computes that support it add their forces to the net force directly
+    bool m_accumulate_net_force = false;
+
+    /// Flags the forces in m_active_forces that added their forces to the net force directly
+    std::vector<char> m_active_in_net;
+
+    /// Flags the forces in m_active_forces that are computed concurrently
+    std::vector<char> m_active_concurrent;
+
+    /// Test if the outer forces are evaluated at a time step
+    bool isOuterStep(uint64_t timestep) const
+        {
+        return timestep % m_outer_period == 0;
+        }
+
+    /// Fill m_active_forces and m_active_weights with the forces evaluated at a time step
+    void collectActiveForces(uint64_t timestep);
+
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
@@ -153,6 +272,25 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// helper function to compute net force/virial
     virtual void computeNetForce(uint64_t timestep);
 
+    /// helper function to compute one force, timing it when force timing is enabled
+    bool computeForce(ForceCompute& force, uint64_t timestep, bool into_net = false);
+
+#ifdef ENABLE_TBB
+    /// helper function to compute the forces flagged in m_active_concurrent concurrently
+    void computeConcurrentForces(uint64_t timestep);
+#endif
+
+    /// Start timing work that is counted in the force time
+    /** @returns Start time to pass to stopForceTimer()
+     */
+    int64_t startForceTimer() const
+        {
+        return m_force_clock.getTime();
+        }
+
+    /// Stop timing work that is counted in the force time and add it to the force time
+    void stopForceTimer(int64_t start);
+
 #ifdef ENABLE_HIP
     /// helper function to compute net force/virial on the GPU
     virtual void computeNetForceGPU(uint64_t timestep);
@@ -168,6 +306,16 @@ class PYBIND11_EXPORT Integrator : public Updater
 
     /// Check if any forces introduce anisotropic degrees of freedom
     virtual bool areForcesAnisotropic();
+
+    private:
+    /// Clock used to time the force computes
+    ClockSource m_force_clock;
+
+    /// True when the force computes are timed
+    bool m_force_timing = false;
+
+    /// Accumulated time spent in the force computes (ns)
+    int64_t m_force_time = 0;
     };
 
 /// Exports the NVEUpdater class to python
@@ -0,0 +1,171 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LatticeGenerator.cc
+    \brief Defines the LatticeGenerator class
+*/
+
+#include "LatticeGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+LatticeGenerator::LatticeGenerator(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                   py::list positions,
+                                   py::list typeids,
+                                   unsigned int nx,
+                                   unsigned int ny,
+                                   unsigned int nz)
+    : m_exec_conf(exec_conf), m_n {nx, ny, nz}
+    {
+    if (positions.size() != typeids.size())
+        {
+        throw std::invalid_argument("The number of type ids must match the number of sites.");
+        }
+    if (positions.size() == 0 || nx == 0 || ny == 0 || nz == 0)
+        {
+        throw std::invalid_argument("The lattice must have at least one particle.");
+        }
+
+    for (unsigned int b = 0; b < positions.size(); b++)
+        {
+        py::tuple p = py::cast<py::tuple>(positions[b]);
+        if (p.size() != 3)
+            throw std::invalid_argument("Site positions must have 3 elements.");
+
+        Scalar3 f = make_scalar3(p[0].cast<Scalar>(), p[1].cast<Scalar>(), p[2].cast<Scalar>());
+        if (f.x < 0 || f.x >= 1 || f.y < 0 || f.y >= 1 || f.z < 0 || f.z >= 1)
+            {
+            throw std::invalid_argument(
+                "Site positions must be fractional coordinates in the range [0, 1).");
+            }
+        m_positions.push_back(f);
+        m_typeids.push_back(typeids[b].cast<unsigned int>());
+        }
+
+    uint64_t N = uint64_t(nx) * ny * nz * m_positions.size();
+    if (N > std::numeric_limits<unsigned int>::max())
+        {
+        std::ostringstream s;
+        s << "The lattice has " << N << " particles, which is more than the supported maximum.";
+        throw std::invalid_argument(s.str());
+        }
+    m_N_global = (unsigned int)N;
+    }
+
+/*! \param sysdef System definition with the global box and particle types of the lattice
+
+    Collective call. With domain decomposition, each rank loops over the unit cells that overlap
+    its domain and keeps the sites that DomainDecomposition::placeParticle() assigns to it, which is
+    exactly the assignment an initialization from a snapshot would make.
+*/
+void LatticeGenerator::initializeLocal(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const BoxDim global_box = pdata->getGlobalBox();
+    bool is_2d = sysdef->getNDimensions() == 2;
+
+    for (unsigned int type : m_typeids)
+        {
+        if (type >= pdata->getNTypes())
+            {
+            std::ostringstream s;
+            s << "Particle typeid " << type << " is invalid in a system with "
+              << pdata->getNTypes() << " types.";
+            throw std::runtime_error(s.str());
+            }
+        }
+    if (is_2d && m_n[2] != 1)
+        {
+        throw std::runtime_error("2D lattices must have 1 unit cell in the z direction.");
+        }
+
+    // range of unit cells to consider on this rank
+    unsigned int lo[3] = {0, 0, 0};
+    unsigned int hi[3] = {m_n[0], m_n[1], m_n[2]};
+
+#ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    unsigned int rank = m_exec_conf->getRank();
+    std::vector<unsigned int> cart_ranks;
+    if (decomposition)
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+        cart_ranks.assign(h_cart_ranks.data,
+                          h_cart_ranks.data + decomposition->getDomainIndexer().getNumElements());
+
+        uint3 grid_pos = decomposition->getGridPos();
+        unsigned int pos[3] = {grid_pos.x, grid_pos.y, grid_pos.z};
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            // extend the range by one cell so that rounding cannot drop sites near a boundary
+            Scalar f_lo = decomposition->getCumulativeFraction(dir, pos[dir]);
+            Scalar f_hi = decomposition->getCumulativeFraction(dir, pos[dir] + 1);
+            int cell_lo = int(std::floor(f_lo * m_n[dir])) - 1;
+            int cell_hi = int(std::ceil(f_hi * m_n[dir])) + 1;
+            lo[dir] = (unsigned int)std::max(cell_lo, 0);
+            hi[dir] = (unsigned int)std::min(cell_hi, int(m_n[dir]));
+            }
+        }
+#endif
+
+    unsigned int n_sites = (unsigned int)m_positions.size();
+    std::vector<pdata_element> particles;
+    for (unsigned int k = lo[2]; k < hi[2]; k++)
+        for (unsigned int j = lo[1]; j < hi[1]; j++)
+            for (unsigned int i = lo[0]; i < hi[0]; i++)
+                for (unsigned int b = 0; b < n_sites; b++)
+                    {
+                    const Scalar3& site = m_positions[b];
+                    Scalar3 f = make_scalar3((Scalar(i) + site.x) / Scalar(m_n[0]),
+                                             (Scalar(j) + site.y) / Scalar(m_n[1]),
+                                             (Scalar(k) + site.z) / Scalar(m_n[2]));
+                    Scalar3 pos = global_box.makeCoordinates(f);
+                    if (is_2d)
+                        pos.z = 0;
+
+                    int3 image = make_int3(0, 0, 0);
+                    global_box.wrap(pos, image);
+
+#ifdef ENABLE_MPI
+                    if (decomposition
+                        && decomposition->placeParticle(global_box, pos, cart_ranks.data())
+                               != rank)
+                        {
+                        continue;
+                        }
+#endif
+
+                    pdata_element p = {};
+                    p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(m_typeids[b]));
+                    p.vel = make_scalar4(0, 0, 0, 1);
+                    p.diameter = 1;
+                    p.image = image;
+                    p.body = NO_BODY;
+                    p.orientation = make_scalar4(1, 0, 0, 0);
+                    p.tag = ((k * m_n[1] + j) * m_n[0] + i) * n_sites + b;
+                    particles.push_back(p);
+                    }
+
+    pdata->initializeFromLocalParticles(particles, m_N_global, false);
+    }
+
+void export_LatticeGenerator(py::module& m)
+    {
+    py::class_<LatticeGenerator, std::shared_ptr<LatticeGenerator>>(m, "LatticeGenerator")
+        .def(py::init<std::shared_ptr<const ExecutionConfiguration>,
+                      py::list,
+                      py::list,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int>())
+        .def("getNGlobal", &LatticeGenerator::getNGlobal)
+        .def("initializeLocal", &LatticeGenerator::initializeLocal);
+    }
@@ -0,0 +1,66 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file LatticeGenerator.h
+    \brief Declares the LatticeGenerator class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "SystemDefinition.h"
+
+#include <pybind11/pybind11.h>
+#include <vector>
+
+//! Place particles on a lattice directly in the domains of the ranks
+/*! The lattice is the unit cell replicated nx, ny, and nz times along its lattice vectors, so the
+    global box is the unit cell with its lengths multiplied by nx, ny, and nz and the same tilt
+    factors. The sites of the unit cell are given in fractional coordinates of the unit cell.
+
+    Put the state together from a snapshot that holds the global box and the type names but no
+    particles, then call initializeLocal(). Each rank generates only the sites in its own domain,
+    so no particle data is communicated and no rank holds all of the particles. The particle at
+    site b of cell (i, j, k) has the tag ((k * ny + j) * nx + i) * n_sites + b, the same order as a
+    snapshot that loops over the cells with i fastest.
+*/
+class PYBIND11_EXPORT LatticeGenerator
+    {
+    public:
+    //! Constructor
+    /*! \param exec_conf Execution configuration
+        \param positions Fractional coordinates of the sites in the unit cell
+        \param typeids Type id of the particle at each site
+        \param nx Number of unit cells along the first lattice vector
+        \param ny Number of unit cells along the second lattice vector
+        \param nz Number of unit cells along the third lattice vector
+    */
+    LatticeGenerator(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                     pybind11::list positions,
+                     pybind11::list typeids,
+                     unsigned int nx,
+                     unsigned int ny,
+                     unsigned int nz);
+
+    //! Get the global number of particles
+    unsigned int getNGlobal() const
+        {
+        return m_N_global;
+        }
+
+    //! Place the particles of the local domain
+    void initializeLocal(std::shared_ptr<SystemDefinition> sysdef);
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+    std::vector<Scalar3> m_positions;                          //!< Fractional site coordinates
+    std::vector<unsigned int> m_typeids;                       //!< Type id of each site
+    unsigned int m_n[3];                                       //!< Number of unit cells
+    unsigned int m_N_global;                                   //!< Global number of particles
+    };
+
+//! Exports LatticeGenerator to python
+void export_LatticeGenerator(pybind11::module& m);
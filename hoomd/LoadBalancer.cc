@@ -9,6 +9,8 @@
 
 #include "LoadBalancer.h"
 #include "Communicator.h"
+#include "Integrator.h"
+#include "System.h"
 
 #include "hoomd/extern/BVLSSolver.h"
 #include <Eigen/Dense>
@@ -34,8 +36,10 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
       m_mpi_comm(m_exec_conf->getMPICommunicator()),
 #endif
       m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
-      m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-      m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
+      m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_time_cost(false),
+      m_max_scale(Scalar(0.05)), m_N_own(m_pdata->getN()), m_N_own_particles(0),
+      m_weight(Scalar(1.0)),
+      m_last_force_time(0), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
       m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
@@ -67,6 +71,27 @@ LoadBalancer::~LoadBalancer()
     m_exec_conf->msg->notice(5) << "Destroying LoadBalancer" << endl;
     }
 
+void LoadBalancer::setCost(const std::string& cost)
+    {
+    if (cost == "particles")
+        {
+        m_time_cost = false;
+
+        // stop timing the forces
+        if (auto integrator = m_timed_integrator.lock())
+            integrator->setForceTiming(false);
+        m_timed_integrator.reset();
+        }
+    else if (cost == "time")
+        {
+        m_time_cost = true;
+        }
+    else
+        {
+        throw std::invalid_argument("Invalid load balancing cost: " + cost);
+        }
+    }
+
 /*!
  * \param timestep Current time step of the simulation
  *
@@ -86,7 +111,8 @@ void LoadBalancer::update(uint64_t timestep)
         m_prof->push(m_exec_conf, "balance");
 
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
-    resetNOwn(m_pdata->getN());
+    resetNOwn(m_pdata->getN(), (m_particles) ? m_particles->getN() : 0);
+    updateWeight();
 
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
@@ -101,8 +127,10 @@ void LoadBalancer::update(uint64_t timestep)
     // get the minimum domain size
     const BoxDim& box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
-    const Scalar3 min_domain_frac
-        = Scalar(2.0) * m_comm->getGhostLayerMaxWidth() / box.getNearestPlaneDistance();
+    Scalar min_domain_width = Scalar(2.0) * m_comm->getGhostLayerMaxWidth();
+    if (m_particles)
+        min_domain_width = std::max(min_domain_width, m_particles->getMinDomainWidth());
+    const Scalar3 min_domain_frac = min_domain_width / box.getNearestPlaneDistance();
 
     // compute the current imbalance always for the average in printed stats
     m_total_max_imbalance += getMaxImbalance();
@@ -143,10 +171,10 @@ void LoadBalancer::update(uint64_t timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> N_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
+            // reduce the load in the slice along dim
             bool active = reduce(N_i, dim, reduce_root);
 
             // attempt an adjustment
@@ -169,11 +197,12 @@ void LoadBalancer::update(uint64_t timestep)
             }
 
         // force a particle migration if one is needed
+        // the other particles are migrated by their module, so keep their counted number
         if (m_needs_migrate)
             {
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
-            resetNOwn(m_pdata->getN());
+            resetNOwn(m_pdata->getN(), m_N_own_particles);
             m_needs_migrate = false;
 
             // increment the number of rebalances actually performed
@@ -190,14 +219,21 @@ void LoadBalancer::update(uint64_t timestep)
 
 /*!
  * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all
- * ranks.
+ * ranks. N is the number of MD particles plus the weighted number of other particles on the rank.
+ * With the "time" cost, N is further multiplied by the weight of the particles on the rank.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar load = getLoad();
+        Scalar total_load = getParticleLoad(m_pdata->getNGlobal(),
+                                            (m_particles) ? m_particles->getNGlobal() : 0);
+        if (m_time_cost)
+            {
+            MPI_Allreduce(&load, &total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+            }
+        Scalar cur_imb = load / (total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -212,12 +248,65 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * With the "time" cost, sets the weight of the particles on this rank to the force compute time
+ * per particle since the previous call, divided by the average time per particle over all ranks.
+ * The other particles count as their weighted number of MD particles.
+ * The weight is 1 with the "particles" cost, and until every rank has timed the forces of the
+ * current Integrator for at least one step.
+ *
+ * \note All ranks must call updateWeight() since it involves collective MPI calls.
+ */
+void LoadBalancer::updateWeight()
+    {
+    m_weight = Scalar(1.0);
+    if (!m_time_cost)
+        return;
+
+    std::shared_ptr<Integrator> integrator;
+    if (auto system = m_system.lock())
+        integrator = system->getIntegrator();
+
+    // time spent in the forces since the last update, negative when not measured
+    double elapsed = -1.0;
+    if (integrator)
+        {
+        if (integrator == m_timed_integrator.lock())
+            {
+            elapsed = double(integrator->getForceTime() - m_last_force_time);
+            }
+        else
+            {
+            // start timing a new integrator
+            if (auto old_integrator = m_timed_integrator.lock())
+                old_integrator->setForceTiming(false);
+            integrator->setForceTiming(true);
+            m_timed_integrator = integrator;
+            }
+        m_last_force_time = integrator->getForceTime();
+        }
+
+    double min_elapsed(0.0), total_elapsed(0.0);
+    MPI_Allreduce(&elapsed, &min_elapsed, 1, MPI_DOUBLE, MPI_MIN, m_mpi_comm);
+    if (min_elapsed <= 0.0)
+        return;
+    MPI_Allreduce(&elapsed, &total_elapsed, 1, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+
+    const Scalar N = getParticleLoad(m_pdata->getN(), m_N_own_particles);
+    const Scalar N_global = getParticleLoad(m_pdata->getNGlobal(),
+                                            (m_particles) ? m_particles->getNGlobal() : 0);
+    if (N > Scalar(0.0))
+        {
+        m_weight = Scalar((elapsed / double(N)) / (total_elapsed / double(N_global)));
+        }
+    }
+
+/*!
+ * \param N_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
  * \returns true if the current rank holds the active \a N_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a N_i holds the (weighted) number of particles in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for
  * efficiency the data will be active only on Cartesian rank \a reduce_root, as indicated by the
@@ -228,7 +317,7 @@ Scalar LoadBalancer::getMaxImbalance()
  * replaced by cascading send operations down dimensions. Generally, load balancing should not be
  * performed too frequently, and so we do not pursue this optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
+bool LoadBalancer::reduce(std::vector<Scalar>& N_i,
                           unsigned int dim,
                           unsigned int reduce_root)
     {
@@ -237,12 +326,19 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
         return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> N_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    Scalar N_own = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&N_own,
+               1,
+               MPI_HOOMD_SCALAR,
+               &N_per_rank[0],
+               1,
+               MPI_HOOMD_SCALAR,
+               reduce_root,
+               m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -252,7 +348,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> N_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
         {
         N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
@@ -265,7 +361,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
         N_i.resize(di.getW());
         for (unsigned int i = 0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            N_i[i] = Scalar(0.0);
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int j = 0; j < di.getH(); ++j)
@@ -281,7 +377,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
         N_i.resize(di.getH());
         for (unsigned int j = 0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            N_i[j] = Scalar(0.0);
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
@@ -297,7 +393,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
         N_i.resize(di.getD());
         for (unsigned int k = 0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            N_i[k] = Scalar(0.0);
             for (unsigned int j = 0; j < di.getH(); ++j)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
@@ -319,7 +415,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param N_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -334,19 +430,21 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
  * minimum domain size through a slack variable w. Additional box constraints are enforced on the
  * new positions of the domain slices.
  *  3. Minimize the cost function using bounded variable least-squares (BVLSSolver).
- *  4. Sanity check the adjustment. Domains must be big enough and cannot have inverted. If the
+ *  4. Round the domain boundaries to the grid of the particles set with setParticles(), if it has
+ * one. The maximum rescaling of a domain is increased to one grid spacing if that is larger.
+ *  5. Sanity check the adjustment. Domains must be big enough and cannot have inverted. If the
  * minimization was successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& N_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const Scalar target = std::accumulate(N_i.begin(), N_i.end(), Scalar(0.0)) / Scalar(N_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -356,32 +454,40 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
         return false;
         }
 
+    // spacing of the grid the boundaries are placed on
+    const Scalar grid_spacing = (m_particles) ? m_particles->getGridSpacing() : Scalar(0.0);
+
     // imbalance factors for each rank
     vector<Scalar> new_widths(N_i.size());
     for (unsigned int i = 0; i < N_i.size(); ++i)
         {
+        const Scalar width = (cum_frac_i[i + 1] - cum_frac_i[i]) * L_i;
+
+        // a domain on a grid must be able to change by at least one grid spacing
+        const Scalar max_scale = std::max(m_max_scale, grid_spacing / width);
+
         const Scalar imb_factor = Scalar(N_i[i]) / target;
         Scalar scale_factor
-            = (N_i[i] > 0)
+            = (N_i[i] > Scalar(0.0))
                   ? Scalar(1.0) / imb_factor
                   : (Scalar(1.0)
-                     + m_max_scale); // as in gromacs, use half the imbalance factor to scale
+                     + max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated
         // systems
-        if (scale_factor > (Scalar(1.0) + m_max_scale))
+        if (scale_factor > (Scalar(1.0) + max_scale))
             {
-            scale_factor = (Scalar(1.0) + m_max_scale);
+            scale_factor = (Scalar(1.0) + max_scale);
             }
-        else if (scale_factor < (Scalar(1.0) - m_max_scale))
+        else if (scale_factor < (Scalar(1.0) - max_scale))
             {
-            scale_factor = (Scalar(1.0) - m_max_scale);
+            scale_factor = (Scalar(1.0) - max_scale);
             }
 
         // compute the new domain width (can't be smaller than the threshold, if it is, this is not
         // a free variable)
-        new_widths[i] = scale_factor * (cum_frac_i[i + 1] - cum_frac_i[i]) * L_i;
+        new_widths[i] = scale_factor * width;
         }
 
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to
@@ -435,6 +541,35 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
         if (solver.converged())
             {
             Eigen::VectorXd x = solver.getSolution();
+
+            // round the boundaries to the grid, and stop if none of them moved
+            if (grid_spacing > Scalar(0.0))
+                {
+                bool moved = false;
+                for (unsigned int cur_div = 0; cur_div < n; ++cur_div)
+                    {
+                    x(cur_div) = std::round(x(cur_div) / grid_spacing) * grid_spacing;
+                    if (std::abs(x(cur_div) - cum_frac_i[cur_div + 1] * L_i)
+                        > Scalar(1e-6) * grid_spacing)
+                        moved = true;
+                    }
+                if (!moved)
+                    return false;
+
+                // rounding can make a domain smaller than the minimum
+                for (unsigned int i = 0; i < m; ++i)
+                    {
+                    const Scalar lo = (i > 0) ? x(i - 1) : Scalar(0.0);
+                    const Scalar hi = (i < n) ? x(i) : L_i;
+                    if (hi - lo < min_frac_i * L_i)
+                        {
+                        m_exec_conf->msg->warning()
+                            << "comm.balance: no convergence, domains too small" << endl;
+                        return false;
+                        }
+                    }
+                }
+
             vector<Scalar> sorted_f(n);
             // do validation / sanity checking
             for (unsigned int cur_div = 0; cur_div < n; ++cur_div)
@@ -478,10 +613,14 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
 
 /*!
  * \param cnts Map holding result of number of particles on each rank that neighbors the local rank
+ * \param pos Positions of the particles
+ * \param N Number of particles owned by this rank
  */
-void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts)
+void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts,
+                                         const GlobalArray<Scalar4>& pos,
+                                         unsigned int N)
     {
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos(pos, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
                                            access_location::host,
                                            access_mode::read);
@@ -490,7 +629,7 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
     const Index3D& di = m_decomposition->getDomainIndexer();
     const uint3 rank_pos = m_decomposition->getGridPos();
 
-    for (unsigned int cur_p = 0; cur_p < m_pdata->getN(); ++cur_p)
+    for (unsigned int cur_p = 0; cur_p < N; ++cur_p)
         {
         const Scalar4 cur_postype = h_pos.data[cur_p];
         const Scalar3 cur_pos = make_scalar3(cur_postype.x, cur_postype.y, cur_postype.z);
@@ -558,7 +697,8 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
 /*!
  * Each rank calls countParticlesOffRank() to count the number of particles to send to other ranks.
  * Neighboring ranks then perform send/receive calls, and count the new number of particles they own
- * as the number they owned locally plus the number received minus the number sent.
+ * as the number they owned locally plus the number received minus the number sent. The MD particles
+ * and the particles set with setParticles() are counted separately.
  *
  * \note All ranks must participate in this call since it involves send/receive operations between
  * neighboring domains.
@@ -570,18 +710,36 @@ void LoadBalancer::computeOwnedParticles()
         return;
 
     // count the particles that are off the rank
-    ArrayHandle<unsigned int> h_unique_neigh(m_comm->getUniqueNeighbors(),
-                                             access_location::host,
-                                             access_mode::read);
-
-    // fill the map initially to zeros (not necessary since should be auto-initialized to zero, but
-    // just playing it safe)
     std::map<unsigned int, unsigned int> cnts;
-    for (unsigned int i = 0; i < m_comm->getNUniqueNeighbors(); ++i)
+    countParticlesOffRank(cnts, m_pdata->getPositions(), m_pdata->getN());
+    const unsigned int N_own = exchangeParticleCounts(m_pdata->getN(), cnts);
+
+    unsigned int N_own_particles = 0;
+    if (m_particles)
         {
-        cnts[h_unique_neigh.data[i]] = 0;
+        std::map<unsigned int, unsigned int> particle_cnts;
+        countParticlesOffRank(particle_cnts, m_particles->getPositions(), m_particles->getN());
+        N_own_particles = exchangeParticleCounts(m_particles->getN(), particle_cnts);
         }
-    countParticlesOffRank(cnts);
+
+    // set the count
+    resetNOwn(N_own, N_own_particles);
+    }
+
+/*!
+ * \param N Number of particles owned by this rank before the adjustment
+ * \param cnts Number of particles that go to each neighboring rank
+ * \returns Number of particles owned by this rank after the adjustment
+ *
+ * \note All ranks must participate in this call since it involves send/receive operations between
+ * neighboring domains.
+ */
+unsigned int LoadBalancer::exchangeParticleCounts(unsigned int N,
+                                                  std::map<unsigned int, unsigned int>& cnts)
+    {
+    ArrayHandle<unsigned int> h_unique_neigh(m_comm->getUniqueNeighbors(),
+                                             access_location::host,
+                                             access_mode::read);
 
     MPI_Request req[2 * m_comm->getNUniqueNeighbors()];
     MPI_Status stat[2 * m_comm->getNUniqueNeighbors()];
@@ -612,15 +770,14 @@ void LoadBalancer::computeOwnedParticles()
     MPI_Waitall(nreq, req, stat);
 
     // reduce the particles sent to me
-    int N_own = m_pdata->getN();
+    int N_own = N;
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         N_own += n_recv_ptls[cur_neigh];
         N_own -= n_send_ptls[cur_neigh];
         }
 
-    // set the count
-    resetNOwn(N_own);
+    return N_own;
     }
 
 #endif // ENABLE_MPI
@@ -637,6 +794,10 @@ void LoadBalancer::resetStats()
 
 void export_LoadBalancer(py::module& m)
     {
+    py::class_<LoadBalancerParticles, std::shared_ptr<LoadBalancerParticles>>(
+        m,
+        "LoadBalancerParticles");
+
     py::class_<LoadBalancer, Tuner, std::shared_ptr<LoadBalancer>>(m, "LoadBalancer")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<Trigger>>())
         .def_property("tolerance", &LoadBalancer::getTolerance, &LoadBalancer::setTolerance)
@@ -645,5 +806,8 @@ void export_LoadBalancer(py::module& m)
                       &LoadBalancer::setMaxIterations)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
-        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
+        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+        .def_property("cost", &LoadBalancer::getCost, &LoadBalancer::setCost)
+        .def("setSystem", &LoadBalancer::setSystem)
+        .def("setParticles", &LoadBalancer::setParticles);
     }
@@ -12,6 +12,7 @@
 #endif
 
 #pragma once
+#include "GlobalArray.h"
 #include "Trigger.h"
 #include "Tuner.h"
 
@@ -21,19 +22,70 @@
 #include <string>
 #include <vector>
 
+class Integrator;
+class System;
+
+//! Particles outside of the ParticleData that are balanced together with the MD particles
+/*!
+ * Modules that hold their own particles (like the MPCD solvent) implement this interface so that
+ * the LoadBalancer counts their particles in the load of each rank. The particles must belong to
+ * the rank whose domain contains them, and are migrated by their module after the domains change.
+ */
+class PYBIND11_EXPORT LoadBalancerParticles
+    {
+    public:
+    //! Destructor
+    virtual ~LoadBalancerParticles() { }
+
+    //! Get the positions of the particles
+    virtual const GlobalArray<Scalar4>& getPositions() = 0;
+
+    //! Get the number of particles owned by this rank
+    virtual unsigned int getN() = 0;
+
+    //! Get the number of particles owned by all ranks
+    virtual unsigned int getNGlobal() = 0;
+
+    //! Get the cost of one particle relative to one MD particle
+    virtual Scalar getWeight() = 0;
+
+    //! Get the spacing of the grid that the domain boundaries are placed on, or 0 for no grid
+    /*!
+     * The grid starts from the lower bound of the global box.
+     */
+    virtual Scalar getGridSpacing() = 0;
+
+    //! Get the minimum width of a domain
+    virtual Scalar getMinDomainWidth() = 0;
+    };
+
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between
  * them. The load imbalance is defined as the number of particles owned by a rank divided by the
  * average number of particles per rank if the particles had a uniform distribution.
  *
+ * With the "time" cost, each particle is instead weighted by the time per particle this rank spent
+ * in the force computes (including the neighbor list) since the previous update, measured through
+ * the Integrator of the System set with setSystem(). The weights are normalized by the global
+ * average time per particle, and the load imbalance is the weighted number of particles owned by a
+ * rank divided by the average over all ranks.
+ *
+ * Particles that are not MD particles, like the MPCD solvent, are added to the load with
+ * setParticles(). Each of them counts as LoadBalancerParticles::getWeight() MD particles, and with
+ * the "time" cost, the weight per particle of the rank multiplies their load too.
+ *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load
  * balance, subject to the following constraints that are imposed to both maintain a stable
  * balancing and to keep communication isolated to the 26 nearest neighbors of a cell:
  *  1. No domain may move more than half its neighboring domains.
- *  2. No domain may be smaller than the minimum size set by the ghost layer.
+ *  2. No domain may be smaller than the minimum size set by the ghost layer, or the minimum width
+ *     of the particles set with setParticles().
  *  3. A domain should change size by at most approximately 5% in a single rescaling.
  *
+ * When the particles set with setParticles() have a grid spacing, the domain boundaries are rounded
+ * to the grid, and a domain may change size by one grid spacing when that is more than 5%.
+ *
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost
  * function is the deviation of the domain sizes from the proposed rescaled width.
  *
@@ -101,6 +153,34 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
             }
         }
 
+    //! Set the cost that is balanced
+    /*!
+     * \param cost "particles" to balance the number of particles, "time" to balance the measured
+     * force compute time
+     */
+    void setCost(const std::string& cost);
+
+    //! Get the cost that is balanced
+    std::string getCost() const
+        {
+        return m_time_cost ? "time" : "particles";
+        }
+
+    //! Set the System whose Integrator is timed for the "time" cost
+    void setSystem(std::shared_ptr<System> system)
+        {
+        m_system = system;
+        }
+
+    //! Set additional particles to balance together with the MD particles
+    /*!
+     * \param particles Particles to balance, or nullptr to balance only the MD particles
+     */
+    void setParticles(std::shared_ptr<LoadBalancerParticles> particles)
+        {
+        m_particles = particles;
+        }
+
     /// Set m_enable_x
     void setEnableX(bool enable)
         {
@@ -156,8 +236,11 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     //! Computes the maximum imbalance factor
     Scalar getMaxImbalance();
 
-    //! Reduce the particle numbers per rank down to one dimension
-    bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+    //! Update the cost per particle of this rank from the measured force compute time
+    void updateWeight();
+
+    //! Reduce the load per rank down to one dimension
+    bool reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root);
 
     //! Set flags within the class that a resize has been performed
     void signalResize()
@@ -169,7 +252,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     //! Adjust the partitioning along a single dimension
     bool adjust(std::vector<Scalar>& cum_frac_i,
-                const std::vector<unsigned int>& N_i,
+                const std::vector<Scalar>& N_i,
                 Scalar L_i,
                 Scalar min_domain_frac);
 
@@ -177,7 +260,13 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     void computeOwnedParticles();
 
     //! Count the number of particles that have gone off the rank
-    virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts);
+    virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts,
+                                       const GlobalArray<Scalar4>& pos,
+                                       unsigned int N);
+
+    //! Exchange the particles counted off the rank with the neighbors
+    unsigned int exchangeParticleCounts(unsigned int N,
+                                        std::map<unsigned int, unsigned int>& cnts);
 
     //! Gets the number of owned particles, updating if necessary
     unsigned int getNOwn()
@@ -186,18 +275,38 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         return m_N_own;
         }
 
+    //! Gets the load of this rank, the weighted number of owned particles
+    Scalar getLoad()
+        {
+        computeOwnedParticles();
+        return getParticleLoad(m_N_own, m_N_own_particles) * m_weight;
+        }
+
+    //! Get the number of MD particles that a number of MD particles and other particles counts as
+    Scalar getParticleLoad(unsigned int N, unsigned int N_particles)
+        {
+        Scalar load = Scalar(N);
+        if (m_particles)
+            load += m_particles->getWeight() * Scalar(N_particles);
+        return load;
+        }
+
     //! Force a reset of the number of owned particles without counting
     /*!
      * \param N number of particles owned by the rank
+     * \param N_particles number of particles set with setParticles() owned by the rank
      */
-    void resetNOwn(unsigned int N)
+    void resetNOwn(unsigned int N, unsigned int N_particles)
         {
         m_N_own = N;
+        m_N_own_particles = N_particles;
         m_recompute_max_imbalance = true;
         m_needs_recount = false;
         }
 #endif // ENABLE_MPI
 
+    std::shared_ptr<LoadBalancerParticles> m_particles; //!< Other particles to balance
+
     Scalar m_max_imbalance;         //!< Maximum imbalance
     bool m_recompute_max_imbalance; //!< Flag if maximum imbalance needs to be computed
 
@@ -209,11 +318,18 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     bool m_enable_x;        //!< Flag to enable balancing in x
     bool m_enable_y;        //!< Flag to enable balancing in y
     bool m_enable_z;        //!< Flag to enable balancing z
+    bool m_time_cost;       //!< Flag to balance the force compute time instead of particles
 
     const Scalar m_max_scale; //!< Maximum fraction to rescale either direction (5%)
 
     private:
-    unsigned int m_N_own; //!< Number of particles owned by this rank
+    unsigned int m_N_own;           //!< Number of particles owned by this rank
+    unsigned int m_N_own_particles; //!< Number of other particles owned by this rank
+    Scalar m_weight;                //!< Cost of a particle on this rank relative to the average
+
+    std::weak_ptr<System> m_system;                //!< System that holds the timed Integrator
+    std::weak_ptr<Integrator> m_timed_integrator; //!< Integrator with force timing enabled
+    int64_t m_last_force_time;                     //!< Force time of m_timed_integrator at update
 
     Scalar m_max_max_imbalance;   //!< The maximum imbalance of any check
     double m_total_max_imbalance; //!< The average imbalance over checks
@@ -26,50 +26,54 @@ LoadBalancerGPU::LoadBalancerGPU(std::shared_ptr<SystemDefinition> sysdef,
                                  std::shared_ptr<Trigger> trigger)
     : LoadBalancer(sysdef, trigger)
     {
-    // allocate data connected to the maximum number of particles
-    m_pdata->getMaxParticleNumberChangeSignal()
-        .connect<LoadBalancerGPU, &LoadBalancerGPU::slotMaxNumChanged>(this);
-
+    // the per particle arrays are sized when the particles are counted
+    GPUArray<unsigned int> ranks(m_pdata->getMaxN(), m_exec_conf);
+    m_ranks.swap(ranks);
     GPUArray<unsigned int> off_ranks(m_pdata->getMaxN(), m_exec_conf);
     m_off_ranks.swap(off_ranks);
 
     m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "load_balance", this->m_exec_conf));
     }
 
-LoadBalancerGPU::~LoadBalancerGPU()
-    {
-    // disconnect from the signal
-    m_pdata->getMaxParticleNumberChangeSignal()
-        .disconnect<LoadBalancerGPU, &LoadBalancerGPU::slotMaxNumChanged>(this);
-    }
+LoadBalancerGPU::~LoadBalancerGPU() { }
 
 #ifdef ENABLE_MPI
-void LoadBalancerGPU::countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts)
+/*!
+ * \param cnts Map holding result of number of particles on each rank that neighbors the local rank
+ * \param pos Positions of the particles
+ * \param N Number of particles owned by this rank
+ */
+void LoadBalancerGPU::countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts,
+                                            const GlobalArray<Scalar4>& pos,
+                                            unsigned int N)
     {
     // do nothing if rank doesn't own any particles
-    if (m_pdata->getN() == 0)
+    if (N == 0)
         return;
 
-    // mark the current ranks of each particle (hijack the comm flags array)
+    // the particles are not necessarily the MD particles, so size the scratch arrays to fit them
+    if (N > m_ranks.getNumElements())
         {
-        ArrayHandle<unsigned int> d_comm_flag(m_pdata->getCommFlags(),
-                                              access_location::device,
-                                              access_mode::overwrite);
-        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
-                                   access_location::device,
-                                   access_mode::read);
+        m_ranks.resize(N);
+        m_off_ranks.resize(N);
+        }
+
+    // mark the current ranks of each particle
+        {
+        ArrayHandle<unsigned int> d_ranks(m_ranks, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_pos(pos, access_location::device, access_mode::read);
         ArrayHandle<unsigned int> d_cart_ranks(m_decomposition->getCartRanks(),
                                                access_location::device,
                                                access_mode::read);
 
         m_tuner->begin();
-        gpu_load_balance_mark_rank(d_comm_flag.data,
+        gpu_load_balance_mark_rank(d_ranks.data,
                                    d_pos.data,
                                    d_cart_ranks.data,
                                    m_decomposition->getGridPos(),
                                    m_pdata->getBox(),
                                    m_decomposition->getDomainIndexer(),
-                                   m_pdata->getN(),
+                                   N,
                                    m_tuner->getParam());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -79,17 +83,15 @@ void LoadBalancerGPU::countParticlesOffRank(std::map<unsigned int, unsigned int>
     // select the particles that should be sent to other ranks
     vector<unsigned int> off_rank;
         {
-        ArrayHandle<unsigned int> d_comm_flag(m_pdata->getCommFlags(),
-                                              access_location::device,
-                                              access_mode::read);
+        ArrayHandle<unsigned int> d_ranks(m_ranks, access_location::device, access_mode::read);
         ArrayHandle<unsigned int> d_off_ranks(m_off_ranks,
                                               access_location::device,
                                               access_mode::overwrite);
 
         // size the temporary storage
         const unsigned int n_off_rank = gpu_load_balance_select_off_rank(d_off_ranks.data,
-                                                                         d_comm_flag.data,
-                                                                         m_pdata->getN(),
+                                                                         d_ranks.data,
+                                                                         N,
                                                                          m_exec_conf->getRank());
 
         // copy just the subset of particles that are off rank on the device into host memory
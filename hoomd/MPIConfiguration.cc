@@ -23,7 +23,7 @@ MPIConfiguration::MPIConfiguration(
     MPI_Comm hoomd_world
 #endif
     )
-    : m_rank(0), m_n_rank(1)
+    : m_rank(0), m_n_rank(1), m_node_rank(0), m_n_node_ranks(1)
     {
 #ifdef ENABLE_MPI
     m_mpi_comm = m_hoomd_world = hoomd_world;
@@ -36,6 +36,15 @@ MPIConfiguration::MPIConfiguration(
     int rank;
     MPI_Comm_rank(m_mpi_comm, &rank);
     m_rank = rank;
+
+    // find the ranks that share this node, which share its cores between their threads
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(m_hoomd_world, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_rank(node_comm, &rank);
+    MPI_Comm_size(node_comm, &size);
+    m_node_rank = rank;
+    m_n_node_ranks = size;
+    MPI_Comm_free(&node_comm);
 #endif
     }
 
@@ -96,6 +105,8 @@ void export_MPIConfiguration(pybind11::module& m)
         .def("barrier", &MPIConfiguration::barrier)
         .def("getNRanksGlobal", &MPIConfiguration::getNRanksGlobal)
         .def("getRankGlobal", &MPIConfiguration::getRankGlobal)
+        .def("getNodeRank", &MPIConfiguration::getNodeRank)
+        .def("getNRanksPerNode", &MPIConfiguration::getNRanksPerNode)
 #ifdef ENABLE_MPI
         .def_static("_make_mpi_conf_mpi_comm",
                     [](pybind11::object mpi_comm) -> std::shared_ptr<MPIConfiguration>
@@ -114,6 +114,18 @@ class PYBIND11_EXPORT MPIConfiguration
     //! Return the number of ranks in this partition
     unsigned int getNRanks() const;
 
+    //! Return the rank of this processor among the ranks of the job on the same node
+    unsigned int getNodeRank() const
+        {
+        return m_node_rank;
+        }
+
+    //! Return the number of ranks of the job on the same node as this processor
+    unsigned int getNRanksPerNode() const
+        {
+        return m_n_node_ranks;
+        }
+
     //! Returns true if this is the root processor
     bool isRoot() const
         {
@@ -133,8 +145,10 @@ class PYBIND11_EXPORT MPIConfiguration
     MPI_Comm m_mpi_comm;    //!< The MPI communicator
     MPI_Comm m_hoomd_world; //!< The HOOMD world communicator
 #endif
-    unsigned int m_rank;   //!< Rank of this processor (0 if running in single-processor mode)
-    unsigned int m_n_rank; //!< Ranks per partition
+    unsigned int m_rank;         //!< Rank of this processor (0 if running in single-processor mode)
+    unsigned int m_n_rank;       //!< Ranks per partition
+    unsigned int m_node_rank;    //!< Rank among the ranks on this node (in all partitions)
+    unsigned int m_n_node_ranks; //!< Number of ranks on this node (in all partitions)
     };
 
 //! Exports MPIConfiguration to python
@@ -0,0 +1,141 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MemoryAccounting.cc
+    \brief Implements a class that sums the memory allocated by each owner
+*/
+
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cxxabi.h>
+
+namespace py = pybind11;
+
+//! Get the owner that an allocation with the given tag counts towards
+static std::string owner_from_tag(const std::string& tag)
+    {
+    if (tag.empty())
+        return std::string("untagged");
+
+    size_t pos = tag.rfind("::");
+    if (pos == std::string::npos || pos == 0)
+        return tag;
+
+    return tag.substr(0, pos);
+    }
+
+void MemoryAccounting::registerAllocation(const void* ptr,
+                                          size_t nbytes,
+                                          bool device,
+                                          const std::string& tag) const
+    {
+    if (!ptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // a pointer is only registered once, replace stale entries
+    auto it = m_allocations.find(ptr);
+    if (it != m_allocations.end())
+        {
+        remove(it->second);
+        m_allocations.erase(it);
+        }
+
+    Allocation allocation = {nbytes, device, owner_from_tag(tag)};
+    add(allocation);
+    m_allocations[ptr] = allocation;
+    }
+
+void MemoryAccounting::unregisterAllocation(const void* ptr) const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_allocations.find(ptr);
+    if (it == m_allocations.end())
+        return;
+
+    remove(it->second);
+    m_allocations.erase(it);
+    }
+
+void MemoryAccounting::updateTag(const void* ptr, const std::string& tag) const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_allocations.find(ptr);
+    if (it == m_allocations.end())
+        return;
+
+    std::string owner = owner_from_tag(tag);
+    if (owner == it->second.owner)
+        return;
+
+    remove(it->second);
+    it->second.owner = owner;
+    add(it->second);
+    }
+
+py::dict MemoryAccounting::getUsage() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    py::dict result;
+    for (const auto& owner_usage : m_usage)
+        {
+        const Usage& usage = owner_usage.second;
+        py::dict entry;
+        entry["host_bytes"] = usage.host_bytes;
+        entry["device_bytes"] = usage.device_bytes;
+        entry["peak_host_bytes"] = usage.peak_host_bytes;
+        entry["peak_device_bytes"] = usage.peak_device_bytes;
+        result[py::str(owner_usage.first)] = entry;
+        }
+    return result;
+    }
+
+void MemoryAccounting::add(const Allocation& allocation) const
+    {
+    Usage& usage = m_usage[allocation.owner];
+    if (allocation.device)
+        {
+        usage.device_bytes += allocation.nbytes;
+        usage.peak_device_bytes = std::max(usage.peak_device_bytes, usage.device_bytes);
+        }
+    else
+        {
+        usage.host_bytes += allocation.nbytes;
+        usage.peak_host_bytes = std::max(usage.peak_host_bytes, usage.host_bytes);
+        }
+    }
+
+void MemoryAccounting::remove(const Allocation& allocation) const
+    {
+    Usage& usage = m_usage[allocation.owner];
+    if (allocation.device)
+        usage.device_bytes -= allocation.nbytes;
+    else
+        usage.host_bytes -= allocation.nbytes;
+    }
+
+namespace hoomd
+    {
+namespace detail
+    {
+/*! \param name The mangled name from std::type_info
+    \returns The demangled name, or \a name when it cannot be demangled
+*/
+std::string demangle(const char* name)
+    {
+    int status = -1;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    std::string result = (status == 0) ? std::string(demangled) : std::string(name);
+    free(demangled);
+    return result;
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
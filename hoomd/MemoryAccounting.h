@@ -0,0 +1,105 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file MemoryAccounting.h
+    \brief Declares a class that sums the memory allocated by each owner
+*/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+#include <pybind11/pybind11.h>
+
+//! Sums the memory held by the arrays of each owner
+/*! GPUArray, GlobalArray, and GlobalVector register every host, device, and managed allocation
+    along with their tag. TAG_ALLOCATION sets tags of the form Owner::m_array, where Owner is the
+    demangled type of the object that holds the array. MemoryAccounting sums the bytes by owner,
+    which is the tag up to the last "::". Allocations without a tag count towards "untagged".
+
+    Unlike MemoryTraceback, MemoryAccounting is always enabled. It keeps the current and the peak
+    number of bytes on the host and on the device for each owner. Managed memory counts as device
+    memory.
+*/
+class PYBIND11_EXPORT MemoryAccounting
+    {
+    public:
+    //! Register a memory allocation
+    /*! \param ptr The pointer to the memory address being allocated
+        \param nbytes The size of the allocation in bytes
+        \param device True if the allocation is in device or managed memory
+        \param tag The name of the array
+     */
+    void registerAllocation(const void* ptr,
+                            size_t nbytes,
+                            bool device,
+                            const std::string& tag) const;
+
+    //! Unregister a memory allocation
+    /*! \param ptr The pointer to the memory address being freed
+     */
+    void unregisterAllocation(const void* ptr) const;
+
+    //! Update the name of an allocation
+    /*! \param ptr The pointer to the allocation
+        \param tag The new tag
+     */
+    void updateTag(const void* ptr, const std::string& tag) const;
+
+    //! Get the memory usage of each owner
+    /*! \returns A dict that maps each owner to a dict with the keys host_bytes, device_bytes,
+        peak_host_bytes, and peak_device_bytes
+    */
+    pybind11::dict getUsage() const;
+
+    private:
+    //! A registered allocation
+    struct Allocation
+        {
+        size_t nbytes;     //!< Size in bytes
+        bool device;       //!< True for device or managed memory
+        std::string owner; //!< Owner the allocation is counted towards
+        };
+
+    //! Memory usage of one owner
+    struct Usage
+        {
+        size_t host_bytes = 0;        //!< Current host memory
+        size_t device_bytes = 0;      //!< Current device memory
+        size_t peak_host_bytes = 0;   //!< Largest host memory held at once
+        size_t peak_device_bytes = 0; //!< Largest device memory held at once
+        };
+
+    mutable std::mutex m_mutex;                              //!< Protects the maps
+    mutable std::map<const void*, Allocation> m_allocations; //!< Registered allocations
+    mutable std::map<std::string, Usage> m_usage;            //!< Usage by owner
+
+    //! Add an allocation to the usage of its owner
+    void add(const Allocation& allocation) const;
+
+    //! Remove an allocation from the usage of its owner
+    void remove(const Allocation& allocation) const;
+    };
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Demangle a type name
+std::string demangle(const char* name);
+
+//! Get the name of the owner to tag allocations with
+/*! \param obj The object that holds the array
+    \returns The demangled dynamic type of \a obj
+*/
+template<class T> std::string allocation_owner(const T* obj)
+    {
+    return demangle(typeid(*obj).name());
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -0,0 +1,236 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MemoryPool.cc
+    \brief Defines the MemoryPool class
+*/
+
+#ifdef ENABLE_HIP
+#include "MemoryPool.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+//! Smallest block size handed out by the pool
+static const size_t min_block_bytes = 512;
+
+MemoryPool::MemoryPool(bool managed, size_t max_cached_bytes)
+    : m_managed(managed), m_max_cached_bytes(max_cached_bytes), m_cached_bytes(0),
+      m_peak_cached_bytes(0), m_allocated_bytes(0), m_num_hits(0), m_num_misses(0)
+    {
+    }
+
+MemoryPool::~MemoryPool()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    releaseLocked();
+
+    // blocks still in use belong to arrays that outlive the pool, free them here
+    for (auto& allocated : m_allocated_blocks)
+        freeBlock(allocated.second);
+    m_allocated_blocks.clear();
+    }
+
+/*! \param num_bytes Size of the requested allocation
+    \returns The size of the block that holds \a num_bytes
+*/
+size_t MemoryPool::getSizeClass(size_t num_bytes)
+    {
+    if (num_bytes <= min_block_bytes)
+        return min_block_bytes;
+
+    // the largest power of two below num_bytes, split into four steps
+    size_t power = min_block_bytes;
+    while (power * 2 < num_bytes)
+        power *= 2;
+    size_t step = power / 4;
+
+    return (num_bytes + step - 1) / step * step;
+    }
+
+void* MemoryPool::allocate(size_t num_bytes)
+    {
+    if (num_bytes == 0)
+        return nullptr;
+
+    int device;
+    hipGetDevice(&device);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Block block;
+    block.num_bytes = getSizeClass(num_bytes);
+    block.device = device;
+
+    auto free_blocks = m_free_blocks.find(std::make_pair(device, block.num_bytes));
+    if (free_blocks != m_free_blocks.end() && !free_blocks->second.empty())
+        {
+        block = free_blocks->second.back();
+        free_blocks->second.pop_back();
+        m_cached_bytes -= block.num_bytes;
+        m_num_hits++;
+
+        // wait until the device is done with the previous user of the block
+        if (hipEventQuery(block.event) == hipErrorNotReady)
+            hipEventSynchronize(block.event);
+        }
+    else
+        {
+        hipError_t status = allocateBlock(block);
+        if (status != hipSuccess)
+            {
+            // return the cached blocks to the device and try again
+            releaseLocked();
+            status = allocateBlock(block);
+            }
+
+        if (status != hipSuccess)
+            {
+            throw std::runtime_error("MemoryPool: Error allocating " + std::to_string(num_bytes)
+                                     + " bytes: " + std::string(hipGetErrorString(status)));
+            }
+        m_num_misses++;
+        }
+
+    m_allocated_bytes += block.num_bytes;
+    m_allocated_blocks[block.ptr] = block;
+    return block.ptr;
+    }
+
+void MemoryPool::deallocate(void* ptr)
+    {
+    if (ptr == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto allocated = m_allocated_blocks.find(ptr);
+    if (allocated == m_allocated_blocks.end())
+        throw std::runtime_error("MemoryPool: Freeing a pointer that is not in the pool");
+
+    Block block = allocated->second;
+    m_allocated_blocks.erase(allocated);
+    m_allocated_bytes -= block.num_bytes;
+
+    if (m_cached_bytes + block.num_bytes > m_max_cached_bytes)
+        {
+        freeBlock(block);
+        return;
+        }
+
+    // events must be recorded on the device that created them
+    int device;
+    hipGetDevice(&device);
+    if (device != block.device)
+        hipSetDevice(block.device);
+
+    hipEventRecord(block.event, 0);
+
+    if (device != block.device)
+        hipSetDevice(device);
+
+    m_free_blocks[std::make_pair(block.device, block.num_bytes)].push_back(block);
+    m_cached_bytes += block.num_bytes;
+    m_peak_cached_bytes = std::max(m_peak_cached_bytes, m_cached_bytes);
+    }
+
+void MemoryPool::release()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    releaseLocked();
+    }
+
+void MemoryPool::setMaxCachedBytes(size_t max_cached_bytes)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_cached_bytes = max_cached_bytes;
+    if (m_cached_bytes > m_max_cached_bytes)
+        releaseLocked();
+    }
+
+size_t MemoryPool::getCachedBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cached_bytes;
+    }
+
+size_t MemoryPool::getPeakCachedBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_peak_cached_bytes;
+    }
+
+size_t MemoryPool::getAllocatedBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_allocated_bytes;
+    }
+
+size_t MemoryPool::getNumHits() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_hits;
+    }
+
+size_t MemoryPool::getNumMisses() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_misses;
+    }
+
+/*! \param block Block with the size class and device set
+    \returns The status of the allocation
+*/
+hipError_t MemoryPool::allocateBlock(Block& block)
+    {
+    hipError_t status;
+    if (m_managed)
+        status = hipMallocManaged(&block.ptr, block.num_bytes, hipMemAttachGlobal);
+    else
+        status = hipMalloc(&block.ptr, block.num_bytes);
+
+    if (status != hipSuccess)
+        {
+        // clear the error state
+        hipGetLastError();
+        return status;
+        }
+
+    status = hipEventCreateWithFlags(&block.event, hipEventDisableTiming);
+    if (status != hipSuccess)
+        {
+        hipGetLastError();
+        hipFree(block.ptr);
+        }
+    return status;
+    }
+
+/*! hipFree synchronizes the device, so the block is no longer in use when it returns.
+ */
+void MemoryPool::freeBlock(Block& block)
+    {
+    int device;
+    hipGetDevice(&device);
+    if (device != block.device)
+        hipSetDevice(block.device);
+
+    hipFree(block.ptr);
+    hipEventDestroy(block.event);
+
+    if (device != block.device)
+        hipSetDevice(device);
+    }
+
+void MemoryPool::releaseLocked()
+    {
+    for (auto& free_blocks : m_free_blocks)
+        {
+        for (auto& block : free_blocks.second)
+            freeBlock(block);
+        }
+    m_free_blocks.clear();
+    m_cached_bytes = 0;
+    }
+
+#endif // ENABLE_HIP
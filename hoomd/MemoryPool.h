@@ -0,0 +1,120 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file MemoryPool.h
+    \brief Declares a pool of device memory blocks shared by all arrays
+*/
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//! Pool of device or managed memory blocks
+/*! hipMalloc, hipMallocManaged, and hipFree are expensive and hipFree synchronizes the device.
+    Arrays that are resized often, such as the particle data and the communication buffers, would
+    stall the device on every change in the number of particles. MemoryPool keeps freed blocks and
+    hands them out again to later requests of the same size class.
+
+    The size classes are spaced by a quarter of the next smaller power of two, so a block wastes
+    at most 25% of its size. Blocks are kept separately for each device.
+
+    Freed blocks are stream ordered: deallocate() records an event on the default stream and
+    allocate() waits on that event before it reuses the block. Kernels that are in flight when an
+    array is freed therefore never see their memory reused. The wait only blocks when the device
+    has not yet reached the point where the block was freed.
+
+    The pool holds at most max_cached_bytes in free blocks. It frees blocks that do not fit
+    directly, and releases the whole cache when an allocation fails before trying again.
+*/
+class __attribute__((visibility("default"))) MemoryPool
+    {
+    public:
+    //! Constructor
+    /*! \param managed True to allocate managed memory, false for device memory
+        \param max_cached_bytes Maximum size of the free blocks held
+     */
+    MemoryPool(bool managed, size_t max_cached_bytes);
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    //! Destructor
+    ~MemoryPool();
+
+    //! Allocate a block
+    /*! \param num_bytes Number of bytes to allocate
+        \returns A pointer to a block of at least \a num_bytes, or nullptr when \a num_bytes is 0
+     */
+    void* allocate(size_t num_bytes);
+
+    //! Return a block to the pool
+    /*! \param ptr Pointer returned by allocate()
+     */
+    void deallocate(void* ptr);
+
+    //! Free all cached blocks
+    void release();
+
+    //! Set the maximum size of the free blocks held
+    void setMaxCachedBytes(size_t max_cached_bytes);
+
+    //! Get the number of bytes in free blocks
+    size_t getCachedBytes() const;
+
+    //! Get the largest number of bytes held in free blocks at once
+    size_t getPeakCachedBytes() const;
+
+    //! Get the number of bytes in blocks that are in use
+    size_t getAllocatedBytes() const;
+
+    //! Get the number of allocations served from the cache
+    size_t getNumHits() const;
+
+    //! Get the number of allocations that needed a new block
+    size_t getNumMisses() const;
+
+    //! Get the size class of an allocation
+    static size_t getSizeClass(size_t num_bytes);
+
+    private:
+    //! A block of memory
+    struct Block
+        {
+        void* ptr;        //!< Start of the block
+        size_t num_bytes; //!< Size class of the block
+        int device;       //!< Device the block was allocated on
+        hipEvent_t event; //!< Recorded when the block was freed
+        };
+
+    typedef std::pair<int, size_t> block_key; //!< Device and size class of a free block
+
+    bool m_managed;             //!< True if the pool allocates managed memory
+    size_t m_max_cached_bytes;  //!< Maximum size of the free blocks
+    size_t m_cached_bytes;      //!< Total size of the free blocks
+    size_t m_peak_cached_bytes; //!< Largest total size of the free blocks
+    size_t m_allocated_bytes;   //!< Total size of the blocks in use
+    size_t m_num_hits;          //!< Number of allocations served from the cache
+    size_t m_num_misses;        //!< Number of allocations that needed a new block
+    mutable std::mutex m_mutex; //!< Protects the block lists
+
+    std::map<block_key, std::vector<Block>> m_free_blocks; //!< Free blocks by size class
+    std::unordered_map<void*, Block> m_allocated_blocks;   //!< Blocks in use
+
+    //! Allocate a new block from the device
+    hipError_t allocateBlock(Block& block);
+
+    //! Free a block on the device
+    void freeBlock(Block& block);
+
+    //! Free all cached blocks, the caller holds the lock
+    void releaseLocked();
+    };
+
+#endif // ENABLE_HIP
@@ -19,8 +19,11 @@
 #include <vector>
 
 #include <assert.h>
+#include <condition_variable>
+#include <mutex>
 #include <pybind11/iostream.h>
 #include <sstream>
+#include <thread>
 using namespace std;
 
 namespace py = pybind11;
@@ -56,6 +59,65 @@ class mpi_io : public std::streambuf
     };
 #endif
 
+//! Stream buffer that collects output in memory and writes it to a target stream on a thread
+/*! Writing to the buffer appends to a string under a mutex. A flush (i.e. std::endl) wakes the
+    background thread, which writes all collected output to the target stream. drain() writes the
+    collected output on the calling thread and returns once the target stream has received it.
+*/
+class buffered_streambuf : public std::streambuf
+    {
+    public:
+    //! Constructor
+    buffered_streambuf(std::ostream* target);
+
+    //! Destructor
+    virtual ~buffered_streambuf();
+
+    //! Write all collected output and then switch to a new target stream
+    void setTarget(std::ostream* target);
+
+    //! Write all collected output to the target stream
+    void drain();
+
+    protected:
+    //! Write a character
+    virtual int overflow(int ch);
+
+    //! Write a sequence of characters
+    virtual std::streamsize xsputn(const char* s, std::streamsize n);
+
+    //! Wake the background thread
+    virtual int sync();
+
+    private:
+    std::ostream* m_target;       //!< Stream to write the output to
+    std::string m_pending;        //!< Output collected since the last write
+    std::mutex m_pending_mutex;   //!< Protects m_pending, m_notified and m_stop
+    std::mutex m_write_mutex;     //!< Serializes writes to m_target
+    std::condition_variable m_cv; //!< Wakes the background thread
+    bool m_notified = false;      //!< True when output was flushed
+    bool m_stop = false;          //!< True when the background thread should exit
+    std::thread m_thread;         //!< Background thread
+
+    //! Main loop of the background thread
+    void run();
+
+    //! Write the collected output (m_write_mutex must be held)
+    void write();
+    };
+
+//! Release the GIL when the calling thread holds it
+/*! The background thread of buffered_streambuf acquires the GIL to write to python streams. Threads
+    that wait on it must not hold the GIL.
+*/
+static std::unique_ptr<py::gil_scoped_release> releaseGILIfHeld()
+    {
+    std::unique_ptr<py::gil_scoped_release> release;
+    if (Py_IsInitialized() && PyGILState_Check())
+        release.reset(new py::gil_scoped_release());
+    return release;
+    }
+
 /*! \post Warning and error streams are set to cerr
     \post The notice stream is set to cout
     \post The notice level is set to 2
@@ -69,6 +131,7 @@ Messenger::Messenger(std::shared_ptr<MPIConfiguration> mpi_config) : m_mpi_confi
 
     m_nullstream = std::shared_ptr<nullstream>(new nullstream());
     m_notice_level = 2;
+    m_notice_level_all = 2;
     m_err_prefix = "**ERROR**";
     m_warning_prefix = "*Warning*";
     m_notice_prefix = "notice";
@@ -99,6 +162,10 @@ Messenger::Messenger(const Messenger& msg)
     m_warning_prefix = msg.m_warning_prefix;
     m_notice_prefix = msg.m_notice_prefix;
     m_notice_level = msg.m_notice_level;
+    m_notice_level_all = msg.m_notice_level_all;
+    m_per_rank = msg.m_per_rank;
+    m_notice_sink = msg.m_notice_sink;
+    m_notice_buffered = msg.m_notice_buffered;
 
     m_mpi_config = msg.m_mpi_config;
     }
@@ -117,6 +184,10 @@ Messenger& Messenger::operator=(Messenger& msg)
     m_warning_prefix = msg.m_warning_prefix;
     m_notice_prefix = msg.m_notice_prefix;
     m_notice_level = msg.m_notice_level;
+    m_notice_level_all = msg.m_notice_level_all;
+    m_per_rank = msg.m_per_rank;
+    m_notice_sink = msg.m_notice_sink;
+    m_notice_buffered = msg.m_notice_buffered;
 
     m_mpi_config = msg.m_mpi_config;
 
@@ -125,6 +196,8 @@ Messenger& Messenger::operator=(Messenger& msg)
 
 Messenger::~Messenger()
     {
+    flush();
+
     // set pointers to NULL
     m_err_stream = NULL;
     m_warning_stream = NULL;
@@ -147,6 +220,7 @@ std::ostream& Messenger::error()
         return *m_nullstream;
         }
 #endif
+    flush();
     reopenPythonIfNeeded();
     if (m_err_prefix != string(""))
         *m_err_stream << m_err_prefix << ": ";
@@ -166,6 +240,7 @@ std::ostream& Messenger::errorAllRanks()
     {
     assert(m_err_stream);
 
+    flush();
     reopenPythonIfNeeded();
 
     // Delay so that multiple ranks calling this have a good chance of writing non-overlapping
@@ -198,6 +273,7 @@ std::ostream& Messenger::warning()
         return *m_nullstream;
 
     assert(m_warning_stream);
+    flush();
     reopenPythonIfNeeded();
     if (m_warning_prefix != string(""))
         *m_warning_stream << m_warning_prefix << ": ";
@@ -218,23 +294,18 @@ void Messenger::warningStr(const std::string& msg)
    is preceded with
     "${notice_prefix}(n): ".
 
-    If level is greater than the notice level, a null stream is returned so that the output is not
-   printed.
+    notice() calls this method only when level is not greater than the notice level. When buffered,
+   the returned stream writes to the notice buffer.
 */
-std::ostream& Messenger::notice(unsigned int level)
+std::ostream& Messenger::noticeStream(unsigned int level)
     {
     assert(m_notice_stream);
-    if (level <= m_notice_level)
-        {
-        reopenPythonIfNeeded();
-        if (m_notice_prefix != string("") && level > 1)
-            *m_notice_stream << m_notice_prefix << "(" << level << "): ";
-        return *m_notice_stream;
-        }
-    else
-        {
-        return *m_nullstream;
-        }
+    reopenPythonIfNeeded();
+
+    std::ostream& stream = m_notice_sink ? *m_notice_buffered : *m_notice_stream;
+    if (m_notice_prefix != string("") && level > 1)
+        stream << m_notice_prefix << "(" << level << "): ";
+    return stream;
     }
 
 /*! Outputs the the collective notice string on the processor with rank zero, in rank order.
@@ -303,13 +374,25 @@ void Messenger::noticeStr(unsigned int level, const std::string& msg)
     }
 
 /*! \param fname File name
+    \param per_rank When true, each rank opens its own file "fname.rank" and prints notices
+
     The file is overwritten if it exists. If there is an error opening the file, all level's streams
    are left as is and an error() is issued.
 */
-void Messenger::openFile(const std::string& fname)
+void Messenger::openFile(const std::string& fname, bool per_rank)
     {
+    flush();
+
+    m_per_rank = per_rank;
+    setNoticeLevel(m_notice_level_all);
+
+    if (per_rank)
+        {
+        std::string rank_fname = fname + "." + to_string(m_mpi_config->getRank());
+        m_file_out = std::make_shared<std::ofstream>(rank_fname.c_str());
+        }
 #ifdef ENABLE_MPI
-    if (m_mpi_config->getNRanks() > 1)
+    else if (m_mpi_config->getNRanks() > 1)
         {
         // open the shared file
         std::string broadcast_fname = fname;
@@ -325,7 +408,10 @@ void Messenger::openFile(const std::string& fname)
         m_file_out = std::make_shared<std::ofstream>(fname.c_str());
         }
 #else
-    m_file_out = std::make_shared<std::ofstream>(fname.c_str());
+    else
+        {
+        m_file_out = std::make_shared<std::ofstream>(fname.c_str());
+        }
 #endif
 
     // update the error, warning, and notice streams
@@ -333,6 +419,41 @@ void Messenger::openFile(const std::string& fname)
     m_err_stream = m_file_out.get();
     m_warning_stream = m_file_out.get();
     m_notice_stream = m_file_out.get();
+    updateNoticeSink();
+    }
+
+/*! \param buffered True to buffer notices and write them on a background thread
+
+    Any buffered notices are written before buffering is turned off.
+*/
+void Messenger::setBuffered(bool buffered)
+    {
+    if (buffered && !m_notice_sink)
+        {
+        m_notice_sink = std::make_shared<buffered_streambuf>(m_notice_stream);
+        m_notice_buffered = std::make_shared<std::ostream>(m_notice_sink.get());
+        }
+    else if (!buffered && m_notice_sink)
+        {
+        flush();
+        m_notice_buffered = std::shared_ptr<std::ostream>();
+        m_notice_sink = std::shared_ptr<buffered_streambuf>();
+        }
+    }
+
+/*! Returns after the notice stream has received all buffered notices. Does nothing when notices are
+    not buffered.
+*/
+void Messenger::flush()
+    {
+    if (m_notice_sink)
+        m_notice_sink->drain();
+    }
+
+void Messenger::updateNoticeSink()
+    {
+    if (m_notice_sink)
+        m_notice_sink->setTarget(m_notice_stream);
     }
 
 /*! Sets all messenger output streams to ones that use PySys_WriteStd* functions so that messenger
@@ -345,6 +466,8 @@ void Messenger::openFile(const std::string& fname)
 */
 void Messenger::openPython()
     {
+    flush();
+
     // only import sys on first load
     if (!m_python_open)
         m_sys = pybind11::module::import("sys");
@@ -363,6 +486,10 @@ void Messenger::openPython()
     m_warning_stream = m_file_err.get();
     m_notice_stream = m_file_out.get();
     m_python_open = true;
+    updateNoticeSink();
+
+    m_per_rank = false;
+    setNoticeLevel(m_notice_level_all);
     }
 
 /*! Some notebook operations swap out sys.stdout and sys.stderr. Check if these have been swapped
@@ -374,6 +501,9 @@ void Messenger::reopenPythonIfNeeded()
     // and python is initialized
     if (m_python_open && Py_IsInitialized())
         {
+        // messages may be sent while System::run has released the GIL
+        pybind11::gil_scoped_acquire acquire;
+
         // flush and reopen the streams if sys.stdout or sys.stderr change
         pybind11::object new_pystdout = m_sys.attr("stdout");
         pybind11::object new_pystderr = m_sys.attr("stderr");
@@ -390,11 +520,17 @@ void Messenger::reopenPythonIfNeeded()
  */
 void Messenger::openStd()
     {
-    m_file_out = std::shared_ptr<std::ostream>();
-    m_file_err = std::shared_ptr<std::ostream>();
+    flush();
+
     m_err_stream = &cerr;
     m_warning_stream = &cerr;
     m_notice_stream = &cout;
+    updateNoticeSink();
+    m_file_out = std::shared_ptr<std::ostream>();
+    m_file_err = std::shared_ptr<std::ostream>();
+
+    m_per_rank = false;
+    setNoticeLevel(m_notice_level_all);
     }
 
 #ifdef ENABLE_MPI
@@ -442,6 +578,106 @@ void mpi_io::close()
 
 #endif
 
+/*! \param target Stream to write the output to
+ */
+buffered_streambuf::buffered_streambuf(std::ostream* target) : m_target(target)
+    {
+    m_thread = std::thread(&buffered_streambuf::run, this);
+    }
+
+buffered_streambuf::~buffered_streambuf()
+    {
+        {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_stop = true;
+        }
+    m_cv.notify_one();
+
+    // the thread writes the remaining output before it exits
+    auto release = releaseGILIfHeld();
+    m_thread.join();
+    }
+
+/*! \param target New stream to write the output to
+ */
+void buffered_streambuf::setTarget(std::ostream* target)
+    {
+    auto release = releaseGILIfHeld();
+    std::lock_guard<std::mutex> write_lock(m_write_mutex);
+    write();
+    m_target = target;
+    }
+
+void buffered_streambuf::drain()
+    {
+    auto release = releaseGILIfHeld();
+    std::lock_guard<std::mutex> write_lock(m_write_mutex);
+    write();
+    }
+
+int buffered_streambuf::overflow(int ch)
+    {
+    if (ch != traits_type::eof())
+        {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending.push_back(char(ch));
+        }
+    return 0;
+    }
+
+std::streamsize buffered_streambuf::xsputn(const char* s, std::streamsize n)
+    {
+    std::lock_guard<std::mutex> lock(m_pending_mutex);
+    m_pending.append(s, size_t(n));
+    return n;
+    }
+
+int buffered_streambuf::sync()
+    {
+        {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_notified = true;
+        }
+    m_cv.notify_one();
+    return 0;
+    }
+
+void buffered_streambuf::run()
+    {
+    std::unique_lock<std::mutex> lock(m_pending_mutex);
+    while (true)
+        {
+        m_cv.wait(lock, [this] { return m_notified || m_stop; });
+        bool stop = m_stop;
+        m_notified = false;
+        lock.unlock();
+
+            {
+            std::lock_guard<std::mutex> write_lock(m_write_mutex);
+            write();
+            }
+
+        if (stop)
+            return;
+        lock.lock();
+        }
+    }
+
+void buffered_streambuf::write()
+    {
+    std::string data;
+        {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        data.swap(m_pending);
+        }
+
+    if (!data.empty() && m_target)
+        {
+        m_target->write(data.data(), std::streamsize(data.size()));
+        m_target->flush();
+        }
+    }
+
 void export_Messenger(py::module& m)
     {
     py::class_<Messenger, std::shared_ptr<Messenger>>(m, "Messenger")
@@ -464,6 +700,10 @@ void export_Messenger(py::module& m)
              py::return_value_policy::reference_internal)
         .def("setWarningPrefix", &Messenger::setWarningPrefix)
         .def("openFile", &Messenger::openFile)
+        .def("getPerRank", &Messenger::getPerRank)
+        .def("setBuffered", &Messenger::setBuffered)
+        .def("getBuffered", &Messenger::getBuffered)
+        .def("flush", &Messenger::flush)
         .def("openPython", &Messenger::openPython)
         .def("openStd", &Messenger::openStd);
     }
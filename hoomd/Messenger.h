@@ -33,6 +33,8 @@ struct PYBIND11_EXPORT nullstream : std::ostream
     nullstream() : std::ios(0), std::ostream(0) { }
     };
 
+class buffered_streambuf;
+
 //! Utility class for controlling message printing
 /*! Large code projects need something more intelligent than just cout's for warning and
     notices and cerr for errors. To aid in user debugging, multiple levels of notice messages are
@@ -94,6 +96,16 @@ struct PYBIND11_EXPORT nullstream : std::ostream
         - 6 memory allocation/reallocation notices from every major class
         - 7 memory allocation/reallocation notices from GPUArray
     - 10: Trace messages that may print many times per time step.
+
+    \b Buffered output
+
+    setBuffered(true) sends notices to an in-memory buffer. A background thread writes the buffer to
+   the notice stream when a message is flushed (i.e. with std::endl), so the caller never waits on
+   the file system or on the python GIL. Errors and warnings are written directly, after the
+   buffered notices. Copies of a Messenger share the buffer.
+
+    openFile(fname, true) opens a separate file on each rank (fname.rank) and prints notices on all
+   ranks, not only on rank 0.
 */
 class PYBIND11_EXPORT Messenger
     {
@@ -126,7 +138,24 @@ class PYBIND11_EXPORT Messenger
     void warningStr(const std::string& msg);
 
     //! Get a notice stream
-    std::ostream& notice(unsigned int level);
+    /*! \param level Notice level of the message
+        \returns The notice stream, or a null stream when \a level exceeds the notice level
+    */
+    std::ostream& notice(unsigned int level)
+        {
+        if (level > m_notice_level)
+            return *m_nullstream;
+        return noticeStream(level);
+        }
+
+    //! Test whether notices of a given level are printed on this rank
+    /*! Unlike getNoticeLevel(), this check does not communicate. Use it to skip building
+        expensive messages.
+    */
+    bool isNoticeEnabled(unsigned int level) const
+        {
+        return level <= m_notice_level;
+        }
 
     //! Print a notice message in rank-order
     void collectiveNoticeStr(unsigned int level, const std::string& msg);
@@ -153,7 +182,8 @@ class PYBIND11_EXPORT Messenger
      */
     void setNoticeLevel(unsigned int level)
         {
-        m_notice_level = (m_mpi_config->getRank() == 0) ? level : 0;
+        m_notice_level_all = level;
+        m_notice_level = (m_mpi_config->getRank() == 0 || m_per_rank) ? level : 0;
         }
 
     //! Set the error stream
@@ -177,7 +207,9 @@ class PYBIND11_EXPORT Messenger
      */
     void setNoticeStream(std::ostream& stream)
         {
+        flush();
         m_notice_stream = &stream;
+        updateNoticeSink();
         }
 
     //! Get the null stream
@@ -243,7 +275,25 @@ class PYBIND11_EXPORT Messenger
         }
 
     //! Open a file for error, warning, and notice streams
-    void openFile(const std::string& fname);
+    void openFile(const std::string& fname, bool per_rank = false);
+
+    //! Test whether each rank writes to its own file
+    bool getPerRank() const
+        {
+        return m_per_rank;
+        }
+
+    //! Set whether notices are buffered and written on a background thread
+    void setBuffered(bool buffered);
+
+    //! Test whether notices are buffered
+    bool getBuffered() const
+        {
+        return bool(m_notice_sink);
+        }
+
+    //! Write all buffered notices to the notice stream
+    void flush();
 
     //! "Open" python sys.stdout and sys.stderr
     void openPython();
@@ -271,12 +321,23 @@ class PYBIND11_EXPORT Messenger
     std::string m_warning_prefix; //!< Prefix for warning messages
     std::string m_notice_prefix;  //!< Prefix for notice messages
 
-    unsigned int m_notice_level; //!< Notice level
+    unsigned int m_notice_level;     //!< Notice level on this rank
+    unsigned int m_notice_level_all; //!< Notice level requested by setNoticeLevel()
+    bool m_per_rank = false;         //!< True when each rank writes to its own file
+
+    std::shared_ptr<buffered_streambuf> m_notice_sink; //!< Buffer for notices (when buffered)
+    std::shared_ptr<std::ostream> m_notice_buffered;   //!< Stream that writes to m_notice_sink
 
     bool m_python_open = false;  //!< True when the python output stream is open
     pybind11::module m_sys;      //!< sys module
     pybind11::object m_pystdout; //!< Currently bound python sys.stdout
     pybind11::object m_pystderr; //!< Currently bound python sys.stderr
+
+    //! Write the notice prefix and get the stream to print a notice on
+    std::ostream& noticeStream(unsigned int level);
+
+    //! Point the notice buffer at the current notice stream
+    void updateNoticeSink();
     };
 
 //! Exports Messenger to python
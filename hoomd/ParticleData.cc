@@ -22,12 +22,14 @@
 #include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <stdlib.h>
+#include <tuple>
 
 using namespace std;
 
@@ -76,7 +78,8 @@ ParticleData::ParticleData(unsigned int N,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
-      m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
+      m_accel_set(false), m_pos_soa_valid(false), m_pos_soa_write_count(0), m_group_bits_used(0),
+      m_resize_factor(9. / 8.), m_arrays_allocated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -141,7 +144,8 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
-      m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
+      m_accel_set(false), m_pos_soa_valid(false), m_pos_soa_write_count(0), m_group_bits_used(0),
+      m_resize_factor(9. / 8.), m_arrays_allocated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -329,6 +333,7 @@ void ParticleData::allocate(unsigned int N)
     {
     // maximum number is the current particle number
     m_max_nparticles = N;
+    m_pos_soa_valid = false;
 
     // positions
     GlobalArray<Scalar4> pos(N, m_exec_conf);
@@ -370,6 +375,11 @@ void ParticleData::allocate(unsigned int N)
     m_body.swap(body);
     TAG_ALLOCATION(m_body);
 
+    // group membership bits
+    GlobalArray<unsigned int> group_bits(N, m_exec_conf);
+    m_group_bits.swap(group_bits);
+    TAG_ALLOCATION(m_group_bits);
+
     GlobalArray<Scalar4> net_force(N, m_exec_conf);
     m_net_force.swap(net_force);
     TAG_ALLOCATION(m_net_force);
@@ -452,6 +462,10 @@ void ParticleData::allocate(unsigned int N)
                           sizeof(unsigned int) * m_body.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
                           gpu_map[idev]);
+            cudaMemAdvise(m_group_bits.get(),
+                          sizeof(unsigned int) * m_group_bits.getNumElements(),
+                          cudaMemAdviseSetAccessedBy,
+                          gpu_map[idev]);
             cudaMemAdvise(m_orientation.get(),
                           sizeof(Scalar4) * m_orientation.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
@@ -461,8 +475,9 @@ void ParticleData::allocate(unsigned int N)
         }
 #endif
 
-    // allocate alternate particle data arrays (for swapping in-out)
-    allocateAlternateArrays(N);
+    // the alternate particle data arrays (for swapping in-out) are allocated on first use
+    if (!m_pos_alt.isNull())
+        allocateAlternateArrays(N);
 
     // notify observers
     m_max_particle_num_signal.emit();
@@ -516,6 +531,11 @@ void ParticleData::allocateAlternateArrays(unsigned int N)
     m_body_alt.swap(body_alt);
     TAG_ALLOCATION(m_body_alt);
 
+    // group membership bits
+    GlobalArray<unsigned int> group_bits_alt(N, m_exec_conf);
+    m_group_bits_alt.swap(group_bits_alt);
+    TAG_ALLOCATION(m_group_bits_alt);
+
     // orientation
     GlobalArray<Scalar4> orientation_alt(N, m_exec_conf);
     m_orientation_alt.swap(orientation_alt);
@@ -601,6 +621,10 @@ void ParticleData::allocateAlternateArrays(unsigned int N)
                           sizeof(unsigned int) * m_body_alt.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
                           gpu_map[idev]);
+            cudaMemAdvise(m_group_bits_alt.get(),
+                          sizeof(unsigned int) * m_group_bits_alt.getNumElements(),
+                          cudaMemAdviseSetAccessedBy,
+                          gpu_map[idev]);
             cudaMemAdvise(m_orientation_alt.get(),
                           sizeof(Scalar4) * m_orientation_alt.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
@@ -700,6 +724,7 @@ void ParticleData::reallocate(unsigned int max_n)
     m_exec_conf->msg->notice(7) << "Resizing particle data arrays " << m_max_nparticles << " -> "
                                 << max_n << " ptls" << std::endl;
     m_max_nparticles = max_n;
+    m_pos_soa_valid = false;
 
     m_pos.resize(max_n);
     m_vel.resize(max_n);
@@ -709,6 +734,7 @@ void ParticleData::reallocate(unsigned int max_n)
     m_image.resize(max_n);
     m_tag.resize(max_n);
     m_body.resize(max_n);
+    m_group_bits.resize(max_n);
 
     m_net_force.resize(max_n);
     m_net_virial.resize(max_n, 6);
@@ -774,6 +800,10 @@ void ParticleData::reallocate(unsigned int max_n)
                           sizeof(unsigned int) * m_body.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
                           gpu_map[idev]);
+            cudaMemAdvise(m_group_bits.get(),
+                          sizeof(unsigned int) * m_group_bits.getNumElements(),
+                          cudaMemAdviseSetAccessedBy,
+                          gpu_map[idev]);
             cudaMemAdvise(m_orientation.get(),
                           sizeof(Scalar4) * m_orientation.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
@@ -794,6 +824,7 @@ void ParticleData::reallocate(unsigned int max_n)
         m_image_alt.resize(max_n);
         m_tag_alt.resize(max_n);
         m_body_alt.resize(max_n);
+        m_group_bits_alt.resize(max_n);
         m_orientation_alt.resize(max_n);
         m_angmom_alt.resize(max_n);
         m_inertia_alt.resize(max_n);
@@ -857,6 +888,10 @@ void ParticleData::reallocate(unsigned int max_n)
                               sizeof(unsigned int) * m_body_alt.getNumElements(),
                               cudaMemAdviseSetAccessedBy,
                               gpu_map[idev]);
+                cudaMemAdvise(m_group_bits_alt.get(),
+                              sizeof(unsigned int) * m_group_bits_alt.getNumElements(),
+                              cudaMemAdviseSetAccessedBy,
+                              gpu_map[idev]);
                 cudaMemAdvise(m_orientation_alt.get(),
                               sizeof(Scalar4) * m_orientation_alt.getNumElements(),
                               cudaMemAdviseSetAccessedBy,
@@ -893,6 +928,40 @@ void ParticleData::maybe_rebuild_tag_cache()
     m_invalid_cached_tags = false;
     }
 
+/*! \returns The positions and types of the local and ghost particles, one component per array
+
+    The copy is rebuilt when the number of particles changed, when m_pos has been acquired with
+    write access since the last rebuild, or after it was swapped or reallocated.
+
+    \pre No ArrayHandle to the positions is currently held
+*/
+const pdata_positions_soa& ParticleData::getPositionsSoA()
+    {
+    const unsigned int n = m_nparticles + m_nghosts;
+    if (m_pos_soa_valid && m_pos_soa_write_count == m_pos.getWriteCount()
+        && m_pos_soa.x.size() == n)
+        return m_pos_soa;
+
+    m_pos_soa.x.resize(n);
+    m_pos_soa.y.resize(n);
+    m_pos_soa.z.resize(n);
+    m_pos_soa.type.resize(n);
+
+    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        const Scalar4 postype = h_pos.data[i];
+        m_pos_soa.x[i] = postype.x;
+        m_pos_soa.y[i] = postype.y;
+        m_pos_soa.z[i] = postype.z;
+        m_pos_soa.type[i] = __scalar_as_int(postype.w);
+        }
+
+    m_pos_soa_write_count = m_pos.getWriteCount();
+    m_pos_soa_valid = true;
+    return m_pos_soa;
+    }
+
 /*! \return true If and only if all particles are in the simulation box
  */
 template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>& snap)
@@ -1337,6 +1406,99 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         }
     }
 
+/*! \param particles The particles owned by this rank
+    \param nglobal Global number of particles
+    \param accel_set True if the accelerations of the particles are valid
+
+    Each rank sets its own particles, so no particle data is communicated. The caller guarantees
+    that the particles lie in the local domain and that the tags of all ranks together are exactly
+    0 to nglobal - 1. Net forces, torques, and virials are reset to 0. The type mapping is not
+    changed.
+*/
+void ParticleData::initializeFromLocalParticles(const std::vector<pdata_element>& particles,
+                                                unsigned int nglobal,
+                                                bool accel_set)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from local particles" << std::endl;
+
+    removeAllGhostParticles();
+
+    m_tag_set.clear();
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    // every tag is in use
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        m_tag_set.insert(m_tag_set.end(), tag);
+    m_invalid_cached_tags = true;
+
+    m_rtag.resize(nglobal);
+        {
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::overwrite);
+        std::fill(h_rtag.data, h_rtag.data + nglobal, NOT_LOCAL);
+        }
+
+    resize((unsigned int)particles.size());
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_force(m_net_force,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_torque(m_net_torque,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial(m_net_virial,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_comm_flags(m_comm_flags,
+                                               access_location::host,
+                                               access_mode::overwrite);
+
+        size_t net_virial_pitch = m_net_virial.getPitch();
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            const pdata_element& p = particles[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+            h_net_force.data[idx] = make_scalar4(0, 0, 0, 0);
+            h_net_torque.data[idx] = make_scalar4(0, 0, 0, 0);
+            for (unsigned int j = 0; j < 6; j++)
+                h_net_virial.data[net_virial_pitch * j + idx] = 0;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_comm_flags.data[idx] = 0;
+            }
+        }
+
+    m_accel_set = accel_set;
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1584,6 +1746,278 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
     return index;
     }
 
+//! take a snapshot of the local particles
+/* \param snapshot The snapshot to write to
+   \returns a map to lookup the snapshot index from a particle tag
+
+   The snapshot contains the particles owned by this rank (no ghosts) in ascending tag order.
+   Unlike takeSnapshot(), this method does not communicate and may be called on any subset of
+   ranks.
+*/
+template<class Real>
+std::map<unsigned int, unsigned int>
+ParticleData::takeLocalSnapshot(SnapshotParticleData<Real>& snapshot)
+    {
+    std::map<unsigned int, unsigned int> index;
+
+    m_exec_conf->msg->notice(4) << "ParticleData: taking local snapshot" << std::endl;
+
+    // sort the local particles by tag
+    std::vector<std::pair<unsigned int, unsigned int>> tag_idx(m_nparticles);
+        {
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            tag_idx[idx] = std::make_pair(h_tag.data[idx], idx);
+        }
+    std::sort(tag_idx.begin(), tag_idx.end());
+
+    std::vector<unsigned int> indices(m_nparticles);
+    for (unsigned int snap_id = 0; snap_id < m_nparticles; snap_id++)
+        {
+        index.insert(std::make_pair(tag_idx[snap_id].first, snap_id));
+        indices[snap_id] = tag_idx[snap_id].second;
+        }
+
+    fillSnapshot(snapshot, indices);
+
+    snapshot.type_mapping = m_type_mapping;
+    snapshot.is_accel_set = m_accel_set;
+
+    return index;
+    }
+
+/*! \param snapshot The snapshot to write to
+    \param indices Local indices of the particles to copy
+
+    The snapshot is resized to the number of indices. The positions are wrapped into the global
+    box, as in takeSnapshot().
+*/
+template<class Real>
+void ParticleData::fillSnapshot(SnapshotParticleData<Real>& snapshot,
+                                const std::vector<unsigned int>& indices)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_orientation, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::read);
+
+    snapshot.resize((unsigned int)indices.size());
+    for (unsigned int snap_id = 0; snap_id < indices.size(); snap_id++)
+        {
+        unsigned int idx = indices[snap_id];
+        assert(idx < m_nparticles);
+
+        snapshot.pos[snap_id] = vec3<Real>(
+            make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin);
+        snapshot.vel[snap_id]
+            = vec3<Real>(make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z));
+        snapshot.accel[snap_id] = vec3<Real>(h_accel.data[idx]);
+        snapshot.type[snap_id] = __scalar_as_int(h_pos.data[idx].w);
+        snapshot.mass[snap_id] = Real(h_vel.data[idx].w);
+        snapshot.charge[snap_id] = Real(h_charge.data[idx]);
+        snapshot.diameter[snap_id] = Real(h_diameter.data[idx]);
+        snapshot.image[snap_id] = h_image.data[idx];
+        snapshot.image[snap_id].x -= m_o_image.x;
+        snapshot.image[snap_id].y -= m_o_image.y;
+        snapshot.image[snap_id].z -= m_o_image.z;
+        snapshot.body[snap_id] = h_body.data[idx];
+        snapshot.orientation[snap_id] = quat<Real>(h_orientation.data[idx]);
+        snapshot.angmom[snap_id] = quat<Real>(h_angmom.data[idx]);
+        snapshot.inertia[snap_id] = vec3<Real>(h_inertia.data[idx]);
+
+        // make sure the position stored in the snapshot is within the boundaries
+        Scalar3 tmp = vec_to_scalar3(snapshot.pos[snap_id]);
+        m_global_box.wrap(tmp, snapshot.image[snap_id]);
+        snapshot.pos[snap_id] = vec3<Real>(tmp);
+        }
+    }
+
+#ifdef ENABLE_MPI
+//! Gather one field of the snapshots of all ranks on the root rank
+template<class Real, class T>
+static void gatherSnapshotField(const SnapshotParticleData<Real>& local,
+                                std::vector<SnapshotParticleData<Real>>& local_proc,
+                                std::vector<T> SnapshotParticleData<Real>::*field,
+                                unsigned int root,
+                                const MPI_Comm mpi_comm)
+    {
+    std::vector<std::vector<T>> field_proc;
+    gather_v(local.*field, field_proc, root, mpi_comm);
+    for (unsigned int i = 0; i < field_proc.size(); i++)
+        local_proc[i].*field = std::move(field_proc[i]);
+    }
+
+//! Copy the fields of one particle that are present in the destination snapshot
+template<class Real>
+static void copySnapshotElement(SnapshotParticleData<Real>& dst,
+                                unsigned int j,
+                                const SnapshotParticleData<Real>& src,
+                                unsigned int i)
+    {
+    dst.pos[j] = src.pos[i];
+    dst.type[j] = src.type[i];
+    if (!dst.isOmitted(snapshot_field::velocity))
+        dst.vel[j] = src.vel[i];
+    if (!dst.isOmitted(snapshot_field::acceleration))
+        dst.accel[j] = src.accel[i];
+    if (!dst.isOmitted(snapshot_field::mass))
+        dst.mass[j] = src.mass[i];
+    if (!dst.isOmitted(snapshot_field::charge))
+        dst.charge[j] = src.charge[i];
+    if (!dst.isOmitted(snapshot_field::diameter))
+        dst.diameter[j] = src.diameter[i];
+    if (!dst.isOmitted(snapshot_field::image))
+        dst.image[j] = src.image[i];
+    if (!dst.isOmitted(snapshot_field::body))
+        dst.body[j] = src.body[i];
+    if (!dst.isOmitted(snapshot_field::orientation))
+        dst.orientation[j] = src.orientation[i];
+    if (!dst.isOmitted(snapshot_field::angmom))
+        dst.angmom[j] = src.angmom[i];
+    if (!dst.isOmitted(snapshot_field::moment_inertia))
+        dst.inertia[j] = src.inertia[i];
+    }
+#endif
+
+//! take a snapshot of the particles in a range of tags
+/* \param snapshot The snapshot to write to
+   \param tag_begin First tag of the range
+   \param tag_end One past the last tag of the range
+   \returns The tags of the particles in the snapshot, in ascending order
+
+   The snapshot contains the particles with tags in [tag_begin, tag_end) in ascending tag order.
+   Only these particles are gathered on the root rank, so a large system can be read in chunks with
+   memory proportional to the chunk size. Fields in which all particles of the chunk hold the
+   default value are omitted (see SnapshotParticleData::default_fields).
+
+   All ranks must call this method with the same range. The snapshot is empty on the other ranks.
+*/
+template<class Real>
+std::vector<unsigned int> ParticleData::takeSnapshotChunk(SnapshotParticleData<Real>& snapshot,
+                                                          unsigned int tag_begin,
+                                                          unsigned int tag_end)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: taking snapshot of tags " << tag_begin
+                                << " to " << tag_end << std::endl;
+
+    // find the local particles in the range through the reverse tags, in tag order
+    std::vector<unsigned int> tags;
+    std::vector<unsigned int> indices;
+        {
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::read);
+        tag_end = std::min(tag_end, (unsigned int)m_rtag.size());
+        for (unsigned int tag = tag_begin; tag < tag_end; tag++)
+            {
+            unsigned int idx = h_rtag.data[tag];
+            if (idx < m_nparticles)
+                {
+                tags.push_back(tag);
+                indices.push_back(idx);
+                }
+            }
+        }
+
+    SnapshotParticleData<Real> local;
+    fillSnapshot(local, indices);
+    unsigned int default_fields = local.findDefaultFields();
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+        unsigned int root = 0;
+
+        // omit a field only when it holds the default value on all ranks
+        MPI_Allreduce(MPI_IN_PLACE, &default_fields, 1, MPI_UNSIGNED, MPI_BAND, mpi_comm);
+        local.resizeOmitting(local.size, default_fields);
+
+        // collect the particles in the range on the root processor, omitted fields are empty
+        std::vector<std::vector<unsigned int>> tags_proc;
+        std::vector<SnapshotParticleData<Real>> local_proc(n_ranks);
+        gather_v(tags, tags_proc, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::pos, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::vel, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::accel, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::type, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::mass, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::charge, root, mpi_comm);
+        gatherSnapshotField(local,
+                            local_proc,
+                            &SnapshotParticleData<Real>::diameter,
+                            root,
+                            mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::image, root, mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::body, root, mpi_comm);
+        gatherSnapshotField(local,
+                            local_proc,
+                            &SnapshotParticleData<Real>::orientation,
+                            root,
+                            mpi_comm);
+        gatherSnapshotField(local, local_proc, &SnapshotParticleData<Real>::angmom, root, mpi_comm);
+        gatherSnapshotField(local,
+                            local_proc,
+                            &SnapshotParticleData<Real>::inertia,
+                            root,
+                            mpi_comm);
+
+        tags.clear();
+        if (m_exec_conf->getRank() == root)
+            {
+            // merge the particles of all ranks in tag order
+            std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> order;
+            for (unsigned int irank = 0; irank < n_ranks; irank++)
+                for (unsigned int i = 0; i < tags_proc[irank].size(); i++)
+                    order.push_back(std::make_tuple(tags_proc[irank][i], irank, i));
+            std::sort(order.begin(), order.end());
+
+            snapshot.resizeOmitting((unsigned int)order.size(), default_fields);
+            tags.resize(order.size());
+            for (unsigned int snap_id = 0; snap_id < order.size(); snap_id++)
+                {
+                tags[snap_id] = std::get<0>(order[snap_id]);
+                copySnapshotElement(snapshot,
+                                    snap_id,
+                                    local_proc[std::get<1>(order[snap_id])],
+                                    std::get<2>(order[snap_id]));
+                }
+            }
+        else
+            {
+            snapshot.resizeOmitting(0, default_fields);
+            }
+        }
+    else
+#endif
+        {
+        local.resizeOmitting(local.size, default_fields);
+        snapshot = std::move(local);
+        }
+
+    snapshot.type_mapping = m_type_mapping;
+    snapshot.is_accel_set = m_accel_set;
+
+    return tags;
+    }
+
+/*! \param tag_begin First tag of the range
+    \param tag_end One past the last tag of the range
+    \returns A tuple of the tags in the chunk and the snapshot of the chunk
+*/
+pybind11::tuple ParticleData::takeSnapshotChunkPy(unsigned int tag_begin, unsigned int tag_end)
+    {
+    auto snapshot = std::make_shared<SnapshotParticleData<double>>();
+    std::vector<unsigned int> tags = takeSnapshotChunk(*snapshot, tag_begin, tag_end);
+    return pybind11::make_tuple(pybind11::array_t<unsigned int>(tags.size(), tags.data()),
+                                snapshot);
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -2685,6 +3119,8 @@ void export_BoxDim(py::module& m)
         .def("getTiltFactorXY", &BoxDim::getTiltFactorXY)
         .def("getTiltFactorXZ", &BoxDim::getTiltFactorXZ)
         .def("getTiltFactorYZ", &BoxDim::getTiltFactorYZ)
+        .def("setLeesEdwardsOffset", &BoxDim::setLeesEdwardsOffset)
+        .def("getLeesEdwardsOffset", &BoxDim::getLeesEdwardsOffset)
         .def("getLatticeVector", &BoxDim::getLatticeVector)
         .def("wrap", wrap_overload)
         .def("minImage", minImage_overload)
@@ -2714,6 +3150,12 @@ ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double>&
                                              bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template std::map<unsigned int, unsigned int>
+ParticleData::takeLocalSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template std::vector<unsigned int>
+ParticleData::takeSnapshotChunk<double>(SnapshotParticleData<double>& snapshot,
+                                     unsigned int tag_begin,
+                                     unsigned int tag_end);
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                     const BoxDim& global_box,
@@ -2724,6 +3166,12 @@ ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float>& s
                                             bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template std::map<unsigned int, unsigned int>
+ParticleData::takeLocalSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template std::vector<unsigned int>
+ParticleData::takeSnapshotChunk<float>(SnapshotParticleData<float>& snapshot,
+                                     unsigned int tag_begin,
+                                     unsigned int tag_end);
 
 void export_ParticleData(py::module& m)
     {
@@ -2780,6 +3228,7 @@ void export_ParticleData(py::module& m)
         .def("addParticle", &ParticleData::addParticle)
         .def("removeParticle", &ParticleData::removeParticle)
         .def("getNthTag", &ParticleData::getNthTag)
+        .def("takeSnapshotChunk", &ParticleData::takeSnapshotChunkPy)
 #ifdef ENABLE_MPI
         .def("setDomainDecomposition", &ParticleData::setDomainDecomposition)
         .def("getDomainDecomposition", &ParticleData::getDomainDecomposition)
@@ -2789,32 +3238,123 @@ void export_ParticleData(py::module& m)
 
 //! Constructor for SnapshotParticleData
 template<class Real>
-SnapshotParticleData<Real>::SnapshotParticleData(unsigned int N) : size(N), is_accel_set(false)
+SnapshotParticleData<Real>::SnapshotParticleData(unsigned int N)
+    : size(N), is_accel_set(false), default_fields(0)
     {
     resize(N);
     }
 
 template<class Real> void SnapshotParticleData<Real>::resize(unsigned int N)
     {
+    resizeOmitting(N, 0);
+    }
+
+//! Resize a snapshot field, or release its memory when the field is omitted
+template<class T>
+static void resizeSnapshotField(std::vector<T>& field, unsigned int N, const T& value, bool omit)
+    {
+    if (omit)
+        std::vector<T>().swap(field);
+    else
+        field.resize(N, value);
+    }
+
+/*! Omitted fields that were present before are released. Present fields that were omitted before
+    are filled with the default values.
+*/
+template<class Real>
+void SnapshotParticleData<Real>::resizeOmitting(unsigned int N, unsigned int fields)
+    {
+    default_fields = fields;
+
     pos.resize(N, vec3<Real>(0.0, 0.0, 0.0));
-    vel.resize(N, vec3<Real>(0.0, 0.0, 0.0));
-    accel.resize(N, vec3<Real>(0.0, 0.0, 0.0));
     type.resize(N, 0);
-    mass.resize(N, Scalar(1.0));
-    charge.resize(N, Scalar(0.0));
-    diameter.resize(N, Scalar(1.0));
-    image.resize(N, make_int3(0, 0, 0));
-    body.resize(N, NO_BODY);
-    orientation.resize(N, quat<Real>(1.0, vec3<Real>(0.0, 0.0, 0.0)));
-    angmom.resize(N, quat<Real>(0.0, vec3<Real>(0.0, 0.0, 0.0)));
-    inertia.resize(N, vec3<Real>(0.0, 0.0, 0.0));
+    resizeSnapshotField(vel, N, vec3<Real>(0.0, 0.0, 0.0), isOmitted(snapshot_field::velocity));
+    resizeSnapshotField(accel,
+                        N,
+                        vec3<Real>(0.0, 0.0, 0.0),
+                        isOmitted(snapshot_field::acceleration));
+    resizeSnapshotField(mass, N, Real(1.0), isOmitted(snapshot_field::mass));
+    resizeSnapshotField(charge, N, Real(0.0), isOmitted(snapshot_field::charge));
+    resizeSnapshotField(diameter, N, Real(1.0), isOmitted(snapshot_field::diameter));
+    resizeSnapshotField(image, N, make_int3(0, 0, 0), isOmitted(snapshot_field::image));
+    resizeSnapshotField(body, N, NO_BODY, isOmitted(snapshot_field::body));
+    resizeSnapshotField(orientation,
+                        N,
+                        quat<Real>(1.0, vec3<Real>(0.0, 0.0, 0.0)),
+                        isOmitted(snapshot_field::orientation));
+    resizeSnapshotField(angmom,
+                        N,
+                        quat<Real>(0.0, vec3<Real>(0.0, 0.0, 0.0)),
+                        isOmitted(snapshot_field::angmom));
+    resizeSnapshotField(inertia,
+                        N,
+                        vec3<Real>(0.0, 0.0, 0.0),
+                        isOmitted(snapshot_field::moment_inertia));
     size = N;
     is_accel_set = false;
     }
 
+//! Test whether all values of a snapshot field equal the default value
+template<class T> static bool isDefaultField(const std::vector<T>& field, const T& value)
+    {
+    return std::all_of(field.begin(), field.end(), [&value](const T& v) { return v == value; });
+    }
+
+template<class Real>
+static bool isDefaultField(const std::vector<quat<Real>>& field, const quat<Real>& value)
+    {
+    return std::all_of(field.begin(),
+                       field.end(),
+                       [&value](const quat<Real>& q) { return q.s == value.s && q.v == value.v; });
+    }
+
+static bool isDefaultField(const std::vector<int3>& field, const int3& value)
+    {
+    return std::all_of(field.begin(),
+                       field.end(),
+                       [&value](const int3& v)
+                       { return v.x == value.x && v.y == value.y && v.z == value.z; });
+    }
+
+template<class Real> unsigned int SnapshotParticleData<Real>::findDefaultFields() const
+    {
+    // omitted fields are empty, and pass trivially
+    unsigned int fields = 0;
+    if (isDefaultField(vel, vec3<Real>(0.0, 0.0, 0.0)))
+        fields |= 1u << snapshot_field::velocity;
+    if (isDefaultField(accel, vec3<Real>(0.0, 0.0, 0.0)))
+        fields |= 1u << snapshot_field::acceleration;
+    if (isDefaultField(mass, Real(1.0)))
+        fields |= 1u << snapshot_field::mass;
+    if (isDefaultField(charge, Real(0.0)))
+        fields |= 1u << snapshot_field::charge;
+    if (isDefaultField(diameter, Real(1.0)))
+        fields |= 1u << snapshot_field::diameter;
+    if (isDefaultField(image, make_int3(0, 0, 0)))
+        fields |= 1u << snapshot_field::image;
+    if (isDefaultField(body, NO_BODY))
+        fields |= 1u << snapshot_field::body;
+    if (isDefaultField(orientation, quat<Real>(1.0, vec3<Real>(0.0, 0.0, 0.0))))
+        fields |= 1u << snapshot_field::orientation;
+    if (isDefaultField(angmom, quat<Real>(0.0, vec3<Real>(0.0, 0.0, 0.0))))
+        fields |= 1u << snapshot_field::angmom;
+    if (isDefaultField(inertia, vec3<Real>(0.0, 0.0, 0.0)))
+        fields |= 1u << snapshot_field::moment_inertia;
+    return fields;
+    }
+
+template<class Real> void SnapshotParticleData<Real>::expandDefaultFields()
+    {
+    bool accel_set = is_accel_set;
+    resizeOmitting(size, 0);
+    is_accel_set = accel_set;
+    }
+
 template<class Real> void SnapshotParticleData<Real>::insert(unsigned int i, unsigned int n)
     {
     assert(i <= size);
+    expandDefaultFields();
     pos.insert(pos.begin() + i, n, vec3<Real>(0.0, 0.0, 0.0));
     vel.insert(vel.begin() + i, n, vec3<Real>(0.0, 0.0, 0.0));
     accel.insert(accel.begin() + i, n, vec3<Real>(0.0, 0.0, 0.0));
@@ -2863,6 +3403,9 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
     if (m_prof)
         m_prof->push("pack");
 
+    // the remaining particles are compacted into the alternate arrays
+    checkAlternateArrays();
+
     unsigned int num_remove_ptls = 0;
 
         {
@@ -2910,6 +3453,9 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
         ArrayHandle<unsigned int> h_body(getBodies(),
                                          access_location::host,
                                          access_mode::readwrite);
+        ArrayHandle<unsigned int> h_group_bits(getGroupBits(),
+                                               access_location::host,
+                                               access_mode::readwrite);
         ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
                                            access_location::host,
                                            access_mode::readwrite);
@@ -2952,6 +3498,9 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
         ArrayHandle<unsigned int> h_body_alt(m_body_alt,
                                              access_location::host,
                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_bits_alt(m_group_bits_alt,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
         ArrayHandle<Scalar4> h_orientation_alt(m_orientation_alt,
                                                access_location::host,
                                                access_mode::overwrite);
@@ -2990,6 +3539,7 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
                 h_diameter_alt.data[n] = h_diameter.data[i];
                 h_image_alt.data[n] = h_image.data[i];
                 h_body_alt.data[n] = h_body.data[i];
+                h_group_bits_alt.data[n] = h_group_bits.data[i];
                 h_orientation_alt.data[n] = h_orientation.data[i];
                 h_angmom_alt.data[n] = h_angmom.data[i];
                 h_inertia_alt.data[n] = h_inertia.data[i];
@@ -3012,6 +3562,7 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
                 p.diameter = h_diameter.data[i];
                 p.image = h_image.data[i];
                 p.body = h_body.data[i];
+                p.group_bits = h_group_bits.data[i];
                 p.orientation = h_orientation.data[i];
                 p.angmom = h_angmom.data[i];
                 p.inertia = h_inertia.data[i];
@@ -3042,6 +3593,7 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
     swapDiameters();
     swapImages();
     swapBodies();
+    swapGroupBits();
     swapOrientations();
     swapAngularMomenta();
     swapMomentsOfInertia();
@@ -3100,6 +3652,9 @@ void ParticleData::addParticles(const std::vector<pdata_element>& in)
         ArrayHandle<unsigned int> h_body(getBodies(),
                                          access_location::host,
                                          access_mode::readwrite);
+        ArrayHandle<unsigned int> h_group_bits(getGroupBits(),
+                                               access_location::host,
+                                               access_mode::readwrite);
         ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
                                            access_location::host,
                                            access_mode::readwrite);
@@ -3137,6 +3692,7 @@ void ParticleData::addParticles(const std::vector<pdata_element>& in)
             h_diameter.data[n] = p.diameter;
             h_image.data[n] = p.image;
             h_body.data[n] = p.body;
+            h_group_bits.data[n] = p.group_bits;
             h_orientation.data[n] = p.orientation;
             h_angmom.data[n] = p.angmom;
             h_inertia.data[n] = p.inertia;
@@ -3180,6 +3736,9 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
     if (m_prof)
         m_prof->push(m_exec_conf, "pack");
 
+    // the remaining particles are compacted into the alternate arrays
+    checkAlternateArrays();
+
     // this is the maximum number of elements we can possibly write to out
     unsigned int max_n_out = (unsigned int)out.getNumElements();
     if (comm_flags.getNumElements() < max_n_out)
@@ -3213,6 +3772,9 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
         ArrayHandle<Scalar> d_diameter(getDiameters(), access_location::device, access_mode::read);
         ArrayHandle<int3> d_image(getImages(), access_location::device, access_mode::read);
         ArrayHandle<unsigned int> d_body(getBodies(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_group_bits(getGroupBits(),
+                                               access_location::device,
+                                               access_mode::read);
         ArrayHandle<Scalar4> d_orientation(getOrientationArray(),
                                            access_location::device,
                                            access_mode::read);
@@ -3247,6 +3809,9 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
         ArrayHandle<unsigned int> d_body_alt(m_body_alt,
                                              access_location::device,
                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> d_group_bits_alt(m_group_bits_alt,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
         ArrayHandle<Scalar4> d_orientation_alt(m_orientation_alt,
                                                access_location::device,
                                                access_mode::overwrite);
@@ -3298,6 +3863,7 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
                                      d_diameter.data,
                                      d_image.data,
                                      d_body.data,
+                                     d_group_bits.data,
                                      d_orientation.data,
                                      d_angmom.data,
                                      d_inertia.data,
@@ -3314,6 +3880,7 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
                                      d_diameter_alt.data,
                                      d_image_alt.data,
                                      d_body_alt.data,
+                                     d_group_bits_alt.data,
                                      d_orientation_alt.data,
                                      d_angmom_alt.data,
                                      d_inertia_alt.data,
@@ -3359,6 +3926,7 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
     swapDiameters();
     swapImages();
     swapBodies();
+    swapGroupBits();
     swapOrientations();
     swapAngularMomenta();
     swapMomentsOfInertia();
@@ -3404,6 +3972,9 @@ void ParticleData::addParticlesGPU(const GlobalVector<pdata_element>& in)
         ArrayHandle<unsigned int> d_body(getBodies(),
                                          access_location::device,
                                          access_mode::readwrite);
+        ArrayHandle<unsigned int> d_group_bits(getGroupBits(),
+                                               access_location::device,
+                                               access_mode::readwrite);
         ArrayHandle<Scalar4> d_orientation(getOrientationArray(),
                                            access_location::device,
                                            access_mode::readwrite);
@@ -3443,6 +4014,7 @@ void ParticleData::addParticlesGPU(const GlobalVector<pdata_element>& in)
                                 d_diameter.data,
                                 d_image.data,
                                 d_body.data,
+                                d_group_bits.data,
                                 d_orientation.data,
                                 d_angmom.data,
                                 d_inertia.data,
@@ -3526,6 +4098,10 @@ void ParticleData::setGPUAdvice()
                           sizeof(unsigned int) * nelem,
                           cudaMemAdviseSetPreferredLocation,
                           gpu_map[idev]);
+            cudaMemAdvise(m_group_bits.get() + range.first,
+                          sizeof(unsigned int) * nelem,
+                          cudaMemAdviseSetPreferredLocation,
+                          gpu_map[idev]);
             cudaMemAdvise(m_orientation.get() + range.first,
                           sizeof(Scalar4) * nelem,
                           cudaMemAdviseSetPreferredLocation,
@@ -3571,6 +4147,9 @@ void ParticleData::setGPUAdvice()
             cudaMemPrefetchAsync(m_body.get() + range.first,
                                  sizeof(unsigned int) * nelem,
                                  gpu_map[idev]);
+            cudaMemPrefetchAsync(m_group_bits.get() + range.first,
+                                 sizeof(unsigned int) * nelem,
+                                 gpu_map[idev]);
             cudaMemPrefetchAsync(m_orientation.get() + range.first,
                                  sizeof(Scalar4) * nelem,
                                  gpu_map[idev]);
@@ -3635,6 +4214,10 @@ void ParticleData::setGPUAdvice()
                               sizeof(unsigned int) * nelem,
                               cudaMemAdviseSetPreferredLocation,
                               gpu_map[idev]);
+                cudaMemAdvise(m_group_bits_alt.get() + range.first,
+                              sizeof(unsigned int) * nelem,
+                              cudaMemAdviseSetPreferredLocation,
+                              gpu_map[idev]);
                 cudaMemAdvise(m_orientation_alt.get() + range.first,
                               sizeof(Scalar4) * nelem,
                               cudaMemAdviseSetPreferredLocation,
@@ -3686,6 +4269,9 @@ void ParticleData::setGPUAdvice()
                 cudaMemPrefetchAsync(m_body_alt.get() + range.first,
                                      sizeof(unsigned int) * nelem,
                                      gpu_map[idev]);
+                cudaMemPrefetchAsync(m_group_bits_alt.get() + range.first,
+                                     sizeof(unsigned int) * nelem,
+                                     gpu_map[idev]);
                 cudaMemPrefetchAsync(m_orientation_alt.get() + range.first,
                                      sizeof(Scalar4) * nelem,
                                      gpu_map[idev]);
@@ -3785,6 +4371,17 @@ void SnapshotParticleData<Real>::replicate(unsigned int nx,
         }
     }
 
+//! Make a read-only numpy array that repeats the default value of an omitted snapshot field
+/*! \param N Number of particles
+    \param value Default value of one particle
+*/
+template<class T> static py::object defaultFieldNP(unsigned int N, const std::vector<T>& value)
+    {
+    py::array_t<T> row(value.size(), value.data());
+    py::tuple shape = value.size() > 1 ? py::make_tuple(N, value.size()) : py::make_tuple(N);
+    return py::module::import("numpy").attr("broadcast_to")(row, shape);
+    }
+
 /*! \returns a numpy array that wraps the pos data element.
     The raw data is referenced by the numpy array, modifications to the numpy array will modify the
    snapshot
@@ -3811,6 +4408,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getVelNP(pybind11::o
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::velocity))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {0, 0, 0});
+
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
     dims[1] = 3;
@@ -3827,6 +4427,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getAccelNP(pybind11:
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::acceleration))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {0, 0, 0});
+
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
     dims[1] = 3;
@@ -3856,6 +4459,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getMassNP(pybind11::
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::mass))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {1});
+
     return pybind11::array(self_cpp->mass.size(), &self_cpp->mass[0], self);
     }
 
@@ -3869,6 +4475,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getChargeNP(pybind11
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::charge))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {0});
+
     return pybind11::array(self_cpp->charge.size(), &self_cpp->charge[0], self);
     }
 
@@ -3882,6 +4491,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getDiameterNP(pybind
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::diameter))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {1});
+
     return pybind11::array(self_cpp->diameter.size(), &self_cpp->diameter[0], self);
     }
 
@@ -3895,6 +4507,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getImageNP(pybind11:
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::image))
+        return defaultFieldNP(self_cpp->size, std::vector<int> {0, 0, 0});
+
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
     dims[1] = 3;
@@ -3911,6 +4526,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getBodyNP(pybind11::
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::body))
+        return defaultFieldNP(self_cpp->size, std::vector<int> {int(NO_BODY)});
+
     return pybind11::array(self_cpp->body.size(), (int*)&self_cpp->body[0], self);
     }
 
@@ -3924,6 +4542,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getOrientationNP(pyb
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::orientation))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {1, 0, 0, 0});
+
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
     dims[1] = 4;
@@ -3941,6 +4562,9 @@ py::object SnapshotParticleData<Real>::getMomentInertiaNP(pybind11::object self)
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::moment_inertia))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {0, 0, 0});
+
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->inertia.size();
     dims[1] = 3;
@@ -3957,6 +4581,9 @@ template<class Real> py::object SnapshotParticleData<Real>::getAngmomNP(pybind11
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
 
+    if (self_cpp->isOmitted(snapshot_field::angmom))
+        return defaultFieldNP(self_cpp->size, std::vector<Real> {0, 0, 0, 0});
+
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->angmom.size();
     dims[1] = 4;
@@ -4008,6 +4635,7 @@ template<class Real> void SnapshotParticleData<Real>::bcast(unsigned int root, M
     ::bcast(size, root, mpi_comm);
     ::bcast(type_mapping, root, mpi_comm);
     ::bcast(is_accel_set, root, mpi_comm);
+    ::bcast(default_fields, root, mpi_comm);
     }
 #endif
 
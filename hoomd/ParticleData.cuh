@@ -32,20 +32,21 @@ const unsigned int NOT_LOCAL = 0xffffffff;
 //! Compact particle data storage
 struct pdata_element
     {
-    Scalar4 pos;          //!< Position
-    Scalar4 vel;          //!< Velocity
-    Scalar3 accel;        //!< Acceleration
-    Scalar charge;        //!< Charge
-    Scalar diameter;      //!< Diameter
-    int3 image;           //!< Image
-    unsigned int body;    //!< Body id
-    Scalar4 orientation;  //!< Orientation
-    Scalar4 angmom;       //!< Angular momentum
-    Scalar3 inertia;      //!< Moments of inertia
-    unsigned int tag;     //!< global tag
-    Scalar4 net_force;    //!< net force
-    Scalar4 net_torque;   //!< net torque
-    Scalar net_virial[6]; //!< net virial
+    Scalar4 pos;             //!< Position
+    Scalar4 vel;             //!< Velocity
+    Scalar3 accel;           //!< Acceleration
+    Scalar charge;           //!< Charge
+    Scalar diameter;         //!< Diameter
+    int3 image;              //!< Image
+    unsigned int body;       //!< Body id
+    unsigned int group_bits; //!< Group membership bits
+    Scalar4 orientation;     //!< Orientation
+    Scalar4 angmom;          //!< Angular momentum
+    Scalar3 inertia;         //!< Moments of inertia
+    unsigned int tag;        //!< global tag
+    Scalar4 net_force;       //!< net force
+    Scalar4 net_torque;      //!< net torque
+    Scalar net_virial[6];    //!< net virial
     };
 #else
 //! Forward declaration
@@ -61,6 +62,7 @@ unsigned int gpu_pdata_remove(const unsigned int N,
                               const Scalar* d_diameter,
                               const int3* d_image,
                               const unsigned int* d_body,
+                              const unsigned int* d_group_bits,
                               const Scalar4* d_orientation,
                               const Scalar4* d_angmom,
                               const Scalar3* d_inertia,
@@ -77,6 +79,7 @@ unsigned int gpu_pdata_remove(const unsigned int N,
                               Scalar* d_diameter_alt,
                               int3* d_image_alt,
                               unsigned int* d_body_alt,
+                              unsigned int* d_group_bits_alt,
                               Scalar4* d_orientation_alt,
                               Scalar4* d_angmom_alt,
                               Scalar3* d_inertia_alt,
@@ -102,6 +105,7 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
                              Scalar* d_diameter,
                              int3* d_image,
                              unsigned int* d_body,
+                             unsigned int* d_group_bits,
                              Scalar4* d_orientation,
                              Scalar4* d_angmom,
                              Scalar3* d_inertia,
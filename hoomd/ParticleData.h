@@ -81,8 +81,10 @@ struct pdata_flag
         {
         pressure_tensor = 0,       //!< Bit id in PDataFlags for the full virial
         rotational_kinetic_energy, //!< Bit id in PDataFlags for the rotational kinetic energy
-        external_field_virial      //!< Bit id in PDataFlags for the external virial contribution of
+        external_field_virial,     //!< Bit id in PDataFlags for the external virial contribution of
                                    //!< volume change
+        force_arrays               //!< Bit id in PDataFlags for the force arrays of each
+                                   //!< ForceCompute
         };
     };
 
@@ -108,6 +110,9 @@ const unsigned int NO_BODY = 0xffffffff;
 //! indicate a floppy body (forces between are ignored, but they are integrated independently).
 const unsigned int MIN_FLOPPY = 0x80000000;
 
+//! Sentinel value returned by ParticleData::acquireGroupBit() when all group bits are in use
+const unsigned int NO_GROUP_BIT = 0xffffffff;
+
 //! Sentinel value in \a r_tag to signify that this particle is not currently present on the local
 //! processor
 const unsigned int NOT_LOCAL = 0xffffffff;
@@ -138,6 +143,26 @@ void serialize(Archive& ar, quat<Real>& q, const unsigned int version)
 /// Get a default type name given a type id
 std::string getDefaultTypeName(unsigned int id);
 
+//! Per-particle fields of a snapshot that may be omitted when all particles hold the default value
+struct snapshot_field
+    {
+    //! The enum
+    enum Enum
+        {
+        velocity = 0,   //!< Bit id of the velocities
+        acceleration,   //!< Bit id of the accelerations
+        mass,           //!< Bit id of the masses
+        charge,         //!< Bit id of the charges
+        diameter,       //!< Bit id of the diameters
+        image,          //!< Bit id of the images
+        body,           //!< Bit id of the body ids
+        orientation,    //!< Bit id of the orientations
+        angmom,         //!< Bit id of the angular momenta
+        moment_inertia, //!< Bit id of the moments of inertia
+        num_fields      //!< Number of fields
+        };
+    };
+
 //! Handy structure for passing around per-particle data
 /*! A snapshot is used for two purposes:
  * - Initializing the ParticleData
@@ -150,12 +175,17 @@ std::string getDefaultTypeName(unsigned int id);
  * using ParticleData::initializeFromSnapshot().
  *
  * To support the second scenario it is necessary that particles can be accessed in global tag
- * order. Therefore, the data in a snapshot is stored in global tag order. \ingroup data_structs
+ * order. Therefore, the data in a snapshot is stored in global tag order.
+ *
+ * ParticleData::takeSnapshotChunk() omits the fields in which all particles hold the default value
+ * and records them in default_fields. The omitted fields are empty vectors, and python reads them
+ * as read-only arrays of the default value. Call expandDefaultFields() before modifying such a
+ * snapshot or initializing from it. \ingroup data_structs
  */
 template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
     {
     //! Empty snapshot
-    SnapshotParticleData() : size(0), is_accel_set(false) { }
+    SnapshotParticleData() : size(0), is_accel_set(false), default_fields(0) { }
 
     //! constructor
     /*! \param N number of particles to allocate memory for
@@ -167,6 +197,26 @@ template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
      */
     void resize(unsigned int N);
 
+    //! Resize the snapshot and omit fields that hold the default values
+    /*! \param N number of particles in snapshot
+        \param fields Bit mask of snapshot_field ids to omit
+     */
+    void resizeOmitting(unsigned int N, unsigned int fields);
+
+    //! Find the fields that hold the default value for all particles
+    /*! \returns A bit mask of snapshot_field ids
+     */
+    unsigned int findDefaultFields() const;
+
+    //! Allocate the omitted fields and fill them with the default values
+    void expandDefaultFields();
+
+    //! Test whether a field is omitted
+    bool isOmitted(snapshot_field::Enum field) const
+        {
+        return default_fields & (1u << field);
+        }
+
     unsigned int getSize()
         {
         return size;
@@ -248,6 +298,10 @@ template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
     std::vector<std::string> type_mapping; //!< Mapping between particle type ids and names
 
     bool is_accel_set; //!< Flag indicating if accel is set
+
+    //! Bit mask of snapshot_field ids that are omitted (empty) because all particles hold the
+    //! default value
+    unsigned int default_fields;
     };
 
 //! Structure to store packed particle data
@@ -255,20 +309,33 @@ template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
  */
 struct pdata_element
     {
-    Scalar4 pos;          //!< Position
-    Scalar4 vel;          //!< Velocity
-    Scalar3 accel;        //!< Acceleration
-    Scalar charge;        //!< Charge
-    Scalar diameter;      //!< Diameter
-    int3 image;           //!< Image
-    unsigned int body;    //!< Body id
-    Scalar4 orientation;  //!< Orientation
-    Scalar4 angmom;       //!< Angular momentum
-    Scalar3 inertia;      //!< Principal moments of inertia
-    unsigned int tag;     //!< global tag
-    Scalar4 net_force;    //!< net force
-    Scalar4 net_torque;   //!< net torque
-    Scalar net_virial[6]; //!< net virial
+    Scalar4 pos;             //!< Position
+    Scalar4 vel;             //!< Velocity
+    Scalar3 accel;           //!< Acceleration
+    Scalar charge;           //!< Charge
+    Scalar diameter;         //!< Diameter
+    int3 image;              //!< Image
+    unsigned int body;       //!< Body id
+    unsigned int group_bits; //!< Group membership bits
+    Scalar4 orientation;     //!< Orientation
+    Scalar4 angmom;          //!< Angular momentum
+    Scalar3 inertia;         //!< Principal moments of inertia
+    unsigned int tag;        //!< global tag
+    Scalar4 net_force;       //!< net force
+    Scalar4 net_torque;      //!< net torque
+    Scalar net_virial[6];    //!< net virial
+    };
+
+//! Structure of arrays copy of the particle positions and types
+/*! Host-side mirror of ParticleData::getPositions() with each component stored in a separate
+    contiguous array. Entries cover the local and ghost particles in the same order.
+ */
+struct pdata_positions_soa
+    {
+    std::vector<Scalar> x;          //!< x coordinates
+    std::vector<Scalar> y;          //!< y coordinates
+    std::vector<Scalar> z;          //!< z coordinates
+    std::vector<unsigned int> type; //!< Type ids
     };
 
 //! Manages all of the data arrays for the particles
@@ -405,6 +472,15 @@ struct pdata_element
    zeroes it. TODO: This might not be sufficient for simulations where the box size changes. We'll
    see in testing.
 
+    ## Structure of arrays positions
+
+    CPU kernels that process many neighbors per particle benefit from reading the x, y, and z
+   coordinates from separate contiguous arrays. getPositionsSoA() returns such a copy of the
+   positions and types of the local and ghost particles. The copy is rebuilt lazily: only when the
+   particle count changed or the position array was acquired with write access since the last call
+   (see GPUArrayBase::getWriteCount()), and after swapPositions() or a reallocation. It must be
+   requested while no ArrayHandle to the positions is held.
+
     ## Acceleration data
 
     Most initialization routines do not provide acceleration data. In this case, the integrator
@@ -525,6 +601,12 @@ class PYBIND11_EXPORT ParticleData
         return (unsigned int)(m_type_mapping.size());
         }
 
+    //! Get the names of the particle types
+    const std::vector<std::string>& getTypeMapping() const
+        {
+        return m_type_mapping;
+        }
+
     //! Get the origin for the particle system
     /*! \return origin of the system
      */
@@ -661,6 +743,39 @@ class PYBIND11_EXPORT ParticleData
         return m_body;
         }
 
+    //! Return group membership bits
+    /*! Bit \a b of element \a idx is set when the particle with index \a idx is a member of the
+        ParticleGroup that acquired bit \a b. The bits move with the particles when they are sorted
+        or migrate between ranks.
+    */
+    const GlobalArray<unsigned int>& getGroupBits() const
+        {
+        return m_group_bits;
+        }
+
+    //! Acquire a free group membership bit
+    /*! \returns The index of the bit, or NO_GROUP_BIT if all bits are in use
+     */
+    unsigned int acquireGroupBit()
+        {
+        for (unsigned int bit = 0; bit < sizeof(unsigned int) * 8; bit++)
+            {
+            if (!(m_group_bits_used & (1u << bit)))
+                {
+                m_group_bits_used |= 1u << bit;
+                return bit;
+                }
+            }
+        return NO_GROUP_BIT;
+        }
+
+    //! Release a group membership bit acquired with acquireGroupBit()
+    void releaseGroupBit(unsigned int bit)
+        {
+        if (bit != NO_GROUP_BIT)
+            m_group_bits_used &= ~(1u << bit);
+        }
+
     /*!
      * Access methods to stand-by arrays for fast swapping in of reordered particle data
      *
@@ -683,8 +798,9 @@ class PYBIND11_EXPORT ParticleData
      */
 
     //! Return positions and types (alternate array)
-    const GlobalArray<Scalar4>& getAltPositions() const
+    const GlobalArray<Scalar4>& getAltPositions()
         {
+        checkAlternateArrays();
         return m_pos_alt;
         }
 
@@ -692,11 +808,16 @@ class PYBIND11_EXPORT ParticleData
     inline void swapPositions()
         {
         m_pos.swap(m_pos_alt);
+        m_pos_soa_valid = false;
         }
 
+    //! Return a structure of arrays copy of the positions and types
+    const pdata_positions_soa& getPositionsSoA();
+
     //! Return velocities and masses (alternate array)
-    const GlobalArray<Scalar4>& getAltVelocities() const
+    const GlobalArray<Scalar4>& getAltVelocities()
         {
+        checkAlternateArrays();
         return m_vel_alt;
         }
 
@@ -707,8 +828,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return accelerations (alternate array)
-    const GlobalArray<Scalar3>& getAltAccelerations() const
+    const GlobalArray<Scalar3>& getAltAccelerations()
         {
+        checkAlternateArrays();
         return m_accel_alt;
         }
 
@@ -719,8 +841,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return charges (alternate array)
-    const GlobalArray<Scalar>& getAltCharges() const
+    const GlobalArray<Scalar>& getAltCharges()
         {
+        checkAlternateArrays();
         return m_charge_alt;
         }
 
@@ -731,8 +854,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return diameters (alternate array)
-    const GlobalArray<Scalar>& getAltDiameters() const
+    const GlobalArray<Scalar>& getAltDiameters()
         {
+        checkAlternateArrays();
         return m_diameter_alt;
         }
 
@@ -743,8 +867,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return images (alternate array)
-    const GlobalArray<int3>& getAltImages() const
+    const GlobalArray<int3>& getAltImages()
         {
+        checkAlternateArrays();
         return m_image_alt;
         }
 
@@ -755,8 +880,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return tags (alternate array)
-    const GlobalArray<unsigned int>& getAltTags() const
+    const GlobalArray<unsigned int>& getAltTags()
         {
+        checkAlternateArrays();
         return m_tag_alt;
         }
 
@@ -767,8 +893,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return body ids (alternate array)
-    const GlobalArray<unsigned int>& getAltBodies() const
+    const GlobalArray<unsigned int>& getAltBodies()
         {
+        checkAlternateArrays();
         return m_body_alt;
         }
 
@@ -778,9 +905,23 @@ class PYBIND11_EXPORT ParticleData
         m_body.swap(m_body_alt);
         }
 
+    //! Return group membership bits (alternate array)
+    const GlobalArray<unsigned int>& getAltGroupBits()
+        {
+        checkAlternateArrays();
+        return m_group_bits_alt;
+        }
+
+    //! Swap in group membership bits
+    inline void swapGroupBits()
+        {
+        m_group_bits.swap(m_group_bits_alt);
+        }
+
     //! Get the net force array (alternate array)
-    const GlobalArray<Scalar4>& getAltNetForce() const
+    const GlobalArray<Scalar4>& getAltNetForce()
         {
+        checkAlternateArrays();
         return m_net_force_alt;
         }
 
@@ -791,8 +932,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the net virial array (alternate array)
-    const GlobalArray<Scalar>& getAltNetVirial() const
+    const GlobalArray<Scalar>& getAltNetVirial()
         {
+        checkAlternateArrays();
         return m_net_virial_alt;
         }
 
@@ -803,8 +945,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the net torque array (alternate array)
-    const GlobalArray<Scalar4>& getAltNetTorqueArray() const
+    const GlobalArray<Scalar4>& getAltNetTorqueArray()
         {
+        checkAlternateArrays();
         return m_net_torque_alt;
         }
 
@@ -815,8 +958,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the orientations (alternate array)
-    const GlobalArray<Scalar4>& getAltOrientationArray() const
+    const GlobalArray<Scalar4>& getAltOrientationArray()
         {
+        checkAlternateArrays();
         return m_orientation_alt;
         }
 
@@ -827,14 +971,16 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the angular momenta (alternate array)
-    const GlobalArray<Scalar4>& getAltAngularMomentumArray() const
+    const GlobalArray<Scalar4>& getAltAngularMomentumArray()
         {
+        checkAlternateArrays();
         return m_angmom_alt;
         }
 
     //! Get the moments of inertia array (alternate array)
-    const GlobalArray<Scalar3>& getAltMomentsOfInertiaArray() const
+    const GlobalArray<Scalar3>& getAltMomentsOfInertiaArray()
         {
+        checkAlternateArrays();
         return m_inertia_alt;
         }
 
@@ -1157,10 +1303,28 @@ class PYBIND11_EXPORT ParticleData
     void initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
                                 bool ignore_bodies = false);
 
+    //! Initialize the local particles without distributing them from the root rank
+    void initializeFromLocalParticles(const std::vector<pdata_element>& particles,
+                                      unsigned int nglobal,
+                                      bool accel_set);
+
     //! Take a snapshot
     template<class Real>
     std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real>& snapshot);
 
+    //! Take a snapshot of the particles local to this rank
+    template<class Real>
+    std::map<unsigned int, unsigned int> takeLocalSnapshot(SnapshotParticleData<Real>& snapshot);
+
+    //! Take a snapshot of the particles in a range of tags
+    template<class Real>
+    std::vector<unsigned int> takeSnapshotChunk(SnapshotParticleData<Real>& snapshot,
+                                                unsigned int tag_begin,
+                                                unsigned int tag_end);
+
+    //! Take a snapshot of the particles in a range of tags for python
+    pybind11::tuple takeSnapshotChunkPy(unsigned int tag_begin, unsigned int tag_end);
+
     //! Add ghost particles at the end of the local particle data
     void addGhostParticles(const unsigned int nghosts);
 
@@ -1321,12 +1485,19 @@ class PYBIND11_EXPORT ParticleData
     GlobalArray<unsigned int> m_tag;   //!< particle tags
     GlobalVector<unsigned int> m_rtag; //!< reverse lookup tags
     GlobalArray<unsigned int> m_body;  //!< rigid body ids
+    GlobalArray<unsigned int> m_group_bits; //!< group membership bits
     GlobalArray<Scalar4>
         m_orientation; //!< Orientation quaternion for each particle (ignored if not anisotropic)
     GlobalArray<Scalar4> m_angmom;          //!< Angular momementum quaternion for each particle
     GlobalArray<Scalar3> m_inertia;         //!< Principal moments of inertia for each particle
     GlobalArray<unsigned int> m_comm_flags; //!< Array of communication flags
 
+    pdata_positions_soa m_pos_soa;  //!< Structure of arrays copy of m_pos
+    bool m_pos_soa_valid;           //!< False when m_pos_soa must be rebuilt
+    uint64_t m_pos_soa_write_count; //!< Write count of m_pos when m_pos_soa was built
+
+    unsigned int m_group_bits_used; //!< Group membership bits acquired by a ParticleGroup
+
     std::stack<unsigned int> m_recycled_tags; //!< Global tags of removed particles
     std::set<unsigned int> m_tag_set;         //!< Lookup table for tags by active index
     std::vector<unsigned int>
@@ -1350,6 +1521,7 @@ class PYBIND11_EXPORT ParticleData
     GlobalArray<int3> m_image_alt;          //!< particle images (swap-in)
     GlobalArray<unsigned int> m_tag_alt;    //!< particle tags (swap-in)
     GlobalArray<unsigned int> m_body_alt;   //!< rigid body ids (swap-in)
+    GlobalArray<unsigned int> m_group_bits_alt; //!< group membership bits (swap-in)
     GlobalArray<Scalar4> m_orientation_alt; //!< orientations (swap-in)
     GlobalArray<Scalar4> m_angmom_alt;      //!< angular momenta (swap-in)
     GlobalArray<Scalar3>
@@ -1387,6 +1559,16 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to allocate alternate particle data
     void allocateAlternateArrays(unsigned int N);
 
+    //! Allocate the alternate particle data on first use
+    /*! Only sorting and particle migration use the alternate arrays. Simulations that do neither
+        do not pay for their memory.
+    */
+    void checkAlternateArrays()
+        {
+        if (m_pos_alt.isNull())
+            allocateAlternateArrays(m_max_nparticles);
+        }
+
     //! Helper function for amortized array resizing
     void resize(unsigned int new_nparticles);
 
@@ -1402,6 +1584,11 @@ class PYBIND11_EXPORT ParticleData
      */
     template<class Real> bool inBox(const SnapshotParticleData<Real>& snap);
 
+    //! Copy local particles to a snapshot in the given order
+    template<class Real>
+    void fillSnapshot(SnapshotParticleData<Real>& snapshot,
+                      const std::vector<unsigned int>& indices);
+
     //! Update the CUDA memory hints
     void setGPUAdvice();
     };
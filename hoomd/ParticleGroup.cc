@@ -10,6 +10,7 @@
 #ifdef ENABLE_HIP
 #include "CachedAllocator.h"
 #include "ParticleGroup.cuh"
+#include "filter/ParticleFilterMask.cuh"
 
 #include <hip/hip_runtime.h>
 #endif
@@ -174,13 +175,15 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_num_local_members(0), m_particles_sorted(true), m_reallocated(false),
       m_global_ptl_num_change(false), m_selector(selector), m_update_tags(update_tags),
-      m_warning_printed(false)
+      m_warning_printed(false), m_group_bit(NO_GROUP_BIT)
     {
 #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
 #endif
 
+    acquireGroupBit();
+
     // update member tag arrays
     updateMemberTags(true);
 
@@ -208,7 +211,8 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
                              const std::vector<unsigned int>& member_tags)
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_num_local_members(0), m_particles_sorted(true), m_reallocated(false),
-      m_global_ptl_num_change(false), m_update_tags(false), m_warning_printed(false)
+      m_global_ptl_num_change(false), m_update_tags(false), m_warning_printed(false),
+      m_group_bit(NO_GROUP_BIT)
     {
     // check input
     unsigned int max_tag = m_pdata->getMaximumTag();
@@ -278,6 +282,9 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
 #endif
 
+    acquireGroupBit();
+    updateGroupBits();
+
     // now that the tag list is completely set up and all memory is allocated, rebuild the index
     // list
     rebuildIndexList();
@@ -309,6 +316,20 @@ ParticleGroup::~ParticleGroup()
             .disconnect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
         m_pdata->getGlobalParticleNumberChangeSignal()
             .disconnect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
+        m_pdata->releaseGroupBit(m_group_bit);
+        }
+    }
+
+/*! Groups that do not get a bit look up the membership of each particle by its tag.
+ */
+void ParticleGroup::acquireGroupBit()
+    {
+    m_group_bit = m_pdata->acquireGroupBit();
+    if (m_group_bit == NO_GROUP_BIT)
+        {
+        m_exec_conf->msg->notice(4)
+            << "ParticleGroup: all group membership bits are in use, rebuilding the index from tags"
+            << std::endl;
         }
     }
 
@@ -326,76 +347,174 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         m_warning_printed = true;
         }
 
+    bool tag_hash_built = false;
     if (m_selector && (m_update_tags || force_update))
         {
         // notice message
         m_pdata->getExecConf()->msg->notice(7) << "ParticleGroup: rebuilding tags" << std::endl;
 
-        // assign all of the particles that belong to the group
-        // for each particle in the (global) data
-        vector<unsigned int> member_tags = m_selector->getSelectedTags(m_sysdef);
-
-#ifdef ENABLE_MPI
-        if (m_pdata->getDomainDecomposition())
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled() && m_selector->hasMaskGPU())
             {
-            // combine lists from all processors
-            std::vector<std::vector<unsigned int>> member_tags_proc(m_exec_conf->getNRanks());
-            all_gather_v(member_tags, member_tags_proc, m_exec_conf->getMPICommunicator());
-
-            assert(member_tags_proc.size() == m_exec_conf->getNRanks());
-
-            // combine all tags into an ordered set
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            std::set<unsigned int> tag_set;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                {
-                tag_set.insert(member_tags_proc[irank].begin(), member_tags_proc[irank].end());
-                }
-
-            // construct list
-            member_tags.clear();
-            member_tags.insert(member_tags.begin(), tag_set.begin(), tag_set.end());
+            selectMembersGPU();
+            tag_hash_built = true;
             }
+        else
 #endif
-
-        // store member tags in GlobalArray
-        GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
-        m_member_tags.swap(member_tags_array);
-        TAG_ALLOCATION(m_member_tags);
-
-        // sort member tags
-        std::sort(member_tags.begin(), member_tags.end());
-
             {
-            ArrayHandle<unsigned int> h_member_tags(m_member_tags,
-                                                    access_location::host,
-                                                    access_mode::overwrite);
-            std::copy(member_tags.begin(), member_tags.end(), h_member_tags.data);
+            selectMembers();
             }
-
-        GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
-        m_member_idx.swap(member_idx);
-        TAG_ALLOCATION(m_member_idx);
         }
 
-    // one byte per particle to indicate membership in the group, initialize with current number of
+    // one flag per particle to indicate membership in the group, sized with the maximum number of
     // local particles
-    GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
-    m_is_member.swap(is_member);
-    TAG_ALLOCATION(m_is_member);
+    if (m_is_member.getNumElements() != m_pdata->getMaxN())
+        {
+        GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
+        m_is_member.swap(is_member);
+        TAG_ALLOCATION(m_is_member);
+        }
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
+    if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
+        {
+        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(),
+                                                m_pdata->getExecConf());
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
+        }
 
     // build the reverse lookup table for tags
-    buildTagHash();
+    if (!tag_hash_built)
+        buildTagHash();
+
+    // the members may have changed, write the membership bits of the local particles
+    updateGroupBits();
 
     // now that the tag list is completely set up and all memory is allocated, rebuild the index
     // list
     rebuildIndexList();
     }
 
+/*! Stores the tags selected by the selector on all ranks in m_member_tags, in ascending order,
+    and allocates m_member_idx.
+ */
+void ParticleGroup::selectMembers() const
+    {
+    // assign all of the particles that belong to the group
+    // for each particle in the (global) data
+    vector<unsigned int> member_tags = m_selector->getSelectedTags(m_sysdef);
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // combine lists from all processors
+        std::vector<std::vector<unsigned int>> member_tags_proc(m_exec_conf->getNRanks());
+        all_gather_v(member_tags, member_tags_proc, m_exec_conf->getMPICommunicator());
+
+        assert(member_tags_proc.size() == m_exec_conf->getNRanks());
+
+        // combine all tags into an ordered set
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+        std::set<unsigned int> tag_set;
+        for (unsigned int irank = 0; irank < n_ranks; ++irank)
+            {
+            tag_set.insert(member_tags_proc[irank].begin(), member_tags_proc[irank].end());
+            }
+
+        // construct list
+        member_tags.clear();
+        member_tags.insert(member_tags.begin(), tag_set.begin(), tag_set.end());
+        }
+#endif
+
+    // store member tags in GlobalArray
+    GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
+    m_member_tags.swap(member_tags_array);
+    TAG_ALLOCATION(m_member_tags);
+
+    // sort member tags
+    std::sort(member_tags.begin(), member_tags.end());
+
+        {
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        std::copy(member_tags.begin(), member_tags.end(), h_member_tags.data);
+        }
+
+    GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
+    m_member_idx.swap(member_idx);
+    TAG_ALLOCATION(m_member_idx);
+    }
+
+#ifdef ENABLE_HIP
+/*! The selector sets the bits of its members in a bitmask by tag, and the masks of all ranks are
+    combined with a bitwise or. The member tags are listed in ascending order and the tag hash is
+    written directly from the mask, so the tags are neither copied to the host nor sorted.
+ */
+void ParticleGroup::selectMembersGPU() const
+    {
+    const unsigned int n_tags = (unsigned int)m_pdata->getRTags().size();
+    const unsigned int n_words = particle_filter_mask_words(n_tags);
+    CachedAllocator& alloc = m_exec_conf->getCachedAllocator();
+
+    ScopedAllocation<unsigned int> d_mask(alloc, n_words);
+    hipMemset(d_mask.data, 0, sizeof(unsigned int) * n_words);
+    m_selector->getSelectedMaskGPU(m_sysdef, d_mask.data);
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // combine the masks of all ranks
+        std::vector<unsigned int> mask(n_words);
+        hipMemcpy(mask.data(), d_mask.data, sizeof(unsigned int) * n_words, hipMemcpyDeviceToHost);
+        MPI_Allreduce(MPI_IN_PLACE,
+                      mask.data(),
+                      n_words,
+                      MPI_UNSIGNED,
+                      MPI_BOR,
+                      m_exec_conf->getMPICommunicator());
+        hipMemcpy(d_mask.data, mask.data(), sizeof(unsigned int) * n_words, hipMemcpyHostToDevice);
+        }
+#endif
+
+    ScopedAllocation<unsigned int> d_offsets(alloc, n_words + 1);
+    unsigned int num_members = 0;
+    gpu_particle_filter_mask_count(n_words, d_mask.data, d_offsets.data, num_members, alloc);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    GlobalArray<unsigned int> member_tags(num_members, m_exec_conf);
+    m_member_tags.swap(member_tags);
+    TAG_ALLOCATION(m_member_tags);
+
+    GlobalArray<unsigned int> member_idx(num_members, m_exec_conf);
+    m_member_idx.swap(member_idx);
+    TAG_ALLOCATION(m_member_idx);
+
+    if (m_is_member_tag.getNumElements() != n_tags)
+        {
+        GlobalArray<unsigned int> is_member_tag(n_tags, m_exec_conf);
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
+        }
+
+    ArrayHandle<unsigned int> d_member_tags(m_member_tags,
+                                            access_location::device,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag,
+                                              access_location::device,
+                                              access_mode::overwrite);
+    gpu_particle_filter_mask_to_tags(n_tags,
+                                     d_mask.data,
+                                     d_offsets.data,
+                                     d_member_tags.data,
+                                     d_is_member_tag.data);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+#endif
+
 void ParticleGroup::reallocate() const
     {
     m_is_member.resize(m_pdata->getMaxN());
@@ -662,6 +781,9 @@ void ParticleGroup::rebuildIndexList() const
         ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
                                         access_location::host,
                                         access_mode::read);
+        ArrayHandle<unsigned int> h_group_bits(m_pdata->getGroupBits(),
+                                               access_location::host,
+                                               access_mode::read);
         ArrayHandle<unsigned int> h_member_idx(m_member_idx,
                                                access_location::host,
                                                access_mode::readwrite);
@@ -670,7 +792,11 @@ void ParticleGroup::rebuildIndexList() const
         for (unsigned int idx = 0; idx < nparticles; idx++)
             {
             assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
-            unsigned int is_member = h_is_member_tag.data[h_tag.data[idx]];
+            unsigned int is_member;
+            if (m_group_bit != NO_GROUP_BIT)
+                is_member = (h_group_bits.data[idx] >> m_group_bit) & 1;
+            else
+                is_member = h_is_member_tag.data[h_tag.data[idx]];
             h_is_member.data[idx] = is_member;
             if (is_member)
                 {
@@ -695,6 +821,40 @@ void ParticleGroup::rebuildIndexList() const
 #endif
     }
 
+/*! The membership bit travels with the particle when the particle data is sorted or particles
+    migrate between ranks, so it only needs to be written when the set of members changes.
+*/
+void ParticleGroup::updateGroupBits() const
+    {
+    if (m_group_bit == NO_GROUP_BIT)
+        return;
+
+#ifdef ENABLE_HIP
+    if (m_pdata->getExecConf()->isCUDAEnabled())
+        {
+        updateGroupBitsGPU();
+        return;
+        }
+#endif
+
+    ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag,
+                                              access_location::host,
+                                              access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_bits(m_pdata->getGroupBits(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+
+    const unsigned int mask = 1u << m_group_bit;
+    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+        {
+        if (h_is_member_tag.data[h_tag.data[idx]])
+            h_group_bits.data[idx] |= mask;
+        else
+            h_group_bits.data[idx] &= ~mask;
+        }
+    }
+
 void ParticleGroup::updateGPUAdvice() const
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
@@ -746,15 +906,23 @@ void ParticleGroup::rebuildIndexListGPU() const
                                            access_location::device,
                                            access_mode::overwrite);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
-
-    // get temporary buffer
-    ScopedAllocation<unsigned int> d_tmp(m_pdata->getExecConf()->getCachedAllocator(),
-                                         m_pdata->getN());
+    ArrayHandle<unsigned int> d_group_bits(m_pdata->getGroupBits(),
+                                           access_location::device,
+                                           access_mode::read);
 
     // reset membership properties
     if (m_member_tags.getNumElements() > 0)
         {
-        gpu_rebuild_index_list(m_pdata->getN(), d_is_member_tag.data, d_is_member.data, d_tag.data);
+        if (m_group_bit != NO_GROUP_BIT)
+            gpu_group_bits_to_flags(m_pdata->getN(),
+                                    d_group_bits.data,
+                                    m_group_bit,
+                                    d_is_member.data);
+        else
+            gpu_rebuild_index_list(m_pdata->getN(),
+                                   d_is_member_tag.data,
+                                   d_is_member.data,
+                                   d_tag.data);
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
 
@@ -762,7 +930,6 @@ void ParticleGroup::rebuildIndexListGPU() const
                                d_is_member.data,
                                d_member_idx.data,
                                m_num_local_members,
-                               d_tmp.data,
                                m_pdata->getExecConf()->getCachedAllocator());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -770,6 +937,26 @@ void ParticleGroup::rebuildIndexListGPU() const
     else
         m_num_local_members = 0;
     }
+
+//! write the membership bit of the local particles on the GPU
+void ParticleGroup::updateGroupBitsGPU() const
+    {
+    ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag,
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_group_bits(m_pdata->getGroupBits(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+
+    gpu_update_group_bits(m_pdata->getN(),
+                          d_tag.data,
+                          d_is_member_tag.data,
+                          d_group_bits.data,
+                          m_group_bit);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
 #endif
 
 unsigned int ParticleGroup::intersectionSize(std::shared_ptr<ParticleGroup> other)
@@ -9,9 +9,6 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <hipcub/hipcub.hpp>
-#include <thrust/device_ptr.h>
-#include <thrust/execution_policy.h>
-#include <thrust/reduce.h>
 #pragma GCC diagnostic pop
 
 /*! \file ParticleGroup.cu
@@ -34,27 +31,45 @@ __global__ void gpu_rebuild_index_list_kernel(unsigned int N,
     d_is_member[idx] = d_is_member_tag[tag];
     }
 
-__global__ void gpu_scatter_member_indices(unsigned int N,
-                                           const unsigned int* d_scan,
-                                           const unsigned int* d_is_member,
-                                           unsigned* d_member_idx)
+//! GPU kernel to write the membership bit of a group from the tag lookup table
+__global__ void gpu_update_group_bits_kernel(unsigned int N,
+                                             const unsigned int* d_tag,
+                                             const unsigned int* d_is_member_tag,
+                                             unsigned int* d_group_bits,
+                                             unsigned int mask)
     {
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (idx >= N)
         return;
 
-    if (d_is_member[idx])
-        d_member_idx[d_scan[idx]] = idx;
+    unsigned int bits = d_group_bits[idx];
+    if (d_is_member_tag[d_tag[idx]])
+        bits |= mask;
+    else
+        bits &= ~mask;
+    d_group_bits[idx] = bits;
+    }
+
+//! GPU kernel to extract the membership flags of a group from the group bits
+__global__ void gpu_group_bits_to_flags_kernel(unsigned int N,
+                                               const unsigned int* d_group_bits,
+                                               unsigned int bit,
+                                               unsigned int* d_is_member)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_is_member[idx] = (d_group_bits[idx] >> bit) & 1;
     }
 
 //! GPU method for rebuilding the index list of a ParticleGroup
 /*! \param N number of local particles
     \param d_is_member_tag Global lookup table for tag -> group membership
     \param d_is_member Array of membership flags
-    \param d_member_idx Array of member indices
     \param d_tag Array of tags
-    \param num_local_members Number of members on the local processor (return value)
 */
 hipError_t gpu_rebuild_index_list(unsigned int N,
                                   unsigned int* d_is_member_tag,
@@ -80,57 +95,116 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
     return hipSuccess;
     }
 
-//! GPU method for compacting the group member indices
 /*! \param N number of local particles
+    \param d_tag Array of tags
     \param d_is_member_tag Global lookup table for tag -> group membership
+    \param d_group_bits Group membership bits of the particles
+    \param bit The membership bit of the group
+*/
+hipError_t gpu_update_group_bits(unsigned int N,
+                                 const unsigned int* d_tag,
+                                 const unsigned int* d_is_member_tag,
+                                 unsigned int* d_group_bits,
+                                 unsigned int bit)
+    {
+    assert(d_tag);
+    assert(d_is_member_tag);
+    assert(d_group_bits);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_update_group_bits_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_tag,
+                       d_is_member_tag,
+                       d_group_bits,
+                       1u << bit);
+    return hipSuccess;
+    }
+
+/*! \param N number of local particles
+    \param d_group_bits Group membership bits of the particles
+    \param bit The membership bit of the group
+    \param d_is_member Array of membership flags (output)
+*/
+hipError_t gpu_group_bits_to_flags(unsigned int N,
+                                   const unsigned int* d_group_bits,
+                                   unsigned int bit,
+                                   unsigned int* d_is_member)
+    {
+    assert(d_group_bits);
+    assert(d_is_member);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_group_bits_to_flags_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_group_bits,
+                       bit,
+                       d_is_member);
+    return hipSuccess;
+    }
+
+//! GPU method for compacting the group member indices
+/*! \param N number of local particles
     \param d_is_member Array of membership flags
     \param d_member_idx Array of member indices
-    \param d_tag Array of tags
     \param num_local_members Number of members on the local processor (return value)
+    \param alloc Caching allocator for temporary storage
+
+    The indices of the flagged particles are selected in a single stream compaction pass.
 */
 hipError_t gpu_compact_index_list(unsigned int N,
                                   unsigned int* d_is_member,
                                   unsigned int* d_member_idx,
                                   unsigned int& num_local_members,
-                                  unsigned int* d_tmp,
                                   CachedAllocator& alloc)
     {
     assert(d_is_member);
     assert(d_member_idx);
 
-    // compute member_idx offsets
-    void* d_temp_storage = NULL;
-    size_t temp_storage_bytes = 0;
+    if (N == 0)
+        {
+        num_local_members = 0;
+        return hipSuccess;
+        }
+
+    hipcub::CountingInputIterator<unsigned int> indices(0);
+    unsigned int* d_num_selected = alloc.getTemporaryBuffer<unsigned int>(1);
 
     // determine size of temporary storage
-    hipcub::DeviceScan::ExclusiveSum(d_temp_storage, temp_storage_bytes, d_is_member, d_tmp, N);
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceSelect::Flagged(d_temp_storage,
+                                  temp_storage_bytes,
+                                  indices,
+                                  d_is_member,
+                                  d_member_idx,
+                                  d_num_selected,
+                                  N);
 
     d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
-    hipcub::DeviceScan::ExclusiveSum(d_temp_storage, temp_storage_bytes, d_is_member, d_tmp, N);
+    hipcub::DeviceSelect::Flagged(d_temp_storage,
+                                  temp_storage_bytes,
+                                  indices,
+                                  d_is_member,
+                                  d_member_idx,
+                                  d_num_selected,
+                                  N);
     alloc.deallocate((char*)d_temp_storage);
 
-    thrust::device_ptr<unsigned int> is_member(d_is_member);
-#ifdef __HIP_PLATFORM_HCC__
-    num_local_members = thrust::reduce(thrust::hip::par(alloc),
-#else
-    num_local_members = thrust::reduce(thrust::cuda::par(alloc),
-#endif
-                                       is_member,
-                                       is_member + N);
-
-    // fill member_idx array
-    unsigned int block_size = 256;
-    unsigned int n_blocks = N / block_size + 1;
-
-    hipLaunchKernelGGL(gpu_scatter_member_indices,
-                       dim3(n_blocks),
-                       dim3(block_size),
-                       0,
-                       0,
-                       N,
-                       d_tmp,
-                       d_is_member,
-                       d_member_idx);
+    hipMemcpy(&num_local_members, d_num_selected, sizeof(unsigned int), hipMemcpyDeviceToHost);
+    alloc.deallocate((char*)d_num_selected);
 
     return hipSuccess;
     }
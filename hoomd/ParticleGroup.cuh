@@ -16,18 +16,29 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
                                   unsigned int* d_is_member,
                                   unsigned int* d_tag);
 
+//! GPU method for writing the membership bit of a ParticleGroup
+hipError_t gpu_update_group_bits(unsigned int N,
+                                 const unsigned int* d_tag,
+                                 const unsigned int* d_is_member_tag,
+                                 unsigned int* d_group_bits,
+                                 unsigned int bit);
+
+//! GPU method for extracting the membership flags of a ParticleGroup from the group bits
+hipError_t gpu_group_bits_to_flags(unsigned int N,
+                                   const unsigned int* d_group_bits,
+                                   unsigned int bit,
+                                   unsigned int* d_is_member);
+
 //! GPU method for compacting the group member indices
 /*! \param N number of local particles
-    \param d_is_member_tag Global lookup table for tag -> group membership
     \param d_is_member Array of membership flags
     \param d_member_idx Array of member indices
-    \param d_tag Array of tags
     \param num_local_members Number of members on the local processor (return value)
+    \param alloc Caching allocator for temporary storage
 */
 hipError_t gpu_compact_index_list(unsigned int N,
                                   unsigned int* d_is_member,
                                   unsigned int* d_member_idx,
                                   unsigned int& num_local_members,
-                                  unsigned int* d_tmp,
                                   CachedAllocator& alloc);
 #endif
@@ -136,6 +136,12 @@ class PYBIND11_EXPORT ParticleFilterRigidCenter : public ParticleFilter
    particle in the group. For that it needs a list of indices of all the particles in the group. To
    facilitates this, the list of indices in the group will be stored in a GPUArray.
 
+    Each group acquires one of the per-particle membership bits in ParticleData::getGroupBits().
+   The bits are written from the member tags only when the members change, and they move with the
+   particles when the particles are sorted or migrate between ranks. After a sort, the index list
+   is rebuilt from the bits by a stream compaction, without looking up the particle tags. Groups
+   created after all bits have been acquired look up the membership of each particle by its tag.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT ParticleGroup
@@ -145,7 +151,7 @@ class PYBIND11_EXPORT ParticleGroup
     // @{
 
     //! Constructs an empty particle group
-    ParticleGroup() : m_num_local_members(0) {};
+    ParticleGroup() : m_num_local_members(0), m_group_bit(NO_GROUP_BIT) {};
 
     //! Constructs a particle group of all particles that meet the given selection
     ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
@@ -255,6 +261,21 @@ class PYBIND11_EXPORT ParticleGroup
         return m_member_idx;
         }
 
+    //! Direct access to the membership flags
+    /*! \returns A GPUArray with one element per local particle index, equal to 1 if the particle
+       is a member of the group \note The caller \b must \b not write to or change the array.
+
+        \note This method CAN access the particle data tag array if the index is rebuilt.
+              Hence, the tag array may not be accessed in the same scope in which this method is
+       called.
+    */
+    const GlobalArray<unsigned int>& getMemberFlagArray() const
+        {
+        checkRebuild();
+
+        return m_is_member;
+        }
+
 #ifdef ENABLE_HIP
     //! Return the load balancing GPU partition
     const GPUPartition& getGPUPartition() const
@@ -365,6 +386,7 @@ class PYBIND11_EXPORT ParticleGroup
 
     bool m_update_tags; //!< True if tags should be updated when global number of particles changes
     mutable bool m_warning_printed; //!< True if warning about static groups has been printed
+    unsigned int m_group_bit; //!< Membership bit in ParticleData::getGroupBits(), or NO_GROUP_BIT
 
 #ifdef ENABLE_HIP
     mutable GPUPartition m_gpu_partition; //!< A handy struct to store load balancing info for this
@@ -383,6 +405,12 @@ class PYBIND11_EXPORT ParticleGroup
     //! Helper function to rebuild the index lists after the particles have been sorted
     void rebuildIndexList() const;
 
+    //! Helper function to reserve a membership bit in the particle data
+    void acquireGroupBit();
+
+    //! Helper function to write the membership bit of the local particles from the tag lookup
+    void updateGroupBits() const;
+
     //! Helper function to rebuild internal arrays
     void checkRebuild() const
         {
@@ -434,9 +462,18 @@ class PYBIND11_EXPORT ParticleGroup
     //! Helper function to build the 1:1 hash for tag membership
     void buildTagHash() const;
 
+    //! Select the member tags with the selector
+    void selectMembers() const;
+
 #ifdef ENABLE_HIP
+    //! Select the member tags and build the tag hash from the selector's bitmask on the GPU
+    void selectMembersGPU() const;
+
     //! Helper function to rebuild the index lists after the particles have been sorted
     void rebuildIndexListGPU() const;
+
+    //! Helper function to write the membership bit of the local particles on the GPU
+    void updateGroupBitsGPU() const;
 #endif
     };
 
@@ -204,6 +204,121 @@ Profiler::Profiler(const std::string& name) : m_name(name)
 #ifdef SCOREP_USER_ENABLE
     SCOREP_USER_REGION_BEGIN(m_root.m_scorep_region, name.c_str(), SCOREP_USER_REGION_TYPE_COMMON)
 #endif
+
+#ifdef ENABLE_PAPI
+    // profiling works without counters when PAPI is not usable on this machine
+    m_papi_event_set = PAPI_NULL;
+    if (PAPI_is_initialized() == PAPI_NOT_INITED
+        && PAPI_library_init(PAPI_VER_CURRENT) != PAPI_VER_CURRENT)
+        return;
+    if (PAPI_create_eventset(&m_papi_event_set) != PAPI_OK)
+        return;
+
+    const std::pair<const char*, int> events[] = {{"cache_misses", PAPI_L2_TCM},
+                                                  {"llc_misses", PAPI_L3_TCM},
+                                                  {"fp_ops", PAPI_DP_OPS},
+                                                  {"cycles", PAPI_TOT_CYC},
+                                                  {"instructions", PAPI_TOT_INS}};
+    for (const auto& event : events)
+        {
+        // some CPUs cannot count all events in one set, skip the ones that do not fit
+        if (PAPI_add_event(m_papi_event_set, event.second) == PAPI_OK)
+            m_hw_names.push_back(event.first);
+        }
+
+    // another Profiler on this thread may already be counting
+    if (!m_hw_names.empty() && PAPI_start(m_papi_event_set) != PAPI_OK)
+        m_hw_names.clear();
+    m_hw_value.resize(m_hw_names.size());
+#endif
+    }
+
+//! Helper function to destroy the GPU events of a profile node and its children
+static void destroy_events(ProfileDataElem& elem)
+    {
+#ifdef ENABLE_HIP
+    for (unsigned int idev = 0; idev < elem.m_start_events.size(); ++idev)
+        {
+        hipEventDestroy(elem.m_start_events[idev]);
+        hipEventDestroy(elem.m_stop_events[idev]);
+        }
+    elem.m_start_events.clear();
+    elem.m_stop_events.clear();
+#endif
+
+    for (auto& child : elem.m_children)
+        destroy_events(child.second);
+    }
+
+Profiler::~Profiler()
+    {
+    destroy_events(m_root);
+
+#ifdef ENABLE_PAPI
+    if (m_papi_event_set != PAPI_NULL)
+        {
+        if (!m_hw_names.empty())
+            PAPI_stop(m_papi_event_set, m_hw_value.data());
+        PAPI_cleanup_eventset(m_papi_event_set);
+        PAPI_destroy_eventset(&m_papi_event_set);
+        }
+#endif
+    }
+
+//! Helper function to add the timings of the children of a profile node to a dictionary
+/*! \param timings Dictionary to add to
+    \param elem Profile node
+    \param prefix Path of \a elem ("" for the root)
+    \param hw_names Names of the sampled hardware counters
+*/
+static void collect_timings(py::dict& timings,
+                            const ProfileDataElem& elem,
+                            const string& prefix,
+                            const vector<string>& hw_names)
+    {
+    for (const auto& child : elem.m_children)
+        {
+        const string path = prefix.empty() ? child.first : prefix + "/" + child.first;
+
+        py::dict entry;
+        entry["count"] = child.second.m_count;
+        entry["wall_time"] = double(child.second.m_elapsed_time) / 1e9;
+        entry["gpu_time"] = double(child.second.m_gpu_elapsed_time) / 1e9;
+        py::list gpu_times;
+        for (int64_t t : child.second.m_gpu_elapsed_times)
+            gpu_times.append(double(t) / 1e9);
+        entry["gpu_time_per_device"] = gpu_times;
+        entry["flop_count"] = child.second.m_flop_count;
+        entry["byte_count"] = child.second.m_mem_byte_count;
+
+        py::dict hw_counters;
+        for (unsigned int i = 0; i < child.second.m_hw_counts.size(); i++)
+            {
+            hw_counters[py::str(hw_names[i])] = child.second.m_hw_counts[i];
+
+            // every last level cache miss loads one 64 byte cache line from DRAM
+            if (hw_names[i] == "llc_misses")
+                hw_counters["dram_bytes"] = child.second.m_hw_counts[i] * 64;
+            }
+        entry["hw_counters"] = hw_counters;
+        timings[py::str(path)] = entry;
+
+        collect_timings(timings, child.second, path, hw_names);
+        }
+    }
+
+/*! \returns A dictionary that maps the path of each profile node (names joined by "/", without the
+    root) to a dictionary with the keys count, wall_time (seconds), gpu_time (seconds, on the slowest
+    GPU), gpu_time_per_device (list of seconds per active GPU, empty on the CPU), flop_count,
+    byte_count, and hw_counters (a dictionary of the sampled hardware counters, plus dram_bytes
+    estimated from the last level cache misses). The values include the time spent in child
+    nodes.
+*/
+py::dict Profiler::getTimings() const
+    {
+    py::dict timings;
+    collect_timings(timings, m_root, "", m_hw_names);
+    return timings;
     }
 
 void Profiler::output(std::ostream& o)
@@ -249,7 +364,8 @@ string print_profiler(Profiler* prof)
 
 void export_Profiler(py::module& m)
     {
-    py::class_<Profiler>(m, "Profiler")
+    py::class_<Profiler, std::shared_ptr<Profiler>>(m, "Profiler")
         .def(py::init<const std::string&>())
+        .def("getTimings", &Profiler::getTimings)
         .def("__str__", &print_profiler);
     }
@@ -13,6 +13,7 @@
 
 #include "ClockSource.h"
 #include "ExecutionConfiguration.h"
+#include "Tracer.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -22,11 +23,17 @@
 #include <nvToolsExt.h>
 #endif
 
+#ifdef ENABLE_PAPI
+#include <papi.h>
+#endif
+
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <map>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 
@@ -63,7 +70,12 @@ class PYBIND11_EXPORT ProfileDataElem
     public:
     //! Constructs an element with zeroed counters
     ProfileDataElem()
-        : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0)
+        : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0), m_count(0),
+          m_gpu_elapsed_time(0)
+#ifdef ENABLE_HIP
+          ,
+          m_start_recorded(false)
+#endif
 #ifdef SCOREP_USER_ENABLE
           ,
           m_scorep_region(SCOREP_USER_INVALID_REGION)
@@ -95,10 +107,28 @@ class PYBIND11_EXPORT ProfileDataElem
 
     std::map<std::string, ProfileDataElem> m_children; //!< Child nodes of this profile
 
-    int64_t m_start_time;     //!< The start time of the most recent timed event
-    int64_t m_elapsed_time;   //!< A running total of elapsed running time
-    int64_t m_flop_count;     //!< A running total of floating point operations
-    int64_t m_mem_byte_count; //!< A running total of memory bytes transferred
+    int64_t m_start_time;       //!< The start time of the most recent timed event
+    int64_t m_elapsed_time;     //!< A running total of elapsed running time
+    int64_t m_flop_count;       //!< A running total of floating point operations
+    int64_t m_mem_byte_count;   //!< A running total of memory bytes transferred
+    int64_t m_count;            //!< Number of completed push/pop pairs
+    int64_t m_gpu_elapsed_time; //!< A running total of GPU time between the push and pop events
+
+    //! Running totals of the GPU time between the push and pop events on each active GPU
+    std::vector<int64_t> m_gpu_elapsed_times;
+
+    //! Running totals of the hardware counters, in the order of Profiler::getHardwareCounterNames()
+    std::vector<int64_t> m_hw_counts;
+
+#ifdef ENABLE_PAPI
+    std::vector<long long> m_hw_start; //!< Hardware counter values at the most recent push
+#endif
+
+#ifdef ENABLE_HIP
+    std::vector<hipEvent_t> m_start_events; //!< Events recorded on push on each active GPU
+    std::vector<hipEvent_t> m_stop_events;  //!< Events recorded on pop on each active GPU
+    bool m_start_recorded; //!< True when m_start_events were recorded by the current push
+#endif
 
 #ifdef SCOREP_USER_ENABLE
     SCOREP_User_RegionHandle m_scorep_region; //!< ScoreP region identifier
@@ -121,7 +151,20 @@ class PYBIND11_EXPORT ProfileDataElem
     These methods automatically synchronize with the asynchronous GPU execution stream in order
     to provide accurate timing information.
 
-    These profiles can of course be output via normal ostream operators.
+    These profiles can of course be output via normal ostream operators. getTimings() returns the
+    same data as a flat Python dictionary keyed by the path of each node in the tree so that it can
+    be logged or sent to monitoring tools.
+
+    When the GPU is active, the versions of push() and pop() that take an ExecutionConfiguration
+    also record events on the default stream of every active GPU and accumulate the GPU time
+    between them separately from the wall clock time, both per GPU and for the slowest GPU.
+
+    Builds with ENABLE_PAPI also read hardware counters with PAPI on push() and pop() and
+    accumulate the differences: cache misses, last level cache misses, double precision
+    floating point operations, cycles, and instructions. Counters that the CPU does not provide
+    are left out (see getHardwareCounterNames()). PAPI counts the events of the thread that pushes
+    the region, so work done by TBB worker threads or on the GPU is not included. PAPI runs one
+    event set per thread, so when several Profilers exist at once, only the first samples counters.
     \ingroup utils
     */
 class PYBIND11_EXPORT Profiler
@@ -129,6 +172,10 @@ class PYBIND11_EXPORT Profiler
     public:
     //! Constructs an empty profiler and starts its timer ticking
     Profiler(const std::string& name = "Profile");
+
+    //! Destroys the GPU events
+    ~Profiler();
+
     //! Pushes a new sub-category into the current category
     void push(const std::string& name);
     //! Pops back up to the next super-category
@@ -141,11 +188,33 @@ class PYBIND11_EXPORT Profiler
              uint64_t flop_count = 0,
              uint64_t byte_count = 0);
 
+    //! Get the accumulated timings of every node in the profile
+    pybind11::dict getTimings() const;
+
+    //! Get the names of the sampled hardware counters (empty without PAPI)
+    const std::vector<std::string>& getHardwareCounterNames() const
+        {
+        return m_hw_names;
+        }
+
+    //! Set the tracer that records pushed regions in a timeline (may be null)
+    void setTracer(std::shared_ptr<Tracer> tracer)
+        {
+        m_tracer = tracer;
+        }
+
     private:
     ClockSource m_clk;                    //!< Clock to provide timing information
     std::string m_name;                   //!< The name of this profile
     ProfileDataElem m_root;               //!< The root profile element
     std::stack<ProfileDataElem*> m_stack; //!< A stack of data elements for the push/pop structure
+    std::shared_ptr<Tracer> m_tracer;     //!< Timeline tracer (null when not tracing)
+    std::vector<std::string> m_hw_names;  //!< Names of the sampled hardware counters
+
+#ifdef ENABLE_PAPI
+    int m_papi_event_set;              //!< PAPI event set with the sampled counters
+    std::vector<long long> m_hw_value; //!< Scratch space to read the counters
+#endif
 
     //! Output helper function
     void output(std::ostream& o);
@@ -177,6 +246,33 @@ inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_co
         }
 #endif
     push(name);
+
+#if defined(ENABLE_HIP)
+    if (exec_conf->isCUDAEnabled())
+        {
+        ProfileDataElem* cur = m_stack.top();
+        const std::vector<unsigned int>& gpu_ids = exec_conf->getGPUIds();
+        if (cur->m_start_events.empty())
+            {
+            cur->m_start_events.resize(gpu_ids.size());
+            cur->m_stop_events.resize(gpu_ids.size());
+            cur->m_gpu_elapsed_times.assign(gpu_ids.size(), 0);
+            for (int idev = int(gpu_ids.size()) - 1; idev >= 0; --idev)
+                {
+                hipSetDevice(gpu_ids[idev]);
+                hipEventCreate(&cur->m_start_events[idev]);
+                hipEventCreate(&cur->m_stop_events[idev]);
+                }
+            }
+
+        for (int idev = int(gpu_ids.size()) - 1; idev >= 0; --idev)
+            {
+            hipSetDevice(gpu_ids[idev]);
+            hipEventRecord(cur->m_start_events[idev], 0);
+            }
+        cur->m_start_recorded = true;
+        }
+#endif
     }
 
 inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_conf,
@@ -184,12 +280,43 @@ inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_con
                           uint64_t byte_count)
     {
 #if defined(ENABLE_HIP)
+    ProfileDataElem* cur = m_stack.top();
+    const std::vector<unsigned int>& gpu_ids = exec_conf->getGPUIds();
+    if (cur->m_start_recorded)
+        {
+        for (int idev = int(gpu_ids.size()) - 1; idev >= 0; --idev)
+            {
+            hipSetDevice(gpu_ids[idev]);
+            hipEventRecord(cur->m_stop_events[idev], 0);
+            }
+        }
+
     // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
     if (exec_conf->isCUDAEnabled())
         {
         exec_conf->multiGPUBarrier();
         hipDeviceSynchronize();
         }
+
+    if (cur->m_start_recorded)
+        {
+        // the GPUs run concurrently, the slowest one determines the GPU time of the region
+        int64_t max_gpu_time = 0;
+        for (unsigned int idev = 0; idev < cur->m_stop_events.size(); ++idev)
+            {
+            float gpu_ms = 0.0f;
+            hipEventSynchronize(cur->m_stop_events[idev]);
+            hipEventElapsedTime(&gpu_ms, cur->m_start_events[idev], cur->m_stop_events[idev]);
+            const int64_t gpu_time = int64_t(double(gpu_ms) * 1e6);
+            cur->m_gpu_elapsed_times[idev] += gpu_time;
+            max_gpu_time = std::max(max_gpu_time, gpu_time);
+            }
+        cur->m_gpu_elapsed_time += max_gpu_time;
+        cur->m_start_recorded = false;
+
+        if (m_tracer)
+            m_tracer->addDeviceEvent(max_gpu_time);
+        }
 #endif
     pop(flop_count, byte_count);
     }
@@ -214,6 +341,19 @@ inline void Profiler::push(const std::string& name)
     // and updating the stack
     m_stack.push(&cur->m_children[name]);
 
+#ifdef ENABLE_PAPI
+    if (!m_hw_names.empty())
+        {
+        ProfileDataElem* child = m_stack.top();
+        PAPI_read(m_papi_event_set, m_hw_value.data());
+        child->m_hw_start = m_hw_value;
+        child->m_hw_counts.resize(m_hw_names.size(), 0);
+        }
+#endif
+
+    if (m_tracer)
+        m_tracer->begin(name);
+
 #ifdef SCOREP_USER_ENABLE
     // log Score-P region
     SCOREP_USER_REGION_BEGIN(cur->m_children[name].m_scorep_region,
@@ -237,6 +377,16 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
 
     // then increasing the elapsed time for the current item
     ProfileDataElem* cur = m_stack.top();
+
+#ifdef ENABLE_PAPI
+    if (!m_hw_names.empty())
+        {
+        PAPI_read(m_papi_event_set, m_hw_value.data());
+        for (unsigned int i = 0; i < m_hw_names.size(); i++)
+            cur->m_hw_counts[i] += m_hw_value[i] - cur->m_hw_start[i];
+        }
+#endif
+
 #ifdef SCOREP_USER_ENABLE
     SCOREP_USER_REGION_END(cur->m_scorep_region)
 #endif
@@ -245,9 +395,13 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     // and increasing the flop and mem counters
     cur->m_flop_count += flop_count;
     cur->m_mem_byte_count += byte_count;
+    cur->m_count++;
 
     // and finally popping the stack so that the next pop will access the correct element
     m_stack.pop();
+
+    if (m_tracer)
+        m_tracer->end();
     }
 
 #endif
@@ -12,6 +12,8 @@ PythonAnalyzer::PythonAnalyzer(std::shared_ptr<SystemDefinition> sysdef, pybind1
 void PythonAnalyzer::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
+    // System::run releases the GIL
+    pybind11::gil_scoped_acquire acquire;
     m_analyzer.attr("act")(timestep);
     }
 
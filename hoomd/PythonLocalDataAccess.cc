@@ -1,5 +1,185 @@
 #include "PythonLocalDataAccess.h"
 
+#include <cstdint>
+
+#if ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+/// Structures of the DLPack ABI (https://github.com/dmlc/dlpack).
+/** Only the parts HOOMD-blue needs to export tensors are declared. The layout
+ *  must match dlpack.h exactly.
+ */
+namespace
+    {
+struct DLDevice
+    {
+    int32_t device_type;
+    int32_t device_id;
+    };
+
+struct DLDataType
+    {
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+    };
+
+struct DLTensor
+    {
+    void* data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+    };
+
+struct DLManagedTensor
+    {
+    DLTensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensor* self);
+    };
+
+/// DLPack type codes
+enum DLDataTypeCode
+    {
+    kDLInt = 0,
+    kDLUInt = 1,
+    kDLFloat = 2
+    };
+
+/// Owns the tensor and its shape and strides.
+struct DLPackContext
+    {
+    DLManagedTensor tensor;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    };
+
+void dlpack_deleter(DLManagedTensor* self)
+    {
+    delete static_cast<DLPackContext*>(self->manager_ctx);
+    }
+
+/// Free tensors that no consumer took ownership of.
+void dlpack_capsule_destructor(PyObject* capsule)
+    {
+    // consumers rename the capsule to "used_dltensor" when they take the tensor
+    if (PyCapsule_IsValid(capsule, "dltensor"))
+        {
+        auto tensor = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+        tensor->deleter(tensor);
+        }
+    }
+
+/// Convert a buffer format character to a DLPack data type.
+DLDataType dlpack_dtype(const std::string& typestr)
+    {
+    if (typestr.size() != 1)
+        throw pybind11::buffer_error("Unsupported type for DLPack: " + typestr);
+
+    switch (typestr[0])
+        {
+    case 'f':
+        return DLDataType {kDLFloat, 32, 1};
+    case 'd':
+        return DLDataType {kDLFloat, 64, 1};
+    case 'b':
+        return DLDataType {kDLInt, 8, 1};
+    case 'B':
+        return DLDataType {kDLUInt, 8, 1};
+    case 'h':
+        return DLDataType {kDLInt, 16, 1};
+    case 'H':
+        return DLDataType {kDLUInt, 16, 1};
+    case 'i':
+        return DLDataType {kDLInt, 32, 1};
+    case 'I':
+        return DLDataType {kDLUInt, 32, 1};
+    case 'l':
+    case 'q':
+        return DLDataType {kDLInt, 64, 1};
+    case 'L':
+    case 'Q':
+        return DLDataType {kDLUInt, 64, 1};
+    default:
+        throw pybind11::buffer_error("Unsupported type for DLPack: " + typestr);
+        }
+    }
+    } // end anonymous namespace
+
+pybind11::capsule HOOMDBuffer::makeDLPack(DLPackDevice device_type, int device_id) const
+    {
+    DLDataType dtype = dlpack_dtype(m_typestr);
+    ssize_t itemsize = dtype.bits / 8;
+
+    auto context = new DLPackContext;
+    context->shape.assign(m_shape.begin(), m_shape.end());
+
+    // DLPack strides count elements, not bytes
+    for (auto stride : m_strides)
+        {
+        if (stride % itemsize != 0)
+            {
+            delete context;
+            throw pybind11::buffer_error("Buffer strides are not a multiple of the item size.");
+            }
+        context->strides.push_back(stride / itemsize);
+        }
+
+    DLTensor& tensor = context->tensor.dl_tensor;
+    tensor.data = m_data;
+    tensor.device = DLDevice {int32_t(device_type), device_id};
+    tensor.ndim = int32_t(m_shape.size());
+    tensor.dtype = dtype;
+    tensor.shape = context->shape.data();
+    tensor.strides = context->strides.data();
+    tensor.byte_offset = 0;
+    context->tensor.manager_ctx = context;
+    context->tensor.deleter = dlpack_deleter;
+
+    PyObject* capsule = PyCapsule_New(&context->tensor, "dltensor", dlpack_capsule_destructor);
+    if (!capsule)
+        {
+        delete context;
+        throw pybind11::error_already_set();
+        }
+    return pybind11::reinterpret_steal<pybind11::capsule>(capsule);
+    }
+
+#if ENABLE_HIP
+pybind11::capsule HOOMDDeviceBuffer::getDLPack(pybind11::object stream) const
+    {
+    // None and 1 both refer to the legacy default stream
+    if (!stream.is_none() && stream.cast<intptr_t>() != 1)
+        hipDeviceSynchronize();
+
+    int device_id;
+    hipGetDevice(&device_id);
+
+#ifdef __HIP_PLATFORM_HCC__
+    return makeDLPack(DLPackDevice::rocm, device_id);
+#else
+    return makeDLPack(DLPackDevice::cuda, device_id);
+#endif
+    }
+
+pybind11::tuple HOOMDDeviceBuffer::getDLPackDevice() const
+    {
+    int device_id;
+    hipGetDevice(&device_id);
+
+#ifdef __HIP_PLATFORM_HCC__
+    return pybind11::make_tuple(int(DLPackDevice::rocm), device_id);
+#else
+    return pybind11::make_tuple(int(DLPackDevice::cuda), device_id);
+#endif
+    }
+#endif
+
 void export_GhostDataFlag(pybind11::module& m)
     {
     pybind11::enum_<GhostDataFlag>(m, "GhostDataFlag")
@@ -12,7 +192,9 @@ void export_HOOMDHostBuffer(pybind11::module& m)
     {
     pybind11::class_<HOOMDHostBuffer>(m, "HOOMDHostBuffer", pybind11::buffer_protocol())
         .def_buffer([](HOOMDHostBuffer& b) -> pybind11::buffer_info { return b.new_buffer(); })
-        .def_property_readonly("read_only", &HOOMDHostBuffer::getReadOnly);
+        .def_property_readonly("read_only", &HOOMDHostBuffer::getReadOnly)
+        .def("__dlpack__", &HOOMDHostBuffer::getDLPack, pybind11::arg("stream") = pybind11::none())
+        .def("__dlpack_device__", &HOOMDHostBuffer::getDLPackDevice);
     ;
     }
 
@@ -22,7 +204,11 @@ void export_HOOMDDeviceBuffer(pybind11::module& m)
     pybind11::class_<HOOMDDeviceBuffer>(m, "HOOMDDeviceBuffer")
         .def_property_readonly("__cuda_array_interface__",
                                &HOOMDDeviceBuffer::getCudaArrayInterface)
-        .def_property_readonly("read_only", &HOOMDDeviceBuffer::getReadOnly);
+        .def_property_readonly("read_only", &HOOMDDeviceBuffer::getReadOnly)
+        .def("__dlpack__",
+             &HOOMDDeviceBuffer::getDLPack,
+             pybind11::arg("stream") = pybind11::none())
+        .def("__dlpack_device__", &HOOMDDeviceBuffer::getDLPackDevice);
     ;
     }
 #endif
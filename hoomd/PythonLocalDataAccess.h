@@ -8,6 +8,15 @@
 #include <type_traits>
 #include <utility>
 
+/// DLPack device types of the buffers HOOMD-blue exports.
+/** Values from the DLPack specification (https://github.com/dmlc/dlpack). */
+enum class DLPackDevice
+    {
+    cpu = 1,
+    cuda = 2,
+    rocm = 10
+    };
+
 /// Base class for buffers for LocalDataAccess template class type checking.
 /** In addition, this class allows for a uniform way of specifying a CPU(Host)
  *  or GPU(Device) buffer.  HOOMDBuffer classes need to implement a templated
@@ -44,6 +53,16 @@ struct HOOMDBuffer
         {
         return m_read_only;
         }
+
+    protected:
+    /// Create a DLPack capsule that refers to the buffer.
+    /** The capsule is named "dltensor" as the DLPack Python specification
+     *  requires. The consumer renames it when it takes ownership of the
+     *  tensor. Like the buffer itself, the tensor is only valid inside the
+     *  context manager that created the buffer. DLPack has no read only flag,
+     *  so consumers must not write to tensors of read only buffers.
+     */
+    pybind11::capsule makeDLPack(DLPackDevice device_type, int device_id) const;
     };
 
 /// Represents the data required to specify a CPU buffer object in Python.
@@ -90,6 +109,19 @@ struct HOOMDHostBuffer : public HOOMDBuffer
                                      std::vector<ssize_t>(m_shape),
                                      std::vector<ssize_t>(m_strides));
         }
+
+    /// Export the buffer through the DLPack __dlpack__ protocol.
+    /** Host buffers ignore the stream argument. */
+    pybind11::capsule getDLPack(pybind11::object) const
+        {
+        return makeDLPack(DLPackDevice::cpu, 0);
+        }
+
+    /// Implement __dlpack_device__.
+    pybind11::tuple getDLPackDevice() const
+        {
+        return pybind11::make_tuple(int(DLPackDevice::cpu), 0);
+        }
     };
 
 #if ENABLE_HIP
@@ -157,6 +189,16 @@ struct HOOMDDeviceBuffer : public HOOMDBuffer
         interface["strides"] = pybind11::tuple(strides);
         return interface;
         }
+
+    /// Export the buffer through the DLPack __dlpack__ protocol.
+    /** HOOMD-blue launches its kernels on the legacy default stream. When the
+     *  consumer passes a different stream, the device is synchronized so that
+     *  the data is ready on that stream.
+     */
+    pybind11::capsule getDLPack(pybind11::object stream) const;
+
+    /// Implement __dlpack_device__.
+    pybind11::tuple getDLPackDevice() const;
     };
 #endif
 
@@ -321,6 +363,37 @@ template<class Output, class Data> class LocalDataAccess
                             true);
         }
 
+    /// Convert Global/GPUArray into an Ouput object for Python
+    /** This function is for arrays with a size that the caller determines,
+     *  such as the neighbor list. Use getBuffer for per particle arrays.
+     *
+     *  Template parameters:
+     *  T: the value stored in the by the internal array (i.e. the template
+     *  parameter of the ArrayHandle)
+     *  U: the templated array class returned by the parameter
+     *  get_array_func.
+     *
+     *  Arguments:
+     *  handle: a reference to the unique_ptr that holds the ArrayHandle.
+     *  get_array_func: the method of m_data to use to access the array.
+     *  size: the number of elements to expose.
+     *  read_only: whether the array should be read only (defaults to True).
+     */
+    template<class T, template<class> class U = GlobalArray>
+    Output getBufferExplicit(std::unique_ptr<ArrayHandle<T>>& handle,
+                             const U<T>& (Data::*get_array_func)() const,
+                             size_t size,
+                             bool read_only = true)
+        {
+        checkManager();
+        updateHandle(handle, get_array_func, read_only);
+
+        return Output::make(handle.get()->data,
+                            std::vector<ssize_t>({ssize_t(size)}),
+                            std::vector<ssize_t>({sizeof(T)}),
+                            read_only);
+        }
+
     // clear should remove any references to ArrayHandle objects so the
     // handle can be released for other objects.
     virtual void clear() = 0;
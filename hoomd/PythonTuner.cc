@@ -14,6 +14,8 @@ PythonTuner::PythonTuner(std::shared_ptr<SystemDefinition> sysdef,
 void PythonTuner::update(uint64_t timestep)
     {
     Updater::update(timestep);
+    // System::run releases the GIL
+    pybind11::gil_scoped_acquire acquire;
     m_tuner.attr("act")(timestep);
     }
 
@@ -12,6 +12,8 @@ PythonUpdater::PythonUpdater(std::shared_ptr<SystemDefinition> sysdef, pybind11:
 void PythonUpdater::update(uint64_t timestep)
     {
     Updater::update(timestep);
+    // System::run releases the GIL
+    pybind11::gil_scoped_acquire acquire;
     m_updater.attr("act")(timestep);
     }
 
@@ -334,6 +334,37 @@ template<typename Real> class UniformDistribution
         return a + width * detail::generate_canonical<Real>(rng);
         }
 
+    //! Draw two values from the distribution
+    /*! \param out1 [out] First output
+        \param out2 [out] Second output
+        \param rng Random number generator
+
+        Both values come from the 128 bits of one call to the generator.
+    */
+    template<typename RNG> DEVICE inline void operator()(Real& out1, Real& out2, RNG& rng)
+        {
+        uint64_t u0, u1;
+        detail::generate_2u64(u0, u1, rng);
+        out1 = a + width * r123::u01<Real>(u0);
+        out2 = a + width * r123::u01<Real>(u1);
+        }
+
+    //! Draw n values from the distribution
+    /*! \param out [out] Array of n outputs
+        \param n Number of values to draw
+        \param rng Random number generator
+
+        Calls the generator (n+1)/2 times.
+    */
+    template<typename RNG> DEVICE inline void operator()(Real* out, unsigned int n, RNG& rng)
+        {
+        unsigned int i = 0;
+        for (; i + 1 < n; i += 2)
+            (*this)(out[i], out[i + 1], rng);
+        if (i < n)
+            out[i] = (*this)(rng);
+        }
+
     private:
     const Real a;     //!< Left end point of the interval
     const Real width; //!< Width of the interval
@@ -395,6 +426,23 @@ template<typename Real> class NormalDistribution
         out2 = y + mu;
         }
 
+    //! Draw n values from the distribution
+    /*! \param out [out] Array of n outputs
+        \param n Number of values to draw
+        \param rng Random number generator
+
+        Uses both Box-Muller outputs of each call to the generator, so it calls the generator
+        (n+1)/2 times instead of n times.
+    */
+    template<typename RNG> DEVICE inline void operator()(Real* out, unsigned int n, RNG& rng)
+        {
+        unsigned int i = 0;
+        for (; i + 1 < n; i += 2)
+            (*this)(out[i], out[i + 1], rng);
+        if (i < n)
+            out[i] = (*this)(rng);
+        }
+
     private:
     const Real sigma; //!< Standard deviation
     const Real mu;    //!< Mean
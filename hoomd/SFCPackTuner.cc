@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <math.h>
 #include <stdexcept>
 
@@ -23,7 +24,8 @@ namespace py = pybind11;
  */
 SFCPackTuner::SFCPackTuner(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<Trigger> trigger)
-    : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0)
+    : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0), m_disorder_threshold(0),
+      m_disorder(0), m_num_sorts(0), m_sort_needed(true), m_sort_by_type(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackTuner" << endl;
 
@@ -105,11 +107,15 @@ void SFCPackTuner::update(uint64_t timestep)
     else
         getSortedOrder3D();
 
-    // apply that sort order to the particles
-    applySortOrder();
+    // apply that sort order to the particles, unless they are still in order
+    if (m_sort_needed)
+        {
+        applySortOrder();
 
-    // trigger sort signal (this also forces particle migration)
-    m_pdata->notifyParticleSort();
+        // trigger sort signal (this also forces particle migration)
+        m_pdata->notifyParticleSort();
+        m_num_sorts++;
+        }
 
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
@@ -146,6 +152,9 @@ void SFCPackTuner::applySortOrder()
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
                                      access_location::host,
                                      access_mode::readwrite);
+    ArrayHandle<unsigned int> h_group_bits(m_pdata->getGroupBits(),
+                                           access_location::host,
+                                           access_mode::readwrite);
     ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
                                   access_location::host,
                                   access_mode::readwrite);
@@ -272,6 +281,12 @@ void SFCPackTuner::applySortOrder()
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         h_body.data[i] = uint_tmp[i];
 
+    // sort group membership bits
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        uint_tmp[i] = h_group_bits.data[m_sort_order[i]];
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        h_group_bits.data[i] = uint_tmp[i];
+
     // sort global tag
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         uint_tmp[i] = h_tag.data[m_sort_order[i]];
@@ -291,6 +306,23 @@ void SFCPackTuner::applySortOrder()
     delete[] int3_tmp;
     }
 
+//! Count the consecutive particles whose bins decrease
+/*! \param particle_bins Bin and index of each particle in memory order
+    \param N Number of particles
+*/
+static unsigned int
+countDescents(const std::vector<std::pair<unsigned int, unsigned int>>& particle_bins,
+              unsigned int N)
+    {
+    unsigned int n_descents = 0;
+    for (unsigned int n = 1; n < N; n++)
+        {
+        if (particle_bins[n].first < particle_bins[n - 1].first)
+            n_descents++;
+        }
+    return n_descents;
+    }
+
 //! x walking table for the hilbert curve
 static int istep[] = {0, 0, 0, 0, 1, 1, 1, 1};
 //! y walking table for the hilbert curve
@@ -500,6 +532,7 @@ void SFCPackTuner::getSortedOrder2D()
 
     // put the particles in the bins
         {
+        unsigned int n_types = getNumSortTypes(m_grid * m_grid);
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::read);
@@ -524,13 +557,18 @@ void SFCPackTuner::getSortedOrder2D()
             if (jb >= (int)m_grid)
                 jb = m_grid - 1;
 
-            // record its bin
+            // record its bin, and its type within the bin
             unsigned int bin = ib * m_grid + jb;
+            if (n_types > 1)
+                bin = bin * n_types + __scalar_as_int(h_pos.data[n].w);
 
             m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
             }
         }
 
+    if (!checkDisorder(countDescents(m_particle_bins, m_pdata->getN())))
+        return;
+
     // sort the tuples
     sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
 
@@ -604,6 +642,7 @@ void SFCPackTuner::getSortedOrder3D()
     assert(m_traversal_order.getNumElements() == m_grid * m_grid * m_grid);
 
     // put the particles in the bins
+    unsigned int n_types = getNumSortTypes(m_grid * m_grid * m_grid);
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
     // access traversal order
@@ -636,12 +675,17 @@ void SFCPackTuner::getSortedOrder3D()
         if (kb >= (int)m_grid)
             kb = m_grid - 1;
 
-        // record its bin
-        unsigned int bin = ib * (m_grid * m_grid) + jb * m_grid + kb;
+        // record its bin along the curve, and its type within the bin
+        unsigned int bin = h_traversal_order.data[ib * (m_grid * m_grid) + jb * m_grid + kb];
+        if (n_types > 1)
+            bin = bin * n_types + __scalar_as_int(h_pos.data[n].w);
 
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
+        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
         }
 
+    if (!checkDisorder(countDescents(m_particle_bins, m_pdata->getN())))
+        return;
+
     // sort the tuples
     sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
 
@@ -652,6 +696,51 @@ void SFCPackTuner::getSortedOrder3D()
         }
     }
 
+/*! \param n_descents Number of consecutive particles in memory whose bins are out of curve order
+    \returns True when the particles should be sorted
+
+    Sets m_disorder and m_sort_needed. All ranks return the same result.
+*/
+bool SFCPackTuner::checkDisorder(unsigned int n_descents)
+    {
+    unsigned int N = m_pdata->getN();
+    m_disorder = (N > 1) ? Scalar(n_descents) / Scalar(N - 1) : Scalar(0);
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // every rank must take part in the sort
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &m_disorder,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    m_sort_needed = m_disorder_threshold == Scalar(0) || m_disorder > m_disorder_threshold;
+    return m_sort_needed;
+    }
+
+/*! \param n_bins Number of bins in the grid
+    \returns The number of types to combine with the bin in each sort key, 1 when not sorting by
+    type
+*/
+unsigned int SFCPackTuner::getNumSortTypes(unsigned int n_bins)
+    {
+    if (!m_sort_by_type)
+        return 1;
+
+    unsigned int n_types = m_pdata->getNTypes();
+    if (uint64_t(n_bins) * n_types > std::numeric_limits<unsigned int>::max())
+        {
+        throw std::runtime_error("Too many types to sort by type with grid "
+                                 + std::to_string(m_grid) + ", reduce the grid.");
+        }
+    return n_types;
+    }
+
 void SFCPackTuner::writeTraversalOrder(const std::string& fname,
                                        const vector<unsigned int>& reverse_order)
     {
@@ -690,5 +779,11 @@ void export_SFCPackTuner(py::module& m)
     {
     py::class_<SFCPackTuner, Tuner, std::shared_ptr<SFCPackTuner>>(m, "SFCPackTuner")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<Trigger>>())
-        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython);
+        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython)
+        .def_property("disorder_threshold",
+                      &SFCPackTuner::getDisorderThreshold,
+                      &SFCPackTuner::setDisorderThreshold)
+        .def_property("sort_by_type", &SFCPackTuner::getSortByType, &SFCPackTuner::setSortByType)
+        .def_property_readonly("disorder", &SFCPackTuner::getDisorder)
+        .def_property_readonly("num_sorts", &SFCPackTuner::getNumSorts);
     }
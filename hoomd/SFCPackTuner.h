@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -38,6 +39,19 @@
    set to reasonable defaults, which is as high as it can possibly go without consuming a
    significant amount of memory. The grid dimension can be changed by calling setGrid().
 
+    Adaptive sorting:<br>
+    A sort costs a full reorder of the particle data and forces every neighbor list to rebuild.
+    When the disorder threshold is set, the tuner measures the disorder of the current order on
+    each triggered step: the fraction of consecutive particles in memory whose bins are out of
+    space-filling curve order. It reorders the particles only when the disorder exceeds the
+    threshold. The disorder is 0 right after a sort and approaches 1/2 for a random order. With
+    MPI, the ranks sort together when the largest disorder of any rank exceeds the threshold.
+
+    Sorting by type:<br>
+    When sort by type is enabled, particles are ordered by bin and then by type, so that particles
+    of the same type are contiguous within each bin. GPU pair potentials then load the same
+    parameters across a warp and branch less in type dependent evaluators.
+
     Implementation details:<br>
     The rearranging is done by computing bins for the particles, and then ordering the particles
    based on the order in which those bins appear along a hilbert curve. It is very efficient, even
@@ -80,11 +94,55 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
         return m_grid;
         }
 
+    //! Set the disorder above which the tuner sorts
+    /*! \param threshold Fraction of consecutive particles out of curve order, 0 sorts on every
+        triggered step
+    */
+    void setDisorderThreshold(Scalar threshold)
+        {
+        if (threshold < 0 || threshold > 1)
+            throw std::domain_error("The disorder threshold must be between 0 and 1.");
+        m_disorder_threshold = threshold;
+        }
+
+    Scalar getDisorderThreshold()
+        {
+        return m_disorder_threshold;
+        }
+
+    //! Set whether to order the particles by type within each bin
+    void setSortByType(bool sort_by_type)
+        {
+        m_sort_by_type = sort_by_type;
+        }
+
+    bool getSortByType()
+        {
+        return m_sort_by_type;
+        }
+
+    //! Get the disorder measured on the last triggered step
+    Scalar getDisorder()
+        {
+        return m_disorder;
+        }
+
+    //! Get the number of times the tuner reordered the particles
+    uint64_t getNumSorts()
+        {
+        return m_num_sorts;
+        }
+
     protected:
     unsigned int m_grid;                      //!< Grid dimension to use
     unsigned int m_last_grid;                 //!< The last value of MMax
     unsigned int m_last_dim;                  //!< Check the last dimension we ran at
     GPUArray<unsigned int> m_traversal_order; //!< Generated traversal order of bins
+    Scalar m_disorder_threshold;              //!< Disorder above which to sort
+    Scalar m_disorder;                        //!< Disorder measured on the last triggered step
+    uint64_t m_num_sorts;                     //!< Number of sorts applied
+    bool m_sort_needed;                       //!< True when the last measurement calls for a sort
+    bool m_sort_by_type;                      //!< True to order by type within each bin
 
     //! Helper function that actually performs the sort
     virtual void getSortedOrder2D();
@@ -94,6 +152,12 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
     //! Apply the sorted order to the particle data
     virtual void applySortOrder();
 
+    //! Decide whether to sort from the number of particles out of curve order
+    bool checkDisorder(unsigned int n_descents);
+
+    //! Get the number of types to order by within each bin
+    unsigned int getNumSortTypes(unsigned int n_bins);
+
     //! Helper function to generate traversal order
     static void generateTraversalOrder(int i,
                                        int j,
@@ -133,16 +133,36 @@ void SFCPackTunerGPU::getSortedOrder3D()
                                                 access_location::device,
                                                 access_mode::read);
 
-    // put the particles in the bins and sort
-    gpu_generate_sorted_order(m_pdata->getN(),
-                              d_pos.data,
-                              d_gpu_particle_bins.data,
-                              d_traversal_order.data,
-                              m_grid,
-                              d_gpu_sort_order.data,
-                              box,
-                              m_sysdef->getNDimensions() == 2,
-                              m_exec_conf->getCachedAllocator());
+    unsigned int n_bins = m_grid * m_grid;
+    if (m_sysdef->getNDimensions() == 3)
+        n_bins *= m_grid;
+    unsigned int n_types = getNumSortTypes(n_bins);
+
+    // put the particles in the bins
+    gpu_sfc_bin_particles(m_pdata->getN(),
+                          d_pos.data,
+                          d_gpu_particle_bins.data,
+                          d_traversal_order.data,
+                          m_grid,
+                          d_gpu_sort_order.data,
+                          box,
+                          m_sysdef->getNDimensions() == 2,
+                          n_types);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    unsigned int n_descents = gpu_sfc_count_descents(m_pdata->getN(),
+                                                     d_gpu_particle_bins.data,
+                                                     m_exec_conf->getCachedAllocator());
+    if (!checkDisorder(n_descents))
+        return;
+
+    // sort the particles by bin
+    gpu_sfc_sort_particles(m_pdata->getN(),
+                           d_gpu_particle_bins.data,
+                           d_gpu_sort_order.data,
+                           m_exec_conf->getCachedAllocator());
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -176,6 +196,9 @@ void SFCPackTunerGPU::applySortOrder()
         ArrayHandle<unsigned int> d_body_alt(m_pdata->getAltBodies(),
                                              access_location::device,
                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> d_group_bits_alt(m_pdata->getAltGroupBits(),
+                                                   access_location::device,
+                                                   access_mode::overwrite);
         ArrayHandle<unsigned int> d_tag_alt(m_pdata->getAltTags(),
                                             access_location::device,
                                             access_mode::overwrite);
@@ -219,6 +242,9 @@ void SFCPackTunerGPU::applySortOrder()
         ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
                                          access_location::device,
                                          access_mode::read);
+        ArrayHandle<unsigned int> d_group_bits(m_pdata->getGroupBits(),
+                                               access_location::device,
+                                               access_mode::read);
         ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
                                         access_location::device,
                                         access_mode::read);
@@ -270,6 +296,8 @@ void SFCPackTunerGPU::applySortOrder()
                                d_image_alt.data,
                                d_body.data,
                                d_body_alt.data,
+                               d_group_bits.data,
+                               d_group_bits_alt.data,
                                d_tag.data,
                                d_tag_alt.data,
                                d_orientation.data,
@@ -299,6 +327,7 @@ void SFCPackTunerGPU::applySortOrder()
     m_pdata->swapDiameters();
     m_pdata->swapImages();
     m_pdata->swapBodies();
+    m_pdata->swapGroupBits();
     m_pdata->swapTags();
     m_pdata->swapOrientations();
     m_pdata->swapAngularMomenta();
@@ -14,6 +14,8 @@
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <thrust/device_ptr.h>
 #include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
 #include <thrust/sort.h>
 #pragma GCC diagnostic pop
 
@@ -27,7 +29,8 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
                                              const unsigned int* d_traversal_order,
                                              unsigned int n_grid,
                                              unsigned int* d_sorted_order,
-                                             const BoxDim box)
+                                             const BoxDim box,
+                                             unsigned int n_types)
     {
     unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
 
@@ -65,14 +68,18 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
         {
         // do not use Hilbert curve in 2D
         bin = ib * n_grid + jb;
-        d_particle_bins[idx] = bin;
         }
     else
         {
-        bin = ib * (n_grid * n_grid) + jb * n_grid + kb;
-        d_particle_bins[idx] = d_traversal_order[bin];
+        bin = d_traversal_order[ib * (n_grid * n_grid) + jb * n_grid + kb];
         }
 
+    // order by type within the bin
+    if (n_types > 1)
+        bin = bin * n_types + __scalar_as_int(postype.w);
+
+    d_particle_bins[idx] = bin;
+
     // store index of ptl
     d_sorted_order[idx] = idx;
     }
@@ -85,16 +92,17 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
     \param d_sorted_order Sorted order of particles
     \param box Box dimensions
     \param twod If true, bin particles in two dimensions
+    \param n_types Number of types to order by within each bin, 1 to order by bin only
     */
-void gpu_generate_sorted_order(unsigned int N,
-                               const Scalar4* d_pos,
-                               unsigned int* d_particle_bins,
-                               unsigned int* d_traversal_order,
-                               unsigned int n_grid,
-                               unsigned int* d_sorted_order,
-                               const BoxDim& box,
-                               bool twod,
-                               CachedAllocator& alloc)
+void gpu_sfc_bin_particles(unsigned int N,
+                           const Scalar4* d_pos,
+                           unsigned int* d_particle_bins,
+                           unsigned int* d_traversal_order,
+                           unsigned int n_grid,
+                           unsigned int* d_sorted_order,
+                           const BoxDim& box,
+                           bool twod,
+                           unsigned int n_types)
     {
     // maybe need to autotune, but SFCPackTuner is called infrequently
     unsigned int block_size = 256;
@@ -112,7 +120,8 @@ void gpu_generate_sorted_order(unsigned int N,
                            d_traversal_order,
                            n_grid,
                            d_sorted_order,
-                           box);
+                           box,
+                           n_types);
     else
         hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<false>),
                            dim3(n_blocks),
@@ -125,8 +134,45 @@ void gpu_generate_sorted_order(unsigned int N,
                            d_traversal_order,
                            n_grid,
                            d_sorted_order,
-                           box);
+                           box,
+                           n_types);
+    }
+
+/*! \param N number of local particles
+    \param d_particle_bins Device array of particle bins in memory order
+    \param alloc Caching allocator for temporary storage
+    \returns The number of particles whose bin is smaller than the bin of the previous particle
+    */
+unsigned int
+gpu_sfc_count_descents(unsigned int N, const unsigned int* d_particle_bins, CachedAllocator& alloc)
+    {
+    if (N < 2)
+        return 0;
+
+    thrust::device_ptr<const unsigned int> particle_bins(d_particle_bins);
+#ifdef __HIP_PLATFORM_HCC__
+    return thrust::inner_product(thrust::hip::par(alloc),
+#else
+    return thrust::inner_product(thrust::cuda::par(alloc),
+#endif
+                                 particle_bins,
+                                 particle_bins + N - 1,
+                                 particle_bins + 1,
+                                 0u,
+                                 thrust::plus<unsigned int>(),
+                                 thrust::greater<unsigned int>());
+    }
 
+/*! \param N number of local particles
+    \param d_particle_bins Device array of particle bins, sorted on output
+    \param d_sorted_order Sorted order of particles
+    \param alloc Caching allocator for temporary storage
+    */
+void gpu_sfc_sort_particles(unsigned int N,
+                            unsigned int* d_particle_bins,
+                            unsigned int* d_sorted_order,
+                            CachedAllocator& alloc)
+    {
     // Sort particles
     if (N)
         {
@@ -161,6 +207,8 @@ __global__ void gpu_apply_sorted_order_kernel(unsigned int N,
                                               int3* d_image_alt,
                                               const unsigned int* d_body,
                                               unsigned int* d_body_alt,
+                                              const unsigned int* d_group_bits,
+                                              unsigned int* d_group_bits_alt,
                                               const unsigned int* d_tag,
                                               unsigned int* d_tag_alt,
                                               const Scalar4* d_orientation,
@@ -194,6 +242,7 @@ __global__ void gpu_apply_sorted_order_kernel(unsigned int N,
     d_diameter_alt[idx] = d_diameter[old_idx];
     d_image_alt[idx] = d_image[old_idx];
     d_body_alt[idx] = d_body[old_idx];
+    d_group_bits_alt[idx] = d_group_bits[old_idx];
     unsigned int tag = d_tag[old_idx];
     d_tag_alt[idx] = tag;
     d_orientation_alt[idx] = d_orientation[old_idx];
@@ -232,6 +281,8 @@ void gpu_apply_sorted_order(unsigned int N,
                             int3* d_image_alt,
                             const unsigned int* d_body,
                             unsigned int* d_body_alt,
+                            const unsigned int* d_group_bits,
+                            unsigned int* d_group_bits_alt,
                             const unsigned int* d_tag,
                             unsigned int* d_tag_alt,
                             const Scalar4* d_orientation,
@@ -274,6 +325,8 @@ void gpu_apply_sorted_order(unsigned int N,
                        d_image_alt,
                        d_body,
                        d_body_alt,
+                       d_group_bits,
+                       d_group_bits_alt,
                        d_tag,
                        d_tag_alt,
                        d_orientation,
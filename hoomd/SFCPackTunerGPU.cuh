@@ -15,16 +15,26 @@
    Used by SFCPackTunerGPU.
 */
 
-//! Generate sorted order on GPU
-void gpu_generate_sorted_order(unsigned int N,
-                               const Scalar4* d_pos,
-                               unsigned int* d_particle_bins,
-                               unsigned int* d_traversal_order,
-                               unsigned int n_grid,
-                               unsigned int* d_sorted_order,
-                               const BoxDim& box,
-                               bool twod,
-                               CachedAllocator& alloc);
+//! Bin particles along the space-filling curve on the GPU
+void gpu_sfc_bin_particles(unsigned int N,
+                           const Scalar4* d_pos,
+                           unsigned int* d_particle_bins,
+                           unsigned int* d_traversal_order,
+                           unsigned int n_grid,
+                           unsigned int* d_sorted_order,
+                           const BoxDim& box,
+                           bool twod,
+                           unsigned int n_types);
+
+//! Count the consecutive particles whose bins decrease
+unsigned int
+gpu_sfc_count_descents(unsigned int N, const unsigned int* d_particle_bins, CachedAllocator& alloc);
+
+//! Generate sorted order from the particle bins on the GPU
+void gpu_sfc_sort_particles(unsigned int N,
+                            unsigned int* d_particle_bins,
+                            unsigned int* d_sorted_order,
+                            CachedAllocator& alloc);
 
 //! Reorder particle data (GPU driver function)
 void gpu_apply_sorted_order(unsigned int N,
@@ -44,6 +54,8 @@ void gpu_apply_sorted_order(unsigned int N,
                             int3* d_image_alt,
                             const unsigned int* d_body,
                             unsigned int* d_body_alt,
+                            const unsigned int* d_group_bits,
+                            unsigned int* d_group_bits_alt,
                             const unsigned int* d_tag,
                             unsigned int* d_tag_alt,
                             const Scalar4* d_orientation,
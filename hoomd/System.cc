@@ -8,6 +8,7 @@
 */
 
 #include "System.h"
+#include "AutotunerCache.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -32,6 +33,27 @@ namespace py = pybind11;
 
 PyObject* walltimeLimitExceptionTypeObj = 0;
 
+namespace
+    {
+//! Find the first step at or after tstep when any of the triggers may be active
+/*! \param ops Operations to check
+    \param get_trigger Function that returns the trigger of an operation
+    \param tstep First time step to consider
+*/
+template<class T, class F>
+uint64_t nextTriggerStep(const std::vector<T>& ops, F get_trigger, uint64_t tstep)
+    {
+    uint64_t next = Trigger::never;
+    for (auto& op : ops)
+        {
+        next = std::min(next, get_trigger(op)->nextStep(tstep));
+        if (next == tstep)
+            break;
+        }
+    return next;
+    }
+    } // end namespace
+
 /*! \param sysdef SystemDefinition for the system to be simulated
     \param initial_tstep Initial time step of the simulation
 
@@ -85,6 +107,10 @@ void System::setCommunicator(std::shared_ptr<Communicator> comm)
 
 void System::run(uint64_t nsteps, bool write_at_start)
     {
+    // let other python threads run during the simulation, the operations that call python acquire
+    // the GIL when they need it
+    py::gil_scoped_release release;
+
     m_start_tstep = m_cur_tstep;
     m_end_tstep = m_cur_tstep + nsteps;
 
@@ -92,6 +118,9 @@ void System::run(uint64_t nsteps, bool write_at_start)
     m_initial_time = m_clk.getTime();
     setupProfiling();
 
+    // the operations and their triggers may have changed since the last run
+    findNextTriggerSteps(m_cur_tstep);
+
     // preset the flags before the run loop so that any analyzers/updaters run on step 0 have the
     // info they need but set the flags before prepRun, as prepRun may remove some flags that it
     // cannot generate on the first step
@@ -99,6 +128,10 @@ void System::run(uint64_t nsteps, bool write_at_start)
 
     resetStats();
 
+    // autotuners look up cached parameters for systems of this size
+    AutotunerCache::setSystem(m_sysdef->getParticleData()->getNGlobal(),
+                              m_sysdef->getParticleData()->getNTypes());
+
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
@@ -117,7 +150,7 @@ void System::run(uint64_t nsteps, bool write_at_start)
         }
 
     // execute analyzers on initial step if requested
-    if (write_at_start)
+    if (write_at_start && m_cur_tstep >= m_next_analyzer_step)
         {
         for (auto& analyzer_trigger_pair : m_analyzers)
             {
@@ -126,21 +159,50 @@ void System::run(uint64_t nsteps, bool write_at_start)
             }
         }
 
-    // run the steps
+    // regions of the time step loop to show in the timeline
+    Tracer* tracer = m_exec_conf->getTracer().get();
+
+    // acquiring the GIL on every step would wait for the other python threads, so signals are only
+    // checked every 100 ms
+    int64_t last_signal_check = m_initial_time;
+
+    // run the steps, only evaluating the triggers on the steps where they may be active
     for (uint64_t count = 0; count < nsteps; count++)
         {
-        for (auto& tuner : m_tuners)
+        if (tracer)
+            tracer->begin("Tuners");
+        if (m_cur_tstep >= m_next_tuner_step)
             {
-            if ((*tuner->getTrigger())(m_cur_tstep))
-                tuner->update(m_cur_tstep);
+            for (auto& tuner : m_tuners)
+                {
+                if ((*tuner->getTrigger())(m_cur_tstep))
+                    tuner->update(m_cur_tstep);
+                }
+            m_next_tuner_step = nextTriggerStep(
+                m_tuners,
+                [](const std::shared_ptr<Tuner>& tuner) { return tuner->getTrigger(); },
+                m_cur_tstep + 1);
+            }
+        if (tracer)
+            {
+            tracer->end();
+            tracer->begin("Updaters");
             }
 
         // execute updaters
-        for (auto& updater_trigger_pair : m_updaters)
+        if (m_cur_tstep >= m_next_updater_step)
             {
-            if ((*updater_trigger_pair.second)(m_cur_tstep))
-                updater_trigger_pair.first->update(m_cur_tstep);
+            for (auto& updater_trigger_pair : m_updaters)
+                {
+                if ((*updater_trigger_pair.second)(m_cur_tstep))
+                    updater_trigger_pair.first->update(m_cur_tstep);
+                }
+            m_next_updater_step = nextTriggerStep(m_updaters,
+                                                  [](const _updater_pair& p) { return p.second; },
+                                                  m_cur_tstep + 1);
             }
+        if (tracer)
+            tracer->end();
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
         // or together all of their requested PDataFlags to determine the flags to set for this time
@@ -148,25 +210,49 @@ void System::run(uint64_t nsteps, bool write_at_start)
         m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep + 1));
 
         // execute the integrator
+        if (tracer)
+            tracer->begin("Integrator");
         if (m_integrator)
             m_integrator->update(m_cur_tstep);
+        if (tracer)
+            tracer->end();
 
         m_cur_tstep++;
 
         // execute analyzers after incrementing the step counter
-        for (auto& analyzer_trigger_pair : m_analyzers)
+        if (tracer)
+            tracer->begin("Analyzers");
+        if (m_cur_tstep >= m_next_analyzer_step)
             {
-            if ((*analyzer_trigger_pair.second)(m_cur_tstep))
-                analyzer_trigger_pair.first->analyze(m_cur_tstep);
+            for (auto& analyzer_trigger_pair : m_analyzers)
+                {
+                if ((*analyzer_trigger_pair.second)(m_cur_tstep))
+                    analyzer_trigger_pair.first->analyze(m_cur_tstep);
+                }
+            m_next_analyzer_step = nextTriggerStep(m_analyzers,
+                                                   [](const _analyzer_pair& p) { return p.second; },
+                                                   m_cur_tstep + 1);
             }
+        if (tracer)
+            tracer->end();
 
         updateTPS();
 
         // propagate Python exceptions related to signals
-        if (PyErr_CheckSignals() != 0)
+        const int64_t now = m_clk.getTime();
+        if (now - last_signal_check > int64_t(100000000) || count + 1 == nsteps)
             {
-            throw py::error_already_set();
+            last_signal_check = now;
+            py::gil_scoped_acquire acquire;
+            if (PyErr_CheckSignals() != 0)
+                {
+                throw py::error_already_set();
+                }
             }
+
+        // the integrator may end the run early
+        if (m_integrator && m_integrator->isRunComplete())
+            break;
         }
 
 #ifdef ENABLE_MPI
@@ -225,8 +311,13 @@ void System::setAutotunerParams(bool enabled, unsigned int period)
 
 void System::setupProfiling()
     {
-    if (m_profile)
+    // tracing records the profiled regions, so it needs a profiler as well
+    const std::shared_ptr<Tracer>& tracer = m_exec_conf->getTracer();
+    if (m_profile || tracer)
+        {
         m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation"));
+        m_profiler->setTracer(tracer);
+        }
     else
         m_profiler = std::shared_ptr<Profiler>();
 
@@ -253,6 +344,10 @@ void System::setupProfiling()
         updater_trigger_pair.first->setProfiler(m_profiler);
         }
 
+    // tuners
+    for (auto& tuner : m_tuners)
+        tuner->setProfiler(m_profiler);
+
     // computes
     for (auto compute : m_computes)
         compute->setProfiler(m_profiler);
@@ -291,29 +386,57 @@ PDataFlags System::determineFlags(uint64_t tstep)
     {
     PDataFlags flags = m_default_flags;
     if (m_integrator)
-        flags |= m_integrator->getRequestedPDataFlags();
+        flags |= m_integrator->getRequestedPDataFlags(tstep);
 
-    for (auto& analyzer_trigger_pair : m_analyzers)
+    // skip the operations that cannot trigger on this step
+    if (tstep >= m_next_analyzer_step)
         {
-        if ((*analyzer_trigger_pair.second)(tstep))
-            flags |= analyzer_trigger_pair.first->getRequestedPDataFlags();
+        for (auto& analyzer_trigger_pair : m_analyzers)
+            {
+            if ((*analyzer_trigger_pair.second)(tstep))
+                flags |= analyzer_trigger_pair.first->getRequestedPDataFlags();
+            }
         }
 
-    for (auto& updater_trigger_pair : m_updaters)
+    if (tstep >= m_next_updater_step)
         {
-        if ((*updater_trigger_pair.second)(tstep))
-            flags |= updater_trigger_pair.first->getRequestedPDataFlags();
+        for (auto& updater_trigger_pair : m_updaters)
+            {
+            if ((*updater_trigger_pair.second)(tstep))
+                flags |= updater_trigger_pair.first->getRequestedPDataFlags();
+            }
         }
 
-    for (auto& tuner : m_tuners)
+    if (tstep >= m_next_tuner_step)
         {
-        if ((*tuner->getTrigger())(tstep))
-            flags |= tuner->getRequestedPDataFlags();
+        for (auto& tuner : m_tuners)
+            {
+            if ((*tuner->getTrigger())(tstep))
+                flags |= tuner->getRequestedPDataFlags();
+            }
         }
 
     return flags;
     }
 
+/*! \param tstep First time step to consider
+
+    The bounds are valid until operations are added or their triggers are replaced. This may happen
+    between runs or from an operation during a run, so python calls resetTriggerSteps() after every
+    such change. Removing operations only leaves bounds that are too early, which are harmless.
+*/
+void System::findNextTriggerSteps(uint64_t tstep)
+    {
+    m_next_tuner_step = nextTriggerStep(
+        m_tuners,
+        [](const std::shared_ptr<Tuner>& tuner) { return tuner->getTrigger(); },
+        tstep);
+    m_next_updater_step
+        = nextTriggerStep(m_updaters, [](const _updater_pair& p) { return p.second; }, tstep);
+    m_next_analyzer_step
+        = nextTriggerStep(m_analyzers, [](const _analyzer_pair& p) { return p.second; }, tstep);
+    }
+
 void export_System(py::module& m)
     {
     py::bind_vector<std::vector<std::pair<std::shared_ptr<Analyzer>, std::shared_ptr<Trigger>>>>(
@@ -333,7 +456,10 @@ void export_System(py::module& m)
 
         .def("setAutotunerParams", &System::setAutotunerParams)
         .def("enableProfiler", &System::enableProfiler)
+        .def("getProfilerEnabled", &System::getProfilerEnabled)
+        .def("getProfiler", &System::getProfiler)
         .def("run", &System::run)
+        .def("resetTriggerSteps", &System::resetTriggerSteps)
 
         .def("getLastTPS", &System::getLastTPS)
         .def("getCurrentTimeStep", &System::getCurrentTimeStep)
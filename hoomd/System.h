@@ -93,9 +93,30 @@ class PYBIND11_EXPORT System
     */
     void run(uint64_t nsteps, bool write_at_start = false);
 
+    //! Recompute the first steps when the tuners, updaters, and analyzers may trigger
+    /*! Call after adding operations or replacing their triggers, also from operations that run
+        during a run.
+    */
+    void resetTriggerSteps()
+        {
+        findNextTriggerSteps(m_cur_tstep);
+        }
+
     //! Configures profiling of runs
     void enableProfiler(bool enable);
 
+    //! Get whether runs are profiled
+    bool getProfilerEnabled() const
+        {
+        return m_profile;
+        }
+
+    /// Get the profiler of the current or last run (null when profiling was disabled)
+    std::shared_ptr<Profiler> getProfiler()
+        {
+        return m_profiler;
+        }
+
     //! Get the average TPS from the last run
     Scalar getLastTPS() const
         {
@@ -189,6 +210,10 @@ class PYBIND11_EXPORT System
     uint64_t m_end_tstep;   //!< Final time step of the current run
     uint64_t m_cur_tstep;   //!< Current time step
 
+    uint64_t m_next_tuner_step = 0;    //!< No tuner triggers before this step
+    uint64_t m_next_updater_step = 0;  //!< No updater triggers before this step
+    uint64_t m_next_analyzer_step = 0; //!< No analyzer triggers before this step
+
     ClockSource m_clk; //!< A clock counting time from the beginning of the run
 
     bool m_profile; //!< True if runs should be profiled
@@ -206,6 +231,9 @@ class PYBIND11_EXPORT System
     //! Get the flags needed for a particular step
     PDataFlags determineFlags(uint64_t tstep);
 
+    //! Find the first steps at or after tstep when the tuners, updaters, and analyzers may trigger
+    void findNextTriggerSteps(uint64_t tstep);
+
     /// Record the initial time of the last run
     int64_t m_initial_time = 0;
 
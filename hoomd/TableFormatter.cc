@@ -0,0 +1,253 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TableFormatter.cc
+    \brief Defines the TableFormatter class
+*/
+
+#include "TableFormatter.h"
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+namespace
+    {
+//! Count the code points in a UTF-8 string, to match the lengths of python strings
+size_t utf8Length(const string& s)
+    {
+    return count_if(s.begin(), s.end(), [](char c) { return (c & 0xC0) != 0x80; });
+    }
+
+//! Get the last n code points of a UTF-8 string
+string utf8Tail(const string& s, size_t n)
+    {
+    size_t length = utf8Length(s);
+    if (length <= n)
+        return s;
+
+    // skip the first (length - n) code points
+    size_t skip = length - n;
+    size_t i = 0;
+    for (; i < s.size(); i++)
+        {
+        if ((s[i] & 0xC0) != 0x80)
+            {
+            if (skip == 0)
+                break;
+            skip--;
+            }
+        }
+    return s.substr(i);
+    }
+    } // end namespace
+
+/*! \param pretty Limit the number of decimals to the column width
+    \param max_precision Maximum number of significant digits
+    \param max_decimals_pretty Maximum number of decimals in pretty output
+*/
+TableFormatter::TableFormatter(bool pretty,
+                               unsigned int max_precision,
+                               unsigned int max_decimals_pretty)
+    : m_pretty(pretty), m_max_precision(max_precision), m_max_decimals_pretty(max_decimals_pretty)
+    {
+    }
+
+/*! \param values Logged values, strings or numbers
+    \param widths Width of each column
+    \param delimiter String placed between the columns
+*/
+void TableFormatter::appendRow(py::sequence values,
+                               const std::vector<unsigned int>& widths,
+                               const std::string& delimiter)
+    {
+    const size_t n = py::len(values);
+    if (n != widths.size())
+        throw runtime_error("The number of values and columns do not match.");
+
+    for (size_t i = 0; i < n; i++)
+        {
+        if (i > 0)
+            m_output += delimiter;
+
+        py::object value = values[i];
+        if (py::isinstance<py::str>(value))
+            m_output += formatString(value.cast<string>(), widths[i]);
+        else
+            m_output += formatNumber(value, widths[i]);
+        }
+    m_output += '\n';
+    }
+
+/*! \param names Column headers
+    \param widths Width of each column
+    \param delimiter String placed between the columns
+*/
+void TableFormatter::appendHeader(const std::vector<std::string>& names,
+                                  const std::vector<unsigned int>& widths,
+                                  const std::string& delimiter)
+    {
+    if (names.size() != widths.size())
+        throw runtime_error("The number of names and columns do not match.");
+
+    for (size_t i = 0; i < names.size(); i++)
+        {
+        if (i > 0)
+            m_output += delimiter;
+        m_output += formatString(names[i], widths[i]);
+        }
+    m_output += '\n';
+    }
+
+std::string TableFormatter::takeOutput()
+    {
+    string output;
+    output.swap(m_output);
+    return output;
+    }
+
+/*! \param value Python integer or floating point number
+    \param width Column width
+
+    Integers (any object that implements __index__ other than python floats) are written in full.
+    Other objects are converted to floating point numbers.
+*/
+std::string TableFormatter::formatNumber(py::handle value, unsigned int width) const
+    {
+    PyObject* obj = value.ptr();
+    if (PyLong_Check(obj) || (!PyFloat_Check(obj) && PyIndex_Check(obj)))
+        {
+        py::object index = py::reinterpret_steal<py::object>(PyNumber_Index(obj));
+        if (!index)
+            throw py::error_already_set();
+
+        string out;
+        center(out, py::str(index).cast<string>(), width);
+        return out;
+        }
+
+    double x = PyFloat_AsDouble(obj);
+    if (x == -1.0 && PyErr_Occurred())
+        throw py::error_already_set();
+    return formatFloat(x, width);
+    }
+
+/*! \param value String to format
+    \param width Column width
+
+    Long strings are truncated to their end in pretty output.
+*/
+std::string TableFormatter::formatString(const std::string& value, unsigned int width) const
+    {
+    string out;
+    if (m_pretty && utf8Length(value) > width)
+        center(out, utf8Tail(value, max(1, int(width) - 2)), width);
+    else
+        center(out, value, width);
+    return out;
+    }
+
+/*! \param x Number to format
+    \param width Column width
+*/
+std::string TableFormatter::formatFloat(double x, unsigned int width) const
+    {
+    string out;
+    if (std::isnan(x))
+        {
+        center(out, "nan", width);
+        return out;
+        }
+    if (std::isinf(x))
+        {
+        center(out, x > 0 ? "inf" : "-inf", width);
+        return out;
+        }
+
+    // The smallest representation of a number greater than one has no decimals. Numbers less
+    // than one need at least 0. This counts the characters before the decimals with the point.
+    int min_len_repr = int(std::log10(std::max(std::fabs(x), 1.0))) + 1;
+    if (x < 0)
+        min_len_repr += 1;
+
+    const int w = int(width);
+    const int precision = int(m_max_precision) - 1;
+    const int max_decimals = int(m_max_decimals_pretty);
+    int decimals;
+    const char* fmt;
+    if (!(min_len_repr < 6) || min_len_repr > w)
+        {
+        decimals = m_pretty ? min(max(w - 6, 1), max_decimals) : max(precision, 0);
+        fmt = "%.*e";
+        }
+    else
+        {
+        decimals = m_pretty ? min(max(w - min_len_repr - 2, 1), max_decimals)
+                            : max(precision - min_len_repr + 1, 0);
+        fmt = "%.*f";
+        }
+
+    int n = snprintf(nullptr, 0, fmt, decimals, x);
+    vector<char> buf(n + 1);
+    snprintf(buf.data(), buf.size(), fmt, decimals, x);
+    center(out, string(buf.data(), n), width);
+    return out;
+    }
+
+/*! \param out String to append to
+    \param value String to center
+    \param width Column width
+
+    Matches python's centered alignment, which places the extra space on the right.
+*/
+void TableFormatter::center(std::string& out, const std::string& value, unsigned int width)
+    {
+    const size_t length = utf8Length(value);
+    const size_t pad = (length < width) ? width - length : 0;
+    out.append(pad / 2, ' ');
+    out += value;
+    out.append(pad - pad / 2, ' ');
+    }
+
+void export_TableFormatter(py::module& m)
+    {
+    py::class_<TableFormatter, std::shared_ptr<TableFormatter>>(m, "TableFormatter")
+        .def(py::init<bool, unsigned int, unsigned int>(),
+             py::arg("pretty"),
+             py::arg("max_precision"),
+             py::arg("max_decimals_pretty") = 5)
+        .def("appendRow", &TableFormatter::appendRow)
+        .def("appendHeader", &TableFormatter::appendHeader)
+        .def("takeOutput", &TableFormatter::takeOutput)
+        .def("formatNumber", &TableFormatter::formatNumber)
+        .def("formatString", &TableFormatter::formatString)
+        .def_property_readonly("pretty", &TableFormatter::getPretty)
+        .def_property_readonly("max_precision", &TableFormatter::getMaxPrecision)
+        .def_property_readonly("max_decimals_pretty", &TableFormatter::getMaxDecimalsPretty)
+        .def("__eq__",
+             [](const TableFormatter& a, const TableFormatter& b)
+             {
+                 return a.getPretty() == b.getPretty()
+                        && a.getMaxPrecision() == b.getMaxPrecision()
+                        && a.getMaxDecimalsPretty() == b.getMaxDecimalsPretty();
+             })
+        .def(py::pickle(
+            [](const TableFormatter& f)
+            {
+                return py::make_tuple(f.getPretty(),
+                                      f.getMaxPrecision(),
+                                      f.getMaxDecimalsPretty());
+            },
+            [](py::tuple params)
+            {
+                return TableFormatter(params[0].cast<bool>(),
+                                      params[1].cast<unsigned int>(),
+                                      params[2].cast<unsigned int>());
+            }));
+    }
@@ -0,0 +1,87 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file TableFormatter.h
+    \brief Declares a class that formats the rows of hoomd.write.Table
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+//! Formats rows of logged values for hoomd.write.Table
+/*! hoomd.write.Table writes one row per call. Formatting each value with python format strings
+    costs more than the simulation step at high output frequencies, so TableFormatter formats a
+    whole row of values in one call and collects the rows in a buffer until takeOutput().
+
+    The formats match the ones Table used in python. Strings and integers are centered in the
+    column. Floating point numbers use fixed notation when the integer part fits in the column and
+    scientific notation otherwise. When \a pretty is true, the number of decimals is limited by the
+    column width and \a max_decimals_pretty. Otherwise, numbers are written with \a max_precision
+    significant digits.
+*/
+class PYBIND11_EXPORT TableFormatter
+    {
+    public:
+    //! Constructor
+    TableFormatter(bool pretty, unsigned int max_precision, unsigned int max_decimals_pretty = 5);
+
+    //! Append a row of formatted values to the output
+    void appendRow(pybind11::sequence values,
+                   const std::vector<unsigned int>& widths,
+                   const std::string& delimiter);
+
+    //! Append a row of centered strings to the output
+    void appendHeader(const std::vector<std::string>& names,
+                      const std::vector<unsigned int>& widths,
+                      const std::string& delimiter);
+
+    //! Get the buffered output and clear the buffer
+    std::string takeOutput();
+
+    //! Format a number in a column
+    std::string formatNumber(pybind11::handle value, unsigned int width) const;
+
+    //! Format a string in a column
+    std::string formatString(const std::string& value, unsigned int width) const;
+
+    //! Get whether the output is pretty
+    bool getPretty() const
+        {
+        return m_pretty;
+        }
+
+    //! Get the maximum precision
+    unsigned int getMaxPrecision() const
+        {
+        return m_max_precision;
+        }
+
+    //! Get the maximum number of decimals in pretty output
+    unsigned int getMaxDecimalsPretty() const
+        {
+        return m_max_decimals_pretty;
+        }
+
+    private:
+    bool m_pretty;                      //!< True to limit the decimals to the column width
+    unsigned int m_max_precision;       //!< Maximum number of significant digits
+    unsigned int m_max_decimals_pretty; //!< Maximum number of decimals in pretty output
+    std::string m_output;               //!< Buffered rows
+
+    //! Format a floating point number in a column
+    std::string formatFloat(double value, unsigned int width) const;
+
+    //! Center a string in a column
+    static void center(std::string& out, const std::string& value, unsigned int width);
+    };
+
+//! Exports TableFormatter to python
+void export_TableFormatter(pybind11::module& m);
@@ -0,0 +1,234 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TagOrderedParticleData.cc
+    \brief Defines read-only views of the particle data in tag order
+*/
+
+#include "TagOrderedParticleData.h"
+
+#include <stdexcept>
+
+namespace py = pybind11;
+
+TagOrderedParticleData::TagOrderedParticleData(std::shared_ptr<ParticleData> pdata)
+    : m_pdata(pdata), m_rtag_write_count(0), m_num_order_updates(0)
+    {
+    }
+
+void TagOrderedParticleData::updateOrder()
+    {
+    const GlobalVector<unsigned int>& rtag = m_pdata->getRTags();
+    if (m_num_order_updates > 0 && m_rtag_write_count == rtag.getWriteCount())
+        return;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        throw std::runtime_error(
+            "Tag ordered particle data is not available with domain decomposition.");
+        }
+#endif
+
+    unsigned int N = m_pdata->getN();
+    m_order.resize(N);
+
+    ArrayHandle<unsigned int> h_rtag(rtag, access_location::host, access_mode::read);
+
+    // tags may have gaps after particles are removed, skip the unused ones
+    unsigned int n = 0;
+    if (N > 0)
+        {
+        unsigned int max_tag = m_pdata->getMaximumTag();
+        for (unsigned int tag = 0; tag <= max_tag && n < N; tag++)
+            {
+            unsigned int idx = h_rtag.data[tag];
+            if (idx < N)
+                m_order[n++] = idx;
+            }
+        }
+    assert(n == N);
+
+    m_rtag_write_count = rtag.getWriteCount();
+    m_num_order_updates++;
+    }
+
+template<class S, class T, class F>
+py::array TagOrderedParticleData::gather(Buffer& buffer,
+                                         const GlobalArray<T>& array,
+                                         unsigned int n_components,
+                                         F convert)
+    {
+    updateOrder();
+
+    if (buffer.valid && buffer.write_count == array.getWriteCount()
+        && buffer.order_update == m_num_order_updates)
+        {
+        return buffer.array;
+        }
+
+    size_t N = m_order.size();
+    if (!buffer.valid || size_t(buffer.array.shape(0)) != N)
+        {
+        // arrays handed out before keep their memory
+        std::vector<ssize_t> shape {ssize_t(N)};
+        if (n_components > 0)
+            shape.push_back(n_components);
+        buffer.array = py::array_t<S>(shape);
+        buffer.array.attr("flags").attr("writeable") = false;
+        }
+
+    // the array is read-only in python, write it through its data pointer
+    S* out = static_cast<S*>(const_cast<void*>(buffer.array.data()));
+    unsigned int stride = n_components > 0 ? n_components : 1;
+
+    ArrayHandle<T> h_array(array, access_location::host, access_mode::read);
+    for (size_t i = 0; i < N; i++)
+        convert(h_array.data[m_order[i]], out + i * stride);
+
+    buffer.write_count = array.getWriteCount();
+    buffer.order_update = m_num_order_updates;
+    buffer.valid = true;
+    return buffer.array;
+    }
+
+py::array TagOrderedParticleData::getPosition()
+    {
+    return gather<Scalar>(m_position,
+                          m_pdata->getPositions(),
+                          3,
+                          [](const Scalar4& v, Scalar* out)
+                          {
+                              out[0] = v.x;
+                              out[1] = v.y;
+                              out[2] = v.z;
+                          });
+    }
+
+py::array TagOrderedParticleData::getTypes()
+    {
+    return gather<unsigned int>(m_type,
+                                m_pdata->getPositions(),
+                                0,
+                                [](const Scalar4& v, unsigned int* out)
+                                { out[0] = __scalar_as_int(v.w); });
+    }
+
+py::array TagOrderedParticleData::getVelocities()
+    {
+    return gather<Scalar>(m_velocity,
+                          m_pdata->getVelocities(),
+                          3,
+                          [](const Scalar4& v, Scalar* out)
+                          {
+                              out[0] = v.x;
+                              out[1] = v.y;
+                              out[2] = v.z;
+                          });
+    }
+
+py::array TagOrderedParticleData::getMasses()
+    {
+    return gather<Scalar>(m_mass,
+                          m_pdata->getVelocities(),
+                          0,
+                          [](const Scalar4& v, Scalar* out) { out[0] = v.w; });
+    }
+
+py::array TagOrderedParticleData::getOrientation()
+    {
+    return gather<Scalar>(m_orientation,
+                          m_pdata->getOrientationArray(),
+                          4,
+                          [](const Scalar4& v, Scalar* out)
+                          {
+                              out[0] = v.x;
+                              out[1] = v.y;
+                              out[2] = v.z;
+                              out[3] = v.w;
+                          });
+    }
+
+py::array TagOrderedParticleData::getAngularMomentum()
+    {
+    return gather<Scalar>(m_angmom,
+                          m_pdata->getAngularMomentumArray(),
+                          4,
+                          [](const Scalar4& v, Scalar* out)
+                          {
+                              out[0] = v.x;
+                              out[1] = v.y;
+                              out[2] = v.z;
+                              out[3] = v.w;
+                          });
+    }
+
+py::array TagOrderedParticleData::getMomentsOfInertia()
+    {
+    return gather<Scalar>(m_inertia,
+                          m_pdata->getMomentsOfInertiaArray(),
+                          3,
+                          [](const Scalar3& v, Scalar* out)
+                          {
+                              out[0] = v.x;
+                              out[1] = v.y;
+                              out[2] = v.z;
+                          });
+    }
+
+py::array TagOrderedParticleData::getCharge()
+    {
+    return gather<Scalar>(m_charge,
+                          m_pdata->getCharges(),
+                          0,
+                          [](const Scalar& v, Scalar* out) { out[0] = v; });
+    }
+
+py::array TagOrderedParticleData::getDiameter()
+    {
+    return gather<Scalar>(m_diameter,
+                          m_pdata->getDiameters(),
+                          0,
+                          [](const Scalar& v, Scalar* out) { out[0] = v; });
+    }
+
+py::array TagOrderedParticleData::getImages()
+    {
+    return gather<int>(m_image,
+                       m_pdata->getImages(),
+                       3,
+                       [](const int3& v, int* out)
+                       {
+                           out[0] = v.x;
+                           out[1] = v.y;
+                           out[2] = v.z;
+                       });
+    }
+
+py::array TagOrderedParticleData::getBodies()
+    {
+    return gather<unsigned int>(m_body,
+                                m_pdata->getBodies(),
+                                0,
+                                [](const unsigned int& v, unsigned int* out) { out[0] = v; });
+    }
+
+void export_TagOrderedParticleData(py::module& m)
+    {
+    py::class_<TagOrderedParticleData, std::shared_ptr<TagOrderedParticleData>>(
+        m,
+        "TagOrderedParticleData")
+        .def(py::init<std::shared_ptr<ParticleData>>())
+        .def("getPosition", &TagOrderedParticleData::getPosition)
+        .def("getTypes", &TagOrderedParticleData::getTypes)
+        .def("getVelocities", &TagOrderedParticleData::getVelocities)
+        .def("getMasses", &TagOrderedParticleData::getMasses)
+        .def("getOrientation", &TagOrderedParticleData::getOrientation)
+        .def("getAngularMomentum", &TagOrderedParticleData::getAngularMomentum)
+        .def("getMomentsOfInertia", &TagOrderedParticleData::getMomentsOfInertia)
+        .def("getCharge", &TagOrderedParticleData::getCharge)
+        .def("getDiameter", &TagOrderedParticleData::getDiameter)
+        .def("getImages", &TagOrderedParticleData::getImages)
+        .def("getBodies", &TagOrderedParticleData::getBodies)
+        .def_property_readonly("num_order_updates", &TagOrderedParticleData::getNumOrderUpdates);
+    }
@@ -0,0 +1,126 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file TagOrderedParticleData.h
+    \brief Declares read-only views of the particle data in tag order
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ParticleData.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+//! Read-only views of the particle data in tag order
+/*! SnapshotParticleData copies every array, orders the copies by tag through a std::map, and
+    converts them to new numpy arrays on every call. Analysis code that reads the state often pays
+    for this on every call. TagOrderedParticleData keeps one persistent numpy array per property and
+    the local index of each particle in tag order.
+
+    The index order is rebuilt only when the reverse tag array changes, which happens when the
+    particles are sorted, added, or removed. A property array is gathered again only when either
+    the order or the source array changed since the last gather, which the write count of the
+    source array tracks. Repeated reads on the same step are therefore free, and reads of
+    properties that do not change, such as the charges, only cost a gather after a sort.
+
+    The returned arrays are read-only and are updated in place by later calls. They keep the
+    precision of the simulation. Tag order requires all particles on one rank, so domain decomposed
+    simulations are not supported.
+*/
+class PYBIND11_EXPORT TagOrderedParticleData
+    {
+    public:
+    //! Constructor
+    /*! \param pdata Particle data to view
+     */
+    TagOrderedParticleData(std::shared_ptr<ParticleData> pdata);
+
+    //! Get the positions, shape (N, 3)
+    pybind11::array getPosition();
+
+    //! Get the types, shape (N)
+    pybind11::array getTypes();
+
+    //! Get the velocities, shape (N, 3)
+    pybind11::array getVelocities();
+
+    //! Get the masses, shape (N)
+    pybind11::array getMasses();
+
+    //! Get the orientations, shape (N, 4)
+    pybind11::array getOrientation();
+
+    //! Get the angular momenta, shape (N, 4)
+    pybind11::array getAngularMomentum();
+
+    //! Get the moments of inertia, shape (N, 3)
+    pybind11::array getMomentsOfInertia();
+
+    //! Get the charges, shape (N)
+    pybind11::array getCharge();
+
+    //! Get the diameters, shape (N)
+    pybind11::array getDiameter();
+
+    //! Get the images, shape (N, 3)
+    pybind11::array getImages();
+
+    //! Get the rigid body ids, shape (N)
+    pybind11::array getBodies();
+
+    //! Get the number of times the tag order was rebuilt
+    uint64_t getNumOrderUpdates() const
+        {
+        return m_num_order_updates;
+        }
+
+    private:
+    //! A persistent output array
+    struct Buffer
+        {
+        pybind11::array array;     //!< Data in tag order
+        uint64_t write_count = 0;  //!< Write count of the source array at the last gather
+        uint64_t order_update = 0; //!< Order the data was gathered with
+        bool valid = false;        //!< True once the data has been gathered
+        };
+
+    std::shared_ptr<ParticleData> m_pdata; //!< Particle data to view
+    std::vector<unsigned int> m_order;     //!< Local index of each particle in tag order
+    uint64_t m_rtag_write_count;           //!< Write count of the reverse tags for m_order
+    uint64_t m_num_order_updates;          //!< Number of times m_order was built
+
+    Buffer m_position;    //!< Positions
+    Buffer m_type;        //!< Types
+    Buffer m_velocity;    //!< Velocities
+    Buffer m_mass;        //!< Masses
+    Buffer m_orientation; //!< Orientations
+    Buffer m_angmom;      //!< Angular momenta
+    Buffer m_inertia;     //!< Moments of inertia
+    Buffer m_charge;      //!< Charges
+    Buffer m_diameter;    //!< Diameters
+    Buffer m_image;       //!< Images
+    Buffer m_body;        //!< Rigid body ids
+
+    //! Rebuild the tag order when the reverse tags changed
+    void updateOrder();
+
+    //! Gather a property into its buffer in tag order
+    /*! \param buffer Output buffer
+        \param array Source array in local index order
+        \param n_components Number of values per particle, 0 for a 1D output array
+        \param convert Writes the values of one particle from its source element
+    */
+    template<class S, class T, class F>
+    pybind11::array
+    gather(Buffer& buffer, const GlobalArray<T>& array, unsigned int n_components, F convert);
+    };
+
+//! Export TagOrderedParticleData to python
+void export_TagOrderedParticleData(pybind11::module& m);
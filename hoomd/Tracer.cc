@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file Tracer.cc
+    \brief Defines the Tracer class
+*/
+
+#include "Tracer.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+//! Escape a string for use in a JSON string literal
+static string json_escape(const string& s)
+    {
+    ostringstream o;
+    for (char c : s)
+        {
+        if (c == '"' || c == '\\')
+            o << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            o << "\\u" << hex << setw(4) << setfill('0') << int(c) << dec;
+        else
+            o << c;
+        }
+    return o.str();
+    }
+
+/*! \param rank Rank to use as the process id
+    \returns The events and track name metadata as JSON objects separated by commas
+*/
+string Tracer::getEventsJSON(unsigned int rank) const
+    {
+    ostringstream o;
+    o << setiosflags(ios::fixed) << setprecision(3);
+
+    // name the process and each track that has events
+    o << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+      << ",\"args\":{\"name\":\"Rank " << rank << "\"}}";
+
+    set<unsigned int> tracks;
+    for (const auto& event : m_events)
+        tracks.insert(event.track);
+
+    for (unsigned int track : tracks)
+        {
+        string track_name = track == cpu_track ? string("CPU")
+                                               : "GPU " + to_string(track - gpu_track) + " stream";
+        o << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":" << track
+          << ",\"args\":{\"name\":\"" << track_name << "\"}}";
+        }
+
+    // trace event times are in microseconds
+    for (const auto& event : m_events)
+        {
+        o << ",\n{\"name\":\"" << json_escape(event.name) << "\",\"ph\":\"X\",\"pid\":" << rank
+          << ",\"tid\":" << event.track << ",\"ts\":" << double(event.start) / 1e3
+          << ",\"dur\":" << double(event.duration) / 1e3 << "}";
+        }
+
+    return o.str();
+    }
+
+/*! \param filename File to write
+    \param mpi_conf MPI configuration
+
+    Collective call. The root rank gathers the events from all ranks and writes the file.
+*/
+void Tracer::write(const std::string& filename, std::shared_ptr<MPIConfiguration> mpi_conf) const
+    {
+    vector<string> rank_events;
+    string events = getEventsJSON(mpi_conf->getRank());
+
+#ifdef ENABLE_MPI
+    gather_v(events, rank_events, 0, mpi_conf->getCommunicator());
+#else
+    rank_events.push_back(events);
+#endif
+
+    if (!mpi_conf->isRoot())
+        return;
+
+    ofstream f(filename.c_str());
+    if (!f.good())
+        throw runtime_error("Error opening trace file " + filename);
+
+    f << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t i = 0; i < rank_events.size(); i++)
+        {
+        if (i > 0)
+            f << ",\n";
+        f << rank_events[i];
+        }
+    f << "\n]}\n";
+
+    if (!f.good())
+        throw runtime_error("Error writing trace file " + filename);
+    }
@@ -0,0 +1,121 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file Tracer.h
+    \brief Declares a class that records a timeline of events
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ClockSource.h"
+#include "MPIConfiguration.h"
+
+#include <stack>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+//! Records a timeline of nested regions for display in a trace viewer
+/*! Tracer stores complete events (name, track, start time, and duration) in memory and writes
+    them in the Chrome trace event JSON format, which chrome://tracing and https://ui.perfetto.dev
+    can display. Each MPI rank is a process in the trace and each track (the CPU thread and the
+    GPU streams) is a thread of that process.
+
+    begin() and end() record nested regions on the CPU track. addEvent() records an event with an
+    explicit time and duration on any track, e.g. measured with GPU events.
+
+    ExecutionConfiguration owns the active Tracer (see ExecutionConfiguration::setTracing()). Code
+    that records events checks ExecutionConfiguration::getTracer() for null first, so there is no
+    overhead beyond that check when tracing is off. Profiler forwards its push() and pop() calls to
+    the tracer given to Profiler::setTracer(), so all profiled regions appear in the timeline.
+
+    Times are measured from the construction of the Tracer on each rank. Construct it at the same
+    point on all ranks (i.e. collectively) to align the timelines.
+*/
+class PYBIND11_EXPORT Tracer
+    {
+    public:
+    //! Track id of the CPU thread
+    static const unsigned int cpu_track = 0;
+
+    //! Track id of the default stream of the first GPU
+    static const unsigned int gpu_track = 1;
+
+    //! Begin a region on the CPU track
+    void begin(const std::string& name)
+        {
+        m_stack.push(std::make_pair(name, m_clk.getTime()));
+        }
+
+    //! End the most recently begun region
+    void end()
+        {
+        if (m_stack.empty())
+            return;
+
+        int64_t t = m_clk.getTime();
+        addEvent(m_stack.top().first, cpu_track, m_stack.top().second, t - m_stack.top().second);
+        m_stack.pop();
+        }
+
+    //! Add an event
+    /*! \param name Name of the event
+        \param track Track to place the event on
+        \param start Start time in nanoseconds (see getTime())
+        \param duration Duration in nanoseconds
+    */
+    void addEvent(const std::string& name, unsigned int track, int64_t start, int64_t duration)
+        {
+        m_events.push_back(Event {name, track, start, duration});
+        }
+
+    //! Add an event that ends now
+    void addEventEndingNow(const std::string& name, unsigned int track, int64_t duration)
+        {
+        addEvent(name, track, m_clk.getTime() - duration, duration);
+        }
+
+    //! Add an event that ends now on the GPU track named after the innermost open region
+    void addDeviceEvent(int64_t duration)
+        {
+        if (!m_stack.empty())
+            addEventEndingNow(m_stack.top().first, gpu_track, duration);
+        }
+
+    //! Get the current time in nanoseconds since the tracer started
+    int64_t getTime() const
+        {
+        return m_clk.getTime();
+        }
+
+    //! Get the number of recorded events
+    size_t getNumEvents() const
+        {
+        return m_events.size();
+        }
+
+    //! Write the trace of all ranks to a file
+    void write(const std::string& filename, std::shared_ptr<MPIConfiguration> mpi_conf) const;
+
+    private:
+    //! A complete event
+    struct Event
+        {
+        std::string name;
+        unsigned int track;
+        int64_t start;
+        int64_t duration;
+        };
+
+    ClockSource m_clk;                                   //!< Time source
+    std::vector<Event> m_events;                         //!< Recorded events
+    std::stack<std::pair<std::string, int64_t>> m_stack; //!< Open regions and their start times
+
+    //! Get the events of this rank as comma separated JSON objects
+    std::string getEventsJSON(unsigned int rank) const;
+    };
@@ -5,12 +5,20 @@
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 
+constexpr uint64_t Trigger::never;
+
 //* Method to enable unit testing of C++ trigger calls from pytest
 bool testTriggerCall(std::shared_ptr<Trigger> t, uint64_t step)
     {
     return (*t)(step);
     }
 
+//* Method to enable unit testing of C++ trigger nextStep calls from pytest
+uint64_t testTriggerNextStep(std::shared_ptr<Trigger> t, uint64_t step)
+    {
+    return t->nextStep(step);
+    }
+
 //* Trampoline for classes inherited in python
 class TriggerPy : public Trigger
     {
@@ -27,6 +35,17 @@ class TriggerPy : public Trigger
                                timestep // Argument(s)
         );
         }
+
+    // trampoline method, triggers defined in python are evaluated on every step by default
+    uint64_t nextStep(uint64_t timestep) override
+        {
+        PYBIND11_OVERLOAD_NAME(uint64_t,    // Return type
+                               Trigger,     // Parent class
+                               "next_step", // name of function in python
+                               nextStep,    // Name of function in C++
+                               timestep     // Argument(s)
+        );
+        }
     };
 
 void export_Trigger(pybind11::module& m)
@@ -34,7 +53,9 @@ void export_Trigger(pybind11::module& m)
     pybind11::class_<Trigger, TriggerPy, std::shared_ptr<Trigger>>(m, "Trigger")
         .def(pybind11::init<>())
         .def("__call__", &Trigger::operator())
-        .def("compute", &Trigger::compute);
+        .def("compute", &Trigger::compute)
+        .def("next_step", &Trigger::nextStep)
+        .def_property_readonly_static("never", [](pybind11::object) { return Trigger::never; });
 
     pybind11::class_<PeriodicTrigger, Trigger, std::shared_ptr<PeriodicTrigger>>(m,
                                                                                  "PeriodicTrigger")
@@ -80,5 +101,20 @@ void export_Trigger(pybind11::module& m)
     pybind11::class_<OrTrigger, Trigger, std::shared_ptr<OrTrigger>>(m, "OrTrigger")
         .def(pybind11::init<pybind11::object>(), pybind11::arg("triggers"));
 
+    pybind11::class_<ScheduleTrigger, Trigger, std::shared_ptr<ScheduleTrigger>>(m,
+                                                                                 "ScheduleTrigger")
+        .def(pybind11::init<const std::vector<std::pair<uint64_t, uint64_t>>&>(),
+             pybind11::arg("stages"))
+        .def_property_readonly("stages", &ScheduleTrigger::getStages)
+        .def(pybind11::pickle(
+            [](const ScheduleTrigger& trigger)
+            { return pybind11::make_tuple(trigger.getStages()); },
+            [](pybind11::tuple params)
+            {
+                return ScheduleTrigger(
+                    params[0].cast<std::vector<std::pair<uint64_t, uint64_t>>>());
+            }));
+
     m.def("_test_trigger_call", &testTriggerCall);
+    m.def("_test_trigger_next_step", &testTriggerNextStep);
     }
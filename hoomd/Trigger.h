@@ -5,10 +5,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <pybind11/iostream.h>
 #include <pybind11/pybind11.h>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 /** Defines on what time steps operations should be performed
@@ -48,6 +50,24 @@ class PYBIND11_EXPORT Trigger
 
     virtual bool compute(uint64_t timestep) = 0;
 
+    /** Find the first time step at which the trigger may be active
+     *
+     *  @param timestep First time step to consider
+     *  @returns A step `n >= timestep` such that the trigger is not active on any step in
+     *           `[timestep, n)`, or `never` when the trigger is never active again.
+     *
+     *  System uses nextStep() to skip evaluating triggers on steps where they cannot be active. The
+     *  trigger is still evaluated on the returned step, so it may be a lower bound. The default
+     *  returns `timestep`, which evaluates the trigger on every step.
+     */
+    virtual uint64_t nextStep(uint64_t timestep)
+        {
+        return timestep;
+        }
+
+    /// Value returned by nextStep() when the trigger is never active again
+    static constexpr uint64_t never = std::numeric_limits<uint64_t>::max();
+
     private:
     /// Caches the last time step at which the trigger was computed
     uint64_t m_last_timestep;
@@ -81,6 +101,21 @@ class PYBIND11_EXPORT PeriodicTrigger : public Trigger
         return (timestep - m_phase) % m_period == 0;
         }
 
+    uint64_t nextStep(uint64_t timestep)
+        {
+        const uint64_t remainder = (timestep - m_phase) % m_period;
+        if (remainder == 0)
+            return timestep;
+
+        const uint64_t next = timestep + (m_period - remainder);
+        if (timestep < m_phase && next > m_phase)
+            {
+            // (timestep - m_phase) wrapped around, so the first step is the phase itself
+            return m_phase;
+            }
+        return (next < timestep) ? never : next;
+        }
+
     /// Set the period
     void setPeriod(uint64_t period)
         {
@@ -126,6 +161,11 @@ class PYBIND11_EXPORT BeforeTrigger : public Trigger
         return timestep < m_timestep;
         }
 
+    uint64_t nextStep(uint64_t timestep)
+        {
+        return (timestep < m_timestep) ? timestep : never;
+        }
+
     /// Get the timestep before which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -158,6 +198,11 @@ class PYBIND11_EXPORT OnTrigger : public Trigger
         return timestep == m_timestep;
         }
 
+    uint64_t nextStep(uint64_t timestep)
+        {
+        return (timestep <= m_timestep) ? m_timestep : never;
+        }
+
     /// Get the timestep when the trigger is active.
     uint64_t getTimestep() const
         {
@@ -190,6 +235,13 @@ class PYBIND11_EXPORT AfterTrigger : public Trigger
         return timestep > m_timestep;
         }
 
+    uint64_t nextStep(uint64_t timestep)
+        {
+        if (timestep > m_timestep)
+            return timestep;
+        return (m_timestep == never) ? never : m_timestep + 1;
+        }
+
     /// Get the timestep after which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -264,6 +316,17 @@ class PYBIND11_EXPORT AndTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// All triggers must be active, so none of the steps before the latest nextStep() can be
+    uint64_t nextStep(uint64_t timestep)
+        {
+        uint64_t next = timestep;
+        for (auto& t : m_triggers)
+            {
+            next = std::max(next, t->nextStep(timestep));
+            }
+        return next;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
@@ -300,6 +363,17 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// Any trigger may be active, so the earliest nextStep() is the first candidate
+    uint64_t nextStep(uint64_t timestep)
+        {
+        uint64_t next = never;
+        for (auto& t : m_triggers)
+            {
+            next = std::min(next, t->nextStep(timestep));
+            }
+        return next;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
@@ -310,5 +384,111 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
     std::vector<std::shared_ptr<Trigger>> m_triggers;
     };
 
+/** Schedule trigger
+ *
+ *  Trigger periodically with a period that changes in stages. Each stage (t_i, period_i) begins on
+ *  step t_i and triggers every period_i steps from t_i until the next stage begins. A stage with a
+ *  period of 0 never triggers. The trigger is not active before the first stage. One
+ *  ScheduleTrigger replaces an Or of And(After, Before, Periodic) triggers and evaluates in C++.
+ */
+class PYBIND11_EXPORT ScheduleTrigger : public Trigger
+    {
+    public:
+    /** Construct a ScheduleTrigger
+     *
+     *  @param stages The (first step, period) pairs in increasing order of first step
+     */
+    ScheduleTrigger(const std::vector<std::pair<uint64_t, uint64_t>>& stages) : Trigger()
+        {
+        if (stages.empty())
+            {
+            throw std::invalid_argument("stages must not be empty");
+            }
+        for (size_t i = 1; i < stages.size(); i++)
+            {
+            if (stages[i].first <= stages[i - 1].first)
+                {
+                throw std::invalid_argument("The first steps of stages must increase");
+                }
+            }
+        m_stages = stages;
+        }
+
+    bool compute(uint64_t timestep)
+        {
+        size_t i = findStage(timestep);
+        if (i == m_stages.size())
+            return false;
+
+        const uint64_t period = m_stages[i].second;
+        return period != 0 && (timestep - m_stages[i].first) % period == 0;
+        }
+
+    uint64_t nextStep(uint64_t timestep)
+        {
+        size_t i = findStage(timestep);
+        if (i == m_stages.size())
+            {
+            i = 0;
+            timestep = m_stages[0].first;
+            }
+
+        for (; i < m_stages.size(); i++)
+            {
+            const uint64_t start = m_stages[i].first;
+            const uint64_t period = m_stages[i].second;
+            const uint64_t end = (i + 1 < m_stages.size()) ? m_stages[i + 1].first : never;
+            timestep = std::max(timestep, start);
+
+            if (period != 0)
+                {
+                const uint64_t remainder = (timestep - start) % period;
+                const uint64_t next = remainder == 0 ? timestep : timestep + (period - remainder);
+                if (next >= timestep && next < end)
+                    return next;
+                }
+            }
+        return never;
+        }
+
+    /// Get the stages
+    const std::vector<std::pair<uint64_t, uint64_t>>& getStages() const
+        {
+        return m_stages;
+        }
+
+    protected:
+    /// The (first step, period) pairs
+    std::vector<std::pair<uint64_t, uint64_t>> m_stages;
+
+    /// Index of the stage that contains the last queried step
+    size_t m_stage = 0;
+
+    /** Find the stage that contains a step
+     *
+     *  @param timestep Time step to query
+     *  @returns The index of the stage, or the number of stages when `timestep` is before the first
+     *
+     *  Successive queries usually fall in the same stage, so the search starts from the last one.
+     */
+    size_t findStage(uint64_t timestep)
+        {
+        if (timestep < m_stages[0].first)
+            return m_stages.size();
+
+        if (timestep < m_stages[m_stage].first
+            || (m_stage + 1 < m_stages.size() && timestep >= m_stages[m_stage + 1].first))
+            {
+            auto next = std::upper_bound(m_stages.begin(),
+                                         m_stages.end(),
+                                         timestep,
+                                         [](uint64_t t, const std::pair<uint64_t, uint64_t>& s)
+                                         { return t < s.first; });
+            m_stage = (next - m_stages.begin()) - 1;
+            }
+        return m_stage;
+        }
+    };
+
 /// Export Trigger classes to Python
 void export_Trigger(pybind11::module& m);
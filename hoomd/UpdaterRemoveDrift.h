@@ -34,7 +34,7 @@ class UpdaterRemoveDrift : public Updater
         }
 
     //! Set reference positions from a (N_particles, 3) numpy array
-    void setReferencePositions(const pybind11::array_t<double> ref_pos)
+    virtual void setReferencePositions(const pybind11::array_t<double> ref_pos)
         {
         if (ref_pos.ndim() != 2)
             {
@@ -85,16 +85,40 @@ class UpdaterRemoveDrift : public Updater
 
     //! Take one timestep forward
     virtual void update(uint64_t timestep)
+        {
+        vec3<Scalar> rshift = sumDisplacements();
+
+#ifdef ENABLE_MPI
+        if (this->m_pdata->getDomainDecomposition())
+            {
+            Scalar r[3] = {rshift.x, rshift.y, rshift.z};
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &r[0],
+                          3,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            rshift.x = r[0];
+            rshift.y = r[1];
+            rshift.z = r[2];
+            }
+#endif
+
+        rshift /= Scalar(this->m_pdata->getNGlobal());
+
+        shiftParticles(rshift);
+        }
+
+    protected:
+    //! Sum the minimum image displacements of the local particles from their reference positions
+    virtual vec3<Scalar> sumDisplacements()
         {
         ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
                                        access_location::host,
-                                       access_mode::readwrite);
+                                       access_mode::read);
         ArrayHandle<unsigned int> h_tag(this->m_pdata->getTags(),
                                         access_location::host,
                                         access_mode::read);
-        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
-                                  access_location::host,
-                                  access_mode::readwrite);
         const BoxDim& box = this->m_pdata->getGlobalBox();
         const vec3<Scalar> origin(this->m_pdata->getOrigin());
         vec3<Scalar> rshift;
@@ -111,23 +135,19 @@ class UpdaterRemoveDrift : public Updater
             rshift += vec3<Scalar>(box.minImage(vec_to_scalar3(dr)));
             }
 
-#ifdef ENABLE_MPI
-        if (this->m_pdata->getDomainDecomposition())
-            {
-            Scalar r[3] = {rshift.x, rshift.y, rshift.z};
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &r[0],
-                          3,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            rshift.x = r[0];
-            rshift.y = r[1];
-            rshift.z = r[2];
-            }
-#endif
+        return rshift;
+        }
 
-        rshift /= Scalar(this->m_pdata->getNGlobal());
+    //! Subtract the mean drift from the local particles and wrap them back into the box
+    virtual void shiftParticles(const vec3<Scalar>& rshift)
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        const BoxDim& box = this->m_pdata->getGlobalBox();
 
         for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
             {
@@ -139,7 +159,6 @@ class UpdaterRemoveDrift : public Updater
             }
         }
 
-    protected:
     std::vector<vec3<Scalar>> m_ref_positions;
     };
 
@@ -0,0 +1,146 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "UpdaterRemoveDriftGPU.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/transform_reduce.h>
+#pragma GCC diagnostic pop
+
+/*! \file UpdaterRemoveDriftGPU.cu
+    \brief Defines the GPU kernels used by UpdaterRemoveDriftGPU
+*/
+
+namespace kernel
+    {
+//! Minimum image displacement of one particle from its reference position
+struct particle_displacement
+    {
+    particle_displacement(const Scalar4* _d_pos,
+                          const unsigned int* _d_tag,
+                          const Scalar3* _d_ref_pos,
+                          const Scalar3 _origin,
+                          const BoxDim& _box)
+        : d_pos(_d_pos), d_tag(_d_tag), d_ref_pos(_d_ref_pos), origin(_origin), box(_box)
+        {
+        }
+
+    __device__ Scalar3 operator()(unsigned int idx) const
+        {
+        const Scalar4 postype = d_pos[idx];
+        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z) - origin;
+        int3 tmp_image = make_int3(0, 0, 0);
+        box.wrap(pos, tmp_image);
+        return box.minImage(pos - d_ref_pos[d_tag[idx]]);
+        }
+
+    const Scalar4* d_pos;
+    const unsigned int* d_tag;
+    const Scalar3* d_ref_pos;
+    const Scalar3 origin;
+    const BoxDim box;
+    };
+
+//! Kernel to subtract the drift and wrap the particles back into the box
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param rshift Drift to subtract
+    \param box Global simulation box
+*/
+__global__ void gpu_remove_drift_shift_kernel(const unsigned int N,
+                                              Scalar4* d_pos,
+                                              int3* d_image,
+                                              const Scalar3 rshift,
+                                              const BoxDim box)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    int3 image = d_image[idx];
+    postype.x -= rshift.x;
+    postype.y -= rshift.y;
+    postype.z -= rshift.z;
+    box.wrap(postype, image);
+    d_pos[idx] = postype;
+    d_image[idx] = image;
+    }
+    } // end namespace kernel
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param d_ref_pos Reference positions by tag
+    \param origin Origin of the global box
+    \param box Global simulation box
+    \param alloc Caching allocator for temporary storage
+    \returns The sum of the displacements
+*/
+Scalar3 gpu_remove_drift_sum(const unsigned int N,
+                             const Scalar4* d_pos,
+                             const unsigned int* d_tag,
+                             const Scalar3* d_ref_pos,
+                             const Scalar3 origin,
+                             const BoxDim& box,
+                             CachedAllocator& alloc)
+    {
+    if (N == 0)
+        return make_scalar3(0, 0, 0);
+
+    return thrust::transform_reduce(
+#ifdef __HIP_PLATFORM_HCC__
+        thrust::hip::par(alloc),
+#else
+        thrust::cuda::par(alloc),
+#endif
+        thrust::counting_iterator<unsigned int>(0),
+        thrust::counting_iterator<unsigned int>(N),
+        kernel::particle_displacement(d_pos, d_tag, d_ref_pos, origin, box),
+        make_scalar3(0, 0, 0),
+        thrust::plus<Scalar3>());
+    }
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param rshift Drift to subtract
+    \param box Global simulation box
+    \param block_size Block size to execute
+*/
+hipError_t gpu_remove_drift_shift(const unsigned int N,
+                                  Scalar4* d_pos,
+                                  int3* d_image,
+                                  const Scalar3 rshift,
+                                  const BoxDim& box,
+                                  const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)kernel::gpu_remove_drift_shift_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1);
+
+    hipLaunchKernelGGL((kernel::gpu_remove_drift_shift_kernel),
+                       dim3(grid),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_pos,
+                       d_image,
+                       rshift,
+                       box);
+
+    return hipSuccess;
+    }
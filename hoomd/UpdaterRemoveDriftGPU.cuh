@@ -0,0 +1,34 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_CUH_
+#define _REMOVE_DRIFT_UPDATER_GPU_CUH_
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/CachedAllocator.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file UpdaterRemoveDriftGPU.cuh
+    \brief Declares the GPU kernel drivers used by UpdaterRemoveDriftGPU
+*/
+
+//! Sum the minimum image displacements of the local particles from their reference positions
+Scalar3 gpu_remove_drift_sum(const unsigned int N,
+                             const Scalar4* d_pos,
+                             const unsigned int* d_tag,
+                             const Scalar3* d_ref_pos,
+                             const Scalar3 origin,
+                             const BoxDim& box,
+                             CachedAllocator& alloc);
+
+//! Subtract the drift from the local particles and wrap them back into the box
+hipError_t gpu_remove_drift_shift(const unsigned int N,
+                                  Scalar4* d_pos,
+                                  int3* d_image,
+                                  const Scalar3 rshift,
+                                  const BoxDim& box,
+                                  const unsigned int block_size);
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_CUH_
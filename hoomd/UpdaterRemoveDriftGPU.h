@@ -0,0 +1,150 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.h
+    \brief Declares the GPU implementation of UpdaterRemoveDrift
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+// inclusion guard
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_H_
+#define _REMOVE_DRIFT_UPDATER_GPU_H_
+
+#ifdef ENABLE_HIP
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUArray.h"
+#include "hoomd/UpdaterRemoveDrift.h"
+#include "hoomd/UpdaterRemoveDriftGPU.cuh"
+
+#include <pybind11/pybind11.h>
+
+/** Removes the average particle drift on the GPU. The reference positions are mirrored in a device
+ * array indexed by tag, so only the summed displacement is copied to the host.
+ */
+class UpdaterRemoveDriftGPU : public UpdaterRemoveDrift
+    {
+    public:
+    //! Constructor
+    UpdaterRemoveDriftGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          pybind11::array_t<double> ref_positions)
+        : UpdaterRemoveDrift(sysdef, ref_positions)
+        {
+        if (!m_exec_conf->isCUDAEnabled())
+            {
+            throw std::runtime_error("Cannot initialize UpdaterRemoveDriftGPU on a CPU device.");
+            }
+
+        copyReferencePositions();
+
+        // initialize autotuner
+        std::vector<unsigned int> valid_params;
+        unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+        for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+            valid_params.push_back(block_size);
+
+        m_tuner.reset(new Autotuner(valid_params, 5, 100000, "remove_drift", this->m_exec_conf));
+        }
+
+    //! Set reference positions from a (N_particles, 3) numpy array
+    virtual void setReferencePositions(const pybind11::array_t<double> ref_pos)
+        {
+        UpdaterRemoveDrift::setReferencePositions(ref_pos);
+        copyReferencePositions();
+        }
+
+    //! Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        UpdaterRemoveDrift::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    //! Sum the minimum image displacements of the local particles on the GPU
+    virtual vec3<Scalar> sumDisplacements()
+        {
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar3> d_ref_positions(m_d_ref_positions,
+                                             access_location::device,
+                                             access_mode::read);
+
+        Scalar3 rshift = gpu_remove_drift_sum(this->m_pdata->getN(),
+                                              d_postype.data,
+                                              d_tag.data,
+                                              d_ref_positions.data,
+                                              this->m_pdata->getOrigin(),
+                                              this->m_pdata->getGlobalBox(),
+                                              m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        return vec3<Scalar>(rshift);
+        }
+
+    //! Subtract the mean drift on the GPU
+    virtual void shiftParticles(const vec3<Scalar>& rshift)
+        {
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+        ArrayHandle<int3> d_image(this->m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+
+        m_tuner->begin();
+        gpu_remove_drift_shift(this->m_pdata->getN(),
+                               d_postype.data,
+                               d_image.data,
+                               vec_to_scalar3(rshift),
+                               this->m_pdata->getGlobalBox(),
+                               m_tuner->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
+
+    private:
+    GPUArray<Scalar3> m_d_ref_positions; //!< Reference positions by tag
+    std::unique_ptr<Autotuner> m_tuner;  //!< Autotuner for block size
+
+    //! Copy the reference positions to the device array
+    void copyReferencePositions()
+        {
+        GPUArray<Scalar3> ref_positions(m_ref_positions.size(), m_exec_conf);
+        m_d_ref_positions.swap(ref_positions);
+
+        ArrayHandle<Scalar3> h_ref_positions(m_d_ref_positions,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        for (size_t i = 0; i < m_ref_positions.size(); i++)
+            {
+            h_ref_positions.data[i] = vec_to_scalar3(m_ref_positions[i]);
+            }
+        }
+    };
+
+/// Export the UpdaterRemoveDriftGPU to python
+void export_UpdaterRemoveDriftGPU(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterRemoveDriftGPU,
+                     UpdaterRemoveDrift,
+                     std::shared_ptr<UpdaterRemoveDriftGPU>>(m, "UpdaterRemoveDriftGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, pybind11::array_t<double>>())
+        .def_property("reference_positions",
+                      &UpdaterRemoveDriftGPU::getReferencePositions,
+                      &UpdaterRemoveDriftGPU::setReferencePositions);
+    }
+
+#endif // ENABLE_HIP
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_H_
@@ -2,6 +2,7 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "Variant.h"
+#include <pybind11/stl.h>
 
 // These testVariant{Method} functions allow us to test that Python custom
 // variants work properly in C++. This ensures we can test that the function
@@ -174,6 +175,23 @@ void export_Variant(pybind11::module& m)
                                     params[4].cast<uint64_t>());
             }));
 
+    pybind11::class_<VariantPiecewiseLinear, Variant, std::shared_ptr<VariantPiecewiseLinear>>(
+        m,
+        "VariantPiecewiseLinear")
+        .def(pybind11::init<const std::vector<std::pair<uint64_t, Scalar>>&>(),
+             pybind11::arg("points"))
+        .def_property("points",
+                      &VariantPiecewiseLinear::getPoints,
+                      &VariantPiecewiseLinear::setPoints)
+        .def(pybind11::pickle(
+            [](const VariantPiecewiseLinear& variant)
+            { return pybind11::make_tuple(variant.getPoints()); },
+            [](pybind11::tuple params)
+            {
+                return VariantPiecewiseLinear(
+                    params[0].cast<std::vector<std::pair<uint64_t, Scalar>>>());
+            }));
+
     m.def("_test_variant_call", &testVariantCall);
     m.def("_test_variant_min", &testVariantMin);
     m.def("_test_variant_max", &testVariantMax);
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "HOOMDMath.h"
 
@@ -591,5 +594,107 @@ class PYBIND11_EXPORT VariantPower : public Variant
     double m_inv_end;
     };
 
+/** Piecewise linear variant
+
+    Variant that interpolates linearly between the points (t_i, v_i). It holds v_0 before t_0 and
+    the last value after the last point. Schedules with many stages evaluate in C++ without calling
+    back to Python. Consecutive calls usually fall in the same segment, so the variant remembers
+    the last segment and only searches the points when the time step leaves it.
+*/
+class PYBIND11_EXPORT VariantPiecewiseLinear : public Variant
+    {
+    public:
+    /** Construct a VariantPiecewiseLinear.
+
+        @param points The (time step, value) pairs in increasing order of time step.
+    */
+    VariantPiecewiseLinear(const std::vector<std::pair<uint64_t, Scalar>>& points)
+        {
+        setPoints(points);
+        }
+
+    /// Evaluate the variant.
+    Scalar operator()(uint64_t timestep)
+        {
+        if (timestep <= m_points.front().first)
+            {
+            return m_points.front().second;
+            }
+        if (timestep >= m_points.back().first)
+            {
+            return m_points.back().second;
+            }
+
+        // find the segment [t_i, t_i+1) that contains timestep
+        if (timestep < m_points[m_segment].first || timestep >= m_points[m_segment + 1].first)
+            {
+            auto next = std::upper_bound(m_points.begin(),
+                                         m_points.end(),
+                                         timestep,
+                                         [](uint64_t t, const std::pair<uint64_t, Scalar>& p)
+                                         { return t < p.first; });
+            m_segment = (next - m_points.begin()) - 1;
+            }
+
+        const auto& a = m_points[m_segment];
+        const auto& b = m_points[m_segment + 1];
+        double s = double(timestep - a.first) / double(b.first - a.first);
+        return b.second * s + a.second * (1.0 - s);
+        }
+
+    /// Set the points.
+    void setPoints(const std::vector<std::pair<uint64_t, Scalar>>& points)
+        {
+        if (points.empty())
+            {
+            throw std::invalid_argument("points must not be empty");
+            }
+        for (size_t i = 1; i < points.size(); i++)
+            {
+            if (points[i].first <= points[i - 1].first)
+                {
+                throw std::invalid_argument("The time steps of points must increase");
+                }
+            }
+        m_points = points;
+        m_segment = 0;
+        }
+
+    /// Get the points.
+    const std::vector<std::pair<uint64_t, Scalar>>& getPoints() const
+        {
+        return m_points;
+        }
+
+    /// Return min
+    Scalar min()
+        {
+        return std::min_element(m_points.begin(),
+                                m_points.end(),
+                                [](const std::pair<uint64_t, Scalar>& a,
+                                   const std::pair<uint64_t, Scalar>& b)
+                                { return a.second < b.second; })
+            ->second;
+        }
+
+    /// Return max
+    Scalar max()
+        {
+        return std::max_element(m_points.begin(),
+                                m_points.end(),
+                                [](const std::pair<uint64_t, Scalar>& a,
+                                   const std::pair<uint64_t, Scalar>& b)
+                                { return a.second < b.second; })
+            ->second;
+        }
+
+    protected:
+    /// The (time step, value) pairs.
+    std::vector<std::pair<uint64_t, Scalar>> m_points;
+
+    /// Index of the first point of the last evaluated segment.
+    size_t m_segment = 0;
+    };
+
 /// Export Variant classes to Python
 void export_Variant(pybind11::module& m);
@@ -6,10 +6,14 @@
 
 :py:mod:`hoomd` provides a high level user interface for defining and executing
 simulations using HOOMD.
+
+The components `hoomd.md`, `hoomd.hpmc`, and `hoomd.dem` and their extension
+modules load when first accessed.
 """
 import sys
 import pathlib
 import os
+import importlib
 
 if ((pathlib.Path(__file__).parent / 'CMakeLists.txt').exists()
         and 'SPHINX' not in os.environ):
@@ -40,12 +44,32 @@ from hoomd import communicator
 from hoomd import util
 from hoomd import write
 from hoomd import _hoomd
-if version.md_built:
-    from hoomd import md
-if version.hpmc_built:
-    from hoomd import hpmc
-if version.dem_built and version.md_built:
-    from hoomd import dem
+from hoomd import _import
+
+_import._install_extension_finder()
+
+# components that are imported on first access
+_lazy_components = {
+    'md': version.md_built,
+    'hpmc': version.hpmc_built,
+    'dem': version.dem_built and version.md_built,
+}
+
+
+def __getattr__(name):
+    """Import components on first access."""
+    if _lazy_components.get(name, False):
+        return importlib.import_module('hoomd.' + name)
+    raise AttributeError(f"module 'hoomd' has no attribute {name!r}")
+
+
+def __dir__():
+    """List the attributes, including components not yet imported."""
+    return sorted(
+        set(globals())
+        | {name for name, built in _lazy_components.items() if built})
+
+
 # if version.metal_built:
 #     from hoomd import metal
 # if version.mpcd_built:
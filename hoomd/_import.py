@@ -0,0 +1,90 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Load HOOMD extension modules from node local copies.
+
+When the environment variable ``HOOMD_EXTENSION_BCAST_DIR`` names a node local
+directory (such as ``/tmp``), rank 0 locates and reads the shared object of
+each HOOMD extension module (``hoomd.md._md``, ``hoomd.hpmc._hpmc``, and those
+of plugins) and broadcasts it to the other ranks. Every rank writes the shared
+object into the directory and loads it from there, so only one rank reads the
+extension modules from the (possibly slow) shared file system.
+
+Every rank in the current communicator must import the same extension modules
+in the same order. This is the case when all ranks run the same script.
+"""
+
+import hashlib
+import importlib.machinery
+import importlib.util
+import os
+import sys
+
+from hoomd import _hoomd
+import hoomd.communicator
+
+_ENVIRONMENT_VARIABLE = 'HOOMD_EXTENSION_BCAST_DIR'
+
+
+class _BroadcastExtensionFinder:
+    """Find HOOMD extension modules on rank 0 and broadcast them."""
+
+    def __init__(self, directory):
+        self._directory = directory
+
+    def find_spec(self, fullname, path, target=None):
+        """Locate the extension module ``fullname``."""
+        parts = fullname.split('.')
+        if (len(parts) < 3 or parts[0] != 'hoomd'
+                or not parts[-1].startswith('_')):
+            return None
+
+        mpi_conf = hoomd.communicator._current_communicator.cpp_mpi_conf
+        if mpi_conf.getNRanks() == 1:
+            return None
+
+        data = b''
+        if mpi_conf.getRank() == 0:
+            spec = importlib.machinery.PathFinder.find_spec(
+                fullname, path, target)
+            if spec is not None and isinstance(
+                    spec.loader, importlib.machinery.ExtensionFileLoader):
+                with open(spec.origin, 'rb') as f:
+                    data = f.read()
+
+        data = _hoomd.mpi_bcast_bytes(data, mpi_conf)
+        if len(data) == 0:
+            return None
+
+        # name the copy by its contents so that different builds do not clash
+        digest = hashlib.sha1(data).hexdigest()[:16]
+        filename = os.path.join(
+            self._directory,
+            f'{fullname}-{digest}{importlib.machinery.EXTENSION_SUFFIXES[0]}')
+
+        if not os.path.exists(filename):
+            os.makedirs(self._directory, exist_ok=True)
+            # ranks on the same node write identical files, move them into
+            # place atomically
+            tmp_filename = f'{filename}.tmp.{os.getpid()}'
+            with open(tmp_filename, 'wb') as f:
+                f.write(data)
+            os.replace(tmp_filename, filename)
+
+        loader = importlib.machinery.ExtensionFileLoader(fullname, filename)
+        return importlib.util.spec_from_file_location(fullname,
+                                                      filename,
+                                                      loader=loader)
+
+
+def _install_extension_finder():
+    """Install the finder when the environment variable is set."""
+    directory = os.environ.get(_ENVIRONMENT_VARIABLE, '')
+    if directory == '':
+        return
+
+    if not any(
+            isinstance(finder, _BroadcastExtensionFinder)
+            for finder in sys.meta_path):
+        sys.meta_path.insert(0, _BroadcastExtensionFinder(directory))
@@ -0,0 +1,45 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Standard performance benchmarks.
+
+`hoomd.benchmark` provides a fixed set of workloads and a runner that reports
+time steps per second, per compute timings, and memory use as machine readable
+JSON so that performance can be compared across builds and releases.
+
+Run the full suite from the command line::
+
+    python3 -m hoomd.benchmark --device GPU --output benchmark.json
+
+or from a build directory with ``make benchmark``. Run ``python3 -m
+hoomd.benchmark --help`` for the available options.
+
+Use the Python API to benchmark individual workloads or your own simulations::
+
+    sim = hoomd.benchmark.workloads['lj_liquid_0.8442'](hoomd.device.CPU())
+    result = hoomd.benchmark.run_benchmark(sim, steps=500)
+
+The MPCD workloads in `hoomd.benchmark.mpcd_workloads` cover a bulk SRD
+fluid, the Andersen thermostat, Couette flow in a slit, pressure-driven flow
+through a slit pore, and polymers embedded in the solvent. Compare them with
+the particle updates per second, which count the MD and the MPCD particles.
+
+`hoomd.benchmark.scaling` runs workloads over a sweep of MPI rank counts and
+reports the parallel efficiency, the time in each communication phase, and the
+ghost particle counts::
+
+    python3 -m hoomd.benchmark.scaling --ranks 1 2 4 8 --output scaling.json
+
+Note:
+    The workloads use `hoomd.md`, `hoomd.hpmc`, and `hoomd.mpcd`. `run_suite`
+    skips the HPMC and MPCD workloads when they are not built.
+"""
+
+from hoomd.benchmark import workloads as _workloads_module
+from hoomd.benchmark.workloads import (lj_liquid, polymer_melt,
+                                       pppm_electrolyte, hpmc_spheres,
+                                       hpmc_polyhedra)
+from hoomd.benchmark.runner import run_benchmark, run_suite
+
+workloads = _workloads_module.workloads
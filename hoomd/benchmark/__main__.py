@@ -0,0 +1,65 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Command line interface to run the benchmark suite."""
+
+import argparse
+import json
+import sys
+
+import hoomd
+import hoomd.benchmark
+
+
+def main(args=None):
+    """Run the benchmark suite and write the results as JSON."""
+    parser = argparse.ArgumentParser(
+        prog='python3 -m hoomd.benchmark',
+        description='Run the HOOMD-blue benchmark suite.')
+    parser.add_argument('--device',
+                        choices=['CPU', 'GPU'],
+                        default='CPU',
+                        help='Device to execute on.')
+    parser.add_argument('--workloads',
+                        nargs='+',
+                        choices=list(hoomd.benchmark.workloads),
+                        help='Workloads to run (default: all).')
+    parser.add_argument('-N',
+                        type=int,
+                        help='Number of particles in each workload.')
+    parser.add_argument('--steps',
+                        type=int,
+                        default=1000,
+                        help='Number of steps in each timed run.')
+    parser.add_argument('--warmup-steps',
+                        type=int,
+                        default=1000,
+                        help='Number of steps to run before timing.')
+    parser.add_argument('--repeat',
+                        type=int,
+                        default=3,
+                        help='Number of timed runs.')
+    parser.add_argument('--output',
+                        help='JSON output file (default: standard output).')
+    options = parser.parse_args(args)
+
+    device = getattr(hoomd.device, options.device)(notice_level=1)
+    results = hoomd.benchmark.run_suite(device,
+                                        names=options.workloads,
+                                        N=options.N,
+                                        steps=options.steps,
+                                        warmup_steps=options.warmup_steps,
+                                        repeat=options.repeat)
+
+    if device.communicator.rank == 0:
+        if options.output is None:
+            json.dump(results, sys.stdout, indent=2)
+            sys.stdout.write('\n')
+        else:
+            with open(options.output, 'w') as f:
+                json.dump(results, f, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,462 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Standard MPCD benchmark workloads.
+
+The `hoomd.mpcd` Python interface does not operate on a `hoomd.Simulation`
+yet, so these workloads set up the MPCD solvent, collision rule, and streaming
+method from the C++ classes in ``_mpcd`` and run them with `_MPCDIntegrator`.
+Each workload returns a `hoomd.Simulation` that is ready to `run
+<hoomd.Simulation.run>`.
+
+The MPCD cell size is 1, so the box lengths are rounded to whole numbers of
+cells and the actual number of MPCD particles may differ slightly from *N*.
+Read it from the ``N_mpcd`` attribute of the integrator.
+"""
+
+import math
+
+import numpy
+
+import hoomd
+from hoomd import _hoomd
+from hoomd.md.integrate import Integrator
+from hoomd.mpcd import _mpcd
+
+
+class _MPCDIntegrator(Integrator):
+    """Run an MPCD solvent together with the MD integration methods.
+
+    Args:
+        dt (float): Integrator time step size.
+        solvent (callable): Called with the simulation and the C++ integrator
+            when the integrator attaches. Returns the C++ MPCD system data
+            after it sets up the collision rule, streaming method, sorter, and
+            fillers.
+        forces (list[hoomd.md.force.Force]): MD forces.
+        methods (list[hoomd.md.methods.Method]): MD integration methods.
+    """
+
+    def __init__(self, dt, solvent, forces=None, methods=None):
+        super().__init__(dt=dt, forces=forces, methods=methods)
+        self._solvent = solvent
+        self._sysdata = None
+        self._mpcd_comm = None
+
+    def _attach(self):
+        sysdata = self._solvent.create(self._simulation)
+        self._cpp_obj = _mpcd.Integrator(sysdata, self.dt)
+        self._solvent.configure(self._simulation, sysdata, self._cpp_obj)
+        if self._simulation.device.communicator.num_ranks > 1:
+            if isinstance(self._simulation.device, hoomd.device.GPU):
+                self._mpcd_comm = _mpcd.CommunicatorGPU(sysdata)
+            else:
+                self._mpcd_comm = _mpcd.Communicator(sysdata)
+            self._cpp_obj.setMPCDCommunicator(self._mpcd_comm)
+        self._sysdata = sysdata
+
+        # skip creating the MD integrator in Integrator._attach
+        self.outer_forces._sync(self._simulation, self._cpp_obj.outer_forces)
+        super(Integrator, self)._attach()
+
+    def _detach(self):
+        self._sysdata = None
+        self._mpcd_comm = None
+        super()._detach()
+
+    @property
+    def N_mpcd(self):  # noqa: N802 - allow N in name
+        """int: Number of MPCD particles."""
+        if self._sysdata is None:
+            return self._solvent.N
+        return self._sysdata.getParticleData().N_global
+
+
+class _Solvent:
+    """Place the MPCD particles and set up the MPCD algorithm.
+
+    Args:
+        position (numpy.ndarray): Positions of the MPCD particles.
+        kT (float): Temperature of the initial velocities.
+        seed (int): Random number seed.
+        configure (callable): Called with the simulation, the C++ MPCD system
+            data, the C++ integrator, and a `_Classes` to add the collision
+            rule, streaming method, sorter, and fillers.
+    """
+
+    def __init__(self, position, kT, seed, configure):
+        self.position = position
+        self.kT = kT
+        self.seed = seed
+        self.N = len(position)
+        self._configure = configure
+
+    def create(self, simulation):
+        """Create the C++ MPCD system data from the positions."""
+        snapshot = _mpcd.SystemDataSnapshot(
+            simulation.state._cpp_sys_def)
+        if simulation.device.communicator.rank == 0:
+            rng = numpy.random.default_rng(self.seed)
+            particles = snapshot.particles
+            particles.types = ['A']
+            particles.resize(self.N)
+            particles.position[:] = self.position
+            velocity = rng.normal(0.0, math.sqrt(self.kT), size=(self.N, 3))
+            velocity -= numpy.mean(velocity, axis=0)
+            particles.velocity[:] = velocity
+            particles.typeid[:] = 0
+        return _mpcd.SystemData(snapshot)
+
+    def configure(self, simulation, sysdata, integrator):
+        """Add the MPCD methods to the C++ integrator."""
+        self._configure(simulation, sysdata, integrator,
+                        _Classes(simulation.device))
+
+
+class _Classes:
+    """Select the CPU or GPU version of the C++ MPCD classes.
+
+    `_Classes` looks up ``name`` as ``name`` on the CPU and ``nameGPU`` on the
+    GPU. Classes named after a geometry put ``GPU`` before the geometry name.
+    """
+
+    def __init__(self, device):
+        self._gpu = isinstance(device, hoomd.device.GPU)
+
+    def __call__(self, name, geometry=''):
+        suffix = 'GPU' if self._gpu else ''
+        return getattr(_mpcd, name + suffix + geometry)
+
+
+def _box_snapshot(device, L, types=('A',)):
+    """Make an MD snapshot of a cubic box with no particles."""
+    snapshot = hoomd.Snapshot(device.communicator)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [L, L, L, 0, 0, 0]
+        snapshot.particles.types = list(types)
+    return snapshot
+
+
+def _make_simulation(device, snapshot, seed):
+    sim = hoomd.Simulation(device=device, seed=seed)
+    sim.create_state_from_snapshot(snapshot)
+    return sim
+
+
+def _box_length(N, density, fraction=1.0, multiple=1):
+    """Box length in cells that holds about N particles at a density.
+
+    Args:
+        N (int): Number of particles.
+        density (float): Number density of the particles.
+        fraction (float): Fraction of the box volume filled with particles.
+        multiple (int): Round the box length to a multiple of this number of
+            cells.
+    """
+    L = (N / (density * fraction))**(1 / 3)
+    return max(multiple, multiple * int(round(L / multiple)))
+
+
+def _random_positions(rng, L, N, outside=None):
+    """Place N particles uniformly in a cubic box of length L.
+
+    Args:
+        outside (callable): Returns a boolean mask of the positions that are
+            not allowed. These positions are drawn again.
+    """
+    position = rng.uniform(-L / 2, L / 2, size=(N, 3))
+    if outside is not None:
+        mask = outside(position)
+        while numpy.any(mask):
+            position[mask] = rng.uniform(-L / 2,
+                                         L / 2,
+                                         size=(numpy.count_nonzero(mask), 3))
+            mask = outside(position)
+    return position
+
+
+def _collide_srd(simulation, sysdata, integrator, classes, period, angle, kT,
+                 seed):
+    """Add a SRD collision rule with a cell thermo compute."""
+    thermo = classes('CellThermoCompute')(sysdata)
+    srd = classes('SRDCollisionMethod')(sysdata, simulation.timestep, period,
+                                        0, seed, thermo)
+    srd.setRotationAngle(angle * math.pi / 180)
+    if kT is not None:
+        srd.setTemperature(hoomd.variant.Constant(kT))
+    integrator.setCollisionMethod(srd)
+    return srd
+
+
+def _stream(simulation, sysdata, integrator, classes, period, geometry_name,
+            geometry, field=None):
+    """Add a streaming method in a geometry."""
+    stream = classes('ConfinedStreamingMethod',
+                     geometry_name)(sysdata, simulation.timestep, period, 0,
+                                    geometry)
+    if field is not None:
+        stream.setField(field)
+    integrator.setStreamingMethod(stream)
+    return stream
+
+
+def _sort(simulation, sysdata, integrator, classes, period):
+    """Add a sorter."""
+    sorter = classes('Sorter')(sysdata, simulation.timestep, period)
+    integrator.setSorter(sorter)
+    return sorter
+
+
+def _constant_force(simulation, force):
+    """Make a constant external force along x."""
+    field = _mpcd.ExternalField(simulation.device._cpp_exec_conf)
+    field.ConstantForce(_hoomd.make_scalar3(force, 0, 0))
+    return field
+
+
+def mpcd_srd(device, N=1000000, density=10.0, kT=1.0, seed=1):
+    """Bulk SRD fluid.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of MPCD particles.
+        density (float): Number density of the MPCD particles
+            :math:`[\\mathrm{length}^{-3}]`.
+        kT (float): Temperature of the initial velocities
+            :math:`[\\mathrm{energy}]`.
+        seed (int): Random number seed.
+
+    Streams and collides the MPCD particles every step with ``dt = 0.1``, a
+    rotation angle of 130 degrees, and random grid shifting. Sorts the
+    particles every 20 steps.
+    """
+    L = _box_length(N, density)
+    rng = numpy.random.default_rng(seed)
+    position = _random_positions(rng, L, int(density * L**3))
+
+    def configure(simulation, sysdata, integrator, classes):
+        _collide_srd(simulation, sysdata, integrator, classes, 1, 130.0, None,
+                     seed)
+        _stream(simulation, sysdata, integrator, classes, 1, 'Bulk',
+                _mpcd.BulkGeometry())
+        _sort(simulation, sysdata, integrator, classes, 20)
+
+    sim = _make_simulation(device, _box_snapshot(device, L), seed)
+    sim.operations.integrator = _MPCDIntegrator(
+        dt=0.1, solvent=_Solvent(position, kT, seed, configure))
+    return sim
+
+
+def mpcd_at(device, N=1000000, density=10.0, kT=1.0, seed=1):
+    """Bulk fluid with the Andersen thermostat collision rule.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of MPCD particles.
+        density (float): Number density of the MPCD particles
+            :math:`[\\mathrm{length}^{-3}]`.
+        kT (float): Thermostat temperature :math:`[\\mathrm{energy}]`.
+        seed (int): Random number seed.
+
+    Streams and collides the MPCD particles every step with ``dt = 0.1``.
+    Sorts the particles every 20 steps.
+    """
+    L = _box_length(N, density)
+    rng = numpy.random.default_rng(seed)
+    position = _random_positions(rng, L, int(density * L**3))
+
+    def configure(simulation, sysdata, integrator, classes):
+        thermo = classes('CellThermoCompute')(sysdata)
+        rand_thermo = classes('CellThermoCompute')(sysdata)
+        at = classes('ATCollisionMethod')(sysdata, simulation.timestep, 1, 0,
+                                          thermo, rand_thermo,
+                                          hoomd.variant.Constant(kT))
+        integrator.setCollisionMethod(at)
+        _stream(simulation, sysdata, integrator, classes, 1, 'Bulk',
+                _mpcd.BulkGeometry())
+        _sort(simulation, sysdata, integrator, classes, 20)
+
+    sim = _make_simulation(device, _box_snapshot(device, L), seed)
+    sim.operations.integrator = _MPCDIntegrator(
+        dt=0.1, solvent=_Solvent(position, kT, seed, configure))
+    return sim
+
+
+def mpcd_couette(device, N=1000000, density=10.0, kT=1.0, V=1.0, seed=1):
+    """Couette flow between parallel plates.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of MPCD particles.
+        density (float): Number density of the MPCD particles
+            :math:`[\\mathrm{length}^{-3}]`.
+        kT (float): Temperature of the fluid and the virtual particles
+            :math:`[\\mathrm{energy}]`.
+        V (float): Speed of the walls along x
+            :math:`[\\mathrm{length} / \\mathrm{time}]`.
+        seed (int): Random number seed.
+
+    No-slip walls that move in opposite directions bound the fluid one cell
+    inside the box along z. Virtual particles fill the cells that the walls
+    cut, and the SRD collision rule thermostats the fluid.
+    """
+    L = _box_length(N, density, multiple=2)
+    H = L / 2 - 1
+    rng = numpy.random.default_rng(seed)
+    position = _random_positions(rng, L, int(density * L**2 * 2 * H),
+                                 lambda r: numpy.abs(r[:, 2]) >= H)
+
+    def configure(simulation, sysdata, integrator, classes):
+        _collide_srd(simulation, sysdata, integrator, classes, 1, 130.0, kT,
+                     seed)
+        geometry = _mpcd.SlitGeometry(H, V, _mpcd.boundary.no_slip)
+        _stream(simulation, sysdata, integrator, classes, 1, 'Slit', geometry)
+        integrator.addFiller(
+            classes('SlitGeometryFiller')(sysdata, density, 0,
+                                          hoomd.variant.Constant(kT),
+                                          geometry))
+        _sort(simulation, sysdata, integrator, classes, 20)
+
+    sim = _make_simulation(device, _box_snapshot(device, L), seed)
+    sim.operations.integrator = _MPCDIntegrator(
+        dt=0.1, solvent=_Solvent(position, kT, seed, configure))
+    return sim
+
+
+def mpcd_slit_pore(device, N=1000000, density=10.0, kT=1.0, force=0.01, seed=1):
+    """Pressure-driven flow through a slit pore.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of MPCD particles.
+        density (float): Number density of the MPCD particles
+            :math:`[\\mathrm{length}^{-3}]`.
+        kT (float): Temperature of the fluid and the virtual particles
+            :math:`[\\mathrm{energy}]`.
+        force (float): Constant force on each MPCD particle along x
+            :math:`[\\mathrm{force}]`.
+        seed (int): Random number seed.
+
+    A pore of half height :math:`L/4` and half length :math:`L/4` with no-slip
+    walls joins two reservoirs, and a constant force drives the fluid through
+    it. Virtual particles fill the cells that the walls cut, and the SRD
+    collision rule thermostats the fluid.
+    """
+    L = _box_length(N, density, fraction=0.75, multiple=4)
+    H = L / 4
+    rng = numpy.random.default_rng(seed)
+
+    def in_walls(r):
+        return numpy.logical_and(
+            numpy.abs(r[:, 0]) < H,
+            numpy.abs(r[:, 2]) > H)
+
+    position = _random_positions(rng, L, int(density * 0.75 * L**3), in_walls)
+
+    def configure(simulation, sysdata, integrator, classes):
+        _collide_srd(simulation, sysdata, integrator, classes, 1, 130.0, kT,
+                     seed)
+        geometry = _mpcd.SlitPoreGeometry(H, H, _mpcd.boundary.no_slip)
+        _stream(simulation, sysdata, integrator, classes, 1, 'SlitPore',
+                geometry, _constant_force(simulation, force))
+        integrator.addFiller(
+            classes('SlitPoreGeometryFiller')(sysdata, density, 0,
+                                              hoomd.variant.Constant(kT), seed,
+                                              geometry))
+        _sort(simulation, sysdata, integrator, classes, 20)
+
+    sim = _make_simulation(device, _box_snapshot(device, L), seed)
+    sim.operations.integrator = _MPCDIntegrator(
+        dt=0.1, solvent=_Solvent(position, kT, seed, configure))
+    return sim
+
+
+def mpcd_polymer(device,
+                 N=1000000,
+                 density=5.0,
+                 N_polymer=10000,
+                 chain_length=50,
+                 kT=1.0,
+                 seed=1):
+    """Bead spring polymers embedded in a SRD fluid.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of MPCD particles.
+        density (float): Number density of the MPCD particles
+            :math:`[\\mathrm{length}^{-3}]`.
+        N_polymer (int): Number of monomers. Rounded down to a multiple of
+            ``chain_length``.
+        chain_length (int): Number of monomers per chain.
+        kT (float): Thermostat temperature :math:`[\\mathrm{energy}]`.
+        seed (int): Random number seed.
+
+    The chains start as straight rods. They are held together by harmonic
+    bonds, interact with a purely repulsive (WCA) LJ potential that excludes
+    bonded neighbors, and are integrated with NVE at ``dt = 0.005``. The
+    monomers have the mass of the MPCD particles in one cell and take part in
+    the SRD collisions every 20 steps, which also thermostat the fluid.
+    """
+    N_polymer = (N_polymer // chain_length) * chain_length
+    L = _box_length(N, density)
+    rng = numpy.random.default_rng(seed)
+    position = _random_positions(rng, L, int(density * L**3))
+
+    # lay the chains along x in rows on a square grid in the y-z plane
+    bond = 0.97
+    per_row = max(1, int(L // (chain_length * bond)))
+    num_rows = int(math.ceil(N_polymer / chain_length / per_row))
+    n = int(math.ceil(math.sqrt(num_rows)))
+    spacing = L / n
+    if spacing < 1.2 or chain_length * bond > L:
+        raise ValueError("The chains do not fit in the box.")
+
+    snapshot = _box_snapshot(device, L)
+    if snapshot.communicator.rank == 0:
+        chain = numpy.arange(N_polymer) // chain_length
+        row = chain // per_row
+        monomer = numpy.arange(N_polymer) % chain_length
+        mpos = numpy.zeros((N_polymer, 3))
+        mpos[:, 0] = ((chain % per_row) * chain_length + monomer) * bond
+        mpos[:, 1] = (row % n + 0.5) * spacing
+        mpos[:, 2] = (row // n + 0.5) * spacing
+        mpos = numpy.mod(mpos, L) - L / 2
+
+        snapshot.particles.N = N_polymer
+        snapshot.particles.position[:] = mpos
+        snapshot.particles.mass[:] = density
+        velocity = rng.normal(0.0,
+                              math.sqrt(kT / density),
+                              size=(N_polymer, 3))
+        snapshot.particles.velocity[:] = velocity - numpy.mean(velocity,
+                                                               axis=0)
+
+        first = numpy.arange(N_polymer)[monomer < chain_length - 1]
+        snapshot.bonds.N = len(first)
+        snapshot.bonds.types = ['backbone']
+        snapshot.bonds.group[:] = numpy.stack((first, first + 1), axis=1)
+    sim = _make_simulation(device, snapshot, seed)
+
+    def configure(simulation, sysdata, integrator, classes):
+        srd = _collide_srd(simulation, sysdata, integrator, classes, 20, 130.0,
+                           kT, seed)
+        srd.setEmbeddedGroup(simulation.state._get_group(hoomd.filter.All()))
+        _stream(simulation, sysdata, integrator, classes, 20, 'Bulk',
+                _mpcd.BulkGeometry())
+        _sort(simulation, sysdata, integrator, classes, 100)
+
+    nlist = hoomd.md.nlist.Cell(exclusions=('bond',))
+    wca = hoomd.md.pair.LJ(nlist=nlist,
+                           default_r_cut=2**(1 / 6),
+                           mode='shift')
+    wca.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    harmonic = hoomd.md.bond.Harmonic()
+    harmonic.params['backbone'] = dict(k=30.0, r0=1.0)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = _MPCDIntegrator(
+        dt=0.005,
+        solvent=_Solvent(position, kT, seed, configure),
+        forces=[wca, harmonic],
+        methods=[nve])
+    return sim
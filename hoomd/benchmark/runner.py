@@ -0,0 +1,144 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Run benchmark workloads and collect their results."""
+
+import resource
+import statistics
+import sys
+
+import hoomd
+
+
+def _compute_timings(sim, num_iters):
+    """Time the computes attached to the simulation's integrator.
+
+    Calls the C++ ``benchmark`` method of each MD force and each neighbor list
+    and returns the average time per call in milliseconds by compute name.
+    Computes that do not support benchmarking are skipped.
+    """
+    integrator = sim.operations.integrator
+    computes = []
+    for force in getattr(integrator, 'forces', []):
+        computes.append(force)
+        nlist = getattr(force, 'nlist', None)
+        if nlist is not None and nlist not in computes:
+            computes.append(nlist)
+
+    timings = {}
+    for compute in computes:
+        name = type(compute).__name__
+        if name in timings:
+            name = f'{name}_{len(timings)}'
+        try:
+            timings[name] = compute._cpp_obj.benchmark(num_iters)
+        except RuntimeError:
+            continue
+    return timings
+
+
+def _max_rss_bytes():
+    """Peak resident set size of this process in bytes."""
+    max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports kilobytes, macOS reports bytes
+    if sys.platform == 'darwin':
+        return max_rss
+    return max_rss * 1024
+
+
+def run_benchmark(sim,
+                  steps=1000,
+                  warmup_steps=1000,
+                  repeat=3,
+                  compute_iterations=100):
+    """Measure the performance of a simulation.
+
+    Args:
+        sim (`hoomd.Simulation`): Simulation with an initialized state and an
+            integrator.
+        steps (int): Number of steps in each timed run.
+        warmup_steps (int): Number of steps to run before timing. The warm up
+            equilibrates the initial configuration and executes the autotuners.
+        repeat (int): Number of timed runs.
+        compute_iterations (int): Number of iterations to average in the per
+            compute timings.
+
+    Returns:
+        dict: The benchmark results with the keys:
+
+        * ``N`` (`int`) - number of particles.
+        * ``N_mpcd`` (`int`) - number of MPCD particles (0 without MPCD).
+        * ``steps`` (`int`) - number of steps in each timed run.
+        * ``tps`` (`list` [`float`]) - time steps per second of each timed run.
+        * ``tps_mean`` (`float`) - mean of ``tps``.
+        * ``tps_stdev`` (`float`) - sample standard deviation of ``tps`` (0
+          when ``repeat`` is 1).
+        * ``pups_mean`` (`float`) - particle updates per second, the mean of
+          ``tps`` times the number of MD and MPCD particles. Use it to compare
+          workloads and systems of different sizes.
+        * ``compute_ms`` (`dict` [`str`, `float`]) - average time per call in
+          milliseconds for each MD force and neighbor list.
+        * ``max_rss_bytes`` (`int`) - peak resident set size of the process on
+          rank 0.
+    """
+    if warmup_steps > 0:
+        sim.run(warmup_steps)
+
+    tps = []
+    for i in range(repeat):
+        sim.run(steps)
+        tps.append(sim.tps)
+
+    N = sim.state.N_particles
+    N_mpcd = getattr(sim.operations.integrator, 'N_mpcd', 0)
+    tps_mean = statistics.mean(tps)
+    return dict(N=N,
+                N_mpcd=N_mpcd,
+                steps=steps,
+                tps=tps,
+                tps_mean=tps_mean,
+                tps_stdev=statistics.stdev(tps) if len(tps) > 1 else 0.0,
+                pups_mean=tps_mean * (N + N_mpcd),
+                compute_ms=_compute_timings(sim, compute_iterations),
+                max_rss_bytes=_max_rss_bytes())
+
+
+def run_suite(device, names=None, N=None, **kwargs):
+    """Run several standard workloads.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        names (list[str]): Names of the workloads to run (see
+            `hoomd.benchmark.workloads`). Defaults to all workloads that the
+            current build supports.
+        N (int): Number of particles in each workload (the number of MPCD
+            particles in the MPCD workloads). Defaults to the size set by each
+            workload.
+        kwargs: Additional keyword arguments passed to `run_benchmark`.
+
+    Returns:
+        dict: Build and device metadata under ``'hoomd'`` and the result of
+        `run_benchmark` for each workload under ``'workloads'``.
+    """
+    from hoomd.benchmark.workloads import workloads
+
+    if names is None:
+        names = [
+            name for name in workloads
+            if (hoomd.version.hpmc_built or not name.startswith('hpmc')) and (
+                hoomd.version.mpcd_built or not name.startswith('mpcd'))
+        ]
+
+    results = {}
+    for name in names:
+        workload_args = {} if N is None else dict(N=N)
+        sim = workloads[name](device, **workload_args)
+        results[name] = run_benchmark(sim, **kwargs)
+
+    metadata = dict(version=hoomd.version.version,
+                    git_sha1=hoomd.version.git_sha1,
+                    compile_flags=hoomd.version.compile_flags,
+                    device=type(device).__name__,
+                    num_ranks=device.communicator.num_ranks)
+    return dict(hoomd=metadata, workloads=results)
@@ -0,0 +1,343 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Strong scaling benchmarks over a sweep of MPI rank counts.
+
+`run_scaling` launches each workload with a fixed number of particles on an
+increasing number of MPI ranks and reports the parallel efficiency, the time
+spent in each communication phase, and the number of ghost particles. Compare
+the results with `compare_scaling` to catch scaling regressions.
+
+Run the sweep from the command line::
+
+    python3 -m hoomd.benchmark.scaling --ranks 1 2 4 8 --output scaling.json
+
+or from a build directory with ``make benchmark_scaling``. Pass ``--baseline``
+with the output of a previous sweep to exit with a non-zero status when the
+efficiency drops by more than ``--tolerance``.
+
+Each point of the sweep runs in a separate ``mpiexec`` process
+(`run_scaling_rank`). Each rank writes its measurements to a JSON file that
+the driver combines after the process exits.
+"""
+
+import argparse
+import json
+import os
+import shlex
+import statistics
+import subprocess
+import sys
+import tempfile
+
+import hoomd
+
+default_workloads = ('lj_liquid_0.8442', 'pppm_electrolyte', 'hpmc_spheres')
+"""tuple[str]: Workloads in the default sweep.
+
+They exercise `Communicator` (or `CommunicatorGPU`), the distributed FFT and
+ghost cell exchange of PPPM, and the HPMC ghost layer.
+"""
+
+communication_phases = ('comm_migrate', 'comm_ghost_exch',
+                        'comm_ghost_update', 'comm_ghost_net_force',
+                        'balance', 'ghost cell update')
+"""tuple[str]: Profiled regions reported as communication phases.
+
+``comm_*`` are the particle migration and ghost communication steps of the
+communicator, ``balance`` is `hoomd.tune.LoadBalancer`, and ``ghost cell
+update`` is the PPPM mesh communication.
+"""
+
+
+def _phase_times(timings):
+    """Sum the wall time of each communication phase over the profile tree."""
+    times = {phase: 0.0 for phase in communication_phases}
+    for name, timing in timings.items():
+        phase = name.split('/')[-1]
+        if phase in times:
+            times[phase] += timing['wall_time']
+    return times
+
+
+def run_scaling_rank(device,
+                     name,
+                     output_dir,
+                     N=None,
+                     steps=1000,
+                     warmup_steps=1000):
+    """Measure one point of the sweep on the current MPI ranks.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        name (str): Name of the workload (see
+            `hoomd.benchmark.workloads`).
+        output_dir (str): Directory to write the measurements to.
+        N (int): Number of particles. Defaults to the size set by the
+            workload.
+        steps (int): Number of timed steps.
+        warmup_steps (int): Number of steps to run before timing.
+
+    Each rank writes ``rank<rank>.json`` to *output_dir* with the keys:
+
+    * ``tps`` (`float`) - time steps per second of the timed run.
+    * ``N`` (`int`) - number of particles in the simulation.
+    * ``N_local`` (`int`) - number of particles owned by the rank.
+    * ``N_ghost`` (`int`) - number of ghost particles on the rank.
+    * ``comm_time`` (`dict` [`str`, `float`]) - wall time of each of the
+      `communication_phases` in the timed run :math:`[\\mathrm{s}]`.
+    """
+    from hoomd.benchmark.workloads import workloads
+
+    sim = workloads[name](device, **({} if N is None else dict(N=N)))
+    if warmup_steps > 0:
+        sim.run(warmup_steps)
+
+    sim.profiling = True
+    sim.run(steps)
+    sim.profiling = False
+
+    pdata = sim.state._cpp_sys_def.getParticleData()
+    result = dict(tps=sim.tps,
+                  N=sim.state.N_particles,
+                  N_local=pdata.getN(),
+                  N_ghost=pdata.getNGhosts(),
+                  comm_time=_phase_times(sim.timings))
+
+    rank = device.communicator.rank
+    with open(os.path.join(output_dir, f'rank{rank}.json'), 'w') as f:
+        json.dump(result, f)
+
+
+def _combine_ranks(rank_results, steps):
+    """Combine the measurements of all ranks at one point of the sweep."""
+    N_local = [r['N_local'] for r in rank_results]
+    N_ghost = [r['N_ghost'] for r in rank_results]
+    comm_time = {}
+    for phase in communication_phases:
+        # report per step times, the slowest rank sets the pace
+        times = [r['comm_time'][phase] / steps for r in rank_results]
+        comm_time[phase] = dict(max=max(times), mean=statistics.mean(times))
+
+    return dict(num_ranks=len(rank_results),
+                N=rank_results[0]['N'],
+                tps=rank_results[0]['tps'],
+                comm_time=comm_time,
+                N_local=dict(min=min(N_local), max=max(N_local)),
+                N_ghost=dict(total=sum(N_ghost),
+                             max=max(N_ghost),
+                             mean=statistics.mean(N_ghost)))
+
+
+def parallel_efficiency(points):
+    """Compute the strong scaling efficiency of a sweep.
+
+    Args:
+        points (list[dict]): Points of the sweep with the keys ``num_ranks``
+            and ``tps``.
+
+    Returns:
+        list[float]: The efficiency of each point relative to the point with
+        the fewest ranks, :math:`\\frac{n_0 \\cdot tps(n)}{n \\cdot
+        tps(n_0)}`.
+    """
+    reference = min(points, key=lambda p: p['num_ranks'])
+    return [(reference['num_ranks'] * p['tps'])
+            / (p['num_ranks'] * reference['tps']) for p in points]
+
+
+def run_scaling(names=default_workloads,
+                ranks=(1, 2, 4, 8),
+                device='CPU',
+                N=None,
+                steps=1000,
+                warmup_steps=1000,
+                launcher=('mpiexec', '-n', '{n}'),
+                python=sys.executable):
+    """Run a strong scaling sweep.
+
+    Args:
+        names (list[str]): Names of the workloads to run (see
+            `hoomd.benchmark.workloads`).
+        ranks (list[int]): Numbers of MPI ranks to run each workload on.
+        device (str): ``'CPU'`` or ``'GPU'``.
+        N (int): Number of particles in each workload. Defaults to the size
+            set by each workload. The size stays the same at all rank counts.
+        steps (int): Number of timed steps at each point.
+        warmup_steps (int): Number of steps to run before timing.
+        launcher (list[str]): Command that launches the MPI processes.
+            ``{n}`` is replaced by the number of ranks.
+        python (str): Python interpreter that runs the workloads.
+
+    Returns:
+        dict: Build metadata under ``'hoomd'`` and the sweep of each workload
+        under ``'workloads'``. Each sweep is a list with one `dict` per rank
+        count and the keys:
+
+        * ``num_ranks`` (`int`) - number of MPI ranks.
+        * ``N`` (`int`) - number of particles.
+        * ``tps`` (`float`) - time steps per second.
+        * ``efficiency`` (`float`) - parallel efficiency relative to the
+          fewest ranks (see `parallel_efficiency`).
+        * ``comm_time`` (`dict`) - the ``max`` and ``mean`` over the ranks of
+          the time per step in each of the `communication_phases`
+          :math:`[\\mathrm{s}]`.
+        * ``N_local`` (`dict`) - the ``min`` and ``max`` number of particles
+          owned by a rank.
+        * ``N_ghost`` (`dict`) - the ``total``, ``max``, and ``mean`` number
+          of ghost particles per rank.
+
+    Raises:
+        subprocess.CalledProcessError: When a point of the sweep fails.
+    """
+    results = {}
+    for name in names:
+        points = []
+        for n in ranks:
+            with tempfile.TemporaryDirectory() as output_dir:
+                command = [arg.format(n=n) for arg in launcher]
+                command += [
+                    python, '-m', 'hoomd.benchmark.scaling', '--worker',
+                    name, '--worker-output', output_dir, '--device', device,
+                    '--steps',
+                    str(steps), '--warmup-steps',
+                    str(warmup_steps)
+                ]
+                if N is not None:
+                    command += ['-N', str(N)]
+                subprocess.run(command, check=True)
+
+                rank_results = []
+                for rank in range(n):
+                    path = os.path.join(output_dir, f'rank{rank}.json')
+                    with open(path) as f:
+                        rank_results.append(json.load(f))
+            points.append(_combine_ranks(rank_results, steps))
+
+        for point, efficiency in zip(points, parallel_efficiency(points)):
+            point['efficiency'] = efficiency
+        results[name] = points
+
+    metadata = dict(version=hoomd.version.version,
+                    git_sha1=hoomd.version.git_sha1,
+                    compile_flags=hoomd.version.compile_flags,
+                    device=device)
+    return dict(hoomd=metadata, workloads=results)
+
+
+def compare_scaling(results, baseline, tolerance=0.1):
+    """Find scaling regressions.
+
+    Args:
+        results (dict): Output of `run_scaling`.
+        baseline (dict): Output of a previous `run_scaling`.
+        tolerance (float): Largest acceptable drop in efficiency.
+
+    Returns:
+        list[str]: A description of each point (workload and rank count in
+        both sweeps) whose efficiency is lower than the baseline by more than
+        *tolerance*.
+    """
+    regressions = []
+    for name, points in results['workloads'].items():
+        reference = {
+            p['num_ranks']: p for p in baseline['workloads'].get(name, [])
+        }
+        for point in points:
+            base = reference.get(point['num_ranks'])
+            if base is None:
+                continue
+            if point['efficiency'] < base['efficiency'] - tolerance:
+                regressions.append(
+                    f"{name} on {point['num_ranks']} ranks: efficiency "
+                    f"{point['efficiency']:.3f} < baseline "
+                    f"{base['efficiency']:.3f}")
+    return regressions
+
+
+def main(args=None):
+    """Run a strong scaling sweep and write the results as JSON."""
+    from hoomd.benchmark.workloads import workloads
+
+    parser = argparse.ArgumentParser(
+        prog='python3 -m hoomd.benchmark.scaling',
+        description='Run a HOOMD-blue strong scaling sweep.')
+    parser.add_argument('--device',
+                        choices=['CPU', 'GPU'],
+                        default='CPU',
+                        help='Device to execute on.')
+    parser.add_argument('--workloads',
+                        nargs='+',
+                        choices=list(workloads),
+                        default=list(default_workloads),
+                        help='Workloads to run.')
+    parser.add_argument('--ranks',
+                        nargs='+',
+                        type=int,
+                        default=[1, 2, 4, 8],
+                        help='Numbers of MPI ranks.')
+    parser.add_argument('-N',
+                        type=int,
+                        help='Number of particles in each workload.')
+    parser.add_argument('--steps',
+                        type=int,
+                        default=1000,
+                        help='Number of timed steps.')
+    parser.add_argument('--warmup-steps',
+                        type=int,
+                        default=1000,
+                        help='Number of steps to run before timing.')
+    parser.add_argument('--launcher',
+                        default='mpiexec -n {n}',
+                        help='MPI launch command, {n} is the number of ranks.')
+    parser.add_argument('--output',
+                        help='JSON output file (default: standard output).')
+    parser.add_argument('--baseline',
+                        help='JSON output of a previous sweep to compare to.')
+    parser.add_argument('--tolerance',
+                        type=float,
+                        default=0.1,
+                        help='Largest acceptable drop in efficiency.')
+    parser.add_argument('--worker', help=argparse.SUPPRESS)
+    parser.add_argument('--worker-output', help=argparse.SUPPRESS)
+    options = parser.parse_args(args)
+
+    if options.worker is not None:
+        device = getattr(hoomd.device, options.device)(notice_level=1)
+        run_scaling_rank(device,
+                         options.worker,
+                         options.worker_output,
+                         N=options.N,
+                         steps=options.steps,
+                         warmup_steps=options.warmup_steps)
+        return 0
+
+    results = run_scaling(names=options.workloads,
+                          ranks=options.ranks,
+                          device=options.device,
+                          N=options.N,
+                          steps=options.steps,
+                          warmup_steps=options.warmup_steps,
+                          launcher=shlex.split(options.launcher))
+
+    if options.output is None:
+        json.dump(results, sys.stdout, indent=2)
+        sys.stdout.write('\n')
+    else:
+        with open(options.output, 'w') as f:
+            json.dump(results, f, indent=2)
+
+    if options.baseline is not None:
+        with open(options.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare_scaling(results, baseline, options.tolerance)
+        for regression in regressions:
+            print(f'Scaling regression: {regression}', file=sys.stderr)
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
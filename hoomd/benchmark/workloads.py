@@ -0,0 +1,238 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Standard benchmark workloads.
+
+Each workload function returns a `hoomd.Simulation` with an initialized state
+and an integrator that is ready to `run <hoomd.Simulation.run>`. The systems
+start on a lattice; `hoomd.benchmark.run_benchmark` runs warm up steps to
+equilibrate them before timing.
+"""
+
+import itertools
+import math
+
+import numpy
+
+import hoomd
+
+
+def _lattice_snapshot(device, N, volume, particle_types, rng, perturb=0.05):
+    """Place N particles on a simple cubic lattice in a cubic box.
+
+    Displace each particle randomly by up to ``perturb`` lattice constants in
+    each direction so that forces do not cancel by symmetry.
+    """
+    snapshot = hoomd.Snapshot(device.communicator)
+    if snapshot.communicator.rank == 0:
+        L = volume**(1 / 3)
+        n = int(math.ceil(N**(1 / 3)))
+        a = L / n
+        snapshot.configuration.box = [L, L, L, 0, 0, 0]
+        snapshot.particles.N = N
+        snapshot.particles.types = particle_types
+
+        grid = numpy.array(list(itertools.product(range(n), repeat=3))[:N])
+        position = (grid + 0.5) * a - L / 2
+        position += rng.uniform(-perturb * a,
+                                perturb * a,
+                                size=position.shape)
+        snapshot.particles.position[:] = position
+    return snapshot
+
+
+def _make_simulation(device, snapshot, seed):
+    sim = hoomd.Simulation(device=device, seed=seed)
+    sim.create_state_from_snapshot(snapshot)
+    return sim
+
+
+def lj_liquid(device, N=64000, density=0.8442, kT=1.2, seed=1):
+    """Lennard-Jones liquid.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of particles.
+        density (float): Number density :math:`[\\mathrm{length}^{-3}]`.
+        kT (float): Langevin thermostat temperature
+            :math:`[\\mathrm{energy}]`.
+        seed (int): Random number seed.
+
+    Single component LJ liquid with :math:`r_\\mathrm{cut} = 2.5`, a cell list
+    and a Langevin thermostat.
+    """
+    rng = numpy.random.default_rng(seed)
+    snapshot = _lattice_snapshot(device, N, N / density, ['A'], rng)
+    sim = _make_simulation(device, snapshot, seed)
+
+    nlist = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=kT)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    forces=[lj],
+                                                    methods=[langevin])
+    return sim
+
+
+def polymer_melt(device, N=64000, chain_length=10, density=0.85, seed=1):
+    """Melt of bead spring polymers.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of monomers. Rounded down to a multiple of
+            ``chain_length``.
+        chain_length (int): Number of monomers per chain.
+        density (float): Monomer number density
+            :math:`[\\mathrm{length}^{-3}]`.
+        seed (int): Random number seed.
+
+    The chains are held together by harmonic bonds and interact with a purely
+    repulsive (WCA) LJ potential that excludes bonded neighbors.
+    """
+    N = (N // chain_length) * chain_length
+    rng = numpy.random.default_rng(seed)
+    snapshot = _lattice_snapshot(device, N, N / density, ['A'], rng)
+    if snapshot.communicator.rank == 0:
+        # consecutive lattice sites are nearest neighbors along the z axis, at
+        # the end of a row the next site is a diagonal neighbor through the
+        # periodic boundary
+        chain_start = numpy.arange(0, N, chain_length)
+        first = (chain_start[:, numpy.newaxis]
+                 + numpy.arange(chain_length - 1)).flatten()
+        snapshot.bonds.N = len(first)
+        snapshot.bonds.types = ['backbone']
+        snapshot.bonds.group[:] = numpy.stack((first, first + 1), axis=1)
+    sim = _make_simulation(device, snapshot, seed)
+
+    nlist = hoomd.md.nlist.Cell(exclusions=('bond',))
+    wca = hoomd.md.pair.LJ(nlist=nlist,
+                           default_r_cut=2**(1 / 6),
+                           mode='shift')
+    wca.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    harmonic = hoomd.md.bond.Harmonic()
+    harmonic.params['backbone'] = dict(k=30.0, r0=1.0)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    forces=[wca, harmonic],
+                                                    methods=[langevin])
+    return sim
+
+
+def pppm_electrolyte(device, N=64000, density=0.5, seed=1):
+    """Charge neutral electrolyte with long range electrostatics.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of ions. Rounded down to an even number.
+        density (float): Ion number density :math:`[\\mathrm{length}^{-3}]`.
+        seed (int): Random number seed.
+
+    Equal numbers of +1 and -1 ions interact with a WCA potential and Coulomb
+    interactions evaluated by `hoomd.md.long_range.pppm`.
+    """
+    N = (N // 2) * 2
+    rng = numpy.random.default_rng(seed)
+    snapshot = _lattice_snapshot(device, N, N / density, ['P', 'M'], rng)
+    if snapshot.communicator.rank == 0:
+        typeid = numpy.arange(N) % 2
+        snapshot.particles.typeid[:] = typeid
+        snapshot.particles.charge[:] = 1 - 2 * typeid
+    sim = _make_simulation(device, snapshot, seed)
+
+    nlist = hoomd.md.nlist.Cell()
+    wca = hoomd.md.pair.LJ(nlist=nlist,
+                           default_r_cut=2**(1 / 6),
+                           mode='shift')
+    wca.params[(['P', 'M'], ['P', 'M'])] = dict(epsilon=1.0, sigma=1.0)
+    L = (N / density)**(1 / 3)
+    grid = 2**int(math.ceil(math.log2(L)))
+    real_space, reciprocal_space = \
+        hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist, resolution=(grid, grid, grid), order=5, r_cut=3.0)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(
+        dt=0.005,
+        forces=[wca, real_space, reciprocal_space],
+        methods=[langevin])
+    return sim
+
+
+def hpmc_spheres(device, N=64000, phi=0.5, seed=1):
+    """Hard sphere fluid.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of spheres.
+        phi (float): Volume fraction.
+        seed (int): Random number seed.
+    """
+    rng = numpy.random.default_rng(seed)
+    volume = N * math.pi / 6 / phi
+    snapshot = _lattice_snapshot(device, N, volume, ['A'], rng, perturb=0)
+    sim = _make_simulation(device, snapshot, seed)
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1.0)
+    sim.operations.integrator = mc
+    return sim
+
+
+def hpmc_polyhedra(device, N=32000, phi=0.4, seed=1):
+    """Hard cube fluid.
+
+    Args:
+        device (`hoomd.device.Device`): Device to execute on.
+        N (int): Number of cubes.
+        phi (float): Volume fraction.
+        seed (int): Random number seed.
+
+    Unit cubes simulated with `hoomd.hpmc.integrate.ConvexPolyhedron`.
+    """
+    rng = numpy.random.default_rng(seed)
+    snapshot = _lattice_snapshot(device, N, N / phi, ['A'], rng, perturb=0)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.orientation[:] = [1, 0, 0, 0]
+    sim = _make_simulation(device, snapshot, seed)
+
+    mc = hoomd.hpmc.integrate.ConvexPolyhedron(default_d=0.1, default_a=0.1)
+    vertices = list(itertools.product([-0.5, 0.5], repeat=3))
+    mc.shape['A'] = dict(vertices=vertices)
+    sim.operations.integrator = mc
+    return sim
+
+
+def _mpcd_workload(name):
+    """Make a workload that imports `hoomd.benchmark.mpcd_workloads` lazily.
+
+    The MPCD workloads require ``hoomd.mpcd``, which is not always built.
+    """
+
+    def make(device, **kwargs):
+        from hoomd.benchmark import mpcd_workloads
+        return getattr(mpcd_workloads, name)(device, **kwargs)
+
+    make.__doc__ = f'See `hoomd.benchmark.mpcd_workloads.{name}`.'
+    return make
+
+
+workloads = {
+    'lj_liquid_0.6': lambda device, **kw: lj_liquid(device, density=0.6, **kw),
+    'lj_liquid_0.8442': lambda device, **kw: lj_liquid(device, **kw),
+    'lj_liquid_1.0': lambda device, **kw: lj_liquid(device, density=1.0, **kw),
+    'polymer_melt': polymer_melt,
+    'pppm_electrolyte': pppm_electrolyte,
+    'hpmc_spheres': hpmc_spheres,
+    'hpmc_polyhedra': hpmc_polyhedra,
+    'mpcd_srd': _mpcd_workload('mpcd_srd'),
+    'mpcd_at': _mpcd_workload('mpcd_at'),
+    'mpcd_couette': _mpcd_workload('mpcd_couette'),
+    'mpcd_slit_pore': _mpcd_workload('mpcd_slit_pore'),
+    'mpcd_polymer': _mpcd_workload('mpcd_polymer'),
+}
+"""dict[str, callable]: Standard workloads by name.
+
+Each callable takes a `hoomd.device.Device` as its first argument and keyword
+arguments that are forwarded to the workload function.
+"""
@@ -412,6 +412,78 @@ def operation_pickling_check(instance, sim):
     pickling_check(instance)
 
 
+def forces_equality_check(simulation_factory,
+                          snapshot,
+                          make_integrator,
+                          values=(False, True),
+                          toggle=None,
+                          steps=0,
+                          sum_forces=False,
+                          rtol=1e-6,
+                          atol=1e-9):
+    """Test that simulations that differ in one setting compute equal forces.
+
+    For each of ``values``, run a simulation of ``snapshot`` with the
+    integrator ``make_integrator(value)`` for ``steps`` steps. Then compare the
+    forces, energies, and virials of the integrator's forces and outer forces
+    (and the particle positions when ``steps > 0``) to those of the first value.
+
+    Args:
+        simulation_factory: The ``simulation_factory`` fixture.
+        snapshot (hoomd.Snapshot): Initial condition.
+        make_integrator (callable): Returns a new `hoomd.md.Integrator` that
+            applies the setting ``value``.
+        values (tuple): Values of the setting.
+        toggle (callable): When given, ``toggle(integrator)`` must return the
+            value of the setting after the run.
+        steps (int): Number of steps to run.
+        sum_forces (bool): Compare the sums of the quantities over the forces,
+            for settings that change which forces the integrator holds.
+        rtol (float): Relative tolerance.
+        atol (float or tuple[float]): Absolute tolerance, or one each for the
+            forces (and positions), energies, and virials.
+
+    Returns:
+        list[hoomd.Simulation]: The simulation of each value.
+    """
+    simulations = []
+    results = []
+    for value in values:
+        integrator = make_integrator(value)
+        sim = simulation_factory(snapshot)
+        sim.operations.integrator = integrator
+        sim.always_compute_pressure = True
+        sim.run(steps)
+        if toggle is not None:
+            assert toggle(integrator) == value
+
+        # all ranks take part in gathering the quantities
+        forces = list(integrator.forces)
+        forces += list(getattr(integrator, 'outer_forces', []))
+        quantities = [[f.forces, f.energies, f.virials] for f in forces]
+        final = sim.state.get_snapshot() if steps > 0 else None
+
+        simulations.append(sim)
+        if sim.device.communicator.rank == 0:
+            if sum_forces:
+                quantities = [[sum(q) for q in zip(*quantities)]]
+            if final is not None:
+                quantities.append([final.particles.position])
+            results.append(quantities)
+
+    atol = numpy.broadcast_to(atol, (3,))
+    for result in results[1:]:
+        assert len(result) == len(results[0])
+        for reference_arrays, arrays in zip(results[0], result):
+            for reference, array, tolerance in zip(reference_arrays, arrays,
+                                                   atol):
+                numpy.testing.assert_allclose(array,
+                                              reference,
+                                              rtol=rtol,
+                                              atol=tolerance)
+    return simulations
+
+
 class BlockAverage:
     """Block average method for estimating standard deviation of the mean.
 
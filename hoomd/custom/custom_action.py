@@ -37,8 +37,9 @@ class Action(metaclass=_AbstractLoggable):
                 self.com = self._state.snapshot.particles.position.mean(axis=0)
 
     To request that HOOMD-blue compute virials, pressure, the rotational kinetic
-    energy, or the external field virial, set the flags attribute with the
-    appropriate flags from the internal `Action.Flags` enumeration.
+    energy, the external field virial, or the force arrays of each force, set
+    the flags attribute with the appropriate flags from the internal
+    `Action.Flags` enumeration.
 
     .. code-block:: python
 
@@ -82,10 +83,12 @@ class Action(metaclass=_AbstractLoggable):
         * PRESSURE_TENSOR = 0
         * ROTATIONAL_KINETIC_ENERGY = 1
         * EXTERNAL_FIELD_VIRIAL = 2
+        * FORCE_ARRAYS = 3
         """
         PRESSURE_TENSOR = 0
         ROTATIONAL_KINETIC_ENERGY = 1
         EXTERNAL_FIELD_VIRIAL = 2
+        FORCE_ARRAYS = 3
 
     flags = []
     log_quantities = {}
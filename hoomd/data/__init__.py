@@ -7,3 +7,4 @@ from .local_access import (AngleLocalAccessBase, BondLocalAccessBase,
                            ParticleLocalAccessBase)
 from .local_access_cpu import LocalSnapshot
 from .local_access_gpu import LocalSnapshotGPU
+from .tag_ordered import TagOrderedParticles
@@ -459,6 +459,24 @@ class HOOMDArray(metaclass=_wrap_class_factory(_wrap_list)):
         return np.array(self._coerce_to_ndarray(),
                         copy=True).__array_interface__
 
+    def __dlpack__(self, stream=None):
+        """Export the underlying data buffer as a DLPack capsule.
+
+        The capsule points to HOOMD-blue's memory and is only valid inside the
+        context manager in which the array was created. DLPack cannot mark
+        tensors as read only, so do not write to tensors made from read only
+        arrays.
+        """
+        if not self._callback():
+            raise HOOMDArrayError(
+                "Cannot access {} outside context manager.".format(
+                    self.__class__.__name__))
+        return self._buffer.__dlpack__(stream=stream)
+
+    def __dlpack_device__(self):
+        """tuple[int, int]: The DLPack device type and id of the buffer."""
+        return self._buffer.__dlpack_device__()
+
     def _coerce_to_ndarray(self):
         """Provide a `numpy.ndarray` interface to the underlying buffer.
 
@@ -549,6 +567,24 @@ if hoomd.version.gpu_enabled:
         def __cuda_array_interface__(self):
             return deepcopy(self._buffer.__cuda_array_interface__)
 
+        def __dlpack__(self, stream=None):
+            """Export the underlying data buffer as a DLPack capsule.
+
+            The capsule is only valid inside the context manager in which the
+            array was created. Unless ``stream`` is None or 1 (the legacy
+            default stream), the device synchronizes before the capsule is
+            returned.
+            """
+            if not self._callback():
+                raise HOOMDArrayError(
+                    "Cannot access {} outside context manager.".format(
+                        self.__class__.__name__))
+            return self._buffer.__dlpack__(stream=stream)
+
+        def __dlpack_device__(self):
+            """tuple[int, int]: The DLPack device type and id of the buffer."""
+            return self._buffer.__dlpack_device__()
+
         @property
         def read_only(self):
             return self._buffer.read_only
@@ -771,7 +807,10 @@ Note:
     installed. Any package that supports version 2 of the
     `__cuda_array_interface__
     <https://numba.pydata.org/numba-doc/latest/cuda/cuda_array_interface.html>`_
-    should support the direct use of `HOOMDGPUArray` objects.
+    should support the direct use of `HOOMDGPUArray` objects. `HOOMDGPUArray`
+    and `HOOMDArray` also implement the DLPack protocol (``__dlpack__`` and
+    ``__dlpack_device__``), so ``torch.from_dlpack`` and similar functions
+    wrap the data without a copy.
 
 """
 
@@ -127,13 +127,40 @@ class _ValidatedDefaultDict(MutableMapping):
 
     def __setitem__(self, keys, item):
         """Set parameter by key."""
-        keys = self._yield_keys(keys)
+        keys = list(self._yield_keys(keys))
         try:
             validated_value = self._validate_values(item)
         except ValueError as err:
-            raise err.__class__(f"For types {list(keys)} {str(err)}.") from err
-        for key in keys:
-            self._single_setitem(key, validated_value)
+            raise err.__class__(f"For types {keys} {str(err)}.") from err
+        self._multi_setitem(keys, [validated_value] * len(keys))
+
+    def _multi_setitem(self, keys, items):
+        """Set the parameters of many keys, one item per key."""
+        for key, item in zip(keys, items):
+            self._single_setitem(key, item)
+
+    def set_array(self, keys, values):
+        """Set the parameters of many keys at once.
+
+        Args:
+            keys (list): One key per row of ``values``.
+            values (numpy.ndarray): Structured array with one field per
+                parameter, or a sequence of parameter values.
+        """
+        keys = [key for k in keys for key in self._yield_keys(k)]
+        if len(keys) != len(values):
+            raise ValueError(f"Expected {len(keys)} values, got {len(values)}.")
+
+        names = getattr(getattr(values, 'dtype', None), 'names', None)
+        validated_values = []
+        for key, value in zip(keys, values):
+            if names is not None:
+                value = {name: value[name] for name in names}
+            try:
+                validated_values.append(self._validate_values(value))
+            except ValueError as err:
+                raise err.__class__(f"For type {key} {str(err)}.") from err
+        self._multi_setitem(keys, validated_values)
 
     def __delitem__(self, key):
         raise NotImplementedError("__delitem__ is not defined for this type.")
@@ -387,13 +414,16 @@ class AttachedTypeParameterDict(_ValidatedDefaultDict):
         self._default = type_param_dict._default
         self._type_converter = type_param_dict._type_converter
         # add all types to c++
-        for key in self:
+        keys = list(self)
+        parameters = []
+        for key in keys:
             parameter = type_param_dict._single_getitem(key)
             try:
                 _raise_if_required_arg(parameter)
             except IncompleteSpecificationError as err:
                 raise IncompleteSpecificationError(f"for key {key} {str(err)}")
-            self._single_setitem(key, parameter)
+            parameters.append(parameter)
+        self._multi_setitem(keys, parameters)
 
     def to_detached(self):
         """Convert to a detached parameter dict."""
@@ -416,6 +446,31 @@ class AttachedTypeParameterDict(_ValidatedDefaultDict):
         """Set parameter by key."""
         getattr(self._cpp_obj, self._setter)(key, item)
 
+    def _multi_setitem(self, keys, items):
+        """Set the parameters of many keys in one call to C++ when possible.
+
+        C++ classes may export a ``set<Name>Bulk`` method that takes the list
+        of keys and either a dict mapping each parameter name to a list of
+        values (for dict valued parameters) or the list of values.
+        """
+        bulk_setter = getattr(self._cpp_obj, self._setter + "Bulk", None)
+        if bulk_setter is None or len(keys) < 2:
+            super()._multi_setitem(keys, items)
+            return
+
+        if not any(isinstance(item, dict) for item in items):
+            bulk_setter(list(keys), list(items))
+            return
+
+        names = items[0].keys()
+        if any(not isinstance(item, dict) or item.keys() != names
+               for item in items):
+            super()._multi_setitem(keys, items)
+            return
+
+        columns = {name: [item[name] for item in items] for name in names}
+        bulk_setter(list(keys), columns)
+
     def _yield_keys(self, key):
         """Includes key check for existing simulation keys.
 
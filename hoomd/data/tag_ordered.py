@@ -0,0 +1,89 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Read particle data in tag order without a snapshot."""
+
+from hoomd import _hoomd
+
+
+class TagOrderedParticles:
+    """Read-only views of the particle data in tag order.
+
+    `TagOrderedParticles` exposes the same particle properties as
+    `hoomd.Snapshot.particles`, ordered by particle tag, without building a
+    snapshot. Each property is a read-only `numpy.ndarray` backed by a
+    persistent buffer. Reading a property gathers the data again only when
+    the particles were sorted, added, or removed, or when the property changed
+    since the last read. Repeated reads in analysis loops are therefore much
+    cheaper than `State.get_snapshot`.
+
+    Access `TagOrderedParticles` through `State.tag_ordered_particles`:
+
+    .. code-block:: python
+
+        positions = sim.state.tag_ordered_particles.position
+
+    Warning:
+        Later reads update the arrays in place. Copy an array to keep its
+        values past the next read of the same property.
+
+    Note:
+        The arrays have the precision of the simulation. Domain decomposed
+        simulations do not support `TagOrderedParticles`.
+
+    Attributes:
+        position ((N_particles, 3) `numpy.ndarray` of ``float``):
+            Particle positions :math:`[\\mathrm{length}]`.
+        typeid ((N_particles) `numpy.ndarray` of ``uint32``):
+            Particle type ids.
+        velocity ((N_particles, 3) `numpy.ndarray` of ``float``):
+            Particle velocities :math:`[\\mathrm{velocity}]`.
+        mass ((N_particles) `numpy.ndarray` of ``float``):
+            Particle masses :math:`[\\mathrm{mass}]`.
+        orientation ((N_particles, 4) `numpy.ndarray` of ``float``):
+            Particle orientations expressed as quaternions.
+        angmom ((N_particles, 4) `numpy.ndarray` of ``float``):
+            Particle angular momenta expressed as quaternions
+            :math:`[\\mathrm{mass} \\cdot \\mathrm{velocity} \\cdot
+            \\mathrm{length}]`.
+        moment_inertia ((N_particles, 3) `numpy.ndarray` of ``float``):
+            Particle principal moments of inertia
+            :math:`[\\mathrm{mass} \\cdot \\mathrm{length}^2]`.
+        charge ((N_particles) `numpy.ndarray` of ``float``):
+            Particle electrical charges :math:`[\\mathrm{charge}]`.
+        diameter ((N_particles) `numpy.ndarray` of ``float``):
+            Particle diameters :math:`[\\mathrm{length}]`.
+        image ((N_particles, 3) `numpy.ndarray` of ``int32``):
+            The periodic image each particle occupies.
+        body ((N_particles) `numpy.ndarray` of ``uint32``):
+            The id of the rigid body each particle is in.
+    """
+
+    _fields = {
+        'position': 'getPosition',
+        'typeid': 'getTypes',
+        'velocity': 'getVelocities',
+        'mass': 'getMasses',
+        'orientation': 'getOrientation',
+        'angmom': 'getAngularMomentum',
+        'moment_inertia': 'getMomentsOfInertia',
+        'charge': 'getCharge',
+        'diameter': 'getDiameter',
+        'image': 'getImages',
+        'body': 'getBodies'
+    }
+
+    def __init__(self, state):
+        self._state = state
+        self._cpp_obj = _hoomd.TagOrderedParticleData(
+            state._cpp_sys_def.getParticleData())
+
+    def __getattr__(self, attr):
+        if attr not in self._fields:
+            raise AttributeError("{} object has no attribute {}".format(
+                type(self), attr))
+        if self._state._in_context_manager:
+            raise RuntimeError(
+                "Cannot read tag ordered particles inside a local snapshot.")
+        return getattr(self._cpp_obj, self._fields[attr])()
@@ -176,6 +176,30 @@ class TypeParameter(MutableMapping):
         """
         self.param_dict.setdefault(key, default)
 
+    def set_array(self, keys, values):
+        """Set the values of many keys at once.
+
+        Args:
+            keys (list): One key per row of ``values``.
+            values (numpy.ndarray): Structured array with one field per
+                parameter (or a sequence of values), one row per key.
+
+        `set_array` validates all rows before it sets any of them. Attached
+        pair, bond, and angle potentials receive all parameters in a single
+        call to C++, which is much faster than setting many type pairs one at a
+        time.
+
+        .. code-block:: python
+
+            pairs = list(itertools.combinations_with_replacement(types, 2))
+            params = numpy.zeros(len(pairs),
+                                 dtype=[('epsilon', float), ('sigma', float)])
+            params['epsilon'] = ...
+            params['sigma'] = ...
+            lj.params.set_array(pairs, params)
+        """
+        self.param_dict.set_array(keys, values)
+
     def __eq__(self, other):
         """Test for equality."""
         return self.name == other.name and \
@@ -180,6 +180,18 @@ void DEM2DForceCompute<Real, Real4, Potential>::setParams(unsigned int type,
         }
 
     m_shapes[type] = points;
+
+    // bounding circles for culling, edge k connects vertex k to vertex (k + 1) % N
+    m_typeRadius.resize(m_shapes.size(), Real(0));
+    m_edgeRadius.resize(m_shapes.size());
+    m_typeRadius[type] = Real(0);
+    m_edgeRadius[type].resize(points.size());
+    for (size_t k(0); k < points.size(); ++k)
+        {
+        const vec2<Real> edge(points[(k + 1) % points.size()] - points[k]);
+        m_typeRadius[type] = max(m_typeRadius[type], sqrt(dot(points[k], points[k])));
+        m_edgeRadius[type][k] = Real(0.5) * sqrt(dot(edge, edge));
+        }
     }
 
 /*! \post The DEM2D forces are computed for the given timestep. The neighborlist's
@@ -334,6 +346,14 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
             // only compute the force if the particles are closer than the cutoff (FLOPS: 1)
             if (m_evaluator.withinCutoff(rsq, r_cut_sq))
                 {
+                // largest distance between interacting features of i and j
+                const Real maxDist(m_evaluator.maxFeatureDistance());
+
+                // skip the pair when the bounding circles of the shapes are too far apart
+                const Real pairReach(m_typeRadius[typei] + m_typeRadius[typej] + maxDist);
+                if (maxDist < 0 || rsq > pairReach * pairReach)
+                    continue;
+
                 // local forces and torques for particles i and j
                 vec2<Real> forceij, forceji;
                 Real torqueij(0), torqueji(0), potentialij(0);
@@ -348,15 +368,28 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 // Iterate over each vertex of particle i, if particle j has any edges
                 if (vertices_j.size() > 1)
                     {
+                    const vector<Real>& edgeRadiusj(m_edgeRadius[typej]);
+                    const Real reachj(m_typeRadius[typej] + maxDist);
                     for (typename vector<vec2<Real>>::const_iterator viIter(vertices_i.begin());
                          viIter != vertices_i.end();
                          ++viIter)
                         {
+                        // skip the vertex when it is out of reach of the whole shape j
+                        const vec2<Real> r0j(*viIter - dx);
+                        if (dot(r0j, r0j) > reachj * reachj)
+                            continue;
+
                         // iterate over each edge of particle j
                         for (typename vector<vec2<Real>>::const_iterator vjIter(vertices_j.begin());
                              vjIter + 1 != vertices_j.end();
                              ++vjIter)
                             {
+                            const vec2<Real> r(r0j - Real(0.5) * (*vjIter + *(vjIter + 1)));
+                            const Real edgeReach(edgeRadiusj[vjIter - vertices_j.begin()]
+                                                 + maxDist);
+                            if (dot(r, r) > edgeReach * edgeReach)
+                                continue;
+
                             m_evaluator.vertexEdge(dx,
                                                    *viIter,
                                                    *vjIter,
@@ -385,15 +418,28 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 // iterate over each vertex of particle j, if vi has any edges
                 if (vertices_i.size() > 1)
                     {
+                    const vector<Real>& edgeRadiusi(m_edgeRadius[typei]);
+                    const Real reachi(m_typeRadius[typei] + maxDist);
                     for (typename vector<vec2<Real>>::const_iterator vjIter(vertices_j.begin());
                          vjIter != vertices_j.end();
                          ++vjIter)
                         {
+                        // skip the vertex when it is out of reach of the whole shape i
+                        const vec2<Real> r0i(*vjIter + dx);
+                        if (dot(r0i, r0i) > reachi * reachi)
+                            continue;
+
                         // iterate over each edge of particle i
                         for (typename vector<vec2<Real>>::const_iterator viIter(vertices_i.begin());
                              viIter + 1 != vertices_i.end();
                              ++viIter)
                             {
+                            const vec2<Real> r(r0i - Real(0.5) * (*viIter + *(viIter + 1)));
+                            const Real edgeReach(edgeRadiusi[viIter - vertices_i.begin()]
+                                                 + maxDist);
+                            if (dot(r, r) > edgeReach * edgeReach)
+                                continue;
+
                             m_evaluator.vertexEdge(-dx,
                                                    *vjIter,
                                                    *viIter,
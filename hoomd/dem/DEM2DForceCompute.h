@@ -36,6 +36,11 @@
   Forces can be computed directly by calling compute() and then retrieved with a call to acquire(),
   but a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+  Broad phase culling on the CPU: setParams() computes the radius of the circle bounding each type
+  and the half length of each edge. computeForces() skips particle pairs, vertices, and edges whose
+  bounding circles are further apart than the largest interacting feature distance of the
+  potential.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -98,6 +103,8 @@ class DEM2DForceCompute : public ForceCompute
     DEMEvaluator<Real, Real4, Potential>
         m_evaluator; //!< Object holding parameters and computation method for the potential
     std::vector<std::vector<vec2<Real>>> m_shapes; //!< Vertices for each type
+    std::vector<Real> m_typeRadius; //!< Radius of the circle bounding the vertices of each type
+    std::vector<std::vector<Real>> m_edgeRadius; //!< Half length of each edge of each type
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -445,6 +445,72 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         size_t faceSize = m_facesVec[shapeIdx].size();
         h_numTypeFaces.data[shapeIdx] = (unsigned int)faceSize;
         }
+
+    // build the bounding spheres used for culling on the CPU
+    m_typeRadius.assign(nTypes, Real(0));
+    for (size_t shapeIdx(0); shapeIdx < m_shapes.size(); ++shapeIdx)
+        {
+        for (size_t vertIdx(0); vertIdx < m_shapes[shapeIdx].size(); ++vertIdx)
+            {
+            const vec3<Real>& vertex(m_shapes[shapeIdx][vertIdx]);
+            m_typeRadius[shapeIdx] = max(m_typeRadius[shapeIdx], sqrt(dot(vertex, vertex)));
+            }
+        }
+
+    // faces without a plane (fewer than three vertices) get a zero normal, which never culls
+    m_faceCenter.assign(nFaces, vec3<Real>());
+    m_faceNormal.assign(nFaces, vec3<Real>());
+    m_faceRadius.assign(nFaces, Real(0));
+    for (size_t shapeIdx(0); shapeIdx < m_facesVec.size(); ++shapeIdx)
+        {
+        if (m_facesVec[shapeIdx].empty())
+            continue;
+
+        size_t faceIdx(shapeIdx);
+        do
+            {
+            const unsigned int firstVert(h_firstFaceVert.data[faceIdx]);
+            vec3<Real> center, normal;
+            unsigned int count(0);
+            unsigned int vert(firstVert);
+            do
+                {
+                const vec3<Real> p0(h_verts.data[h_realVertIndex.data[vert]]);
+                const vec3<Real> p1(h_verts.data[h_realVertIndex.data[h_nextFaceVert.data[vert]]]);
+                center += p0;
+                // Newell's method
+                normal += cross(p0, p1);
+                ++count;
+                vert = h_nextFaceVert.data[vert];
+                } while (vert != firstVert);
+            center /= Real(count);
+
+            Real radius(0);
+            do
+                {
+                const vec3<Real> r(vec3<Real>(h_verts.data[h_realVertIndex.data[vert]]) - center);
+                radius = max(radius, sqrt(dot(r, r)));
+                vert = h_nextFaceVert.data[vert];
+                } while (vert != firstVert);
+
+            const Real normalLength(sqrt(dot(normal, normal)));
+            m_faceCenter[faceIdx] = center;
+            m_faceNormal[faceIdx] = count > 2 && normalLength > 0 ? normal / normalLength
+                                                                  : vec3<Real>();
+            m_faceRadius[faceIdx] = radius;
+            faceIdx = h_nextFace.data[faceIdx];
+            } while (faceIdx != shapeIdx);
+        }
+
+    m_edgeCenter.resize(nEdges);
+    m_edgeRadius.resize(nEdges);
+    for (size_t edgeIdx(0); edgeIdx < nEdges; ++edgeIdx)
+        {
+        const vec3<Real> p0(h_verts.data[h_edges.data[2 * edgeIdx]]);
+        const vec3<Real> p1(h_verts.data[h_edges.data[2 * edgeIdx + 1]]);
+        m_edgeCenter[edgeIdx] = Real(0.5) * (p0 + p1);
+        m_edgeRadius[edgeIdx] = Real(0.5) * sqrt(dot(p1 - p0, p1 - p0));
+        }
     }
 
 /*!
@@ -747,24 +813,52 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
             // only compute the force if the particles are closer than the cutoff (FLOPS: 1)
             if (m_evaluator.withinCutoff(rsq, r_cut_sq))
                 {
+                // largest distance between interacting features of i and j
+                const Real maxDist(m_evaluator.maxFeatureDistance());
+
+                // skip the pair when the bounding spheres of the shapes are too far apart
+                const Real pairReach(m_typeRadius[typei] + m_typeRadius[typej] + maxDist);
+                if (maxDist < 0 || rsq > pairReach * pairReach)
+                    continue;
+
                 // local forces and torques for particles i and j
                 vec3<Real> forceij, forceji;
                 vec3<Real> torqueij, torqueji;
                 Real potentialij(0);
 
+                // inverse rotations into the body frames of i and j
+                const quat<Real> quatiInv(conj(quat<Real>(quati)));
+                const quat<Real> quatjInv(conj(quat<Real>(quatj)));
+
                 // iterate over each vertex in particle i
+                const Real reachj(m_typeRadius[typej] + maxDist);
                 for (size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
                     {
                     const vec3<Real> vertex0(
                         rotate(quati,
                                vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
 
+                    // skip the vertex when it is out of reach of the whole shape j
+                    const vec3<Real> vertex0j(rotate(quatjInv, vertex0 - dx));
+                    if (dot(vertex0j, vertex0j) > reachj * reachj)
+                        continue;
+
                     // iterate over each face in particle j
                     size_t faceIndex(typej);
                     if (h_numTypeFaces.data[typej] > 0)
                         {
                         do
                             {
+                            // skip faces whose plane or bounding sphere is out of reach
+                            const vec3<Real> r(vertex0j - m_faceCenter[faceIndex]);
+                            const Real faceReach(m_faceRadius[faceIndex] + maxDist);
+                            if (dot(r, r) > faceReach * faceReach
+                                || fabs(dot(r, m_faceNormal[faceIndex])) > maxDist)
+                                {
+                                faceIndex = h_nextFace.data[faceIndex];
+                                continue;
+                                }
+
                             m_evaluator.vertexFace(dx,
                                                    vertex0,
                                                    quatj,
@@ -786,6 +880,12 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         // iterate over all edges of j
                         for (size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                             {
+                            const size_t edgeIndex(edgej + h_firstTypeEdge.data[typej]);
+                            const vec3<Real> r(vertex0j - m_edgeCenter[edgeIndex]);
+                            const Real edgeReach(m_edgeRadius[edgeIndex] + maxDist);
+                            if (dot(r, r) > edgeReach * edgeReach)
+                                continue;
+
                             vec3<Real> p10(
                                 h_verts
                                     .data[h_edges.data[2 * (edgej + h_firstTypeEdge.data[typej])]]);
@@ -828,18 +928,34 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                     }
 
                 // iterate over each vertex in particle j
+                const Real reachi(m_typeRadius[typei] + maxDist);
                 for (size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typej]; ++vertIndex)
                     {
                     const vec3<Real> vertex0(
                         rotate(quatj,
                                vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
 
+                    // skip the vertex when it is out of reach of the whole shape i
+                    const vec3<Real> vertex0i(rotate(quatiInv, vertex0 + dx));
+                    if (dot(vertex0i, vertex0i) > reachi * reachi)
+                        continue;
+
                     // iterate over each face in particle i
                     size_t faceIndex(typei);
                     if (h_numTypeFaces.data[typei] > 0)
                         {
                         do
                             {
+                            // skip faces whose plane or bounding sphere is out of reach
+                            const vec3<Real> r(vertex0i - m_faceCenter[faceIndex]);
+                            const Real faceReach(m_faceRadius[faceIndex] + maxDist);
+                            if (dot(r, r) > faceReach * faceReach
+                                || fabs(dot(r, m_faceNormal[faceIndex])) > maxDist)
+                                {
+                                faceIndex = h_nextFace.data[faceIndex];
+                                continue;
+                                }
+
                             m_evaluator.vertexFace(-dx,
                                                    vertex0,
                                                    quati,
@@ -861,6 +977,12 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         // iterate over all edges of i
                         for (size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                             {
+                            const size_t edgeIndex(edgei + h_firstTypeEdge.data[typei]);
+                            const vec3<Real> r(vertex0i - m_edgeCenter[edgeIndex]);
+                            const Real edgeReach(m_edgeRadius[edgeIndex] + maxDist);
+                            if (dot(r, r) > edgeReach * edgeReach)
+                                continue;
+
                             vec3<Real> p10(
                                 h_verts
                                     .data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei])]]);
@@ -889,6 +1011,16 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 // iterate over all pairs of edges
                 for (size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                     {
+                    // center of edge i in the body frame of j, skip the edge when it is out of
+                    // reach of the whole shape j
+                    const size_t edgeIndexi(edgei + h_firstTypeEdge.data[typei]);
+                    const vec3<Real> centeri(
+                        rotate(quatjInv, rotate(quati, m_edgeCenter[edgeIndexi]) - dx));
+                    const Real edgeReachi(m_edgeRadius[edgeIndexi] + maxDist);
+                    if (dot(centeri, centeri)
+                        > (edgeReachi + m_typeRadius[typej]) * (edgeReachi + m_typeRadius[typej]))
+                        continue;
+
                     vec3<Real> p00(
                         h_verts.data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei])]]);
                     vec3<Real> p01(
@@ -899,6 +1031,12 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                     // iterate over all edges of j
                     for (size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                         {
+                        const size_t edgeIndexj(edgej + h_firstTypeEdge.data[typej]);
+                        const vec3<Real> r(centeri - m_edgeCenter[edgeIndexj]);
+                        const Real edgeReach(edgeReachi + m_edgeRadius[edgeIndexj]);
+                        if (dot(r, r) > edgeReach * edgeReach)
+                            continue;
+
                         vec3<Real> p10(
                             h_verts.data[h_edges.data[2 * (edgej + h_firstTypeEdge.data[typej])]]);
                         vec3<Real> p11(
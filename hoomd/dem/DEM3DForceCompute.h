@@ -58,6 +58,11 @@
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
 
+  Broad phase culling on the CPU: createGeometry() also computes a bounding sphere for each type,
+  face, and edge and the unit normal of each face in the body frame. computeForces() skips particle
+  pairs, vertices, faces, and edges whose bounding spheres (or, for faces, planes) are further
+  apart than the largest interacting feature distance of the potential.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -153,6 +158,13 @@ class DEM3DForceCompute : public ForceCompute
     std::vector<std::vector<vec3<Real>>> m_shapes;                  //!< Vertices for each type
     std::vector<std::vector<std::vector<unsigned int>>> m_facesVec; //!< Faces for each type
 
+    std::vector<Real> m_typeRadius;       //!< type->radius of the sphere bounding the vertices
+    std::vector<vec3<Real>> m_faceCenter; //!< face index->center of the face
+    std::vector<vec3<Real>> m_faceNormal; //!< face index->unit normal of the face
+    std::vector<Real> m_faceRadius;       //!< face index->radius of the sphere bounding the face
+    std::vector<vec3<Real>> m_edgeCenter; //!< edge index->midpoint of the edge
+    std::vector<Real> m_edgeRadius;       //!< edge index->half length of the edge
+
     //! Re-send the list of vertices and links to the GPU
     void createGeometry();
 
@@ -143,6 +143,14 @@ template<typename Real, typename Real4, typename Potential> class DEMEvaluator
         return m_potential.withinCutoff(rsq, r_cut_sq);
         }
 
+    /*! Largest distance between a vertex, edge, or face of particle i and one of particle j at
+      which the potential is nonzero. Features further apart than this can be skipped.
+     */
+    DEVICE inline Real maxFeatureDistance() const
+        {
+        return m_potential.maxFeatureDistance();
+        }
+
     DEVICE static bool needsDiameter()
         {
         return Potential::needsDiameter();
@@ -81,6 +81,13 @@ template<typename Real, typename Real4, typename FrictionModel> class SWCAPotent
         return rmd * rmd < r_cut_sq;
         }
 
+    /*! Largest distance between two shape features that interact, valid after setDiameter()
+     */
+    DEVICE inline Real maxFeatureDistance() const
+        {
+        return sqrt(m_rcutsq) + m_delta;
+        }
+
     //! Test if potential needs the diameter
     DEVICE static bool needsDiameter()
         {
@@ -18,9 +18,17 @@ class Device:
 
     .. rubric:: TBB threads
 
-    Set `num_cpu_threads` to `None` and TBB will auto-select the number of CPU
-    threads to execute. If the environment variable ``OMP_NUM_THREADS`` is set,
-    HOOMD will use this value. You can also set `num_cpu_threads` explicitly.
+    Set `num_cpu_threads` to `None` and HOOMD will use one thread per core
+    assigned to the MPI rank. When the MPI launcher binds the ranks to cores or
+    sockets, these are the cores in the binding. Otherwise, the ranks on a node
+    split its cores evenly. This allows hybrid runs with a few MPI ranks per
+    node (for example, one per socket) that thread over the rest of the cores,
+    which reduces the ghost particle volume and the number of MPI messages. If
+    the environment variable ``OMP_NUM_THREADS`` is set, HOOMD will use this
+    value. You can also set `num_cpu_threads` explicitly.
+
+    Set `pin_cpu_threads` to `True` to pin each thread to one of the rank's
+    cores (Linux only).
 
     Note:
         At this time **very few** features in HOOMD use TBB for threading.
@@ -43,6 +51,7 @@ class Device:
 
         # name of the message file
         self._msg_file = msg_file
+        self._msg_per_rank = False
 
     @property
     def communicator(self):
@@ -96,10 +105,43 @@ class Device:
     def msg_file(self, fname):
         self._msg_file = fname
         if fname is not None:
-            self._cpp_msg.openFile(fname)
+            self._cpp_msg.openFile(fname, self._msg_per_rank)
         else:
             self._cpp_msg.openStd()
 
+    @property
+    def msg_per_rank(self):
+        """bool: Write a separate message file on each MPI rank.
+
+        When `msg_per_rank` is `True`, each rank writes its messages to
+        ``f'{msg_file}.{rank}'`` and prints notices, not only rank 0. This
+        avoids the shared file in large MPI jobs and shows messages from all
+        ranks. `msg_per_rank` has no effect when `msg_file` is `None`.
+        """
+        return self._msg_per_rank
+
+    @msg_per_rank.setter
+    def msg_per_rank(self, per_rank):
+        self._msg_per_rank = bool(per_rank)
+        if self._msg_file is not None:
+            self._cpp_msg.openFile(self._msg_file, self._msg_per_rank)
+
+    @property
+    def msg_buffered(self):
+        """bool: Buffer notice messages and write them on a background thread.
+
+        When `msg_buffered` is `True`, printing a notice appends it to an
+        in-memory buffer and a background thread writes the buffer to the
+        message file or stream. Simulations do not wait on the file system or
+        on Python's ``sys.stdout``, which helps at high notice levels. Warnings
+        and errors are still written immediately, after any buffered notices.
+        """
+        return self._cpp_msg.getBuffered()
+
+    @msg_buffered.setter
+    def msg_buffered(self, buffered):
+        self._cpp_msg.setBuffered(bool(buffered))
+
     @property
     def devices(self):
         """list[str]: Descriptions of the active hardware devices."""
@@ -122,6 +164,106 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def pin_cpu_threads(self):
+        """bool: Pin each TBB thread to one of the cores of this rank.
+
+        Threads that have already run keep their affinity when
+        `pin_cpu_threads` is set to `False`.
+        """
+        return self._cpp_exec_conf.getThreadPinning()
+
+    @pin_cpu_threads.setter
+    def pin_cpu_threads(self, pin_cpu_threads):
+        if not hoomd.version.tbb_enabled:
+            self._cpp_msg.warning(
+                "HOOMD was compiled without thread support, ignoring request "
+                "to pin threads.\n")
+        else:
+            self._cpp_exec_conf.setThreadPinning(bool(pin_cpu_threads))
+
+    @property
+    def huge_pages(self):
+        """bool: Back large host arrays with transparent huge pages.
+
+        When `huge_pages` is `True`, host arrays of at least 2 MiB are aligned
+        to 2 MiB and the operating system is asked to back them with
+        transparent huge pages, which reduces TLB misses in the force loops.
+        Set `huge_pages` before creating the simulation state, it applies to
+        arrays allocated afterwards. The setting has no effect when the
+        operating system does not support transparent huge pages.
+        """
+        return self._cpp_exec_conf.getHugePages()
+
+    @huge_pages.setter
+    def huge_pages(self, huge_pages):
+        self._cpp_exec_conf.setHugePages(bool(huge_pages))
+
+    @property
+    def numa_first_touch(self):
+        """bool: Clear new host arrays with all TBB threads.
+
+        The operating system places each page of memory on the NUMA node of
+        the thread that first writes to it. When `numa_first_touch` is `True`,
+        all TBB threads clear contiguous ranges of each new host array of at
+        least 2 MiB, which spreads the pages over the NUMA nodes the threads run
+        on. Combine it with `pin_cpu_threads` so that the threads stay on those
+        nodes. Set `numa_first_touch` before creating the simulation state.
+
+        Note:
+            GPU devices pin the host arrays when allocating them, which places
+            the pages before they are cleared.
+        """
+        return self._cpp_exec_conf.getNUMAFirstTouch()
+
+    @numa_first_touch.setter
+    def numa_first_touch(self, numa_first_touch):
+        self._cpp_exec_conf.setNUMAFirstTouch(bool(numa_first_touch))
+
+    @property
+    def cpu_cores(self):
+        """list[int]: Cores assigned to this rank [read only].
+
+        Empty when the affinity cannot be determined.
+        """
+        return self._cpp_exec_conf.getRankCores()
+
+    @contextlib.contextmanager
+    def trace(self, filename):
+        """Record a timeline of the simulation.
+
+        Args:
+            filename (str): Name of the trace file to write.
+
+        Open `trace` as a context manager around calls to `Simulation.run
+        <hoomd.Simulation.run>`. When the context manager closes, it writes
+        the timeline in the Chrome trace event JSON format to ``filename``.
+        Open the file in https://ui.perfetto.dev or ``chrome://tracing``.
+
+        The timeline shows the phases of each time step, the regions that
+        operations profile (such as neighbor list builds, force computes, and
+        MPI communication), and autotuner scans. Each MPI rank is a separate
+        process in the timeline with one track for the CPU and one for the GPU.
+
+        Example::
+
+            with device.trace('trace.json'):
+                sim.run(100)
+
+        Note:
+            Tracing synchronizes the GPU at the start and end of each region,
+            which reduces performance. Trace short runs.
+
+        Note:
+            All MPI ranks must open and close the context manager together.
+        """
+        self._cpp_exec_conf.setTracing(True)
+        try:
+            yield None
+        finally:
+            self._cpp_exec_conf.writeTrace(filename)
+            self._cpp_exec_conf.setTracing(False)
+
 
 def _create_messenger(mpi_config, notice_level, msg_file):
     msg = _hoomd.Messenger(mpi_config)
@@ -196,6 +338,15 @@ class GPU(Device):
         requires that all GPUs support concurrent manged memory access and have
         high bandwidth interconnects.
 
+    .. rubric:: Autotuner cache
+
+    HOOMD autotunes kernel launch parameters at the start of every simulation.
+    Set the environment variable ``HOOMD_AUTOTUNER_CACHE_DIR`` to a directory
+    to store the tuned parameters there and start later simulations (with the
+    same GPU model, HOOMD version, and a similar number of particles) from
+    them. The autotuners still periodically re-validate the cached parameters.
+    Any number of processes may share the cache directory.
+
     """
 
     def __init__(self,
@@ -245,6 +396,32 @@ class GPU(Device):
     def gpu_error_checking(self, new_bool):
         self._cpp_exec_conf.setCUDAErrorChecking(new_bool)
 
+    @property
+    def autotuner_search(self):
+        """str: How autotuners search for the fastest kernel parameters.
+
+        * ``'exhaustive'`` (the default) - Time every parameter several times,
+          then repeat the full scan periodically.
+        * ``'adaptive'`` - Successively halve the set of candidate parameters,
+          taking one more sample of each survivor per round. Periodically, time
+          the current best parameter and one challenger.
+
+        The adaptive search needs about two samples per parameter to converge
+        instead of five. Change `autotuner_search` before the first call to
+        `hoomd.Simulation.run`, it does not apply to autotuners that have
+        started tuning.
+        """
+        if self._cpp_exec_conf.getAutotunerAdaptive():
+            return 'adaptive'
+        return 'exhaustive'
+
+    @autotuner_search.setter
+    def autotuner_search(self, search):
+        if search not in ('exhaustive', 'adaptive'):
+            raise ValueError(f"Invalid autotuner search {search!r}, use "
+                             "'exhaustive' or 'adaptive'.")
+        self._cpp_exec_conf.setAutotunerAdaptive(search == 'adaptive')
+
     @property
     def compute_capability(self):
         """tuple(int, int): Compute capability of the device.
@@ -321,6 +498,9 @@ class CPU(Device):
 
         notice_level (int): Minimum level of messages to print.
 
+        pin_cpu_threads (bool): Pin each TBB thread to one of the cores of this
+            rank.
+
     .. rubric:: MPI
 
     In MPI execution environments, create a `CPU` device on every rank.
@@ -330,7 +510,8 @@ class CPU(Device):
                  num_cpu_threads=None,
                  communicator=None,
                  msg_file=None,
-                 notice_level=2):
+                 notice_level=2,
+                 pin_cpu_threads=False):
 
         super().__init__(communicator, notice_level, msg_file)
 
@@ -341,6 +522,9 @@ class CPU(Device):
         if num_cpu_threads is not None:
             self.num_cpu_threads = num_cpu_threads
 
+        if pin_cpu_threads:
+            self.pin_cpu_threads = pin_cpu_threads
+
 
 def auto_select(communicator=None, msg_file=None, notice_level=2):
     """Automatically select the hardware device.
@@ -2174,6 +2174,108 @@ int gsd_read_chunk(struct gsd_handle* handle, void* data, const struct gsd_index
     return GSD_SUCCESS;
 }
 
+int gsd_map_chunk(struct gsd_handle* handle,
+                  const struct gsd_index_entry* chunk,
+                  struct gsd_chunk_map* map)
+{
+    if (handle == NULL)
+    {
+        return GSD_ERROR_INVALID_ARGUMENT;
+    }
+    if (chunk == NULL)
+    {
+        return GSD_ERROR_INVALID_ARGUMENT;
+    }
+    if (map == NULL)
+    {
+        return GSD_ERROR_INVALID_ARGUMENT;
+    }
+    if (handle->open_flags == GSD_OPEN_APPEND)
+    {
+        return GSD_ERROR_FILE_MUST_BE_READABLE;
+    }
+
+    gsd_util_zero_memory(map, sizeof(struct gsd_chunk_map));
+
+    size_t size = chunk->N * chunk->M * gsd_sizeof_type((enum gsd_type)chunk->type);
+    if (size == 0)
+    {
+        return GSD_ERROR_FILE_CORRUPT;
+    }
+    if (chunk->location == 0)
+    {
+        return GSD_ERROR_FILE_CORRUPT;
+    }
+
+    // validate that we don't map past the end of the file
+    if ((chunk->location + size) > (uint64_t)handle->file_size)
+    {
+        return GSD_ERROR_FILE_CORRUPT;
+    }
+
+#if GSD_USE_MMAP
+    // mmap requires an offset aligned to the page size
+    size_t page_size = getpagesize();
+    size_t offset = (chunk->location / page_size) * page_size;
+    size_t mapped_len = size + (chunk->location - offset);
+    void* mapped_data = mmap(NULL, mapped_len, PROT_READ, MAP_SHARED, handle->fd, offset);
+
+    if (mapped_data == MAP_FAILED)
+    {
+        return GSD_ERROR_IO;
+    }
+
+    map->mapped_data = mapped_data;
+    map->mapped_len = mapped_len;
+    map->data = ((const char*)mapped_data) + (chunk->location - offset);
+#else
+    // mmap not supported, read the data from the disk
+    void* data = malloc(size);
+    if (data == NULL)
+    {
+        return GSD_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+
+    ssize_t bytes_read = gsd_io_pread_retry(handle->fd, data, size, chunk->location);
+    if (bytes_read == -1 || bytes_read != size)
+    {
+        free(data);
+        return GSD_ERROR_IO;
+    }
+
+    map->data = data;
+#endif
+
+    return GSD_SUCCESS;
+}
+
+int gsd_unmap_chunk(struct gsd_chunk_map* map)
+{
+    if (map == NULL || map->data == NULL)
+    {
+        return GSD_ERROR_INVALID_ARGUMENT;
+    }
+
+#if GSD_USE_MMAP
+    if (map->mapped_data)
+    {
+        int retval = munmap(map->mapped_data, map->mapped_len);
+
+        if (retval != 0)
+        {
+            return GSD_ERROR_IO;
+        }
+    }
+    else
+#endif
+    {
+        free((void*)map->data);
+    }
+
+    gsd_util_zero_memory(map, sizeof(struct gsd_chunk_map));
+    return GSD_SUCCESS;
+}
+
 size_t gsd_sizeof_type(enum gsd_type type)
 {
     size_t val = 0;
@@ -237,6 +237,22 @@ struct gsd_index_buffer
     size_t mapped_len;
 };
 
+/** Memory map of a chunk
+
+    Filled by gsd_map_chunk() and released by gsd_unmap_chunk().
+*/
+struct gsd_chunk_map
+{
+    /// Address of the chunk data
+    const void* data;
+
+    /// Pointer to mapped data (NULL if not mapped)
+    void* mapped_data;
+
+    /// Number of bytes mapped
+    size_t mapped_len;
+};
+
 /** Byte buffer
 
     Used to buffer of small data chunks held for a buffered write at the end of a frame. Also
@@ -532,6 +548,43 @@ gsd_find_chunk(struct gsd_handle* handle, uint64_t frame, const char* name);
 */
 int gsd_read_chunk(struct gsd_handle* handle, void* data, const struct gsd_index_entry* chunk);
 
+/** Map a chunk of the GSD file into memory
+
+    @param handle Handle to an open GSD file.
+    @param chunk Chunk to map.
+    @param map Map to fill.
+
+    @pre *handle* was opened in read or readwrite mode.
+    @pre *chunk* was found by gsd_find_chunk().
+
+    On success, `map->data` points to the `N * M * gsd_sizeof_type(type)` bytes of the chunk,
+    read only, without copying them through a user space buffer. On systems without mmap, the chunk
+    is read into an allocated buffer instead. The map remains valid after gsd_close() until it is
+    released with gsd_unmap_chunk().
+
+    @return
+      - GSD_SUCCESS (0) on success. Negative value on failure:
+      - GSD_ERROR_IO: IO error (check errno).
+      - GSD_ERROR_INVALID_ARGUMENT: *handle* is NULL, *chunk* is NULL, or *map* is NULL.
+      - GSD_ERROR_FILE_MUST_BE_READABLE: The file was opened in append mode.
+      - GSD_ERROR_FILE_CORRUPT: The GSD file is corrupt.
+      - GSD_ERROR_MEMORY_ALLOCATION_FAILED: failed to allocate memory.
+*/
+int gsd_map_chunk(struct gsd_handle* handle,
+                  const struct gsd_index_entry* chunk,
+                  struct gsd_chunk_map* map);
+
+/** Release a chunk mapped by gsd_map_chunk()
+
+    @param map Map to release.
+
+    @return
+      - GSD_SUCCESS (0) on success. Negative value on failure:
+      - GSD_ERROR_IO: IO error (check errno).
+      - GSD_ERROR_INVALID_ARGUMENT: *map* is NULL or not mapped.
+*/
+int gsd_unmap_chunk(struct gsd_chunk_map* map);
+
 /** Get the number of frames in the GSD file
 
     @param handle Handle to an open GSD file
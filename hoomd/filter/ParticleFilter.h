@@ -4,6 +4,7 @@
 #include "../SystemDefinition.h"
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 #include <vector>
 
 /// Utility class to select particles based on given conditions
@@ -27,6 +28,10 @@
     rank.
 
     The base class getSelectedTags() method returns an empty vector.
+
+    On the GPU, filters that implement getSelectedMaskGPU() select the particles
+    into a membership bitmask by tag (see ParticleFilterMask.cuh) instead, so
+    that ParticleGroup builds its member list without copying tags to the host.
 */
 class PYBIND11_EXPORT ParticleFilter
     {
@@ -43,5 +48,27 @@ class PYBIND11_EXPORT ParticleFilter
         {
         return std::vector<unsigned int>();
         }
+
+#ifdef ENABLE_HIP
+    /// Test whether the filter selects particles on the device
+    virtual bool hasMaskGPU() const
+        {
+        return false;
+        }
+
+    /** Select particles on the device
+     *  Args:
+     *  sysdef: the System Definition
+     *  d_mask: membership bitmask with one bit per tag, zeroed by the
+     *  caller
+     *
+     *  Sets the bits of the tags that getSelectedTags() returns.
+     */
+    virtual void getSelectedMaskGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    unsigned int* d_mask) const
+        {
+        throw std::runtime_error("This particle filter cannot select particles on the device.");
+        }
+#endif
     };
 #endif
@@ -2,6 +2,7 @@
 #define __PARTICLE_FILTER_ALL_H__
 
 #include "ParticleFilter.h"
+#include "ParticleFilterMask.cuh"
 
 //! Select all particles
 class PYBIND11_EXPORT ParticleFilterAll : public ParticleFilter
@@ -33,5 +34,30 @@ class PYBIND11_EXPORT ParticleFilterAll : public ParticleFilter
         std::copy_n(h_tag.data, N, member_tags.begin());
         return member_tags;
         }
+
+#ifdef ENABLE_HIP
+    virtual bool hasMaskGPU() const
+        {
+        return true;
+        }
+
+    /** Args:
+     *  sysdef: the System Definition
+     *  d_mask: membership bitmask, the bits of all particles in the local
+     *  rank are set
+     */
+    virtual void getSelectedMaskGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    unsigned int* d_mask) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const ArrayHandle<unsigned int> d_tag(pdata->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+
+        gpu_particle_filter_mask_all(pdata->getN(), d_tag.data, d_mask);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            pdata->getExecConf()->handleHIPError(hipGetLastError(), __FILE__, __LINE__);
+        }
+#endif
     };
 #endif
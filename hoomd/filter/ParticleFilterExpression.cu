@@ -0,0 +1,118 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ParticleFilterExpression.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
+#pragma GCC diagnostic pop
+
+/*! \file ParticleFilterExpression.cu
+    \brief GPU evaluation of compiled particle filter expressions
+*/
+
+//! Flag the particles for which the expression is true
+__global__ void gpu_particle_filter_expression_kernel(unsigned int N,
+                                                      const Scalar4* d_postype,
+                                                      const Scalar4* d_vel,
+                                                      const unsigned int* d_tag,
+                                                      const unsigned int* d_program,
+                                                      unsigned int program_size,
+                                                      const double* d_constants,
+                                                      unsigned int* d_flags)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_flags[idx] = particle_filter_expression_eval(d_program,
+                                                   program_size,
+                                                   d_constants,
+                                                   d_postype[idx],
+                                                   d_vel[idx],
+                                                   d_tag[idx]);
+    }
+
+/*! \param N number of local particles
+    \param d_postype Particle positions and types
+    \param d_vel Particle velocities and masses
+    \param d_tag Particle tags
+    \param d_program Instructions of the expression
+    \param program_size Number of instructions
+    \param d_constants Constants referenced by the program
+    \param d_selected_tags Tags of the selected particles (output, N elements)
+    \param num_selected Number of selected particles (output)
+    \param alloc Caching allocator for temporary storage
+*/
+hipError_t gpu_particle_filter_expression(unsigned int N,
+                                          const Scalar4* d_postype,
+                                          const Scalar4* d_vel,
+                                          const unsigned int* d_tag,
+                                          const unsigned int* d_program,
+                                          unsigned int program_size,
+                                          const double* d_constants,
+                                          unsigned int* d_selected_tags,
+                                          unsigned int& num_selected,
+                                          CachedAllocator& alloc)
+    {
+    assert(d_postype);
+    assert(d_vel);
+    assert(d_tag);
+    assert(d_program);
+    assert(d_selected_tags);
+
+    if (N == 0)
+        {
+        num_selected = 0;
+        return hipSuccess;
+        }
+
+    unsigned int* d_flags = alloc.getTemporaryBuffer<unsigned int>(N);
+    unsigned int* d_num_selected = alloc.getTemporaryBuffer<unsigned int>(1);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_expression_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_postype,
+                       d_vel,
+                       d_tag,
+                       d_program,
+                       program_size,
+                       d_constants,
+                       d_flags);
+
+    // determine size of temporary storage
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceSelect::Flagged(d_temp_storage,
+                                  temp_storage_bytes,
+                                  d_tag,
+                                  d_flags,
+                                  d_selected_tags,
+                                  d_num_selected,
+                                  N);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceSelect::Flagged(d_temp_storage,
+                                  temp_storage_bytes,
+                                  d_tag,
+                                  d_flags,
+                                  d_selected_tags,
+                                  d_num_selected,
+                                  N);
+    alloc.deallocate((char*)d_temp_storage);
+
+    hipMemcpy(&num_selected, d_num_selected, sizeof(unsigned int), hipMemcpyDeviceToHost);
+    alloc.deallocate((char*)d_num_selected);
+    alloc.deallocate((char*)d_flags);
+
+    return hipSuccess;
+    }
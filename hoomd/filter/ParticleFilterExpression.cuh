@@ -0,0 +1,213 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PARTICLE_FILTER_EXPRESSION_CUH__
+#define __PARTICLE_FILTER_EXPRESSION_CUH__
+
+#include "hoomd/HOOMDMath.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/CachedAllocator.h"
+#endif
+
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+/*! \file ParticleFilterExpression.cuh
+    \brief Evaluates compiled particle filter expressions on the host and the device
+*/
+
+/// Operations of a compiled particle filter expression
+/** Each instruction is stored in one unsigned int: the operation in the lowest 8 bits and its
+    argument in the remaining bits. The program runs on a stack of doubles, boolean results are 0
+    or 1.
+*/
+enum particle_filter_expression_op
+    {
+    expression_push_constant = 0, //!< Push constants[arg]
+    expression_push_x,            //!< Push the x coordinate of the position
+    expression_push_y,            //!< Push the y coordinate of the position
+    expression_push_z,            //!< Push the z coordinate of the position
+    expression_push_vx,           //!< Push the x component of the velocity
+    expression_push_vy,           //!< Push the y component of the velocity
+    expression_push_vz,           //!< Push the z component of the velocity
+    expression_push_mass,         //!< Push the mass
+    expression_push_tag,          //!< Push the tag
+    expression_push_type,         //!< Push the type id
+    expression_add,               //!< a + b
+    expression_subtract,          //!< a - b
+    expression_multiply,          //!< a * b
+    expression_divide,            //!< a / b
+    expression_less,              //!< a < b
+    expression_less_equal,        //!< a <= b
+    expression_greater,           //!< a > b
+    expression_greater_equal,     //!< a >= b
+    expression_equal,             //!< a == b
+    expression_not_equal,         //!< a != b
+    expression_and,               //!< a and b
+    expression_or,                //!< a or b
+    expression_negate,            //!< -a
+    expression_not,               //!< not a
+    expression_abs,               //!< abs(a)
+    expression_sqrt,              //!< sqrt(a)
+    expression_num_ops
+    };
+
+//! Maximum depth of the evaluation stack
+const unsigned int PARTICLE_FILTER_EXPRESSION_MAX_STACK = 16;
+
+//! Evaluate a compiled particle filter expression for one particle
+/*! \param program Instructions of the expression
+    \param program_size Number of instructions
+    \param constants Constants referenced by the program
+    \param postype Position and type of the particle
+    \param vel Velocity and mass of the particle
+    \param tag Tag of the particle
+
+    \returns true when the expression evaluates to a non-zero value
+
+    \pre The program has been validated to leave exactly one value on the stack without exceeding
+    PARTICLE_FILTER_EXPRESSION_MAX_STACK.
+*/
+HOSTDEVICE inline bool particle_filter_expression_eval(const unsigned int* program,
+                                                       unsigned int program_size,
+                                                       const double* constants,
+                                                       const Scalar4& postype,
+                                                       const Scalar4& vel,
+                                                       unsigned int tag)
+    {
+    double stack[PARTICLE_FILTER_EXPRESSION_MAX_STACK];
+    unsigned int top = 0;
+
+    for (unsigned int i = 0; i < program_size; ++i)
+        {
+        const unsigned int op = program[i] & 0xff;
+        const unsigned int arg = program[i] >> 8;
+
+        if (op <= expression_push_type)
+            {
+            double value;
+            switch (op)
+                {
+            case expression_push_constant:
+                value = constants[arg];
+                break;
+            case expression_push_x:
+                value = postype.x;
+                break;
+            case expression_push_y:
+                value = postype.y;
+                break;
+            case expression_push_z:
+                value = postype.z;
+                break;
+            case expression_push_vx:
+                value = vel.x;
+                break;
+            case expression_push_vy:
+                value = vel.y;
+                break;
+            case expression_push_vz:
+                value = vel.z;
+                break;
+            case expression_push_mass:
+                value = vel.w;
+                break;
+            case expression_push_tag:
+                value = tag;
+                break;
+            default:
+                value = __scalar_as_int(postype.w);
+                break;
+                }
+            stack[top++] = value;
+            }
+        else if (op >= expression_negate)
+            {
+            double& a = stack[top - 1];
+            switch (op)
+                {
+            case expression_negate:
+                a = -a;
+                break;
+            case expression_not:
+                a = (a == 0.0);
+                break;
+            case expression_abs:
+                a = fabs(a);
+                break;
+            default:
+                a = sqrt(a);
+                break;
+                }
+            }
+        else
+            {
+            const double b = stack[--top];
+            double& a = stack[top - 1];
+            switch (op)
+                {
+            case expression_add:
+                a = a + b;
+                break;
+            case expression_subtract:
+                a = a - b;
+                break;
+            case expression_multiply:
+                a = a * b;
+                break;
+            case expression_divide:
+                a = a / b;
+                break;
+            case expression_less:
+                a = (a < b);
+                break;
+            case expression_less_equal:
+                a = (a <= b);
+                break;
+            case expression_greater:
+                a = (a > b);
+                break;
+            case expression_greater_equal:
+                a = (a >= b);
+                break;
+            case expression_equal:
+                a = (a == b);
+                break;
+            case expression_not_equal:
+                a = (a != b);
+                break;
+            case expression_and:
+                a = (a != 0.0 && b != 0.0);
+                break;
+            default:
+                a = (a != 0.0 || b != 0.0);
+                break;
+                }
+            }
+        }
+
+    return stack[0] != 0.0;
+    }
+
+// undefine HOSTDEVICE so we don't interfere with other headers
+#undef HOSTDEVICE
+
+#ifdef ENABLE_HIP
+//! Select the tags of the local particles for which the expression is true
+hipError_t gpu_particle_filter_expression(unsigned int N,
+                                          const Scalar4* d_postype,
+                                          const Scalar4* d_vel,
+                                          const unsigned int* d_tag,
+                                          const unsigned int* d_program,
+                                          unsigned int program_size,
+                                          const double* d_constants,
+                                          unsigned int* d_selected_tags,
+                                          unsigned int& num_selected,
+                                          CachedAllocator& alloc);
+#endif
+
+#endif
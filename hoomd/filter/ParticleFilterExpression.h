@@ -0,0 +1,190 @@
+#ifndef __PARTICLE_FILTER_EXPRESSION_H__
+#define __PARTICLE_FILTER_EXPRESSION_H__
+
+#include "ParticleFilter.h"
+#include "ParticleFilterExpression.cuh"
+#include <pybind11/stl.h>
+#include <stdexcept>
+#include <string>
+
+/// Select particles with a compiled expression of their position, velocity, mass, tag, and type
+/** The Python front end compiles the expression into a stack program (see
+    particle_filter_expression_op). The constants that follow the numeric constants refer to the
+    names in type_names, which are resolved to type ids each time the filter is evaluated.
+
+    The expression is evaluated for all local particles in one pass on the CPU or in a kernel on
+    the GPU, so dynamic groups do not call back into Python.
+*/
+class PYBIND11_EXPORT ParticleFilterExpression : public ParticleFilter
+    {
+    public:
+    /** Args:
+     *  program: instructions of the compiled expression
+     *  constants: numeric constants referenced by the program
+     *  type_names: type names referenced by the program, appended to the constants
+     */
+    ParticleFilterExpression(std::vector<unsigned int> program,
+                             std::vector<double> constants,
+                             std::vector<std::string> type_names)
+        : ParticleFilter(), m_program(program), m_constants(constants), m_type_names(type_names)
+        {
+        validate();
+        }
+
+    virtual ~ParticleFilterExpression() { }
+
+    /** Args:
+     *  sysdef: system definition to find tags for
+     *
+     *  Returns:
+     *  tags of all rank local particles for which the expression is true
+     */
+    virtual std::vector<unsigned int>
+    getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const unsigned int N = pdata->getN();
+
+        std::vector<double> constants(m_constants);
+        for (const auto& name : m_type_names)
+            {
+            constants.push_back(pdata->getTypeByName(name));
+            }
+
+#ifdef ENABLE_HIP
+        if (pdata->getExecConf()->isCUDAEnabled())
+            {
+            return getSelectedTagsGPU(pdata, constants);
+            }
+#endif
+
+        const ArrayHandle<unsigned int> h_tag(pdata->getTags(),
+                                              access_location::host,
+                                              access_mode::read);
+        const ArrayHandle<Scalar4> h_postype(pdata->getPositions(),
+                                             access_location::host,
+                                             access_mode::read);
+        const ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        std::vector<unsigned int> member_tags;
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            if (particle_filter_expression_eval(m_program.data(),
+                                                (unsigned int)m_program.size(),
+                                                constants.data(),
+                                                h_postype.data[idx],
+                                                h_vel.data[idx],
+                                                h_tag.data[idx]))
+                {
+                member_tags.push_back(h_tag.data[idx]);
+                }
+            }
+        return member_tags;
+        }
+
+    protected:
+    std::vector<unsigned int> m_program;   ///< Instructions of the compiled expression
+    std::vector<double> m_constants;       ///< Numeric constants referenced by the program
+    std::vector<std::string> m_type_names; ///< Type names referenced by the program
+
+    /// Check that the program is well formed and fits on the evaluation stack
+    void validate() const
+        {
+        const size_t n_constants = m_constants.size() + m_type_names.size();
+        unsigned int depth = 0;
+        for (unsigned int instruction : m_program)
+            {
+            const unsigned int op = instruction & 0xff;
+            const unsigned int arg = instruction >> 8;
+
+            if (op >= expression_num_ops)
+                throw std::runtime_error("Invalid operation in particle filter expression.");
+            if (op == expression_push_constant && arg >= n_constants)
+                throw std::runtime_error("Invalid constant in particle filter expression.");
+
+            if (op <= expression_push_type)
+                {
+                depth++;
+                if (depth > PARTICLE_FILTER_EXPRESSION_MAX_STACK)
+                    throw std::runtime_error("Particle filter expression is too deeply nested.");
+                }
+            else if (op < expression_negate)
+                {
+                if (depth < 2)
+                    throw std::runtime_error("Malformed particle filter expression.");
+                depth--;
+                }
+            else if (depth < 1)
+                {
+                throw std::runtime_error("Malformed particle filter expression.");
+                }
+            }
+
+        if (depth != 1)
+            throw std::runtime_error("Malformed particle filter expression.");
+        }
+
+#ifdef ENABLE_HIP
+    /// Evaluate the expression for all local particles on the GPU
+    std::vector<unsigned int> getSelectedTagsGPU(std::shared_ptr<ParticleData> pdata,
+                                                 const std::vector<double>& constants) const
+        {
+        const unsigned int N = pdata->getN();
+        CachedAllocator& alloc = pdata->getExecConf()->getCachedAllocator();
+
+        ScopedAllocation<unsigned int> d_program(alloc, m_program.size());
+        ScopedAllocation<double> d_constants(alloc, constants.size());
+        ScopedAllocation<unsigned int> d_selected_tags(alloc, N);
+        hipMemcpy(d_program.data,
+                  m_program.data(),
+                  sizeof(unsigned int) * m_program.size(),
+                  hipMemcpyHostToDevice);
+        if (constants.size())
+            {
+            hipMemcpy(d_constants.data,
+                      constants.data(),
+                      sizeof(double) * constants.size(),
+                      hipMemcpyHostToDevice);
+            }
+
+        unsigned int num_selected = 0;
+            {
+            const ArrayHandle<unsigned int> d_tag(pdata->getTags(),
+                                                  access_location::device,
+                                                  access_mode::read);
+            const ArrayHandle<Scalar4> d_postype(pdata->getPositions(),
+                                                 access_location::device,
+                                                 access_mode::read);
+            const ArrayHandle<Scalar4> d_vel(pdata->getVelocities(),
+                                             access_location::device,
+                                             access_mode::read);
+
+            gpu_particle_filter_expression(N,
+                                           d_postype.data,
+                                           d_vel.data,
+                                           d_tag.data,
+                                           d_program.data,
+                                           (unsigned int)m_program.size(),
+                                           d_constants.data,
+                                           d_selected_tags.data,
+                                           num_selected,
+                                           alloc);
+            if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+                pdata->getExecConf()->handleHIPError(hipGetLastError(), __FILE__, __LINE__);
+            }
+
+        std::vector<unsigned int> member_tags(num_selected);
+        if (num_selected)
+            {
+            hipMemcpy(member_tags.data(),
+                      d_selected_tags.data,
+                      sizeof(unsigned int) * num_selected,
+                      hipMemcpyDeviceToHost);
+            }
+        return member_tags;
+        }
+#endif
+    };
+#endif
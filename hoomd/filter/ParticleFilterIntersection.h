@@ -2,6 +2,7 @@
 #define __PARTICLE_FILTER_INTERSECTION_H__
 
 #include "ParticleFilter.h"
+#include "ParticleFilterMask.cuh"
 #include <algorithm>
 
 /// Represents the intersection of two filters: f and g.
@@ -45,6 +46,37 @@ class PYBIND11_EXPORT ParticleFilterIntersection : public ParticleFilter
         return tags;
         }
 
+#ifdef ENABLE_HIP
+    virtual bool hasMaskGPU() const
+        {
+        return m_f->hasMaskGPU() && m_g->hasMaskGPU();
+        }
+
+    /** Args:
+     *  sysdef: the System Definition
+     *  d_mask: membership bitmask, the bits of all rank local particles that
+     *  are in filter m_f and filter m_g are set
+     */
+    virtual void getSelectedMaskGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    unsigned int* d_mask) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const unsigned int n_words
+            = particle_filter_mask_words((unsigned int)pdata->getRTags().size());
+
+        CachedAllocator& alloc = pdata->getExecConf()->getCachedAllocator();
+        ScopedAllocation<unsigned int> d_mask_g(alloc, n_words);
+        hipMemset(d_mask_g.data, 0, sizeof(unsigned int) * n_words);
+
+        m_f->getSelectedMaskGPU(sysdef, d_mask);
+        m_g->getSelectedMaskGPU(sysdef, d_mask_g.data);
+
+        gpu_particle_filter_mask_combine(n_words, d_mask, d_mask_g.data, mask_intersection);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            pdata->getExecConf()->handleHIPError(hipGetLastError(), __FILE__, __LINE__);
+        }
+#endif
+
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
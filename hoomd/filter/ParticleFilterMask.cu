@@ -0,0 +1,308 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ParticleFilterMask.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
+#pragma GCC diagnostic pop
+
+/*! \file ParticleFilterMask.cu
+    \brief Selects particles into membership bitmasks on the device
+*/
+
+//! Set the bit of one tag
+__device__ inline void particle_filter_mask_set(unsigned int* d_mask, unsigned int tag)
+    {
+    atomicOr(d_mask + tag / 32, 1u << (tag % 32));
+    }
+
+//! Set the bits of all local particles
+__global__ void
+gpu_particle_filter_mask_all_kernel(unsigned int N, const unsigned int* d_tag, unsigned int* d_mask)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    particle_filter_mask_set(d_mask, d_tag[idx]);
+    }
+
+//! Set the bits of the local particles with a selected type
+__global__ void gpu_particle_filter_mask_type_kernel(unsigned int N,
+                                                     const Scalar4* d_postype,
+                                                     const unsigned int* d_tag,
+                                                     const unsigned int* d_type_selected,
+                                                     unsigned int* d_mask)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    if (d_type_selected[__scalar_as_int(d_postype[idx].w)])
+        particle_filter_mask_set(d_mask, d_tag[idx]);
+    }
+
+//! Set the bits of a list of tags
+__global__ void gpu_particle_filter_mask_tags_kernel(unsigned int n_selected,
+                                                     const unsigned int* d_selected_tags,
+                                                     unsigned int n_tags,
+                                                     unsigned int* d_mask)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_selected)
+        return;
+
+    unsigned int tag = d_selected_tags[i];
+    if (tag < n_tags)
+        particle_filter_mask_set(d_mask, tag);
+    }
+
+//! Combine two membership bitmasks in place
+__global__ void gpu_particle_filter_mask_combine_kernel(unsigned int n_words,
+                                                        unsigned int* d_a,
+                                                        const unsigned int* d_b,
+                                                        particle_filter_mask_op op)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_words)
+        return;
+
+    if (op == mask_intersection)
+        d_a[i] &= d_b[i];
+    else
+        d_a[i] &= ~d_b[i];
+    }
+
+//! Count the set bits of each word
+__global__ void gpu_particle_filter_mask_popc_kernel(unsigned int n_words,
+                                                     const unsigned int* d_mask,
+                                                     unsigned int* d_count)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_words)
+        return;
+
+    d_count[i] = __popc(d_mask[i]);
+    }
+
+//! List the selected tags of one word and write the membership flags of its tags
+__global__ void gpu_particle_filter_mask_to_tags_kernel(unsigned int n_tags,
+                                                        const unsigned int* d_mask,
+                                                        const unsigned int* d_offsets,
+                                                        unsigned int* d_selected_tags,
+                                                        unsigned int* d_is_member_tag)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i * 32 >= n_tags)
+        return;
+
+    unsigned int word = d_mask[i];
+    unsigned int offset = d_offsets[i];
+    for (unsigned int bit = 0; bit < 32 && i * 32 + bit < n_tags; ++bit)
+        {
+        unsigned int tag = i * 32 + bit;
+        unsigned int member = (word >> bit) & 1;
+        if (member)
+            d_selected_tags[offset++] = tag;
+        d_is_member_tag[tag] = member;
+        }
+    }
+
+/*! \param N number of local particles
+    \param d_tag Particle tags
+    \param d_mask Membership bitmask
+*/
+hipError_t
+gpu_particle_filter_mask_all(unsigned int N, const unsigned int* d_tag, unsigned int* d_mask)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_mask_all_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_tag,
+                       d_mask);
+
+    return hipSuccess;
+    }
+
+/*! \param N number of local particles
+    \param d_postype Particle positions and types
+    \param d_tag Particle tags
+    \param d_type_selected Non-zero for the selected types
+    \param d_mask Membership bitmask
+*/
+hipError_t gpu_particle_filter_mask_type(unsigned int N,
+                                         const Scalar4* d_postype,
+                                         const unsigned int* d_tag,
+                                         const unsigned int* d_type_selected,
+                                         unsigned int* d_mask)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_mask_type_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_postype,
+                       d_tag,
+                       d_type_selected,
+                       d_mask);
+
+    return hipSuccess;
+    }
+
+/*! \param n_selected Number of tags to select
+    \param d_selected_tags Tags to select
+    \param n_tags Number of bits in the mask, larger tags are ignored
+    \param d_mask Membership bitmask
+*/
+hipError_t gpu_particle_filter_mask_tags(unsigned int n_selected,
+                                         const unsigned int* d_selected_tags,
+                                         unsigned int n_tags,
+                                         unsigned int* d_mask)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_selected / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_mask_tags_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_selected,
+                       d_selected_tags,
+                       n_tags,
+                       d_mask);
+
+    return hipSuccess;
+    }
+
+/*! \param n_words Number of words in the masks
+    \param d_a First mask, replaced by the result
+    \param d_b Second mask
+    \param op Set operation
+*/
+hipError_t gpu_particle_filter_mask_combine(unsigned int n_words,
+                                            unsigned int* d_a,
+                                            const unsigned int* d_b,
+                                            particle_filter_mask_op op)
+    {
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_words / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_mask_combine_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_words,
+                       d_a,
+                       d_b,
+                       op);
+
+    return hipSuccess;
+    }
+
+/*! \param n_words Number of words in the mask
+    \param d_mask Membership bitmask
+    \param d_offsets Index of the first selected tag of each word, followed by the number of
+           selected tags (output, n_words + 1 elements)
+    \param num_selected Number of selected tags (output)
+    \param alloc Caching allocator for temporary storage
+*/
+hipError_t gpu_particle_filter_mask_count(unsigned int n_words,
+                                          const unsigned int* d_mask,
+                                          unsigned int* d_offsets,
+                                          unsigned int& num_selected,
+                                          CachedAllocator& alloc)
+    {
+    if (n_words == 0)
+        {
+        num_selected = 0;
+        return hipSuccess;
+        }
+
+    // one more element holds the total
+    unsigned int* d_count = alloc.getTemporaryBuffer<unsigned int>(n_words + 1);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_words / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_mask_popc_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_words,
+                       d_mask,
+                       d_count);
+    hipMemset(d_count + n_words, 0, sizeof(unsigned int));
+
+    // determine size of temporary storage
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceScan::ExclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_count,
+                                     d_offsets,
+                                     n_words + 1);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceScan::ExclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_count,
+                                     d_offsets,
+                                     n_words + 1);
+    alloc.deallocate((char*)d_temp_storage);
+
+    hipMemcpy(&num_selected, d_offsets + n_words, sizeof(unsigned int), hipMemcpyDeviceToHost);
+    alloc.deallocate((char*)d_count);
+
+    return hipSuccess;
+    }
+
+/*! \param n_tags Number of bits in the mask
+    \param d_mask Membership bitmask
+    \param d_offsets Index of the first selected tag of each word
+    \param d_selected_tags Selected tags in ascending order (output)
+    \param d_is_member_tag Membership flag of each tag (output, n_tags elements)
+*/
+hipError_t gpu_particle_filter_mask_to_tags(unsigned int n_tags,
+                                            const unsigned int* d_mask,
+                                            const unsigned int* d_offsets,
+                                            unsigned int* d_selected_tags,
+                                            unsigned int* d_is_member_tag)
+    {
+    unsigned int n_words = particle_filter_mask_words(n_tags);
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_words / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_particle_filter_mask_to_tags_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_tags,
+                       d_mask,
+                       d_offsets,
+                       d_selected_tags,
+                       d_is_member_tag);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,71 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PARTICLE_FILTER_MASK_CUH__
+#define __PARTICLE_FILTER_MASK_CUH__
+
+#include "hoomd/HOOMDMath.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/CachedAllocator.h"
+
+/*! \file ParticleFilterMask.cuh
+    \brief Selects particles into membership bitmasks on the device
+
+    A membership bitmask has one bit per particle tag: tag t is bit t % 32 of word t / 32. Masks
+    of different filters combine with bitwise operations, and compacting a mask lists the selected
+    tags in ascending order.
+*/
+
+//! Number of words in a membership bitmask of n_tags tags
+inline unsigned int particle_filter_mask_words(unsigned int n_tags)
+    {
+    return (n_tags + 31) / 32;
+    }
+
+//! Set operations on membership bitmasks
+enum particle_filter_mask_op
+    {
+    mask_intersection, //!< a & b
+    mask_difference    //!< a & ~b
+    };
+
+//! Set the bits of all local particles
+hipError_t
+gpu_particle_filter_mask_all(unsigned int N, const unsigned int* d_tag, unsigned int* d_mask);
+
+//! Set the bits of the local particles with a selected type
+hipError_t gpu_particle_filter_mask_type(unsigned int N,
+                                         const Scalar4* d_postype,
+                                         const unsigned int* d_tag,
+                                         const unsigned int* d_type_selected,
+                                         unsigned int* d_mask);
+
+//! Set the bits of a list of tags
+hipError_t gpu_particle_filter_mask_tags(unsigned int n_selected,
+                                         const unsigned int* d_selected_tags,
+                                         unsigned int n_tags,
+                                         unsigned int* d_mask);
+
+//! Combine two membership bitmasks in place
+hipError_t gpu_particle_filter_mask_combine(unsigned int n_words,
+                                            unsigned int* d_a,
+                                            const unsigned int* d_b,
+                                            particle_filter_mask_op op);
+
+//! Count the selected tags and the offset of each word in the list of selected tags
+hipError_t gpu_particle_filter_mask_count(unsigned int n_words,
+                                          const unsigned int* d_mask,
+                                          unsigned int* d_offsets,
+                                          unsigned int& num_selected,
+                                          CachedAllocator& alloc);
+
+//! List the selected tags in ascending order and write the membership flag of every tag
+hipError_t gpu_particle_filter_mask_to_tags(unsigned int n_tags,
+                                            const unsigned int* d_mask,
+                                            const unsigned int* d_offsets,
+                                            unsigned int* d_selected_tags,
+                                            unsigned int* d_is_member_tag);
+#endif
+
+#endif
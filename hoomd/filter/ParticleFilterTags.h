@@ -2,6 +2,7 @@
 #define __PARTICLE_FILTER_TAGS_H__
 
 #include "ParticleFilter.h"
+#include "ParticleFilterMask.cuh"
 #include <pybind11/numpy.h>
 
 /// Select particles based on their tag
@@ -38,6 +39,39 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
         return m_tags;
         }
 
+#ifdef ENABLE_HIP
+    virtual bool hasMaskGPU() const
+        {
+        return true;
+        }
+
+    /** Args:
+     *  sysdef System Definition
+     *  d_mask: membership bitmask, the bits of m_tags are set
+     */
+    virtual void getSelectedMaskGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    unsigned int* d_mask) const
+        {
+        if (m_tags.empty())
+            return;
+
+        const auto pdata = sysdef->getParticleData();
+        CachedAllocator& alloc = pdata->getExecConf()->getCachedAllocator();
+        ScopedAllocation<unsigned int> d_selected_tags(alloc, m_tags.size());
+        hipMemcpy(d_selected_tags.data,
+                  m_tags.data(),
+                  sizeof(unsigned int) * m_tags.size(),
+                  hipMemcpyHostToDevice);
+
+        gpu_particle_filter_mask_tags((unsigned int)m_tags.size(),
+                                      d_selected_tags.data,
+                                      (unsigned int)pdata->getRTags().size(),
+                                      d_mask);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            pdata->getExecConf()->handleHIPError(hipGetLastError(), __FILE__, __LINE__);
+        }
+#endif
+
     protected:
     std::vector<unsigned int> m_tags; //< Tags to use for filter
     };
@@ -2,6 +2,7 @@
 #define __PARTICLE_FILTER_TYPE_H__
 
 #include "ParticleFilter.h"
+#include "ParticleFilterMask.cuh"
 #include <pybind11/stl.h>
 #include <string>
 #include <unordered_set>
@@ -64,6 +65,54 @@ class PYBIND11_EXPORT ParticleFilterType : public ParticleFilter
         return member_tags;
         }
 
+#ifdef ENABLE_HIP
+    virtual bool hasMaskGPU() const
+        {
+        return true;
+        }
+
+    /** Args:
+     *  sysdef: system definition to find tags for
+     *  d_mask: membership bitmask, the bits of all rank local particles of
+     *  types in m_types are set
+     */
+    virtual void getSelectedMaskGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    unsigned int* d_mask) const
+        {
+        const auto pdata = sysdef->getParticleData();
+
+        // flag the selected types
+        const unsigned int n_types = pdata->getNTypes();
+        std::vector<unsigned int> type_selected(n_types, 0);
+        for (auto type_str : m_types)
+            {
+            type_selected[pdata->getTypeByName(type_str)] = 1;
+            }
+
+        CachedAllocator& alloc = pdata->getExecConf()->getCachedAllocator();
+        ScopedAllocation<unsigned int> d_type_selected(alloc, n_types);
+        hipMemcpy(d_type_selected.data,
+                  type_selected.data(),
+                  sizeof(unsigned int) * n_types,
+                  hipMemcpyHostToDevice);
+
+        const ArrayHandle<unsigned int> d_tag(pdata->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+        const ArrayHandle<Scalar4> d_postype(pdata->getPositions(),
+                                             access_location::device,
+                                             access_mode::read);
+
+        gpu_particle_filter_mask_type(pdata->getN(),
+                                      d_postype.data,
+                                      d_tag.data,
+                                      d_type_selected.data,
+                                      d_mask);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            pdata->getExecConf()->handleHIPError(hipGetLastError(), __FILE__, __LINE__);
+        }
+#endif
+
     protected:
     std::unordered_set<std::string> m_types; ///< Set of types to select
     };
@@ -43,6 +43,26 @@ class PYBIND11_EXPORT ParticleFilterUnion : public ParticleFilter
         return tags;
         }
 
+#ifdef ENABLE_HIP
+    virtual bool hasMaskGPU() const
+        {
+        return m_f->hasMaskGPU() && m_g->hasMaskGPU();
+        }
+
+    /** Args:
+     *  sysdef: the System Definition
+     *  d_mask: membership bitmask, the bits of all rank local particles that
+     *  are in either filter m_f or filter m_g are set
+     */
+    virtual void getSelectedMaskGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    unsigned int* d_mask) const
+        {
+        // both filters set their bits in the same mask
+        m_f->getSelectedMaskGPU(sysdef, d_mask);
+        m_g->getSelectedMaskGPU(sysdef, d_mask);
+        }
+#endif
+
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
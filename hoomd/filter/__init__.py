@@ -30,3 +30,4 @@ from hoomd.filter.set_ import Intersection, SetDifference, Union
 from hoomd.filter.tags import Tags
 from hoomd.filter.type_ import Type
 from hoomd.filter.custom import CustomFilter
+from hoomd.filter.expression import Expression
@@ -2,6 +2,7 @@
 #include "ParticleFilter.h"
 #include "ParticleFilterAll.h"
 #include "ParticleFilterCustom.h"
+#include "ParticleFilterExpression.h"
 #include "ParticleFilterIntersection.h"
 #include "ParticleFilterNull.h"
 #include "ParticleFilterRigid.h"
@@ -56,6 +57,13 @@ void export_ParticleFilters(pybind11::module& m)
         "ParticleFilterCustom")
         .def(pybind11::init<pybind11::object, pybind11::object>());
 
+    pybind11::class_<ParticleFilterExpression,
+                     ParticleFilter,
+                     std::shared_ptr<ParticleFilterExpression>>(m, "ParticleFilterExpression")
+        .def(pybind11::init<std::vector<unsigned int>,
+                            std::vector<double>,
+                            std::vector<std::string>>());
+
     pybind11::class_<ParticleFilterRigid, ParticleFilter, std::shared_ptr<ParticleFilterRigid>>(
         m,
         "ParticleFilterRigid")
@@ -0,0 +1,214 @@
+"""Define the Expression filter."""
+
+import ast
+
+from hoomd.filter.filter_ import ParticleFilter
+from hoomd._hoomd import ParticleFilterExpression
+
+# Operation codes, these must match particle_filter_expression_op in
+# ParticleFilterExpression.cuh.
+_PUSH_CONSTANT = 0
+_VARIABLES = {
+    'x': 1,
+    'y': 2,
+    'z': 3,
+    'vx': 4,
+    'vy': 5,
+    'vz': 6,
+    'mass': 7,
+    'tag': 8,
+    'type': 9,
+}
+_BINARY = {
+    ast.Add: 10,
+    ast.Sub: 11,
+    ast.Mult: 12,
+    ast.Div: 13,
+    ast.Lt: 14,
+    ast.LtE: 15,
+    ast.Gt: 16,
+    ast.GtE: 17,
+    ast.Eq: 18,
+    ast.NotEq: 19,
+    ast.And: 20,
+    ast.Or: 21,
+}
+_UNARY = {
+    ast.USub: 22,
+    ast.Not: 23,
+}
+_FUNCTIONS = {
+    'abs': 24,
+    'sqrt': 25,
+}
+_MAX_STACK = 16
+
+
+class _Compiler:
+    """Compile a Python expression into a stack program."""
+
+    def __init__(self, parameters):
+        self.parameters = parameters
+        self.program = []
+        self.constants = []
+        self.type_names = []
+        self.depth = 0
+        self.max_depth = 0
+
+    def compile(self, expression):
+        try:
+            tree = ast.parse(expression, mode='eval')
+        except SyntaxError as error:
+            raise ValueError(f"Invalid expression {expression!r}.") from error
+        self.visit(tree.body)
+
+        if self.max_depth > _MAX_STACK:
+            raise ValueError(f"Expression {expression!r} is too deeply nested.")
+
+        # type names are stored after the numeric constants
+        offset = len(self.constants)
+        return ([(op | ((offset + arg) << 8)) if kind == 'type' else
+                 (op | (arg << 8)) for kind, op, arg in self.program],
+                self.constants, self.type_names)
+
+    def emit(self, op, arg=0, kind=None, push=0):
+        self.program.append((kind, op, arg))
+        self.depth += push
+        self.max_depth = max(self.max_depth, self.depth)
+
+    def push_number(self, value):
+        if value not in self.constants:
+            self.constants.append(value)
+        self.emit(_PUSH_CONSTANT, self.constants.index(value), push=1)
+
+    def push_type_name(self, name):
+        if name not in self.type_names:
+            self.type_names.append(name)
+        self.emit(_PUSH_CONSTANT,
+                  self.type_names.index(name),
+                  kind='type',
+                  push=1)
+
+    def visit(self, node):
+        if isinstance(node, ast.BoolOp):
+            self.visit(node.values[0])
+            for value in node.values[1:]:
+                self.visit(value)
+                self.emit(_BINARY[type(node.op)], push=-1)
+        elif isinstance(node, ast.BinOp) and type(node.op) in _BINARY:
+            self.visit(node.left)
+            self.visit(node.right)
+            self.emit(_BINARY[type(node.op)], push=-1)
+        elif isinstance(node, ast.UnaryOp) and type(node.op) in _UNARY:
+            self.visit(node.operand)
+            self.emit(_UNARY[type(node.op)])
+        elif isinstance(node, ast.UnaryOp) and isinstance(node.op, ast.UAdd):
+            self.visit(node.operand)
+        elif isinstance(node, ast.Compare):
+            # a < b < c is (a < b) and (b < c)
+            left = node.left
+            for i, (op, right) in enumerate(zip(node.ops, node.comparators)):
+                if type(op) not in _BINARY:
+                    raise ValueError(
+                        f"Unsupported comparison {type(op).__name__}.")
+                self.visit(left)
+                self.visit(right)
+                self.emit(_BINARY[type(op)], push=-1)
+                if i > 0:
+                    self.emit(_BINARY[ast.And], push=-1)
+                left = right
+        elif (isinstance(node, ast.Call) and isinstance(node.func, ast.Name)
+              and node.func.id in _FUNCTIONS and len(node.args) == 1
+              and not node.keywords):
+            self.visit(node.args[0])
+            self.emit(_FUNCTIONS[node.func.id])
+        elif isinstance(node, ast.Name):
+            if node.id in _VARIABLES:
+                self.emit(_VARIABLES[node.id], push=1)
+            elif node.id in self.parameters:
+                self.push_number(float(self.parameters[node.id]))
+            else:
+                raise ValueError(f"Unknown name {node.id!r} in expression.")
+        elif isinstance(node, ast.Constant) and isinstance(node.value, str):
+            self.push_type_name(node.value)
+        elif isinstance(node, ast.Constant) and isinstance(
+                node.value, (bool, int, float)):
+            self.push_number(float(node.value))
+        else:
+            raise ValueError(
+                f"Unsupported syntax {type(node).__name__} in expression.")
+
+
+class Expression(ParticleFilter, ParticleFilterExpression):
+    """Select particles with an expression.
+
+    Args:
+        expression (str): Expression to evaluate for each particle.
+        parameters (dict[str, float]): Values of named constants in the
+            expression.
+
+    `Expression` selects the particles for which *expression* is true. HOOMD
+    compiles the expression once and evaluates it for all particles in C++
+    (or on the GPU), so updating the group with `hoomd.update.FilterUpdater`
+    costs about as much as one pass over the particles. Use `CustomFilter`
+    for selections that need the full system state.
+
+    The expression uses Python syntax with the variables:
+
+    * ``x``, ``y``, ``z`` - Particle position :math:`[\\mathrm{length}]`.
+    * ``vx``, ``vy``, ``vz`` - Particle velocity
+      :math:`[\\mathrm{velocity}]`.
+    * ``mass`` - Particle mass :math:`[\\mathrm{mass}]`.
+    * ``tag`` - Particle tag.
+    * ``type`` - Particle type, compare it to a type name in quotes.
+
+    It may use the arithmetic operators ``+``, ``-``, ``*``, ``/``, the
+    comparisons ``<``, ``<=``, ``>``, ``>=``, ``==``, ``!=`` (including
+    chained comparisons), the logical operators ``and``, ``or``, ``not``, and
+    the functions ``abs`` and ``sqrt``.
+
+    Example::
+
+        above_wall = hoomd.filter.Expression('z > wall',
+                                             parameters=dict(wall=5.0))
+        fast_A = hoomd.filter.Expression(
+            "type == 'A' and sqrt(vx*vx + vy*vy + vz*vz) > 2")
+
+    Base: `ParticleFilter`
+    """
+
+    def __init__(self, expression, parameters=None):
+        ParticleFilter.__init__(self)
+        if parameters is None:
+            parameters = {}
+        self._expression = expression
+        self._parameters = {
+            key: float(value) for key, value in parameters.items()
+        }
+        program, constants, type_names = _Compiler(
+            self._parameters).compile(expression)
+        ParticleFilterExpression.__init__(self, program, constants, type_names)
+
+    def __hash__(self):
+        """Return a hash of the filter parameters."""
+        return hash((self._expression, tuple(sorted(self._parameters.items()))))
+
+    def __eq__(self, other):
+        """Test for equality between two particle filters."""
+        return (type(self) == type(other)
+                and self._expression == other._expression
+                and self._parameters == other._parameters)
+
+    @property
+    def expression(self):
+        """str: Expression to evaluate for each particle."""
+        return self._expression
+
+    @property
+    def parameters(self):
+        """dict[str, float]: Values of named constants in the expression."""
+        return dict(self._parameters)
+
+    def __reduce__(self):
+        """Enable (deep)copying and pickling of `Expression` filters."""
+        return (type(self), (self.expression, self.parameters))
@@ -14,6 +14,8 @@
 #include <clang/Lex/HeaderSearch.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/InitializePasses.h>
@@ -25,6 +27,9 @@
 
 #pragma GCC diagnostic pop
 
+#include "JITCache.h"
+#include "hoomd/HOOMDVersion.h"
+
 #include <iostream>
 #include <sstream>
 
@@ -67,12 +72,43 @@ ClangCompiler::ClangCompiler()
     @param user_args The arguments to pass to the compiler.
 
     @returns The LLVM module with the code compiled.
+
+    The bitcode of the module is cached on disk with hpmc::detail::JITCache, so later calls with
+    the same code and arguments, in this or any other process, skip the clang front end.
 */
 std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code,
                                                          const std::vector<std::string>& user_args,
                                                          llvm::LLVMContext& context,
                                                          std::ostringstream& out)
     {
+    // the compiled module depends on the compiler, the target, the HOOMD headers, and the input
+    std::ostringstream cache_key_stream;
+    cache_key_stream << "clang " << CLANG_VERSION_STRING << "\n"
+                     << llvm::sys::getDefaultTargetTriple() << "\n"
+                     << "HOOMD " << HOOMD_VERSION << "\n";
+    for (auto& arg : user_args)
+        {
+        cache_key_stream << arg << "\n";
+        }
+    cache_key_stream << code;
+    const std::string cache_key = cache_key_stream.str();
+
+    std::string cached_bitcode;
+    if (hpmc::detail::JITCache::load(cache_key, cached_bitcode))
+        {
+        auto cached_module
+            = llvm::parseBitcodeFile(llvm::MemoryBufferRef(cached_bitcode, "code.bc"), context);
+        if (cached_module)
+            {
+            out << "Loaded the compiled code from " << hpmc::detail::JITCache::getPath()
+                << std::endl;
+            return std::move(*cached_module);
+            }
+
+        // compile the code again when the cache entry is unreadable
+        llvm::consumeError(cached_module.takeError());
+        }
+
     // initialize the diagnostics engine to write compilation warnings/errors to stdout/stderr
     clang::IntrusiveRefCntPtr<clang::DiagnosticOptions> diagnostic_options
         = new clang::DiagnosticOptions();
@@ -203,5 +239,15 @@ std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code
     //     passBuilder.buildPerModuleDefaultPipeline(llvm::PassBuilder::OptimizationLevel::O3);
     //     modulePassManager.run(*module, moduleAnalysisManager);
 
+    // save the module for later calls
+    if (!hpmc::detail::JITCache::getPath().empty())
+        {
+        std::string bitcode;
+        llvm::raw_string_ostream bitcode_stream(bitcode);
+        llvm::WriteBitcodeToFile(*module, bitcode_stream);
+        bitcode_stream.flush();
+        hpmc::detail::JITCache::store(cache_key, bitcode);
+        }
+
     return module;
     }
@@ -12,6 +12,11 @@
 #include "IntegratorHPMCMono.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 /*! \file ComputeFreeVolume.h
     \brief Defines the template class for an approximate free volume integration
     \note This header cannot be compiled by nvcc
@@ -84,6 +89,9 @@ template<class Shape> class ComputeFreeVolume : public Compute
 
     //! Return an estimate of the overlap volume
     virtual void computeFreeVolume(uint64_t timestep);
+
+    //! Get the number of strata along each box vector for stratified sampling
+    static unsigned int computeNumStrataDim(unsigned int n_sample, unsigned int ndim);
     };
 
 template<class Shape>
@@ -121,7 +129,6 @@ template<class Shape> void ComputeFreeVolume<Shape>::compute(uint64_t timestep)
 template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t timestep)
     {
     unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
     this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
@@ -147,6 +154,9 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
         const BoxDim& box = m_pdata->getBox();
 
         // access parameters and interaction matrix
@@ -166,18 +176,31 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
         n_sample /= this->m_exec_conf->getNRanks();
 #endif
 
-        for (unsigned int i = 0; i < n_sample; i++)
+        // stratify the samples over the box
+        unsigned int n_strata_dim = computeNumStrataDim(n_sample, ndim);
+        unsigned int n_strata = n_strata_dim * n_strata_dim * (ndim == 3 ? n_strata_dim : 1);
+        unsigned int n_stratified = n_sample / n_strata * n_strata;
+
+        // no sample can overlap when the test particle interacts with no type
+        bool check_overlaps = false;
+        for (unsigned int typ_j = 0; typ_j < m_pdata->getNTypes(); typ_j++)
+            {
+            if (h_overlaps.data[overlap_idx(m_type, typ_j)])
+                check_overlaps = true;
+            }
+
+        const unsigned int n_images = (unsigned int)image_list.size();
+        const unsigned int rank = m_exec_conf->getRank();
+
+        // test one sample for overlaps, return true if it overlaps with any particle
+        auto test_sample = [&](unsigned int i)
             {
             // select a random particle coordinate in the box
             hoomd::RandomGenerator rng_i(
                 hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
-                hoomd::Counter(m_exec_conf->getRank(), i));
-
-            Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                hoomd::Counter(rank, i));
 
-            Scalar3 f = make_scalar3(xrand, yrand, zrand);
+            Scalar3 f = generateStratifiedFraction(rng_i, i, n_strata_dim, n_stratified, ndim);
             vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
             Shape shape_i(quat<Scalar>(), params[m_type]);
@@ -187,11 +210,10 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                 }
 
             // check for overlaps with neighboring particle's positions
-            bool overlap = false;
+            unsigned int err_count = 0;
             detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
 
             // All image boxes (including the primary)
-            const unsigned int n_images = (unsigned int)image_list.size();
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                 {
                 vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
@@ -213,25 +235,23 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                                 // read in its position and orientation
                                 unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
-
-                                // load the position and orientation of the j particle
-                                postype_j = h_postype.data[j];
-                                orientation_j = h_orientation.data[j];
+                                // load the position of the j particle, skip non-interacting types
+                                Scalar4 postype_j = h_postype.data[j];
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                if (!h_overlaps.data[overlap_idx(m_type, typ_j)])
+                                    continue;
 
                                 // put particles in coordinate system of particle i
                                 vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
+                                Shape shape_j(quat<Scalar>(h_orientation.data[j]), params[typ_j]);
+                                m_mc->applyParticleScale(shape_j, h_diameter.data[j]);
 
-                                if (h_overlaps.data[overlap_idx(m_type, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                // the first overlap decides the sample
+                                if (check_circumsphere_overlap(r_ij, shape_i, shape_j)
                                     && test_overlap(r_ij, shape_i, shape_j, err_count))
                                     {
-                                    overlap = true;
-                                    break;
+                                    return true;
                                     }
                                 }
                             }
@@ -241,21 +261,40 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                         // skip ahead
                         cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
                         }
-
-                    if (overlap)
-                        break;
                     } // end loop over AABB nodes
+                }     // end loop over images
 
-                if (overlap)
-                    break;
-                } // end loop over images
+            return false;
+            };
 
-            if (overlap)
+        if (check_overlaps)
+            {
+#ifdef ENABLE_TBB
+            m_exec_conf->getTaskArena()->execute(
+                [&]
                 {
-                overlap_count++;
+                    overlap_count = tbb::parallel_reduce(
+                        tbb::blocked_range<unsigned int>(0, n_sample),
+                        0u,
+                        [&](const tbb::blocked_range<unsigned int>& r, unsigned int count)
+                        {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                if (test_sample(i))
+                                    count++;
+                                }
+                            return count;
+                        },
+                        [](unsigned int a, unsigned int b) { return a + b; });
+                });
+#else
+            for (unsigned int i = 0; i < n_sample; i++)
+                {
+                if (test_sample(i))
+                    overlap_count++;
                 }
-            } // end loop through all particles
-
+#endif
+            }
         } // end lexical scope
 
 #ifdef ENABLE_MPI
@@ -279,6 +318,29 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
     *h_n_overlap_all.data = overlap_count;
     }
 
+/*! \param n_sample Number of samples on this rank
+    \param ndim Dimensionality of the system
+    \returns The largest number of strata along each box vector such that every stratum holds at
+             least one sample
+*/
+template<class Shape>
+unsigned int ComputeFreeVolume<Shape>::computeNumStrataDim(unsigned int n_sample, unsigned int ndim)
+    {
+    if (n_sample == 0)
+        return 1;
+
+    unsigned int n = (unsigned int)std::pow(double(n_sample), 1.0 / double(ndim));
+
+    // correct round off in pow
+    auto n_strata = [ndim](unsigned int m) { return (uint64_t)m * m * (ndim == 3 ? m : 1); };
+    while (n_strata(n + 1) <= n_sample)
+        n++;
+    while (n > 1 && n_strata(n) > n_sample)
+        n--;
+
+    return n > 0 ? n : 1;
+    }
+
 // \return the free volume.
 template<class Shape> Scalar ComputeFreeVolume<Shape>::getFreeVolume()
     {
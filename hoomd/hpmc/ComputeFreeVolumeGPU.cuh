@@ -33,6 +33,8 @@ struct hpmc_free_volume_args_t
     {
     //! Construct a pair_args_t
     hpmc_free_volume_args_t(unsigned int _n_sample,
+                            unsigned int _n_strata_dim,
+                            unsigned int _n_stratified,
                             unsigned int _type,
                             Scalar4* _d_postype,
                             Scalar4* _d_orientation,
@@ -61,7 +63,8 @@ struct hpmc_free_volume_args_t
                             const unsigned int* _d_check_overlaps,
                             Index2D _overlap_idx,
                             const hipDeviceProp_t& _devprop)
-        : n_sample(_n_sample), type(_type), d_postype(_d_postype), d_orientation(_d_orientation),
+        : n_sample(_n_sample), n_strata_dim(_n_strata_dim), n_stratified(_n_stratified),
+          type(_type), d_postype(_d_postype), d_orientation(_d_orientation),
           d_cell_idx(_d_cell_idx), d_cell_size(_d_cell_size), ci(_ci), cli(_cli),
           d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
           cell_dim(_cell_dim), N(_N), num_types(_num_types), seed(_seed), rank(_rank),
@@ -71,6 +74,8 @@ struct hpmc_free_volume_args_t
           d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx), devprop(_devprop) {};
 
     unsigned int n_sample;                //!< Number of depletants particles to generate
+    unsigned int n_strata_dim;            //!< Number of strata along each box vector
+    unsigned int n_stratified;            //!< Number of stratified samples
     unsigned int type;                    //!< Type of depletant particle
     Scalar4* d_postype;                   //!< postype array
     Scalar4* d_orientation;               //!< orientation array
@@ -135,6 +140,8 @@ __device__ inline unsigned int compute_cell_idx(const Scalar3 p,
 
 //! Kernel to estimate the colloid overlap volume and the depletant free volume
 /*! \param n_sample Number of probe depletant particles to generate
+    \param n_strata_dim Number of strata along each box vector
+    \param n_stratified Number of stratified samples
     \param type Type of depletant particle
     \param d_postype Particle positions and types by index
     \param d_orientation Particle orientation
@@ -158,6 +165,8 @@ __device__ inline unsigned int compute_cell_idx(const Scalar3 p,
 */
 template<class Shape>
 __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
+                                            unsigned int n_strata_dim,
+                                            unsigned int n_stratified,
                                             unsigned int type,
                                             Scalar4* d_postype,
                                             Scalar4* d_orientation,
@@ -267,12 +276,8 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
 
     if (active)
         {
-        // select a random particle coordinate in the box
-        Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng);
-        Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng);
-        Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng);
-
-        Scalar3 f = make_scalar3(xrand, yrand, zrand);
+        // select a stratified random particle coordinate in the box
+        Scalar3 f = generateStratifiedFraction(rng, i, n_strata_dim, n_stratified, dim);
         pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
         if (shape_i.hasOrientation())
@@ -292,6 +297,10 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
 
         for (unsigned int k = 0; k < excell_size; k += group_size)
             {
+            // stop as soon as any thread in the group finds an overlap
+            if (((volatile unsigned int*)s_overlap)[group])
+                break;
+
             unsigned int local_k = k + offset;
             if (local_k < excell_size)
                 {
@@ -299,8 +308,11 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
                 unsigned int j = __ldg(&d_excell_idx[excli(local_k, my_cell)]);
 
                 Scalar4 postype_j = __ldg(d_postype + j);
-                Scalar4 orientation_j = make_scalar4(1, 0, 0, 0);
                 unsigned int typ_j = __scalar_as_int(postype_j.w);
+                if (!s_check_overlaps[overlap_idx(typ_j, type)])
+                    continue;
+
+                Scalar4 orientation_j = make_scalar4(1, 0, 0, 0);
                 Shape shape_j(quat<Scalar>(orientation_j), s_params[typ_j]);
                 if (shape_j.hasOrientation())
                     shape_j.orientation = quat<Scalar>(__ldg(d_orientation + j));
@@ -318,8 +330,7 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
                     {
                     // circumsphere overlap
                     unsigned int err_count;
-                    if (s_check_overlaps[overlap_idx(typ_j, type)]
-                        && test_overlap(r_ij, shape_i, shape_j, err_count))
+                    if (test_overlap(r_ij, shape_i, shape_j, err_count))
                         {
                         s_overlap[group] = 1;
                         break;
@@ -412,6 +423,8 @@ hipError_t gpu_hpmc_free_volume(const hpmc_free_volume_args_t& args,
                        shared_bytes,
                        0,
                        args.n_sample,
+                       args.n_strata_dim,
+                       args.n_stratified,
                        args.type,
                        args.d_postype,
                        args.d_orientation,
@@ -269,7 +269,15 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
         n_sample /= this->m_exec_conf->getNRanks();
 #endif
 
+        // stratify the samples over the box
+        unsigned int ndim = this->m_sysdef->getNDimensions();
+        unsigned int n_strata_dim = this->computeNumStrataDim(n_sample, ndim);
+        unsigned int n_strata = n_strata_dim * n_strata_dim * (ndim == 3 ? n_strata_dim : 1);
+        unsigned int n_stratified = n_sample / n_strata * n_strata;
+
         detail::hpmc_free_volume_args_t free_volume_args(n_sample,
+                                                         n_strata_dim,
+                                                         n_stratified,
                                                          this->m_type,
                                                          d_postype.data,
                                                          d_orientation.data,
@@ -287,7 +295,7 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
                                                          this->m_exec_conf->getRank(),
                                                          0,
                                                          timestep,
-                                                         this->m_sysdef->getNDimensions(),
+                                                         ndim,
                                                          box,
                                                          block_size,
                                                          stride,
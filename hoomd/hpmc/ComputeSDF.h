@@ -161,7 +161,7 @@ template<class Shape> class ComputeSDF : public Compute
     void zeroHistogram();
 
     //! Add to histogram counts
-    void countHistogram(uint64_t timestep);
+    virtual void countHistogram(uint64_t timestep);
 
     //! Determine the s bin of a given particle pair
     size_t computeBin(const vec3<Scalar>& r_ij,
@@ -283,6 +283,9 @@ template<class Shape> void ComputeSDF<Shape>::zeroHistogram()
 */
 template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
     {
+    if (m_mc->getScaleByDiameter())
+        throw std::runtime_error("ComputeSDF does not support scale_by_diameter.");
+
     // update the aabb tree
     const detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
     // update the image list
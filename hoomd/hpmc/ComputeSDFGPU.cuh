@@ -0,0 +1,320 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_SDF_GPU_CUH_
+#define _COMPUTE_SDF_GPU_CUH_
+
+#include "HPMCPrecisionSetup.h"
+#include "hip/hip_runtime.h"
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+#ifdef __HIPCC__
+#include "ComputeFreeVolumeGPU.cuh"
+#endif
+
+/*! \file ComputeSDFGPU.cuh
+    \brief Declaration of the CUDA kernel driver for the scale distribution function
+*/
+
+namespace hpmc
+    {
+namespace detail
+    {
+//! Wraps arguments to gpu_hpmc_sdf
+/*! \ingroup hpmc_data_structs */
+struct hpmc_sdf_args_t
+    {
+    //! Construct a hpmc_sdf_args_t
+    hpmc_sdf_args_t(const Scalar4* _d_postype,
+                    const Scalar4* _d_orientation,
+                    const Index3D& _ci,
+                    const unsigned int* _d_excell_idx,
+                    const unsigned int* _d_excell_size,
+                    const Index2D& _excli,
+                    const uint3& _cell_dim,
+                    const Scalar3 _ghost_width,
+                    const unsigned int _N,
+                    const unsigned int _num_types,
+                    const BoxDim& _box,
+                    const Scalar _dx,
+                    const unsigned int _n_bins,
+                    unsigned int* _d_hist,
+                    const unsigned int _block_size,
+                    const unsigned int _group_size,
+                    const hipDeviceProp_t& _devprop)
+        : d_postype(_d_postype), d_orientation(_d_orientation), ci(_ci),
+          d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
+          cell_dim(_cell_dim), ghost_width(_ghost_width), N(_N), num_types(_num_types), box(_box),
+          dx(_dx), n_bins(_n_bins), d_hist(_d_hist), block_size(_block_size),
+          group_size(_group_size), devprop(_devprop) {};
+
+    const Scalar4* d_postype;          //!< postype array
+    const Scalar4* d_orientation;      //!< orientation array
+    const Index3D& ci;                 //!< Cell indexer
+    const unsigned int* d_excell_idx;  //!< Expanded cell neighbors
+    const unsigned int* d_excell_size; //!< Size of expanded cell list per cell
+    const Index2D excli;               //!< Expanded cell indexer
+    const uint3& cell_dim;             //!< Cell dimensions
+    const Scalar3 ghost_width;         //!< Width of ghost layer
+    const unsigned int N;              //!< Number of particles
+    const unsigned int num_types;      //!< Number of particle types
+    const BoxDim& box;                 //!< Current simulation box
+    const Scalar dx;                   //!< Histogram bin width
+    const unsigned int n_bins;         //!< Number of histogram bins
+    unsigned int* d_hist;              //!< Histogram counts (output)
+    unsigned int block_size;           //!< Block size to execute
+    unsigned int group_size;           //!< Number of threads that process one particle
+    const hipDeviceProp_t& devprop;    //!< CUDA device properties
+    };
+
+template<class Shape>
+hipError_t gpu_hpmc_sdf(const hpmc_sdf_args_t& args, const typename Shape::param_type* d_params);
+
+#ifdef __HIPCC__
+
+//! Test the overlap of two particles after scaling their separation by 1 - lambda
+template<class Shape>
+__device__ inline bool test_scaled_overlap_device(const vec3<Scalar>& r_ij,
+                                                  const Shape& shape_i,
+                                                  const Shape& shape_j,
+                                                  Scalar lambda)
+    {
+    unsigned int err_count = 0;
+    vec3<Scalar> r_ij_scaled = r_ij * (Scalar(1.0) - lambda);
+    return check_circumsphere_overlap(r_ij_scaled, shape_i, shape_j)
+           && test_overlap(r_ij_scaled, shape_i, shape_j, err_count);
+    }
+
+//! Find the histogram bin of a particle pair with a binary search, as in ComputeSDF::computeBin()
+/*! \returns n_bins when the pair overlaps without scaling or does not overlap at the largest scale
+ */
+template<class Shape>
+__device__ inline unsigned int compute_sdf_bin(const vec3<Scalar>& r_ij,
+                                               const Shape& shape_i,
+                                               const Shape& shape_j,
+                                               const Scalar dx,
+                                               const unsigned int n_bins)
+    {
+    unsigned int L = 0;
+    unsigned int R = n_bins;
+
+    if (test_scaled_overlap_device(r_ij, shape_i, shape_j, Scalar(L) * dx))
+        return n_bins;
+
+    if (!test_scaled_overlap_device(r_ij, shape_i, shape_j, Scalar(R) * dx))
+        return n_bins;
+
+    do
+        {
+        unsigned int m = (L + R) / 2;
+
+        if (test_scaled_overlap_device(r_ij, shape_i, shape_j, Scalar(m) * dx))
+            R = m;
+        else
+            L = m;
+        } while ((R - L) > 1);
+
+    return L;
+    }
+
+//! Kernel to histogram the smallest scale factor at which each particle touches a neighbor
+/*! \param d_postype Particle positions and types by index
+    \param d_orientation Particle orientation
+    \param ci Cell indexer
+    \param d_excell_idx Expanded cell neighbors
+    \param d_excell_size Size of expanded cell list per cell
+    \param excli Expanded cell indexer
+    \param cell_dim Dimensions of the cell list
+    \param ghost_width Width of ghost layer
+    \param N number of local particles
+    \param num_types Number of particle types
+    \param box Simulation box
+    \param dx Histogram bin width
+    \param n_bins Number of histogram bins
+    \param d_hist Histogram counts (output value)
+    \param d_params Per-type shape parameters
+
+    Each group of threads (threadIdx.y) processes one particle. The threads in the group
+    (threadIdx.x) split the particles in the expanded cell and reduce the smallest bin in shared
+    memory.
+*/
+template<class Shape>
+__global__ void gpu_hpmc_sdf_kernel(const Scalar4* d_postype,
+                                    const Scalar4* d_orientation,
+                                    const Index3D ci,
+                                    const unsigned int* d_excell_idx,
+                                    const unsigned int* d_excell_size,
+                                    const Index2D excli,
+                                    const uint3 cell_dim,
+                                    const Scalar3 ghost_width,
+                                    const unsigned int N,
+                                    const unsigned int num_types,
+                                    const BoxDim box,
+                                    const Scalar dx,
+                                    const unsigned int n_bins,
+                                    unsigned int* d_hist,
+                                    const typename Shape::param_type* d_params,
+                                    unsigned int max_extra_bytes)
+    {
+    unsigned int offset = threadIdx.x;
+    unsigned int group_size = blockDim.x;
+    unsigned int group = threadIdx.y;
+    unsigned int n_groups = blockDim.y;
+    bool master = (offset == 0);
+
+    unsigned int i = blockIdx.x * n_groups + group;
+
+    // load the per type parameters into shared memory
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename Shape::param_type* s_params = (typename Shape::param_type*)(&s_data[0]);
+    unsigned int* s_min_bin = (unsigned int*)(s_params + num_types);
+
+    // copy over parameters one int per thread for fast loads
+        {
+        unsigned int tidx = threadIdx.x + blockDim.x * threadIdx.y;
+        unsigned int block_size = blockDim.x * blockDim.y;
+        unsigned int param_size = num_types * sizeof(typename Shape::param_type) / sizeof(int);
+
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < param_size)
+                {
+                ((int*)s_params)[cur_offset + tidx] = ((int*)d_params)[cur_offset + tidx];
+                }
+            }
+        }
+
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_min_bin + n_groups);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+        s_params[cur_type].load_shared(s_extra, available_bytes);
+
+    if (master)
+        s_min_bin[group] = n_bins;
+
+    __syncthreads();
+
+    if (i < N)
+        {
+        Scalar4 postype_i = d_postype[i];
+        Shape shape_i(quat<Scalar>(d_orientation[i]), s_params[__scalar_as_int(postype_i.w)]);
+        vec3<Scalar> pos_i(postype_i);
+        unsigned int my_cell
+            = compute_cell_idx(vec_to_scalar3(pos_i), box, ghost_width, cell_dim, ci);
+
+        unsigned int min_bin = n_bins;
+        unsigned int excell_size = d_excell_size[my_cell];
+        for (unsigned int k = offset; k < excell_size; k += group_size)
+            {
+            unsigned int j = __ldg(&d_excell_idx[excli(k, my_cell)]);
+            if (j == i)
+                continue;
+
+            Scalar4 postype_j = __ldg(d_postype + j);
+            Shape shape_j(quat<Scalar>(__ldg(d_orientation + j)),
+                          s_params[__scalar_as_int(postype_j.w)]);
+
+            // put particle j into the coordinate system of particle i
+            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i;
+            r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(r_ij)));
+
+            unsigned int bin = compute_sdf_bin(r_ij, shape_i, shape_j, dx, n_bins);
+            min_bin = min(min_bin, bin);
+            }
+
+        if (min_bin < n_bins)
+            atomicMin(&s_min_bin[group], min_bin);
+        }
+
+    __syncthreads();
+
+    if (master && i < N && s_min_bin[group] < n_bins)
+        atomicAdd(&d_hist[s_min_bin[group]], 1);
+    }
+
+//! Kernel driver for gpu_hpmc_sdf_kernel()
+/*! \param args Bundled arguments
+    \param d_params Per-type shape parameters
+    \returns Error codes generated by any CUDA calls, or hipSuccess when there is no error
+
+    \ingroup hpmc_kernels
+*/
+template<class Shape>
+hipError_t gpu_hpmc_sdf(const hpmc_sdf_args_t& args, const typename Shape::param_type* d_params)
+    {
+    assert(args.d_postype);
+    assert(args.d_orientation);
+    assert(args.group_size >= 1);
+    assert(args.block_size % args.group_size == 0);
+
+    // reset counters
+    hipMemsetAsync(args.d_hist, 0, sizeof(unsigned int) * args.n_bins);
+
+    // determine the maximum block size and clamp the input block size down
+    int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_hpmc_sdf_kernel<Shape>));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    // setup the grid to run the kernel
+    unsigned int n_groups = min(args.block_size, (unsigned int)max_block_size) / args.group_size;
+
+    dim3 threads(args.group_size, n_groups, 1);
+    dim3 grid(args.N / n_groups + 1, 1, 1);
+
+    size_t shared_bytes
+        = args.num_types * sizeof(typename Shape::param_type) + n_groups * sizeof(unsigned int);
+
+    unsigned int max_extra_bytes = static_cast<unsigned int>(args.devprop.sharedMemPerBlock
+                                                             - attr.sharedSizeBytes - shared_bytes);
+
+    // determine dynamically requested shared memory
+    char* ptr = (char*)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < args.num_types; ++i)
+        {
+        d_params[i].allocate_shared(ptr, available_bytes);
+        }
+    const unsigned int extra_bytes = max_extra_bytes - available_bytes;
+
+    shared_bytes += extra_bytes;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_hpmc_sdf_kernel<Shape>),
+                       dim3(grid),
+                       dim3(threads),
+                       shared_bytes,
+                       0,
+                       args.d_postype,
+                       args.d_orientation,
+                       args.ci,
+                       args.d_excell_idx,
+                       args.d_excell_size,
+                       args.excli,
+                       args.cell_dim,
+                       args.ghost_width,
+                       args.N,
+                       args.num_types,
+                       args.box,
+                       args.dx,
+                       args.n_bins,
+                       args.d_hist,
+                       d_params,
+                       max_extra_bytes);
+
+    return hipSuccess;
+    }
+
+#endif // __HIPCC__
+
+    }; // end namespace detail
+
+    } // end namespace hpmc
+
+#endif // _COMPUTE_SDF_GPU_CUH_
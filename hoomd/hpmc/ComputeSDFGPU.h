@@ -0,0 +1,327 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __COMPUTE_SDF_GPU_H__
+#define __COMPUTE_SDF_GPU_H__
+
+#ifdef ENABLE_HIP
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/CellList.h"
+#include "hoomd/GPUArray.h"
+
+#include "ComputeSDF.h"
+#include "ComputeSDFGPU.cuh"
+#include "IntegratorHPMCMonoGPUTypes.cuh"
+
+/*! \file ComputeSDFGPU.h
+    \brief Defines the template class for an sdf compute on the GPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+//! SDF analysis on the GPU
+/*! ComputeSDFGPU counts the histogram with the same binary search over scaled overlap tests as
+    ComputeSDF. Particles find their neighbors in the expanded cells of a cell list with a nominal
+    width wide enough for all pairs that may touch at the largest scale factor. The histogram stays
+    on the device until computeSDF() reduces it, so GPU simulations do not need to copy the particle
+    data back to the host to evaluate the pressure.
+
+    \ingroup hpmc_computes
+*/
+template<class Shape> class ComputeSDFGPU : public ComputeSDF<Shape>
+    {
+    public:
+    //! Construct the compute
+    ComputeSDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                  std::shared_ptr<CellList> cl,
+                  double xmax,
+                  double dx);
+    //! Destructor
+    virtual ~ComputeSDFGPU() {};
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner_sdf->setPeriod(period);
+        m_tuner_sdf->setEnabled(enable);
+
+        m_tuner_excell_block_size->setPeriod(period);
+        m_tuner_excell_block_size->setEnabled(enable);
+        }
+
+    protected:
+    std::shared_ptr<CellList> m_cl; //!< The cell list
+
+    uint3 m_last_dim;         //!< Dimensions of the cell list on the last call to update
+    unsigned int m_last_nmax; //!< Last cell list NMax value allocated in excell
+
+    GPUArray<unsigned int> m_excell_idx;  //!< Particle indices in expanded cells
+    GPUArray<unsigned int> m_excell_size; //!< Number of particles in each expanded cell
+    Index2D m_excell_list_indexer;        //!< Indexer to access elements of the excell_idx list
+
+    GPUArray<unsigned int> m_hist_gpu; //!< Histogram counts on the device
+
+    std::unique_ptr<Autotuner> m_tuner_sdf;               //!< Autotuner for the histogram kernel
+    std::unique_ptr<Autotuner> m_tuner_excell_block_size; //!< Autotuner for excell block_size
+
+    //! Add to histogram counts
+    virtual void countHistogram(uint64_t timestep);
+
+    void initializeExcellMem();
+    };
+
+template<class Shape>
+ComputeSDFGPU<Shape>::ComputeSDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                                    std::shared_ptr<CellList> cl,
+                                    double xmax,
+                                    double dx)
+    : ComputeSDF<Shape>(sysdef, mc, xmax, dx), m_cl(cl)
+    {
+    this->m_cl->setRadius(1);
+    this->m_cl->setComputeTDB(false);
+    this->m_cl->setFlagType();
+    this->m_cl->setComputeIdx(true);
+
+    // initialize the autotuners
+    // the block size and group size are searched, encoded as block_size*10000 + group_size.
+    std::vector<unsigned int> valid_params;
+    unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+    for (unsigned int block_size = warp_size;
+         block_size <= (unsigned int)this->m_exec_conf->dev_prop.maxThreadsPerBlock;
+         block_size += warp_size)
+        {
+        for (auto s : Autotuner::getTppListPow2(warp_size))
+            {
+            if ((block_size % s) == 0)
+                valid_params.push_back(block_size * 10000 + s);
+            }
+        }
+    m_tuner_sdf.reset(new Autotuner(valid_params, 5, 1000000, "hpmc_sdf", this->m_exec_conf));
+
+    GPUArray<unsigned int> excell_size(0, this->m_exec_conf);
+    m_excell_size.swap(excell_size);
+
+    GPUArray<unsigned int> excell_idx(0, this->m_exec_conf);
+    m_excell_idx.swap(excell_idx);
+
+    GPUArray<unsigned int> hist_gpu(0, this->m_exec_conf);
+    m_hist_gpu.swap(hist_gpu);
+
+    // set last dim to a bogus value so that it will re-init on the first call
+    m_last_dim = make_uint3(0xffffffff, 0xffffffff, 0xffffffff);
+    m_last_nmax = 0xffffffff;
+
+    m_tuner_excell_block_size.reset(new Autotuner(warp_size,
+                                                  this->m_exec_conf->dev_prop.maxThreadsPerBlock,
+                                                  warp_size,
+                                                  5,
+                                                  1000000,
+                                                  "hpmc_sdf_excell_block_size",
+                                                  this->m_exec_conf));
+    }
+
+/*! \param timestep current timestep
+
+    countHistogram() adds the minimum bin of every local particle to m_hist, like
+    ComputeSDF::countHistogram().
+*/
+template<class Shape> void ComputeSDFGPU<Shape>::countHistogram(uint64_t timestep)
+    {
+    // particles touch at the largest scale factor when they are closer than this width
+    Scalar max_diam = this->m_mc->getMaxCoreDiameter();
+    Scalar nominal_width = max_diam + this->m_xmax / (1 - this->m_xmax) * max_diam;
+
+    if (this->m_cl->getNominalWidth() != nominal_width)
+        this->m_cl->setNominalWidth(nominal_width);
+
+    const BoxDim& box = this->m_pdata->getBox();
+    Scalar3 npd = box.getNearestPlaneDistance();
+
+    if ((box.getPeriodic().x && npd.x <= nominal_width * 2)
+        || (box.getPeriodic().y && npd.y <= nominal_width * 2)
+        || (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z
+            && npd.z <= nominal_width * 2))
+        {
+        this->m_exec_conf->msg->error() << "Simulation box too small for compute.sdf() on GPU - "
+                                           "increase it so the minimum image convention works"
+                                        << std::endl;
+        throw std::runtime_error("Error computing SDF");
+        }
+
+    // compute cell list
+    this->m_cl->compute(timestep);
+
+    // if the cell list is a different size than last time, reinitialize expanded cell list
+    uint3 cur_dim = this->m_cl->getDim();
+    if (this->m_last_dim.x != cur_dim.x || this->m_last_dim.y != cur_dim.y
+        || this->m_last_dim.z != cur_dim.z || this->m_last_nmax != this->m_cl->getNmax())
+        {
+        this->initializeExcellMem();
+        m_last_dim = cur_dim;
+        m_last_nmax = this->m_cl->getNmax();
+        }
+
+    unsigned int n_bins = (unsigned int)this->m_hist.size();
+    if (m_hist_gpu.getNumElements() != n_bins)
+        {
+        m_hist_gpu.resize(n_bins);
+        }
+
+        {
+        // access the cell list data
+        ArrayHandle<unsigned int> d_cell_size(this->m_cl->getCellSizeArray(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_cell_idx(this->m_cl->getIndexArray(),
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<unsigned int> d_cell_adj(this->m_cl->getCellAdjArray(),
+                                             access_location::device,
+                                             access_mode::read);
+
+        // per-device cell list data
+        const ArrayHandle<unsigned int>& d_cell_size_per_device
+            = this->m_cl->getPerDevice()
+                  ? ArrayHandle<unsigned int>(this->m_cl->getCellSizeArrayPerDevice(),
+                                              access_location::device,
+                                              access_mode::read)
+                  : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                              access_location::device,
+                                              access_mode::read);
+        const ArrayHandle<unsigned int>& d_cell_idx_per_device
+            = this->m_cl->getPerDevice()
+                  ? ArrayHandle<unsigned int>(this->m_cl->getIndexArrayPerDevice(),
+                                              access_location::device,
+                                              access_mode::read)
+                  : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                              access_location::device,
+                                              access_mode::read);
+
+        ArrayHandle<unsigned int> d_excell_idx(this->m_excell_idx,
+                                               access_location::device,
+                                               access_mode::readwrite);
+        ArrayHandle<unsigned int> d_excell_size(this->m_excell_size,
+                                                access_location::device,
+                                                access_mode::readwrite);
+
+        // update the expanded cells
+        this->m_tuner_excell_block_size->begin();
+        gpu::hpmc_excell(d_excell_idx.data,
+                         d_excell_size.data,
+                         m_excell_list_indexer,
+                         this->m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
+                         this->m_cl->getPerDevice() ? d_cell_size_per_device.data
+                                                    : d_cell_size.data,
+                         d_cell_adj.data,
+                         this->m_cl->getCellIndexer(),
+                         this->m_cl->getCellListIndexer(),
+                         this->m_cl->getCellAdjIndexer(),
+                         this->m_cl->getPerDevice() ? this->m_exec_conf->getNumActiveGPUs() : 1,
+                         this->m_tuner_excell_block_size->getParam());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        this->m_tuner_excell_block_size->end();
+
+        // access the particle data
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> d_hist(m_hist_gpu,
+                                         access_location::device,
+                                         access_mode::overwrite);
+
+        // access the parameters
+        const std::vector<typename Shape::param_type,
+                          managed_allocator<typename Shape::param_type>>& params
+            = this->m_mc->getParams();
+
+        m_tuner_sdf->begin();
+        unsigned int param = m_tuner_sdf->getParam();
+        unsigned int block_size = param / 10000;
+        unsigned int group_size = param % 10000;
+
+        detail::hpmc_sdf_args_t sdf_args(d_postype.data,
+                                         d_orientation.data,
+                                         this->m_cl->getCellIndexer(),
+                                         d_excell_idx.data,
+                                         d_excell_size.data,
+                                         this->m_excell_list_indexer,
+                                         this->m_cl->getDim(),
+                                         this->m_cl->getGhostWidth(),
+                                         this->m_pdata->getN(),
+                                         this->m_pdata->getNTypes(),
+                                         box,
+                                         this->m_dx,
+                                         n_bins,
+                                         d_hist.data,
+                                         block_size,
+                                         group_size,
+                                         this->m_exec_conf->dev_prop);
+
+        detail::gpu_hpmc_sdf<Shape>(sdf_args, params.data());
+
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_tuner_sdf->end();
+        }
+
+    // copy the histogram to the host for the reduction in computeSDF()
+    ArrayHandle<unsigned int> h_hist(m_hist_gpu, access_location::host, access_mode::read);
+    std::copy(h_hist.data, h_hist.data + n_bins, this->m_hist.begin());
+    }
+
+template<class Shape> void ComputeSDFGPU<Shape>::initializeExcellMem()
+    {
+    this->m_exec_conf->msg->notice(4) << "hpmc resizing expanded cells" << std::endl;
+
+    // get the current cell dimensions
+    unsigned int num_cells = this->m_cl->getCellIndexer().getNumElements();
+    unsigned int num_adj = this->m_cl->getCellAdjIndexer().getW();
+    unsigned int num_max = this->m_cl->getNmax();
+
+    // make the excell dimensions the same, but with room for Nmax*Nadj in each cell
+    m_excell_list_indexer = Index2D(num_max * num_adj, num_cells);
+
+    // reallocate memory
+    m_excell_idx.resize(m_excell_list_indexer.getNumElements());
+    m_excell_size.resize(num_cells);
+    }
+
+//! Export this hpmc compute to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of ComputeSDFGPU<Shape> will be exported
+*/
+template<class Shape> void export_ComputeSDFGPU(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<ComputeSDFGPU<Shape>,
+                     ComputeSDF<Shape>,
+                     std::shared_ptr<ComputeSDFGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
+                            std::shared_ptr<CellList>,
+                            double,
+                            double>());
+    }
+
+    } // end namespace hpmc
+
+#endif // ENABLE_HIP
+
+#endif // __COMPUTE_SDF_GPU_H__
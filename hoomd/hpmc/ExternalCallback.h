@@ -126,6 +126,7 @@ class __attribute__((visibility("hidden"))) ExternalCallback : public ExternalFi
     double getEnergy(std::shared_ptr<SnapshotSystemData<Scalar>> snap)
         {
         double e = 0.0;
+        pybind11::gil_scoped_acquire acquire;
         if (!callback.is(pybind11::none()))
             {
             pybind11::object rv = callback(snap);
@@ -14,6 +14,10 @@
 
 #include "HPMCCounters.h" // do we need this to keep track of the statistics?
 
+#ifdef ENABLE_HIP
+#include "ExternalFieldGPU.cuh"
+#endif
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #endif
@@ -70,6 +74,26 @@ template<class Shape> class ExternalFieldMono : public ExternalField
 
     ~ExternalFieldMono() { }
 
+#ifdef ENABLE_HIP
+    //! A struct that contains the kernel arguments
+    typedef gpu::hpmc_external_args_t gpu_args_t;
+
+    //! Apply the field to the trial moves proposed on the GPU
+    /*! \param args Kernel arguments
+        \param params Shape parameters of each type, accessible on the device
+
+        Fields that implement this method set args.d_reject_out_of_cell for the trial moves that
+        they reject.
+
+        \returns false when the field has no GPU implementation
+    */
+    virtual bool rejectTrialMovesGPU(const gpu_args_t& args,
+                                     const typename Shape::param_type* params)
+        {
+        return false;
+        }
+#endif
+
     //! needed for Compute. currently not used.
     virtual void compute(uint64_t timestep) { }
 
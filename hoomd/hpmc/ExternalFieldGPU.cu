@@ -0,0 +1,309 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ExternalFieldGPU.cuh"
+#include "ShapeSphere.h"
+
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file ExternalFieldGPU.cu
+    \brief Definition of the GPU kernels that apply HPMC external fields to trial moves
+*/
+
+namespace hpmc
+    {
+namespace gpu
+    {
+namespace kernel
+    {
+//! Test whether a sphere of radius \a radius is confined by a sphere wall
+__device__ inline bool
+test_confined_sphere(const hpmc_sphere_wall_t& wall, const vec3<Scalar>& r, const Scalar radius)
+    {
+    Scalar max_dist = sqrt(dot(r, r));
+    if (wall.inside)
+        return wall.rsq > (max_dist + radius) * (max_dist + radius);
+
+    max_dist = fmax(max_dist - radius, Scalar(0.0));
+    return wall.rsq < max_dist * max_dist;
+    }
+
+//! Test whether a sphere of radius \a radius is confined by a cylinder wall
+__device__ inline bool test_confined_cylinder(const hpmc_cylinder_wall_t& wall,
+                                              const vec3<Scalar>& r,
+                                              const Scalar radius)
+    {
+    vec3<Scalar> dist_vec = cross(r, wall.orientation);
+    Scalar max_dist = sqrt(dot(dist_vec, dist_vec));
+    if (wall.inside)
+        return wall.rsq > (max_dist + radius) * (max_dist + radius);
+
+    max_dist = fmax(max_dist - radius, Scalar(0.0));
+    return wall.rsq < max_dist * max_dist;
+    }
+
+//! Reject the trial moves of spheres that leave the walls
+__global__ void hpmc_external_walls(const Scalar4* d_trial_postype,
+                                    const unsigned int* d_trial_move_type,
+                                    unsigned int* d_reject_out_of_cell,
+                                    const BoxDim box,
+                                    const Scalar3 origin,
+                                    const unsigned int nwork,
+                                    const unsigned int offset,
+                                    const SphereParams* d_params,
+                                    const hpmc_sphere_wall_t* d_sphere_walls,
+                                    const unsigned int n_sphere_walls,
+                                    const hpmc_cylinder_wall_t* d_cylinder_walls,
+                                    const unsigned int n_cylinder_walls,
+                                    const hpmc_plane_wall_t* d_plane_walls,
+                                    const unsigned int n_plane_walls)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= nwork)
+        return;
+    idx += offset;
+
+    if (!d_trial_move_type[idx] || d_reject_out_of_cell[idx])
+        return;
+
+    Scalar4 postype_i = d_trial_postype[idx];
+    unsigned int typ_i = __scalar_as_int(postype_i.w);
+    const Scalar radius = d_params[typ_i].radius;
+    const vec3<Scalar> pos_i = vec3<Scalar>(postype_i) - vec3<Scalar>(origin);
+
+    bool accept = true;
+    for (unsigned int k = 0; k < n_sphere_walls && accept; k++)
+        {
+        const hpmc_sphere_wall_t wall = d_sphere_walls[k];
+        vec3<Scalar> r(box.minImage(vec_to_scalar3(pos_i - wall.origin)));
+        accept = test_confined_sphere(wall, r, radius);
+        }
+
+    for (unsigned int k = 0; k < n_cylinder_walls && accept; k++)
+        {
+        const hpmc_cylinder_wall_t wall = d_cylinder_walls[k];
+        vec3<Scalar> r(box.minImage(vec_to_scalar3(pos_i - wall.origin)));
+        accept = test_confined_cylinder(wall, r, radius);
+        }
+
+    for (unsigned int k = 0; k < n_plane_walls && accept; k++)
+        {
+        const hpmc_plane_wall_t wall = d_plane_walls[k];
+        vec3<Scalar> r(box.minImage(vec_to_scalar3(pos_i)));
+        Scalar max_dist = dot(wall.normal, r) + wall.d;
+        accept = max_dist >= Scalar(0.0) && max_dist - radius > Scalar(0.0);
+        }
+
+    if (!accept)
+        d_reject_out_of_cell[idx] = 1;
+    }
+
+//! Evaluate the energy of one particle in the harmonic lattice field
+__device__ inline Scalar lattice_energy(const vec3<Scalar>& position,
+                                        const quat<Scalar>& orientation,
+                                        const unsigned int tag,
+                                        const BoxDim& box,
+                                        const Scalar3* d_lattice_positions,
+                                        const Scalar k,
+                                        const Scalar4* d_lattice_orientations,
+                                        const Scalar q,
+                                        const Scalar4* d_symmetry,
+                                        const unsigned int n_symmetry)
+    {
+    Scalar energy(0.0);
+    if (d_lattice_positions)
+        {
+        vec3<Scalar> r0(d_lattice_positions[tag]);
+        vec3<Scalar> dr(box.minImage(vec_to_scalar3(r0 - position)));
+        energy += k * dot(dr, dr);
+        }
+
+    if (d_lattice_orientations)
+        {
+        quat<Scalar> q0(d_lattice_orientations[tag]);
+        Scalar dqmin(0.0);
+        for (unsigned int i = 0; i < n_symmetry; i++)
+            {
+            quat<Scalar> dq = q0 - orientation * quat<Scalar>(d_symmetry[i]);
+            dqmin = (i == 0) ? norm2(dq) : fmin(dqmin, norm2(dq));
+            }
+        energy += q * dqmin;
+        }
+    return energy;
+    }
+
+//! Accept the trial moves in the harmonic lattice field with the Metropolis criterion
+/*! Translation moves keep the orientation and rotation moves keep the position, so the old
+    orientation is only read for rotation moves. This also covers shapes without orientation, whose
+    stored orientations are not meaningful.
+*/
+__global__ void hpmc_external_lattice(const Scalar4* d_postype,
+                                      const Scalar4* d_orientation,
+                                      const Scalar4* d_trial_postype,
+                                      const Scalar4* d_trial_orientation,
+                                      const unsigned int* d_trial_move_type,
+                                      const unsigned int* d_tag,
+                                      unsigned int* d_reject_out_of_cell,
+                                      const BoxDim box,
+                                      const Scalar3 origin,
+                                      const uint16_t seed,
+                                      const unsigned int rank,
+                                      const uint64_t timestep,
+                                      const unsigned int select,
+                                      const unsigned int nwork,
+                                      const unsigned int offset,
+                                      const Scalar3* d_lattice_positions,
+                                      const Scalar k,
+                                      const Scalar4* d_lattice_orientations,
+                                      const Scalar q,
+                                      const Scalar4* d_symmetry,
+                                      const unsigned int n_symmetry)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= nwork)
+        return;
+    idx += offset;
+
+    unsigned int move_type = d_trial_move_type[idx];
+    if (!move_type || d_reject_out_of_cell[idx])
+        return;
+
+    quat<Scalar> orientation_new(d_trial_orientation[idx]);
+    quat<Scalar> orientation_old = (move_type == 2) ? quat<Scalar>(d_orientation[idx])
+                                                    : orientation_new;
+
+    unsigned int tag = d_tag[idx];
+    vec3<Scalar> pos_old = vec3<Scalar>(d_postype[idx]) - vec3<Scalar>(origin);
+    vec3<Scalar> pos_new = vec3<Scalar>(d_trial_postype[idx]) - vec3<Scalar>(origin);
+
+    Scalar dE = lattice_energy(pos_new,
+                               orientation_new,
+                               tag,
+                               box,
+                               d_lattice_positions,
+                               k,
+                               d_lattice_orientations,
+                               q,
+                               d_symmetry,
+                               n_symmetry)
+                - lattice_energy(pos_old,
+                                 orientation_old,
+                                 tag,
+                                 box,
+                                 d_lattice_positions,
+                                 k,
+                                 d_lattice_orientations,
+                                 q,
+                                 d_symmetry,
+                                 n_symmetry);
+
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoExternalField, timestep, seed),
+        hoomd::Counter(idx, select, rank));
+    if (hoomd::detail::generate_canonical<Scalar>(rng) >= fast::exp(-dE))
+        d_reject_out_of_cell[idx] = 1;
+    }
+    } // end namespace kernel
+
+void hpmc_external_walls(const hpmc_external_args_t& args,
+                         const SphereParams* params,
+                         const hpmc_sphere_wall_t* d_sphere_walls,
+                         const unsigned int n_sphere_walls,
+                         const hpmc_cylinder_wall_t* d_cylinder_walls,
+                         const unsigned int n_cylinder_walls,
+                         const hpmc_plane_wall_t* d_plane_walls,
+                         const unsigned int n_plane_walls)
+    {
+    // determine the maximum block size and clamp the input block size down
+    int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_external_walls));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        const unsigned int num_blocks = nwork / block_size + 1;
+
+        hipLaunchKernelGGL(kernel::hpmc_external_walls,
+                           dim3(num_blocks),
+                           dim3(block_size),
+                           0,
+                           0,
+                           args.d_trial_postype,
+                           args.d_trial_move_type,
+                           args.d_reject_out_of_cell,
+                           args.box,
+                           args.origin,
+                           nwork,
+                           range.first,
+                           params,
+                           d_sphere_walls,
+                           n_sphere_walls,
+                           d_cylinder_walls,
+                           n_cylinder_walls,
+                           d_plane_walls,
+                           n_plane_walls);
+        }
+    }
+
+void hpmc_external_lattice(const hpmc_external_args_t& args,
+                           const Scalar3* d_lattice_positions,
+                           const Scalar k,
+                           const Scalar4* d_lattice_orientations,
+                           const Scalar q,
+                           const Scalar4* d_symmetry,
+                           const unsigned int n_symmetry)
+    {
+    // determine the maximum block size and clamp the input block size down
+    int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_external_lattice));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        const unsigned int num_blocks = nwork / block_size + 1;
+
+        hipLaunchKernelGGL(kernel::hpmc_external_lattice,
+                           dim3(num_blocks),
+                           dim3(block_size),
+                           0,
+                           0,
+                           args.d_postype,
+                           args.d_orientation,
+                           args.d_trial_postype,
+                           args.d_trial_orientation,
+                           args.d_trial_move_type,
+                           args.d_tag,
+                           args.d_reject_out_of_cell,
+                           args.box,
+                           args.origin,
+                           args.seed,
+                           args.rank,
+                           args.timestep,
+                           args.select,
+                           nwork,
+                           range.first,
+                           d_lattice_positions,
+                           k,
+                           d_lattice_orientations,
+                           q,
+                           d_symmetry,
+                           n_symmetry);
+        }
+    }
+
+    } // end namespace gpu
+
+    } // end namespace hpmc
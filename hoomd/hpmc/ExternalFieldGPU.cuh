@@ -0,0 +1,114 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+/*! \file ExternalFieldGPU.cuh
+    \brief Declaration of the GPU kernels that apply HPMC external fields to trial moves
+*/
+
+namespace hpmc
+    {
+struct SphereParams;
+
+namespace gpu
+    {
+//! Sphere wall on the device
+struct hpmc_sphere_wall_t
+    {
+    vec3<Scalar> origin; //!< Center of the sphere
+    Scalar rsq;          //!< Squared radius of the sphere
+    unsigned int inside; //!< Nonzero when the particles must be inside of the sphere
+    };
+
+//! Cylinder wall on the device
+struct hpmc_cylinder_wall_t
+    {
+    vec3<Scalar> origin;      //!< Point on the axis of the cylinder
+    vec3<Scalar> orientation; //!< Unit vector along the axis of the cylinder
+    Scalar rsq;               //!< Squared radius of the cylinder
+    unsigned int inside;      //!< Nonzero when the particles must be inside of the cylinder
+    };
+
+//! Plane wall on the device
+struct hpmc_plane_wall_t
+    {
+    vec3<Scalar> normal; //!< Unit normal pointing to the allowed side of the plane
+    Scalar d;            //!< Plane equation offset, dot(normal, r) + d = 0 on the plane
+    };
+
+//! Wraps arguments to the external field kernels
+/*! The kernels evaluate the field for every trial move proposed by hpmc_gen_moves and set
+    d_reject_out_of_cell for the moves that the field rejects. These moves are then rejected a
+    priori, like the moves that leave their cell.
+*/
+struct hpmc_external_args_t
+    {
+    //! Construct a hpmc_external_args_t
+    hpmc_external_args_t(const Scalar4* _d_postype,
+                         const Scalar4* _d_orientation,
+                         const Scalar4* _d_trial_postype,
+                         const Scalar4* _d_trial_orientation,
+                         const unsigned int* _d_trial_move_type,
+                         const unsigned int* _d_tag,
+                         unsigned int* _d_reject_out_of_cell,
+                         const BoxDim& _box,
+                         const Scalar3& _origin,
+                         const uint16_t _seed,
+                         const unsigned int _rank,
+                         const uint64_t _timestep,
+                         const unsigned int _select,
+                         const unsigned int _block_size,
+                         const GPUPartition& _gpu_partition)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_trial_postype(_d_trial_postype),
+          d_trial_orientation(_d_trial_orientation), d_trial_move_type(_d_trial_move_type),
+          d_tag(_d_tag), d_reject_out_of_cell(_d_reject_out_of_cell), box(_box), origin(_origin),
+          seed(_seed), rank(_rank), timestep(_timestep), select(_select), block_size(_block_size),
+          gpu_partition(_gpu_partition)
+        {
+        }
+
+    const Scalar4* d_postype;              //!< postype array
+    const Scalar4* d_orientation;          //!< orientation array
+    const Scalar4* d_trial_postype;        //!< New positions (and type) of particles
+    const Scalar4* d_trial_orientation;    //!< New orientations of particles
+    const unsigned int* d_trial_move_type; //!< 0=no move, 1/2 = translate/rotate
+    const unsigned int* d_tag;             //!< Particle tags
+    unsigned int* d_reject_out_of_cell;    //!< Set to one to reject particle move
+    const BoxDim box;                      //!< Global simulation box
+    const Scalar3 origin;                  //!< Origin of the box
+    const uint16_t seed;                   //!< RNG seed
+    const unsigned int rank;               //!< MPI rank
+    const uint64_t timestep;               //!< Current timestep
+    const unsigned int select;             //!< Current selection
+    const unsigned int block_size;         //!< Block size to execute
+    const GPUPartition& gpu_partition;     //!< Split particles among GPUs
+    };
+
+//! Reject the trial moves of spheres that leave the walls
+void hpmc_external_walls(const hpmc_external_args_t& args,
+                         const SphereParams* params,
+                         const hpmc_sphere_wall_t* d_sphere_walls,
+                         const unsigned int n_sphere_walls,
+                         const hpmc_cylinder_wall_t* d_cylinder_walls,
+                         const unsigned int n_cylinder_walls,
+                         const hpmc_plane_wall_t* d_plane_walls,
+                         const unsigned int n_plane_walls);
+
+//! Accept the trial moves in the harmonic lattice field with the Metropolis criterion
+void hpmc_external_lattice(const hpmc_external_args_t& args,
+                           const Scalar3* d_lattice_positions,
+                           const Scalar k,
+                           const Scalar4* d_lattice_orientations,
+                           const Scalar q,
+                           const Scalar4* d_symmetry,
+                           const unsigned int n_symmetry);
+
+    } // end namespace gpu
+
+    } // end namespace hpmc
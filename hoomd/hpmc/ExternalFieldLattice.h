@@ -215,6 +215,16 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
             {
             m_symmetry.push_back(identity);
             }
+
+#ifdef ENABLE_HIP
+        GPUArray<Scalar4> symmetry_gpu(m_symmetry.size(), m_exec_conf);
+        m_symmetry_gpu.swap(symmetry_gpu);
+        ArrayHandle<Scalar4> h_symmetry_gpu(m_symmetry_gpu,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        for (size_t i = 0; i < m_symmetry.size(); i++)
+            h_symmetry_gpu.data[i] = quat_to_scalar4(m_symmetry[i]);
+#endif
         reset(0); // initializes all of the energy parameters.
         }
 
@@ -346,6 +356,35 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
         return new_U - old_U;
         }
 
+#ifdef ENABLE_HIP
+    //! Accept the trial moves generated on the GPU with the Metropolis criterion
+    virtual bool rejectTrialMovesGPU(const typename ExternalFieldMono<Shape>::gpu_args_t& args,
+                                     const typename Shape::param_type* params)
+        {
+        bool positions_valid = m_latticePositions.isValid();
+        bool orientations_valid = m_latticeOrientations.isValid();
+        if (!positions_valid && !orientations_valid)
+            return true;
+
+        ArrayHandle<Scalar3> d_lattice_positions(m_latticePositions.getReferenceArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+        ArrayHandle<Scalar4> d_lattice_orientations(m_latticeOrientations.getReferenceArray(),
+                                                    access_location::device,
+                                                    access_mode::read);
+        ArrayHandle<Scalar4> d_symmetry(m_symmetry_gpu, access_location::device, access_mode::read);
+
+        gpu::hpmc_external_lattice(args,
+                                   positions_valid ? d_lattice_positions.data : nullptr,
+                                   m_k,
+                                   orientations_valid ? d_lattice_orientations.data : nullptr,
+                                   m_q,
+                                   d_symmetry.data,
+                                   (unsigned int)m_symmetry.size());
+        return true;
+        }
+#endif
+
     void setReferences(const pybind11::list& r0, const pybind11::list& q0)
         {
         unsigned int ndim = m_sysdef->getNDimensions();
@@ -593,6 +632,9 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
     Scalar m_q;                                          // spring constant
 
     std::vector<quat<Scalar>> m_symmetry; // quaternions in the symmetry group of the shape.
+#ifdef ENABLE_HIP
+    GPUArray<Scalar4> m_symmetry_gpu; // m_symmetry on the device
+#endif
 
     Scalar m_Energy; // Store the total energy of the last computed timestep
 
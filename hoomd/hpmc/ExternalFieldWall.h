@@ -7,14 +7,19 @@
 /*! \file ExternalField.h
     \brief Declaration of ExternalField base class
 */
+#include "hoomd/AABBTree.h"
 #include "hoomd/Compute.h"
+#include "hoomd/GPUArray.h"
 #include "hoomd/VectorMath.h"
 
 #include "ExternalField.h"
 #include "IntegratorHPMCMono.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <tuple>
+#include <vector>
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -175,6 +180,22 @@ DEVICE inline bool test_confined<SphereWall, ShapeSphere>(const SphereWall& wall
     return wall.inside ? (wall.rsq > max_dist * max_dist) : (wall.rsq < max_dist * max_dist);
     }
 
+//! Test the overlap of a wall, given as a spheropolyhedron, with a (scaled) convex polyhedron
+DEVICE inline bool test_overlap_wall(const vec3<Scalar>& r_ab,
+                                     const detail::PolyhedronVertices& wall_verts,
+                                     const ShapeConvexPolyhedron& shape,
+                                     unsigned int& err)
+    {
+    OverlapReal DaDb = wall_verts.diameter + shape.getCircumsphereDiameter();
+    return detail::xenocollide_3d(
+        detail::SupportFuncConvexPolyhedron(wall_verts, wall_verts.sweep_radius),
+        detail::SupportFuncConvexPolyhedron(shape.verts, 0, shape.scale),
+        vec3<OverlapReal>(r_ab),
+        quat<OverlapReal>(shape.orientation),
+        DaDb / OverlapReal(2.0),
+        err);
+    }
+
 // Spherical Walls and Convex Polyhedra
 DEVICE inline bool test_confined(const SphereWall& wall,
                                  const ShapeConvexPolyhedron& shape,
@@ -217,6 +238,7 @@ DEVICE inline bool test_confined(const SphereWall& wall,
             for (unsigned int v = 0; v < (unsigned int)shape.verts.N && accept; v++)
                 {
                 vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+                pos *= Scalar(shape.scale);
                 vec3<Scalar> rotated_pos = rotate(shape.orientation, pos);
                 rotated_pos += shifted_pos;
                 rxyz_sq = rotated_pos.x * rotated_pos.x + rotated_pos.y * rotated_pos.y
@@ -226,13 +248,9 @@ DEVICE inline bool test_confined(const SphereWall& wall,
             }
         else
             {
-            // build a sphero-polyhedron and for the wall and the convex polyhedron
-            quat<Scalar> q; // default is (1, 0, 0, 0)
+            // test the wall as a spheropolyhedron against the convex polyhedron
             unsigned int err = 0;
-            ShapeSpheropolyhedron wall_shape(q, *wall.verts);
-            ShapeSpheropolyhedron part_shape(shape.orientation, shape.verts);
-
-            accept = !test_overlap(shifted_pos, wall_shape, part_shape, err);
+            accept = !test_overlap_wall(shifted_pos, *wall.verts, shape, err);
             }
         }
     return accept;
@@ -400,6 +418,7 @@ DEVICE inline bool test_confined(const CylinderWall& wall,
             for (unsigned int v = 0; v < shape.verts.N && accept; v++)
                 {
                 vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+                pos *= Scalar(shape.scale);
                 vec3<Scalar> rotated_pos = rotate(shape.orientation, pos);
                 rotated_pos += shifted_pos;
 
@@ -418,10 +437,7 @@ DEVICE inline bool test_confined(const CylinderWall& wall,
             proj = dot(shifted_pos, wall.orientation) * wall.orientation;
             r_ab = shifted_pos - proj;
             unsigned int err = 0;
-            assert(shape.verts.sweep_radius == 0);
-            ShapeSpheropolyhedron wall_shape(quat<Scalar>(), *wall.verts);
-            ShapeSpheropolyhedron part_shape(shape.orientation, shape.verts);
-            accept = !test_overlap(r_ab, wall_shape, part_shape, err);
+            accept = !test_overlap_wall(r_ab, *wall.verts, shape, err);
             }
         }
     return accept;
@@ -463,6 +479,7 @@ DEVICE inline bool test_confined(const PlaneWall& wall,
         for (unsigned int v = 0; v < shape.verts.N && accept; v++)
             {
             vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+            pos *= Scalar(shape.scale);
             vec3<Scalar> rotated_pos = rotate(shape.orientation, pos);
             rotated_pos += shifted_pos;
             max_dist = dot(wall.normal, rotated_pos)
@@ -510,6 +527,79 @@ DEVICE inline bool test_confined(const PlaneWall& wall,
     return accept;
     }
 
+//! Whether test_confined implements the sphere walls for the particle shape
+/*! The implementations accept a particle outside of a sphere wall whenever the circumsphere of the
+    particle does not overlap the wall. ExternalFieldWall relies on this to skip distant walls.
+*/
+template<class Shape> struct wall_sphere_tree_supported
+    {
+    static const bool value = false;
+    };
+
+template<> struct wall_sphere_tree_supported<ShapeSphere>
+    {
+    static const bool value = true;
+    };
+
+template<> struct wall_sphere_tree_supported<ShapeConvexPolyhedron>
+    {
+    static const bool value = true;
+    };
+
+template<> struct wall_sphere_tree_supported<ShapeSpheropolyhedron>
+    {
+    static const bool value = true;
+    };
+
+#ifdef ENABLE_HIP
+//! Apply the walls to trial moves on the GPU
+/*! The GPU kernel implements the walls for spheres only. The overload for SphereParams launches it,
+    this template reports that other shapes have no GPU implementation.
+*/
+template<class ParamType>
+inline bool reject_wall_moves_gpu(const gpu::hpmc_external_args_t& args,
+                                  const ParamType* params,
+                                  const gpu::hpmc_sphere_wall_t* d_sphere_walls,
+                                  const unsigned int n_sphere_walls,
+                                  const gpu::hpmc_cylinder_wall_t* d_cylinder_walls,
+                                  const unsigned int n_cylinder_walls,
+                                  const gpu::hpmc_plane_wall_t* d_plane_walls,
+                                  const unsigned int n_plane_walls)
+    {
+    return false;
+    }
+
+inline bool reject_wall_moves_gpu(const gpu::hpmc_external_args_t& args,
+                                  const SphereParams* params,
+                                  const gpu::hpmc_sphere_wall_t* d_sphere_walls,
+                                  const unsigned int n_sphere_walls,
+                                  const gpu::hpmc_cylinder_wall_t* d_cylinder_walls,
+                                  const unsigned int n_cylinder_walls,
+                                  const gpu::hpmc_plane_wall_t* d_plane_walls,
+                                  const unsigned int n_plane_walls)
+    {
+    gpu::hpmc_external_walls(args,
+                             params,
+                             d_sphere_walls,
+                             n_sphere_walls,
+                             d_cylinder_walls,
+                             n_cylinder_walls,
+                             d_plane_walls,
+                             n_plane_walls);
+    return true;
+    }
+#endif
+
+//! Confine HPMC particles with sphere, cylinder, and plane walls
+/*! Particles must be inside every sphere wall with inside == true, so energydiff() tests each of
+    these. The sphere walls with inside == false (obstacles, such as the grains of a porous medium)
+    only reject particles that overlap them. ExternalFieldWall places these in an AABBTree at their
+    wrapped positions and tests only the walls whose bounding boxes overlap the circumsphere of a
+    periodic image of the particle. The tree is rebuilt lazily after the walls or the box change.
+
+    On the GPU, rejectTrialMovesGPU() applies the walls to spheres in a kernel that runs after the
+    trial moves are generated.
+*/
 template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     {
     using Compute::m_pdata;
@@ -517,7 +607,8 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     public:
     ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef,
                       std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
-        : ExternalFieldMono<Shape>(sysdef), m_mc(mc)
+        : ExternalFieldMono<Shape>(sysdef), m_sphere_tree_invalid(true), m_gpu_walls_invalid(true),
+          m_mc(mc)
         {
         m_box = m_pdata->getGlobalBox();
         //! scale the container walls every time the box changes
@@ -541,14 +632,56 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         const BoxDim& box = this->m_pdata->getGlobalBox();
         vec3<Scalar> origin(m_pdata->getOrigin());
 
-        for (size_t i = 0; i < m_Spheres.size(); i++)
+        updateSphereTree();
+
+        for (size_t i = 0; i < m_tested_spheres.size(); i++)
             {
-            if (!test_confined(m_Spheres[i], shape_new, position_new, origin, box))
+            if (!test_confined(m_Spheres[m_tested_spheres[i]],
+                               shape_new,
+                               position_new,
+                               origin,
+                               box))
                 {
                 return INFINITY;
                 }
             }
 
+        if (!m_tree_spheres.empty())
+            {
+            // the tree holds the wrapped walls, query the wrapped particle and its periodic images
+            Scalar3 pos = vec_to_scalar3(position_new - origin);
+            int3 img = make_int3(0, 0, 0);
+            box.wrap(pos, img);
+            const Scalar radius = Scalar(0.5) * shape_new.getCircumsphereDiameter();
+            const uchar3 periodic = box.getPeriodic();
+            const int nx = periodic.x ? 1 : 0;
+            const int ny = periodic.y ? 1 : 0;
+            const int nz = (periodic.z && this->m_sysdef->getNDimensions() == 3) ? 1 : 0;
+
+            for (int h = -nx; h <= nx; h++)
+                for (int k = -ny; k <= ny; k++)
+                    for (int l = -nz; l <= nz; l++)
+                        {
+                        vec3<Scalar> image = vec3<Scalar>(pos)
+                                             + Scalar(h) * vec3<Scalar>(box.getLatticeVector(0))
+                                             + Scalar(k) * vec3<Scalar>(box.getLatticeVector(1))
+                                             + Scalar(l) * vec3<Scalar>(box.getLatticeVector(2));
+                        m_hits.clear();
+                        m_sphere_tree.query(m_hits, detail::AABB(image, radius));
+                        for (size_t j = 0; j < m_hits.size(); j++)
+                            {
+                            if (!test_confined(m_Spheres[m_tree_spheres[m_hits[j]]],
+                                               shape_new,
+                                               position_new,
+                                               origin,
+                                               box))
+                                {
+                                return INFINITY;
+                                }
+                            }
+                        }
+            }
+
         for (size_t i = 0; i < m_Cylinders.size(); i++)
             {
             set_cylinder_wall_verts(m_Cylinders[i], shape_new);
@@ -597,6 +730,34 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
             }
         }
 
+#ifdef ENABLE_HIP
+    //! Reject the trial moves that leave the walls on the GPU
+    virtual bool rejectTrialMovesGPU(const typename ExternalFieldMono<Shape>::gpu_args_t& args,
+                                     const typename Shape::param_type* params)
+        {
+        updateGPUWalls();
+
+        ArrayHandle<gpu::hpmc_sphere_wall_t> d_sphere_walls(m_gpu_sphere_walls,
+                                                            access_location::device,
+                                                            access_mode::read);
+        ArrayHandle<gpu::hpmc_cylinder_wall_t> d_cylinder_walls(m_gpu_cylinder_walls,
+                                                                access_location::device,
+                                                                access_mode::read);
+        ArrayHandle<gpu::hpmc_plane_wall_t> d_plane_walls(m_gpu_plane_walls,
+                                                          access_location::device,
+                                                          access_mode::read);
+
+        return reject_wall_moves_gpu(args,
+                                     params,
+                                     d_sphere_walls.data,
+                                     (unsigned int)m_Spheres.size(),
+                                     d_cylinder_walls.data,
+                                     (unsigned int)m_Cylinders.size(),
+                                     d_plane_walls.data,
+                                     (unsigned int)m_Planes.size());
+        }
+#endif
+
     // assumes cubic box
     void scaleWalls()
         {
@@ -622,6 +783,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
             }
 
         m_box = newBox;
+        invalidateWalls();
         }
 
     std::tuple<Scalar, vec3<Scalar>, bool> GetSphereWallParameters(size_t index)
@@ -733,6 +895,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         if (index >= m_Spheres.size())
             throw std::runtime_error("Out of bounds of sphere walls.");
         m_Spheres[index] = wall;
+        invalidateWalls();
         }
 
     void SetCylinderWallParameter(size_t index, const CylinderWall& wall)
@@ -740,6 +903,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         if (index >= m_Cylinders.size())
             throw std::runtime_error("Out of bounds of cylinder walls.");
         m_Cylinders[index] = wall;
+        invalidateWalls();
         }
 
     void SetPlaneWallParameter(size_t index, const PlaneWall& wall)
@@ -747,52 +911,62 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         if (index >= m_Planes.size())
             throw std::runtime_error("Out of bounds of plane walls.");
         m_Planes[index] = wall;
+        invalidateWalls();
         }
 
     void SetSphereWalls(const std::vector<SphereWall>& Spheres)
         {
         m_Spheres = Spheres;
+        invalidateWalls();
         }
 
     void SetCylinderWalls(const std::vector<CylinderWall>& Cylinders)
         {
         m_Cylinders = Cylinders;
+        invalidateWalls();
         }
 
     void SetPlaneWalls(const std::vector<PlaneWall>& Planes)
         {
         m_Planes = Planes;
+        invalidateWalls();
         }
 
     void AddSphereWall(const SphereWall& wall)
         {
         m_Spheres.push_back(wall);
+        invalidateWalls();
         }
 
     void AddCylinderWall(const CylinderWall& wall)
         {
         m_Cylinders.push_back(wall);
+        invalidateWalls();
         }
 
     void AddPlaneWall(const PlaneWall& wall)
         {
         m_Planes.push_back(wall);
+        invalidateWalls();
         }
 
     // is this messy ...
     void RemoveSphereWall(size_t index)
         {
         m_Spheres.erase(m_Spheres.begin() + index);
+        invalidateWalls();
         }
 
     void RemoveCylinderWall(size_t index)
         {
         m_Cylinders.erase(m_Cylinders.begin() + index);
+        invalidateWalls();
         }
 
     void RemovePlaneWall(size_t index)
         {
         m_Planes.erase(m_Planes.begin() + index);
+        invalidateWalls();
         }
 
     bool wall_overlap(const unsigned int& index,
@@ -815,6 +989,9 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
         const std::vector<typename Shape::param_type,
                           managed_allocator<typename Shape::param_type>>& params
             = m_mc->getParams();
@@ -827,6 +1004,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
             vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
             int typ_i = __scalar_as_int(postype_i.w);
             Shape shape_i(quat<Scalar>(orientation_i), params[typ_i]);
+            m_mc->applyParticleScale(shape_i, h_diameter.data[i]);
 
             if (wall_overlap(i, pos_i, shape_i, pos_i, shape_i))
                 {
@@ -917,6 +1095,111 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         }
 
     protected:
+    //! Flag the derived wall data for an update after the walls change
+    void invalidateWalls()
+        {
+        m_sphere_tree_invalid = true;
+        m_gpu_walls_invalid = true;
+        }
+
+#ifdef ENABLE_HIP
+    //! Copy the walls to the device arrays read by the GPU kernel
+    void updateGPUWalls()
+        {
+        if (!m_gpu_walls_invalid)
+            return;
+
+        // allocate at least one element so that the handles are valid when there are no walls
+        GPUArray<gpu::hpmc_sphere_wall_t> sphere_walls(std::max(m_Spheres.size(), size_t(1)),
+                                                       this->m_exec_conf);
+            {
+            ArrayHandle<gpu::hpmc_sphere_wall_t> h_sphere_walls(sphere_walls,
+                                                                access_location::host,
+                                                                access_mode::overwrite);
+            for (unsigned int i = 0; i < m_Spheres.size(); i++)
+                {
+                h_sphere_walls.data[i].origin = m_Spheres[i].origin;
+                h_sphere_walls.data[i].rsq = m_Spheres[i].rsq;
+                h_sphere_walls.data[i].inside = m_Spheres[i].inside;
+                }
+            }
+        m_gpu_sphere_walls.swap(sphere_walls);
+
+        GPUArray<gpu::hpmc_cylinder_wall_t> cylinder_walls(std::max(m_Cylinders.size(), size_t(1)),
+                                                           this->m_exec_conf);
+            {
+            ArrayHandle<gpu::hpmc_cylinder_wall_t> h_cylinder_walls(cylinder_walls,
+                                                                    access_location::host,
+                                                                    access_mode::overwrite);
+            for (unsigned int i = 0; i < m_Cylinders.size(); i++)
+                {
+                h_cylinder_walls.data[i].origin = m_Cylinders[i].origin;
+                h_cylinder_walls.data[i].orientation = m_Cylinders[i].orientation;
+                h_cylinder_walls.data[i].rsq = m_Cylinders[i].rsq;
+                h_cylinder_walls.data[i].inside = m_Cylinders[i].inside;
+                }
+            }
+        m_gpu_cylinder_walls.swap(cylinder_walls);
+
+        GPUArray<gpu::hpmc_plane_wall_t> plane_walls(std::max(m_Planes.size(), size_t(1)),
+                                                     this->m_exec_conf);
+            {
+            ArrayHandle<gpu::hpmc_plane_wall_t> h_plane_walls(plane_walls,
+                                                              access_location::host,
+                                                              access_mode::overwrite);
+            for (unsigned int i = 0; i < m_Planes.size(); i++)
+                {
+                h_plane_walls.data[i].normal = m_Planes[i].normal;
+                h_plane_walls.data[i].d = m_Planes[i].d;
+                }
+            }
+        m_gpu_plane_walls.swap(plane_walls);
+
+        m_gpu_walls_invalid = false;
+        }
+#endif
+
+    //! Sort the sphere walls into those tested directly and those placed in the tree
+    void updateSphereTree()
+        {
+        if (!m_sphere_tree_invalid)
+            return;
+
+        m_tested_spheres.clear();
+        m_tree_spheres.clear();
+        for (unsigned int i = 0; i < m_Spheres.size(); i++)
+            {
+            if (m_Spheres[i].inside || !wall_sphere_tree_supported<Shape>::value)
+                m_tested_spheres.push_back(i);
+            else
+                m_tree_spheres.push_back(i);
+            }
+
+        unsigned int n_tree = (unsigned int)m_tree_spheres.size();
+        if (n_tree > 0)
+            {
+            const BoxDim& box = m_pdata->getGlobalBox();
+            detail::AABB* aabbs;
+            int retval = posix_memalign((void**)&aabbs, 32, n_tree * sizeof(detail::AABB));
+            if (retval != 0)
+                throw std::runtime_error("Error allocating AABB memory");
+
+            for (unsigned int j = 0; j < n_tree; j++)
+                {
+                const SphereWall& wall = m_Spheres[m_tree_spheres[j]];
+                Scalar3 wall_origin = vec_to_scalar3(wall.origin);
+                int3 img = make_int3(0, 0, 0);
+                box.wrap(wall_origin, img);
+                aabbs[j] = detail::AABB(vec3<Scalar>(wall_origin), sqrt(wall.rsq));
+                }
+
+            m_sphere_tree.buildTree(aabbs, n_tree);
+            free(aabbs);
+            }
+
+        m_sphere_tree_invalid = false;
+        }
+
     void set_cylinder_wall_verts(CylinderWall& wall, const Shape& shape)
         {
         vec3<Scalar> v0;
@@ -954,6 +1237,19 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     std::vector<PlaneWall> m_Planes;
     Scalar m_Volume;
 
+    detail::AABBTree m_sphere_tree;            //!< Tree of the sphere walls in m_tree_spheres
+    std::vector<unsigned int> m_tested_spheres; //!< Sphere walls tested for every particle
+    std::vector<unsigned int> m_tree_spheres;   //!< Sphere walls placed in m_sphere_tree
+    std::vector<unsigned int> m_hits;           //!< Leaves of m_sphere_tree found by a query
+    bool m_sphere_tree_invalid;                 //!< True when m_sphere_tree must be rebuilt
+    bool m_gpu_walls_invalid;                   //!< True when the GPU walls must be copied
+
+#ifdef ENABLE_HIP
+    GPUArray<gpu::hpmc_sphere_wall_t> m_gpu_sphere_walls;     //!< Sphere walls on the device
+    GPUArray<gpu::hpmc_cylinder_wall_t> m_gpu_cylinder_walls; //!< Cylinder walls on the device
+    GPUArray<gpu::hpmc_plane_wall_t> m_gpu_plane_walls;       //!< Plane walls on the device
+#endif
+
     private:
     std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< integrator
     BoxDim m_box;                                    //!< the current box
@@ -0,0 +1,247 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "HPMCPrecisionSetup.h"
+#include "MinkowskiMath.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#ifndef __GJK_RAYCAST_3D_H__
+#define __GJK_RAYCAST_3D_H__
+
+/*! \file GJKRaycast3D.h
+    \brief Implements the GJK ray cast in 3D
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+namespace hpmc
+    {
+namespace detail
+    {
+const unsigned int GJK_RAYCAST_3D_MAX_ITERATIONS = 128;
+
+//! Find the point of a simplex closest to the origin
+/*! \param y Vertices of the simplex
+    \param p Support points the vertices were computed from, reordered along with y
+    \param n Number of vertices (1 to 4)
+    \returns The point of the simplex closest to the origin
+
+    On return, y, p, and n are reduced to the smallest face of the simplex that contains the
+    closest point.
+
+    The closest point is the projection of the origin onto the affine hull of one of the faces, and
+    that projection has positive barycentric coordinates. A simplex has at most 15 faces, so all of
+    them are tested and the nearest valid projection is taken. The points are composed from their
+    barycentric coordinates, so they stay inside the simplex even when roundoff spoils the
+    projection of a degenerate face.
+*/
+DEVICE inline vec3<OverlapReal>
+gjk_closest_point_simplex(vec3<OverlapReal>* y, vec3<OverlapReal>* p, unsigned int& n)
+    {
+    vec3<OverlapReal> best = y[0];
+    OverlapReal best_dsq = dot(y[0], y[0]);
+    unsigned int best_face = 1;
+
+    for (unsigned int face = 2; face < (1u << n); ++face)
+        {
+        unsigned int idx[4];
+        unsigned int k = 0;
+        for (unsigned int i = 0; i < n; ++i)
+            if (face & (1u << i))
+                idx[k++] = i;
+
+        const vec3<OverlapReal>& y0 = y[idx[0]];
+        vec3<OverlapReal> e[3];
+        for (unsigned int i = 1; i < k; ++i)
+            e[i - 1] = y[idx[i]] - y0;
+
+        // barycentric coordinates of the projection with respect to the edges e
+        OverlapReal lambda[3] = {0, 0, 0};
+        if (k == 1)
+            {
+            // single vertices are tested below
+            continue;
+            }
+        else if (k == 2)
+            {
+            OverlapReal ee = dot(e[0], e[0]);
+            if (ee <= OverlapReal(0.0))
+                continue;
+            lambda[0] = -dot(e[0], y0) / ee;
+            }
+        else if (k == 3)
+            {
+            vec3<OverlapReal> normal = cross(e[0], e[1]);
+            OverlapReal nn = dot(normal, normal);
+            if (nn <= OverlapReal(0.0))
+                continue;
+            vec3<OverlapReal> d = normal * (dot(y0, normal) / nn) - y0;
+            lambda[0] = dot(cross(d, e[1]), normal) / nn;
+            lambda[1] = dot(cross(e[0], d), normal) / nn;
+            }
+        else
+            {
+            OverlapReal det = dot(e[0], cross(e[1], e[2]));
+            if (det == OverlapReal(0.0))
+                continue;
+            lambda[0] = -dot(y0, cross(e[1], e[2])) / det;
+            lambda[1] = -dot(e[0], cross(y0, e[2])) / det;
+            lambda[2] = -dot(e[0], cross(e[1], y0)) / det;
+            }
+
+        OverlapReal mu0 = OverlapReal(1.0);
+        bool inside = true;
+        vec3<OverlapReal> q = y0;
+        for (unsigned int i = 0; i < k - 1; ++i)
+            {
+            inside = inside && lambda[i] > OverlapReal(0.0);
+            mu0 -= lambda[i];
+            q += lambda[i] * e[i];
+            }
+        if (!inside || mu0 <= OverlapReal(0.0))
+            continue;
+
+        OverlapReal dsq = dot(q, q);
+        if (dsq < best_dsq)
+            {
+            best = q;
+            best_dsq = dsq;
+            best_face = face;
+            }
+        }
+
+    // the remaining single vertices
+    for (unsigned int i = 1; i < n; ++i)
+        {
+        OverlapReal dsq = dot(y[i], y[i]);
+        if (dsq < best_dsq)
+            {
+            best = y[i];
+            best_dsq = dsq;
+            best_face = 1u << i;
+            }
+        }
+
+    // keep only the vertices of the closest face
+    unsigned int m = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        if (best_face & (1u << i))
+            {
+            y[m] = y[i];
+            p[m] = p[i];
+            m++;
+            }
+        }
+    n = m;
+
+    return best;
+    }
+
+//! GJK ray cast in 3D
+/*! \tparam SupportFuncA Support function class type for shape A
+    \tparam SupportFuncB Support function class type for shape B
+    \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param r Unit vector along which shape A moves, in frame A
+    \param max_distance Largest distance of interest
+    \param R Approximate radius of Minkowski difference for scaling tolerance value
+    \param distance Set to the distance A moves before it touches B
+    \param err_count Error counter to increment whenever the iteration does not converge
+    \returns true when A touches B after moving less than *max_distance* along *r*
+
+    Shape A moved by lambda*r touches B when lambda*r is on the boundary of the Minkowski difference
+    B-A. The ray cast (G. van den Bergen, Ray Casting against General Convex Objects with
+    Application to Continuous Collision Detection, 2004) runs GJK between the point x = lambda*r
+    and B-A. Whenever the current GJK direction v gives a plane that separates x from B-A, x
+    advances along the ray to that plane. The ray misses when x is separated by a plane it moves
+    away from, and hits once x is within the tolerance of B-A.
+
+    x never advances past the boundary of B-A, so the distance found is at most the exact distance
+    and less by no more than the tolerance. When the iteration does not converge, the current
+    distance is returned as a hit and err_count is incremented, so that A never moves into B.
+
+    The support functions follow the conventions of xenocollide_3d(). Shapes with curved surfaces
+    (such as a sweep radius) are supported, the tolerance terminates the iteration.
+
+    \ingroup minkowski
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline bool gjk_raycast_3d(const SupportFuncA& sa,
+                                  const SupportFuncB& sb,
+                                  const vec3<OverlapReal>& ab_t,
+                                  const quat<OverlapReal>& q,
+                                  const vec3<OverlapReal>& r,
+                                  const OverlapReal max_distance,
+                                  const OverlapReal R,
+                                  OverlapReal& distance,
+                                  unsigned int& err_count)
+    {
+    CompositeSupportFunc3D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, q);
+    const OverlapReal tol = OverlapReal(1e-6) * R;
+
+    OverlapReal lambda = OverlapReal(0.0);
+    vec3<OverlapReal> x(0, 0, 0);
+
+    // b's center is inside B-A
+    vec3<OverlapReal> v = x - ab_t;
+
+    vec3<OverlapReal> y[4], p[4];
+    unsigned int n = 0;
+
+    for (unsigned int iteration = 0; iteration < GJK_RAYCAST_3D_MAX_ITERATIONS; ++iteration)
+        {
+        if (dot(v, v) <= tol * tol)
+            {
+            distance = lambda;
+            return true;
+            }
+
+        vec3<OverlapReal> s = S(v);
+        OverlapReal vw = dot(v, x - s);
+        if (vw > OverlapReal(0.0))
+            {
+            // the support plane separates x from B-A, advance x to the plane
+            OverlapReal vr = dot(v, r);
+            if (vr >= OverlapReal(0.0))
+                return false;
+
+            lambda -= vw / vr;
+            if (lambda > max_distance)
+                return false;
+            x = lambda * r;
+            }
+
+        p[n++] = s;
+        for (unsigned int i = 0; i < n; ++i)
+            y[i] = x - p[i];
+
+        v = gjk_closest_point_simplex(y, p, n);
+
+        // x is enclosed by a tetrahedron of B-A
+        if (n == 4)
+            {
+            distance = lambda;
+            return true;
+            }
+        }
+
+    err_count++;
+    distance = lambda;
+    return true;
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+
+#undef DEVICE
+#endif // __GJK_RAYCAST_3D_H__
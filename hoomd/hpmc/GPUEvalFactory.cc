@@ -7,6 +7,10 @@
 #include <vector>
 
 #include "GPUEvalFactory.h"
+#include "JITCache.h"
+#include "hoomd/HOOMDVersion.h"
+
+#include <sstream>
 
 // pybind11 vector bindings
 #include <pybind11/pybind11.h>
@@ -60,16 +64,76 @@ void GPUEvalFactory::compileGPU(const std::string& code,
         }
     m_exec_conf->msg->notice(5) << code << std::endl;
 
-    // compile on each GPU, substituting common headers with fake headers
-    auto gpu_map = m_exec_conf->getGPUIds();
-    m_program.clear();
-    for (int idev = m_exec_conf->getNumActiveGPUs() - 1; idev >= 0; idev--)
+    // the kernels are compiled, or loaded from the cache, on first use
+    m_code = code;
+    m_compile_options = compile_options;
+    m_program.reset();
+    for (auto& kernels : m_kernels)
+        kernels.clear();
+
+#endif
+    }
+
+#if __HIP_PLATFORM_NVCC__
+/*! \param idev the logical GPU id
+    \param eval_threads template parameter
+    \param launch_bounds template parameter
+
+    Kernel instantiations are cached on disk with hpmc::detail::JITCache. NVRTC only runs when an
+    instantiation is in neither the in memory nor the on disk cache.
+*/
+const jitify::experimental::KernelInstantiation&
+GPUEvalFactory::getKernel(unsigned int idev, unsigned int eval_threads, unsigned int launch_bounds)
+    {
+    auto key = std::make_pair(eval_threads, launch_bounds);
+    auto it = m_kernels[idev].find(key);
+    if (it != m_kernels[idev].end())
+        return it->second;
+
+    // kernels are loaded into the context of the current device
+    cudaSetDevice(m_exec_conf->getGPUIds()[idev]);
+
+    // the PTX depends on the compiler, the HOOMD headers, the instantiation, and the input
+    std::ostringstream cache_key_stream;
+    cache_key_stream << "nvrtc " << CUDA_VERSION << "\n"
+                     << "HOOMD " << HOOMD_VERSION << "\n"
+                     << m_kernel_name << "<" << eval_threads << "," << launch_bounds << ">\n";
+    for (auto& option : m_compile_options)
         {
-        m_exec_conf->msg->notice(3) << "Compiling nvrtc code on GPU " << idev << std::endl;
-        cudaSetDevice(gpu_map[idev]);
-        m_program.push_back(m_cache[idev].program(code, 0, compile_options));
+        cache_key_stream << option << "\n";
         }
+    cache_key_stream << m_code;
+    const std::string cache_key = cache_key_stream.str();
 
-#endif
+    std::string serialized;
+    if (hpmc::detail::JITCache::load(cache_key, serialized))
+        {
+        try
+            {
+            auto inserted = m_kernels[idev].emplace(
+                key,
+                jitify::experimental::KernelInstantiation::deserialize(serialized));
+            m_exec_conf->msg->notice(3) << "Loaded nvrtc kernel " << m_kernel_name << " from "
+                                        << hpmc::detail::JITCache::getPath() << std::endl;
+            return inserted.first->second;
+            }
+        catch (const std::runtime_error&)
+            {
+            // compile the kernel again when the cache entry is unreadable
+            }
+        }
+
+    if (!m_program)
+        {
+        m_program.reset(new jitify::experimental::Program(m_code, {}, m_compile_options));
+        }
+
+    m_exec_conf->msg->notice(3) << "Compiling nvrtc code on GPU " << idev << std::endl;
+    auto inserted = m_kernels[idev].emplace(
+        key,
+        m_program->kernel(m_kernel_name).instantiate(eval_threads, launch_bounds));
+    hpmc::detail::JITCache::store(cache_key, inserted.first->second.serialize());
+    return inserted.first->second;
     }
 #endif
+#endif
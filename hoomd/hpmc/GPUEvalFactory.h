@@ -32,6 +32,9 @@
 #endif
 
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 //! Evaluate patch energies via runtime generated code, GPU version
@@ -60,9 +63,8 @@ class GPUEvalFactory
              i *= 2)
             m_launch_bounds.push_back(i);
 
-// instantiate jitify cache
 #ifdef __HIP_PLATFORM_NVCC__
-        m_cache.resize(this->m_exec_conf->getNumActiveGPUs());
+        m_kernels.resize(this->m_exec_conf->getNumActiveGPUs());
 #endif
 
         compileGPU(code, kernel_name, options, cuda_devrt_library_path, compute_arch);
@@ -90,10 +92,9 @@ class GPUEvalFactory
         int max_threads = 0;
 
 #ifdef __HIP_PLATFORM_NVCC__
-        CUresult custatus = cuFuncGetAttribute(
-            &max_threads,
-            CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK,
-            m_program[idev].kernel(m_kernel_name).instantiate(eval_threads, launch_bounds));
+        CUresult custatus = cuFuncGetAttribute(&max_threads,
+                                               CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK,
+                                               getKernel(idev, eval_threads, launch_bounds));
         char* error;
         if (custatus != CUDA_SUCCESS)
             {
@@ -116,10 +117,9 @@ class GPUEvalFactory
         int shared_size = 0;
 
 #ifdef __HIP_PLATFORM_NVCC__
-        CUresult custatus = cuFuncGetAttribute(
-            &shared_size,
-            CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES,
-            m_program[idev].kernel(m_kernel_name).instantiate(eval_threads, launch_bounds));
+        CUresult custatus = cuFuncGetAttribute(&shared_size,
+                                               CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES,
+                                               getKernel(idev, eval_threads, launch_bounds));
         char* error;
         if (custatus != CUDA_SUCCESS)
             {
@@ -141,7 +141,7 @@ class GPUEvalFactory
     \param launch_bounds template parameter
     */
 #ifdef __HIP_PLATFORM_NVCC__
-    jitify::KernelLauncher configureKernel(unsigned int idev,
+    jitify::experimental::KernelLauncher configureKernel(unsigned int idev,
                                            dim3 grid,
                                            dim3 threads,
                                            size_t sharedMemBytes,
@@ -151,9 +151,7 @@ class GPUEvalFactory
         {
         cudaSetDevice(m_exec_conf->getGPUIds()[idev]);
 
-        return m_program[idev]
-            .kernel(m_kernel_name)
-            .instantiate(eval_threads, launch_bounds)
+        return getKernel(idev, eval_threads, launch_bounds)
             .configure(grid, threads, static_cast<unsigned int>(sharedMemBytes), hStream);
         }
 #endif
@@ -175,10 +173,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr(param_array_name.c_str());
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr(param_array_name.c_str());
 
                     // copy the array pointer to the device
                     char* error;
@@ -206,10 +202,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr("param_array_constituent");
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr("param_array_constituent");
 
                     // copy the array pointer to the device
                     char* error;
@@ -237,10 +231,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr("jit::d_r_cut_constituent");
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr("jit::d_r_cut_constituent");
 
                     // copy the array pointer to the device
                     char* error;
@@ -268,10 +260,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr("jit::d_union_params");
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr("jit::d_union_params");
 
                     // copy the array pointer to the device
                     char* error;
@@ -301,8 +291,20 @@ class GPUEvalFactory
                     unsigned int compute_arch);
 
 #ifdef __HIP_PLATFORM_NVCC__
-    std::vector<jitify::JitCache> m_cache;  //!< jitify kernel cache, one per GPU
-    std::vector<jitify::Program> m_program; //!< The kernel object, one per GPU
+    std::string m_code;                         //!< The source code
+    std::vector<std::string> m_compile_options; //!< The NVRTC options
+
+    //! The program, loaded when a kernel is not found in the cache
+    std::unique_ptr<jitify::experimental::Program> m_program;
+
+    //! The kernel instantiations by eval_threads and launch_bounds, one map per GPU
+    std::vector<std::map<std::pair<unsigned int, unsigned int>,
+                         jitify::experimental::KernelInstantiation>>
+        m_kernels;
+
+    //! Get a kernel instantiation, loading or compiling it on first use
+    const jitify::experimental::KernelInstantiation&
+    getKernel(unsigned int idev, unsigned int eval_threads, unsigned int launch_bounds);
 #endif
     };
 #endif
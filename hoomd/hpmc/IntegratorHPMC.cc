@@ -6,7 +6,9 @@
 namespace py = pybind11;
 
 #include "hoomd/VectorMath.h"
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 using namespace std;
 
@@ -25,6 +27,9 @@ IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef)
     GlobalArray<hpmc_counters_t> counters(1, this->m_exec_conf);
     m_count_total.swap(counters);
 
+    GlobalArray<hpmc_counters_t> count_type(this->m_pdata->getNTypes(), this->m_exec_conf);
+    m_count_type.swap(count_type);
+
     GPUVector<Scalar> d(this->m_pdata->getNTypes(), this->m_exec_conf);
     m_d.swap(d);
 
@@ -122,42 +127,103 @@ bool IntegratorHPMC::checkParticleOrientations()
     \returns false if resize results in overlaps
 */
 bool IntegratorHPMC::attemptBoxResize(uint64_t timestep, const BoxDim& new_box)
+    {
+    // move the particles to be inside the new box
+    scaleParticlePositions(m_pdata->getGlobalBox(), new_box);
+
+    m_pdata->setGlobalBox(new_box);
+
+    // we have moved particles, communicate those changes
+    this->communicate(false);
+
+    // check overlaps
+    return !this->countOverlaps(true);
+    }
+
+void IntegratorHPMC::scaleParticlePositions(const BoxDim& old_box, const BoxDim& new_box)
     {
     unsigned int N = m_pdata->getN();
 
-    // Get old and new boxes;
-    BoxDim curBox = m_pdata->getGlobalBox();
+    // Get particle positions
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
 
-    // Use lexical scope block to make sure ArrayHandles get cleaned up
+    for (unsigned int i = 0; i < N; i++)
         {
-        // Get particle positions
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
 
-        // move the particles to be inside the new box
-        for (unsigned int i = 0; i < N; i++)
-            {
-            Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        // obtain scaled coordinates in the old global box
+        Scalar3 f = old_box.makeFraction(old_pos);
+
+        // scale particles
+        Scalar3 scaled_pos = new_box.makeCoordinates(f);
+        h_pos.data[i].x = scaled_pos.x;
+        h_pos.data[i].y = scaled_pos.y;
+        h_pos.data[i].z = scaled_pos.z;
+        }
+    }
 
-            // obtain scaled coordinates in the old global box
-            Scalar3 f = curBox.makeFraction(old_pos);
+/*! The move sizes d and a of each type are scaled by (acceptance + 1) / (target + 1), at most 2,
+    where acceptance is the fraction of the trial moves of that type accepted since the last
+    adjustment. This is the update hoomd.tune.ScaleSolver makes with gamma = 1, computed from
+    counts recorded by type during the trial moves. Types with zero move sizes, or without trial
+    moves since the last adjustment, are left unchanged.
+*/
+void IntegratorHPMC::adjustMoveSizes()
+    {
+    const unsigned int n_types = m_pdata->getNTypes();
 
-            // scale particles
-            Scalar3 scaled_pos = new_box.makeCoordinates(f);
-            h_pos.data[i].x = scaled_pos.x;
-            h_pos.data[i].y = scaled_pos.y;
-            h_pos.data[i].z = scaled_pos.z;
+    // accepted and rejected translation and rotation moves of each type
+    std::vector<unsigned long long int> counts(4 * n_types);
+        {
+        ArrayHandle<hpmc_counters_t> h_count_type(m_count_type,
+                                                  access_location::host,
+                                                  access_mode::readwrite);
+        for (unsigned int type = 0; type < n_types; type++)
+            {
+            counts[4 * type] = h_count_type.data[type].translate_accept_count;
+            counts[4 * type + 1] = h_count_type.data[type].translate_reject_count;
+            counts[4 * type + 2] = h_count_type.data[type].rotate_accept_count;
+            counts[4 * type + 3] = h_count_type.data[type].rotate_reject_count;
+            h_count_type.data[type] = hpmc_counters_t();
             }
-        } // end lexical scope
+        }
 
-    m_pdata->setGlobalBox(new_box);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      counts.data(),
+                      (int)counts.size(),
+                      MPI_LONG_LONG_INT,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
 
-    // we have moved particles, communicate those changes
-    this->communicate(false);
+    auto scale = [this](Scalar size, unsigned long long int accept, unsigned long long int reject)
+    {
+        if (size == Scalar(0.0) || accept + reject == 0)
+            return size;
 
-    // check overlaps
-    return !this->countOverlaps(true);
+        Scalar acceptance = Scalar(accept) / Scalar(accept + reject);
+        Scalar factor = std::min((acceptance + Scalar(1.0)) / (m_move_size_target + Scalar(1.0)),
+                                 Scalar(2.0));
+        return std::max(size * factor, Scalar(1e-7));
+    };
+
+        {
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::readwrite);
+        for (unsigned int type = 0; type < n_types; type++)
+            {
+            h_d.data[type] = scale(h_d.data[type], counts[4 * type], counts[4 * type + 1]);
+            h_a.data[type] = scale(h_a.data[type], counts[4 * type + 2], counts[4 * type + 3]);
+            }
+        }
+
+    updateCellWidth();
     }
 
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the
@@ -246,9 +312,24 @@ void export_IntegratorHPMC(py::module& m)
         .def("getCounters", &IntegratorHPMC::getCounters)
         .def("communicate", &IntegratorHPMC::communicate)
         .def_property("nselect", &IntegratorHPMC::getNSelect, &IntegratorHPMC::setNSelect)
+        .def_property("checkerboard",
+                      &IntegratorHPMC::getCheckerboard,
+                      &IntegratorHPMC::setCheckerboard)
+        .def_property("depletant_batch_size",
+                      &IntegratorHPMC::getDepletantBatchSize,
+                      &IntegratorHPMC::setDepletantBatchSize)
+        .def_property("exchange_period",
+                      &IntegratorHPMC::getExchangePeriod,
+                      &IntegratorHPMC::setExchangePeriod)
         .def_property("translation_move_probability",
                       &IntegratorHPMC::getTranslationMoveProbability,
-                      &IntegratorHPMC::setTranslationMoveProbability);
+                      &IntegratorHPMC::setTranslationMoveProbability)
+        .def_property("move_size_trigger",
+                      &IntegratorHPMC::getMoveSizeTrigger,
+                      &IntegratorHPMC::setMoveSizeTrigger)
+        .def_property("move_size_target",
+                      &IntegratorHPMC::getMoveSizeTarget,
+                      &IntegratorHPMC::setMoveSizeTarget);
 
     py::class_<hpmc_counters_t>(m, "hpmc_counters_t")
         .def_readonly("overlap_checks", &hpmc_counters_t::overlap_checks)
@@ -15,6 +15,7 @@
 
 #include "hoomd/CellList.h"
 #include "hoomd/Integrator.h"
+#include "hoomd/Trigger.h"
 
 #include "ExternalField.h"
 #include "HPMCCounters.h"
@@ -56,8 +57,7 @@ struct hpmc_patch_args_t
                       const unsigned int* _d_excell_idx,
                       const unsigned int* _d_excell_size,
                       const Index2D& _excli,
-                      const Scalar _r_cut_patch,
-                      const Scalar* _d_additive_cutoff,
+                      const Scalar* _d_r_cut_patch,
                       const unsigned int* _d_update_order_by_ptl,
                       const unsigned int* _d_reject_in,
                       unsigned int* _d_reject_out,
@@ -70,10 +70,10 @@ struct hpmc_patch_args_t
           cell_dim(_cell_dim), ghost_width(_ghost_width), N(_N), seed(_seed), rank(_rank),
           timestep(_timestep), select(_select), num_types(_num_types), box(_box),
           d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
-          r_cut_patch(_r_cut_patch), d_additive_cutoff(_d_additive_cutoff),
-          d_update_order_by_ptl(_d_update_order_by_ptl), d_reject_in(_d_reject_in),
-          d_reject_out(_d_reject_out), d_charge(_d_charge), d_diameter(_d_diameter),
-          d_reject_out_of_cell(_d_reject_out_of_cell), gpu_partition(_gpu_partition)
+          d_r_cut_patch(_d_r_cut_patch), d_update_order_by_ptl(_d_update_order_by_ptl),
+          d_reject_in(_d_reject_in), d_reject_out(_d_reject_out), d_charge(_d_charge),
+          d_diameter(_d_diameter), d_reject_out_of_cell(_d_reject_out_of_cell),
+          gpu_partition(_gpu_partition)
         {
         }
 
@@ -95,8 +95,7 @@ struct hpmc_patch_args_t
     const unsigned int* d_excell_idx;          //!< Expanded cell list
     const unsigned int* d_excell_size;         //!< Size of expanded cells
     const Index2D& excli;                      //!< Excell indexer
-    const Scalar r_cut_patch;                  //!< Global cutoff radius
-    const Scalar* d_additive_cutoff;           //!< Additive contribution to cutoff per type
+    const Scalar* d_r_cut_patch;               //!< Cutoff radius per type pair
     const unsigned int* d_update_order_by_ptl; //!< Order of the update sequence
     const unsigned int* d_reject_in;           //!< Previous reject flags
     unsigned int* d_reject_out;                //!< New reject flags
@@ -142,6 +141,16 @@ class PatchEnergy
         return 0;
         }
 
+    //! Returns the distance between the centers of particles of two types beyond which energies
+    //! are always zero
+    /*! The GPU broad phase only queues the pairs within this distance. Derived classes that know a
+        tighter bound for some type pairs override this method.
+    */
+    virtual Scalar getRCutPair(unsigned int type_i, unsigned int type_j)
+        {
+        return getRCut() + Scalar(0.5) * (getAdditiveCutoff(type_i) + getAdditiveCutoff(type_j));
+        }
+
     //! evaluate the energy of the patch interaction
     /*! \param r_ij Vector pointing from particle i to j
         \param type_i Integer type index of particle i
@@ -217,6 +226,9 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                                 access_location::host,
                                                 access_mode::read);
         m_count_step_start = h_counters.data[0];
+
+        if (m_move_size_trigger && (*m_move_size_trigger)(timestep))
+            adjustMoveSizes();
         }
 
     //! Change maximum displacement
@@ -337,6 +349,89 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return m_nselect;
         }
 
+    //! Set the checkerboard mode
+    /*! \param checkerboard When true, the CPU integrator moves the particles of independent cells
+            in parallel
+    */
+    void setCheckerboard(bool checkerboard)
+        {
+        m_checkerboard = checkerboard;
+        }
+
+    //! Get the checkerboard mode
+    bool getCheckerboard()
+        {
+        return m_checkerboard;
+        }
+
+    //! Set the depletant batch size
+    /*! \param batch_size Maximum number of depletant insertions per particle that the GPU
+            integrator processes in one kernel launch, 0 for no limit
+    */
+    void setDepletantBatchSize(unsigned int batch_size)
+        {
+        m_depletant_batch_size = batch_size;
+        }
+
+    //! Get the depletant batch size
+    unsigned int getDepletantBatchSize()
+        {
+        return m_depletant_batch_size;
+        }
+
+    //! Set the exchange period
+    /*! \param period Number of time steps between the domain shifts, particle migrations, and ghost
+            exchanges with MPI domain decomposition
+    */
+    void setExchangePeriod(unsigned int period)
+        {
+        if (period == 0)
+            throw std::domain_error("exchange_period must be positive");
+        m_exchange_period = period;
+        }
+
+    //! Get the exchange period
+    unsigned int getExchangePeriod()
+        {
+        return m_exchange_period;
+        }
+
+    //! Set the trigger that selects the steps where the move sizes are adjusted
+    /*! \param trigger The trigger, nullptr freezes the move sizes
+     */
+    void setMoveSizeTrigger(std::shared_ptr<Trigger> trigger)
+        {
+        m_move_size_trigger = trigger;
+
+        // discard the counts recorded with the previous settings
+        ArrayHandle<hpmc_counters_t> h_count_type(m_count_type,
+                                                  access_location::host,
+                                                  access_mode::overwrite);
+        std::fill(h_count_type.data,
+                  h_count_type.data + m_count_type.getNumElements(),
+                  hpmc_counters_t());
+        }
+
+    //! Get the trigger that selects the steps where the move sizes are adjusted
+    std::shared_ptr<Trigger> getMoveSizeTrigger()
+        {
+        return m_move_size_trigger;
+        }
+
+    //! Set the target acceptance ratio of the move size adjustments
+    void setMoveSizeTarget(Scalar target)
+        {
+        if (!(target > Scalar(0.0) && target < Scalar(1.0)))
+            throw std::domain_error("move_size_target must be between 0 and 1");
+        m_move_size_target = target;
+        }
+
+    //! Get the target acceptance ratio of the move size adjustments
+    Scalar getMoveSizeTarget()
+        {
+        return m_move_size_target;
+        }
+
     //! Get performance in moves per second
     virtual double getMPS()
         {
@@ -429,12 +524,24 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     virtual void prepRun(uint64_t timestep)
         {
         m_past_first_run = true;
+
+        // the state or the patch parameters may have changed between runs
+        invalidatePatchEnergy();
         }
 
     //! Set the patch energy
     virtual void setPatchEnergy(std::shared_ptr<PatchEnergy> patch)
         {
         m_patch = patch;
+        invalidatePatchEnergy();
+        }
+
+    //! Recompute the total patch energy on the next call to computePatchEnergy()
+    /*! Call this after changing the particles or the patch interaction outside of update().
+     */
+    void invalidatePatchEnergy()
+        {
+        m_patch_energy_valid = false;
         }
 
     //! Get the patch energy
@@ -446,12 +553,48 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     protected:
     unsigned int m_translation_move_probability; //!< Fraction of moves that are translation moves.
     unsigned int m_nselect;                      //!< Number of particles to select for trial moves
+    bool m_checkerboard = false;                 //!< Move the particles in checkerboard order
+    unsigned int m_depletant_batch_size = 0;     //!< Max depletant insertions per GPU kernel launch
+    unsigned int m_exchange_period = 1;          //!< Time steps between ghost exchanges
+    unsigned int m_steps_since_exchange = 0;     //!< Time steps since the last ghost exchange
+    bool m_ghosts_stale = false; //!< True when update() skipped the last ghost exchange
+
+    //! Test whether this time step shifts the domains and exchanges the ghosts
+    /*! Between the exchanges, the trial moves continue in the same active regions. Moves into the
+        inactive region at the upper boundary of each domain are rejected, so the particles in
+        that region are frozen and the ghosts that the active particles interact with, the frozen
+        particles of the lower neighbors, stay valid. Only the ghosts at the upper boundaries go
+        stale, and countOverlaps() and computePatchEnergy() refresh them before they use them.
+    */
+    bool isExchangeStep()
+        {
+        if (++m_steps_since_exchange < m_exchange_period)
+            return false;
+        m_steps_since_exchange = 0;
+        return true;
+        }
+
+    //! Exchange the ghosts when update() skipped the last exchange
+    void refreshStaleGhosts()
+        {
+        if (m_ghosts_stale)
+            communicate(false);
+        }
 
     GPUVector<Scalar> m_d; //!< Maximum move displacement by type
     GPUVector<Scalar> m_a; //!< Maximum angular displacement by type
 
     GlobalArray<hpmc_counters_t> m_count_total; //!< Accept/reject total count
 
+    /// Accept/reject counts by particle type since the last move size adjustment
+    GlobalArray<hpmc_counters_t> m_count_type;
+
+    /// Trigger that selects the steps where the move sizes are adjusted
+    std::shared_ptr<Trigger> m_move_size_trigger;
+
+    /// Target acceptance ratio of the move size adjustments
+    Scalar m_move_size_target = 0.2;
+
     Scalar m_nominal_width;     //!< nominal cell width
     Scalar m_extra_ghost_width; //!< extra ghost width to add
     ClockSource m_clock;        //!< Timer for self-benchmarking
@@ -464,13 +607,39 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
 
     std::shared_ptr<PatchEnergy> m_patch; //!< Patchy Interaction
 
+    //! Maximum number of time steps between full computations of the patch energy
+    static constexpr uint64_t patch_energy_period = 100;
+
+    /// Total patch energy at the last call to computePatchEnergy()
+    /** Between the full computations, computePatchEnergy() adds the energy changes of the trial
+     * moves that update() accepts on this rank. A full computation bounds the accumulated round off
+     * error every patch_energy_period time steps, and replaces the total after anything but
+     * update() changes the system.
+     */
+    double m_patch_energy = 0.0;
+    double m_patch_energy_change = 0.0; //!< Energy change of the local accepted trial moves
+    bool m_patch_energy_valid = false;  //!< False when the next computation must be a full one
+    uint64_t m_patch_energy_timestep = 0; //!< Time step of the last full computation
+
     bool m_past_first_run; //!< Flag to test if the first run() has started
+
+    //! Adjust the move sizes toward the target acceptance ratio
+    void adjustMoveSizes();
+
     //! Update the nominal width of the cells
     /*! This method is virtual so that derived classes can set appropriate widths
         (for example, some may want max diameter while others may want a buffer distance).
     */
     virtual void updateCellWidth() { }
 
+    //! Scale the local particle positions from one global box to another
+    /*! \param old_box Global box the positions are currently in
+        \param new_box Global box to scale the positions into
+
+        Derived classes may override this to scale the positions where they reside.
+    */
+    virtual void scaleParticlePositions(const BoxDim& old_box, const BoxDim& new_box);
+
     //! Return the requested ghost layer width
     virtual Scalar getGhostLayerWidth(unsigned int type)
         {
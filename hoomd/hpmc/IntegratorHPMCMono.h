@@ -142,6 +142,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
                 free(m_aabbs);
             m_pdata->getBoxChangeSignal().template disconnect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotBoxChanged>(this);
             m_pdata->getParticleSortSignal().template disconnect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
+            m_pdata->getGlobalParticleNumberChangeSignal().template disconnect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotNumParticlesChanged>(this);
             }
 
         virtual void resetStats();
@@ -240,6 +241,22 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Get the minimum particle diameter
         virtual OverlapReal getMinCoreDiameter();
 
+        //! Set whether to scale the shape of each particle by its diameter
+        void setScaleByDiameter(bool scale_by_diameter);
+
+        //! Get whether the shape of each particle is scaled by its diameter
+        bool getScaleByDiameter()
+            {
+            return m_scale_by_diameter;
+            }
+
+        //! Scale the shape of a particle by its diameter when scale_by_diameter is set
+        void applyParticleScale(Shape& shape, Scalar diameter) const
+            {
+            if (m_scale_by_diameter)
+                setParticleScale(shape, OverlapReal(diameter));
+            }
+
         //! Set the pair parameters for a single type
         virtual void setParam(unsigned int typ, const param_type& param);
 
@@ -336,6 +353,11 @@ class IntegratorHPMCMono : public IntegratorHPMC
                 flags[comm_flag::charge] = 1;
                 o << " diameter charge";
                 }
+            else if (m_scale_by_diameter)
+                {
+                flags[comm_flag::diameter] = 1;
+                o << " diameter";
+                }
 
             bool have_auxilliary_variables = false;
             for (unsigned int i = 0; i < this->m_pdata->getNTypes(); ++i)
@@ -380,6 +402,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
                     }
                 }
 
+            updateMaxParticleScale();
             updateCellWidth(); // make sure the cell width is up-to-date and forces a rebuild of the AABB tree and image list
 
             communicate(true);
@@ -403,6 +426,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
                 m_comm->exchangeGhosts();
 
                 m_aabb_tree_invalid = true;
+                m_ghosts_stale = false;
                 }
             #endif
             }
@@ -429,7 +453,12 @@ class IntegratorHPMCMono : public IntegratorHPMC
             return m_image_hkl;
             }
 
-        void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
+        //! Notify the integrator that an updater moved particles
+        void invalidateAABBTree()
+            {
+            m_aabb_tree_invalid = true;
+            this->invalidatePatchEnergy();
+            }
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
         int slotWriteGSDState(gsd_handle&, std::string name) const;
@@ -485,9 +514,17 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_refit;                     //!< Flag if the particles moved since the aabb tree was fit
+        Scalar m_aabb_tree_build_area;              //!< Surface area of the aabb tree when it was built
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
+        bool m_scale_by_diameter;                   //!< True to scale the shape of each particle by its diameter
+        Scalar m_max_particle_scale;                //!< Largest particle scale in the system
+
+        //! Find the largest particle scale, update the cell width when it changes
+        void updateMaxParticleScale();
+
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
         /* Depletants related data members */
@@ -510,6 +547,37 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
+        /* Checkerboard mode related data members */
+
+        std::vector<unsigned int> m_cb_cell;           //!< Checkerboard cell of each particle
+        std::vector<unsigned int> m_cb_cell_begin;     //!< Index of the first member of each cell
+        std::vector<unsigned int> m_cb_cell_members;   //!< Particles sorted by cell in update order
+        std::vector<OverlapReal> m_cb_radius;          //!< AABB radius of particles moved in a set
+        std::vector<char> m_cb_moved;                  //!< True for particles moved in a set
+        bool m_cb_warning_issued = false;              //!< True if the grid size warning has been issued
+
+        //! Compute the dimensions of the checkerboard cell grid
+        bool computeCheckerboardDim(uint3& dim);
+
+        //! Perform one sweep of trial moves over the cells of a checkerboard grid
+        void updateCheckerboard(uint64_t timestep, unsigned int i_nselect, const uint3& dim,
+            const unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_counters_t *count_type);
+
+        /* Overlap witness related data members */
+
+        std::vector<uint2> m_overlap_partner;                 //!< Particle and image the last trial move of each particle overlapped with
+        std::vector<detail::OverlapWitness> m_overlap_witness; //!< Shape specific witness of that overlap
+
+        /* Batched leaf overlap test related data members */
+
+        std::vector<OverlapReal> m_circumsphere_diameter; //!< Circumsphere diameter of each type
+
+        //! Select the particles in a leaf node whose circumspheres overlap that of a trial move
+        inline unsigned int selectLeafCandidates(unsigned int cur_node_idx, unsigned int i, unsigned int typ_i,
+            const vec3<Scalar>& pos_i, const vec3<Scalar>& pos_i_image, bool first_image,
+            const Scalar4 *h_postype, const Scalar *h_diameter, unsigned int *candidates,
+            hpmc_counters_t& counters);
+
         //! Grow the m_aabbs list
         virtual void growAABBList(unsigned int N);
 
@@ -524,6 +592,13 @@ class IntegratorHPMCMono : public IntegratorHPMC
             // anything that changes the box (i.e. NPT, box_resize) is also moving the particles,
             // so use it as a sign to rebuild the AABB tree
             m_aabb_tree_invalid = true;
+            this->invalidatePatchEnergy();
+            }
+
+        //! callback so that inserting or removing particles recomputes the patch energy
+        void slotNumParticlesChanged()
+            {
+            this->invalidatePatchEnergy();
             }
 
         //! callback so that the particle sort signal can invalidate the AABB tree
@@ -541,6 +616,8 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_valid(false),
               m_hasOrientation(true),
               m_extra_image_width(0.0),
+              m_scale_by_diameter(false),
+              m_max_particle_scale(1.0),
               m_fugacity(m_exec_conf),
               m_ntrial(m_exec_conf)
     {
@@ -562,6 +639,7 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     // Connect to the BoxChange signal
     m_pdata->getBoxChangeSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotBoxChanged>(this);
     m_pdata->getParticleSortSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotNumParticlesChanged>(this);
 
     m_image_list_rebuilds = 0;
     m_image_list_warning_issued = false;
@@ -570,6 +648,8 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_refit = false;
+    m_aabb_tree_build_area = 0;
 
     m_depletant_idx = Index2D(this->m_pdata->getNTypes());
     m_fugacity.resize(m_depletant_idx.getNumElements(), 0.0);
@@ -647,6 +727,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // get needed vars
     ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::readwrite);
     hpmc_counters_t& counters = h_counters.data[0];
+    ArrayHandle<hpmc_counters_t> h_count_type(this->m_count_type, access_location::host, access_mode::readwrite);
 
     ArrayHandle<hpmc_implicit_counters_t> h_implicit_counters(m_implicit_count, access_location::host, access_mode::readwrite);
     std::copy(h_implicit_counters.data, h_implicit_counters.data + m_depletant_idx.getNumElements(), m_implicit_count_step_start.begin());
@@ -654,6 +735,10 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     const BoxDim& box = m_pdata->getBox();
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
+    // the largest particle sets the nominal width when the shapes scale with the diameters
+    if (m_scale_by_diameter)
+        updateMaxParticleScale();
+
     #ifdef ENABLE_MPI
     // compute the width of the active region
     Scalar3 npd = box.getNearestPlaneDistance();
@@ -671,6 +756,9 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // update the image list
     updateImageList();
 
+    m_overlap_partner.resize(m_pdata->getN(), make_uint2(UINT_MAX, 0));
+    m_overlap_witness.resize(m_pdata->getN());
+
     bool has_depletants = false;
     for (unsigned int i = 0; i < m_depletant_idx.getNumElements(); ++i)
         {
@@ -681,12 +769,23 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             }
         }
 
+    if (has_depletants && m_scale_by_diameter)
+        throw std::runtime_error("Depletants do not support scale_by_diameter.");
+
     // Combine the three seeds to generate RNG for poisson distribution
     hoomd::RandomGenerator rng_depletants(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants,
                                                       timestep,
                                                       this->m_sysdef->getSeed()),
                                           hoomd::Counter(this->m_exec_conf->getRank()));
 
+    // the circumsphere diameters of the types enter the batched leaf overlap test
+    m_circumsphere_diameter.resize(m_pdata->getNTypes());
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        {
+        Shape shape(quat<Scalar>(), m_params[typ]);
+        m_circumsphere_diameter[typ] = shape.getCircumsphereDiameter();
+        }
+
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC update");
 
     if( m_external ) // I think we need this here otherwise I don't think it will get called.
@@ -699,9 +798,19 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // checkerboard moves do not support depletants
+    uint3 cb_dim;
+    bool checkerboard = m_checkerboard && !has_depletants && computeCheckerboardDim(cb_dim);
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
+        if (checkerboard)
+            {
+            updateCheckerboard(timestep, i_nselect, cb_dim, h_overlaps.data, counters, h_count_type.data);
+            continue;
+            }
+
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
@@ -738,10 +847,12 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                          hoomd::Counter(i, m_exec_conf->getRank(), i_nselect));
             int typ_i = __scalar_as_int(postype_i.w);
             Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+            applyParticleScale(shape_i, h_diameter.data[i]);
             unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
             bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_translation_move_probability);
 
             Shape shape_old(quat<Scalar>(orientation_i), m_params[typ_i]);
+            applyParticleScale(shape_old, h_diameter.data[i]);
             vec3<Scalar> pos_old = pos_i;
 
             if (move_type_translate)
@@ -800,10 +911,29 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
+            const unsigned int n_images = (unsigned int)m_image_list.size();
+
+            // first test the particle that the last trial move of i overlapped with, trial moves are
+            // small and likely to be rejected by the same overlap
+            const uint2 partner = m_overlap_partner[i];
+            if (partner.x != i && partner.x < m_pdata->getN() + m_pdata->getNGhosts() && partner.y < n_images)
+                {
+                Scalar4 postype_j = h_postype.data[partner.x];
+                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - (pos_i + m_image_list[partner.y]);
+
+                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                Shape shape_j(quat<Scalar>(h_orientation.data[partner.x]), m_params[typ_j]);
+                applyParticleScale(shape_j, h_diameter.data[partner.x]);
+
+                counters.overlap_checks++;
+                overlap = h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count, m_overlap_witness[i]);
+                }
+
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
-            const unsigned int n_images = (unsigned int)m_image_list.size();
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
                 {
                 vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
                 detail::AABB aabb = aabb_i_local;
@@ -816,10 +946,15 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                         {
                         if (m_aabb_tree.isNodeLeaf(cur_node_idx))
                             {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            unsigned int candidates[detail::NODE_CAPACITY];
+                            unsigned int n_candidates = selectLeafCandidates(cur_node_idx, i, typ_i, pos_i,
+                                pos_i_image, cur_image == 0, h_postype.data,
+                                m_scale_by_diameter ? h_diameter.data : nullptr, candidates, counters);
+
+                            for (unsigned int cur_p = 0; cur_p < n_candidates; cur_p++)
                                 {
                                 // read in its position and orientation
-                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                                unsigned int j = candidates[cur_p];
 
                                 Scalar4 postype_j;
                                 Scalar4 orientation_j;
@@ -851,6 +986,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
 
                                 unsigned int typ_j = __scalar_as_int(postype_j.w);
                                 Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                                applyParticleScale(shape_j, h_diameter.data[j]);
 
                                 Scalar rcut = 0.0;
                                 if (m_patch)
@@ -858,11 +994,16 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                         static_cast<OverlapReal>(m_patch->getAdditiveCutoff(typ_j));
 
                                 counters.overlap_checks++;
+                                detail::OverlapWitness witness;
                                 if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
                                     && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count, witness))
                                     {
                                     overlap = true;
+
+                                    // remember the overlap for the next trial move of i
+                                    m_overlap_partner[i] = make_uint2(j != i ? j : UINT_MAX, cur_image);
+                                    m_overlap_witness[i] = witness;
                                     break;
                                     }
                                 else if (m_patch && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
@@ -895,6 +1036,9 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                     break;
                 } // end loop over images
 
+            if (!overlap)
+                m_overlap_partner[i].x = UINT_MAX;
+
             // calculate old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !overlap)
                 {
@@ -945,6 +1089,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
                                     unsigned int typ_j = __scalar_as_int(postype_j.w);
                                     Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                                    applyParticleScale(shape_j, h_diameter.data[j]);
 
                                     Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
@@ -971,6 +1116,9 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                     } // end loop over images
                 } // end if (m_patch)
 
+            // U_old - U_new of the patch interaction alone
+            const double patch_energy_diff = patch_field_energy_diff;
+
             // Add external energetic contribution
             if (m_external)
                 {
@@ -998,11 +1146,20 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 if (!shape_i.ignoreStatistics())
                     {
                     if (move_type_translate)
+                        {
                         counters.translate_accept_count++;
+                        h_count_type.data[typ_i].translate_accept_count++;
+                        }
                     else
+                        {
                         counters.rotate_accept_count++;
+                        h_count_type.data[typ_i].rotate_accept_count++;
+                        }
                     }
 
+                // keep the running total of the patch energy
+                this->m_patch_energy_change -= patch_energy_diff;
+
                 // update the position of the particle in the tree for future updates
                 detail::AABB aabb = aabb_i_local;
                 aabb.translate(pos_i);
@@ -1026,9 +1183,15 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                     {
                     // increment reject counter
                     if (move_type_translate)
+                        {
                         counters.translate_reject_count++;
+                        h_count_type.data[typ_i].translate_reject_count++;
+                        }
                     else
+                        {
                         counters.rotate_reject_count++;
+                        h_count_type.data[typ_i].rotate_reject_count++;
+                        }
                     }
                 }
             } // end loop over all particles
@@ -1045,8 +1208,12 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
         }
 
     // perform the grid shift
+    bool exchange = true;
     #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
+        exchange = this->isExchangeStep();
+
+    if (m_sysdef->isDomainDecomposed() && exchange)
         {
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
@@ -1078,10 +1245,13 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
     // migrate and exchange particles
-    communicate(true);
+    if (exchange)
+        communicate(true);
+    else
+        m_ghosts_stale = true;
 
-    // all particle have been moved, the aabb tree is now invalid
-    m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit
+    m_aabb_tree_refit = true;
 
     // set current MPS value
     hpmc_counters_t run_counters = getCounters(1);
@@ -1089,6 +1259,564 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     m_mps = double(run_counters.getNMoves()) / cur_time;
     }
 
+/*! \param dim Number of cells along each direction of the local box
+    \returns true if the local box fits at least two cells of the nominal width along each direction
+
+    The number of cells is even along every direction so that cells of the same set are separated by
+    a cell of a different set, also across periodic boundaries.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::computeCheckerboardDim(uint3& dim)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 npd = box.getNearestPlaneDistance();
+    unsigned int ndim = m_sysdef->getNDimensions();
+
+    // no more cells along a direction than about two per particle
+    Scalar n_max = Scalar(2.0) * std::ceil(std::pow(Scalar(m_pdata->getN()), Scalar(1.0) / Scalar(ndim)));
+
+    auto n_cells = [&](Scalar L) -> unsigned int
+        {
+        Scalar n = m_nominal_width > Scalar(0.0) ? std::min(L / m_nominal_width, n_max) : n_max;
+        return (unsigned int)n & ~1u;
+        };
+
+    dim = make_uint3(n_cells(npd.x), n_cells(npd.y), ndim == 2 ? 1 : n_cells(npd.z));
+
+    if (dim.x < 2 || dim.y < 2 || dim.z < 1 || (ndim == 3 && dim.z < 2))
+        {
+        if (!m_cb_warning_issued)
+            {
+            m_exec_conf->msg->warning() << "HPMC checkerboard: the box is too small to fit two cells "
+                << "of width " << m_nominal_width << " in every direction, moving particles serially."
+                << std::endl;
+            m_cb_warning_issued = true;
+            }
+        return false;
+        }
+
+    return true;
+    }
+
+/*! \param timestep Current time step
+    \param i_nselect Index of the sweep in this time step
+    \param dim Dimensions of the cell grid from computeCheckerboardDim()
+    \param h_overlaps Interaction matrix
+    \param counters Counters to add the trial moves to
+    \param count_type Counters by particle type to add the trial moves to
+
+    The local box is divided into a randomly shifted grid of cells at least as wide as the nominal
+    width, colored into 2^d sets. The sets are visited in random order and the cells of one set are
+    processed in parallel: each cell moves its particles in the update order, and rejects moves
+    that leave the cell. Particles in different cells of one set cannot interact, and particles in
+    other sets do not move, so the trial moves of different cells are independent. Every particle
+    is moved with its own random number stream, so the result does not depend on the number of
+    threads.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCheckerboard(uint64_t timestep, unsigned int i_nselect, const uint3& dim,
+    const unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_counters_t *count_type)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_cells = dim.x * dim.y * dim.z;
+    const unsigned int NO_CELL = 0xffffffff;
+
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = m_nominal_width / npd;
+    #endif
+
+    uint16_t seed = m_sysdef->getSeed();
+    const OverlapReal min_core_diameter = getMinCoreDiameter();
+
+    // shift the grid and shuffle the order of the sets
+    hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, seed),
+                               hoomd::Counter(m_exec_conf->getRank(), i_nselect));
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+    Scalar3 shift = make_scalar3(uniform(rng), uniform(rng), ndim == 3 ? uniform(rng) : Scalar(0.0));
+
+    const unsigned int n_sets = ndim == 3 ? 8 : 4;
+    unsigned int set_order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    for (unsigned int k = n_sets - 1; k > 0; --k)
+        std::swap(set_order[k], set_order[hoomd::UniformIntDistribution(k)(rng)]);
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    //access move sizes
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+    // cell of a position in the shifted grid
+    auto get_cell = [&](const vec3<Scalar>& pos) -> unsigned int
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + shift;
+        unsigned int c[3];
+        const Scalar fd[3] = {f.x, f.y, f.z};
+        const unsigned int nd[3] = {dim.x, dim.y, dim.z};
+        for (unsigned int d = 0; d < 3; ++d)
+            {
+            Scalar x = fd[d] - std::floor(fd[d]);
+            c[d] = std::min((unsigned int)(x * Scalar(nd[d])), nd[d] - 1);
+            }
+        return c[0] + dim.x * (c[1] + dim.y * c[2]);
+        };
+
+    // set of a cell
+    auto get_set = [&](unsigned int cell) -> unsigned int
+        {
+        unsigned int x = cell % dim.x;
+        unsigned int y = (cell / dim.x) % dim.y;
+        unsigned int z = cell / (dim.x * dim.y);
+        return (x & 1) | ((y & 1) << 1) | ((z & 1) << 2);
+        };
+
+    // sort the local particles into cells in the update order, ghosts do not move
+    m_cb_cell.assign(N + m_pdata->getNGhosts(), NO_CELL);
+    m_cb_cell_begin.assign(n_cells + 1, 0);
+    m_cb_cell_members.resize(N);
+    m_cb_radius.resize(N);
+    m_cb_moved.assign(N, 0);
+
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        m_cb_cell[i] = get_cell(vec3<Scalar>(h_postype.data[i]));
+        m_cb_cell_begin[m_cb_cell[i] + 1]++;
+        }
+    for (unsigned int c = 0; c < n_cells; ++c)
+        {
+        m_cb_cell_begin[c + 1] += m_cb_cell_begin[c];
+        }
+
+    std::vector<unsigned int> cell_fill(m_cb_cell_begin.begin(), m_cb_cell_begin.end() - 1);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        m_cb_cell_members[cell_fill[m_cb_cell[i]]++] = i;
+        }
+
+    #ifdef ENABLE_TBB
+    const unsigned int n_types = m_pdata->getNTypes();
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    tbb::enumerable_thread_specific< std::vector<hpmc_counters_t> > thread_count_type(n_types);
+    tbb::enumerable_thread_specific<double> thread_patch_energy_change(0.0);
+    #endif
+
+    for (unsigned int k = 0; k < n_sets; ++k)
+        {
+        const unsigned int set = set_order[k];
+        const uint3 half = make_uint3(dim.x / 2, dim.y / 2, ndim == 3 ? dim.z / 2 : 1);
+        const unsigned int n_set_cells = half.x * half.y * half.z;
+
+        // move the particles of one cell of the set
+        auto update_cell = [&](unsigned int set_cell, hpmc_counters_t& cell_counters, hpmc_counters_t *cell_count_type,
+                               double& cell_patch_energy_change)
+            {
+            unsigned int cx = 2 * (set_cell % half.x) + (set & 1);
+            unsigned int cy = 2 * ((set_cell / half.x) % half.y) + ((set >> 1) & 1);
+            unsigned int cz = 2 * (set_cell / (half.x * half.y)) + ((set >> 2) & 1);
+            unsigned int cell = cx + dim.x * (cy + dim.y * cz);
+
+            // call f(j, r_ij) for all potential neighbors j of i at pos, until it returns true
+            auto for_each_neighbor = [&](unsigned int i, const vec3<Scalar>& pos, const detail::AABB& aabb_local, auto f) -> bool
+                {
+                // the tree is not updated during a set, check the particles of this cell directly
+                for (unsigned int m = m_cb_cell_begin[cell]; m < m_cb_cell_begin[cell + 1]; ++m)
+                    {
+                    unsigned int j = m_cb_cell_members[m];
+                    if (j == i)
+                        continue;
+
+                    vec3<Scalar> r_ij(box.minImage(vec_to_scalar3(vec3<Scalar>(h_postype.data[j]) - pos)));
+                    if (f(j, r_ij))
+                        return true;
+                    }
+
+                const unsigned int n_images = (unsigned int)m_image_list.size();
+                for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                    {
+                    vec3<Scalar> pos_image = pos + m_image_list[cur_image];
+                    detail::AABB aabb = aabb_local;
+                    aabb.translate(pos_image);
+
+                    // stackless search
+                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                        {
+                        if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                            {
+                            if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                {
+                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                    {
+                                    unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                    // this cell is handled above, other cells of the set are out of range
+                                    unsigned int cell_j = m_cb_cell[j];
+                                    if (j == i || (cell_j != NO_CELL && get_set(cell_j) == set))
+                                        continue;
+
+                                    if (f(j, vec3<Scalar>(h_postype.data[j]) - pos_image))
+                                        return true;
+                                    }
+                                }
+                            }
+                        else
+                            {
+                            // skip ahead
+                            cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                            }
+                        }  // end loop over AABB nodes
+                    } // end loop over images
+
+                return false;
+                };
+
+            for (unsigned int m = m_cb_cell_begin[cell]; m < m_cb_cell_begin[cell + 1]; ++m)
+                {
+                unsigned int i = m_cb_cell_members[m];
+
+                // read in the current position and orientation
+                Scalar4 postype_i = h_postype.data[i];
+                Scalar4 orientation_i = h_orientation.data[i];
+                vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                #ifdef ENABLE_MPI
+                if (m_sysdef->isDomainDecomposed())
+                    {
+                    // only move particle if active
+                    if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                        continue;
+                    }
+                #endif
+
+                // make a trial move for i
+                hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoTrialMove, timestep, seed),
+                                             hoomd::Counter(i, m_exec_conf->getRank(), i_nselect));
+                int typ_i = __scalar_as_int(postype_i.w);
+                Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+                applyParticleScale(shape_i, h_diameter.data[i]);
+                unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+                bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_translation_move_probability);
+
+                Shape shape_old(quat<Scalar>(orientation_i), m_params[typ_i]);
+                applyParticleScale(shape_old, h_diameter.data[i]);
+                vec3<Scalar> pos_old = pos_i;
+
+                bool accept = true;
+                if (move_type_translate)
+                    {
+                    // skip if no overlap check is required
+                    if (h_d.data[typ_i] == 0.0)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            cell_counters.translate_accept_count++;
+                        continue;
+                        }
+
+                    move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                    #ifdef ENABLE_MPI
+                    if (m_sysdef->isDomainDecomposed())
+                        {
+                        // check if particle has moved into the ghost layer, and skip if it is
+                        if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                            continue;
+                        }
+                    #endif
+
+                    // reject moves that leave the cell
+                    accept = get_cell(pos_i) == cell;
+                    }
+                else
+                    {
+                    if (h_a.data[typ_i] == 0.0)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            cell_counters.rotate_accept_count++;
+                        continue;
+                        }
+
+                    if (ndim == 2)
+                        move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                    else
+                        move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                    }
+
+                OverlapReal r_cut_patch = 0;
+
+                if (m_patch)
+                    {
+                    r_cut_patch = static_cast<OverlapReal>(m_patch->getRCut()) +
+                        static_cast<OverlapReal>(0.5) * static_cast<OverlapReal>(m_patch->getAdditiveCutoff(typ_i));
+                    }
+
+                // subtract minimum AABB extent from search radius
+                OverlapReal R_query = std::max(shape_i.getCircumsphereDiameter()/OverlapReal(2.0),
+                    r_cut_patch-min_core_diameter/(OverlapReal)2.0);
+                detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
+
+                // patch + field interaction deltaU
+                double patch_field_energy_diff = 0;
+
+                // check for overlaps with neighboring particle's positions (also calculate the new energy)
+                bool overlap = accept && for_each_neighbor(i, pos_i, aabb_i_local,
+                    [&](unsigned int j, const vec3<Scalar>& r_ij)
+                    {
+                    Scalar4 postype_j = h_postype.data[j];
+                    Scalar4 orientation_j = h_orientation.data[j];
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                    applyParticleScale(shape_j, h_diameter.data[j]);
+
+                    Scalar rcut = 0.0;
+                    if (m_patch)
+                        rcut = r_cut_patch + 0.5 *
+                            static_cast<OverlapReal>(m_patch->getAdditiveCutoff(typ_j));
+
+                    cell_counters.overlap_checks++;
+                    if (h_overlaps[m_overlap_idx(typ_i, typ_j)]
+                        && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                        && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                        {
+                        return true;
+                        }
+                    else if (m_patch && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
+                        {
+                        // deltaU = U_old - U_new: subtract energy of new configuration
+                        patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
+                                                   quat<float>(shape_i.orientation),
+                                                   float(h_diameter.data[i]),
+                                                   float(h_charge.data[i]),
+                                                   typ_j,
+                                                   quat<float>(orientation_j),
+                                                   float(h_diameter.data[j]),
+                                                   float(h_charge.data[j]));
+                        }
+                    return false;
+                    });
+
+                // calculate old patch energy only if m_patch not NULL and no overlaps
+                if (accept && m_patch && !overlap)
+                    {
+                    for_each_neighbor(i, pos_old, aabb_i_local,
+                        [&](unsigned int j, const vec3<Scalar>& r_ij)
+                        {
+                        Scalar4 postype_j = h_postype.data[j];
+                        Scalar4 orientation_j = h_orientation.data[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                        Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                        // deltaU = U_old - U_new: add energy of old configuration
+                        if (dot(r_ij,r_ij) <= rcut*rcut)
+                            patch_field_energy_diff += m_patch->energy(r_ij,
+                                                       typ_i,
+                                                       quat<float>(orientation_i),
+                                                       float(h_diameter.data[i]),
+                                                       float(h_charge.data[i]),
+                                                       typ_j,
+                                                       quat<float>(orientation_j),
+                                                       float(h_diameter.data[j]),
+                                                       float(h_charge.data[j]));
+                        return false;
+                        });
+                    }
+
+                // U_old - U_new of the patch interaction alone
+                const double patch_energy_diff = patch_field_energy_diff;
+
+                // Add external energetic contribution
+                if (accept && m_external)
+                    {
+                    patch_field_energy_diff -= m_external->energydiff(i, pos_old, shape_old, pos_i, shape_i);
+                    }
+
+                accept = accept && !overlap && hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(patch_field_energy_diff);
+
+                if (accept)
+                    {
+                    // increment accept counter and assign new position
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        if (move_type_translate)
+                            {
+                            cell_counters.translate_accept_count++;
+                            cell_count_type[typ_i].translate_accept_count++;
+                            }
+                        else
+                            {
+                            cell_counters.rotate_accept_count++;
+                            cell_count_type[typ_i].rotate_accept_count++;
+                            }
+                        }
+
+                    cell_patch_energy_change -= patch_energy_diff;
+
+                    // update position of particle, the tree is updated after the set
+                    h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+                    m_cb_radius[i] = R_query;
+                    m_cb_moved[i] = 1;
+
+                    if (shape_i.hasOrientation())
+                        {
+                        h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                        }
+                    }
+                else
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        // increment reject counter
+                        if (move_type_translate)
+                            {
+                            cell_counters.translate_reject_count++;
+                            cell_count_type[typ_i].translate_reject_count++;
+                            }
+                        else
+                            {
+                            cell_counters.rotate_reject_count++;
+                            cell_count_type[typ_i].rotate_reject_count++;
+                            }
+                        }
+                    }
+                } // end loop over the particles in the cell
+            };
+
+        #ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute([&]{
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_set_cells),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+            hpmc_counters_t& local_counters = thread_counters.local();
+            std::vector<hpmc_counters_t>& local_count_type = thread_count_type.local();
+            double& local_patch_energy_change = thread_patch_energy_change.local();
+            for (unsigned int set_cell = r.begin(); set_cell != r.end(); ++set_cell)
+                update_cell(set_cell, local_counters, local_count_type.data(), local_patch_energy_change);
+            });
+        }); // end task arena execute()
+        #else
+        for (unsigned int set_cell = 0; set_cell < n_set_cells; ++set_cell)
+            update_cell(set_cell, counters, count_type, this->m_patch_energy_change);
+        #endif
+
+        // update the positions of the particles in the tree for the next set
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            if (m_cb_moved[i])
+                {
+                m_aabb_tree.update(i, detail::AABB(vec3<Scalar>(h_postype.data[i]), m_cb_radius[i]));
+                m_cb_moved[i] = 0;
+                }
+            }
+        } // end loop over sets
+
+    #ifdef ENABLE_TBB
+    // reduce counters
+    for (auto i = thread_counters.begin(); i != thread_counters.end(); ++i)
+        {
+        counters = counters + *i;
+        }
+    for (auto i = thread_count_type.begin(); i != thread_count_type.end(); ++i)
+        {
+        for (unsigned int type = 0; type < n_types; ++type)
+            count_type[type] = count_type[type] + (*i)[type];
+        }
+    for (auto i = thread_patch_energy_change.begin(); i != thread_patch_energy_change.end(); ++i)
+        {
+        this->m_patch_energy_change += *i;
+        }
+    #endif
+    }
+
+/*! \param cur_node_idx Index of the leaf node
+    \param i Index of the moved particle
+    \param typ_i Type of the moved particle
+    \param pos_i Trial position of the moved particle
+    \param pos_i_image Trial position of the moved particle in the current image
+    \param first_image True in the primary image, where particle i does not interact with itself
+    \param h_postype Particle positions and types
+    \param h_diameter Particle diameters that scale the circumspheres, nullptr to not scale them
+    \param candidates Output list of candidate particles (at least detail::NODE_CAPACITY elements)
+    \param counters Move counters, pairs rejected here count as overlap checks
+    \returns The number of candidates
+
+    The pair distances to all particles in the leaf are computed in one pass over structure of
+    arrays, which the compiler vectorizes, before any shape is constructed. Only the pairs with
+    overlapping circumspheres are passed on to the full overlap test. For spheres this is the
+    complete test up to the boundary. With a patch energy, all particles in the leaf are candidates,
+    because pairs within the patch cutoff interact without overlapping.
+*/
+template <class Shape>
+inline unsigned int IntegratorHPMCMono<Shape>::selectLeafCandidates(unsigned int cur_node_idx,
+    unsigned int i, unsigned int typ_i, const vec3<Scalar>& pos_i, const vec3<Scalar>& pos_i_image,
+    bool first_image, const Scalar4 *h_postype, const Scalar *h_diameter, unsigned int *candidates,
+    hpmc_counters_t& counters)
+    {
+    const unsigned int n_p = m_aabb_tree.getNodeNumParticles(cur_node_idx);
+
+    if (m_patch)
+        {
+        for (unsigned int cur_p = 0; cur_p < n_p; cur_p++)
+            candidates[cur_p] = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+        return n_p;
+        }
+
+    // gather the separations and circumsphere diameters of the leaf
+    OverlapReal dx[detail::NODE_CAPACITY];
+    OverlapReal dy[detail::NODE_CAPACITY];
+    OverlapReal dz[detail::NODE_CAPACITY];
+    OverlapReal d_ij[detail::NODE_CAPACITY];
+    OverlapReal d_i = m_circumsphere_diameter[typ_i];
+    if (h_diameter)
+        d_i *= OverlapReal(h_diameter[i]);
+    for (unsigned int cur_p = 0; cur_p < n_p; cur_p++)
+        {
+        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+        vec3<Scalar> r_ij = pos_i - pos_i_image;
+        unsigned int typ_j = typ_i;
+        if (j != i)
+            {
+            const Scalar4 postype_j = h_postype[j];
+            r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+            typ_j = __scalar_as_int(postype_j.w);
+            }
+
+        dx[cur_p] = OverlapReal(r_ij.x);
+        dy[cur_p] = OverlapReal(r_ij.y);
+        dz[cur_p] = OverlapReal(r_ij.z);
+        d_ij[cur_p] = d_i + m_circumsphere_diameter[typ_j]*(h_diameter ? OverlapReal(h_diameter[j]) : OverlapReal(1.0));
+        }
+
+    // batched circumsphere test
+    int hit[detail::NODE_CAPACITY];
+    for (unsigned int cur_p = 0; cur_p < n_p; cur_p++)
+        {
+        OverlapReal rsq = dx[cur_p]*dx[cur_p] + dy[cur_p]*dy[cur_p] + dz[cur_p]*dz[cur_p];
+        hit[cur_p] = rsq*OverlapReal(4.0) <= d_ij[cur_p]*d_ij[cur_p];
+        }
+
+    // compact the list of candidates, in the first image i does not interact with itself
+    unsigned int n_tested = 0;
+    unsigned int n_candidates = 0;
+    for (unsigned int cur_p = 0; cur_p < n_p; cur_p++)
+        {
+        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+        if (j == i && first_image)
+            continue;
+
+        n_tested++;
+        if (hit[cur_p])
+            candidates[n_candidates++] = j;
+        }
+
+    counters.overlap_checks += n_tested - n_candidates;
+    return n_candidates;
+    }
+
 /*! \param timestep current step
     \param early_exit exit at first overlap found if true
     \returns number of overlaps if early_exit=false, 1 if early_exit=true
@@ -1099,6 +1827,8 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
     unsigned int overlap_count = 0;
     unsigned int err_count = 0;
 
+    this->refreshStaleGhosts();
+
     // build an up to date AABB tree
     buildAABBTree();
     // update the image list
@@ -1109,6 +1839,7 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
     // access particle data and system box
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     // access parameters and interaction matrix
@@ -1122,6 +1853,7 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
         Scalar4 orientation_i = h_orientation.data[i];
         unsigned int typ_i = __scalar_as_int(postype_i.w);
         Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+        applyParticleScale(shape_i, h_diameter.data[i]);
         vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
 
         // Check particle against AABB tree for neighbors
@@ -1158,6 +1890,7 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
 
                             unsigned int typ_j = __scalar_as_int(postype_j.w);
                             Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                            applyParticleScale(shape_j, h_diameter.data[j]);
 
                             if (h_tag.data[i] <= h_tag.data[j]
                                 && h_overlaps.data[m_overlap_idx(typ_i,typ_j)]
@@ -1230,6 +1963,24 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
         throw std::runtime_error("Error communicating in count_overlaps");
         }
 
+    // between the full computations, add the energy changes of the accepted trial moves
+    double change[2] = {this->m_patch_energy_change, this->m_patch_energy_valid ? 0.0 : 1.0};
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, change, 2, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+    this->m_patch_energy_change = 0.0;
+
+    if (change[1] == 0.0 && timestep < this->m_patch_energy_timestep + patch_energy_period)
+        {
+        this->m_patch_energy += change[0];
+        return float(this->m_patch_energy);
+        }
+
+    this->refreshStaleGhosts();
+
     // build an up to date AABB tree
     buildAABBTree();
     // update the image list
@@ -1255,6 +2006,7 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
         Scalar4 orientation_i = h_orientation.data[i];
         unsigned int typ_i = __scalar_as_int(postype_i.w);
         Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+        applyParticleScale(shape_i, h_diameter.data[i]);
         vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
 
         Scalar d_i = h_diameter.data[i];
@@ -1301,6 +2053,7 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
 
                             unsigned int typ_j = __scalar_as_int(postype_j.w);
                             Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                            applyParticleScale(shape_j, h_diameter.data[j]);
 
                             // count unique pairs within range
                             Scalar rcut_ij = r_cut + 0.5*m_patch->getAdditiveCutoff(typ_j);
@@ -1339,6 +2092,10 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
         }
     #endif
 
+    this->m_patch_energy = energy;
+    this->m_patch_energy_valid = true;
+    this->m_patch_energy_timestep = timestep;
+
     return float(energy);
     }
 
@@ -1368,7 +2125,7 @@ Scalar IntegratorHPMCMono<Shape>::getMaxCoreDiameter()
                 max_d = std::max(0.5*(temp_i.getCircumsphereDiameter()+temp_j.getCircumsphereDiameter()),max_d);
             }
         }
-    return max_d;
+    return max_d*m_max_particle_scale;
     }
 
 template <class Shape>
@@ -1393,6 +2150,54 @@ OverlapReal IntegratorHPMCMono<Shape>::getMinCoreDiameter()
     return minD;
     }
 
+/*! \param scale_by_diameter True to scale the shape of each particle by its diameter
+
+    A polydisperse system then needs one type per shape instead of one type per size. Only the CPU
+    code paths scale the shapes.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::setScaleByDiameter(bool scale_by_diameter)
+    {
+    if (scale_by_diameter && !particle_scale_supported<Shape>::value)
+        throw std::runtime_error("scale_by_diameter is not supported by this shape.");
+
+    if (scale_by_diameter && m_exec_conf->isCUDAEnabled())
+        throw std::runtime_error("scale_by_diameter is not supported on the GPU.");
+
+    m_scale_by_diameter = scale_by_diameter;
+    updateMaxParticleScale();
+    updateCellWidth();
+    }
+
+/*! The largest diameter scales the nominal width. Resize the cells and invalidate the AABB tree
+    and image list when it changes.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateMaxParticleScale()
+    {
+    Scalar max_scale(1.0);
+    if (m_scale_by_diameter)
+        {
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        max_scale = Scalar(0.0);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            max_scale = std::max(max_scale, h_diameter.data[i]);
+
+        #ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            MPI_Allreduce(MPI_IN_PLACE, &max_scale, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+            }
+        #endif
+        }
+
+    if (max_scale != m_max_particle_scale)
+        {
+        m_max_particle_scale = max_scale;
+        updateCellWidth();
+        }
+    }
+
 /*! \param typ type name to set
     \param v python dictionary to convert to shape
 */
@@ -1430,6 +2235,8 @@ void IntegratorHPMCMono<Shape>::setParam(unsigned int typ,  const param_type& pa
         m_params[typ] = param;
         }
 
+    this->invalidatePatchEnergy();
+
     updateCellWidth();
     }
 
@@ -1695,13 +2502,12 @@ void IntegratorHPMCMono<Shape>::updateCellWidth()
     // Account for patch width
     if (this->m_patch)
         {
-        Scalar max_extent = 0.0;
-        for (unsigned int typ = 0; typ < this->m_pdata->getNTypes(); typ++)
-            {
-            max_extent = std::max(max_extent, this->m_patch->getAdditiveCutoff(typ));
-            }
+        Scalar max_r_cut = 0.0;
+        for (unsigned int type_i = 0; type_i < this->m_pdata->getNTypes(); type_i++)
+            for (unsigned int type_j = type_i; type_j < this->m_pdata->getNTypes(); type_j++)
+                max_r_cut = std::max(max_r_cut, this->m_patch->getRCutPair(type_i, type_j));
 
-        this->m_nominal_width = std::max(this->m_nominal_width, this->m_patch->getRCut() + max_extent);
+        this->m_nominal_width = std::max(this->m_nominal_width, max_r_cut);
         }
     this->m_image_list_valid = false;
     this->m_aabb_tree_invalid = true;
@@ -1737,6 +2543,11 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
     this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be rebuilt several times in a
     single step because of box volume moves.
 
+    When the particles only moved a little and the particle list is unchanged, set m_aabb_tree_refit instead.
+    buildAABBTree() then refits the node volumes of the existing tree to the new positions, and rebuilds the tree
+    only when the surface area of the refit tree exceeds that of the last built tree by a factor of
+    aabb_tree_max_area_ratio.
+
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
@@ -1745,14 +2556,19 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
 template <class Shape>
 const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
-    if (m_aabb_tree_invalid)
+    // rebuild a refit tree when queries become this much more expensive
+    const Scalar aabb_tree_max_area_ratio = Scalar(1.25);
+
+    if (m_aabb_tree_invalid || m_aabb_tree_refit)
         {
-        m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
+        m_exec_conf->msg->notice(8) << (m_aabb_tree_invalid ? "Building" : "Refitting") << " AABB tree: "
+            << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
         if (this->m_prof) this->m_prof->push(this->m_exec_conf, "AABB tree build");
         // build the AABB tree
             {
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
 
             // grow the AABB list to the needed size
             unsigned int n_aabb = m_pdata->getN()+m_pdata->getNGhosts();
@@ -1764,6 +2580,7 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                     unsigned int i = cur_particle;
                     unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
                     Shape shape(quat<Scalar>(h_orientation.data[i]), m_params[typ_i]);
+                    applyParticleScale(shape, h_diameter.data[i]);
 
                     if (!this->m_patch)
                         m_aabbs[i] = shape.getAABB(vec3<Scalar>(h_postype.data[i]));
@@ -1774,7 +2591,23 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                bool refit = false;
+                if (!m_aabb_tree_invalid && n_aabb == m_aabb_tree.getNumParticles())
+                    {
+                    m_aabb_tree.refit(m_aabbs, n_aabb);
+                    if (m_aabb_tree.getSurfaceArea() <= aabb_tree_max_area_ratio * m_aabb_tree_build_area)
+                        refit = true;
+                    }
+
+                if (!refit)
+                    {
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    m_aabb_tree_build_area = m_aabb_tree.getSurfaceArea();
+
+                    // particle indices may have changed
+                    m_overlap_partner.clear();
+                    }
                 }
             }
 
@@ -1782,6 +2615,7 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
         }
 
     m_aabb_tree_invalid = false;
+    m_aabb_tree_refit = false;
     return m_aabb_tree;
     }
 
@@ -1850,6 +2684,7 @@ std::vector<std::pair<unsigned int, unsigned int> > IntegratorHPMCMono<Shape>::m
     // access particle data and system box
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     // Loop over all particles
@@ -1859,6 +2694,7 @@ std::vector<std::pair<unsigned int, unsigned int> > IntegratorHPMCMono<Shape>::m
         Scalar4 postype_i = h_postype.data[i];
         Scalar4 orientation_i = h_orientation.data[i];
         Shape shape_i(quat<Scalar>(orientation_i), m_params[__scalar_as_int(postype_i.w)]);
+        applyParticleScale(shape_i, h_diameter.data[i]);
         vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
 
         // Check particle against AABB tree for neighbors
@@ -1896,6 +2732,7 @@ std::vector<std::pair<unsigned int, unsigned int> > IntegratorHPMCMono<Shape>::m
                             vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
                             Shape shape_j(quat<Scalar>(orientation_j), m_params[__scalar_as_int(postype_j.w)]);
+                            applyParticleScale(shape_j, h_diameter.data[j]);
 
                             if (h_tag.data[i] <= h_tag.data[j]
                                 && check_circumsphere_overlap(r_ij, shape_i, shape_j)
@@ -3096,6 +3933,7 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("getShape", &IntegratorHPMCMono<Shape>::getShape)
           .def("setShape", &IntegratorHPMCMono<Shape>::setShape)
           .def("computePatchEnergy", &IntegratorHPMCMono<Shape>::computePatchEnergy)
+          .def_property("scale_by_diameter", &IntegratorHPMCMono<Shape>::getScaleByDiameter, &IntegratorHPMCMono<Shape>::setScaleByDiameter)
           ;
     }
 
@@ -0,0 +1,558 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "IntegratorHPMCMono.h"
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#endif
+
+/*! \file IntegratorHPMCMonoEC.h
+    \brief Declaration of IntegratorHPMCMonoEC
+*/
+
+namespace hpmc
+    {
+/** Event chain Monte Carlo of hard shapes
+
+    IntegratorHPMCMonoEC replaces the translation trial moves of IntegratorHPMCMono with straight
+    event chains (E. P. Bernard, W. Krauth, and D. B. Wilson, Phys. Rev. E 80, 056704, 2009). An
+    event chain starts at a particle and picks a random direction. The particle slides along that
+    direction until it touches another particle, which then continues to slide in the same
+    direction. The chain ends once the displacements of all particles in the chain sum to the chain
+    length. Event chains are rejection free and displace many particles collectively, so they relax
+    dense hard particle fluids much faster than local trial moves.
+
+    Each sweep starts one event chain per particle. Rotation trial moves are applied as in
+    IntegratorHPMCMono, selected with the translation move probability.
+
+    The distance a particle slides before it touches a neighbor is given by sweep_distance(). Only
+    shapes that specialize sweep_distance() may be used. The neighbors are found with the AABB tree
+    of IntegratorHPMCMono, by querying the AABB swept by the particle. Each query covers at most
+    the largest interaction range, and the image list is extended by that length.
+
+    Event chain moves do not support patch energies, external fields, depletants, or domain
+    decomposition.
+*/
+template<class Shape> class IntegratorHPMCMonoEC : public IntegratorHPMCMono<Shape>
+    {
+    public:
+    /// Construct the integrator
+    IntegratorHPMCMonoEC(std::shared_ptr<SystemDefinition> sysdef);
+
+    /// Destructor
+    virtual ~IntegratorHPMCMonoEC();
+
+    /// Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    /// Get the total displacement of each event chain
+    Scalar getChainLength()
+        {
+        return m_chain_length;
+        }
+
+    /// Set the total displacement of each event chain
+    void setChainLength(Scalar chain_length)
+        {
+        if (chain_length < Scalar(0.0))
+            throw std::domain_error("chain_length must be non-negative.");
+        m_chain_length = chain_length;
+        }
+
+    protected:
+    Scalar m_chain_length;       //!< Total displacement of each event chain
+    Scalar m_max_sweep_distance; //!< Largest displacement covered by one neighbor query
+
+    /// Set the nominal width appropriate for looped moves
+    virtual void updateCellWidth();
+
+    /// Move particles along a direction until the chain length is used up
+    void eventChain(unsigned int i,
+                    const vec3<Scalar>& direction,
+                    Scalar4* h_postype,
+                    const Scalar4* h_orientation,
+                    int3* h_image,
+                    const unsigned int* h_overlaps,
+                    hpmc_counters_t& counters);
+
+    /// Find the first particle that particle i touches while sliding along a direction
+    unsigned int findCollision(unsigned int i,
+                               const vec3<Scalar>& direction,
+                               OverlapReal& distance,
+                               const Scalar4* h_postype,
+                               const Scalar4* h_orientation,
+                               const unsigned int* h_overlaps,
+                               hpmc_counters_t& counters);
+
+    /// Test whether particle i overlaps any other particle
+    bool checkOverlap(unsigned int i,
+                      const vec3<Scalar>& pos_i,
+                      const Shape& shape_i,
+                      const Scalar4* h_postype,
+                      const Scalar4* h_orientation,
+                      const unsigned int* h_overlaps,
+                      hpmc_counters_t& counters);
+    };
+
+template<class Shape>
+IntegratorHPMCMonoEC<Shape>::IntegratorHPMCMonoEC(std::shared_ptr<SystemDefinition> sysdef)
+    : IntegratorHPMCMono<Shape>(sysdef), m_chain_length(1.0), m_max_sweep_distance(0.0)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMCMonoEC" << std::endl;
+    }
+
+template<class Shape> IntegratorHPMCMonoEC<Shape>::~IntegratorHPMCMonoEC()
+    {
+    this->m_exec_conf->msg->notice(5) << "Destroying IntegratorHPMCMonoEC" << std::endl;
+    }
+
+template<class Shape> void IntegratorHPMCMonoEC<Shape>::updateCellWidth()
+    {
+    IntegratorHPMCMono<Shape>::updateCellWidth();
+
+    // neighbors of a particle may be up to one query length further away than with local moves
+    m_max_sweep_distance = this->getMaxCoreDiameter();
+    this->m_extra_image_width += m_max_sweep_distance;
+    }
+
+template<class Shape> void IntegratorHPMCMonoEC<Shape>::update(uint64_t timestep)
+    {
+    Integrator::update(timestep);
+    this->m_exec_conf->msg->notice(10) << "HPMCMonoEC update: " << timestep << std::endl;
+    IntegratorHPMC::update(timestep);
+
+    if (this->m_patch)
+        throw std::runtime_error("Event chain moves do not support patch energies.");
+    if (this->m_external)
+        throw std::runtime_error("Event chain moves do not support external fields.");
+    for (unsigned int i = 0; i < this->m_depletant_idx.getNumElements(); ++i)
+        {
+        if (this->m_fugacity[i] != 0.0)
+            throw std::runtime_error("Event chain moves do not support depletants.");
+        }
+    if (this->m_scale_by_diameter)
+        throw std::runtime_error("Event chain moves do not support scale_by_diameter.");
+#ifdef ENABLE_MPI
+    if (this->m_sysdef->isDomainDecomposed())
+        throw std::runtime_error("Event chain moves do not support domain decomposition.");
+#endif
+
+    ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total,
+                                            access_location::host,
+                                            access_mode::readwrite);
+    hpmc_counters_t& counters = h_counters.data[0];
+    ArrayHandle<hpmc_counters_t> h_count_type(this->m_count_type,
+                                              access_location::host,
+                                              access_mode::readwrite);
+
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    uint16_t seed = this->m_sysdef->getSeed();
+
+    // Shuffle the order of particles for this step
+    this->m_update_order.resize(this->m_pdata->getN());
+    this->m_update_order.shuffle(timestep, seed, this->m_exec_conf->getRank());
+
+    // update the AABB Tree and the image list
+    this->buildAABBTree();
+    this->limitMoveDistances();
+    this->updateImageList();
+
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "HPMC EC update");
+
+    ArrayHandle<unsigned int> h_overlaps(this->m_overlaps,
+                                         access_location::host,
+                                         access_mode::read);
+
+    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        ArrayHandle<Scalar> h_a(this->m_a, access_location::host, access_mode::read);
+
+        for (unsigned int cur_particle = 0; cur_particle < this->m_pdata->getN(); cur_particle++)
+            {
+            unsigned int i = this->m_update_order[cur_particle];
+
+            hoomd::RandomGenerator rng_i(
+                hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoEventChain, timestep, seed),
+                hoomd::Counter(i, this->m_exec_conf->getRank(), i_nselect));
+
+            Scalar4 postype_i = h_postype.data[i];
+            unsigned int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+            bool move_type_translate = !shape_i.hasOrientation()
+                                       || (move_type_select < this->m_translation_move_probability);
+
+            if (move_type_translate)
+                {
+                if (m_chain_length == Scalar(0.0))
+                    continue;
+
+                vec3<Scalar> direction;
+                if (ndim == 2)
+                    {
+                    Scalar theta = hoomd::UniformDistribution<Scalar>(Scalar(0.0),
+                                                                      Scalar(2.0 * M_PI))(rng_i);
+                    direction = vec3<Scalar>(slow::cos(theta), slow::sin(theta), Scalar(0.0));
+                    }
+                else
+                    {
+                    hoomd::SpherePointGenerator<Scalar>()(rng_i, direction);
+                    }
+
+                eventChain(i,
+                           direction,
+                           h_postype.data,
+                           h_orientation.data,
+                           h_image.data,
+                           h_overlaps.data,
+                           counters);
+                }
+            else
+                {
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                if (ndim == 2)
+                    move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                else
+                    move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+
+                vec3<Scalar> pos_i(postype_i);
+                bool overlap = checkOverlap(i,
+                                            pos_i,
+                                            shape_i,
+                                            h_postype.data,
+                                            h_orientation.data,
+                                            h_overlaps.data,
+                                            counters);
+
+                if (!overlap)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        counters.rotate_accept_count++;
+                        h_count_type.data[typ_i].rotate_accept_count++;
+                        }
+
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    this->m_aabb_tree.update(i, shape_i.getAABB(pos_i));
+                    }
+                else
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        counters.rotate_reject_count++;
+                        h_count_type.data[typ_i].rotate_reject_count++;
+                        }
+                    }
+                }
+            }
+        }
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+
+    // all particle have been moved, the aabb tree needs to be refit
+    this->m_aabb_tree_refit = true;
+
+    // set current MPS value
+    hpmc_counters_t run_counters = this->getCounters(1);
+    double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
+    this->m_mps = double(run_counters.getNMoves()) / cur_time;
+    }
+
+/*! \param i Particle that starts the chain
+    \param direction Unit vector along which the particles move
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_image Particle images
+    \param h_overlaps Interaction matrix
+    \param counters Counters to add the displacements to
+
+    Every displacement between two collisions is counted as an accepted translation move. Particles
+    are wrapped back into the box after each displacement.
+*/
+template<class Shape>
+void IntegratorHPMCMonoEC<Shape>::eventChain(unsigned int i,
+                                             const vec3<Scalar>& direction,
+                                             Scalar4* h_postype,
+                                             const Scalar4* h_orientation,
+                                             int3* h_image,
+                                             const unsigned int* h_overlaps,
+                                             hpmc_counters_t& counters)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    const unsigned int N = this->m_pdata->getN();
+
+    Scalar remaining = m_chain_length;
+    unsigned int n_stuck = 0;
+    while (remaining > Scalar(0.0))
+        {
+        OverlapReal distance = OverlapReal(
+            m_max_sweep_distance > Scalar(0.0) ? std::min(remaining, m_max_sweep_distance)
+                                               : remaining);
+        unsigned int j = findCollision(i,
+                                       direction,
+                                       distance,
+                                       h_postype,
+                                       h_orientation,
+                                       h_overlaps,
+                                       counters);
+
+        // particles that touch on all sides cannot move
+        if (distance == OverlapReal(0.0) && ++n_stuck > N)
+            {
+            counters.overlap_err_count++;
+            break;
+            }
+        else if (distance > OverlapReal(0.0))
+            {
+            n_stuck = 0;
+            }
+
+        // slide i up to the collision
+        Scalar4 postype_i = h_postype[i];
+        vec3<Scalar> pos_i = vec3<Scalar>(postype_i) + Scalar(distance) * direction;
+        h_postype[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+        box.wrap(h_postype[i], h_image[i]);
+
+        unsigned int typ_i = __scalar_as_int(postype_i.w);
+        Shape shape_i(quat<Scalar>(h_orientation[i]), this->m_params[typ_i]);
+        this->m_aabb_tree.update(i, shape_i.getAABB(vec3<Scalar>(h_postype[i])));
+
+        if (!shape_i.ignoreStatistics())
+            counters.translate_accept_count++;
+
+        remaining -= Scalar(distance);
+
+        // the particle that was hit continues the chain, particle i continues when it moved the
+        // full query distance without a collision
+        if (j != UINT_MAX)
+            i = j;
+        }
+    }
+
+/*! \param i Particle that slides
+    \param direction Unit vector along which particle i slides
+    \param distance In: largest distance to consider. Out: distance to the first collision.
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_overlaps Interaction matrix
+    \param counters Counters to add the overlap checks and errors to
+    \returns The particle that i collides with first, or UINT_MAX when i slides the full distance
+             without a collision.
+
+    When i collides with its own periodic image, i is returned.
+*/
+template<class Shape>
+unsigned int IntegratorHPMCMonoEC<Shape>::findCollision(unsigned int i,
+                                                        const vec3<Scalar>& direction,
+                                                        OverlapReal& distance,
+                                                        const Scalar4* h_postype,
+                                                        const Scalar4* h_orientation,
+                                                        const unsigned int* h_overlaps,
+                                                        hpmc_counters_t& counters)
+    {
+    Scalar4 postype_i = h_postype[i];
+    vec3<Scalar> pos_i(postype_i);
+    unsigned int typ_i = __scalar_as_int(postype_i.w);
+    Shape shape_i(quat<Scalar>(h_orientation[i]), this->m_params[typ_i]);
+
+    unsigned int collision = UINT_MAX;
+
+    // the AABB swept by particle i
+    detail::AABB aabb_i_local
+        = detail::merge(shape_i.getAABB(vec3<Scalar>(0, 0, 0)),
+                        shape_i.getAABB(Scalar(distance) * direction));
+
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        // in the first image, skip i == j
+                        if (j == i && cur_image == 0)
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        if (!h_overlaps[this->m_overlap_idx(typ_i, typ_j)])
+                            continue;
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                        Shape shape_j(quat<Scalar>(h_orientation[j]), this->m_params[typ_j]);
+
+                        // skip particles that the circumsphere of i misses
+                        OverlapReal R = OverlapReal(0.5)
+                                        * (shape_i.getCircumsphereDiameter()
+                                           + shape_j.getCircumsphereDiameter());
+                        OverlapReal r_parallel = OverlapReal(dot(r_ij, direction));
+                        OverlapReal r_perp_sq
+                            = OverlapReal(dot(r_ij, r_ij)) - r_parallel * r_parallel;
+                        if (r_parallel < -R || r_parallel > distance + R || r_perp_sq > R * R)
+                            continue;
+
+                        counters.overlap_checks++;
+                        OverlapReal d = sweep_distance(r_ij,
+                                                       shape_i,
+                                                       shape_j,
+                                                       direction,
+                                                       distance,
+                                                       counters.overlap_err_count);
+                        if (d < distance)
+                            {
+                            distance = d;
+                            collision = j;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return collision;
+    }
+
+/*! \param i Particle to test
+    \param pos_i Position of particle i
+    \param shape_i Shape of particle i
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_overlaps Interaction matrix
+    \param counters Counters to add the overlap checks and errors to
+    \returns true when particle i overlaps any other particle
+*/
+template<class Shape>
+bool IntegratorHPMCMonoEC<Shape>::checkOverlap(unsigned int i,
+                                               const vec3<Scalar>& pos_i,
+                                               const Shape& shape_i,
+                                               const Scalar4* h_postype,
+                                               const Scalar4* h_orientation,
+                                               const unsigned int* h_overlaps,
+                                               hpmc_counters_t& counters)
+    {
+    unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+    detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        vec3<Scalar> pos_j;
+                        quat<Scalar> orientation_j;
+                        if (j != i)
+                            {
+                            pos_j = vec3<Scalar>(h_postype[j]);
+                            orientation_j = quat<Scalar>(h_orientation[j]);
+                            }
+                        else if (cur_image == 0)
+                            {
+                            // in the first image, skip i == j
+                            continue;
+                            }
+                        else
+                            {
+                            // use the trial orientation for the periodic images of i
+                            pos_j = pos_i;
+                            orientation_j = shape_i.orientation;
+                            }
+
+                        unsigned int typ_j = __scalar_as_int(h_postype[j].w);
+                        vec3<Scalar> r_ij = pos_j - pos_i_image;
+                        Shape shape_j(orientation_j, this->m_params[typ_j]);
+
+                        counters.overlap_checks++;
+                        if (h_overlaps[this->m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            return true;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return false;
+    }
+
+#ifndef __HIPCC__
+//! Export the IntegratorHPMCMonoEC class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of IntegratorHPMCMonoEC<Shape> will be exported
+*/
+template<class Shape> void export_IntegratorHPMCMonoEC(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<IntegratorHPMCMonoEC<Shape>,
+                     IntegratorHPMCMono<Shape>,
+                     std::shared_ptr<IntegratorHPMCMonoEC<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
+        .def_property("chain_length",
+                      &IntegratorHPMCMonoEC<Shape>::getChainLength,
+                      &IntegratorHPMCMonoEC<Shape>::setChainLength);
+    }
+#endif
+
+    } // end namespace hpmc
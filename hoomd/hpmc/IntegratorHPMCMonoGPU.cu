@@ -144,6 +144,43 @@ __global__ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
     // clear input
     d_reject_in[i] = reject_out_of_cell;
     }
+
+//! Kernel to scale particle positions into a new box
+/*! \param d_postype Particle positions to scale
+    \param N Number of particles
+    \param old_box Box the particles are in
+    \param new_box Box to scale the particles into
+
+    The fractional coordinates of the particles are preserved.
+*/
+__global__ void hpmc_scale_positions(Scalar4* d_postype,
+                                     const unsigned int N,
+                                     const BoxDim old_box,
+                                     const BoxDim new_box)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= N)
+        return;
+
+    Scalar4 postype = d_postype[i];
+    Scalar3 f = old_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 pos = new_box.makeCoordinates(f);
+    d_postype[i] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+    }
+
+//! Kernel to count the particles with a nonzero reject flag
+__global__ void hpmc_count_rejected(const unsigned int* d_reject,
+                                    unsigned int* d_count,
+                                    const unsigned int nwork,
+                                    const unsigned work_offset)
+    {
+    unsigned int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= nwork)
+        return;
+
+    if (d_reject[work_idx + work_offset])
+        atomicAdd(d_count, 1);
+    }
     } // end namespace kernel
 
 //! Driver for kernel::hpmc_excell()
@@ -265,5 +302,59 @@ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
         }
     }
 
+//! Kernel driver for kernel::hpmc_scale_positions()
+void hpmc_scale_positions(Scalar4* d_postype,
+                          const unsigned int N,
+                          const BoxDim& old_box,
+                          const BoxDim& new_box,
+                          const unsigned int block_size)
+    {
+    assert(d_postype);
+
+    dim3 threads(block_size, 1, 1);
+    dim3 grid(N / block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL(kernel::hpmc_scale_positions,
+                       grid,
+                       threads,
+                       0,
+                       0,
+                       d_postype,
+                       N,
+                       old_box,
+                       new_box);
+    }
+
+//! Kernel driver for kernel::hpmc_count_rejected()
+void hpmc_count_rejected(const unsigned int* d_reject,
+                         unsigned int* d_count,
+                         const GPUPartition& gpu_partition,
+                         const unsigned int block_size)
+    {
+    assert(d_reject);
+    assert(d_count);
+
+    dim3 threads(block_size, 1, 1);
+
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        const unsigned int num_blocks = nwork / block_size + 1;
+        dim3 grid(num_blocks, 1, 1);
+
+        hipLaunchKernelGGL(kernel::hpmc_count_rejected,
+                           grid,
+                           threads,
+                           0,
+                           0,
+                           d_reject,
+                           d_count,
+                           nwork,
+                           range.first);
+        }
+    }
+
     } // end namespace gpu
     } // end namespace hpmc
@@ -66,10 +66,12 @@ __launch_bounds__(max_threads)
                                       const unsigned int* d_reject_in,
                                       unsigned int* d_reject_out,
                                       const unsigned int* d_reject_out_of_cell,
+                                      const unsigned int* d_type_cache_order,
                                       const unsigned int max_extra_bytes,
                                       const unsigned int max_queue_size,
                                       const unsigned int work_offset,
-                                      const unsigned int nwork)
+                                      const unsigned int nwork,
+                                      const bool count_overlap_checks)
     {
     __shared__ unsigned int s_overlap_checks;
     __shared__ unsigned int s_overlap_err_count;
@@ -125,9 +127,14 @@ __launch_bounds__(max_threads)
     // initialize extra shared mem
     char* s_extra = (char*)(s_reject_group + n_groups);
 
+    // cache the nested parameters of the most frequent types first, the remaining ones are read
+    // from global memory
     unsigned int available_bytes = max_extra_bytes;
-    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+    for (unsigned int i = 0; i < num_types; ++i)
+        {
+        unsigned int cur_type = d_type_cache_order ? d_type_cache_order[i] : i;
         s_params[cur_type].load_shared(s_extra, available_bytes);
+        }
     __syncthreads();
 
     if (master && group == 0)
@@ -196,7 +203,8 @@ __launch_bounds__(max_threads)
     if (active)
         {
         excell_size = d_excell_size[my_cell];
-        overlap_checks += excell_size;
+        if (count_overlap_checks)
+            overlap_checks += excell_size;
         }
 
     // loop while still searching
@@ -257,7 +265,9 @@ __launch_bounds__(max_threads)
                 vec3<Scalar> r_ij = pos_j - pos_i;
                 r_ij = box.minImage(r_ij);
 
+                // only queue the type pairs that this launch checks
                 if (idx != j && (old || j < N_local)
+                    && s_check_overlaps[overlap_idx(s_type_group[group], type_j)]
                     && check_circumsphere_overlap(r_ij, shape_i, shape_j))
                     {
                     // add this particle to the queue
@@ -443,11 +453,16 @@ void narrow_phase_launcher(const hpmc_args_t& args,
             = static_cast<unsigned int>(shared_bytes + attr.sharedSizeBytes);
         unsigned int max_extra_bytes
             = static_cast<unsigned int>(args.devprop.sharedMemPerBlock - base_shared_bytes);
+
+        // a smaller parameter cache fits more blocks on a multiprocessor
+        max_extra_bytes >>= args.param_cache_level;
+
         char* ptr = (char*)nullptr;
         unsigned int available_bytes = max_extra_bytes;
         for (unsigned int i = 0; i < args.num_types; ++i)
             {
-            params[i].allocate_shared(ptr, available_bytes);
+            unsigned int cur_type = args.d_type_cache_order ? args.d_type_cache_order[i] : i;
+            params[cur_type].allocate_shared(ptr, available_bytes);
             }
         unsigned int extra_bytes = max_extra_bytes - available_bytes;
         shared_bytes += extra_bytes;
@@ -502,10 +517,12 @@ void narrow_phase_launcher(const hpmc_args_t& args,
                                args.d_reject_in,
                                args.d_reject_out,
                                args.d_reject_out_of_cell,
+                               args.d_type_cache_order,
                                max_extra_bytes,
                                max_queue_size,
                                range.first,
-                               nwork);
+                               nwork,
+                               args.count_overlap_checks);
             }
         }
     else
@@ -19,6 +19,9 @@
 #include "hoomd/GPUPartition.cuh"
 
 #include <hip/hip_runtime.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
 
 #ifdef ENABLE_MPI
 #include "hoomd/MPIConfiguration.h"
@@ -166,8 +169,14 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
         m_tuner_moves->setPeriod(period * this->m_nselect);
         m_tuner_moves->setEnabled(enable);
 
-        m_tuner_narrow->setPeriod(chain_length * period * this->m_nselect);
-        m_tuner_narrow->setEnabled(enable);
+        m_tuner_external->setPeriod(period * this->m_nselect);
+        m_tuner_external->setEnabled(enable);
+
+        for (auto& tuner : m_tuner_narrow)
+            {
+            tuner->setPeriod(chain_length * period * this->m_nselect);
+            tuner->setEnabled(enable);
+            }
 
         if (this->m_patch)
             {
@@ -202,6 +211,9 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
 
+    //! Count the number of particle overlaps
+    virtual unsigned int countOverlaps(bool early_exit);
+
 #ifdef ENABLE_MPI
     void setNtrialCommunicator(std::shared_ptr<MPIConfiguration> mpi_conf)
         {
@@ -225,8 +237,10 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     GlobalArray<unsigned int> m_excell_size; //!< Number of particles in each expanded cell
     Index2D m_excell_list_indexer;           //!< Indexer to access elements of the excell_idx list
 
-    std::unique_ptr<Autotuner> m_tuner_moves;  //!< Autotuner for proposing moves
-    std::unique_ptr<Autotuner> m_tuner_narrow; //!< Autotuner for the narrow phase
+    std::unique_ptr<Autotuner> m_tuner_moves;    //!< Autotuner for proposing moves
+    std::unique_ptr<Autotuner> m_tuner_external; //!< Autotuner for the external field
+    //! Autotuners for the narrow phase, one per bucket of type pairs
+    std::vector<std::unique_ptr<Autotuner>> m_tuner_narrow;
     std::unique_ptr<Autotuner>
         m_tuner_update_pdata; //!< Autotuner for the update step group and block sizes
     std::unique_ptr<Autotuner> m_tuner_excell_block_size; //!< Autotuner for excell block_size
@@ -264,9 +278,10 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
 
     detail::UpdateOrderGPU m_update_order; //!< Particle update order
     GlobalArray<unsigned int> m_condition; //!< Condition of convergence check
+    GlobalArray<unsigned int> m_n_overlapping; //!< Number of overlapping particles
 
     //! For energy evaluation
-    GlobalArray<Scalar> m_additive_cutoff; //!< Per-type additive cutoffs from patch potential
+    GlobalArray<Scalar> m_r_cut_patch; //!< Patch cutoff radius per type pair
 
     GlobalArray<hpmc_counters_t> m_counters; //!< Per-device counters
     GlobalArray<hpmc_implicit_counters_t>
@@ -293,14 +308,45 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     //!< Variables for implicit depletants
     GlobalArray<Scalar> m_lambda; //!< Poisson means, per type pair
 
+    //! Maximum number of narrow phase launches that split the type pairs
+    static constexpr unsigned int max_overlap_buckets = 4;
+
+    std::vector<unsigned int> m_overlap_bucket;  //!< Bucket of each type pair
+    unsigned int m_n_overlap_buckets = 1;        //!< Number of buckets of type pairs
+    GlobalArray<unsigned int> m_overlap_buckets; //!< Interaction matrix of each bucket
+
+    //! Types ordered by their number of local particles, most frequent first
+    std::vector<unsigned int, managed_allocator<unsigned int>> m_type_cache_order;
+    bool m_type_cache_order_invalid = true; //!< True when the type frequencies may have changed
+    unsigned int m_type_cache_order_N = 0;  //!< Number of local particles at the last update
+
     //! Set up excell_list
     virtual void initializeExcellMem();
 
+    //! Group the type pairs by the cost of their overlap checks
+    void updateOverlapBuckets();
+
+    //! Order the types by their number of local particles
+    void updateTypeCacheOrder();
+
+    //! Check the overlaps of the trial moves, one launch per bucket of type pairs
+    void narrowPhase(gpu::hpmc_args_t& args, const typename Shape::param_type* params);
+
     //! Set the nominal width appropriate for looped moves
     virtual void updateCellWidth();
 
     //! Update GPU memory hints
     virtual void updateGPUAdvice();
+
+    //! Scale the local particle positions on the device
+    virtual void scaleParticlePositions(const BoxDim& old_box, const BoxDim& new_box);
+
+    //! Recount the types after the particles are sorted
+    virtual void slotSorted()
+        {
+        IntegratorHPMCMono<Shape>::slotSorted();
+        m_type_cache_order_invalid = true;
+        }
     };
 
 template<class Shape>
@@ -328,6 +374,13 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
                                       1000000,
                                       "hpmc_moves",
                                       this->m_exec_conf));
+    m_tuner_external.reset(new Autotuner(dev_prop.warpSize,
+                                         dev_prop.maxThreadsPerBlock,
+                                         dev_prop.warpSize,
+                                         5,
+                                         1000000,
+                                         "hpmc_external",
+                                         this->m_exec_conf));
     m_tuner_update_pdata.reset(new Autotuner(dev_prop.warpSize,
                                              dev_prop.maxThreadsPerBlock,
                                              dev_prop.warpSize,
@@ -357,7 +410,8 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
                                                       "hpmc_num_depletants_ntrial",
                                                       this->m_exec_conf));
 
-    // tuning parameters for narrow phase
+    // tuning parameters for narrow phase: block size, threads per particle, threads per overlap
+    // check, and the share of the free shared memory that caches nested shape parameters
     std::vector<unsigned int> valid_params;
     unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
     const unsigned int narrow_phase_max_tpp = this->m_exec_conf->dev_prop.maxThreadsDim[2];
@@ -373,13 +427,23 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
                 if (t == 1 || Shape::isParallel())
                     {
                     if ((s * t <= block_size) && ((block_size % (s * t)) == 0))
-                        valid_params.push_back(block_size * 1000000 + s * 100 + t);
+                        {
+                        for (unsigned int level = 0; level < 3; ++level)
+                            valid_params.push_back(block_size * 1000000 + level * 10000 + s * 100
+                                                   + t);
+                        }
                     }
                 }
             }
         }
 
-    m_tuner_narrow.reset(new Autotuner(valid_params, 5, 100000, "hpmc_narrow", this->m_exec_conf));
+    // each bucket of type pairs tunes its own launch configuration
+    for (unsigned int bucket = 0; bucket < max_overlap_buckets; ++bucket)
+        {
+        std::string name = bucket == 0 ? "hpmc_narrow" : "hpmc_narrow_" + std::to_string(bucket);
+        m_tuner_narrow.emplace_back(
+            new Autotuner(valid_params, 5, 100000, name, this->m_exec_conf));
+        }
 
     m_tuner_convergence.reset(new Autotuner(dev_prop.warpSize,
                                             dev_prop.maxThreadsPerBlock,
@@ -451,6 +515,9 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_condition);
     TAG_ALLOCATION(m_condition);
 
+    GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_n_overlapping);
+    TAG_ALLOCATION(m_n_overlapping);
+
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_req_len);
     TAG_ALLOCATION(m_req_len);
 
@@ -635,8 +702,9 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
 #endif
 
     // patch
-    GlobalArray<Scalar>(this->m_pdata->getNTypes(), this->m_exec_conf).swap(m_additive_cutoff);
-    TAG_ALLOCATION(m_additive_cutoff);
+    GlobalArray<Scalar>(this->m_overlap_idx.getNumElements(), this->m_exec_conf)
+        .swap(m_r_cut_patch);
+    TAG_ALLOCATION(m_r_cut_patch);
     }
 
 template<class Shape> IntegratorHPMCMonoGPU<Shape>::~IntegratorHPMCMonoGPU()
@@ -837,17 +905,28 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
     {
     IntegratorHPMC::update(timestep);
 
+    // the GPU accepts the trial moves of neighboring particles concurrently and does not sum their
+    // energy changes, so computePatchEnergy() recomputes the total
+    this->invalidatePatchEnergy();
+
     if (this->m_patch)
         {
-        ArrayHandle<Scalar> h_additive_cutoff(m_additive_cutoff,
-                                              access_location::host,
-                                              access_mode::overwrite);
+        ArrayHandle<Scalar> h_r_cut_patch(m_r_cut_patch,
+                                          access_location::host,
+                                          access_mode::overwrite);
         for (unsigned int itype = 0; itype < this->m_pdata->getNTypes(); ++itype)
             {
-            h_additive_cutoff.data[itype] = this->m_patch->getAdditiveCutoff(itype);
+            for (unsigned int jtype = 0; jtype < this->m_pdata->getNTypes(); ++jtype)
+                {
+                h_r_cut_patch.data[this->m_overlap_idx(itype, jtype)]
+                    = this->m_patch->getRCutPair(itype, jtype);
+                }
             }
         }
 
+    updateOverlapBuckets();
+    updateTypeCacheOrder();
+
     // rng for shuffle and grid shift
     hoomd::RandomGenerator rng(
         hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoShift, timestep, this->m_sysdef->getSeed()),
@@ -1201,6 +1280,39 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                 if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
                     CHECK_CUDA_ERROR();
                 m_tuner_moves->end();
+
+                // reject trial moves in the external field a priori
+                if (this->m_external)
+                    {
+                    ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                                   access_location::device,
+                                                   access_mode::read);
+
+                    m_tuner_external->begin();
+                    gpu::hpmc_external_args_t external_args(d_postype.data,
+                                                            d_orientation.data,
+                                                            d_trial_postype.data,
+                                                            d_trial_orientation.data,
+                                                            d_trial_move_type.data,
+                                                            d_tag.data,
+                                                            d_reject_out_of_cell.data,
+                                                            this->m_pdata->getGlobalBox(),
+                                                            this->m_pdata->getOrigin(),
+                                                            this->m_sysdef->getSeed(),
+                                                            this->m_exec_conf->getRank(),
+                                                            timestep,
+                                                            i,
+                                                            m_tuner_external->getParam(),
+                                                            this->m_pdata->getGPUPartition());
+                    if (!this->m_external->rejectTrialMovesGPU(external_args, params.data()))
+                        {
+                        throw std::runtime_error(
+                            "This external field is not implemented on the GPU for this shape.");
+                        }
+                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                        CHECK_CUDA_ERROR();
+                    m_tuner_external->end();
+                    }
                 }
 
             bool converged = false;
@@ -1425,15 +1537,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
 
                     this->m_exec_conf->beginMultiGPU();
 
-                    m_tuner_narrow->begin();
-                    unsigned int param = m_tuner_narrow->getParam();
-                    args.block_size = param / 1000000;
-                    args.tpp = (param % 1000000) / 100;
-                    args.overlap_threads = param % 100;
-                    gpu::hpmc_narrow_phase<Shape>(args, params.data());
-                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-                        CHECK_CUDA_ERROR();
-                    m_tuner_narrow->end();
+                    narrowPhase(args, params.data());
 
                     /*
                      * Insert depletants
@@ -1515,11 +1619,31 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                     depletants_per_thread,
                                     &m_depletant_streams[this->m_depletant_idx(itype, jtype)]
                                          .front());
-                                gpu::hpmc_insert_depletants<Shape>(args,
-                                                                   implicit_args,
-                                                                   params.data());
-                                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-                                    CHECK_CUDA_ERROR();
+
+                                // insert the depletants in batches to bound the size of the grid
+                                unsigned int max_n_depletants_all = 0;
+                                for (unsigned int idev = 0;
+                                     idev < this->m_exec_conf->getNumActiveGPUs();
+                                     ++idev)
+                                    {
+                                    max_n_depletants_all
+                                        = std::max(max_n_depletants_all, max_n_depletants[idev]);
+                                    }
+                                if (this->m_depletant_batch_size)
+                                    implicit_args.depletant_batch_size
+                                        = this->m_depletant_batch_size;
+
+                                do
+                                    {
+                                    gpu::hpmc_insert_depletants<Shape>(args,
+                                                                       implicit_args,
+                                                                       params.data());
+                                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                                        CHECK_CUDA_ERROR();
+                                    implicit_args.depletant_offset
+                                        += std::min(implicit_args.depletant_batch_size,
+                                                    max_n_depletants_all);
+                                    } while (implicit_args.depletant_offset < max_n_depletants_all);
                                 m_tuner_depletants->end();
                                 }
                             else
@@ -1637,54 +1761,91 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                     }
 #endif
 
-                                gpu::hpmc_auxilliary_args_t auxilliary_args(
-                                    d_tag.data,
-                                    d_vel.data,
-                                    d_trial_vel.data,
-                                    ntrial,
-                                    &nwork_rank[0],
-                                    &work_offset[0],
-                                    d_n_depletants_ntrial.data + ntrial_offset,
-                                    d_deltaF_int.data
-                                        + this->m_depletant_idx(itype, jtype)
-                                              * this->m_pdata->getMaxN(),
-                                    &m_depletant_streams_phase1[this->m_depletant_idx(itype, jtype)]
-                                         .front(),
-                                    &m_depletant_streams_phase2[this->m_depletant_idx(itype, jtype)]
-                                         .front(),
-                                    m_max_len,
-                                    d_req_len.data,
-                                    particle_comm_rank == particle_comm_size - 1,
-                                    this->m_pdata->getNGhosts(),
-                                    gpu_partition_rank);
+                                // process the insertions in batches to bound the size of the
+                                // grid, the free energy accumulates over the batches
+                                unsigned int max_nwork = 0;
+                                for (unsigned int idev = 0;
+                                     idev < this->m_exec_conf->getNumActiveGPUs();
+                                     ++idev)
+                                    {
+                                    max_nwork = std::max(max_nwork, nwork_rank[idev]);
+                                    }
+                                unsigned int batch_size = this->m_depletant_batch_size
+                                                              ? this->m_depletant_batch_size
+                                                              : std::max(max_nwork, 1u);
+
+                                unsigned int nwork_batch[this->m_exec_conf->getNumActiveGPUs()];
+                                unsigned int work_offset_batch[this->m_exec_conf
+                                                                   ->getNumActiveGPUs()];
+                                unsigned int batch_offset = 0;
+                                do
+                                    {
+                                    for (unsigned int idev = 0;
+                                         idev < this->m_exec_conf->getNumActiveGPUs();
+                                         ++idev)
+                                        {
+                                        nwork_batch[idev]
+                                            = nwork_rank[idev]
+                                              - std::min(nwork_rank[idev], batch_offset);
+                                        nwork_batch[idev] = std::min(nwork_batch[idev], batch_size);
+                                        work_offset_batch[idev] = work_offset[idev] + batch_offset;
+                                        }
 
-                                // phase 1, insert into excluded volume of particle i
-                                m_tuner_depletants_phase1->begin();
-                                unsigned int param = m_tuner_depletants_phase1->getParam();
-                                args.block_size = param / 1000000;
-                                implicit_args.depletants_per_thread = (param % 1000000) / 10000;
-                                args.tpp = param % 10000;
-                                gpu::hpmc_depletants_auxilliary_phase1<Shape>(args,
-                                                                              implicit_args,
-                                                                              auxilliary_args,
-                                                                              params.data());
-                                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-                                    CHECK_CUDA_ERROR();
-                                m_tuner_depletants_phase1->end();
+                                    gpu::hpmc_auxilliary_args_t auxilliary_args(
+                                        d_tag.data,
+                                        d_vel.data,
+                                        d_trial_vel.data,
+                                        ntrial,
+                                        &nwork_batch[0],
+                                        &work_offset_batch[0],
+                                        d_n_depletants_ntrial.data + ntrial_offset,
+                                        d_deltaF_int.data
+                                            + this->m_depletant_idx(itype, jtype)
+                                                  * this->m_pdata->getMaxN(),
+                                        &m_depletant_streams_phase1[this->m_depletant_idx(itype,
+                                                                                          jtype)]
+                                             .front(),
+                                        &m_depletant_streams_phase2[this->m_depletant_idx(itype,
+                                                                                          jtype)]
+                                             .front(),
+                                        m_max_len,
+                                        d_req_len.data,
+                                        particle_comm_rank == particle_comm_size - 1,
+                                        this->m_pdata->getNGhosts(),
+                                        gpu_partition_rank);
+
+                                    // phase 1, insert into excluded volume of particle i
+                                    m_tuner_depletants_phase1->begin();
+                                    unsigned int param = m_tuner_depletants_phase1->getParam();
+                                    args.block_size = param / 1000000;
+                                    implicit_args.depletants_per_thread
+                                        = (param % 1000000) / 10000;
+                                    args.tpp = param % 10000;
+                                    gpu::hpmc_depletants_auxilliary_phase1<Shape>(args,
+                                                                                  implicit_args,
+                                                                                  auxilliary_args,
+                                                                                  params.data());
+                                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                                        CHECK_CUDA_ERROR();
+                                    m_tuner_depletants_phase1->end();
+
+                                    // phase 2, reinsert into excluded volume of i's neighbors
+                                    m_tuner_depletants_phase2->begin();
+                                    param = m_tuner_depletants_phase2->getParam();
+                                    args.block_size = param / 1000000;
+                                    implicit_args.depletants_per_thread
+                                        = (param % 1000000) / 10000;
+                                    args.tpp = param % 10000;
+                                    gpu::hpmc_depletants_auxilliary_phase2<Shape>(args,
+                                                                                  implicit_args,
+                                                                                  auxilliary_args,
+                                                                                  params.data());
+                                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                                        CHECK_CUDA_ERROR();
+                                    m_tuner_depletants_phase2->end();
 
-                                // phase 2, reinsert into excluded volume of i's neighbors
-                                m_tuner_depletants_phase2->begin();
-                                param = m_tuner_depletants_phase2->getParam();
-                                args.block_size = param / 1000000;
-                                implicit_args.depletants_per_thread = (param % 1000000) / 10000;
-                                args.tpp = param % 10000;
-                                gpu::hpmc_depletants_auxilliary_phase2<Shape>(args,
-                                                                              implicit_args,
-                                                                              auxilliary_args,
-                                                                              params.data());
-                                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-                                    CHECK_CUDA_ERROR();
-                                m_tuner_depletants_phase2->end();
+                                    batch_offset += batch_size;
+                                    } while (batch_offset < max_nwork);
 
                                 // wait for worker streams to complete
                                 for (int idev = (int)gpu_map.size() - 1; idev >= 0; --idev)
@@ -1880,9 +2041,9 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                     ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(),
                                                    access_location::device,
                                                    access_mode::read);
-                    ArrayHandle<Scalar> d_additive_cutoff(m_additive_cutoff,
-                                                          access_location::device,
-                                                          access_mode::read);
+                    ArrayHandle<Scalar> d_r_cut_patch(m_r_cut_patch,
+                                                      access_location::device,
+                                                      access_mode::read);
 
                     /*
                      *  evaluate energy of old and new configuration simultaneously against the old
@@ -1920,8 +2081,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                                        d_excell_idx.data,
                                                        d_excell_size.data,
                                                        m_excell_list_indexer,
-                                                       this->m_patch->getRCut(),
-                                                       d_additive_cutoff.data,
+                                                       d_r_cut_patch.data,
                                                        d_update_order_by_ptl.data,
                                                        d_reject.data,
                                                        d_reject_out.data,
@@ -2017,6 +2177,11 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                                    access_location::device,
                                                    access_mode::read);
 
+                // counters by type, only recorded for the move size adjustments
+                ArrayHandle<hpmc_counters_t> d_count_type(this->m_count_type,
+                                                          access_location::device,
+                                                          access_mode::readwrite);
+
                 // Update the particle data and statistics
                 this->m_exec_conf->beginMultiGPU();
                 m_tuner_update_pdata->begin();
@@ -2026,6 +2191,8 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                              ngpu > 1 ? d_counters_per_device.data
                                                       : d_counters.data,
                                              (unsigned int)this->m_counters.getPitch(),
+                                             this->m_move_size_trigger ? d_count_type.data
+                                                                       : nullptr,
                                              this->m_pdata->getGPUPartition(),
                                              have_auxilliary_variables,
                                              d_trial_postype.data,
@@ -2070,6 +2237,13 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
             }
         }
 
+    // shift the domains and exchange the ghosts at the period of the exchange
+    bool exchange = true;
+#ifdef ENABLE_MPI
+    if (this->m_sysdef->isDomainDecomposed())
+        exchange = this->isExchangeStep();
+#endif
+
     // shift particles
     Scalar3 shift = make_scalar3(0, 0, 0);
     hoomd::UniformDistribution<Scalar> uniform(-this->m_nominal_width / Scalar(2.0),
@@ -2081,7 +2255,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
         shift.z = uniform(rng);
         }
 
-    if (this->m_pdata->getN() > 0)
+    if (exchange && this->m_pdata->getN() > 0)
         {
         BoxDim box = this->m_pdata->getBox();
 
@@ -2101,13 +2275,20 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
 
-    // update the particle data origin
-    this->m_pdata->translateOrigin(shift);
-
     if (this->m_prof)
         this->m_prof->pop(this->m_exec_conf);
 
-    this->communicate(true);
+    if (exchange)
+        {
+        // update the particle data origin
+        this->m_pdata->translateOrigin(shift);
+
+        this->communicate(true);
+        }
+    else
+        {
+        this->m_ghosts_stale = true;
+        }
 
     // all particle have been moved, the aabb tree is now invalid
     this->m_aabb_tree_invalid = true;
@@ -2118,6 +2299,476 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
     this->m_mps = double(run_counters.getNMoves()) / cur_time;
     }
 
+/*! \param early_exit exit at first overlap found if true
+    \returns number of overlaps if early_exit=false, 1 if early_exit=true
+
+    With early_exit, the overlaps of the current configuration are checked on the device with the
+    narrow phase kernel of the trial moves: every particle is tested in place against the cell list
+    and the particles with an overlap are counted. Exact pair counts are computed on the host.
+*/
+template<class Shape> unsigned int IntegratorHPMCMonoGPU<Shape>::countOverlaps(bool early_exit)
+    {
+    this->refreshStaleGhosts();
+
+    if (!early_exit)
+        return IntegratorHPMCMono<Shape>::countOverlaps(early_exit);
+
+    // the expanded cells require the minimum image convention, as in update()
+    const BoxDim global_box = this->m_pdata->getGlobalBox();
+    Scalar3 nearest_plane_distance = global_box.getNearestPlaneDistance();
+    if ((global_box.getPeriodic().x && nearest_plane_distance.x <= this->m_nominal_width * 2)
+        || (global_box.getPeriodic().y && nearest_plane_distance.y <= this->m_nominal_width * 2)
+        || (this->m_sysdef->getNDimensions() == 3 && global_box.getPeriodic().z
+            && nearest_plane_distance.z <= this->m_nominal_width * 2))
+        {
+        return IntegratorHPMCMono<Shape>::countOverlaps(early_exit);
+        }
+
+    updateOverlapBuckets();
+    updateTypeCacheOrder();
+
+    unsigned int n_overlapping = 0;
+
+    if (this->m_pdata->getN() > 0)
+        {
+        // the particles may have moved without advancing the time step
+        this->m_cl->forceCompute(0);
+
+        if (this->m_prof)
+            this->m_prof->push(this->m_exec_conf, "HPMC count overlaps");
+
+        uint3 cur_dim = this->m_cl->getDim();
+        if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z
+            || m_last_nmax != this->m_cl->getNmax())
+            {
+            initializeExcellMem();
+
+            m_last_dim = cur_dim;
+            m_last_nmax = this->m_cl->getNmax();
+            }
+
+        if (m_reject.getNumElements() < this->m_pdata->getMaxN())
+            {
+            m_reject.resize(this->m_pdata->getMaxN());
+            m_reject_out_of_cell.resize(this->m_pdata->getMaxN());
+            m_reject_out.resize(this->m_pdata->getMaxN());
+            m_trial_postype.resize(this->m_pdata->getMaxN());
+            m_trial_orientation.resize(this->m_pdata->getMaxN());
+            m_trial_vel.resize(this->m_pdata->getMaxN());
+            m_trial_move_type.resize(this->m_pdata->getMaxN());
+
+            updateGPUAdvice();
+            }
+
+        m_update_order.resize(this->m_pdata->getN());
+
+            { // ArrayHandle scope
+            ArrayHandle<unsigned int> d_cell_size(this->m_cl->getCellSizeArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+            ArrayHandle<unsigned int> d_cell_idx(this->m_cl->getIndexArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<unsigned int> d_cell_adj(this->m_cl->getCellAdjArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+
+            const ArrayHandle<unsigned int>& d_cell_size_per_device
+                = m_cl->getPerDevice()
+                      ? ArrayHandle<unsigned int>(m_cl->getCellSizeArrayPerDevice(),
+                                                  access_location::device,
+                                                  access_mode::read)
+                      : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                                  access_location::device,
+                                                  access_mode::read);
+            const ArrayHandle<unsigned int>& d_cell_idx_per_device
+                = m_cl->getPerDevice()
+                      ? ArrayHandle<unsigned int>(m_cl->getIndexArrayPerDevice(),
+                                                  access_location::device,
+                                                  access_mode::read)
+                      : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                                  access_location::device,
+                                                  access_mode::read);
+
+            ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
+            ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+
+            this->m_tuner_excell_block_size->begin();
+            gpu::hpmc_excell(d_excell_idx.data,
+                             d_excell_size.data,
+                             m_excell_list_indexer,
+                             m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
+                             m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
+                             d_cell_adj.data,
+                             this->m_cl->getCellIndexer(),
+                             this->m_cl->getCellListIndexer(),
+                             this->m_cl->getCellAdjIndexer(),
+                             this->m_exec_conf->getNumActiveGPUs(),
+                             this->m_tuner_excell_block_size->getParam());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            this->m_tuner_excell_block_size->end();
+
+            ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                               access_location::device,
+                                               access_mode::read);
+            ArrayHandle<Scalar4> d_vel(this->m_pdata->getVelocities(),
+                                       access_location::device,
+                                       access_mode::read);
+
+            ArrayHandle<unsigned int> d_update_order_by_ptl(m_update_order.get(),
+                                                            access_location::device,
+                                                            access_mode::read);
+            ArrayHandle<unsigned int> d_reject_out_of_cell(m_reject_out_of_cell,
+                                                           access_location::device,
+                                                           access_mode::overwrite);
+            ArrayHandle<unsigned int> d_reject(m_reject,
+                                               access_location::device,
+                                               access_mode::overwrite);
+            ArrayHandle<unsigned int> d_reject_out(m_reject_out,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
+            ArrayHandle<Scalar4> d_trial_postype(m_trial_postype,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<Scalar4> d_trial_orientation(m_trial_orientation,
+                                                     access_location::device,
+                                                     access_mode::overwrite);
+            ArrayHandle<Scalar4> d_trial_vel(m_trial_vel,
+                                             access_location::device,
+                                             access_mode::overwrite);
+            ArrayHandle<unsigned int> d_trial_move_type(m_trial_move_type,
+                                                        access_location::device,
+                                                        access_mode::overwrite);
+            ArrayHandle<unsigned int> d_n_overlapping(m_n_overlapping,
+                                                      access_location::device,
+                                                      access_mode::overwrite);
+
+            // test every particle in place: no particle is moved, and none is rejected a priori
+            this->m_exec_conf->beginMultiGPU();
+            for (int idev = this->m_exec_conf->getNumActiveGPUs() - 1; idev >= 0; --idev)
+                {
+                hipSetDevice(this->m_exec_conf->getGPUIds()[idev]);
+
+                auto range = this->m_pdata->getGPUPartition().getRange(idev);
+                unsigned int nelem = range.second - range.first;
+                if (nelem != 0)
+                    {
+                    hipMemcpyAsync(d_trial_postype.data + range.first,
+                                   d_postype.data + range.first,
+                                   sizeof(Scalar4) * nelem,
+                                   hipMemcpyDeviceToDevice);
+                    hipMemcpyAsync(d_trial_orientation.data + range.first,
+                                   d_orientation.data + range.first,
+                                   sizeof(Scalar4) * nelem,
+                                   hipMemcpyDeviceToDevice);
+                    hipMemsetAsync(d_trial_move_type.data + range.first,
+                                   0,
+                                   sizeof(unsigned int) * nelem);
+                    hipMemsetAsync(d_reject_out_of_cell.data + range.first,
+                                   0,
+                                   sizeof(unsigned int) * nelem);
+                    hipMemsetAsync(d_reject.data + range.first, 0, sizeof(unsigned int) * nelem);
+                    hipMemsetAsync(d_reject_out.data + range.first,
+                                   0,
+                                   sizeof(unsigned int) * nelem);
+                    }
+                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
+            this->m_exec_conf->endMultiGPU();
+
+            hipMemset(d_n_overlapping.data, 0, sizeof(unsigned int));
+
+                {
+                auto& params = this->getParams();
+
+                ArrayHandle<unsigned int> d_overlaps(this->m_overlaps,
+                                                     access_location::device,
+                                                     access_mode::read);
+                ArrayHandle<Scalar> d_d(this->m_d, access_location::device, access_mode::read);
+                ArrayHandle<Scalar> d_a(this->m_a, access_location::device, access_mode::read);
+
+                // the per-device counters are reset before they are used by update(), so the
+                // overlap checks counted here do not enter the move statistics
+                ArrayHandle<hpmc_counters_t> d_counters_per_device(this->m_counters,
+                                                                   access_location::device,
+                                                                   access_mode::readwrite);
+
+                bool domain_decomposition = false;
+#ifdef ENABLE_MPI
+                if (this->m_sysdef->isDomainDecomposed())
+                    domain_decomposition = true;
+#endif
+
+                BoxDim box = this->m_pdata->getBox();
+                Scalar3 ghost_width = this->m_cl->getGhostWidth();
+                Scalar3 ghost_fraction = this->m_nominal_width / box.getNearestPlaneDistance();
+
+                gpu::hpmc_args_t args(d_postype.data,
+                                      d_orientation.data,
+                                      d_vel.data,
+                                      d_counters_per_device.data,
+                                      (unsigned int)this->m_counters.getPitch(),
+                                      this->m_cl->getCellIndexer(),
+                                      this->m_cl->getDim(),
+                                      ghost_width,
+                                      this->m_pdata->getN(),
+                                      this->m_pdata->getNTypes(),
+                                      this->m_sysdef->getSeed(),
+                                      this->m_exec_conf->getRank(),
+                                      d_d.data,
+                                      d_a.data,
+                                      d_overlaps.data,
+                                      this->m_overlap_idx,
+                                      this->m_translation_move_probability,
+                                      0,
+                                      this->m_sysdef->getNDimensions(),
+                                      box,
+                                      0,
+                                      ghost_fraction,
+                                      domain_decomposition,
+                                      0, // block size
+                                      0, // tpp
+                                      0, // overlap threads
+                                      false,
+                                      d_reject_out_of_cell.data,
+                                      d_trial_postype.data,
+                                      d_trial_orientation.data,
+                                      d_trial_vel.data,
+                                      d_trial_move_type.data,
+                                      d_update_order_by_ptl.data,
+                                      d_excell_idx.data,
+                                      d_excell_size.data,
+                                      m_excell_list_indexer,
+                                      d_reject.data,
+                                      d_reject_out.data,
+                                      this->m_exec_conf->dev_prop,
+                                      this->m_pdata->getGPUPartition(),
+                                      &m_narrow_phase_streams.front());
+
+                this->m_exec_conf->beginMultiGPU();
+                narrowPhase(args, params.data());
+                this->m_exec_conf->endMultiGPU();
+                }
+
+            this->m_exec_conf->beginMultiGPU();
+            gpu::hpmc_count_rejected(d_reject_out.data,
+                                     d_n_overlapping.data,
+                                     this->m_pdata->getGPUPartition(),
+                                     128);
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            this->m_exec_conf->endMultiGPU();
+            } // end ArrayHandle scope
+
+        ArrayHandle<unsigned int> h_n_overlapping(m_n_overlapping,
+                                                  access_location::host,
+                                                  access_mode::read);
+        n_overlapping = *h_n_overlapping.data;
+
+        if (this->m_prof)
+            this->m_prof->pop(this->m_exec_conf);
+        }
+
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &n_overlapping,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      this->m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return n_overlapping > 0 ? 1 : 0;
+    }
+
+/*! The cost of a type pair is estimated from the size of the shape parameters of both types,
+    including the nested arrays that the kernels load (vertices, union members, ...). Pairs whose
+    costs differ by less than a factor of four share a bucket. When the shapes of a mixture differ
+    greatly in complexity, the narrow phase checks each bucket in a separate launch so that the
+    threads of a warp perform checks of similar cost.
+*/
+template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateOverlapBuckets()
+    {
+    const unsigned int ntypes = this->m_pdata->getNTypes();
+    const unsigned int n_pairs = this->m_overlap_idx.getNumElements();
+    auto& params = this->getParams();
+
+    std::vector<unsigned int> type_cost(ntypes);
+    for (unsigned int itype = 0; itype < ntypes; ++itype)
+        {
+        char* ptr = nullptr;
+        unsigned int available_bytes = std::numeric_limits<unsigned int>::max();
+        params[itype].allocate_shared(ptr, available_bytes);
+        type_cost[itype] = static_cast<unsigned int>(sizeof(typename Shape::param_type))
+                           + (std::numeric_limits<unsigned int>::max() - available_bytes);
+        }
+
+    ArrayHandle<unsigned int> h_overlaps(this->m_overlaps,
+                                         access_location::host,
+                                         access_mode::read);
+
+    unsigned int min_cost = std::numeric_limits<unsigned int>::max();
+    for (unsigned int itype = 0; itype < ntypes; ++itype)
+        for (unsigned int jtype = 0; jtype < ntypes; ++jtype)
+            if (h_overlaps.data[this->m_overlap_idx(itype, jtype)])
+                min_cost = std::min(min_cost, type_cost[itype] + type_cost[jtype]);
+
+    // bucket by factors of four of the cost, then drop the empty buckets
+    std::vector<unsigned int> bucket(n_pairs, 0);
+    std::vector<unsigned int> bucket_used(max_overlap_buckets, 0);
+    for (unsigned int itype = 0; itype < ntypes; ++itype)
+        {
+        for (unsigned int jtype = 0; jtype < ntypes; ++jtype)
+            {
+            unsigned int pair = this->m_overlap_idx(itype, jtype);
+            if (!h_overlaps.data[pair])
+                continue;
+
+            unsigned int ratio = (type_cost[itype] + type_cost[jtype]) / min_cost;
+            while (ratio >= 4 && bucket[pair] + 1 < max_overlap_buckets)
+                {
+                ratio /= 4;
+                bucket[pair]++;
+                }
+            bucket_used[bucket[pair]] = 1;
+            }
+        }
+
+    std::vector<unsigned int> compact(max_overlap_buckets, 0);
+    unsigned int n_buckets = 0;
+    for (unsigned int b = 0; b < max_overlap_buckets; ++b)
+        {
+        compact[b] = n_buckets;
+        n_buckets += bucket_used[b];
+        }
+    for (unsigned int pair = 0; pair < n_pairs; ++pair)
+        bucket[pair] = compact[bucket[pair]];
+    n_buckets = std::max(n_buckets, 1u);
+
+    if (n_buckets == m_n_overlap_buckets && bucket == m_overlap_bucket)
+        return;
+
+    m_overlap_bucket = bucket;
+    m_n_overlap_buckets = n_buckets;
+    if (n_buckets == 1)
+        return;
+
+    if (m_overlap_buckets.getNumElements() < n_buckets * n_pairs)
+        {
+        GlobalArray<unsigned int> overlap_buckets(n_buckets * n_pairs, this->m_exec_conf);
+        m_overlap_buckets.swap(overlap_buckets);
+        TAG_ALLOCATION(m_overlap_buckets);
+        }
+
+    ArrayHandle<unsigned int> h_overlap_buckets(m_overlap_buckets,
+                                                access_location::host,
+                                                access_mode::overwrite);
+    for (unsigned int b = 0; b < n_buckets; ++b)
+        for (unsigned int pair = 0; pair < n_pairs; ++pair)
+            h_overlap_buckets.data[b * n_pairs + pair] = h_overlaps.data[pair] && bucket[pair] == b;
+    }
+
+/*! \param args Kernel arguments with the interaction matrix of all type pairs
+    \param params Shape parameters per type
+
+    The buckets run cheapest first on the same stream. The later launches read the reject flags of
+    the earlier ones, and skip the trial moves that are already rejected.
+*/
+template<class Shape>
+void IntegratorHPMCMonoGPU<Shape>::narrowPhase(gpu::hpmc_args_t& args,
+                                               const typename Shape::param_type* params)
+    {
+    ArrayHandle<unsigned int> d_overlap_buckets(m_overlap_buckets,
+                                                access_location::device,
+                                                access_mode::read);
+    const unsigned int* d_overlaps = args.d_check_overlaps;
+    const unsigned int n_pairs = this->m_overlap_idx.getNumElements();
+    args.d_type_cache_order = m_type_cache_order.data();
+
+    for (unsigned int bucket = 0; bucket < m_n_overlap_buckets; ++bucket)
+        {
+        if (m_n_overlap_buckets > 1)
+            args.d_check_overlaps = d_overlap_buckets.data + bucket * n_pairs;
+        args.count_overlap_checks = bucket == 0;
+
+        m_tuner_narrow[bucket]->begin();
+        unsigned int param = m_tuner_narrow[bucket]->getParam();
+        args.block_size = param / 1000000;
+        args.param_cache_level = (param % 1000000) / 10000;
+        args.tpp = (param % 10000) / 100;
+        args.overlap_threads = param % 100;
+        gpu::hpmc_narrow_phase<Shape>(args, params);
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_narrow[bucket]->end();
+        }
+
+    args.d_check_overlaps = d_overlaps;
+    args.count_overlap_checks = true;
+    }
+
+/*! The narrow phase caches the nested shape parameters (e.g. vertices and OBB trees) in the shared
+    memory left over by its launch configuration. Types that do not fit stay in global memory and
+    are read through the L1 cache. Caching the most frequent types first keeps most of the checks
+    in shared memory when a mixture of complex shapes does not fit.
+
+    Counting the types reads the particle positions on the host, so the order is only updated after
+    the particles are sorted or when the number of particles changes.
+*/
+template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateTypeCacheOrder()
+    {
+    const unsigned int ntypes = this->m_pdata->getNTypes();
+    const unsigned int N = this->m_pdata->getN();
+    if (!m_type_cache_order_invalid && m_type_cache_order.size() == ntypes
+        && m_type_cache_order_N == N)
+        return;
+
+    std::vector<unsigned int> count(ntypes, 0);
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        for (unsigned int i = 0; i < N; ++i)
+            count[__scalar_as_int(h_postype.data[i].w)]++;
+        }
+
+    std::vector<unsigned int> order(ntypes);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&count](unsigned int a, unsigned int b) { return count[a] > count[b]; });
+
+    // the device is idle after reading the positions, so the managed memory can be written
+    m_type_cache_order.assign(order.begin(), order.end());
+    m_type_cache_order_invalid = false;
+    m_type_cache_order_N = N;
+    }
+
+template<class Shape>
+void IntegratorHPMCMonoGPU<Shape>::scaleParticlePositions(const BoxDim& old_box,
+                                                          const BoxDim& new_box)
+    {
+    ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+
+    gpu::hpmc_scale_positions(d_postype.data, this->m_pdata->getN(), old_box, new_box, 128);
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 template<class Shape> void IntegratorHPMCMonoGPU<Shape>::initializeExcellMem()
     {
     this->m_exec_conf->msg->notice(4) << "hpmc resizing expanded cells" << std::endl;
@@ -79,7 +79,9 @@ __launch_bounds__(max_threads)
                                            bool repulsive,
                                            unsigned int work_offset,
                                            unsigned int max_depletant_queue_size,
-                                           const unsigned int* d_n_depletants)
+                                           const unsigned int* d_n_depletants,
+                                           const unsigned int depletant_offset,
+                                           const unsigned int depletant_batch_size)
     {
     // variables to tell what type of thread we are
     unsigned int group = threadIdx.z;
@@ -198,6 +200,11 @@ __launch_bounds__(max_threads)
     // generate random number of depletants from Poisson distribution
     unsigned int n_depletants = d_n_depletants[i];
 
+    // this launch inserts the depletants [depletant_offset, depletant_end)
+    unsigned int depletant_end = depletant_offset
+                                 + min(n_depletants - min(n_depletants, depletant_offset),
+                                       depletant_batch_size);
+
     unsigned int overlap_checks = 0;
 
     // find the cell this particle should be in
@@ -239,11 +246,12 @@ __launch_bounds__(max_threads)
 
     unsigned int gidx = gridDim.y * blockIdx.z + blockIdx.y;
     unsigned int blocks_per_particle = gridDim.y * gridDim.z;
-    unsigned int i_dep = group_size * group + offset + gidx * group_size * n_groups;
+    unsigned int i_dep
+        = depletant_offset + group_size * group + offset + gidx * group_size * n_groups;
 
     while (s_adding_depletants)
         {
-        while (s_depletant_queue_size < max_depletant_queue_size && i_dep < n_depletants
+        while (s_depletant_queue_size < max_depletant_queue_size && i_dep < depletant_end
                && !s_reject)
             {
             // one RNG per depletant
@@ -329,7 +337,7 @@ __launch_bounds__(max_threads)
 
             // advance depletant idx
             i_dep += group_size * n_groups * blocks_per_particle;
-            } // end while (s_depletant_queue_size < max_depletant_queue_size && i_dep < n_depletants)
+            } // end while (s_depletant_queue_size < max_depletant_queue_size && i_dep < end)
 
         __syncthreads();
 
@@ -614,7 +622,7 @@ __launch_bounds__(max_threads)
         __syncthreads();
         if (master && group == 0)
             s_depletant_queue_size = 0;
-        if (i_dep < n_depletants && !s_reject)
+        if (i_dep < depletant_end && !s_reject)
             atomicAdd(&s_adding_depletants, 1);
         __syncthreads();
         } // end loop over depletants
@@ -647,7 +655,7 @@ __launch_bounds__(max_threads)
 
         Shape shape_i(quat<Scalar>(quat<Scalar>()), s_params[s_type_i]);
         bool ignore_stats = shape_i.ignoreStatistics();
-        if (!ignore_stats && blockIdx.y == 0 && blockIdx.z == 0)
+        if (!ignore_stats && blockIdx.y == 0 && blockIdx.z == 0 && depletant_offset == 0)
             {
 // increment number of inserted depletants
 #if (__CUDA_ARCH__ >= 600)
@@ -753,10 +761,18 @@ void depletants_launcher(const hpmc_args_t& args,
             if (range.first == range.second)
                 continue;
 
+            // number of depletants per particle in this batch
+            unsigned int max_n_depletants = implicit_args.max_n_depletants[idev];
+            unsigned int n_batch
+                = max_n_depletants - std::min(max_n_depletants, implicit_args.depletant_offset);
+            n_batch = std::min(n_batch, implicit_args.depletant_batch_size);
+
+            // later batches have no work on this device
+            if (n_batch == 0 && implicit_args.depletant_offset > 0)
+                continue;
+
             unsigned int blocks_per_particle
-                = implicit_args.max_n_depletants[idev]
-                      / (implicit_args.depletants_per_thread * n_groups * tpp)
-                  + 1;
+                = n_batch / (implicit_args.depletants_per_thread * n_groups * tpp) + 1;
 
             dim3 grid(range.second - range.first, blocks_per_particle, 1);
 
@@ -825,7 +841,9 @@ void depletants_launcher(const hpmc_args_t& args,
                 implicit_args.repulsive,
                 range.first,
                 max_depletant_queue_size,
-                implicit_args.d_n_depletants);
+                implicit_args.d_n_depletants,
+                implicit_args.depletant_offset,
+                implicit_args.depletant_batch_size);
             }
         }
     else
@@ -10,6 +10,7 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/VectorMath.h"
 #include "hoomd/hpmc/HPMCCounters.h"
+#include <climits>
 #include <hip/hip_runtime.h>
 
 // base data types
@@ -52,6 +53,8 @@ struct hpmc_implicit_args_t
     unsigned int depletants_per_thread; //!< Controls parallelism (number of depletant loop
                                         //!< iterations per group)
     const hipStream_t* streams;         //!< Stream for this depletant type
+    unsigned int depletant_offset = 0;  //!< First depletant per particle inserted by this launch
+    unsigned int depletant_batch_size = UINT_MAX; //!< Max depletants per particle in this launch
     };
 
 //! Driver for kernel::hpmc_insert_depletants()
@@ -183,6 +183,7 @@ __global__ void hpmc_update_pdata(Scalar4* d_postype,
                                   Scalar4* d_orientation,
                                   Scalar4* d_vel,
                                   hpmc_counters_t* d_counters,
+                                  hpmc_counters_t* d_count_type,
                                   const unsigned int nwork,
                                   const unsigned int offset,
                                   const bool have_auxilliary_variable,
@@ -248,6 +249,22 @@ __global__ void hpmc_update_pdata(Scalar4* d_postype,
                 atomicAdd(&s_translate_reject_count, 1);
             if (!ignore_stats && !accept && !move_type_translate)
                 atomicAdd(&s_rotate_reject_count, 1);
+
+            // count by type for the move size adjustments
+            if (!ignore_stats && d_count_type)
+                {
+                hpmc_counters_t* count_i = d_count_type + type_i;
+                unsigned long long int* count
+                    = move_type_translate ? (accept ? &count_i->translate_accept_count
+                                                    : &count_i->translate_reject_count)
+                                          : (accept ? &count_i->rotate_accept_count
+                                                    : &count_i->rotate_reject_count);
+#if (__CUDA_ARCH__ >= 600)
+                atomicAdd_system(count, 1ull);
+#else
+                atomicAdd(count, 1ull);
+#endif
+                }
             }
         }
 
@@ -415,6 +432,7 @@ void hpmc_update_pdata(const hpmc_update_args_t& args, const typename Shape::par
                            args.d_orientation,
                            args.d_vel,
                            args.d_counters + idev * args.counters_pitch,
+                           args.d_count_type,
                            nwork,
                            range.first,
                            args.have_auxilliary_variable,
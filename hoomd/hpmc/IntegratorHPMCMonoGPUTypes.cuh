@@ -119,6 +119,18 @@ struct hpmc_args_t
     const hipDeviceProp_t& devprop;            //!< CUDA device properties
     const GPUPartition& gpu_partition;         //!< Multi-GPU partition
     const hipStream_t* streams;                //!< kernel streams
+
+    //! Add the candidate neighbors to the overlap check counter, set on one of the narrow phase
+    //! launches that split the type pairs (see IntegratorHPMCMonoGPU::narrowPhase())
+    bool count_overlap_checks = true;
+
+    //! Order in which the narrow phase caches the nested shape parameters of the types in shared
+    //! memory (managed memory, NULL for the type index order)
+    const unsigned int* d_type_cache_order = nullptr;
+
+    //! The narrow phase caches nested shape parameters in the free shared memory divided by
+    //! 2^param_cache_level
+    unsigned int param_cache_level = 0;
     };
 
 //! Wraps arguments for hpmc_update_pdata
@@ -130,6 +142,7 @@ struct hpmc_update_args_t
                        Scalar4* _d_vel,
                        hpmc_counters_t* _d_counters,
                        unsigned int _counters_pitch,
+                       hpmc_counters_t* _d_count_type,
                        const GPUPartition& _gpu_partition,
                        const bool _have_auxilliary_variable,
                        const Scalar4* _d_trial_postype,
@@ -139,7 +152,8 @@ struct hpmc_update_args_t
                        const unsigned int* _d_reject,
                        const unsigned int _block_size)
         : d_postype(_d_postype), d_orientation(_d_orientation), d_vel(_d_vel),
-          d_counters(_d_counters), counters_pitch(_counters_pitch), gpu_partition(_gpu_partition),
+          d_counters(_d_counters), counters_pitch(_counters_pitch), d_count_type(_d_count_type),
+          gpu_partition(_gpu_partition),
           have_auxilliary_variable(_have_auxilliary_variable), d_trial_postype(_d_trial_postype),
           d_trial_orientation(_d_trial_orientation), d_trial_vel(_d_trial_vel),
           d_trial_move_type(_d_trial_move_type), d_reject(_d_reject), block_size(_block_size)
@@ -152,6 +166,7 @@ struct hpmc_update_args_t
     Scalar4* d_vel;
     hpmc_counters_t* d_counters;
     unsigned int counters_pitch;
+    hpmc_counters_t* d_count_type; //!< Counters by particle type, NULL when not recorded
     const GPUPartition& gpu_partition;
     const bool have_auxilliary_variable;
     const Scalar4* d_trial_postype;
@@ -204,6 +219,19 @@ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
                             const GPUPartition& gpu_partition,
                             unsigned int block_size);
 
+//! Kernel driver for kernel::hpmc_scale_positions()
+void hpmc_scale_positions(Scalar4* d_postype,
+                          const unsigned int N,
+                          const BoxDim& old_box,
+                          const BoxDim& new_box,
+                          const unsigned int block_size);
+
+//! Kernel driver for kernel::hpmc_count_rejected()
+void hpmc_count_rejected(const unsigned int* d_reject,
+                         unsigned int* d_count,
+                         const GPUPartition& gpu_partition,
+                         const unsigned int block_size);
+
     } // end namespace gpu
 
     } // end namespace hpmc
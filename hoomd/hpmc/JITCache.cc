@@ -0,0 +1,148 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "JITCache.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace hpmc
+    {
+namespace detail
+    {
+namespace
+    {
+/// Identifies the cache file format
+const char cache_magic[] = "HOOMD-JIT-CACHE-1";
+
+/// The cache directory
+std::string& cachePath()
+    {
+    static std::string path = []()
+    {
+        const char* env = std::getenv("HOOMD_JIT_CACHE_DIR");
+        return std::string(env ? env : "");
+    }();
+    return path;
+    }
+
+/// 64-bit FNV-1a hash
+uint64_t hashKey(const std::string& key)
+    {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key)
+        {
+        hash ^= c;
+        hash *= 1099511628211ull;
+        }
+    return hash;
+    }
+
+/// Create a directory and its parents
+bool makeDirectories(const std::string& path)
+    {
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+        {
+        std::string parent = path.substr(0, pos);
+        if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+            return false;
+        }
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+    }
+
+/// Write a length prefixed string
+void writeString(std::ostream& out, const std::string& s)
+    {
+    uint64_t size = s.size();
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+/// Read a length prefixed string
+bool readString(std::istream& in, std::string& s)
+    {
+    uint64_t size = 0;
+    if (!in.read(reinterpret_cast<char*>(&size), sizeof(size)))
+        return false;
+    s.resize(size);
+    return size == 0 || bool(in.read(&s[0], static_cast<std::streamsize>(size)));
+    }
+    } // end anonymous namespace
+
+const std::string& JITCache::getPath()
+    {
+    return cachePath();
+    }
+
+void JITCache::setPath(const std::string& path)
+    {
+    cachePath() = path;
+    }
+
+std::string JITCache::getFilename(const std::string& key)
+    {
+    std::ostringstream s;
+    s << getPath() << "/" << std::hex << std::setw(16) << std::setfill('0') << hashKey(key)
+      << ".jit";
+    return s.str();
+    }
+
+bool JITCache::load(const std::string& key, std::string& data)
+    {
+    if (getPath().empty())
+        return false;
+
+    std::ifstream in(getFilename(key), std::ios::binary);
+    if (!in)
+        return false;
+
+    std::string magic, stored_key;
+    if (!readString(in, magic) || magic != cache_magic || !readString(in, stored_key)
+        || stored_key != key)
+        return false;
+
+    return readString(in, data);
+    }
+
+void JITCache::store(const std::string& key, const std::string& data)
+    {
+    if (getPath().empty() || !makeDirectories(getPath()))
+        return;
+
+    // write to a file unique to this process, then atomically move it into place
+    std::string filename = getFilename(key);
+    std::ostringstream tmp_name;
+    tmp_name << filename << ".tmp." << getpid();
+
+        {
+        std::ofstream out(tmp_name.str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+
+        writeString(out, cache_magic);
+        writeString(out, key);
+        writeString(out, data);
+
+        if (!out)
+            {
+            out.close();
+            std::remove(tmp_name.str().c_str());
+            return;
+            }
+        }
+
+    if (std::rename(tmp_name.str().c_str(), filename.c_str()) != 0)
+        std::remove(tmp_name.str().c_str());
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
@@ -0,0 +1,57 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include <string>
+
+namespace hpmc
+    {
+namespace detail
+    {
+/** On disk cache for code compiled by the JIT classes.
+
+    Entries are stored in the directory named by the environment variable HOOMD_JIT_CACHE_DIR
+    (the cache is disabled when it is unset or empty), one file per entry named by a hash of the
+    key. Each file also stores the full key, so a hash collision is a cache miss and never
+    returns code compiled from different source. Entries are written to a temporary file and
+    renamed into place, so any number of processes may share one cache directory.
+
+    The key must identify everything the compiled code depends on: the source, the compiler
+    options, and the compiler and HOOMD versions. Remove the cache directory after changing
+    the HOOMD headers without changing the HOOMD version.
+*/
+class JITCache
+    {
+    public:
+    /// Get the cache directory, empty when the cache is disabled
+    static const std::string& getPath();
+
+    /// Set the cache directory, an empty path disables the cache
+    static void setPath(const std::string& path);
+
+    /** Look up an entry
+
+        @param key Key of the entry.
+        @param data Set to the cached data when the entry is found.
+
+        @returns true when the entry is found.
+    */
+    static bool load(const std::string& key, std::string& data);
+
+    /** Store an entry
+
+        @param key Key of the entry.
+        @param data Data to cache.
+
+        Failures to write the cache are silently ignored.
+    */
+    static void store(const std::string& key, const std::string& data);
+
+    private:
+    /// Get the file name of the entry with the given key
+    static std::string getFilename(const std::string& key);
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
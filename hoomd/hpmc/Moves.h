@@ -262,6 +262,47 @@ generatePositionInAABB(RNG& rng, const detail::AABB& aabb, unsigned int ndim)
     return p;
     }
 
+/* Generate the fractional coordinates of a stratified sample in the box
+ *
+ * \param rng The random number generator
+ * \param i Index of the sample
+ * \param n_strata_dim Number of strata along each box vector
+ * \param n_stratified Number of stratified samples (a multiple of n_strata_dim^ndim)
+ * \param ndim Dimensionality of system
+ *
+ * The box is split into n_strata_dim^ndim cells and sample i < n_stratified is placed uniformly in
+ * cell i % n_strata_dim^ndim. Every cell receives the same number of samples, so the fraction of
+ * samples in a region remains an unbiased estimate of its volume fraction with a lower variance
+ * than uniform sampling. The remaining samples are uniform in the box.
+ */
+template<class RNG>
+DEVICE inline Scalar3 generateStratifiedFraction(RNG& rng,
+                                                 unsigned int i,
+                                                 unsigned int n_strata_dim,
+                                                 unsigned int n_stratified,
+                                                 unsigned int ndim)
+    {
+    Scalar3 f;
+    f.x = hoomd::detail::generate_canonical<Scalar>(rng);
+    f.y = hoomd::detail::generate_canonical<Scalar>(rng);
+    f.z = hoomd::detail::generate_canonical<Scalar>(rng);
+
+    if (i < n_stratified)
+        {
+        unsigned int n_strata = n_strata_dim * n_strata_dim * (ndim == 3 ? n_strata_dim : 1);
+        unsigned int stratum = i % n_strata;
+        Scalar inv_n = Scalar(1.0) / Scalar(n_strata_dim);
+
+        f.x = (Scalar(stratum % n_strata_dim) + f.x) * inv_n;
+        stratum /= n_strata_dim;
+        f.y = (Scalar(stratum % n_strata_dim) + f.y) * inv_n;
+        if (ndim == 3)
+            f.z = (Scalar(stratum / n_strata_dim) + f.z) * inv_n;
+        }
+
+    return f;
+    }
+
 /* Generate a uniformly distributed random position in an OBB
  *
  * \param rng The random number generator
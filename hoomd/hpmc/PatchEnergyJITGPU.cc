@@ -39,7 +39,7 @@ void PatchEnergyJITGPU::computePatchEnergyGPU(const gpu_args_t& args, hipStream_
 
     unsigned int max_queue_size = n_groups * tpp;
 
-    const size_t min_shared_bytes = args.num_types * sizeof(Scalar);
+    const size_t min_shared_bytes = args.num_types * args.num_types * sizeof(Scalar);
 
     size_t shared_bytes = n_groups
                               * (sizeof(unsigned int) + 2 * sizeof(Scalar4) + 2 * sizeof(Scalar3)
@@ -98,36 +98,35 @@ void PatchEnergyJITGPU::computePatchEnergyGPU(const gpu_args_t& args, hipStream_
                                                       eval_threads,
                                                       block_size);
 
-        CUresult res = launcher(args.d_postype,
-                                args.d_orientation,
-                                args.d_trial_postype,
-                                args.d_trial_orientation,
-                                args.d_trial_move_type,
-                                args.d_charge,
-                                args.d_diameter,
-                                args.d_excell_idx,
-                                args.d_excell_size,
-                                args.excli,
-                                args.d_update_order_by_ptl,
-                                args.d_reject_in,
-                                args.d_reject_out,
-                                args.seed,
-                                args.timestep,
-                                args.select,
-                                args.rank,
-                                args.num_types,
-                                args.box,
-                                args.ghost_width,
-                                args.cell_dim,
-                                args.ci,
-                                args.N,
-                                args.r_cut_patch,
-                                args.d_additive_cutoff,
-                                args.d_reject_out_of_cell,
-                                max_queue_size,
-                                range.first,
-                                nwork,
-                                max_extra_bytes);
+        CUresult res = launcher.launch(args.d_postype,
+                                       args.d_orientation,
+                                       args.d_trial_postype,
+                                       args.d_trial_orientation,
+                                       args.d_trial_move_type,
+                                       args.d_charge,
+                                       args.d_diameter,
+                                       args.d_excell_idx,
+                                       args.d_excell_size,
+                                       args.excli,
+                                       args.d_update_order_by_ptl,
+                                       args.d_reject_in,
+                                       args.d_reject_out,
+                                       args.seed,
+                                       args.timestep,
+                                       args.select,
+                                       args.rank,
+                                       args.num_types,
+                                       args.box,
+                                       args.ghost_width,
+                                       args.cell_dim,
+                                       args.ci,
+                                       args.N,
+                                       args.d_r_cut_patch,
+                                       args.d_reject_out_of_cell,
+                                       max_queue_size,
+                                       range.first,
+                                       nwork,
+                                       max_extra_bytes);
 
         if (res != CUDA_SUCCESS)
             {
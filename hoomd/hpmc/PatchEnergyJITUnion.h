@@ -274,6 +274,17 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             return extent;
         }
 
+    //! Get the cutoff distance between the centers of two union particles
+    /*! The constituent cutoff extends by the extents of both types, the isotropic cutoff does not.
+     */
+    virtual Scalar getRCutPair(unsigned int type_i, unsigned int type_j)
+        {
+        assert(type_i <= m_extent_type.size() && type_j <= m_extent_type.size());
+        return std::max(m_r_cut_isotropic,
+                        m_r_cut_constituent
+                            + Scalar(0.5) * (m_extent_type[type_i] + m_extent_type[type_j]));
+        }
+
     //! evaluate the energy of the patch interaction
     /*! \param r_ij Vector pointing from particle i to j
         \param type_i Integer type index of particle i
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "GJKRaycast3D.h"
 #include "ShapeSphere.h" //< For the base template of test_overlap
 #include "XenoCollide3D.h"
 #include "hoomd/BoxDim.h"
@@ -42,7 +43,8 @@ struct PolyhedronVertices : ShapeParams
     {
     /// Default constructor initializes zero values.
     DEVICE PolyhedronVertices()
-        : n_hull_verts(0), N(0), diameter(OverlapReal(0)), sweep_radius(OverlapReal(0)), ignore(0)
+        : n_hull_verts(0), N(0), diameter(OverlapReal(0)), insphere_radius(OverlapReal(0)),
+          sweep_radius(OverlapReal(0)), ignore(0)
         {
         }
 
@@ -64,7 +66,7 @@ struct PolyhedronVertices : ShapeParams
                        bool managed = false)
         : x((unsigned int)verts.size(), managed), y((unsigned int)verts.size(), managed),
           z((unsigned int)verts.size(), managed), n_hull_verts(0), N((unsigned int)verts.size()),
-          diameter(0.0), sweep_radius(sweep_radius_), ignore(ignore_)
+          diameter(0.0), insphere_radius(0.0), sweep_radius(sweep_radius_), ignore(ignore_)
         {
         setVerts(verts, sweep_radius_);
         }
@@ -132,6 +134,49 @@ struct PolyhedronVertices : ShapeParams
                 hull_verts[i] = (unsigned int)indexBuffer[i];
             }
 
+        // the insphere about the origin touches the closest face plane of the hull
+        insphere_radius = OverlapReal(0.0);
+        if (n_hull_verts > 0)
+            {
+            vec3<OverlapReal> centroid(0, 0, 0);
+            for (unsigned int i = 0; i < N; i++)
+                centroid += vec3<OverlapReal>(x[i], y[i], z[i]);
+            centroid /= OverlapReal(N);
+
+            OverlapReal d_min = OverlapReal(FLT_MAX);
+            for (unsigned int i = 0; i + 2 < n_hull_verts; i += 3)
+                {
+                vec3<OverlapReal> a(x[hull_verts[i]], y[hull_verts[i]], z[hull_verts[i]]);
+                vec3<OverlapReal> b(x[hull_verts[i + 1]], y[hull_verts[i + 1]], z[hull_verts[i + 1]]);
+                vec3<OverlapReal> c(x[hull_verts[i + 2]], y[hull_verts[i + 2]], z[hull_verts[i + 2]]);
+                vec3<OverlapReal> n = cross(b - a, c - a);
+                OverlapReal n_len = fast::sqrt(dot(n, n));
+                if (n_len == OverlapReal(0.0))
+                    continue;
+
+                // orient the normal outward, independent of the winding of the triangle
+                if (dot(n, a - centroid) < OverlapReal(0.0))
+                    n = -n;
+
+                d_min = detail::min(d_min, dot(n, a) / n_len);
+                }
+
+            if (d_min > OverlapReal(0.0) && d_min < OverlapReal(FLT_MAX))
+                insphere_radius = d_min + sweep_radius;
+            }
+        else if (N > 0)
+            {
+            // a sphere swept around a point or segment contains the origin sphere that fits in the
+            // sweep of the closest vertex
+            OverlapReal r_min_sq = OverlapReal(FLT_MAX);
+            for (unsigned int i = 0; i < N; i++)
+                {
+                vec3<OverlapReal> v(x[i], y[i], z[i]);
+                r_min_sq = detail::min(r_min_sq, dot(v, v));
+                }
+            insphere_radius = detail::max(OverlapReal(0.0), sweep_radius - fast::sqrt(r_min_sq));
+            }
+
         if (N >= 1)
             {
             std::vector<OverlapReal> vertex_radii(N, sweep_radius);
@@ -242,6 +287,9 @@ struct PolyhedronVertices : ShapeParams
     /// Circumsphere diameter
     OverlapReal diameter;
 
+    /// Radius of the largest sphere about the origin inside the shape
+    OverlapReal insphere_radius;
+
     /// Radius of the sphere sweep (used for spheropolyhedra)
     OverlapReal sweep_radius;
 
@@ -263,13 +311,16 @@ class SupportFuncConvexPolyhedron
     /** Construct a support function for a convex polyhedron
 
         @param _verts Polyhedron vertices
+        @param extra_sweep_radius Radius of the sphere to sweep the polyhedron by
+        @param _scale Factor to scale the vertices by before sweeping
 
         Note that for performance it is assumed that unused vertices (beyond N) have already
         been set to zero.
     */
     DEVICE SupportFuncConvexPolyhedron(const PolyhedronVertices& _verts,
-                                       OverlapReal extra_sweep_radius = OverlapReal(0.0))
-        : verts(_verts), sweep_radius(extra_sweep_radius)
+                                       OverlapReal extra_sweep_radius = OverlapReal(0.0),
+                                       OverlapReal _scale = OverlapReal(1.0))
+        : verts(_verts), sweep_radius(extra_sweep_radius), scale(_scale)
         {
         }
 
@@ -380,6 +431,88 @@ class SupportFuncConvexPolyhedron
 
                 int id = __builtin_ffs(_mm_movemask_ps(_mm_cmpeq_ps(max_dot_v, d_v)));
 
+                if (id)
+                    {
+                    max_idx = i + id - 1;
+                    break;
+                    }
+                }
+#elif !defined(__HIPCC__) && defined(__AVX__) \
+    && !(defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+            // process dot products with AVX 4 at a time on the CPU in double precision
+            __m256d nx_v = _mm256_broadcast_sd(&n.x);
+            __m256d ny_v = _mm256_broadcast_sd(&n.y);
+            __m256d nz_v = _mm256_broadcast_sd(&n.z);
+            __m256d max_dot_v = _mm256_broadcast_sd(&max_dot);
+            double d_s[verts.x.size()] __attribute__((aligned(32)));
+
+            for (unsigned int i = 0; i < verts.N; i += 4)
+                {
+                __m256d x_v = _mm256_load_pd(verts.x.get() + i);
+                __m256d y_v = _mm256_load_pd(verts.y.get() + i);
+                __m256d z_v = _mm256_load_pd(verts.z.get() + i);
+
+                __m256d d_v = _mm256_add_pd(
+                    _mm256_mul_pd(nx_v, x_v),
+                    _mm256_add_pd(_mm256_mul_pd(ny_v, y_v), _mm256_mul_pd(nz_v, z_v)));
+
+                // determine a maximum in each of the 4 channels as we go
+                max_dot_v = _mm256_max_pd(max_dot_v, d_v);
+
+                _mm256_store_pd(d_s + i, d_v);
+                }
+
+            // find the maximum of the 4 channels, first within and then across the 128b segments
+            max_dot_v = _mm256_max_pd(max_dot_v, _mm256_permute_pd(max_dot_v, 0x5));
+            max_dot_v = _mm256_max_pd(max_dot_v, _mm256_permute2f128_pd(max_dot_v, max_dot_v, 1));
+
+            // loop again and find the first index of the max element
+            for (unsigned int i = 0; i < verts.N; i += 4)
+                {
+                __m256d d_v = _mm256_load_pd(d_s + i);
+
+                int id = __builtin_ffs(_mm256_movemask_pd(_mm256_cmp_pd(max_dot_v, d_v, 0)));
+
+                if (id)
+                    {
+                    max_idx = i + id - 1;
+                    break;
+                    }
+                }
+#elif !defined(__HIPCC__) && defined(__SSE2__) \
+    && !(defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+            // process dot products with SSE2 2 at a time on the CPU in double precision
+            __m128d nx_v = _mm_load1_pd(&n.x);
+            __m128d ny_v = _mm_load1_pd(&n.y);
+            __m128d nz_v = _mm_load1_pd(&n.z);
+            __m128d max_dot_v = _mm_load1_pd(&max_dot);
+            double d_s[verts.x.size()] __attribute__((aligned(16)));
+
+            for (unsigned int i = 0; i < verts.N; i += 2)
+                {
+                __m128d x_v = _mm_load_pd(verts.x.get() + i);
+                __m128d y_v = _mm_load_pd(verts.y.get() + i);
+                __m128d z_v = _mm_load_pd(verts.z.get() + i);
+
+                __m128d d_v = _mm_add_pd(_mm_mul_pd(nx_v, x_v),
+                                         _mm_add_pd(_mm_mul_pd(ny_v, y_v), _mm_mul_pd(nz_v, z_v)));
+
+                // determine a maximum in each of the 2 channels as we go
+                max_dot_v = _mm_max_pd(max_dot_v, d_v);
+
+                _mm_store_pd(d_s + i, d_v);
+                }
+
+            // find the maximum of the 2 channels
+            max_dot_v = _mm_max_pd(max_dot_v, _mm_shuffle_pd(max_dot_v, max_dot_v, 1));
+
+            // loop again and find the first index of the max element
+            for (unsigned int i = 0; i < verts.N; i += 2)
+                {
+                __m128d d_v = _mm_load_pd(d_s + i);
+
+                int id = __builtin_ffs(_mm_movemask_pd(_mm_cmpeq_pd(max_dot_v, d_v)));
+
                 if (id)
                     {
                     max_idx = i + id - 1;
@@ -388,7 +521,7 @@ class SupportFuncConvexPolyhedron
                 }
 #else
 
-            // if no AVX or SSE, or running in double precision, fall back on serial computation
+            // if no AVX or SSE, fall back on serial computation
             // this code path also triggers on the GPU
 
             OverlapReal max_dot0 = dot(n, vec3<OverlapReal>(verts.x[0], verts.y[0], verts.z[0]));
@@ -452,7 +585,9 @@ class SupportFuncConvexPolyhedron
                 }
 #endif
 
-            vec3<OverlapReal> v(verts.x[max_idx], verts.y[max_idx], verts.z[max_idx]);
+            // scaling the polyhedron does not change the vertex furthest along n
+            vec3<OverlapReal> v
+                = scale * vec3<OverlapReal>(verts.x[max_idx], verts.y[max_idx], verts.z[max_idx]);
             if (sweep_radius != OverlapReal(0.0))
                 return v + (sweep_radius * fast::rsqrt(dot(n, n))) * n;
             else
@@ -470,6 +605,7 @@ class SupportFuncConvexPolyhedron
     private:
     const PolyhedronVertices& verts; //!< Vertices of the polyhedron
     const OverlapReal sweep_radius;  //!< Extra sweep radius
+    const OverlapReal scale;         //!< Scale of the vertices
     };
 
 /** Geometric primitives for closest point calculation
@@ -713,7 +849,7 @@ struct ShapeConvexPolyhedron
 
     /// Construct a shape at a given orientation
     DEVICE ShapeConvexPolyhedron(const quat<Scalar>& _orientation, const param_type& _params)
-        : orientation(_orientation), verts(_params)
+        : orientation(_orientation), verts(_params), scale(1.0)
         {
         }
 
@@ -733,14 +869,13 @@ struct ShapeConvexPolyhedron
     DEVICE OverlapReal getCircumsphereDiameter() const
         {
         // return the precomputed diameter
-        return verts.diameter;
+        return verts.diameter * scale;
         }
 
     /// Get the in-sphere radius of the shape
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        return verts.insphere_radius * scale;
         }
 
     /// Return the bounding box of the shape in world coordinates
@@ -775,6 +910,8 @@ struct ShapeConvexPolyhedron
     DEVICE detail::OBB getOBB(const vec3<Scalar>& pos) const
         {
         detail::OBB obb = verts.obb;
+        obb.lengths *= scale;
+        obb.center *= scale;
         obb.affineTransform(orientation, pos);
         return obb;
         }
@@ -798,8 +935,22 @@ struct ShapeConvexPolyhedron
 
     /// Shape parameters
     const detail::PolyhedronVertices& verts;
+
+    /// Scale of this particle's polyhedron, see particle_scale_supported
+    OverlapReal scale;
+    };
+
+template<> struct particle_scale_supported<ShapeConvexPolyhedron>
+    {
+    static const bool value = true;
     };
 
+//! Scale the polyhedron of a particle
+DEVICE inline void setParticleScale(ShapeConvexPolyhedron& shape, OverlapReal scale)
+    {
+    shape.scale = scale;
+    }
+
 /** Convex polyhedron overlap test
 
     @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
@@ -820,8 +971,8 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
 
     OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
 
-    return detail::xenocollide_3d(detail::SupportFuncConvexPolyhedron(a.verts),
-                                  detail::SupportFuncConvexPolyhedron(b.verts),
+    return detail::xenocollide_3d(detail::SupportFuncConvexPolyhedron(a.verts, 0, a.scale),
+                                  detail::SupportFuncConvexPolyhedron(b.verts, 0, b.scale),
                                   rotate(conj(quat<OverlapReal>(a.orientation)), dr),
                                   conj(quat<OverlapReal>(a.orientation))
                                       * quat<OverlapReal>(b.orientation),
@@ -839,6 +990,42 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+/** Convex polyhedron sweep distance
+
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param direction Unit vector along which *a* moves
+    @param max_distance Largest distance of interest
+    @param err in/out variable incremented when error conditions occur in the query
+    @returns The distance *a* moves before it touches *b*, at most *max_distance*
+*/
+template<>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const ShapeConvexPolyhedron& a,
+                                         const ShapeConvexPolyhedron& b,
+                                         const vec3<Scalar>& direction,
+                                         OverlapReal max_distance,
+                                         unsigned int& err)
+    {
+    quat<OverlapReal> q_a(a.orientation);
+    vec3<OverlapReal> ab_t = rotate(conj(q_a), vec3<OverlapReal>(r_ab));
+
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    OverlapReal distance = max_distance;
+    detail::gjk_raycast_3d(detail::SupportFuncConvexPolyhedron(a.verts, 0, a.scale),
+                           detail::SupportFuncConvexPolyhedron(b.verts, 0, b.scale),
+                           ab_t,
+                           conj(q_a) * quat<OverlapReal>(b.orientation),
+                           rotate(conj(q_a), vec3<OverlapReal>(direction)),
+                           max_distance,
+                           DaDb / OverlapReal(2.0),
+                           distance,
+                           err);
+    return distance;
+    }
+
 #ifndef __HIPCC__
 template<> inline std::string getShapeSpec(const ShapeConvexPolyhedron& poly)
     {
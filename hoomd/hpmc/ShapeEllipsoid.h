@@ -122,8 +122,8 @@ struct ShapeEllipsoid
     /// Get the in-sphere radius of the shape
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        // the smallest semi-axis
+        return detail::min(axes.x, detail::min(axes.y, axes.z));
         }
 
     /** Support function of the shape (in local coordinates), used in getAABB
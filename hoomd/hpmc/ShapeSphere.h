@@ -178,7 +178,7 @@ struct ShapeSphere
 
     /// Construct a shape at a given orientation
     DEVICE ShapeSphere(const quat<Scalar>& _orientation, const param_type& _params)
-        : orientation(_orientation), params(_params)
+        : orientation(_orientation), params(_params), scale(1.0)
         {
         }
 
@@ -197,25 +197,31 @@ struct ShapeSphere
     /// Get the circumsphere diameter of the shape
     DEVICE OverlapReal getCircumsphereDiameter() const
         {
-        return params.radius * OverlapReal(2.0);
+        return getRadius() * OverlapReal(2.0);
         }
 
     /// Get the in-sphere radius of the shape
     DEVICE OverlapReal getInsphereRadius() const
         {
-        return params.radius;
+        return getRadius();
+        }
+
+    /// Get the radius of the sphere, including the scale of the particle
+    DEVICE OverlapReal getRadius() const
+        {
+        return params.radius * scale;
         }
 
     /// Return the bounding box of the shape in world coordinates
     DEVICE detail::AABB getAABB(const vec3<Scalar>& pos) const
         {
-        return detail::AABB(pos, params.radius);
+        return detail::AABB(pos, getRadius());
         }
 
     /// Return a tight fitting OBB around the shape
     DEVICE detail::OBB getOBB(const vec3<Scalar>& pos) const
         {
-        return detail::OBB(pos, params.radius);
+        return detail::OBB(pos, getRadius());
         }
 
     /// Returns true if this shape splits the overlap check over several threads of a warp using
@@ -235,8 +241,35 @@ struct ShapeSphere
 
     /// Sphere parameters
     const SphereParams& params;
+
+    /// Scale of this particle's sphere, see particle_scale_supported
+    OverlapReal scale;
     };
 
+//! Whether the shape scales by a per particle factor
+/*! IntegratorHPMCMono scales the shape of each particle by its diameter when scale_by_diameter is
+    set, so that polydisperse systems need only one type per shape. Shapes that support this have a
+    scale member, which setParticleScale() sets and all geometric queries of the shape honor.
+*/
+template<class Shape> struct particle_scale_supported
+    {
+    static const bool value = false;
+    };
+
+template<> struct particle_scale_supported<ShapeSphere>
+    {
+    static const bool value = true;
+    };
+
+//! Scale the shape of a particle, a no-op for shapes without particle_scale_supported
+template<class Shape> DEVICE inline void setParticleScale(Shape& shape, OverlapReal scale) { }
+
+//! Scale the sphere of a particle
+DEVICE inline void setParticleScale(ShapeSphere& shape, OverlapReal scale)
+    {
+    shape.scale = scale;
+    }
+
 //! Check if circumspheres overlap
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -291,7 +324,7 @@ DEVICE inline bool test_overlap<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_
 
     OverlapReal rsq = dot(dr, dr);
 
-    OverlapReal RaRb = a.params.radius + b.params.radius;
+    OverlapReal RaRb = a.getRadius() + b.getRadius();
     if (rsq < RaRb * RaRb)
         {
         return true;
@@ -323,8 +356,98 @@ struct SamplingMethod
         };
     };
 
+//! Part of two shapes that overlapped in the last overlap test of a pair of particles
+/*! Shapes with hierarchical overlap tests store the node pair that overlapped (e.g. the leaves of
+    the member trees of ShapeUnion) and test that pair first in the next test of the same particles.
+*/
+struct OverlapWitness
+    {
+    //! Construct an invalid witness
+    DEVICE OverlapWitness() : node_a(UINT_MAX), node_b(UINT_MAX) { }
+
+    unsigned int node_a; //!< Node of the first shape
+    unsigned int node_b; //!< Node of the second shape
+    };
+
     }; // namespace detail
 
+//! Overlap test that starts from the witness of an earlier overlap of the same pair
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \param witness In: witness of the last overlap of this pair. Out: witness of the overlap found.
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    The default implementation ignores the witness.
+*/
+template<class ShapeA, class ShapeB>
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                const ShapeA& a,
+                                const ShapeB& b,
+                                unsigned int& err,
+                                detail::OverlapWitness& witness)
+    {
+    return test_overlap(r_ab, a, b, err);
+    }
+
+//! Distance that shape a moves along a direction before it touches shape b
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector along which *a* moves
+    \param max_distance Largest distance of interest
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \returns The distance *a* moves before it touches *b*, or *max_distance* when *a* moves at
+             least *max_distance* without touching *b*.
+
+    Event chain moves use this query to slide particles until they collide. There is no default
+    implementation, only the shapes that specialize sweep_distance support event chain moves. The
+    distance returned must never exceed the exact distance, so that the move does not create
+    overlaps.
+*/
+template<class ShapeA, class ShapeB>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const ShapeA& a,
+                                         const ShapeB& b,
+                                         const vec3<Scalar>& direction,
+                                         OverlapReal max_distance,
+                                         unsigned int& err);
+
+//! Sphere-Sphere sweep distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector along which *a* moves
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur in the query
+    \returns The distance *a* moves before it touches *b*, at most *max_distance*
+
+    \ingroup shape
+*/
+template<>
+DEVICE inline OverlapReal sweep_distance<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_ab,
+                                                                   const ShapeSphere& a,
+                                                                   const ShapeSphere& b,
+                                                                   const vec3<Scalar>& direction,
+                                                                   OverlapReal max_distance,
+                                                                   unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    vec3<OverlapReal> d(direction);
+
+    OverlapReal RaRb = a.getRadius() + b.getRadius();
+
+    // distance of b ahead of a along the direction, and squared distance from the line of motion
+    OverlapReal d_parallel = dot(dr, d);
+    OverlapReal d_perp_sq = dot(dr, dr) - d_parallel * d_parallel;
+    if (d_parallel <= OverlapReal(0.0) || d_perp_sq >= RaRb * RaRb)
+        return max_distance;
+
+    OverlapReal distance = d_parallel - fast::sqrt(RaRb * RaRb - d_perp_sq);
+    return detail::min(max_distance, detail::max(OverlapReal(0.0), distance));
+    }
+
 //! Allocate memory for temporary storage in depletant simulations
 /*! \param shape_a the first shape
     \param shape_b the second shape
@@ -99,8 +99,7 @@ struct ShapeSpheropolyhedron
     //! Get the in-sphere radius
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        return verts.insphere_radius;
         }
 
     //! Return the bounding box of the shape in world coordinates
@@ -193,6 +192,43 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Spheropolyhedron sweep distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector along which *a* moves
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur in the query
+    \returns The distance *a* moves before it touches *b*, at most *max_distance*
+
+    \ingroup shape
+*/
+template<>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const ShapeSpheropolyhedron& a,
+                                         const ShapeSpheropolyhedron& b,
+                                         const vec3<Scalar>& direction,
+                                         OverlapReal max_distance,
+                                         unsigned int& err)
+    {
+    quat<OverlapReal> q_a(a.orientation);
+    vec3<OverlapReal> ab_t = rotate(conj(q_a), vec3<OverlapReal>(r_ab));
+
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    OverlapReal distance = max_distance;
+    detail::gjk_raycast_3d(detail::SupportFuncConvexPolyhedron(a.verts, a.verts.sweep_radius),
+                           detail::SupportFuncConvexPolyhedron(b.verts, b.verts.sweep_radius),
+                           ab_t,
+                           conj(q_a) * quat<OverlapReal>(b.orientation),
+                           rotate(conj(q_a), vec3<OverlapReal>(direction)),
+                           max_distance,
+                           DaDb / OverlapReal(2.0),
+                           distance,
+                           err);
+    return distance;
+    }
+
 #ifndef __HIPCC__
 template<> inline std::string getShapeSpec(const ShapeSpheropolyhedron& spoly)
     {
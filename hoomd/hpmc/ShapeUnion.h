@@ -524,23 +524,46 @@ DEVICE inline bool test_narrow_phase_overlap(vec3<OverlapReal> dr,
     return false;
     }
 
+/** Test for overlap, starting from the leaf node pair that overlapped in the last test
+
+    @param witness In: leaf node pair that overlapped in the last test of this pair of particles.
+                   Out: leaf node pair that overlaps, invalid when the shapes are disjoint.
+
+    Unions with many members spend most of the overlap test in the tandem tree traversal. Trial
+    moves are small, so a pair of particles that overlapped before the move likely still overlaps
+    at the same pair of leaves. Testing that pair first rejects the move without a traversal.
+*/
 template<class Shape>
 DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                                 const ShapeUnion<Shape>& a,
                                 const ShapeUnion<Shape>& b,
-                                unsigned int& err)
+                                unsigned int& err,
+                                detail::OverlapWitness& witness)
     {
     const detail::GPUTree& tree_a = a.members.tree;
     const detail::GPUTree& tree_b = b.members.tree;
 
+    vec3<OverlapReal> dr_rot(rotate(conj(b.orientation), -r_ab));
+    quat<OverlapReal> q(conj(b.orientation) * a.orientation);
+
+    if (witness.node_a < tree_a.getNumNodes() && witness.node_b < tree_b.getNumNodes()
+        && tree_a.isLeaf(witness.node_a) && tree_b.isLeaf(witness.node_b))
+        {
+        detail::OBB obb_a = tree_a.getOBB(witness.node_a);
+        obb_a.affineTransform(q, dr_rot);
+
+        if (detail::overlap(obb_a, tree_b.getOBB(witness.node_b))
+            && test_narrow_phase_overlap(r_ab, a, b, witness.node_a, witness.node_b, err))
+            return true;
+        }
+
+    witness = detail::OverlapWitness();
+
     // perform a tandem tree traversal
     unsigned long int stack = 0;
     unsigned int cur_node_a = 0;
     unsigned int cur_node_b = 0;
 
-    vec3<OverlapReal> dr_rot(rotate(conj(b.orientation), -r_ab));
-    quat<OverlapReal> q(conj(b.orientation) * a.orientation);
-
     detail::OBB obb_a = tree_a.getOBB(cur_node_a);
     obb_a.affineTransform(q, dr_rot);
 
@@ -564,12 +587,26 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                                         q,
                                         dr_rot)
             && test_narrow_phase_overlap(r_ab, a, b, query_node_a, query_node_b, err))
+            {
+            witness.node_a = query_node_a;
+            witness.node_b = query_node_b;
             return true;
+            }
         }
 
     return false;
     }
 
+template<class Shape>
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                const ShapeUnion<Shape>& a,
+                                const ShapeUnion<Shape>& b,
+                                unsigned int& err)
+    {
+    detail::OverlapWitness witness;
+    return test_overlap(r_ab, a, b, err, witness);
+    }
+
 template<class Shape>
 DEVICE inline bool test_narrow_phase_excluded_volume_overlap(vec3<OverlapReal> dr,
                                                              const ShapeUnion<Shape>& a,
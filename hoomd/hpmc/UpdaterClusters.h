@@ -17,18 +17,14 @@
 #include "HPMCCounters.h"
 #include "IntegratorHPMCMono.h"
 
+#include <memory>
+
 #ifdef ENABLE_TBB
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_set.h>
-#include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task.h>
+#include <tbb/task_arena.h>
 #include <atomic>
-
-#if TBB_VERSION_MAJOR < 2021
-#define ENABLE_TBB_TASK
-#endif
-
 #endif
 
 namespace hpmc
@@ -37,49 +33,26 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB_TASK
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
+#ifdef ENABLE_TBB
+//! Hash function for the particle pairs in the concurrent containers
+struct pair_hash
     {
-    public:
-        //! Default constructor
-        my_atomic_flag()
-            {
-            f.clear();
-            }
-
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
-            {
-            f.clear();
-            }
-
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
-            }
-
-        //! Sets flag and returns old value
-        bool test_and_set()
-            {
-            return f.test_and_set();
-            }
-
-    private:
-        std::atomic_flag f;
+    size_t operator()(const std::pair<unsigned int, unsigned int>& p) const
+        {
+        return std::hash<uint64_t>()((uint64_t(p.first) << 32) | p.second);
+        }
     };
 #endif
 
-// Graph class represents a undirected graph
-// using adjacency list representation
+//! Undirected graph that tracks its connected components with a union-find forest
+/*! Every vertex points to a parent vertex with a smaller index, roots point to themselves. Adding
+    an edge links the larger of the two roots below the smaller one, so the root of each component
+    is its smallest vertex and the components do not depend on the order in which edges are added.
+
+    With TBB, addEdge() may be called concurrently from several threads. The parents are updated
+    with compare-and-swap, and the path halving in find() only ever replaces a parent by one of its
+    ancestors.
+*/
 class Graph
     {
     public:
@@ -93,175 +66,107 @@ class Graph
 
         inline void addEdge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB_TASK
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
         inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        void setTaskArena(std::shared_ptr<tbb::task_arena> task_arena)
-            {
-            m_task_arena = task_arena;
-            }
-        #endif
 
     private:
-        #ifndef ENABLE_TBB_TASK
-        std::multimap<unsigned int,unsigned int> adj;
+        #ifdef ENABLE_TBB
+        std::unique_ptr<std::atomic<unsigned int>[]> m_parent; //!< Parent of each vertex
         #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
+        std::unique_ptr<unsigned int[]> m_parent;              //!< Parent of each vertex
         #endif
+        unsigned int m_V = 0;                                  //!< Number of vertices
+        unsigned int m_capacity = 0;                           //!< Allocated number of vertices
 
-        #ifndef ENABLE_TBB_TASK
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        /// The TBB task arena
-        std::shared_ptr<tbb::task_arena> m_task_arena;
-        #endif
-
-        #ifndef ENABLE_TBB_TASK
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
-
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB_TASK
-
+        //! Find the root of a vertex, halving the path to it
+        inline unsigned int find(unsigned int v);
     };
 
-// Gather connected components in an undirected graph
-#ifdef ENABLE_TBB_TASK
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
-void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
+Graph::Graph(unsigned int V)
     {
-    #ifdef ENABLE_TBB_TASK
-    this->m_task_arena->execute([&]{
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    resize(V);
+    }
+
+// Remove all edges and set the number of vertices
+void Graph::resize(unsigned int V)
+    {
+    if (V > m_capacity)
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
+        #ifdef ENABLE_TBB
+        m_parent.reset(new std::atomic<unsigned int>[V]);
+        #else
+        m_parent.reset(new unsigned int[V]);
+        #endif
+        m_capacity = V;
         }
-    }); // end task arena execute()
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
+    m_V = V;
+    for (unsigned int v = 0; v < m_V; ++v)
+        m_parent[v] = v;
+    }
+
+unsigned int Graph::find(unsigned int v)
+    {
+    unsigned int p = m_parent[v];
+    while (p != v)
         {
-        if (visited[v] == false)
+        unsigned int gp = m_parent[p];
+        if (gp != p)
             {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
+            #ifdef ENABLE_TBB
+            // another thread may have linked v closer to the root in the meantime
+            unsigned int expected = p;
+            m_parent[v].compare_exchange_weak(expected, gp);
+            #else
+            m_parent[v] = gp;
+            #endif
             }
+        v = gp;
+        p = m_parent[v];
         }
-    #endif
+    return v;
     }
 
-#ifndef ENABLE_TBB_TASK
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
+// method to add an undirected edge
+void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
+    while (true)
         {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
+        v = find(v);
+        w = find(w);
+        if (v == w)
+            return;
+
+        // link the larger root below the smaller one
+        if (v < w)
+            std::swap(v, w);
+
+        #ifdef ENABLE_TBB
+        // retry if another thread linked v first
+        unsigned int expected = v;
+        if (m_parent[v].compare_exchange_strong(expected, w))
+            return;
+        #else
+        m_parent[v] = w;
+        return;
+        #endif
         }
     }
-#endif
-Graph::Graph(unsigned int V)
-    {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
-    }
 
-void Graph::resize(unsigned int V)
-    {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.clear();
-    visited.resize(V);
-    #endif
-
-    adj.clear();
-    }
-
-// method to add a directed edge
-void Graph::addEdge(unsigned int v, unsigned int w)
+// Gather connected components, ordered by their smallest vertex, with the vertices in increasing order
+void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
     {
-    adj.insert(std::make_pair(v,w));
+    // the root of a component is its smallest vertex, so it is visited before the other vertices
+    std::vector<unsigned int> component(m_V);
+    for (unsigned int v = 0; v < m_V; ++v)
+        {
+        unsigned int root = find(v);
+        if (root == v)
+            {
+            component[v] = (unsigned int)cc.size();
+            cc.push_back(std::vector<unsigned int>());
+            }
+        cc[component[root]].push_back(v);
+        }
     }
 } // end namespace detail
 
@@ -360,11 +265,7 @@ class UpdaterClusters : public Updater
 
         unsigned int m_instance=0;                  //!< Unique ID for RNG seeding
 
-        #ifdef ENABLE_TBB_TASK
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
         std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
 
         detail::Graph m_G; //!< The graph
 
@@ -374,14 +275,14 @@ class UpdaterClusters : public Updater
         GlobalVector<Scalar4> m_orientation_backup;    //!< Old local orientations
         GlobalVector<int3> m_image_backup;             //!< Old local images
 
-        #ifndef ENABLE_TBB_TASK
+        #ifndef ENABLE_TBB
         std::set<std::pair<unsigned int, unsigned int> > m_overlap;   //!< A local vector of particle pairs due to overlap
         std::map<std::pair<unsigned int, unsigned int>,float > m_energy_old_old;    //!< Energy of interaction old-old
         std::map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;    //!< Energy of interaction old-old
         #else
-        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > m_overlap;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_old_old;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;
+        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int>, detail::pair_hash> m_overlap;
+        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>, float, detail::pair_hash> m_energy_old_old;
+        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>, float, detail::pair_hash> m_energy_new_old;
         #endif
 
         hpmc_clusters_counters_t m_count_total;                 //!< Total count since initialization
@@ -420,10 +321,6 @@ UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef
     {
     m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
 
-    #ifdef ENABLE_TBB_TASK
-    m_G.setTaskArena(sysdef->getParticleData()->getExecConf()->getTaskArena());
-    #endif
-
     // initialize stats
     resetStats();
 
@@ -488,7 +385,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
         }
     img_i = box.getImage(pos_i_transf);
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->m_pdata->getNTypes()),
         [=, &shape_i](const tbb::blocked_range<unsigned int>& x) {
@@ -497,7 +394,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
     for (unsigned int type_a = 0; type_a < this->m_pdata->getNTypes(); ++type_a)
     #endif
         {
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         tbb::parallel_for(tbb::blocked_range<unsigned int>(type_a, this->m_pdata->getNTypes()),
             [=, &shape_i](const tbb::blocked_range<unsigned int>& w) {
         for (unsigned int type_b = w.begin(); type_b != w.end(); ++type_b)
@@ -647,7 +544,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                 }
 
             // for every depletant
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
             tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
                 [=, &shape_i,
                     &pos_j, &orientation_j, &type_j, &V_all,
@@ -1043,15 +940,15 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                         }
                     } // end loop over intersections
                 } // end loop over depletants
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
                 });
             #endif
             } // end loop over type_b
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             });
         #endif
         } // end loop over type_a
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1198,7 +1095,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     if (patch)
         {
         // test old configuration against itself
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         this->m_exec_conf->getTaskArena()->execute([&]{
         tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i)
         #else
@@ -1291,14 +1188,14 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over images
 
             } // end loop over old configuration
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             );
         }); // end task arena execute()
         #endif
         }
 
     // loop over new configuration
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
     #else
@@ -1456,7 +1353,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over images
             } // end if patch
         } // end loop over local particles
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         );
     }); // end task arena execute()
     #endif
@@ -1483,7 +1380,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
         return;
 
     // test old configuration against itself
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i) {
     #else
@@ -1501,7 +1398,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
             h_overlaps.data, h_fugacity.data,
             timestep, q, pivot, line);
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1562,6 +1459,9 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
         throw std::runtime_error("UpdaterClusters does not work with spatial domain decomposition.");
     #endif
 
+    if (m_mc->getScaleByDiameter())
+        throw std::runtime_error("UpdaterClusters does not support scale_by_diameter.");
+
     m_exec_conf->msg->notice(10) << timestep << " UpdaterClusters" << std::endl;
 
     m_count_step_start = m_count_total;
@@ -1658,7 +1558,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     if (m_prof)
         m_prof->push("overlap");
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
     #else
@@ -1675,7 +1575,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
             m_G.addEdge(i,j);
             }
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         );
     }); // end task arena execute()
     #endif
@@ -1687,8 +1587,8 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     if (m_mc->getPatchEnergy())
         {
         // sum up interaction energies
-        #ifdef ENABLE_TBB_TASK
-        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, float> delta_U;
+        #ifdef ENABLE_TBB
+        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, float, detail::pair_hash> delta_U;
         #else
         std::map< std::pair<unsigned int, unsigned int>, float> delta_U;
         #endif
@@ -1727,7 +1627,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
             delta_U[p] = delU;
             }
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         this->m_exec_conf->getTaskArena()->execute([&]{
         tbb::parallel_for(delta_U.range(), [&] (decltype(delta_U.range()) r)
         #else
@@ -1752,7 +1652,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
                     }
                 }
             }
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             );
         }); // end task arena execute()
         #endif
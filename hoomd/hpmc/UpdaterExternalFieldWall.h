@@ -152,7 +152,10 @@ class __attribute__((visibility("hidden"))) UpdaterExternalFieldWall : public Up
             m_CurrPlanes = m_external->GetPlaneWalls();
 
             // call back to python to update the external field
-            m_py_updater(timestep);
+                {
+                pybind11::gil_scoped_acquire acquire;
+                m_py_updater(timestep);
+                }
 
             // the only thing that changed was the external field,
             // not particle positions or orientations. so all we need to do is
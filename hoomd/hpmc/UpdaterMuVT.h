@@ -187,6 +187,20 @@ template<class Shape> class UpdaterMuVT : public Updater
                                    quat<Scalar> orientation,
                                    Scalar& lnboltzmann);
 
+    /*! Test whether a fictitious particle certainly overlaps with a local particle
+     * \param aabb_tree The AABB tree of the local particles
+     * \param type Type of particle to test
+     * \param pos Position of fictitious particle
+     * \param h_postype Positions and types of the local particles
+     * \param h_overlaps Interaction matrix
+     * \returns True if the insphere of the particle overlaps with that of another particle
+     */
+    bool checkInsphereOverlap(const detail::AABBTree& aabb_tree,
+                              unsigned int type,
+                              const vec3<Scalar>& pos,
+                              const Scalar4* h_postype,
+                              const unsigned int* h_overlaps);
+
     /*! Try removing a particle
         \param timestep Current time step
         \param tag Tag of particle being removed
@@ -875,6 +889,9 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
     m_count_step_start = m_count_total;
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
+    if (m_mc->getScaleByDiameter())
+        throw std::runtime_error("UpdaterMuVT does not support scale_by_diameter.");
+
     if (m_prof)
         m_prof->push("update muVT");
 
@@ -1920,6 +1937,82 @@ bool UpdaterMuVT<Shape>::tryRemoveParticle(uint64_t timestep, unsigned int tag,
     return nonzero;
     }
 
+/*! Overlapping inspheres imply overlapping shapes, so this test can reject an insertion without
+    the exact overlap tests. In dense systems almost all insertions are rejected, most of them by
+    a neighbor that overlaps deeply enough for the inspheres to overlap. A false result does not
+    imply that there is no overlap.
+*/
+template<class Shape>
+bool UpdaterMuVT<Shape>::checkInsphereOverlap(const detail::AABBTree& aabb_tree,
+                                              unsigned int type,
+                                              const vec3<Scalar>& pos,
+                                              const Scalar4* h_postype,
+                                              const unsigned int* h_overlaps)
+    {
+    auto& params = m_mc->getParams();
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+    auto& image_list = m_mc->updateImageList();
+    const unsigned int n_images = (unsigned int)image_list.size();
+
+    // insphere radii of the types
+    const unsigned int ntypes = m_pdata->getNTypes();
+    std::vector<OverlapReal> r_in(ntypes);
+    OverlapReal r_in_max(0.0);
+    for (unsigned int typ = 0; typ < ntypes; ++typ)
+        {
+        Shape shape(quat<Scalar>(), params[typ]);
+        r_in[typ] = shape.getInsphereRadius();
+        r_in_max = std::max(r_in_max, r_in[typ]);
+        }
+
+    if (r_in[type] == OverlapReal(0.0) && r_in_max == OverlapReal(0.0))
+        return false;
+
+    detail::AABB aabb_local = detail::AABB(vec3<Scalar>(0, 0, 0), r_in[type] + r_in_max);
+
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_image = pos + image_list[cur_image];
+
+        detail::AABB aabb = aabb_local;
+        aabb.translate(pos_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                        Scalar4 postype_j = h_postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                        vec3<OverlapReal> r_ij(vec3<Scalar>(postype_j) - pos_image);
+                        OverlapReal r_in_ij = r_in[type] + r_in[typ_j];
+                        if (h_overlaps[overlap_idx(type, typ_j)]
+                            && dot(r_ij, r_ij) < r_in_ij * r_in_ij)
+                            {
+                            return true;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            }
+        }
+
+    return false;
+    }
+
 template<class Shape>
 bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
                                            unsigned int type,
@@ -2056,7 +2149,10 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
                            r_cut_patch - m_mc->getMinCoreDiameter() / (OverlapReal)2.0);
             detail::AABB aabb_local = detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
 
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            // screen the insertion with the inexpensive insphere test first
+            overlap = checkInsphereOverlap(aabb_tree, type, pos, h_postype.data, h_overlaps.data);
+
+            for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
                 {
                 vec3<Scalar> pos_image = pos + image_list[cur_image];
 
@@ -35,6 +35,13 @@ UpdaterQuickCompress::~UpdaterQuickCompress()
         .disconnect<UpdaterQuickCompress, &UpdaterQuickCompress::slotMaxNChange>(this);
     }
 
+BoxDim UpdaterQuickCompress::getTargetBoxDim()
+    {
+    // System::run releases the GIL
+    pybind11::gil_scoped_acquire acquire;
+    return m_target_box.attr("_cpp_obj").cast<BoxDim>();
+    }
+
 void UpdaterQuickCompress::update(uint64_t timestep)
     {
     Updater::update(timestep);
@@ -47,7 +54,7 @@ void UpdaterQuickCompress::update(uint64_t timestep)
     BoxDim current_box = m_pdata->getGlobalBox();
 
     // TODO: This slow. We will implement a general reusable fix later in #705
-    BoxDim target_box = m_target_box.attr("_cpp_obj").cast<BoxDim>();
+    BoxDim target_box = getTargetBoxDim();
 
     if (n_overlaps == 0 && current_box != target_box)
         {
@@ -158,7 +165,7 @@ BoxDim UpdaterQuickCompress::getNewBox(uint64_t timestep)
     double scale = uniform(rng);
 
     // TODO: This slow. We will implement a general reusable fix later in #705
-    BoxDim target_box = m_target_box.attr("_cpp_obj").cast<BoxDim>();
+    BoxDim target_box = getTargetBoxDim();
 
     // construct the scaled box
     BoxDim current_box = m_pdata->getGlobalBox();
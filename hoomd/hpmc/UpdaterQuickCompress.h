@@ -134,6 +134,9 @@ class UpdaterQuickCompress : public Updater
     /// hold backup copy of particle positions
     GPUArray<Scalar4> m_pos_backup;
 
+    /// Get the target box dimensions from the python box
+    BoxDim getTargetBoxDim();
+
     /// Perform the box scale move
     void performBoxScale(uint64_t timestep);
 
@@ -28,10 +28,13 @@ class FreeVolume(Compute):
     combination with an HPMC integrator, which defines the particle shape
     parameters.
 
-    `FreeVolume` generates `num_samples` uniform random test particle placements
+    `FreeVolume` generates `num_samples` random test particle placements
     (position and orientation) inside the box and counts the number of times
     these test placements overlap with the particles in the simulation state.
-    It then computes the free volume with:
+    The placements are stratified: `FreeVolume` splits the box into a grid of
+    equal cells and places the same number of samples uniformly in each cell,
+    which reduces the variance of the estimate. It then computes the free volume
+    with:
 
     .. math::
         V_\mathrm{free} = \left( \frac{n_\mathrm{samples} - n_\mathrm{overlaps}}
@@ -80,7 +83,7 @@ class FreeVolume(Compute):
             raise RuntimeError("The integrator must be an HPMC integrator.")
 
         # Extract 'Shape' from '<hoomd.hpmc.integrate.Shape object>'
-        integrator_name = integrator.__class__.__name__
+        integrator_name = integrator._shape_name
         try:
             if isinstance(self._simulation.device, hoomd.device.CPU):
                 cpp_cls = getattr(_hpmc, 'ComputeFreeVolume' + integrator_name)
@@ -143,9 +146,6 @@ class SDF(Compute):
         `SDF` does not compute correct pressures for simulations with
         concave particles or enthalpic interactions.
 
-    Note:
-        `SDF` runs on the CPU even in GPU simulations.
-
     Attributes:
         xmax (float): Maximum *x* value at the right hand side of the rightmost
             bin :math:`[\mathrm{length}]`.
@@ -164,12 +164,24 @@ class SDF(Compute):
             raise RuntimeError("The integrator must be an HPMC integrator.")
 
         # Extract 'Shape' from '<hoomd.hpmc.integrate.Shape object>'
-        integrator_name = integrator.__class__.__name__
-
-        cpp_cls = getattr(_hpmc, 'ComputeSDF' + integrator_name)
+        integrator_name = integrator._shape_name
+        try:
+            if isinstance(self._simulation.device, hoomd.device.CPU):
+                cpp_cls = getattr(_hpmc, 'ComputeSDF' + integrator_name)
+            else:
+                cpp_cls = getattr(_hpmc,
+                                  'ComputeSDF' + integrator_name + 'GPU')
+        except AttributeError:
+            raise RuntimeError("Unsupported integrator.")
 
-        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
-                                integrator._cpp_obj, self.xmax, self.dx)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                    integrator._cpp_obj, self.xmax, self.dx)
+        else:
+            cl = _hoomd.CellList(self._simulation.state._cpp_sys_def)
+            self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                    integrator._cpp_obj, cl, self.xmax,
+                                    self.dx)
 
         super()._attach()
 
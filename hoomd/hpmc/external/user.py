@@ -75,6 +75,11 @@ class CPPExternalPotential(_HOOMDBaseObject):
     Note:
         `CPPExternalPotential` does not support execution on GPUs.
 
+    Note:
+        Set the environment variable ``HOOMD_JIT_CACHE_DIR`` to cache the
+        compiled code on disk, as described in
+        `hoomd.hpmc.pair.user.CPPPotentialBase`.
+
     Warning:
         ``CPPExternalPotential`` is **experimental** and subject to change in
         future minor releases.
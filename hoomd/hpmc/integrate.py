@@ -6,12 +6,14 @@
 
 from hoomd import _hoomd
 from hoomd.data.parameterdicts import TypeParameterDict, ParameterDict
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import (OnlyIf, OnlyTypes, to_type_converter,
+                                      trigger_preprocessing)
 from hoomd.data.typeparam import TypeParameter
 from hoomd.error import DataAccessError
 from hoomd.hpmc import _hpmc
 from hoomd.integrate import BaseIntegrator
 from hoomd.logging import log
+from hoomd.trigger import Trigger
 import hoomd
 import json
 
@@ -115,6 +117,57 @@ class HPMCIntegrator(BaseIntegrator):
         nselect (int): Number of trial moves to perform per particle per
             timestep.
 
+        checkerboard (bool): Set to `True` to perform the trial moves on the
+            CPU in checkerboard order (**default:** `False`).
+
+            The local box is divided into a randomly shifted grid of cells at
+            least as wide as the largest interaction range, and the cells are
+            colored into 4 (2D) or 8 (3D) sets. The sets are visited in random
+            order, and the TBB threads move the particles of the cells in one
+            set in parallel. Moves that leave a cell are rejected. The result
+            does not depend on the number of threads. Checkerboard moves are
+            not used with depletants or when the box is smaller than two cells
+            in some direction. The GPU integrators ignore this setting.
+
+        depletant_batch_size (int): Maximum number of depletant insertions
+            per particle that the GPU integrators process in one kernel
+            launch, or 0 for no limit (**default:** 0).
+
+            With a positive value, the GPU inserts the depletants of each
+            particle in consecutive batches. This bounds the size of the
+            kernel launches at high fugacity. The result does not depend on
+            the batch size. The CPU integrators ignore this setting.
+
+        exchange_period (int): Number of time steps between the random
+            shifts of the domains, the particle migrations, and the ghost
+            exchanges with MPI domain decomposition (**default:** 1).
+
+            Particles in the inactive region at the boundary of each domain
+            do not move. Between the exchanges, the trial moves continue in
+            the same active regions, so the ghosts the active particles
+            interact with stay valid. Larger values communicate less often
+            and freeze the same particles for longer. The random shift at each
+            exchange keeps the simulation ergodic.
+
+        move_size_trigger (`hoomd.trigger.Trigger` or `None`): Select the
+            time steps where the integrator adjusts `d` and `a` of every
+            type toward `move_size_target` (**default:** `None`).
+
+            At each selected step, the move sizes of each type are scaled by
+            :math:`(\\alpha + 1) / (\\alpha_\\mathrm{target} + 1)`
+            (at most 2), where :math:`\\alpha` is the fraction of that type's
+            trial moves accepted since the previous adjustment. Move sizes
+            set to zero stay zero. The adjustments happen inside the
+            integrator, without Python callbacks, using the same update as
+            `hoomd.hpmc.tune.MoveSize.scale_solver` with ``gamma=1``. Use a
+            trigger that stops, such as
+            ``hoomd.trigger.And([hoomd.trigger.Periodic(100),
+            hoomd.trigger.Before(10000)])``, or set this to `None` to freeze
+            the move sizes for production runs.
+
+        move_size_target (float): Target acceptance ratio of the move size
+            adjustments (**default:** 0.2).
+
     .. rubric:: Attributes
     """
     _remove_for_pickling = BaseIntegrator._remove_for_pickling + ('_cpp_cell',)
@@ -128,7 +181,15 @@ class HPMCIntegrator(BaseIntegrator):
         # Set base parameter dict for hpmc integrators
         param_dict = ParameterDict(
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=False,
+            depletant_batch_size=int(0),
+            exchange_period=int(1),
+            move_size_trigger=OnlyTypes(Trigger,
+                                        preprocess=trigger_preprocessing,
+                                        allow_none=True),
+            move_size_target=0.2)
+        param_dict['move_size_trigger'] = None
         self._param_dict.update(param_dict)
         self._pair_potential = None
         self._external_potential = None
@@ -231,6 +292,13 @@ class HPMCIntegrator(BaseIntegrator):
         ret = [json.loads(json_string) for json_string in type_shapes]
         return ret
 
+    @property
+    def _shape_name(self):
+        """str: Name of the shape, used to select C++ classes for the shape."""
+        for cls in type(self).__mro__:
+            if HPMCIntegrator in cls.__bases__:
+                return cls.__name__
+
     @log(category='sequence', requires_run=True)
     def map_overlaps(self):
         """list[tuple[int, int]]: List of overlapping particles.
@@ -410,12 +478,18 @@ class Sphere(HPMCIntegrator):
             translation moves.
         nselect (int): Number of trial moves to perform per particle per
             timestep.
+        scale_by_diameter (bool): Scale the shape of each particle by its
+            diameter.
 
     Perform hard particle Monte Carlo of spheres defined by their diameter
     (see `shape`). When the shape parameter ``orientable`` is `False` (the
     default), `Sphere` only applies translation trial moves and ignores
     ``translation_move_probability``.
 
+    Set `scale_by_diameter` to simulate polydisperse spheres with a single
+    particle type. Each sphere then has the diameter of its type multiplied by
+    the particle diameter.
+
     Tip:
         Use spheres with ``diameter=0`` in conjunction with pair potentials
         for Monte Carlo simulations of particles with no hard core.
@@ -454,6 +528,11 @@ class Sphere(HPMCIntegrator):
               `True` to ignore tracked statistics.
             * ``orientable`` (`bool`, **default:** `False`) - set to `True` to
               allow rotation moves on this particle type.
+
+        scale_by_diameter (bool): When `True`, scale the shape of each particle
+            by its diameter. Only supported on the CPU, and not supported with
+            depletants, event chains, `hoomd.hpmc.update.Clusters`,
+            `hoomd.hpmc.update.MuVT`, or `hoomd.hpmc.compute.SDF`.
     """
     _cpp_cls = 'IntegratorHPMCMonoSphere'
 
@@ -461,12 +540,16 @@ class Sphere(HPMCIntegrator):
                  default_d=0.1,
                  default_a=0.1,
                  translation_move_probability=0.5,
-                 nselect=4):
+                 nselect=4,
+                 scale_by_diameter=False):
 
         # initialize base class
         super().__init__(default_d, default_a, translation_move_probability,
                          nselect)
 
+        self._param_dict.update(
+            ParameterDict(scale_by_diameter=bool(scale_by_diameter)))
+
         typeparam_shape = TypeParameter('shape',
                                         type_kind='particle_types',
                                         param_dict=TypeParameterDict(
@@ -490,6 +573,61 @@ class Sphere(HPMCIntegrator):
         return super()._return_type_shapes()
 
 
+class SphereEventChain(Sphere):
+    """Hard sphere Monte Carlo with event chain moves.
+
+    Args:
+        chain_length (float): Total displacement of the particles in each event
+            chain :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+
+    Event chains replace the translation trial moves of `Sphere`. An event chain
+    starts at a particle and picks a random direction. The particle slides along
+    that direction until it touches another particle, which then slides on in
+    the same direction. The chain ends when the displacements of all particles
+    in the chain sum to `chain_length`. Event chains are rejection free and
+    displace many particles collectively, which relaxes dense hard particle
+    fluids much faster than local trial moves (see `Bernard, Krauth, and Wilson
+    2009 <https://doi.org/10.1103/PhysRevE.80.056704>`__).
+
+    Each of the `nselect` sweeps in a timestep starts an event chain at every
+    particle, or performs a rotation trial move with probability
+    ``1 - translation_move_probability`` for orientable shapes. `d` is not
+    used. `translate_moves` counts the displacements between collisions,
+    which are all accepted.
+
+    Warning:
+        Event chain moves do not support pair potentials, external potentials,
+        depletants, or MPI domain decomposition. They run on the CPU.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.SphereEventChain(chain_length=2.0)
+        mc.shape["A"] = dict(diameter=1.0)
+
+    Attributes:
+        chain_length (float): Total displacement of the particles in each event
+            chain :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoECSphere'
+
+    def __init__(self,
+                 chain_length=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1):
+
+        # initialize base class, event chains do not use d
+        super().__init__(0.0, default_a, translation_move_probability, nselect)
+
+        self._param_dict.update(ParameterDict(chain_length=float(chain_length)))
+
+
 class ConvexPolygon(HPMCIntegrator):
     """Hard convex polygon Monte Carlo.
 
@@ -973,9 +1111,13 @@ class ConvexPolyhedron(HPMCIntegrator):
             translation moves.
         nselect (int): Number of trial moves to perform per particle per
             timestep.
+        scale_by_diameter (bool): Scale the shape of each particle by its
+            diameter.
 
     Perform hard particle Monte Carlo of convex polyhedra defined by their
-    vertices (see `shape`).
+    vertices (see `shape`). Set `scale_by_diameter` to simulate polydisperse
+    polyhedra with a single particle type. Each polyhedron then has the
+    vertices of its type multiplied by the particle diameter.
 
     See Also:
         Use `Polyhedron` for concave polyhedra.
@@ -1030,6 +1172,11 @@ class ConvexPolyhedron(HPMCIntegrator):
             Warning:
                 HPMC does not check that all vertex requirements are met.
                 Undefined behavior will result when they are violated.
+
+        scale_by_diameter (bool): When `True`, scale the shape of each particle
+            by its diameter. Only supported on the CPU, and not supported with
+            depletants, event chains, `hoomd.hpmc.update.Clusters`,
+            `hoomd.hpmc.update.MuVT`, or `hoomd.hpmc.compute.SDF`.
     """
 
     _cpp_cls = 'IntegratorHPMCMonoConvexPolyhedron'
@@ -1038,12 +1185,16 @@ class ConvexPolyhedron(HPMCIntegrator):
                  default_d=0.1,
                  default_a=0.1,
                  translation_move_probability=0.5,
-                 nselect=4):
+                 nselect=4,
+                 scale_by_diameter=False):
 
         # initialize base class
         super().__init__(default_d, default_a, translation_move_probability,
                          nselect)
 
+        self._param_dict.update(
+            ParameterDict(scale_by_diameter=bool(scale_by_diameter)))
+
         typeparam_shape = TypeParameter('shape',
                                         type_kind='particle_types',
                                         param_dict=TypeParameterDict(
@@ -1066,6 +1217,65 @@ class ConvexPolyhedron(HPMCIntegrator):
         return super(ConvexPolyhedron, self)._return_type_shapes()
 
 
+class ConvexPolyhedronEventChain(ConvexPolyhedron):
+    """Hard convex polyhedron Monte Carlo with event chain moves.
+
+    Args:
+        chain_length (float): Total displacement of the particles in each event
+            chain :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+
+    Event chains replace the translation trial moves of `ConvexPolyhedron`. An
+    event chain starts at a particle and picks a random direction. The particle
+    slides along that direction until it touches another particle, which then
+    slides on in the same direction. The chain ends when the displacements of
+    all particles in the chain sum to `chain_length`. Event chains are rejection
+    free and displace many particles collectively, which relaxes dense hard
+    particle fluids much faster than local trial moves (see `Bernard, Krauth,
+    and Wilson 2009 <https://doi.org/10.1103/PhysRevE.80.056704>`__).
+
+    Each of the `nselect` sweeps in a timestep starts an event chain at every
+    particle, or performs a rotation trial move with probability
+    ``1 - translation_move_probability`` for orientable shapes. `d` is not
+    used. `translate_moves` counts the displacements between collisions,
+    which are all accepted.
+
+    Warning:
+        Event chain moves do not support pair potentials, external potentials,
+        depletants, or MPI domain decomposition. They run on the CPU.
+
+    Example::
+
+        mc = hpmc.integrate.ConvexPolyhedronEventChain(chain_length=2.0,
+                                                        default_a=0.1)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)]);
+
+    Attributes:
+        chain_length (float): Total displacement of the particles in each event
+            chain :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoECConvexPolyhedron'
+
+    def __init__(self,
+                 chain_length=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1):
+
+        # initialize base class, event chains do not use d
+        super().__init__(0.0, default_a, translation_move_probability, nselect)
+
+        self._param_dict.update(ParameterDict(chain_length=float(chain_length)))
+
+
 class FacetedEllipsoid(HPMCIntegrator):
     r"""Hard faceted ellipsoid Monte Carlo.
 
@@ -1381,6 +1591,67 @@ class ConvexSpheropolyhedron(HPMCIntegrator):
         return super(ConvexSpheropolyhedron, self)._return_type_shapes()
 
 
+class ConvexSpheropolyhedronEventChain(ConvexSpheropolyhedron):
+    """Hard convex spheropolyhedron Monte Carlo with event chain moves.
+
+    Args:
+        chain_length (float): Total displacement of the particles in each event
+            chain :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+
+    Event chains replace the translation trial moves of
+    `ConvexSpheropolyhedron`. An event chain starts at a particle and picks a
+    random direction. The particle slides along that direction until it touches
+    another particle, which then slides on in the same direction. The chain ends
+    when the displacements of all particles in the chain sum to `chain_length`.
+    Event chains are rejection free and displace many particles collectively,
+    which relaxes dense hard particle fluids much faster than local trial moves
+    (see `Bernard, Krauth, and Wilson 2009
+    <https://doi.org/10.1103/PhysRevE.80.056704>`__).
+
+    Each of the `nselect` sweeps in a timestep starts an event chain at every
+    particle, or performs a rotation trial move with probability
+    ``1 - translation_move_probability`` for orientable shapes. `d` is not
+    used. `translate_moves` counts the displacements between collisions,
+    which are all accepted.
+
+    Warning:
+        Event chain moves do not support pair potentials, external potentials,
+        depletants, or MPI domain decomposition. They run on the CPU.
+
+    Example::
+
+        mc = hpmc.integrate.ConvexSpheropolyhedronEventChain(
+            chain_length=2.0, default_a=0.1)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)],
+                             sweep_radius=0.1);
+
+    Attributes:
+        chain_length (float): Total displacement of the particles in each event
+            chain :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoECSpheropolyhedron'
+
+    def __init__(self,
+                 chain_length=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1):
+
+        # initialize base class, event chains do not use d
+        super().__init__(0.0, default_a, translation_move_probability, nselect)
+
+        self._param_dict.update(ParameterDict(chain_length=float(chain_length)))
+
+
 class Ellipsoid(HPMCIntegrator):
     """Hard ellipsoid Monte Carlo.
 
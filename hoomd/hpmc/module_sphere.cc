@@ -5,6 +5,7 @@
 #include "ComputeFreeVolume.h"
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoEC.h"
 
 #include "ComputeSDF.h"
 #include "ShapeSphere.h"
@@ -21,6 +22,7 @@
 #include "UpdaterMuVT.h"
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
 #endif
@@ -36,6 +38,7 @@ namespace hpmc
 void export_sphere(py::module& m)
     {
     export_IntegratorHPMCMono<ShapeSphere>(m, "IntegratorHPMCMonoSphere");
+    export_IntegratorHPMCMonoEC<ShapeSphere>(m, "IntegratorHPMCMonoECSphere");
     export_ComputeFreeVolume<ShapeSphere>(m, "ComputeFreeVolumeSphere");
     export_ComputeSDF<ShapeSphere>(m, "ComputeSDFSphere");
     export_UpdaterMuVT<ShapeSphere>(m, "UpdaterMuVTSphere");
@@ -51,6 +54,7 @@ void export_sphere(py::module& m)
 #ifdef ENABLE_HIP
     export_IntegratorHPMCMonoGPU<ShapeSphere>(m, "IntegratorHPMCMonoSphereGPU");
     export_ComputeFreeVolumeGPU<ShapeSphere>(m, "ComputeFreeVolumeSphereGPU");
+    export_ComputeSDFGPU<ShapeSphere>(m, "ComputeSDFSphereGPU");
     export_UpdaterClustersGPU<ShapeSphere>(m, "UpdaterClustersSphereGPU");
 #endif
     }
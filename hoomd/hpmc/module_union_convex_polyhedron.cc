@@ -21,6 +21,7 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
 #endif
@@ -72,6 +73,9 @@ void export_union_convex_polyhedron(py::module& m)
     export_ComputeFreeVolumeGPU<ShapeUnion<ShapeSpheropolyhedron>>(
         m,
         "ComputeFreeVolumeConvexPolyhedronUnionGPU");
+    export_ComputeSDFGPU<ShapeUnion<ShapeSpheropolyhedron>>(
+        m,
+        "ComputeSDFConvexSpheropolyhedronUnionGPU");
     export_UpdaterClustersGPU<ShapeUnion<ShapeSpheropolyhedron>>(
         m,
         "UpdaterClustersConvexSpheropolyhedronUnionGPU");
@@ -73,12 +73,24 @@ class CPPPotentialBase(_HOOMDBaseObject):
     Note:
         Your code *must* return a value.
 
+    .. rubric:: Compilation cache
+
+    Set the environment variable ``HOOMD_JIT_CACHE_DIR`` to a directory to
+    cache the compiled code on disk. Later jobs that compile the same code with
+    the same version of HOOMD-blue load it from the cache instead. Any number
+    of processes may share the cache directory.
+
     """
 
     @log(requires_run=True)
     def energy(self):
         """float: Total interaction energy of the system in the current state.
 
+        During a run on the CPU, the integrator keeps a running total of the
+        energy changes of the accepted trial moves and recomputes the energy
+        from scratch every 100 time steps, at the start of each run, and after
+        an updater changes the system.
+
         Returns `None` when the patch object and integrator are not
         attached.
         """
@@ -0,0 +1,76 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test the HPMC event chain integrators."""
+
+import hoomd
+import hoomd.hpmc
+import pytest
+import numpy
+
+cube_vertices = [(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5),
+                 (-0.5, 0.5, 0.5), (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                 (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]
+
+integrators = [
+    (hoomd.hpmc.integrate.SphereEventChain, dict(diameter=1.0)),
+    (hoomd.hpmc.integrate.ConvexPolyhedronEventChain,
+     dict(vertices=cube_vertices)),
+    (hoomd.hpmc.integrate.ConvexSpheropolyhedronEventChain,
+     dict(vertices=cube_vertices, sweep_radius=0.1)),
+]
+
+
+@pytest.mark.parametrize("integrator,shape", integrators)
+def test_construction(integrator, shape):
+    """Test that the event chain integrators store their parameters."""
+    mc = integrator(chain_length=2.5, default_a=0.2)
+    mc.shape['A'] = shape
+
+    assert mc.chain_length == 2.5
+    assert mc.a['A'] == 0.2
+    assert mc.d['A'] == 0.0
+
+    mc.chain_length = 0.5
+    assert mc.chain_length == 0.5
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("integrator,shape", integrators)
+def test_run(simulation_factory, lattice_snapshot_factory, integrator, shape):
+    """Test that event chains move particles without creating overlaps."""
+    sim = simulation_factory(lattice_snapshot_factory(a=1.5, n=5))
+    mc = integrator(chain_length=3.0)
+    mc.shape['A'] = shape
+    sim.operations.integrator = mc
+
+    sim.run(0)
+    assert mc.overlaps == 0
+    assert mc.chain_length == 3.0
+
+    with sim.state.cpu_local_snapshot as data:
+        initial_position = numpy.array(data.particles.position, copy=True)
+
+    sim.run(20)
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
+
+    with sim.state.cpu_local_snapshot as data:
+        assert not numpy.allclose(data.particles.position, initial_position)
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_run_2d(simulation_factory, lattice_snapshot_factory):
+    """Test event chains of disks."""
+    sim = simulation_factory(
+        lattice_snapshot_factory(dimensions=2, a=1.2, n=8))
+    mc = hoomd.hpmc.integrate.SphereEventChain(chain_length=2.0)
+    mc.shape['A'] = dict(diameter=1.0)
+    sim.operations.integrator = mc
+
+    sim.run(20)
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
@@ -201,3 +201,53 @@ class TestMoveSize:
 
     def test_pickling(self, move_size_tuner, simulation):
         operation_pickling_check(move_size_tuner, simulation)
+
+
+class TestIntegratorMoveSize:
+
+    def test_defaults(self, simulation):
+        integrator = simulation.operations.integrator
+        assert integrator.move_size_trigger is None
+        assert integrator.move_size_target == 0.2
+
+        simulation.run(0)
+        assert integrator.move_size_trigger is None
+        assert integrator.move_size_target == 0.2
+
+    def test_invalid_target(self, simulation):
+        integrator = simulation.operations.integrator
+        simulation.run(0)
+        with pytest.raises(ValueError):
+            integrator.move_size_target = 1.5
+
+    def test_adjust_and_freeze(self, simulation_factory,
+                               lattice_snapshot_factory):
+        snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        dimensions=2,
+                                        r=1e-3,
+                                        n=20)
+        if snap.communicator.rank == 0:
+            snap.particles.typeid[::2] = 1
+        sim = simulation_factory(snap)
+        integrator = hpmc.integrate.Sphere(default_d=0.01)
+        integrator.shape['A'] = dict(diameter=0.9)
+        integrator.shape['B'] = dict(diameter=0.5)
+        integrator.move_size_trigger = 10
+        integrator.move_size_target = 0.3
+        sim.operations.integrator = integrator
+
+        sim.run(4000)
+
+        # each type converges to its own move size
+        d_A = integrator.d['A']
+        d_B = integrator.d['B']
+        assert d_A != 0.01
+        assert d_B > d_A
+
+        # freeze the move sizes and measure the acceptance ratio
+        integrator.move_size_trigger = None
+        sim.run(1000)
+        assert integrator.d['A'] == d_A
+        assert integrator.d['B'] == d_B
+        accepted, rejected = integrator.translate_moves
+        assert isclose(accepted / (accepted + rejected), 0.3, abs_tol=0.05)
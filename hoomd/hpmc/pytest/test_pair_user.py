@@ -351,3 +351,44 @@ def test_cpp_potential_sticky_spheres(device, simulation_factory,
             dist = np.linalg.norm(snap.particles.position[0]
                                   - snap.particles.position[1])
             assert dist > max_r_interact
+
+
+@pytest.mark.skipif(llvm_disabled, reason='LLVM not enabled')
+def test_energy_running_total(device, simulation_factory,
+                              lattice_snapshot_factory):
+    """Test that the energy logged during a run matches a full computation."""
+    soft_attraction = """
+                      float rsq = dot(r_ij, r_ij);
+                      return -1.0f / (1.0f + rsq);
+                      """
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1.2, n=4))
+
+    patch = hoomd.hpmc.pair.user.CPPPotential(code=soft_attraction,
+                                              param_array=[],
+                                              r_cut=2.0)
+    mc = hoomd.hpmc.integrate.Sphere(d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.pair_potential = patch
+    sim.operations.integrator = mc
+
+    class EnergyRecorder(hoomd.custom.Action):
+
+        def __init__(self):
+            self.energies = []
+
+        def act(self, timestep):
+            self.energies.append(patch.energy)
+
+    record = EnergyRecorder()
+    sim.operations.writers.append(
+        hoomd.write.CustomWriter(action=record,
+                                 trigger=hoomd.trigger.Periodic(1)))
+
+    sim.run(50)
+    assert len(set(record.energies)) > 1
+
+    # the energy is recomputed from scratch at the start of each run
+    energy_tracked = record.energies[-1]
+    sim.run(0)
+    assert np.isclose(patch.energy, energy_tracked, rtol=1e-4)
@@ -125,6 +125,64 @@ def test_moves(device, simulation_factory, lattice_snapshot_factory,
         assert accepted_rejected_rot > 0
 
 
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_checkerboard(simulation_factory, lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    assert not mc.checkerboard
+    mc.checkerboard = True
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=8))
+    sim.operations.add(mc)
+    sim.run(10)
+
+    assert mc.checkerboard
+    assert mc.overlaps == 0
+    accepted, rejected = mc.translate_moves
+    assert accepted > 0
+    assert accepted + rejected == 10 * 4 * sim.state.N_particles
+
+
+@pytest.mark.serial
+def test_depletant_batch_size(simulation_factory, lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.shape['B'] = dict(diameter=0.2)
+    mc.depletant_fugacity[('B', 'B')] = 10.0
+    assert mc.depletant_batch_size == 0
+    mc.depletant_batch_size = 2
+
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], a=1.5, n=4)
+    sim = simulation_factory(snap)
+    sim.operations.add(mc)
+    sim.run(10)
+
+    assert mc.depletant_batch_size == 2
+    assert mc.overlaps == 0
+    accepted, rejected = mc.translate_moves
+    assert accepted + rejected > 0
+
+
+def test_exchange_period(simulation_factory, lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    assert mc.exchange_period == 1
+    mc.exchange_period = 5
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=8))
+    sim.operations.add(mc)
+    sim.run(12)
+
+    assert mc.exchange_period == 5
+    assert mc.overlaps == 0
+    accepted, rejected = mc.translate_moves
+    assert accepted > 0
+
+    with pytest.raises(ValueError):
+        mc.exchange_period = 0
+
+
 # An ellipsoid with a = b = c should be a sphere
 # A spheropolyhedron with a single vertex should be a sphere
 # A sphinx where the indenting sphere is negligible should also be a sphere
@@ -657,3 +715,73 @@ def test_pickling(valid_args, simulation_factory,
     sim = simulation_factory(
         two_particle_snapshot_factory(L=1000, dimensions=n_dimensions))
     operation_pickling_check(mc, sim)
+
+
+_scaled_shapes = [({
+    'diameter': 1
+}, hoomd.hpmc.integrate.Sphere),
+                  ({
+                      'vertices': [(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5),
+                                   (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+                                   (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                                   (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]
+                  }, hoomd.hpmc.integrate.ConvexPolyhedron)]
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("shape_args,integrator", _scaled_shapes)
+def test_overlaps_scale_by_diameter(simulation_factory,
+                                    two_particle_snapshot_factory, shape_args,
+                                    integrator):
+    """Test overlaps of shapes scaled by the particle diameters.
+
+    The two unit shapes are 1.5 apart along x, so they overlap when the sum of
+    their diameters exceeds 3.
+    """
+    mc = integrator(scale_by_diameter=True)
+    mc.shape["A"] = shape_args
+    assert mc.scale_by_diameter
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.5))
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert mc.scale_by_diameter
+    assert mc.overlaps == 0
+
+    def set_diameters(diameters):
+        s = sim.state.get_snapshot()
+        if s.communicator.rank == 0:
+            s.particles.diameter[:] = diameters
+        sim.state.set_snapshot(s)
+
+    # enlarged shapes that still fit
+    set_diameters([1.4, 1.4])
+    assert mc.overlaps == 0
+    set_diameters([2.0, 0.9])
+    assert mc.overlaps == 0
+
+    # enlarged shapes that overlap
+    set_diameters([1.6, 1.6])
+    assert mc.overlaps == 1
+    set_diameters([2.2, 0.9])
+    assert mc.overlaps == 1
+
+    # the diameters are ignored without scale_by_diameter
+    mc.scale_by_diameter = False
+    assert mc.overlaps == 0
+
+    # shrunk shapes do not overlap when the unit shapes would
+    mc.scale_by_diameter = True
+    s = sim.state.get_snapshot()
+    if s.communicator.rank == 0:
+        s.particles.position[:] = [(-0.4, 0, 0.1), (0.4, 0, 0.1)]
+        s.particles.diameter[:] = [0.7, 0.7]
+    sim.state.set_snapshot(s)
+    assert mc.overlaps == 0
+    mc.scale_by_diameter = False
+    assert mc.overlaps == 1
+
+    # trial moves keep the scaled shapes apart
+    mc.scale_by_diameter = True
+    sim.run(10)
+    assert mc.overlaps == 0
@@ -102,3 +102,55 @@ UP_TEST(bigger)
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST(refit)
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(4, 5, 7));
+
+    // build a test AABB tree big enough to exercise the node splitting
+    std::vector<vec3<Scalar>> points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                    * Scalar(1000);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    Scalar build_area = tree.getSurfaceArea();
+    UP_ASSERT_EQUAL(tree.getNumParticles(), N);
+
+    // move the points and refit the tree, buildTree reordered the aabbs
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng));
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(aabbs, N);
+
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    // small moves only change the surface area a little
+    UP_ASSERT(tree.getSurfaceArea() < Scalar(1.25) * build_area);
+
+    // refitting to a compressed configuration shrinks the nodes
+    for (unsigned int i = 0; i < N; i++)
+        {
+        aabbs[i] = AABB(points[i] * Scalar(0.5), Scalar(1.0));
+        }
+    tree.refit(aabbs, N);
+    UP_ASSERT(tree.getSurfaceArea() < build_area);
+    }
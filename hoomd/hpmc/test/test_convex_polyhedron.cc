@@ -1,5 +1,6 @@
 
 
+#include "hoomd/hpmc/ExternalFieldWall.h"
 #include "hoomd/hpmc/IntegratorHPMC.h"
 #include "hoomd/hpmc/Moves.h"
 #include "hoomd/hpmc/ShapeConvexPolyhedron.h"
@@ -641,3 +642,205 @@ UP_TEST(closest_pt_cube_no_rot)
     MY_CHECK_CLOSE(p.y, 0.5, tol);
     MY_CHECK_CLOSE(p.z, 0.5, tol);
     }
+
+UP_TEST(insphere)
+    {
+    quat<Scalar> o;
+
+    // cube
+    vector<vec3<OverlapReal>> vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    PolyhedronVertices cube(vlist, 0, 0);
+    MY_CHECK_CLOSE(ShapeConvexPolyhedron(o, cube).getInsphereRadius(), 0.5, tol);
+
+    // the sweep radius adds to the insphere
+    PolyhedronVertices rounded_cube(vlist, OverlapReal(0.25), 0);
+    MY_CHECK_CLOSE(ShapeConvexPolyhedron(o, rounded_cube).getInsphereRadius(), 0.75, tol);
+
+    // regular tetrahedron
+    vlist.clear();
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, -0.5));
+    PolyhedronVertices tetrahedron(vlist, 0, 0);
+    MY_CHECK_CLOSE(ShapeConvexPolyhedron(o, tetrahedron).getInsphereRadius(),
+                   0.5 / sqrt(3.0),
+                   tol);
+
+    // the origin is on the surface of this tetrahedron
+    vlist.clear();
+    vlist.push_back(vec3<OverlapReal>(0, 0, 0));
+    vlist.push_back(vec3<OverlapReal>(1, 0, 0));
+    vlist.push_back(vec3<OverlapReal>(0, 1.25, 0));
+    vlist.push_back(vec3<OverlapReal>(0, 0, 1.1));
+    PolyhedronVertices corner(vlist, 0, 0);
+    MY_CHECK_SMALL(ShapeConvexPolyhedron(o, corner).getInsphereRadius(), tol_small);
+
+    // sphere swept around a point off the origin
+    vlist.clear();
+    vlist.push_back(vec3<OverlapReal>(0.1, 0, 0));
+    PolyhedronVertices sphere(vlist, OverlapReal(0.5), 0);
+    MY_CHECK_CLOSE(ShapeConvexPolyhedron(o, sphere).getInsphereRadius(), 0.4, tol);
+    }
+
+UP_TEST(sweep_distance)
+    {
+    quat<Scalar> o;
+    vec3<Scalar> r_ab;
+    vec3<Scalar> x(1, 0, 0);
+
+    // build a cube
+    vector<vec3<OverlapReal>> vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    PolyhedronVertices verts(vlist, 0, 0);
+
+    ShapeConvexPolyhedron a(o, verts);
+    ShapeConvexPolyhedron b(o, verts);
+
+    // face to face
+    r_ab = vec3<Scalar>(3, 0, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 10, err_count), 2, tol);
+
+    // the collision is beyond the maximum distance
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 1.5, err_count), 1.5, tol);
+
+    // moving away
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, -x, 10, err_count), 10, tol);
+
+    // partially offset faces
+    r_ab = vec3<Scalar>(3, 0.5, -0.25);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 10, err_count), 2, tol);
+
+    // passing by
+    r_ab = vec3<Scalar>(3, 1.1, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 10, err_count), 10, tol);
+
+    // edge of b rotated 45 degrees about z to face a
+    quat<Scalar> o_rot = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0, 0, 1), M_PI / 4);
+    ShapeConvexPolyhedron c(o_rot, verts);
+    r_ab = vec3<Scalar>(3, 0, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, c, x, 10, err_count), 2.5 - sqrt(0.5), tol);
+
+    // diagonal motion onto the rotated edge
+    vec3<Scalar> d = vec3<Scalar>(1, 1, 0) / sqrt(2.0);
+    r_ab = vec3<Scalar>(3, 3, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, c, d, 10, err_count),
+                   3 * sqrt(2.0) - sqrt(0.5) - 0.5,
+                   tol);
+
+    // a rotated, moving along the face normal of b
+    ShapeConvexPolyhedron e(o_rot, verts);
+    r_ab = vec3<Scalar>(0, 3, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, e, b, vec3<Scalar>(0, 1, 0), 10, err_count),
+                   2.5 - sqrt(0.5),
+                   tol);
+
+    // touching cubes do not move towards each other
+    r_ab = vec3<Scalar>(1, 0, 0);
+    MY_CHECK_SMALL(sweep_distance(r_ab, a, b, x, 10, err_count), tol_small);
+    }
+
+UP_TEST(overlap_cube_scaled)
+    {
+    quat<Scalar> o;
+
+    // build a cube
+    vector<vec3<OverlapReal>> vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    PolyhedronVertices verts(vlist, 0, 0);
+
+    ShapeConvexPolyhedron a(o, verts);
+    ShapeConvexPolyhedron b(o, verts);
+    vec3<Scalar> r_ab(1.5, 0, 0);
+    UP_ASSERT(!test_overlap(r_ab, a, b, err_count));
+
+    // the particle scale multiplies the vertices
+    setParticleScale(a, 1.6);
+    MY_CHECK_CLOSE(a.getCircumsphereDiameter(), 1.6 * sqrt(3.0), tol);
+    MY_CHECK_CLOSE(a.getInsphereRadius(), 0.8, tol);
+    UP_ASSERT(!test_overlap(r_ab, a, b, err_count));
+    UP_ASSERT(!test_overlap(-r_ab, b, a, err_count));
+
+    setParticleScale(b, 1.6);
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count));
+    UP_ASSERT(test_overlap(-r_ab, b, a, err_count));
+
+    // a scaled cube rotated 45 degrees about z reaches further along x
+    quat<Scalar> o_rot = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0, 0, 1), M_PI / 4);
+    ShapeConvexPolyhedron c(o_rot, verts);
+    setParticleScale(c, 1.2);
+    setParticleScale(b, 1.0);
+    r_ab = vec3<Scalar>(1.3, 0, 0);
+    UP_ASSERT(test_overlap(r_ab, c, b, err_count));
+    r_ab = vec3<Scalar>(1.4, 0, 0);
+    UP_ASSERT(!test_overlap(r_ab, c, b, err_count));
+    }
+
+UP_TEST(walls_cube_scaled)
+    {
+    quat<Scalar> o;
+    BoxDim box(100);
+    vec3<Scalar> box_origin(0, 0, 0);
+
+    // build a cube
+    vector<vec3<OverlapReal>> vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    PolyhedronVertices verts(vlist, 0, 0);
+
+    ShapeConvexPolyhedron a(o, verts);
+    ShapeConvexPolyhedron scaled(o, verts);
+    setParticleScale(scaled, 1.8);
+
+    // inside a sphere, tested with the vertices
+    SphereWall sphere_in(5, vec3<Scalar>(0, 0, 0), true);
+    vec3<Scalar> r(4.2, 0, 0);
+    UP_ASSERT(test_confined(sphere_in, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(sphere_in, scaled, r, box_origin, box));
+
+    // outside of a sphere, tested with XenoCollide
+    SphereWall sphere_out(2, vec3<Scalar>(0, 0, 0), false);
+    r = vec3<Scalar>(2.8, 0, 0);
+    UP_ASSERT(test_confined(sphere_out, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(sphere_out, scaled, r, box_origin, box));
+
+    // inside a cylinder
+    CylinderWall cylinder(3, vec3<Scalar>(0, 0, 0), vec3<Scalar>(0, 0, 1), true);
+    r = vec3<Scalar>(2.2, 0, 5);
+    UP_ASSERT(test_confined(cylinder, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(cylinder, scaled, r, box_origin, box));
+
+    // on the positive side of a plane
+    PlaneWall plane(vec3<Scalar>(1, 0, 0), vec3<Scalar>(0, 0, 0));
+    r = vec3<Scalar>(0.7, 0, 0);
+    UP_ASSERT(test_confined(plane, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(plane, scaled, r, box_origin, box));
+    }
@@ -7,6 +7,7 @@
 
 HOOMD_UP_MAIN();
 
+#include "hoomd/hpmc/ExternalFieldWall.h"
 #include "hoomd/hpmc/ShapeSphere.h"
 
 #include <iostream>
@@ -109,3 +110,113 @@ UP_TEST(overlap_boundaries)
     UP_ASSERT(test_overlap(rij, a, c, err_count));
     UP_ASSERT(test_overlap(-rij, c, a, err_count));
     }
+
+UP_TEST(sweep_distance)
+    {
+    // parameters
+    quat<Scalar> o;
+    SphereParams par_a, par_b;
+    par_a.radius = 1.25;
+    par_a.ignore = 0;
+    par_a.isOriented = false;
+    par_b.radius = 1.75;
+    par_b.ignore = 0;
+    par_b.isOriented = false;
+    ShapeSphere a(o, par_a);
+    ShapeSphere b(o, par_b);
+
+    // head on
+    vec3<Scalar> r_ab(5, 0, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, vec3<Scalar>(1, 0, 0), 10, err_count), 2, tol);
+
+    // the collision is beyond the maximum distance
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, vec3<Scalar>(1, 0, 0), 1.5, err_count), 1.5, tol);
+
+    // moving away
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, vec3<Scalar>(-1, 0, 0), 10, err_count), 10, tol);
+
+    // glancing collision
+    r_ab = vec3<Scalar>(5, 1.8, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, vec3<Scalar>(1, 0, 0), 10, err_count), 2.6, tol);
+
+    // passing by
+    r_ab = vec3<Scalar>(5, 0, 3.1);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, vec3<Scalar>(1, 0, 0), 10, err_count), 10, tol);
+
+    // touching spheres do not move towards each other
+    r_ab = vec3<Scalar>(0, 3, 0);
+    MY_CHECK_SMALL(sweep_distance(r_ab, a, b, vec3<Scalar>(0, 1, 0), 10, err_count), tol_small);
+    }
+
+UP_TEST(overlap_scaled)
+    {
+    quat<Scalar> o;
+    SphereParams par;
+    par.radius = 0.5;
+    par.ignore = 0;
+    par.isOriented = false;
+
+    ShapeSphere a(o, par);
+    ShapeSphere b(o, par);
+    vec3<Scalar> r_ab(1.5, 0, 0);
+    UP_ASSERT(!test_overlap(r_ab, a, b, err_count));
+
+    // the particle scale multiplies the radius
+    setParticleScale(a, 1.8);
+    MY_CHECK_CLOSE(a.getCircumsphereDiameter(), 1.8, tol);
+    MY_CHECK_CLOSE(a.getInsphereRadius(), 0.9, tol);
+    MY_CHECK_CLOSE(a.getAABB(vec3<Scalar>(0, 0, 0)).getUpper().x, 0.9, tol);
+    UP_ASSERT(!test_overlap(r_ab, a, b, err_count));
+    UP_ASSERT(!test_overlap(-r_ab, b, a, err_count));
+
+    setParticleScale(a, 2.2);
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count));
+    UP_ASSERT(test_overlap(-r_ab, b, a, err_count));
+
+    // shrunk spheres
+    setParticleScale(a, 0.5);
+    setParticleScale(b, 0.5);
+    r_ab = vec3<Scalar>(0.6, 0, 0);
+    UP_ASSERT(!test_overlap(r_ab, a, b, err_count));
+    r_ab = vec3<Scalar>(0.4, 0, 0);
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count));
+    }
+
+UP_TEST(walls_scaled)
+    {
+    quat<Scalar> o;
+    BoxDim box(100);
+    vec3<Scalar> box_origin(0, 0, 0);
+    SphereParams par;
+    par.radius = 0.5;
+    par.ignore = 0;
+    par.isOriented = false;
+
+    ShapeSphere a(o, par);
+    ShapeSphere scaled(o, par);
+    setParticleScale(scaled, 2.4);
+
+    // inside a sphere
+    SphereWall sphere_in(5, vec3<Scalar>(0, 0, 0), true);
+    vec3<Scalar> r(4.2, 0, 0);
+    UP_ASSERT(test_confined(sphere_in, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(sphere_in, scaled, r, box_origin, box));
+
+    // outside of a sphere
+    SphereWall sphere_out(2, vec3<Scalar>(0, 0, 0), false);
+    r = vec3<Scalar>(3, 0, 0);
+    UP_ASSERT(test_confined(sphere_out, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(sphere_out, scaled, r, box_origin, box));
+
+    // inside a cylinder
+    CylinderWall cylinder(3, vec3<Scalar>(0, 0, 0), vec3<Scalar>(0, 0, 1), true);
+    r = vec3<Scalar>(2.2, 0, 5);
+    UP_ASSERT(test_confined(cylinder, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(cylinder, scaled, r, box_origin, box));
+
+    // on the positive side of a plane
+    PlaneWall plane(vec3<Scalar>(1, 0, 0), vec3<Scalar>(0, 0, 0));
+    r = vec3<Scalar>(0.8, 0, 0);
+    UP_ASSERT(test_confined(plane, a, r, box_origin, box));
+    UP_ASSERT(!test_confined(plane, scaled, r, box_origin, box));
+    }
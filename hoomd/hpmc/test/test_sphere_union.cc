@@ -237,3 +237,57 @@ UP_TEST(overlapping_dumbbells)
     UP_ASSERT(test_overlap(r_b - r_a, a, b, err_count));
     UP_ASSERT(test_overlap(r_a - r_b, b, a, err_count));
     }
+
+UP_TEST(overlap_witness)
+    {
+    // chain of 8 spheres of radius 0.25 along x, split over several leaves
+    quat<Scalar> o;
+    ShapeSphere::param_type par;
+    par.radius = OverlapReal(0.25);
+    par.ignore = 0;
+
+    ShapeUnion<ShapeSphere>::param_type params(8);
+    params.diameter = OverlapReal(4.0);
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        params.mpos[i] = vec3<Scalar>(-1.75 + 0.5 * i, 0, 0);
+        params.morientation[i] = o;
+        params.mparams[i] = par;
+        params.moverlap[i] = 1;
+        }
+    params.ignore = 0;
+    build_tree<ShapeSphere>(params);
+    UP_ASSERT(params.tree.getNumNodes() > 1);
+
+    ShapeUnion<ShapeSphere> a(o, params);
+    ShapeUnion<ShapeSphere> b(o, params);
+
+    // a test without a witness records the overlapping leaves
+    OverlapWitness witness;
+    vec3<Scalar> r_ab(0, 0.49, 0);
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count, witness));
+    UP_ASSERT(witness.node_a < params.tree.getNumNodes());
+    UP_ASSERT(witness.node_b < params.tree.getNumNodes());
+    UP_ASSERT(params.tree.isLeaf(witness.node_a));
+    UP_ASSERT(params.tree.isLeaf(witness.node_b));
+
+    // after a small move the same leaves still overlap
+    OverlapWitness last = witness;
+    r_ab = vec3<Scalar>(0.01, 0.48, 0);
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count, witness));
+    UP_ASSERT_EQUAL(witness.node_a, last.node_a);
+    UP_ASSERT_EQUAL(witness.node_b, last.node_b);
+
+    // only the ends of the chains overlap, a stale witness does not miss the overlap
+    r_ab = vec3<Scalar>(3.9, 0, 0);
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count, witness));
+    UP_ASSERT(test_overlap(r_ab, a, b, err_count));
+    UP_ASSERT(params.tree.isLeaf(witness.node_a));
+    UP_ASSERT(params.tree.isLeaf(witness.node_b));
+
+    // disjoint shapes invalidate the witness
+    r_ab = vec3<Scalar>(4.1, 0, 0);
+    UP_ASSERT(!test_overlap(r_ab, a, b, err_count, witness));
+    UP_ASSERT_EQUAL(witness.node_a, UINT_MAX);
+    UP_ASSERT_EQUAL(witness.node_b, UINT_MAX);
+    }
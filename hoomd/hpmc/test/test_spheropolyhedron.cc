@@ -920,3 +920,47 @@ UP_TEST(closest_pt_rounded_cube_no_rot)
     MY_CHECK_CLOSE(p.y, 0, tol);
     MY_CHECK_CLOSE(p.z, 0, tol);
     }
+
+UP_TEST(sweep_distance)
+    {
+    quat<Scalar> o;
+    vec3<Scalar> r_ab;
+    vec3<Scalar> x(1, 0, 0);
+
+    // spheres
+    vector<vec3<OverlapReal>> vlist;
+    vlist.push_back(vec3<OverlapReal>(0, 0, 0));
+    PolyhedronVertices sphere = setup_verts(vlist, 0.5);
+    ShapeSpheropolyhedron a(o, sphere);
+    ShapeSpheropolyhedron b(o, sphere);
+
+    r_ab = vec3<Scalar>(3, 0, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 10, err_count), 2, tol);
+    r_ab = vec3<Scalar>(3, 0.6, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 10, err_count), 2.2, tol);
+    r_ab = vec3<Scalar>(3, 1.1, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, a, b, x, 10, err_count), 10, tol);
+
+    // rounded cubes
+    vlist.clear();
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, -0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, -0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    PolyhedronVertices rounded_cube = setup_verts(vlist, 0.25);
+    ShapeSpheropolyhedron c(o, rounded_cube);
+    ShapeSpheropolyhedron d(o, rounded_cube);
+
+    // face to face
+    r_ab = vec3<Scalar>(3, 0, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, c, d, x, 10, err_count), 1.5, tol);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, c, d, -x, 10, err_count), 10, tol);
+
+    // rounded edges meeting
+    r_ab = vec3<Scalar>(3, 1.25, 0);
+    MY_CHECK_CLOSE(sweep_distance(r_ab, c, d, x, 10, err_count), 2 - 0.5 * sqrt(0.75), tol);
+    }
@@ -408,7 +408,7 @@ class MuVT(Updater):
             raise RuntimeError("The integrator must be a HPMC integrator.")
 
         cpp_cls_name = "UpdaterMuVT"
-        cpp_cls_name += integrator.__class__.__name__
+        cpp_cls_name += integrator._shape_name
         cpp_cls = getattr(_hpmc, cpp_cls_name)
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
@@ -542,7 +542,7 @@ class Clusters(Updater):
             raise RuntimeError("The integrator must be a HPMC integrator.")
 
         cpp_cls_name = "UpdaterClusters"
-        cpp_cls_name += integrator.__class__.__name__
+        cpp_cls_name += integrator._shape_name
         cpp_cls = getattr(_hpmc, cpp_cls_name)
         use_gpu = (isinstance(self._simulation.device, hoomd.device.GPU)
                    and (cpp_cls_name + 'GPU') in _hpmc.__dict__)
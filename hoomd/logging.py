@@ -8,7 +8,7 @@ from copy import deepcopy
 from enum import Flag, auto
 from itertools import count
 from functools import reduce, wraps
-from hoomd.util import dict_map, _SafeNamespaceDict
+from hoomd.util import dict_flatten, dict_map, _SafeNamespaceDict
 from hoomd.error import DataAccessError
 from collections.abc import Sequence
 
@@ -589,6 +589,7 @@ class Logger(_SafeNamespaceDict):
         self._categories = LoggerCategories.ALL if categories is None else \
             LoggerCategories.any(categories)
         self._only_default = only_default
+        self._flat_entries = None
         super().__init__()
 
     @property
@@ -717,6 +718,23 @@ class Logger(_SafeNamespaceDict):
             super().__setitem__(namespace, value)
         else:
             super().__setitem__(namespace, _LoggerEntry.from_tuple(value))
+        self._flat_entries = None
+
+    def __delitem__(self, namespace):
+        """Remove a quantity from the logger."""
+        super().__delitem__(namespace)
+        self._flat_entries = None
+
+    def _entries(self):
+        """The (namespace, entry) pairs in the order of `log`.
+
+        Writers that log every quantity on each call use this to skip building
+        the nested dictionary. The list is cached, so the same object is
+        returned until quantities are added or removed.
+        """
+        if getattr(self, '_flat_entries', None) is None:
+            self._flat_entries = list(dict_flatten(self._dict).items())
+        return self._flat_entries
 
     def __iadd__(self, obj):
         """Add quantities from object or list of objects to logger.
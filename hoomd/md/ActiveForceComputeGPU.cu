@@ -90,7 +90,7 @@ __global__ void gpu_compute_active_force_rotational_diffusion_kernel(const unsig
 
     if (fact.w != 0)
         {
-        unsigned int ptag = d_tag[group_idx];
+        unsigned int ptag = d_tag[idx];
 
         quat<Scalar> quati(__ldg(d_orientation + idx));
 
@@ -28,10 +28,14 @@ typedef AnisoPotentialPair<EvaluatorPairDipole> AnisoPotentialPairDipole;
 
 #ifdef ENABLE_HIP
 //! Pair potential force compute for Gay-Berne forces and torques on the GPU
-typedef AnisoPotentialPairGPU<EvaluatorPairGB, gpu_compute_pair_aniso_forces_gb>
+typedef AnisoPotentialPairGPU<EvaluatorPairGB,
+                              gpu_compute_pair_aniso_forces_gb,
+                              gpu_compute_aniso_directors_gb>
     AnisoPotentialPairGBGPU;
 //! Pair potential force compute for dipole forces and torques on the GPU
-typedef AnisoPotentialPairGPU<EvaluatorPairDipole, gpu_compute_pair_aniso_forces_dipole>
+typedef AnisoPotentialPairGPU<EvaluatorPairDipole,
+                              gpu_compute_pair_aniso_forces_dipole,
+                              gpu_compute_aniso_directors_dipole>
     AnisoPotentialPairDipoleGPU;
 #endif
 
@@ -24,3 +24,33 @@ gpu_compute_pair_aniso_forces_dipole(const a_pair_args_t& pair_args,
     {
     return gpu_compute_pair_aniso_forces<EvaluatorPairDipole>(pair_args, d_param, d_shape_param);
     }
+
+hipError_t gpu_compute_aniso_directors_gb(Scalar4* d_director,
+                                          const Scalar4* d_pos,
+                                          const Scalar4* d_orientation,
+                                          const EvaluatorPairGB::shape_type* d_shape_params,
+                                          const unsigned int N,
+                                          const unsigned int block_size)
+    {
+    return gpu_compute_aniso_directors<EvaluatorPairGB>(d_director,
+                                                        d_pos,
+                                                        d_orientation,
+                                                        d_shape_params,
+                                                        N,
+                                                        block_size);
+    }
+
+hipError_t gpu_compute_aniso_directors_dipole(Scalar4* d_director,
+                                              const Scalar4* d_pos,
+                                              const Scalar4* d_orientation,
+                                              const EvaluatorPairDipole::shape_type* d_shape_params,
+                                              const unsigned int N,
+                                              const unsigned int block_size)
+    {
+    return gpu_compute_aniso_directors<EvaluatorPairDipole>(d_director,
+                                                            d_pos,
+                                                            d_orientation,
+                                                            d_shape_params,
+                                                            N,
+                                                            block_size);
+    }
@@ -27,4 +27,22 @@ gpu_compute_pair_aniso_forces_dipole(const a_pair_args_t&,
                                      const EvaluatorPairDipole::param_type*,
                                      const EvaluatorPairDipole::shape_type*);
 
+//! Compute the directors of the particles on the GPU with EvaluatorPairGB
+hipError_t __attribute__((visibility("default")))
+gpu_compute_aniso_directors_gb(Scalar4*,
+                               const Scalar4*,
+                               const Scalar4*,
+                               const EvaluatorPairGB::shape_type*,
+                               const unsigned int,
+                               const unsigned int);
+
+//! Compute the directors of the particles on the GPU with EvaluatorPairDipole
+hipError_t __attribute__((visibility("default")))
+gpu_compute_aniso_directors_dipole(Scalar4*,
+                                   const Scalar4*,
+                                   const Scalar4*,
+                                   const EvaluatorPairDipole::shape_type*,
+                                   const unsigned int,
+                                   const unsigned int);
+
 #endif
@@ -14,6 +14,7 @@
 #include "EvaluatorPairDLVO.h"
 #include "EvaluatorPairDPDLJThermo.h"
 #include "EvaluatorPairDPDThermo.h"
+#include "EvaluatorPairDSF.h"
 #include "EvaluatorPairEwald.h"
 #include "EvaluatorPairExpandedMie.h"
 #include "EvaluatorPairForceShiftedLJ.h"
@@ -112,6 +113,10 @@ hipError_t __attribute__((visibility("default")))
 gpu_compute_reaction_field_forces(const pair_args_t& args,
                                   const EvaluatorPairReactionField::param_type* d_params);
 
+//! Compute damped shifted force electrostatics on the GPU with EvaluatorPairDSF
+hipError_t __attribute__((visibility("default")))
+gpu_compute_dsf_forces(const pair_args_t& pair_args, const EvaluatorPairDSF::param_type* d_params);
+
 //! Compute buckingham pair forces on the GPU with PairEvaluatorBuckingham
 hipError_t __attribute__((visibility("default")))
 gpu_compute_buckingham_forces(const pair_args_t& pair_args,
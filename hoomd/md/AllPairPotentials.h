@@ -10,6 +10,7 @@
 #include "EvaluatorPairDLVO.h"
 #include "EvaluatorPairDPDLJThermo.h"
 #include "EvaluatorPairDPDThermo.h"
+#include "EvaluatorPairDSF.h"
 #include "EvaluatorPairEwald.h"
 #include "EvaluatorPairExpandedMie.h"
 #include "EvaluatorPairForceShiftedLJ.h"
@@ -78,6 +79,8 @@ typedef PotentialPair<EvaluatorPairMie> PotentialPairMie;
 typedef PotentialPair<EvaluatorPairExpandedMie> PotentialPairExpandedMie;
 //! Pair potential force compute for ReactionField potential
 typedef PotentialPair<EvaluatorPairReactionField> PotentialPairReactionField;
+//! Pair potential force compute for damped shifted force electrostatics
+typedef PotentialPair<EvaluatorPairDSF> PotentialPairDSF;
 //! Pair potential force compute for Buckingham forces
 typedef PotentialPair<EvaluatorPairBuckingham> PotentialPairBuckingham;
 //! Pair potential force compute for lj1208 forces
@@ -135,6 +138,8 @@ typedef PotentialPairGPU<EvaluatorPairExpandedMie, gpu_compute_expanded_mie_forc
 //! Pair potential force compute for reaction field forces on the GPU
 typedef PotentialPairGPU<EvaluatorPairReactionField, gpu_compute_reaction_field_forces>
     PotentialPairReactionFieldGPU;
+//! Pair potential force compute for damped shifted force electrostatics on the GPU
+typedef PotentialPairGPU<EvaluatorPairDSF, gpu_compute_dsf_forces> PotentialPairDSFGPU;
 //! Pair potential force compute for Buckingham forces on the GPU
 typedef PotentialPairGPU<EvaluatorPairBuckingham, gpu_compute_buckingham_forces>
     PotentialPairBuckinghamGPU;
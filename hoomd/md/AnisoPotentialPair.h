@@ -502,6 +502,15 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
                                           access_location::host,
                                           access_mode::read);
 
+    // iterate only over the cutoff shell of this potential when the rows are partitioned
+    const int shell = m_nlist->getShell(m_r_cut_nlist);
+    ArrayHandle<unsigned int> h_shell_n_neigh(m_nlist->getShellNNeighArray(),
+                                              access_location::host,
+                                              access_mode::read);
+    const unsigned int* n_neigh = shell >= 0
+                                      ? h_shell_n_neigh.data + shell * m_nlist->getShellPitch()
+                                      : h_n_neigh.data;
+
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
@@ -569,7 +578,7 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
 
             // loop over all of the neighbors of this particle
             const unsigned int myHead = h_head_list.data[i];
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            const unsigned int size = n_neigh[i];
             for (unsigned int k = 0; k < size; k++)
                 {
                 // access the index of this neighbor (MEM TRANSFER: 1 scalar)
@@ -9,6 +9,7 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/TextureTools.h"
+#include "hoomd/VectorMath.h"
 
 #ifdef __HIPCC__
 #include "hoomd/WarpTools.cuh"
@@ -44,6 +45,7 @@ struct a_pair_args_t
                   const Scalar* _d_diameter,
                   const Scalar* _d_charge,
                   const Scalar4* _d_orientation,
+                  const Scalar4* _d_director,
                   const unsigned int* _d_tag,
                   const BoxDim& _box,
                   const unsigned int* _d_n_neigh,
@@ -60,11 +62,12 @@ struct a_pair_args_t
                   bool _update_shape_param)
         : d_force(_d_force), d_torque(_d_torque), d_virial(_d_virial), virial_pitch(_virial_pitch),
           N(_N), n_max(_n_max), d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge),
-          d_orientation(_d_orientation), d_tag(_d_tag), box(_box), d_n_neigh(_d_n_neigh),
-          d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq), ntypes(_ntypes),
-          block_size(_block_size), shift_mode(_shift_mode), compute_virial(_compute_virial),
-          threads_per_particle(_threads_per_particle), gpu_partition(_gpu_partition),
-          devprop(_devprop), update_shape_param(_update_shape_param) {};
+          d_orientation(_d_orientation), d_director(_d_director), d_tag(_d_tag), box(_box),
+          d_n_neigh(_d_n_neigh), d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq),
+          ntypes(_ntypes), block_size(_block_size), shift_mode(_shift_mode),
+          compute_virial(_compute_virial), threads_per_particle(_threads_per_particle),
+          gpu_partition(_gpu_partition), devprop(_devprop),
+          update_shape_param(_update_shape_param) {};
 
     Scalar4* d_force;             //!< Force to write out
     Scalar4* d_torque;            //!< Torque to write out
@@ -76,6 +79,7 @@ struct a_pair_args_t
     const Scalar* d_diameter;     //!< particle diameters
     const Scalar* d_charge;       //!< particle charges
     const Scalar4* d_orientation; //!< particle orientation to compute forces over
+    const Scalar4* d_director;    //!< particle directors (when the evaluator needs them)
     const unsigned int* d_tag;    //!< particle tags to compute forces over
     const BoxDim& box;            //!< Simulation box in GPU format
     const unsigned int*
@@ -110,6 +114,7 @@ struct a_pair_args_t
     \param d_diameter particle diameters
     \param d_charge particle charges
     \param d_orientation Quaternion data on the GPU to calculate forces on
+    \param d_director Directors precomputed by gpu_compute_aniso_directors()
     \param d_tag Tag data on the GPU to calculate forces on
     \param box Box dimensions used to implement periodic boundary conditions
     \param d_n_neigh Device memory array listing the number of neighbors for each particle
@@ -148,6 +153,7 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                                      const Scalar* d_diameter,
                                      const Scalar* d_charge,
                                      const Scalar4* d_orientation,
+                                     const Scalar4* d_director,
                                      const unsigned int* d_tag,
                                      const BoxDim box,
                                      const unsigned int* d_n_neigh,
@@ -242,7 +248,13 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
         // read in the position of our particle
         Scalar4 postypei = __ldg(d_pos + idx);
         Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
-        Scalar4 quati = __ldg(d_orientation + idx);
+        // evaluators that accept directors do not read the orientations
+        Scalar4 quati = make_scalar4(Scalar(1.0), Scalar(0), Scalar(0), Scalar(0));
+        Scalar4 diri = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+        if (evaluator::needsDirector())
+            diri = __ldg(d_director + idx);
+        else
+            quati = __ldg(d_orientation + idx);
 
         Scalar di = Scalar(0);
         if (evaluator::needsDiameter())
@@ -273,7 +285,12 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                 // get the neighbor's position
                 Scalar4 postypej = __ldg(d_pos + cur_j);
                 Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
-                Scalar4 quatj = __ldg(d_orientation + cur_j);
+                Scalar4 quatj = make_scalar4(Scalar(1.0), Scalar(0), Scalar(0), Scalar(0));
+                Scalar4 dirj = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+                if (evaluator::needsDirector())
+                    dirj = __ldg(d_director + cur_j);
+                else
+                    quatj = __ldg(d_orientation + cur_j);
 
                 Scalar dj = Scalar(0);
                 if (evaluator::needsDiameter())
@@ -321,6 +338,8 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                                   &(s_shape_params[__scalar_as_int(postypej.w)]));
                 if (evaluator::needsTags())
                     eval.setTags(__ldg(d_tag + idx), __ldg(d_tag + cur_j));
+                if (evaluator::needsDirector())
+                    eval.setDirector(vec3<Scalar>(diri), vec3<Scalar>(dirj));
 
                 // call evaluator
                 eval.evaluate(jforce, pair_eng, energy_shift, torquei, torquej);
@@ -483,6 +502,7 @@ struct AnisoPairForceComputeKernel
                 pair_args.d_diameter,
                 pair_args.d_charge,
                 pair_args.d_orientation,
+                pair_args.d_director,
                 pair_args.d_tag,
                 pair_args.box,
                 pair_args.d_n_neigh,
@@ -595,6 +615,79 @@ hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
         }
     return hipSuccess;
     }
+
+//! Kernel to compute the director of each particle
+/*! \param d_director Directors (output)
+    \param d_pos Particle positions and types
+    \param d_orientation Particle orientations
+    \param d_shape_params Shape parameters, stored per type
+    \param N Number of particles (local and ghost)
+
+    The director is the vector in the space frame that the evaluator computes from the orientation
+    of a particle, e.g. the axis of an ellipsoid or a dipole moment. Computing it once per particle
+    avoids repeating the quaternion math for every neighbor in the pair kernel.
+*/
+template<class evaluator>
+__global__ void
+gpu_compute_aniso_directors_kernel(Scalar4* d_director,
+                                   const Scalar4* d_pos,
+                                   const Scalar4* d_orientation,
+                                   const typename evaluator::shape_type* d_shape_params,
+                                   const unsigned int N)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int type = __scalar_as_int(__ldg(d_pos + idx).w);
+    const vec3<Scalar> director
+        = evaluator::computeDirector(quat<Scalar>(__ldg(d_orientation + idx)),
+                                     d_shape_params[type]);
+    d_director[idx] = make_scalar4(director.x, director.y, director.z, Scalar(0));
+    }
+
+//! Kernel driver for gpu_compute_aniso_directors_kernel()
+/*! \param d_director Directors (output)
+    \param d_pos Particle positions and types
+    \param d_orientation Particle orientations
+    \param d_shape_params Shape parameters, stored per type
+    \param N Number of particles (local and ghost)
+    \param block_size Block size to execute
+*/
+template<class evaluator>
+hipError_t gpu_compute_aniso_directors(Scalar4* d_director,
+                                       const Scalar4* d_pos,
+                                       const Scalar4* d_orientation,
+                                       const typename evaluator::shape_type* d_shape_params,
+                                       const unsigned int N,
+                                       const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(
+        &attr,
+        reinterpret_cast<const void*>(&gpu_compute_aniso_directors_kernel<evaluator>));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL((gpu_compute_aniso_directors_kernel<evaluator>),
+                       dim3(grid),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_director,
+                       d_pos,
+                       d_orientation,
+                       d_shape_params,
+                       N);
+
+    return hipSuccess;
+    }
 #endif
 
 #endif // __ANISO_POTENTIAL_PAIR_GPU_CUH__
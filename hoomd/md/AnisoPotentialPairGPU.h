@@ -31,13 +31,24 @@
 
     \tparam evaluator EvaluatorPair class used to evaluate potential, force and torque.
     \tparam gpu_cgpf Driver function that calls gpu_compute_pair_forces<evaluator>()
+    \tparam gpu_cgad Driver function that calls gpu_compute_aniso_directors<evaluator>()
+
+    When the evaluator accepts directors (evaluator::needsDirector()), the director of every local
+    and ghost particle is computed once per step into m_director, and the pair kernel reads the
+    directors instead of converting the orientation of each neighbor.
 
     \sa export_AnisoPotentialPairGPU()
 */
 template<class evaluator,
          hipError_t gpu_cgpf(const a_pair_args_t& pair_args,
                              const typename evaluator::param_type* d_params,
-                             const typename evaluator::shape_type* d_shape_params)>
+                             const typename evaluator::shape_type* d_shape_params),
+         hipError_t gpu_cgad(Scalar4* d_director,
+                             const Scalar4* d_pos,
+                             const Scalar4* d_orientation,
+                             const typename evaluator::shape_type* d_shape_params,
+                             const unsigned int N,
+                             const unsigned int block_size)>
 class AnisoPotentialPairGPU : public AnisoPotentialPair<evaluator>
     {
     public:
@@ -66,11 +77,15 @@ class AnisoPotentialPairGPU : public AnisoPotentialPair<evaluator>
         AnisoPotentialPair<evaluator>::setAutotunerParams(enable, period);
         m_tuner->setPeriod(period);
         m_tuner->setEnabled(enable);
+        m_director_tuner->setPeriod(period);
+        m_director_tuner->setEnabled(enable);
         }
 
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
-    unsigned int m_param;               //!< Kernel tuning parameter
+    std::unique_ptr<Autotuner> m_director_tuner; //!< Autotuner for the director block size
+    unsigned int m_param;                        //!< Kernel tuning parameter
+    GlobalArray<Scalar4> m_director;             //!< Director of each local and ghost particle
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -79,8 +94,14 @@ class AnisoPotentialPairGPU : public AnisoPotentialPair<evaluator>
 template<class evaluator,
          hipError_t gpu_cgpf(const a_pair_args_t& pair_args,
                              const typename evaluator::param_type* d_params,
-                             const typename evaluator::shape_type* d_shape_params)>
-AnisoPotentialPairGPU<evaluator, gpu_cgpf>::AnisoPotentialPairGPU(
+                             const typename evaluator::shape_type* d_shape_params),
+         hipError_t gpu_cgad(Scalar4* d_director,
+                             const Scalar4* d_pos,
+                             const Scalar4* d_orientation,
+                             const typename evaluator::shape_type* d_shape_params,
+                             const unsigned int N,
+                             const unsigned int block_size)>
+AnisoPotentialPairGPU<evaluator, gpu_cgpf, gpu_cgad>::AnisoPotentialPairGPU(
     std::shared_ptr<SystemDefinition> sysdef,
     std::shared_ptr<NeighborList> nlist)
     : AnisoPotentialPair<evaluator>(sysdef, nlist), m_param(0)
@@ -114,6 +135,13 @@ AnisoPotentialPairGPU<evaluator, gpu_cgpf>::AnisoPotentialPairGPU(
                                 100000,
                                 "aniso_pair_" + evaluator::getName(),
                                 this->m_exec_conf));
+    m_director_tuner.reset(new Autotuner(warp_size,
+                                         1024,
+                                         warp_size,
+                                         5,
+                                         100000,
+                                         "aniso_pair_director_" + evaluator::getName(),
+                                         this->m_exec_conf));
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
     m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
@@ -123,8 +151,14 @@ AnisoPotentialPairGPU<evaluator, gpu_cgpf>::AnisoPotentialPairGPU(
 template<class evaluator,
          hipError_t gpu_cgpf(const a_pair_args_t& pair_args,
                              const typename evaluator::param_type* d_params,
-                             const typename evaluator::shape_type* d_shape_params)>
-void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
+                             const typename evaluator::shape_type* d_shape_params),
+         hipError_t gpu_cgad(Scalar4* d_director,
+                             const Scalar4* d_pos,
+                             const Scalar4* d_orientation,
+                             const typename evaluator::shape_type* d_shape_params,
+                             const unsigned int N,
+                             const unsigned int block_size)>
+void AnisoPotentialPairGPU<evaluator, gpu_cgpf, gpu_cgad>::computeForces(uint64_t timestep)
     {
     this->m_nlist->compute(timestep);
 
@@ -154,6 +188,15 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
                                           access_location::device,
                                           access_mode::read);
 
+    // iterate only over the cutoff shell of this potential when the rows are partitioned
+    const int shell = this->m_nlist->getShell(this->m_r_cut_nlist);
+    ArrayHandle<unsigned int> d_shell_n_neigh(this->m_nlist->getShellNNeighArray(),
+                                              access_location::device,
+                                              access_mode::read);
+    const unsigned int* n_neigh
+        = shell >= 0 ? d_shell_n_neigh.data + shell * this->m_nlist->getShellPitch()
+                     : d_n_neigh.data;
+
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
                                access_location::device,
@@ -189,6 +232,32 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
     // access flags
     PDataFlags flags = this->m_pdata->getFlags();
 
+    // compute the directors of the local and ghost particles once for all of their pairs
+    if (evaluator::needsDirector())
+        {
+        const unsigned int n_director = this->m_pdata->getN() + this->m_pdata->getNGhosts();
+        if (m_director.getNumElements() < n_director)
+            {
+            GlobalArray<Scalar4> director(this->m_pdata->getMaxN(), this->m_exec_conf);
+            m_director.swap(director);
+            }
+
+        ArrayHandle<Scalar4> d_director(m_director,
+                                        access_location::device,
+                                        access_mode::overwrite);
+        m_director_tuner->begin();
+        gpu_cgad(d_director.data,
+                 d_pos.data,
+                 d_orientation.data,
+                 d_shape_params.data,
+                 n_director,
+                 m_director_tuner->getParam());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_director_tuner->end();
+        }
+    ArrayHandle<Scalar4> d_director(m_director, access_location::device, access_mode::read);
+
     this->m_exec_conf->beginMultiGPU();
 
     if (!m_param)
@@ -211,9 +280,10 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
                            d_diameter.data,
                            d_charge.data,
                            d_orientation.data,
+                           d_director.data,
                            d_tag.data,
                            box,
-                           d_n_neigh.data,
+                           n_neigh,
                            d_nlist.data,
                            d_head_list.data,
                            d_rcutsq.data,
@@ -37,7 +37,7 @@ BondTablePotential::BondTablePotential(std::shared_ptr<SystemDefinition> sysdef,
         }
 
     // allocate storage for the tables and parameters
-    GPUArray<Scalar2> tables(m_table_width, m_bond_data->getNTypes(), m_exec_conf);
+    GPUArray<Scalar4> tables(m_table_width, m_bond_data->getNTypes(), m_exec_conf);
     m_tables.swap(tables);
     GPUArray<Scalar4> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
@@ -75,7 +75,7 @@ void BondTablePotential::setTable(unsigned int type,
         }
 
     // access the arrays
-    ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_tables(m_tables, access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::readwrite);
 
     // range check on the parameters
@@ -98,11 +98,14 @@ void BondTablePotential::setTable(unsigned int type,
     h_params.data[type].y = rmax;
     h_params.data[type].z = (rmax - rmin) / Scalar(m_table_width - 1);
 
-    // fill out the table
+    // fill out the table with the values and their increments to the next entry
     for (unsigned int i = 0; i < m_table_width; i++)
         {
-        h_tables.data[m_table_value(i, type)].x = V[i];
-        h_tables.data[m_table_value(i, type)].y = F[i];
+        unsigned int next = i + 1 < m_table_width ? i + 1 : i;
+        h_tables.data[m_table_value(i, type)] = make_scalar4(V[i],
+                                                             F[i],
+                                                             V[next] - V[i],
+                                                             F[next] - F[i]);
         }
     }
 
@@ -134,7 +137,7 @@ void BondTablePotential::computeForces(uint64_t timestep)
     const BoxDim& box = m_pdata->getGlobalBox();
 
     // access the table data
-    ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
     // for each of the bonds
@@ -193,20 +196,15 @@ void BondTablePotential::computeForces(uint64_t timestep)
 
             /// Here we use the table!!
             unsigned int value_i = (unsigned int)floor(value_f);
-            Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
-            Scalar2 VF1 = h_tables.data[m_table_value(value_i + 1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
+            // one load reads the values at value_i and the increments to value_i + 1
+            Scalar4 entry = h_tables.data[m_table_value(value_i, type)];
 
             // compute the linear interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V = entry.x + f * entry.z;
+            Scalar F = entry.y + f * entry.w;
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar force_divr = Scalar(0.0);
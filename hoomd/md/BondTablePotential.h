@@ -82,7 +82,7 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
     protected:
     std::shared_ptr<BondData> m_bond_data; //!< Bond data to use in computing bonds
     unsigned int m_table_width;            //!< Width of the tables in memory
-    GPUArray<Scalar2> m_tables;            //!< Stored V and F tables
+    GPUArray<Scalar4> m_tables;            //!< V, F, and their increments to the next entry
     GPUArray<Scalar4> m_params;            //!< Parameters stored for each table
     Index2D m_table_value;                 //!< Index table helper
 
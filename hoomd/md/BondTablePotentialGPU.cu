@@ -43,7 +43,7 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
                                                     size_t pitch,
                                                     const unsigned int* n_bonds_list,
                                                     const unsigned int n_bond_type,
-                                                    const Scalar2* d_tables,
+                                                    const Scalar4* d_tables,
                                                     const Scalar4* d_params,
                                                     const Index2D table_value,
                                                     unsigned int* d_flags)
@@ -87,7 +87,7 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
         int cur_bond_type = cur_bond.idx[1];
 
         // get the bonded particle's position (MEM_TRANSFER: 16 bytes)
-        Scalar4 neigh_postype = d_pos[cur_bond_idx];
+        Scalar4 neigh_postype = __ldg(d_pos + cur_bond_idx);
         Scalar3 neigh_pos = make_scalar3(neigh_postype.x, neigh_postype.y, neigh_postype.z);
 
         // calculate dr (FLOPS: 3)
@@ -114,20 +114,15 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
             // compute index into the table and read in values
             unsigned int value_i = floor(value_f);
 
-            Scalar2 VF0 = __ldg(d_tables + table_value(value_i, cur_bond_type));
-            Scalar2 VF1 = __ldg(d_tables + table_value(value_i + 1, cur_bond_type));
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
+            // one load reads the values at value_i and the increments to value_i + 1
+            Scalar4 entry = __ldg(d_tables + table_value(value_i, cur_bond_type));
 
             // compute the linear interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V = entry.x + f * entry.z;
+            Scalar F = entry.y + f * entry.w;
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar forcemag_divr = 0.0f;
@@ -192,7 +187,7 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         const unsigned int pitch,
                                         const unsigned int* n_bonds_list,
                                         const unsigned int n_bond_type,
-                                        const Scalar2* d_tables,
+                                        const Scalar4* d_tables,
                                         const Scalar4* d_params,
                                         const unsigned int table_width,
                                         const Index2D& table_value,
@@ -27,7 +27,7 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         const unsigned int pitch,
                                         const unsigned int* n_bonds_list,
                                         const unsigned int n_bond_type,
-                                        const Scalar2* d_tables,
+                                        const Scalar4* d_tables,
                                         const Scalar4* d_params,
                                         const unsigned int table_width,
                                         const Index2D& table_value,
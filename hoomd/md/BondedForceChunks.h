@@ -0,0 +1,139 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __BONDED_FORCE_CHUNKS_H__
+#define __BONDED_FORCE_CHUNKS_H__
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+/*! \file BondedForceChunks.h
+    \brief Declares BondedForceChunks
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Evaluate bonded groups in parallel on the CPU
+/*! Bonded group forces are evaluated once per group and added to every local member, so two
+    threads may add to the same particle. When built with TBB and more than one CPU thread is
+    active, compute() splits the groups into one contiguous chunk per thread and evaluates the
+    chunks in parallel in the ExecutionConfiguration task arena. Each chunk adds its forces and
+    virials to its own buffer, and the buffers are summed into the output in chunk order, so the
+    result is reproducible for a given number of threads. Otherwise, compute() evaluates all groups
+    directly into the output.
+
+    The buffers persist between calls to avoid reallocating them every step.
+*/
+class BondedForceChunks
+    {
+    public:
+    //! Evaluate the forces of a range of groups
+    /*! \param exec_conf Execution configuration that provides the task arena
+        \param n_groups Number of groups to evaluate
+        \param N Number of particles the groups add forces to, including ghosts if they do
+        \param h_force Output forces, zeroed by the caller
+        \param h_virial Output virials, zeroed by the caller
+        \param virial_pitch Pitch of \a h_virial
+        \param compute_virial Set to false to skip the virial buffers
+        \param compute_range Function that adds the forces of the groups in [first, last) with
+            the signature (first, last, force, virial, virial_pitch)
+    */
+    template<class F>
+    void compute(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                 unsigned int n_groups,
+                 unsigned int N,
+                 Scalar4* h_force,
+                 Scalar* h_virial,
+                 size_t virial_pitch,
+                 bool compute_virial,
+                 const F& compute_range)
+        {
+#ifdef ENABLE_TBB
+        const unsigned int n_chunks = std::min(exec_conf->getNumThreads(), n_groups);
+        if (n_chunks > 1)
+            {
+            const unsigned int chunk_size = (n_groups + n_chunks - 1) / n_chunks;
+
+            m_chunk_force.assign(size_t(n_chunks) * N, make_scalar4(0, 0, 0, 0));
+            if (compute_virial)
+                m_chunk_virial.assign(size_t(n_chunks) * 6 * N, Scalar(0.0));
+
+            exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(
+                        tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                        {
+                            for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                                {
+                                unsigned int first = chunk * chunk_size;
+                                unsigned int last = std::min(first + chunk_size, n_groups);
+                                compute_range(first,
+                                              last,
+                                              m_chunk_force.data() + size_t(chunk) * N,
+                                              compute_virial ? m_chunk_virial.data()
+                                                                   + size_t(chunk) * 6 * N
+                                                             : nullptr,
+                                              size_t(N));
+                                }
+                        },
+                        tbb::simple_partitioner());
+
+                    // sum the chunks in chunk order for a reproducible result
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      {
+                                          for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                              {
+                                              for (unsigned int chunk = 0; chunk < n_chunks;
+                                                   ++chunk)
+                                                  {
+                                                  const Scalar4& f
+                                                      = m_chunk_force[size_t(chunk) * N + i];
+                                                  h_force[i].x += f.x;
+                                                  h_force[i].y += f.y;
+                                                  h_force[i].z += f.z;
+                                                  h_force[i].w += f.w;
+
+                                                  if (compute_virial)
+                                                      {
+                                                      const Scalar* v = m_chunk_virial.data()
+                                                                        + size_t(chunk) * 6 * N;
+                                                      for (unsigned int k = 0; k < 6; ++k)
+                                                          h_virial[k * virial_pitch + i]
+                                                              += v[k * N + i];
+                                                      }
+                                                  }
+                                              }
+                                      });
+                });
+            return;
+            }
+#endif
+
+        compute_range(0, n_groups, h_force, compute_virial ? h_virial : nullptr, virial_pitch);
+        }
+
+    private:
+#ifdef ENABLE_TBB
+    /// Per-chunk force accumulators (n_chunks * N)
+    std::vector<Scalar4> m_chunk_force;
+
+    /// Per-chunk virial accumulators (n_chunks * 6 * N)
+    std::vector<Scalar> m_chunk_virial;
+#endif
+    };
+
+#endif // __BONDED_FORCE_CHUNKS_H__
@@ -18,6 +18,7 @@
 namespace py = pybind11;
 
 #include <iostream>
+#include <vector>
 using namespace std;
 
 /*! \param sysdef System for which to compute thermodynamic properties
@@ -47,9 +48,10 @@ ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
 #endif
 
     m_computed_flags.reset();
+    m_valid_properties = thermo_property::all;
 
 #ifdef ENABLE_MPI
-    m_properties_reduced = true;
+    m_reduced_properties = thermo_property::all;
 #endif
     }
 
@@ -58,7 +60,7 @@ ComputeThermo::~ComputeThermo()
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
     }
 
-/*! Calls computeProperties if the properties need updating
+/*! Marks all properties for evaluation if the properties need updating
     \param timestep Current time step of the simulation
 */
 void ComputeThermo::compute(uint64_t timestep)
@@ -66,18 +68,43 @@ void ComputeThermo::compute(uint64_t timestep)
     Compute::compute(timestep);
     if (shouldCompute(timestep))
         {
-        computeProperties();
         m_computed_flags = m_pdata->getFlags();
+        m_valid_properties = 0;
+#ifdef ENABLE_MPI
+        m_reduced_properties = 0;
+#endif
         }
     }
 
-/*! Computes all thermodynamic properties of the system in one fell swoop.
+/*! \param properties Properties to evaluate (thermo_property flags)
+
+    Computes the properties in \a properties that have not been evaluated since the last call to
+    compute(), and reduces them over MPI ranks.
+*/
+void ComputeThermo::evaluate(unsigned int properties)
+    {
+    // the pressure is computed from the kinetic energy
+    if (properties & thermo_property::pressure)
+        properties |= thermo_property::translational_kinetic_energy;
+
+    const unsigned int missing = properties & ~m_valid_properties;
+    if (missing)
+        m_valid_properties |= computeProperties(missing);
+
+#ifdef ENABLE_MPI
+    if ((properties & ~m_reduced_properties) != 0)
+        reduceProperties();
+#endif
+    }
+
+/*! \param properties Properties to compute (thermo_property flags)
+    \returns The properties written
  */
-void ComputeThermo::computeProperties()
+unsigned int ComputeThermo::computeProperties(unsigned int properties)
     {
     // just drop out if the group is an empty group
     if (m_group->getNumMembersGlobal() == 0)
-        return;
+        return thermo_property::all;
 
     unsigned int group_size = m_group->getNumMembers();
 
@@ -99,11 +126,15 @@ void ComputeThermo::computeProperties()
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
 
+    // use the flags of the last call to compute(), the getters test the same flags
+    const PDataFlags& flags = m_computed_flags;
+    const bool compute_pressure = properties & thermo_property::pressure;
+    const bool compute_pressure_tensor = compute_pressure && flags[pdata_flag::pressure_tensor];
+    unsigned int computed = 0;
+
     // total kinetic energy
     double ke_trans_total = 0.0;
 
-    PDataFlags flags = m_pdata->getFlags();
-
     double pressure_kinetic_xx = 0.0;
     double pressure_kinetic_xy = 0.0;
     double pressure_kinetic_xz = 0.0;
@@ -111,7 +142,7 @@ void ComputeThermo::computeProperties()
     double pressure_kinetic_yz = 0.0;
     double pressure_kinetic_zz = 0.0;
 
-    if (flags[pdata_flag::pressure_tensor])
+    if (compute_pressure_tensor)
         {
         // Calculate kinetic part of pressure tensor
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -133,7 +164,8 @@ void ComputeThermo::computeProperties()
         ke_trans_total
             = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
         }
-    else
+    else if (properties
+             & (thermo_property::translational_kinetic_energy | thermo_property::pressure))
         {
         // total kinetic energy
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -151,11 +183,15 @@ void ComputeThermo::computeProperties()
 
         ke_trans_total *= Scalar(0.5);
         }
+    // a valid kinetic energy may already be reduced, only write it when requested
+    if (properties & thermo_property::translational_kinetic_energy)
+        computed |= thermo_property::translational_kinetic_energy;
 
     // total rotational kinetic energy
     double ke_rot_total = 0.0;
 
-    if (flags[pdata_flag::rotational_kinetic_energy])
+    if ((properties & thermo_property::rotational_kinetic_energy)
+        && flags[pdata_flag::rotational_kinetic_energy])
         {
         // Calculate rotational part of kinetic energy
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
@@ -198,21 +234,27 @@ void ComputeThermo::computeProperties()
 
         ke_rot_total /= Scalar(2.0);
         }
+    if (properties & thermo_property::rotational_kinetic_energy)
+        computed |= thermo_property::rotational_kinetic_energy;
 
     // total potential energy
     double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    if (properties & thermo_property::potential_energy)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
-            pe_total += (double)h_net_force.data[j].w;
+            unsigned int j = m_group->getMemberIndex(group_idx);
+
+            // ignore rigid body constituent particles in the sum
+            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+                {
+                pe_total += (double)h_net_force.data[j].w;
+                }
             }
-        }
 
-    pe_total += m_pdata->getExternalEnergy();
+        pe_total += m_pdata->getExternalEnergy();
+        computed |= thermo_property::potential_energy;
+        }
 
     double W = 0.0;
     double virial_xx = m_pdata->getExternalVirial(0);
@@ -222,7 +264,7 @@ void ComputeThermo::computeProperties()
     double virial_yz = m_pdata->getExternalVirial(4);
     double virial_zz = m_pdata->getExternalVirial(5);
 
-    if (flags[pdata_flag::pressure_tensor])
+    if (compute_pressure_tensor)
         {
         // Calculate upper triangular virial tensor
         size_t virial_pitch = net_virial.getPitch();
@@ -245,74 +287,99 @@ void ComputeThermo::computeProperties()
         W = Scalar(1. / 3.) * (virial_xx + virial_yy + virial_zz);
         }
 
-    // compute the pressure
-    // volume/area & other 2D stuff needed
-    BoxDim global_box = m_pdata->getGlobalBox();
-
-    Scalar3 L = global_box.getL();
-    Scalar volume;
-    unsigned int D = m_sysdef->getNDimensions();
-    if (D == 2)
-        {
-        // "volume" is area in 2D
-        volume = L.x * L.y;
-        // W needs to be corrected since the 1/3 factor is built in
-        W *= Scalar(3.0 / 2.0);
-        }
-    else
-        {
-        volume = L.x * L.y * L.z;
-        }
-
-    // pressure: P = (N * K_B * T + W)/V
-    Scalar pressure = (2.0 * ke_trans_total / Scalar(D) + W) / volume;
-
-    // pressure tensor = (kinetic part + virial) / V
-    Scalar pressure_xx = (pressure_kinetic_xx + virial_xx) / volume;
-    Scalar pressure_xy = (pressure_kinetic_xy + virial_xy) / volume;
-    Scalar pressure_xz = (pressure_kinetic_xz + virial_xz) / volume;
-    Scalar pressure_yy = (pressure_kinetic_yy + virial_yy) / volume;
-    Scalar pressure_yz = (pressure_kinetic_yz + virial_yz) / volume;
-    Scalar pressure_zz = (pressure_kinetic_zz + virial_zz) / volume;
-
     // fill out the GlobalArray
-    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
-    h_properties.data[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
-    h_properties.data[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
-    h_properties.data[thermo_index::potential_energy] = Scalar(pe_total);
-    h_properties.data[thermo_index::pressure] = pressure;
-    h_properties.data[thermo_index::pressure_xx] = pressure_xx;
-    h_properties.data[thermo_index::pressure_xy] = pressure_xy;
-    h_properties.data[thermo_index::pressure_xz] = pressure_xz;
-    h_properties.data[thermo_index::pressure_yy] = pressure_yy;
-    h_properties.data[thermo_index::pressure_yz] = pressure_yz;
-    h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
+    if (computed & thermo_property::translational_kinetic_energy)
+        h_properties.data[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
+    if (computed & thermo_property::rotational_kinetic_energy)
+        h_properties.data[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
+    if (computed & thermo_property::potential_energy)
+        h_properties.data[thermo_index::potential_energy] = Scalar(pe_total);
+
+    if (compute_pressure)
+        {
+        // compute the pressure
+        // volume/area & other 2D stuff needed
+        BoxDim global_box = m_pdata->getGlobalBox();
+
+        Scalar3 L = global_box.getL();
+        Scalar volume;
+        unsigned int D = m_sysdef->getNDimensions();
+        if (D == 2)
+            {
+            // "volume" is area in 2D
+            volume = L.x * L.y;
+            // W needs to be corrected since the 1/3 factor is built in
+            W *= Scalar(3.0 / 2.0);
+            }
+        else
+            {
+            volume = L.x * L.y * L.z;
+            }
 
-#ifdef ENABLE_MPI
-    // in MPI, reduce extensive quantities only when they're needed
-    m_properties_reduced = !m_pdata->getDomainDecomposition();
-#endif // ENABLE_MPI
+        // pressure: P = (N * K_B * T + W)/V
+        h_properties.data[thermo_index::pressure] = (2.0 * ke_trans_total / Scalar(D) + W) / volume;
+
+        // pressure tensor = (kinetic part + virial) / V
+        h_properties.data[thermo_index::pressure_xx] = (pressure_kinetic_xx + virial_xx) / volume;
+        h_properties.data[thermo_index::pressure_xy] = (pressure_kinetic_xy + virial_xy) / volume;
+        h_properties.data[thermo_index::pressure_xz] = (pressure_kinetic_xz + virial_xz) / volume;
+        h_properties.data[thermo_index::pressure_yy] = (pressure_kinetic_yy + virial_yy) / volume;
+        h_properties.data[thermo_index::pressure_yz] = (pressure_kinetic_yz + virial_yz) / volume;
+        h_properties.data[thermo_index::pressure_zz] = (pressure_kinetic_zz + virial_zz) / volume;
+        computed |= thermo_property::pressure;
+        }
 
     if (m_prof)
         m_prof->pop();
+
+    return computed;
     }
 
 #ifdef ENABLE_MPI
+/*! Reduces the valid properties that have not been reduced yet.
+ */
 void ComputeThermo::reduceProperties()
     {
-    if (m_properties_reduced)
+    if (!m_pdata->getDomainDecomposition())
+        {
+        m_reduced_properties = m_valid_properties;
         return;
+        }
+
+    const unsigned int properties = m_valid_properties & ~m_reduced_properties;
+    if (!properties)
+        return;
+
+    // gather the indices of the properties to reduce
+    std::vector<unsigned int> indices;
+    if (properties & thermo_property::translational_kinetic_energy)
+        indices.push_back(thermo_index::translational_kinetic_energy);
+    if (properties & thermo_property::rotational_kinetic_energy)
+        indices.push_back(thermo_index::rotational_kinetic_energy);
+    if (properties & thermo_property::potential_energy)
+        indices.push_back(thermo_index::potential_energy);
+    if (properties & thermo_property::pressure)
+        {
+        for (unsigned int i = thermo_index::pressure; i <= thermo_index::pressure_zz; i++)
+            indices.push_back(i);
+        }
 
     // reduce properties
     ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
+    std::vector<Scalar> values(indices.size());
+    for (size_t i = 0; i < indices.size(); i++)
+        values[i] = h_properties.data[indices[i]];
     MPI_Allreduce(MPI_IN_PLACE,
-                  h_properties.data,
-                  thermo_index::num_quantities,
+                  values.data(),
+                  int(values.size()),
                   MPI_HOOMD_SCALAR,
                   MPI_SUM,
                   m_exec_conf->getMPICommunicator());
+    for (size_t i = 0; i < indices.size(); i++)
+        h_properties.data[indices[i]] = values[i];
 
-    m_properties_reduced = true;
+    m_reduced_properties |= properties;
     }
 #endif
 
@@ -44,6 +44,10 @@
      - number of degrees of freedom (ndof)
      - number of particles in the group
 
+    compute() does not reduce any properties. Each property is evaluated when it is first requested
+   after compute(), so a ComputeThermo that only provides the temperature never sums the virial.
+   The pressure and pressure tensor are evaluated together.
+
     ndof is utilized in calculating the temperature from the kinetic energy. setNDOF() changes it to
    any value the user desires (the default is one!). In standard usage, the python interface queries
    the number of degrees of freedom from the integrators and sets that value for each ComputeThermo
@@ -68,10 +72,8 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getTemperature()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::translational_kinetic_energy
+                 | thermo_property::rotational_kinetic_energy);
         ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
         if (m_group->getTranslationalDOF() + m_group->getRotationalDOF() > 0)
             {
@@ -92,10 +94,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getTranslationalTemperature()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::translational_kinetic_energy);
         ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
         if (m_group->getTranslationalDOF() > 0)
             {
@@ -113,10 +112,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getRotationalTemperature()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::rotational_kinetic_energy);
         // return 0.0 if the flags are not valid or we have no rotational DOF
         if (m_computed_flags[pdata_flag::rotational_kinetic_energy]
             && m_group->getRotationalDOF() > 0)
@@ -141,11 +137,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         // return NaN if the flags are not valid
         if (m_computed_flags[pdata_flag::pressure_tensor])
             {
-// return the pressure
-#ifdef ENABLE_MPI
-            if (!m_properties_reduced)
-                reduceProperties();
-#endif
+            evaluate(thermo_property::pressure);
 
             ArrayHandle<Scalar> h_properties(m_properties,
                                              access_location::host,
@@ -163,10 +155,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getTranslationalKineticEnergy()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::translational_kinetic_energy);
 
         ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
         return h_properties.data[thermo_index::translational_kinetic_energy];
@@ -177,10 +166,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getRotationalKineticEnergy()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::rotational_kinetic_energy);
 
         // return 0.0 if the flags are not valid
         if (m_computed_flags[pdata_flag::rotational_kinetic_energy])
@@ -201,10 +187,8 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getKineticEnergy()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::translational_kinetic_energy
+                 | thermo_property::rotational_kinetic_energy);
 
         // return only translational component if the flags are not valid
         ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
@@ -224,10 +208,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getPotentialEnergy()
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(thermo_property::potential_energy);
 
         ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
         return h_properties.data[thermo_index::potential_energy];
@@ -243,10 +224,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         PressureTensor p;
         if (m_computed_flags[pdata_flag::pressure_tensor])
             {
-#ifdef ENABLE_MPI
-            if (!m_properties_reduced)
-                reduceProperties();
-#endif
+            evaluate(thermo_property::pressure);
 
             ArrayHandle<Scalar> h_properties(m_properties,
                                              access_location::host,
@@ -310,12 +288,11 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         }
 
     //! Get the gpu array of properties
-    const GlobalArray<Scalar>& getProperties()
+    /*! \param properties Properties to evaluate (thermo_property flags), the others may be stale
+     */
+    const GlobalArray<Scalar>& getProperties(unsigned int properties = thermo_property::all)
         {
-#ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
-#endif
+        evaluate(properties);
 
         return m_properties;
         }
@@ -334,11 +311,21 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
+    /// Properties evaluated since the last call to compute() (thermo_property flags)
+    unsigned int m_valid_properties;
+
+    //! Evaluate the requested properties that are not yet valid
+    void evaluate(unsigned int properties);
+
     //! Does the actual computation
-    virtual void computeProperties();
+    /*! \param properties Properties to compute (thermo_property flags)
+        \returns The properties written, a superset of \a properties
+    */
+    virtual unsigned int computeProperties(unsigned int properties);
 
 #ifdef ENABLE_MPI
-    bool m_properties_reduced; //!< True if properties have been reduced across MPI
+    /// Valid properties that have been reduced across MPI (thermo_property flags)
+    unsigned int m_reduced_properties;
 
     //! Reduce properties over MPI
     virtual void reduceProperties();
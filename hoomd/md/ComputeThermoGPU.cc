@@ -18,9 +18,13 @@ namespace py = pybind11;
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 using namespace std;
 
+std::vector<ComputeThermoGPU*> ComputeThermoGPU::s_instances;
+
 /*! \param sysdef System for which to compute thermodynamic properties
     \param group Subset of the system over which properties are calculated
 */
@@ -28,7 +32,7 @@ using namespace std;
 ComputeThermoGPU::ComputeThermoGPU(std::shared_ptr<SystemDefinition> sysdef,
                                    std::shared_ptr<ParticleGroup> group)
     : ComputeThermo(sysdef, group), m_scratch(m_exec_conf), m_scratch_pressure_tensor(m_exec_conf),
-      m_scratch_rot(m_exec_conf)
+      m_scratch_rot(m_exec_conf), m_group_args(m_exec_conf)
     {
     if (!m_exec_conf->isCUDAEnabled())
         {
@@ -40,34 +44,21 @@ ComputeThermoGPU::ComputeThermoGPU(std::shared_ptr<SystemDefinition> sysdef,
     m_block_size = 256;
 
     hipEventCreateWithFlags(&m_event, hipEventDisableTiming);
+
+    s_instances.push_back(this);
     }
 
 //! Destructor
 ComputeThermoGPU::~ComputeThermoGPU()
     {
+    s_instances.erase(std::find(s_instances.begin(), s_instances.end(), this));
     hipEventDestroy(m_event);
     }
 
-/*! Computes all thermodynamic properties of the system in one fell swoop, on the GPU.
+/*! \param num_blocks Number of partial sums per property
  */
-void ComputeThermoGPU::computeProperties()
+void ComputeThermoGPU::resizeScratch(unsigned int num_blocks)
     {
-    // just drop out if the group is an empty group
-    if (m_group->getNumMembersGlobal() == 0)
-        return;
-
-    unsigned int group_size = m_group->getNumMembers();
-
-    if (m_prof)
-        m_prof->push(m_exec_conf, "Thermo");
-
-    assert(m_pdata);
-
-    // number of blocks in reduction (round up for every GPU)
-    unsigned int num_blocks
-        = m_group->getNumMembers() / m_block_size + m_exec_conf->getNumActiveGPUs();
-
-    // resize work space
     size_t old_size = m_scratch.size();
 
     m_scratch.resize(num_blocks);
@@ -116,25 +107,283 @@ void ComputeThermoGPU::computeProperties()
                   sizeof(Scalar) * m_scratch_pressure_tensor.size());
         hipMemset(d_scratch_rot.data, 0, sizeof(Scalar) * m_scratch_rot.size());
         }
+    }
 
-    // access the particle data
-    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::read);
+/*! \param args Arguments to fill out
+    \param num_blocks Number of partial sums per property
+
+    Sets all members of \a args except the array pointers.
+*/
+void ComputeThermoGPU::fillArgs(compute_thermo_args& args, unsigned int num_blocks)
+    {
+    args.n_blocks = num_blocks;
+    args.virial_pitch = m_pdata->getNetVirial().getPitch();
+    args.ndof = m_group->getTranslationalDOF();
+    args.D = m_sysdef->getNDimensions();
+    args.block_size = m_block_size;
+    args.external_virial_xx = m_pdata->getExternalVirial(0);
+    args.external_virial_xy = m_pdata->getExternalVirial(1);
+    args.external_virial_xz = m_pdata->getExternalVirial(2);
+    args.external_virial_yy = m_pdata->getExternalVirial(3);
+    args.external_virial_yz = m_pdata->getExternalVirial(4);
+    args.external_virial_zz = m_pdata->getExternalVirial(5);
+    args.external_energy = m_pdata->getExternalEnergy();
+    }
+
+/*! \param properties Properties to compute (thermo_property flags)
+    \returns The properties written
+
+    Reduces the properties of this group, and of the other pending groups found by findBatch(), on
+    the GPU.
+*/
+unsigned int ComputeThermoGPU::computeProperties(unsigned int properties)
+    {
+    // just drop out if the group is an empty group
+    if (m_group->getNumMembersGlobal() == 0)
+        return thermo_property::all;
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Thermo");
+
+    assert(m_pdata);
+
+    const unsigned int write = getPropertiesToWrite(properties);
+
+    std::vector<ComputeThermoGPU*> batch = findBatch(write);
+    if (batch.size() > 1)
+        {
+        computeBatch(batch, write);
+        }
+    else
+        {
+        unsigned int group_size = m_group->getNumMembers();
+
+        // number of blocks in reduction (round up for every GPU)
+        unsigned int num_blocks
+            = m_group->getNumMembers() / m_block_size + m_exec_conf->getNumActiveGPUs();
+        resizeScratch(num_blocks);
+
+            { // scope the array handles so they are released before the final sums
+            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                       access_location::device,
+                                       access_mode::read);
+            ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                             access_location::device,
+                                             access_mode::read);
+            ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                             access_location::device,
+                                             access_mode::read);
+            ArrayHandle<Scalar> d_net_virial(m_pdata->getNetVirial(),
+                                             access_location::device,
+                                             access_mode::read);
+            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                               access_location::device,
+                                               access_mode::read);
+            ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
+                                          access_location::device,
+                                          access_mode::read);
+            ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> d_scratch(m_scratch,
+                                           access_location::device,
+                                           access_mode::overwrite);
+            ArrayHandle<Scalar> d_scratch_pressure_tensor(m_scratch_pressure_tensor,
+                                                          access_location::device,
+                                                          access_mode::overwrite);
+            ArrayHandle<Scalar> d_scratch_rot(m_scratch_rot,
+                                              access_location::device,
+                                              access_mode::overwrite);
+            ArrayHandle<Scalar> d_properties(m_properties,
+                                             access_location::device,
+                                             access_mode::readwrite);
+
+            // access the group
+            ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                    access_location::device,
+                                                    access_mode::read);
+
+            m_exec_conf->beginMultiGPU();
+
+            // build up args list
+            compute_thermo_args args;
+            fillArgs(args, num_blocks);
+            args.d_net_force = d_net_force.data;
+            args.d_net_virial = d_net_virial.data;
+            args.d_orientation = d_orientation.data;
+            args.d_angmom = d_angmom.data;
+            args.d_inertia = d_inertia.data;
+            args.d_scratch = d_scratch.data;
+            args.d_scratch_pressure_tensor = d_scratch_pressure_tensor.data;
+            args.d_scratch_rot = d_scratch_rot.data;
+
+            // perform the computation on the GPU(s)
+            gpu_compute_thermo_partial(d_properties.data,
+                                       d_vel.data,
+                                       d_body.data,
+                                       d_tag.data,
+                                       d_index_array.data,
+                                       group_size,
+                                       m_pdata->getGlobalBox(),
+                                       args,
+                                       m_computed_flags[pdata_flag::pressure_tensor]
+                                           && (write & thermo_property::pressure),
+                                       m_computed_flags[pdata_flag::rotational_kinetic_energy]
+                                           && (write & thermo_property::rotational_kinetic_energy),
+                                       m_group->getGPUPartition());
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            // converge GPUs
+            m_exec_conf->endMultiGPU();
+            }
+
+        // perform the final sums on GPU 0
+        computeFinalSums(num_blocks, write);
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+
+    return write;
+    }
+
+/*! \param num_blocks Number of partial sums per property in the scratch space
+    \param properties Properties to write (thermo_property flags)
+*/
+void ComputeThermoGPU::computeFinalSums(unsigned int num_blocks, unsigned int properties)
+    {
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
                                      access_location::device,
                                      access_mode::read);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
-    BoxDim box = m_pdata->getGlobalBox();
+    ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar> d_net_virial(m_pdata->getNetVirial(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> d_scratch(m_scratch, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_scratch_pressure_tensor(m_scratch_pressure_tensor,
+                                                  access_location::device,
+                                                  access_mode::read);
+    ArrayHandle<Scalar> d_scratch_rot(m_scratch_rot, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_properties(m_properties, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                            access_location::device,
+                                            access_mode::read);
+
+    compute_thermo_args args;
+    fillArgs(args, num_blocks);
+    args.d_net_force = d_net_force.data;
+    args.d_net_virial = d_net_virial.data;
+    args.d_orientation = NULL;
+    args.d_angmom = NULL;
+    args.d_inertia = NULL;
+    args.d_scratch = d_scratch.data;
+    args.d_scratch_pressure_tensor = d_scratch_pressure_tensor.data;
+    args.d_scratch_rot = d_scratch_rot.data;
+
+    gpu_compute_thermo_final(d_properties.data,
+                             d_vel.data,
+                             d_body.data,
+                             d_tag.data,
+                             d_index_array.data,
+                             m_group->getNumMembers(),
+                             m_pdata->getGlobalBox(),
+                             args,
+                             m_computed_flags[pdata_flag::pressure_tensor],
+                             m_computed_flags[pdata_flag::rotational_kinetic_energy],
+                             properties);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param properties Properties this instance is about to compute (thermo_property flags)
+    \returns This instance followed by the other instances to compute in the same pass
+
+    The other instances must belong to the same system, have been computed at the same time step
+    with the same particle data flags, and have at least one of \a properties pending.
+*/
+std::vector<ComputeThermoGPU*> ComputeThermoGPU::findBatch(unsigned int properties)
+    {
+    std::vector<ComputeThermoGPU*> batch;
+    batch.push_back(this);
+
+    // the batched kernel runs on a single GPU
+    if (m_exec_conf->getNumActiveGPUs() > 1)
+        return batch;
+
+    for (ComputeThermoGPU* other : s_instances)
+        {
+        if (other == this || other->m_sysdef != m_sysdef || other->m_first_compute
+            || other->m_last_computed != m_last_computed
+            || other->m_computed_flags != m_computed_flags)
+            continue;
 
-    PDataFlags flags = m_pdata->getFlags();
+        if ((other->getPropertiesToWrite(properties) & properties) == 0
+            || other->m_group->getNumMembersGlobal() == 0)
+            continue;
 
-        { // scope these array handles so they are released before the additional terms are added
-        // access the net force, pe, and virial
-        const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
-        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
-        ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
-        ArrayHandle<Scalar> d_net_virial(net_virial, access_location::device, access_mode::read);
+        batch.push_back(other);
+        }
+
+    return batch;
+    }
+
+/*! \param batch Instances to compute, starting with this one
+    \param properties Properties requested from this instance (thermo_property flags)
+
+    gpu_compute_thermo_multi_partial sums the contributions of every local particle to all groups
+    of the batch in one pass. Each instance then completes its own partial sums.
+*/
+void ComputeThermoGPU::computeBatch(const std::vector<ComputeThermoGPU*>& batch,
+                                    unsigned int properties)
+    {
+    const unsigned int N = m_pdata->getN();
+    const unsigned int num_blocks = N / m_block_size + 1;
+
+    // the properties written by each instance, and the partial sums needed by any of them
+    std::vector<unsigned int> write(batch.size());
+    bool compute_pressure_tensor = false;
+    bool compute_rotational_energy = false;
+    for (size_t i = 0; i < batch.size(); i++)
+        {
+        write[i] = batch[i]->getPropertiesToWrite(properties);
+        compute_pressure_tensor = compute_pressure_tensor
+                                  || (m_computed_flags[pdata_flag::pressure_tensor]
+                                      && (write[i] & thermo_property::pressure));
+        compute_rotational_energy
+            = compute_rotational_energy
+              || (m_computed_flags[pdata_flag::rotational_kinetic_energy]
+                  && (write[i] & thermo_property::rotational_kinetic_energy));
+        batch[i]->resizeScratch(num_blocks);
+        }
+
+    m_group_args.resize(batch.size());
+
+        {
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<Scalar> d_net_virial(m_pdata->getNetVirial(),
+                                         access_location::device,
+                                         access_mode::read);
         ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
                                            access_location::device,
                                            access_mode::read);
@@ -144,89 +393,79 @@ void ComputeThermoGPU::computeProperties()
         ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
                                        access_location::device,
                                        access_mode::read);
-        ArrayHandle<Scalar4> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
-        ArrayHandle<Scalar> d_scratch_pressure_tensor(m_scratch_pressure_tensor,
-                                                      access_location::device,
-                                                      access_mode::overwrite);
-        ArrayHandle<Scalar> d_scratch_rot(m_scratch_rot,
-                                          access_location::device,
-                                          access_mode::overwrite);
-        ArrayHandle<Scalar> d_properties(m_properties,
-                                         access_location::device,
-                                         access_mode::overwrite);
 
-        // access the group
-        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
+        // hold the arrays of every group while the kernel runs
+        std::vector<std::unique_ptr<ArrayHandle<unsigned int>>> member_handles;
+        std::vector<std::unique_ptr<ArrayHandle<Scalar4>>> scratch_handles;
+        std::vector<std::unique_ptr<ArrayHandle<Scalar>>> scratch_pressure_tensor_handles;
+        std::vector<std::unique_ptr<ArrayHandle<Scalar>>> scratch_rot_handles;
 
-        m_exec_conf->beginMultiGPU();
+            {
+            ArrayHandle<compute_thermo_group_args> h_group_args(m_group_args,
+                                                                access_location::host,
+                                                                access_mode::overwrite);
+            for (size_t i = 0; i < batch.size(); i++)
+                {
+                member_handles.emplace_back(
+                    new ArrayHandle<unsigned int>(batch[i]->m_group->getMemberFlagArray(),
+                                                  access_location::device,
+                                                  access_mode::read));
+                scratch_handles.emplace_back(new ArrayHandle<Scalar4>(batch[i]->m_scratch,
+                                                                      access_location::device,
+                                                                      access_mode::overwrite));
+                scratch_pressure_tensor_handles.emplace_back(
+                    new ArrayHandle<Scalar>(batch[i]->m_scratch_pressure_tensor,
+                                            access_location::device,
+                                            access_mode::overwrite));
+                scratch_rot_handles.emplace_back(new ArrayHandle<Scalar>(batch[i]->m_scratch_rot,
+                                                                         access_location::device,
+                                                                         access_mode::overwrite));
+
+                h_group_args.data[i].d_is_member = member_handles.back()->data;
+                h_group_args.data[i].d_scratch = scratch_handles.back()->data;
+                h_group_args.data[i].d_scratch_pressure_tensor
+                    = scratch_pressure_tensor_handles.back()->data;
+                h_group_args.data[i].d_scratch_rot = scratch_rot_handles.back()->data;
+                }
+            }
+
+        ArrayHandle<compute_thermo_group_args> d_group_args(m_group_args,
+                                                            access_location::device,
+                                                            access_mode::read);
 
-        // build up args list
         compute_thermo_args args;
-        args.n_blocks = num_blocks;
+        fillArgs(args, num_blocks);
         args.d_net_force = d_net_force.data;
         args.d_net_virial = d_net_virial.data;
         args.d_orientation = d_orientation.data;
         args.d_angmom = d_angmom.data;
         args.d_inertia = d_inertia.data;
-        args.virial_pitch = net_virial.getPitch();
-        args.ndof = m_group->getTranslationalDOF();
-        args.D = m_sysdef->getNDimensions();
-        args.d_scratch = d_scratch.data;
-        args.d_scratch_pressure_tensor = d_scratch_pressure_tensor.data;
-        args.d_scratch_rot = d_scratch_rot.data;
-        args.block_size = m_block_size;
-        args.external_virial_xx = m_pdata->getExternalVirial(0);
-        args.external_virial_xy = m_pdata->getExternalVirial(1);
-        args.external_virial_xz = m_pdata->getExternalVirial(2);
-        args.external_virial_yy = m_pdata->getExternalVirial(3);
-        args.external_virial_yz = m_pdata->getExternalVirial(4);
-        args.external_virial_zz = m_pdata->getExternalVirial(5);
-        args.external_energy = m_pdata->getExternalEnergy();
-
-        // perform the computation on the GPU(s)
-        gpu_compute_thermo_partial(d_properties.data,
-                                   d_vel.data,
-                                   d_body.data,
-                                   d_tag.data,
-                                   d_index_array.data,
-                                   group_size,
-                                   box,
-                                   args,
-                                   flags[pdata_flag::pressure_tensor],
-                                   flags[pdata_flag::rotational_kinetic_energy],
-                                   m_group->getGPUPartition());
-
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-
-        // converge GPUs
-        m_exec_conf->endMultiGPU();
-
-        // perform the computation on GPU 0
-        gpu_compute_thermo_final(d_properties.data,
-                                 d_vel.data,
-                                 d_body.data,
-                                 d_tag.data,
-                                 d_index_array.data,
-                                 group_size,
-                                 box,
-                                 args,
-                                 flags[pdata_flag::pressure_tensor],
-                                 flags[pdata_flag::rotational_kinetic_energy]);
+        args.d_scratch = NULL;
+        args.d_scratch_pressure_tensor = NULL;
+        args.d_scratch_rot = NULL;
+
+        gpu_compute_thermo_multi_partial(d_group_args.data,
+                                         (unsigned int)batch.size(),
+                                         d_vel.data,
+                                         d_body.data,
+                                         d_tag.data,
+                                         N,
+                                         args,
+                                         compute_pressure_tensor,
+                                         compute_rotational_energy);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         }
 
-#ifdef ENABLE_MPI
-    // in MPI, reduce extensive quantities only when they're needed
-    m_properties_reduced = !m_pdata->getDomainDecomposition();
-#endif // ENABLE_MPI
+    for (size_t i = 0; i < batch.size(); i++)
+        {
+        batch[i]->computeFinalSums(num_blocks, write[i]);
 
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
+        // the caller marks the properties of this instance valid
+        if (batch[i] != this)
+            batch[i]->m_valid_properties |= write[i];
+        }
     }
 
 void export_ComputeThermoGPU(py::module& m)
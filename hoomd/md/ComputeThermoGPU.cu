@@ -299,6 +299,152 @@ __global__ void gpu_compute_rotational_ke_partial_sums(Scalar* d_scratch,
         }
     }
 
+//! Perform partial sums of the thermo properties of several groups in one pass
+/*! \param d_groups Membership flags and scratch space of each group
+    \param n_groups Number of groups
+    \param d_net_force Net force / pe array from ParticleData
+    \param d_net_virial Net virial array from ParticleData
+    \param virial_pitch pitch of 2D virial array
+    \param d_velocity Particle velocity and mass array from ParticleData
+    \param d_orientation Orientation quaternions from ParticleData
+    \param d_angmom Conjugate quaternions from ParticleData
+    \param d_inertia Moments of inertia from ParticleData
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param N Number of local particles
+    \param num_blocks Number of blocks, the stride of the pressure tensor partial sums
+    \param compute_pressure_tensor whether to compute the full pressure tensor
+    \param compute_rotational_energy whether to compute the rotational kinetic energy
+
+    One thread is executed per local particle. Each thread computes the contributions of its
+   particle once and the block then reduces them for every group the particle is a member of. The
+   partial sums are written to the scratch space of each group in the same layout as
+   gpu_compute_thermo_partial_sums, gpu_compute_pressure_tensor_partial_sums, and
+   gpu_compute_rotational_ke_partial_sums write, so that gpu_compute_thermo_final can complete them.
+   10*sizeof(Scalar)*block_size bytes of dynamic shared memory are needed.
+*/
+__global__ void gpu_compute_thermo_multi_partial_sums(const compute_thermo_group_args* d_groups,
+                                                      unsigned int n_groups,
+                                                      const Scalar4* d_net_force,
+                                                      const Scalar* d_net_virial,
+                                                      const size_t virial_pitch,
+                                                      const Scalar4* d_velocity,
+                                                      const Scalar4* d_orientation,
+                                                      const Scalar4* d_angmom,
+                                                      const Scalar3* d_inertia,
+                                                      const unsigned int* d_body,
+                                                      const unsigned int* d_tag,
+                                                      unsigned int N,
+                                                      unsigned int num_blocks,
+                                                      bool compute_pressure_tensor,
+                                                      bool compute_rotational_energy)
+    {
+    extern __shared__ Scalar compute_thermo_multi_sdata[];
+
+    // 2*KE, PE, W, the six components of the pressure tensor, and the rotational KE
+    const unsigned int num_values = 10;
+
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    Scalar my_element[num_values];
+    for (unsigned int i = 0; i < num_values; i++)
+        my_element[i] = Scalar(0.0);
+
+    bool active = false;
+    if (idx < N)
+        {
+        // ignore rigid body constituent particles in the sum
+        unsigned int body = d_body[idx];
+        unsigned int tag = d_tag[idx];
+        if (body >= MIN_FLOPPY || body == tag)
+            {
+            active = true;
+
+            Scalar4 vel = d_velocity[idx];
+            Scalar mass = vel.w;
+            my_element[0] = mass * (vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
+            my_element[1] = d_net_force[idx].w;
+            my_element[2] = Scalar(1.0 / 3.0)
+                            * (d_net_virial[0 * virial_pitch + idx]
+                               + d_net_virial[3 * virial_pitch + idx]
+                               + d_net_virial[5 * virial_pitch + idx]);
+
+            if (compute_pressure_tensor)
+                {
+                my_element[3] = mass * vel.x * vel.x + d_net_virial[0 * virial_pitch + idx];
+                my_element[4] = mass * vel.x * vel.y + d_net_virial[1 * virial_pitch + idx];
+                my_element[5] = mass * vel.x * vel.z + d_net_virial[2 * virial_pitch + idx];
+                my_element[6] = mass * vel.y * vel.y + d_net_virial[3 * virial_pitch + idx];
+                my_element[7] = mass * vel.y * vel.z + d_net_virial[4 * virial_pitch + idx];
+                my_element[8] = mass * vel.z * vel.z + d_net_virial[5 * virial_pitch + idx];
+                }
+
+            if (compute_rotational_energy)
+                {
+                quat<Scalar> q(d_orientation[idx]);
+                quat<Scalar> p(d_angmom[idx]);
+                vec3<Scalar> I(d_inertia[idx]);
+                quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+
+                Scalar ke_rot(0.0);
+                if (I.x >= EPSILON)
+                    ke_rot += s.v.x * s.v.x / I.x;
+                if (I.y >= EPSILON)
+                    ke_rot += s.v.y * s.v.y / I.y;
+                if (I.z >= EPSILON)
+                    ke_rot += s.v.z * s.v.z / I.z;
+                my_element[9] = ke_rot * Scalar(1.0 / 2.0);
+                }
+            }
+        }
+
+    for (unsigned int group = 0; group < n_groups; group++)
+        {
+        const compute_thermo_group_args group_args = d_groups[group];
+        bool member = active && group_args.d_is_member[idx] == 1;
+
+        for (unsigned int i = 0; i < num_values; i++)
+            compute_thermo_multi_sdata[i * blockDim.x + threadIdx.x]
+                = member ? my_element[i] : Scalar(0.0);
+        __syncthreads();
+
+        // reduce the sum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                {
+                for (unsigned int i = 0; i < num_values; i++)
+                    compute_thermo_multi_sdata[i * blockDim.x + threadIdx.x]
+                        += compute_thermo_multi_sdata[i * blockDim.x + threadIdx.x + offs];
+                }
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        // write out the partial sums of this group
+        if (threadIdx.x == 0)
+            {
+            group_args.d_scratch[blockIdx.x]
+                = make_scalar4(compute_thermo_multi_sdata[0 * blockDim.x],
+                               compute_thermo_multi_sdata[1 * blockDim.x],
+                               compute_thermo_multi_sdata[2 * blockDim.x],
+                               0);
+            if (compute_pressure_tensor)
+                {
+                for (unsigned int i = 0; i < 6; i++)
+                    group_args.d_scratch_pressure_tensor[num_blocks * i + blockIdx.x]
+                        = compute_thermo_multi_sdata[(i + 3) * blockDim.x];
+                }
+            if (compute_rotational_energy)
+                group_args.d_scratch_rot[blockIdx.x] = compute_thermo_multi_sdata[9 * blockDim.x];
+            }
+
+        // the next group reuses the shared memory
+        __syncthreads();
+        }
+    }
+
 //! Complete partial sums and compute final thermodynamic quantities (for pressure, only isotropic
 //! contribution)
 /*! \param d_properties Property array to write final values
@@ -311,6 +457,8 @@ __global__ void gpu_compute_rotational_ke_partial_sums(Scalar* d_scratch,
     \param num_partial_sums Number of partial sums in \a d_scratch
     \param external_virial External contribution to virial (1/3 trace)
     \param external_energy External contribution to potential energy
+    \param properties Properties to write (thermo_property flags)
+    \param compute_rotational_energy True when d_scratch_rot holds valid partial sums
 
 
     Only one block is executed. In that block, the partial sums are read in and reduced to final
@@ -328,10 +476,15 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
                                               unsigned int group_size,
                                               unsigned int num_partial_sums,
                                               Scalar external_virial,
-                                              Scalar external_energy)
+                                              Scalar external_energy,
+                                              unsigned int properties,
+                                              bool compute_rotational_energy)
     {
     extern __shared__ Scalar4 compute_thermo_final_sdata[];
 
+    const bool sum_rotational_energy
+        = compute_rotational_energy && (properties & thermo_property::rotational_kinetic_energy);
+
     Scalar4 final_sum = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
     // sum up the values in the partial sum via a sliding window
@@ -341,7 +494,7 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
         if (start + threadIdx.x < num_partial_sums)
             {
             Scalar4 scratch = d_scratch[start + threadIdx.x];
-            Scalar scratch_rot = d_scratch_rot[start + threadIdx.x];
+            Scalar scratch_rot = sum_rotational_energy ? d_scratch_rot[start + threadIdx.x] : 0;
 
             compute_thermo_final_sdata[threadIdx.x]
                 = make_scalar4(scratch.x, scratch.y, scratch.z, scratch_rot);
@@ -408,11 +561,15 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
         // pressure: P = (N * K_B * T + W)/V
         Scalar pressure = (Scalar(2.0) * ke_trans_total / Scalar(D) + W) / volume;
 
-        // fill out the GPUArray
-        d_properties[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
-        d_properties[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
-        d_properties[thermo_index::potential_energy] = Scalar(pe_total);
-        d_properties[thermo_index::pressure] = pressure;
+        // fill out the GPUArray, leaving the properties that are already valid untouched
+        if (properties & thermo_property::translational_kinetic_energy)
+            d_properties[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
+        if (properties & thermo_property::rotational_kinetic_energy)
+            d_properties[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
+        if (properties & thermo_property::potential_energy)
+            d_properties[thermo_index::potential_energy] = Scalar(pe_total);
+        if (properties & thermo_property::pressure)
+            d_properties[thermo_index::pressure] = pressure;
         }
     }
 
@@ -636,6 +793,61 @@ hipError_t gpu_compute_thermo_partial(Scalar* d_properties,
     return hipSuccess;
     }
 
+//! Compute partial sums of thermodynamic properties of several groups on the GPU
+/*! \param d_groups Membership flags and scratch space of each group
+    \param n_groups Number of groups
+    \param d_vel particle velocities and masses on the GPU
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param N Number of local particles
+    \param args Additional arguments, the scratch pointers are ignored
+    \param compute_pressure_tensor whether to compute the full pressure tensor
+    \param compute_rotational_energy whether to compute the rotational kinetic energy
+
+    Every group's scratch space must hold args.n_blocks >= N / args.block_size + 1 partial sums.
+    Complete the sums of each group with gpu_compute_thermo_final.
+*/
+hipError_t gpu_compute_thermo_multi_partial(const compute_thermo_group_args* d_groups,
+                                            unsigned int n_groups,
+                                            Scalar4* d_vel,
+                                            unsigned int* d_body,
+                                            unsigned int* d_tag,
+                                            unsigned int N,
+                                            const compute_thermo_args& args,
+                                            bool compute_pressure_tensor,
+                                            bool compute_rotational_energy)
+    {
+    assert(d_groups);
+    assert(args.n_blocks * args.block_size >= N);
+
+    dim3 grid(args.n_blocks, 1, 1);
+    dim3 threads(args.block_size, 1, 1);
+    size_t shared_bytes = 10 * sizeof(Scalar) * args.block_size;
+
+    hipLaunchKernelGGL(gpu_compute_thermo_multi_partial_sums,
+                       dim3(grid),
+                       dim3(threads),
+                       shared_bytes,
+                       0,
+                       d_groups,
+                       n_groups,
+                       args.d_net_force,
+                       args.d_net_virial,
+                       args.virial_pitch,
+                       d_vel,
+                       args.d_orientation,
+                       args.d_angmom,
+                       args.d_inertia,
+                       d_body,
+                       d_tag,
+                       N,
+                       args.n_blocks,
+                       compute_pressure_tensor,
+                       compute_rotational_energy);
+
+    return hipSuccess;
+    }
+
 //! Compute thermodynamic properties of a group on the GPU
 /*! \param d_properties Array to write computed properties
     \param d_vel particle velocities and masses on the GPU
@@ -647,7 +859,7 @@ hipError_t gpu_compute_thermo_partial(Scalar* d_properties,
     \param args Additional arguments
     \param compute_pressure_tensor whether to compute the full pressure tensor
     \param compute_rotational_energy whether to compute the rotational kinetic energy
-    \param num_blocks Number of partial sums to reduce
+    \param properties Properties to write (thermo_property flags)
 
     This function drives gpu_compute_thermo_partial_sums and gpu_compute_thermo_final_sums, see them
    for details.
@@ -662,7 +874,8 @@ hipError_t gpu_compute_thermo_final(Scalar* d_properties,
                                     const BoxDim& box,
                                     const compute_thermo_args& args,
                                     bool compute_pressure_tensor,
-                                    bool compute_rotational_energy)
+                                    bool compute_rotational_energy,
+                                    unsigned int properties)
     {
     assert(d_properties);
     assert(d_vel);
@@ -697,9 +910,11 @@ hipError_t gpu_compute_thermo_final(Scalar* d_properties,
                        group_size,
                        args.n_blocks,
                        external_virial,
-                       args.external_energy);
+                       args.external_energy,
+                       properties,
+                       compute_rotational_energy);
 
-    if (compute_pressure_tensor)
+    if (compute_pressure_tensor && (properties & thermo_property::pressure))
         {
         shared_bytes = 6 * sizeof(Scalar) * final_block_size;
         // run the kernel
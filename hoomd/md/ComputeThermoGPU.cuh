@@ -41,6 +41,15 @@ struct compute_thermo_args
     Scalar external_energy;    //!< External potential energy
     };
 
+//! Per group arguments to gpu_compute_thermo_multi_partial
+struct compute_thermo_group_args
+    {
+    const unsigned int* d_is_member;   //!< Membership flag of each local particle
+    Scalar4* d_scratch;                //!< n_blocks partial sums of 2*KE, PE, and W
+    Scalar* d_scratch_pressure_tensor; //!< n_blocks*6 partial sums of the pressure tensor
+    Scalar* d_scratch_rot;             //!< n_blocks partial sums of the rotational kinetic energy
+    };
+
 //! Computes the partial sums of thermodynamic properties for ComputeThermo
 hipError_t gpu_compute_thermo_partial(Scalar* d_properties,
                                       Scalar4* d_vel,
@@ -54,6 +63,17 @@ hipError_t gpu_compute_thermo_partial(Scalar* d_properties,
                                       bool compute_rotational_energy,
                                       const GPUPartition& gpu_partition);
 
+//! Computes the partial sums of thermodynamic properties of several groups in one pass
+hipError_t gpu_compute_thermo_multi_partial(const compute_thermo_group_args* d_groups,
+                                            unsigned int n_groups,
+                                            Scalar4* d_vel,
+                                            unsigned int* d_body,
+                                            unsigned int* d_tag,
+                                            unsigned int N,
+                                            const compute_thermo_args& args,
+                                            bool compute_pressure_tensor,
+                                            bool compute_rotational_energy);
+
 //! Computes the final sums of thermodynamic properties for ComputeThermo
 hipError_t gpu_compute_thermo_final(Scalar* d_properties,
                                     Scalar4* d_vel,
@@ -64,6 +84,7 @@ hipError_t gpu_compute_thermo_final(Scalar* d_properties,
                                     const BoxDim& box,
                                     const compute_thermo_args& args,
                                     bool compute_pressure_tensor,
-                                    bool compute_rotational_energy);
+                                    bool compute_rotational_energy,
+                                    unsigned int properties);
 
 #endif
@@ -4,6 +4,9 @@
 // Maintainer: joaander
 
 #include "ComputeThermo.h"
+#include "ComputeThermoGPU.cuh"
+
+#include <vector>
 
 /*! \file ComputeThermoGPU.h
     \brief Declares a class for computing thermodynamic quantities on the GPU
@@ -20,6 +23,13 @@
 
 //! Computes thermodynamic properties of a group of particles on the GPU
 /*! ComputeThermoGPU is a GPU accelerated implementation of ComputeThermo
+
+    All ComputeThermoGPU instances register themselves in a list. When one instance evaluates its
+    properties, it also evaluates the same properties of the other instances on the same system
+    that were computed at the same time step and are still pending. One kernel pass over the local
+    particles reduces all of these groups, instead of one pass per group. The batch is only formed
+    on a single GPU.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT ComputeThermoGPU : public ComputeThermo
@@ -39,8 +49,38 @@ class PYBIND11_EXPORT ComputeThermoGPU : public ComputeThermo
     unsigned int m_block_size; //!< Block size executed
     hipEvent_t m_event;        //!< CUDA event for synchronization
 
+    /// Per group arguments of the batched reduction
+    GlobalVector<compute_thermo_group_args> m_group_args;
+
+    /// All ComputeThermoGPU instances
+    static std::vector<ComputeThermoGPU*> s_instances;
+
     //! Does the actual computation
-    virtual void computeProperties();
+    virtual unsigned int computeProperties(unsigned int properties);
+
+    //! Get the pending instances that can be reduced together with this one
+    std::vector<ComputeThermoGPU*> findBatch(unsigned int properties);
+
+    //! Compute the properties of several instances in one pass
+    void computeBatch(const std::vector<ComputeThermoGPU*>& batch, unsigned int properties);
+
+    //! Resize the scratch space
+    void resizeScratch(unsigned int num_blocks);
+
+    //! Fill out the arguments to the kernel drivers
+    void fillArgs(compute_thermo_args& args, unsigned int num_blocks);
+
+    //! Complete the partial sums in the scratch space
+    void computeFinalSums(unsigned int num_blocks, unsigned int properties);
+
+    //! Get the properties to write when \a properties are requested
+    unsigned int getPropertiesToWrite(unsigned int properties) const
+        {
+        // the kinetic and potential energy are summed in the same pass as the pressure
+        return (properties | thermo_property::translational_kinetic_energy
+                | thermo_property::potential_energy)
+               & ~m_valid_properties;
+        }
     };
 
 //! Exports the ComputeThermoGPU class to python
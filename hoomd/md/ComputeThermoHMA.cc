@@ -74,11 +74,41 @@ ComputeThermoHMA::ComputeThermoHMA(std::shared_ptr<SystemDefinition> sysdef,
         vec3<Scalar> unwrapped = box.shift(pos, snapshot.image[tag]);
         h_lattice_site.data[tag] = make_scalar3(unwrapped.x, unwrapped.y, unwrapped.z);
         }
+
+    GlobalArray<Scalar3> lat_index(m_pdata->getMaxN(), m_exec_conf);
+    m_lattice_site_index.swap(lat_index);
+    TAG_ALLOCATION(m_lattice_site_index);
+
+    m_pdata->getParticleSortSignal()
+        .connect<ComputeThermoHMA, &ComputeThermoHMA::slotParticleSort>(this);
     }
 
 ComputeThermoHMA::~ComputeThermoHMA()
     {
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermoHMA" << endl;
+
+    m_pdata->getParticleSortSignal()
+        .disconnect<ComputeThermoHMA, &ComputeThermoHMA::slotParticleSort>(this);
+    }
+
+/*! Gathers the lattice sites of the local particles into m_lattice_site_index after the particles
+    have been sorted, added, or removed.
+*/
+void ComputeThermoHMA::updateLatticeSiteIndex()
+    {
+    if (m_lattice_site_index.getNumElements() < m_pdata->getMaxN())
+        m_lattice_site_index.resize(m_pdata->getMaxN());
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_lattice_site(m_lattice_site, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_lattice_site_index(m_lattice_site_index,
+                                              access_location::host,
+                                              access_mode::overwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        h_lattice_site_index.data[i] = h_lattice_site.data[h_tag.data[i]];
+
+    m_lattice_site_index_valid = true;
     }
 
 /*! Calls computeProperties if the properties need updating
@@ -108,6 +138,9 @@ void ComputeThermoHMA::computeProperties()
 
     assert(m_pdata);
 
+    if (!m_lattice_site_index_valid)
+        updateLatticeSiteIndex();
+
     // access the net force, pe, and virial
     const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
@@ -115,8 +148,9 @@ void ComputeThermoHMA::computeProperties()
                                      access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar3> h_lattice_site(m_lattice_site, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_lattice_site(m_lattice_site_index,
+                                        access_location::host,
+                                        access_mode::read);
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
 
     // total potential energy
@@ -141,20 +175,19 @@ void ComputeThermoHMA::computeProperties()
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int tag = h_tag.data[group_idx];
         pe_total += (double)h_net_force.data[j].w;
         W += Scalar(1. / D)
              * ((double)h_net_virial.data[j + 0 * virial_pitch]
                 + (double)h_net_virial.data[j + 3 * virial_pitch]
                 + (double)h_net_virial.data[j + 5 * virial_pitch]);
 
-        Scalar4 pos4 = h_pos.data[group_idx];
+        Scalar4 pos4 = h_pos.data[j];
         Scalar3 pos3 = make_scalar3(pos4.x, pos4.y, pos4.z);
-        Scalar3 dr = box.shift(pos3, h_image.data[group_idx]) - h_lattice_site.data[tag];
+        Scalar3 dr = box.shift(pos3, h_image.data[j]) - h_lattice_site.data[j];
         double fdr = 0;
-        fdr += (double)h_net_force.data[group_idx].x * dr.x;
-        fdr += (double)h_net_force.data[group_idx].y * dr.y;
-        fdr += (double)h_net_force.data[group_idx].z * dr.z;
+        fdr += (double)h_net_force.data[j].x * dr.x;
+        fdr += (double)h_net_force.data[j].y * dr.y;
+        fdr += (double)h_net_force.data[j].z * dr.z;
         pe_total += 0.5 * fdr;
         p_HMA += fV * fdr;
         }
@@ -134,7 +134,10 @@ class PYBIND11_EXPORT ComputeThermoHMA : public Compute
         }
 
     //! Method to be called when particles are added/removed/sorted
-    void slotParticleSort();
+    void slotParticleSort()
+        {
+        m_lattice_site_index_valid = false;
+        }
 
     protected:
     std::shared_ptr<ParticleGroup> m_group; //!< Group to compute properties for
@@ -151,7 +154,19 @@ class PYBIND11_EXPORT ComputeThermoHMA : public Compute
 #endif
 
     Scalar m_temperature, m_harmonicPressure;
-    GlobalArray<Scalar3> m_lattice_site;
+    GlobalArray<Scalar3> m_lattice_site; //!< Lattice sites by particle tag
+
+    /// Lattice sites by local particle index
+    /** The sites follow the particles when they are sorted or migrate, so that the reduction reads
+        them in the same order as the positions.
+    */
+    GlobalArray<Scalar3> m_lattice_site_index;
+
+    /// True when m_lattice_site_index matches the current particle order
+    bool m_lattice_site_index_valid = false;
+
+    //! Gather the lattice sites of the local particles by index
+    virtual void updateLatticeSiteIndex();
     };
 
 //! Exports the ComputeThermoHMA class to python
@@ -57,6 +57,10 @@ ComputeThermoHMAGPU::ComputeThermoHMAGPU(std::shared_ptr<SystemDefinition> sysde
                           sizeof(Scalar3) * m_lattice_site.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
                           gpu_map[idev]);
+            cudaMemAdvise(m_lattice_site_index.get(),
+                          sizeof(Scalar3) * m_lattice_site_index.getNumElements(),
+                          cudaMemAdviseSetAccessedBy,
+                          gpu_map[idev]);
             }
         CHECK_CUDA_ERROR();
         }
@@ -71,6 +75,32 @@ ComputeThermoHMAGPU::~ComputeThermoHMAGPU()
     hipEventDestroy(m_event);
     }
 
+/*! Gathers the lattice sites of the local particles into m_lattice_site_index on the GPU after the
+    particles have been sorted, added, or removed.
+*/
+void ComputeThermoHMAGPU::updateLatticeSiteIndex()
+    {
+    if (m_lattice_site_index.getNumElements() < m_pdata->getMaxN())
+        m_lattice_site_index.resize(m_pdata->getMaxN());
+
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_lattice_site(m_lattice_site, access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_lattice_site_index(m_lattice_site_index,
+                                              access_location::device,
+                                              access_mode::overwrite);
+
+    gpu_gather_lattice_sites(d_lattice_site_index.data,
+                             d_lattice_site.data,
+                             d_tag.data,
+                             m_pdata->getN(),
+                             m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_lattice_site_index_valid = true;
+    }
+
 /*! Computes all thermodynamic properties of the system in one fell swoop, on the GPU.
  */
 void ComputeThermoHMAGPU::computeProperties()
@@ -86,6 +116,9 @@ void ComputeThermoHMAGPU::computeProperties()
 
     assert(m_pdata);
 
+    if (!m_lattice_site_index_valid)
+        updateLatticeSiteIndex();
+
     // number of blocks in reduction (round up for every GPU)
     unsigned int num_blocks
         = m_group->getNumMembers() / m_block_size + m_exec_conf->getNumActiveGPUs();
@@ -126,7 +159,9 @@ void ComputeThermoHMAGPU::computeProperties()
                                      access_location::device,
                                      access_mode::read);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
-    ArrayHandle<Scalar3> d_lattice_site(m_lattice_site, access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_lattice_site(m_lattice_site_index,
+                                        access_location::device,
+                                        access_mode::read);
     ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
     BoxDim box = m_pdata->getGlobalBox();
 
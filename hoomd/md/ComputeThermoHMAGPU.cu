@@ -25,7 +25,7 @@ extern __shared__ Scalar3 compute_thermo_hma_final_sdata[];
     \param d_net_virial Net virial array from ParticleData
     \param virial_pitch pitch of 2D virial array
     \param d_position Particle position array from ParticleData
-    \param d_lattice_site Particle lattice site array
+    \param d_lattice_site Lattice site of each particle, by index
     \param d_image Image array from ParticleData
     \param d_body Particle body id
     \param d_tag Particle tag
@@ -86,7 +86,7 @@ __global__ void gpu_compute_thermo_hma_partial_sums(Scalar3* d_scratch,
                                       + d_net_virial[5 * virial_pitch + idx]); // zz
             Scalar4 pos4 = d_position[idx];
             Scalar3 pos3 = make_scalar3(pos4.x, pos4.y, pos4.z);
-            Scalar3 lat = d_lattice_site[tag];
+            Scalar3 lat = d_lattice_site[idx];
             Scalar3 dr = box.shift(pos3, d_image[idx]) - lat;
             double fdr = 0;
             fdr += (double)d_net_force[idx].x * dr.x;
@@ -240,7 +240,7 @@ __global__ void gpu_compute_thermo_hma_final_sums(Scalar* d_properties,
 
 //! Compute partial sums of thermodynamic properties of a group on the GPU,
 /*! \param d_pos Particle position array from ParticleData
-    \param d_lattice_site Particle lattice site array
+    \param d_lattice_site Lattice site of each particle, by index
     \param d_image Image array from ParticleData
     \param d_body Particle body id
     \param d_tag Particle tag
@@ -361,3 +361,48 @@ hipError_t gpu_compute_thermo_hma_final(Scalar* d_properties,
 
     return hipSuccess;
     }
+
+//! Gather the lattice sites of the local particles by index
+/*! \param d_lattice_site_index Lattice site of each particle, by index (output)
+    \param d_lattice_site Lattice site of each particle, by tag
+    \param d_tag Particle tag
+    \param N Number of local particles
+*/
+__global__ void gpu_gather_lattice_sites_kernel(Scalar3* d_lattice_site_index,
+                                                const Scalar3* d_lattice_site,
+                                                const unsigned int* d_tag,
+                                                unsigned int N)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_lattice_site_index[idx] = d_lattice_site[d_tag[idx]];
+    }
+
+/*! \param d_lattice_site_index Lattice site of each particle, by index (output)
+    \param d_lattice_site Lattice site of each particle, by tag
+    \param d_tag Particle tag
+    \param N Number of local particles
+    \param block_size Block size to execute on the GPU
+*/
+hipError_t gpu_gather_lattice_sites(Scalar3* d_lattice_site_index,
+                                    const Scalar3* d_lattice_site,
+                                    const unsigned int* d_tag,
+                                    unsigned int N,
+                                    unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    dim3 grid(N / block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+
+    gpu_gather_lattice_sites_kernel<<<grid, threads>>>(d_lattice_site_index,
+                                                       d_lattice_site,
+                                                       d_tag,
+                                                       N);
+
+    return hipSuccess;
+    }
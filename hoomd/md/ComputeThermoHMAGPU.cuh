@@ -47,6 +47,13 @@ hipError_t gpu_compute_thermo_hma_partial(Scalar4* d_pos,
                                           const compute_thermo_hma_args& args,
                                           const GPUPartition& gpu_partition);
 
+//! Gathers the lattice sites of the local particles by index
+hipError_t gpu_gather_lattice_sites(Scalar3* d_lattice_site_index,
+                                    const Scalar3* d_lattice_site,
+                                    const unsigned int* d_tag,
+                                    unsigned int N,
+                                    unsigned int block_size);
+
 //! Computes the final sums of thermodynamic properties for ComputeThermo
 hipError_t gpu_compute_thermo_hma_final(Scalar* d_properties,
                                         unsigned int* d_body,
@@ -39,6 +39,9 @@ class PYBIND11_EXPORT ComputeThermoHMAGPU : public ComputeThermoHMA
 
     //! Does the actual computation
     virtual void computeProperties();
+
+    //! Gather the lattice sites of the local particles by index on the GPU
+    virtual void updateLatticeSiteIndex();
     };
 
 //! Exports the ComputeThermoHMAGPU class to python
@@ -31,6 +31,23 @@ struct thermo_index
         };
     };
 
+//! Bit flags that select the properties ComputeThermo evaluates
+/*! ComputeThermo evaluates each property the first time it is requested after compute(). The
+    pressure flag covers both the pressure and the pressure tensor.
+*/
+struct thermo_property
+    {
+    //! The enum
+    enum Enum
+        {
+        translational_kinetic_energy = 1 << 0, //!< translational_kinetic_energy
+        rotational_kinetic_energy = 1 << 1,    //!< rotational_kinetic_energy
+        potential_energy = 1 << 2,             //!< potential_energy
+        pressure = 1 << 3,                     //!< pressure and pressure_xx to pressure_zz
+        all = (1 << 4) - 1                     //!< All properties
+        };
+    };
+
 //! structure for storing the components of the pressure tensor
 struct PressureTensor
     {
@@ -0,0 +1,473 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file Correlator.cc
+    \brief Contains code for the Correlator class
+*/
+
+#include "Correlator.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System to sample
+    \param group Particles to sample
+    \param thermo Computes the pressure tensor of \a group
+    \param pressure_tensor Set to true to correlate the off-diagonal pressure tensor components
+    \param heat_flux Set to true to correlate the heat flux
+    \param msd Set to true to accumulate the mean squared displacement
+    \param num_points Number of points per level
+    \param averaging Number of values averaged into one value of the next level
+    \param num_levels Number of levels
+*/
+Correlator::Correlator(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<ParticleGroup> group,
+                       std::shared_ptr<ComputeThermo> thermo,
+                       bool pressure_tensor,
+                       bool heat_flux,
+                       bool msd,
+                       unsigned int num_points,
+                       unsigned int averaging,
+                       unsigned int num_levels)
+    : Analyzer(sysdef), m_group(group), m_thermo(thermo), m_num_points(num_points),
+      m_averaging(averaging), m_num_levels(num_levels),
+      m_dimensions(sysdef->getNDimensions()), m_initialized(false), m_group_size(0),
+      m_num_channels(0), m_num_samples(0), m_first_timestep(0), m_last_timestep(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing Correlator" << endl;
+
+    if (m_averaging < 2)
+        throw runtime_error("averaging must be at least 2.");
+    if (m_num_points < m_averaging || m_num_points % m_averaging != 0)
+        throw runtime_error("num_points must be a multiple of averaging.");
+    if (m_num_levels < 1)
+        throw runtime_error("num_levels must be positive.");
+
+    m_enabled[correlator_quantity::pressure_tensor] = pressure_tensor;
+    m_enabled[correlator_quantity::heat_flux] = heat_flux;
+    m_enabled[correlator_quantity::msd] = msd;
+
+#ifdef ENABLE_MPI
+    // the history of each particle would have to migrate with it
+    if (msd && m_sysdef->isDomainDecomposed())
+        throw runtime_error("Correlator does not support msd with domain decomposition.");
+#endif
+
+    m_insert_index.resize(m_num_levels);
+    m_num_accumulated.resize(m_num_levels);
+    m_num_values.resize(m_num_levels);
+    m_num_correlation.resize(m_num_levels * m_num_points);
+    }
+
+Correlator::~Correlator()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying Correlator" << endl;
+    }
+
+PDataFlags Correlator::getRequestedPDataFlags()
+    {
+    PDataFlags flags(0);
+    if (m_enabled[correlator_quantity::pressure_tensor]
+        || m_enabled[correlator_quantity::heat_flux])
+        flags[pdata_flag::pressure_tensor] = 1;
+    return flags;
+    }
+
+/*! The channels are allocated on the first call to analyze() so that the group is up to date.
+ */
+void Correlator::initialize()
+    {
+    m_group_size = m_group->getNumMembersGlobal();
+
+    // pressure tensor and heat flux channels first, then D channels for every group member
+    const unsigned int num_off_diagonal = m_dimensions == 2 ? 1 : 3;
+    m_channel_count[correlator_quantity::pressure_tensor]
+        = m_enabled[correlator_quantity::pressure_tensor] ? num_off_diagonal : 0;
+    m_channel_count[correlator_quantity::heat_flux]
+        = m_enabled[correlator_quantity::heat_flux] ? m_dimensions : 0;
+    m_channel_count[correlator_quantity::msd]
+        = m_enabled[correlator_quantity::msd] ? m_dimensions * m_group_size : 0;
+
+    m_num_channels = 0;
+    for (unsigned int q = 0; q < correlator_quantity::num_quantities; q++)
+        {
+        m_channel_begin[q] = m_num_channels;
+        m_num_channels += m_channel_count[q];
+        }
+
+    GlobalArray<double> sample(m_num_channels, m_exec_conf);
+    m_sample.swap(sample);
+    TAG_ALLOCATION(m_sample);
+
+    GlobalArray<double> shift(size_t(m_num_channels) * m_num_levels * m_num_points, m_exec_conf);
+    m_shift.swap(shift);
+    TAG_ALLOCATION(m_shift);
+
+    GlobalArray<double> accumulator(size_t(m_num_channels) * m_num_levels, m_exec_conf);
+    m_accumulator.swap(accumulator);
+    TAG_ALLOCATION(m_accumulator);
+
+    GlobalArray<double> correlation(correlator_quantity::num_quantities * m_num_levels
+                                        * m_num_points,
+                                    m_exec_conf);
+    m_correlation.swap(correlation);
+    TAG_ALLOCATION(m_correlation);
+
+    if (m_enabled[correlator_quantity::msd])
+        {
+        GlobalArray<unsigned int> tag_to_member(m_pdata->getNGlobal(), m_exec_conf);
+        m_tag_to_member.swap(tag_to_member);
+        TAG_ALLOCATION(m_tag_to_member);
+
+        ArrayHandle<unsigned int> h_tag_to_member(m_tag_to_member,
+                                                  access_location::host,
+                                                  access_mode::overwrite);
+        for (unsigned int i = 0; i < m_group_size; i++)
+            h_tag_to_member.data[m_group->getMemberTag(i)] = i;
+        }
+
+    m_initialized = true;
+    reset();
+    }
+
+void Correlator::reset()
+    {
+    fill(m_insert_index.begin(), m_insert_index.end(), 0);
+    fill(m_num_accumulated.begin(), m_num_accumulated.end(), 0);
+    fill(m_num_values.begin(), m_num_values.end(), 0);
+    fill(m_num_correlation.begin(), m_num_correlation.end(), 0);
+    m_num_samples = 0;
+
+    if (!m_initialized)
+        return;
+
+    ArrayHandle<double> h_accumulator(m_accumulator, access_location::host, access_mode::overwrite);
+    ArrayHandle<double> h_correlation(m_correlation, access_location::host, access_mode::overwrite);
+    fill(h_accumulator.data, h_accumulator.data + m_accumulator.getNumElements(), 0.0);
+    fill(h_correlation.data, h_correlation.data + m_correlation.getNumElements(), 0.0);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void Correlator::analyze(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Correlator");
+
+    if (!m_initialized)
+        initialize();
+    if (m_group->getNumMembersGlobal() != m_group_size)
+        throw runtime_error("The number of particles in the Correlator group changed.");
+
+    if (m_num_samples == 0)
+        m_first_timestep = timestep;
+    m_last_timestep = timestep;
+    m_num_samples++;
+
+    sampleFluxes(timestep);
+    if (m_enabled[correlator_quantity::msd])
+        samplePositions();
+
+    // Every m_averaging insertions into a level, the average of the inserted values cascades to
+    // the next level.
+    for (unsigned int level = 0; level < m_num_levels; level++)
+        {
+        const unsigned int insert_index = m_insert_index[level];
+        insertLevel(level, insert_index);
+        m_num_values[level] = min(m_num_values[level] + 1, m_num_points);
+
+        // the lags below num_points / averaging are covered by the previous level
+        const unsigned int lag_begin = level == 0 ? 0 : m_num_points / m_averaging;
+        if (m_num_values[level] > lag_begin)
+            {
+            correlateLevel(level, insert_index, lag_begin);
+            for (unsigned int lag = lag_begin; lag < m_num_values[level]; lag++)
+                m_num_correlation[level * m_num_points + lag]++;
+            }
+
+        m_insert_index[level] = (insert_index + 1) % m_num_points;
+        m_num_accumulated[level]++;
+        if (m_num_accumulated[level] < m_averaging)
+            break;
+        m_num_accumulated[level] = 0;
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void Correlator::sampleFluxes(uint64_t timestep)
+    {
+    ArrayHandle<double> h_sample(m_sample, access_location::host, access_mode::readwrite);
+
+    if (m_enabled[correlator_quantity::pressure_tensor])
+        {
+        m_thermo->compute(timestep);
+        ArrayHandle<Scalar> h_properties(m_thermo->getProperties(thermo_property::pressure),
+                                         access_location::host,
+                                         access_mode::read);
+        double* pressure = h_sample.data + m_channel_begin[correlator_quantity::pressure_tensor];
+        pressure[0] = h_properties.data[thermo_index::pressure_xy];
+        if (m_dimensions == 3)
+            {
+            pressure[1] = h_properties.data[thermo_index::pressure_xz];
+            pressure[2] = h_properties.data[thermo_index::pressure_yz];
+            }
+        }
+
+    if (m_enabled[correlator_quantity::heat_flux])
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::read);
+        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        const size_t virial_pitch = net_virial.getPitch();
+
+        double flux[3] = {0, 0, 0};
+        for (unsigned int group_idx = 0; group_idx < m_group->getNumMembers(); group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+
+            // ignore rigid body constituent particles, like ComputeThermo
+            if (h_body.data[j] < MIN_FLOPPY && h_body.data[j] != h_tag.data[j])
+                continue;
+
+            const Scalar4 vel = h_vel.data[j];
+            const double e = 0.5 * vel.w * (vel.x * vel.x + vel.y * vel.y + vel.z * vel.z)
+                             + h_net_force.data[j].w;
+            const Scalar* W = h_net_virial.data + j;
+            const Scalar Wxx = W[0 * virial_pitch], Wxy = W[1 * virial_pitch],
+                         Wxz = W[2 * virial_pitch], Wyy = W[3 * virial_pitch],
+                         Wyz = W[4 * virial_pitch], Wzz = W[5 * virial_pitch];
+
+            flux[0] += e * vel.x + Wxx * vel.x + Wxy * vel.y + Wxz * vel.z;
+            flux[1] += e * vel.y + Wxy * vel.x + Wyy * vel.y + Wyz * vel.z;
+            flux[2] += e * vel.z + Wxz * vel.x + Wyz * vel.y + Wzz * vel.z;
+            }
+
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            reduceHeatFlux(flux);
+#endif
+
+        double* out = h_sample.data + m_channel_begin[correlator_quantity::heat_flux];
+        for (unsigned int d = 0; d < m_dimensions; d++)
+            out[d] = flux[d];
+        }
+    }
+
+void Correlator::samplePositions()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag_to_member(m_tag_to_member,
+                                              access_location::host,
+                                              access_mode::read);
+    ArrayHandle<double> h_sample(m_sample, access_location::host, access_mode::readwrite);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    double* out = h_sample.data + m_channel_begin[correlator_quantity::msd];
+    for (unsigned int group_idx = 0; group_idx < m_group->getNumMembers(); group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        unsigned int member = h_tag_to_member.data[h_tag.data[j]];
+
+        const Scalar4 pos = h_pos.data[j];
+        const Scalar3 unwrapped = box.shift(make_scalar3(pos.x, pos.y, pos.z), h_image.data[j]);
+        out[member * m_dimensions + 0] = unwrapped.x;
+        out[member * m_dimensions + 1] = unwrapped.y;
+        if (m_dimensions == 3)
+            out[member * m_dimensions + 2] = unwrapped.z;
+        }
+    }
+
+/*! \param level Level to insert into
+    \param insert_index Position in the history of \a level to write
+
+    Level 0 takes the sampled values. Higher levels take the average of the values accumulated on
+    the previous level and clear its accumulator.
+*/
+void Correlator::insertLevel(unsigned int level, unsigned int insert_index)
+    {
+    ArrayHandle<double> h_sample(m_sample, access_location::host, access_mode::read);
+    ArrayHandle<double> h_shift(m_shift, access_location::host, access_mode::readwrite);
+    ArrayHandle<double> h_accumulator(m_accumulator, access_location::host, access_mode::readwrite);
+
+    const bool accumulate = level + 1 < m_num_levels;
+    for (unsigned int c = 0; c < m_num_channels; c++)
+        {
+        double value;
+        if (level == 0)
+            {
+            value = h_sample.data[c];
+            }
+        else
+            {
+            double& previous = h_accumulator.data[c * m_num_levels + level - 1];
+            value = previous / m_averaging;
+            previous = 0;
+            }
+
+        h_shift.data[shiftIndex(c, level, insert_index)] = value;
+        if (accumulate)
+            h_accumulator.data[c * m_num_levels + level] += value;
+        }
+    }
+
+/*! \param level Level to correlate
+    \param insert_index Position of the newest value in the history of \a level
+    \param lag_begin First lag to correlate
+
+    The products of the newest value with the values lag_begin to m_num_values[level]-1 points
+    earlier are summed over the channels of each quantity. The msd quantity sums the squared
+    differences instead.
+*/
+void Correlator::correlateLevel(unsigned int level,
+                                unsigned int insert_index,
+                                unsigned int lag_begin)
+    {
+    ArrayHandle<double> h_shift(m_shift, access_location::host, access_mode::read);
+    ArrayHandle<double> h_correlation(m_correlation, access_location::host, access_mode::readwrite);
+
+    const unsigned int lag_end = m_num_values[level];
+    for (unsigned int q = 0; q < correlator_quantity::num_quantities; q++)
+        {
+        const bool difference = q == correlator_quantity::msd;
+        double* correlation = h_correlation.data + correlationIndex(q, level, 0);
+        for (unsigned int c = m_channel_begin[q]; c < m_channel_begin[q] + m_channel_count[q]; c++)
+            {
+            const double* history = h_shift.data + shiftIndex(c, level, 0);
+            const double newest = history[insert_index];
+            for (unsigned int lag = lag_begin; lag < lag_end; lag++)
+                {
+                const double other
+                    = history[(insert_index + m_num_points - lag) % m_num_points];
+                correlation[lag] += difference ? (newest - other) * (newest - other)
+                                               : newest * other;
+                }
+            }
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! \param flux Components of the heat flux of the local particles, replaced by the global sum
+ */
+void Correlator::reduceHeatFlux(double* flux)
+    {
+    MPI_Allreduce(MPI_IN_PLACE, flux, 3, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
+    }
+#endif
+
+/*! Level 0 contributes lags 0 to num_points - 1. Each level k > 0 contributes lags
+    num_points / averaging to num_points - 1 times averaging^k.
+*/
+std::vector<double> Correlator::getLagSteps()
+    {
+    const double interval
+        = m_num_samples > 1
+              ? double(m_last_timestep - m_first_timestep) / double(m_num_samples - 1)
+              : 0.0;
+    vector<double> lags;
+    double scale = 1.0;
+    for (unsigned int level = 0; level < m_num_levels; level++)
+        {
+        const unsigned int lag_begin = level == 0 ? 0 : m_num_points / m_averaging;
+        for (unsigned int lag = lag_begin; lag < m_num_points; lag++)
+            {
+            if (m_num_correlation[level * m_num_points + lag] > 0)
+                lags.push_back(lag * scale * interval);
+            }
+        scale *= m_averaging;
+        }
+    return lags;
+    }
+
+/*! \param quantity Index of the quantity (a correlator_quantity::Enum)
+
+    The pressure tensor and heat flux correlations are averaged over the components. The mean
+    squared displacement is averaged over the group members and summed over the components.
+*/
+std::vector<double> Correlator::getCorrelation(unsigned int quantity)
+    {
+    if (quantity >= correlator_quantity::num_quantities)
+        throw runtime_error("Invalid Correlator quantity.");
+
+    vector<double> result;
+    if (!m_initialized || !m_enabled[quantity])
+        return result;
+
+    const double norm = quantity == correlator_quantity::msd
+                            ? double(m_group_size)
+                            : double(m_channel_count[quantity]);
+
+    ArrayHandle<double> h_correlation(m_correlation, access_location::host, access_mode::read);
+    for (unsigned int level = 0; level < m_num_levels; level++)
+        {
+        const unsigned int lag_begin = level == 0 ? 0 : m_num_points / m_averaging;
+        for (unsigned int lag = lag_begin; lag < m_num_points; lag++)
+            {
+            const uint64_t n = m_num_correlation[level * m_num_points + lag];
+            if (n > 0)
+                result.push_back(h_correlation.data[correlationIndex(quantity, level, lag)]
+                                 / (double(n) * norm));
+            }
+        }
+    return result;
+    }
+
+void export_Correlator(py::module& m)
+    {
+    py::class_<Correlator, Analyzer, std::shared_ptr<Correlator>>(m, "Correlator")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      std::shared_ptr<ComputeThermo>,
+                      bool,
+                      bool,
+                      bool,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int>())
+        .def("getLagSteps", &Correlator::getLagSteps)
+        .def("getCorrelation", &Correlator::getCorrelation)
+        .def("isEnabled", &Correlator::isEnabled)
+        .def("reset", &Correlator::reset)
+        .def_property_readonly(
+            "pressure_tensor",
+            [](const Correlator& correlator)
+            { return correlator.isEnabled(correlator_quantity::pressure_tensor); })
+        .def_property_readonly(
+            "heat_flux",
+            [](const Correlator& correlator)
+            { return correlator.isEnabled(correlator_quantity::heat_flux); })
+        .def_property_readonly(
+            "msd",
+            [](const Correlator& correlator)
+            { return correlator.isEnabled(correlator_quantity::msd); })
+        .def_property_readonly("num_samples", &Correlator::getNumSamples)
+        .def_property_readonly("num_points", &Correlator::getNumPoints)
+        .def_property_readonly("averaging", &Correlator::getAveraging)
+        .def_property_readonly("num_levels", &Correlator::getNumLevels);
+    }
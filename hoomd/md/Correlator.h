@@ -0,0 +1,191 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermo.h"
+#include "hoomd/Analyzer.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file Correlator.h
+    \brief Declares the Correlator class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __CORRELATOR_H__
+#define __CORRELATOR_H__
+
+//! Enum for indexing the quantities correlated by Correlator
+struct correlator_quantity
+    {
+    //! The enum
+    enum Enum
+        {
+        pressure_tensor = 0, //!< Autocorrelation of the off-diagonal pressure tensor components
+        heat_flux,           //!< Autocorrelation of the components of the heat flux
+        msd,                 //!< Mean squared displacement of the group members
+        num_quantities       // final element to count number of quantities
+        };
+    };
+
+//! Accumulates time correlation functions with multiple tau correlators
+/*! Correlator implements the multiple tau correlator of Ramirez et al. (J. Chem. Phys. 133,
+    154103, 2010). Each sampled channel keeps a history of \a num_points values on each of
+    \a num_levels levels. Level 0 stores every sample, and each coarser level stores the average of
+    \a averaging consecutive values of the previous level. Correlations are accumulated every time
+    a value is inserted into a level, so the correlation function extends to lags of
+    num_points * averaging^(num_levels - 1) samples in O(num_levels * num_points) memory per
+    channel.
+
+    The channels are:
+     - pressure_tensor: the off-diagonal components of the pressure tensor computed by \a thermo
+       (xy, xz, and yz in 3D, xy in 2D).
+     - heat_flux: the components of J = sum_i (e_i v_i + W_i . v_i), where e_i is the kinetic plus
+       potential energy of particle i and W_i its virial tensor.
+     - msd: the components of the unwrapped position of each group member. Their correlation is
+       the squared displacement summed over the members.
+
+    The insertion and correlation bookkeeping is the same for all channels, so it lives on the host.
+    The channel histories and the correlation sums live in GlobalArrays. CorrelatorGPU updates them
+    on the device, so sampling does not copy any data to the host (except to reduce the heat flux
+    over MPI ranks). The results are copied to the host when they are read.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT Correlator : public Analyzer
+    {
+    public:
+    //! Constructs the analyzer
+    Correlator(std::shared_ptr<SystemDefinition> sysdef,
+               std::shared_ptr<ParticleGroup> group,
+               std::shared_ptr<ComputeThermo> thermo,
+               bool pressure_tensor,
+               bool heat_flux,
+               bool msd,
+               unsigned int num_points,
+               unsigned int averaging,
+               unsigned int num_levels);
+
+    //! Destructor
+    virtual ~Correlator();
+
+    //! Sample the channels and update the correlations
+    virtual void analyze(uint64_t timestep);
+
+    //! Get needed pdata flags
+    virtual PDataFlags getRequestedPDataFlags();
+
+    //! Get the lags with accumulated correlations, in timesteps
+    std::vector<double> getLagSteps();
+
+    //! Get the correlation function of a quantity at the lags returned by getLagSteps()
+    std::vector<double> getCorrelation(unsigned int quantity);
+
+    //! Test if a quantity is correlated
+    bool isEnabled(unsigned int quantity) const
+        {
+        return m_enabled[quantity];
+        }
+
+    //! Get the number of samples
+    uint64_t getNumSamples() const
+        {
+        return m_num_samples;
+        }
+
+    //! Get the number of points per level
+    unsigned int getNumPoints() const
+        {
+        return m_num_points;
+        }
+
+    //! Get the number of values averaged into one value of the next level
+    unsigned int getAveraging() const
+        {
+        return m_averaging;
+        }
+
+    //! Get the number of levels
+    unsigned int getNumLevels() const
+        {
+        return m_num_levels;
+        }
+
+    //! Discard the accumulated correlations
+    void reset();
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group;   //!< Group to sample
+    std::shared_ptr<ComputeThermo> m_thermo;  //!< Computes the pressure tensor
+    unsigned int m_num_points;                //!< Number of points per level
+    unsigned int m_averaging;                 //!< Number of values averaged into the next level
+    unsigned int m_num_levels;                //!< Number of levels
+    unsigned int m_dimensions;                //!< Number of dimensions of the system
+    bool m_initialized;                       //!< True when the arrays are allocated
+    unsigned int m_group_size;                //!< Number of group members when initialized
+    unsigned int m_num_channels;              //!< Total number of channels
+
+    bool m_enabled[correlator_quantity::num_quantities];           //!< Correlated quantities
+    unsigned int m_channel_begin[correlator_quantity::num_quantities]; //!< First channel
+    unsigned int m_channel_count[correlator_quantity::num_quantities]; //!< Number of channels
+
+    GlobalArray<unsigned int> m_tag_to_member; //!< Index of each tag in the group (msd only)
+    GlobalArray<double> m_sample;              //!< Current value of each channel
+    GlobalArray<double> m_shift;               //!< History of each channel on each level
+    GlobalArray<double> m_accumulator;         //!< Sum of the values averaged into the next level
+    GlobalArray<double> m_correlation;         //!< Correlation sums of each quantity, level and lag
+
+    std::vector<unsigned int> m_insert_index;    //!< Next index to insert on each level
+    std::vector<unsigned int> m_num_accumulated; //!< Number of values in each accumulator
+    std::vector<unsigned int> m_num_values;      //!< Number of valid values on each level
+    std::vector<uint64_t> m_num_correlation;     //!< Number of correlations of each level and lag
+
+    uint64_t m_num_samples;    //!< Number of samples
+    uint64_t m_first_timestep; //!< Timestep of the first sample
+    uint64_t m_last_timestep;  //!< Timestep of the last sample
+
+    //! Get the index of a value in m_shift
+    size_t shiftIndex(unsigned int channel, unsigned int level, unsigned int point) const
+        {
+        return (size_t(channel) * m_num_levels + level) * m_num_points + point;
+        }
+
+    //! Get the index of a sum in m_correlation
+    size_t correlationIndex(unsigned int quantity, unsigned int level, unsigned int lag) const
+        {
+        return (size_t(quantity) * m_num_levels + level) * m_num_points + lag;
+        }
+
+    //! Allocate the arrays
+    void initialize();
+
+    //! Sample the pressure tensor and heat flux channels
+    virtual void sampleFluxes(uint64_t timestep);
+
+    //! Sample the unwrapped positions of the group members
+    virtual void samplePositions();
+
+    //! Insert the current values into a level
+    virtual void insertLevel(unsigned int level, unsigned int insert_index);
+
+    //! Accumulate the correlations of the values just inserted into a level
+    virtual void
+    correlateLevel(unsigned int level, unsigned int insert_index, unsigned int lag_begin);
+
+#ifdef ENABLE_MPI
+    //! Sum the heat flux over the MPI ranks
+    void reduceHeatFlux(double* flux);
+#endif
+    };
+
+//! Exports the Correlator class to python
+void export_Correlator(pybind11::module& m);
+
+#endif
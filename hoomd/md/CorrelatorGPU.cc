@@ -0,0 +1,244 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CorrelatorGPU.cc
+    \brief Contains code for the CorrelatorGPU class
+*/
+
+#include "CorrelatorGPU.h"
+#include "CorrelatorGPU.cuh"
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System to sample
+    \param group Particles to sample
+    \param thermo Computes the pressure tensor of \a group
+    \param pressure_tensor Set to true to correlate the off-diagonal pressure tensor components
+    \param heat_flux Set to true to correlate the heat flux
+    \param msd Set to true to accumulate the mean squared displacement
+    \param num_points Number of points per level
+    \param averaging Number of values averaged into one value of the next level
+    \param num_levels Number of levels
+*/
+CorrelatorGPU::CorrelatorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<ParticleGroup> group,
+                             std::shared_ptr<ComputeThermo> thermo,
+                             bool pressure_tensor,
+                             bool heat_flux,
+                             bool msd,
+                             unsigned int num_points,
+                             unsigned int averaging,
+                             unsigned int num_levels)
+    : Correlator(sysdef,
+                 group,
+                 thermo,
+                 pressure_tensor,
+                 heat_flux,
+                 msd,
+                 num_points,
+                 averaging,
+                 num_levels),
+      m_scratch(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a CorrelatorGPU with no GPU in the execution configuration" << endl;
+        throw std::runtime_error("Error initializing CorrelatorGPU");
+        }
+
+    m_block_size = 256;
+    }
+
+CorrelatorGPU::~CorrelatorGPU() { }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CorrelatorGPU::sampleFluxes(uint64_t timestep)
+    {
+    if (m_enabled[correlator_quantity::pressure_tensor])
+        {
+        m_thermo->compute(timestep);
+        ArrayHandle<Scalar> d_properties(m_thermo->getProperties(thermo_property::pressure),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<double> d_sample(m_sample, access_location::device, access_mode::readwrite);
+
+        gpu_correlator_sample_pressure_tensor(
+            d_sample.data + m_channel_begin[correlator_quantity::pressure_tensor],
+            d_properties.data,
+            m_dimensions);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    if (m_enabled[correlator_quantity::heat_flux])
+        {
+        const unsigned int group_size = m_group->getNumMembers();
+        const unsigned int n_blocks = group_size / m_block_size + 1;
+        m_scratch.resize(3 * n_blocks);
+
+            {
+            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                       access_location::device,
+                                       access_mode::read);
+            ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                             access_location::device,
+                                             access_mode::read);
+            const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+            ArrayHandle<Scalar> d_net_virial(net_virial,
+                                             access_location::device,
+                                             access_mode::read);
+            ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                             access_location::device,
+                                             access_mode::read);
+            ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                    access_location::device,
+                                                    access_mode::read);
+            ArrayHandle<double> d_scratch(m_scratch,
+                                          access_location::device,
+                                          access_mode::overwrite);
+            ArrayHandle<double> d_sample(m_sample,
+                                         access_location::device,
+                                         access_mode::readwrite);
+
+            gpu_correlator_heat_flux_partial(d_scratch.data,
+                                             d_vel.data,
+                                             d_net_force.data,
+                                             d_net_virial.data,
+                                             net_virial.getPitch(),
+                                             d_body.data,
+                                             d_tag.data,
+                                             d_index_array.data,
+                                             group_size,
+                                             n_blocks,
+                                             m_block_size);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            gpu_correlator_heat_flux_final(
+                d_sample.data + m_channel_begin[correlator_quantity::heat_flux],
+                d_scratch.data,
+                n_blocks,
+                m_dimensions);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            ArrayHandle<double> h_sample(m_sample, access_location::host, access_mode::readwrite);
+            double* out = h_sample.data + m_channel_begin[correlator_quantity::heat_flux];
+            double flux[3] = {0, 0, 0};
+            for (unsigned int d = 0; d < m_dimensions; d++)
+                flux[d] = out[d];
+            reduceHeatFlux(flux);
+            for (unsigned int d = 0; d < m_dimensions; d++)
+                out[d] = flux[d];
+            }
+#endif
+        }
+    }
+
+void CorrelatorGPU::samplePositions()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_tag_to_member(m_tag_to_member,
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<double> d_sample(m_sample, access_location::device, access_mode::readwrite);
+
+    gpu_correlator_sample_positions(d_sample.data + m_channel_begin[correlator_quantity::msd],
+                                    d_pos.data,
+                                    d_image.data,
+                                    d_tag.data,
+                                    d_tag_to_member.data,
+                                    d_index_array.data,
+                                    m_group->getNumMembers(),
+                                    m_pdata->getGlobalBox(),
+                                    m_dimensions,
+                                    m_block_size);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param level Level to insert into
+    \param insert_index Position in the history of \a level to write
+*/
+void CorrelatorGPU::insertLevel(unsigned int level, unsigned int insert_index)
+    {
+    ArrayHandle<double> d_sample(m_sample, access_location::device, access_mode::read);
+    ArrayHandle<double> d_shift(m_shift, access_location::device, access_mode::readwrite);
+    ArrayHandle<double> d_accumulator(m_accumulator,
+                                      access_location::device,
+                                      access_mode::readwrite);
+
+    gpu_correlator_insert(d_shift.data,
+                          d_accumulator.data,
+                          d_sample.data,
+                          m_num_channels,
+                          m_num_levels,
+                          m_num_points,
+                          m_averaging,
+                          level,
+                          insert_index,
+                          m_block_size);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param level Level to correlate
+    \param insert_index Position of the newest value in the history of \a level
+    \param lag_begin First lag to correlate
+*/
+void CorrelatorGPU::correlateLevel(unsigned int level,
+                                   unsigned int insert_index,
+                                   unsigned int lag_begin)
+    {
+    ArrayHandle<double> d_shift(m_shift, access_location::device, access_mode::read);
+    ArrayHandle<double> d_correlation(m_correlation,
+                                      access_location::device,
+                                      access_mode::readwrite);
+
+    for (unsigned int q = 0; q < correlator_quantity::num_quantities; q++)
+        {
+        gpu_correlator_correlate(d_correlation.data + correlationIndex(q, level, 0),
+                                 d_shift.data,
+                                 m_channel_begin[q],
+                                 m_channel_count[q],
+                                 m_num_levels,
+                                 m_num_points,
+                                 level,
+                                 insert_index,
+                                 lag_begin,
+                                 m_num_values[level],
+                                 q == correlator_quantity::msd,
+                                 m_block_size);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    }
+
+void export_CorrelatorGPU(py::module& m)
+    {
+    py::class_<CorrelatorGPU, Correlator, std::shared_ptr<CorrelatorGPU>>(m, "CorrelatorGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      std::shared_ptr<ComputeThermo>,
+                      bool,
+                      bool,
+                      bool,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int>());
+    }
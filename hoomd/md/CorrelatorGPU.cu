@@ -0,0 +1,518 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "CorrelatorGPU.cuh"
+#include <hip/hip_runtime.h>
+
+#include <assert.h>
+
+/*! \file CorrelatorGPU.cu
+    \brief Defines GPU kernel code for sampling and correlating time series. Used by CorrelatorGPU.
+*/
+
+//! Copy the off-diagonal pressure tensor components into the sample
+/*! \param d_sample Pressure tensor channels of the sample
+    \param d_properties Properties computed by ComputeThermoGPU
+    \param dimensions Number of dimensions of the system
+
+    Launched with a single thread.
+*/
+__global__ void gpu_correlator_sample_pressure_tensor_kernel(double* d_sample,
+                                                             const Scalar* d_properties,
+                                                             unsigned int dimensions)
+    {
+    d_sample[0] = d_properties[thermo_index::pressure_xy];
+    if (dimensions == 3)
+        {
+        d_sample[1] = d_properties[thermo_index::pressure_xz];
+        d_sample[2] = d_properties[thermo_index::pressure_yz];
+        }
+    }
+
+//! Perform partial sums of the heat flux
+/*! \param d_scratch Scratch space, component d of block b is written to d_scratch[d*n_blocks + b]
+    \param d_vel Particle velocities and masses
+    \param d_net_force Net force and potential energy
+    \param d_net_virial Net virial
+    \param virial_pitch Pitch of the net virial array
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param d_group_members Indices of the group members
+    \param group_size Number of group members
+    \param n_blocks Number of blocks
+
+    One thread is executed per group member. 3*sizeof(double)*block_size bytes of dynamic shared
+    memory are needed.
+*/
+__global__ void gpu_correlator_heat_flux_partial_sums(double* d_scratch,
+                                                      const Scalar4* d_vel,
+                                                      const Scalar4* d_net_force,
+                                                      const Scalar* d_net_virial,
+                                                      const size_t virial_pitch,
+                                                      const unsigned int* d_body,
+                                                      const unsigned int* d_tag,
+                                                      const unsigned int* d_group_members,
+                                                      unsigned int group_size,
+                                                      unsigned int n_blocks)
+    {
+    extern __shared__ double correlator_flux_sdata[];
+
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    double flux[3] = {0, 0, 0};
+    if (group_idx < group_size)
+        {
+        unsigned int j = d_group_members[group_idx];
+
+        // ignore rigid body constituent particles, like ComputeThermo
+        unsigned int body = d_body[j];
+        if (body >= MIN_FLOPPY || body == d_tag[j])
+            {
+            const Scalar4 vel = d_vel[j];
+            const double e = 0.5 * vel.w * (vel.x * vel.x + vel.y * vel.y + vel.z * vel.z)
+                             + d_net_force[j].w;
+            const Scalar Wxx = d_net_virial[0 * virial_pitch + j];
+            const Scalar Wxy = d_net_virial[1 * virial_pitch + j];
+            const Scalar Wxz = d_net_virial[2 * virial_pitch + j];
+            const Scalar Wyy = d_net_virial[3 * virial_pitch + j];
+            const Scalar Wyz = d_net_virial[4 * virial_pitch + j];
+            const Scalar Wzz = d_net_virial[5 * virial_pitch + j];
+
+            flux[0] = e * vel.x + Wxx * vel.x + Wxy * vel.y + Wxz * vel.z;
+            flux[1] = e * vel.y + Wxy * vel.x + Wyy * vel.y + Wyz * vel.z;
+            flux[2] = e * vel.z + Wxz * vel.x + Wyz * vel.y + Wzz * vel.z;
+            }
+        }
+
+    for (unsigned int d = 0; d < 3; d++)
+        correlator_flux_sdata[d * blockDim.x + threadIdx.x] = flux[d];
+    __syncthreads();
+
+    // reduce the sum in parallel
+    unsigned int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            {
+            for (unsigned int d = 0; d < 3; d++)
+                correlator_flux_sdata[d * blockDim.x + threadIdx.x]
+                    += correlator_flux_sdata[d * blockDim.x + threadIdx.x + offs];
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        {
+        for (unsigned int d = 0; d < 3; d++)
+            d_scratch[d * n_blocks + blockIdx.x] = correlator_flux_sdata[d * blockDim.x];
+        }
+    }
+
+//! Sum the partial sums of the heat flux
+/*! \param d_sample Heat flux channels of the sample
+    \param d_scratch Partial sums written by gpu_correlator_heat_flux_partial_sums
+    \param n_blocks Number of partial sums per component
+    \param dimensions Number of dimensions of the system
+
+    Launched with a single block. 3*sizeof(double)*block_size bytes of dynamic shared memory are
+    needed.
+*/
+__global__ void gpu_correlator_heat_flux_final_sums(double* d_sample,
+                                                    const double* d_scratch,
+                                                    unsigned int n_blocks,
+                                                    unsigned int dimensions)
+    {
+    extern __shared__ double correlator_flux_final_sdata[];
+
+    double flux[3] = {0, 0, 0};
+    for (unsigned int i = threadIdx.x; i < n_blocks; i += blockDim.x)
+        {
+        for (unsigned int d = 0; d < 3; d++)
+            flux[d] += d_scratch[d * n_blocks + i];
+        }
+
+    for (unsigned int d = 0; d < 3; d++)
+        correlator_flux_final_sdata[d * blockDim.x + threadIdx.x] = flux[d];
+    __syncthreads();
+
+    unsigned int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            {
+            for (unsigned int d = 0; d < 3; d++)
+                correlator_flux_final_sdata[d * blockDim.x + threadIdx.x]
+                    += correlator_flux_final_sdata[d * blockDim.x + threadIdx.x + offs];
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        {
+        for (unsigned int d = 0; d < dimensions; d++)
+            d_sample[d] = correlator_flux_final_sdata[d * blockDim.x];
+        }
+    }
+
+//! Write the unwrapped positions of the group members into the sample
+/*! \param d_sample Msd channels of the sample
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_tag Particle tags
+    \param d_tag_to_member Index of each tag in the group
+    \param d_group_members Indices of the group members
+    \param group_size Number of group members
+    \param box Global simulation box
+    \param dimensions Number of dimensions of the system
+
+    One thread is executed per group member.
+*/
+__global__ void gpu_correlator_sample_positions_kernel(double* d_sample,
+                                                       const Scalar4* d_pos,
+                                                       const int3* d_image,
+                                                       const unsigned int* d_tag,
+                                                       const unsigned int* d_tag_to_member,
+                                                       const unsigned int* d_group_members,
+                                                       unsigned int group_size,
+                                                       const BoxDim box,
+                                                       unsigned int dimensions)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx >= group_size)
+        return;
+
+    unsigned int j = d_group_members[group_idx];
+    unsigned int member = d_tag_to_member[d_tag[j]];
+
+    const Scalar4 pos = d_pos[j];
+    const Scalar3 unwrapped = box.shift(make_scalar3(pos.x, pos.y, pos.z), d_image[j]);
+    d_sample[member * dimensions + 0] = unwrapped.x;
+    d_sample[member * dimensions + 1] = unwrapped.y;
+    if (dimensions == 3)
+        d_sample[member * dimensions + 2] = unwrapped.z;
+    }
+
+//! Insert the current values of all channels into a level
+/*! One thread is executed per channel. See Correlator::insertLevel.
+ */
+__global__ void gpu_correlator_insert_kernel(double* d_shift,
+                                             double* d_accumulator,
+                                             const double* d_sample,
+                                             unsigned int num_channels,
+                                             unsigned int num_levels,
+                                             unsigned int num_points,
+                                             unsigned int averaging,
+                                             unsigned int level,
+                                             unsigned int insert_index)
+    {
+    unsigned int c = blockIdx.x * blockDim.x + threadIdx.x;
+    if (c >= num_channels)
+        return;
+
+    double value;
+    if (level == 0)
+        {
+        value = d_sample[c];
+        }
+    else
+        {
+        double* previous = d_accumulator + c * num_levels + level - 1;
+        value = *previous / averaging;
+        *previous = 0;
+        }
+
+    d_shift[(size_t(c) * num_levels + level) * num_points + insert_index] = value;
+    if (level + 1 < num_levels)
+        d_accumulator[c * num_levels + level] += value;
+    }
+
+//! Accumulate the correlations of one quantity on one level
+/*! \param d_correlation Correlation sums of the quantity on the level
+    \param d_shift Channel histories
+    \param channel_begin First channel of the quantity
+    \param channel_count Number of channels of the quantity
+    \param num_levels Number of levels
+    \param num_points Number of points per level
+    \param level Level to correlate
+    \param insert_index Position of the newest value in the history of \a level
+    \param lag_begin First lag to correlate
+    \param difference Set to true to sum the squared differences instead of the products
+
+    One block is executed per lag. The threads of the block stride over the channels and reduce
+    their sums in shared memory, so no atomic operations are needed. sizeof(double)*block_size
+    bytes of dynamic shared memory are needed.
+*/
+__global__ void gpu_correlator_correlate_kernel(double* d_correlation,
+                                                const double* d_shift,
+                                                unsigned int channel_begin,
+                                                unsigned int channel_count,
+                                                unsigned int num_levels,
+                                                unsigned int num_points,
+                                                unsigned int level,
+                                                unsigned int insert_index,
+                                                unsigned int lag_begin,
+                                                bool difference)
+    {
+    extern __shared__ double correlator_correlate_sdata[];
+
+    const unsigned int lag = lag_begin + blockIdx.x;
+    const unsigned int other_index = (insert_index + num_points - lag) % num_points;
+
+    double sum = 0;
+    for (unsigned int i = threadIdx.x; i < channel_count; i += blockDim.x)
+        {
+        const double* history
+            = d_shift + (size_t(channel_begin + i) * num_levels + level) * num_points;
+        const double newest = history[insert_index];
+        const double other = history[other_index];
+        sum += difference ? (newest - other) * (newest - other) : newest * other;
+        }
+
+    correlator_correlate_sdata[threadIdx.x] = sum;
+    __syncthreads();
+
+    unsigned int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            correlator_correlate_sdata[threadIdx.x]
+                += correlator_correlate_sdata[threadIdx.x + offs];
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_correlation[lag] += correlator_correlate_sdata[0];
+    }
+
+/*! \param d_sample Pressure tensor channels of the sample
+    \param d_properties Properties computed by ComputeThermoGPU
+    \param dimensions Number of dimensions of the system
+*/
+hipError_t gpu_correlator_sample_pressure_tensor(double* d_sample,
+                                                 const Scalar* d_properties,
+                                                 unsigned int dimensions)
+    {
+    assert(d_sample);
+    assert(d_properties);
+
+    hipLaunchKernelGGL(gpu_correlator_sample_pressure_tensor_kernel,
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       0,
+                       d_sample,
+                       d_properties,
+                       dimensions);
+
+    return hipSuccess;
+    }
+
+/*! \param d_scratch Scratch space for 3*n_blocks partial sums
+    \param d_vel Particle velocities and masses
+    \param d_net_force Net force and potential energy
+    \param d_net_virial Net virial
+    \param virial_pitch Pitch of the net virial array
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param d_group_members Indices of the group members
+    \param group_size Number of group members
+    \param n_blocks Number of blocks, n_blocks * block_size >= group_size
+    \param block_size Block size to execute (a power of two)
+*/
+hipError_t gpu_correlator_heat_flux_partial(double* d_scratch,
+                                            const Scalar4* d_vel,
+                                            const Scalar4* d_net_force,
+                                            const Scalar* d_net_virial,
+                                            size_t virial_pitch,
+                                            const unsigned int* d_body,
+                                            const unsigned int* d_tag,
+                                            const unsigned int* d_group_members,
+                                            unsigned int group_size,
+                                            unsigned int n_blocks,
+                                            unsigned int block_size)
+    {
+    assert(d_scratch);
+    assert(n_blocks * block_size >= group_size);
+
+    hipLaunchKernelGGL(gpu_correlator_heat_flux_partial_sums,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       3 * sizeof(double) * block_size,
+                       0,
+                       d_scratch,
+                       d_vel,
+                       d_net_force,
+                       d_net_virial,
+                       virial_pitch,
+                       d_body,
+                       d_tag,
+                       d_group_members,
+                       group_size,
+                       n_blocks);
+
+    return hipSuccess;
+    }
+
+/*! \param d_sample Heat flux channels of the sample
+    \param d_scratch Partial sums written by gpu_correlator_heat_flux_partial
+    \param n_blocks Number of partial sums per component
+    \param dimensions Number of dimensions of the system
+*/
+hipError_t gpu_correlator_heat_flux_final(double* d_sample,
+                                          const double* d_scratch,
+                                          unsigned int n_blocks,
+                                          unsigned int dimensions)
+    {
+    assert(d_sample);
+    assert(d_scratch);
+
+    const unsigned int final_block_size = 256;
+    hipLaunchKernelGGL(gpu_correlator_heat_flux_final_sums,
+                       dim3(1),
+                       dim3(final_block_size),
+                       3 * sizeof(double) * final_block_size,
+                       0,
+                       d_sample,
+                       d_scratch,
+                       n_blocks,
+                       dimensions);
+
+    return hipSuccess;
+    }
+
+/*! \param d_sample Msd channels of the sample
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_tag Particle tags
+    \param d_tag_to_member Index of each tag in the group
+    \param d_group_members Indices of the group members
+    \param group_size Number of group members
+    \param box Global simulation box
+    \param dimensions Number of dimensions of the system
+    \param block_size Block size to execute
+*/
+hipError_t gpu_correlator_sample_positions(double* d_sample,
+                                           const Scalar4* d_pos,
+                                           const int3* d_image,
+                                           const unsigned int* d_tag,
+                                           const unsigned int* d_tag_to_member,
+                                           const unsigned int* d_group_members,
+                                           unsigned int group_size,
+                                           const BoxDim& box,
+                                           unsigned int dimensions,
+                                           unsigned int block_size)
+    {
+    if (group_size == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_correlator_sample_positions_kernel,
+                       dim3(group_size / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_sample,
+                       d_pos,
+                       d_image,
+                       d_tag,
+                       d_tag_to_member,
+                       d_group_members,
+                       group_size,
+                       box,
+                       dimensions);
+
+    return hipSuccess;
+    }
+
+/*! \param d_shift Channel histories
+    \param d_accumulator Sums of the values averaged into the next level
+    \param d_sample Current value of each channel
+    \param num_channels Number of channels
+    \param num_levels Number of levels
+    \param num_points Number of points per level
+    \param averaging Number of values averaged into one value of the next level
+    \param level Level to insert into
+    \param insert_index Position in the history of \a level to write
+    \param block_size Block size to execute
+*/
+hipError_t gpu_correlator_insert(double* d_shift,
+                                 double* d_accumulator,
+                                 const double* d_sample,
+                                 unsigned int num_channels,
+                                 unsigned int num_levels,
+                                 unsigned int num_points,
+                                 unsigned int averaging,
+                                 unsigned int level,
+                                 unsigned int insert_index,
+                                 unsigned int block_size)
+    {
+    if (num_channels == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_correlator_insert_kernel,
+                       dim3(num_channels / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_shift,
+                       d_accumulator,
+                       d_sample,
+                       num_channels,
+                       num_levels,
+                       num_points,
+                       averaging,
+                       level,
+                       insert_index);
+
+    return hipSuccess;
+    }
+
+/*! \param d_correlation Correlation sums of the quantity on the level
+    \param d_shift Channel histories
+    \param channel_begin First channel of the quantity
+    \param channel_count Number of channels of the quantity
+    \param num_levels Number of levels
+    \param num_points Number of points per level
+    \param level Level to correlate
+    \param insert_index Position of the newest value in the history of \a level
+    \param lag_begin First lag to correlate
+    \param lag_end One past the last lag to correlate
+    \param difference Set to true to sum the squared differences instead of the products
+    \param block_size Block size to execute (a power of two)
+*/
+hipError_t gpu_correlator_correlate(double* d_correlation,
+                                    const double* d_shift,
+                                    unsigned int channel_begin,
+                                    unsigned int channel_count,
+                                    unsigned int num_levels,
+                                    unsigned int num_points,
+                                    unsigned int level,
+                                    unsigned int insert_index,
+                                    unsigned int lag_begin,
+                                    unsigned int lag_end,
+                                    bool difference,
+                                    unsigned int block_size)
+    {
+    if (channel_count == 0 || lag_end <= lag_begin)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_correlator_correlate_kernel,
+                       dim3(lag_end - lag_begin),
+                       dim3(block_size),
+                       sizeof(double) * block_size,
+                       0,
+                       d_correlation,
+                       d_shift,
+                       channel_begin,
+                       channel_count,
+                       num_levels,
+                       num_points,
+                       level,
+                       insert_index,
+                       lag_begin,
+                       difference);
+
+    return hipSuccess;
+    }
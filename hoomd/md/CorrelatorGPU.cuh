@@ -0,0 +1,78 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _CORRELATOR_GPU_CUH_
+#define _CORRELATOR_GPU_CUH_
+
+#include "ComputeThermoTypes.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+
+/*! \file CorrelatorGPU.cuh
+    \brief Kernel driver function declarations for CorrelatorGPU
+*/
+
+//! Copy the off-diagonal pressure tensor components from the ComputeThermo properties
+hipError_t gpu_correlator_sample_pressure_tensor(double* d_sample,
+                                                 const Scalar* d_properties,
+                                                 unsigned int dimensions);
+
+//! Computes the partial sums of the heat flux
+hipError_t gpu_correlator_heat_flux_partial(double* d_scratch,
+                                            const Scalar4* d_vel,
+                                            const Scalar4* d_net_force,
+                                            const Scalar* d_net_virial,
+                                            size_t virial_pitch,
+                                            const unsigned int* d_body,
+                                            const unsigned int* d_tag,
+                                            const unsigned int* d_group_members,
+                                            unsigned int group_size,
+                                            unsigned int n_blocks,
+                                            unsigned int block_size);
+
+//! Sums the partial sums of the heat flux into the sample
+hipError_t gpu_correlator_heat_flux_final(double* d_sample,
+                                          const double* d_scratch,
+                                          unsigned int n_blocks,
+                                          unsigned int dimensions);
+
+//! Writes the unwrapped positions of the group members into the sample
+hipError_t gpu_correlator_sample_positions(double* d_sample,
+                                           const Scalar4* d_pos,
+                                           const int3* d_image,
+                                           const unsigned int* d_tag,
+                                           const unsigned int* d_tag_to_member,
+                                           const unsigned int* d_group_members,
+                                           unsigned int group_size,
+                                           const BoxDim& box,
+                                           unsigned int dimensions,
+                                           unsigned int block_size);
+
+//! Inserts the current values of all channels into a level
+hipError_t gpu_correlator_insert(double* d_shift,
+                                 double* d_accumulator,
+                                 const double* d_sample,
+                                 unsigned int num_channels,
+                                 unsigned int num_levels,
+                                 unsigned int num_points,
+                                 unsigned int averaging,
+                                 unsigned int level,
+                                 unsigned int insert_index,
+                                 unsigned int block_size);
+
+//! Accumulates the correlations of one quantity on one level
+hipError_t gpu_correlator_correlate(double* d_correlation,
+                                    const double* d_shift,
+                                    unsigned int channel_begin,
+                                    unsigned int channel_count,
+                                    unsigned int num_levels,
+                                    unsigned int num_points,
+                                    unsigned int level,
+                                    unsigned int insert_index,
+                                    unsigned int lag_begin,
+                                    unsigned int lag_end,
+                                    bool difference,
+                                    unsigned int block_size);
+
+#endif
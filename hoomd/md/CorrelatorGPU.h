@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "Correlator.h"
+
+/*! \file CorrelatorGPU.h
+    \brief Declares the CorrelatorGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __CORRELATOR_GPU_H__
+#define __CORRELATOR_GPU_H__
+
+//! Accumulates time correlation functions on the GPU
+/*! CorrelatorGPU samples the channels, inserts them into the levels, and accumulates the
+    correlations in device memory. The host only keeps the insertion and correlation counters.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CorrelatorGPU : public Correlator
+    {
+    public:
+    //! Constructs the analyzer
+    CorrelatorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<ParticleGroup> group,
+                  std::shared_ptr<ComputeThermo> thermo,
+                  bool pressure_tensor,
+                  bool heat_flux,
+                  bool msd,
+                  unsigned int num_points,
+                  unsigned int averaging,
+                  unsigned int num_levels);
+
+    //! Destructor
+    virtual ~CorrelatorGPU();
+
+    protected:
+    GlobalVector<double> m_scratch; //!< Scratch space for the heat flux partial sums
+    unsigned int m_block_size;      //!< Block size executed
+
+    //! Sample the pressure tensor and heat flux channels
+    virtual void sampleFluxes(uint64_t timestep);
+
+    //! Sample the unwrapped positions of the group members
+    virtual void samplePositions();
+
+    //! Insert the current values into a level
+    virtual void insertLevel(unsigned int level, unsigned int insert_index);
+
+    //! Accumulate the correlations of the values just inserted into a level
+    virtual void
+    correlateLevel(unsigned int level, unsigned int insert_index, unsigned int lag_begin);
+    };
+
+//! Exports the CorrelatorGPU class to python
+void export_CorrelatorGPU(pybind11::module& m);
+
+#endif
@@ -84,6 +84,21 @@ void CosineSqAngleForceCompute::setParamsPython(std::string type, pybind11::dict
     setParams(typ, _params.k, _params.t_0);
     }
 
+/*! \param types List of angle type names
+    \param columns Map from parameter name to a sequence with one value per type
+*/
+void CosineSqAngleForceCompute::setParamsBulk(pybind11::list types, pybind11::dict columns)
+    {
+    for (size_t i = 0; i < types.size(); ++i)
+        {
+        pybind11::dict params;
+        for (auto column : columns)
+            params[column.first] = column.second[pybind11::int_(i)];
+
+        setParamsPython(types[i].cast<std::string>(), params);
+        }
+    }
+
 pybind11::dict CosineSqAngleForceCompute::getParams(std::string type)
     {
     auto typ = m_angle_data->getTypeByName(type);
@@ -131,138 +146,165 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
 
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
-        {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error()
-                << "angle.cosinesq: angle " << angle.tag[0] << " " << angle.tag[1] << " "
-                << angle.tag[2] << " incomplete." << endl
-                << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
-
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-        // apply minimum image conventions to all 3 vectors
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
-
-        // this is where cosinesq differs from harmonic
-        // FLOPS: 14 / MEM TRANSFER: 2 Scalars
-
-        // FLOPS: 42 / MEM TRANSFER: 6 Scalars
-        Scalar rsqab = dab.x * dab.x + dab.y * dab.y + dab.z * dab.z; // squared magnitude of r_ab
-        Scalar rab = sqrt(rsqab);                                     // magnitude of r_ab
-        Scalar rsqcb = dcb.x * dcb.x + dcb.y * dcb.y + dcb.z * dcb.z; // squared magnitude of r_cb
-        Scalar rcb = sqrt(rsqcb);                                     // magnitude of r_cb
-
-        Scalar c_abbc = dab.x * dcb.x + dab.y * dcb.y + dab.z * dcb.z; // = ab dot bc
-        c_abbc /= rab * rcb;                                           // cos(t)
-
-        if (c_abbc > 1.0)
-            c_abbc = 1.0; // how does this ever happen?
-        if (c_abbc < -1.0)
-            c_abbc = -1.0;
-
-        // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
-        Scalar dcosth = c_abbc - cos(m_t_0[angle_type]); // = cos(t) - cos(t0)
-        Scalar tk = m_K[angle_type] * dcosth;            // = k(cos(t) - cos(t0))
-
-        Scalar a = 1.0 * tk;             // = k(cos(t) - cos(t0))
-        Scalar a11 = a * c_abbc / rsqab; // = k(cos(t) - cos(t0)) * cos(t) / r_ij^2
-        Scalar a12 = -a / (rab * rcb);   // = -k(cos(t) - cos(t0)) / (rij * rkj)
-        Scalar a22 = a * c_abbc / rsqcb; // = k(cos(t) - cos(t0)) * cos(t) / r_kj^2
-
-        Scalar fab[3], fcb[3];
-
-        fab[0] = a11 * dab.x + a12 * dcb.x;
-        fab[1] = a11 * dab.y + a12 * dcb.y;
-        fab[2] = a11 * dab.z + a12 * dcb.z;
-
-        fcb[0] = a22 * dcb.x + a12 * dab.x;
-        fcb[1] = a22 * dcb.y + a12 * dab.y;
-        fcb[2] = a22 * dcb.z + a12 * dab.z;
-
-        // the rest of the computation should stay the same
-        // compute 1/3 of the energy, 1/3 for each atom in the angle
-        Scalar angle_eng = (tk * dcosth) * Scalar(1.0 / 6.0);
-
-        // compute 1/3 of the virial, 1/3 for each atom in the angle
-        // upper triangular version of virial tensor
-        Scalar angle_virial[6];
-        angle_virial[0] = Scalar(1. / 3.) * (dab.x * fab[0] + dcb.x * fcb[0]);
-        angle_virial[1] = Scalar(1. / 3.) * (dab.y * fab[0] + dcb.y * fcb[0]);
-        angle_virial[2] = Scalar(1. / 3.) * (dab.z * fab[0] + dcb.z * fcb[0]);
-        angle_virial[3] = Scalar(1. / 3.) * (dab.y * fab[1] + dcb.y * fcb[1]);
-        angle_virial[4] = Scalar(1. / 3.) * (dab.z * fab[1] + dcb.z * fcb[1]);
-        angle_virial[5] = Scalar(1. / 3.) * (dab.z * fab[2] + dcb.z * fcb[2]);
-
-        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
-        // do not update ghost particles
-        if (idx_a < m_pdata->getN())
-            {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_a] += angle_virial[j];
-            }
 
-        if (idx_b < m_pdata->getN())
+    ArrayHandle<AngleData::members_t> h_groups(m_angle_data->getMembersArray(),
+                                               access_location::host,
+                                               access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(),
+                                     access_location::host,
+                                     access_mode::read);
+
+    // compute the forces of the groups [first, last)
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t pitch)
+    {
+        for (unsigned int i = first; i < last; i++)
             {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_b] += angle_virial[j];
+            // lookup the tag of each of the particles participating in the angle
+            const AngleData::members_t& angle = h_groups.data[i];
+            assert(angle.tag[0] <= m_pdata->getMaximumTag());
+            assert(angle.tag[1] <= m_pdata->getMaximumTag());
+            assert(angle.tag[2] <= m_pdata->getMaximumTag());
+
+            // transform a, b, and c into indices into the particle data arrays
+            // MEM TRANSFER: 6 ints
+            unsigned int idx_a = h_rtag.data[angle.tag[0]];
+            unsigned int idx_b = h_rtag.data[angle.tag[1]];
+            unsigned int idx_c = h_rtag.data[angle.tag[2]];
+
+            // throw an error if this angle is incomplete
+            if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
+                {
+                this->m_exec_conf->msg->error()
+                    << "angle.cosinesq: angle " << angle.tag[0] << " " << angle.tag[1] << " "
+                    << angle.tag[2] << " incomplete." << endl
+                    << endl;
+                throw std::runtime_error("Error in angle calculation");
+                }
+
+            assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
+
+            // calculate d\vec{r}
+            Scalar3 dab;
+            dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
+            dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
+            dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
+
+            Scalar3 dcb;
+            dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
+            dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
+            dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
+
+            Scalar3 dac;
+            dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
+            dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
+            dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
+
+            // apply minimum image conventions to all 3 vectors
+            dab = box.minImage(dab);
+            dcb = box.minImage(dcb);
+            dac = box.minImage(dac);
+
+            // this is where cosinesq differs from harmonic
+            // FLOPS: 14 / MEM TRANSFER: 2 Scalars
+
+            // FLOPS: 42 / MEM TRANSFER: 6 Scalars
+            // squared magnitude of r_ab
+            Scalar rsqab = dab.x * dab.x + dab.y * dab.y + dab.z * dab.z;
+            Scalar rab = sqrt(rsqab);                                     // magnitude of r_ab
+            // squared magnitude of r_cb
+            Scalar rsqcb = dcb.x * dcb.x + dcb.y * dcb.y + dcb.z * dcb.z;
+            Scalar rcb = sqrt(rsqcb);                                     // magnitude of r_cb
+
+            Scalar c_abbc = dab.x * dcb.x + dab.y * dcb.y + dab.z * dcb.z; // = ab dot bc
+            c_abbc /= rab * rcb;                                           // cos(t)
+
+            if (c_abbc > 1.0)
+                c_abbc = 1.0; // how does this ever happen?
+            if (c_abbc < -1.0)
+                c_abbc = -1.0;
+
+            // actually calculate the force
+            unsigned int angle_type = h_typeval.data[i].type;
+            Scalar dcosth = c_abbc - cos(m_t_0[angle_type]); // = cos(t) - cos(t0)
+            Scalar tk = m_K[angle_type] * dcosth;            // = k(cos(t) - cos(t0))
+
+            Scalar a = 1.0 * tk;             // = k(cos(t) - cos(t0))
+            Scalar a11 = a * c_abbc / rsqab; // = k(cos(t) - cos(t0)) * cos(t) / r_ij^2
+            Scalar a12 = -a / (rab * rcb);   // = -k(cos(t) - cos(t0)) / (rij * rkj)
+            Scalar a22 = a * c_abbc / rsqcb; // = k(cos(t) - cos(t0)) * cos(t) / r_kj^2
+
+            Scalar fab[3], fcb[3];
+
+            fab[0] = a11 * dab.x + a12 * dcb.x;
+            fab[1] = a11 * dab.y + a12 * dcb.y;
+            fab[2] = a11 * dab.z + a12 * dcb.z;
+
+            fcb[0] = a22 * dcb.x + a12 * dab.x;
+            fcb[1] = a22 * dcb.y + a12 * dab.y;
+            fcb[2] = a22 * dcb.z + a12 * dab.z;
+
+            // the rest of the computation should stay the same
+            // compute 1/3 of the energy, 1/3 for each atom in the angle
+            Scalar angle_eng = (tk * dcosth) * Scalar(1.0 / 6.0);
+
+            // compute 1/3 of the virial, 1/3 for each atom in the angle
+            // upper triangular version of virial tensor
+            Scalar angle_virial[6];
+            angle_virial[0] = Scalar(1. / 3.) * (dab.x * fab[0] + dcb.x * fcb[0]);
+            angle_virial[1] = Scalar(1. / 3.) * (dab.y * fab[0] + dcb.y * fcb[0]);
+            angle_virial[2] = Scalar(1. / 3.) * (dab.z * fab[0] + dcb.z * fcb[0]);
+            angle_virial[3] = Scalar(1. / 3.) * (dab.y * fab[1] + dcb.y * fcb[1]);
+            angle_virial[4] = Scalar(1. / 3.) * (dab.z * fab[1] + dcb.z * fcb[1]);
+            angle_virial[5] = Scalar(1. / 3.) * (dab.z * fab[2] + dcb.z * fcb[2]);
+
+            // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
+            // do not update ghost particles
+            if (idx_a < m_pdata->getN())
+                {
+                force[idx_a].x += fab[0];
+                force[idx_a].y += fab[1];
+                force[idx_a].z += fab[2];
+                force[idx_a].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    virial[j * pitch + idx_a] += angle_virial[j];
+                }
+
+            if (idx_b < m_pdata->getN())
+                {
+                force[idx_b].x -= fab[0] + fcb[0];
+                force[idx_b].y -= fab[1] + fcb[1];
+                force[idx_b].z -= fab[2] + fcb[2];
+                force[idx_b].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    virial[j * pitch + idx_b] += angle_virial[j];
+                }
+
+            if (idx_c < m_pdata->getN())
+                {
+                force[idx_c].x += fcb[0];
+                force[idx_c].y += fcb[1];
+                force[idx_c].z += fcb[2];
+                force[idx_c].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    virial[j * pitch + idx_c] += angle_virial[j];
+                }
             }
+    };
 
-        if (idx_c < m_pdata->getN())
-            {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_c] += angle_virial[j];
-            }
-        }
+    m_chunks.compute(m_exec_conf,
+                     size,
+                     m_pdata->getN(),
+                     h_force.data,
+                     h_virial.data,
+                     virial_pitch,
+                     true,
+                     compute_range);
 
     if (m_prof)
         m_prof->pop();
@@ -275,5 +317,6 @@ void export_CosineSqAngleForceCompute(py::module& m)
         "CosineSqAngleForceCompute")
         .def(py::init<std::shared_ptr<SystemDefinition>>())
         .def("getParams", &CosineSqAngleForceCompute::getParams)
-        .def("setParams", &CosineSqAngleForceCompute::setParamsPython);
+        .def("setParams", &CosineSqAngleForceCompute::setParamsPython)
+        .def("setParamsBulk", &CosineSqAngleForceCompute::setParamsBulk);
     }
@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2021 The Regents of the University of Michigan
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -68,6 +69,9 @@ class PYBIND11_EXPORT CosineSqAngleForceCompute : public ForceCompute
 
     virtual void setParamsPython(std::string type, pybind11::dict params);
 
+    /// Set the parameters for many types from columns of parameter values
+    virtual void setParamsBulk(pybind11::list types, pybind11::dict columns);
+
     /// Get the parameters for a given type
     virtual pybind11::dict getParams(std::string type);
 
@@ -89,6 +93,7 @@ class PYBIND11_EXPORT CosineSqAngleForceCompute : public ForceCompute
     Scalar* m_t_0; //!< r_0 parameter for multiple angle types
 
     std::shared_ptr<AngleData> m_angle_data; //!< Angle data to use in computing angles
+    BondedForceChunks m_chunks;              //!< Per-thread force buffers
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
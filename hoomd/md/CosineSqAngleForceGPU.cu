@@ -76,10 +76,10 @@ gpu_compute_cosinesq_angle_forces_kernel(Scalar4* d_force,
         int cur_angle_abc = apos_list[pitch * angle_idx + idx];
 
         // get the a-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 x_postype = d_pos[cur_angle_x_idx];
+        Scalar4 x_postype = __ldg(d_pos + cur_angle_x_idx);
         Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
         // get the c-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 y_postype = d_pos[cur_angle_y_idx];
+        Scalar4 y_postype = __ldg(d_pos + cur_angle_y_idx);
         Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
 
         if (cur_angle_abc == 0)
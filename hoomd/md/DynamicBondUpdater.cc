@@ -0,0 +1,279 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DynamicBondUpdater.cc
+    \brief Defines the DynamicBondUpdater class
+*/
+
+#include "DynamicBondUpdater.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hoomd;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param nlist Neighbor list to find the pairs that form bonds
+    \param group Particles that form bonds
+    \param bond_type Name of the type of the bonds
+    \param r_form Distance below which bonds form
+    \param p_form Probability to form a bond
+    \param p_break Probability to break a bond
+    \param max_bonds Maximum number of bonds of the type per particle
+*/
+DynamicBondUpdater::DynamicBondUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<NeighborList> nlist,
+                                       std::shared_ptr<ParticleGroup> group,
+                                       const std::string& bond_type,
+                                       Scalar r_form,
+                                       Scalar p_form,
+                                       Scalar p_break,
+                                       unsigned int max_bonds)
+    : Updater(sysdef), m_nlist(nlist), m_group(group), m_bond_data(sysdef->getBondData()),
+      m_bond_type(m_bond_data->getTypeByName(bond_type)), m_r_form(r_form), m_p_form(p_form),
+      m_p_break(p_break), m_max_bonds(max_bonds)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing DynamicBondUpdater" << endl;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        throw std::runtime_error("DynamicBond does not support MPI domain decomposition.");
+        }
+#endif
+
+    unsigned int n_types = m_pdata->getNTypes();
+    m_r_cut_nlist = std::make_shared<GlobalArray<Scalar>>(n_types * n_types, m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        std::fill(h_r_cut_nlist.data, h_r_cut_nlist.data + n_types * n_types, m_r_form);
+        }
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+    }
+
+DynamicBondUpdater::~DynamicBondUpdater()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying DynamicBondUpdater" << endl;
+
+    if (m_attached)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+/*! \param r_form Distance below which bonds form
+ */
+void DynamicBondUpdater::setRForm(Scalar r_form)
+    {
+    m_r_form = r_form;
+
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        std::fill(h_r_cut_nlist.data,
+                  h_r_cut_nlist.data + m_r_cut_nlist->getNumElements(),
+                  m_r_form);
+        }
+
+    if (m_attached)
+        m_nlist->notifyRCutMatrixChange();
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void DynamicBondUpdater::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    if (m_prof)
+        m_prof->push("DynamicBond");
+
+    breakBonds(timestep);
+    formBonds(timestep);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void DynamicBondUpdater::breakBonds(uint64_t timestep)
+    {
+    if (m_p_break <= Scalar(0.0))
+        return;
+
+    // choose the bonds first, removing a bond reorders the bond arrays
+    std::vector<unsigned int> broken;
+        {
+        ArrayHandle<BondData::members_t> h_bonds(m_bond_data->getMembersArray(),
+                                                 access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_bond_tag(m_bond_data->getTags(),
+                                             access_location::host,
+                                             access_mode::read);
+
+        for (unsigned int i = 0; i < m_bond_data->getN(); ++i)
+            {
+            if (h_typeval.data[i].type != m_bond_type)
+                continue;
+
+            const BondData::members_t& bond = h_bonds.data[i];
+            RandomGenerator rng(Seed(RNGIdentifier::DynamicBondUpdater,
+                                     timestep,
+                                     m_sysdef->getSeed()),
+                                Counter(std::min(bond.tag[0], bond.tag[1]),
+                                        std::max(bond.tag[0], bond.tag[1]),
+                                        1));
+
+            if (UniformDistribution<Scalar>()(rng) < m_p_break)
+                broken.push_back(h_bond_tag.data[i]);
+            }
+        }
+
+    for (unsigned int tag : broken)
+        m_bond_data->removeBondedGroup(tag);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void DynamicBondUpdater::formBonds(uint64_t timestep)
+    {
+    if (m_p_form <= Scalar(0.0))
+        return;
+
+    m_nlist->compute(timestep);
+
+    const BoxDim box = m_pdata->getBox();
+    const Scalar r_form_sq = m_r_form * m_r_form;
+    const bool full = m_nlist->getStorageMode() == NeighborList::full;
+    const unsigned int N = m_pdata->getN();
+
+    // read the group members first, the group may access the particle tags
+    std::vector<bool> is_member(N, false);
+    for (unsigned int i = 0; i < m_group->getNumMembers(); ++i)
+        is_member[m_group->getMemberIndex(i)] = true;
+
+    // choose the pairs first, adding a bond may patch the bond table
+    std::vector<std::pair<unsigned int, unsigned int>> formed;
+        {
+        // the table of bonds by particle index holds the bonds that remain after breakBonds()
+        ArrayHandle<BondData::members_t> h_gpu_table(m_bond_data->getGPUTable(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        const Index2D& gpu_table_indexer = m_bond_data->getGPUTableIndexer();
+        ArrayHandle<unsigned int> h_n_bonds(m_bond_data->getNGroupsArray(),
+                                            access_location::host,
+                                            access_mode::read);
+
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(),
+                                              access_location::host,
+                                              access_mode::read);
+
+        // count the bonds of the type per particle
+        std::vector<unsigned int> n_bonds(N, 0);
+        for (unsigned int i = 0; i < N; ++i)
+            for (unsigned int k = 0; k < h_n_bonds.data[i]; ++k)
+                if (h_gpu_table.data[gpu_table_indexer(i, k)].idx[1] == m_bond_type)
+                    n_bonds[i]++;
+
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            if (!is_member[i])
+                continue;
+
+            const vec3<Scalar> pos_i(h_pos.data[i]);
+            const unsigned int head_i = h_head_list.data[i];
+
+            for (unsigned int k = 0; k < h_n_neigh.data[i]; ++k)
+                {
+                if (n_bonds[i] >= m_max_bonds)
+                    break;
+
+                unsigned int j = h_nlist.data[head_i + k];
+
+                // consider each pair once
+                if (j >= N || (full && j < i) || !is_member[j] || n_bonds[j] >= m_max_bonds)
+                    continue;
+
+                vec3<Scalar> dr = box.minImage(vec3<Scalar>(h_pos.data[j]) - pos_i);
+                if (dot(dr, dr) > r_form_sq)
+                    continue;
+
+                // skip bonded pairs
+                bool bonded = false;
+                for (unsigned int b = 0; b < h_n_bonds.data[i]; ++b)
+                    {
+                    const BondData::members_t& entry = h_gpu_table.data[gpu_table_indexer(i, b)];
+                    bonded = bonded || (entry.idx[0] == j && entry.idx[1] == m_bond_type);
+                    }
+                if (bonded)
+                    continue;
+
+                unsigned int tag_i = h_tag.data[i];
+                unsigned int tag_j = h_tag.data[j];
+                RandomGenerator rng(Seed(RNGIdentifier::DynamicBondUpdater,
+                                         timestep,
+                                         m_sysdef->getSeed()),
+                                    Counter(std::min(tag_i, tag_j), std::max(tag_i, tag_j), 0));
+
+                if (UniformDistribution<Scalar>()(rng) < m_p_form)
+                    {
+                    formed.push_back(std::make_pair(tag_i, tag_j));
+                    n_bonds[i]++;
+                    n_bonds[j]++;
+                    }
+                }
+            }
+        }
+
+    for (const auto& pair : formed)
+        m_bond_data->addBondedGroup(Bond(m_bond_type, pair.first, pair.second));
+    }
+
+void export_DynamicBondUpdater(py::module& m)
+    {
+    py::class_<DynamicBondUpdater, Updater, std::shared_ptr<DynamicBondUpdater>>(
+        m,
+        "DynamicBondUpdater")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<NeighborList>,
+                      std::shared_ptr<ParticleGroup>,
+                      const std::string&,
+                      Scalar,
+                      Scalar,
+                      Scalar,
+                      unsigned int>())
+        .def_property("bond_type",
+                      &DynamicBondUpdater::getBondType,
+                      &DynamicBondUpdater::setBondType)
+        .def_property("r_form", &DynamicBondUpdater::getRForm, &DynamicBondUpdater::setRForm)
+        .def_property("p_form", &DynamicBondUpdater::getPForm, &DynamicBondUpdater::setPForm)
+        .def_property("p_break", &DynamicBondUpdater::getPBreak, &DynamicBondUpdater::setPBreak)
+        .def_property("max_bonds",
+                      &DynamicBondUpdater::getMaxBonds,
+                      &DynamicBondUpdater::setMaxBonds);
+    }
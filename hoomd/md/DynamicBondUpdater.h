@@ -0,0 +1,149 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DynamicBondUpdater.h
+    \brief Declares an updater that forms and breaks bonds
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborList.h"
+#include "hoomd/ParticleGroup.h"
+#include "hoomd/Updater.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <string>
+
+#pragma once
+
+/// Forms and breaks bonds of one type
+/** Each time the updater is triggered, every bond of the given type breaks with probability
+ * p_break. Then, every pair of particles in the group that is closer than r_form forms a bond of
+ * the given type with probability p_form, unless either particle already has max_bonds bonds of
+ * that type or the particles are bonded already. The pairs are found with the neighbor list, the
+ * updater adds r_form to the neighbor list cutoffs of all type pairs.
+ *
+ * The random numbers depend on the timestep, the simulation seed, and the particle tags of the
+ * pair, so the result does not depend on the particle order.
+ *
+ * The bonds are added and removed one at a time with BondData::addBondedGroup() and
+ * BondData::removeBondedGroup(). These patch the table of bonds by particle index and the neighbor
+ * list exclusions instead of rebuilding them, see BondedGroupData::patchGPUTable() and
+ * NeighborList::slotBondChange().
+ *
+ * DynamicBondUpdater does not support MPI domain decomposition.
+ */
+class PYBIND11_EXPORT DynamicBondUpdater : public Updater
+    {
+    public:
+    /// Constructor
+    DynamicBondUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<NeighborList> nlist,
+                       std::shared_ptr<ParticleGroup> group,
+                       const std::string& bond_type,
+                       Scalar r_form,
+                       Scalar p_form,
+                       Scalar p_break,
+                       unsigned int max_bonds);
+
+    /// Destructor
+    virtual ~DynamicBondUpdater();
+
+    /// Form and break bonds
+    virtual void update(uint64_t timestep);
+
+    /// Remove the r_cut matrix from the neighbor list when the updater is detached
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+    /// Get the type of the bonds
+    std::string getBondType()
+        {
+        return m_bond_data->getNameByType(m_bond_type);
+        }
+
+    /// Set the type of the bonds
+    void setBondType(const std::string& bond_type)
+        {
+        m_bond_type = m_bond_data->getTypeByName(bond_type);
+        }
+
+    /// Get the distance below which bonds form
+    Scalar getRForm()
+        {
+        return m_r_form;
+        }
+
+    /// Set the distance below which bonds form
+    void setRForm(Scalar r_form);
+
+    /// Get the probability to form a bond
+    Scalar getPForm()
+        {
+        return m_p_form;
+        }
+
+    /// Set the probability to form a bond
+    void setPForm(Scalar p_form)
+        {
+        m_p_form = p_form;
+        }
+
+    /// Get the probability to break a bond
+    Scalar getPBreak()
+        {
+        return m_p_break;
+        }
+
+    /// Set the probability to break a bond
+    void setPBreak(Scalar p_break)
+        {
+        m_p_break = p_break;
+        }
+
+    /// Get the maximum number of bonds per particle
+    unsigned int getMaxBonds()
+        {
+        return m_max_bonds;
+        }
+
+    /// Set the maximum number of bonds per particle
+    void setMaxBonds(unsigned int max_bonds)
+        {
+        m_max_bonds = max_bonds;
+        }
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist;  //!< Neighbor list to find the pairs
+    std::shared_ptr<ParticleGroup> m_group; //!< Particles that form bonds
+    std::shared_ptr<BondData> m_bond_data;  //!< Bonds
+    unsigned int m_bond_type;               //!< Type of the bonds
+    Scalar m_r_form;                        //!< Distance below which bonds form
+    Scalar m_p_form;                        //!< Probability to form a bond
+    Scalar m_p_break;                       //!< Probability to break a bond
+    unsigned int m_max_bonds;               //!< Maximum number of bonds per particle
+
+    /// r_cut matrix added to the neighbor list
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
+
+    /// True while the r_cut matrix is added to the neighbor list
+    bool m_attached = true;
+
+    /// Break bonds
+    void breakBonds(uint64_t timestep);
+
+    /// Form bonds
+    void formBonds(uint64_t timestep);
+    };
+
+/// Export the DynamicBondUpdater to python
+void export_DynamicBondUpdater(pybind11::module& m);
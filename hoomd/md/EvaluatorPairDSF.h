@@ -0,0 +1,180 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_DSF_H__
+#define __PAIR_EVALUATOR_DSF_H__
+
+#ifndef __HIPCC__
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairDSF.h
+    \brief Defines the pair evaluator class for damped shifted force electrostatics
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+//! Class for evaluating the damped shifted force (DSF) electrostatic pair potential
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ
+
+    <b>DSF specifics</b>
+
+    EvaluatorPairDSF evaluates the function:
+
+    \f[
+    V_{\mathrm{DSF}}(r) = q_i q_j \left[ \frac{\mathrm{erfc}(\alpha r)}{r}
+        - \frac{\mathrm{erfc}(\alpha r_c)}{r_c}
+        + \left( \frac{\mathrm{erfc}(\alpha r_c)}{r_c^2}
+        + \frac{2\alpha}{\sqrt{\pi}} \frac{\exp(-\alpha^2 r_c^2)}{r_c} \right) (r - r_c) \right]
+    \f]
+
+    Both the potential and the force go to zero at the cutoff, so the energy shift is not needed.
+    Excluded pairs do not interact and need no correction, unlike the Ewald real space term.
+    The damping parameter \a alpha is placed in \a params.alpha.
+*/
+class EvaluatorPairDSF
+    {
+    public:
+    //! Define the parameter type used by this pair potential evaluator
+    struct param_type
+        {
+        Scalar alpha;
+
+        DEVICE void load_shared(char*& ptr, unsigned int& available_bytes) { }
+
+        HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+#ifdef ENABLE_HIP
+        //! Set CUDA memory hints
+        void set_memory_hints() const { }
+#endif
+
+#ifndef __HIPCC__
+        param_type() : alpha(0) { }
+
+        param_type(pybind11::dict v, bool managed = false)
+            {
+            alpha = v["alpha"].cast<Scalar>();
+            }
+
+        pybind11::dict asDict()
+            {
+            pybind11::dict v;
+            v["alpha"] = alpha;
+            return v;
+            }
+#endif
+        }
+#ifdef SINGLE_PRECISION
+    __attribute__((aligned(8)));
+#else
+    __attribute__((aligned(16)));
+#endif
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairDSF(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), alpha(_params.alpha), qiqj(0)
+        {
+        }
+
+    //! DSF doesn't use diameter
+    DEVICE static bool needsDiameter()
+        {
+        return false;
+        }
+    //! Accept the optional diameter values
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    DEVICE void setDiameter(Scalar di, Scalar dj) { }
+
+    //! DSF uses charge
+    DEVICE static bool needsCharge()
+        {
+        return true;
+        }
+    //! Accept the optional charge values
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj)
+        {
+        qiqj = qi * qj;
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift Ignored, the potential is already zero at the cutoff
+        \note There is no need to check if rsq < rcutsq in this method. Cutoff tests are
+        performed in PotentialPair.
+
+        \return True if they are evaluated or false if they are not because we are beyond the cutoff
+    */
+    DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && qiqj != 0)
+            {
+            Scalar rinv = fast::rsqrt(rsq);
+            Scalar r = Scalar(1.0) / rinv;
+            Scalar rcutinv = fast::rsqrt(rcutsq);
+            Scalar rcut = Scalar(1.0) / rcutinv;
+
+            Scalar two_alpha_sqrtpi = Scalar(2.0) * alpha / fast::sqrt(Scalar(M_PI));
+            Scalar erfc_r = fast::erfc(alpha * r);
+            Scalar erfc_rcut = fast::erfc(alpha * rcut);
+
+            // the force at the cutoff, subtracted to make the force continuous
+            Scalar f_rcut = erfc_rcut * rcutinv * rcutinv
+                            + two_alpha_sqrtpi * fast::exp(-alpha * alpha * rcutsq) * rcutinv;
+            Scalar f_r
+                = erfc_r * rinv * rinv + two_alpha_sqrtpi * fast::exp(-alpha * alpha * rsq) * rinv;
+
+            force_divr = qiqj * (f_r - f_rcut) * rinv;
+            pair_eng = qiqj * (erfc_r * rinv - erfc_rcut * rcutinv + f_rcut * (r - rcut));
+
+            return true;
+            }
+        else
+            return false;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("dsf");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;    //!< Stored rsq from the constructor
+    Scalar rcutsq; //!< Stored rcutsq from the constructor
+    Scalar alpha;  //!< Damping parameter
+    Scalar qiqj;   //!< product of qi and qj
+    };
+
+#endif // __PAIR_EVALUATOR_DSF_H__
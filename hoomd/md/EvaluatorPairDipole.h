@@ -129,7 +129,8 @@ class EvaluatorPairDipole
                                    Scalar _rcutsq,
                                    const param_type& _params)
         : dr(_dr), rcutsq(_rcutsq), q_i(0), q_j(0), quat_i(_quat_i),
-          quat_j(_quat_j), mu_i {0, 0, 0}, mu_j {0, 0, 0}, A(_params.A), kappa(_params.kappa)
+          quat_j(_quat_j), mu_i {0, 0, 0}, mu_j {0, 0, 0}, A(_params.A), kappa(_params.kappa),
+          has_director(false)
         {
         }
 
@@ -162,6 +163,33 @@ class EvaluatorPairDipole
         return true;
         }
 
+    //! Whether the pair potential accepts precomputed directors instead of the orientations
+    HOSTDEVICE static bool needsDirector()
+        {
+        return true;
+        }
+
+    //! Compute the director of a particle
+    /*! \param q Orientation of the particle
+        \param shape Shape of the particle type
+        \returns The dipole moment in the space frame
+    */
+    HOSTDEVICE static vec3<Scalar> computeDirector(const quat<Scalar>& q, const shape_type& shape)
+        {
+        return rotate(q, shape.mu);
+        }
+
+    //! Accept the optional precomputed directors
+    /*! \param director_i Director of particle i
+        \param director_j Director of particle j
+    */
+    HOSTDEVICE void setDirector(const vec3<Scalar>& director_i, const vec3<Scalar>& director_j)
+        {
+        p_i = director_i;
+        p_j = director_j;
+        has_director = true;
+        }
+
     //! Accept the optional diameter values
     /*! \param di Diameter of particle i
         \param dj Diameter of particle j
@@ -223,8 +251,11 @@ class EvaluatorPairDipole
 
         // convert dipole vector in the body frame of each particle to space
         // frame
-        vec3<Scalar> p_i = rotate(quat<Scalar>(quat_i), mu_i);
-        vec3<Scalar> p_j = rotate(quat<Scalar>(quat_j), mu_j);
+        if (!has_director)
+            {
+            p_i = rotate(quat<Scalar>(quat_i), mu_i);
+            p_j = rotate(quat<Scalar>(quat_j), mu_j);
+            }
 
         vec3<Scalar> f;
         vec3<Scalar> t_i;
@@ -330,8 +361,11 @@ class EvaluatorPairDipole
     Scalar4 quat_i, quat_j; //!< Stored quaternion of ith and jth particle from constructor
     vec3<Scalar> mu_i;      /// Magnetic moment for ith particle
     vec3<Scalar> mu_j;      /// Magnetic moment for jth particle
+    vec3<Scalar> p_i;       /// Dipole moment of the ith particle in the space frame
+    vec3<Scalar> p_j;       /// Dipole moment of the jth particle in the space frame
     Scalar A;
     Scalar kappa;
+    bool has_director; /// True when p_i and p_j were set by setDirector()
     // const param_type &params;   //!< The pair potential parameters
     };
 
@@ -134,7 +134,7 @@ class EvaluatorPairGB
                                const Scalar _rcutsq,
                                const param_type& _params)
         : dr(_dr), rcutsq(_rcutsq), qi(_qi), qj(_qj), epsilon(_params.epsilon),
-          lperp(_params.lperp), lpar(_params.lpar)
+          lperp(_params.lperp), lpar(_params.lpar), has_director(false)
         {
         }
 
@@ -167,6 +167,33 @@ class EvaluatorPairGB
         return false;
         }
 
+    //! Whether the pair potential accepts precomputed directors instead of the orientations
+    HOSTDEVICE static bool needsDirector()
+        {
+        return true;
+        }
+
+    //! Compute the director of a particle
+    /*! \param q Orientation of the particle
+        \param shape Shape of the particle type
+        \returns The axis of length lpar in the space frame
+    */
+    HOSTDEVICE static vec3<Scalar> computeDirector(const quat<Scalar>& q, const shape_type& shape)
+        {
+        return rotmat3<Scalar>(conj(q)).row2;
+        }
+
+    //! Accept the optional precomputed directors
+    /*! \param director_i Director of particle i
+        \param director_j Director of particle j
+    */
+    HOSTDEVICE void setDirector(const vec3<Scalar>& director_i, const vec3<Scalar>& director_j)
+        {
+        a3 = director_i;
+        b3 = director_j;
+        has_director = true;
+        }
+
     //! Accept the optional diameter values
     /*! \param di Diameter of particle i
         \param dj Diameter of particle j
@@ -209,13 +236,12 @@ class EvaluatorPairGB
         Scalar r = fast::sqrt(rsq);
         vec3<Scalar> unitr = fast::rsqrt(dot(dr, dr)) * dr;
 
-        // obtain rotation matrices (space->body)
-        rotmat3<Scalar> rotA(conj(qi));
-        rotmat3<Scalar> rotB(conj(qj));
-
-        // last row of rotation matrix
-        vec3<Scalar> a3 = rotA.row2;
-        vec3<Scalar> b3 = rotB.row2;
+        // last row of the rotation matrices (space->body)
+        if (!has_director)
+            {
+            a3 = computeDirector(qi, shape_type());
+            b3 = computeDirector(qj, shape_type());
+            }
 
         Scalar ca = dot(a3, unitr);
         Scalar cb = dot(b3, unitr);
@@ -308,6 +334,9 @@ class EvaluatorPairGB
     Scalar epsilon;
     Scalar lperp;
     Scalar lpar;
+    vec3<Scalar> a3;   //!< Director of particle i
+    vec3<Scalar> b3;   //!< Director of particle j
+    bool has_director; //!< True when the directors were set by setDirector()
     // const param_type &params;  //!< The pair potential parameters
     };
 
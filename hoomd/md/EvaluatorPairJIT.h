@@ -0,0 +1,202 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_JIT_H__
+#define __PAIR_EVALUATOR_JIT_H__
+
+#ifndef __HIPCC__
+#include <stdexcept>
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairJIT.h
+    \brief Defines the pair evaluator class for runtime compiled pair potentials
+*/
+
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+//! Maximum number of user parameters per type pair
+const unsigned int pair_jit_max_params = 8;
+
+//! Signature of the runtime compiled pair function
+/*! \param r_sq Squared distance between the particles
+    \param q_i Charge of particle i
+    \param q_j Charge of particle j
+    \param params User parameters of the type pair
+    \param force_divr Set to the force divided by r
+
+    \returns The pair energy
+*/
+typedef Scalar (*pair_jit_eval_t)(Scalar r_sq,
+                                  Scalar q_i,
+                                  Scalar q_j,
+                                  const Scalar* params,
+                                  Scalar& force_divr);
+
+//! Class for evaluating pair potentials given in C++ code at run time
+/*! The user provides the body of a function with the signature pair_jit_eval_t. On the host,
+    PotentialPairJIT compiles it with LLVM and stores the resulting function pointer in the
+    parameters of every type pair. On the device, PotentialPairJITGPU compiles it with NVRTC as a
+    __device__ function named eval and defines HOOMD_PAIR_JIT_DEVICE before including this header,
+    so that the kernels in PotentialPairGPU.cuh call the user function directly and inline it like
+    any other evaluator.
+
+    The potential is shifted by subtracting the value of the user function at the cutoff.
+*/
+class EvaluatorPairJIT
+    {
+    public:
+    //! Define the parameter type used by this pair potential evaluator
+    struct param_type
+        {
+        Scalar params[pair_jit_max_params]; //!< User parameters
+        pair_jit_eval_t eval;               //!< Host function pointer, unused on the device
+
+        DEVICE void load_shared(char*& ptr, unsigned int& available_bytes) { }
+
+        HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+#ifdef ENABLE_HIP
+        void set_memory_hint() const { }
+#endif
+
+#ifndef __HIPCC__
+        param_type() : eval(nullptr)
+            {
+            for (unsigned int i = 0; i < pair_jit_max_params; ++i)
+                params[i] = Scalar(0.0);
+            }
+
+        param_type(pybind11::dict v, bool managed = false) : param_type()
+            {
+            auto values = v["params"].cast<pybind11::list>();
+            if (values.size() > pair_jit_max_params)
+                {
+                throw std::runtime_error("At most " + std::to_string(pair_jit_max_params)
+                                         + " parameters are supported per type pair.");
+                }
+            for (unsigned int i = 0; i < values.size(); ++i)
+                params[i] = values[i].cast<Scalar>();
+            }
+
+        pybind11::dict asDict()
+            {
+            pybind11::list values;
+            for (unsigned int i = 0; i < pair_jit_max_params; ++i)
+                values.append(params[i]);
+
+            pybind11::dict v;
+            v["params"] = values;
+            return v;
+            }
+#endif
+        }
+#ifdef SINGLE_PRECISION
+    __attribute__((aligned(8)));
+#else
+    __attribute__((aligned(16)));
+#endif
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairJIT(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), qi(0), qj(0), params(_params)
+        {
+        }
+
+    //! The user function does not use the diameter
+    DEVICE static bool needsDiameter()
+        {
+        return false;
+        }
+    //! Accept the optional diameter values
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    DEVICE void setDiameter(Scalar di, Scalar dj) { }
+
+    //! The user function receives the charges
+    DEVICE static bool needsCharge()
+        {
+        return true;
+        }
+    //! Accept the optional charge values
+    /*! \param _qi Charge of particle i
+        \param _qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar _qi, Scalar _qj)
+        {
+        qi = _qi;
+        qj = _qj;
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the
+       cutoff
+
+        \return True if they are evaluated or false if they are not because we are beyond the cutoff
+    */
+    DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq)
+            {
+            pair_eng = callEval(rsq, force_divr);
+
+            if (energy_shift)
+                {
+                Scalar force_divr_cut;
+                pair_eng -= callEval(rcutsq, force_divr_cut);
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("jit");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;        //!< Stored rsq from the constructor
+    Scalar rcutsq;     //!< Stored rcutsq from the constructor
+    Scalar qi;         //!< Charge of particle i
+    Scalar qj;         //!< Charge of particle j
+    param_type params; //!< Parameters of the type pair
+
+    //! Call the user function
+    DEVICE Scalar callEval(Scalar r_sq, Scalar& force_divr)
+        {
+#ifdef HOOMD_PAIR_JIT_DEVICE
+        return eval(r_sq, qi, qj, params.params, force_divr);
+#else
+        return params.eval(r_sq, qi, qj, params.params, force_divr);
+#endif
+        }
+    };
+
+#endif // __PAIR_EVALUATOR_JIT_H__
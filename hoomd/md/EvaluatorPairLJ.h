@@ -223,6 +223,48 @@ class EvaluatorPairLJ
         }
 
 #ifndef __HIPCC__
+    //! Evaluate the force and energy of n pairs at once
+    /*! \param rsq Squared distance between the particles of each pair
+        \param rcutsq Squared cutoff radius of each pair
+        \param params Parameters of each pair
+        \param force_divr Output array of the computed forces divided by r
+        \param pair_eng Output array of the computed pair energies
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        The result for each pair is identical to evalForceAndEnergy(). Pairs that would not be
+        evaluated get zero force and energy. The loop body has no branches so that the compiler can
+        vectorize it over the pairs.
+    */
+    template<unsigned int n>
+    static void evalForceAndEnergyBatch(const Scalar* rsq,
+                                        const Scalar* rcutsq,
+                                        const param_type* params,
+                                        Scalar* force_divr,
+                                        Scalar* pair_eng,
+                                        bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar lj1 = params[k].lj1;
+            const Scalar lj2 = params[k].lj2;
+
+            Scalar r2inv = Scalar(1.0) / rsq[k];
+            Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar f = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
+            Scalar e = r6inv * (lj1 * r6inv - lj2);
+
+            Scalar rcut2inv = Scalar(1.0) / rcutsq[k];
+            Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+            Scalar e_cut = rcut6inv * (lj1 * rcut6inv - lj2);
+            e = energy_shift ? e - e_cut : e;
+
+            bool evaluated = rsq[k] < rcutsq[k] && lj1 != 0;
+            force_divr[k] = evaluated ? f : Scalar(0.0);
+            pair_eng[k] = evaluated ? e : Scalar(0.0);
+            }
+        }
+
     //! Get the name of this potential
     /*! \returns The potential name.
      */
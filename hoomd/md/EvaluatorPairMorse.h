@@ -156,6 +156,47 @@ class EvaluatorPairMorse
         }
 
 #ifndef __HIPCC__
+    //! Evaluate the force and energy of n pairs at once
+    /*! \param rsq Squared distance between the particles of each pair
+        \param rcutsq Squared cutoff radius of each pair
+        \param params Parameters of each pair
+        \param force_divr Output array of the computed forces divided by r
+        \param pair_eng Output array of the computed pair energies
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        See EvaluatorPairLJ::evalForceAndEnergyBatch().
+    */
+    template<unsigned int n>
+    static void evalForceAndEnergyBatch(const Scalar* rsq,
+                                        const Scalar* rcutsq,
+                                        const param_type* params,
+                                        Scalar* force_divr,
+                                        Scalar* pair_eng,
+                                        bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar D0 = params[k].D0;
+            const Scalar alpha = params[k].alpha;
+            const Scalar r0 = params[k].r0;
+
+            Scalar r = fast::sqrt(rsq[k]);
+            Scalar Exp_factor = fast::exp(-alpha * (r - r0));
+            Scalar e = D0 * Exp_factor * (Exp_factor - Scalar(2.0));
+            Scalar f = Scalar(2.0) * D0 * alpha * Exp_factor * (Exp_factor - Scalar(1.0)) / r;
+
+            Scalar rcut = fast::sqrt(rcutsq[k]);
+            Scalar Exp_factor_cut = fast::exp(-alpha * (rcut - r0));
+            Scalar e_cut = D0 * Exp_factor_cut * (Exp_factor_cut - Scalar(2.0));
+            e = energy_shift ? e - e_cut : e;
+
+            bool evaluated = rsq[k] < rcutsq[k];
+            force_divr[k] = evaluated ? f : Scalar(0.0);
+            pair_eng[k] = evaluated ? e : Scalar(0.0);
+            }
+        }
+
     //! Get the name of this potential
     /*! \returns The potential name.
      */
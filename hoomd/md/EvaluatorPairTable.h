@@ -31,6 +31,8 @@
     r < rmin and r >= rcut is 0.
 
     V and F Values are interpolated linearly between two points on either side of the given r.
+    Each entry of the table holds V(i), F(i), V(i+1) - V(i), and F(i+1) - F(i), so one load reads
+    all the data needed for an evaluation.
 */
 class EvaluatorPairTable
     {
@@ -38,9 +40,8 @@ class EvaluatorPairTable
     //! Define the parameter type used by this pair potential evaluator
     struct param_type
         {
-        Scalar rmin;                  //!< the distance of the first index of the table potential
-        ManagedArray<Scalar> V_table; //!< the tabulated energy
-        ManagedArray<Scalar> F_table; //!< the tabulated force specifically - (dV / dr)
+        Scalar rmin;                //!< the distance of the first index of the table potential
+        ManagedArray<Scalar4> table; //!< V, F = -dV/dr, and their increments to the next entry
 
         //! Load dynamic data members into shared memory and increase pointer
         /*! \param ptr Pointer to load data to (will be incremented)
@@ -48,22 +49,19 @@ class EvaluatorPairTable
          */
         DEVICE void load_shared(char*& ptr, unsigned int& available_bytes)
             {
-            V_table.load_shared(ptr, available_bytes);
-            F_table.load_shared(ptr, available_bytes);
+            table.load_shared(ptr, available_bytes);
             }
 
         HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const
             {
-            V_table.allocate_shared(ptr, available_bytes);
-            F_table.allocate_shared(ptr, available_bytes);
+            table.allocate_shared(ptr, available_bytes);
             }
 
 #ifdef ENABLE_HIP
         //! Attach managed memory to CUDA stream
         void set_memory_hint() const
             {
-            V_table.set_memory_hint();
-            F_table.set_memory_hint();
+            table.set_memory_hint();
             }
 #endif
 
@@ -87,16 +85,28 @@ class EvaluatorPairTable
 
             size_t width = V_py.size();
             rmin = v["r_min"].cast<Scalar>();
-            V_table = ManagedArray<Scalar>(static_cast<unsigned int>(width), managed);
-            F_table = ManagedArray<Scalar>(static_cast<unsigned int>(width), managed);
-            std::copy(V_py.data(0), V_py.data(0) + width, V_table.get());
-            std::copy(F_py.data(0), F_py.data(0) + width, F_table.get());
+            table = ManagedArray<Scalar4>(static_cast<unsigned int>(width), managed);
+            for (size_t i = 0; i < width; i++)
+                {
+                // past the last entry, V and F are 0
+                const Scalar V_next = i + 1 < width ? V_py(i + 1) : Scalar(0.0);
+                const Scalar F_next = i + 1 < width ? F_py(i + 1) : Scalar(0.0);
+                table[static_cast<unsigned int>(i)]
+                    = make_scalar4(V_py(i), F_py(i), V_next - V_py(i), F_next - F_py(i));
+                }
             }
 
         pybind11::dict asDict() const
             {
-            const auto V = pybind11::array_t<Scalar>(V_table.size(), V_table.get());
-            const auto F = pybind11::array_t<Scalar>(F_table.size(), F_table.get());
+            auto V = pybind11::array_t<Scalar>(table.size());
+            auto F = pybind11::array_t<Scalar>(table.size());
+            auto V_out = V.mutable_unchecked<1>();
+            auto F_out = F.mutable_unchecked<1>();
+            for (unsigned int i = 0; i < table.size(); i++)
+                {
+                V_out(i) = table[i].x;
+                F_out(i) = table[i].y;
+                }
             auto params = pybind11::dict();
             params["V"] = V;
             params["F"] = F;
@@ -117,8 +127,7 @@ class EvaluatorPairTable
         \param _params Per type pair parameters of this potential
     */
     DEVICE EvaluatorPairTable(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
-        : rsq(_rsq), rcutsq(_rcutsq), rmin(_params.rmin), V_table(_params.V_table),
-          F_table(_params.F_table)
+        : rsq(_rsq), rcutsq(_rcutsq), rmin(_params.rmin), table(_params.table)
         {
         }
 
@@ -157,7 +166,7 @@ class EvaluatorPairTable
     DEVICE bool
     evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, const bool energy_shift) const
         {
-        unsigned int width = V_table.size();
+        unsigned int width = table.size();
 
         const Scalar r = fast::sqrt(rsq);
         // compute the force divided by r in force_divr
@@ -172,23 +181,14 @@ class EvaluatorPairTable
 
         // compute index into the table and read in values
         unsigned int value_i = static_cast<unsigned int>(slow::floor(value_f));
-        // unpack the data
-        const Scalar V0 = V_table[value_i];
-        const Scalar F0 = F_table[value_i];
-        Scalar V1 = 0;
-        Scalar F1 = 0;
-        if (value_i + 1 < width)
-            {
-            V1 = V_table[value_i + 1];
-            F1 = F_table[value_i + 1];
-            }
+        const Scalar4 entry = table[value_i];
 
         // compute the linear interpolation coefficient
         const Scalar f = value_f - Scalar(value_i);
 
         // interpolate to get V and F;
-        const Scalar V = V0 + f * (V1 - V0);
-        const Scalar F = F0 + f * (F1 - F0);
+        const Scalar V = entry.x + f * entry.z;
+        const Scalar F = entry.y + f * entry.w;
 
         // return the force divided by r
         if (rsq > Scalar(0.0))
@@ -219,8 +219,7 @@ class EvaluatorPairTable
     Scalar rcutsq;                //!< the potential cuttoff distance squared
     size_t width;                 //!< the distance between table indices
     Scalar rmin;                  //!< the distance of the first index of the table potential
-    ManagedArray<Scalar> V_table; //!< the tabulated energy
-    ManagedArray<Scalar> F_table; //!< the tabulated force specifically - (dV / dr)
+    ManagedArray<Scalar4> table;  //!< V, F = -dV/dr, and their increments to the next entry
     };
 
 #endif
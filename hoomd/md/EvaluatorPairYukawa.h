@@ -169,6 +169,48 @@ class EvaluatorPairYukawa
         }
 
 #ifndef __HIPCC__
+    //! Evaluate the force and energy of n pairs at once
+    /*! \param rsq Squared distance between the particles of each pair
+        \param rcutsq Squared cutoff radius of each pair
+        \param params Parameters of each pair
+        \param force_divr Output array of the computed forces divided by r
+        \param pair_eng Output array of the computed pair energies
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        See EvaluatorPairLJ::evalForceAndEnergyBatch().
+    */
+    template<unsigned int n>
+    static void evalForceAndEnergyBatch(const Scalar* rsq,
+                                        const Scalar* rcutsq,
+                                        const param_type* params,
+                                        Scalar* force_divr,
+                                        Scalar* pair_eng,
+                                        bool energy_shift)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            {
+            const Scalar epsilon = params[k].epsilon;
+            const Scalar kappa = params[k].kappa;
+
+            Scalar rinv = fast::rsqrt(rsq[k]);
+            Scalar r = Scalar(1.0) / rinv;
+            Scalar r2inv = Scalar(1.0) / rsq[k];
+            Scalar exp_val = fast::exp(-kappa * r);
+            Scalar f = epsilon * exp_val * r2inv * (rinv + kappa);
+            Scalar e = epsilon * exp_val * rinv;
+
+            Scalar rcutinv = fast::rsqrt(rcutsq[k]);
+            Scalar rcut = Scalar(1.0) / rcutinv;
+            Scalar e_cut = epsilon * fast::exp(-kappa * rcut) * rcutinv;
+            e = energy_shift ? e - e_cut : e;
+
+            bool evaluated = rsq[k] < rcutsq[k] && epsilon != 0;
+            force_divr[k] = evaluated ? f : Scalar(0.0);
+            pair_eng[k] = evaluated ? e : Scalar(0.0);
+            }
+        }
+
     //! Get the name of this potential
     /*! \returns The potential name.
      */
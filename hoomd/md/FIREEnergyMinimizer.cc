@@ -496,5 +496,8 @@ void export_FIREEnergyMinimizer(py::module& m)
         .def_property("energy_tol", &FIREEnergyMinimizer::getEtol, &FIREEnergyMinimizer::setEtol)
         .def_property("min_steps_conv",
                       &FIREEnergyMinimizer::getMinSteps,
-                      &FIREEnergyMinimizer::setMinSteps);
+                      &FIREEnergyMinimizer::setMinSteps)
+        .def_property("stop_when_converged",
+                      &FIREEnergyMinimizer::getStopWhenConverged,
+                      &FIREEnergyMinimizer::setStopWhenConverged);
     }
@@ -165,6 +165,24 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
         return m_run_minsteps;
         }
 
+    //! Set whether the run ends when the minimization converges
+    void setStopWhenConverged(bool stop)
+        {
+        m_stop_when_converged = stop;
+        }
+
+    //! Get whether the run ends when the minimization converges
+    bool getStopWhenConverged()
+        {
+        return m_stop_when_converged;
+        }
+
+    //! End the run once converged, when requested
+    virtual bool isRunComplete()
+        {
+        return m_stop_when_converged && m_converged;
+        }
+
     protected:
     //! Function to create the underlying integrator
     unsigned int m_nmin; //!< minimum number of consecutive successful search directions before
@@ -188,6 +206,9 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
     unsigned int m_run_minsteps;  //!< A minimum number of search attempts the search will use
     bool m_was_reset;             //!< whether or not the minimizer was reset
 
+    /// Whether the run ends when the minimization converges
+    bool m_stop_when_converged = false;
+
     private:
     };
 
@@ -13,6 +13,9 @@ using namespace std;
     \brief Contains code for the FIREEnergyMinimizerGPU class
 */
 
+//! Number of sums per integration method: E, P, vsq, fsq, Pr, wsq, and tsq
+const unsigned int n_fire_sums = 7;
+
 /*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
     \param group The group of particles this integration method is to work on
     \param dt Default step size
@@ -27,13 +30,8 @@ FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition>
         throw std::runtime_error("Error initializing FIREEnergyMinimizer");
         }
 
-    // allocate the sum arrays
-    GPUArray<Scalar> sum(1, m_exec_conf);
-    m_sum.swap(sum);
-    GPUArray<Scalar> sum3(3, m_exec_conf);
-    m_sum3.swap(sum3);
-
-    // initialize the partial sum arrays
+    // initialize the sum and partial sum arrays
+    m_sums = GPUVector<Scalar>(m_exec_conf);
     m_partial_sum1 = GPUVector<Scalar>(m_exec_conf);
     m_partial_sum2 = GPUVector<Scalar>(m_exec_conf);
     m_partial_sum3 = GPUVector<Scalar>(m_exec_conf);
@@ -64,6 +62,9 @@ void FIREEnergyMinimizerGPU::resizePartialSumArrays()
         m_partial_sum2.resize(num_blocks);
         m_partial_sum3.resize(num_blocks);
         }
+
+    if (m_sums.size() != m_methods.size() * n_fire_sums)
+        m_sums.resize(m_methods.size() * n_fire_sums);
     }
 
 /*! \param timesteps is the iteration number
@@ -87,157 +88,85 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
     // update partial sum memory space if needed
     resizePartialSumArrays();
 
-    // compute the total energy on the GPU
+    // compute the total energy, P, vnorm, fnorm (and the angular sums) of every method on the GPU
+    // into one array, so that the host waits for the GPU only once per step
     // CPU version is Scalar energy = computePotentialEnergy(timesteps)/Scalar(group_size);
 
     if (m_prof)
-        m_prof->push(m_exec_conf, "FIRE compute total energy");
+        m_prof->push(m_exec_conf, "FIRE sums");
 
     unsigned int total_group_size = 0;
+#ifdef ENABLE_MPI
+    bool aniso = false;
+#endif
 
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
+        ArrayHandle<Scalar> d_partial_sum1(m_partial_sum1,
+                                           access_location::device,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar> d_partial_sum2(m_partial_sum2,
+                                           access_location::device,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar> d_partial_sum3(m_partial_sum3,
+                                           access_location::device,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar> d_sums(m_sums, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                     access_location::device,
+                                     access_mode::read);
 
-        unsigned int group_size = current_group->getNumMembers();
-        total_group_size += group_size;
+        for (unsigned int i = 0; i < m_methods.size(); i++)
+            {
+            std::shared_ptr<ParticleGroup> current_group = m_methods[i]->getGroup();
 
-        ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
+            unsigned int group_size = current_group->getNumMembers();
+            total_group_size += group_size;
 
-            {
-            ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
-                                             access_location::device,
-                                             access_mode::read);
-            ArrayHandle<Scalar> d_partial_sumE(m_partial_sum1,
-                                               access_location::device,
-                                               access_mode::overwrite);
-            ArrayHandle<Scalar> d_sumE(m_sum, access_location::device, access_mode::overwrite);
+            ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
+                                                    access_location::device,
+                                                    access_mode::read);
 
             unsigned int num_blocks = group_size / m_block_size + 1;
+            Scalar* d_method_sums = d_sums.data + i * n_fire_sums;
+
             gpu_fire_compute_sum_pe(d_index_array.data,
                                     group_size,
                                     d_net_force.data,
-                                    d_sumE.data,
-                                    d_partial_sumE.data,
+                                    d_method_sums,
+                                    d_partial_sum1.data,
                                     m_block_size,
                                     num_blocks);
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
-            }
-
-        ArrayHandle<Scalar> h_sumE(m_sum, access_location::host, access_mode::read);
-        energy += h_sumE.data[0];
-        }
-
-#ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &energy,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &total_group_size,
-                      1,
-                      MPI_INT,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        }
-#endif
-
-    m_energy_total = energy;
-    energy /= (Scalar)total_group_size;
-
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
-
-    if (m_was_reset)
-        {
-        m_was_reset = false;
-        m_old_energy = energy + Scalar(100000) * m_etol;
-        }
-
-    // sum P, vnorm, fnorm
-
-    if (m_prof)
-        m_prof->push(m_exec_conf, "FIRE P, vnorm, fnorm");
-
-#ifdef ENABLE_MPI
-    bool aniso = false;
-#endif
-
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-        {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-
-        unsigned int group_size = current_group->getNumMembers();
-        ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
-
-            {
-            ArrayHandle<Scalar> d_partial_sum_P(m_partial_sum1,
-                                                access_location::device,
-                                                access_mode::overwrite);
-            ArrayHandle<Scalar> d_partial_sum_vsq(m_partial_sum2,
-                                                  access_location::device,
-                                                  access_mode::overwrite);
-            ArrayHandle<Scalar> d_partial_sum_fsq(m_partial_sum3,
-                                                  access_location::device,
-                                                  access_mode::overwrite);
-            ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::read);
-            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
-                                         access_location::device,
-                                         access_mode::read);
-
-            unsigned int num_blocks = group_size / m_block_size + 1;
 
             gpu_fire_compute_sum_all(m_pdata->getN(),
                                      d_vel.data,
                                      d_accel.data,
                                      d_index_array.data,
                                      group_size,
-                                     d_sum.data,
-                                     d_partial_sum_P.data,
-                                     d_partial_sum_vsq.data,
-                                     d_partial_sum_fsq.data,
+                                     d_method_sums + 1,
+                                     d_partial_sum1.data,
+                                     d_partial_sum2.data,
+                                     d_partial_sum3.data,
                                      m_block_size,
                                      num_blocks);
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
-            }
 
-        ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-        Pt += h_sum.data[0];
-        vnorm += h_sum.data[1];
-        fnorm += h_sum.data[2];
-
-        if ((*method)->getAnisotropic())
-            {
+            if (m_methods[i]->getAnisotropic())
+                {
 #ifdef ENABLE_MPI
-            aniso = true;
+                aniso = true;
 #endif
 
-                {
-                ArrayHandle<Scalar> d_partial_sum_Pr(m_partial_sum1,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_wnorm(m_partial_sum2,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_tsq(m_partial_sum3,
-                                                      access_location::device,
-                                                      access_mode::overwrite);
-                ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
                 ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
                                                    access_location::device,
                                                    access_mode::read);
@@ -251,8 +180,6 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                                                access_location::device,
                                                access_mode::read);
 
-                unsigned int num_blocks = group_size / m_block_size + 1;
-
                 gpu_fire_compute_sum_all_angular(m_pdata->getN(),
                                                  d_orientation.data,
                                                  d_inertia.data,
@@ -260,26 +187,54 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                                                  d_net_torque.data,
                                                  d_index_array.data,
                                                  group_size,
-                                                 d_sum.data,
-                                                 d_partial_sum_Pr.data,
-                                                 d_partial_sum_wnorm.data,
-                                                 d_partial_sum_tsq.data,
+                                                 d_method_sums + 4,
+                                                 d_partial_sum1.data,
+                                                 d_partial_sum2.data,
+                                                 d_partial_sum3.data,
                                                  m_block_size,
                                                  num_blocks);
 
                 if (m_exec_conf->isCUDAErrorCheckingEnabled())
                     CHECK_CUDA_ERROR();
                 }
-            ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-            Pr += h_sum.data[0];
-            wnorm += h_sum.data[1];
-            tnorm += h_sum.data[2];
+            }
+        }
+
+    // sum over the methods, this is the only point where the host waits for the GPU
+        {
+        ArrayHandle<Scalar> h_sums(m_sums, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < m_methods.size(); i++)
+            {
+            const Scalar* method_sums = h_sums.data + i * n_fire_sums;
+            energy += method_sums[0];
+            Pt += method_sums[1];
+            vnorm += method_sums[2];
+            fnorm += method_sums[3];
+
+            if (m_methods[i]->getAnisotropic())
+                {
+                Pr += method_sums[4];
+                wnorm += method_sums[5];
+                tnorm += method_sums[6];
+                }
             }
         }
 
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &energy,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &total_group_size,
+                      1,
+                      MPI_INT,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE,
                       &fnorm,
                       1,
@@ -323,6 +278,15 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         }
 #endif
 
+    m_energy_total = energy;
+    energy /= (Scalar)total_group_size;
+
+    if (m_was_reset)
+        {
+        m_was_reset = false;
+        m_old_energy = energy + Scalar(100000) * m_etol;
+        }
+
     vnorm = sqrt(vnorm);
     fnorm = sqrt(fnorm);
     wnorm = sqrt(wnorm);
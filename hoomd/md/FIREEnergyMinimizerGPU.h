@@ -43,8 +43,7 @@ class PYBIND11_EXPORT FIREEnergyMinimizerGPU : public FIREEnergyMinimizer
     GPUVector<Scalar> m_partial_sum1; //!< memory space for partial sum over P and E
     GPUVector<Scalar> m_partial_sum2; //!< memory space for partial sum over vsq
     GPUVector<Scalar> m_partial_sum3; //!< memory space for partial sum over asq
-    GPUArray<Scalar> m_sum;           //!< memory space for sum over E
-    GPUArray<Scalar> m_sum3;          //!< memory space for the sum over P, vsq, asq
+    GPUVector<Scalar> m_sums;         //!< memory space for the sums of every integration method
 
     private:
     //! allocate the memory needed to store partial sums
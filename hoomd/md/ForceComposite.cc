@@ -9,6 +9,12 @@
 #include <map>
 #include <sstream>
 #include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace py = pybind11;
 
 /*! \file ForceComposite.cc
@@ -381,6 +387,7 @@ void ForceComposite::validateRigidBodies()
     m_pdata->takeSnapshot(snap);
 
     std::vector<unsigned int> molecule_tag;
+    std::vector<unsigned int> index_in_body;
 
     // number of bodies in system
     unsigned int nbodies = 0;
@@ -399,6 +406,7 @@ void ForceComposite::validateRigidBodies()
         map_t body_particle_count;
 
         molecule_tag.resize(snap.size, NO_MOLECULE);
+        index_in_body.resize(snap.size, NO_BODY);
 
         // count number of constituent particles to add
         for (unsigned i = 0; i < snap.size; ++i)
@@ -465,6 +473,7 @@ void ForceComposite::validateRigidBodies()
                         "is in order of particle tag.");
                     }
                 // increase molecule size by one as particle is validated
+                index_in_body[i] = current_molecule_size;
                 it->second++;
                 // Mark consistent particle in molecule as belonging to its central particle.
                 molecule_tag[i] = molecule_tag[snap.body[i]];
@@ -491,6 +500,7 @@ void ForceComposite::validateRigidBodies()
     if (m_pdata->getDomainDecomposition())
         {
         bcast(molecule_tag, 0, m_exec_conf->getMPICommunicator());
+        bcast(index_in_body, 0, m_exec_conf->getMPICommunicator());
         bcast(nbodies, 0, m_exec_conf->getMPICommunicator());
         }
 #endif
@@ -503,6 +513,7 @@ void ForceComposite::validateRigidBodies()
                                                  access_mode::overwrite);
         std::copy(molecule_tag.begin(), molecule_tag.end(), h_molecule_tag.data);
         }
+    m_index_in_body = std::move(index_in_body);
 
     // store number of molecules in all ranks
     m_n_molecules_global = nbodies;
@@ -565,6 +576,7 @@ void ForceComposite::createRigidBodies()
         }
 
     std::vector<unsigned int> molecule_tag;
+    std::vector<unsigned int> index_in_body;
     unsigned int n_central_particles = snap.size - n_free_bodies;
     unsigned int n_without_constituent = snap.size;
     snap.insert(snap.size, n_constituent_particles);
@@ -576,6 +588,7 @@ void ForceComposite::createRigidBodies()
                                               access_location::host,
                                               access_mode::read);
         molecule_tag.resize(n_central_particles + n_constituent_particles, NO_MOLECULE);
+        index_in_body.resize(n_central_particles + n_constituent_particles, NO_BODY);
 
         unsigned int constituent_particle_tag = n_without_constituent;
         for (unsigned int particle_tag = 0; particle_tag < n_without_constituent; ++particle_tag)
@@ -612,6 +625,7 @@ void ForceComposite::createRigidBodies()
                 // Since the central particle tags here will be [0, n_central_particles), we know
                 // that the molecule number will be the same as the central particle tag.
                 molecule_tag[constituent_particle_tag] = particle_tag;
+                index_in_body[constituent_particle_tag] = current_body_index;
 
                 ++constituent_particle_tag;
                 }
@@ -625,6 +639,7 @@ void ForceComposite::createRigidBodies()
     if (m_pdata->getDomainDecomposition())
         {
         bcast(molecule_tag, 0, m_exec_conf->getMPICommunicator());
+        bcast(index_in_body, 0, m_exec_conf->getMPICommunicator());
         bcast(n_central_particles, 0, m_exec_conf->getMPICommunicator());
         }
 #endif
@@ -637,6 +652,7 @@ void ForceComposite::createRigidBodies()
                                                  access_mode::overwrite);
         std::copy(molecule_tag.begin(), molecule_tag.end(), h_molecule_tag.data);
         }
+    m_index_in_body = std::move(index_in_body);
     m_n_molecules_global = n_central_particles;
 
     m_bodies_changed = false;
@@ -746,8 +762,9 @@ void ForceComposite::computeForces(uint64_t timestep)
         compute_virial = true;
         }
 
-    // loop over all molecules, also incomplete ones
-    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+    // sum the forces of one molecule, also of incomplete ones. Each molecule only writes to its
+    // central particle and its own constituents, so molecules can be processed in parallel.
+    auto sum_molecule = [&](unsigned int ibody)
         {
         // get central particle tag from first particle in molecule
         assert(h_molecule_length.data[ibody] > 0);
@@ -760,7 +777,7 @@ void ForceComposite::computeForces(uint64_t timestep)
         unsigned int central_idx = h_rtag.data[central_tag];
 
         if (central_idx >= n_particles_local)
-            continue;
+            return;
 
         // the central particle must be present
         assert(central_tag == h_tag.data[first_idx]);
@@ -862,7 +879,23 @@ void ForceComposite::computeForces(uint64_t timestep)
             h_net_virial.data[4 * net_virial_pitch + idxj] = 0.0;
             h_net_virial.data[5 * net_virial_pitch + idxj] = 0.0;
             }
-        }
+        };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nmol),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int ibody = r.begin(); ibody != r.end(); ibody++)
+                                      sum_molecule(ibody);
+                              });
+        });
+#else
+    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+        sum_molecule(ibody);
+#endif
     }
 
 /* Set position and velocity of constituent particles in rigid bodies in the 1st or second half of
@@ -916,9 +949,18 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
     const BoxDim& box = m_pdata->getBox();
     const BoxDim& global_box = m_pdata->getGlobalBox();
 
+    // the communicator skips ghost constituents that can be placed relative to their central
+    // particle, including those of bodies that are incomplete on this rank
+    bool rebuild_ghosts = false;
+#ifdef ENABLE_MPI
+    rebuild_ghosts = m_comm && m_comm->isRebuildingRigidGhosts();
+#endif
+
     // we need to update both local and ghost particles
     unsigned int n_particles_local = m_pdata->getN() + m_pdata->getNGhosts();
-    for (unsigned int particle_index = 0; particle_index < n_particles_local; particle_index++)
+
+    // update one constituent particle, which only writes to that particle
+    auto update_particle = [&](unsigned int particle_index)
         {
         unsigned int central_tag = h_body.data[particle_index];
 
@@ -926,25 +968,25 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
         // orientations here.
         if (central_tag >= MIN_FLOPPY)
             {
-            continue;
+            return;
             }
 
         // body tag equals tag for central particle
         assert(central_tag <= m_pdata->getMaximumTag());
         unsigned int central_idx = h_rtag.data[central_tag];
 
-        // If this is a rigid body center continue, since we do not need to update its position or
+        // If this is a rigid body center return, since we do not need to update its position or
         // orientation (the integrator methods do this).
         if (particle_index == central_idx)
             {
-            continue;
+            return;
             }
 
-        // Continue if central particle is on another rank and current index is a ghost particle
+        // Return if central particle is on another rank and current index is a ghost particle
         // since there is no updating to do.
         if (central_idx == NOT_LOCAL && particle_index >= m_pdata->getN())
             {
-            continue;
+            return;
             }
 
         if (central_idx == NOT_LOCAL)
@@ -967,6 +1009,7 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
 
         unsigned int body_len = h_body_len.data[type];
         unsigned int mol_idx = h_molecule_idx.data[particle_index];
+        unsigned int idx_in_body;
         // Checks if the number of local particle in a molecule denoted by
         // h_molecule_len.data[particle_index] is equal to the number of particles in the rigid body
         // definition `body_len`. If this is the case for a ghost particle this is fine, otherwise
@@ -982,16 +1025,22 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
                 throw std::runtime_error(error_msg.str());
                 }
 
-            // otherwise we must ignore it
-            continue;
+            // otherwise we must ignore it, unless its position was not communicated
+            if (!rebuild_ghosts)
+                return;
+
+            // the molecule order does not count the members missing on this rank
+            idx_in_body = m_index_in_body[h_tag.data[particle_index]];
+            }
+        else
+            {
+            // fetch relative index in body from molecule list
+            assert(h_molecule_order.data[particle_index] > 0);
+            idx_in_body = h_molecule_order.data[particle_index] - 1;
             }
 
         int3 img = h_image.data[central_idx];
 
-        // fetch relative index in body from molecule list
-        assert(h_molecule_order.data[particle_index] > 0);
-        unsigned int idx_in_body = h_molecule_order.data[particle_index] - 1;
-
         vec3<Scalar> local_pos(h_body_pos.data[m_body_idx(type, idx_in_body)]);
         vec3<Scalar> dr_space = rotate(orientation, local_pos);
 
@@ -1014,7 +1063,25 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
                                                       h_postype.data[particle_index].w);
         h_orientation.data[particle_index] = quat_to_scalar4(updated_orientation);
         h_image.data[particle_index] = img + imgi;
-        }
+        };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_particles_local),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int particle_index = r.begin();
+                                       particle_index != r.end();
+                                       particle_index++)
+                                      update_particle(particle_index);
+                              });
+        });
+#else
+    for (unsigned int particle_index = 0; particle_index < n_particles_local; particle_index++)
+        update_particle(particle_index);
+#endif
     }
 
 void export_ForceComposite(py::module& m)
@@ -208,6 +208,12 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
     std::vector<Scalar> m_body_max_diameter; //!< List of diameters for all body types
     Scalar m_global_max_d;                   //!< Maximum over all body diameters
 
+    /// Index of each constituent particle in its body definition, by tag
+    /** Places the ghost constituents of bodies that are incomplete on this rank when the
+     * Communicator skips them in ghost updates (Communicator::setRebuildRigidGhosts()).
+     */
+    std::vector<unsigned int> m_index_in_body;
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
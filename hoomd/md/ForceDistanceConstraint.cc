@@ -5,6 +5,7 @@
 
 #include "ForceDistanceConstraint.h"
 
+#include <algorithm>
 #include <string.h>
 using namespace Eigen;
 namespace py = pybind11;
@@ -19,7 +20,10 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
       m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
-      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
+      m_iterative(false), m_iterations(16), m_lagrange_valid(false), m_iter_idx(m_exec_conf),
+      m_iter_r(m_exec_conf), m_iter_q(m_exec_conf), m_iter_diag(m_exec_conf),
+      m_iter_rhs(m_exec_conf), m_iter_sum(m_exec_conf), m_constraint_reorder(true),
+      m_constraints_added_removed(true), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -120,19 +124,30 @@ void ForceDistanceConstraint::computeForces(uint64_t timestep)
         throw std::runtime_error("Error computing constraints.\n");
         }
 
-    // reallocate through amortized resizin
-    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint * n_constraint);
-    m_cvec.resize(n_constraint);
+    if (m_iterative)
+        {
+        // solve for the multipliers without the dense matrix
+        solveConstraintsIterative(timestep);
 
-    // populate the terms in the matrix vector equation
-    fillMatrixVector(timestep);
+        // check violations
+        checkConstraints(timestep);
+        }
+    else
+        {
+        // reallocate through amortized resizin
+        unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+        m_cmatrix.resize(n_constraint * n_constraint);
+        m_cvec.resize(n_constraint);
 
-    // check violations
-    checkConstraints(timestep);
+        // populate the terms in the matrix vector equation
+        fillMatrixVector(timestep);
 
-    // solve the matrix vector equation
-    solveConstraints(timestep);
+        // check violations
+        checkConstraints(timestep);
+
+        // solve the matrix vector equation
+        solveConstraints(timestep);
+        }
 
     // compute forces
     computeConstraintForces(timestep);
@@ -448,6 +463,161 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
         m_prof->pop();
     }
 
+void ForceDistanceConstraint::initLagrangeIterative()
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // the multipliers of the previous step are a good initial guess, unless the constraints changed
+    // order
+    if (!m_lagrange_valid || m_lagrange.size() != n_constraint)
+        {
+        m_lagrange.resize(n_constraint);
+
+        ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+        memset(h_lagrange.data, 0, sizeof(double) * n_constraint);
+        m_lagrange_valid = true;
+        }
+
+    m_iter_r.resize(n_constraint);
+    m_iter_q.resize(n_constraint);
+    m_iter_diag.resize(n_constraint);
+    m_iter_rhs.resize(n_constraint);
+    m_iter_sum.resize(m_pdata->getN() + m_pdata->getNGhosts());
+    }
+
+/*! The constraint matrix couples two constraints only when they share a particle. Writing
+    g_i = sum_m (+-) lambda_m r_m over the constraints m of particle i (+ for the first member, -
+    for the second), the product of the matrix with the multipliers is
+
+        (A lambda)_n = 4 q_n . (g_a / m_a - g_b / m_b)
+
+    for constraint n between particles a and b. Each Jacobi iteration computes g for every particle
+    and then updates lambda_n += (c_n - (A lambda)_n) / A_nn. The cost and memory of an iteration
+    scale linearly with the number of constraints. The iterations start from the multipliers of the
+    previous step, which change little between steps.
+*/
+void ForceDistanceConstraint::solveConstraintsIterative(uint64_t timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0)
+        return;
+
+    if (m_prof)
+        m_prof->push("iterate");
+
+    initLagrangeIterative();
+    m_iter_idx.resize(n_constraint);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    // access constraint data
+    ArrayHandle<ConstraintData::members_t> h_groups(m_cdata->getMembersArray(),
+                                                    access_location::host,
+                                                    access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_cdata->getTypeValArray(),
+                                     access_location::host,
+                                     access_mode::read);
+
+    // access solver arrays
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+    ArrayHandle<uint2> h_idx(m_iter_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_r(m_iter_r, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_q(m_iter_q, access_location::host, access_mode::overwrite);
+    ArrayHandle<double> h_diag(m_iter_diag, access_location::host, access_mode::overwrite);
+    ArrayHandle<double> h_rhs(m_iter_rhs, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_sum(m_iter_sum, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        // transform a and b into indices into the particle data arrays
+        const ConstraintData::members_t& constraint = h_groups.data[n];
+        unsigned int idx_a = h_rtag.data[constraint.tag[0]];
+        unsigned int idx_b = h_rtag.data[constraint.tag[1]];
+
+        if (idx_a >= max_local || idx_b >= max_local)
+            {
+            this->m_exec_conf->msg->error()
+                << "constrain.distance(): constraint " << constraint.tag[0] << " "
+                << constraint.tag[1] << " incomplete." << std::endl
+                << std::endl;
+            throw std::runtime_error("Error in constraint calculation");
+            }
+
+        vec3<Scalar> rn(box.minImage(vec3<Scalar>(h_pos.data[idx_a])
+                                     - vec3<Scalar>(h_pos.data[idx_b])));
+
+        Scalar ma(h_vel.data[idx_a].w);
+        Scalar mb(h_vel.data[idx_b].w);
+        vec3<Scalar> rndot(vec3<Scalar>(h_vel.data[idx_a]) - vec3<Scalar>(h_vel.data[idx_b]));
+        vec3<Scalar> qn(rn + rndot * m_deltaT);
+
+        // get constraint distance
+        Scalar d = h_typeval.data[n].val;
+
+        // check distance violation
+        if (fast::sqrt(dot(rn, rn)) - d >= m_rel_tol * d || std::isnan(dot(rn, rn)))
+            {
+            m_constraint_violated.resetFlags(n + 1);
+            }
+
+        h_idx.data[n] = make_uint2(idx_a, idx_b);
+        h_r.data[n] = make_scalar4(rn.x, rn.y, rn.z, Scalar(0.0));
+        h_q.data[n] = make_scalar4(qn.x, qn.y, qn.z, Scalar(0.0));
+        h_diag.data[n] = double(4.0) * dot(qn, rn) * (Scalar(1.0) / ma + Scalar(1.0) / mb);
+        h_rhs.data[n] = (dot(qn, qn) - d * d) / m_deltaT / m_deltaT
+                        + double(2.0)
+                              * dot(qn,
+                                    vec3<Scalar>(h_netforce.data[idx_a]) / ma
+                                        - vec3<Scalar>(h_netforce.data[idx_b]) / mb);
+        }
+
+    for (unsigned int iteration = 0; iteration < m_iterations; ++iteration)
+        {
+        // sum lambda*r over the constraints of each particle
+        memset(h_sum.data, 0, sizeof(Scalar4) * max_local);
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            {
+            uint2 idx = h_idx.data[n];
+            Scalar lambda = (Scalar)h_lagrange.data[n];
+            Scalar4 r = h_r.data[n];
+
+            h_sum.data[idx.x].x += lambda * r.x;
+            h_sum.data[idx.x].y += lambda * r.y;
+            h_sum.data[idx.x].z += lambda * r.z;
+            h_sum.data[idx.y].x -= lambda * r.x;
+            h_sum.data[idx.y].y -= lambda * r.y;
+            h_sum.data[idx.y].z -= lambda * r.z;
+            }
+
+        // Jacobi update of the multipliers
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            {
+            uint2 idx = h_idx.data[n];
+            vec3<Scalar> ga(h_sum.data[idx.x]);
+            vec3<Scalar> gb(h_sum.data[idx.y]);
+            vec3<Scalar> qn(h_q.data[n]);
+
+            double Alambda = double(4.0)
+                             * dot(qn, ga / h_vel.data[idx.x].w - gb / h_vel.data[idx.y].w);
+            h_lagrange.data[n] += (h_rhs.data[n] - Alambda) / h_diag.data[n];
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void ForceDistanceConstraint::computeConstraintForces(uint64_t timestep)
     {
     ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::read);
@@ -606,7 +776,7 @@ Scalar ForceDistanceConstraint::askGhostLayerWidth(unsigned int type)
         m_constraints_added_removed = false;
         }
 
-    return m_d_max;
+    return type < m_d_max_type.size() ? m_d_max_type[type] : m_d_max;
     }
 
 void ForceDistanceConstraint::assignMoleculeTags()
@@ -651,6 +821,7 @@ void ForceDistanceConstraint::assignMoleculeTags()
 
     // maximum molecule diameter
     m_d_max = Scalar(0.0);
+    std::vector<Scalar> molecule_d;
 
         {
         // label ptls by connected component index
@@ -661,6 +832,7 @@ void ForceDistanceConstraint::assignMoleculeTags()
                 // depth first search
                 Scalar d
                     = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length);
+                molecule_d.push_back(d);
                 if (d > m_d_max)
                     {
                     m_d_max = d;
@@ -669,6 +841,38 @@ void ForceDistanceConstraint::assignMoleculeTags()
             }
         }
 
+    // the ghost layer of a type only needs to cover the molecules that contain it
+    m_d_max_type.assign(m_pdata->getNTypes(), Scalar(0.0));
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            unsigned int mol = h_molecule_tag.data[h_tag.data[i]];
+            if (mol == NO_MOLECULE)
+                continue;
+
+            unsigned int type = __scalar_as_int(h_pos.data[i].w);
+            m_d_max_type[type] = std::max(m_d_max_type[type], molecule_d[mol]);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      m_d_max_type.data(),
+                      (int)m_d_max_type.size(),
+                      MPI_HOOMD_SCALAR,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
     m_exec_conf->msg->notice(6) << "Maximum constraint length: " << m_d_max << std::endl;
     m_n_molecules_global = molecule;
     }
@@ -681,5 +885,11 @@ void export_ForceDistanceConstraint(py::module& m)
         .def(py::init<std::shared_ptr<SystemDefinition>>())
         .def_property("tolerance",
                       &ForceDistanceConstraint::getRelativeTolerance,
-                      &ForceDistanceConstraint::setRelativeTolerance);
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolver,
+                      &ForceDistanceConstraint::setSolver)
+        .def_property("iterations",
+                      &ForceDistanceConstraint::getIterations,
+                      &ForceDistanceConstraint::setIterations);
     }
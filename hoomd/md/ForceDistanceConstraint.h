@@ -61,6 +61,49 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         return m_rel_tol;
         }
 
+    /// Set the solver for the Lagrange multipliers
+    /** \param solver "direct" to factorize the sparse constraint matrix, "iterative" to solve the
+        constraint equation with Jacobi iterations
+    */
+    void setSolver(const std::string& solver)
+        {
+        if (solver == "direct")
+            {
+            // rebuild the sparse matrix, its lookup table is not maintained by the iterative solver
+            if (m_iterative)
+                {
+                m_constraint_reorder = true;
+                m_condition.resetFlags(1);
+                }
+            m_iterative = false;
+            }
+        else if (solver == "iterative")
+            {
+            m_iterative = true;
+            m_lagrange_valid = false;
+            }
+        else
+            throw std::invalid_argument("Invalid solver: " + solver);
+        }
+
+    /// Get the solver for the Lagrange multipliers
+    std::string getSolver()
+        {
+        return m_iterative ? "iterative" : "direct";
+        }
+
+    /// Set the number of iterations of the iterative solver
+    void setIterations(unsigned int iterations)
+        {
+        m_iterations = iterations;
+        }
+
+    /// Get the number of iterations of the iterative solver
+    unsigned int getIterations()
+        {
+        return m_iterations;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -88,11 +131,25 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     GPUVector<int>
         m_sparse_idxlookup; //!< Reverse lookup from column-major to sparse matrix element
 
+    bool m_iterative;          //!< True to solve for the Lagrange multipliers iteratively
+    unsigned int m_iterations; //!< Number of Jacobi iterations per step
+    bool m_lagrange_valid;     //!< True if m_lagrange holds multipliers in the current order
+
+    GPUVector<uint2> m_iter_idx;   //!< Particle indices of each constraint (CPU only)
+    GPUVector<Scalar4> m_iter_r;   //!< Separation of each constraint
+    GPUVector<Scalar4> m_iter_q;   //!< Separation of each constraint at t+deltaT
+    GPUVector<double> m_iter_diag; //!< Diagonal elements of the constraint matrix
+    GPUVector<double> m_iter_rhs;  //!< The vector on the RHS of the constraint equation
+    GPUVector<Scalar4> m_iter_sum; //!< Sum of lambda*r over the constraints of each particle / m
+
     bool m_constraint_reorder;        //!< True if groups have changed
     bool m_constraints_added_removed; //!< True if global constraint topology has changed
 
     Scalar m_d_max; //!< Maximum constraint extension
 
+    /// Maximum extension of the molecules that contain a particle of each type
+    std::vector<Scalar> m_d_max_type;
+
     //! Compute the forces
     virtual void computeForces(uint64_t timestep);
 
@@ -108,10 +165,17 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     //! Solve the linear matrix-vector equation
     virtual void computeConstraintForces(uint64_t timestep);
 
+    //! Solve the constraint equation with Jacobi iterations, without forming the matrix
+    virtual void solveConstraintsIterative(uint64_t timestep);
+
+    //! Reset the multipliers if the iterative solver can not start from the previous step
+    void initLagrangeIterative();
+
     //! Method called when constraint order changes
     virtual void slotConstraintReorder()
         {
         m_constraint_reorder = true;
+        m_lagrange_valid = false;
         }
 
     //! Method called when constraint order changes
@@ -120,8 +184,10 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         m_constraints_added_removed = true;
         }
 
-    //! Returns the requested ghost layer width for all types
+    //! Returns the requested ghost layer width for a type
     /*! \param type the type for which we are requesting info
+
+        Types that are not part of any constrained molecule request no ghost layer.
      */
     virtual Scalar askGhostLayerWidth(unsigned int type);
 
@@ -42,6 +42,13 @@ ForceDistanceConstraintGPU::ForceDistanceConstraintGPU(std::shared_ptr<SystemDef
                                       100000,
                                       "dist_constraint_force",
                                       this->m_exec_conf));
+    m_tuner_iterate.reset(new Autotuner(warp_size,
+                                        1024,
+                                        warp_size,
+                                        5,
+                                        100000,
+                                        "dist_constraint_iterate",
+                                        this->m_exec_conf));
 
 #ifdef CUSOLVER_AVAILABLE
     // initialize cuSPARSE
@@ -138,7 +145,7 @@ void ForceDistanceConstraintGPU::fillMatrixVector(uint64_t timestep)
         ArrayHandle<double> d_cvec(m_cvec, access_location::device, access_mode::overwrite);
 
         // access GPU constraint table on device
-        const GPUArray<ConstraintData::members_t>& gpu_constraint_list
+        const GlobalArray<ConstraintData::members_t>& gpu_constraint_list
             = this->m_cdata->getGPUTable();
         const Index2D& gpu_table_indexer = this->m_cdata->getGPUTableIndexer();
 
@@ -685,6 +692,86 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
 #endif
     }
 
+void ForceDistanceConstraintGPU::solveConstraintsIterative(uint64_t timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0)
+        return;
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "iterate");
+
+    initLagrangeIterative();
+
+    // access solver arrays
+    ArrayHandle<double> d_lagrange(m_lagrange, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar4> d_r(m_iter_r, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_q(m_iter_q, access_location::device, access_mode::overwrite);
+    ArrayHandle<double> d_diag(m_iter_diag, access_location::device, access_mode::overwrite);
+    ArrayHandle<double> d_rhs(m_iter_rhs, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_sum(m_iter_sum, access_location::device, access_mode::overwrite);
+
+    // access GPU constraint table on device
+    const GlobalArray<ConstraintData::members_t>& gpu_constraint_list
+        = this->m_cdata->getGPUTable();
+    const Index2D& gpu_table_indexer = this->m_cdata->getGPUTableIndexer();
+
+    ArrayHandle<ConstraintData::members_t> d_gpu_clist(gpu_constraint_list,
+                                                       access_location::device,
+                                                       access_mode::read);
+    ArrayHandle<unsigned int> d_gpu_n_constraints(this->m_cdata->getNGroupsArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+    ArrayHandle<unsigned int> d_gpu_cpos(m_cdata->getGPUPosTable(),
+                                         access_location::device,
+                                         access_mode::read);
+    ArrayHandle<typeval_t> d_group_typeval(m_cdata->getTypeValArray(),
+                                           access_location::device,
+                                           access_mode::read);
+
+    // access particle data
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<Scalar4> d_netforce(m_pdata->getNetForce(),
+                                    access_location::device,
+                                    access_mode::read);
+
+    m_tuner_iterate->begin();
+    gpu_solve_constraints_iterative(m_pdata->getN() + m_pdata->getNGhosts(),
+                                    d_lagrange.data,
+                                    d_r.data,
+                                    d_q.data,
+                                    d_diag.data,
+                                    d_rhs.data,
+                                    d_sum.data,
+                                    m_iterations,
+                                    m_rel_tol,
+                                    m_constraint_violated.getDeviceFlags(),
+                                    d_pos.data,
+                                    d_vel.data,
+                                    d_netforce.data,
+                                    d_gpu_clist.data,
+                                    gpu_table_indexer,
+                                    d_gpu_n_constraints.data,
+                                    d_gpu_cpos.data,
+                                    d_group_typeval.data,
+                                    m_deltaT,
+                                    m_pdata->getBox(),
+                                    m_tuner_iterate->getParam());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_tuner_iterate->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
 void ForceDistanceConstraintGPU::computeConstraintForces(uint64_t timestep)
     {
     if (m_prof)
@@ -701,7 +788,8 @@ void ForceDistanceConstraintGPU::computeConstraintForces(uint64_t timestep)
     ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
 
     // access GPU constraint table on device
-    const GPUArray<ConstraintData::members_t>& gpu_constraint_list = this->m_cdata->getGPUTable();
+    const GlobalArray<ConstraintData::members_t>& gpu_constraint_list
+        = this->m_cdata->getGPUTable();
     const Index2D& gpu_table_indexer = this->m_cdata->getGPUTableIndexer();
 
     ArrayHandle<ConstraintData::members_t> d_gpu_clist(gpu_constraint_list,
@@ -323,6 +323,253 @@ __global__ void gpu_fill_constraint_forces_kernel(unsigned int nptl_local,
     d_virial[5 * virial_pitch + idx] = virialzz;
     }
 
+//! Kernel to compute the terms of the constraint equation for the iterative solver
+/*! One thread per particle fills the constraints in which the particle is the first member.
+ */
+__global__ void gpu_fill_constraints_iterative_kernel(unsigned int nptl_local,
+                                                      Scalar4* d_r,
+                                                      Scalar4* d_q,
+                                                      double* d_diag,
+                                                      double* d_rhs,
+                                                      Scalar rel_tol,
+                                                      unsigned int* d_constraint_violated,
+                                                      const Scalar4* d_pos,
+                                                      const Scalar4* d_vel,
+                                                      const Scalar4* d_netforce,
+                                                      const group_storage<2>* d_gpu_clist,
+                                                      const Index2D gpu_clist_indexer,
+                                                      const unsigned int* d_gpu_n_constraints,
+                                                      const unsigned int* d_gpu_cpos,
+                                                      const typeval_union* d_group_typeval,
+                                                      Scalar deltaT,
+                                                      const BoxDim box)
+    {
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= nptl_local)
+        return;
+
+    // load number of constraints per this ptl
+    unsigned int n_constraint_ptl = d_gpu_n_constraints[idx];
+
+    for (unsigned int cidx = 0; cidx < n_constraint_ptl; cidx++)
+        {
+        // only the first member fills the constraint
+        if (d_gpu_cpos[gpu_clist_indexer(idx, cidx)] != 0)
+            continue;
+
+        group_storage<2> cur_constraint = d_gpu_clist[gpu_clist_indexer(idx, cidx)];
+
+        // the other ptl in the constraint
+        unsigned int idx_b = cur_constraint.idx[0];
+
+        // constraint index
+        unsigned int n = cur_constraint.idx[1];
+
+        // the constraint distance
+        Scalar d = d_group_typeval[n].val;
+
+        // constraint separation
+        vec3<Scalar> rn(box.minImage(vec3<Scalar>(d_pos[idx]) - vec3<Scalar>(d_pos[idx_b])));
+
+        // get masses
+        Scalar ma = d_vel[idx].w;
+        Scalar mb = d_vel[idx_b].w;
+
+        // constraint separation at t+2*deltaT
+        vec3<Scalar> rndot(vec3<Scalar>(d_vel[idx]) - vec3<Scalar>(d_vel[idx_b]));
+        vec3<Scalar> qn(rn + deltaT * rndot);
+
+        if (fast::sqrt(dot(rn, rn)) - d >= rel_tol * d || isnan(dot(rn, rn)))
+            {
+            *d_constraint_violated = n + 1;
+            }
+
+        d_r[n] = make_scalar4(rn.x, rn.y, rn.z, Scalar(0.0));
+        d_q[n] = make_scalar4(qn.x, qn.y, qn.z, Scalar(0.0));
+        d_diag[n] = double(4.0) * dot(qn, rn) * (Scalar(1.0) / ma + Scalar(1.0) / mb);
+        d_rhs[n] = (dot(qn, qn) - d * d) / deltaT / deltaT
+                   + double(2.0)
+                         * dot(qn,
+                               vec3<Scalar>(d_netforce[idx]) / ma
+                                   - vec3<Scalar>(d_netforce[idx_b]) / mb);
+        }
+    }
+
+//! Kernel to sum lambda*r over the constraints of each particle, divided by the particle mass
+__global__ void gpu_sum_constraints_iterative_kernel(unsigned int nptl_local,
+                                                     Scalar4* d_sum,
+                                                     const Scalar4* d_r,
+                                                     const double* d_lagrange,
+                                                     const Scalar4* d_vel,
+                                                     const group_storage<2>* d_gpu_clist,
+                                                     const Index2D gpu_clist_indexer,
+                                                     const unsigned int* d_gpu_n_constraints,
+                                                     const unsigned int* d_gpu_cpos)
+    {
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= nptl_local)
+        return;
+
+    // load number of constraints per this ptl
+    unsigned int n_constraint_ptl = d_gpu_n_constraints[idx];
+
+    vec3<Scalar> g(0.0, 0.0, 0.0);
+    for (unsigned int cidx = 0; cidx < n_constraint_ptl; cidx++)
+        {
+        unsigned int n = d_gpu_clist[gpu_clist_indexer(idx, cidx)].idx[1];
+        Scalar lambda = (Scalar)d_lagrange[n];
+
+        if (d_gpu_cpos[gpu_clist_indexer(idx, cidx)] == 0)
+            g += lambda * vec3<Scalar>(d_r[n]);
+        else
+            g -= lambda * vec3<Scalar>(d_r[n]);
+        }
+
+    g = g / d_vel[idx].w;
+    d_sum[idx] = make_scalar4(g.x, g.y, g.z, Scalar(0.0));
+    }
+
+//! Kernel to perform one Jacobi update of the Lagrange multipliers
+__global__ void gpu_update_constraints_iterative_kernel(unsigned int nptl_local,
+                                                        double* d_lagrange,
+                                                        const Scalar4* d_sum,
+                                                        const Scalar4* d_q,
+                                                        const double* d_diag,
+                                                        const double* d_rhs,
+                                                        const group_storage<2>* d_gpu_clist,
+                                                        const Index2D gpu_clist_indexer,
+                                                        const unsigned int* d_gpu_n_constraints,
+                                                        const unsigned int* d_gpu_cpos)
+    {
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= nptl_local)
+        return;
+
+    // load number of constraints per this ptl
+    unsigned int n_constraint_ptl = d_gpu_n_constraints[idx];
+
+    for (unsigned int cidx = 0; cidx < n_constraint_ptl; cidx++)
+        {
+        // only the first member updates the constraint
+        if (d_gpu_cpos[gpu_clist_indexer(idx, cidx)] != 0)
+            continue;
+
+        group_storage<2> cur_constraint = d_gpu_clist[gpu_clist_indexer(idx, cidx)];
+        unsigned int idx_b = cur_constraint.idx[0];
+        unsigned int n = cur_constraint.idx[1];
+
+        vec3<Scalar> qn(d_q[n]);
+        double Alambda
+            = double(4.0) * dot(qn, vec3<Scalar>(d_sum[idx]) - vec3<Scalar>(d_sum[idx_b]));
+        d_lagrange[n] += (d_rhs[n] - Alambda) / d_diag[n];
+        }
+    }
+
+/*! \param nptl_local Number of local and ghost particles
+    \param d_lagrange Lagrange multipliers, updated in place
+    \param d_r Separation of each constraint (output)
+    \param d_q Separation of each constraint at t+deltaT (output)
+    \param d_diag Diagonal elements of the constraint matrix (output)
+    \param d_rhs RHS of the constraint equation (output)
+    \param d_sum Per particle scratch space
+    \param n_iterations Number of Jacobi iterations
+
+    See ForceDistanceConstraint::solveConstraintsIterative() for the algorithm.
+*/
+hipError_t gpu_solve_constraints_iterative(unsigned int nptl_local,
+                                           double* d_lagrange,
+                                           Scalar4* d_r,
+                                           Scalar4* d_q,
+                                           double* d_diag,
+                                           double* d_rhs,
+                                           Scalar4* d_sum,
+                                           unsigned int n_iterations,
+                                           Scalar rel_tol,
+                                           unsigned int* d_constraint_violated,
+                                           const Scalar4* d_pos,
+                                           const Scalar4* d_vel,
+                                           const Scalar4* d_netforce,
+                                           const group_storage<2>* d_gpu_clist,
+                                           const Index2D& gpu_clist_indexer,
+                                           const unsigned int* d_gpu_n_constraints,
+                                           const unsigned int* d_gpu_cpos,
+                                           const typeval_union* d_group_typeval,
+                                           Scalar deltaT,
+                                           const BoxDim box,
+                                           unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_fill_constraints_iterative_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    // run configuration
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = nptl_local / run_block_size + 1;
+
+    hipLaunchKernelGGL((gpu_fill_constraints_iterative_kernel),
+                       dim3(n_blocks),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       nptl_local,
+                       d_r,
+                       d_q,
+                       d_diag,
+                       d_rhs,
+                       rel_tol,
+                       d_constraint_violated,
+                       d_pos,
+                       d_vel,
+                       d_netforce,
+                       d_gpu_clist,
+                       gpu_clist_indexer,
+                       d_gpu_n_constraints,
+                       d_gpu_cpos,
+                       d_group_typeval,
+                       deltaT,
+                       box);
+
+    for (unsigned int iteration = 0; iteration < n_iterations; ++iteration)
+        {
+        hipLaunchKernelGGL((gpu_sum_constraints_iterative_kernel),
+                           dim3(n_blocks),
+                           dim3(run_block_size),
+                           0,
+                           0,
+                           nptl_local,
+                           d_sum,
+                           d_r,
+                           d_lagrange,
+                           d_vel,
+                           d_gpu_clist,
+                           gpu_clist_indexer,
+                           d_gpu_n_constraints,
+                           d_gpu_cpos);
+
+        hipLaunchKernelGGL((gpu_update_constraints_iterative_kernel),
+                           dim3(n_blocks),
+                           dim3(run_block_size),
+                           0,
+                           0,
+                           nptl_local,
+                           d_lagrange,
+                           d_sum,
+                           d_q,
+                           d_diag,
+                           d_rhs,
+                           d_gpu_clist,
+                           gpu_clist_indexer,
+                           d_gpu_n_constraints,
+                           d_gpu_cpos);
+        }
+
+    return hipSuccess;
+    }
+
 #ifdef CUSOLVER_AVAILABLE
 hipError_t gpu_count_nnz(unsigned int n_constraint,
                          double* d_matrix,
@@ -32,6 +32,28 @@ hipError_t gpu_fill_matrix_vector(unsigned int n_constraint,
                                   const BoxDim box,
                                   unsigned int block_size);
 
+hipError_t gpu_solve_constraints_iterative(unsigned int nptl_local,
+                                           double* d_lagrange,
+                                           Scalar4* d_r,
+                                           Scalar4* d_q,
+                                           double* d_diag,
+                                           double* d_rhs,
+                                           Scalar4* d_sum,
+                                           unsigned int n_iterations,
+                                           Scalar rel_tol,
+                                           unsigned int* d_constraint_violated,
+                                           const Scalar4* d_pos,
+                                           const Scalar4* d_vel,
+                                           const Scalar4* d_netforce,
+                                           const group_storage<2>* d_gpu_clist,
+                                           const Index2D& gpu_clist_indexer,
+                                           const unsigned int* d_gpu_n_constraints,
+                                           const unsigned int* d_gpu_cpos,
+                                           const typeval_union* d_group_typeval,
+                                           Scalar deltaT,
+                                           const BoxDim box,
+                                           unsigned int block_size);
+
 #ifdef CUSOLVER_AVAILABLE
 #include <cusparse.h>
 
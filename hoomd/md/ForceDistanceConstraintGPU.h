@@ -58,14 +58,17 @@ class ForceDistanceConstraintGPU : public ForceDistanceConstraint
 
         m_tuner_fill->setPeriod(period);
         m_tuner_force->setPeriod(period);
+        m_tuner_iterate->setPeriod(period);
 
         m_tuner_fill->setEnabled(enable);
         m_tuner_force->setEnabled(enable);
+        m_tuner_iterate->setEnabled(enable);
         }
 
     protected:
-    std::unique_ptr<Autotuner> m_tuner_fill;  //!< Autotuner for filling the constraint matrix
-    std::unique_ptr<Autotuner> m_tuner_force; //!< Autotuner for populating the force array
+    std::unique_ptr<Autotuner> m_tuner_fill;    //!< Autotuner for filling the constraint matrix
+    std::unique_ptr<Autotuner> m_tuner_force;   //!< Autotuner for populating the force array
+    std::unique_ptr<Autotuner> m_tuner_iterate; //!< Autotuner for the iterative solver
 
 #ifdef CUSOLVER_AVAILABLE
     cusparseHandle_t m_cusparse_handle;        //!< cuSPARSE handle
@@ -120,6 +123,9 @@ class ForceDistanceConstraintGPU : public ForceDistanceConstraint
 
     //! Compute the constraint forces using the Lagrange multipliers
     virtual void computeConstraintForces(uint64_t timestep);
+
+    //! Solve the constraint equation with Jacobi iterations on the GPU
+    virtual void solveConstraintsIterative(uint64_t timestep);
     };
 
 //! Exports the ForceDistanceConstraint to python
@@ -2,6 +2,7 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 // Maintainer: dnlebard
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -70,6 +71,9 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
 
     virtual void setParamsPython(std::string type, pybind11::dict params);
 
+    /// Set the parameters for many types from columns of parameter values
+    virtual void setParamsBulk(pybind11::list types, pybind11::dict columns);
+
     /// Get the parameters for a type
     pybind11::dict getParams(std::string type);
 
@@ -91,6 +95,7 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
     Scalar* m_t_0; //!< r_0 parameter for multiple angle types
 
     std::shared_ptr<AngleData> m_angle_data; //!< Angle data to use in computing angles
+    BondedForceChunks m_chunks;              //!< Per-thread force buffers
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -3,6 +3,7 @@
 
 // Maintainer: dnlebard
 
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -95,6 +96,7 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
     Scalar* m_phi_0; //!< phi_0 parameter for multiple dihedral types
 
     std::shared_ptr<DihedralData> m_dihedral_data; //!< Dihedral data to use in computing dihedrals
+    BondedForceChunks m_chunks;                    //!< Per-thread force buffers
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -31,14 +31,20 @@ HarmonicDihedralForceComputeGPU::HarmonicDihedralForceComputeGPU(
     GPUArray<Scalar4> params(m_dihedral_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
 
+    // search block sizes for the particle centric (0) and dihedral centric (1) kernels, encoded
+    // as block_size*10 + mode
+    // the dihedral centric kernel evaluates each dihedral once instead of once per member and adds
+    // the forces with atomics, which is faster when the atomics are cheaper than the 3 redundant
+    // evaluations
+    std::vector<unsigned int> valid_params;
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
-    m_tuner.reset(new Autotuner(warp_size,
-                                1024,
-                                warp_size,
-                                5,
-                                100000,
-                                "harmonic_dihedral",
-                                this->m_exec_conf));
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+        {
+        for (unsigned int mode = 0; mode < 2; mode++)
+            valid_params.push_back(block_size * 10 + mode);
+        }
+
+    m_tuner.reset(new Autotuner(valid_params, 5, 100000, "harmonic_dihedral", this->m_exec_conf));
     }
 
 HarmonicDihedralForceComputeGPU::~HarmonicDihedralForceComputeGPU() { }
@@ -79,16 +85,6 @@ void HarmonicDihedralForceComputeGPU::computeForces(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "Harmonic Dihedral");
 
-    ArrayHandle<DihedralData::members_t> d_gpu_dihedral_list(m_dihedral_data->getGPUTable(),
-                                                             access_location::device,
-                                                             access_mode::read);
-    ArrayHandle<unsigned int> d_n_dihedrals(m_dihedral_data->getNGroupsArray(),
-                                            access_location::device,
-                                            access_mode::read);
-    ArrayHandle<unsigned int> d_dihedrals_ABCD(m_dihedral_data->getGPUPosTable(),
-                                               access_location::device,
-                                               access_mode::read);
-
     // the dihedral table is up to date: we are good to go. Call the kernel
     ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
     BoxDim box = m_pdata->getGlobalBox();
@@ -97,22 +93,79 @@ void HarmonicDihedralForceComputeGPU::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
     ArrayHandle<Scalar4> d_params(m_params, access_location::device, access_mode::read);
 
+    // the particle table also validates that all members of the local dihedrals are present
+    const GlobalVector<DihedralData::members_t>& gpu_table = m_dihedral_data->getGPUTable();
+
     // run the kernel in parallel on all GPUs
     this->m_tuner->begin();
-    gpu_compute_harmonic_dihedral_forces(d_force.data,
-                                         d_virial.data,
-                                         m_virial.getPitch(),
-                                         m_pdata->getN(),
-                                         d_pos.data,
-                                         box,
-                                         d_gpu_dihedral_list.data,
-                                         d_dihedrals_ABCD.data,
-                                         m_dihedral_data->getGPUTableIndexer().getW(),
-                                         d_n_dihedrals.data,
-                                         d_params.data,
-                                         m_dihedral_data->getNTypes(),
-                                         this->m_tuner->getParam(),
-                                         this->m_exec_conf->dev_prop.warpSize);
+    unsigned int param = this->m_tuner->getParam();
+    unsigned int block_size = param / 10;
+    unsigned int mode = param % 10;
+
+    if (mode == 0)
+        {
+        ArrayHandle<DihedralData::members_t> d_gpu_dihedral_list(gpu_table,
+                                                                 access_location::device,
+                                                                 access_mode::read);
+        ArrayHandle<unsigned int> d_n_dihedrals(m_dihedral_data->getNGroupsArray(),
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> d_dihedrals_ABCD(m_dihedral_data->getGPUPosTable(),
+                                                   access_location::device,
+                                                   access_mode::read);
+
+        gpu_compute_harmonic_dihedral_forces(d_force.data,
+                                             d_virial.data,
+                                             m_virial.getPitch(),
+                                             m_pdata->getN(),
+                                             d_pos.data,
+                                             box,
+                                             d_gpu_dihedral_list.data,
+                                             d_dihedrals_ABCD.data,
+                                             m_dihedral_data->getGPUTableIndexer().getW(),
+                                             d_n_dihedrals.data,
+                                             d_params.data,
+                                             m_dihedral_data->getNTypes(),
+                                             block_size,
+                                             this->m_exec_conf->dev_prop.warpSize);
+        }
+    else
+        {
+        // 4 force and 6 virial accumulators per particle
+        if (m_accum.getNumElements() < 10 * m_pdata->getN())
+            {
+            GlobalArray<ForceReal> accum(10 * m_pdata->getMaxN(), m_exec_conf);
+            m_accum.swap(accum);
+            }
+
+        ArrayHandle<ForceReal> d_accum(m_accum, access_location::device, access_mode::overwrite);
+        ArrayHandle<DihedralData::members_t> d_members(m_dihedral_data->getMembersArray(),
+                                                       access_location::device,
+                                                       access_mode::read);
+        ArrayHandle<typeval_t> d_typeval(m_dihedral_data->getTypeValArray(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                         access_location::device,
+                                         access_mode::read);
+
+        gpu_compute_harmonic_dihedral_forces_scatter(d_force.data,
+                                                     d_virial.data,
+                                                     m_virial.getPitch(),
+                                                     d_accum.data,
+                                                     m_accum.getNumElements() / 10,
+                                                     m_pdata->getN(),
+                                                     m_pdata->getNGhosts(),
+                                                     d_pos.data,
+                                                     box,
+                                                     d_members.data,
+                                                     d_typeval.data,
+                                                     d_rtag.data,
+                                                     m_dihedral_data->getN(),
+                                                     d_params.data,
+                                                     block_size);
+        }
+
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     this->m_tuner->end();
@@ -52,8 +52,10 @@ class PYBIND11_EXPORT HarmonicDihedralForceComputeGPU : public HarmonicDihedralF
     setParams(unsigned int type, Scalar K, Scalar sign, int multiplicity, Scalar phi_0);
 
     protected:
-    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-    GPUArray<Scalar4> m_params;         //!< Parameters stored on the GPU (k,sign,m)
+    //! Autotuner for block size and particle or dihedral centric evaluation
+    std::unique_ptr<Autotuner> m_tuner;
+    GPUArray<Scalar4> m_params;     //!< Parameters stored on the GPU (k,sign,m)
+    GlobalArray<ForceReal> m_accum; //!< Force accumulators for dihedral centric evaluation
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -22,6 +22,173 @@
    HarmonicDihedralForceComputeGPU.
 */
 
+//! Evaluate the harmonic dihedral force on each member of one dihedral
+/*! \param pos_a Position of the a particle
+    \param pos_b Position of the b particle
+    \param pos_c Position of the c particle
+    \param pos_d Position of the d particle
+    \param params K, sign, multiplicity, and phi_0 of the dihedral type
+    \param box Box dimensions for periodic boundary condition handling
+    \param ff Output forces on a, b, c, and d
+    \param dihedral_eng Output energy of each member (1/4 of the dihedral energy)
+    \param dihedral_virial Output virial of each member (1/4 of the dihedral virial)
+*/
+__device__ inline void harmonic_dihedral_terms(const Scalar3& pos_a,
+                                               const Scalar3& pos_b,
+                                               const Scalar3& pos_c,
+                                               const Scalar3& pos_d,
+                                               const Scalar4& params,
+                                               const BoxDim& box,
+                                               Scalar3* ff,
+                                               Scalar& dihedral_eng,
+                                               Scalar* dihedral_virial)
+    {
+    // calculate dr for a-b,c-b,and a-c
+    Scalar3 dab = pos_a - pos_b;
+    Scalar3 dcb = pos_c - pos_b;
+    Scalar3 ddc = pos_d - pos_c;
+
+    dab = box.minImage(dab);
+    dcb = box.minImage(dcb);
+    ddc = box.minImage(ddc);
+
+    Scalar3 dcbm = -dcb;
+    dcbm = box.minImage(dcbm);
+
+    Scalar K = params.x;
+    Scalar sign = params.y;
+    Scalar multi = params.z;
+    Scalar phi_0 = params.w;
+
+    Scalar aax = dab.y * dcbm.z - dab.z * dcbm.y;
+    Scalar aay = dab.z * dcbm.x - dab.x * dcbm.z;
+    Scalar aaz = dab.x * dcbm.y - dab.y * dcbm.x;
+
+    Scalar bbx = ddc.y * dcbm.z - ddc.z * dcbm.y;
+    Scalar bby = ddc.z * dcbm.x - ddc.x * dcbm.z;
+    Scalar bbz = ddc.x * dcbm.y - ddc.y * dcbm.x;
+
+    Scalar raasq = aax * aax + aay * aay + aaz * aaz;
+    Scalar rbbsq = bbx * bbx + bby * bby + bbz * bbz;
+    Scalar rgsq = dcbm.x * dcbm.x + dcbm.y * dcbm.y + dcbm.z * dcbm.z;
+    Scalar rg = sqrtf(rgsq);
+
+    Scalar rginv, raa2inv, rbb2inv;
+    rginv = raa2inv = rbb2inv = Scalar(0.0);
+    if (rg > Scalar(0.0))
+        rginv = Scalar(1.0) / rg;
+    if (raasq > Scalar(0.0))
+        raa2inv = Scalar(1.0) / raasq;
+    if (rbbsq > Scalar(0.0))
+        rbb2inv = Scalar(1.0) / rbbsq;
+    Scalar rabinv = sqrtf(raa2inv * rbb2inv);
+
+    Scalar c_abcd = (aax * bbx + aay * bby + aaz * bbz) * rabinv;
+    Scalar s_abcd = rg * rabinv * (aax * ddc.x + aay * ddc.y + aaz * ddc.z);
+
+    if (c_abcd > Scalar(1.0))
+        c_abcd = Scalar(1.0);
+    if (c_abcd < -Scalar(1.0))
+        c_abcd = -Scalar(1.0);
+
+    Scalar p = Scalar(1.0);
+    Scalar ddfab;
+    Scalar dfab = Scalar(0.0);
+    int m = __scalar2int_rn(multi);
+
+    for (int jj = 0; jj < m; jj++)
+        {
+        ddfab = p * c_abcd - dfab * s_abcd;
+        dfab = p * s_abcd + dfab * c_abcd;
+        p = ddfab;
+        }
+
+    /////////////////////////
+    // FROM LAMMPS: sin_shift is always 0... so dropping all sin_shift terms!!!!
+    // Adding charmm dihedral functionality, sin_shift not always 0,
+    // cos_shift not always 1
+    /////////////////////////
+    Scalar sin_phi_0 = fast::sin(phi_0);
+    Scalar cos_phi_0 = fast::cos(phi_0);
+    p = p * cos_phi_0 + dfab * sin_phi_0;
+    p *= sign;
+    dfab = dfab * cos_phi_0 - ddfab * sin_phi_0;
+    dfab *= sign;
+    dfab *= -multi;
+    p += Scalar(1.0);
+
+    if (multi < Scalar(1.0))
+        {
+        p = Scalar(1.0) + sign;
+        dfab = Scalar(0.0);
+        }
+
+    Scalar fg = dab.x * dcbm.x + dab.y * dcbm.y + dab.z * dcbm.z;
+    Scalar hg = ddc.x * dcbm.x + ddc.y * dcbm.y + ddc.z * dcbm.z;
+
+    Scalar fga = fg * raa2inv * rginv;
+    Scalar hgb = hg * rbb2inv * rginv;
+    Scalar gaa = -raa2inv * rg;
+    Scalar gbb = rbb2inv * rg;
+
+    Scalar dtfx = gaa * aax;
+    Scalar dtfy = gaa * aay;
+    Scalar dtfz = gaa * aaz;
+    Scalar dtgx = fga * aax - hgb * bbx;
+    Scalar dtgy = fga * aay - hgb * bby;
+    Scalar dtgz = fga * aaz - hgb * bbz;
+    Scalar dthx = gbb * bbx;
+    Scalar dthy = gbb * bby;
+    Scalar dthz = gbb * bbz;
+
+    // Scalar df = -K * dfab;
+    Scalar df = -K * dfab * Scalar(0.500); // the 0.5 term is for 1/2K in the forces
+
+    Scalar sx2 = df * dtgx;
+    Scalar sy2 = df * dtgy;
+    Scalar sz2 = df * dtgz;
+
+    Scalar ffax = df * dtfx;
+    Scalar ffay = df * dtfy;
+    Scalar ffaz = df * dtfz;
+
+    Scalar ffbx = sx2 - ffax;
+    Scalar ffby = sy2 - ffay;
+    Scalar ffbz = sz2 - ffaz;
+
+    Scalar ffdx = df * dthx;
+    Scalar ffdy = df * dthy;
+    Scalar ffdz = df * dthz;
+
+    Scalar ffcx = -sx2 - ffdx;
+    Scalar ffcy = -sy2 - ffdy;
+    Scalar ffcz = -sz2 - ffdz;
+
+    // the force on each individual atom a,b,c,d
+    ff[0] = make_scalar3(ffax, ffay, ffaz);
+    ff[1] = make_scalar3(ffbx, ffby, ffbz);
+    ff[2] = make_scalar3(ffcx, ffcy, ffcz);
+    ff[3] = make_scalar3(ffdx, ffdy, ffdz);
+
+    // compute 1/4 of the energy, 1/4 for each atom in the dihedral
+    // Scalar dihedral_eng = p*K*Scalar(1.0/4.0);
+    dihedral_eng = p * K * Scalar(1.0 / 8.0); // the 1/8th term is (1/2)K * 1/4
+    // compute 1/4 of the virial, 1/4 for each atom in the dihedral
+    // upper triangular version of virial tensor
+    dihedral_virial[0]
+        = Scalar(1. / 4.) * (dab.x * ffax + dcb.x * ffcx + (ddc.x + dcb.x) * ffdx);
+    dihedral_virial[1]
+        = Scalar(1. / 4.) * (dab.y * ffax + dcb.y * ffcx + (ddc.y + dcb.y) * ffdx);
+    dihedral_virial[2]
+        = Scalar(1. / 4.) * (dab.z * ffax + dcb.z * ffcx + (ddc.z + dcb.z) * ffdx);
+    dihedral_virial[3]
+        = Scalar(1. / 4.) * (dab.y * ffay + dcb.y * ffcy + (ddc.y + dcb.y) * ffdy);
+    dihedral_virial[4]
+        = Scalar(1. / 4.) * (dab.z * ffay + dcb.z * ffcy + (ddc.z + dcb.z) * ffdy);
+    dihedral_virial[5]
+        = Scalar(1. / 4.) * (dab.z * ffaz + dcb.z * ffcz + (ddc.z + dcb.z) * ffdz);
+    }
+
 //! Kernel for calculating harmonic dihedral forces on the GPU
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
@@ -84,13 +251,13 @@ gpu_compute_harmonic_dihedral_forces_kernel(Scalar4* d_force,
         int cur_dihedral_abcd = cur_ABCD;
 
         // get the a-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 x_postype = d_pos[cur_dihedral_x_idx];
+        Scalar4 x_postype = __ldg(d_pos + cur_dihedral_x_idx);
         Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
         // get the c-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 y_postype = d_pos[cur_dihedral_y_idx];
+        Scalar4 y_postype = __ldg(d_pos + cur_dihedral_y_idx);
         Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
         // get the c-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 z_postype = d_pos[cur_dihedral_z_idx];
+        Scalar4 z_postype = __ldg(d_pos + cur_dihedral_z_idx);
         Scalar3 z_pos = make_scalar3(z_postype.x, z_postype.y, z_postype.z);
 
         if (cur_dihedral_abcd == 0)
@@ -122,175 +289,25 @@ gpu_compute_harmonic_dihedral_forces_kernel(Scalar4* d_force,
             pos_c = z_pos;
             }
 
-        // calculate dr for a-b,c-b,and a-c
-        Scalar3 dab = pos_a - pos_b;
-        Scalar3 dcb = pos_c - pos_b;
-        Scalar3 ddc = pos_d - pos_c;
-
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        ddc = box.minImage(ddc);
-
-        Scalar3 dcbm = -dcb;
-        dcbm = box.minImage(dcbm);
-
         // get the dihedral parameters (MEM TRANSFER: 12 bytes)
         Scalar4 params = __ldg(d_params + cur_dihedral_type);
-        Scalar K = params.x;
-        Scalar sign = params.y;
-        Scalar multi = params.z;
-        Scalar phi_0 = params.w;
-
-        Scalar aax = dab.y * dcbm.z - dab.z * dcbm.y;
-        Scalar aay = dab.z * dcbm.x - dab.x * dcbm.z;
-        Scalar aaz = dab.x * dcbm.y - dab.y * dcbm.x;
-
-        Scalar bbx = ddc.y * dcbm.z - ddc.z * dcbm.y;
-        Scalar bby = ddc.z * dcbm.x - ddc.x * dcbm.z;
-        Scalar bbz = ddc.x * dcbm.y - ddc.y * dcbm.x;
-
-        Scalar raasq = aax * aax + aay * aay + aaz * aaz;
-        Scalar rbbsq = bbx * bbx + bby * bby + bbz * bbz;
-        Scalar rgsq = dcbm.x * dcbm.x + dcbm.y * dcbm.y + dcbm.z * dcbm.z;
-        Scalar rg = sqrtf(rgsq);
-
-        Scalar rginv, raa2inv, rbb2inv;
-        rginv = raa2inv = rbb2inv = Scalar(0.0);
-        if (rg > Scalar(0.0))
-            rginv = Scalar(1.0) / rg;
-        if (raasq > Scalar(0.0))
-            raa2inv = Scalar(1.0) / raasq;
-        if (rbbsq > Scalar(0.0))
-            rbb2inv = Scalar(1.0) / rbbsq;
-        Scalar rabinv = sqrtf(raa2inv * rbb2inv);
-
-        Scalar c_abcd = (aax * bbx + aay * bby + aaz * bbz) * rabinv;
-        Scalar s_abcd = rg * rabinv * (aax * ddc.x + aay * ddc.y + aaz * ddc.z);
-
-        if (c_abcd > Scalar(1.0))
-            c_abcd = Scalar(1.0);
-        if (c_abcd < -Scalar(1.0))
-            c_abcd = -Scalar(1.0);
-
-        Scalar p = Scalar(1.0);
-        Scalar ddfab;
-        Scalar dfab = Scalar(0.0);
-        int m = __scalar2int_rn(multi);
-
-        for (int jj = 0; jj < m; jj++)
-            {
-            ddfab = p * c_abcd - dfab * s_abcd;
-            dfab = p * s_abcd + dfab * c_abcd;
-            p = ddfab;
-            }
-
-        /////////////////////////
-        // FROM LAMMPS: sin_shift is always 0... so dropping all sin_shift terms!!!!
-        // Adding charmm dihedral functionality, sin_shift not always 0,
-        // cos_shift not always 1
-        /////////////////////////
-        Scalar sin_phi_0 = fast::sin(phi_0);
-        Scalar cos_phi_0 = fast::cos(phi_0);
-        p = p * cos_phi_0 + dfab * sin_phi_0;
-        p *= sign;
-        dfab = dfab * cos_phi_0 - ddfab * sin_phi_0;
-        dfab *= sign;
-        dfab *= -multi;
-        p += Scalar(1.0);
-
-        if (multi < Scalar(1.0))
-            {
-            p = Scalar(1.0) + sign;
-            dfab = Scalar(0.0);
-            }
 
-        Scalar fg = dab.x * dcbm.x + dab.y * dcbm.y + dab.z * dcbm.z;
-        Scalar hg = ddc.x * dcbm.x + ddc.y * dcbm.y + ddc.z * dcbm.z;
-
-        Scalar fga = fg * raa2inv * rginv;
-        Scalar hgb = hg * rbb2inv * rginv;
-        Scalar gaa = -raa2inv * rg;
-        Scalar gbb = rbb2inv * rg;
-
-        Scalar dtfx = gaa * aax;
-        Scalar dtfy = gaa * aay;
-        Scalar dtfz = gaa * aaz;
-        Scalar dtgx = fga * aax - hgb * bbx;
-        Scalar dtgy = fga * aay - hgb * bby;
-        Scalar dtgz = fga * aaz - hgb * bbz;
-        Scalar dthx = gbb * bbx;
-        Scalar dthy = gbb * bby;
-        Scalar dthz = gbb * bbz;
-
-        // Scalar df = -K * dfab;
-        Scalar df = -K * dfab * Scalar(0.500); // the 0.5 term is for 1/2K in the forces
-
-        Scalar sx2 = df * dtgx;
-        Scalar sy2 = df * dtgy;
-        Scalar sz2 = df * dtgz;
-
-        Scalar ffax = df * dtfx;
-        Scalar ffay = df * dtfy;
-        Scalar ffaz = df * dtfz;
-
-        Scalar ffbx = sx2 - ffax;
-        Scalar ffby = sy2 - ffay;
-        Scalar ffbz = sz2 - ffaz;
-
-        Scalar ffdx = df * dthx;
-        Scalar ffdy = df * dthy;
-        Scalar ffdz = df * dthz;
-
-        Scalar ffcx = -sx2 - ffdx;
-        Scalar ffcy = -sy2 - ffdy;
-        Scalar ffcz = -sz2 - ffdz;
-
-        // Now, apply the force to each individual atom a,b,c,d
-        // and accumulate the energy/virial
-        // compute 1/4 of the energy, 1/4 for each atom in the dihedral
-        // Scalar dihedral_eng = p*K*Scalar(1.0/4.0);
-        Scalar dihedral_eng = p * K * Scalar(1.0 / 8.0); // the 1/8th term is (1/2)K * 1/4
-        // compute 1/4 of the virial, 1/4 for each atom in the dihedral
-        // upper triangular version of virial tensor
+        Scalar3 ff[4];
+        Scalar dihedral_eng;
         Scalar dihedral_virial[6];
-        dihedral_virial[0]
-            = Scalar(1. / 4.) * (dab.x * ffax + dcb.x * ffcx + (ddc.x + dcb.x) * ffdx);
-        dihedral_virial[1]
-            = Scalar(1. / 4.) * (dab.y * ffax + dcb.y * ffcx + (ddc.y + dcb.y) * ffdx);
-        dihedral_virial[2]
-            = Scalar(1. / 4.) * (dab.z * ffax + dcb.z * ffcx + (ddc.z + dcb.z) * ffdx);
-        dihedral_virial[3]
-            = Scalar(1. / 4.) * (dab.y * ffay + dcb.y * ffcy + (ddc.y + dcb.y) * ffdy);
-        dihedral_virial[4]
-            = Scalar(1. / 4.) * (dab.z * ffay + dcb.z * ffcy + (ddc.z + dcb.z) * ffdy);
-        dihedral_virial[5]
-            = Scalar(1. / 4.) * (dab.z * ffaz + dcb.z * ffcz + (ddc.z + dcb.z) * ffdz);
-
-        if (cur_dihedral_abcd == 0)
-            {
-            force_idx.x += ffax;
-            force_idx.y += ffay;
-            force_idx.z += ffaz;
-            }
-        if (cur_dihedral_abcd == 1)
-            {
-            force_idx.x += ffbx;
-            force_idx.y += ffby;
-            force_idx.z += ffbz;
-            }
-        if (cur_dihedral_abcd == 2)
-            {
-            force_idx.x += ffcx;
-            force_idx.y += ffcy;
-            force_idx.z += ffcz;
-            }
-        if (cur_dihedral_abcd == 3)
-            {
-            force_idx.x += ffdx;
-            force_idx.y += ffdy;
-            force_idx.z += ffdz;
-            }
-
+        harmonic_dihedral_terms(pos_a,
+                                pos_b,
+                                pos_c,
+                                pos_d,
+                                params,
+                                box,
+                                ff,
+                                dihedral_eng,
+                                dihedral_virial);
+
+        force_idx.x += ff[cur_dihedral_abcd].x;
+        force_idx.y += ff[cur_dihedral_abcd].y;
+        force_idx.z += ff[cur_dihedral_abcd].z;
         force_idx.w += dihedral_eng;
         for (int k = 0; k < 6; k++)
             virial_idx[k] += dihedral_virial[k];
@@ -302,6 +319,118 @@ gpu_compute_harmonic_dihedral_forces_kernel(Scalar4* d_force,
         d_virial[k * virial_pitch + idx] = virial_idx[k];
     }
 
+//! Kernel for calculating harmonic dihedral forces on the GPU, one thread per dihedral
+/*! \param d_accum Accumulators for the force, energy, and virial of each particle
+    \param accum_pitch Pitch of the 2D accumulator array
+    \param N number of particles
+    \param n_max Number of local and ghost particles
+    \param d_pos particle positions on the device
+    \param d_params Parameters for the dihedral force
+    \param box Box dimensions for periodic boundary condition handling
+    \param d_members Tags of the members of each dihedral
+    \param d_typeval Type of each dihedral
+    \param d_rtag Particle index of each tag
+    \param n_groups Number of dihedrals
+
+    Each dihedral is evaluated once and its forces are added to the local members with atomics.
+    Row k < 4 of \a d_accum holds the force component k (w is the energy), rows 4 to 9 hold the
+    virial.
+*/
+__global__ void
+gpu_compute_harmonic_dihedral_forces_scatter_kernel(ForceReal* d_accum,
+                                                    const size_t accum_pitch,
+                                                    const unsigned int N,
+                                                    const unsigned int n_max,
+                                                    const Scalar4* d_pos,
+                                                    const Scalar4* d_params,
+                                                    BoxDim box,
+                                                    const group_storage<4>* d_members,
+                                                    const typeval_union* d_typeval,
+                                                    const unsigned int* d_rtag,
+                                                    const unsigned int n_groups)
+    {
+    // identify the dihedral this thread handles
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx >= n_groups)
+        return;
+
+    group_storage<4> members = d_members[group_idx];
+    unsigned int type = d_typeval[group_idx].type;
+
+    unsigned int idx[4];
+    Scalar3 pos[4];
+    for (unsigned int i = 0; i < 4; i++)
+        {
+        idx[i] = __ldg(d_rtag + members.tag[i]);
+
+        // the particle table check reports incomplete dihedrals
+        if (idx[i] >= n_max)
+            return;
+
+        Scalar4 postype = __ldg(d_pos + idx[i]);
+        pos[i] = make_scalar3(postype.x, postype.y, postype.z);
+        }
+
+    // get the dihedral parameters (MEM TRANSFER: 12 bytes)
+    Scalar4 params = __ldg(d_params + type);
+
+    Scalar3 ff[4];
+    Scalar dihedral_eng;
+    Scalar dihedral_virial[6];
+    harmonic_dihedral_terms(pos[0],
+                            pos[1],
+                            pos[2],
+                            pos[3],
+                            params,
+                            box,
+                            ff,
+                            dihedral_eng,
+                            dihedral_virial);
+
+    // add the terms to the members owned by this rank
+    for (unsigned int i = 0; i < 4; i++)
+        {
+        if (idx[i] >= N)
+            continue;
+
+        atomicAddForceReal(d_accum + idx[i], ff[i].x);
+        atomicAddForceReal(d_accum + accum_pitch + idx[i], ff[i].y);
+        atomicAddForceReal(d_accum + 2 * accum_pitch + idx[i], ff[i].z);
+        atomicAddForceReal(d_accum + 3 * accum_pitch + idx[i], dihedral_eng);
+        for (unsigned int k = 0; k < 6; k++)
+            atomicAddForceReal(d_accum + (4 + k) * accum_pitch + idx[i], dihedral_virial[k]);
+        }
+    }
+
+//! Kernel to write out the accumulated dihedral forces
+/*! \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param d_accum Accumulated force, energy, and virial of each particle
+    \param accum_pitch Pitch of the 2D accumulator array
+    \param N number of particles
+*/
+__global__ void gpu_harmonic_dihedral_write_accum_kernel(Scalar4* d_force,
+                                                         Scalar* d_virial,
+                                                         const size_t virial_pitch,
+                                                         const ForceReal* d_accum,
+                                                         const size_t accum_pitch,
+                                                         const unsigned int N)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_force[idx] = make_scalar4(Scalar(d_accum[idx]),
+                                Scalar(d_accum[accum_pitch + idx]),
+                                Scalar(d_accum[2 * accum_pitch + idx]),
+                                Scalar(d_accum[3 * accum_pitch + idx]));
+    for (unsigned int k = 0; k < 6; k++)
+        d_virial[k * virial_pitch + idx] = Scalar(d_accum[(4 + k) * accum_pitch + idx]);
+    }
+
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
@@ -374,3 +503,87 @@ hipError_t gpu_compute_harmonic_dihedral_forces(Scalar4* d_force,
 
     return hipSuccess;
     }
+
+/*! \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param d_accum Scratch memory with 10 rows of \a accum_pitch accumulators
+    \param accum_pitch Pitch of the 2D accumulator array, at least N
+    \param N number of particles
+    \param n_ghost number of ghost particles
+    \param d_pos particle positions on the GPU
+    \param box Box dimensions (in GPU format) to use for periodic boundary conditions
+    \param d_members Tags of the members of each dihedral
+    \param d_typeval Type of each dihedral
+    \param d_rtag Particle index of each tag
+    \param n_groups Number of dihedrals
+    \param d_params K, sign,multiplicity params packed as padded Scalar4 variables
+    \param block_size Block size to use when performing calculations
+
+    \returns Any error code resulting from the kernel launch
+    \note Always returns hipSuccess in release builds to avoid the hipDeviceSynchronize()
+
+    Evaluates each dihedral once instead of once per member. In fixed point mode the result is
+    reproducible, otherwise it depends on the order of the atomic additions.
+*/
+hipError_t gpu_compute_harmonic_dihedral_forces_scatter(Scalar4* d_force,
+                                                        Scalar* d_virial,
+                                                        const size_t virial_pitch,
+                                                        ForceReal* d_accum,
+                                                        const size_t accum_pitch,
+                                                        const unsigned int N,
+                                                        const unsigned int n_ghost,
+                                                        const Scalar4* d_pos,
+                                                        const BoxDim& box,
+                                                        const group_storage<4>* d_members,
+                                                        const typeval_union* d_typeval,
+                                                        const unsigned int* d_rtag,
+                                                        const unsigned int n_groups,
+                                                        Scalar4* d_params,
+                                                        int block_size)
+    {
+    assert(d_params);
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_compute_harmonic_dihedral_forces_scatter_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipMemsetAsync(d_accum, 0, sizeof(ForceReal) * 10 * accum_pitch);
+
+    if (n_groups > 0)
+        {
+        hipLaunchKernelGGL((gpu_compute_harmonic_dihedral_forces_scatter_kernel),
+                           dim3(n_groups / run_block_size + 1),
+                           dim3(run_block_size),
+                           0,
+                           0,
+                           d_accum,
+                           accum_pitch,
+                           N,
+                           N + n_ghost,
+                           d_pos,
+                           d_params,
+                           box,
+                           d_members,
+                           d_typeval,
+                           d_rtag,
+                           n_groups);
+        }
+
+    hipLaunchKernelGGL((gpu_harmonic_dihedral_write_accum_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_force,
+                       d_virial,
+                       virial_pitch,
+                       d_accum,
+                       accum_pitch,
+                       N);
+
+    return hipSuccess;
+    }
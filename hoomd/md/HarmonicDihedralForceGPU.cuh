@@ -8,6 +8,8 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
 
+#include "MDPrecisionSetup.h"
+
 /*! \file HarmonicDihedralForceGPU.cuh
     \brief Declares GPU kernel code for calculating the harmonic dihedral forces. Used by
    HarmonicDihedralForceComputeGPU.
@@ -32,4 +34,21 @@ hipError_t gpu_compute_harmonic_dihedral_forces(Scalar4* d_force,
                                                 int block_size,
                                                 int warp_size);
 
+//! Kernel driver that evaluates each harmonic dihedral once and scatters the forces
+hipError_t gpu_compute_harmonic_dihedral_forces_scatter(Scalar4* d_force,
+                                                        Scalar* d_virial,
+                                                        const size_t virial_pitch,
+                                                        ForceReal* d_accum,
+                                                        const size_t accum_pitch,
+                                                        const unsigned int N,
+                                                        const unsigned int n_ghost,
+                                                        const Scalar4* d_pos,
+                                                        const BoxDim& box,
+                                                        const group_storage<4>* d_members,
+                                                        const typeval_union* d_typeval,
+                                                        const unsigned int* d_rtag,
+                                                        const unsigned int n_groups,
+                                                        Scalar4* d_params,
+                                                        int block_size);
+
 #endif
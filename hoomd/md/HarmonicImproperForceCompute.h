@@ -3,6 +3,7 @@
 
 // Maintainer: dnlebard
 
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -59,6 +60,7 @@ class PYBIND11_EXPORT HarmonicImproperForceCompute : public ForceCompute
     Scalar* m_chi; //!< Chi parameter for multiple impropers
 
     std::shared_ptr<ImproperData> m_improper_data; //!< Improper data to use in computing impropers
+    BondedForceChunks m_chunks;                    //!< Per-thread force buffers
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
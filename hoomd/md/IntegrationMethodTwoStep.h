@@ -9,6 +9,11 @@
 
 #include <memory>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #ifndef __INTEGRATION_METHOD_TWO_STEP_H__
 #define __INTEGRATION_METHOD_TWO_STEP_H__
 
@@ -153,8 +158,10 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
     //! Get needed pdata flags
     /*! Not all fields in ParticleData are computed by default. When derived classes need one of
        these optional fields, they must return the requested fields in getRequestedPDataFlags().
+
+       \param timestep Time step the flags are needed on
     */
-    virtual PDataFlags getRequestedPDataFlags()
+    virtual PDataFlags getRequestedPDataFlags(uint64_t timestep)
         {
         return PDataFlags(0);
         }
@@ -226,6 +233,40 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
         m_valid_restart = b;
         }
 
+    //! Apply a per-particle update to every member of the group
+    /*! \param f Callable invoked as f(j) with the particle index j of each group member
+
+        With TBB and more than one CPU thread, the members are split between the threads of the
+        ExecutionConfiguration task arena. \a f must only write to the data of particle j.
+    */
+    template<class F> void forEachMember(const F& f)
+        {
+        const unsigned int group_size = m_group->getNumMembers();
+        ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                          access_location::host,
+                                          access_mode::read);
+#ifdef ENABLE_TBB
+        if (m_exec_conf->getNumThreads() > 1)
+            {
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      {
+                                          for (unsigned int group_idx = r.begin();
+                                               group_idx != r.end();
+                                               ++group_idx)
+                                              f(h_index.data[group_idx]);
+                                      });
+                });
+            return;
+            }
+#endif
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            f(h_index.data[group_idx]);
+        }
+
     private:
     unsigned int m_integrator_id; //!< Registered integrator id to access the state variables
     bool m_valid_restart;         //!< True if the restart info was valid when loading
@@ -9,6 +9,12 @@ namespace py = pybind11;
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_HIP
+#include "IntegratorTwoStep.cuh"
+#endif
+
+#include <cmath>
+
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<IntegrationMethodTwoStep>>);
 
@@ -74,6 +80,11 @@ void IntegratorTwoStep::update(uint64_t timestep)
     if (m_prof)
         m_prof->push("Integrate");
 
+    // apply the first half of the SLLOD velocity term
+    const bool deforming = isDeforming();
+    if (deforming)
+        deformVelocities(m_deltaT / Scalar(2.0));
+
     // perform the first step of the integration on all groups
     for (auto& method : m_methods)
         {
@@ -84,6 +95,10 @@ void IntegratorTwoStep::update(uint64_t timestep)
         method->integrateStepOne(timestep);
         }
 
+    // stream the particles with the deforming box before they are communicated
+    if (deforming)
+        deformBox();
+
     if (m_prof)
         m_prof->pop();
 
@@ -95,8 +110,10 @@ void IntegratorTwoStep::update(uint64_t timestep)
         // b) that forces are calculated correctly, if ghost atom positions are updated every time
         // step
 
-        // also updates rigid bodies after ghost updating
-        m_comm->communicate(timestep + 1);
+        // also updates rigid bodies after ghost updating, which needs the complete ghost update
+        // up front. Otherwise, forces may overlap their computation with the ghost update (see
+        // ForceCompute::overlapsGhostUpdate()) and computeNetForce() completes it.
+        m_comm->communicate(timestep + 1, m_overlap_ghost_update && !m_rigid_bodies);
         }
     else
 #endif
@@ -128,6 +145,10 @@ void IntegratorTwoStep::update(uint64_t timestep)
         method->includeRATTLEForce(timestep + 1);
         }
 
+    // apply the second half of the SLLOD velocity term
+    if (deforming)
+        deformVelocities(m_deltaT / Scalar(2.0));
+
     /* NOTE: For composite particles, it is assumed that positions and orientations are not updated
        in the second step.
 
@@ -311,9 +332,11 @@ void IntegratorTwoStep::prepRun(uint64_t timestep)
     m_prepared = true;
     }
 
-/*! Return the combined flags of all integration methods.
- */
-PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
+/*! \param timestep Time step the flags are needed on
+
+    Return the combined flags of all integration methods.
+*/
+PDataFlags IntegratorTwoStep::getRequestedPDataFlags(uint64_t timestep)
     {
     PDataFlags flags;
 
@@ -321,7 +344,7 @@ PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
     for (auto& method : m_methods)
         {
         // or them all together
-        flags |= method->getRequestedPDataFlags();
+        flags |= method->getRequestedPDataFlags(timestep);
         }
 
     return flags;
@@ -393,6 +416,220 @@ CommFlags IntegratorTwoStep::determineFlags(uint64_t timestep)
     }
 #endif
 
+/*! \param rate Velocity gradient components (xx, yy, zz, xy, xz, yz)
+
+    The components define the streaming velocity u(r) = (grad u) . r with
+    u_x = xx r_x + xy r_y + xz r_z, u_y = yy r_y + yz r_z, and u_z = zz r_z.
+*/
+void IntegratorTwoStep::setDeformationRate(pybind11::tuple rate)
+    {
+    if (pybind11::len(rate) != 6)
+        {
+        throw std::length_error("deformation_rate must have length 6");
+        }
+
+    Scalar3 strain_rate = make_scalar3(pybind11::cast<Scalar>(rate[0]),
+                                       pybind11::cast<Scalar>(rate[1]),
+                                       pybind11::cast<Scalar>(rate[2]));
+    Scalar3 shear_rate = make_scalar3(pybind11::cast<Scalar>(rate[3]),
+                                      pybind11::cast<Scalar>(rate[4]),
+                                      pybind11::cast<Scalar>(rate[5]));
+
+    if (m_sysdef->getNDimensions() == 2
+        && (strain_rate.z != 0 || shear_rate.y != 0 || shear_rate.z != 0))
+        {
+        throw std::invalid_argument("deformation_rate must not deform z in 2D simulations");
+        }
+
+    m_strain_rate = strain_rate;
+    m_shear_rate = shear_rate;
+    }
+
+/*! \param lees_edwards True to apply the xy shear with Lees-Edwards boundary conditions
+
+    The periodic images along y are exchanged between ranks together with their x coordinates, so
+    Lees-Edwards boundary conditions require that the box is not decomposed along x.
+*/
+void IntegratorTwoStep::setLeesEdwards(bool lees_edwards)
+    {
+#ifdef ENABLE_MPI
+    if (lees_edwards && m_sysdef->isDomainDecomposed()
+        && m_pdata->getDomainDecomposition()->getDomainIndexer().getW() > 1)
+        {
+        throw std::runtime_error(
+            "Lees-Edwards boundary conditions require that the box is not decomposed along x");
+        }
+#endif
+
+    m_lees_edwards = lees_edwards;
+    }
+
+pybind11::tuple IntegratorTwoStep::getDeformationRate()
+    {
+    return pybind11::make_tuple(m_strain_rate.x,
+                                m_strain_rate.y,
+                                m_strain_rate.z,
+                                m_shear_rate.x,
+                                m_shear_rate.y,
+                                m_shear_rate.z);
+    }
+
+/*! \param dt Time interval to apply the velocity term over
+
+    Applies v -= dt (grad u) . v to the peculiar velocities of all local particles.
+*/
+void IntegratorTwoStep::deformVelocities(Scalar dt)
+    {
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        gpu_integrator_deform_velocities(m_pdata->getN(),
+                                         d_vel.data,
+                                         m_strain_rate,
+                                         m_shear_rate,
+                                         dt,
+                                         256);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        Scalar4 vel = h_vel.data[i];
+        vel.x -= dt * (m_strain_rate.x * vel.x + m_shear_rate.x * vel.y + m_shear_rate.y * vel.z);
+        vel.y -= dt * (m_strain_rate.y * vel.y + m_shear_rate.z * vel.z);
+        vel.z -= dt * m_strain_rate.z * vel.z;
+        h_vel.data[i] = vel;
+        }
+    }
+
+/*! The box matrix h advances by dt (grad u) . h and the particles keep their fractional
+    coordinates. When a tilt exceeds half of the box, the box is remapped to the equivalent lattice
+    with the smallest tilt and the particle images are expressed in the remapped lattice vectors.
+*/
+void IntegratorTwoStep::deformBox()
+    {
+    const BoxDim global_box = m_pdata->getGlobalBox();
+    const Scalar3 L = global_box.getL();
+    const Scalar dt = m_deltaT;
+
+    // off diagonal elements of the box matrix, the Lees-Edwards offset displaces the lattice
+    // vector a2 like the xy tilt
+    const Scalar h_xy = global_box.getTiltFactorXY() * L.y + global_box.getLeesEdwardsOffset();
+    const Scalar h_xz = global_box.getTiltFactorXZ() * L.z;
+    const Scalar h_yz = global_box.getTiltFactorYZ() * L.z;
+
+    BoxDim old_box(L);
+    old_box.setTiltFactors(h_xy / L.y, h_xz / L.z, h_yz / L.z);
+    old_box.setPeriodic(global_box.getPeriodic());
+
+    Scalar3 new_L = make_scalar3(L.x * (Scalar(1.0) + dt * m_strain_rate.x),
+                                 L.y * (Scalar(1.0) + dt * m_strain_rate.y),
+                                 L.z * (Scalar(1.0) + dt * m_strain_rate.z));
+    Scalar new_h_xy = h_xy + dt * (m_strain_rate.x * h_xy + m_shear_rate.x * L.y);
+    Scalar new_h_xz
+        = h_xz + dt * (m_strain_rate.x * h_xz + m_shear_rate.x * h_yz + m_shear_rate.y * L.z);
+    Scalar new_h_yz = h_yz + dt * (m_strain_rate.y * h_yz + m_shear_rate.z * L.z);
+
+    BoxDim new_box(new_L);
+    new_box.setTiltFactors(new_h_xy / new_L.y, new_h_xz / new_L.z, new_h_yz / new_L.z);
+    new_box.setPeriodic(old_box.getPeriodic());
+
+    // with Lees-Edwards boundary conditions, the xy tilt factor is fixed and the rest of the xy
+    // element is the offset
+    const Scalar xy = m_lees_edwards ? global_box.getTiltFactorXY() : Scalar(0.0);
+
+    // subtract lattice vectors from the tilted ones: a3 -= n_yz a2, a3 -= n_xz a1, a2 -= n_xy a1
+    int3 flip = make_int3(0, 0, 0);
+    flip.z = int(std::round(new_h_yz / new_L.y));
+    new_h_yz -= Scalar(flip.z) * new_L.y;
+    new_h_xz -= Scalar(flip.z) * new_h_xy;
+    flip.y = int(std::round(new_h_xz / new_L.x));
+    new_h_xz -= Scalar(flip.y) * new_L.x;
+    flip.x = int(std::round((new_h_xy - xy * new_L.y) / new_L.x));
+    new_h_xy -= Scalar(flip.x) * new_L.x;
+
+    BoxDim remapped_box(new_L);
+    if (m_lees_edwards)
+        {
+        remapped_box.setTiltFactors(xy, new_h_xz / new_L.z, new_h_yz / new_L.z);
+        remapped_box.setLeesEdwardsOffset(new_h_xy - xy * new_L.y);
+        }
+    else
+        {
+        remapped_box.setTiltFactors(new_h_xy / new_L.y, new_h_xz / new_L.z, new_h_yz / new_L.z);
+        }
+    remapped_box.setPeriodic(old_box.getPeriodic());
+
+    m_pdata->setGlobalBox(remapped_box);
+
+#ifdef ENABLE_MPI
+    // remapping the tilt changes the fractional coordinates, particles may leave their domains
+    // (wrapping the Lees-Edwards offset does not change the shape of the box)
+    if (m_sysdef->isDomainDecomposed()
+        && ((flip.x != 0 && !m_lees_edwards) || flip.y != 0 || flip.z != 0))
+        {
+        m_comm->forceMigrate();
+        }
+#endif
+
+    const BoxDim& local_box = m_pdata->getBox();
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<int3> d_image(m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+        gpu_integrator_deform_positions(m_pdata->getN(),
+                                        d_pos.data,
+                                        d_image.data,
+                                        old_box,
+                                        new_box,
+                                        local_box,
+                                        flip,
+                                        256);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        Scalar3 pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        pos = new_box.makeCoordinates(old_box.makeFraction(pos));
+        h_pos.data[i].x = pos.x;
+        h_pos.data[i].y = pos.y;
+        h_pos.data[i].z = pos.z;
+
+        // express the image in the remapped lattice vectors
+        int3& image = h_image.data[i];
+        image.y += flip.z * image.z;
+        image.x += flip.y * image.z;
+        image.x += flip.x * image.y;
+
+        local_box.wrap(h_pos.data[i], image);
+        }
+    }
+
 /// Check if any forces introduce anisotropic degrees of freedom
 bool IntegratorTwoStep::areForcesAnisotropic()
     {
@@ -418,5 +655,14 @@ void export_IntegratorTwoStep(py::module& m)
         .def_property("rigid", &IntegratorTwoStep::getRigid, &IntegratorTwoStep::setRigid)
         .def_property("integrate_rotational_dof",
                       &IntegratorTwoStep::getIntegrateRotationalDOF,
-                      &IntegratorTwoStep::setIntegrateRotationalDOF);
+                      &IntegratorTwoStep::setIntegrateRotationalDOF)
+        .def_property("overlap_ghost_update",
+                      &IntegratorTwoStep::getOverlapGhostUpdate,
+                      &IntegratorTwoStep::setOverlapGhostUpdate)
+        .def_property("deformation_rate",
+                      &IntegratorTwoStep::getDeformationRate,
+                      &IntegratorTwoStep::setDeformationRate)
+        .def_property("lees_edwards",
+                      &IntegratorTwoStep::getLeesEdwards,
+                      &IntegratorTwoStep::setLeesEdwards);
     }
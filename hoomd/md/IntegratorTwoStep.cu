@@ -0,0 +1,158 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "IntegratorTwoStep.cuh"
+
+/*! \file IntegratorTwoStep.cu
+    \brief Defines the GPU kernels used by IntegratorTwoStep to apply affine deformations
+*/
+
+namespace kernel
+    {
+//! Kernel to apply the SLLOD velocity term
+/*! \param N Number of local particles
+    \param d_vel Particle velocities and masses
+    \param strain_rate Diagonal components of the velocity gradient (xx, yy, zz)
+    \param shear_rate Off diagonal components of the velocity gradient (xy, xz, yz)
+    \param scale Time interval to apply the term over
+*/
+__global__ void gpu_integrator_deform_velocities_kernel(const unsigned int N,
+                                                        Scalar4* d_vel,
+                                                        const Scalar3 strain_rate,
+                                                        const Scalar3 shear_rate,
+                                                        const Scalar scale)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 vel = d_vel[idx];
+    vel.x -= scale * (strain_rate.x * vel.x + shear_rate.x * vel.y + shear_rate.y * vel.z);
+    vel.y -= scale * (strain_rate.y * vel.y + shear_rate.z * vel.z);
+    vel.z -= scale * strain_rate.z * vel.z;
+    d_vel[idx] = vel;
+    }
+
+//! Kernel to stream the particles with the box
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param old_box Global box before the deformation
+    \param new_box Global box after the deformation, before the lattice is remapped
+    \param local_box Local box after the deformation and remapping
+    \param flip Number of lattice vectors subtracted from the tilt (xy, xz, yz)
+*/
+__global__ void gpu_integrator_deform_positions_kernel(const unsigned int N,
+                                                       Scalar4* d_pos,
+                                                       int3* d_image,
+                                                       const BoxDim old_box,
+                                                       const BoxDim new_box,
+                                                       const BoxDim local_box,
+                                                       const int3 flip)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    pos = new_box.makeCoordinates(old_box.makeFraction(pos));
+    postype.x = pos.x;
+    postype.y = pos.y;
+    postype.z = pos.z;
+
+    // express the image in the remapped lattice vectors
+    int3 image = d_image[idx];
+    image.y += flip.z * image.z;
+    image.x += flip.y * image.z;
+    image.x += flip.x * image.y;
+
+    local_box.wrap(postype, image);
+    d_pos[idx] = postype;
+    d_image[idx] = image;
+    }
+    } // end namespace kernel
+
+/*! \param N Number of local particles
+    \param d_vel Particle velocities and masses
+    \param strain_rate Diagonal components of the velocity gradient (xx, yy, zz)
+    \param shear_rate Off diagonal components of the velocity gradient (xy, xz, yz)
+    \param scale Time interval to apply the term over
+    \param block_size Block size to execute
+*/
+hipError_t gpu_integrator_deform_velocities(const unsigned int N,
+                                            Scalar4* d_vel,
+                                            const Scalar3 strain_rate,
+                                            const Scalar3 shear_rate,
+                                            const Scalar scale,
+                                            const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)kernel::gpu_integrator_deform_velocities_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1);
+
+    hipLaunchKernelGGL((kernel::gpu_integrator_deform_velocities_kernel),
+                       dim3(grid),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_vel,
+                       strain_rate,
+                       shear_rate,
+                       scale);
+
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param old_box Global box before the deformation
+    \param new_box Global box after the deformation, before the lattice is remapped
+    \param local_box Local box after the deformation and remapping
+    \param flip Number of lattice vectors subtracted from the tilt (xy, xz, yz)
+    \param block_size Block size to execute
+*/
+hipError_t gpu_integrator_deform_positions(const unsigned int N,
+                                           Scalar4* d_pos,
+                                           int3* d_image,
+                                           const BoxDim& old_box,
+                                           const BoxDim& new_box,
+                                           const BoxDim& local_box,
+                                           const int3 flip,
+                                           const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)kernel::gpu_integrator_deform_positions_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1);
+
+    hipLaunchKernelGGL((kernel::gpu_integrator_deform_positions_kernel),
+                       dim3(grid),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_pos,
+                       d_image,
+                       old_box,
+                       new_box,
+                       local_box,
+                       flip);
+
+    return hipSuccess;
+    }
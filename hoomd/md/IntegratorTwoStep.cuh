@@ -0,0 +1,31 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file IntegratorTwoStep.cuh
+    \brief Declares the GPU kernel drivers used by IntegratorTwoStep to apply affine deformations
+*/
+
+#pragma once
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+//! Apply the SLLOD velocity term v -= scale * (grad u) . v to the local particles
+hipError_t gpu_integrator_deform_velocities(const unsigned int N,
+                                            Scalar4* d_vel,
+                                            const Scalar3 strain_rate,
+                                            const Scalar3 shear_rate,
+                                            const Scalar scale,
+                                            const unsigned int block_size);
+
+//! Stream the local particles with the affine deformation of the box and remap their images
+hipError_t gpu_integrator_deform_positions(const unsigned int N,
+                                           Scalar4* d_pos,
+                                           int3* d_image,
+                                           const BoxDim& old_box,
+                                           const BoxDim& new_box,
+                                           const BoxDim& local_box,
+                                           const int3 flip,
+                                           const unsigned int block_size);
@@ -29,6 +29,14 @@
    steps one and two, and which can use the updated particle positions and velocities to update any
    slaved degrees of freedom (rigid bodies).
 
+    IntegratorTwoStep optionally deforms the box continuously with a constant upper triangular
+    velocity gradient (grad u) and integrates the SLLOD equations of motion. The particle velocities
+    are peculiar velocities: the term -(grad u) . v is applied for half a step before and after the
+    methods, and the particles stream with the box after step one. When a tilt exceeds half of the
+    box, the box is remapped to the equivalent lattice with the smallest tilt. With Lees-Edwards
+    boundary conditions enabled, the xy shear advances the Lees-Edwards offset of the box instead
+    of the xy tilt factor, so the shape of the box and the cell lists do not change.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
@@ -70,8 +78,8 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
     /// Prepare for the run
     virtual void prepRun(uint64_t timestep);
 
-    /// Get needed pdata flags
-    virtual PDataFlags getRequestedPDataFlags();
+    /// Get needed pdata flags on a given time step
+    virtual PDataFlags getRequestedPDataFlags(uint64_t timestep);
 
     /// helper function to compute net force/virial
     virtual void computeNetForce(uint64_t timestep);
@@ -109,10 +117,50 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         m_rigid_bodies = new_rigid;
         }
 
+    /// Set whether forces may overlap their computation with the ghost update
+    void setOverlapGhostUpdate(bool overlap_ghost_update)
+        {
+        m_overlap_ghost_update = overlap_ghost_update;
+        }
+
+    /// Get whether forces may overlap their computation with the ghost update
+    bool getOverlapGhostUpdate()
+        {
+        return m_overlap_ghost_update;
+        }
+
+    /// Set the velocity gradient of the box deformation (xx, yy, zz, xy, xz, yz)
+    void setDeformationRate(pybind11::tuple rate);
+
+    /// Get the velocity gradient of the box deformation (xx, yy, zz, xy, xz, yz)
+    pybind11::tuple getDeformationRate();
+
+    /// Set whether the xy shear uses Lees-Edwards boundary conditions
+    void setLeesEdwards(bool lees_edwards);
+
+    /// Get whether the xy shear uses Lees-Edwards boundary conditions
+    bool getLeesEdwards()
+        {
+        return m_lees_edwards;
+        }
+
     protected:
     /// Helper method to test if all added methods have valid restart information
     bool isValidRestart();
 
+    /// Test if the box deforms
+    bool isDeforming()
+        {
+        return m_strain_rate.x != 0 || m_strain_rate.y != 0 || m_strain_rate.z != 0
+               || m_shear_rate.x != 0 || m_shear_rate.y != 0 || m_shear_rate.z != 0;
+        }
+
+    /// Apply the SLLOD velocity term over the time interval dt
+    void deformVelocities(Scalar dt);
+
+    /// Deform the box by one time step and stream the particles with it
+    void deformBox();
+
     std::vector<std::shared_ptr<IntegrationMethodTwoStep>>
         m_methods; //!< List of all the integration methods
 
@@ -123,6 +171,18 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
 
     /// True when orientation degrees of freedom should be integrated
     bool m_integrate_rotational_dof = false;
+
+    /// True when forces may compute while the ghost positions are in flight
+    bool m_overlap_ghost_update = false;
+
+    /// Diagonal components of the deformation velocity gradient (xx, yy, zz)
+    Scalar3 m_strain_rate = make_scalar3(0, 0, 0);
+
+    /// Off diagonal components of the deformation velocity gradient (xy, xz, yz)
+    Scalar3 m_shear_rate = make_scalar3(0, 0, 0);
+
+    /// True when the xy shear shifts the periodic images instead of tilting the box
+    bool m_lees_edwards = false;
     };
 
 /// Exports the IntegratorTwoStep class to python
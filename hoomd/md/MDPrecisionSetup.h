@@ -0,0 +1,135 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file MDPrecisionSetup.h
+    \brief Setup for md mixed precision and fixed point force accumulation
+*/
+
+#ifndef __MD_PRECISION_SETUP_H__
+#define __MD_PRECISION_SETUP_H__
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+#if defined(ENABLE_MD_FIXED_POINT_FORCES)
+
+//! 64-bit fixed point real for reproducible force accumulation
+/*! Each term is rounded to a multiple of 2^-32 and the sum is kept in a 64-bit integer. Integer
+    addition is associative, so the sum does not depend on the order of the terms, and the forces
+    are reproducible bit for bit regardless of the neighbor order or the reduction tree. The sum
+    must stay within +-2^31.
+*/
+struct FixedPointReal
+    {
+    //! Scale factor from real to fixed point
+    static constexpr double scale = 4294967296.0;
+
+    //! Default constructor, leaves the value uninitialized
+    FixedPointReal() = default;
+
+    //! Round a real to fixed point
+    HOSTDEVICE FixedPointReal(Scalar x) : value(llrint(double(x) * scale)) { }
+
+    //! Add another fixed point real
+    HOSTDEVICE FixedPointReal& operator+=(const FixedPointReal& x)
+        {
+        value += x.value;
+        return *this;
+        }
+
+    //! Sum of two fixed point reals
+    HOSTDEVICE FixedPointReal operator+(const FixedPointReal& x) const
+        {
+        FixedPointReal result;
+        result.value = value + x.value;
+        return result;
+        }
+
+    //! Multiply by a real
+    HOSTDEVICE FixedPointReal& operator*=(Scalar x)
+        {
+        value = llrint(double(value) * double(x));
+        return *this;
+        }
+
+    //! Convert to a real
+    HOSTDEVICE explicit operator Scalar() const
+        {
+        return Scalar(double(value) / scale);
+        }
+
+    long long value; //!< Multiple of 2^-32 stored
+    };
+
+//! Typedef'd real for use in force accumulators
+typedef FixedPointReal ForceReal;
+
+//! Typedef'd real4 for use in force accumulators
+struct ForceReal4
+    {
+    ForceReal x; //!< x component
+    ForceReal y; //!< y component
+    ForceReal z; //!< z component
+    ForceReal w; //!< w component
+    };
+
+#elif defined(SINGLE_PRECISION) && defined(ENABLE_MD_MIXED_PRECISION)
+
+// in single precision, mixed mode sums the forces, virials, and energies in double precision
+//! Typedef'd real for use in force accumulators
+typedef double ForceReal;
+//! Typedef'd real4 for use in force accumulators
+typedef double4 ForceReal4;
+
+#else
+
+// otherwise the accumulators have the precision of Scalar
+typedef Scalar ForceReal;
+typedef Scalar4 ForceReal4;
+
+#endif
+
+//! Helper function to create ForceReal4's
+HOSTDEVICE inline ForceReal4 make_forcereal4(ForceReal x, ForceReal y, ForceReal z, ForceReal w)
+    {
+    ForceReal4 result;
+    result.x = x;
+    result.y = y;
+    result.z = z;
+    result.w = w;
+    return result;
+    }
+
+//! Convert an accumulated force to a Scalar4 for output
+HOSTDEVICE inline Scalar4 forcereal4_to_scalar4(const ForceReal4& f)
+    {
+    return make_scalar4(Scalar(f.x), Scalar(f.y), Scalar(f.z), Scalar(f.w));
+    }
+
+#ifdef __HIPCC__
+//! Atomically add a term to a force accumulator in global memory
+/*! In fixed point mode the term is rounded and added as a 64-bit integer, so the sum does not
+    depend on the order in which the threads arrive.
+*/
+__device__ inline void atomicAddForceReal(ForceReal* address, Scalar x)
+    {
+#if defined(ENABLE_MD_FIXED_POINT_FORCES)
+    atomicAdd(reinterpret_cast<unsigned long long*>(&address->value),
+              static_cast<unsigned long long>(FixedPointReal(x).value));
+#else
+    atomicAdd(address, ForceReal(x));
+#endif
+    }
+#endif
+
+#undef HOSTDEVICE
+
+#endif //__MD_PRECISION_SETUP_H__
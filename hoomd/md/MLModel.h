@@ -0,0 +1,116 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MLModel.h
+    \brief Declares the interface to machine learned interatomic potential backends
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUArray.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <pybind11/pybind11.h>
+
+#pragma once
+
+/// Inputs to a machine learned interatomic potential
+/** All pointers refer to memory in \a location. The particles 0 to N - 1 are local, N to N +
+ * n_ghosts - 1 are ghosts. The neighbors of the local particle i are nlist[head_list[i] + k] for k
+ * in [0, n_neigh[i]), stored in both directions (full storage) and including the ghosts. These are
+ * the arrays of the NeighborList, not copies. The list contains all pairs within r_cut + r_buff,
+ * the model applies its own cutoff.
+ */
+struct MLModelInput
+    {
+    /// Memory space of all pointers
+    access_location::Enum location;
+
+    /// Number of local particles
+    unsigned int N;
+
+    /// Number of ghost particles
+    unsigned int n_ghosts;
+
+    /// Number of particle types
+    unsigned int n_types;
+
+    /// Positions and types (N + n_ghosts)
+    const Scalar4* postype;
+
+    /// Tags (N + n_ghosts)
+    const unsigned int* tag;
+
+    /// Local simulation box
+    BoxDim box;
+
+    /// Number of neighbors of each local particle (N)
+    const unsigned int* n_neigh;
+
+    /// Neighbor indices
+    const unsigned int* nlist;
+
+    /// Offset of the neighbors of each local particle in nlist (N)
+    const unsigned int* head_list;
+
+    /// True when the virial is needed
+    bool compute_virial;
+    };
+
+/// Outputs of a machine learned interatomic potential
+/** The arrays are zeroed before MLModel::evaluate() is called. The model adds the forces (x, y, z)
+ * and energies (w) of all particles, including the ghosts. The forces on the ghosts are sent back
+ * to the ranks that own them. The model adds the virial of each interaction to local particles
+ * only.
+ */
+struct MLModelOutput
+    {
+    /// Forces and energies (N + n_ghosts)
+    Scalar4* force;
+
+    /// Virials, six components with pitch virial_pitch
+    Scalar* virial;
+
+    /// Pitch of the virial array
+    size_t virial_pitch;
+    };
+
+/// Interface to a machine learned interatomic potential backend
+/** Plugins derive from MLModel to evaluate a model with an inference library, such as TorchScript,
+ * ONNX Runtime, or TensorRT, and export the derived class to python with MLModel as its base. The
+ * MLPotential force compute hands the model its inputs in host memory, or in device memory when the
+ * model supports it and the simulation runs on the GPU. The model reads the inputs and writes the
+ * outputs in place.
+ */
+class PYBIND11_EXPORT MLModel
+    {
+    public:
+    virtual ~MLModel() { }
+
+    /// Get the cutoff radius of the model
+    virtual Scalar getRCut() const = 0;
+
+    /// Get the distance within which the model reads the particles
+    /** Message passing models that combine L interaction layers read the particles within L *
+     * r_cut. The ghost layer covers this distance.
+     */
+    virtual Scalar getInteractionRange() const
+        {
+        return getRCut();
+        }
+
+    /// Test whether the model reads the inputs and writes the outputs in device memory
+    virtual bool supportsDevice() const
+        {
+        return false;
+        }
+
+    /// Evaluate the model
+    /** \param input Positions and neighbor list
+        \param output Forces, energies and virials
+    */
+    virtual void evaluate(const MLModelInput& input, const MLModelOutput& output) = 0;
+    };
@@ -0,0 +1,242 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MLPotential.cc
+    \brief Defines the MLPotential class
+*/
+
+#include "MLPotential.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param nlist Neighbor list
+    \param model Model backend
+*/
+MLPotential::MLPotential(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<NeighborList> nlist,
+                         std::shared_ptr<MLModel> model)
+    : ForceCompute(sysdef), m_nlist(nlist), m_model(model)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MLPotential" << endl;
+
+    if (!m_model)
+        {
+        throw std::invalid_argument("MLPotential requires a model.");
+        }
+
+    m_nlist->setStorageMode(NeighborList::full);
+
+    unsigned int n_types = m_pdata->getNTypes();
+    m_r_cut_nlist = std::make_shared<GlobalArray<Scalar>>(n_types * n_types, m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        std::fill(h_r_cut_nlist.data, h_r_cut_nlist.data + n_types * n_types, m_model->getRCut());
+        }
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        auto comm_weak = m_sysdef->getCommunicator();
+        assert(comm_weak.lock());
+        m_comm = comm_weak.lock();
+
+        // the model may read particles beyond its cutoff
+        m_comm->getGhostLayerWidthRequestSignal()
+            .connect<MLPotential, &MLPotential::getGhostLayerWidth>(this);
+        }
+#endif
+    }
+
+MLPotential::~MLPotential()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MLPotential" << endl;
+
+    if (m_attached)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        m_comm->getGhostLayerWidthRequestSignal()
+            .disconnect<MLPotential, &MLPotential::getGhostLayerWidth>(this);
+        }
+#endif
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void MLPotential::computeForces(uint64_t timestep)
+    {
+    m_nlist->compute(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "MLPotential");
+
+    access_location::Enum location = access_location::host;
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled() && m_model->supportsDevice())
+        {
+        location = access_location::device;
+        }
+#endif
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_ghosts = m_pdata->getNGhosts();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), location, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), location, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), location, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), location, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), location, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force, location, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, location, access_mode::overwrite);
+
+    // the model accumulates into the outputs
+#ifdef ENABLE_HIP
+    if (location == access_location::device)
+        {
+        hipMemset(h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        hipMemset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+    else
+#endif
+        {
+        memset(h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+
+    MLModelInput input;
+    input.location = location;
+    input.N = N;
+    input.n_ghosts = n_ghosts;
+    input.n_types = m_pdata->getNTypes();
+    input.postype = h_pos.data;
+    input.tag = h_tag.data;
+    input.box = m_pdata->getBox();
+    input.n_neigh = h_n_neigh.data;
+    input.nlist = h_nlist.data;
+    input.head_list = h_head_list.data;
+    input.compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
+
+    MLModelOutput output;
+    output.force = h_force.data;
+    output.virial = h_virial.data;
+    output.virial_pitch = m_virial.getPitch();
+
+    m_model->evaluate(input, output);
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step of the simulation
+ */
+CommFlags MLPotential::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags = CommFlags(0);
+
+    flags |= ForceCompute::getRequestedCommFlags(timestep);
+
+    // send the forces on ghosts back to their owners
+    flags[comm_flag::reverse_net_force] = 1;
+
+    // reverse net force requires tags
+    flags[comm_flag::tag] = 1;
+
+    return flags;
+    }
+
+/*! \param type Particle type
+    \returns The interaction range of the model plus the neighbor list buffer
+*/
+Scalar MLPotential::getGhostLayerWidth(unsigned int type)
+    {
+    return m_model->getInteractionRange() + m_nlist->getRBuff();
+    }
+#endif
+
+/*! \param input Positions and neighbor list in host memory
+    \param output Forces, energies and virials in host memory
+*/
+void HarmonicMLModel::evaluate(const MLModelInput& input, const MLModelOutput& output)
+    {
+    assert(input.location == access_location::host);
+
+    const Scalar r_cut_sq = m_r_cut * m_r_cut;
+    for (unsigned int i = 0; i < input.N; i++)
+        {
+        const Scalar3 pos_i
+            = make_scalar3(input.postype[i].x, input.postype[i].y, input.postype[i].z);
+        const unsigned int head = input.head_list[i];
+
+        for (unsigned int k = 0; k < input.n_neigh[i]; k++)
+            {
+            const unsigned int j = input.nlist[head + k];
+
+            // evaluate each pair once, also when j is a ghost
+            if (input.tag[j] <= input.tag[i])
+                continue;
+
+            const Scalar3 pos_j
+                = make_scalar3(input.postype[j].x, input.postype[j].y, input.postype[j].z);
+            const Scalar3 dx = input.box.minImage(pos_i - pos_j);
+            const Scalar rsq = dot(dx, dx);
+            if (rsq >= r_cut_sq)
+                continue;
+
+            const Scalar r = fast::sqrt(rsq);
+            const Scalar delta = m_r_cut - r;
+            const Scalar3 f = m_k * delta / r * dx;
+
+            output.force[i].x += f.x;
+            output.force[i].y += f.y;
+            output.force[i].z += f.z;
+            output.force[i].w += Scalar(0.5) * m_k * delta * delta;
+
+            output.force[j].x -= f.x;
+            output.force[j].y -= f.y;
+            output.force[j].z -= f.z;
+
+            if (input.compute_virial)
+                {
+                output.virial[0 * output.virial_pitch + i] += dx.x * f.x;
+                output.virial[1 * output.virial_pitch + i] += dx.x * f.y;
+                output.virial[2 * output.virial_pitch + i] += dx.x * f.z;
+                output.virial[3 * output.virial_pitch + i] += dx.y * f.y;
+                output.virial[4 * output.virial_pitch + i] += dx.y * f.z;
+                output.virial[5 * output.virial_pitch + i] += dx.z * f.z;
+                }
+            }
+        }
+    }
+
+void export_MLPotential(py::module& m)
+    {
+    py::class_<MLModel, std::shared_ptr<MLModel>>(m, "MLModel")
+        .def_property_readonly("r_cut", &MLModel::getRCut)
+        .def_property_readonly("interaction_range", &MLModel::getInteractionRange)
+        .def_property_readonly("supports_device", &MLModel::supportsDevice);
+
+    py::class_<HarmonicMLModel, MLModel, std::shared_ptr<HarmonicMLModel>>(m, "HarmonicMLModel")
+        .def(py::init<Scalar, Scalar>())
+        .def_property_readonly("k", &HarmonicMLModel::getK);
+
+    py::class_<MLPotential, ForceCompute, std::shared_ptr<MLPotential>>(m, "MLPotential")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<NeighborList>,
+                      std::shared_ptr<MLModel>>())
+        .def_property_readonly("model", &MLPotential::getModel);
+    }
@@ -0,0 +1,124 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MLPotential.h
+    \brief Declares a force compute that evaluates machine learned interatomic potentials
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "MLModel.h"
+#include "NeighborList.h"
+#include "hoomd/ForceCompute.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#pragma once
+
+/// Reference model with a harmonic repulsion between all pairs
+/** HarmonicMLModel evaluates U(r) = k / 2 (r_cut - r)^2 for r < r_cut on the host. It shows how a
+ * backend consumes MLModelInput and fills MLModelOutput and provides an analytic reference for
+ * tests. The model evaluates each pair once, from the particle with the lower tag, and adds the
+ * opposite force to the neighbor even when it is a ghost. The energy and virial of the pair go to
+ * the local particle.
+ */
+class PYBIND11_EXPORT HarmonicMLModel : public MLModel
+    {
+    public:
+    /// Constructor
+    /** \param k Spring constant
+        \param r_cut Cutoff radius
+    */
+    HarmonicMLModel(Scalar k, Scalar r_cut) : m_k(k), m_r_cut(r_cut) { }
+
+    /// Get the cutoff radius of the model
+    virtual Scalar getRCut() const
+        {
+        return m_r_cut;
+        }
+
+    /// Get the spring constant
+    Scalar getK() const
+        {
+        return m_k;
+        }
+
+    /// Evaluate the model
+    virtual void evaluate(const MLModelInput& input, const MLModelOutput& output);
+
+    protected:
+    Scalar m_k;     //!< Spring constant
+    Scalar m_r_cut; //!< Cutoff radius
+    };
+
+/// Computes forces with a machine learned interatomic potential
+/** MLPotential passes the positions, the neighbor list, and the force arrays to an MLModel backend
+ * without copying them. The model evaluates all local particles in one batch. When the simulation
+ * runs on the GPU and the model supports device memory, all arrays are passed in device memory.
+ *
+ * MLPotential adds the model cutoff to the neighbor list, which must use full storage.
+ *
+ * With MPI domain decomposition, the ghost layer covers the interaction range of the model and the
+ * forces on the ghosts are sent back to their owners (comm_flag::reverse_net_force), which
+ * Communicator::updateNetForce() adds to the net force. Reverse communication is not available on
+ * the GPU.
+ */
+class PYBIND11_EXPORT MLPotential : public ForceCompute
+    {
+    public:
+    /// Constructor
+    MLPotential(std::shared_ptr<SystemDefinition> sysdef,
+                std::shared_ptr<NeighborList> nlist,
+                std::shared_ptr<MLModel> model);
+
+    /// Destructor
+    virtual ~MLPotential();
+
+    /// Get the model
+    std::shared_ptr<MLModel> getModel()
+        {
+        return m_model;
+        }
+
+    /// Remove the r_cut matrix from the neighbor list when the force is detached
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+#ifdef ENABLE_MPI
+    /// Get ghost particle fields requested by this potential
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    /// Get the ghost layer width needed by the model
+    Scalar getGhostLayerWidth(unsigned int type);
+#endif
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist; //!< Neighbor list with full storage
+    std::shared_ptr<MLModel> m_model;      //!< Model backend
+
+    /// r_cut matrix added to the neighbor list
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
+
+    /// True while the r_cut matrix is added to the neighbor list
+    bool m_attached = true;
+
+#ifdef ENABLE_MPI
+    /// Communicator that provides the ghost layer
+    std::shared_ptr<Communicator> m_comm;
+#endif
+
+    /// Compute the forces
+    virtual void computeForces(uint64_t timestep);
+    };
+
+/// Export the MLModel interface and MLPotential to python
+void export_MLPotential(pybind11::module& m);
@@ -50,8 +50,6 @@ MuellerPlatheFlow::MuellerPlatheFlow(std::shared_ptr<SystemDefinition> sysdef,
 
     m_exec_conf->msg->notice(5) << "Constructing MuellerPlatheFlow " << endl;
     this->updateDomainDecomposition();
-    // m_exec_conf->msg->notice(0)<<m_exec_conf->getRank()<<": "<< m_max_swap.gbl_rank<<"
-    // "<<m_min_swap.gbl_rank<<endl;
 
     // Check min max slab.
     this->setMinSlab(m_min_slab);
@@ -158,9 +156,6 @@ void MuellerPlatheFlow::swapMinMaxSlab(void)
 
     std::swap(m_has_max_slab, m_has_min_slab);
 
-#ifdef ENABLE_MPI
-    std::swap(m_max_swap, m_min_swap);
-#endif // ENABLE_MPI
     m_exec_conf->msg->notice(4) << "MuellerPlatheUpdater swapped min/max slab: "
                                 << this->getMinSlab() << " " << this->getMaxSlab() << endl;
     }
@@ -223,13 +218,6 @@ void MuellerPlatheFlow::updateDomainDecomposition(void)
         m_has_max_slab = false;
         if (my_pos == this->getMaxSlab() / (m_N_slabs / my_grid))
             m_has_max_slab = true;
-
-        // Create the communicator.
-        const int min_color = this->hasMinSlab() ? 0 : MPI_UNDEFINED;
-        initMPISwap(&m_min_swap, min_color);
-
-        const int max_color = this->hasMaxSlab() ? 0 : MPI_UNDEFINED;
-        initMPISwap(&m_max_swap, max_color);
         }
 #endif // ENABLE_MPI
     }
@@ -297,7 +285,7 @@ void MuellerPlatheFlow::searchMinMaxVelocity(void)
                 if (index == this->getMinSlab() && m_last_min_vel.x > vel && this->hasMinSlab())
                     {
                     m_last_min_vel.x = vel;
-                    m_last_max_vel.y = mass;
+                    m_last_min_vel.y = mass;
                     m_last_min_vel.z = __int_as_scalar(h_tag.data[j]);
                     }
                 }
@@ -380,88 +368,34 @@ void MuellerPlatheFlow::verifyOrthorhombicBox(void)
     }
 #ifdef ENABLE_MPI
 
-// Not performance optimized: could be slow. It is meant for init.
-void MuellerPlatheFlow::initMPISwap(struct MPI_SWAP* ms, const int color)
-    {
-    if (ms->initialized && ms->rank != MPI_UNDEFINED)
-        MPI_Comm_free(&(ms->comm));
-
-    MPI_Comm_split(m_exec_conf->getMPICommunicator(), color, m_exec_conf->getRank(), &(ms->comm));
-    if (color != MPI_UNDEFINED)
-        {
-        MPI_Comm_rank(ms->comm, &(ms->rank));
-        MPI_Comm_size(ms->comm, &(ms->size));
-        }
-    else
-        {
-        ms->rank = MPI_UNDEFINED;
-        ms->size = MPI_UNDEFINED;
-        }
-    int send = 0;
-    if (ms->rank == 0)
-        {
-        send = 1;
-        }
-    vector<int> recv;
-    all_gather_v(send, recv, m_exec_conf->getMPICommunicator());
-
-    // ARG_MAX;
-    ms->gbl_rank = -1;
-    for (unsigned int i = 0; i < recv.size(); i++)
-        {
-        if (recv[i] == 1)
-            {
-            assert(ms->gbl_rank == -1);
-            ms->gbl_rank = i;
-            }
-        }
-    assert(ms->gbl_rank > -1);
-    ms->initialized = true;
-    }
-
-void MuellerPlatheFlow::bcastVelToAll(struct MPI_SWAP* ms, Scalar3* vel, const MPI_Op op)
-    {
-    if (ms->rank != MPI_UNDEFINED)
-        {
-        Scalar_Int tmp;
-        tmp.s = vel->x;
-        tmp.i = ms->rank;
-        MPI_Allreduce(MPI_IN_PLACE, &tmp, 1, MPI_HOOMD_SCALAR_INT, op, ms->comm);
-        // Send to subset local rank
-        if (tmp.i != 0)
-            {
-            if (ms->rank == 0)
-                {
-                recv(vel->x, tmp.i, ms->comm);
-                recv(vel->y, tmp.i, ms->comm);
-                recv(vel->z, tmp.i, ms->comm);
-                }
-            if (ms->rank == tmp.i)
-                {
-                send(vel->x, 0, ms->comm);
-                send(vel->y, 0, ms->comm);
-                send(vel->z, 0, ms->comm);
-                }
-            }
-        // ms->rank == 0 has the definite answer
-        }
-    // Broadcast the result to every rank.
-    // This way, each rank can check, whether
-    // it needs to update and can determine the exchanged momentum.
-    bcast(vel->x, ms->gbl_rank, m_exec_conf->getMPICommunicator());
-    bcast(vel->y, ms->gbl_rank, m_exec_conf->getMPICommunicator());
-    bcast(vel->z, ms->gbl_rank, m_exec_conf->getMPICommunicator());
-    }
-
+/*! Each rank contributes the extrema found in its domain. One MPI_MAXLOC reduction over all ranks
+    finds the ranks with the largest momentum in the max slab and the smallest momentum in the min
+    slab, and these ranks broadcast the mass and tag of their particle.
+*/
 void MuellerPlatheFlow::mpiExchangeVelocity(void)
     {
-#ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        bcastVelToAll(&m_min_swap, &m_last_min_vel, MPI_MINLOC);
-        bcastVelToAll(&m_max_swap, &m_last_max_vel, MPI_MAXLOC);
-        }
-#endif // ENABLE_MPI
+    if (!m_pdata->getDomainDecomposition())
+        return;
+
+    MPI_Comm comm = m_exec_conf->getMPICommunicator();
+    const int rank = m_exec_conf->getRank();
+
+    // negate the min momentum to find both extrema with MPI_MAXLOC
+    Scalar_Int extrema[2];
+    extrema[0].s = m_last_max_vel.x;
+    extrema[0].i = rank;
+    extrema[1].s = -m_last_min_vel.x;
+    extrema[1].i = rank;
+    MPI_Allreduce(MPI_IN_PLACE, extrema, 2, MPI_HOOMD_SCALAR_INT, MPI_MAXLOC, comm);
+
+    Scalar mass_tag[2] = {m_last_max_vel.y, m_last_max_vel.z};
+    MPI_Bcast(mass_tag, 2, MPI_HOOMD_SCALAR, extrema[0].i, comm);
+    m_last_max_vel = make_scalar3(extrema[0].s, mass_tag[0], mass_tag[1]);
+
+    mass_tag[0] = m_last_min_vel.y;
+    mass_tag[1] = m_last_min_vel.z;
+    MPI_Bcast(mass_tag, 2, MPI_HOOMD_SCALAR, extrema[1].i, comm);
+    m_last_min_vel = make_scalar3(-extrema[1].s, mass_tag[0], mass_tag[1]);
     }
 
 #endif // ENABLE_MPI
@@ -39,14 +39,18 @@ MuellerPlatheFlowGPU::MuellerPlatheFlowGPU(std::shared_ptr<SystemDefinition> sys
         throw std::runtime_error("Error initializing MuellerPlatheFlowGPU");
         }
 
+    // the search kernel reduces in shared memory and requires a power of 2 block size
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
-    m_tuner.reset(new Autotuner(warp_size,
-                                1024,
-                                warp_size,
-                                5,
-                                100000,
-                                "muellerplatheflow",
-                                this->m_exec_conf));
+    std::vector<unsigned int> valid_params;
+    for (unsigned int block_size = warp_size; block_size <= 512; block_size *= 2)
+        valid_params.push_back(block_size);
+    m_tuner.reset(
+        new Autotuner(valid_params, 5, 100000, "muellerplatheflow", this->m_exec_conf));
+
+    GPUArray<Scalar3> block_extrema(2, m_exec_conf);
+    m_block_extrema.swap(block_extrema);
+    GPUArray<Scalar3> extrema(2, m_exec_conf);
+    m_extrema.swap(extrema);
     }
 
 MuellerPlatheFlowGPU::~MuellerPlatheFlowGPU(void)
@@ -56,6 +60,7 @@ MuellerPlatheFlowGPU::~MuellerPlatheFlowGPU(void)
 
 void MuellerPlatheFlowGPU::searchMinMaxVelocity(void)
     {
+    m_swapped_on_device = false;
     const unsigned int group_size = m_group->getNumMembers();
     if (group_size == 0)
         return;
@@ -63,46 +68,78 @@ void MuellerPlatheFlowGPU::searchMinMaxVelocity(void)
         return;
     if (m_prof)
         m_prof->push("MuellerPlatheFlowGPU::search");
-    const ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                     access_location::device,
-                                     access_mode::read);
-    const ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
-                                     access_location::device,
-                                     access_mode::read);
-    const ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
-                                          access_location::device,
-                                          access_mode::read);
-    const ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
-                                           access_location::device,
-                                           access_mode::read);
-    const GlobalArray<unsigned int>& group_members = m_group->getIndexArray();
-    const ArrayHandle<unsigned int> d_group_members(group_members,
-                                                    access_location::device,
-                                                    access_mode::read);
 
-    const BoxDim& gl_box = m_pdata->getGlobalBox();
+    // without domain decomposition, the extrema are final and the swap happens on the device
+    bool swap = true;
+#ifdef ENABLE_MPI
+    swap = !m_pdata->getDomainDecomposition();
+#endif
 
-    m_tuner->begin();
-    gpu_search_min_max_velocity(group_size,
-                                d_vel.data,
-                                d_pos.data,
-                                d_tag.data,
-                                d_rtag.data,
-                                d_group_members.data,
-                                gl_box,
-                                this->getNSlabs(),
-                                this->getMaxSlab(),
-                                this->getMinSlab(),
-                                &m_last_max_vel,
-                                &m_last_min_vel,
-                                this->hasMaxSlab(),
-                                this->hasMinSlab(),
-                                m_tuner->getParam(),
-                                m_flow_direction,
-                                m_slab_direction);
-    m_tuner->end();
-    if (m_exec_conf->isCUDAErrorCheckingEnabled())
-        CHECK_CUDA_ERROR();
+    const unsigned int block_size = m_tuner->getParam();
+    const unsigned int n_blocks = group_size / block_size + 1;
+    if (m_block_extrema.getNumElements() < 2 * n_blocks)
+        {
+        GPUArray<Scalar3> block_extrema(2 * n_blocks, m_exec_conf);
+        m_block_extrema.swap(block_extrema);
+        }
+
+        {
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        const ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                         access_location::device,
+                                         access_mode::read);
+        const ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+        const ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                               access_location::device,
+                                               access_mode::read);
+        const GlobalArray<unsigned int>& group_members = m_group->getIndexArray();
+        const ArrayHandle<unsigned int> d_group_members(group_members,
+                                                        access_location::device,
+                                                        access_mode::read);
+        ArrayHandle<Scalar3> d_block_extrema(m_block_extrema,
+                                             access_location::device,
+                                             access_mode::overwrite);
+        ArrayHandle<Scalar3> d_extrema(m_extrema, access_location::device, access_mode::overwrite);
+
+        const BoxDim& gl_box = m_pdata->getGlobalBox();
+
+        m_tuner->begin();
+        gpu_search_min_max_velocity(group_size,
+                                    m_pdata->getN(),
+                                    d_vel.data,
+                                    d_pos.data,
+                                    d_tag.data,
+                                    d_rtag.data,
+                                    d_group_members.data,
+                                    gl_box,
+                                    this->getNSlabs(),
+                                    this->getMaxSlab(),
+                                    this->getMinSlab(),
+                                    m_last_max_vel,
+                                    m_last_min_vel,
+                                    this->hasMaxSlab(),
+                                    this->hasMinSlab(),
+                                    block_size,
+                                    m_flow_direction,
+                                    m_slab_direction,
+                                    d_block_extrema.data,
+                                    d_extrema.data,
+                                    swap,
+                                    m_pdata->getN() + m_pdata->getNGhosts());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
+
+    // read back the extrema to account for the exchanged momentum
+    ArrayHandle<Scalar3> h_extrema(m_extrema, access_location::host, access_mode::read);
+    m_last_max_vel = h_extrema.data[0];
+    m_last_min_vel = h_extrema.data[1];
+    m_swapped_on_device = swap;
 
     if (m_prof)
         m_prof->pop();
@@ -110,6 +147,10 @@ void MuellerPlatheFlowGPU::searchMinMaxVelocity(void)
 
 void MuellerPlatheFlowGPU::updateMinMaxVelocity(void)
     {
+    // the search kernel has already swapped the velocities
+    if (m_swapped_on_device)
+        return;
+
     if (m_prof)
         m_prof->push("MuellerPlatheFlowGPU::update");
     const ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
@@ -7,126 +7,240 @@
 #include "hoomd/HOOMDMath.h"
 #include <assert.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#include <thrust/device_ptr.h>
-#include <thrust/functional.h>
-#include <thrust/transform_reduce.h>
-#pragma GCC diagnostic pop
-
-struct vel_search_un_opt : public thrust::unary_function<const unsigned int, Scalar3>
+/*! \file MuellerPlatheFlowGPU.cu
+    \brief Defines GPU kernel code for calculating MinMax velocities and updates for the flow.
+*/
+
+//! Number of threads of the kernel that reduces the extrema of all blocks, must be a power of 2
+const unsigned int REDUCE_BLOCK_SIZE = 256;
+
+//! Component of a vector along a direction
+__host__ __device__ inline Scalar get_component(const Scalar4& v,
+                                                const flow_enum::Direction direction)
     {
-    vel_search_un_opt(const Scalar4* const d_vel,
-                      const unsigned int* const d_tag,
-                      flow_enum::Direction flow_direction)
-        : m_vel(d_vel), m_tag(d_tag), m_flow_direction(flow_direction)
+    switch (direction)
         {
+    case flow_enum::X:
+        return v.x;
+    case flow_enum::Y:
+        return v.y;
+    default:
+        return v.z;
         }
-    const Scalar4* const m_vel;
-    const unsigned int* const m_tag;
-    const flow_enum::Direction m_flow_direction;
-    __host__ __device__ Scalar3 operator()(const unsigned int idx) const
+    }
+
+//! Set the component of a vector along a direction
+__device__ inline void
+set_component(Scalar4& v, const flow_enum::Direction direction, const Scalar value)
+    {
+    switch (direction)
         {
-        const unsigned int tag = m_tag[idx];
-        Scalar vel;
-        switch (m_flow_direction)
-            {
-        case flow_enum::X:
-            vel = m_vel[idx].x;
-            break;
-        case flow_enum::Y:
-            vel = m_vel[idx].y;
-            break;
-        case flow_enum::Z:
-            vel = m_vel[idx].z;
-            break;
-            }
-        const Scalar mass = m_vel[idx].w;
-        vel *= mass;
-        Scalar3 result;
-        result.x = vel;
-        result.y = mass;
-        result.z = __int_as_scalar(tag);
-        return result;
+    case flow_enum::X:
+        v.x = value;
+        break;
+    case flow_enum::Y:
+        v.y = value;
+        break;
+    default:
+        v.z = value;
+        break;
         }
-    };
-template<typename CMP>
-struct vel_search_binary_opt : public thrust::binary_function<Scalar3, Scalar3, Scalar3>
+    }
+
+//! Keep the extremum with the larger (max) or smaller (min) momentum in the shared memory arrays
+/*! \param s_max Max slab extrema
+    \param s_min Min slab extrema
+    \param i Index to keep the result in
+    \param j Index to compare with
+*/
+__device__ inline void
+reduce_extrema(Scalar3* s_max, Scalar3* s_min, const unsigned int i, const unsigned int j)
+    {
+    if (s_max[j].x > s_max[i].x)
+        s_max[i] = s_max[j];
+    if (s_min[j].x < s_min[i].x)
+        s_min[i] = s_min[j];
+    }
+
+//! Reduce the extrema in shared memory with all threads of the block
+/*! \param s_max Max slab extrema (blockDim.x entries)
+    \param s_min Min slab extrema (blockDim.x entries)
+
+    blockDim.x must be a power of 2. The result is in s_max[0] and s_min[0].
+*/
+__device__ inline void reduce_extrema_block(Scalar3* s_max, Scalar3* s_min)
     {
-    vel_search_binary_opt(const unsigned int* const d_rtag,
-                          const Scalar4* const d_pos,
-                          const BoxDim gl_box,
-                          const unsigned int Nslabs,
-                          const unsigned int slab_index,
-                          const Scalar3 invalid,
-                          const flow_enum::Direction slab_direction)
-        : m_rtag(d_rtag), m_pos(d_pos), m_gl_box(gl_box), m_Nslabs(Nslabs),
-          m_slab_index(slab_index), m_invalid(invalid), m_slab_direction(slab_direction)
+    __syncthreads();
+    for (unsigned int offset = blockDim.x / 2; offset > 0; offset >>= 1)
         {
+        if (threadIdx.x < offset)
+            reduce_extrema(s_max, s_min, threadIdx.x, threadIdx.x + offset);
+        __syncthreads();
         }
-    const unsigned int* const m_rtag;
-    const Scalar4* const m_pos;
-    const BoxDim m_gl_box;
-    const unsigned int m_Nslabs;
-    const unsigned int m_slab_index;
-    const Scalar3 m_invalid;
-    const flow_enum::Direction m_slab_direction;
-
-    __host__ __device__ Scalar3 operator()(const Scalar3& a, const Scalar3& b) const
+    }
+
+//! Set the new velocities of the particles with the max and min momentum
+/*! The particles may be local particles or ghosts. Particles that are not on this rank are
+    skipped.
+*/
+__device__ inline void swap_min_max_velocity(const unsigned int* const d_rtag,
+                                             Scalar4* const d_vel,
+                                             const unsigned int Ntotal,
+                                             const Scalar3 last_max_vel,
+                                             const Scalar3 last_min_vel,
+                                             const flow_enum::Direction flow_direction)
+    {
+    const unsigned int min_tag = __scalar_as_int(last_min_vel.z);
+    const unsigned int min_idx = d_rtag[min_tag];
+    const unsigned int max_tag = __scalar_as_int(last_max_vel.z);
+    const unsigned int max_idx = d_rtag[max_tag];
+
+    if (min_idx < Ntotal)
+        set_component(d_vel[min_idx], flow_direction, last_max_vel.x / last_min_vel.y);
+
+    if (max_idx < Ntotal)
+        set_component(d_vel[max_idx], flow_direction, last_min_vel.x / last_max_vel.y);
+    }
+
+//! Find the extrema of the momentum in the max and min slabs of each block
+/*! Each thread handles one member of the group. Only local particles are considered. The extrema
+    of block b are written to d_block_extrema[2*b] (max) and d_block_extrema[2*b+1] (min). The
+    momentum is stored in x, the mass in y and the tag (as Scalar) in z.
+*/
+__global__ void gpu_search_min_max_velocity_kernel(const unsigned int group_size,
+                                                   const unsigned int N,
+                                                   const Scalar4* const d_vel,
+                                                   const Scalar4* const d_pos,
+                                                   const unsigned int* const d_tag,
+                                                   const unsigned int* const d_group_members,
+                                                   const Scalar L,
+                                                   const unsigned int Nslabs,
+                                                   const unsigned int max_slab,
+                                                   const unsigned int min_slab,
+                                                   const Scalar3 init_max_vel,
+                                                   const Scalar3 init_min_vel,
+                                                   const bool has_max_slab,
+                                                   const bool has_min_slab,
+                                                   const flow_enum::Direction flow_direction,
+                                                   const flow_enum::Direction slab_direction,
+                                                   Scalar3* const d_block_extrema)
+    {
+    HIP_DYNAMIC_SHARED(Scalar3, s_extrema)
+    Scalar3* s_max = s_extrema;
+    Scalar3* s_min = s_extrema + blockDim.x;
+
+    Scalar3 max_vel = init_max_vel;
+    Scalar3 min_vel = init_min_vel;
+
+    const unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx < group_size)
         {
-        Scalar3 result = m_invalid;
-        // Early exit, if invalid args involved.
-        if (a.z == m_invalid.z)
-            return b;
-        if (b.z == m_invalid.z)
-            return a;
-
-        const unsigned int idx_a = m_rtag[__scalar_as_int(a.z)];
-        const unsigned int idx_b = m_rtag[__scalar_as_int(b.z)];
-
-        unsigned int index_a, index_b;
-        switch (m_slab_direction)
+        const unsigned int j = d_group_members[group_idx];
+        if (j < N)
             {
-        case flow_enum::X:
-            index_a = (m_pos[idx_a].x / m_gl_box.getL().x + .5) * m_Nslabs;
-            index_b = (m_pos[idx_b].x / m_gl_box.getL().x + .5) * m_Nslabs;
-            break;
-        case flow_enum::Y:
-            index_a = (m_pos[idx_a].y / m_gl_box.getL().y + .5) * m_Nslabs;
-            index_b = (m_pos[idx_b].y / m_gl_box.getL().y + .5) * m_Nslabs;
-            break;
-        case flow_enum::Z:
-            index_a = (m_pos[idx_a].z / m_gl_box.getL().z + .5) * m_Nslabs;
-            index_b = (m_pos[idx_b].z / m_gl_box.getL().z + .5) * m_Nslabs;
-            break;
-            }
-        index_a %= m_Nslabs;
-        index_b %= m_Nslabs;
+            const Scalar4 pos = d_pos[j];
+            unsigned int slab
+                = (unsigned int)((get_component(pos, slab_direction) / L + Scalar(0.5)) * Nslabs);
+            slab %= Nslabs;
 
-        if (index_a == index_b)
-            {
-            if (index_a == m_slab_index)
-                {
-                CMP cmp;
-                if (cmp(a.x, b.x))
-                    result = a;
-                else
-                    result = b;
-                }
+            const Scalar4 vel = d_vel[j];
+            const Scalar mass = vel.w;
+            const Scalar3 momentum = make_scalar3(get_component(vel, flow_direction) * mass,
+                                                  mass,
+                                                  __int_as_scalar(d_tag[j]));
+            if (has_max_slab && slab == max_slab)
+                max_vel = momentum;
+            if (has_min_slab && slab == min_slab)
+                min_vel = momentum;
             }
-        else
+        }
+
+    s_max[threadIdx.x] = max_vel;
+    s_min[threadIdx.x] = min_vel;
+    reduce_extrema_block(s_max, s_min);
+
+    if (threadIdx.x == 0)
+        {
+        d_block_extrema[2 * blockIdx.x] = s_max[0];
+        d_block_extrema[2 * blockIdx.x + 1] = s_min[0];
+        }
+    }
+
+//! Reduce the extrema of all blocks and optionally swap the velocities
+/*! Runs in a single block. The extrema are written to d_extrema[0] (max) and d_extrema[1] (min).
+    When \a swap is set and both extrema were found, the velocities are swapped on the device.
+*/
+__global__ void gpu_reduce_min_max_velocity_kernel(const unsigned int n_blocks,
+                                                   const Scalar3* const d_block_extrema,
+                                                   const Scalar3 init_max_vel,
+                                                   const Scalar3 init_min_vel,
+                                                   Scalar3* const d_extrema,
+                                                   const bool swap,
+                                                   const unsigned int* const d_rtag,
+                                                   Scalar4* const d_vel,
+                                                   const unsigned int Ntotal,
+                                                   const flow_enum::Direction flow_direction)
+    {
+    __shared__ Scalar3 s_max[REDUCE_BLOCK_SIZE];
+    __shared__ Scalar3 s_min[REDUCE_BLOCK_SIZE];
+
+    s_max[threadIdx.x] = init_max_vel;
+    s_min[threadIdx.x] = init_min_vel;
+    for (unsigned int b = threadIdx.x; b < n_blocks; b += blockDim.x)
+        {
+        const Scalar3 max_vel = d_block_extrema[2 * b];
+        const Scalar3 min_vel = d_block_extrema[2 * b + 1];
+        if (max_vel.x > s_max[threadIdx.x].x)
+            s_max[threadIdx.x] = max_vel;
+        if (min_vel.x < s_min[threadIdx.x].x)
+            s_min[threadIdx.x] = min_vel;
+        }
+    reduce_extrema_block(s_max, s_min);
+
+    if (threadIdx.x == 0)
+        {
+        const Scalar3 max_vel = s_max[0];
+        const Scalar3 min_vel = s_min[0];
+        d_extrema[0] = max_vel;
+        d_extrema[1] = min_vel;
+
+        if (swap && __scalar_as_int(max_vel.z) != __scalar_as_int(init_max_vel.z)
+            && __scalar_as_int(min_vel.z) != __scalar_as_int(init_min_vel.z))
             {
-            if (index_a == m_slab_index)
-                result = a;
-            if (index_b == m_slab_index)
-                result = b;
+            swap_min_max_velocity(d_rtag, d_vel, Ntotal, max_vel, min_vel, flow_direction);
             }
-        return result;
         }
-    };
+    }
 
+/*! \param group_size Number of members in the group
+    \param N Number of local particles
+    \param d_vel Particle velocities (swapped in place when \a swap is set)
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param d_rtag Reverse-lookup tag->index
+    \param d_group_members Indices of the group members
+    \param gl_box Global simulation box
+    \param Nslabs Number of slabs
+    \param max_slab Slab to search the max momentum in
+    \param min_slab Slab to search the min momentum in
+    \param init_max_vel Max extremum that marks "not found"
+    \param init_min_vel Min extremum that marks "not found"
+    \param has_max_slab True when this rank holds part of the max slab
+    \param has_min_slab True when this rank holds part of the min slab
+    \param blocksize Number of threads per block, must be a power of 2
+    \param flow_direction Direction of the flow
+    \param slab_direction Direction normal to the slabs
+    \param d_block_extrema Temporary storage for the extrema of each block (2 per block)
+    \param d_extrema Output: the max (0) and min (1) extrema
+    \param swap True to swap the velocities of the extrema on the device
+    \param Ntotal Number of local and ghost particles
+
+    The velocities are swapped without returning to the host. The host only reads d_extrema to
+    account for the exchanged momentum.
+*/
 hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
-                                       const Scalar4* const d_vel,
+                                       const unsigned int N,
+                                       Scalar4* const d_vel,
                                        const Scalar4* const d_pos,
                                        const unsigned int* const d_tag,
                                        const unsigned int* const d_rtag,
@@ -135,46 +249,67 @@ hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        const unsigned int Nslabs,
                                        const unsigned int max_slab,
                                        const unsigned int min_slab,
-                                       Scalar3* const last_max_vel,
-                                       Scalar3* const last_min_vel,
+                                       const Scalar3 init_max_vel,
+                                       const Scalar3 init_min_vel,
                                        const bool has_max_slab,
                                        const bool has_min_slab,
                                        const unsigned int blocksize,
                                        const flow_enum::Direction flow_direction,
-                                       const flow_enum::Direction slab_direction)
+                                       const flow_enum::Direction slab_direction,
+                                       Scalar3* const d_block_extrema,
+                                       Scalar3* const d_extrema,
+                                       const bool swap,
+                                       const unsigned int Ntotal)
     {
-    thrust::device_ptr<const unsigned int> member_ptr(d_group_members);
+    const unsigned int n_blocks = group_size / blocksize + 1;
 
-    vel_search_un_opt un_opt(d_vel, d_tag, flow_direction);
+    // box length normal to the slabs
+    const Scalar3 box_L = gl_box.getL();
+    const Scalar L = get_component(make_scalar4(box_L.x, box_L.y, box_L.z, 0), slab_direction);
 
-    if (has_max_slab)
-        {
-        vel_search_binary_opt<thrust::greater<const Scalar>>
-            max_bin_opt(d_rtag, d_pos, gl_box, Nslabs, max_slab, *last_max_vel, slab_direction);
-        Scalar3 init = *last_max_vel;
-        *last_max_vel = thrust::transform_reduce(member_ptr,
-                                                 member_ptr + group_size,
-                                                 un_opt,
-                                                 init,
-                                                 max_bin_opt);
-        }
+    hipLaunchKernelGGL((gpu_search_min_max_velocity_kernel),
+                       dim3(n_blocks),
+                       dim3(blocksize),
+                       2 * blocksize * sizeof(Scalar3),
+                       0,
+                       group_size,
+                       N,
+                       d_vel,
+                       d_pos,
+                       d_tag,
+                       d_group_members,
+                       L,
+                       Nslabs,
+                       max_slab,
+                       min_slab,
+                       init_max_vel,
+                       init_min_vel,
+                       has_max_slab,
+                       has_min_slab,
+                       flow_direction,
+                       slab_direction,
+                       d_block_extrema);
 
-    if (has_min_slab)
-        {
-        vel_search_binary_opt<thrust::less<const Scalar>>
-            min_bin_opt(d_rtag, d_pos, gl_box, Nslabs, min_slab, *last_min_vel, slab_direction);
-        Scalar3 init = *last_min_vel;
-        *last_min_vel = thrust::transform_reduce(member_ptr,
-                                                 member_ptr + group_size,
-                                                 un_opt,
-                                                 init,
-                                                 min_bin_opt);
-        }
+    hipLaunchKernelGGL((gpu_reduce_min_max_velocity_kernel),
+                       dim3(1),
+                       dim3(REDUCE_BLOCK_SIZE),
+                       0,
+                       0,
+                       n_blocks,
+                       d_block_extrema,
+                       init_max_vel,
+                       init_min_vel,
+                       d_extrema,
+                       swap,
+                       d_rtag,
+                       d_vel,
+                       Ntotal,
+                       flow_direction);
 
     return hipPeekAtLastError();
     }
 
-void __global__ gpu_update_min_max_velocity_kernel(const unsigned int* const d_rtag,
+__global__ void gpu_update_min_max_velocity_kernel(const unsigned int* const d_rtag,
                                                    Scalar4* const d_vel,
                                                    const unsigned int Ntotal,
                                                    const Scalar3 last_max_vel,
@@ -184,45 +319,8 @@ void __global__ gpu_update_min_max_velocity_kernel(const unsigned int* const d_r
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (idx >= 1)
         return;
-    const unsigned int min_tag = __scalar_as_int(last_min_vel.z);
-    const unsigned int min_idx = d_rtag[min_tag];
-    const unsigned int max_tag = __scalar_as_int(last_max_vel.z);
-    const unsigned int max_idx = d_rtag[max_tag];
-    // Is the particle local on the processor?
-    // Swap the particles the new velocities.
-    if (min_idx < Ntotal)
-        {
-        const Scalar new_min_vel = last_max_vel.x / last_min_vel.y;
-        switch (flow_direction)
-            {
-        case flow_enum::X:
-            d_vel[min_idx].x = new_min_vel;
-            break;
-        case flow_enum::Y:
-            d_vel[min_idx].y = new_min_vel;
-            break;
-        case flow_enum::Z:
-            d_vel[min_idx].z = new_min_vel;
-            break;
-            }
-        }
 
-    if (max_idx < Ntotal)
-        {
-        const Scalar new_max_vel = last_min_vel.x / last_max_vel.y;
-        switch (flow_direction)
-            {
-        case flow_enum::X:
-            d_vel[max_idx].x = new_max_vel;
-            break;
-        case flow_enum::Y:
-            d_vel[max_idx].y = new_max_vel;
-            break;
-        case flow_enum::Z:
-            d_vel[max_idx].z = new_max_vel;
-            break;
-            }
-        }
+    swap_min_max_velocity(d_rtag, d_vel, Ntotal, last_max_vel, last_min_vel, flow_direction);
     }
 
 hipError_t gpu_update_min_max_velocity(const unsigned int* const d_rtag,
@@ -12,8 +12,10 @@
 #ifndef __MUELLER_PLATHE_FLOW_GPU_CUH__
 #define __MUELLER_PLATHE_FLOW_GPU_CUH__
 
+//! Find the extrema of the momentum in the max and min slabs, and swap them when requested
 hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
-                                       const Scalar4* const d_vel,
+                                       const unsigned int N,
+                                       Scalar4* const d_vel,
                                        const Scalar4* const d_pos,
                                        const unsigned int* const d_tag,
                                        const unsigned int* const d_rtag,
@@ -22,14 +24,19 @@ hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        const unsigned int Nslabs,
                                        const unsigned int max_slab,
                                        const unsigned int min_slab,
-                                       Scalar3* const last_max_vel,
-                                       Scalar3* const last_min_vel,
+                                       const Scalar3 init_max_vel,
+                                       const Scalar3 init_min_vel,
                                        const bool has_max_slab,
                                        const bool has_min_slab,
                                        const unsigned int blocksize,
                                        flow_enum::Direction flow_direction,
-                                       flow_enum::Direction slab_direction);
+                                       flow_enum::Direction slab_direction,
+                                       Scalar3* const d_block_extrema,
+                                       Scalar3* const d_extrema,
+                                       const bool swap,
+                                       const unsigned int Ntotal);
 
+//! Swap the velocities of the given extrema
 hipError_t gpu_update_min_max_velocity(const unsigned int* const d_rtag,
                                        Scalar4* const d_vel,
                                        const unsigned int Ntotal,
@@ -25,7 +25,12 @@
 #define __MUELLER_PLATHE_FLOW_GPU_H__
 
 //! By exchanging velocities based on their spatial position a flow is created. GPU accelerated
-/*! \ingroup computes
+/*! The search for the extrema and, without domain decomposition, the velocity swap run on the
+    device. The host reads back only the two extrema to account for the exchanged momentum. With
+    domain decomposition, the extrema of each rank are combined by MuellerPlatheFlow with a single
+    MPI_MAXLOC reduction and the swap is a separate kernel.
+
+    \ingroup computes
  */
 class MuellerPlatheFlowGPU : public MuellerPlatheFlow
     {
@@ -65,6 +70,12 @@ class MuellerPlatheFlowGPU : public MuellerPlatheFlow
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
 
+    GPUArray<Scalar3> m_block_extrema; //!< Max and min extrema found by each block
+    GPUArray<Scalar3> m_extrema;       //!< Max and min extrema of all particles on this rank
+
+    /// True when the last search already swapped the velocities on the device
+    bool m_swapped_on_device = false;
+
     virtual void searchMinMaxVelocity(void);
     virtual void updateMinMaxVelocity(void);
     };
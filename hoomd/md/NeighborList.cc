@@ -8,10 +8,14 @@
 #endif
 
 #include "NeighborList.h"
+#include "NeighborListCompression.h"
+#include "NeighborListExclusionMask.h"
 #include "hoomd/BondedGroupData.h"
 
 namespace py = pybind11;
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
@@ -57,6 +61,7 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     // initialize box length at last update
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
+    m_last_box = m_pdata->getGlobalBox();
 
     // allocate r_cut pairwise storage
     GlobalArray<Scalar> r_cut(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -189,6 +194,10 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_ex_list_tag.swap(ex_list_tag);
     TAG_ALLOCATION(m_ex_list_tag);
 
+    GlobalArray<unsigned int> ex_count_tag(m_pdata->getRTags().size(), 1, m_exec_conf);
+    m_ex_count_tag.swap(ex_count_tag);
+    TAG_ALLOCATION(m_ex_count_tag);
+
     GlobalArray<unsigned int> n_ex_idx(m_pdata->getMaxN(), m_exec_conf);
     m_n_ex_idx.swap(n_ex_idx);
     TAG_ALLOCATION(m_n_ex_idx);
@@ -197,6 +206,14 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_ex_list_idx.swap(ex_list_idx);
     TAG_ALLOCATION(m_ex_list_idx);
 
+    GlobalArray<unsigned int> ex_mask_idx(m_pdata->getMaxN(), m_exec_conf);
+    m_ex_mask_idx.swap(ex_mask_idx);
+    TAG_ALLOCATION(m_ex_mask_idx);
+
+    GlobalArray<unsigned int> n_ex_filter_idx(m_pdata->getMaxN(), m_exec_conf);
+    m_n_ex_filter_idx.swap(n_ex_filter_idx);
+    TAG_ALLOCATION(m_n_ex_filter_idx);
+
     // reset exclusions
     resizeAndClearExclusions();
 
@@ -213,26 +230,50 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 
+    m_sysdef->getBondData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotBondChange>(this);
+
     m_sysdef->getBondData()
         ->getGroupNumChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getAngleData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotAngleChange>(this);
+
     m_sysdef->getAngleData()
         ->getGroupNumChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getDihedralData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotDihedralChange>(this);
+
     m_sysdef->getDihedralData()
         ->getGroupNumChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getImproperData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotImproperChange>(this);
+
     m_sysdef->getImproperData()
         ->getGroupNumChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getConstraintData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotConstraintChange>(this);
+
     m_sysdef->getConstraintData()
         ->getGroupNumChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getPairData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotPairChange>(this);
+
     m_sysdef->getPairData()
         ->getGroupNumChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
@@ -286,6 +327,10 @@ void NeighborList::reallocate()
     m_ex_list_idx.resize(m_pdata->getMaxN(), ex_list_height);
     m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), ex_list_height);
 
+    // the masks are recomputed with the exclusion list
+    m_ex_mask_idx.resize(m_pdata->getMaxN());
+    m_n_ex_filter_idx.resize(m_pdata->getMaxN());
+
     // resize the head list and number of neighbors per particle
     m_head_list.resize(m_pdata->getMaxN());
     m_n_neigh.resize(m_pdata->getMaxN());
@@ -304,26 +349,50 @@ NeighborList::~NeighborList()
     m_pdata->getGlobalParticleNumberChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 
+    m_sysdef->getBondData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotBondChange>(this);
+
     m_sysdef->getBondData()
         ->getGroupNumChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getAngleData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotAngleChange>(this);
+
     m_sysdef->getAngleData()
         ->getGroupNumChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getDihedralData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotDihedralChange>(this);
+
     m_sysdef->getDihedralData()
         ->getGroupNumChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getImproperData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotImproperChange>(this);
+
     m_sysdef->getImproperData()
         ->getGroupNumChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getConstraintData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotConstraintChange>(this);
+
     m_sysdef->getConstraintData()
         ->getGroupNumChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
 
+    m_sysdef->getPairData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotPairChange>(this);
+
     m_sysdef->getPairData()
         ->getGroupNumChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
@@ -374,6 +443,10 @@ void NeighborList::compute(uint64_t timestep)
             }
         }
 
+    // apply the exclusions of single groups added or removed since the last step
+    if (!m_exclusion_patches.empty())
+        applyExclusionPatches();
+
     // take care of some updates if things have changed since construction
     if (m_force_update)
         {
@@ -387,6 +460,12 @@ void NeighborList::compute(uint64_t timestep)
     // check if the list needs to be updated and update it
     if (needsUpdating(timestep))
         {
+#ifdef ENABLE_MPI
+        // the list includes ghost particles, complete a pending ghost update
+        if (m_comm)
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+
         // check simulation box size is OK
         checkBoxSize();
 
@@ -408,11 +487,29 @@ void NeighborList::compute(uint64_t timestep)
                 }
             } while (overflowed);
 
+        // leave the masked exclusions in the list when every consumer skips them
+        m_ex_masks_used = m_mask_exclusions && m_exclusions_set && supportsExclusionMasks()
+                          && std::all_of(m_consumer_ex_mask.begin(),
+                                         m_consumer_ex_mask.end(),
+                                         [](bool evaluates) { return evaluates; });
+
         if (m_exclusions_set)
             filterNlist();
 
+        // consumers with short cutoffs read only a prefix of each row
+        m_shells_valid = m_consumer_r_cut.size() > 1 && !m_compressed;
+        if (m_shells_valid)
+            {
+            updateShells();
+            partitionShells();
+            }
+
+        if (m_compressed)
+            compressNlist();
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_ghost_partition_valid = false;
         }
     if (m_prof)
         m_prof->pop();
@@ -421,7 +518,8 @@ void NeighborList::compute(uint64_t timestep)
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
-    Calls buildNlist repeatedly to benchmark the neighbor list.
+    Calls buildNlist repeatedly to benchmark the neighbor list. In MPI simulations, all ranks
+    return the time of the slowest rank.
 */
 double NeighborList::benchmark(unsigned int num_iters)
     {
@@ -451,7 +549,49 @@ double NeighborList::benchmark(unsigned int num_iters)
     uint64_t total_time_ns = t.getTime() - start_time;
 
     // convert the run time to milliseconds
-    return double(total_time_ns) / 1e6 / double(num_iters);
+    double result = double(total_time_ns) / 1e6 / double(num_iters);
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &result,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return result;
+    }
+
+/*! \param r_cut Flattened r_cut matrix with ntypes*ntypes elements
+
+    Adds \a r_cut as a consumer r_cut matrix owned by the neighbor list, replacing the previous
+    one. This allows benchmark() to time a neighbor list that no pair force uses yet.
+*/
+void NeighborList::setBenchmarkRCut(pybind11::list r_cut)
+    {
+    if (pybind11::len(r_cut) != m_r_cut.getNumElements())
+        {
+        throw std::invalid_argument("given r_cut_matrix is not the right size");
+        }
+
+    if (m_benchmark_r_cut)
+        removeRCutMatrix(m_benchmark_r_cut);
+
+    m_benchmark_r_cut
+        = std::make_shared<GlobalArray<Scalar>>(m_r_cut.getNumElements(), m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*m_benchmark_r_cut,
+                                    access_location::host,
+                                    access_mode::overwrite);
+        for (unsigned int i = 0; i < m_r_cut.getNumElements(); i++)
+            h_r_cut.data[i] = r_cut[i].cast<Scalar>();
+        }
+
+    addRCutMatrix(m_benchmark_r_cut);
     }
 
 /*! \param r_buff New buffer radius to set
@@ -616,7 +756,7 @@ Scalar NeighborList::estimateNNeigh()
     \param tag2 TAG (not index) of the second particle in the pair
     \post The pair \a tag1, \a tag2 will not appear in the neighborlist
     \note This only takes effect on the next call to compute() that updates the list
-    \note Duplicates are checked for and not added.
+    \note Duplicates are not added again, they increment the reference count of the exclusion.
 */
 void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
     {
@@ -627,9 +767,35 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
 
     m_exclusions_set = true;
 
-    // don't add an exclusion twice
-    if (isExcluded(tag1, tag2))
-        return;
+    // don't add an exclusion twice, count the reference instead
+        {
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_ex_count_tag(m_ex_count_tag,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+
+        bool found = false;
+        unsigned int tags[2] = {tag1, tag2};
+        for (unsigned int i = 0; i < (tag1 == tag2 ? 1u : 2u); ++i)
+            {
+            for (unsigned int offset = 0; offset < h_n_ex_tag.data[tags[i]]; offset++)
+                {
+                unsigned int ex_idx = m_ex_list_indexer_tag(tags[i], offset);
+                if (h_ex_list_tag.data[ex_idx] == tags[1 - i])
+                    {
+                    h_ex_count_tag.data[ex_idx]++;
+                    found = true;
+                    break;
+                    }
+                }
+            }
+
+        if (found)
+            return;
+        }
 
     // this is clunky, but needed due to the fact that we cannot have an array handle in scope when
     // calling grow exclusion list
@@ -658,6 +824,9 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
         ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
                                                 access_location::host,
                                                 access_mode::readwrite);
+        ArrayHandle<unsigned int> h_ex_count_tag(m_ex_count_tag,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
         ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag,
                                              access_location::host,
                                              access_mode::readwrite);
@@ -666,18 +835,277 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
         unsigned int pos1 = h_n_ex_tag.data[tag1];
         assert(pos1 < m_ex_list_indexer.getH());
         h_ex_list_tag.data[m_ex_list_indexer_tag(tag1, pos1)] = tag2;
+        h_ex_count_tag.data[m_ex_list_indexer_tag(tag1, pos1)] = 1;
         h_n_ex_tag.data[tag1]++;
 
         // add tag1 to tag2's exclusion list
-        unsigned int pos2 = h_n_ex_tag.data[tag2];
-        assert(pos2 < m_ex_list_indexer.getH());
-        h_ex_list_tag.data[m_ex_list_indexer_tag(tag2, pos2)] = tag1;
-        h_n_ex_tag.data[tag2]++;
+        if (tag2 != tag1)
+            {
+            unsigned int pos2 = h_n_ex_tag.data[tag2];
+            assert(pos2 < m_ex_list_indexer.getH());
+            h_ex_list_tag.data[m_ex_list_indexer_tag(tag2, pos2)] = tag1;
+            h_ex_count_tag.data[m_ex_list_indexer_tag(tag2, pos2)] = 1;
+            h_n_ex_tag.data[tag2]++;
+            }
+        }
+
+    forceUpdate();
+    }
+
+/*! \param tag1 TAG (not index) of the first particle in the pair
+    \param tag2 TAG (not index) of the second particle in the pair
+    \post The pair \a tag1, \a tag2 may appear in the neighborlist when no other reference to the
+    exclusion remains
+    \note This only takes effect on the next call to compute() that updates the list
+*/
+void NeighborList::removeExclusion(unsigned int tag1, unsigned int tag2)
+    {
+    assert(tag1 <= m_pdata->getMaximumTag());
+    assert(tag2 <= m_pdata->getMaximumTag());
+
+    bool removed = false;
+
+        {
+        // access arrays
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
+                                                access_location::host,
+                                                access_mode::readwrite);
+        ArrayHandle<unsigned int> h_ex_count_tag(m_ex_count_tag,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag,
+                                             access_location::host,
+                                             access_mode::readwrite);
+
+        // remove a reference to tag2 from tag1's exclusion list and to tag1 from tag2's, move the
+        // last exclusion into the hole when no reference remains
+        unsigned int tags[2] = {tag1, tag2};
+        for (unsigned int i = 0; i < (tag1 == tag2 ? 1u : 2u); ++i)
+            {
+            unsigned int tag = tags[i];
+            unsigned int other = tags[1 - i];
+            unsigned int n = h_n_ex_tag.data[tag];
+
+            for (unsigned int offset = 0; offset < n; offset++)
+                {
+                unsigned int ex_idx = m_ex_list_indexer_tag(tag, offset);
+                if (h_ex_list_tag.data[ex_idx] == other)
+                    {
+                    if (--h_ex_count_tag.data[ex_idx] == 0)
+                        {
+                        unsigned int last_idx = m_ex_list_indexer_tag(tag, n - 1);
+                        h_ex_list_tag.data[ex_idx] = h_ex_list_tag.data[last_idx];
+                        h_ex_count_tag.data[ex_idx] = h_ex_count_tag.data[last_idx];
+                        h_n_ex_tag.data[tag]--;
+                        removed = true;
+                        }
+                    break;
+                    }
+                }
+            }
         }
 
+    if (removed)
+        forceUpdate();
+    }
+
+/*! \returns true when the exclusions of the changed group may be patched
+
+    Every single group change is followed by a group number change. When no full rebuild of the
+    exclusions is pending, the caller queues the exclusion patches of the group and the following
+    number change is ignored.
+*/
+bool NeighborList::beginGroupChange()
+    {
+    if (m_topology_changed || m_n_particles_changed)
+        return false;
+
+    m_skip_topology_change = true;
+    return true;
+    }
+
+/*! \param tag1 First particle tag in the pair
+    \param tag2 Second particle tag in the pair
+    \param add True to add a reference to the exclusion, false to remove one
+*/
+void NeighborList::queueExclusionPatch(unsigned int tag1, unsigned int tag2, bool add)
+    {
+    exclusion_patch_t patch;
+    patch.tag1 = tag1;
+    patch.tag2 = tag2;
+    patch.add = add;
+    m_exclusion_patches.push_back(patch);
+
     forceUpdate();
     }
 
+/*! \param tags Tags of the bond members
+    \param added True if the bond was added, false if it was removed
+*/
+void NeighborList::slotBondChange(const BondData::members_t& tags, bool added)
+    {
+    if (!beginGroupChange())
+        return;
+
+    if (m_exclusions.count("bond"))
+        queueExclusionPatch(tags.tag[0], tags.tag[1], added);
+
+    if (m_exclusions.count("1-3") || m_exclusions.count("1-4"))
+        queueBondPathPatches(tags.tag[0], tags.tag[1], added);
+    }
+
+/*! \param tags Tags of the angle members
+    \param added True if the angle was added, false if it was removed
+*/
+void NeighborList::slotAngleChange(const AngleData::members_t& tags, bool added)
+    {
+    if (!beginGroupChange())
+        return;
+
+    if (m_exclusions.count("angle"))
+        queueExclusionPatch(tags.tag[0], tags.tag[2], added);
+    }
+
+/*! \param tags Tags of the dihedral members
+    \param added True if the dihedral was added, false if it was removed
+*/
+void NeighborList::slotDihedralChange(const DihedralData::members_t& tags, bool added)
+    {
+    if (!beginGroupChange())
+        return;
+
+    if (m_exclusions.count("dihedral"))
+        queueExclusionPatch(tags.tag[0], tags.tag[3], added);
+    }
+
+/*! \param tags Tags of the improper members
+    \param added True if the improper was added, false if it was removed
+
+    Impropers do not define exclusions.
+*/
+void NeighborList::slotImproperChange(const ImproperData::members_t& tags, bool added)
+    {
+    beginGroupChange();
+    }
+
+/*! \param tags Tags of the constraint members
+    \param added True if the constraint was added, false if it was removed
+*/
+void NeighborList::slotConstraintChange(const ConstraintData::members_t& tags, bool added)
+    {
+    if (!beginGroupChange())
+        return;
+
+    if (m_exclusions.count("constraint"))
+        queueExclusionPatch(tags.tag[0], tags.tag[1], added);
+    }
+
+/*! \param tags Tags of the pair members
+    \param added True if the pair was added, false if it was removed
+*/
+void NeighborList::slotPairChange(const PairData::members_t& tags, bool added)
+    {
+    if (!beginGroupChange())
+        return;
+
+    if (m_exclusions.count("special_pair"))
+        queueExclusionPatch(tags.tag[0], tags.tag[1], added);
+    }
+
+/*! \param tag_a First particle tag in the bond
+    \param tag_b Second particle tag in the bond
+    \param add True if the bond was added, false if it was removed
+
+    Queues one patch for every 1-3 path (angle) and 1-4 path (dihedral) through the bond, counted
+    the same way as addOneThreeExclusionsFromTopology() and addOneFourExclusionsFromTopology() count
+    them, and updates the bond partners.
+*/
+void NeighborList::queueBondPathPatches(unsigned int tag_a, unsigned int tag_b, bool add)
+    {
+    std::vector<unsigned int>& partners_a = m_bond_partners[tag_a];
+    std::vector<unsigned int>& partners_b = m_bond_partners[tag_b];
+
+    // the paths use the partners without the changed bond
+    if (!add)
+        {
+        auto it_a = std::find(partners_a.begin(), partners_a.end(), tag_b);
+        if (it_a != partners_a.end())
+            partners_a.erase(it_a);
+
+        auto it_b = std::find(partners_b.begin(), partners_b.end(), tag_a);
+        if (it_b != partners_b.end())
+            partners_b.erase(it_b);
+        }
+
+    if (m_exclusions.count("1-3"))
+        {
+        // the bond is one of the two bonds of the angle
+        for (unsigned int tag_c : partners_a)
+            if (tag_c != tag_b)
+                queueExclusionPatch(tag_b, tag_c, add);
+
+        for (unsigned int tag_c : partners_b)
+            if (tag_c != tag_a)
+                queueExclusionPatch(tag_a, tag_c, add);
+        }
+
+    if (m_exclusions.count("1-4"))
+        {
+        // the bond is the middle bond of the dihedral
+        for (unsigned int tag_j : partners_a)
+            {
+            if (tag_j == tag_b)
+                continue;
+
+            for (unsigned int tag_k : partners_b)
+                if (tag_k != tag_a && tag_k != tag_j)
+                    queueExclusionPatch(tag_j, tag_k, add);
+            }
+
+        // the bond is an end bond of the dihedral
+        for (unsigned int tag_c : partners_a)
+            {
+            if (tag_c == tag_b)
+                continue;
+
+            for (unsigned int tag_k : m_bond_partners[tag_c])
+                if (tag_k != tag_a && tag_k != tag_b)
+                    queueExclusionPatch(tag_b, tag_k, add);
+            }
+
+        for (unsigned int tag_c : partners_b)
+            {
+            if (tag_c == tag_a)
+                continue;
+
+            for (unsigned int tag_j : m_bond_partners[tag_c])
+                if (tag_j != tag_b && tag_j != tag_a)
+                    queueExclusionPatch(tag_a, tag_j, add);
+            }
+        }
+
+    if (add)
+        {
+        partners_a.push_back(tag_b);
+        partners_b.push_back(tag_a);
+        }
+    }
+
+/*! Adds or removes one reference to every exclusion in m_exclusion_patches in order.
+ */
+void NeighborList::applyExclusionPatches()
+    {
+    for (const exclusion_patch_t& patch : m_exclusion_patches)
+        {
+        if (patch.add)
+            addExclusion(patch.tag1, patch.tag2);
+        else
+            removeExclusion(patch.tag1, patch.tag2);
+        }
+
+    m_exclusion_patches.clear();
+    }
+
 /*! \post No particles are excluded from the neighbor list
  */
 void NeighborList::resizeAndClearExclusions()
@@ -692,6 +1120,7 @@ void NeighborList::resizeAndClearExclusions()
         if (m_ex_list_tag.getPitch() != m_n_ex_tag.getNumElements())
             {
             m_ex_list_tag.resize(m_n_ex_tag.getNumElements(), m_ex_list_tag.getHeight());
+            m_ex_count_tag.resize(m_n_ex_tag.getNumElements(), m_ex_count_tag.getHeight());
             m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(),
                                             (unsigned int)m_ex_list_tag.getHeight());
             }
@@ -703,6 +1132,8 @@ void NeighborList::resizeAndClearExclusions()
     memset(h_n_ex_tag.data, 0, sizeof(unsigned int) * m_n_ex_tag.getNumElements());
     memset(h_n_ex_idx.data, 0, sizeof(unsigned int) * m_n_ex_idx.getNumElements());
     m_exclusions_set = false;
+    m_exclusion_patches.clear();
+    m_bond_partners.clear();
 
     forceUpdate();
     }
@@ -1057,23 +1488,54 @@ bool NeighborList::isExcluded(unsigned int tag1, unsigned int tag2)
     return false;
     }
 
+/*! Collects the bond partners of every particle tag in m_bond_partners. Each bond adds one entry
+    to the partners of both of its particles.
+*/
+void NeighborList::buildBondPartners()
+    {
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+
+    // access bond data by snapshot
+    BondData::Snapshot snapshot;
+    bond_data->takeSnapshot(snapshot);
+
+    // broadcast global bond list
+    std::vector<BondData::members_t> bonds;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        if (m_exec_conf->getRank() == 0)
+            bonds = snapshot.groups;
+
+        bcast(bonds, 0, m_exec_conf->getMPICommunicator());
+        }
+    else
+#endif
+        {
+        bonds = snapshot.groups;
+        }
+
+    m_bond_partners.assign(m_pdata->getRTags().size(), std::vector<unsigned int>());
+    for (const BondData::members_t& bond : bonds)
+        {
+        m_bond_partners[bond.tag[0]].push_back(bond.tag[1]);
+        m_bond_partners[bond.tag[1]].push_back(bond.tag[0]);
+        }
+    }
+
 /*! Add topologically derived exclusions for angles
  *
  * This excludes all non-bonded interactions between all pairs particles
  * that are bonded to the same atom.
- * To make the process quasi-linear scaling with system size we first
- * create a 1-d array the collects the number and index of bond partners.
+ * To make the process linear scaling with system size we first
+ * collect the bond partners of each particle with buildBondPartners().
  */
 void NeighborList::addOneThreeExclusionsFromTopology()
     {
-    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
-    const unsigned int myNAtoms = (unsigned int)m_pdata->getRTags().size();
-    const unsigned int MAXNBONDS
-        = 7
-          + 1; //! assumed maximum number of bonds per atom plus one entry for the number of bonds.
-    const unsigned int nBonds = bond_data->getNGlobal();
+    buildBondPartners();
 
-    if (nBonds == 0)
+    if (m_sysdef->getBondData()->getNGlobal() == 0)
         {
         m_exec_conf->msg->warning()
             << "nlist: No bonds defined while trying to add topology derived 1-3 exclusions"
@@ -1081,65 +1543,19 @@ void NeighborList::addOneThreeExclusionsFromTopology()
         return;
         }
 
-    // build a per atom list with all bonding partners from the list of bonds.
-    unsigned int* localBondList = new unsigned int[MAXNBONDS * myNAtoms];
-    memset((void*)localBondList, 0, sizeof(unsigned int) * MAXNBONDS * myNAtoms);
-
-    for (unsigned int i = 0; i < nBonds; i++)
-        {
-        // loop over all bonds and make a 1D exclusion map
-
-        // FIXME: this will not work when the group tags are not contiguous
-        Bond bondi = bond_data->getGroupByTag(i);
-
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
-
-        // next, increment the number of bonds, and update the tags
-        const unsigned int nBondsA = ++localBondList[tagA * MAXNBONDS];
-        const unsigned int nBondsB = ++localBondList[tagB * MAXNBONDS];
-
-        if (nBondsA >= MAXNBONDS)
-            {
-            m_exec_conf->msg->error()
-                << "nlist: Too many bonds to process exclusions for particle with tag: " << tagA
-                << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS - 1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
-            }
-
-        if (nBondsB >= MAXNBONDS)
-            {
-            m_exec_conf->msg->error()
-                << "nlist: Too many bonds to process exclusions for particle with tag: " << tagB
-                << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS - 1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
-            }
-
-        localBondList[tagA * MAXNBONDS + nBondsA] = tagB;
-        localBondList[tagB * MAXNBONDS + nBondsB] = tagA;
-        }
-
     // now loop over the atoms and build exclusions if we have more than
     // one bonding partner, i.e. we are in the center of an angle.
-    for (unsigned int i = 0; i < myNAtoms; i++)
+    for (const std::vector<unsigned int>& partners : m_bond_partners)
         {
-        // now, loop over all atoms, and find those in the middle of an angle
-        const unsigned int iAtom = i * MAXNBONDS;
-        const unsigned int nBonds = localBondList[iAtom];
-
-        if (nBonds > 1) // need at least two bonds
+        for (unsigned int j = 0; j < partners.size(); ++j)
             {
-            for (unsigned int j = 1; j < nBonds; ++j)
+            for (unsigned int k = j + 1; k < partners.size(); ++k)
                 {
-                for (unsigned int k = j + 1; k <= nBonds; ++k)
-                    addExclusion(localBondList[iAtom + j], localBondList[iAtom + k]);
+                if (partners[j] != partners[k])
+                    addExclusion(partners[j], partners[k]);
                 }
             }
         }
-    // free temp memory
-    delete[] localBondList;
     }
 
 /*! Add topologically derived exclusions for dihedrals
@@ -1147,20 +1563,15 @@ void NeighborList::addOneThreeExclusionsFromTopology()
  * This excludes all non-bonded interactions between all pairs particles
  * that are connected to a common bond.
  *
- * To make the process quasi-linear scaling with system size we first
- * create a 1-d array the collects the number and index of bond partners.
+ * To make the process linear scaling with system size we first
+ * collect the bond partners of each particle with buildBondPartners()
  * and then loop over bonded partners.
  */
 void NeighborList::addOneFourExclusionsFromTopology()
     {
-    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
-    const unsigned int myNAtoms = (unsigned int)m_pdata->getRTags().size();
-    const unsigned int MAXNBONDS
-        = 7
-          + 1; //! assumed maximum number of bonds per atom plus one entry for the number of bonds.
-    const unsigned int nBonds = bond_data->getNGlobal();
+    buildBondPartners();
 
-    if (nBonds == 0)
+    if (m_sysdef->getBondData()->getNGlobal() == 0)
         {
         m_exec_conf->msg->warning()
             << "nlist: No bonds defined while trying to add topology derived 1-4 exclusions"
@@ -1168,72 +1579,30 @@ void NeighborList::addOneFourExclusionsFromTopology()
         return;
         }
 
-    // allocate and clear data.
-    unsigned int* localBondList = new unsigned int[MAXNBONDS * myNAtoms];
-    memset((void*)localBondList, 0, sizeof(unsigned int) * MAXNBONDS * myNAtoms);
-
-    for (unsigned int i = 0; i < nBonds; i++)
+    //  loop over all bonds, each bond appears once as the partner of its lower tag
+    for (unsigned int tagA = 0; tagA < m_bond_partners.size(); tagA++)
         {
-        // loop over all bonds and make a 1D exclusion map
-        Bond bondi = bond_data->getGroupByTag(i);
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
-
-        // next, increment the number of bonds, and update the tags
-        const unsigned int nBondsA = ++localBondList[tagA * MAXNBONDS];
-        const unsigned int nBondsB = ++localBondList[tagB * MAXNBONDS];
-
-        if (nBondsA >= MAXNBONDS)
-            {
-            m_exec_conf->msg->error()
-                << "nlist: Too many bonds to process exclusions for particle with tag: " << tagA
-                << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS - 1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
-            }
-
-        if (nBondsB >= MAXNBONDS)
+        for (unsigned int tagB : m_bond_partners[tagA])
             {
-            m_exec_conf->msg->error()
-                << "nlist: Too many bonds to process exclusions for particle with tag: " << tagB
-                << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS - 1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
-            }
-
-        localBondList[tagA * MAXNBONDS + nBondsA] = tagB;
-        localBondList[tagB * MAXNBONDS + nBondsB] = tagA;
-        }
-
-    //  loop over all bonds
-    for (unsigned int i = 0; i < nBonds; i++)
-        {
-        // FIXME: this will not work when the group tags are not contiguous
-        Bond bondi = bond_data->getGroupByTag(i);
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
-
-        const unsigned int nBondsA = localBondList[tagA * MAXNBONDS];
-        const unsigned int nBondsB = localBondList[tagB * MAXNBONDS];
-
-        for (unsigned int j = 1; j <= nBondsA; j++)
-            {
-            const unsigned int tagJ = localBondList[tagA * MAXNBONDS + j];
-            if (tagJ == tagB) // skip the bond in the middle of the dihedral
+            if (tagB < tagA)
                 continue;
 
-            for (unsigned int k = 1; k <= nBondsB; k++)
+            for (unsigned int tagJ : m_bond_partners[tagA])
                 {
-                const unsigned int tagK = localBondList[tagB * MAXNBONDS + k];
-                if (tagK == tagA) // skip the bond in the middle of the dihedral
+                if (tagJ == tagB) // skip the bond in the middle of the dihedral
                     continue;
 
-                addExclusion(tagJ, tagK);
+                for (unsigned int tagK : m_bond_partners[tagB])
+                    {
+                    // skip the bond in the middle of the dihedral and rings of three
+                    if (tagK == tagA || tagK == tagJ)
+                        continue;
+
+                    addExclusion(tagJ, tagK);
+                    }
                 }
             }
         }
-    // free temp memory
-    delete[] localBondList;
     }
 
 /*! \returns true If any of the particles have been moved more than 1/2 of the buffer distance since
@@ -1259,14 +1628,8 @@ bool NeighborList::distanceCheck(uint64_t timestep)
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
-
-    // get current nearest plane distances
-    Scalar3 L_g = m_pdata->getGlobalBox().getNearestPlaneDistance();
-
-    // Find direction of maximum box length contraction (smallest eigenvalue of deformation tensor)
-    Scalar3 lambda = L_g / m_last_L;
-    Scalar lambda_min = (lambda.x < lambda.y) ? lambda.x : lambda.y;
-    lambda_min = (lambda_min < lambda.z) ? lambda_min : (Scalar)lambda.z;
+    BoxDim last_box, global_box;
+    Scalar lambda_min = computeAffineBoxes(last_box, global_box);
 
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
@@ -1285,9 +1648,13 @@ bool NeighborList::distanceCheck(uint64_t timestep)
         const Scalar delta_max = (rmax * lambda_min - old_rmin) / Scalar(2.0);
         Scalar maxsq = (delta_max > 0) ? delta_max * delta_max : 0;
 
-        Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x * h_last_pos.data[i].x,
-                                  h_pos.data[i].y - lambda.y * h_last_pos.data[i].y,
-                                  h_pos.data[i].z - lambda.z * h_last_pos.data[i].z);
+        // map the last position affinely into the current box, so that homogeneous dilations and
+        // shears of the box do not count as displacements
+        Scalar3 last_pos = make_scalar3(h_last_pos.data[i].x,
+                                        h_last_pos.data[i].y,
+                                        h_last_pos.data[i].z);
+        last_pos = global_box.makeCoordinates(last_box.makeFraction(last_pos));
+        Scalar3 dx = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z) - last_pos;
 
         dx = box.minImage(dx);
 
@@ -1325,6 +1692,47 @@ bool NeighborList::distanceCheck(uint64_t timestep)
     return result;
     }
 
+/*! \param last_box Set to the global box at the last update
+    \param cur_box Set to the current global box
+    \returns The smallest contraction of the affine deformation from \a last_box to \a cur_box
+
+    The Lees-Edwards offsets are folded into the xy tilt factors of both boxes. Remapping the tilt
+    and wrapping the offset change the xy element of the box matrix by multiples of L_x without
+    moving the particles, so the change of the xy element is reduced to the nearest image and
+    does not count as a displacement. The shear contracts separations by up to the change of the
+    xy tilt, in addition to the contraction of the nearest plane distances.
+*/
+Scalar NeighborList::computeAffineBoxes(BoxDim& last_box, BoxDim& cur_box)
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 L = global_box.getL();
+    const Scalar3 last_L = m_last_box.getL();
+
+    Scalar last_h_xy = m_last_box.getTiltFactorXY() * last_L.y + m_last_box.getLeesEdwardsOffset();
+    Scalar h_xy = global_box.getTiltFactorXY() * L.y + global_box.getLeesEdwardsOffset();
+    Scalar delta_h_xy = h_xy - last_h_xy;
+    delta_h_xy -= L.x * std::round(delta_h_xy / L.x);
+
+    last_box = m_last_box;
+    last_box.setTiltFactors(last_h_xy / last_L.y,
+                            m_last_box.getTiltFactorXZ(),
+                            m_last_box.getTiltFactorYZ());
+    last_box.setLeesEdwardsOffset(Scalar(0.0));
+
+    cur_box = global_box;
+    cur_box.setTiltFactors((last_h_xy + delta_h_xy) / L.y,
+                           global_box.getTiltFactorXZ(),
+                           global_box.getTiltFactorYZ());
+    cur_box.setLeesEdwardsOffset(Scalar(0.0));
+
+    // Find direction of maximum box length contraction (smallest eigenvalue of deformation tensor)
+    Scalar3 lambda = global_box.getNearestPlaneDistance() / m_last_L;
+    Scalar lambda_min = (lambda.x < lambda.y) ? lambda.x : lambda.y;
+    lambda_min = (lambda_min < lambda.z) ? lambda_min : (Scalar)lambda.z;
+
+    return lambda_min - std::fabs(delta_h_xy) / L.y;
+    }
+
 /*! Copies the current positions of all particles over to m_last_x etc...
  */
 void NeighborList::setLastUpdatedPos()
@@ -1349,6 +1757,7 @@ void NeighborList::setLastUpdatedPos()
     // update last box nearest plane distance
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
+    m_last_box = m_pdata->getGlobalBox();
 
     if (m_prof)
         m_prof->pop();
@@ -1488,7 +1897,8 @@ void NeighborList::buildNlist(uint64_t timestep)
     }
 
 /*! Translates the exclusions set in \c m_n_ex_tag and \c m_ex_list_tag to indices in \c m_n_ex_idx
- * and \c m_ex_list_idx
+ * and \c m_ex_list_idx. Also encodes the exclusion masks in \c m_ex_mask_idx and sets
+ * \c m_n_ex_filter_idx to the number of exclusions of the particles that have no mask.
  */
 void NeighborList::updateExListIdx()
     {
@@ -1509,6 +1919,12 @@ void NeighborList::updateExListIdx()
     ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
                                             access_location::host,
                                             access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_mask_idx(m_ex_mask_idx,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> h_n_ex_filter_idx(m_n_ex_filter_idx,
+                                                access_location::host,
+                                                access_mode::overwrite);
 
     // translate the number and exclusions from one array to the other
     for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
@@ -1521,6 +1937,8 @@ void NeighborList::updateExListIdx()
         h_n_ex_idx.data[idx] = n;
 
         // construct the exclusion list
+        unsigned int mask = 0;
+        bool maskable = true;
         for (unsigned int offset = 0; offset < n; offset++)
             {
             unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag, offset)];
@@ -1528,7 +1946,17 @@ void NeighborList::updateExListIdx()
 
             // store excluded particle idx
             h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
+
+            unsigned int bit = nlist_ex_mask_bit((int)ex_tag - (int)tag);
+            if (bit < 32)
+                mask |= 1u << bit;
+            else
+                maskable = false;
             }
+
+        // particles with exclusions outside of the mask range are filtered
+        h_ex_mask_idx.data[idx] = maskable ? mask : 0;
+        h_n_ex_filter_idx.data[idx] = maskable ? 0 : n;
         }
 
     if (m_prof)
@@ -1544,7 +1972,10 @@ void NeighborList::filterNlist()
 
     // access data
     ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    // with masks, only the rows of the particles without a mask are filtered
+    ArrayHandle<unsigned int> h_n_ex_idx(m_ex_masks_used ? m_n_ex_filter_idx : m_n_ex_idx,
+                                         access_location::host,
+                                         access_mode::read);
     ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
                                             access_location::host,
                                             access_mode::read);
@@ -1656,6 +2087,279 @@ void NeighborList::resizeNlist(size_t size)
         }
     }
 
+/*!
+ * \param size Number of bytes required by the compressed neighbor list
+ */
+void NeighborList::resizeCompressedNlist(size_t size)
+    {
+    if (size > m_compressed_nlist.getNumElements())
+        {
+        m_exec_conf->msg->notice(6) << "nlist: (Re-)allocating compressed neighbor list, new size "
+                                    << size << " bytes" << endl;
+
+        size_t alloc_size
+            = m_compressed_nlist.getNumElements() ? m_compressed_nlist.getNumElements() : 1;
+
+        while (size > alloc_size)
+            {
+            alloc_size = ((size_t)(((float)alloc_size) * 1.125f)) + 1;
+            }
+
+        // round up to nearest multiple of 4
+        alloc_size = (alloc_size > 4) ? (alloc_size + 3) & ~3 : 4;
+
+        GlobalArray<unsigned char> compressed_nlist(alloc_size, m_exec_conf);
+        m_compressed_nlist.swap(compressed_nlist);
+        TAG_ALLOCATION(m_compressed_nlist);
+        }
+    }
+
+/*!
+ * The radius of the shell of consumer c for particles of type i is the largest r_cut(i,j) of the
+ * consumer's matrix plus the buffer (and the diameter shift). For each type, the shells are
+ * stored in increasing order of their radius in m_shell_rlistsq, and m_shell_order holds the
+ * consumer of each shell.
+ */
+void NeighborList::updateShells()
+    {
+    const unsigned int n_shells = (unsigned int)m_consumer_r_cut.size();
+    const unsigned int n_types = m_pdata->getNTypes();
+
+    if (m_shell_rlistsq.getNumElements() != n_types * n_shells)
+        {
+        GlobalArray<Scalar> shell_rlistsq(n_types * n_shells, m_exec_conf);
+        m_shell_rlistsq.swap(shell_rlistsq);
+        TAG_ALLOCATION(m_shell_rlistsq);
+
+        GlobalArray<unsigned int> shell_order(n_types * n_shells, m_exec_conf);
+        m_shell_order.swap(shell_order);
+        TAG_ALLOCATION(m_shell_order);
+        }
+
+    const size_t pitch = m_n_neigh.getNumElements();
+    if (m_shell_pitch != pitch || m_shell_n_neigh.getNumElements() != pitch * n_shells)
+        {
+        GlobalArray<unsigned int> shell_n_neigh(pitch * n_shells, m_exec_conf);
+        m_shell_n_neigh.swap(shell_n_neigh);
+        TAG_ALLOCATION(m_shell_n_neigh);
+        m_shell_pitch = pitch;
+        }
+
+    // largest cutoff of each consumer for each type
+    std::vector<Scalar> r_cut_max(n_types * n_shells, Scalar(0.0));
+    for (unsigned int c = 0; c < n_shells; ++c)
+        {
+        ArrayHandle<Scalar> h_r_cut(*m_consumer_r_cut[c], access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < n_types; ++i)
+            {
+            for (unsigned int j = 0; j < n_types; ++j)
+                {
+                r_cut_max[i * n_shells + c]
+                    = std::max(r_cut_max[i * n_shells + c], h_r_cut.data[m_typpair_idx(i, j)]);
+                }
+            }
+        }
+
+    ArrayHandle<Scalar> h_shell_rlistsq(m_shell_rlistsq,
+                                        access_location::host,
+                                        access_mode::overwrite);
+    ArrayHandle<unsigned int> h_shell_order(m_shell_order,
+                                            access_location::host,
+                                            access_mode::overwrite);
+
+    const Scalar shift = m_diameter_shift ? m_d_max - Scalar(1.0) : Scalar(0.0);
+    std::vector<std::pair<Scalar, unsigned int>> shells(n_shells);
+    for (unsigned int i = 0; i < n_types; ++i)
+        {
+        for (unsigned int c = 0; c < n_shells; ++c)
+            {
+            const Scalar r_cut = r_cut_max[i * n_shells + c];
+            const Scalar r_list = (r_cut > Scalar(0.0)) ? r_cut + m_r_buff + shift : Scalar(0.0);
+            shells[c] = std::make_pair(r_list * r_list, c);
+            }
+        std::stable_sort(shells.begin(), shells.end());
+
+        for (unsigned int k = 0; k < n_shells; ++k)
+            {
+            h_shell_rlistsq.data[i * n_shells + k] = shells[k].first;
+            h_shell_order.data[i * n_shells + k] = shells[k].second;
+            }
+        }
+    }
+
+/*!
+ * Each row is partitioned in place, one shell after another, so that the neighbors within the
+ * radius of a shell precede all others. The partition does not preserve the order of the
+ * neighbors, but it only depends on the order produced by the build.
+ */
+void NeighborList::partitionShells()
+    {
+    if (m_prof)
+        m_prof->push("shells");
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_shells = (unsigned int)m_consumer_r_cut.size();
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_shell_rlistsq(m_shell_rlistsq, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_shell_order(m_shell_order,
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> h_shell_n_neigh(m_shell_n_neigh,
+                                              access_location::host,
+                                              access_mode::overwrite);
+
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        const Scalar4 postypei = h_pos.data[i];
+        const Scalar3 pi = make_scalar3(postypei.x, postypei.y, postypei.z);
+        const unsigned int typei = __scalar_as_int(postypei.w);
+        unsigned int* row = h_nlist.data + h_head_list.data[i];
+        const unsigned int n_neigh = h_n_neigh.data[i];
+
+        unsigned int first = 0;
+        for (unsigned int k = 0; k < n_shells; ++k)
+            {
+            const Scalar rlistsq = h_shell_rlistsq.data[typei * n_shells + k];
+            for (unsigned int m = first; m < n_neigh; ++m)
+                {
+                const unsigned int j = row[m];
+                const Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                const Scalar3 dx = box.minImage(pi - pj);
+                if (dot(dx, dx) <= rlistsq)
+                    std::swap(row[first++], row[m]);
+                }
+            h_shell_n_neigh.data[h_shell_order.data[typei * n_shells + k] * m_shell_pitch + i]
+                = first;
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*!
+ * The neighbors of each particle are sorted by index in place, so that the rows in m_nlist match
+ * the compressed rows. Row i of the compressed list starts at byte m_compressed_head_list[i] and
+ * ends at m_compressed_head_list[i + 1].
+ */
+void NeighborList::compressNlist()
+    {
+    if (m_prof)
+        m_prof->push("compress");
+
+    const unsigned int N = m_pdata->getN();
+    if (m_compressed_head_list.getNumElements() < N + 1)
+        {
+        GlobalArray<size_t> compressed_head_list(N + 1, m_exec_conf);
+        m_compressed_head_list.swap(compressed_head_list);
+        TAG_ALLOCATION(m_compressed_head_list);
+        }
+
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+        {
+        ArrayHandle<size_t> h_compressed_head_list(m_compressed_head_list,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+
+        // sort the rows and count their bytes
+        size_t size = 0;
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            unsigned int* row = h_nlist.data + h_head_list.data[i];
+            const unsigned int n_neigh = h_n_neigh.data[i];
+            std::sort(row, row + n_neigh);
+
+            h_compressed_head_list.data[i] = size;
+            unsigned int prev = 0;
+            for (unsigned int k = 0; k < n_neigh; ++k)
+                {
+                size += nlist_compressed_size(row[k] - prev);
+                prev = row[k];
+                }
+            }
+        h_compressed_head_list.data[N] = size;
+
+        resizeCompressedNlist(size);
+        }
+
+    ArrayHandle<size_t> h_compressed_head_list(m_compressed_head_list,
+                                               access_location::host,
+                                               access_mode::read);
+    ArrayHandle<unsigned char> h_compressed_nlist(m_compressed_nlist,
+                                                  access_location::host,
+                                                  access_mode::overwrite);
+
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        const unsigned int* row = h_nlist.data + h_head_list.data[i];
+        unsigned char* p = h_compressed_nlist.data + h_compressed_head_list.data[i];
+        unsigned int prev = 0;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; ++k)
+            {
+            nlist_compressed_write(p, row[k] - prev);
+            prev = row[k];
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*!
+ * Particles whose neighbors are all local are placed at the front of m_ghost_partition and those
+ * with at least one ghost neighbor at the back, each in increasing index order.
+ */
+void NeighborList::buildGhostPartition()
+    {
+    const unsigned int N = m_pdata->getN();
+    if (m_ghost_partition.getNumElements() < N)
+        {
+        GlobalArray<unsigned int> ghost_partition(N, m_exec_conf);
+        m_ghost_partition.swap(ghost_partition);
+        TAG_ALLOCATION(m_ghost_partition);
+        }
+
+    ArrayHandle<unsigned int> h_ghost_partition(m_ghost_partition,
+                                                access_location::host,
+                                                access_mode::overwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+    unsigned int n_interior = 0;
+    unsigned int n_boundary = 0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const unsigned int head_i = h_head_list.data[i];
+        bool has_ghost = false;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            if (h_nlist.data[head_i + k] >= N)
+                {
+                has_ghost = true;
+                break;
+                }
+            }
+
+        if (has_ghost)
+            h_ghost_partition.data[N - 1 - n_boundary++] = i;
+        else
+            h_ghost_partition.data[n_interior++] = i;
+        }
+
+    // the boundary particles were filled in from the back
+    std::reverse(h_ghost_partition.data + n_interior, h_ghost_partition.data + N);
+    m_n_interior = n_interior;
+    }
+
 /*!
  * \returns true if an overflow is detected for any particle type
  * \returns false if all particle types have enough memory for their neighbors
@@ -1694,6 +2398,7 @@ void NeighborList::growExclusionList()
     unsigned int new_height = m_ex_list_indexer.getH() + 1;
 
     m_ex_list_tag.resize(m_pdata->getRTags().size(), new_height);
+    m_ex_count_tag.resize(m_pdata->getRTags().size(), new_height);
     m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
 
     // update the indexers
@@ -1811,6 +2516,10 @@ void export_NeighborList(py::module& m)
                       &NeighborList::setRebuildCheckDelay)
         .def_property("check_dist", &NeighborList::getDistCheck, &NeighborList::setDistCheck)
         .def("setStorageMode", &NeighborList::setStorageMode)
+        .def_property("compressed", &NeighborList::getCompressed, &NeighborList::setCompressed)
+        .def_property("mask_exclusions",
+                      &NeighborList::getMaskExclusions,
+                      &NeighborList::setMaskExclusions)
         .def_property("exclusions", &NeighborList::getExclusions, &NeighborList::setExclusions)
         .def_property("diameter_shift",
                       &NeighborList::getDiameterShift,
@@ -1818,6 +2527,7 @@ void export_NeighborList(py::module& m)
         .def_property("max_diameter",
                       &NeighborList::getMaximumDiameter,
                       &NeighborList::setMaximumDiameter)
+        .def("setBenchmarkRCut", &NeighborList::setBenchmarkRCut)
         .def("getMaxRCut", &NeighborList::getMaxRCut)
         .def("getMinRCut", &NeighborList::getMinRCut)
         .def("getMaxRList", &NeighborList::getMaxRList)
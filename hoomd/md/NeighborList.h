@@ -8,6 +8,7 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/PythonLocalDataAccess.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
@@ -104,6 +105,12 @@
    removes any particles that are excluded. This allows an arbitrary number of exclusions to be
    processed without slowing the performance of the buildNlist() step itself.
 
+    Each exclusion counts how many times it has been added (\a ex_count), so removeExclusion() only
+   allows the pair when every source of the exclusion is gone. When a single bond, angle, dihedral,
+   constraint, or pair is added or removed, the exclusions of that group (including 1-3 and 1-4
+   exclusions derived from a bond) are queued and applied in the next compute() by
+   applyExclusionPatches() instead of rebuilding all exclusions.
+
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition
    is stored in the GlobalArray \a d_conditions.
@@ -139,6 +146,8 @@ class PYBIND11_EXPORT NeighborList : public Compute
     /** Add a r_cut matrix
 
     @param r_cut_matrix Matrix to add
+    @param evaluates_ex_masks Set to true when the consumer skips the pairs flagged by
+        getExMaskArray() itself, see setMaskExclusions()
 
     NeighborList consumers must provide a per type pair r_cut matrix to the neighbor list so
     that when one consumer changes a r_cut value, NeighborList can compute the needed minimum
@@ -147,7 +156,8 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Consumers should call notifyRCutMatrixChange() when they any element of of their matrix.
     They should call removeRCutMatrix() when they no longer need to use the neighbor list.
     */
-    void addRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
+    void addRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix,
+                       bool evaluates_ex_masks = false)
         {
         if (r_cut_matrix->getNumElements() != m_r_cut.getNumElements())
             {
@@ -155,6 +165,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
             }
 
         m_consumer_r_cut.push_back(r_cut_matrix);
+        m_consumer_ex_mask.push_back(evaluates_ex_masks);
         notifyRCutMatrixChange();
         forceUpdate();
         }
@@ -180,7 +191,31 @@ class PYBIND11_EXPORT NeighborList : public Compute
             {
             throw std::invalid_argument("r_cut_matrix not found in neighbor list");
             }
+        m_consumer_ex_mask.erase(m_consumer_ex_mask.begin() + (p - m_consumer_r_cut.begin()));
         m_consumer_r_cut.erase(p);
+        m_shells_valid = false;
+        forceUpdate();
+        }
+
+    /** Set whether the consumer of a r_cut matrix evaluates the exclusion masks
+
+    @param r_cut_matrix Matrix the consumer added with addRCutMatrix()
+    @param evaluates_ex_masks Set to true when the consumer skips the pairs flagged by
+        getExMaskArray() itself
+
+    Subclasses of consumers that read the neighbor list differently than their base class use this
+    to change the value given to addRCutMatrix().
+    */
+    void setEvaluatesExclusionMasks(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix,
+                                    bool evaluates_ex_masks)
+        {
+        auto p = std::find(m_consumer_r_cut.begin(), m_consumer_r_cut.end(), r_cut_matrix);
+        if (p == m_consumer_r_cut.end())
+            {
+            throw std::invalid_argument("r_cut_matrix not found in neighbor list");
+            }
+        m_consumer_ex_mask[p - m_consumer_r_cut.begin()] = evaluates_ex_masks;
+        forceUpdate();
         }
 
     //! Change the global buffer radius
@@ -226,10 +261,60 @@ class PYBIND11_EXPORT NeighborList : public Compute
         forceUpdate();
         }
 
+    //! Enable or disable the compressed copy of the neighbor list
+    /*! \param compressed Set to true to also store the list in compressed rows
+
+        When enabled, every build sorts the neighbors of each particle and encodes them into
+        getCompressedNListArray(). Consumers that support it read the compressed rows instead of
+        getNListArray().
+    */
+    void setCompressed(bool compressed)
+        {
+        m_compressed = compressed;
+        forceUpdate();
+        }
+
+    //! Enable or disable the exclusion masks
+    /*! \param mask_exclusions Set to true to leave excluded pairs in the list and flag them in
+        getExMaskArray()
+
+        filterNlist() removes the excluded pairs from every row, which costs a pass over the list
+        for each particle with exclusions. When enabled, the exclusions of particle i whose tags are
+        within NLIST_EX_MASK_RANGE of the tag of i are encoded as a bit mask instead, and only
+        the rows of particles with other exclusions are filtered. The masks are only used when all
+        consumers registered with \a evaluates_ex_masks, see getExclusionMasksUsed().
+    */
+    void setMaskExclusions(bool mask_exclusions)
+        {
+        m_mask_exclusions = mask_exclusions;
+        forceUpdate();
+        }
+
     // @}
     //! \name Get properties
     // @{
 
+    //! Test if the compressed neighbor list is enabled
+    bool getCompressed()
+        {
+        return m_compressed;
+        }
+
+    //! Test if the exclusion masks are enabled
+    bool getMaskExclusions()
+        {
+        return m_mask_exclusions;
+        }
+
+    //! Test if the last build left masked exclusions in the list
+    /*! When true, consumers must skip the pairs i,j where nlist_ex_mask_excluded() is true for
+        the mask of i in getExMaskArray().
+    */
+    bool getExclusionMasksUsed()
+        {
+        return m_ex_masks_used;
+        }
+
     //! Get the storage mode
     storageMode getStorageMode()
         {
@@ -291,23 +376,72 @@ class PYBIND11_EXPORT NeighborList : public Compute
     // @{
 
     //! Get the number of neighbors array
-    const GlobalArray<unsigned int>& getNNeighArray()
+    const GlobalArray<unsigned int>& getNNeighArray() const
         {
         return m_n_neigh;
         }
 
     //! Get the neighbor list
-    const GlobalArray<unsigned int>& getNListArray()
+    const GlobalArray<unsigned int>& getNListArray() const
         {
         return m_nlist;
         }
 
     //! Get the head list
-    const GlobalArray<unsigned int>& getHeadList()
+    const GlobalArray<unsigned int>& getHeadList() const
         {
         return m_head_list;
         }
 
+    //! Get the compressed neighbor list (see NeighborListCompression.h)
+    const GlobalArray<unsigned char>& getCompressedNListArray()
+        {
+        return m_compressed_nlist;
+        }
+
+    //! Get the byte offset of each particle's row in the compressed neighbor list
+    const GlobalArray<size_t>& getCompressedHeadList()
+        {
+        return m_compressed_head_list;
+        }
+
+    //! Get the cutoff shell of a neighbor list consumer
+    /*! \param r_cut_matrix r_cut matrix the consumer added with addRCutMatrix()
+        \returns The row of getShellNNeighArray() that holds the number of neighbors of each
+                 particle within the cutoff of the consumer, or -1 when the rows of the neighbor
+                 list are not partitioned into shells.
+
+        When more than one consumer shares the neighbor list, each row of the list is partitioned
+        into nested cutoff shells at every build. The neighbors that a consumer needs are a prefix
+        of the row, so consumers with a short cutoff iterate only over the first entries. Call
+        getShell() after compute().
+    */
+    int getShell(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
+        {
+        if (!m_shells_valid)
+            return -1;
+
+        auto p = std::find(m_consumer_r_cut.begin(), m_consumer_r_cut.end(), r_cut_matrix);
+        if (p == m_consumer_r_cut.end())
+            return -1;
+        return int(p - m_consumer_r_cut.begin());
+        }
+
+    //! Get the number of neighbors of each particle within each cutoff shell
+    /*! Element shell * getShellPitch() + i is the length of the prefix of row i that holds the
+        neighbors of particle i for the consumer in \a shell (see getShell()).
+    */
+    const GlobalArray<unsigned int>& getShellNNeighArray()
+        {
+        return m_shell_n_neigh;
+        }
+
+    //! Get the pitch of the rows of getShellNNeighArray()
+    size_t getShellPitch()
+        {
+        return m_shell_pitch;
+        }
+
     //! Get the number of exclusions array
     const GlobalArray<unsigned int>& getNExArray()
         {
@@ -320,6 +454,14 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_ex_list_idx;
         }
 
+    //! Get the exclusion masks by particle index
+    /*! \note The masks are 0 for the particles whose exclusions are filtered from the list.
+     */
+    const GlobalArray<unsigned int>& getExMaskArray()
+        {
+        return m_ex_mask_idx;
+        }
+
     //! Get the neighbor list indexer
     /*! \note Do not save indexers across calls. Get a new indexer after every call to compute() -
        they will change.
@@ -346,6 +488,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Exclude a pair of particles from being added to the neighbor list
     void addExclusion(unsigned int tag1, unsigned int tag2);
 
+    //! Remove one reference to an exclusion, allow the pair once no reference remains
+    void removeExclusion(unsigned int tag1, unsigned int tag2);
+
     //! Enable/disable body filtering
     virtual void setFilterBody(bool filter_body)
         {
@@ -448,6 +593,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Benchmark the neighbor list
     virtual double benchmark(unsigned int num_iters);
 
+    //! Set the r_cut matrix to benchmark with before any consumer adds one
+    void setBenchmarkRCut(pybind11::list r_cut);
+
     //! Forces a full update of the list on the next call to compute()
     void forceUpdate()
         {
@@ -488,6 +636,25 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_typpair_idx;
         }
 
+    //! Get the local particle indices ordered with the particles that have no ghost neighbors first
+    /*! The first getNInteriorParticles() entries are the particles with only local neighbors, the
+        remaining getPdata()->getN() - getNInteriorParticles() entries have at least one ghost
+        neighbor. Both parts are in increasing index order. The partition is rebuilt on demand
+        after each build of the neighbor list, call it after compute().
+    */
+    const GlobalArray<unsigned int>& getGhostPartition()
+        {
+        updateGhostPartition();
+        return m_ghost_partition;
+        }
+
+    //! Get the number of local particles that have no ghost neighbors
+    unsigned int getNInteriorParticles()
+        {
+        updateGhostPartition();
+        return m_n_interior;
+        }
+
     protected:
     Index2D m_typpair_idx;          //!< Indexer for full type pair storage
     GlobalArray<Scalar> m_r_cut;    //!< The potential cutoffs stored by pair type
@@ -497,6 +664,12 @@ class PYBIND11_EXPORT NeighborList : public Compute
     /// List of r_cut matrices from neighborlist consumers
     std::vector<std::shared_ptr<GlobalArray<Scalar>>> m_consumer_r_cut;
 
+    /// True for each consumer in m_consumer_r_cut that evaluates the exclusion masks
+    std::vector<bool> m_consumer_ex_mask;
+
+    /// r_cut matrix set by setBenchmarkRCut()
+    std::shared_ptr<GlobalArray<Scalar>> m_benchmark_r_cut;
+
     Scalar m_rcut_max_max; //!< The maximum cutoff radius of any pair
     Scalar m_rcut_min;     //!< The smallest cutoff radius of any pair (that is > 0)
     Scalar m_r_buff;       //!< The buffer around the cutoff
@@ -510,6 +683,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     GlobalArray<Scalar4> m_last_pos;     //!< coordinates of last updated particle positions
     Scalar3 m_last_L;                    //!< Box lengths at last update
     Scalar3 m_last_L_local;              //!< Local Box lengths at last update
+    BoxDim m_last_box;                   //!< Global box at last update
 
     GlobalArray<unsigned int> m_head_list; //!< Indexes for particles to read from the neighbor list
     GlobalArray<unsigned int>
@@ -517,6 +691,16 @@ class PYBIND11_EXPORT NeighborList : public Compute
     GlobalArray<unsigned int>
         m_conditions; //!< Holds the max number of computed particles by type for resizing
 
+    bool m_compressed = false;                     //!< True if the compressed rows are built
+    GlobalArray<unsigned char> m_compressed_nlist; //!< Compressed neighbor list data
+    GlobalArray<size_t> m_compressed_head_list;    //!< Byte offsets into m_compressed_nlist
+
+    bool m_shells_valid = false;               //!< True if the rows are partitioned into shells
+    GlobalArray<unsigned int> m_shell_n_neigh; //!< Number of neighbors within each shell
+    size_t m_shell_pitch = 0;                  //!< Pitch of the rows of m_shell_n_neigh
+    GlobalArray<Scalar> m_shell_rlistsq;       //!< Squared shell radii by type, in increasing order
+    GlobalArray<unsigned int> m_shell_order;   //!< Consumer of each shell in m_shell_rlistsq
+
     GlobalArray<unsigned int> m_ex_list_tag; //!< List of excluded particles referenced by tag
     GlobalArray<unsigned int> m_ex_list_idx; //!< List of excluded particles referenced by index
     GlobalVector<unsigned int> m_n_ex_tag;   //!< Number of exclusions for a given particle tag
@@ -525,12 +709,46 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Index2D m_ex_list_indexer_tag;           //!< Indexer for accessing the by-tag exclusion list
     bool m_exclusions_set;                   //!< True if any exclusions have been set
 
+    bool m_mask_exclusions = false;              //!< True if exclusions may be masked
+    bool m_ex_masks_used = false;                //!< True if the last build masked the exclusions
+    GlobalArray<unsigned int> m_ex_mask_idx;     //!< Exclusion mask for a given particle index
+    GlobalArray<unsigned int> m_n_ex_filter_idx; //!< Exclusions to filter for a particle index
+
+    /// Number of references to each exclusion in m_ex_list_tag
+    GlobalArray<unsigned int> m_ex_count_tag;
+
     /// True if the number of particles has changed.
     bool m_n_particles_changed = false;
 
     /// True if the number of bonds/angles/dihedrals/impropers/pairs has changed.
     bool m_topology_changed = false;
 
+    /// True when the next group number change has already been applied to the exclusions.
+    bool m_skip_topology_change = false;
+
+    /// Exclusion added or removed by a single group change
+    struct exclusion_patch_t
+        {
+        unsigned int tag1; //!< First particle tag
+        unsigned int tag2; //!< Second particle tag
+        bool add;          //!< True to add a reference, false to remove one
+        };
+
+    /// Exclusion patches queued since the last compute()
+    std::vector<exclusion_patch_t> m_exclusion_patches;
+
+    /// Bond partners of each particle tag, kept while 1-3 or 1-4 exclusions are set
+    std::vector<std::vector<unsigned int>> m_bond_partners;
+
+    /// Local particle indices, those without ghost neighbors first (see getGhostPartition())
+    GlobalArray<unsigned int> m_ghost_partition;
+
+    /// Number of local particles without ghost neighbors
+    unsigned int m_n_interior = 0;
+
+    /// True when m_ghost_partition matches the current neighbor list
+    bool m_ghost_partition_valid = false;
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
@@ -542,6 +760,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Performs the distance check
     virtual bool distanceCheck(uint64_t timestep);
 
+    //! Compute the boxes that map the last positions affinely into the current box
+    Scalar computeAffineBoxes(BoxDim& last_box, BoxDim& cur_box);
+
     //! Updates the previous position table for use in the next distance check
     virtual void setLastUpdatedPos();
 
@@ -551,6 +772,12 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Updates the idx exclusion list
     virtual void updateExListIdx();
 
+    //! Apply the queued exclusion patches to the by-tag exclusion list
+    virtual void applyExclusionPatches();
+
+    //! Grow the exclusions list memory capacity by one row
+    void growExclusionList();
+
     //! Loops through all pairs, and updates the r_list(i,j)
     void updateRList();
 
@@ -560,12 +787,46 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Test if the build can leave masked exclusions in the list
+    /*! Subclasses whose consumers read the list in a way that cannot evaluate the masks (e.g. a
+        precomputed pair mask) return false.
+    */
+    virtual bool supportsExclusionMasks()
+        {
+        return true;
+        }
+
     //! Build the head list to allocated memory
     virtual void buildHeadList();
 
+    //! Sort the rows of the neighbor list and encode them into m_compressed_nlist
+    virtual void compressNlist();
+
+    //! Amortized resizing of the compressed neighbor list
+    void resizeCompressedNlist(size_t size);
+
+    //! Compute the shell radii of the consumers and allocate the shell arrays
+    void updateShells();
+
+    //! Partition the rows of the neighbor list into the cutoff shells of the consumers
+    virtual void partitionShells();
+
     //! Amortized resizing of the neighborlist
     void resizeNlist(size_t size);
 
+    //! Partition the local particles by whether they have ghost neighbors
+    virtual void buildGhostPartition();
+
+    //! Rebuild the ghost partition if the neighbor list changed
+    void updateGhostPartition()
+        {
+        if (!m_ghost_partition_valid)
+            {
+            buildGhostPartition();
+            m_ghost_partition_valid = true;
+            }
+        }
+
 #ifdef ENABLE_MPI
     CommFlags getRequestedCommFlags(uint64_t timestep)
         {
@@ -628,9 +889,6 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Resets the condition status to all zeroes
     virtual void resetConditions();
 
-    //! Grow the exclusions list memory capacity by one row
-    void growExclusionList();
-
     //! Method to be called when the global particle number changes
     void slotGlobalParticleNumberChange()
         {
@@ -640,9 +898,45 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Method to be called when the global bond/angle/dihedral/improper/pair number changes
     void slotGlobalTopologyNumberChange()
         {
+        if (m_skip_topology_change)
+            {
+            m_skip_topology_change = false;
+            return;
+            }
+
         m_topology_changed = true;
         }
 
+    //! Start an incremental update of the exclusions for a single group change
+    bool beginGroupChange();
+
+    //! Queue an exclusion patch for the next compute()
+    void queueExclusionPatch(unsigned int tag1, unsigned int tag2, bool add);
+
+    //! Method to be called when a single bond is added or removed
+    void slotBondChange(const BondData::members_t& tags, bool added);
+
+    //! Method to be called when a single angle is added or removed
+    void slotAngleChange(const AngleData::members_t& tags, bool added);
+
+    //! Method to be called when a single dihedral is added or removed
+    void slotDihedralChange(const DihedralData::members_t& tags, bool added);
+
+    //! Method to be called when a single improper is added or removed
+    void slotImproperChange(const ImproperData::members_t& tags, bool added);
+
+    //! Method to be called when a single constraint is added or removed
+    void slotConstraintChange(const ConstraintData::members_t& tags, bool added);
+
+    //! Method to be called when a single special pair is added or removed
+    void slotPairChange(const PairData::members_t& tags, bool added);
+
+    //! Build the bond partners of each particle tag
+    void buildBondPartners();
+
+    //! Queue the 1-3 and 1-4 exclusion patches of a single bond
+    void queueBondPathPatches(unsigned int tag_a, unsigned int tag_b, bool add);
+
     //! Clear all existing exclusions
     void resizeAndClearExclusions();
 
@@ -678,4 +972,81 @@ class PYBIND11_EXPORT NeighborList : public Compute
 //! Exports NeighborList to python
 void export_NeighborList(pybind11::module& m);
 
+//! Python access to the neighbor list arrays
+/*! Exposes the head list, the number of neighbors, and the neighbor list of the local particles
+    through HOOMDHostBuffer or HOOMDDeviceBuffer objects. The arrays are read only and hold the list
+    from the last build. Buffers support the buffer protocol or the __cuda_array_interface__, and
+    DLPack, so machine learning frameworks can read the list without a copy.
+*/
+template<class Output>
+class PYBIND11_EXPORT LocalNeighborListData : public LocalDataAccess<Output, NeighborList>
+    {
+    public:
+    LocalNeighborListData(NeighborList& data, std::shared_ptr<ParticleData> pdata)
+        : LocalDataAccess<Output, NeighborList>(data), m_nlist(data), m_pdata(pdata),
+          m_head_list_handle(), m_n_neigh_handle(), m_nlist_handle()
+        {
+        }
+
+    virtual ~LocalNeighborListData() = default;
+
+    Output getHeadList()
+        {
+        return this->template getBufferExplicit<unsigned int>(m_head_list_handle,
+                                                              &NeighborList::getHeadList,
+                                                              m_pdata->getN());
+        }
+
+    Output getNNeigh()
+        {
+        return this->template getBufferExplicit<unsigned int>(m_n_neigh_handle,
+                                                              &NeighborList::getNNeighArray,
+                                                              m_pdata->getN());
+        }
+
+    Output getNList()
+        {
+        return this->template getBufferExplicit<unsigned int>(
+            m_nlist_handle,
+            &NeighborList::getNListArray,
+            m_nlist.getNListArray().getNumElements());
+        }
+
+    bool isHalfNlist()
+        {
+        return m_nlist.getStorageMode() == NeighborList::half;
+        }
+
+    protected:
+    void clear()
+        {
+        m_head_list_handle.reset(nullptr);
+        m_n_neigh_handle.reset(nullptr);
+        m_nlist_handle.reset(nullptr);
+        }
+
+    private:
+    NeighborList& m_nlist;                 //!< Neighbor list to expose
+    std::shared_ptr<ParticleData> m_pdata; //!< Particle data, for the number of local particles
+
+    std::unique_ptr<ArrayHandle<unsigned int>> m_head_list_handle; //!< Handle to the head list
+    std::unique_ptr<ArrayHandle<unsigned int>> m_n_neigh_handle;   //!< Handle to the neighbor count
+    std::unique_ptr<ArrayHandle<unsigned int>> m_nlist_handle;     //!< Handle to the neighbor list
+    };
+
+//! Exports LocalNeighborListData to python
+template<class Output>
+void export_LocalNeighborListData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalNeighborListData<Output>,
+                     std::shared_ptr<LocalNeighborListData<Output>>>(m, name.c_str())
+        .def(pybind11::init<NeighborList&, std::shared_ptr<ParticleData>>())
+        .def("getHeadList", &LocalNeighborListData<Output>::getHeadList)
+        .def("getNNeigh", &LocalNeighborListData<Output>::getNNeigh)
+        .def("getNList", &LocalNeighborListData<Output>::getNList)
+        .def("isHalfNlist", &LocalNeighborListData<Output>::isHalfNlist)
+        .def("enter", &LocalNeighborListData<Output>::enter)
+        .def("exit", &LocalNeighborListData<Output>::exit);
+    }
+
 #endif
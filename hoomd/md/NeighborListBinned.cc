@@ -13,6 +13,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -47,6 +53,12 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
 
     m_cl->compute(timestep);
 
+    // visit only the interacting types of each cell when some type pairs do not interact
+    const bool by_type = findInteractingTypes();
+    if (by_type)
+        sortCellsByType();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
     uint3 dim = m_cl->getDim();
     Scalar3 ghost_width = m_cl->getGhostWidth();
 
@@ -99,7 +111,20 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+#ifdef ENABLE_TBB
+    // the neighbor rows are independent, only the overflow conditions are shared between particles
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(
+        std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+
+    m_exec_conf->getTaskArena()->execute([&] {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    unsigned int* conditions = thread_conditions.local().data();
+    for (unsigned int i = r.begin(); i != r.end(); i++)
+#else
+    unsigned int* conditions = h_conditions.data;
+    for (unsigned int i = 0; i < nparticles; i++)
+#endif
         {
         unsigned int cur_n_neigh = 0;
 
@@ -111,6 +136,12 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
 
+        if (by_type && m_interacting_types[type_i].empty())
+            {
+            h_n_neigh.data[i] = 0;
+            continue;
+            }
+
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos, ghost_width);
         int ib = (unsigned int)(f.x * dim.x);
@@ -133,60 +164,75 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
             {
             unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
 
-            // check against all the particles in that neighboring bin to see if it is a neighbor
-            unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            // check against all the particles in that neighboring bin to see if it is a neighbor,
+            // one type segment at a time when the cells are sorted by type
+            const unsigned int n_segments
+                = by_type ? (unsigned int)m_interacting_types[type_i].size() : 1;
+            for (unsigned int segment = 0; segment < n_segments; segment++)
                 {
-                Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
-
-                // get the current neighbor type from the position data (will use tdb on the GPU)
-                unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
-                Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_neigh_type)];
-
-                // automatically exclude particles without a distance check when:
-                // (1) they are the same particle, or
-                // (2) the r_cut(i,j) indicates to skip, or
-                // (3) they are in the same body
-                bool excluded = ((i == (int)cur_neigh) || (r_cut <= Scalar(0.0)));
-                if (m_filter_body && body_i != NO_BODY)
-                    excluded = excluded | (body_i == h_body.data[cur_neigh]);
-                if (excluded)
-                    continue;
-
-                Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
-
-                Scalar r_list = r_cut + m_r_buff;
-                Scalar sqshift = Scalar(0.0);
-                if (m_diameter_shift)
+                unsigned int first = 0;
+                unsigned int size = h_cell_size.data[neigh_cell];
+                const Scalar4* cell_xyzf = h_cell_xyzf.data;
+                if (by_type)
                     {
-                    const Scalar delta
-                        = (diam_i + h_diameter.data[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
-                    // r^2 < (r_list + delta)^2
-                    // r^2 < r_listsq + delta^2 + 2*r_list*delta
-                    sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                    const unsigned int type_j = m_interacting_types[type_i][segment];
+                    first = m_type_cell_head[neigh_cell * (ntypes + 1) + type_j];
+                    size = m_type_cell_head[neigh_cell * (ntypes + 1) + type_j + 1];
+                    cell_xyzf = m_type_sorted_xyzf.data();
                     }
+                for (unsigned int cur_offset = first; cur_offset < size; cur_offset++)
+                    {
+                    const Scalar4& cur_xyzf = cell_xyzf[cli(cur_offset, neigh_cell)];
+                    unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+
+                    // get the current neighbor type from the position data (will use tdb on the
+                    // GPU)
+                    unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
+                    Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_neigh_type)];
+
+                    // automatically exclude particles without a distance check when:
+                    // (1) they are the same particle, or
+                    // (2) the r_cut(i,j) indicates to skip, or
+                    // (3) they are in the same body
+                    bool excluded = ((i == cur_neigh) || (r_cut <= Scalar(0.0)));
+                    if (m_filter_body && body_i != NO_BODY)
+                        excluded = excluded | (body_i == h_body.data[cur_neigh]);
+                    if (excluded)
+                        continue;
+
+                    Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                    Scalar3 dx = my_pos - neigh_pos;
+                    dx = box.minImage(dx);
+
+                    Scalar r_list = r_cut + m_r_buff;
+                    Scalar sqshift = Scalar(0.0);
+                    if (m_diameter_shift)
+                        {
+                        const Scalar delta
+                            = (diam_i + h_diameter.data[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
+                        // r^2 < (r_list + delta)^2
+                        // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                        sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                        }
 
-                Scalar dr_sq = dot(dx, dx);
+                    Scalar dr_sq = dot(dx, dx);
 
-                // move the squared rlist by the diameter shift if necessary
-                Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
-                if (dr_sq <= (r_listsq + sqshift) && !excluded)
-                    {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    // move the squared rlist by the diameter shift if necessary
+                    Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
+                    if (dr_sq <= (r_listsq + sqshift) && !excluded)
                         {
-                        // local neighbor
-                        if (cur_n_neigh < Nmax_i)
+                        if (m_storage_mode == full || i < cur_neigh)
                             {
-                            h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                            // local neighbor
+                            if (cur_n_neigh < Nmax_i)
+                                {
+                                h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                                }
+                            else
+                                conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
+
+                            cur_n_neigh++;
                             }
-                        else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
-
-                        cur_n_neigh++;
                         }
                     }
                 }
@@ -194,11 +240,114 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
 
         h_n_neigh.data[i] = cur_n_neigh;
         }
+#ifdef ENABLE_TBB
+        });
+    }); // end task arena execute()
+
+    for (const auto& conditions : thread_conditions)
+        {
+        for (unsigned int t = 0; t < m_pdata->getNTypes(); ++t)
+            h_conditions.data[t] = max(h_conditions.data[t], conditions[t]);
+        }
+#endif
 
     if (m_prof)
         m_prof->pop(m_exec_conf);
     }
 
+/*! \returns true when at least one type pair does not interact
+
+    Fills m_interacting_types with the types j where r_cut(i,j) > 0 for each type i.
+*/
+bool NeighborListBinned::findInteractingTypes()
+    {
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+
+    const unsigned int ntypes = m_pdata->getNTypes();
+    m_interacting_types.resize(ntypes);
+    bool has_inactive = false;
+    for (unsigned int type_i = 0; type_i < ntypes; type_i++)
+        {
+        m_interacting_types[type_i].clear();
+        for (unsigned int type_j = 0; type_j < ntypes; type_j++)
+            {
+            if (h_r_cut.data[m_typpair_idx(type_i, type_j)] > Scalar(0.0))
+                m_interacting_types[type_i].push_back(type_j);
+            else
+                has_inactive = true;
+            }
+        }
+
+    return has_inactive;
+    }
+
+/*! Stable counting sort of each cell by particle type. The sorted cells keep the layout of the cell
+    list, so cli(offset, cell) indexes both. m_type_cell_head[cell * (ntypes + 1) + type] is the
+    offset of the first particle of type in the cell.
+*/
+void NeighborListBinned::sortCellsByType()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
+                                     access_location::host,
+                                     access_mode::read);
+
+    const Index2D cli = m_cl->getCellListIndexer();
+    const unsigned int n_cells = m_cl->getCellIndexer().getNumElements();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
+    m_type_sorted_xyzf.resize(cli.getNumElements());
+    m_type_cell_head.resize(size_t(n_cells) * (ntypes + 1));
+
+    auto sort_cell = [&](unsigned int cell)
+        {
+        unsigned int* head = m_type_cell_head.data() + size_t(cell) * (ntypes + 1);
+        std::fill(head, head + ntypes + 1, 0);
+
+        // count the particles of each type, shifted by one so the prefix sum gives the first
+        const unsigned int size = h_cell_size.data[cell];
+        for (unsigned int offset = 0; offset < size; offset++)
+            {
+            const unsigned int idx = __scalar_as_int(h_cell_xyzf.data[cli(offset, cell)].w);
+            head[__scalar_as_int(h_pos.data[idx].w) + 1]++;
+            }
+        for (unsigned int type = 0; type < ntypes; type++)
+            head[type + 1] += head[type];
+
+        // scatter, which advances head[type] to the first entry of type + 1
+        for (unsigned int offset = 0; offset < size; offset++)
+            {
+            const Scalar4& xyzf = h_cell_xyzf.data[cli(offset, cell)];
+            const unsigned int type = __scalar_as_int(h_pos.data[__scalar_as_int(xyzf.w)].w);
+            m_type_sorted_xyzf[cli(head[type]++, cell)] = xyzf;
+            }
+
+        // restore the first entry of each type
+        for (unsigned int type = ntypes - 1; type > 0; type--)
+            head[type] = head[type - 1];
+        head[0] = 0;
+        };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int cell = r.begin(); cell != r.end(); cell++)
+                                      sort_cell(cell);
+                              });
+        });
+#else
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        sort_cell(cell);
+#endif
+    }
+
 void export_NeighborListBinned(py::module& m)
     {
     py::class_<NeighborListBinned, NeighborList, std::shared_ptr<NeighborListBinned>>(
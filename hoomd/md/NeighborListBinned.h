@@ -15,6 +15,7 @@
 #endif
 
 #include <pybind11/pybind11.h>
+#include <vector>
 
 #ifndef __NEIGHBORLISTBINNED_H__
 #define __NEIGHBORLISTBINNED_H__
@@ -22,6 +23,10 @@
 //! Efficient neighbor list build on the CPU
 /*! Implements the O(N) neighbor list build on the CPU using a cell list.
 
+    When some type pairs do not interact (r_cut <= 0), the build sorts the contents of each cell by
+    type and each particle visits only the type segments of the types it interacts with. Particles
+    of types that interact with no type skip the cell traversal entirely.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT NeighborListBinned : public NeighborList
@@ -58,8 +63,23 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
     /// Track when the cell size needs to be updated
     bool m_update_cell_size = true;
 
+    /// Types that each type interacts with (r_cut > 0), rebuilt every neighbor list build
+    std::vector<std::vector<unsigned int>> m_interacting_types;
+
+    /// Cell contents sorted by type, indexed like the cell list
+    std::vector<Scalar4> m_type_sorted_xyzf;
+
+    /// Offset of the first particle of each type (and one past the last) in each cell
+    std::vector<unsigned int> m_type_cell_head;
+
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
+
+    //! Find the types that each type interacts with
+    bool findInteractingTypes();
+
+    //! Sort the contents of each cell by type
+    void sortCellsByType();
     };
 
 //! Exports NeighborListBinned to python
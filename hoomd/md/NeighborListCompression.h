@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBORLIST_COMPRESSION_H__
+#define __NEIGHBORLIST_COMPRESSION_H__
+
+/*! \file NeighborListCompression.h
+    \brief Encodes and decodes rows of the compressed neighbor list
+
+    A compressed row stores the neighbors of a particle in increasing index order. Each neighbor is
+    stored as the difference to the previous one (the first as the difference to 0) in a variable
+    length byte code: 7 bits per byte, least significant bits first, with the high bit set on all
+    bytes but the last. Neighbors of nearby particles have nearby indices after the particle sort,
+    so most differences need 1 or 2 bytes instead of 4.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Number of bytes needed to store \a delta
+HOSTDEVICE inline unsigned int nlist_compressed_size(unsigned int delta)
+    {
+    unsigned int n = 1;
+    while (delta >= 0x80)
+        {
+        delta >>= 7;
+        n++;
+        }
+    return n;
+    }
+
+//! Store \a delta at \a p and advance \a p past it
+HOSTDEVICE inline void nlist_compressed_write(unsigned char*& p, unsigned int delta)
+    {
+    while (delta >= 0x80)
+        {
+        *p++ = (unsigned char)(delta | 0x80);
+        delta >>= 7;
+        }
+    *p++ = (unsigned char)delta;
+    }
+
+//! Read the difference stored at \a p and advance \a p past it
+HOSTDEVICE inline unsigned int nlist_compressed_read(const unsigned char*& p)
+    {
+    unsigned int delta = 0;
+    unsigned int shift = 0;
+    unsigned char byte;
+    do
+        {
+        byte = *p++;
+        delta |= (unsigned int)(byte & 0x7f) << shift;
+        shift += 7;
+        } while (byte & 0x80);
+    return delta;
+    }
+
+#undef HOSTDEVICE
+
+#endif // __NEIGHBORLIST_COMPRESSION_H__
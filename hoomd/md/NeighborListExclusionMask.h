@@ -0,0 +1,50 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBORLIST_EXCLUSION_MASK_H__
+#define __NEIGHBORLIST_EXCLUSION_MASK_H__
+
+/*! \file NeighborListExclusionMask.h
+    \brief Encodes and tests the exclusions of a particle as a bit mask over nearby tags
+
+    Molecules are usually stored with consecutive tags, so the exclusions of a particle (bonds,
+    angles, dihedrals, 1-3, 1-4) are with particles whose tags differ by only a few. The exclusion
+    mask of a particle with tag t sets bit nlist_ex_mask_bit(u - t) for every excluded tag u with
+    0 < |u - t| <= NLIST_EX_MASK_RANGE. A particle with an exclusion outside of this range has no
+    mask, and its row of the neighbor list is filtered instead.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Largest tag difference of an exclusion stored in the mask
+const unsigned int NLIST_EX_MASK_RANGE = 16;
+
+//! Bit of the exclusion mask that stores the tag difference \a delta
+/*! \returns The bit, or 32 when \a delta is 0 or outside of the range of the mask
+ */
+HOSTDEVICE inline unsigned int nlist_ex_mask_bit(int delta)
+    {
+    const int range = (int)NLIST_EX_MASK_RANGE;
+    if (delta < -range || delta > range || delta == 0)
+        return 32;
+    return delta < 0 ? (unsigned int)(delta + range) : (unsigned int)(delta + range - 1);
+    }
+
+//! Test if the exclusion mask \a mask of the particle with tag \a tag_i excludes \a tag_j
+HOSTDEVICE inline bool nlist_ex_mask_excluded(unsigned int mask,
+                                              unsigned int tag_i,
+                                              unsigned int tag_j)
+    {
+    unsigned int bit = nlist_ex_mask_bit((int)tag_j - (int)tag_i);
+    return bit < 32 && ((mask >> bit) & 1);
+    }
+
+#undef HOSTDEVICE
+
+#endif // __NEIGHBORLIST_EXCLUSION_MASK_H__
@@ -18,6 +18,7 @@ namespace py = pybind11;
 
 #include "hoomd/CachedAllocator.h"
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -81,13 +82,9 @@ bool NeighborListGPU::distanceCheck(uint64_t timestep)
     BoxDim box = m_pdata->getBox();
     ArrayHandle<Scalar4> d_last_pos(m_last_pos, access_location::device, access_mode::read);
 
-    // get current global nearest plane distance
-    Scalar3 L_g = m_pdata->getGlobalBox().getNearestPlaneDistance();
-
-    // Find direction of maximum box length contraction (smallest eigenvalue of deformation tensor)
-    Scalar3 lambda = L_g / m_last_L;
-    Scalar lambda_min = (lambda.x < lambda.y) ? lambda.x : lambda.y;
-    lambda_min = (lambda_min < lambda.z) ? lambda_min : lambda.z;
+    // boxes that map the last positions affinely into the current box
+    BoxDim last_box, global_box;
+    Scalar lambda_min = computeAffineBoxes(last_box, global_box);
 
     ArrayHandle<Scalar> d_rcut_max(m_rcut_max, access_location::device, access_mode::read);
 
@@ -101,11 +98,12 @@ bool NeighborListGPU::distanceCheck(uint64_t timestep)
                                          d_pos.data,
                                          m_pdata->getN(),
                                          box,
+                                         global_box,
+                                         last_box,
                                          d_rcut_max.data,
                                          m_r_buff,
                                          m_pdata->getNTypes(),
                                          lambda_min,
-                                         lambda,
                                          ++m_checkn,
                                          m_pdata->getGPUPartition());
 
@@ -157,7 +155,10 @@ void NeighborListGPU::filterNlist()
 
     // access data
 
-    ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::read);
+    // with masks, only the rows of the particles without a mask are filtered
+    ArrayHandle<unsigned int> d_n_ex_idx(m_ex_masks_used ? m_n_ex_filter_idx : m_n_ex_idx,
+                                         access_location::device,
+                                         access_mode::read);
     ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx,
                                             access_location::device,
                                             access_mode::read);
@@ -205,6 +206,12 @@ void NeighborListGPU::updateExListIdx()
     ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx,
                                             access_location::device,
                                             access_mode::overwrite);
+    ArrayHandle<unsigned int> d_ex_mask_idx(m_ex_mask_idx,
+                                            access_location::device,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> d_n_ex_filter_idx(m_n_ex_filter_idx,
+                                                access_location::device,
+                                                access_mode::overwrite);
 
     gpu_update_exclusion_list(d_tag.data,
                               d_rtag.data,
@@ -214,6 +221,8 @@ void NeighborListGPU::updateExListIdx()
                               d_n_ex_idx.data,
                               d_ex_list_idx.data,
                               m_ex_list_indexer,
+                              d_ex_mask_idx.data,
+                              d_n_ex_filter_idx.data,
                               m_pdata->getN());
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -222,6 +231,152 @@ void NeighborListGPU::updateExListIdx()
         m_prof->pop(m_exec_conf);
     }
 
+/*! Expands the queued patches into edits of the exclusion list rows of both particles, grows the
+    exclusion list to hold the added exclusions, and applies the edits of each row in order with
+    gpu_apply_exclusion_patches().
+*/
+void NeighborListGPU::applyExclusionPatches()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "patch-ex");
+
+    unsigned int n_rows = 0;
+
+        {
+        // expand the patches into edits of the rows of both particles
+        std::vector<unsigned int> row;
+        std::vector<unsigned int> other;
+        std::vector<unsigned int> add;
+        for (const exclusion_patch_t& patch : m_exclusion_patches)
+            {
+            row.push_back(patch.tag1);
+            other.push_back(patch.tag2);
+            add.push_back(patch.add);
+
+            if (patch.tag2 != patch.tag1)
+                {
+                row.push_back(patch.tag2);
+                other.push_back(patch.tag1);
+                add.push_back(patch.add);
+                }
+
+            m_exclusions_set = m_exclusions_set || patch.add;
+            }
+        m_exclusion_patches.clear();
+
+        // sort the edits by row, preserving the order of the edits of each row
+        std::vector<unsigned int> order(row.size());
+        for (unsigned int k = 0; k < order.size(); ++k)
+            order[k] = k;
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&row](unsigned int a, unsigned int b) { return row[a] < row[b]; });
+
+        m_ex_patch_row.resize(order.size());
+        m_ex_patch_offset.resize(order.size() + 1);
+        m_ex_patch_other.resize(order.size());
+        m_ex_patch_add.resize(order.size());
+
+        ArrayHandle<unsigned int> h_patch_row(m_ex_patch_row,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_patch_offset(m_ex_patch_offset,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        ArrayHandle<unsigned int> h_patch_other(m_ex_patch_other,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        ArrayHandle<unsigned int> h_patch_add(m_ex_patch_add,
+                                              access_location::host,
+                                              access_mode::overwrite);
+
+        for (unsigned int k = 0; k < order.size(); ++k)
+            {
+            if (k == 0 || row[order[k]] != row[order[k - 1]])
+                {
+                h_patch_row.data[n_rows] = row[order[k]];
+                h_patch_offset.data[n_rows] = k;
+                n_rows++;
+                }
+            h_patch_other.data[k] = other[order[k]];
+            h_patch_add.data[k] = add[order[k]];
+            }
+        h_patch_offset.data[n_rows] = (unsigned int)order.size();
+        }
+
+    // grow the exclusion list to hold the added exclusions
+    m_ex_patch_height.resetFlags(0);
+
+        {
+        ArrayHandle<unsigned int> d_patch_row(m_ex_patch_row,
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_patch_offset(m_ex_patch_offset,
+                                                 access_location::device,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> d_patch_add(m_ex_patch_add,
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_n_ex_tag(m_n_ex_tag,
+                                             access_location::device,
+                                             access_mode::read);
+
+        gpu_size_exclusion_patches(n_rows,
+                                   d_patch_row.data,
+                                   d_patch_offset.data,
+                                   d_patch_add.data,
+                                   d_n_ex_tag.data,
+                                   m_ex_patch_height.getDeviceFlags());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    unsigned int req_height = m_ex_patch_height.readFlags();
+    while (m_ex_list_indexer_tag.getH() < req_height)
+        {
+        growExclusionList();
+        }
+
+        {
+        ArrayHandle<unsigned int> d_patch_row(m_ex_patch_row,
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_patch_offset(m_ex_patch_offset,
+                                                 access_location::device,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> d_patch_other(m_ex_patch_other,
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> d_patch_add(m_ex_patch_add,
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_n_ex_tag(m_n_ex_tag,
+                                             access_location::device,
+                                             access_mode::readwrite);
+        ArrayHandle<unsigned int> d_ex_list_tag(m_ex_list_tag,
+                                                access_location::device,
+                                                access_mode::readwrite);
+        ArrayHandle<unsigned int> d_ex_count_tag(m_ex_count_tag,
+                                                 access_location::device,
+                                                 access_mode::readwrite);
+
+        gpu_apply_exclusion_patches(n_rows,
+                                    d_patch_row.data,
+                                    d_patch_offset.data,
+                                    d_patch_other.data,
+                                    d_patch_add.data,
+                                    d_n_ex_tag.data,
+                                    d_ex_list_tag.data,
+                                    d_ex_count_tag.data,
+                                    m_ex_list_indexer_tag);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
 //! Build the head list for neighbor list indexing on the GPU
 void NeighborListGPU::buildHeadList()
     {
@@ -286,6 +441,137 @@ void NeighborListGPU::buildHeadList()
         m_prof->pop(m_exec_conf);
     }
 
+void NeighborListGPU::buildGhostPartition()
+    {
+    const unsigned int N = m_pdata->getN();
+    if (m_ghost_partition.getNumElements() < N)
+        {
+        GlobalArray<unsigned int> ghost_partition(N, m_exec_conf);
+        m_ghost_partition.swap(ghost_partition);
+        TAG_ALLOCATION(m_ghost_partition);
+
+        GlobalArray<unsigned int> ghost_flags(N, m_exec_conf);
+        m_ghost_flags.swap(ghost_flags);
+        TAG_ALLOCATION(m_ghost_flags);
+        }
+
+    ArrayHandle<unsigned int> d_ghost_partition(m_ghost_partition,
+                                                access_location::device,
+                                                access_mode::overwrite);
+    ArrayHandle<unsigned int> d_ghost_flags(m_ghost_flags,
+                                            access_location::device,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+
+    gpu_nlist_ghost_partition(d_ghost_partition.data,
+                              m_n_interior,
+                              d_ghost_flags.data,
+                              d_n_neigh.data,
+                              d_nlist.data,
+                              d_head_list.data,
+                              N,
+                              256);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void NeighborListGPU::partitionShells()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "shells");
+
+    ArrayHandle<unsigned int> d_shell_n_neigh(m_shell_n_neigh,
+                                              access_location::device,
+                                              access_mode::overwrite);
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_shell_rlistsq(m_shell_rlistsq,
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_shell_order(m_shell_order,
+                                            access_location::device,
+                                            access_mode::read);
+
+    gpu_nlist_partition_shells(d_shell_n_neigh.data,
+                               m_shell_pitch,
+                               d_nlist.data,
+                               d_n_neigh.data,
+                               d_head_list.data,
+                               d_pos.data,
+                               d_shell_rlistsq.data,
+                               d_shell_order.data,
+                               m_pdata->getBox(),
+                               m_pdata->getN(),
+                               (unsigned int)m_consumer_r_cut.size(),
+                               256);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void NeighborListGPU::compressNlist()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compress");
+
+    const unsigned int N = m_pdata->getN();
+    if (m_compressed_head_list.getNumElements() < N + 1)
+        {
+        GlobalArray<size_t> compressed_head_list(N + 1, m_exec_conf);
+        m_compressed_head_list.swap(compressed_head_list);
+        TAG_ALLOCATION(m_compressed_head_list);
+        }
+
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+
+        {
+        ArrayHandle<size_t> d_compressed_head_list(m_compressed_head_list,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
+
+        size_t size = 0;
+        gpu_nlist_compressed_size(d_compressed_head_list.data,
+                                  size,
+                                  d_nlist.data,
+                                  d_n_neigh.data,
+                                  d_head_list.data,
+                                  N,
+                                  256);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        resizeCompressedNlist(size);
+        }
+
+    ArrayHandle<size_t> d_compressed_head_list(m_compressed_head_list,
+                                               access_location::device,
+                                               access_mode::read);
+    ArrayHandle<unsigned char> d_compressed_nlist(m_compressed_nlist,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+
+    gpu_nlist_compress(d_compressed_nlist.data,
+                       d_compressed_head_list.data,
+                       d_nlist.data,
+                       d_n_neigh.data,
+                       d_head_list.data,
+                       N,
+                       256);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
 void export_NeighborListGPU(py::module& m)
     {
     py::class_<NeighborListGPU, NeighborList, std::shared_ptr<NeighborListGPU>>(m,
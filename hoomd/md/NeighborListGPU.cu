@@ -8,11 +8,16 @@
     \brief Defines GPU kernel code for neighbor list processing on the GPU
 */
 
+#include "NeighborListCompression.h"
+#include "NeighborListExclusionMask.h"
 #include "NeighborListGPU.cuh"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
+#include <thrust/copy.h>
 #include <thrust/device_ptr.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/scan.h>
 #pragma GCC diagnostic pop
 
@@ -21,11 +26,12 @@
     \param d_pos Current particle positions
     \param nwork Number of particles this GPU processes
     \param box Box dimensions
+    \param global_box Current global box
+    \param last_box Global box at the time the nlist was last updated
     \param d_rcut_max The maximum rcut(i,j) that any particle of type i participates in
     \param r_buff The buffer size that particles can move in
     \param ntypes The number of particle types
     \param lambda_min Minimum contraction of deformation tensor
-    \param lambda Diagonal deformation tensor (for orthorhombic boundaries)
     \param checkn
 
     gpu_nlist_needs_update_check_new_kernel() executes one thread per particle. Every particle's
@@ -37,11 +43,12 @@ __global__ void gpu_nlist_needs_update_check_new_kernel(unsigned int* d_result,
                                                         const Scalar4* d_pos,
                                                         const unsigned int nwork,
                                                         const BoxDim box,
+                                                        const BoxDim global_box,
+                                                        const BoxDim last_box,
                                                         const Scalar* d_rcut_max,
                                                         const Scalar r_buff,
                                                         const unsigned int ntypes,
                                                         const Scalar lambda_min,
-                                                        const Scalar3 lambda,
                                                         const unsigned int checkn,
                                                         const unsigned int offset)
     {
@@ -79,7 +86,9 @@ __global__ void gpu_nlist_needs_update_check_new_kernel(unsigned int* d_result,
         Scalar4 last_postype = d_last_pos[idx];
         Scalar3 last_pos = make_scalar3(last_postype.x, last_postype.y, last_postype.z);
 
-        Scalar3 dx = cur_pos - lambda * last_pos;
+        // map the last position affinely into the current box
+        last_pos = global_box.makeCoordinates(last_box.makeFraction(last_pos));
+        Scalar3 dx = cur_pos - last_pos;
         dx = box.minImage(dx);
 
         if (dot(dx, dx) >= s_maxshiftsq[cur_type])
@@ -96,11 +105,12 @@ hipError_t gpu_nlist_needs_update_check_new(unsigned int* d_result,
                                             const Scalar4* d_pos,
                                             const unsigned int N,
                                             const BoxDim& box,
+                                            const BoxDim& global_box,
+                                            const BoxDim& last_box,
                                             const Scalar* d_rcut_max,
                                             const Scalar r_buff,
                                             const unsigned int ntypes,
                                             const Scalar lambda_min,
-                                            const Scalar3 lambda,
                                             const unsigned int checkn,
                                             const GPUPartition& gpu_partition)
     {
@@ -125,11 +135,12 @@ hipError_t gpu_nlist_needs_update_check_new(unsigned int* d_result,
                            d_pos,
                            nwork,
                            box,
+                           global_box,
+                           last_box,
                            d_rcut_max,
                            r_buff,
                            ntypes,
                            lambda_min,
-                           lambda,
                            checkn,
                            range.first);
         }
@@ -285,6 +296,8 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int* tags,
                                                  unsigned int* n_ex_idx,
                                                  unsigned int* ex_list_idx,
                                                  const Index2D ex_list_indexer,
+                                                 unsigned int* ex_mask_idx,
+                                                 unsigned int* n_ex_filter_idx,
                                                  const unsigned int N)
     {
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -299,13 +312,25 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int* tags,
     // copy over number of exclusions
     n_ex_idx[idx] = n;
 
+    unsigned int mask = 0;
+    bool maskable = true;
     for (unsigned int offset = 0; offset < n; offset++)
         {
         unsigned int ex_tag = ex_list_tag[ex_list_tag_indexer(tag, offset)];
         unsigned int ex_idx = rtags[ex_tag];
 
         ex_list_idx[ex_list_indexer(idx, offset)] = ex_idx;
+
+        unsigned int bit = nlist_ex_mask_bit((int)ex_tag - (int)tag);
+        if (bit < 32)
+            mask |= 1u << bit;
+        else
+            maskable = false;
         }
+
+    // particles with exclusions outside of the mask range are filtered
+    ex_mask_idx[idx] = maskable ? mask : 0;
+    n_ex_filter_idx[idx] = maskable ? 0 : n;
     }
 
 //! GPU function to update the exclusion list on the device
@@ -317,6 +342,8 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int* tags,
     \param d_n_ex_idx List of number of exclusions per idx
     \param d_ex_list_idx Exclusion list per idx
     \param ex_list_indexer Indexer for per-idx exclusion list
+    \param d_ex_mask_idx Exclusion mask per idx
+    \param d_n_ex_filter_idx Number of exclusions to filter per idx
     \param N number of particles
  */
 hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
@@ -327,6 +354,8 @@ hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
                                      unsigned int* d_n_ex_idx,
                                      unsigned int* d_ex_list_idx,
                                      const Index2D& ex_list_indexer,
+                                     unsigned int* d_ex_mask_idx,
+                                     unsigned int* d_n_ex_filter_idx,
                                      const unsigned int N)
     {
     unsigned int block_size = 256;
@@ -344,11 +373,181 @@ hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
                        d_n_ex_idx,
                        d_ex_list_idx,
                        ex_list_indexer,
+                       d_ex_mask_idx,
+                       d_n_ex_filter_idx,
                        N);
 
     return hipSuccess;
     }
 
+//! GPU kernel to find the exclusion list height needed to apply exclusion patches
+/*! \param n_rows Number of patched rows
+    \param d_patch_row Tag of each patched row
+    \param d_patch_offset Offset of the first patch of each row (n_rows + 1 elements)
+    \param d_patch_add 1 if the patch adds a reference to an exclusion, 0 if it removes one
+    \param d_n_ex_tag List of number of exclusions per tag
+    \param d_req_height Maximum required height (output)
+*/
+__global__ void gpu_size_exclusion_patches_kernel(const unsigned int n_rows,
+                                                  const unsigned int* d_patch_row,
+                                                  const unsigned int* d_patch_offset,
+                                                  const unsigned int* d_patch_add,
+                                                  const unsigned int* d_n_ex_tag,
+                                                  unsigned int* d_req_height)
+    {
+    unsigned int row = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (row >= n_rows)
+        return;
+
+    // upper bound: every added reference is a new exclusion
+    unsigned int n = d_n_ex_tag[d_patch_row[row]];
+    for (unsigned int k = d_patch_offset[row]; k < d_patch_offset[row + 1]; ++k)
+        n += d_patch_add[k];
+
+    atomicMax(d_req_height, n);
+    }
+
+/*! \param n_rows Number of patched rows
+    \param d_patch_row Tag of each patched row
+    \param d_patch_offset Offset of the first patch of each row (n_rows + 1 elements)
+    \param d_patch_add 1 if the patch adds a reference to an exclusion, 0 if it removes one
+    \param d_n_ex_tag List of number of exclusions per tag
+    \param d_req_height Maximum required height (output, must be initialized to 0)
+ */
+hipError_t gpu_size_exclusion_patches(const unsigned int n_rows,
+                                      const unsigned int* d_patch_row,
+                                      const unsigned int* d_patch_offset,
+                                      const unsigned int* d_patch_add,
+                                      const unsigned int* d_n_ex_tag,
+                                      unsigned int* d_req_height)
+    {
+    unsigned int block_size = 256;
+
+    hipLaunchKernelGGL((gpu_size_exclusion_patches_kernel),
+                       dim3(n_rows / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_rows,
+                       d_patch_row,
+                       d_patch_offset,
+                       d_patch_add,
+                       d_n_ex_tag,
+                       d_req_height);
+
+    return hipSuccess;
+    }
+
+//! GPU kernel to apply exclusion patches to the by-tag exclusion list
+/*! \param n_rows Number of patched rows
+    \param d_patch_row Tag of each patched row
+    \param d_patch_offset Offset of the first patch of each row (n_rows + 1 elements)
+    \param d_patch_other Tag of the excluded particle of each patch
+    \param d_patch_add 1 if the patch adds a reference to an exclusion, 0 if it removes one
+    \param d_n_ex_tag List of number of exclusions per tag
+    \param d_ex_list_tag 2D Exclusion list per tag
+    \param d_ex_count_tag Number of references to each exclusion
+    \param ex_list_tag_indexer Indexer for per-tag exclusion list
+
+    One thread applies the patches of one row in order.
+*/
+__global__ void gpu_apply_exclusion_patches_kernel(const unsigned int n_rows,
+                                                   const unsigned int* d_patch_row,
+                                                   const unsigned int* d_patch_offset,
+                                                   const unsigned int* d_patch_other,
+                                                   const unsigned int* d_patch_add,
+                                                   unsigned int* d_n_ex_tag,
+                                                   unsigned int* d_ex_list_tag,
+                                                   unsigned int* d_ex_count_tag,
+                                                   const Index2D ex_list_tag_indexer)
+    {
+    unsigned int row = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (row >= n_rows)
+        return;
+
+    unsigned int tag = d_patch_row[row];
+    unsigned int n = d_n_ex_tag[tag];
+
+    for (unsigned int k = d_patch_offset[row]; k < d_patch_offset[row + 1]; ++k)
+        {
+        unsigned int other = d_patch_other[k];
+
+        unsigned int offset = 0;
+        while (offset < n && d_ex_list_tag[ex_list_tag_indexer(tag, offset)] != other)
+            offset++;
+
+        if (d_patch_add[k])
+            {
+            if (offset == n)
+                {
+                // new exclusion
+                d_ex_list_tag[ex_list_tag_indexer(tag, n)] = other;
+                d_ex_count_tag[ex_list_tag_indexer(tag, n)] = 1;
+                n++;
+                }
+            else
+                {
+                d_ex_count_tag[ex_list_tag_indexer(tag, offset)]++;
+                }
+            }
+        else if (offset < n && --d_ex_count_tag[ex_list_tag_indexer(tag, offset)] == 0)
+            {
+            // no reference remains, move the last exclusion into the hole
+            n--;
+            d_ex_list_tag[ex_list_tag_indexer(tag, offset)]
+                = d_ex_list_tag[ex_list_tag_indexer(tag, n)];
+            d_ex_count_tag[ex_list_tag_indexer(tag, offset)]
+                = d_ex_count_tag[ex_list_tag_indexer(tag, n)];
+            }
+        }
+
+    d_n_ex_tag[tag] = n;
+    }
+
+/*! \param n_rows Number of patched rows
+    \param d_patch_row Tag of each patched row
+    \param d_patch_offset Offset of the first patch of each row (n_rows + 1 elements)
+    \param d_patch_other Tag of the excluded particle of each patch
+    \param d_patch_add 1 if the patch adds a reference to an exclusion, 0 if it removes one
+    \param d_n_ex_tag List of number of exclusions per tag
+    \param d_ex_list_tag 2D Exclusion list per tag
+    \param d_ex_count_tag Number of references to each exclusion
+    \param ex_list_tag_indexer Indexer for per-tag exclusion list
+
+    The exclusion list must be high enough to hold the result, see gpu_size_exclusion_patches().
+ */
+hipError_t gpu_apply_exclusion_patches(const unsigned int n_rows,
+                                       const unsigned int* d_patch_row,
+                                       const unsigned int* d_patch_offset,
+                                       const unsigned int* d_patch_other,
+                                       const unsigned int* d_patch_add,
+                                       unsigned int* d_n_ex_tag,
+                                       unsigned int* d_ex_list_tag,
+                                       unsigned int* d_ex_count_tag,
+                                       const Index2D& ex_list_tag_indexer)
+    {
+    unsigned int block_size = 256;
+
+    hipLaunchKernelGGL((gpu_apply_exclusion_patches_kernel),
+                       dim3(n_rows / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_rows,
+                       d_patch_row,
+                       d_patch_offset,
+                       d_patch_other,
+                       d_patch_add,
+                       d_n_ex_tag,
+                       d_ex_list_tag,
+                       d_ex_count_tag,
+                       ex_list_tag_indexer);
+
+    return hipSuccess;
+    }
+
 //! GPU kernel to do a preliminary sizing on particles
 /*!
  * \param d_head_list The head list of indexes to overwrite
@@ -477,3 +676,388 @@ hipError_t gpu_nlist_build_head_list(unsigned int* d_head_list,
 
     return hipSuccess;
     }
+
+/*!
+ * \param d_shell_n_neigh Number of neighbors of each particle within each shell (output)
+ * \param shell_pitch Pitch of the rows of \a d_shell_n_neigh
+ * \param d_nlist Neighbor list, each row is partitioned in place
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param d_pos Particle positions
+ * \param d_shell_rlistsq Squared shell radii of each type, in increasing order
+ * \param d_shell_order Consumer of each shell in \a d_shell_rlistsq
+ * \param box Local simulation box
+ * \param N Number of particles on this rank
+ * \param n_shells Number of shells
+ *
+ * The partition is the same as in NeighborList::partitionShells().
+ */
+__global__ void gpu_nlist_partition_shells_kernel(unsigned int* d_shell_n_neigh,
+                                                  const size_t shell_pitch,
+                                                  unsigned int* d_nlist,
+                                                  const unsigned int* d_n_neigh,
+                                                  const unsigned int* d_head_list,
+                                                  const Scalar4* d_pos,
+                                                  const Scalar* d_shell_rlistsq,
+                                                  const unsigned int* d_shell_order,
+                                                  const BoxDim box,
+                                                  const unsigned int N,
+                                                  const unsigned int n_shells)
+    {
+    // one thread per particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const Scalar4 postypei = d_pos[idx];
+    const Scalar3 pi = make_scalar3(postypei.x, postypei.y, postypei.z);
+    const unsigned int typei = __scalar_as_int(postypei.w);
+    unsigned int* row = d_nlist + d_head_list[idx];
+    const unsigned int n_neigh = d_n_neigh[idx];
+
+    unsigned int first = 0;
+    for (unsigned int k = 0; k < n_shells; ++k)
+        {
+        const Scalar rlistsq = d_shell_rlistsq[typei * n_shells + k];
+        for (unsigned int m = first; m < n_neigh; ++m)
+            {
+            const unsigned int j = row[m];
+            const Scalar4 postypej = d_pos[j];
+            const Scalar3 pj = make_scalar3(postypej.x, postypej.y, postypej.z);
+            const Scalar3 dx = box.minImage(pi - pj);
+            if (dot(dx, dx) <= rlistsq)
+                {
+                row[m] = row[first];
+                row[first] = j;
+                first++;
+                }
+            }
+        d_shell_n_neigh[d_shell_order[typei * n_shells + k] * shell_pitch + idx] = first;
+        }
+    }
+
+/*!
+ * \param d_shell_n_neigh Number of neighbors of each particle within each shell (output)
+ * \param shell_pitch Pitch of the rows of \a d_shell_n_neigh
+ * \param d_nlist Neighbor list, each row is partitioned in place
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param d_pos Particle positions
+ * \param d_shell_rlistsq Squared shell radii of each type, in increasing order
+ * \param d_shell_order Consumer of each shell in \a d_shell_rlistsq
+ * \param box Local simulation box
+ * \param N Number of particles on this rank
+ * \param n_shells Number of shells
+ * \param block_size Number of threads per block for gpu_nlist_partition_shells_kernel()
+ *
+ * \return hipSuccess on completion
+ */
+hipError_t gpu_nlist_partition_shells(unsigned int* d_shell_n_neigh,
+                                      const size_t shell_pitch,
+                                      unsigned int* d_nlist,
+                                      const unsigned int* d_n_neigh,
+                                      const unsigned int* d_head_list,
+                                      const Scalar4* d_pos,
+                                      const Scalar* d_shell_rlistsq,
+                                      const unsigned int* d_shell_order,
+                                      const BoxDim& box,
+                                      const unsigned int N,
+                                      const unsigned int n_shells,
+                                      const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_partition_shells_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_partition_shells_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_shell_n_neigh,
+                       shell_pitch,
+                       d_nlist,
+                       d_n_neigh,
+                       d_head_list,
+                       d_pos,
+                       d_shell_rlistsq,
+                       d_shell_order,
+                       box,
+                       N,
+                       n_shells);
+
+    return hipSuccess;
+    }
+
+/*!
+ * \param d_row_size Set to the number of bytes in the compressed row of each particle, and to 0
+ *                   for index N
+ * \param d_nlist Neighbor list, each row is sorted in place
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param N Number of particles on this rank
+ *
+ * Rows are short, so each thread sorts its row with an insertion sort.
+ */
+__global__ void gpu_nlist_compressed_size_kernel(size_t* d_row_size,
+                                                 unsigned int* d_nlist,
+                                                 const unsigned int* d_n_neigh,
+                                                 const unsigned int* d_head_list,
+                                                 const unsigned int N)
+    {
+    // one thread per particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx > N)
+        return;
+    if (idx == N)
+        {
+        d_row_size[N] = 0;
+        return;
+        }
+
+    unsigned int* row = d_nlist + d_head_list[idx];
+    const unsigned int n_neigh = d_n_neigh[idx];
+    for (unsigned int k = 1; k < n_neigh; ++k)
+        {
+        const unsigned int j = row[k];
+        unsigned int l = k;
+        for (; l > 0 && row[l - 1] > j; --l)
+            row[l] = row[l - 1];
+        row[l] = j;
+        }
+
+    size_t size = 0;
+    unsigned int prev = 0;
+    for (unsigned int k = 0; k < n_neigh; ++k)
+        {
+        const unsigned int j = row[k];
+        size += nlist_compressed_size(j - prev);
+        prev = j;
+        }
+    d_row_size[idx] = size;
+    }
+
+/*!
+ * \param d_compressed_head_list Byte offset of each compressed row (output)
+ * \param size Total number of bytes in the compressed neighbor list (output)
+ * \param d_nlist Neighbor list, each row is sorted in place
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param N Number of particles on this rank
+ * \param block_size Number of threads per block for gpu_nlist_compressed_size_kernel()
+ *
+ * \return hipSuccess on completion
+ *
+ * \a d_compressed_head_list must hold N+1 entries. The row sizes are summed in place with an
+ * exclusive prefix sum from the thrust libraries, so that the last entry is the total size.
+ */
+hipError_t gpu_nlist_compressed_size(size_t* d_compressed_head_list,
+                                     size_t& size,
+                                     unsigned int* d_nlist,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_head_list,
+                                     const unsigned int N,
+                                     const unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_compressed_size_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_compressed_size_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_compressed_head_list,
+                       d_nlist,
+                       d_n_neigh,
+                       d_head_list,
+                       N);
+
+    thrust::device_ptr<size_t> t_head_list = thrust::device_pointer_cast(d_compressed_head_list);
+    thrust::exclusive_scan(t_head_list, t_head_list + N + 1, t_head_list);
+    size = t_head_list[N];
+
+    return hipSuccess;
+    }
+
+/*!
+ * \param d_compressed_nlist Compressed neighbor list (output)
+ * \param d_compressed_head_list Byte offset of each compressed row
+ * \param d_nlist Neighbor list with sorted rows
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param N Number of particles on this rank
+ */
+__global__ void gpu_nlist_compress_kernel(unsigned char* d_compressed_nlist,
+                                          const size_t* d_compressed_head_list,
+                                          const unsigned int* d_nlist,
+                                          const unsigned int* d_n_neigh,
+                                          const unsigned int* d_head_list,
+                                          const unsigned int N)
+    {
+    // one thread per particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int* row = d_nlist + d_head_list[idx];
+    const unsigned int n_neigh = d_n_neigh[idx];
+    unsigned char* p = d_compressed_nlist + d_compressed_head_list[idx];
+    unsigned int prev = 0;
+    for (unsigned int k = 0; k < n_neigh; ++k)
+        {
+        const unsigned int j = row[k];
+        nlist_compressed_write(p, j - prev);
+        prev = j;
+        }
+    }
+
+/*!
+ * \param d_compressed_nlist Compressed neighbor list (output)
+ * \param d_compressed_head_list Byte offset of each compressed row
+ * \param d_nlist Neighbor list with sorted rows
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param N Number of particles on this rank
+ * \param block_size Number of threads per block for gpu_nlist_compress_kernel()
+ *
+ * \return hipSuccess on completion
+ */
+hipError_t gpu_nlist_compress(unsigned char* d_compressed_nlist,
+                              const size_t* d_compressed_head_list,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_head_list,
+                              const unsigned int N,
+                              const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_compress_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_compress_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_compressed_nlist,
+                       d_compressed_head_list,
+                       d_nlist,
+                       d_n_neigh,
+                       d_head_list,
+                       N);
+
+    return hipSuccess;
+    }
+
+/*!
+ * \param d_has_ghost Set to 1 for each particle with a ghost neighbor, 0 otherwise
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_nlist Neighbor list
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param N Number of particles on this rank
+ */
+__global__ void gpu_nlist_mark_ghost_neighbors_kernel(unsigned int* d_has_ghost,
+                                                      const unsigned int* d_n_neigh,
+                                                      const unsigned int* d_nlist,
+                                                      const unsigned int* d_head_list,
+                                                      const unsigned int N)
+    {
+    // one thread per particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int head_idx = d_head_list[idx];
+    const unsigned int n_neigh = d_n_neigh[idx];
+    unsigned int has_ghost = 0;
+    for (unsigned int k = 0; k < n_neigh; ++k)
+        {
+        if (d_nlist[head_idx + k] >= N)
+            {
+            has_ghost = 1;
+            break;
+            }
+        }
+    d_has_ghost[idx] = has_ghost;
+    }
+
+/*!
+ * \param d_ghost_partition Particle indices, those without ghost neighbors first (output)
+ * \param n_interior Number of particles without ghost neighbors (output)
+ * \param d_has_ghost Temporary flag per particle
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param d_nlist Neighbor list
+ * \param d_head_list Indexes for reading the neighbor list
+ * \param N Number of particles on this rank
+ * \param block_size Number of threads per block for gpu_nlist_mark_ghost_neighbors_kernel()
+ *
+ * \return hipSuccess on completion
+ *
+ * \b Implementation
+ * Each particle is flagged when it has a ghost neighbor, then two stream compactions with the
+ * thrust libraries write the unflagged and the flagged indices in order.
+ */
+hipError_t gpu_nlist_ghost_partition(unsigned int* d_ghost_partition,
+                                     unsigned int& n_interior,
+                                     unsigned int* d_has_ghost,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_nlist,
+                                     const unsigned int* d_head_list,
+                                     const unsigned int N,
+                                     const unsigned int block_size)
+    {
+    if (N == 0)
+        {
+        n_interior = 0;
+        return hipSuccess;
+        }
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_mark_ghost_neighbors_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_mark_ghost_neighbors_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_has_ghost,
+                       d_n_neigh,
+                       d_nlist,
+                       d_head_list,
+                       N);
+
+    thrust::counting_iterator<unsigned int> first(0);
+    thrust::device_ptr<unsigned int> t_has_ghost = thrust::device_pointer_cast(d_has_ghost);
+    thrust::device_ptr<unsigned int> t_partition = thrust::device_pointer_cast(d_ghost_partition);
+
+    auto t_boundary = thrust::copy_if(first,
+                                      first + N,
+                                      t_has_ghost,
+                                      t_partition,
+                                      thrust::logical_not<unsigned int>());
+    thrust::copy_if(first, first + N, t_has_ghost, t_boundary, thrust::identity<unsigned int>());
+    n_interior = (unsigned int)(t_boundary - t_partition);
+
+    return hipSuccess;
+    }
@@ -23,11 +23,12 @@ hipError_t gpu_nlist_needs_update_check_new(unsigned int* d_result,
                                             const Scalar4* d_pos,
                                             const unsigned int N,
                                             const BoxDim& box,
+                                            const BoxDim& global_box,
+                                            const BoxDim& last_box,
                                             const Scalar* d_rcut_max,
                                             const Scalar r_buff,
                                             const unsigned int ntypes,
                                             const Scalar lambda_min,
-                                            const Scalar3 lambda,
                                             const unsigned int checkn,
                                             const GPUPartition& gpu_partition);
 
@@ -50,6 +51,48 @@ hipError_t gpu_nlist_build_head_list(unsigned int* d_head_list,
                                      const unsigned int n_types,
                                      const unsigned int block_size);
 
+//! Kernel driver to partition the particles by whether they have ghost neighbors
+hipError_t gpu_nlist_ghost_partition(unsigned int* d_ghost_partition,
+                                     unsigned int& n_interior,
+                                     unsigned int* d_has_ghost,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_nlist,
+                                     const unsigned int* d_head_list,
+                                     const unsigned int N,
+                                     const unsigned int block_size);
+
+//! Kernel driver to partition the neighbor list rows into cutoff shells
+hipError_t gpu_nlist_partition_shells(unsigned int* d_shell_n_neigh,
+                                      const size_t shell_pitch,
+                                      unsigned int* d_nlist,
+                                      const unsigned int* d_n_neigh,
+                                      const unsigned int* d_head_list,
+                                      const Scalar4* d_pos,
+                                      const Scalar* d_shell_rlistsq,
+                                      const unsigned int* d_shell_order,
+                                      const BoxDim& box,
+                                      const unsigned int N,
+                                      const unsigned int n_shells,
+                                      const unsigned int block_size);
+
+//! Kernel driver to sort the neighbor list rows and size the compressed neighbor list
+hipError_t gpu_nlist_compressed_size(size_t* d_compressed_head_list,
+                                     size_t& size,
+                                     unsigned int* d_nlist,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_head_list,
+                                     const unsigned int N,
+                                     const unsigned int block_size);
+
+//! Kernel driver to encode the compressed neighbor list
+hipError_t gpu_nlist_compress(unsigned char* d_compressed_nlist,
+                              const size_t* d_compressed_head_list,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_head_list,
+                              const unsigned int N,
+                              const unsigned int block_size);
+
 //! GPU function to update the exclusion list on the device
 hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
                                      const unsigned int* d_rtag,
@@ -59,6 +102,27 @@ hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
                                      unsigned int* d_n_ex_idx,
                                      unsigned int* d_ex_list_idx,
                                      const Index2D& ex_list_indexer,
+                                     unsigned int* d_ex_mask_idx,
+                                     unsigned int* d_n_ex_filter_idx,
                                      const unsigned int N);
 
+//! GPU function to find the exclusion list height needed to apply exclusion patches
+hipError_t gpu_size_exclusion_patches(const unsigned int n_rows,
+                                      const unsigned int* d_patch_row,
+                                      const unsigned int* d_patch_offset,
+                                      const unsigned int* d_patch_add,
+                                      const unsigned int* d_n_ex_tag,
+                                      unsigned int* d_req_height);
+
+//! GPU function to apply exclusion patches to the by-tag exclusion list
+hipError_t gpu_apply_exclusion_patches(const unsigned int n_rows,
+                                       const unsigned int* d_patch_row,
+                                       const unsigned int* d_patch_offset,
+                                       const unsigned int* d_patch_other,
+                                       const unsigned int* d_patch_add,
+                                       unsigned int* d_n_ex_tag,
+                                       unsigned int* d_ex_list_tag,
+                                       unsigned int* d_ex_count_tag,
+                                       const Index2D& ex_list_tag_indexer);
+
 #endif
@@ -34,7 +34,9 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     public:
     //! Constructs the compute
     NeighborListGPU(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
-        : NeighborList(sysdef, r_buff)
+        : NeighborList(sysdef, r_buff), m_ex_patch_row(m_exec_conf),
+          m_ex_patch_offset(m_exec_conf), m_ex_patch_other(m_exec_conf),
+          m_ex_patch_add(m_exec_conf), m_ex_patch_height(m_exec_conf)
         {
         m_exec_conf->msg->notice(5) << "Constructing NeighborlistGPU" << std::endl;
 
@@ -139,14 +141,27 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
         {
         m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
         m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
+        m_last_box = m_pdata->getGlobalBox();
         }
 
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Apply the queued exclusion patches to the by-tag exclusion list on the GPU
+    virtual void applyExclusionPatches();
+
     //! Build the head list for neighbor list indexing on the GPU
     virtual void buildHeadList();
 
+    //! Partition the local particles by whether they have ghost neighbors on the GPU
+    virtual void buildGhostPartition();
+
+    //! Partition the rows of the neighbor list into cutoff shells on the GPU
+    virtual void partitionShells();
+
+    //! Sort and encode the compressed neighbor list on the GPU
+    virtual void compressNlist();
+
     //! Schedule the distance check kernel
     /*! \param timestep Current time step
      */
@@ -159,6 +174,14 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
 
     GlobalArray<unsigned int>
         m_alt_head_list; //!< Alternate array to hold the head list from prefix sum
+
+    GlobalArray<unsigned int> m_ghost_flags; //!< Flags particles with ghost neighbors
+
+    GPUVector<unsigned int> m_ex_patch_row;    //!< Tag of each patched exclusion list row
+    GPUVector<unsigned int> m_ex_patch_offset; //!< Offset of the first patch of each row
+    GPUVector<unsigned int> m_ex_patch_other;  //!< Excluded tag of each patch
+    GPUVector<unsigned int> m_ex_patch_add;    //!< 1 if the patch adds a reference, 0 if not
+    GPUFlags<unsigned int> m_ex_patch_height;  //!< Exclusion list height needed by the patches
     };
 
 //! Exports NeighborListGPU to python
@@ -59,13 +59,6 @@ NeighborListGPUBinned::~NeighborListGPUBinned() { }
 
 void NeighborListGPUBinned::buildNlist(uint64_t timestep)
     {
-    if (m_storage_mode != full)
-        {
-        m_exec_conf->msg->error() << "Only full mode nlists can be generated on the GPU"
-                                  << std::endl;
-        throw std::runtime_error("Error computing neighbor list");
-        }
-
     // update the cell list size if needed
     if (m_update_cell_size)
         {
@@ -191,7 +184,8 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
                              m_diameter_shift,
                              m_cl->getGhostWidth(),
                              m_pdata->getGPUPartition(),
-                             m_use_index);
+                             m_use_index,
+                             m_storage_mode == half);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
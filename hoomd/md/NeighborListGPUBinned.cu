@@ -39,6 +39,8 @@
     \param ghost_width Width of ghost cell layer
     \param offset Starting particle index
     \param nwork Number of particles to process
+    \param ngpu Number of active GPUs
+    \param half When true, store each pair only in the row of the lower particle index
 
     \note optimized for Kepler
 */
@@ -68,7 +70,8 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
                                                 const Scalar3 ghost_width,
                                                 const unsigned int offset,
                                                 const unsigned int nwork,
-                                                const unsigned int ngpu)
+                                                const unsigned int ngpu,
+                                                const bool half)
     {
     bool filter_body = flags & 1;
     bool diameter_shift = flags & 2;
@@ -155,7 +158,12 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
     // current index in cell
     int cur_offset = threadIdx.x % threads_per_particle;
 
-    bool done = false;
+    // particles of types that interact with no type skip the cell traversal
+    bool interacts = false;
+    for (unsigned int type = 0; type < ntypes; type++)
+        interacts = interacts || s_r_list[typpair_idx(my_type, type)] > Scalar(0.0);
+
+    bool done = !interacts;
 
     // total number of neighbors
     unsigned int nneigh = 0;
@@ -235,7 +243,8 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
                 // compute dr squared
                 Scalar drsq = dot(dx, dx);
 
-                bool excluded = (my_pidx == cur_neigh);
+                // a half list stores each pair in the row of the lower index
+                bool excluded = half ? (cur_neigh <= my_pidx) : (my_pidx == cur_neigh);
 
                 if (filter_body && my_body != 0xffffffff)
                     excluded = excluded | (my_body == neigh_body);
@@ -333,7 +342,8 @@ inline void launcher(unsigned int* d_nlist,
                      unsigned int block_size,
                      std::pair<unsigned int, unsigned int> range,
                      bool use_index,
-                     const unsigned int ngpu)
+                     const unsigned int ngpu,
+                     bool half)
     {
     // shared memory = r_listsq + Nmax + stuff needed for neighborlist (computed below)
     Index2D typpair_idx(ntypes);
@@ -385,7 +395,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             else if (!diameter_shift && filter_body)
                 {
@@ -425,7 +436,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             else if (diameter_shift && !filter_body)
                 {
@@ -465,7 +477,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             else if (diameter_shift && filter_body)
                 {
@@ -505,7 +518,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             }
         else // use_index
@@ -548,7 +562,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             else if (!diameter_shift && filter_body)
                 {
@@ -588,7 +603,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             else if (diameter_shift && !filter_body)
                 {
@@ -628,7 +644,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             else if (diameter_shift && filter_body)
                 {
@@ -668,7 +685,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   half);
                 }
             }
         }
@@ -703,7 +721,8 @@ inline void launcher(unsigned int* d_nlist,
                               block_size,
                               range,
                               use_index,
-                              ngpu);
+                              ngpu,
+                              half);
         }
     }
 
@@ -738,7 +757,8 @@ inline void launcher<min_threads_per_particle / 2>(unsigned int* d_nlist,
                                                    unsigned int block_size,
                                                    std::pair<unsigned int, unsigned int> range,
                                                    bool use_index,
-                                                   const unsigned int ngpu)
+                                                   const unsigned int ngpu,
+                                                   bool half)
     {
     }
 
@@ -770,7 +790,8 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                     bool diameter_shift,
                                     const Scalar3& ghost_width,
                                     const GPUPartition& gpu_partition,
-                                    bool use_index)
+                                    bool use_index,
+                                    bool half)
     {
     unsigned int ngpu = gpu_partition.getNumActiveGPUs();
 
@@ -808,7 +829,8 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                            block_size,
                                            range,
                                            use_index,
-                                           ngpu);
+                                           ngpu,
+                                           half);
         }
     return hipSuccess;
     }
@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListGPUCluster.cc
+    \brief Defines NeighborListGPUCluster
+*/
+
+#include "NeighborListGPUCluster.h"
+#include "NeighborListGPUCluster.cuh"
+
+namespace py = pybind11;
+
+NeighborListGPUCluster::NeighborListGPUCluster(std::shared_ptr<SystemDefinition> sysdef,
+                                               Scalar r_buff)
+    : NeighborListGPUBinned(sysdef, r_buff), m_cluster_nmax(32), m_cluster_overflow(m_exec_conf)
+    {
+    }
+
+NeighborListGPUCluster::~NeighborListGPUCluster() { }
+
+void NeighborListGPUCluster::buildNlist(uint64_t timestep)
+    {
+    NeighborListGPUBinned::buildNlist(timestep);
+    m_clusters_valid = false;
+    }
+
+void NeighborListGPUCluster::buildClusters()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "cluster");
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_clusters = (N + gpu_nlist_cluster_size - 1) / gpu_nlist_cluster_size;
+
+    if (m_n_cluster_neigh.getNumElements() < n_clusters)
+        {
+        GlobalArray<unsigned int> n_cluster_neigh(n_clusters, m_exec_conf);
+        m_n_cluster_neigh.swap(n_cluster_neigh);
+        TAG_ALLOCATION(m_n_cluster_neigh);
+        }
+
+    // group the list until it fits, doubling the number of entries per i cluster each time
+    bool overflowed = false;
+    do
+        {
+        const size_t n_entries = size_t(n_clusters) * m_cluster_nmax;
+        if (m_cluster_nlist.getNumElements() < n_entries)
+            {
+            GlobalArray<unsigned int> cluster_nlist(n_entries, m_exec_conf);
+            m_cluster_nlist.swap(cluster_nlist);
+            TAG_ALLOCATION(m_cluster_nlist);
+
+            GlobalArray<uint64_t> cluster_mask(n_entries, m_exec_conf);
+            m_cluster_mask.swap(cluster_mask);
+            TAG_ALLOCATION(m_cluster_mask);
+            }
+
+        m_cluster_overflow.resetFlags(0);
+
+            {
+            ArrayHandle<unsigned int> d_n_cluster_neigh(m_n_cluster_neigh,
+                                                        access_location::device,
+                                                        access_mode::overwrite);
+            ArrayHandle<unsigned int> d_cluster_nlist(m_cluster_nlist,
+                                                      access_location::device,
+                                                      access_mode::overwrite);
+            ArrayHandle<uint64_t> d_cluster_mask(m_cluster_mask,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<unsigned int> d_n_neigh(m_n_neigh,
+                                                access_location::device,
+                                                access_mode::read);
+            ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::read);
+            ArrayHandle<unsigned int> d_head_list(m_head_list,
+                                                  access_location::device,
+                                                  access_mode::read);
+
+            gpu_nlist_build_clusters(d_n_cluster_neigh.data,
+                                     d_cluster_nlist.data,
+                                     d_cluster_mask.data,
+                                     m_cluster_overflow.getDeviceFlags(),
+                                     d_n_neigh.data,
+                                     d_nlist.data,
+                                     d_head_list.data,
+                                     N,
+                                     m_cluster_nmax,
+                                     256);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        overflowed = m_cluster_overflow.readFlags() != 0;
+        if (overflowed)
+            m_cluster_nmax *= 2;
+        } while (overflowed);
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void export_NeighborListGPUCluster(py::module& m)
+    {
+    py::class_<NeighborListGPUCluster,
+               NeighborListGPUBinned,
+               std::shared_ptr<NeighborListGPUCluster>>(m, "NeighborListGPUCluster")
+        .def(py::init<std::shared_ptr<SystemDefinition>, Scalar>());
+    }
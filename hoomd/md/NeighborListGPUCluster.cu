@@ -0,0 +1,139 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborListGPUCluster.cuh"
+
+/*! \file NeighborListGPUCluster.cu
+    \brief Defines GPU kernel code for the cluster pair neighbor list
+*/
+
+//! Kernel that groups the per-particle neighbor list into cluster pairs
+/*! \param d_n_cluster_neigh Number of j clusters of each i cluster
+    \param d_cluster_nlist j clusters of each i cluster (cluster_nmax entries per i cluster)
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param d_overflow Set to 1 when an i cluster has more than cluster_nmax j clusters
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Per-particle neighbor list
+    \param d_head_list Indexes for reading \a d_nlist
+    \param N Number of local particles
+    \param n_clusters Number of i clusters
+    \param cluster_nmax Maximum number of j clusters per i cluster
+
+    One thread processes each i cluster. Bit a*gpu_nlist_cluster_size + b of a mask is set when
+    particle b of the j cluster is a neighbor of particle a of the i cluster. The mask inherits the
+    cutoffs, exclusions, and body filter of the per-particle list.
+*/
+__global__ void gpu_nlist_build_clusters_kernel(unsigned int* d_n_cluster_neigh,
+                                                unsigned int* d_cluster_nlist,
+                                                uint64_t* d_cluster_mask,
+                                                unsigned int* d_overflow,
+                                                const unsigned int* d_n_neigh,
+                                                const unsigned int* d_nlist,
+                                                const unsigned int* d_head_list,
+                                                const unsigned int N,
+                                                const unsigned int n_clusters,
+                                                const unsigned int cluster_nmax)
+    {
+    const unsigned int cluster = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cluster >= n_clusters)
+        return;
+
+    unsigned int* cluster_nlist = d_cluster_nlist + cluster * cluster_nmax;
+    uint64_t* cluster_mask = d_cluster_mask + cluster * cluster_nmax;
+    unsigned int n_entries = 0;
+    bool overflowed = false;
+
+    for (unsigned int a = 0; a < gpu_nlist_cluster_size; ++a)
+        {
+        const unsigned int idx = cluster * gpu_nlist_cluster_size + a;
+        if (idx >= N)
+            break;
+
+        const unsigned int n_neigh = d_n_neigh[idx];
+        const unsigned int head = d_head_list[idx];
+        for (unsigned int k = 0; k < n_neigh; ++k)
+            {
+            const unsigned int j = d_nlist[head + k];
+            const unsigned int j_cluster = j / gpu_nlist_cluster_size;
+            const uint64_t bit = uint64_t(1)
+                                 << (a * gpu_nlist_cluster_size + j % gpu_nlist_cluster_size);
+
+            // neighbors of the particles in a cluster are spatially close, search from the end
+            unsigned int entry = n_entries;
+            while (entry > 0 && cluster_nlist[entry - 1] != j_cluster)
+                entry--;
+
+            if (entry > 0)
+                {
+                cluster_mask[entry - 1] |= bit;
+                }
+            else if (n_entries < cluster_nmax)
+                {
+                cluster_nlist[n_entries] = j_cluster;
+                cluster_mask[n_entries] = bit;
+                n_entries++;
+                }
+            else
+                {
+                overflowed = true;
+                }
+            }
+        }
+
+    d_n_cluster_neigh[cluster] = n_entries;
+    if (overflowed)
+        *d_overflow = 1;
+    }
+
+/*! \param d_n_cluster_neigh Number of j clusters of each i cluster
+    \param d_cluster_nlist j clusters of each i cluster (cluster_nmax entries per i cluster)
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param d_overflow Set to 1 when an i cluster has more than cluster_nmax j clusters
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Per-particle neighbor list
+    \param d_head_list Indexes for reading \a d_nlist
+    \param N Number of local particles
+    \param cluster_nmax Maximum number of j clusters per i cluster
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_nlist_build_clusters(unsigned int* d_n_cluster_neigh,
+                                    unsigned int* d_cluster_nlist,
+                                    uint64_t* d_cluster_mask,
+                                    unsigned int* d_overflow,
+                                    const unsigned int* d_n_neigh,
+                                    const unsigned int* d_nlist,
+                                    const unsigned int* d_head_list,
+                                    const unsigned int N,
+                                    const unsigned int cluster_nmax,
+                                    const unsigned int block_size)
+    {
+    const unsigned int n_clusters = (N + gpu_nlist_cluster_size - 1) / gpu_nlist_cluster_size;
+    if (n_clusters == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_build_clusters_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(n_clusters / run_block_size + 1);
+
+    hipLaunchKernelGGL((gpu_nlist_build_clusters_kernel),
+                       dim3(grid),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_n_cluster_neigh,
+                       d_cluster_nlist,
+                       d_cluster_mask,
+                       d_overflow,
+                       d_n_neigh,
+                       d_nlist,
+                       d_head_list,
+                       N,
+                       n_clusters,
+                       cluster_nmax);
+
+    return hipSuccess;
+    }
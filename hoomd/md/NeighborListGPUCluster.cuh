@@ -0,0 +1,36 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBORLISTGPUCLUSTER_CUH__
+#define __NEIGHBORLISTGPUCLUSTER_CUH__
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+
+#include <stdint.h>
+
+/*! \file NeighborListGPUCluster.cuh
+    \brief Declares GPU kernel code for the cluster pair neighbor list
+*/
+
+//! Number of particles in a cluster
+/*! Cluster c holds the particles with indices c*gpu_nlist_cluster_size to
+    (c+1)*gpu_nlist_cluster_size - 1. The interaction mask of a cluster pair has one bit for each of
+    the gpu_nlist_cluster_size^2 particle pairs, so the cluster size is at most 8.
+*/
+const unsigned int gpu_nlist_cluster_size = 8;
+
+//! Kernel driver for gpu_nlist_build_clusters_kernel()
+hipError_t gpu_nlist_build_clusters(unsigned int* d_n_cluster_neigh,
+                                    unsigned int* d_cluster_nlist,
+                                    uint64_t* d_cluster_mask,
+                                    unsigned int* d_overflow,
+                                    const unsigned int* d_n_neigh,
+                                    const unsigned int* d_nlist,
+                                    const unsigned int* d_head_list,
+                                    const unsigned int N,
+                                    const unsigned int cluster_nmax,
+                                    const unsigned int block_size);
+
+#endif // __NEIGHBORLISTGPUCLUSTER_CUH__
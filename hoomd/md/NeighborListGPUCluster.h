@@ -0,0 +1,116 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborListGPUBinned.h"
+#include "hoomd/GPUFlags.h"
+
+#include <stdint.h>
+
+/*! \file NeighborListGPUCluster.h
+    \brief Declares the NeighborListGPUCluster class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTGPUCLUSTER_H__
+#define __NEIGHBORLISTGPUCLUSTER_H__
+
+//! Cluster pair neighbor list on the GPU
+/*! NeighborListGPUCluster builds the per-particle neighbor list with a cell list, as
+    NeighborListGPUBinned does, and groups it into pairs of clusters. Cluster c holds the
+    gpu_nlist_cluster_size consecutive particles starting at index c*gpu_nlist_cluster_size. The
+    particle sort places nearby particles in the same cluster.
+
+    For each i cluster of local particles, the cluster list stores the j clusters that hold at least
+    one neighbor and a mask of the particle pairs that are neighbors. Pair potentials evaluate a
+    whole cluster pair from shared memory, which replaces scattered per-pair loads with one load
+    per j particle and cluster pair (see gpu_compute_pair_forces_cluster_kernel()).
+
+    The cluster list is grouped lazily when a consumer requests it after the per-particle list has
+    been rebuilt. Consumers that read the per-particle list work unchanged.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListGPUCluster : public NeighborListGPUBinned
+    {
+    public:
+    //! Constructs the compute
+    NeighborListGPUCluster(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff);
+
+    //! Destructor
+    virtual ~NeighborListGPUCluster();
+
+    //! Get the number of j clusters of each i cluster
+    const GlobalArray<unsigned int>& getNClusterNeighArray()
+        {
+        updateClusters();
+        return m_n_cluster_neigh;
+        }
+
+    //! Get the j clusters of each i cluster
+    /*! j cluster \a k of i cluster \a c is at index c*getClusterNmax() + k.
+     */
+    const GlobalArray<unsigned int>& getClusterNListArray()
+        {
+        updateClusters();
+        return m_cluster_nlist;
+        }
+
+    //! Get the interaction mask of each cluster pair
+    /*! Bit a*gpu_nlist_cluster_size + b is set when particle b of the j cluster is a neighbor of
+        particle a of the i cluster.
+     */
+    const GlobalArray<uint64_t>& getClusterMaskArray()
+        {
+        updateClusters();
+        return m_cluster_mask;
+        }
+
+    //! Get the maximum number of j clusters per i cluster
+    unsigned int getClusterNmax()
+        {
+        updateClusters();
+        return m_cluster_nmax;
+        }
+
+    protected:
+    GlobalArray<unsigned int> m_n_cluster_neigh; //!< Number of j clusters of each i cluster
+    GlobalArray<unsigned int> m_cluster_nlist;   //!< j clusters of each i cluster
+    GlobalArray<uint64_t> m_cluster_mask;        //!< Interaction mask of each cluster pair
+    unsigned int m_cluster_nmax;                 //!< Maximum number of j clusters per i cluster
+    GPUFlags<unsigned int> m_cluster_overflow;   //!< Set when an i cluster overflows the list
+
+    /// True when the cluster list matches the per-particle list
+    bool m_clusters_valid = false;
+
+    //! Builds the neighbor list
+    virtual void buildNlist(uint64_t timestep);
+
+    //! The cluster masks are built from the filtered per-particle list
+    virtual bool supportsExclusionMasks()
+        {
+        return false;
+        }
+
+    //! Group the per-particle neighbor list into cluster pairs
+    void buildClusters();
+
+    //! Group the cluster list if the per-particle list has changed
+    void updateClusters()
+        {
+        if (!m_clusters_valid)
+            {
+            buildClusters();
+            m_clusters_valid = true;
+            }
+        }
+    };
+
+//! Exports NeighborListGPUCluster to python
+void export_NeighborListGPUCluster(pybind11::module& m);
+
+#endif
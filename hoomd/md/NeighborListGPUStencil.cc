@@ -319,6 +319,7 @@ void NeighborListGPUStencil::buildNlist(uint64_t timestep)
                               m_r_buff,
                               m_pdata->getNTypes(),
                               m_cl->getGhostWidth(),
+                              m_cl->getLeesEdwardsShift(),
                               m_filter_body,
                               m_diameter_shift,
                               threads_per_particle,
@@ -41,6 +41,7 @@
     \param r_buff The maximum radius for which to include particles as neighbors
     \param ntypes Number of particle types
     \param ghost_width Width of ghost cell layer
+    \param lees_edwards_shift Shift of the cell columns across the +y (x) and -y (y) boundary
 
     \note optimized for Kepler
 */
@@ -68,7 +69,8 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int* d_nlist,
                                                  const Scalar* d_r_cut,
                                                  const Scalar r_buff,
                                                  const unsigned int ntypes,
-                                                 const Scalar3 ghost_width)
+                                                 const Scalar3 ghost_width,
+                                                 const int2 lees_edwards_shift)
     {
     bool filter_body = flags & 1;
     bool diameter_shift = flags & 2;
@@ -182,6 +184,13 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int* d_nlist,
                 int skb = kb + __scalar_as_int(stencil.z);
                 cell_dist2 = stencil.w;
 
+                // shift the columns across the y boundary by the Lees-Edwards offset
+                if (periodic.y && periodic.x && (sjb >= (int)ci.getH() || sjb < 0))
+                    {
+                    sib += (sjb >= (int)ci.getH()) ? lees_edwards_shift.x : lees_edwards_shift.y;
+                    sib %= (int)ci.getW();
+                    }
+
                 // wrap through the boundary
                 if (sib >= (int)ci.getW() && periodic.x)
                     sib -= ci.getW();
@@ -339,6 +348,7 @@ inline void stencil_launcher(unsigned int* d_nlist,
                              const Scalar r_buff,
                              const unsigned int ntypes,
                              const Scalar3& ghost_width,
+                             const int2 lees_edwards_shift,
                              bool filter_body,
                              bool diameter_shift,
                              const unsigned int threads_per_particle,
@@ -388,7 +398,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               lees_edwards_shift);
             }
         else if (!diameter_shift && filter_body)
             {
@@ -427,7 +438,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               lees_edwards_shift);
             }
         else if (diameter_shift && !filter_body)
             {
@@ -466,7 +478,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               lees_edwards_shift);
             }
         else if (diameter_shift && filter_body)
             {
@@ -505,7 +518,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               lees_edwards_shift);
             }
         }
     else
@@ -534,6 +548,7 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                       r_buff,
                                       ntypes,
                                       ghost_width,
+                                      lees_edwards_shift,
                                       filter_body,
                                       diameter_shift,
                                       threads_per_particle,
@@ -567,6 +582,7 @@ inline void stencil_launcher<min_threads_per_particle / 2>(unsigned int* d_nlist
                                                            const Scalar r_buff,
                                                            const unsigned int ntypes,
                                                            const Scalar3& ghost_width,
+                                                           const int2 lees_edwards_shift,
                                                            bool filter_body,
                                                            bool diameter_shift,
                                                            const unsigned int threads_per_particle,
@@ -598,6 +614,7 @@ hipError_t gpu_compute_nlist_stencil(unsigned int* d_nlist,
                                      const Scalar r_buff,
                                      const unsigned int ntypes,
                                      const Scalar3& ghost_width,
+                                     const int2 lees_edwards_shift,
                                      bool filter_body,
                                      bool diameter_shift,
                                      const unsigned int threads_per_particle,
@@ -627,6 +644,7 @@ hipError_t gpu_compute_nlist_stencil(unsigned int* d_nlist,
                                                r_buff,
                                                ntypes,
                                                ghost_width,
+                                               lees_edwards_shift,
                                                filter_body,
                                                diameter_shift,
                                                threads_per_particle,
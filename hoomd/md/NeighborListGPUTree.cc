@@ -23,6 +23,7 @@ namespace py = pybind11;
  */
 NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
     : NeighborListGPU(sysdef, r_buff), m_type_bits(1), m_lbvh_errors(m_exec_conf), m_n_images(0),
+      m_combined(false), m_max_refits(4), m_n_refits(0), m_refit_valid(false),
       m_types_allocated(false), m_box_changed(true), m_max_num_changed(true), m_max_types(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListGPUTree" << std::endl;
@@ -30,6 +31,10 @@ NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysde
         .connect<NeighborListGPUTree, &NeighborListGPUTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal()
         .connect<NeighborListGPUTree, &NeighborListGPUTree::slotMaxNumChanged>(this);
+    m_pdata->getParticleSortSignal()
+        .connect<NeighborListGPUTree, &NeighborListGPUTree::slotParticlesReordered>(this);
+    m_pdata->getGhostParticlesRemovedSignal()
+        .connect<NeighborListGPUTree, &NeighborListGPUTree::slotParticlesReordered>(this);
 
     hipDeviceProp_t dev_prop = m_exec_conf->dev_prop;
     unsigned int warp_size = dev_prop.warpSize;
@@ -67,6 +72,10 @@ NeighborListGPUTree::~NeighborListGPUTree()
         .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal()
         .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotMaxNumChanged>(this);
+    m_pdata->getParticleSortSignal()
+        .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotParticlesReordered>(this);
+    m_pdata->getGhostParticlesRemovedSignal()
+        .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotParticlesReordered>(this);
 
     // destroy all of the created streams
     for (auto stream = m_streams.begin(); stream != m_streams.end(); ++stream)
@@ -80,8 +89,11 @@ NeighborListGPUTree::~NeighborListGPUTree()
  *
  * First, memory is reallocated based on the number of particles and types.
  * The traversal images are also updated if the box has changed. One LBVH is then
- * built for each particle type using buildTree(), and these LBVHs are traversed in
- * traverseTree().
+ * built for each particle type (or one for all types) using buildTree(), and these LBVHs are
+ * traversed in traverseTree().
+ *
+ * When the particle order has not changed since the last build, the LBVHs are refit with
+ * refitTree() instead, up to the maximum number of consecutive refits.
  */
 void NeighborListGPUTree::buildNlist(uint64_t timestep)
     {
@@ -106,6 +118,9 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
         GPUArray<unsigned int> traverse_order(m_pdata->getMaxN(), m_exec_conf);
         m_traverse_order.swap(traverse_order);
 
+        GPUArray<unsigned int> refit_locks(m_pdata->getMaxN(), m_exec_conf);
+        m_refit_locks.swap(refit_locks);
+
         // all done with the particle data reallocation
         m_max_num_changed = false;
         }
@@ -121,6 +136,9 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
             GPUArray<unsigned int> type_last(m_pdata->getNTypes(), m_exec_conf);
             m_type_last.swap(type_last);
 
+            GPUArray<Scalar> type_rlist(m_pdata->getNTypes(), m_exec_conf);
+            m_type_rlist.swap(type_rlist);
+
             m_lbvhs.resize(m_pdata->getNTypes());
             m_traversers.resize(m_pdata->getNTypes());
             m_streams.resize(m_pdata->getNTypes());
@@ -150,6 +168,7 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
 
         // all done with the type reallocation
         m_types_allocated = true;
+        m_refit_valid = false;
         }
 
     // update properties that depend on the box
@@ -185,10 +204,20 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
         m_traverse_tuner->setPeriod(m_mark_tuner->getPeriod());
         }
 
-    // build the tree
+    // build the tree, or refit it if the particles are in the same order as the last build
     if (m_prof)
         m_prof->push(m_exec_conf, "build");
-    buildTree();
+    if (m_refit_valid && m_n_refits < m_max_refits)
+        {
+        refitTree();
+        ++m_n_refits;
+        }
+    else
+        {
+        buildTree();
+        m_n_refits = 0;
+        m_refit_valid = true;
+        }
     if (m_prof)
         m_prof->pop(m_exec_conf);
 
@@ -201,7 +230,8 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
     }
 
 /*!
- * Builds the LBVHs by first sorting the particles by type (to make one LBVH per type).
+ * Builds the LBVHs by first sorting the particles by type (to make one LBVH per type, or one LBVH
+ * spanning all types when combined).
  * This method also puts the particles into the right order for traversal, and it prepares
  * each LBVH traverser so that subsequent calls to traverse can safely use the cached version
  * of the traverser internal data.
@@ -369,7 +399,7 @@ void NeighborListGPUTree::buildTree()
         m_count_tuner->end();
         }
 
-    // build a lbvh for each type
+    // determine the range of sorted particles in each lbvh
         {
         ArrayHandle<unsigned int> h_type_first(m_type_first,
                                                access_location::host,
@@ -378,6 +408,32 @@ void NeighborListGPUTree::buildTree()
                                               access_location::host,
                                               access_mode::read);
 
+        m_tree_first.assign(m_pdata->getNTypes(), NeighborListTypeSentinel);
+        m_tree_last.assign(m_pdata->getNTypes(), NeighborListTypeSentinel);
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            {
+            const unsigned int first = h_type_first.data[i];
+            const unsigned int last = h_type_last.data[i];
+            if (first == NeighborListTypeSentinel)
+                continue;
+
+            // the combined lbvh spans all types, which are contiguous after the sort
+            const unsigned int tree = (m_combined) ? 0 : i;
+            if (m_tree_first[tree] == NeighborListTypeSentinel)
+                {
+                m_tree_first[tree] = first;
+                m_tree_last[tree] = last;
+                }
+            else
+                {
+                m_tree_first[tree] = std::min(m_tree_first[tree], first);
+                m_tree_last[tree] = std::max(m_tree_last[tree], last);
+                }
+            }
+        }
+
+    // build a lbvh for each type
+        {
         ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
                                    access_location::device,
                                    access_mode::read);
@@ -390,8 +446,8 @@ void NeighborListGPUTree::buildTree()
         // first, setup memory (these do not actually execute in a stream)
         for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
             {
-            const unsigned int first = h_type_first.data[i];
-            const unsigned int last = h_type_last.data[i];
+            const unsigned int first = m_tree_first[i];
+            const unsigned int last = m_tree_last[i];
             if (first != NeighborListTypeSentinel)
                 {
                 m_lbvhs[i]->setup(d_pos.data,
@@ -413,8 +469,8 @@ void NeighborListGPUTree::buildTree()
 
         for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
             {
-            const unsigned int first = h_type_first.data[i];
-            const unsigned int last = h_type_last.data[i];
+            const unsigned int first = m_tree_first[i];
+            const unsigned int last = m_tree_last[i];
 
             if (first != NeighborListTypeSentinel)
                 {
@@ -446,9 +502,6 @@ void NeighborListGPUTree::buildTree()
     // put particles in primitive order for traversal and compress the lbvhs so that the data is
     // ready for traversal
         {
-        ArrayHandle<unsigned int> h_type_first(m_type_first,
-                                               access_location::host,
-                                               access_mode::read);
         ArrayHandle<unsigned int> d_traverse_order(m_traverse_order,
                                                    access_location::device,
                                                    access_mode::overwrite);
@@ -461,7 +514,7 @@ void NeighborListGPUTree::buildTree()
             const unsigned int Ni = m_lbvhs[i]->getN();
             if (Ni > 0)
                 {
-                const unsigned int first = h_type_first.data[i];
+                const unsigned int first = m_tree_first[i];
                 auto d_primitives = m_lbvhs[i]->getPrimitives();
                 m_copy_tuner->begin();
                 gpu_nlist_copy_primitives(d_traverse_order.data + first,
@@ -482,7 +535,7 @@ void NeighborListGPUTree::buildTree()
             {
             if (m_lbvhs[i]->getN() == 0)
                 continue;
-            m_traversers[i]->setup(d_sorted_indexes.data + h_type_first.data[i],
+            m_traversers[i]->setup(d_sorted_indexes.data + m_tree_first[i],
                                    *(*m_lbvhs[i]).get(),
                                    m_streams[i]);
             }
@@ -490,6 +543,65 @@ void NeighborListGPUTree::buildTree()
         }
     }
 
+/*!
+ * The LBVHs from the last call to buildTree() are refit to the current particle positions. The
+ * particles must be in the same order as for that build, so the type sort, the Morton code sort,
+ * and the hierarchy generation are all skipped. The traversers must be set up again afterwards
+ * because they hold a compressed copy of the bounding boxes.
+ */
+void NeighborListGPUTree::refitTree()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                               access_location::device,
+                                               access_mode::read);
+
+    // the positions are saved here by the mark kernel during a build
+        {
+        ArrayHandle<Scalar4> d_last_pos(m_last_pos,
+                                        access_location::device,
+                                        access_mode::overwrite);
+        hipMemcpy(d_last_pos.data,
+                  d_pos.data,
+                  sizeof(Scalar4) * m_pdata->getN(),
+                  hipMemcpyDeviceToDevice);
+        }
+
+    // refit each lbvh in its own stream, the locks of the lbvhs do not overlap
+        {
+        ArrayHandle<unsigned int> d_refit_locks(m_refit_locks,
+                                                access_location::device,
+                                                access_mode::overwrite);
+
+        hipDeviceSynchronize();
+        const unsigned int block_size = m_build_tuner->getParam();
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            {
+            if (m_lbvhs[i]->getN() == 0)
+                continue;
+            m_lbvhs[i]->refit(d_pos.data,
+                              d_sorted_indexes.data + m_tree_first[i],
+                              d_refit_locks.data + m_tree_first[i],
+                              m_streams[i],
+                              block_size);
+            }
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        hipDeviceSynchronize();
+        }
+
+    // compress the refit lbvhs for traversal
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        {
+        if (m_lbvhs[i]->getN() == 0)
+            continue;
+        m_traversers[i]->setup(d_sorted_indexes.data + m_tree_first[i],
+                               *(*m_lbvhs[i]).get(),
+                               m_streams[i]);
+        }
+    hipDeviceSynchronize();
+    }
+
 /*!
  * Traversal is performed for each particle type against all LBVHs. This is done using one CUDA
  * stream for each particle type, and traversal of each LBVH is loaded into the stream so that there
@@ -503,6 +615,12 @@ void NeighborListGPUTree::buildTree()
  */
 void NeighborListGPUTree::traverseTree()
     {
+    if (m_combined)
+        {
+        traverseCombinedTree();
+        return;
+        }
+
     ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_conditions(m_conditions,
@@ -575,7 +693,7 @@ void NeighborListGPUTree::traverseTree()
             LBVHTraverserWrapper::TraverserArgs args;
 
             // the transform operator is for the particles in this LBVH (j)
-            args.map = d_sorted_indexes.data + h_type_first.data[j];
+            args.map = d_sorted_indexes.data + m_tree_first[j];
 
             // particles
             args.positions = d_pos.data;
@@ -587,6 +705,7 @@ void NeighborListGPUTree::traverseTree()
             args.rcut = rcut;
             args.rlist = rlist;
             args.box = box;
+            args.r_cut = NULL;
 
             // neighbor list write op for this type
             args.neigh_list = d_nlist.data;
@@ -608,6 +727,114 @@ void NeighborListGPUTree::traverseTree()
     hipDeviceSynchronize();
     }
 
+/*!
+ * The combined LBVH holds the particles of all types, so it is traversed once for all particles.
+ * The search radius of each particle is the largest cutoff of its type (including the buffer and
+ * the diameter shift), and the cutoff of each type pair is checked when refining the intersected
+ * particles. The maximum number of neighbors and the overflow flag are selected by type.
+ */
+void NeighborListGPUTree::traverseCombinedTree()
+    {
+    // search radius of each type
+        {
+        ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_type_rlist(m_type_rlist,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            {
+            Scalar rcut_max(0.0);
+            for (unsigned int j = 0; j < m_pdata->getNTypes(); ++j)
+                {
+                rcut_max = std::max(rcut_max, h_r_cut.data[m_typpair_idx(i, j)]);
+                }
+
+            if (rcut_max > Scalar(0))
+                {
+                h_type_rlist.data[i] = rcut_max + m_r_buff;
+                if (m_diameter_shift)
+                    h_type_rlist.data[i] += m_d_max - Scalar(1.0);
+                }
+            else
+                {
+                // this type does not interact, skip its search spheres
+                h_type_rlist.data[i] = Scalar(-1.0);
+                }
+            }
+        }
+
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_conditions(m_conditions,
+                                           access_location::device,
+                                           access_mode::readwrite);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+
+    ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                               access_location::device,
+                                               access_mode::read);
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar> d_diam(m_pdata->getDiameters(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_traverse_order(m_traverse_order,
+                                               access_location::device,
+                                               access_mode::read);
+    ArrayHandle<Scalar3> d_image_list(m_image_list, access_location::device, access_mode::read);
+
+    ArrayHandle<Scalar> d_r_cut(m_r_cut, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_type_rlist(m_type_rlist, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_Nmax(m_Nmax, access_location::device, access_mode::read);
+
+    // clear the neighbor counts
+    hipMemset(d_n_neigh.data, 0, sizeof(unsigned int) * m_pdata->getN());
+
+    // nothing to traverse if there are no particles in the lbvh
+    if (m_lbvhs[0]->getN() == 0)
+        return;
+
+    // pack args to the traverser
+    LBVHTraverserWrapper::TraverserArgs args;
+    args.map = d_sorted_indexes.data + m_tree_first[0];
+
+    // particles
+    args.positions = d_pos.data;
+    args.bodies = (m_filter_body) ? d_body.data : NULL;
+    args.diams = (m_diameter_shift) ? d_diam.data : NULL;
+    args.order = d_traverse_order.data + m_tree_first[0];
+    args.N = m_tree_last[0] - m_tree_first[0];
+    args.Nown = m_pdata->getN();
+    args.rcut = Scalar(0.0);
+    args.rlist = Scalar(0.0);
+    args.box = m_pdata->getBox();
+
+    // per-type cutoffs
+    args.r_cut = d_r_cut.data;
+    args.type_rlist = d_type_rlist.data;
+    args.typpair_idx = m_typpair_idx;
+    args.r_buff = m_r_buff;
+    args.type_max_neigh = d_Nmax.data;
+
+    // neighbor list write op for all types
+    args.neigh_list = d_nlist.data;
+    args.nneigh = d_n_neigh.data;
+    args.new_max_neigh = d_conditions.data;
+    args.first_neigh = d_head_list.data;
+    args.max_neigh = 0;
+
+    m_traverse_tuner->begin();
+    m_traversers[0]->traverse(args,
+                              *(*m_lbvhs[0]).get(),
+                              d_image_list.data,
+                              (unsigned int)m_image_list.getNumElements(),
+                              m_streams[0],
+                              m_traverse_tuner->getParam());
+    m_traverse_tuner->end();
+    hipDeviceSynchronize();
+    }
+
 /*!
  * (Re-)computes the translation vectors for traversing the BVH tree. At most, there are 27
  * translation vectors when the simulation box is 3D periodic (self-image included). In 2D, there
@@ -676,5 +903,11 @@ void export_NeighborListGPUTree(py::module& m)
     py::class_<NeighborListGPUTree, NeighborListGPU, std::shared_ptr<NeighborListGPUTree>>(
         m,
         "NeighborListGPUTree")
-        .def(py::init<std::shared_ptr<SystemDefinition>, Scalar>());
+        .def(py::init<std::shared_ptr<SystemDefinition>, Scalar>())
+        .def_property("combined",
+                      &NeighborListGPUTree::getCombined,
+                      &NeighborListGPUTree::setCombined)
+        .def_property("max_refits",
+                      &NeighborListGPUTree::getMaxRefits,
+                      &NeighborListGPUTree::setMaxRefits);
     }
@@ -617,6 +617,163 @@ template<bool use_body, bool use_diam> struct ParticleQueryOp
     const BoxDim box;           //!< Box dimensions
     };
 
+//! Neighbor list particle query operation for the combined LBVH of all types.
+/*!
+ * \tparam use_body If true, use the body fields during query.
+ * \tparam use_diam If true, use the diameter fields during query.
+ *
+ * This operation is the same as ParticleQueryOp, except that the search radius of each sphere is
+ * set by the type of the particle, and the cutoff of the type pair is checked in refine(). It is
+ * used to traverse one LBVH that holds the particles of all types.
+ */
+template<bool use_body, bool use_diam> struct TypedParticleQueryOp
+    {
+    //! Constructor
+    /*!
+     * \param positions_ Particle positions.
+     * \param bodies_ Particle body tags.
+     * \param diams_ Particle diameters.
+     * \param map_ Map of the particle indexes to traverse.
+     * \param N_ Number of particles (total).
+     * \param Nown_ Number of locally owned particles.
+     * \param r_cut_ Cutoff radius of each type pair.
+     * \param type_rlist_ Search radius of each type (may include shifting).
+     * \param typpair_idx_ Indexer for \a r_cut_.
+     * \param r_buff_ Buffer width.
+     * \param box_ Simulation box.
+     */
+    TypedParticleQueryOp(const Scalar4* positions_,
+                         const unsigned int* bodies_,
+                         const Scalar* diams_,
+                         const unsigned int* map_,
+                         unsigned int N_,
+                         unsigned int Nown_,
+                         const Scalar* r_cut_,
+                         const Scalar* type_rlist_,
+                         const Index2D& typpair_idx_,
+                         const Scalar r_buff_,
+                         const BoxDim& box_)
+        : positions(positions_), bodies(bodies_), diams(diams_), map(map_), N(N_), Nown(Nown_),
+          r_cut(r_cut_), type_rlist(type_rlist_), typpair_idx(typpair_idx_), r_buff(r_buff_),
+          box(box_)
+        {
+        }
+
+    //! Data stored per thread for traversal
+    struct ThreadData
+        {
+        DEVICE ThreadData(Scalar3 position_,
+                          int idx_,
+                          unsigned int type_,
+                          unsigned int body_,
+                          Scalar diam_)
+            : position(position_), idx(idx_), type(type_), body(body_), diam(diam_)
+            {
+            }
+
+        Scalar3 position;  //!< Particle position
+        int idx;           //!< True particle index
+        unsigned int type; //!< Particle type
+        unsigned int body; //!< Particle body tag (may be invalid)
+        Scalar diam;       //!< Particle diameter (may be invalid)
+        };
+
+    // specify that the traversal Volume is a bounding sphere
+    typedef SkippableBoundingSphere Volume;
+
+    //! Loads the per-thread data
+    DEVICE ThreadData setup(const unsigned int idx) const
+        {
+        const unsigned int pidx = map[idx];
+
+        const Scalar4 position = positions[pidx];
+        const Scalar3 r = make_scalar3(position.x, position.y, position.z);
+
+        unsigned int body(0xffffffff);
+        if (use_body)
+            {
+            body = __ldg(bodies + pidx);
+            }
+        Scalar diam(1.0);
+        if (use_diam)
+            {
+            diam = __ldg(diams + pidx);
+            }
+
+        return ThreadData(r, pidx, __scalar_as_int(position.w), body, diam);
+        }
+
+    //! Return the traversal volume subject to a translation
+    /*!
+     * The search sphere is made to be skipped if this is a ghost particle or if its type does not
+     * interact with any type.
+     */
+    DEVICE Volume get(const ThreadData& q, const Scalar3& image) const
+        {
+        return Volume(q.position + image, (q.idx < Nown) ? __ldg(type_rlist + q.type) : -1.0);
+        }
+
+    //! Perform the overlap test with the LBVH
+    DEVICE bool overlap(const Volume& v, const neighbor::BoundingBox& box) const
+        {
+        return v.overlap(box);
+        }
+
+    //! Refine the rough overlap test with a primitive
+    /*!
+     * \param q The current thread data.
+     * \param primitive Index of the intersected primitive.
+     * \returns True If the particles are within the search radius of their type pair.
+     *
+     * In addition to the self, body, and diameter filtering of ParticleQueryOp::refine(), the
+     * distance is always checked against the cutoff of the type pair because the sphere is sized
+     * for the largest cutoff of the type.
+     */
+    DEVICE bool refine(const ThreadData& q, const int primitive) const
+        {
+        if (q.idx == primitive)
+            return false;
+
+        // body exclusion
+        if (use_body && q.body != 0xffffffff && q.body == __ldg(bodies + primitive))
+            return false;
+
+        // skip type pairs that do not interact
+        const Scalar4 position = positions[primitive];
+        Scalar rc = __ldg(r_cut + typpair_idx(q.type, __scalar_as_int(position.w)));
+        if (rc <= Scalar(0))
+            return false;
+        rc += r_buff;
+
+        // compute factor to add to base rc
+        if (use_diam)
+            rc += (q.diam + __ldg(diams + primitive)) * Scalar(0.5) - Scalar(1.0);
+
+        // compute distance and wrap back into box
+        const Scalar3 r = make_scalar3(position.x, position.y, position.z);
+        const Scalar3 dr = box.minImage(r - q.position);
+        return dot(dr, dr) <= rc * rc;
+        }
+
+    //! Get the number of primitives
+    __host__ DEVICE unsigned int size() const
+        {
+        return N;
+        }
+
+    const Scalar4* positions;   //!< Particle positions
+    const unsigned int* bodies; //!< Particle bodies
+    const Scalar* diams;        //!< Particle diameters
+    const unsigned int* map;    //!< Mapping of particles to read
+    unsigned int N;             //!< Total number of particles in map
+    unsigned int Nown;          //!< Number of particles owned by the local rank
+    const Scalar* r_cut;        //!< Cutoff radius of each type pair
+    const Scalar* type_rlist;   //!< Search radius of each type
+    const Index2D typpair_idx;  //!< Indexer for r_cut
+    Scalar r_buff;              //!< Buffer width
+    const BoxDim box;           //!< Box dimensions
+    };
+
 //! Operation to write the neighbor list
 /*!
  * The neighbor list is assumed to be aligned to multiples of 4. This enables
@@ -778,6 +935,139 @@ struct NeighborListOp
     unsigned int max_neigh;          //!< Maximum number of neighbors allocated
     };
 
+//! Operation to write the neighbor list of particles of any type
+/*!
+ * This operation is the same as NeighborListOp, except that the maximum number of neighbors and the
+ * overflow flag are selected by the type of the particle. It is used with TypedParticleQueryOp.
+ */
+struct TypedNeighborListOp : public NeighborListOp
+    {
+    //! Constructor
+    /*!
+     * \param neigh_list_ Neighbor list (aligned to multiple of 4)
+     * \param nneigh_ Neighbor of neighbors per particle
+     * \param new_max_neigh_ Maximum number of neighbors to allocate for each type if overflow
+     * occurs.
+     * \param first_neigh_ First index for the current particle index in the neighbor list.
+     * \param type_max_neigh_ Maximum number of neighbors to allow per particle of each type.
+     */
+    TypedNeighborListOp(unsigned int* neigh_list_,
+                        unsigned int* nneigh_,
+                        unsigned int* new_max_neigh_,
+                        const unsigned int* first_neigh_,
+                        const unsigned int* type_max_neigh_)
+        : NeighborListOp(neigh_list_, nneigh_, new_max_neigh_, first_neigh_, 0),
+          type_max_neigh(type_max_neigh_)
+        {
+        }
+
+    //! Thread-local data, with the type and the maximum number of neighbors of the particle
+    struct ThreadData : public NeighborListOp::ThreadData
+        {
+        DEVICE ThreadData(const NeighborListOp::ThreadData& t,
+                          const unsigned int type_,
+                          const unsigned int max_neigh_)
+            : NeighborListOp::ThreadData(t), type(type_), max_neigh(max_neigh_)
+            {
+            }
+
+        unsigned int type;      //!< Type of the particle
+        unsigned int max_neigh; //!< Maximum number of neighbors of the particle
+        };
+
+    //! Setup the thread data
+    template<class QueryDataT>
+    DEVICE ThreadData setup(const unsigned int idx, const QueryDataT& q) const
+        {
+        return ThreadData(NeighborListOp::setup(idx, q), q.type, __ldg(type_max_neigh + q.type));
+        }
+
+    //! Processes a newly intersected primitive.
+    DEVICE void process(ThreadData& t, const int primitive) const
+        {
+        if (t.num_neigh < t.max_neigh)
+            {
+            const unsigned int offset = t.num_neigh % 4;
+            t.stack[offset] = primitive;
+            if (offset == 3)
+                {
+                neigh_list[(t.first + t.num_neigh) / 4]
+                    = make_uint4(t.stack[0], t.stack[1], t.stack[2], t.stack[3]);
+                }
+            }
+        ++t.num_neigh;
+        }
+
+    //! Finish the output job once the thread is ready to terminate.
+    DEVICE void finalize(const ThreadData& t) const
+        {
+        nneigh[t.idx] = t.num_neigh;
+        if (t.num_neigh > t.max_neigh)
+            {
+            atomicMax(new_max_neigh + t.type, t.num_neigh);
+            }
+        else if (t.num_neigh % 4 != 0)
+            {
+            neigh_list[(t.first + t.num_neigh - 1) / 4]
+                = make_uint4(t.stack[0], t.stack[1], t.stack[2], t.stack[3]);
+            }
+        }
+
+    const unsigned int* type_max_neigh; //!< Maximum number of neighbors of each type
+    };
+
+//! Kernel to refit an LBVH to the current positions of its primitives
+/*!
+ * \param tree LBVH to refit.
+ * \param insert Insert operation that gives the bounding box of each primitive.
+ * \param locks Counter for each internal node, zeroed before the launch.
+ * \param N Number of primitives in the LBVH.
+ *
+ * One thread per leaf computes the leaf bounding box and then walks up the hierarchy. The first
+ * thread to reach an internal node stops, and the second one merges the boxes of both children, so
+ * each internal node is processed once after both of its children.
+ */
+__global__ void gpu_nlist_refit_kernel(const neighbor::LBVHData tree,
+                                       const PointMapInsertOp insert,
+                                       unsigned int* locks,
+                                       const unsigned int N)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    // leaves are stored after the N-1 internal nodes
+    int node = (N - 1) + idx;
+    const neighbor::BoundingBox leaf = insert.get(tree.primitive[idx]);
+    float3 lo = leaf.lo;
+    float3 hi = leaf.hi;
+    tree.lo[node] = lo;
+    tree.hi[node] = hi;
+
+    while (node != tree.root)
+        {
+        const int child = node;
+        node = tree.parent[node];
+
+        // make the box of this child visible before the sibling can read it
+        __threadfence();
+        if (atomicAdd(locks + node, 1) == 0)
+            return;
+
+        const int sibling = (tree.left[node] == child) ? tree.right[node] : tree.left[node];
+        const volatile float* sibling_lo = (const volatile float*)(tree.lo + sibling);
+        const volatile float* sibling_hi = (const volatile float*)(tree.hi + sibling);
+        lo = make_float3(fminf(lo.x, sibling_lo[0]),
+                         fminf(lo.y, sibling_lo[1]),
+                         fminf(lo.z, sibling_lo[2]));
+        hi = make_float3(fmaxf(hi.x, sibling_hi[0]),
+                         fmaxf(hi.y, sibling_hi[1]),
+                         fmaxf(hi.z, sibling_hi[2]));
+        tree.lo[node] = lo;
+        tree.hi[node] = hi;
+        }
+    }
+
 //! Host function to convert a double to a float in round-down mode
 float double2float_rd(double x)
     {
@@ -856,6 +1146,43 @@ void LBVHWrapper::build(const Scalar4* points,
     lbvh_->build(neighbor::LBVH::LaunchParameters(block_size, stream), insert, lof, hif);
     }
 
+/*!
+ * \param points Particle positions
+ * \param map Mapping of particles for insertion (same as for the last build)
+ * \param locks Scratch counters, at least one per internal node
+ * \param stream CUDA stream for execution
+ * \param block_size CUDA block size for execution
+ *
+ * The hierarchy of the last build is kept, and only the bounding boxes of the
+ * nodes are updated to enclose the current positions. The particles must be
+ * in the same order as for the last build.
+ */
+void LBVHWrapper::refit(const Scalar4* points,
+                        const unsigned int* map,
+                        unsigned int* locks,
+                        hipStream_t stream,
+                        unsigned int block_size)
+    {
+    const unsigned int N = lbvh_->getN();
+    if (N == 0)
+        return;
+
+    if (N > 1)
+        hipMemsetAsync(locks, 0, sizeof(unsigned int) * (N - 1), stream);
+
+    PointMapInsertOp insert(points, map, N);
+    const unsigned int num_blocks = (N + block_size - 1) / block_size;
+    hipLaunchKernelGGL((gpu_nlist_refit_kernel),
+                       dim3(num_blocks),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       lbvh_->data(),
+                       insert,
+                       locks,
+                       N);
+    }
+
 unsigned int LBVHWrapper::getN() const
     {
     return lbvh_->getN();
@@ -894,6 +1221,52 @@ void LBVHTraverserWrapper::setup(const unsigned int* map, neighbor::LBVH& lbvh,
     trav_->setup(stream, lbvh, mapop);
     }
 
+/*!
+ * \param trav LBVH traverser
+ * \param args Pack of traversal arguments used to build operations
+ * \param lbvh LBVH to traverse
+ * \param translate Image list operation
+ * \param map Map transform operation
+ * \param stream CUDA stream for execution
+ * \param block_size CUDA block size for execution
+ *
+ * Traverse the combined LBVH of all types with the per-type query and output
+ * operations.
+ */
+template<bool use_body, bool use_diam>
+static void traverse_typed(neighbor::LBVHTraverser& trav,
+                           LBVHTraverserWrapper::TraverserArgs& args,
+                           neighbor::LBVH& lbvh,
+                           const neighbor::ImageListOp<Scalar3>& translate,
+                           const neighbor::MapTransformOp& map,
+                           hipStream_t stream,
+                           unsigned int block_size)
+    {
+    TypedNeighborListOp nlist_op(args.neigh_list,
+                                 args.nneigh,
+                                 args.new_max_neigh,
+                                 args.first_neigh,
+                                 args.type_max_neigh);
+
+    TypedParticleQueryOp<use_body, use_diam> query(args.positions,
+                                                   use_body ? args.bodies : NULL,
+                                                   use_diam ? args.diams : NULL,
+                                                   args.order,
+                                                   args.N,
+                                                   args.Nown,
+                                                   args.r_cut,
+                                                   args.type_rlist,
+                                                   args.typpair_idx,
+                                                   args.r_buff,
+                                                   args.box);
+    trav.traverse(neighbor::LBVHTraverser::LaunchParameters(block_size, stream),
+                  lbvh,
+                  query,
+                  nlist_op,
+                  translate,
+                  map);
+    }
+
 /*!
  * \param args Pack of traversal arguments used to build operations
  * \param lbvh LBVH to traverse
@@ -930,6 +1303,20 @@ void LBVHTraverserWrapper::traverse(TraverserArgs& args,
 
     neighbor::ImageListOp<Scalar3> translate(images, Nimages);
 
+    // the combined LBVH of all types checks the cutoff of each type pair
+    if (args.r_cut != NULL)
+        {
+        if (args.bodies == NULL && args.diams == NULL)
+            traverse_typed<false, false>(*trav_, args, lbvh, translate, map, stream, block_size);
+        else if (args.bodies != NULL && args.diams == NULL)
+            traverse_typed<true, false>(*trav_, args, lbvh, translate, map, stream, block_size);
+        else if (args.bodies == NULL && args.diams != NULL)
+            traverse_typed<false, true>(*trav_, args, lbvh, translate, map, stream, block_size);
+        else
+            traverse_typed<true, true>(*trav_, args, lbvh, translate, map, stream, block_size);
+        return;
+        }
+
     if (args.bodies == NULL && args.diams == NULL)
         {
         ParticleQueryOp<false, false> query(args.positions,
@@ -87,6 +87,13 @@ class LBVHWrapper
                hipStream_t stream,
                unsigned int block_size);
 
+    //! Refit the LBVH to the current positions
+    void refit(const Scalar4* points,
+               const unsigned int* map,
+               unsigned int* locks,
+               hipStream_t stream,
+               unsigned int block_size);
+
     //! Get the underlying LBVH
     std::shared_ptr<neighbor::LBVH> get()
         {
@@ -132,6 +139,13 @@ class LBVHTraverserWrapper
         Scalar rlist;
         BoxDim box;
 
+        // per-type cutoffs to traverse the combined LBVH of all types (r_cut is NULL otherwise)
+        Scalar* r_cut;
+        Scalar* type_rlist;
+        Index2D typpair_idx;
+        Scalar r_buff;
+        unsigned int* type_max_neigh;
+
         // neighbor list
         unsigned int* neigh_list;
         unsigned int* nneigh;
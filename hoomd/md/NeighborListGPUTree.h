@@ -34,6 +34,16 @@
  * simulations, this sorting can also be used to efficiently filter out ghosts that lie outside the
  * neighbor search range (e.g., those participating in bonds).
  *
+ * Systems with many types can instead build one combined LBVH for all types (setCombined()). It is
+ * traversed once, with the search radius of each particle set by its type and the type pair cutoff
+ * checked for each intersected particle.
+ *
+ * The LBVHs are refit instead of rebuilt when the particle order has not changed since the last
+ * build (no sort, type change, migration, or ghost exchange). A refit recomputes the bounding boxes
+ * of the existing hierarchy, which skips the type sort, the Morton code sort, and the hierarchy
+ * generation. The hierarchy loses quality as the particles move, so at most getMaxRefits()
+ * consecutive builds are refit before the LBVHs are built again.
+ *
  * \ingroup computes
  */
 class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
@@ -80,6 +90,31 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
             }
         }
 
+    //! Set whether to build one LBVH for all types
+    void setCombined(bool combined)
+        {
+        m_combined = combined;
+        m_refit_valid = false;
+        }
+
+    //! Get whether one LBVH is built for all types
+    bool getCombined()
+        {
+        return m_combined;
+        }
+
+    //! Set the maximum number of consecutive builds that refit the LBVHs
+    void setMaxRefits(unsigned int max_refits)
+        {
+        m_max_refits = max_refits;
+        }
+
+    //! Get the maximum number of consecutive builds that refit the LBVHs
+    unsigned int getMaxRefits()
+        {
+        return m_max_refits;
+        }
+
     protected:
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
@@ -110,12 +145,28 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     unsigned int m_n_images;                 //!< Number of translation vectors for traversal
     GPUArray<unsigned int> m_traverse_order; //!< Order to traverse primitives
 
+    bool m_combined;                        //!< True to build one LBVH for all types
+    std::vector<unsigned int> m_tree_first; //!< First sorted index of each LBVH
+    std::vector<unsigned int> m_tree_last;  //!< Last sorted index of each LBVH
+    GPUArray<Scalar> m_type_rlist;          //!< Search radius of each type in the combined LBVH
+
+    unsigned int m_max_refits;            //!< Maximum consecutive builds that refit the LBVHs
+    unsigned int m_n_refits;              //!< Consecutive builds that refit the LBVHs
+    bool m_refit_valid;                   //!< True when the LBVHs can be refit
+    GPUArray<unsigned int> m_refit_locks; //!< Internal node counters for the refit
+
     //! Build the LBVHs using the neighbor library
     void buildTree();
 
+    //! Refit the LBVHs built by buildTree() to the current positions
+    void refitTree();
+
     //! Traverse the LBVHs using the neighbor library
     void traverseTree();
 
+    //! Traverse the combined LBVH of all types
+    void traverseCombinedTree();
+
     //! Computes the image vectors to query for
     void updateImageVectors();
 
@@ -155,6 +206,13 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     void slotMaxNumChanged()
         {
         m_max_num_changed = true;
+        m_refit_valid = false;
+        }
+
+    //! Notification of a change in the order of the particles or the ghosts
+    void slotParticlesReordered()
+        {
+        m_refit_valid = false;
         }
 
     /// set to true when the type data has been allocated
@@ -13,6 +13,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 /*!
@@ -88,6 +94,7 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
 
     uint3 dim = m_cl->getDim();
     Scalar3 ghost_width = m_cl->getGhostWidth();
+    int2 lees_edwards_shift = m_cl->getLeesEdwardsShift();
 
     if (m_prof)
         m_prof->push(m_exec_conf, "compute");
@@ -170,7 +177,20 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+#ifdef ENABLE_TBB
+    // the neighbor rows are independent, only the overflow conditions are shared between particles
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(
+        std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+
+    m_exec_conf->getTaskArena()->execute([&] {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    unsigned int* conditions = thread_conditions.local().data();
+    for (unsigned int i = r.begin(); i != r.end(); i++)
+#else
+    unsigned int* conditions = h_conditions.data;
+    for (unsigned int i = 0; i < nparticles; i++)
+#endif
         {
         unsigned int cur_n_neigh = 0;
 
@@ -206,6 +226,16 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
             int sjb = jb + __scalar_as_int(stencil.y);
             int skb = kb + __scalar_as_int(stencil.z);
             Scalar cell_dist2 = stencil.w;
+
+            // shift the columns across the y boundary by the Lees-Edwards offset
+            if (periodic.y && periodic.x && (sjb >= (int)dim.y || sjb < 0))
+                {
+                sib += (sjb >= (int)dim.y) ? lees_edwards_shift.x : lees_edwards_shift.y;
+                sib %= (int)dim.x;
+                if (sib < 0)
+                    sib += dim.x;
+                }
+
             // wrap through the boundary
             if (periodic.x)
                 {
@@ -295,7 +325,7 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
                 unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
 
                 // a particle cannot neighbor itself
-                if (i == (int)cur_neigh)
+                if (i == cur_neigh)
                     continue;
 
                 Scalar3 neigh_pos = make_scalar3(neigh_xyzf.x, neigh_xyzf.y, neigh_xyzf.z);
@@ -306,7 +336,7 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
 
                 if (dr_sq <= r_listsq)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    if (m_storage_mode == full || i < cur_neigh)
                         {
                         // local neighbor
                         if (cur_n_neigh < Nmax_i)
@@ -314,8 +344,7 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
 
                         ++cur_n_neigh;
                         }
@@ -325,6 +354,16 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
 
         h_n_neigh.data[i] = cur_n_neigh;
         }
+#ifdef ENABLE_TBB
+        });
+    }); // end task arena execute()
+
+    for (const auto& conditions : thread_conditions)
+        {
+        for (unsigned int t = 0; t < m_pdata->getNTypes(); ++t)
+            h_conditions.data[t] = max(h_conditions.data[t], conditions[t]);
+        }
+#endif
 
     if (m_prof)
         m_prof->pop(m_exec_conf);
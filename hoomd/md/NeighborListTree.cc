@@ -16,6 +16,12 @@ namespace py = pybind11;
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 using namespace hpmc::detail;
 
@@ -309,7 +315,20 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
     // Loop over all particles
+#ifdef ENABLE_TBB
+    // the neighbor rows are independent, only the overflow conditions are shared between particles
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(
+        std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+
+    m_exec_conf->getTaskArena()->execute([&] {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    unsigned int* conditions = thread_conditions.local().data();
+    for (unsigned int i = r.begin(); i != r.end(); ++i)
+#else
+    unsigned int* conditions = h_conditions.data;
     for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+#endif
         {
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
@@ -407,8 +426,8 @@ void NeighborListTree::traverseTree()
                                             if (n_neigh_i < Nmax_i)
                                                 h_nlist.data[nlist_head_i + n_neigh_i] = j;
                                             else
-                                                h_conditions.data[type_i]
-                                                    = max(h_conditions.data[type_i], n_neigh_i + 1);
+                                                conditions[type_i]
+                                                    = max(conditions[type_i], n_neigh_i + 1);
 
                                             ++n_neigh_i;
                                             }
@@ -427,6 +446,16 @@ void NeighborListTree::traverseTree()
             }         // end loop over pair types
         h_n_neigh.data[i] = n_neigh_i;
         } // end loop over particles
+#ifdef ENABLE_TBB
+        });
+    }); // end task arena execute()
+
+    for (const auto& conditions : thread_conditions)
+        {
+        for (unsigned int t = 0; t < m_pdata->getNTypes(); ++t)
+            h_conditions.data[t] = max(h_conditions.data[t], conditions[t]);
+        }
+#endif
 
     if (this->m_prof)
         this->m_prof->pop();
@@ -3,6 +3,7 @@
 
 // Maintainer: ksil
 
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -90,6 +91,7 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
 
     //!< Dihedral data to use in computing dihedrals
     std::shared_ptr<DihedralData> m_dihedral_data;
+    BondedForceChunks m_chunks; //!< Per-thread force buffers
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -76,13 +76,13 @@ gpu_compute_opls_dihedral_forces_kernel(Scalar4* d_force,
         int cur_dihedral_abcd = cur_ABCD;
 
         // get the a-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 x_postype = d_pos[cur_dihedral_x_idx];
+        Scalar4 x_postype = __ldg(d_pos + cur_dihedral_x_idx);
         Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
         // get the c-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 y_postype = d_pos[cur_dihedral_y_idx];
+        Scalar4 y_postype = __ldg(d_pos + cur_dihedral_y_idx);
         Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
         // get the c-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 z_postype = d_pos[cur_dihedral_z_idx];
+        Scalar4 z_postype = __ldg(d_pos + cur_dihedral_z_idx);
         Scalar3 z_pos = make_scalar3(z_postype.x, z_postype.y, z_postype.z);
 
         if (cur_dihedral_abcd == 0)
@@ -50,6 +50,7 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
     m_rcut = Scalar(0.0);
     m_order = 0;
     m_alpha = Scalar(0.0);
+    m_ad = false;
 
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
@@ -672,6 +673,14 @@ void PPPMForceCompute::computeInfluenceFunction()
     temp = floor(((m_kappa * L.z / (M_PI * m_global_dim.z)) * pow(-log(EPS_HOC), 0.25)));
     int nbz = (int)temp;
 
+    if (m_ad)
+        {
+        // the sum over k^2 U^2 in the ad denominator converges slower than the numerator
+        nbx = std::max(nbx, 2);
+        nby = std::max(nby, 2);
+        nbz = std::max(nbz, 2);
+        }
+
     for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
         {
         uint3 wave_idx;
@@ -718,6 +727,7 @@ void PPPMForceCompute::computeInfluenceFunction()
         if (n.x != 0 || n.y != 0 || n.z != 0)
             {
             Scalar sum1(0.0);
+            Scalar sum2(0.0);
             Scalar numerator = Scalar(4.0 * M_PI) / dot(k, k);
 
             Scalar denominator = gf_denom(snx * snx, sny * sny, snz * snz);
@@ -768,11 +778,31 @@ void PPPMForceCompute::computeInfluenceFunction()
                         Scalar arg_gauss = Scalar(0.25) * dot2 / m_kappa / m_kappa;
                         Scalar gauss = exp(-arg_gauss);
 
-                        sum1 += (dot1 / dot2) * gauss * wx * wx * wy * wy * wz * wz;
+                        Scalar w2 = wx * wx * wy * wy * wz * wz;
+                        if (m_ad)
+                            {
+                            Scalar knsq = dot(kn, kn);
+                            sum1 += (knsq / dot2) * gauss * w2;
+                            sum2 += knsq * w2;
+                            }
+                        else
+                            {
+                            sum1 += (dot1 / dot2) * gauss * w2;
+                            }
                         }
                     }
                 }
-            h_inf_f.data[cell_idx] = numerator * sum1 / denominator;
+
+            if (m_ad)
+                {
+                // optimal influence function for analytic differentiation
+                h_inf_f.data[cell_idx]
+                    = Scalar(4.0 * M_PI) * sum1 / (sqrt(denominator) * sum2);
+                }
+            else
+                {
+                h_inf_f.data[cell_idx] = numerator * sum1 / denominator;
+                }
             }
         else // q=0
             {
@@ -792,6 +822,25 @@ void PPPMForceCompute::assignParticles()
     if (m_prof)
         m_prof->push("assign");
 
+    // grow the stencil cache, it is filled here and reused by interpolateForces()
+    unsigned int group_size = m_group->getNumMembers();
+    if (m_stencil_cell.getNumElements() < group_size)
+        {
+        GlobalArray<int3> stencil_cell(group_size, m_exec_conf);
+        m_stencil_cell.swap(stencil_cell);
+        }
+    size_t n_weights = size_t(group_size) * 3 * m_order;
+    if (m_stencil_W.getNumElements() < n_weights)
+        {
+        GlobalArray<Scalar> stencil_W(n_weights, m_exec_conf);
+        m_stencil_W.swap(stencil_W);
+        }
+    if (m_ad && m_stencil_dW.getNumElements() < n_weights)
+        {
+        GlobalArray<Scalar> stencil_dW(n_weights, m_exec_conf);
+        m_stencil_dW.swap(stencil_dW);
+        }
+
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::read);
@@ -800,6 +849,12 @@ void PPPMForceCompute::assignParticles()
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
 
+    ArrayHandle<int3> h_stencil_cell(m_stencil_cell,
+                                     access_location::host,
+                                     access_mode::overwrite);
+    ArrayHandle<Scalar> h_stencil_W(m_stencil_W, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_stencil_dW(m_stencil_dW, access_location::host, access_mode::overwrite);
+
     const BoxDim& box = m_pdata->getBox();
 
     // set mesh to zero
@@ -807,8 +862,11 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume() / (Scalar)(m_mesh_points.x * m_mesh_points.y * m_mesh_points.z);
 
+    int mult_fact = 2 * m_order + 1;
+    int nlower = -(m_order - 1) / 2;
+    int nupper = m_order / 2;
+
     // loop over group
-    unsigned int group_size = m_group->getNumMembers();
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int idx = m_group->getMemberIndex(group_idx);
@@ -816,6 +874,9 @@ void PPPMForceCompute::assignParticles()
         Scalar4 postype = h_postype.data[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
+        // mark the particle as not assigned until its cell is known
+        h_stencil_cell.data[group_idx] = make_int3(-1, -1, -1);
+
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
@@ -871,20 +932,48 @@ void PPPMForceCompute::assignParticles()
             continue;
             }
 
-        int mult_fact = 2 * m_order + 1;
-        Scalar Wx, Wy, Wz;
-
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
+        h_stencil_cell.data[group_idx] = make_int3(ix, iy, iz);
 
+        // evaluate the assignment function once per dimension
+        Scalar* W = h_stencil_W.data + 3 * m_order * group_idx - nlower;
         for (int i = nlower; i <= nupper; ++i)
             {
-            Wx = Scalar(0.0);
+            Scalar Wx(0.0), Wy(0.0), Wz(0.0);
             for (int iorder = m_order - 1; iorder >= 0; iorder--)
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
+                Scalar coeff = h_rho_coeff.data[i - nlower + iorder * mult_fact];
+                Wx = coeff + Wx * dx;
+                Wy = coeff + Wy * dy;
+                Wz = coeff + Wz * dz;
                 }
+            W[i] = Wx;
+            W[m_order + i] = Wy;
+            W[2 * m_order + i] = Wz;
+            }
+
+        if (m_ad)
+            {
+            // derivatives of the assignment function for analytic differentiation
+            Scalar* dW = h_stencil_dW.data + 3 * m_order * group_idx - nlower;
+            for (int i = nlower; i <= nupper; ++i)
+                {
+                Scalar dWx(0.0), dWy(0.0), dWz(0.0);
+                for (int iorder = m_order - 1; iorder >= 1; iorder--)
+                    {
+                    Scalar coeff
+                        = Scalar(iorder) * h_rho_coeff.data[i - nlower + iorder * mult_fact];
+                    dWx = coeff + dWx * dx;
+                    dWy = coeff + dWy * dy;
+                    dWz = coeff + dWz * dz;
+                    }
+                dW[i] = dWx;
+                dW[m_order + i] = dWy;
+                dW[2 * m_order + i] = dWz;
+                }
+            }
 
+        for (int i = nlower; i <= nupper; ++i)
+            {
             int neighi = (int)ix + i;
 
             if (!m_n_ghost_cells.x)
@@ -897,12 +986,6 @@ void PPPMForceCompute::assignParticles()
 
             for (int j = nlower; j <= nupper; ++j)
                 {
-                Wy = Scalar(0.0);
-                for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                    {
-                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
-                    }
-
                 int neighj = (int)iy + j;
 
                 if (!m_n_ghost_cells.y)
@@ -913,14 +996,10 @@ void PPPMForceCompute::assignParticles()
                         neighj += m_grid_dim.y;
                     }
 
+                Scalar Wxy = W[i] * W[m_order + j];
+
                 for (int k = nlower; k <= nupper; ++k)
                     {
-                    Wz = Scalar(0.0);
-                    for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                        {
-                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
-                        }
-
                     int neighk = (int)iz + k;
                     if (!m_n_ghost_cells.z)
                         {
@@ -930,13 +1009,13 @@ void PPPMForceCompute::assignParticles()
                             neighk += m_grid_dim.z;
                         }
 
-                    Scalar W = Wx * Wy * Wz;
+                    Scalar W_ijk = Wxy * W[2 * m_order + k];
 
                     // store in row major order
                     unsigned int neigh_idx
                         = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
-                    h_mesh.data[neigh_idx].r += float(qi * W / V_cell);
+                    h_mesh.data[neigh_idx].r += float(qi * W_ijk / V_cell);
                     }
                 }
             }
@@ -1023,6 +1102,14 @@ void PPPMForceCompute::updateMeshes()
 
             Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
 
+            if (m_ad)
+                {
+                // store the potential, interpolateForces() differentiates the assignment function
+                h_fourier_mesh_G_x.data[k].r = float(f.r * scaled_inf_f);
+                h_fourier_mesh_G_x.data[k].i = float(f.i * scaled_inf_f);
+                continue;
+                }
+
             Scalar3 kvec = h_k.data[k];
 
             h_fourier_mesh_G_x.data[k].r = float(f.i * kvec.x * scaled_inf_f);
@@ -1063,8 +1150,11 @@ void PPPMForceCompute::updateMeshes()
                                                        access_location::host,
                                                        access_mode::overwrite);
         kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        if (!m_ad)
+            {
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+            }
         if (m_prof)
             m_prof->pop();
         }
@@ -1100,14 +1190,17 @@ void PPPMForceCompute::updateMeshes()
                      (cpx_t*)(h_inv_fourier_mesh_x.data + m_ghost_offset),
                      1,
                      m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_fourier_mesh_G_y.data,
-                     (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
-                     1,
-                     m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_fourier_mesh_G_z.data,
-                     (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
-                     1,
-                     m_dfft_plan_inverse);
+        if (!m_ad)
+            {
+            dfft_execute((cpx_t*)h_fourier_mesh_G_y.data,
+                         (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
+                         1,
+                         m_dfft_plan_inverse);
+            dfft_execute((cpx_t*)h_fourier_mesh_G_z.data,
+                         (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
+                         1,
+                         m_dfft_plan_inverse);
+            }
         if (m_prof)
             m_prof->pop();
         }
@@ -1123,8 +1216,11 @@ void PPPMForceCompute::updateMeshes()
             m_prof->push("ghost cell update");
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
         m_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+        if (!m_ad)
+            {
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+            }
         if (m_prof)
             m_prof->pop();
         }
@@ -1137,9 +1233,6 @@ void PPPMForceCompute::interpolateForces()
         m_prof->push("interpolate");
 
     // access particle data
-    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // access inverse Fourier transform mesh
@@ -1159,90 +1252,65 @@ void PPPMForceCompute::interpolateForces()
     // reset force for ALL particles
     memset(h_force.data, 0, sizeof(Scalar4) * m_pdata->getN());
 
-    ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
-
     const BoxDim& box = m_pdata->getBox();
 
+    // gradients of the reduced coordinates, used by analytic differentiation
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+    Scalar V_box = box.getVolume();
+    Scalar3 grad_x = (Scalar)m_mesh_points.x
+                     * make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                                    a2.z * a3.x - a2.x * a3.z,
+                                    a2.x * a3.y - a2.y * a3.x)
+                     / V_box;
+    Scalar3 grad_y = (Scalar)m_mesh_points.y
+                     * make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                                    a3.z * a1.x - a3.x * a1.z,
+                                    a3.x * a1.y - a3.y * a1.x)
+                     / V_box;
+    Scalar3 grad_z = (Scalar)m_mesh_points.z
+                     * make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                                    a1.z * a2.x - a1.x * a2.z,
+                                    a1.x * a2.y - a1.y * a2.x)
+                     / V_box;
+
+    // stencils evaluated in assignParticles()
+    ArrayHandle<int3> h_stencil_cell(m_stencil_cell, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_stencil_W(m_stencil_W, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_stencil_dW(m_stencil_dW, access_location::host, access_mode::read);
+
+    int nlower = -(m_order - 1) / 2;
+    int nupper = m_order / 2;
+
     // loop over group
     unsigned int group_size = m_group->getNumMembers();
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int idx = m_group->getMemberIndex(group_idx);
-        Scalar4 postype = h_postype.data[idx];
-
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+        // skip particles that were not assigned to the mesh
+        int3 cell = h_stencil_cell.data[group_idx];
+        if (cell.x < 0)
             {
             continue;
             }
 
         Scalar qi = h_charge.data[idx];
 
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar)m_mesh_points.x,
-                                           f.y * (Scalar)m_mesh_points.y,
-                                           f.z * (Scalar)m_mesh_points.z);
-        reduced_pos.x += (Scalar)m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar)m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar)m_n_ghost_cells.z;
-
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift = 0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
-        // find cell of the force mesh the particle is in
-        int ix = int(reduced_pos.x + shift);
-        int iy = int(reduced_pos.y + shift);
-        int iz = int(reduced_pos.z + shift);
-
-        Scalar dx = shiftone + (Scalar)ix - reduced_pos.x;
-        Scalar dy = shiftone + (Scalar)iy - reduced_pos.y;
-        Scalar dz = shiftone + (Scalar)iz - reduced_pos.z;
-
-        // handle particles on the boundary
-        if (ix == (int)m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int)m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int)m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
-
-        if (ix < 0 || ix >= (int)m_grid_dim.x || iy < 0 || iy >= (int)m_grid_dim.y || iz < 0
-            || iz >= (int)m_grid_dim.z)
-            {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
+        const Scalar* W = h_stencil_W.data + 3 * m_order * group_idx - nlower;
+        const Scalar* dW = m_ad ? h_stencil_dW.data + 3 * m_order * group_idx - nlower : nullptr;
 
         Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
 
-        int mult_fact = 2 * m_order + 1;
-        Scalar Wx, Wy, Wz;
-
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
+        // derivative of the potential with respect to the reduced coordinates (ad only)
+        Scalar3 dphi = make_scalar3(0.0, 0.0, 0.0);
 
         for (int i = nlower; i <= nupper; ++i)
             {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                {
-                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
-                }
+            Scalar Wx = W[i];
 
-            int neighi = (int)ix + i;
+            int neighi = cell.x + i;
 
             if (!m_n_ghost_cells.x)
                 {
@@ -1254,13 +1322,9 @@ void PPPMForceCompute::interpolateForces()
 
             for (int j = nlower; j <= nupper; ++j)
                 {
-                Wy = Scalar(0.0);
-                for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                    {
-                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
-                    }
+                Scalar Wy = W[m_order + j];
 
-                int neighj = (int)iy + j;
+                int neighj = cell.y + j;
 
                 if (!m_n_ghost_cells.y)
                     {
@@ -1272,13 +1336,9 @@ void PPPMForceCompute::interpolateForces()
 
                 for (int k = nlower; k <= nupper; ++k)
                     {
-                    Wz = Scalar(0.0);
-                    for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                        {
-                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
-                        }
+                    Scalar Wz = W[2 * m_order + k];
 
-                    int neighk = (int)iz + k;
+                    int neighk = cell.z + k;
                     if (!m_n_ghost_cells.z)
                         {
                         if (neighk >= (int)m_grid_dim.z)
@@ -1290,18 +1350,34 @@ void PPPMForceCompute::interpolateForces()
                     unsigned int neigh_idx
                         = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
+                    if (m_ad)
+                        {
+                        Scalar phi = h_inv_fourier_mesh_x.data[neigh_idx].r;
+                        dphi.x += dW[i] * Wy * Wz * phi;
+                        dphi.y += Wx * dW[m_order + j] * Wz * phi;
+                        dphi.z += Wx * Wy * dW[2 * m_order + k] * phi;
+                        continue;
+                        }
+
                     kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
                     kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
                     kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
 
-                    Scalar W = Wx * Wy * Wz;
-                    force.x += qi * W * E_x.r;
-                    force.y += qi * W * E_y.r;
-                    force.z += qi * W * E_z.r;
+                    Scalar W_ijk = Wx * Wy * Wz;
+                    force.x += qi * W_ijk * E_x.r;
+                    force.y += qi * W_ijk * E_y.r;
+                    force.z += qi * W_ijk * E_z.r;
                     }
                 }
             }
 
+        if (m_ad)
+            {
+            // the offsets dx, dy, dz decrease with the reduced coordinates, so F = -q grad(phi)
+            // has a positive sign
+            force = qi * (dphi.x * grad_x + dphi.y * grad_y + dphi.z * grad_z);
+            }
+
         h_force.data[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
         } // end of loop over particles
 
@@ -1401,6 +1477,11 @@ void PPPMForceCompute::computeForces(uint64_t timestep)
             throw std::runtime_error("Error computing PPPM forces");
             }
 
+        if (m_ad && m_order < 2)
+            {
+            throw std::runtime_error("Analytic differentiation requires an order of at least 2.");
+            }
+
         // allocate memory and initialize arrays
         setupMesh();
 
@@ -1847,5 +1928,8 @@ void export_PPPMForceCompute(py::module& m)
         .def_property_readonly("order", &PPPMForceCompute::getOrder)
         .def_property_readonly("kappa", &PPPMForceCompute::getKappa)
         .def_property_readonly("r_cut", &PPPMForceCompute::getRCut)
-        .def_property_readonly("alpha", &PPPMForceCompute::getAlpha);
+        .def_property_readonly("alpha", &PPPMForceCompute::getAlpha)
+        .def_property("differentiation",
+                      &PPPMForceCompute::getDifferentiation,
+                      &PPPMForceCompute::setDifferentiation);
     }
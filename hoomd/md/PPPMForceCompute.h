@@ -81,6 +81,29 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         return m_alpha;
         }
 
+    /// Set the differentiation scheme for the mesh forces
+    /** \param differentiation "ik" to differentiate in k-space with three inverse FFTs, "ad" to
+        differentiate the assignment function analytically with one inverse FFT
+    */
+    void setDifferentiation(const std::string& differentiation)
+        {
+        if (differentiation == "ik")
+            m_ad = false;
+        else if (differentiation == "ad")
+            m_ad = true;
+        else
+            throw std::invalid_argument("Invalid differentiation: " + differentiation);
+
+        // the influence function depends on the differentiation
+        m_need_initialize = true;
+        }
+
+    /// Get the differentiation scheme for the mesh forces
+    std::string getDifferentiation()
+        {
+        return m_ad ? "ad" : "ik";
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -139,6 +162,7 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     Scalar m_rcut;  //!< Cutoff for short-ranged interaction
     int m_order;    //!< Order of interpolation scheme
     Scalar m_alpha; //!< Debye screening parameter
+    bool m_ad;      //!< True to use analytic differentiation, false for ik differentiation
 
     Scalar m_q;  //!< Total system charge
     Scalar m_q2; //!< Sum of charge squared
@@ -146,6 +170,10 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     GlobalArray<Scalar> m_rho_coeff; //!< Coefficients for computing the grid based charge density
     GlobalArray<Scalar> m_gf_b;      //!< Green function coefficients
 
+    GlobalArray<int3> m_stencil_cell; //!< Mesh cell of each group member, x < 0 if not assigned
+    GlobalArray<Scalar> m_stencil_W;  //!< Assignment weights of each group member (3*order)
+    GlobalArray<Scalar> m_stencil_dW; //!< Derivatives of the assignment weights (ad only)
+
     Scalar m_body_energy;      //!< Energy correction due to rigid body exclusions
     bool m_ptls_added_removed; //!< True if global particle number changed
 
@@ -15,8 +15,8 @@ namespace py = pybind11;
 PPPMForceComputeGPU::PPPMForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
                                          std::shared_ptr<NeighborList> nlist,
                                          std::shared_ptr<ParticleGroup> group)
-    : PPPMForceCompute(sysdef, nlist, group), m_local_fft(true), m_sum(m_exec_conf),
-      m_block_size(256)
+    : PPPMForceCompute(sysdef, nlist, group), m_tuner_enabled(true), m_tuner_period(100000),
+      m_local_fft(true), m_sum(m_exec_conf), m_block_size(256)
     {
     unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     m_tuner_assign.reset(
@@ -57,12 +57,21 @@ PPPMForceComputeGPU::~PPPMForceComputeGPU()
 #ifdef ENABLE_MPI
     else if (m_cuda_dfft_initialized)
         {
-        dfft_destroy_plan(m_dfft_plan_forward);
-        dfft_destroy_plan(m_dfft_plan_inverse);
+        destroyDFFTPlans();
         }
 #endif
     }
 
+#ifdef ENABLE_MPI
+void PPPMForceComputeGPU::destroyDFFTPlans()
+    {
+    dfft_cuda_destroy_plan(m_dfft_plan_forward);
+    dfft_cuda_destroy_plan(m_dfft_plan_inverse);
+    dfft_destroy_plan(m_dfft_host_plan_forward);
+    dfft_destroy_plan(m_dfft_host_plan_inverse);
+    }
+#endif
+
 void PPPMForceComputeGPU::initializeFFT()
     {
     // free plans if they have already been initialized
@@ -77,8 +86,7 @@ void PPPMForceComputeGPU::initializeFFT()
 #ifdef ENABLE_MPI
     else if (m_cuda_dfft_initialized)
         {
-        dfft_destroy_plan(m_dfft_plan_forward);
-        dfft_destroy_plan(m_dfft_plan_inverse);
+        destroyDFFTPlans();
         }
 #endif
 
@@ -129,7 +137,6 @@ void PPPMForceComputeGPU::initializeFFT()
         ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-#ifndef USE_HOST_DFFT
         dfft_cuda_create_plan(&m_dfft_plan_forward,
                               3,
                               gdim,
@@ -154,8 +161,9 @@ void PPPMForceComputeGPU::initializeFFT()
                               1,
                               m_exec_conf->getMPICommunicator(),
                               (int*)h_cart_ranks.data);
-#else
-        dfft_create_plan(&m_dfft_plan_forward,
+
+        // the host plans transform the same mesh layout, staged through host memory
+        dfft_create_plan(&m_dfft_host_plan_forward,
                          3,
                          gdim,
                          embed,
@@ -167,7 +175,7 @@ void PPPMForceComputeGPU::initializeFFT()
                          1,
                          m_exec_conf->getMPICommunicator(),
                          (int*)h_cart_ranks.data);
-        dfft_create_plan(&m_dfft_plan_inverse,
+        dfft_create_plan(&m_dfft_host_plan_inverse,
                          3,
                          gdim,
                          NULL,
@@ -179,7 +187,16 @@ void PPPMForceComputeGPU::initializeFFT()
                          1,
                          m_exec_conf->getMPICommunicator(),
                          (int*)h_cart_ranks.data);
-#endif
+
+        // the faster backend depends on the mesh size, retune whenever the mesh changes
+        std::vector<unsigned int> valid_params;
+        valid_params.push_back(dfft_backend_device);
+        valid_params.push_back(dfft_backend_host);
+        m_tuner_dfft.reset(
+            new Autotuner(valid_params, 5, m_tuner_period, "pppm_dfft", this->m_exec_conf));
+        m_tuner_dfft->setEnabled(m_tuner_enabled);
+        // all ranks take part in the same transform and must use the same backend
+        m_tuner_dfft->setSync(true);
 
         m_cuda_dfft_initialized = true;
         }
@@ -391,26 +408,34 @@ void PPPMForceComputeGPU::updateMeshes()
         m_exec_conf->msg->notice(8) << "charge.pppm: Distributed FFT mesh" << std::endl;
         if (m_prof)
             m_prof->push(m_exec_conf, "FFT");
-#ifndef USE_HOST_DFFT
-        ArrayHandle<hipfftComplex> d_mesh(m_mesh, access_location::device, access_mode::read);
+        m_tuner_dfft->begin();
+        if (m_tuner_dfft->getParam() == dfft_backend_device)
+            {
+            ArrayHandle<hipfftComplex> d_mesh(m_mesh,
+                                              access_location::device,
+                                              access_mode::readwrite);
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            dfft_cuda_check_errors(&m_dfft_plan_forward, 1);
-        else
-            dfft_cuda_check_errors(&m_dfft_plan_forward, 0);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                dfft_cuda_check_errors(&m_dfft_plan_forward, 1);
+            else
+                dfft_cuda_check_errors(&m_dfft_plan_forward, 0);
 
-        dfft_cuda_execute(d_mesh.data + m_ghost_offset,
-                          d_mesh.data + m_ghost_offset,
-                          0,
-                          &m_dfft_plan_forward);
-#else
-        ArrayHandle<hipfftComplex> h_mesh(m_mesh, access_location::host, access_mode::read);
+            dfft_cuda_execute(d_mesh.data + m_ghost_offset,
+                              d_mesh.data + m_ghost_offset,
+                              0,
+                              &m_dfft_plan_forward);
+            }
+        else
+            {
+            ArrayHandle<hipfftComplex> h_mesh(m_mesh,
+                                              access_location::host,
+                                              access_mode::readwrite);
 
-        dfft_execute((cpx_t*)(h_mesh.data + m_ghost_offset),
-                     (cpx_t*)(h_fourier_mesh.data + m_ghost_offset),
-                     0,
-                     m_dfft_plan_forward);
-#endif
+            dfft_execute((cpx_t*)(h_mesh.data + m_ghost_offset),
+                         (cpx_t*)(h_mesh.data + m_ghost_offset),
+                         0,
+                         m_dfft_host_plan_forward);
+            }
         if (m_prof)
             m_prof->pop(m_exec_conf);
         }
@@ -446,7 +471,8 @@ void PPPMForceComputeGPU::updateMeshes()
                           d_inf_f.data,
                           d_k.data,
                           m_global_dim.x * m_global_dim.y * m_global_dim.z,
-                          block_size);
+                          block_size,
+                          m_ad);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -481,27 +507,33 @@ void PPPMForceComputeGPU::updateMeshes()
                                          d_inv_fourier_mesh_x.data,
                                          d_inv_fourier_mesh_x.data,
                                          HIPFFT_BACKWARD));
-        CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
-                                         d_inv_fourier_mesh_y.data,
-                                         d_inv_fourier_mesh_y.data,
-                                         HIPFFT_BACKWARD));
-        CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
-                                         d_inv_fourier_mesh_z.data,
-                                         d_inv_fourier_mesh_z.data,
-                                         HIPFFT_BACKWARD));
+        if (!m_ad)
+            {
+            CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
+                                             d_inv_fourier_mesh_y.data,
+                                             d_inv_fourier_mesh_y.data,
+                                             HIPFFT_BACKWARD));
+            CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
+                                             d_inv_fourier_mesh_z.data,
+                                             d_inv_fourier_mesh_z.data,
+                                             HIPFFT_BACKWARD));
+            }
 #else
         CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
                                         d_inv_fourier_mesh_x.data,
                                         d_inv_fourier_mesh_x.data,
                                         CUFFT_INVERSE));
-        CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
-                                        d_inv_fourier_mesh_y.data,
-                                        d_inv_fourier_mesh_y.data,
-                                        CUFFT_INVERSE));
-        CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
-                                        d_inv_fourier_mesh_z.data,
-                                        d_inv_fourier_mesh_z.data,
-                                        CUFFT_INVERSE));
+        if (!m_ad)
+            {
+            CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
+                                            d_inv_fourier_mesh_y.data,
+                                            d_inv_fourier_mesh_y.data,
+                                            CUFFT_INVERSE));
+            CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
+                                            d_inv_fourier_mesh_z.data,
+                                            d_inv_fourier_mesh_z.data,
+                                            CUFFT_INVERSE));
+            }
 #endif
         m_exec_conf->endMultiGPU();
 
@@ -516,57 +548,69 @@ void PPPMForceComputeGPU::updateMeshes()
 
         // Distributed inverse transform of force mesh
         m_exec_conf->msg->notice(8) << "charge.pppm: Distributed iFFT" << std::endl;
-#ifndef USE_HOST_DFFT
-        ArrayHandle<hipfftComplex> d_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
-        ArrayHandle<hipfftComplex> d_inv_fourier_mesh_y(m_inv_fourier_mesh_y,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
-        ArrayHandle<hipfftComplex> d_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
+        if (m_tuner_dfft->getParam() == dfft_backend_device)
+            {
+            ArrayHandle<hipfftComplex> d_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
+                                                            access_location::device,
+                                                            access_mode::readwrite);
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            dfft_cuda_check_errors(&m_dfft_plan_inverse, 1);
-        else
-            dfft_cuda_check_errors(&m_dfft_plan_inverse, 0);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                dfft_cuda_check_errors(&m_dfft_plan_inverse, 1);
+            else
+                dfft_cuda_check_errors(&m_dfft_plan_inverse, 0);
 
-        dfft_cuda_execute(d_inv_fourier_mesh_x.data + m_ghost_offset,
-                          d_inv_fourier_mesh_x.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
-        dfft_cuda_execute(d_inv_fourier_mesh_y.data + m_ghost_offset,
-                          d_inv_fourier_mesh_y.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
-        dfft_cuda_execute(d_inv_fourier_mesh_z.data + m_ghost_offset,
-                          d_inv_fourier_mesh_z.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
-#else
-        ArrayHandle<hipfftComplex> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
-                                                        access_location::host,
-                                                        access_mode::overwrite);
-        ArrayHandle<hipfftComplex> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y,
-                                                        access_location::host,
-                                                        access_mode::overwrite);
-        ArrayHandle<hipfftComplex> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
-                                                        access_location::host,
-                                                        access_mode::overwrite);
-        dfft_execute((cpx_t*)h_inv_fourier_mesh_x.data + m_ghost_offset,
-                     (cpx_t*)h_inv_fourier_mesh_x.data + m_ghost_offset,
-                     1,
-                     m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_inv_fourier_mesh_y.data + m_ghost_offset,
-                     (cpx_t*)h_inv_fourier_mesh_y.data + m_ghost_offset,
-                     1,
-                     m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_inv_fourier_mesh_z.data + m_ghost_offset,
-                     (cpx_t*)h_inv_fourier_mesh_z.data + m_ghost_offset,
-                     1,
-                     m_dfft_plan_inverse);
-#endif
+            dfft_cuda_execute(d_inv_fourier_mesh_x.data + m_ghost_offset,
+                              d_inv_fourier_mesh_x.data + m_ghost_offset,
+                              1,
+                              &m_dfft_plan_inverse);
+
+            if (!m_ad)
+                {
+                ArrayHandle<hipfftComplex> d_inv_fourier_mesh_y(m_inv_fourier_mesh_y,
+                                                                access_location::device,
+                                                                access_mode::readwrite);
+                ArrayHandle<hipfftComplex> d_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
+                                                                access_location::device,
+                                                                access_mode::readwrite);
+                dfft_cuda_execute(d_inv_fourier_mesh_y.data + m_ghost_offset,
+                                  d_inv_fourier_mesh_y.data + m_ghost_offset,
+                                  1,
+                                  &m_dfft_plan_inverse);
+                dfft_cuda_execute(d_inv_fourier_mesh_z.data + m_ghost_offset,
+                                  d_inv_fourier_mesh_z.data + m_ghost_offset,
+                                  1,
+                                  &m_dfft_plan_inverse);
+                }
+            }
+        else
+            {
+            ArrayHandle<hipfftComplex> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
+                                                            access_location::host,
+                                                            access_mode::readwrite);
+            dfft_execute((cpx_t*)(h_inv_fourier_mesh_x.data + m_ghost_offset),
+                         (cpx_t*)(h_inv_fourier_mesh_x.data + m_ghost_offset),
+                         1,
+                         m_dfft_host_plan_inverse);
+
+            if (!m_ad)
+                {
+                ArrayHandle<hipfftComplex> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y,
+                                                                access_location::host,
+                                                                access_mode::readwrite);
+                ArrayHandle<hipfftComplex> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
+                                                                access_location::host,
+                                                                access_mode::readwrite);
+                dfft_execute((cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
+                             (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
+                             1,
+                             m_dfft_host_plan_inverse);
+                dfft_execute((cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
+                             (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
+                             1,
+                             m_dfft_host_plan_inverse);
+                }
+            }
+        m_tuner_dfft->end();
         if (m_prof)
             m_prof->pop(m_exec_conf);
         }
@@ -581,8 +625,11 @@ void PPPMForceComputeGPU::updateMeshes()
             m_prof->push(m_exec_conf, "ghost cell update");
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
         m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
-        m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
-        m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+        if (!m_ad)
+            {
+            m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
+            m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+            }
         if (m_prof)
             m_prof->pop();
         }
@@ -639,7 +686,8 @@ void PPPMForceComputeGPU::interpolateForces()
                        d_rho_coeff.data,
                        block_size,
                        m_local_fft,
-                       m_n_cells + m_ghost_offset);
+                       m_n_cells + m_ghost_offset,
+                       m_ad);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -830,7 +878,8 @@ void PPPMForceComputeGPU::computeInfluenceFunction()
                                    m_alpha,
                                    d_gf_b.data,
                                    m_order,
-                                   block_size);
+                                   block_size,
+                                   m_ad);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -475,7 +475,8 @@ __global__ void gpu_update_meshes_kernel(const unsigned int n_wave_vectors,
                                          hipfftComplex* d_fourier_mesh_G_z,
                                          const Scalar* d_inf_f,
                                          const Scalar3* d_k,
-                                         unsigned int NNN)
+                                         unsigned int NNN,
+                                         bool ad)
     {
     unsigned int k;
 
@@ -488,6 +489,16 @@ __global__ void gpu_update_meshes_kernel(const unsigned int n_wave_vectors,
 
     Scalar scaled_inf_f = d_inf_f[k] / ((Scalar)NNN);
 
+    if (ad)
+        {
+        // store the potential, the force kernel differentiates the assignment function
+        hipfftComplex fourier_phi;
+        fourier_phi.x = f.x * scaled_inf_f;
+        fourier_phi.y = f.y * scaled_inf_f;
+        d_fourier_mesh_G_x[k] = fourier_phi;
+        return;
+        }
+
     Scalar3 kvec = d_k[k];
 
     // Normalization
@@ -517,7 +528,8 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        const Scalar* d_inf_f,
                        const Scalar3* d_k,
                        unsigned int NNN,
-                       unsigned int block_size)
+                       unsigned int block_size,
+                       bool ad)
 
     {
     unsigned int max_block_size;
@@ -540,7 +552,8 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        d_fourier_mesh_G_z,
                        d_inf_f,
                        d_k,
-                       NNN);
+                       NNN,
+                       ad);
     }
 
 __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
@@ -556,7 +569,11 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                                           const hipfftComplex* inv_fourier_mesh_y,
                                           const hipfftComplex* inv_fourier_mesh_z,
                                           const Scalar* d_rho_coeff,
-                                          const unsigned int offset)
+                                          const unsigned int offset,
+                                          const Scalar3 grad_x,
+                                          const Scalar3 grad_y,
+                                          const Scalar3 grad_z,
+                                          bool ad)
     {
     extern __shared__ Scalar s_coeff[];
 
@@ -606,10 +623,14 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
 
     Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
 
+    // derivative of the potential with respect to the reduced coordinates (ad only)
+    Scalar3 dphi = make_scalar3(0.0, 0.0, 0.0);
+
     int nlower = -(order - 1) / 2;
     int nupper = order / 2;
 
     Scalar result;
+    Scalar dx0(0.0), dy0(0.0), dz0(0.0);
     int mult_fact = 2 * order + 1;
 
     // back-interpolate forces from neighboring mesh points
@@ -622,6 +643,15 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
             }
         Scalar x0 = result;
 
+        if (ad)
+            {
+            dx0 = Scalar(0.0);
+            for (int k = order - 1; k >= 1; k--)
+                {
+                dx0 = Scalar(k) * s_coeff[l - nlower + k * mult_fact] + dx0 * dr.x;
+                }
+            }
+
         for (int m = nlower; m <= nupper; ++m)
             {
             result = Scalar(0.0);
@@ -629,7 +659,17 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                 {
                 result = s_coeff[m - nlower + k * mult_fact] + result * dr.y;
                 }
-            Scalar y0 = x0 * result;
+            Scalar wy = result;
+            Scalar y0 = x0 * wy;
+
+            if (ad)
+                {
+                dy0 = Scalar(0.0);
+                for (int k = order - 1; k >= 1; k--)
+                    {
+                    dy0 = Scalar(k) * s_coeff[m - nlower + k * mult_fact] + dy0 * dr.y;
+                    }
+                }
 
             for (int n = nlower; n <= nupper; ++n)
                 {
@@ -638,7 +678,17 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                     {
                     result = s_coeff[n - nlower + k * mult_fact] + result * dr.z;
                     }
-                Scalar z0 = y0 * result;
+                Scalar wz = result;
+                Scalar z0 = y0 * wz;
+
+                if (ad)
+                    {
+                    dz0 = Scalar(0.0);
+                    for (int k = order - 1; k >= 1; k--)
+                        {
+                        dz0 = Scalar(k) * s_coeff[n - nlower + k * mult_fact] + dz0 * dr.z;
+                        }
+                    }
 
                 int neighl = (int)cell_coord.x + l;
                 int neighm = (int)cell_coord.y + m;
@@ -671,6 +721,15 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                 // use column-major layout
                 unsigned int cell_idx = neighl + grid_dim.x * (neighm + grid_dim.y * neighn);
 
+                if (ad)
+                    {
+                    Scalar phi = inv_fourier_mesh_x[cell_idx].x;
+                    dphi.x += dx0 * wy * wz * phi;
+                    dphi.y += x0 * dy0 * wz * phi;
+                    dphi.z += y0 * dz0 * phi;
+                    continue;
+                    }
+
                 hipfftComplex inv_mesh_x = inv_fourier_mesh_x[cell_idx];
                 hipfftComplex inv_mesh_y = inv_fourier_mesh_y[cell_idx];
                 hipfftComplex inv_mesh_z = inv_fourier_mesh_z[cell_idx];
@@ -682,6 +741,13 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
             }
         } // end neighbor cells loop
 
+    if (ad)
+        {
+        // the offsets dr decrease with the reduced coordinates, so F = -q grad(phi) has a positive
+        // sign
+        force = qi * (dphi.x * grad_x + dphi.y * grad_y + dphi.z * grad_z);
+        }
+
     d_force[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
     }
 
@@ -702,8 +768,33 @@ void gpu_compute_forces(const unsigned int N,
                         const Scalar* d_rho_coeff,
                         unsigned int block_size,
                         bool local_fft,
-                        unsigned int inv_mesh_elements)
+                        unsigned int inv_mesh_elements,
+                        bool ad)
     {
+    // gradients of the reduced coordinates, used by analytic differentiation
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+    Scalar V_box = box.getVolume();
+    uint3 inner_dim = make_uint3(grid_dim.x - 2 * n_ghost_cells.x,
+                                 grid_dim.y - 2 * n_ghost_cells.y,
+                                 grid_dim.z - 2 * n_ghost_cells.z);
+    Scalar3 grad_x = (Scalar)inner_dim.x
+                     * make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                                    a2.z * a3.x - a2.x * a3.z,
+                                    a2.x * a3.y - a2.y * a3.x)
+                     / V_box;
+    Scalar3 grad_y = (Scalar)inner_dim.y
+                     * make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                                    a3.z * a1.x - a3.x * a1.z,
+                                    a3.x * a1.y - a3.y * a1.x)
+                     / V_box;
+    Scalar3 grad_z = (Scalar)inner_dim.z
+                     * make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                                    a1.z * a2.x - a1.x * a2.z,
+                                    a1.x * a2.y - a1.y * a2.x)
+                     / V_box;
+
     unsigned int max_block_size;
     hipFuncAttributes attr;
     hipFuncGetAttributes(&attr, (const void*)gpu_compute_forces_kernel);
@@ -748,7 +839,11 @@ void gpu_compute_forces(const unsigned int N,
             local_fft ? d_inv_fourier_mesh_y + idev * inv_mesh_elements : d_inv_fourier_mesh_y,
             local_fft ? d_inv_fourier_mesh_z + idev * inv_mesh_elements : d_inv_fourier_mesh_z,
             d_rho_coeff,
-            range.first);
+            range.first,
+            grad_x,
+            grad_y,
+            grad_z,
+            ad);
         }
     }
 
@@ -1064,7 +1159,8 @@ __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
                                                       const Scalar* gf_b,
                                                       int order,
                                                       Scalar kappa,
-                                                      Scalar alpha)
+                                                      Scalar alpha,
+                                                      bool ad)
     {
     unsigned int kidx;
 
@@ -1138,6 +1234,7 @@ __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
     if (l != 0 || m != 0 || n != 0)
         {
         Scalar sum1(0.0);
+        Scalar sum2(0.0);
         Scalar numerator = Scalar(4.0 * M_PI) / dot(kval, kval);
 
         for (int ix = -nbx; ix <= nbx; ix++)
@@ -1186,11 +1283,30 @@ __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
                     Scalar arg_gauss = Scalar(0.25) * dot2 / kappa / kappa;
                     Scalar gauss = exp(-arg_gauss);
 
-                    sum1 += (dot1 / dot2) * gauss * wx * wx * wy * wy * wz * wz;
+                    Scalar w2 = wx * wx * wy * wy * wz * wz;
+                    if (ad)
+                        {
+                        Scalar knsq = dot(kn, kn);
+                        sum1 += (knsq / dot2) * gauss * w2;
+                        sum2 += knsq * w2;
+                        }
+                    else
+                        {
+                        sum1 += (dot1 / dot2) * gauss * w2;
+                        }
                     }
                 }
             }
-        val = numerator * sum1 / denominator;
+
+        if (ad)
+            {
+            // optimal influence function for analytic differentiation
+            val = Scalar(4.0 * M_PI) * sum1 / (sx * sy * sz * sum2);
+            }
+        else
+            {
+            val = numerator * sum1 / denominator;
+            }
         }
     else
         {
@@ -1215,7 +1331,8 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                                     Scalar alpha,
                                     const Scalar* d_gf_b,
                                     int order,
-                                    unsigned int block_size)
+                                    unsigned int block_size,
+                                    bool ad)
     {
     // compute reciprocal lattice vectors
     Scalar3 a1 = global_box.getLatticeVector(0);
@@ -1249,6 +1366,14 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
     temp = floor(((kappa * L.z / (M_PI * global_dim.z)) * pow(-log(EPS_HOC), 0.25)));
     int nbz = (int)temp;
 
+    if (ad)
+        {
+        // the sum over k^2 U^2 in the ad denominator converges slower than the numerator
+        nbx = max(nbx, 2);
+        nby = max(nby, 2);
+        nbz = max(nbz, 2);
+        }
+
     if (local_fft)
         {
         unsigned int max_block_size;
@@ -1285,7 +1410,8 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                            d_gf_b,
                            order,
                            kappa,
-                           alpha);
+                           alpha,
+                           ad);
         }
 #ifdef ENABLE_MPI
     else
@@ -1324,7 +1450,8 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                            d_gf_b,
                            order,
                            kappa,
-                           alpha);
+                           alpha,
+                           ad);
         }
 #endif
     }
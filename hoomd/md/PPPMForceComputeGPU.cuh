@@ -57,7 +57,8 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        const Scalar* d_inf_f,
                        const Scalar3* d_k,
                        unsigned int NNN,
-                       unsigned int block_size);
+                       unsigned int block_size,
+                       bool ad);
 
 void gpu_compute_forces(const unsigned int N,
                         const Scalar4* d_postype,
@@ -76,7 +77,8 @@ void gpu_compute_forces(const unsigned int N,
                         const Scalar* d_rho_coeff,
                         unsigned int block_size,
                         bool local_fft,
-                        unsigned int inv_mesh_elements);
+                        unsigned int inv_mesh_elements,
+                        bool ad);
 
 void gpu_compute_pe(unsigned int n_wave_vectors,
                     Scalar* d_sum_partial,
@@ -106,7 +108,8 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                                     Scalar alpha,
                                     const Scalar* gf_b,
                                     int order,
-                                    unsigned int block_size);
+                                    unsigned int block_size,
+                                    bool ad);
 
 hipError_t gpu_fix_exclusions(Scalar4* d_force,
                               Scalar* d_virial,
@@ -18,19 +18,14 @@ typedef cufftHandle hipfftHandle;
 
 #include <sstream>
 
-//#define USE_HOST_DFFT
-
 #include "hoomd/Autotuner.h"
 
 #ifdef ENABLE_MPI
 #include "CommunicatorGridGPU.h"
 
-#ifndef USE_HOST_DFFT
 #include "hoomd/extern/dfftlib/src/dfft_cuda.h"
-#else
 #include "hoomd/extern/dfftlib/src/dfft_host.h"
 #endif
-#endif
 
 #define CHECK_HIPFFT_ERROR(status)                      \
         {                                               \
@@ -38,6 +33,10 @@ typedef cufftHandle hipfftHandle;
         }
 
 /*! Order parameter evaluated using the particle mesh method
+
+    With domain decomposition, the distributed FFT runs either on the device (dfft_cuda) or on the
+    host (dfft_host). Which backend is faster depends on the mesh size, the number of ranks and the
+    interconnect, so the backend is autotuned together with the kernel launch parameters.
  */
 class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     {
@@ -59,12 +58,22 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
         m_tuner_update->setPeriod(period);
         m_tuner_force->setPeriod(period);
         m_tuner_influence->setPeriod(period);
+#ifdef ENABLE_MPI
+        if (m_tuner_dfft)
+            m_tuner_dfft->setPeriod(period);
+#endif
 
         m_tuner_assign->setEnabled(enable);
         m_tuner_reduce_mesh->setEnabled(enable);
         m_tuner_update->setEnabled(enable);
         m_tuner_force->setEnabled(enable);
         m_tuner_influence->setEnabled(enable);
+#ifdef ENABLE_MPI
+        if (m_tuner_dfft)
+            m_tuner_dfft->setEnabled(enable);
+#endif
+        m_tuner_enabled = enable;
+        m_tuner_period = period;
         }
 
     protected:
@@ -119,6 +128,8 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     std::unique_ptr<Autotuner> m_tuner_force;       //!< Autotuner for populating the force array
     std::unique_ptr<Autotuner>
         m_tuner_influence; //!< Autotuner for computing the influence function
+    bool m_tuner_enabled;        //!< Autotuner state to apply to tuners created later
+    unsigned int m_tuner_period; //!< Autotuner period to apply to tuners created later
 
     hipfftHandle m_hipfft_plan;   //!< The FFT plan
     bool m_local_fft;             //!< True if we are only doing local FFTs (not distributed)
@@ -131,8 +142,22 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     std::shared_ptr<CommunicatorGridGPUComplex>
         m_gpu_grid_comm_reverse; //!< Communicate fourier mesh
 
-    dfft_plan m_dfft_plan_forward; //!< Forward distributed FFT
-    dfft_plan m_dfft_plan_inverse; //!< Forward distributed FFT
+    //! Backends for the distributed FFT
+    enum dfft_backend
+        {
+        dfft_backend_device = 0, //!< dfft_cuda, transforms the meshes in device memory
+        dfft_backend_host,       //!< dfft_host, transforms the meshes in host memory
+        };
+
+    std::unique_ptr<Autotuner> m_tuner_dfft; //!< Autotuner for the distributed FFT backend
+
+    dfft_plan m_dfft_plan_forward;      //!< Forward distributed FFT
+    dfft_plan m_dfft_plan_inverse;      //!< Inverse distributed FFT
+    dfft_plan m_dfft_host_plan_forward; //!< Forward distributed FFT on the host
+    dfft_plan m_dfft_host_plan_inverse; //!< Inverse distributed FFT on the host
+
+    //! Destroy the distributed FFT plans
+    void destroyDFFTPlans();
 #endif
 
     GlobalArray<hipfftComplex> m_mesh;         //!< The particle density mesh
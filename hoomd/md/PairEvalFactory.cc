@@ -0,0 +1,81 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PairEvalFactory.h"
+#include "hoomd/hpmc/ClangCompiler.h"
+
+#include <sstream>
+#include <utility>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/Support/DynamicLibrary.h"
+
+#pragma GCC diagnostic pop
+
+/*! \file PairEvalFactory.cc
+    \brief Defines PairEvalFactory
+*/
+
+/*! \param cpp_code C++ code to compile
+    \param compiler_args Additional arguments to pass to the compiler
+*/
+PairEvalFactory::PairEvalFactory(const std::string& cpp_code,
+                                 const std::vector<std::string>& compiler_args)
+    : m_eval(nullptr)
+    {
+    std::ostringstream sstream;
+
+    // initialize LLVM
+    auto clang_compiler = ClangCompiler::getClangCompiler();
+
+    // Add the program's symbols into the JIT's search space.
+    if (llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr))
+        {
+        m_error_msg = "Error loading program symbols.\n";
+        return;
+        }
+
+    llvm::LLVMContext Context;
+
+    // compile the module, the bitcode is cached on disk by ClangCompiler
+    std::vector<std::string> args = compiler_args;
+#ifdef SINGLE_PRECISION
+    args.push_back("-DSINGLE_PRECISION");
+#endif
+    auto module = clang_compiler->compileCode(cpp_code, args, Context, sstream);
+
+    if (!module)
+        {
+        m_error_msg = sstream.str();
+        return;
+        }
+
+    m_jit = llvm::orc::KaleidoscopeJIT::Create();
+
+    if (!m_jit)
+        {
+        m_error_msg = "Could not initialize JIT.";
+        return;
+        }
+
+    if (auto E = m_jit->addModule(std::move(module)))
+        {
+        m_error_msg = "Could not add JIT module.";
+        return;
+        }
+
+    auto eval = m_jit->findSymbol("eval");
+
+    if (!eval)
+        {
+        m_error_msg = "Could not find eval function in LLVM module.";
+        return;
+        }
+
+    /// this cast is like this because 1) it works correctly like this and
+    /// 2) trying to use static_cast or reinterpret_cast gives compilation errors
+    m_eval = (EvalFnPtr)(long unsigned int)(eval->getAddress());
+    }
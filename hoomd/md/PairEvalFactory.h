@@ -0,0 +1,52 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+// do not include python headers
+#define HOOMD_LLVMJIT_BUILD
+#include "hoomd/HOOMDMath.h"
+
+#include "hoomd/hpmc/KaleidoscopeJIT.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file PairEvalFactory.h
+    \brief Declares the LLVM compiler of runtime generated MD pair functions
+*/
+
+//! Compile a runtime generated MD pair function with LLVM
+/*! The code must define the function eval with C linkage and the signature pair_jit_eval_t (see
+    EvaluatorPairJIT.h).
+*/
+class PairEvalFactory
+    {
+    public:
+    typedef Scalar (*EvalFnPtr)(Scalar r_sq,
+                                Scalar q_i,
+                                Scalar q_j,
+                                const Scalar* params,
+                                Scalar& force_divr);
+
+    //! Constructor
+    PairEvalFactory(const std::string& cpp_code, const std::vector<std::string>& compiler_args);
+
+    //! Return the evaluator
+    EvalFnPtr getEval()
+        {
+        return m_eval;
+        }
+
+    //! Get the error message from initialization
+    const std::string& getError()
+        {
+        return m_error_msg;
+        }
+
+    private:
+    std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
+    EvalFnPtr m_eval;                                  //!< Function pointer to evaluator
+    std::string m_error_msg; //!< The error message if initialization fails
+    };
@@ -1,8 +1,10 @@
 // Copyright (c) 2009-2021 The Regents of the University of Michigan
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
+#include "BondedForceChunks.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "hoomd/GlobalArray.h"
 #include <memory>
 
 #include <vector>
@@ -40,6 +42,9 @@ template<class evaluator> class PotentialBond : public ForceCompute
     virtual void setParams(unsigned int type, const param_type& param);
     virtual void setParamsPython(std::string type, pybind11::dict param);
 
+    /// Set the parameters for many types from columns of parameter values
+    virtual void setParamsBulk(pybind11::list types, pybind11::dict columns);
+
     /// Get the parameters
     pybind11::dict getParams(std::string type);
 
@@ -52,9 +57,10 @@ template<class evaluator> class PotentialBond : public ForceCompute
 #endif
 
     protected:
-    GPUArray<param_type> m_params;         //!< Bond parameters per type
+    GlobalArray<param_type> m_params;      //!< Bond parameters per type
     std::shared_ptr<BondData> m_bond_data; //!< Bond data to use in computing bonds
     std::string m_prof_name;               //!< Cached profiler name
+    BondedForceChunks m_chunks;            //!< Per-thread force buffers
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -75,7 +81,7 @@ PotentialBond<evaluator>::PotentialBond(std::shared_ptr<SystemDefinition> sysdef
     m_prof_name = std::string("Bond ") + evaluator::getName();
 
     // allocate the parameters
-    GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
+    GlobalArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
     }
 
@@ -124,6 +130,24 @@ void PotentialBond<evaluator>::setParamsPython(std::string type, pybind11::dict
     setParams(itype, struct_param);
     }
 
+/*! \param types List of bond type names
+    \param columns Map from parameter name to a sequence with one value per type
+
+    Sets the parameters of all given bond types in one call from Python.
+*/
+template<class evaluator>
+void PotentialBond<evaluator>::setParamsBulk(pybind11::list types, pybind11::dict columns)
+    {
+    for (size_t i = 0; i < types.size(); ++i)
+        {
+        pybind11::dict param;
+        for (auto column : columns)
+            param[column.first] = column.second[pybind11::int_(i)];
+
+        setParams(m_bond_data->getTypeByName(types[i].cast<std::string>()), param_type(param));
+        }
+    }
+
 /*! \param types Type of the bond to set parameters for using string
     \param param Parameter to set
 
@@ -180,10 +204,6 @@ template<class evaluator> void PotentialBond<evaluator>::computeForces(uint64_t
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i < 6; i++)
-        bond_virial[i] = Scalar(0.0);
-
     ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(),
                                                       access_location::host,
                                                       access_mode::read);
@@ -196,118 +216,138 @@ template<class evaluator> void PotentialBond<evaluator>::computeForces(uint64_t
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
 
-    for (unsigned int i = 0; i < size; i++)
-        {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
+    // compute the forces of the bonds [first, last)
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
+        for (unsigned int i = first; i < last; i++)
             {
-            this->m_exec_conf->msg->error()
-                << "bond." << evaluator::getName() << ": bond " << bond.tag[0] << " " << bond.tag[1]
-                << " incomplete." << std::endl
-                << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+            // lookup the tag of each of the particles participating in the bond
+            const typename BondData::members_t& bond = h_bonds.data[i];
+            assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
+            assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
+
+            // transform a and b into indices into the particle data arrays
+            // (MEM TRANSFER: 4 integers)
+            unsigned int idx_a = h_rtag.data[bond.tag[0]];
+            unsigned int idx_b = h_rtag.data[bond.tag[1]];
+
+            // throw an error if this bond is incomplete
+            if (idx_a >= max_local || idx_b >= max_local)
+                {
+                this->m_exec_conf->msg->error()
+                    << "bond." << evaluator::getName() << ": bond " << bond.tag[0] << " "
+                    << bond.tag[1] << " incomplete." << std::endl
+                    << std::endl;
+                throw std::runtime_error("Error in bond calculation");
+                }
 
-        // calculate d\vec{r}
-        // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+            // calculate d\vec{r}
+            // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
+            Scalar3 posa
+                = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+            Scalar3 posb
+                = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
 
-        Scalar3 dx = posb - posa;
+            Scalar3 dx = posb - posa;
 
-        // access diameter (if needed)
-        Scalar diameter_a = Scalar(0.0);
-        Scalar diameter_b = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            {
-            diameter_a = h_diameter.data[idx_a];
-            diameter_b = h_diameter.data[idx_b];
-            }
+            // access diameter (if needed)
+            Scalar diameter_a = Scalar(0.0);
+            Scalar diameter_b = Scalar(0.0);
+            if (evaluator::needsDiameter())
+                {
+                diameter_a = h_diameter.data[idx_a];
+                diameter_b = h_diameter.data[idx_b];
+                }
 
-        // access charge (if needed)
-        Scalar charge_a = Scalar(0.0);
-        Scalar charge_b = Scalar(0.0);
-        if (evaluator::needsCharge())
-            {
-            charge_a = h_charge.data[idx_a];
-            charge_b = h_charge.data[idx_b];
-            }
+            // access charge (if needed)
+            Scalar charge_a = Scalar(0.0);
+            Scalar charge_b = Scalar(0.0);
+            if (evaluator::needsCharge())
+                {
+                charge_a = h_charge.data[idx_a];
+                charge_b = h_charge.data[idx_b];
+                }
 
-        // if the vector crosses the box, pull it back
-        dx = box.minImage(dx);
+            // if the vector crosses the box, pull it back
+            dx = box.minImage(dx);
 
-        // calculate r_ab squared
-        Scalar rsq = dot(dx, dx);
+            // calculate r_ab squared
+            Scalar rsq = dot(dx, dx);
 
-        // compute the force and potential energy
-        Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
-        evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
-        if (evaluator::needsDiameter())
-            eval.setDiameter(diameter_a, diameter_b);
-        if (evaluator::needsCharge())
-            eval.setCharge(charge_a, charge_b);
+            // compute the force and potential energy
+            Scalar force_divr = Scalar(0.0);
+            Scalar bond_eng = Scalar(0.0);
+            evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
+            if (evaluator::needsDiameter())
+                eval.setDiameter(diameter_a, diameter_b);
+            if (evaluator::needsCharge())
+                eval.setCharge(charge_a, charge_b);
 
-        bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
+            bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
-        // Bond energy must be halved
-        bond_eng *= Scalar(0.5);
+            // Bond energy must be halved
+            bond_eng *= Scalar(0.5);
 
-        if (evaluated)
-            {
-            // calculate virial
-            if (compute_virial)
+            if (evaluated)
                 {
-                Scalar force_div2r = Scalar(1.0 / 2.0) * force_divr;
-                bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-                bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-                bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-                bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-                bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-                bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-                }
-
-            // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
-                {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                // calculate virial
+                Scalar bond_virial[6];
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_b] += bond_virial[i];
+                    {
+                    Scalar force_div2r = Scalar(1.0 / 2.0) * force_divr;
+                    bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+                    bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+                    bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+                    bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+                    bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+                    bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+                    }
+
+                // add the force to the particles (only for non-ghost particles)
+                if (idx_b < m_pdata->getN())
+                    {
+                    force[idx_b].x += force_divr * dx.x;
+                    force[idx_b].y += force_divr * dx.y;
+                    force[idx_b].z += force_divr * dx.z;
+                    force[idx_b].w += bond_eng;
+                    if (compute_virial)
+                        for (unsigned int i = 0; i < 6; i++)
+                            virial[i * virial_pitch + idx_b] += bond_virial[i];
+                    }
+
+                if (idx_a < m_pdata->getN())
+                    {
+                    force[idx_a].x -= force_divr * dx.x;
+                    force[idx_a].y -= force_divr * dx.y;
+                    force[idx_a].z -= force_divr * dx.z;
+                    force[idx_a].w += bond_eng;
+                    if (compute_virial)
+                        for (unsigned int i = 0; i < 6; i++)
+                            virial[i * virial_pitch + idx_a] += bond_virial[i];
+                    }
                 }
-
-            if (idx_a < m_pdata->getN())
+            else
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_a] += bond_virial[i];
+                this->m_exec_conf->msg->error()
+                    << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
+                    << std::endl;
+                throw std::runtime_error("Error in bond calculation");
                 }
             }
-        else
-            {
-            this->m_exec_conf->msg->error()
-                << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
-                << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
-        }
+    };
+
+    m_chunks.compute(m_exec_conf,
+                     size,
+                     m_pdata->getN(),
+                     h_force.data,
+                     h_virial.data,
+                     m_virial_pitch,
+                     compute_virial,
+                     compute_range);
 
     if (m_prof)
         m_prof->pop();
@@ -344,6 +384,7 @@ template<class T> void export_PotentialBond(pybind11::module& m, const std::stri
     pybind11::class_<T, ForceCompute, std::shared_ptr<T>>(m, name.c_str())
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def("setParams", &T::setParamsPython)
+        .def("setParamsBulk", &T::setParamsBulk)
         .def("getParams", &T::getParams);
     }
 
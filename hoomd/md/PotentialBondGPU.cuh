@@ -10,6 +10,9 @@
 #include "hoomd/TextureTools.h"
 
 #include "hoomd/BondedGroupData.cuh"
+#include "hoomd/GPUPartition.cuh"
+
+#include "MDPrecisionSetup.h"
 
 #include <assert.h>
 
@@ -37,11 +40,13 @@ struct bond_args_t
                 const Index2D& _gpu_table_indexer,
                 const unsigned int* _d_gpu_n_bonds,
                 const unsigned int _n_bond_types,
-                const unsigned int _block_size)
+                const unsigned int _block_size,
+                const GPUPartition& _gpu_partition)
         : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), N(_N), n_max(_n_max),
           d_pos(_d_pos), d_charge(_d_charge), d_diameter(_d_diameter), box(_box),
           d_gpu_bondlist(_d_gpu_bondlist), gpu_table_indexer(_gpu_table_indexer),
-          d_gpu_n_bonds(_d_gpu_n_bonds), n_bond_types(_n_bond_types), block_size(_block_size) {};
+          d_gpu_n_bonds(_d_gpu_n_bonds), n_bond_types(_n_bond_types), block_size(_block_size),
+          gpu_partition(_gpu_partition) {};
 
     Scalar4* d_force;                       //!< Force to write out
     Scalar* d_virial;                       //!< Virial to write out
@@ -57,6 +62,7 @@ struct bond_args_t
     const unsigned int* d_gpu_n_bonds;      //!< List of number of bonds stored on the GPU
     const unsigned int n_bond_types;        //!< Number of bond types in the simulation
     const unsigned int block_size;          //!< Block size to execute
+    const GPUPartition& gpu_partition;      //!< Split of the local particles among the GPUs
     };
 
 #ifdef __HIPCC__
@@ -68,7 +74,8 @@ struct bond_args_t
     \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
-    \param N Number of particles in the system
+    \param nwork Number of particles to process on this GPU
+    \param offset Index of the first particle processed on this GPU
     \param d_pos particle positions on the GPU
     \param d_charge particle charges
     \param d_diameter particle diameters
@@ -90,7 +97,8 @@ template<class evaluator>
 __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
                                                Scalar* d_virial,
                                                const size_t virial_pitch,
-                                               const unsigned int N,
+                                               const unsigned int nwork,
+                                               const unsigned int offset,
                                                const Scalar4* d_pos,
                                                const Scalar* d_charge,
                                                const Scalar* d_diameter,
@@ -120,9 +128,11 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
 
     __syncthreads();
 
-    if (idx >= N)
+    if (idx >= nwork)
         return;
 
+    idx += offset;
+
     // load in the length of the list for this thread (MEM TRANSFER: 4 bytes)
     int n_bonds = n_bonds_list[idx];
 
@@ -148,9 +158,9 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
         q += 0; // shut up compiler warning
 
     // initialize the force to 0
-    Scalar4 force = make_scalar4(0, 0, 0, 0);
+    ForceReal4 force = make_forcereal4(0, 0, 0, 0);
     // initialize the virial tensor to 0
-    Scalar virial[6];
+    ForceReal virial[6];
     for (unsigned int i = 0; i < 6; i++)
         virial[i] = 0;
 
@@ -223,10 +233,10 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
         }
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
-    d_force[idx] = force;
+    d_force[idx] = forcereal4_to_scalar4(force);
 
     for (unsigned int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+        d_virial[i * virial_pitch + idx] = Scalar(virial[i]);
     }
 
 #include <iostream>
@@ -257,32 +267,41 @@ hipError_t gpu_compute_bond_forces(const bond_args_t& bond_args,
 
     unsigned int run_block_size = min(bond_args.block_size, max_block_size);
 
-    // setup the grid to run the kernel
-    dim3 grid(bond_args.N / run_block_size + 1, 1, 1);
-    dim3 threads(run_block_size, 1, 1);
-
     const size_t shared_bytes = sizeof(typename evaluator::param_type) * bond_args.n_bond_types;
 
-    // run the kernel
-    hipLaunchKernelGGL(gpu_compute_bond_forces_kernel<evaluator>,
-                       grid,
-                       threads,
-                       shared_bytes,
-                       0,
-                       bond_args.d_force,
-                       bond_args.d_virial,
-                       bond_args.virial_pitch,
-                       bond_args.N,
-                       bond_args.d_pos,
-                       bond_args.d_charge,
-                       bond_args.d_diameter,
-                       bond_args.box,
-                       bond_args.d_gpu_bondlist,
-                       bond_args.gpu_table_indexer,
-                       bond_args.d_gpu_n_bonds,
-                       bond_args.n_bond_types,
-                       d_params,
-                       d_flags);
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = bond_args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = bond_args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid(nwork / run_block_size + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL(gpu_compute_bond_forces_kernel<evaluator>,
+                           grid,
+                           threads,
+                           shared_bytes,
+                           0,
+                           bond_args.d_force,
+                           bond_args.d_virial,
+                           bond_args.virial_pitch,
+                           nwork,
+                           range.first,
+                           bond_args.d_pos,
+                           bond_args.d_charge,
+                           bond_args.d_diameter,
+                           bond_args.box,
+                           bond_args.d_gpu_bondlist,
+                           bond_args.gpu_table_indexer,
+                           bond_args.d_gpu_n_bonds,
+                           bond_args.n_bond_types,
+                           d_params,
+                           d_flags);
+        }
 
     return hipSuccess;
     }
@@ -54,7 +54,7 @@ class PotentialBondGPU : public PotentialBond<evaluator>
 
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-    GPUArray<unsigned int> m_flags;     //!< Flags set during the kernel execution
+    GlobalArray<unsigned int> m_flags;  //!< Flags set during the kernel execution
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -77,12 +77,12 @@ PotentialBondGPU<evaluator, gpu_cgbf>::PotentialBondGPU(std::shared_ptr<SystemDe
         }
 
     // allocate and zero device memory
-    GPUArray<typename evaluator::param_type> params(this->m_bond_data->getNTypes(),
-                                                    this->m_exec_conf);
+    GlobalArray<typename evaluator::param_type> params(this->m_bond_data->getNTypes(),
+                                                       this->m_exec_conf);
     this->m_params.swap(params);
 
     // allocate flags storage on the GPU
-    GPUArray<unsigned int> flags(1, this->m_exec_conf);
+    GlobalArray<unsigned int> flags(1, this->m_exec_conf);
     m_flags.swap(flags);
 
     // reset flags
@@ -130,7 +130,7 @@ void PotentialBondGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::readwrite);
 
         {
-        const GPUArray<typename BondData::members_t>& gpu_bond_list
+        const GlobalArray<typename BondData::members_t>& gpu_bond_list
             = this->m_bond_data->getGPUTable();
         const Index2D& gpu_table_indexer = this->m_bond_data->getGPUTableIndexer();
 
@@ -145,6 +145,7 @@ void PotentialBondGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timestep)
         ArrayHandle<unsigned int> d_flags(m_flags, access_location::device, access_mode::readwrite);
 
         this->m_tuner->begin();
+        this->m_exec_conf->beginMultiGPU();
         gpu_cgbf(bond_args_t(d_force.data,
                              d_virial.data,
                              this->m_virial.getPitch(),
@@ -158,9 +159,11 @@ void PotentialBondGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timestep)
                              gpu_table_indexer,
                              d_gpu_n_bonds.data,
                              this->m_bond_data->getNTypes(),
-                             this->m_tuner->getParam()),
+                             this->m_tuner->getParam(),
+                             this->m_pdata->getGPUPartition()),
                  d_params.data,
                  d_flags.data);
+        this->m_exec_conf->endMultiGPU();
         }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -6,13 +6,19 @@
 #ifndef __POTENTIAL_PAIR_H__
 #define __POTENTIAL_PAIR_H__
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <stdexcept>
+#include <type_traits>
 
 #include "NeighborList.h"
+#include "NeighborListCompression.h"
+#include "NeighborListExclusionMask.h"
+#include "SparseForceAccumulator.h"
+#include "hoomd/CellList.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 #include "hoomd/GlobalArray.h"
@@ -20,6 +26,7 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/managed_allocator.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorPairTable.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -29,6 +36,11 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
     \details The heart of the code that computes pair potentials is in this file.
@@ -39,6 +51,71 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+namespace hoomd
+    {
+namespace detail
+    {
+//! Number of neighbors evaluated together by evaluators that provide evalForceAndEnergyBatch()
+/*! 8 doubles fill one AVX-512 register (two AVX2 registers), 16 floats do the same in single
+    precision.
+*/
+const unsigned int pair_batch_size = sizeof(Scalar) == 4 ? 16 : 8;
+
+//! Detect whether an evaluator provides the batched evaluation method
+template<class evaluator, class = void> struct has_eval_batch : std::false_type
+    {
+    };
+
+template<class evaluator>
+struct has_eval_batch<
+    evaluator,
+    decltype(void(&evaluator::template evalForceAndEnergyBatch<pair_batch_size>))>
+    : std::true_type
+    {
+    };
+
+//! Dispatch a block of pairs to evaluator::evalForceAndEnergyBatch
+/*! The primary template is never called. Only the specialization for evaluators that provide
+    evalForceAndEnergyBatch() references that method, so the code in PotentialPair compiles for all
+    evaluators.
+*/
+template<class evaluator, bool batched = has_eval_batch<evaluator>::value> struct PairBatch
+    {
+    static const bool enabled = false;
+
+    static void eval(const Scalar* rsq,
+                     const Scalar* rcutsq,
+                     const typename evaluator::param_type* params,
+                     Scalar* force_divr,
+                     Scalar* pair_eng,
+                     bool energy_shift)
+        {
+        }
+    };
+
+template<class evaluator> struct PairBatch<evaluator, true>
+    {
+    static const bool enabled = true;
+
+    static void eval(const Scalar* rsq,
+                     const Scalar* rcutsq,
+                     const typename evaluator::param_type* params,
+                     Scalar* force_divr,
+                     Scalar* pair_eng,
+                     bool energy_shift)
+        {
+        evaluator::template evalForceAndEnergyBatch<pair_batch_size>(rsq,
+                                                                     rcutsq,
+                                                                     params,
+                                                                     force_divr,
+                                                                     pair_eng,
+                                                                     energy_shift);
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
+
 //! Template class for computing pair potentials
 /*! <b>Overview:</b>
     PotentialPair computes standard pair potentials (and forces) between all particle pairs in the
@@ -71,6 +148,30 @@
    potentials are used. Thus, the combination of XPLOR switching + shifted potentials will not be
    supported to avoid slowing down the calculation for everyone.
 
+    <b>Batched evaluation</b>
+
+    An evaluator may provide a static template method evalForceAndEnergyBatch<n>() that evaluates n
+   pairs from structure of arrays inputs without branches (see EvaluatorPairLJ). computeForces()
+   detects it at compile time, gathers blocks of hoomd::detail::pair_batch_size neighbors and calls
+   it once per block so that the compiler can vectorize the evaluation. The neighbor positions and
+   types for the block are gathered from ParticleData::getPositionsSoA().
+
+    <b>Threading</b>
+
+    When built with TBB and more than one CPU thread is active, computeForces() splits the local
+   particles into one contiguous chunk per thread and evaluates the chunks in parallel in the
+   ExecutionConfiguration task arena. Each chunk writes the force on its own particles i directly.
+   With a half neighbor list, the third law contributions to particles j go to a per-chunk buffer
+   that is summed into the output in chunk order afterwards, so the result is reproducible for a
+   given number of threads.
+
+    <b>Overlapping the ghost update</b>
+
+    When the Communicator leaves a ghost update pending (see Communicator::communicate()),
+   computeForces() first evaluates the particles that have only local neighbors in the order given
+   by NeighborList::getGhostPartition(). It then waits for the ghost update to finish and evaluates
+   the remaining particles.
+
     <b>Implementation details</b>
 
     rcutsq, ronsq, and the params are stored per particle type pair. It wastes a little bit of
@@ -98,6 +199,8 @@ template<class evaluator> class PotentialPair : public ForceCompute
     //! Set and get the pair parameters for a single type pair
     virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param);
     virtual void setParamsPython(pybind11::tuple typ, pybind11::dict params);
+    /// Set the pair parameters for many type pairs from columns of parameter values
+    virtual void setParamsBulk(pybind11::list typ, pybind11::dict columns);
     /// Get params for a single type pair using a tuple of strings
     virtual pybind11::dict getParams(pybind11::tuple typ);
     //! Set the rcut for a single type pair
@@ -106,6 +209,8 @@ template<class evaluator> class PotentialPair : public ForceCompute
     Scalar getRCut(pybind11::tuple types);
     /// Set the rcut for a single type pair using a tuple of strings
     virtual void setRCutPython(pybind11::tuple types, Scalar r_cut);
+    /// Set the rcut for many type pairs and notify the neighbor list once
+    virtual void setRCutBulk(pybind11::list types, pybind11::list r_cut);
     //! Set ron for a single type pair
     virtual void setRon(unsigned int typ1, unsigned int typ2, Scalar ron);
     /// Get the r_on for a single type pair
@@ -131,6 +236,7 @@ template<class evaluator> class PotentialPair : public ForceCompute
     void setShiftMode(energyShiftMode mode)
         {
         m_shift_mode = mode;
+        m_tables_valid = false;
         }
 
     void setShiftModePython(std::string mode)
@@ -151,6 +257,7 @@ template<class evaluator> class PotentialPair : public ForceCompute
             {
             throw std::runtime_error("Invalid energy shift mode.");
             }
+        m_tables_valid = false;
         }
 
     /// Get the mode used for the energy shifting
@@ -169,6 +276,129 @@ template<class evaluator> class PotentialPair : public ForceCompute
             }
         }
 
+    /// Set whether to evaluate the pairs from interpolation tables
+    void setTabulate(bool tabulate)
+        {
+        if (tabulate && (evaluator::needsDiameter() || evaluator::needsCharge()))
+            {
+            throw std::runtime_error("Pair potentials that depend on the diameter or charge cannot "
+                                     "be tabulated.");
+            }
+        m_tabulate = tabulate;
+        m_tables_valid = false;
+        }
+
+    /// Get whether the pairs are evaluated from interpolation tables
+    bool getTabulate()
+        {
+        return m_tabulate;
+        }
+
+    /// Set whether to evaluate the pairs over tiles of cell list cells instead of neighbor rows
+    void setCellTiles(bool cell_tiles)
+        {
+        m_cell_tiles = cell_tiles;
+
+        // the neighbor list may not have been built while the tiles were in use
+        if (!cell_tiles)
+            m_nlist->forceUpdate();
+        }
+
+    /// Get whether the pairs are evaluated over tiles of cell list cells
+    bool getCellTiles()
+        {
+        return m_cell_tiles;
+        }
+
+    /// Set whether to choose between the neighbor list and cell tiles from the rebuild rate
+    void setAutoCellTiles(bool auto_cell_tiles)
+        {
+        m_auto_cell_tiles = auto_cell_tiles;
+        m_auto_window_open = false;
+
+        // the neighbor list may not have been built while the tiles were in use
+        if (m_auto_tiles_on)
+            m_nlist->forceUpdate();
+        m_auto_tiles_on = false;
+        }
+
+    /// Get whether the choice between the neighbor list and cell tiles is automatic
+    bool getAutoCellTiles()
+        {
+        return m_auto_cell_tiles;
+        }
+
+    /// Get the number of force computations that evaluated the pairs over cell tiles
+    uint64_t getNumCellTileComputes()
+        {
+        return m_num_cell_tile_computes;
+        }
+
+    /// Set whether the GPU kernels read a half neighbor list
+    /** The CPU always evaluates a half neighbor list, PotentialPairGPU switches the storage mode of
+        the neighbor list.
+    */
+    virtual void setHalfNList(bool half_nlist)
+        {
+        m_half_nlist = half_nlist;
+        }
+
+    /// Get whether the GPU kernels read a half neighbor list
+    bool getHalfNList()
+        {
+        return m_half_nlist;
+        }
+
+    /// Set whether each pair with a ghost is evaluated on one rank only
+    /** The force on the ghost is sent back to its owner with the net force, so the per-force
+        arrays of this potential miss the forces on particles whose pairs were evaluated on another
+        rank. Takes effect at the next ghost exchange.
+    */
+    void setReverseGhostForces(bool reverse_ghost_forces)
+        {
+        m_reverse_ghost_forces = reverse_ghost_forces;
+        }
+
+    /// Get whether each pair with a ghost is evaluated on one rank only
+    bool getReverseGhostForces()
+        {
+        return m_reverse_ghost_forces;
+        }
+
+    /// Set the number of entries in each interpolation table
+    void setTableWidth(unsigned int width)
+        {
+        if (width < 2)
+            {
+            throw std::runtime_error("table_width must be at least 2.");
+            }
+        m_table_width = width;
+        m_tables_valid = false;
+        }
+
+    /// Get the number of entries in each interpolation table
+    unsigned int getTableWidth()
+        {
+        return m_table_width;
+        }
+
+    /// Set the smallest distance in the interpolation tables
+    void setTableRMin(Scalar r_min)
+        {
+        if (r_min <= Scalar(0.0))
+            {
+            throw std::runtime_error("table_r_min must be positive.");
+            }
+        m_table_r_min = r_min;
+        m_tables_valid = false;
+        }
+
+    /// Get the smallest distance in the interpolation tables
+    Scalar getTableRMin()
+        {
+        return m_table_r_min;
+        }
+
     virtual void notifyDetach()
         {
         if (m_attached)
@@ -181,8 +411,23 @@ template<class evaluator> class PotentialPair : public ForceCompute
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! Pair potentials complete a pending ghost update after the interior particles
+    virtual bool overlapsGhostUpdate()
+        {
+        return true;
+        }
 #endif
 
+    //! Pair potentials only read the neighbor list and particle data
+    virtual bool supportsConcurrentCompute()
+        {
+        return true;
+        }
+
+    //! Build the neighbor list, the interpolation tables, and the positions for the batched path
+    virtual void prepareConcurrentCompute(uint64_t timestep);
+
     //! Calculates the energy between two lists of particles.
     template<class InputIterator>
     void computeEnergyBetweenSets(InputIterator first1,
@@ -195,6 +440,19 @@ template<class evaluator> class PotentialPair : public ForceCompute
     computeEnergyBetweenSetsPythonList(pybind11::array_t<int, pybind11::array::c_style> tags1,
                                        pybind11::array_t<int, pybind11::array::c_style> tags2);
 
+    //! Evaluate the force and energy of a single pair
+    static bool evalPair(Scalar rsq,
+                         Scalar rcutsq,
+                         Scalar ronsq,
+                         const param_type& param,
+                         energyShiftMode shift_mode,
+                         Scalar di,
+                         Scalar dj,
+                         Scalar qi,
+                         Scalar qj,
+                         Scalar& force_divr,
+                         Scalar& pair_eng);
+
     std::vector<std::string> getTypeShapeMapping() const
         {
         std::vector<std::string> type_shape_mapping(m_pdata->getNTypes());
@@ -207,6 +465,9 @@ template<class evaluator> class PotentialPair : public ForceCompute
         }
 
     protected:
+    /// PotentialPairFused evaluates this potential in its own pass over the neighbor list
+    template<class... evaluators> friend class PotentialPairFused;
+
     std::shared_ptr<NeighborList> m_nlist; //!< The neighborlist to use for the computation
     energyShiftMode m_shift_mode; //!< Store the mode with which to handle the energy shift at r_cut
     Index2D m_typpair_idx;        //!< Helper class for indexing per type pair arrays
@@ -223,13 +484,140 @@ template<class evaluator> class PotentialPair : public ForceCompute
     /// r_cut (not squared) given to the neighbor list
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    /// Evaluate the pairs from interpolation tables
+    bool m_tabulate = false;
+
+    /// Number of entries in each interpolation table
+    unsigned int m_table_width = 1000;
+
+    /// Smallest distance in the interpolation tables
+    Scalar m_table_r_min = Scalar(0.5);
+
+    /// Set when the interpolation tables match the current parameters
+    bool m_tables_valid = false;
+
+    /// Interpolation tables per type pair
+    std::vector<EvaluatorPairTable::param_type> m_table_params;
+
+    /// Evaluate the pairs over tiles of cell list cells when the neighbor list filters no pairs
+    bool m_cell_tiles = false;
+
+    /// Cell list for the cell tiles, created on first use
+    std::shared_ptr<CellList> m_tile_cell_list;
+
+    /// Number of force computations that evaluated the pairs over cell tiles
+    uint64_t m_num_cell_tile_computes = 0;
+
+    /// Choose cell tiles when the neighbor list is rebuilt on most steps
+    bool m_auto_cell_tiles = false;
+
+    /// Cell tiles chosen by the automatic mode
+    bool m_auto_tiles_on = false;
+
+    /// True when the automatic mode has started a measurement window
+    bool m_auto_window_open = false;
+
+    /// First step of the current measurement window
+    uint64_t m_auto_window_start = 0;
+
+    /// Number of neighbor list updates at the start of the window
+    uint64_t m_auto_window_updates = 0;
+
+    /// Number of steps over which the automatic mode measures the rebuild rate
+    static constexpr uint64_t auto_tiles_window = 100;
+
+    /// Number of steps the automatic mode keeps unmeasured cell tiles before measuring again
+    static constexpr uint64_t auto_tiles_hold = 1000;
+
+    /// Store the neighbor list in half mode on the GPU
+    bool m_half_nlist = false;
+
+    /// Evaluate each pair with a ghost on one rank only and send the force on the ghost back
+    bool m_reverse_ghost_forces = false;
+
+    /// Squared range [r_min^2, r_max^2) of r covered by each table
+    std::vector<Scalar2> m_table_rsq_range;
+
+    //! Tabulate the potential of each type pair
+    void buildTables();
+
+    //! Choose between the neighbor list and cell tiles in the automatic mode
+    void chooseCellTiles(uint64_t timestep);
+
+    //! Test whether the pairs are evaluated over cell tiles on this step
+    bool useCellTiles();
+
+    //! Build the cell list for the cell tiles
+    void updateCellTiles(uint64_t timestep);
+
+    //! Test whether the neighbor list must be built on this step
+    bool buildsNeighborList(bool use_cells)
+        {
+#ifdef ENABLE_MPI
+        // the neighbor list decides when particles migrate between ranks
+        if (m_comm)
+            return true;
+#endif
+        return !use_cells;
+        }
+
+    //! Test whether computeForcesRange() evaluates the neighbors in blocks
+    bool useBatch() const
+        {
+        // evaluators that provide evalForceAndEnergyBatch() process the neighbors in blocks,
+        // except with XPLOR smoothing which needs per pair post processing
+        return hoomd::detail::PairBatch<evaluator>::enabled && !evaluator::needsDiameter()
+               && !evaluator::needsCharge() && m_shift_mode != xplor && !m_tabulate;
+        }
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
+
+    //! Test whether each pair with a ghost is evaluated on one rank only
+    /*! With half storage, the pair of a local particle and a ghost is evaluated only on the rank
+        that owns the particle with the lower tag. The force on the ghost is sent back to its owner
+        with comm_flag::reverse_net_force, the energy and virial of the pair are added to the local
+        particle. Only enabled with setReverseGhostForces(). Derived classes that compute the
+        forces themselves return false.
+    */
+    virtual bool reversesGhostForces()
+        {
+        return m_reverse_ghost_forces && m_comm
+               && m_nlist->getStorageMode() == NeighborList::half;
+        }
+#endif
+
+#ifdef ENABLE_TBB
+    /// Per-chunk third law force and virial accumulators, covering the ghosts when their forces
+    /// are sent back
+    std::vector<SparseForceAccumulator> m_chunk_accumulators;
 #endif
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Add the forces to the net force arrays
+    virtual bool computeForcesIntoNet(uint64_t timestep);
+
+    //! Compute the forces into the given arrays
+    void computeForcesInto(uint64_t timestep,
+                           const GlobalArray<Scalar4>& force,
+                           const GlobalArray<Scalar>& virial,
+                           bool overwrite);
+
+    //! Compute the forces on a range of particles
+    void computeForcesRange(const unsigned int* order,
+                            unsigned int begin,
+                            unsigned int end,
+                            const GlobalArray<Scalar4>& force,
+                            const GlobalArray<Scalar>& virial,
+                            bool overwrite);
+
+    //! Compute the forces on all local particles over tiles of the cell list
+    void computeForcesCells(const GlobalArray<Scalar4>& force,
+                            const GlobalArray<Scalar>& virial,
+                            bool overwrite);
     };
 
 /*! \param sysdef System to compute forces on
@@ -258,7 +646,7 @@ PotentialPair<evaluator>::PotentialPair(std::shared_ptr<SystemDefinition> sysdef
 
     m_r_cut_nlist
         = std::make_shared<GlobalArray<Scalar>>(m_typpair_idx.getNumElements(), m_exec_conf);
-    nlist->addRCutMatrix(m_r_cut_nlist);
+    nlist->addRCutMatrix(m_r_cut_nlist, true);
 
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_pdata->getExecConf()->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
@@ -333,6 +721,7 @@ void PotentialPair<evaluator>::setParams(unsigned int typ1,
     validateTypes(typ1, typ2, "setting params");
     m_params[m_typpair_idx(typ1, typ2)] = param;
     m_params[m_typpair_idx(typ2, typ1)] = param;
+    m_tables_valid = false;
     }
 
 template<class evaluator>
@@ -343,6 +732,29 @@ void PotentialPair<evaluator>::setParamsPython(pybind11::tuple typ, pybind11::di
     setParams(typ1, typ2, param_type(params, m_exec_conf->isCUDAEnabled()));
     }
 
+/*! \param typ List of type pair tuples
+    \param columns Map from parameter name to a sequence with one value per type pair
+
+    Sets the parameters of all given type pairs in one call from Python.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::setParamsBulk(pybind11::list typ, pybind11::dict columns)
+    {
+    bool managed = m_exec_conf->isCUDAEnabled();
+    for (size_t i = 0; i < typ.size(); ++i)
+        {
+        pybind11::tuple pair = typ[i].cast<pybind11::tuple>();
+        auto typ1 = m_pdata->getTypeByName(pair[0].cast<std::string>());
+        auto typ2 = m_pdata->getTypeByName(pair[1].cast<std::string>());
+
+        pybind11::dict params;
+        for (auto column : columns)
+            params[column.first] = column.second[pybind11::int_(i)];
+
+        setParams(typ1, typ2, param_type(params, managed));
+        }
+    }
+
 template<class evaluator> pybind11::dict PotentialPair<evaluator>::getParams(pybind11::tuple typ)
     {
     auto typ1 = m_pdata->getTypeByName(typ[0].cast<std::string>());
@@ -390,6 +802,7 @@ void PotentialPair<evaluator>::setRcut(unsigned int typ1, unsigned int typ2, Sca
 
     // notify the neighbor list that we have changed r_cut values
     m_nlist->notifyRCutMatrixChange();
+    m_tables_valid = false;
     }
 
 template<class evaluator>
@@ -400,6 +813,38 @@ void PotentialPair<evaluator>::setRCutPython(pybind11::tuple types, Scalar r_cut
     setRcut(typ1, typ2, r_cut);
     }
 
+/*! \param types List of type pair tuples
+    \param r_cut Cutoff radius for each type pair
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::setRCutBulk(pybind11::list types, pybind11::list r_cut)
+    {
+        {
+        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::readwrite);
+
+        for (size_t i = 0; i < types.size(); ++i)
+            {
+            pybind11::tuple pair = types[i].cast<pybind11::tuple>();
+            auto typ1 = m_pdata->getTypeByName(pair[0].cast<std::string>());
+            auto typ2 = m_pdata->getTypeByName(pair[1].cast<std::string>());
+            validateTypes(typ1, typ2, "setting r_cut");
+
+            Scalar rcut = r_cut[i].cast<Scalar>();
+            h_rcutsq.data[m_typpair_idx(typ1, typ2)] = rcut * rcut;
+            h_rcutsq.data[m_typpair_idx(typ2, typ1)] = rcut * rcut;
+            h_r_cut_nlist.data[m_typpair_idx(typ1, typ2)] = rcut;
+            h_r_cut_nlist.data[m_typpair_idx(typ2, typ1)] = rcut;
+            }
+        }
+
+    // notify the neighbor list that we have changed r_cut values
+    m_nlist->notifyRCutMatrixChange();
+    m_tables_valid = false;
+    }
+
 template<class evaluator> Scalar PotentialPair<evaluator>::getRCut(pybind11::tuple types)
     {
     auto typ1 = m_pdata->getTypeByName(types[0].cast<std::string>());
@@ -422,6 +867,7 @@ void PotentialPair<evaluator>::setRon(unsigned int typ1, unsigned int typ2, Scal
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::readwrite);
     h_ronsq.data[m_typpair_idx(typ1, typ2)] = ron * ron;
     h_ronsq.data[m_typpair_idx(typ2, typ1)] = ron * ron;
+    m_tables_valid = false;
     }
 
 template<class evaluator> Scalar PotentialPair<evaluator>::getROn(pybind11::tuple types)
@@ -468,17 +914,145 @@ int PotentialPair<evaluator>::slotWriteGSDShapeSpec(gsd_handle& handle) const
 */
 template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t timestep)
     {
-    // start by updating the neighborlist
-    m_nlist->compute(timestep);
+    computeForcesInto(timestep, m_force, m_virial, true);
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+
+    computeForcesInto() finds everything it modifies outside of this class up to date afterwards.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::prepareConcurrentCompute(uint64_t timestep)
+    {
+    chooseCellTiles(timestep);
+    const bool use_cells = useCellTiles();
+    if (buildsNeighborList(use_cells))
+        m_nlist->compute(timestep);
+    if (use_cells)
+        updateCellTiles(timestep);
+
+    if (m_tabulate && !m_tables_valid)
+        buildTables();
+
+    if (useBatch() && !use_cells)
+        m_pdata->getPositionsSoA();
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+    \returns true, the forces, energies, and virials are added to the net force and virial arrays
+*/
+template<class evaluator> bool PotentialPair<evaluator>::computeForcesIntoNet(uint64_t timestep)
+    {
+    computeForcesInto(timestep, m_pdata->getNetForce(), m_pdata->getNetVirial(), false);
+    return true;
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+    \param force Array to store the forces and energies in
+    \param virial Array to store the virials in
+    \param overwrite When true, zero \a force and \a virial first. When false, add to them.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeForcesInto(uint64_t timestep,
+                                                 const GlobalArray<Scalar4>& force,
+                                                 const GlobalArray<Scalar>& virial,
+                                                 bool overwrite)
+    {
+    // start by updating the neighborlist, or the cell list when the pairs are evaluated over
+    // cell tiles
+    chooseCellTiles(timestep);
+    const bool use_cells = useCellTiles();
+    if (buildsNeighborList(use_cells))
+        m_nlist->compute(timestep);
 
     // start the profile for this compute
     if (m_prof)
         m_prof->push(m_prof_name);
 
+    if (m_tabulate && !m_tables_valid)
+        buildTables();
+
+    const unsigned int N = m_pdata->getN();
+
+    if (use_cells)
+        {
+#ifdef ENABLE_MPI
+        // the tiles include the ghost cells
+        if (m_comm)
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+        updateCellTiles(timestep);
+        computeForcesCells(force, virial, overwrite);
+        }
+#ifdef ENABLE_MPI
+    else if (m_comm && m_comm->isGhostUpdatePending())
+        {
+        // evaluate the particles with only local neighbors while the ghost positions are in flight
+        const unsigned int n_interior = m_nlist->getNInteriorParticles();
+            {
+            ArrayHandle<unsigned int> h_order(m_nlist->getGhostPartition(),
+                                              access_location::host,
+                                              access_mode::read);
+            computeForcesRange(h_order.data, 0, n_interior, force, virial, overwrite);
+            }
+
+        m_comm->finishUpdateGhosts(timestep);
+
+            {
+            ArrayHandle<unsigned int> h_order(m_nlist->getGhostPartition(),
+                                              access_location::host,
+                                              access_mode::read);
+            computeForcesRange(h_order.data, n_interior, N, force, virial, false);
+            }
+        }
+    else
+#endif
+        {
+        computeForcesRange(nullptr, 0, N, force, virial, overwrite);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param order Indices of the particles to evaluate, or nullptr to evaluate particles by index
+    \param begin First entry of \a order (or first particle) to evaluate
+    \param end One past the last entry of \a order (or last particle) to evaluate
+    \param force Array to store the forces and energies in
+    \param virial Array to store the virials in
+    \param overwrite When true, zero the forces and virials first. When false, add to them.
+
+    The particles in [begin, end) must not be evaluated again until the forces are overwritten.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeForcesRange(const unsigned int* order,
+                                                  unsigned int begin,
+                                                  unsigned int end,
+                                                  const GlobalArray<Scalar4>& force,
+                                                  const GlobalArray<Scalar>& virial,
+                                                  bool overwrite)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    const bool use_batch = useBatch();
+
+    // the batched path gathers neighbor positions from the structure of arrays copy, which must
+    // be requested before the positions are acquired below
+    const Scalar* pos_x = nullptr;
+    const Scalar* pos_y = nullptr;
+    const Scalar* pos_z = nullptr;
+    const unsigned int* pos_type = nullptr;
+    if (use_batch)
+        {
+        const pdata_positions_soa& soa = m_pdata->getPositionsSoA();
+        pos_x = soa.x.data();
+        pos_y = soa.y.data();
+        pos_z = soa.z.data();
+        pos_type = soa.type.data();
+        }
+
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
@@ -491,6 +1065,31 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
                                           access_location::host,
                                           access_mode::read);
 
+    // read the neighbors from the compressed rows when the neighbor list builds them
+    const bool compressed = m_nlist->getCompressed();
+    ArrayHandle<unsigned char> h_compressed_nlist(m_nlist->getCompressedNListArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+    ArrayHandle<size_t> h_compressed_head_list(m_nlist->getCompressedHeadList(),
+                                               access_location::host,
+                                               access_mode::read);
+
+    // skip the excluded pairs that the neighbor list left in the rows
+    const bool ex_masks = m_nlist->getExclusionMasksUsed();
+    ArrayHandle<unsigned int> h_ex_mask(m_nlist->getExMaskArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // iterate only over the cutoff shell of this potential when the rows are partitioned
+    const int shell = m_nlist->getShell(m_r_cut_nlist);
+    ArrayHandle<unsigned int> h_shell_n_neigh(m_nlist->getShellNNeighArray(),
+                                              access_location::host,
+                                              access_mode::read);
+    const unsigned int* n_neigh = shell >= 0
+                                      ? h_shell_n_neigh.data + shell * m_nlist->getShellPitch()
+                                      : h_n_neigh.data;
+
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
@@ -498,8 +1097,11 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // force arrays
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    const access_mode::Enum force_mode
+        = overwrite ? access_mode::overwrite : access_mode::readwrite;
+    ArrayHandle<Scalar4> h_force(force, access_location::host, force_mode);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, force_mode);
+    const size_t virial_pitch = virial.getPitch();
 
     const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
@@ -509,186 +1111,896 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    if (overwrite)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * force.getNumElements());
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * virial.getNumElements());
+        }
 
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+    const unsigned int N = m_pdata->getN();
 
-        // access diameter and charge (if needed)
-        Scalar di = Scalar(0.0);
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+    // evaluate each pair with a ghost on one rank only when the communicator sends the forces on
+    // ghosts back to their owners
+    bool ghost_third_law = false;
+#ifdef ENABLE_MPI
+    ghost_third_law = third_law && reversesGhostForces()
+                      && m_comm->getFlags()[comm_flag::reverse_net_force];
+#endif
+    const unsigned int n_third_law = ghost_third_law ? N + m_pdata->getNGhosts() : N;
 
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+    // Compute the forces on particles [first, last) of the range. Forces on i are added to
+    // h_force/h_virial, third law forces on j < n_third_law are added to chunk_j, or to
+    // h_force/h_virial when it is null.
+    auto compute_range
+        = [&](unsigned int first, unsigned int last, SparseForceAccumulator* chunk_j)
+    {
+        // for each particle
+        for (unsigned int ii = first; ii < last; ii++)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            const unsigned int i = order ? order[ii] : ii;
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
+            Scalar di = Scalar(0.0);
+            Scalar qi = Scalar(0.0);
             if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
+                di = h_diameter.data[i];
             if (evaluator::needsCharge())
-                qj = h_charge.data[j];
+                qi = h_charge.data[i];
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar3 fi = make_scalar3(0, 0, 0);
+            Scalar pei = 0.0;
+            Scalar virialxxi = 0.0;
+            Scalar virialxyi = 0.0;
+            Scalar virialxzi = 0.0;
+            Scalar virialyyi = 0.0;
+            Scalar virialyzi = 0.0;
+            Scalar virialzzi = 0.0;
+
+            // add the force, potential energy and virial of the pair (i,j) to the particle i, and
+            // to particle j if we are using the third law
+            auto accumulate
+                = [&](unsigned int j, const Scalar3& dx, Scalar force_divr, Scalar pair_eng)
+            {
+                // the local particle takes the whole energy and virial of a pair with a ghost
+                // whose force is sent back
+                const bool local_j = j < N;
+                const Scalar share_i
+                    = (ghost_third_law && !local_j) ? Scalar(1.0) : Scalar(0.5);
+                Scalar force_div2r = force_divr * share_i;
+                // add the force, potential energy and virial to the particle i
+                // (FLOPS: 8)
+                fi += dx * force_divr;
+                pei += pair_eng * share_i;
+                if (compute_virial)
+                    {
+                    virialxxi += force_div2r * dx.x * dx.x;
+                    virialxyi += force_div2r * dx.x * dx.y;
+                    virialxzi += force_div2r * dx.x * dx.z;
+                    virialyyi += force_div2r * dx.y * dx.y;
+                    virialyzi += force_div2r * dx.y * dx.z;
+                    virialzzi += force_div2r * dx.z * dx.z;
+                    }
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
+                // scalars / FLOPS: 8) only add force to local particles and to ghosts whose forces
+                // are sent back
+                if (third_law && j < n_third_law)
+                    {
+                    Scalar4* force_j = h_force.data + j;
+                    Scalar* virial_j = h_virial.data + j;
+                    size_t virial_j_pitch = virial_pitch;
+                    if (chunk_j)
+                        {
+                        chunk_j->locate(j, force_j, virial_j);
+                        virial_j_pitch = SparseForceAccumulator::page_size;
+                        }
+                    force_j->x -= dx.x * force_divr;
+                    force_j->y -= dx.y * force_divr;
+                    force_j->z -= dx.z * force_divr;
+                    if (!local_j)
+                        return;
+                    force_j->w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        {
+                        virial_j[0 * virial_j_pitch] += force_div2r * dx.x * dx.x;
+                        virial_j[1 * virial_j_pitch] += force_div2r * dx.x * dx.y;
+                        virial_j[2 * virial_j_pitch] += force_div2r * dx.x * dx.z;
+                        virial_j[3 * virial_j_pitch] += force_div2r * dx.y * dx.y;
+                        virial_j[4 * virial_j_pitch] += force_div2r * dx.y * dx.z;
+                        virial_j[5 * virial_j_pitch] += force_div2r * dx.z * dx.z;
+                        }
+                    }
+            };
 
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
+            // loop over all of the neighbors of this particle
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = n_neigh[i];
+            unsigned int k = 0;
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+            const unsigned int mask_i = ex_masks ? h_ex_mask.data[i] : 0;
+            const unsigned int tag_i = h_tag.data[i];
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+            // read the neighbors in order, decoding the compressed row if there is one
+            const unsigned char* packed
+                = compressed ? h_compressed_nlist.data + h_compressed_head_list.data[i] : nullptr;
+            unsigned int packed_j = 0;
+            auto neighbor = [&](unsigned int n) -> unsigned int
+            {
+                if (packed)
+                    {
+                    packed_j += nlist_compressed_read(packed);
+                    return packed_j;
+                    }
+                return h_nlist.data[myHead + n];
+            };
+
+            if (use_batch)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
+                // gather blocks of neighbors and evaluate them together in SoA form
+                const unsigned int B = hoomd::detail::pair_batch_size;
+                unsigned int b_j[B];
+                Scalar3 b_dx[B];
+                Scalar b_rsq[B];
+                Scalar b_rcutsq[B];
+                param_type b_params[B];
+                Scalar b_force_divr[B];
+                Scalar b_pair_eng[B];
+
+                while (k < size)
+                    {
+                    unsigned int n = 0;
+                    for (; k < size && n < B; k++)
+                        {
+                        unsigned int j = neighbor(k);
+                        assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                        // the rank of the ghost evaluates the pair
+                        if (ghost_third_law && j >= N && h_tag.data[j] < tag_i)
+                            continue;
+
+                        const unsigned int l = n++;
+                        Scalar3 pj = make_scalar3(pos_x[j], pos_y[j], pos_z[j]);
+                        Scalar3 dx = box.minImage(pi - pj);
+                        unsigned int typpair_idx = m_typpair_idx(typei, pos_type[j]);
+
+                        b_j[l] = j;
+                        b_dx[l] = dx;
+                        b_rsq[l] = dot(dx, dx);
+                        b_rcutsq[l] = h_rcutsq.data[typpair_idx];
+                        b_params[l] = m_params[typpair_idx];
+
+                        // place masked exclusions beyond the cutoff
+                        if (mask_i && nlist_ex_mask_excluded(mask_i, tag_i, h_tag.data[j]))
+                            {
+                            b_rsq[l] = Scalar(1.0);
+                            b_rcutsq[l] = Scalar(0.0);
+                            }
+                        }
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
+                    if (n == 0)
+                        break;
 
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+                    // pad the last block with pairs beyond the cutoff
+                    for (unsigned int l = n; l < B; l++)
+                        {
+                        b_rsq[l] = Scalar(1.0);
+                        b_rcutsq[l] = Scalar(0.0);
+                        b_params[l] = b_params[0];
+                        }
 
-            if (evaluated)
+                    hoomd::detail::PairBatch<evaluator>::eval(b_rsq,
+                                                              b_rcutsq,
+                                                              b_params,
+                                                              b_force_divr,
+                                                              b_pair_eng,
+                                                              m_shift_mode == shift);
+
+                    for (unsigned int l = 0; l < n; l++)
+                        accumulate(b_j[l], b_dx[l], b_force_divr[l], b_pair_eng[l]);
+                    }
+                }
+
+            for (; k < size; k++)
                 {
-                // modify the potential for xplor shifting
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int j = neighbor(k);
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                // the rank of the ghost evaluates the pair
+                if (ghost_third_law && j >= N && h_tag.data[j] < tag_i)
+                    continue;
+
+                if (mask_i && nlist_ex_mask_excluded(mask_i, tag_i, h_tag.data[j]))
+                    continue;
+
+                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dx = pi - pj;
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                // access diameter and charge (if needed)
+                Scalar dj = Scalar(0.0);
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    dj = h_diameter.data[j];
+                if (evaluator::needsCharge())
+                    qj = h_charge.data[j];
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r_ij squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                param_type param = m_params[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                Scalar ronsq = Scalar(0.0);
                 if (m_shift_mode == xplor)
+                    ronsq = h_ronsq.data[typpair_idx];
+
+                // compute the force and potential energy, interpolating the table where it
+                // covers r
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                bool evaluated;
+                if (m_tabulate && rsq >= m_table_rsq_range[typpair_idx].x
+                    && rsq < m_table_rsq_range[typpair_idx].y)
                     {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
+                    EvaluatorPairTable table(rsq, rcutsq, m_table_params[typpair_idx]);
+                    evaluated = table.evalForceAndEnergy(force_divr, pair_eng, false);
+                    }
+                else
+                    {
+                    evaluated = evalPair(rsq,
+                                         rcutsq,
+                                         ronsq,
+                                         param,
+                                         m_shift_mode,
+                                         di,
+                                         dj,
+                                         qi,
+                                         qj,
+                                         force_divr,
+                                         pair_eng);
+                    }
 
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                if (evaluated)
+                    {
+                    accumulate(j, dx, force_divr, pair_eng);
+                    }
+                }
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+            // finally, increment the force, potential energy and virial for particle i
+            unsigned int mem_idx = i;
+            h_force.data[mem_idx].x += fi.x;
+            h_force.data[mem_idx].y += fi.y;
+            h_force.data[mem_idx].z += fi.z;
+            h_force.data[mem_idx].w += pei;
+            if (compute_virial)
+                {
+                h_virial.data[0 * virial_pitch + mem_idx] += virialxxi;
+                h_virial.data[1 * virial_pitch + mem_idx] += virialxyi;
+                h_virial.data[2 * virial_pitch + mem_idx] += virialxzi;
+                h_virial.data[3 * virial_pitch + mem_idx] += virialyyi;
+                h_virial.data[4 * virial_pitch + mem_idx] += virialyzi;
+                h_virial.data[5 * virial_pitch + mem_idx] += virialzzi;
+                }
+            }
+    };
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
+#ifdef ENABLE_TBB
+    const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), end - begin);
+    if (n_chunks > 1)
+        {
+        const unsigned int chunk_size = (end - begin + n_chunks - 1) / n_chunks;
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx * force_divr;
-                pei += pair_eng * Scalar(0.5);
+        if (third_law && m_chunk_accumulators.size() < n_chunks)
+            m_chunk_accumulators.resize(n_chunks);
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                            {
+                            unsigned int first = begin + chunk * chunk_size;
+                            unsigned int last = std::min(first + chunk_size, end);
+                            if (third_law)
+                                {
+                                // each chunk zeroes only the pages of the particles it touches
+                                m_chunk_accumulators[chunk].reset(n_third_law, compute_virial);
+                                compute_range(first, last, &m_chunk_accumulators[chunk]);
+                                }
+                            else
+                                {
+                                compute_range(first, last, nullptr);
+                                }
+                            }
+                    },
+                    tbb::simple_partitioner());
+
+                if (!third_law)
+                    return;
+
+                // sum the third law contributions page by page in chunk order for a reproducible
+                // result
+                const unsigned int page_size = SparseForceAccumulator::page_size;
+                const unsigned int n_pages = m_chunk_accumulators[0].getNumPages();
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_pages),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int page = r.begin(); page != r.end(); ++page)
+                            {
+                            const unsigned int first = page * page_size;
+                            const unsigned int n = std::min(page_size, n_third_law - first);
+                            for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+                                {
+                                const SparseForceAccumulator& acc = m_chunk_accumulators[chunk];
+                                const Scalar4* f = acc.getPageForces(page);
+                                if (!f)
+                                    continue;
+
+                                for (unsigned int l = 0; l < n; ++l)
+                                    {
+                                    h_force.data[first + l].x += f[l].x;
+                                    h_force.data[first + l].y += f[l].y;
+                                    h_force.data[first + l].z += f[l].z;
+                                    h_force.data[first + l].w += f[l].w;
+                                    }
+
+                                const Scalar* v = acc.getPageVirials(page);
+                                if (!v)
+                                    continue;
+
+                                for (unsigned int k = 0; k < 6; ++k)
+                                    for (unsigned int l = 0; l < n; ++l)
+                                        h_virial.data[k * virial_pitch + first + l]
+                                            += v[k * page_size + l];
+                                }
+                            }
+                    });
+            });
+        }
+    else
+#endif
+        {
+        compute_range(begin, end, nullptr);
+        }
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+
+    The automatic mode counts the neighbor list updates over windows of auto_tiles_window steps. It
+    switches to the cell tiles when the neighbor list is rebuilt on at least half of the steps of a
+    window, and back when it is rebuilt on less than a quarter of them. Without domain
+    decomposition the neighbor list is not built while the tiles are in use, so after
+    auto_tiles_hold steps the mode goes back to the neighbor list for one window to measure again.
+
+    The first call in each window opens it, later calls on the same step do nothing.
+*/
+template<class evaluator> void PotentialPair<evaluator>::chooseCellTiles(uint64_t timestep)
+    {
+    if (!m_auto_cell_tiles)
+        return;
+
+    if (!m_auto_window_open || timestep < m_auto_window_start)
+        {
+        m_auto_window_open = true;
+        m_auto_window_start = timestep;
+        m_auto_window_updates = m_nlist->getNumUpdates();
+        return;
+        }
+
+    const bool builds_nlist = buildsNeighborList(true);
+    const bool measured = !m_auto_tiles_on || builds_nlist;
+    const uint64_t n_steps = timestep - m_auto_window_start;
+    if (n_steps < (measured ? uint64_t(auto_tiles_window) : uint64_t(auto_tiles_hold)))
+        return;
+
+    bool tiles = false;
+    if (measured)
+        {
+        const uint64_t n_builds = m_nlist->getNumUpdates() - m_auto_window_updates;
+        tiles = m_auto_tiles_on ? 4 * n_builds >= n_steps : 2 * n_builds >= n_steps;
+        }
+
+    if (tiles != m_auto_tiles_on)
+        {
+        m_exec_conf->msg->notice(4) << m_prof_name << ": "
+                                    << (tiles ? "evaluating cell tiles" : "using the neighbor list")
+                                    << " at step " << timestep << std::endl;
+
+        if (!tiles && !builds_nlist)
+            m_nlist->forceUpdate();
+        }
+
+    m_auto_tiles_on = tiles;
+    m_auto_window_start = timestep;
+    m_auto_window_updates = m_nlist->getNumUpdates();
+    }
+
+/*! \returns True when cell tiles are enabled (or chosen by the automatic mode), the neighbor list
+    excludes no pairs, and the potential has a non-zero cutoff
+*/
+template<class evaluator> bool PotentialPair<evaluator>::useCellTiles()
+    {
+    if (!(m_cell_tiles || m_auto_tiles_on) || m_nlist->getExclusionsSet()
+        || m_nlist->getFilterBody() || m_nlist->getDiameterShift())
+        return false;
+
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    return *std::max_element(h_rcutsq.data, h_rcutsq.data + m_rcutsq.getNumElements())
+           > Scalar(0.0);
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+
+    The cells are at least as wide as the largest cutoff, so the pairs of a particle within the
+    cutoff are in its own cell and the adjacent cells.
+*/
+template<class evaluator> void PotentialPair<evaluator>::updateCellTiles(uint64_t timestep)
+    {
+    if (!m_tile_cell_list)
+        {
+        m_tile_cell_list = std::make_shared<CellList>(m_sysdef);
+        m_tile_cell_list->setRadius(1);
+        m_tile_cell_list->setComputeXYZF(true);
+        m_tile_cell_list->setComputeTDB(true);
+        m_tile_cell_list->setFlagIndex();
+        m_tile_cell_list->setComputeAdjList(true);
+        }
+
+    Scalar r_cut_max = Scalar(0.0);
+        {
+        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+        r_cut_max = sqrt(
+            *std::max_element(h_rcutsq.data, h_rcutsq.data + m_rcutsq.getNumElements()));
+        }
+
+    if (m_tile_cell_list->getNominalWidth() != r_cut_max)
+        m_tile_cell_list->setNominalWidth(r_cut_max);
+
+    m_tile_cell_list->compute(timestep);
+    }
+
+/*! \param force Array to store the forces and energies in
+    \param virial Array to store the virials in
+    \param overwrite When true, zero \a force and \a virial first. When false, add to them.
+
+    Each cell of the cell list stores its particles contiguously. For each cell with local
+    particles (the home cell), the particles of each adjacent cell are copied into a tile in
+    structure of arrays form and every pair of a home particle and a tile particle is evaluated,
+    in blocks of hoomd::detail::pair_batch_size when the evaluator provides the batched method. The
+    forces on the home particles accumulate in registers and are written once per home cell, so
+    the cells evaluate in parallel without write conflicts and the result does not depend on the
+    number of threads.
+
+    Each pair is evaluated from both sides (like a full neighbor list), and each side takes half of
+    the energy and virial. The pairs are selected by the cutoff of the potential alone, which
+    matches the neighbor list only when it excludes no pairs (see useCellTiles()).
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeForcesCells(const GlobalArray<Scalar4>& force,
+                                                  const GlobalArray<Scalar>& virial,
+                                                  bool overwrite)
+    {
+    m_num_cell_tile_computes++;
+    const bool use_batch = useBatch();
+
+    const CellList& cl = *m_tile_cell_list;
+    ArrayHandle<unsigned int> h_cell_size(cl.getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(cl.getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(cl.getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_cell_tdb(cl.getTDBArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    const access_mode::Enum force_mode
+        = overwrite ? access_mode::overwrite : access_mode::readwrite;
+    ArrayHandle<Scalar4> h_force(force, access_location::host, force_mode);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, force_mode);
+    const size_t virial_pitch = virial.getPitch();
+
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+
+    const Index2D& cli = cl.getCellListIndexer();
+    const Index2D& cadji = cl.getCellAdjIndexer();
+    const unsigned int n_cells = cl.getCellIndexer().getNumElements();
+    const unsigned int Nmax = cl.getNmax();
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const unsigned int N = m_pdata->getN();
+    const bool compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
+
+    if (overwrite)
+        {
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * force.getNumElements());
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * virial.getNumElements());
+        }
+
+    // evaluate the cells [first, last)
+    auto compute_cells = [&](unsigned int first, unsigned int last)
+    {
+        // home particles: index, position, type, diameter, charge, and accumulators
+        std::vector<unsigned int> home_idx(Nmax);
+        std::vector<Scalar3> home_pos(Nmax);
+        std::vector<unsigned int> home_type(Nmax);
+        std::vector<Scalar> home_d(Nmax);
+        std::vector<Scalar> home_q(Nmax);
+        std::vector<Scalar4> home_force(Nmax);
+        std::vector<Scalar> home_virial(compute_virial ? 6 * Nmax : 0);
+
+        // tile of an adjacent cell in structure of arrays form
+        std::vector<unsigned int> tile_idx(Nmax);
+        std::vector<Scalar> tile_x(Nmax);
+        std::vector<Scalar> tile_y(Nmax);
+        std::vector<Scalar> tile_z(Nmax);
+        std::vector<unsigned int> tile_type(Nmax);
+        std::vector<Scalar> tile_d(Nmax);
+        std::vector<Scalar> tile_q(Nmax);
+
+        for (unsigned int cell = first; cell < last; cell++)
+            {
+            // gather the local particles of the cell, the forces on ghosts are not computed
+            unsigned int n_home = 0;
+            for (unsigned int k = 0; k < h_cell_size.data[cell]; k++)
+                {
+                const Scalar4 xyzf = h_cell_xyzf.data[cli(k, cell)];
+                const unsigned int idx = __scalar_as_int(xyzf.w);
+                if (idx >= N)
+                    continue;
+
+                const Scalar4 tdb = h_cell_tdb.data[cli(k, cell)];
+                home_idx[n_home] = idx;
+                home_pos[n_home] = make_scalar3(xyzf.x, xyzf.y, xyzf.z);
+                home_type[n_home] = __scalar_as_int(tdb.x);
+                home_d[n_home] = tdb.y;
+                home_q[n_home] = evaluator::needsCharge() ? h_charge.data[idx] : Scalar(0.0);
+                home_force[n_home] = make_scalar4(0, 0, 0, 0);
+                n_home++;
+                }
+
+            if (n_home == 0)
+                continue;
+
+            if (compute_virial)
+                std::fill(home_virial.begin(), home_virial.begin() + 6 * n_home, Scalar(0.0));
+
+            // add the force, potential energy and virial of a pair to the home particle h
+            auto accumulate
+                = [&](unsigned int h, const Scalar3& dx, Scalar force_divr, Scalar pair_eng)
+            {
+                home_force[h].x += dx.x * force_divr;
+                home_force[h].y += dx.y * force_divr;
+                home_force[h].z += dx.z * force_divr;
+                home_force[h].w += pair_eng * Scalar(0.5);
                 if (compute_virial)
                     {
-                    virialxxi += force_div2r * dx.x * dx.x;
-                    virialxyi += force_div2r * dx.x * dx.y;
-                    virialxzi += force_div2r * dx.x * dx.z;
-                    virialyyi += force_div2r * dx.y * dx.y;
-                    virialyzi += force_div2r * dx.y * dx.z;
-                    virialzzi += force_div2r * dx.z * dx.z;
+                    Scalar force_div2r = force_divr * Scalar(0.5);
+                    Scalar* v = home_virial.data() + 6 * h;
+                    v[0] += force_div2r * dx.x * dx.x;
+                    v[1] += force_div2r * dx.x * dx.y;
+                    v[2] += force_div2r * dx.x * dx.z;
+                    v[3] += force_div2r * dx.y * dx.y;
+                    v[4] += force_div2r * dx.y * dx.z;
+                    v[5] += force_div2r * dx.z * dx.z;
                     }
+            };
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
+            for (unsigned int adj = 0; adj < cadji.getW(); adj++)
+                {
+                const unsigned int neigh_cell = h_cell_adj.data[cadji(adj, cell)];
+
+                // load the tile
+                const unsigned int n_tile = h_cell_size.data[neigh_cell];
+                for (unsigned int k = 0; k < n_tile; k++)
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
+                    const Scalar4 xyzf = h_cell_xyzf.data[cli(k, neigh_cell)];
+                    const Scalar4 tdb = h_cell_tdb.data[cli(k, neigh_cell)];
+                    tile_idx[k] = __scalar_as_int(xyzf.w);
+                    tile_x[k] = xyzf.x;
+                    tile_y[k] = xyzf.y;
+                    tile_z[k] = xyzf.z;
+                    tile_type[k] = __scalar_as_int(tdb.x);
+                    tile_d[k] = tdb.y;
+                    if (evaluator::needsCharge())
+                        tile_q[k] = h_charge.data[tile_idx[k]];
+                    }
+
+                // evaluate all pairs of home particles and tile particles
+                for (unsigned int h = 0; h < n_home; h++)
+                    {
+                    const Scalar3 pi = home_pos[h];
+                    const unsigned int typei = home_type[h];
+                    unsigned int k = 0;
+
+                    if (use_batch)
+                        {
+                        const unsigned int B = hoomd::detail::pair_batch_size;
+                        Scalar3 b_dx[B];
+                        Scalar b_rsq[B];
+                        Scalar b_rcutsq[B];
+                        param_type b_params[B];
+                        Scalar b_force_divr[B];
+                        Scalar b_pair_eng[B];
+
+                        for (; k < n_tile; k += B)
+                            {
+                            const unsigned int n = std::min(B, n_tile - k);
+                            for (unsigned int l = 0; l < n; l++)
+                                {
+                                Scalar3 pj
+                                    = make_scalar3(tile_x[k + l], tile_y[k + l], tile_z[k + l]);
+                                Scalar3 dx = box.minImage(pi - pj);
+                                unsigned int typpair_idx = m_typpair_idx(typei, tile_type[k + l]);
+                                b_dx[l] = dx;
+                                b_rsq[l] = dot(dx, dx);
+                                b_rcutsq[l] = h_rcutsq.data[typpair_idx];
+                                b_params[l] = m_params[typpair_idx];
+
+                                // place the particle itself beyond the cutoff
+                                if (tile_idx[k + l] == home_idx[h])
+                                    {
+                                    b_rsq[l] = Scalar(1.0);
+                                    b_rcutsq[l] = Scalar(0.0);
+                                    }
+                                }
+
+                            // pad the last block with pairs beyond the cutoff
+                            for (unsigned int l = n; l < B; l++)
+                                {
+                                b_rsq[l] = Scalar(1.0);
+                                b_rcutsq[l] = Scalar(0.0);
+                                b_params[l] = b_params[0];
+                                }
+
+                            hoomd::detail::PairBatch<evaluator>::eval(b_rsq,
+                                                                      b_rcutsq,
+                                                                      b_params,
+                                                                      b_force_divr,
+                                                                      b_pair_eng,
+                                                                      m_shift_mode == shift);
+
+                            for (unsigned int l = 0; l < n; l++)
+                                accumulate(h, b_dx[l], b_force_divr[l], b_pair_eng[l]);
+                            }
+                        }
+
+                    for (; k < n_tile; k++)
                         {
-                        h_virial.data[0 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
-                        h_virial.data[1 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
-                        h_virial.data[2 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
-                        h_virial.data[3 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
-                        h_virial.data[4 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
-                        h_virial.data[5 * m_virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                        if (tile_idx[k] == home_idx[h])
+                            continue;
+
+                        Scalar3 pj = make_scalar3(tile_x[k], tile_y[k], tile_z[k]);
+                        Scalar3 dx = box.minImage(pi - pj);
+                        Scalar rsq = dot(dx, dx);
+
+                        unsigned int typpair_idx = m_typpair_idx(typei, tile_type[k]);
+                        Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                        Scalar ronsq = Scalar(0.0);
+                        if (m_shift_mode == xplor)
+                            ronsq = h_ronsq.data[typpair_idx];
+
+                        Scalar force_divr = Scalar(0.0);
+                        Scalar pair_eng = Scalar(0.0);
+                        bool evaluated;
+                        if (m_tabulate && rsq >= m_table_rsq_range[typpair_idx].x
+                            && rsq < m_table_rsq_range[typpair_idx].y)
+                            {
+                            EvaluatorPairTable table(rsq, rcutsq, m_table_params[typpair_idx]);
+                            evaluated = table.evalForceAndEnergy(force_divr, pair_eng, false);
+                            }
+                        else
+                            {
+                            evaluated = evalPair(rsq,
+                                                 rcutsq,
+                                                 ronsq,
+                                                 m_params[typpair_idx],
+                                                 m_shift_mode,
+                                                 home_d[h],
+                                                 tile_d[k],
+                                                 home_q[h],
+                                                 tile_q[k],
+                                                 force_divr,
+                                                 pair_eng);
+                            }
+
+                        if (evaluated)
+                            accumulate(h, dx, force_divr, pair_eng);
                         }
                     }
                 }
+
+            // write the forces on the home particles
+            for (unsigned int h = 0; h < n_home; h++)
+                {
+                const unsigned int i = home_idx[h];
+                h_force.data[i].x += home_force[h].x;
+                h_force.data[i].y += home_force[h].y;
+                h_force.data[i].z += home_force[h].z;
+                h_force.data[i].w += home_force[h].w;
+                if (compute_virial)
+                    {
+                    for (unsigned int c = 0; c < 6; c++)
+                        h_virial.data[c * virial_pitch + i] += home_virial[6 * h + c];
+                    }
+                }
             }
+    };
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
             {
-            h_virial.data[0 * m_virial_pitch + mem_idx] += virialxxi;
-            h_virial.data[1 * m_virial_pitch + mem_idx] += virialxyi;
-            h_virial.data[2 * m_virial_pitch + mem_idx] += virialxzi;
-            h_virial.data[3 * m_virial_pitch + mem_idx] += virialyyi;
-            h_virial.data[4 * m_virial_pitch + mem_idx] += virialyzi;
-            h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { compute_cells(r.begin(), r.end()); });
+            });
+        }
+    else
+#endif
+        {
+        compute_cells(0, n_cells);
+        }
+    }
+
+/*! Each type pair with r_cut > table_r_min gets a table of V and F at table_width evenly spaced r
+    values from table_r_min to r_cut, evaluated with evalPair() so the energy shift and XPLOR
+    smoothing are included. computeForces() interpolates the table for table_r_min <= r < r_cut - dr
+    and calls the evaluator outside of this range, so the last bin (where the table would
+    interpolate to 0 at r_cut) and close pairs remain exact.
+*/
+template<class evaluator> void PotentialPair<evaluator>::buildTables()
+    {
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+
+    const unsigned int n_pairs = m_typpair_idx.getNumElements();
+    m_table_params.clear();
+    m_table_params.resize(n_pairs);
+    m_table_rsq_range.assign(n_pairs, make_scalar2(0, 0));
+
+    for (unsigned int typpair_idx = 0; typpair_idx < n_pairs; typpair_idx++)
+        {
+        const Scalar rcutsq = h_rcutsq.data[typpair_idx];
+        const Scalar rcut = sqrt(rcutsq);
+        if (rcut <= m_table_r_min)
+            continue;
+
+        EvaluatorPairTable::param_type& table = m_table_params[typpair_idx];
+        table.rmin = m_table_r_min;
+        table.table = ManagedArray<Scalar4>(m_table_width, false);
+
+        const Scalar dr = (rcut - m_table_r_min) / Scalar(m_table_width);
+        std::vector<Scalar> V(m_table_width + 1, Scalar(0.0));
+        std::vector<Scalar> F(m_table_width + 1, Scalar(0.0));
+        for (unsigned int i = 0; i < m_table_width; i++)
+            {
+            const Scalar r = m_table_r_min + Scalar(i) * dr;
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            evalPair(r * r,
+                     rcutsq,
+                     h_ronsq.data[typpair_idx],
+                     m_params[typpair_idx],
+                     m_shift_mode,
+                     Scalar(0.0),
+                     Scalar(0.0),
+                     Scalar(0.0),
+                     Scalar(0.0),
+                     force_divr,
+                     pair_eng);
+            V[i] = pair_eng;
+            F[i] = force_divr * r;
             }
+
+        // V and F are 0 past the last entry, as in EvaluatorPairTable
+        for (unsigned int i = 0; i < m_table_width; i++)
+            table.table[i] = make_scalar4(V[i], F[i], V[i + 1] - V[i], F[i + 1] - F[i]);
+
+        const Scalar r_max = rcut - dr;
+        m_table_rsq_range[typpair_idx] = make_scalar2(m_table_r_min * m_table_r_min, r_max * r_max);
         }
 
-    if (m_prof)
-        m_prof->pop();
+    m_tables_valid = true;
+    }
+
+/*! \param rsq Squared distance between the particles
+    \param rcutsq Squared cutoff radius of the type pair
+    \param ronsq Squared XPLOR r_on of the type pair (only used in the xplor mode)
+    \param param Parameters of the type pair
+    \param shift_mode Energy shifting mode
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+    \param force_divr Set to the force divided by r
+    \param pair_eng Set to the pair energy
+    \returns true when the pair is within the cutoff and the outputs are set
+*/
+template<class evaluator>
+bool PotentialPair<evaluator>::evalPair(Scalar rsq,
+                                        Scalar rcutsq,
+                                        Scalar ronsq,
+                                        const param_type& param,
+                                        energyShiftMode shift_mode,
+                                        Scalar di,
+                                        Scalar dj,
+                                        Scalar qi,
+                                        Scalar qj,
+                                        Scalar& force_divr,
+                                        Scalar& pair_eng)
+    {
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (shift_mode == shift)
+        energy_shift = true;
+    else if (shift_mode == xplor)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    // compute the force and potential energy
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    // modify the potential for xplor shifting
+    if (evaluated && shift_mode == xplor)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing (FLOPS: 16)
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv
+                = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                       * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            // note: I'm not sure why the minus sign needs to be there: my notes have a + But this
+            // is verified correct via plotting
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+
+    return evaluated;
     }
 
 #ifdef ENABLE_MPI
@@ -705,6 +2017,13 @@ CommFlags PotentialPair<evaluator>::getRequestedCommFlags(uint64_t timestep)
     if (evaluator::needsDiameter())
         flags[comm_flag::diameter] = 1;
 
+    // send the forces on ghosts back to their owners, this requires the tags
+    if (reversesGhostForces())
+        {
+        flags[comm_flag::reverse_net_force] = 1;
+        flags[comm_flag::tag] = 1;
+        }
+
     flags |= ForceCompute::getRequestedCommFlags(timestep);
 
     return flags;
@@ -923,12 +2242,22 @@ template<class T> void export_PotentialPair(pybind11::module& m, const std::stri
     potentialpair
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>>())
         .def("setParams", &T::setParamsPython)
+        .def("setParamsBulk", &T::setParamsBulk)
         .def("getParams", &T::getParams)
         .def("setRCut", &T::setRCutPython)
+        .def("setRCutBulk", &T::setRCutBulk)
         .def("getRCut", &T::getRCut)
         .def("setROn", &T::setROnPython)
         .def("getROn", &T::getROn)
         .def_property("mode", &T::getShiftMode, &T::setShiftModePython)
+        .def_property("tabulate", &T::getTabulate, &T::setTabulate)
+        .def_property("table_width", &T::getTableWidth, &T::setTableWidth)
+        .def_property("table_r_min", &T::getTableRMin, &T::setTableRMin)
+        .def_property("cell_tiles", &T::getCellTiles, &T::setCellTiles)
+        .def_property("auto_cell_tiles", &T::getAutoCellTiles, &T::setAutoCellTiles)
+        .def("getNumCellTileComputes", &T::getNumCellTileComputes)
+        .def_property("half_nlist", &T::getHalfNList, &T::setHalfNList)
+        .def_property("reverse_ghost_forces", &T::getReverseGhostForces, &T::setReverseGhostForces)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec);
@@ -60,6 +60,12 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! The thermostat computes all particles in one pass
+    virtual bool overlapsGhostUpdate()
+        {
+        return false;
+        }
 #endif
 
     protected:
@@ -67,6 +73,23 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
 
     //! Actually compute the forces (overwrites PotentialPair::computeForces())
     virtual void computeForces(uint64_t timestep);
+
+    //! computeForces() does not add to the net force
+    virtual bool computeForcesIntoNet(uint64_t timestep)
+        {
+        return false;
+        }
+
+    //! Compute the forces on all local particles over the cells of the cell list
+    void computeForcesCellsThermo(uint64_t timestep);
+
+#ifdef ENABLE_MPI
+    //! computeForces() evaluates the pairs with ghosts on both ranks
+    virtual bool reversesGhostForces()
+        {
+        return false;
+        }
+#endif
     };
 
 /*! \param sysdef System to compute forces on
@@ -77,6 +100,8 @@ PotentialPairDPDThermo<evaluator>::PotentialPairDPDThermo(std::shared_ptr<System
                                                           std::shared_ptr<NeighborList> nlist)
     : PotentialPair<evaluator>(sysdef, nlist)
     {
+    // computeForces() does not skip the masked exclusions
+    this->m_nlist->setEvaluatesExclusionMasks(this->m_r_cut_nlist, false);
     }
 
 /*! \param T the temperature the system is thermostated on this time step.
@@ -99,13 +124,27 @@ template<class evaluator> std::shared_ptr<Variant> PotentialPairDPDThermo<evalua
 */
 template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(uint64_t timestep)
     {
-    // start by updating the neighborlist
-    this->m_nlist->compute(timestep);
+    // start by updating the neighborlist, or the cell list when the pairs are evaluated over
+    // cell tiles
+    this->chooseCellTiles(timestep);
+    const bool use_cells = this->useCellTiles();
+    if (this->buildsNeighborList(use_cells))
+        this->m_nlist->compute(timestep);
 
     // start the profile for this compute
     if (this->m_prof)
         this->m_prof->push(this->m_prof_name);
 
+    if (use_cells)
+        {
+        this->updateCellTiles(timestep);
+        computeForcesCellsThermo(timestep);
+
+        if (this->m_prof)
+            this->m_prof->pop();
+        return;
+        }
+
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
@@ -272,6 +311,148 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
         this->m_prof->pop();
     }
 
+/*! \param timestep specifies the current time step of the simulation
+
+    Evaluates each pair of a local particle and a particle in the same or an adjacent cell of the
+    cell list from both sides, like a full neighbor list. The random force of a pair is seeded with
+    the ordered tags, so both sides draw the same number. Each local particle is written by its own
+    cell only, so the cells evaluate in parallel without write conflicts.
+*/
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::computeForcesCellsThermo(uint64_t timestep)
+    {
+    this->m_num_cell_tile_computes++;
+    const CellList& cl = *this->m_tile_cell_list;
+    ArrayHandle<unsigned int> h_cell_size(cl.getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(cl.getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(cl.getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_cell_tdb(cl.getTDBArray(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_vel(this->m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::read);
+    ArrayHandle<unsigned int> h_tag(this->m_pdata->getTags(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(this->m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(this->m_virial, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_rcutsq(this->m_rcutsq, access_location::host, access_mode::read);
+
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * this->m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
+
+    const Index2D& cli = cl.getCellListIndexer();
+    const Index2D& cadji = cl.getCellAdjIndexer();
+    const unsigned int n_cells = cl.getCellIndexer().getNumElements();
+    const BoxDim& box = this->m_pdata->getGlobalBox();
+    const unsigned int N = this->m_pdata->getN();
+    const size_t virial_pitch = this->m_virial_pitch;
+
+    const uint16_t seed = this->m_sysdef->getSeed();
+    const Scalar currentTemp = (*m_T)(timestep);
+    const bool energy_shift = this->m_shift_mode == this->shift;
+
+    // evaluate the cells [first, last)
+    auto compute_cells = [&](unsigned int first, unsigned int last)
+    {
+        for (unsigned int cell = first; cell < last; cell++)
+            {
+            for (unsigned int m = 0; m < h_cell_size.data[cell]; m++)
+                {
+                const Scalar4 xyzf_i = h_cell_xyzf.data[cli(m, cell)];
+                const unsigned int i = __scalar_as_int(xyzf_i.w);
+
+                // the forces on ghosts are not computed
+                if (i >= N)
+                    continue;
+
+                const Scalar3 pi = make_scalar3(xyzf_i.x, xyzf_i.y, xyzf_i.z);
+                const Scalar3 vi = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
+                const unsigned int typei = __scalar_as_int(h_cell_tdb.data[cli(m, cell)].x);
+
+                Scalar3 fi = make_scalar3(0, 0, 0);
+                Scalar pei = 0.0;
+                Scalar viriali[6] = {0, 0, 0, 0, 0, 0};
+
+                for (unsigned int adj = 0; adj < cadji.getW(); adj++)
+                    {
+                    const unsigned int neigh_cell = h_cell_adj.data[cadji(adj, cell)];
+                    for (unsigned int k = 0; k < h_cell_size.data[neigh_cell]; k++)
+                        {
+                        const Scalar4 xyzf_j = h_cell_xyzf.data[cli(k, neigh_cell)];
+                        const unsigned int j = __scalar_as_int(xyzf_j.w);
+                        if (j == i)
+                            continue;
+
+                        Scalar3 dx = box.minImage(pi - make_scalar3(xyzf_j.x, xyzf_j.y, xyzf_j.z));
+                        Scalar3 dv
+                            = vi - make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+                        Scalar rsq = dot(dx, dx);
+
+                        const unsigned int typej
+                            = __scalar_as_int(h_cell_tdb.data[cli(k, neigh_cell)].x);
+                        unsigned int typpair_idx = this->m_typpair_idx(typei, typej);
+
+                        Scalar force_divr = Scalar(0.0);
+                        Scalar force_divr_cons = Scalar(0.0);
+                        Scalar pair_eng = Scalar(0.0);
+                        evaluator eval(rsq,
+                                       h_rcutsq.data[typpair_idx],
+                                       this->m_params[typpair_idx]);
+                        eval.set_seed_ij_timestep(seed, h_tag.data[i], h_tag.data[j], timestep);
+                        eval.setDeltaT(this->m_deltaT);
+                        eval.setRDotV(dot(dx, dv));
+                        eval.setT(currentTemp);
+
+                        if (eval.evalForceEnergyThermo(force_divr,
+                                                       force_divr_cons,
+                                                       pair_eng,
+                                                       energy_shift))
+                            {
+                            fi += dx * force_divr;
+                            pei += pair_eng * Scalar(0.5);
+
+                            Scalar force_div2r = Scalar(0.5) * force_divr_cons;
+                            viriali[0] += force_div2r * dx.x * dx.x;
+                            viriali[1] += force_div2r * dx.x * dx.y;
+                            viriali[2] += force_div2r * dx.x * dx.z;
+                            viriali[3] += force_div2r * dx.y * dx.y;
+                            viriali[4] += force_div2r * dx.y * dx.z;
+                            viriali[5] += force_div2r * dx.z * dx.z;
+                            }
+                        }
+                    }
+
+                h_force.data[i] = make_scalar4(fi.x, fi.y, fi.z, pei);
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial.data[l * virial_pitch + i] = viriali[l];
+                }
+            }
+    };
+
+#ifdef ENABLE_TBB
+    if (this->m_exec_conf->getNumThreads() > 1)
+        {
+        this->m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { compute_cells(r.begin(), r.end()); });
+            });
+        }
+    else
+#endif
+        {
+        compute_cells(0, n_cells);
+        }
+    }
+
 #ifdef ENABLE_MPI
 /*! \param timestep Current time step
  */
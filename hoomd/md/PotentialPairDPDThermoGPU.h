@@ -72,6 +72,12 @@ class PotentialPairDPDThermoGPU : public PotentialPairDPDThermo<evaluator>
         m_tuner->setEnabled(enable);
         }
 
+    //! The kernels access the particle data on the device, which is not shared between threads
+    virtual bool supportsConcurrentCompute()
+        {
+        return false;
+        }
+
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
     unsigned int m_param;               //!< Kernel tuning parameter
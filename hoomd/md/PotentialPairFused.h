@@ -0,0 +1,633 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __POTENTIAL_PAIR_FUSED_H__
+#define __POTENTIAL_PAIR_FUSED_H__
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "NeighborList.h"
+#include "NeighborListCompression.h"
+#include "NeighborListExclusionMask.h"
+#include "PotentialPair.h"
+#include "hoomd/ForceCompute.h"
+#include "hoomd/Index1D.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/Integrator.cuh"
+#endif
+
+/*! \file PotentialPairFused.h
+    \brief Defines the template class that evaluates several pair potentials in one pass
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Evaluates several pair potentials in a single pass over the neighbor list
+/*! <b>Overview:</b>
+    Each PotentialPair reads the positions, types, and neighbor list and writes its own force and
+    virial arrays, which Integrator::computeNetForce() then sums. PotentialPairFused takes a set of
+    PotentialPair objects (one per evaluator in the template parameter pack) that share a neighbor
+    list. It reads each neighbor once, computes dr once, evaluates all of the potentials for the
+    pair, and accumulates the total force, energy, and virial into its own arrays. Add the
+    PotentialPairFused to the integrator in place of the individual potentials.
+
+    The parameters, cutoffs, and shifting modes remain owned by the individual potentials. The
+    per-particle energies of each potential are written to its own force array, so they can be
+    logged as usual. The forces and virials of the individual potentials are zero.
+
+    On the GPU, each potential evaluates its forces with its own kernel and PotentialPairFused sums
+    them with gpu_integrator_sum_net_force(). This does not reduce the memory traffic, but keeps
+    the same interface on all devices.
+
+    PotentialPairFused evaluates the neighbors one pair at a time with one thread and does not
+    overlap the ghost update.
+*/
+template<class... evaluators> class PotentialPairFused : public ForceCompute
+    {
+    public:
+    //! Construct the fused pair potential
+    PotentialPairFused(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<NeighborList> nlist,
+                       std::shared_ptr<PotentialPair<evaluators>>... potentials);
+
+    //! Destructor
+    virtual ~PotentialPairFused();
+
+#ifdef ENABLE_MPI
+    //! Get ghost particle fields requested by the potentials
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+#endif
+
+    protected:
+    //! Host access to the arrays of one potential during computeForces()
+    template<class evaluator> struct PotentialAccess
+        {
+        PotentialAccess(PotentialPair<evaluator>& potential)
+            : pot(potential),
+              h_rcutsq(potential.m_rcutsq, access_location::host, access_mode::read),
+              h_ronsq(potential.m_ronsq, access_location::host, access_mode::read),
+              h_force(potential.m_force, access_location::host, access_mode::overwrite),
+              h_virial(potential.m_virial, access_location::host, access_mode::overwrite)
+            {
+            }
+
+        PotentialPair<evaluator>& pot;  //!< The potential
+        ArrayHandle<Scalar> h_rcutsq;   //!< Squared cutoff radius per type pair
+        ArrayHandle<Scalar> h_ronsq;    //!< Squared r_on per type pair
+        ArrayHandle<Scalar4> h_force;   //!< Force array of the potential
+        ArrayHandle<Scalar> h_virial;   //!< Virial array of the potential
+        };
+
+    std::shared_ptr<NeighborList> m_nlist; //!< The neighborlist to use for the computation
+    Index2D m_typpair_idx;                 //!< Helper class for indexing per type pair arrays
+    std::string m_prof_name;               //!< Cached profiler name
+
+    /// The fused potentials
+    std::tuple<std::shared_ptr<PotentialPair<evaluators>>...> m_potentials;
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+
+#ifdef ENABLE_HIP
+    //! Compute the forces of the potentials on the GPU and sum them
+    void computeForcesGPU(uint64_t timestep);
+#endif
+
+    //! Evaluate one potential for the pair (i, j)
+    template<class evaluator>
+    static void evalPotential(PotentialAccess<evaluator>& access,
+                              unsigned int i,
+                              unsigned int j,
+                              bool third_law_j,
+                              unsigned int typpair_idx,
+                              Scalar rsq,
+                              Scalar di,
+                              Scalar dj,
+                              Scalar qi,
+                              Scalar qj,
+                              Scalar& force_divr,
+                              Scalar& pair_eng);
+
+    //! Mark the forces of a potential as computed at \a timestep
+    template<class evaluator>
+    void setComputed(PotentialPair<evaluator>& potential, uint64_t timestep);
+
+    //! Check if any of the evaluators needs the diameter
+    static bool needsDiameter()
+        {
+        bool needs = false;
+        using expand = int[];
+        (void)expand {0, (needs = needs || evaluators::needsDiameter(), 0)...};
+        return needs;
+        }
+
+    //! Check if any of the evaluators needs the charge
+    static bool needsCharge()
+        {
+        bool needs = false;
+        using expand = int[];
+        (void)expand {0, (needs = needs || evaluators::needsCharge(), 0)...};
+        return needs;
+        }
+    };
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighborlist to use for computing the forces
+    \param potentials Pair potentials to evaluate, they must all use \a nlist
+*/
+template<class... evaluators>
+PotentialPairFused<evaluators...>::PotentialPairFused(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<NeighborList> nlist,
+    std::shared_ptr<PotentialPair<evaluators>>... potentials)
+    : ForceCompute(sysdef), m_nlist(nlist), m_typpair_idx(m_pdata->getNTypes()),
+      m_potentials(potentials...)
+    {
+    static_assert(sizeof...(evaluators) <= 6, "Fuse at most 6 pair potentials");
+    m_exec_conf->msg->notice(5) << "Constructing PotentialPairFused" << std::endl;
+
+    assert(m_pdata);
+    assert(m_nlist);
+
+    std::vector<std::shared_ptr<NeighborList>> nlists = {potentials->m_nlist...};
+    for (const auto& potential_nlist : nlists)
+        {
+        if (potential_nlist != m_nlist)
+            {
+            throw std::runtime_error("Fused pair potentials must share the neighbor list.");
+            }
+        }
+
+    m_prof_name = "Pair fused";
+    std::vector<std::string> names = {evaluators::getName()...};
+    for (const auto& name : names)
+        m_prof_name += std::string(" ") + name;
+    }
+
+template<class... evaluators> PotentialPairFused<evaluators...>::~PotentialPairFused()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PotentialPairFused" << std::endl;
+    }
+
+/*! \param access Host access to the potential
+    \param i Index of the first particle
+    \param j Index of the second particle
+    \param third_law_j When true, add half of the energy to particle j
+    \param typpair_idx Index of the type pair
+    \param rsq Squared distance between the particles
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+    \param force_divr Force divided by r, the force of the potential is added to it
+    \param pair_eng Pair energy, the energy of the potential is added to it
+*/
+template<class... evaluators>
+template<class evaluator>
+void PotentialPairFused<evaluators...>::evalPotential(PotentialAccess<evaluator>& access,
+                                                      unsigned int i,
+                                                      unsigned int j,
+                                                      bool third_law_j,
+                                                      unsigned int typpair_idx,
+                                                      Scalar rsq,
+                                                      Scalar di,
+                                                      Scalar dj,
+                                                      Scalar qi,
+                                                      Scalar qj,
+                                                      Scalar& force_divr,
+                                                      Scalar& pair_eng)
+    {
+    const PotentialPair<evaluator>& pot = access.pot;
+    Scalar rcutsq = access.h_rcutsq.data[typpair_idx];
+    Scalar ronsq = Scalar(0.0);
+    if (pot.m_shift_mode == PotentialPair<evaluator>::xplor)
+        ronsq = access.h_ronsq.data[typpair_idx];
+
+    Scalar potential_force_divr = Scalar(0.0);
+    Scalar potential_eng = Scalar(0.0);
+    if (PotentialPair<evaluator>::evalPair(rsq,
+                                           rcutsq,
+                                           ronsq,
+                                           pot.m_params[typpair_idx],
+                                           pot.m_shift_mode,
+                                           di,
+                                           dj,
+                                           qi,
+                                           qj,
+                                           potential_force_divr,
+                                           potential_eng))
+        {
+        force_divr += potential_force_divr;
+        pair_eng += potential_eng;
+
+        // the energy of each potential remains available for logging
+        access.h_force.data[i].w += potential_eng * Scalar(0.5);
+        if (third_law_j)
+            access.h_force.data[j].w += potential_eng * Scalar(0.5);
+        }
+    }
+
+/*! \param potential Potential whose forces were computed by computeForces()
+    \param timestep Current time step
+
+    A later call to potential.compute(timestep) (e.g. to log the energy) then keeps the energies
+    written by computeForces().
+*/
+template<class... evaluators>
+template<class evaluator>
+void PotentialPairFused<evaluators...>::setComputed(PotentialPair<evaluator>& potential,
+                                                    uint64_t timestep)
+    {
+    potential.m_first_compute = false;
+    potential.m_last_computed = timestep;
+    potential.m_particles_sorted = false;
+    potential.m_computed_flags = m_pdata->getFlags();
+    }
+
+/*! \post The total pair forces are computed for the given timestep and the energies of each
+   potential are written to its force array.
+
+    \param timestep specifies the current time step of the simulation
+*/
+template<class... evaluators>
+void PotentialPairFused<evaluators...>::computeForces(uint64_t timestep)
+    {
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        computeForcesGPU(timestep);
+        return;
+        }
+#endif
+
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
+
+    // start the profile for this compute
+    if (m_prof)
+        m_prof->push(m_prof_name);
+
+    // depending on the neighborlist settings, we can take advantage of newton's third law
+    // to reduce computations at the cost of memory access complexity: set that flag now
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    // access the neighbor list, particle data, and system box
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    // read the neighbors from the compressed rows when the neighbor list builds them
+    const bool compressed = m_nlist->getCompressed();
+    ArrayHandle<unsigned char> h_compressed_nlist(m_nlist->getCompressedNListArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+    ArrayHandle<size_t> h_compressed_head_list(m_nlist->getCompressedHeadList(),
+                                               access_location::host,
+                                               access_mode::read);
+
+    // skip the excluded pairs that the neighbor list left in the rows
+    const bool ex_masks = m_nlist->getExclusionMasksUsed();
+    ArrayHandle<unsigned int> h_ex_mask(m_nlist->getExMaskArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    // access the parameters and the (energy only) force arrays of each potential
+    std::tuple<PotentialAccess<evaluators>...> access(
+        *std::get<std::shared_ptr<PotentialPair<evaluators>>>(m_potentials)...);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    const bool needs_diameter = needsDiameter();
+    const bool needs_charge = needsCharge();
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        {
+        using expand = int[];
+        (void)expand {0,
+                      (memset((void*)std::get<PotentialAccess<evaluators>>(access).h_force.data,
+                              0,
+                              sizeof(Scalar4) * m_force.getNumElements()),
+                       memset((void*)std::get<PotentialAccess<evaluators>>(access).h_virial.data,
+                              0,
+                              sizeof(Scalar) * m_virial.getNumElements()),
+                       0)...};
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    // for each particle
+    for (unsigned int i = 0; i < N; i++)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        // access diameter and charge (if needed)
+        Scalar di = Scalar(0.0);
+        Scalar qi = Scalar(0.0);
+        if (needs_diameter)
+            di = h_diameter.data[i];
+        if (needs_charge)
+            qi = h_charge.data[i];
+
+        // initialize current particle force, potential energy, and virial to 0
+        Scalar3 fi = make_scalar3(0, 0, 0);
+        Scalar pei = 0.0;
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        // loop over all of the neighbors of this particle, the potentials check their own cutoffs
+        const unsigned int myHead = h_head_list.data[i];
+        const unsigned int size = h_n_neigh.data[i];
+        const unsigned char* packed
+            = compressed ? h_compressed_nlist.data + h_compressed_head_list.data[i] : nullptr;
+        unsigned int packed_j = 0;
+        const unsigned int mask_i = ex_masks ? h_ex_mask.data[i] : 0;
+        const unsigned int tag_i = h_tag.data[i];
+
+        for (unsigned int k = 0; k < size; k++)
+            {
+            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+            unsigned int j;
+            if (packed)
+                {
+                packed_j += nlist_compressed_read(packed);
+                j = packed_j;
+                }
+            else
+                {
+                j = h_nlist.data[myHead + k];
+                }
+            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+            if (mask_i && nlist_ex_mask_excluded(mask_i, tag_i, h_tag.data[j]))
+                continue;
+
+            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 dx = box.minImage(pi - pj);
+
+            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            assert(typej < m_pdata->getNTypes());
+
+            // access diameter and charge (if needed)
+            Scalar dj = Scalar(0.0);
+            Scalar qj = Scalar(0.0);
+            if (needs_diameter)
+                dj = h_diameter.data[j];
+            if (needs_charge)
+                qj = h_charge.data[j];
+
+            // calculate r_ij squared (FLOPS: 5)
+            Scalar rsq = dot(dx, dx);
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            bool third_law_j = third_law && j < N;
+
+            // sum the force and energy of all potentials
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+                {
+                using expand = int[];
+                (void)expand {0,
+                              (evalPotential(std::get<PotentialAccess<evaluators>>(access),
+                                             i,
+                                             j,
+                                             third_law_j,
+                                             typpair_idx,
+                                             rsq,
+                                             di,
+                                             dj,
+                                             qi,
+                                             qj,
+                                             force_divr,
+                                             pair_eng),
+                               0)...};
+                }
+
+            // add the force, potential energy and virial to the particle i
+            // (FLOPS: 8)
+            Scalar force_div2r = force_divr * Scalar(0.5);
+            fi += dx * force_divr;
+            pei += pair_eng * Scalar(0.5);
+            if (compute_virial)
+                {
+                virialxxi += force_div2r * dx.x * dx.x;
+                virialxyi += force_div2r * dx.x * dx.y;
+                virialxzi += force_div2r * dx.x * dx.z;
+                virialyyi += force_div2r * dx.y * dx.y;
+                virialyzi += force_div2r * dx.y * dx.z;
+                virialzzi += force_div2r * dx.z * dx.z;
+                }
+
+            // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars
+            // / FLOPS: 8) only add force to local particles
+            if (third_law_j)
+                {
+                h_force.data[j].x -= dx.x * force_divr;
+                h_force.data[j].y -= dx.y * force_divr;
+                h_force.data[j].z -= dx.z * force_divr;
+                h_force.data[j].w += pair_eng * Scalar(0.5);
+                if (compute_virial)
+                    {
+                    h_virial.data[0 * m_virial_pitch + j] += force_div2r * dx.x * dx.x;
+                    h_virial.data[1 * m_virial_pitch + j] += force_div2r * dx.x * dx.y;
+                    h_virial.data[2 * m_virial_pitch + j] += force_div2r * dx.x * dx.z;
+                    h_virial.data[3 * m_virial_pitch + j] += force_div2r * dx.y * dx.y;
+                    h_virial.data[4 * m_virial_pitch + j] += force_div2r * dx.y * dx.z;
+                    h_virial.data[5 * m_virial_pitch + j] += force_div2r * dx.z * dx.z;
+                    }
+                }
+            }
+
+        // finally, increment the force, potential energy and virial for particle i
+        h_force.data[i].x += fi.x;
+        h_force.data[i].y += fi.y;
+        h_force.data[i].z += fi.z;
+        h_force.data[i].w += pei;
+        if (compute_virial)
+            {
+            h_virial.data[0 * m_virial_pitch + i] += virialxxi;
+            h_virial.data[1 * m_virial_pitch + i] += virialxyi;
+            h_virial.data[2 * m_virial_pitch + i] += virialxzi;
+            h_virial.data[3 * m_virial_pitch + i] += virialyyi;
+            h_virial.data[4 * m_virial_pitch + i] += virialyzi;
+            h_virial.data[5 * m_virial_pitch + i] += virialzzi;
+            }
+        }
+
+        {
+        using expand = int[];
+        (void)expand {
+            0,
+            (setComputed(*std::get<std::shared_ptr<PotentialPair<evaluators>>>(m_potentials),
+                         timestep),
+             0)...};
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+#ifdef ENABLE_HIP
+/*! \param timestep specifies the current time step of the simulation
+ */
+template<class... evaluators>
+void PotentialPairFused<evaluators...>::computeForcesGPU(uint64_t timestep)
+    {
+    std::vector<ForceCompute*> forces
+        = {std::get<std::shared_ptr<PotentialPair<evaluators>>>(m_potentials).get()...};
+
+    // each potential evaluates its forces with its own kernel
+    for (auto force : forces)
+        force->compute(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, m_prof_name);
+
+    // fields of gpu_force_list, in order
+    Scalar4* gpu_force_list::*force_field[]
+        = {&gpu_force_list::f0,
+           &gpu_force_list::f1,
+           &gpu_force_list::f2,
+           &gpu_force_list::f3,
+           &gpu_force_list::f4,
+           &gpu_force_list::f5};
+    Scalar4* gpu_force_list::*torque_field[]
+        = {&gpu_force_list::t0,
+           &gpu_force_list::t1,
+           &gpu_force_list::t2,
+           &gpu_force_list::t3,
+           &gpu_force_list::t4,
+           &gpu_force_list::t5};
+    Scalar* gpu_force_list::*virial_field[]
+        = {&gpu_force_list::v0,
+           &gpu_force_list::v1,
+           &gpu_force_list::v2,
+           &gpu_force_list::v3,
+           &gpu_force_list::v4,
+           &gpu_force_list::v5};
+    size_t gpu_force_list::*pitch_field[] = {&gpu_force_list::vpitch0,
+                                             &gpu_force_list::vpitch1,
+                                             &gpu_force_list::vpitch2,
+                                             &gpu_force_list::vpitch3,
+                                             &gpu_force_list::vpitch4,
+                                             &gpu_force_list::vpitch5};
+
+    gpu_force_list force_list;
+    std::vector<std::unique_ptr<ArrayHandle<Scalar4>>> force_handles;
+    std::vector<std::unique_ptr<ArrayHandle<Scalar>>> virial_handles;
+    for (unsigned int n = 0; n < forces.size(); n++)
+        {
+        force_handles.emplace_back(new ArrayHandle<Scalar4>(forces[n]->getForceArray(),
+                                                            access_location::device,
+                                                            access_mode::read));
+        force_handles.emplace_back(new ArrayHandle<Scalar4>(forces[n]->getTorqueArray(),
+                                                            access_location::device,
+                                                            access_mode::read));
+        virial_handles.emplace_back(new ArrayHandle<Scalar>(forces[n]->getVirialArray(),
+                                                            access_location::device,
+                                                            access_mode::read));
+        force_list.*force_field[n] = force_handles[2 * n]->data;
+        force_list.*torque_field[n] = force_handles[2 * n + 1]->data;
+        force_list.*virial_field[n] = virial_handles[n]->data;
+        force_list.*pitch_field[n] = forces[n]->getVirialArray().getPitch();
+        }
+
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_torque(m_torque, access_location::device, access_mode::overwrite);
+
+    PDataFlags flags = this->m_pdata->getFlags();
+
+    m_exec_conf->beginMultiGPU();
+
+    gpu_integrator_sum_net_force(d_force.data,
+                                 d_virial.data,
+                                 m_virial.getPitch(),
+                                 d_torque.data,
+                                 force_list,
+                                 m_pdata->getN(),
+                                 true,
+                                 flags[pdata_flag::pressure_tensor],
+                                 m_pdata->getGPUPartition());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_exec_conf->endMultiGPU();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+#endif
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+template<class... evaluators>
+CommFlags PotentialPairFused<evaluators...>::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags = ForceCompute::getRequestedCommFlags(timestep);
+
+    std::vector<ForceCompute*> forces
+        = {std::get<std::shared_ptr<PotentialPair<evaluators>>>(m_potentials).get()...};
+    for (auto force : forces)
+        flags |= force->getRequestedCommFlags(timestep);
+
+    return flags;
+    }
+#endif
+
+//! Export this fused pair potential to python
+/*! \param name Name of the class in the exported python module
+    \tparam evaluators Evaluators of the fused potentials, in the order of the constructor arguments
+*/
+template<class... evaluators>
+void export_PotentialPairFused(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<PotentialPairFused<evaluators...>,
+                     ForceCompute,
+                     std::shared_ptr<PotentialPairFused<evaluators...>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            std::shared_ptr<PotentialPair<evaluators>>...>());
+    }
+
+#endif // __POTENTIAL_PAIR_FUSED_H__
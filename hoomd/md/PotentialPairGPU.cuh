@@ -6,16 +6,27 @@
 
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
-#include "hoomd/ParticleData.cuh"
 #include "hoomd/TextureTools.h"
 
+// NVRTC compiles only the kernels for PotentialPairJITGPU, without the host side launchers
+#ifndef HOOMD_LLVMJIT_BUILD
 #include "hoomd/GPUPartition.cuh"
+#include "hoomd/ParticleData.cuh"
+#else
+#include "hoomd/BoxDim.h"
+#endif
+
+#include "MDPrecisionSetup.h"
+#include "NeighborListCompression.h"
+#include "NeighborListExclusionMask.h"
+#include "NeighborListGPUCluster.cuh"
 
 #ifdef __HIPCC__
 #include "hoomd/WarpTools.cuh"
 #endif // __HIPCC__
 
 #include <assert.h>
+#include <stdint.h>
 #include <type_traits>
 
 /*! \file PotentialPairGPU.cuh
@@ -33,6 +44,29 @@ const int gpu_pair_force_max_tpp = 32;
 const int gpu_pair_force_max_tpp = 64;
 #endif
 
+//! Next smaller number of threads per particle with compiled pair force kernels
+/*! The kernels are compiled for 1, 4, 8, and 32 (and 64 on devices with 64 wide wavefronts)
+    threads per particle, the values the autotuner selects in practice. Skipping 2 and 16 removes a
+    third of the kernel instantiations of every evaluator. All other branches on the kernel
+    configuration are template parameters or constant evaluator properties and compile away.
+*/
+constexpr int gpu_pair_force_next_tpp(int tpp)
+    {
+    return tpp > 32 ? 32 : tpp > 8 ? 8 : tpp > 4 ? 4 : tpp > 1 ? 1 : 0;
+    }
+
+//! Test whether the pair force kernels are compiled for the given number of threads per particle
+inline bool gpu_pair_force_has_tpp(unsigned int tpp)
+    {
+    for (int t = gpu_pair_force_max_tpp; t > 0; t = gpu_pair_force_next_tpp(t))
+        {
+        if (static_cast<unsigned int>(t) == tpp)
+            return true;
+        }
+    return false;
+    }
+
+#ifndef HOOMD_LLVMJIT_BUILD
 //! Wraps arguments to gpu_cgpf
 struct pair_args_t
     {
@@ -58,14 +92,16 @@ struct pair_args_t
                 const unsigned int _compute_virial,
                 const unsigned int _threads_per_particle,
                 const GPUPartition& _gpu_partition,
-                const hipDeviceProp_t& _devprop)
+                const hipDeviceProp_t& _devprop,
+                const unsigned int* _d_index = nullptr,
+                const unsigned int _n_index = 0)
         : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), N(_N), n_max(_n_max),
           d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge), box(_box),
           d_n_neigh(_d_n_neigh), d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq),
           d_ronsq(_d_ronsq), size_neigh_list(_size_neigh_list), ntypes(_ntypes),
           block_size(_block_size), shift_mode(_shift_mode), compute_virial(_compute_virial),
           threads_per_particle(_threads_per_particle), gpu_partition(_gpu_partition),
-          devprop(_devprop) {};
+          devprop(_devprop), d_index(_d_index), n_index(_n_index) {};
 
     Scalar4* d_force;          //!< Force to write out
     Scalar* d_virial;          //!< Virial to write out
@@ -90,10 +126,134 @@ struct pair_args_t
     const unsigned int threads_per_particle; //!< Number of threads per particle (maximum: 1 warp)
     const GPUPartition& gpu_partition; //!< The load balancing partition of particles between GPUs
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
+
+    //! Particle indices to evaluate, nullptr to evaluate the particles of each GPU partition
+    const unsigned int* d_index;
+    const unsigned int n_index; //!< Number of entries in d_index
+
+    //! Number of j clusters of each i cluster, nullptr to use the per-particle neighbor list
+    const unsigned int* d_n_cluster_neigh = nullptr;
+    const unsigned int* d_cluster_nlist = nullptr; //!< j clusters of each i cluster
+    const uint64_t* d_cluster_mask = nullptr;      //!< Interaction mask of each cluster pair
+    unsigned int cluster_nmax = 0;                 //!< Maximum number of j clusters per i cluster
+
+    //! Compressed neighbor list, nullptr to read d_nlist (see NeighborListCompression.h)
+    const unsigned char* d_compressed_nlist = nullptr;
+    const size_t* d_compressed_head_list = nullptr; //!< Byte offsets of the compressed rows
+
+    //! Exclusion masks by particle index, nullptr when the neighbor list holds no excluded pairs
+    //! (see NeighborListExclusionMask.h)
+    const unsigned int* d_ex_mask = nullptr;
+    const unsigned int* d_tag = nullptr; //!< Particle tags to evaluate the exclusion masks
+
+    //! Cache the per type pair parameters in shared memory when they fit, read them from global
+    //! memory otherwise
+    bool shared_params = true;
+
+    //! Evaluate each pair once and add the reaction to the neighbor with atomic adds, the force
+    //! and virial arrays must be zeroed first (standard neighbor list only)
+    bool half = false;
+
+    hipStream_t stream = 0; //!< Stream to launch the kernels on
     };
+#endif // HOOMD_LLVMJIT_BUILD
 
 #ifdef __HIPCC__
 
+//! Evaluate the force and energy of a single pair
+/*! \param force_divr Set to the force divided by r
+    \param pair_eng Set to the pair energy
+    \param rsq Squared distance between the particles
+    \param rcutsq Squared cutoff of the type pair
+    \param ronsq Squared XPLOR switching distance of the type pair
+    \param param Parameters of the type pair
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+   switching is enabled
+*/
+template<class evaluator, unsigned int shift_mode>
+__device__ inline void gpu_pair_force_evaluate(Scalar& force_divr,
+                                               Scalar& pair_eng,
+                                               const Scalar rsq,
+                                               const Scalar rcutsq,
+                                               const Scalar ronsq,
+                                               const typename evaluator::param_type& param,
+                                               const Scalar di,
+                                               const Scalar dj,
+                                               const Scalar qi,
+                                               const Scalar qj)
+    {
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (shift_mode == 1)
+        energy_shift = true;
+    else if (shift_mode == 2)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    if (shift_mode == 2)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv
+                = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                       * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+    }
+
+//! Atomically add to a force or virial component
+/*! \param address Address to add to
+    \param val Value to add
+*/
+__device__ inline void gpu_pair_force_atomic_add(Scalar* address, Scalar val)
+    {
+#if !defined(SINGLE_PRECISION) && defined(__HIP_PLATFORM_NVCC__) && (__CUDA_ARCH__ < 600)
+    unsigned long long int* address_as_ull = (unsigned long long int*)address;
+    unsigned long long int old = *address_as_ull, assumed;
+
+    do
+        {
+        assumed = old;
+        old = atomicCAS(address_as_ull,
+                        assumed,
+                        __double_as_longlong(val + __longlong_as_double(assumed)));
+        } while (assumed != old);
+#else
+    atomicAdd(address, val);
+#endif
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -109,31 +269,49 @@ struct pair_args_t
     \param d_n_neigh Device memory array listing the number of neighbors for each particle
     \param d_nlist Device memory array containing the neighbor list contents
     \param d_head_list Indexes for reading \a d_nlist
+    \param d_ex_mask Exclusion masks of the pairs left in \a d_nlist, or nullptr
+    \param d_tag Particle tags, read when \a d_ex_mask is set
     \param d_params Parameters for the potential, stored per type pair
     \param d_rcutsq rcut squared, stored per type pair
     \param d_ronsq ron squared, stored per type pair
     \param ntypes Number of types in the simulation
     \param offset Offset of first particle
+    \param d_index Particle indices to evaluate (indexed by thread, offset included), or nullptr
+    \param half When true, evaluate each pair once and add the reaction to local neighbors
+    \param n_local Number of local particles, the neighbors with a higher index are ghosts
 
     \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei,
    typej) to access the unique value for that type pair. These values are all cached into shared
    memory for quick access, so a dynamic amount of shared memory must be allocated for this kernel
    launch. The amount is (2*sizeof(Scalar) + sizeof(typename evaluator::param_type)) *
-   typpair_idx.getNumElements()
+   typpair_idx.getNumElements(). With many types, this exceeds the shared memory of a block or
+   limits the occupancy. When \a shared_params is false, the kernel reads the values from global
+   memory instead and needs no dynamic shared memory.
 
     Certain options are controlled via template parameters to avoid the performance hit when they
    are not enabled. \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r \tparam
    shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR switching
    is enabled (See PotentialPair for a discussion on what that entails) \tparam compute_virial When
    non-zero, the virial tensor is computed. When zero, the virial tensor is not computed. \tparam
-   tpp Number of threads to use per particle, must be power of 2 and smaller than warp size
+   tpp Number of threads to use per particle, must be power of 2 and smaller than warp size \tparam
+   shared_params When true, the per type pair parameters are cached in shared memory
 
     <b>Implementation details</b>
     Each block will calculate the forces on a block of particles.
     Each group of \a tpp threads will calculate the total force on one particle.
     The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+
+    When \a half is set, each group skips the local neighbors with a lower index and adds the
+    reaction of every other pair with a local neighbor to that neighbor with atomic adds, so each
+    pair is evaluated once. This works with both half and full neighbor list rows. The ghosts get
+    no reaction: the rank that owns a ghost evaluates the pair in its own row. \a d_force and \a
+    d_virial must be zeroed before the launch.
 */
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         int tpp,
+         bool shared_params>
 __global__ void
 gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                                       Scalar* d_virial,
@@ -146,11 +324,16 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                                       const unsigned int* d_n_neigh,
                                       const unsigned int* d_nlist,
                                       const unsigned int* d_head_list,
+                                      const unsigned int* d_ex_mask,
+                                      const unsigned int* d_tag,
                                       const typename evaluator::param_type* d_params,
                                       const Scalar* d_rcutsq,
                                       const Scalar* d_ronsq,
                                       const unsigned int ntypes,
                                       const unsigned int offset,
+                                      const unsigned int* d_index,
+                                      const bool half,
+                                      const unsigned int n_local,
                                       unsigned int max_extra_bytes)
     {
     Index2D typpair_idx(ntypes);
@@ -166,36 +349,45 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                             * (sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
 
     // load in the per type pair parameters
-    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+    if (shared_params)
         {
-        if (cur_offset + threadIdx.x < num_typ_parameters)
+        for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
             {
-            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
-            if (shift_mode == 2)
-                s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+            if (cur_offset + threadIdx.x < num_typ_parameters)
+                {
+                s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+                if (shift_mode == 2)
+                    s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+                }
             }
-        }
 
-    unsigned int param_size
-        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
-    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < param_size)
+        unsigned int param_size
+            = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
             {
-            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
+            if (cur_offset + threadIdx.x < param_size)
+                {
+                ((int*)s_params)[cur_offset + threadIdx.x]
+                    = ((int*)d_params)[cur_offset + threadIdx.x];
+                }
             }
-        }
 
-    // initialize extra shared mem
-    auto s_extra = reinterpret_cast<char*>(s_ronsq + num_typ_parameters);
+        // initialize extra shared mem
+        auto s_extra = reinterpret_cast<char*>(s_ronsq + num_typ_parameters);
+
+        __syncthreads();
 
-    __syncthreads();
+        unsigned int available_bytes = max_extra_bytes;
+        for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
+            s_params[cur_pair].load_shared(s_extra, available_bytes);
 
-    unsigned int available_bytes = max_extra_bytes;
-    for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
-        s_params[cur_pair].load_shared(s_extra, available_bytes);
+        __syncthreads();
+        }
 
-    __syncthreads();
+    // read the per type pair parameters from shared memory when they are cached there
+    const typename evaluator::param_type* params = shared_params ? s_params : d_params;
+    const Scalar* rcutsq_list = shared_params ? s_rcutsq : d_rcutsq;
+    const Scalar* ronsq_list = shared_params ? s_ronsq : d_ronsq;
 
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * (blockDim.x / tpp) + threadIdx.x / tpp;
@@ -208,15 +400,17 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
 
     // add offset to get actual particle index
     idx += offset;
+    if (d_index && active)
+        idx = d_index[idx];
 
     // initialize the force to 0
-    Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
-    Scalar virialxx = Scalar(0.0);
-    Scalar virialxy = Scalar(0.0);
-    Scalar virialxz = Scalar(0.0);
-    Scalar virialyy = Scalar(0.0);
-    Scalar virialyz = Scalar(0.0);
-    Scalar virialzz = Scalar(0.0);
+    ForceReal4 force = make_forcereal4(0, 0, 0, 0);
+    ForceReal virialxx = 0;
+    ForceReal virialxy = 0;
+    ForceReal virialxz = 0;
+    ForceReal virialyy = 0;
+    ForceReal virialyz = 0;
+    ForceReal virialzz = 0;
 
     if (active)
         {
@@ -238,6 +432,9 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         unsigned int my_head = d_head_list[idx];
         unsigned int cur_j = 0;
 
+        const unsigned int mask_i = d_ex_mask ? d_ex_mask[idx] : 0;
+        const unsigned int tag_i = mask_i ? __ldg(d_tag + idx) : 0;
+
         unsigned int next_j(0);
         next_j = threadIdx.x % tpp < n_neigh ? __ldg(d_nlist + my_head + threadIdx.x % tpp) : 0;
 
@@ -251,6 +448,15 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                     {
                     next_j = __ldg(d_nlist + my_head + neigh_idx + tpp);
                     }
+
+                // skip the excluded pairs left in the list
+                if (mask_i && nlist_ex_mask_excluded(mask_i, tag_i, __ldg(d_tag + cur_j)))
+                    continue;
+
+                // the half kernel evaluates each pair in the row of the lower index only
+                if (half && cur_j < idx)
+                    continue;
+
                 // get the neighbor's position
                 Scalar4 postypej = __ldg(d_pos + cur_j);
                 Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
@@ -275,61 +481,26 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 // access the per type pair parameters
                 unsigned int typpair
                     = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
-                Scalar rcutsq = s_rcutsq[typpair];
-                typename evaluator::param_type param = s_params[typpair];
+                Scalar rcutsq = rcutsq_list[typpair];
+                typename evaluator::param_type param = params[typpair];
                 Scalar ronsq = Scalar(0.0);
                 if (shift_mode == 2)
-                    ronsq = s_ronsq[typpair];
-
-                // design specifies that energies are shifted if
-                // 1) shift mode is set to shift
-                // or 2) shift mode is explor and ron > rcut
-                bool energy_shift = false;
-                if (shift_mode == 1)
-                    energy_shift = true;
-                else if (shift_mode == 2)
-                    {
-                    if (ronsq > rcutsq)
-                        energy_shift = true;
-                    }
+                    ronsq = ronsq_list[typpair];
 
                 // evaluate the potential
                 Scalar force_divr = Scalar(0.0);
                 Scalar pair_eng = Scalar(0.0);
+                gpu_pair_force_evaluate<evaluator, shift_mode>(force_divr,
+                                                               pair_eng,
+                                                               rsq,
+                                                               rcutsq,
+                                                               ronsq,
+                                                               param,
+                                                               di,
+                                                               dj,
+                                                               qi,
+                                                               qj);
 
-                evaluator eval(rsq, rcutsq, param);
-                if (evaluator::needsDiameter())
-                    eval.setDiameter(di, dj);
-                if (evaluator::needsCharge())
-                    eval.setCharge(qi, qj);
-
-                eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-                if (shift_mode == 2)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
                 // calculate the virial
                 if (compute_virial)
                     {
@@ -342,6 +513,33 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                     virialzz += dx.z * dx.z * force_div2r;
                     }
 
+                // add the reaction to local neighbors, the rank that owns a ghost evaluates
+                // the pair itself
+                if (half && cur_j < n_local)
+                    {
+                    gpu_pair_force_atomic_add(&d_force[cur_j].x, -dx.x * force_divr);
+                    gpu_pair_force_atomic_add(&d_force[cur_j].y, -dx.y * force_divr);
+                    gpu_pair_force_atomic_add(&d_force[cur_j].z, -dx.z * force_divr);
+                    gpu_pair_force_atomic_add(&d_force[cur_j].w, Scalar(0.5) * pair_eng);
+
+                    if (compute_virial)
+                        {
+                        Scalar force_div2r = Scalar(0.5) * force_divr;
+                        gpu_pair_force_atomic_add(&d_virial[0 * virial_pitch + cur_j],
+                                                  dx.x * dx.x * force_div2r);
+                        gpu_pair_force_atomic_add(&d_virial[1 * virial_pitch + cur_j],
+                                                  dx.x * dx.y * force_div2r);
+                        gpu_pair_force_atomic_add(&d_virial[2 * virial_pitch + cur_j],
+                                                  dx.x * dx.z * force_div2r);
+                        gpu_pair_force_atomic_add(&d_virial[3 * virial_pitch + cur_j],
+                                                  dx.y * dx.y * force_div2r);
+                        gpu_pair_force_atomic_add(&d_virial[4 * virial_pitch + cur_j],
+                                                  dx.y * dx.z * force_div2r);
+                        gpu_pair_force_atomic_add(&d_virial[5 * virial_pitch + cur_j],
+                                                  dx.z * dx.z * force_div2r);
+                        }
+                    }
+
                 // add up the force vector components
                 force.x += dx.x * force_divr;
                 force.y += dx.y * force_divr;
@@ -356,7 +554,7 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         }
 
     // reduce force over threads in cta
-    hoomd::detail::WarpReduce<Scalar, tpp> reducer;
+    hoomd::detail::WarpReduce<ForceReal, tpp> reducer;
     force.x = reducer.Sum(force.x);
     force.y = reducer.Sum(force.y);
     force.z = reducer.Sum(force.z);
@@ -364,7 +562,20 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result
     if (active && threadIdx.x % tpp == 0)
-        d_force[idx] = force;
+        {
+        // other rows add the reactions to particle idx concurrently in the half kernel
+        if (half)
+            {
+            gpu_pair_force_atomic_add(&d_force[idx].x, Scalar(force.x));
+            gpu_pair_force_atomic_add(&d_force[idx].y, Scalar(force.y));
+            gpu_pair_force_atomic_add(&d_force[idx].z, Scalar(force.z));
+            gpu_pair_force_atomic_add(&d_force[idx].w, Scalar(force.w));
+            }
+        else
+            {
+            d_force[idx] = forcereal4_to_scalar4(force);
+            }
+        }
 
     if (compute_virial)
         {
@@ -376,18 +587,534 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         virialzz = reducer.Sum(virialzz);
 
         // if we are the first thread in the cta, write out virial to global mem
-        if (active && threadIdx.x % tpp == 0)
+        if (active && threadIdx.x % tpp == 0 && half)
+            {
+            gpu_pair_force_atomic_add(&d_virial[0 * virial_pitch + idx], Scalar(virialxx));
+            gpu_pair_force_atomic_add(&d_virial[1 * virial_pitch + idx], Scalar(virialxy));
+            gpu_pair_force_atomic_add(&d_virial[2 * virial_pitch + idx], Scalar(virialxz));
+            gpu_pair_force_atomic_add(&d_virial[3 * virial_pitch + idx], Scalar(virialyy));
+            gpu_pair_force_atomic_add(&d_virial[4 * virial_pitch + idx], Scalar(virialyz));
+            gpu_pair_force_atomic_add(&d_virial[5 * virial_pitch + idx], Scalar(virialzz));
+            }
+        else if (active && threadIdx.x % tpp == 0)
             {
-            d_virial[0 * virial_pitch + idx] = virialxx;
-            d_virial[1 * virial_pitch + idx] = virialxy;
-            d_virial[2 * virial_pitch + idx] = virialxz;
-            d_virial[3 * virial_pitch + idx] = virialyy;
-            d_virial[4 * virial_pitch + idx] = virialyz;
-            d_virial[5 * virial_pitch + idx] = virialzz;
+            d_virial[0 * virial_pitch + idx] = Scalar(virialxx);
+            d_virial[1 * virial_pitch + idx] = Scalar(virialxy);
+            d_virial[2 * virial_pitch + idx] = Scalar(virialxz);
+            d_virial[3 * virial_pitch + idx] = Scalar(virialyy);
+            d_virial[4 * virial_pitch + idx] = Scalar(virialyz);
+            d_virial[5 * virial_pitch + idx] = Scalar(virialzz);
             }
         }
     }
 
+//! Kernel for calculating pair forces with a cluster pair neighbor list
+/*! \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param first First particle index to evaluate
+    \param last One past the last particle index to evaluate
+    \param n_max Size of the particle data arrays
+    \param d_pos particle positions
+    \param d_diameter particle diameters
+    \param d_charge particle charges
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_n_cluster_neigh Number of j clusters of each i cluster
+    \param d_cluster_nlist j clusters of each i cluster
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param cluster_nmax Maximum number of j clusters per i cluster
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_rcutsq rcut squared, stored per type pair
+    \param d_ronsq ron squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param cluster_offset First i cluster
+    \param max_extra_bytes Shared memory available for the nested managed arrays of the parameters
+
+    The per type pair parameters are cached in shared memory as in
+   gpu_compute_pair_forces_shared_kernel().
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+   switching is enabled
+    \tparam compute_virial When non-zero, the virial tensor is computed.
+    \tparam shared_params When true, the per type pair parameters are cached in shared memory.
+
+    <b>Implementation details</b>
+    Each block of gpu_nlist_cluster_size^2 threads calculates the forces on the particles of one i
+    cluster. Thread a*gpu_nlist_cluster_size + b evaluates particle a of the i cluster with particle
+    b of each j cluster. The particles of a j cluster are loaded into shared memory once for the
+    whole block, and the interaction mask skips the pairs that are not neighbors. Every thread of
+    the block iterates over the same j clusters, so the block synchronizes between them. The forces
+    are finally reduced over the gpu_nlist_cluster_size threads that share an i particle.
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         bool shared_params>
+__global__ void
+gpu_compute_pair_forces_cluster_kernel(Scalar4* d_force,
+                                       Scalar* d_virial,
+                                       const size_t virial_pitch,
+                                       const unsigned int first,
+                                       const unsigned int last,
+                                       const unsigned int n_max,
+                                       const Scalar4* d_pos,
+                                       const Scalar* d_diameter,
+                                       const Scalar* d_charge,
+                                       const BoxDim box,
+                                       const unsigned int* d_n_cluster_neigh,
+                                       const unsigned int* d_cluster_nlist,
+                                       const uint64_t* d_cluster_mask,
+                                       const unsigned int cluster_nmax,
+                                       const typename evaluator::param_type* d_params,
+                                       const Scalar* d_rcutsq,
+                                       const Scalar* d_ronsq,
+                                       const unsigned int ntypes,
+                                       const unsigned int cluster_offset,
+                                       unsigned int max_extra_bytes)
+    {
+    Index2D typpair_idx(ntypes);
+    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
+
+    // shared arrays for per type pair parameters
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
+    Scalar* s_rcutsq
+        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    Scalar* s_ronsq
+        = (Scalar*)(&s_data[num_typ_parameters
+                            * (sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
+
+    // shared arrays for the particles of the current j cluster
+    __shared__ Scalar4 s_postypej[gpu_nlist_cluster_size];
+    __shared__ Scalar s_diameterj[gpu_nlist_cluster_size];
+    __shared__ Scalar s_chargej[gpu_nlist_cluster_size];
+
+    // load in the per type pair parameters
+    if (shared_params)
+        {
+        for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < num_typ_parameters)
+                {
+                s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+                if (shift_mode == 2)
+                    s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+                }
+            }
+
+        unsigned int param_size
+            = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < param_size)
+                {
+                ((int*)s_params)[cur_offset + threadIdx.x]
+                    = ((int*)d_params)[cur_offset + threadIdx.x];
+                }
+            }
+
+        // initialize extra shared mem
+        auto s_extra = reinterpret_cast<char*>(s_ronsq + num_typ_parameters);
+
+        __syncthreads();
+
+        unsigned int available_bytes = max_extra_bytes;
+        for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
+            s_params[cur_pair].load_shared(s_extra, available_bytes);
+
+        __syncthreads();
+        }
+
+    // read the per type pair parameters from shared memory when they are cached there
+    const typename evaluator::param_type* params = shared_params ? s_params : d_params;
+    const Scalar* rcutsq_list = shared_params ? s_rcutsq : d_rcutsq;
+    const Scalar* ronsq_list = shared_params ? s_ronsq : d_ronsq;
+
+    // identify the i cluster, the i particle, and the j particle slot of this thread
+    const unsigned int cluster = blockIdx.x + cluster_offset;
+    const unsigned int a = threadIdx.x / gpu_nlist_cluster_size;
+    const unsigned int b = threadIdx.x % gpu_nlist_cluster_size;
+    const unsigned int idx = cluster * gpu_nlist_cluster_size + a;
+    const bool active = idx >= first && idx < last;
+
+    // initialize the force to 0
+    ForceReal4 force = make_forcereal4(0, 0, 0, 0);
+    ForceReal virialxx = 0;
+    ForceReal virialxy = 0;
+    ForceReal virialxz = 0;
+    ForceReal virialyy = 0;
+    ForceReal virialyz = 0;
+    ForceReal virialzz = 0;
+
+    Scalar4 postypei = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar di = Scalar(0);
+    Scalar qi = Scalar(0);
+    if (active)
+        {
+        postypei = __ldg(d_pos + idx);
+        if (evaluator::needsDiameter())
+            di = __ldg(d_diameter + idx);
+        if (evaluator::needsCharge())
+            qi = __ldg(d_charge + idx);
+        }
+    Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+
+    const unsigned int n_cluster_neigh = d_n_cluster_neigh[cluster];
+    const unsigned int* cluster_nlist = d_cluster_nlist + cluster * cluster_nmax;
+    const uint64_t* cluster_mask = d_cluster_mask + cluster * cluster_nmax;
+
+    // loop over j clusters
+    for (unsigned int entry = 0; entry < n_cluster_neigh; ++entry)
+        {
+        const unsigned int j_cluster = cluster_nlist[entry];
+        const uint64_t mask = cluster_mask[entry];
+
+        // stage the particles of the j cluster in shared memory
+        if (a == 0)
+            {
+            const unsigned int j = j_cluster * gpu_nlist_cluster_size + b;
+            if (j < n_max)
+                {
+                s_postypej[b] = __ldg(d_pos + j);
+                if (evaluator::needsDiameter())
+                    s_diameterj[b] = __ldg(d_diameter + j);
+                if (evaluator::needsCharge())
+                    s_chargej[b] = __ldg(d_charge + j);
+                }
+            }
+
+        __syncthreads();
+
+        if (active && ((mask >> threadIdx.x) & 1))
+            {
+            Scalar4 postypej = s_postypej[b];
+            Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
+
+            Scalar dj = Scalar(0.0);
+            if (evaluator::needsDiameter())
+                dj = s_diameterj[b];
+
+            Scalar qj = Scalar(0.0);
+            if (evaluator::needsCharge())
+                qj = s_chargej[b];
+
+            // calculate dr (with periodic boundary conditions)
+            Scalar3 dx = posi - posj;
+            dx = box.minImage(dx);
+            Scalar rsq = dot(dx, dx);
+
+            // access the per type pair parameters
+            unsigned int typpair
+                = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
+            Scalar rcutsq = rcutsq_list[typpair];
+            typename evaluator::param_type param = params[typpair];
+            Scalar ronsq = Scalar(0.0);
+            if (shift_mode == 2)
+                ronsq = ronsq_list[typpair];
+
+            // evaluate the potential
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            gpu_pair_force_evaluate<evaluator, shift_mode>(force_divr,
+                                                           pair_eng,
+                                                           rsq,
+                                                           rcutsq,
+                                                           ronsq,
+                                                           param,
+                                                           di,
+                                                           dj,
+                                                           qi,
+                                                           qj);
+
+            // calculate the virial
+            if (compute_virial)
+                {
+                Scalar force_div2r = Scalar(0.5) * force_divr;
+                virialxx += dx.x * dx.x * force_div2r;
+                virialxy += dx.x * dx.y * force_div2r;
+                virialxz += dx.x * dx.z * force_div2r;
+                virialyy += dx.y * dx.y * force_div2r;
+                virialyz += dx.y * dx.z * force_div2r;
+                virialzz += dx.z * dx.z * force_div2r;
+                }
+
+            // add up the force vector components
+            force.x += dx.x * force_divr;
+            force.y += dx.y * force_divr;
+            force.z += dx.z * force_divr;
+
+            force.w += pair_eng;
+            }
+
+        // the next j cluster overwrites the shared memory
+        __syncthreads();
+        }
+
+    // potential energy per particle must be halved
+    force.w *= Scalar(0.5);
+
+    // reduce force over the threads of each i particle
+    hoomd::detail::WarpReduce<ForceReal, gpu_nlist_cluster_size> reducer;
+    force.x = reducer.Sum(force.x);
+    force.y = reducer.Sum(force.y);
+    force.z = reducer.Sum(force.z);
+    force.w = reducer.Sum(force.w);
+
+    // now that the force calculation is complete, write out the result
+    if (active && b == 0)
+        d_force[idx] = forcereal4_to_scalar4(force);
+
+    if (compute_virial)
+        {
+        virialxx = reducer.Sum(virialxx);
+        virialxy = reducer.Sum(virialxy);
+        virialxz = reducer.Sum(virialxz);
+        virialyy = reducer.Sum(virialyy);
+        virialyz = reducer.Sum(virialyz);
+        virialzz = reducer.Sum(virialzz);
+
+        if (active && b == 0)
+            {
+            d_virial[0 * virial_pitch + idx] = Scalar(virialxx);
+            d_virial[1 * virial_pitch + idx] = Scalar(virialxy);
+            d_virial[2 * virial_pitch + idx] = Scalar(virialxz);
+            d_virial[3 * virial_pitch + idx] = Scalar(virialyy);
+            d_virial[4 * virial_pitch + idx] = Scalar(virialyz);
+            d_virial[5 * virial_pitch + idx] = Scalar(virialzz);
+            }
+        }
+    }
+
+//! Kernel for calculating pair forces with a compressed neighbor list
+/*! \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param N number of particles to evaluate
+    \param d_pos particle positions
+    \param d_diameter particle diameters
+    \param d_charge particle charges
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_n_neigh Device memory array listing the number of neighbors for each particle
+    \param d_compressed_nlist Compressed neighbor list
+    \param d_compressed_head_list Byte offsets of the compressed rows
+    \param d_ex_mask Exclusion masks of the pairs left in the neighbor list, or nullptr
+    \param d_tag Particle tags, read when \a d_ex_mask is set
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_rcutsq rcut squared, stored per type pair
+    \param d_ronsq ron squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param offset Offset of first particle
+    \param d_index Particle indices to evaluate (indexed by thread, offset included), or nullptr
+    \param max_extra_bytes Maximum number of bytes of shared memory for nested parameter arrays
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+   switching is enabled
+    \tparam compute_virial When non-zero, the virial tensor is computed.
+    \tparam shared_params When true, the per type pair parameters are cached in shared memory.
+
+    <b>Implementation details</b>
+    The neighbors of a row are decoded one after another, so each thread calculates the total force
+    on one particle. The per type pair parameters are cached in shared memory as in
+    gpu_compute_pair_forces_shared_kernel().
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         bool shared_params>
+__global__ void
+gpu_compute_pair_forces_compressed_kernel(Scalar4* d_force,
+                                          Scalar* d_virial,
+                                          const size_t virial_pitch,
+                                          const unsigned int N,
+                                          const Scalar4* d_pos,
+                                          const Scalar* d_diameter,
+                                          const Scalar* d_charge,
+                                          const BoxDim box,
+                                          const unsigned int* d_n_neigh,
+                                          const unsigned char* d_compressed_nlist,
+                                          const size_t* d_compressed_head_list,
+                                          const unsigned int* d_ex_mask,
+                                          const unsigned int* d_tag,
+                                          const typename evaluator::param_type* d_params,
+                                          const Scalar* d_rcutsq,
+                                          const Scalar* d_ronsq,
+                                          const unsigned int ntypes,
+                                          const unsigned int offset,
+                                          const unsigned int* d_index,
+                                          unsigned int max_extra_bytes)
+    {
+    Index2D typpair_idx(ntypes);
+    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
+
+    // shared arrays for per type pair parameters
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
+    Scalar* s_rcutsq
+        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    Scalar* s_ronsq
+        = (Scalar*)(&s_data[num_typ_parameters
+                            * (sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
+
+    // load in the per type pair parameters
+    if (shared_params)
+        {
+        for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < num_typ_parameters)
+                {
+                s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+                if (shift_mode == 2)
+                    s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+                }
+            }
+
+        unsigned int param_size
+            = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < param_size)
+                {
+                ((int*)s_params)[cur_offset + threadIdx.x]
+                    = ((int*)d_params)[cur_offset + threadIdx.x];
+                }
+            }
+
+        // initialize extra shared mem
+        auto s_extra = reinterpret_cast<char*>(s_ronsq + num_typ_parameters);
+
+        __syncthreads();
+
+        unsigned int available_bytes = max_extra_bytes;
+        for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
+            s_params[cur_pair].load_shared(s_extra, available_bytes);
+
+        __syncthreads();
+        }
+
+    // read the per type pair parameters from shared memory when they are cached there
+    const typename evaluator::param_type* params = shared_params ? s_params : d_params;
+    const Scalar* rcutsq_list = shared_params ? s_rcutsq : d_rcutsq;
+    const Scalar* ronsq_list = shared_params ? s_ronsq : d_ronsq;
+
+    // start by identifying which particle we are to handle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    // add offset to get actual particle index
+    idx += offset;
+    if (d_index)
+        idx = d_index[idx];
+
+    ForceReal4 force = make_forcereal4(0, 0, 0, 0);
+    ForceReal virialxx = 0;
+    ForceReal virialxy = 0;
+    ForceReal virialxz = 0;
+    ForceReal virialyy = 0;
+    ForceReal virialyz = 0;
+    ForceReal virialzz = 0;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+
+    Scalar4 postypei = __ldg(d_pos + idx);
+    Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+
+    Scalar di = Scalar(0);
+    if (evaluator::needsDiameter())
+        di = __ldg(d_diameter + idx);
+
+    Scalar qi = Scalar(0);
+    if (evaluator::needsCharge())
+        qi = __ldg(d_charge + idx);
+
+    const unsigned char* packed = d_compressed_nlist + d_compressed_head_list[idx];
+    unsigned int cur_j = 0;
+
+    const unsigned int mask_i = d_ex_mask ? d_ex_mask[idx] : 0;
+    const unsigned int tag_i = mask_i ? __ldg(d_tag + idx) : 0;
+
+    for (unsigned int neigh_idx = 0; neigh_idx < n_neigh; ++neigh_idx)
+        {
+        // decode the next neighbor index
+        cur_j += nlist_compressed_read(packed);
+
+        // skip the excluded pairs left in the list
+        if (mask_i && nlist_ex_mask_excluded(mask_i, tag_i, __ldg(d_tag + cur_j)))
+            continue;
+
+        Scalar4 postypej = __ldg(d_pos + cur_j);
+        Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
+
+        Scalar dj = Scalar(0.0);
+        if (evaluator::needsDiameter())
+            dj = __ldg(d_diameter + cur_j);
+
+        Scalar qj = Scalar(0.0);
+        if (evaluator::needsCharge())
+            qj = __ldg(d_charge + cur_j);
+
+        // calculate dr (with periodic boundary conditions)
+        Scalar3 dx = box.minImage(posi - posj);
+        Scalar rsq = dot(dx, dx);
+
+        // access the per type pair parameters
+        unsigned int typpair
+            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
+        Scalar rcutsq = rcutsq_list[typpair];
+        typename evaluator::param_type param = params[typpair];
+        Scalar ronsq = Scalar(0.0);
+        if (shift_mode == 2)
+            ronsq = ronsq_list[typpair];
+
+        // evaluate the potential
+        Scalar force_divr = Scalar(0.0);
+        Scalar pair_eng = Scalar(0.0);
+        gpu_pair_force_evaluate<evaluator, shift_mode>(force_divr,
+                                                       pair_eng,
+                                                       rsq,
+                                                       rcutsq,
+                                                       ronsq,
+                                                       param,
+                                                       di,
+                                                       dj,
+                                                       qi,
+                                                       qj);
+
+        if (compute_virial)
+            {
+            Scalar force_div2r = Scalar(0.5) * force_divr;
+            virialxx += dx.x * dx.x * force_div2r;
+            virialxy += dx.x * dx.y * force_div2r;
+            virialxz += dx.x * dx.z * force_div2r;
+            virialyy += dx.y * dx.y * force_div2r;
+            virialyz += dx.y * dx.z * force_div2r;
+            virialzz += dx.z * dx.z * force_div2r;
+            }
+
+        force.x += dx.x * force_divr;
+        force.y += dx.y * force_divr;
+        force.z += dx.z * force_divr;
+        force.w += pair_eng;
+        }
+
+    // potential energy per particle must be halved
+    force.w *= Scalar(0.5);
+    d_force[idx] = forcereal4_to_scalar4(force);
+
+    if (compute_virial)
+        {
+        d_virial[0 * virial_pitch + idx] = Scalar(virialxx);
+        d_virial[1 * virial_pitch + idx] = Scalar(virialxy);
+        d_virial[2 * virial_pitch + idx] = Scalar(virialxz);
+        d_virial[3 * virial_pitch + idx] = Scalar(virialyy);
+        d_virial[4 * virial_pitch + idx] = Scalar(virialyz);
+        d_virial[5 * virial_pitch + idx] = Scalar(virialzz);
+        }
+    }
+
+#ifndef HOOMD_LLVMJIT_BUILD
 template<typename T> int get_max_block_size(T func)
     {
     hipFuncAttributes attr;
@@ -398,19 +1125,37 @@ template<typename T> int get_max_block_size(T func)
     return max_threads;
     }
 
+//! Test whether the per type pair parameters fit in the shared memory of a block
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param param_shared_bytes Shared memory needed by the parameters
+    \param kernel_shared_bytes Static shared memory of the kernel
+*/
+inline bool gpu_pair_force_params_fit_shared(const pair_args_t& pair_args,
+                                             size_t param_shared_bytes,
+                                             size_t kernel_shared_bytes)
+    {
+    return param_shared_bytes + kernel_shared_bytes <= pair_args.devprop.sharedMemPerBlock;
+    }
+
 //! Pair force compute kernel launcher
 /*!
  * \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
  * \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
  * switching is enabled (See PotentialPair for a discussion on what that entails) \tparam
  * compute_virial When non-zero, the virial tensor is computed. When zero, the virial tensor is not
- * computed. \tparam tpp Number of threads to use per particle, must be power of 2 and smaller than
- * warp size
+ * computed. \tparam tpp Number of threads to use per particle, the launcher steps down through the
+ * values of gpu_pair_force_next_tpp() \tparam shared_params When true, cache the per type pair parameters in shared memory.
+ * The launcher falls back to reading them from global memory when \a pair_args.shared_params is
+ * false or the parameters do not fit in shared memory.
  *
  * Partial function template specialization is not allowed in C++, so instead we have to wrap this
  * with a struct that we are allowed to partially specialize.
  */
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         int tpp,
+         bool shared_params = true>
 struct PairForceComputeKernel
     {
     //! Launcher for the pair force kernel
@@ -427,7 +1172,8 @@ struct PairForceComputeKernel
         unsigned int N = range.second - range.first;
         unsigned int offset = range.first;
 
-        if (tpp == pair_args.threads_per_particle)
+        // launch the largest compiled tpp that does not exceed the requested one
+        if (static_cast<unsigned int>(tpp) <= pair_args.threads_per_particle)
             {
             unsigned int block_size = pair_args.block_size;
 
@@ -438,69 +1184,107 @@ struct PairForceComputeKernel
 
             unsigned int max_block_size;
             max_block_size = get_max_block_size(
-                gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, tpp>);
+                gpu_compute_pair_forces_shared_kernel<evaluator,
+                                                      shift_mode,
+                                                      compute_virial,
+                                                      tpp,
+                                                      shared_params>);
 
             hipFuncAttributes attr;
             hipFuncGetAttributes(
                 &attr,
-                reinterpret_cast<const void*>(&gpu_compute_pair_forces_shared_kernel<evaluator,
-                                                                                     shift_mode,
-                                                                                     compute_virial,
-                                                                                     tpp>));
-
-            unsigned int max_extra_bytes = static_cast<unsigned int>(
-                pair_args.devprop.sharedMemPerBlock - param_shared_bytes - attr.sharedSizeBytes);
-
-            // determine dynamically requested shared memory in nested managed arrays
-            char* ptr = nullptr;
-            unsigned int available_bytes = max_extra_bytes;
-            for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+                reinterpret_cast<const void*>(
+                    &gpu_compute_pair_forces_shared_kernel<evaluator,
+                                                           shift_mode,
+                                                           compute_virial,
+                                                           tpp,
+                                                           shared_params>));
+
+            if (shared_params
+                && (!pair_args.shared_params
+                    || !gpu_pair_force_params_fit_shared(pair_args,
+                                                         param_shared_bytes,
+                                                         attr.sharedSizeBytes)))
                 {
-                d_params[i].allocate_shared(ptr, available_bytes);
+                PairForceComputeKernel<evaluator, shift_mode, compute_virial, tpp, false>::launch(
+                    pair_args,
+                    range,
+                    d_params);
+                return;
                 }
 
-            unsigned int extra_shared_bytes = max_extra_bytes - available_bytes;
+            unsigned int max_extra_bytes = 0;
+            unsigned int extra_shared_bytes = 0;
+            if (shared_params)
+                {
+                max_extra_bytes = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock
+                                                            - param_shared_bytes
+                                                            - attr.sharedSizeBytes);
+
+                // determine dynamically requested shared memory in nested managed arrays
+                char* ptr = nullptr;
+                unsigned int available_bytes = max_extra_bytes;
+                for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+                    {
+                    d_params[i].allocate_shared(ptr, available_bytes);
+                    }
+
+                extra_shared_bytes = max_extra_bytes - available_bytes;
+                }
+            else
+                {
+                param_shared_bytes = 0;
+                }
 
             block_size = block_size < max_block_size ? block_size : max_block_size;
             dim3 grid(N / (block_size / tpp) + 1, 1, 1);
 
-            hipLaunchKernelGGL(
-                (gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, tpp>),
-                dim3(grid),
-                dim3(block_size),
-                param_shared_bytes + extra_shared_bytes,
-                0,
-                pair_args.d_force,
-                pair_args.d_virial,
-                pair_args.virial_pitch,
-                N,
-                pair_args.d_pos,
-                pair_args.d_diameter,
-                pair_args.d_charge,
-                pair_args.box,
-                pair_args.d_n_neigh,
-                pair_args.d_nlist,
-                pair_args.d_head_list,
-                d_params,
-                pair_args.d_rcutsq,
-                pair_args.d_ronsq,
-                pair_args.ntypes,
-                offset,
-                max_extra_bytes);
+            hipLaunchKernelGGL((gpu_compute_pair_forces_shared_kernel<evaluator,
+                                                                      shift_mode,
+                                                                      compute_virial,
+                                                                      tpp,
+                                                                      shared_params>),
+                               dim3(grid),
+                               dim3(block_size),
+                               param_shared_bytes + extra_shared_bytes,
+                               pair_args.stream,
+                               pair_args.d_force,
+                               pair_args.d_virial,
+                               pair_args.virial_pitch,
+                               N,
+                               pair_args.d_pos,
+                               pair_args.d_diameter,
+                               pair_args.d_charge,
+                               pair_args.box,
+                               pair_args.d_n_neigh,
+                               pair_args.d_nlist,
+                               pair_args.d_head_list,
+                               pair_args.d_ex_mask,
+                               pair_args.d_tag,
+                               d_params,
+                               pair_args.d_rcutsq,
+                               pair_args.d_ronsq,
+                               pair_args.ntypes,
+                               offset,
+                               pair_args.d_index,
+                               pair_args.half,
+                               pair_args.N,
+                               max_extra_bytes);
             }
         else
             {
-            PairForceComputeKernel<evaluator, shift_mode, compute_virial, tpp / 2>::launch(
-                pair_args,
-                range,
-                d_params);
+            PairForceComputeKernel<evaluator,
+                                   shift_mode,
+                                   compute_virial,
+                                   gpu_pair_force_next_tpp(tpp),
+                                   shared_params>::launch(pair_args, range, d_params);
             }
         }
     };
 
 //! Template specialization to do nothing for the tpp = 0 case
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
-struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, bool shared_params>
+struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0, shared_params>
     {
     static void launch(const pair_args_t& pair_args,
                        std::pair<unsigned int, unsigned int> range,
@@ -510,11 +1294,278 @@ struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
         }
     };
 
+//! Launcher for the cluster pair force kernel
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param range Range of particle indices this GPU operates on
+    \param d_params Parameters for the potential, stored per type pair
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+   switching is enabled
+    \tparam compute_virial When non-zero, the virial tensor is computed.
+    \tparam shared_params When true, cache the per type pair parameters in shared memory. The
+   launcher falls back to reading them from global memory when \a pair_args.shared_params is false
+   or the parameters do not fit in shared memory.
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         bool shared_params = true>
+void gpu_launch_pair_forces_cluster(const pair_args_t& pair_args,
+                                    std::pair<unsigned int, unsigned int> range,
+                                    const typename evaluator::param_type* d_params)
+    {
+    // the i clusters that hold the particles in range
+    const unsigned int cluster_first = range.first / gpu_nlist_cluster_size;
+    const unsigned int cluster_last
+        = (range.second + gpu_nlist_cluster_size - 1) / gpu_nlist_cluster_size;
+    if (cluster_last <= cluster_first)
+        return;
+
+    Index2D typpair_idx(pair_args.ntypes);
+    size_t param_shared_bytes = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
+                                * typpair_idx.getNumElements();
+
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(
+        &attr,
+        reinterpret_cast<const void*>(
+            &gpu_compute_pair_forces_cluster_kernel<evaluator,
+                                                    shift_mode,
+                                                    compute_virial,
+                                                    shared_params>));
+
+    if (shared_params
+        && (!pair_args.shared_params
+            || !gpu_pair_force_params_fit_shared(pair_args,
+                                                 param_shared_bytes,
+                                                 attr.sharedSizeBytes)))
+        {
+        gpu_launch_pair_forces_cluster<evaluator, shift_mode, compute_virial, false>(pair_args,
+                                                                                     range,
+                                                                                     d_params);
+        return;
+        }
+
+    unsigned int max_extra_bytes = 0;
+    unsigned int extra_shared_bytes = 0;
+    if (shared_params)
+        {
+        max_extra_bytes = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock
+                                                    - param_shared_bytes - attr.sharedSizeBytes);
+
+        // determine dynamically requested shared memory in nested managed arrays
+        char* ptr = nullptr;
+        unsigned int available_bytes = max_extra_bytes;
+        for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+            {
+            d_params[i].allocate_shared(ptr, available_bytes);
+            }
+
+        extra_shared_bytes = max_extra_bytes - available_bytes;
+        }
+    else
+        {
+        param_shared_bytes = 0;
+        }
+
+    hipLaunchKernelGGL(
+        (gpu_compute_pair_forces_cluster_kernel<evaluator,
+                                                shift_mode,
+                                                compute_virial,
+                                                shared_params>),
+        dim3(cluster_last - cluster_first),
+        dim3(gpu_nlist_cluster_size * gpu_nlist_cluster_size),
+        param_shared_bytes + extra_shared_bytes,
+        pair_args.stream,
+        pair_args.d_force,
+        pair_args.d_virial,
+        pair_args.virial_pitch,
+        range.first,
+        range.second,
+        pair_args.n_max,
+        pair_args.d_pos,
+        pair_args.d_diameter,
+        pair_args.d_charge,
+        pair_args.box,
+        pair_args.d_n_cluster_neigh,
+        pair_args.d_cluster_nlist,
+        pair_args.d_cluster_mask,
+        pair_args.cluster_nmax,
+        d_params,
+        pair_args.d_rcutsq,
+        pair_args.d_ronsq,
+        pair_args.ntypes,
+        cluster_first,
+        max_extra_bytes);
+    }
+
+//! Select the shift mode of the cluster pair force kernel
+template<class evaluator, unsigned int compute_virial>
+void gpu_compute_pair_forces_cluster(const pair_args_t& pair_args,
+                                     std::pair<unsigned int, unsigned int> range,
+                                     const typename evaluator::param_type* d_params)
+    {
+    switch (pair_args.shift_mode)
+        {
+    case 0:
+        gpu_launch_pair_forces_cluster<evaluator, 0, compute_virial>(pair_args, range, d_params);
+        break;
+    case 1:
+        gpu_launch_pair_forces_cluster<evaluator, 1, compute_virial>(pair_args, range, d_params);
+        break;
+    case 2:
+        gpu_launch_pair_forces_cluster<evaluator, 2, compute_virial>(pair_args, range, d_params);
+        break;
+    default:
+        break;
+        }
+    }
+
+//! Launcher for the compressed neighbor list pair force kernel
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param range Range of particle indices this GPU operates on
+    \param d_params Parameters for the potential, stored per type pair
+
+    The kernel evaluates one particle per thread, \a pair_args.threads_per_particle is not used.
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+   switching is enabled
+    \tparam compute_virial When non-zero, the virial tensor is computed.
+    \tparam shared_params When true, cache the per type pair parameters in shared memory. The
+   launcher falls back to reading them from global memory when \a pair_args.shared_params is false
+   or the parameters do not fit in shared memory.
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         bool shared_params = true>
+void gpu_launch_pair_forces_compressed(const pair_args_t& pair_args,
+                                       std::pair<unsigned int, unsigned int> range,
+                                       const typename evaluator::param_type* d_params)
+    {
+    unsigned int N = range.second - range.first;
+    if (N == 0)
+        return;
+
+    Index2D typpair_idx(pair_args.ntypes);
+    size_t param_shared_bytes = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
+                                * typpair_idx.getNumElements();
+
+    unsigned int max_block_size
+        = get_max_block_size(gpu_compute_pair_forces_compressed_kernel<evaluator,
+                                                                       shift_mode,
+                                                                       compute_virial,
+                                                                       shared_params>);
+
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(
+        &attr,
+        reinterpret_cast<const void*>(
+            &gpu_compute_pair_forces_compressed_kernel<evaluator,
+                                                       shift_mode,
+                                                       compute_virial,
+                                                       shared_params>));
+
+    if (shared_params
+        && (!pair_args.shared_params
+            || !gpu_pair_force_params_fit_shared(pair_args,
+                                                 param_shared_bytes,
+                                                 attr.sharedSizeBytes)))
+        {
+        gpu_launch_pair_forces_compressed<evaluator, shift_mode, compute_virial, false>(pair_args,
+                                                                                        range,
+                                                                                        d_params);
+        return;
+        }
+
+    unsigned int max_extra_bytes = 0;
+    unsigned int extra_shared_bytes = 0;
+    if (shared_params)
+        {
+        max_extra_bytes = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock
+                                                    - param_shared_bytes - attr.sharedSizeBytes);
+
+        // determine dynamically requested shared memory in nested managed arrays
+        char* ptr = nullptr;
+        unsigned int available_bytes = max_extra_bytes;
+        for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+            {
+            d_params[i].allocate_shared(ptr, available_bytes);
+            }
+
+        extra_shared_bytes = max_extra_bytes - available_bytes;
+        }
+    else
+        {
+        param_shared_bytes = 0;
+        }
+
+    unsigned int block_size = pair_args.block_size;
+    block_size = block_size < max_block_size ? block_size : max_block_size;
+
+    hipLaunchKernelGGL(
+        (gpu_compute_pair_forces_compressed_kernel<evaluator,
+                                                   shift_mode,
+                                                   compute_virial,
+                                                   shared_params>),
+        dim3(N / block_size + 1),
+        dim3(block_size),
+        param_shared_bytes + extra_shared_bytes,
+        pair_args.stream,
+        pair_args.d_force,
+        pair_args.d_virial,
+        pair_args.virial_pitch,
+        N,
+        pair_args.d_pos,
+        pair_args.d_diameter,
+        pair_args.d_charge,
+        pair_args.box,
+        pair_args.d_n_neigh,
+        pair_args.d_compressed_nlist,
+        pair_args.d_compressed_head_list,
+        pair_args.d_ex_mask,
+        pair_args.d_tag,
+        d_params,
+        pair_args.d_rcutsq,
+        pair_args.d_ronsq,
+        pair_args.ntypes,
+        range.first,
+        pair_args.d_index,
+        max_extra_bytes);
+    }
+
+//! Select the shift mode of the compressed neighbor list pair force kernel
+template<class evaluator, unsigned int compute_virial>
+void gpu_compute_pair_forces_compressed(const pair_args_t& pair_args,
+                                        std::pair<unsigned int, unsigned int> range,
+                                        const typename evaluator::param_type* d_params)
+    {
+    switch (pair_args.shift_mode)
+        {
+    case 0:
+        gpu_launch_pair_forces_compressed<evaluator, 0, compute_virial>(pair_args, range, d_params);
+        break;
+    case 1:
+        gpu_launch_pair_forces_compressed<evaluator, 1, compute_virial>(pair_args, range, d_params);
+        break;
+    case 2:
+        gpu_launch_pair_forces_compressed<evaluator, 2, compute_virial>(pair_args, range, d_params);
+        break;
+    default:
+        break;
+        }
+    }
+
 //! Kernel driver that computes lj forces on the GPU for LJForceComputeGPU
 /*! \param pair_args Other arguments to pass onto the kernel
     \param d_params Parameters for the potential, stored per type pair
 
     This is just a driver function for gpu_compute_pair_forces_shared_kernel(), see it for details.
+    When \a pair_args holds a cluster pair neighbor list, the driver launches
+    gpu_compute_pair_forces_cluster_kernel() instead. When it holds a compressed neighbor list, the
+    driver launches gpu_compute_pair_forces_compressed_kernel().
 */
 template<class evaluator>
 hipError_t gpu_compute_pair_forces(const pair_args_t& pair_args,
@@ -530,6 +1581,32 @@ hipError_t gpu_compute_pair_forces(const pair_args_t& pair_args,
         {
         auto range = pair_args.gpu_partition.getRangeAndSetGPU(idev);
 
+        // an explicit list of particles is evaluated on a single GPU
+        if (pair_args.d_index)
+            {
+            if (idev > 0)
+                continue;
+            range = std::make_pair(0u, pair_args.n_index);
+            }
+
+        if (pair_args.d_n_cluster_neigh)
+            {
+            if (pair_args.compute_virial)
+                gpu_compute_pair_forces_cluster<evaluator, 1>(pair_args, range, d_params);
+            else
+                gpu_compute_pair_forces_cluster<evaluator, 0>(pair_args, range, d_params);
+            continue;
+            }
+
+        if (pair_args.d_compressed_nlist)
+            {
+            if (pair_args.compute_virial)
+                gpu_compute_pair_forces_compressed<evaluator, 1>(pair_args, range, d_params);
+            else
+                gpu_compute_pair_forces_compressed<evaluator, 0>(pair_args, range, d_params);
+            continue;
+            }
+
         // Launch kernel
         if (pair_args.compute_virial)
             {
@@ -593,5 +1670,6 @@ hipError_t gpu_compute_pair_forces(const pair_args_t& pair_args,
 
     return hipSuccess;
     }
+#endif // HOOMD_LLVMJIT_BUILD
 #endif
 #endif // __POTENTIAL_PAIR_GPU_CUH__
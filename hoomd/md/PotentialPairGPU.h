@@ -10,6 +10,7 @@
 
 #include <memory>
 
+#include "NeighborListGPUCluster.h"
 #include "PotentialPair.h"
 #include "PotentialPairGPU.cuh"
 
@@ -54,15 +55,24 @@ class PotentialPairGPU : public PotentialPair<evaluator>
     //! Destructor
     virtual ~PotentialPairGPU() { }
 
-    //! Set the number of threads per particle to execute on the GPU
-    /*! \param threads_per_particl Number of threads per particle
-        \a threads_per_particle must be a power of two and smaller than the warp size.
+    //! Set the kernel launch parameters to execute on the GPU
+    /*! \param param Kernel parameter encoded as block_size*10000 + storage*1000 +
+        threads_per_particle
+
+        \a threads_per_particle must be a power of two and smaller than the warp size, the kernel
+        runs with the largest compiled value that does not exceed it (see
+        gpu_pair_force_next_tpp()). Bit 0 of \a storage is 0 to cache the per type pair parameters
+        in shared memory and 1 to read them from global memory. Bit 1 selects the half kernel,
+        which evaluates each pair once and adds the reaction to the neighbor with atomic adds.
      */
     void setTuningParam(unsigned int param)
         {
         m_param = param;
         }
 
+    //! Set whether the kernels read a half neighbor list
+    virtual void setHalfNList(bool half_nlist);
+
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
         \param period period (approximate) in time steps when returning occurs
@@ -76,12 +86,63 @@ class PotentialPairGPU : public PotentialPair<evaluator>
         m_tuner->setEnabled(enable);
         }
 
+#ifdef ENABLE_MPI
+    //! The ordered evaluation of the interior particles runs on a single GPU
+    virtual bool overlapsGhostUpdate()
+        {
+        return this->m_exec_conf->getNumActiveGPUs() == 1;
+        }
+#endif
+
+    //! The kernels access the particle data on the device, which is not shared between threads
+    virtual bool supportsConcurrentCompute()
+        {
+        return false;
+        }
+
     protected:
-    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
+    //! Autotuner for block size, parameter storage, and threads per particle
+    std::unique_ptr<Autotuner> m_tuner;
     unsigned int m_param;               //!< Kernel tuning parameter
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! The kernels overwrite the force arrays, they do not add to the net force
+    virtual bool computeForcesIntoNet(uint64_t timestep)
+        {
+        return false;
+        }
+
+#ifdef ENABLE_MPI
+    //! The kernels evaluate the pairs with ghosts on both ranks, the GPU communicator does not
+    //! send forces back
+    virtual bool reversesGhostForces()
+        {
+        return false;
+        }
+#endif
+
+    //! Test whether to launch the half kernel with the given kernel parameter
+    bool useHalfKernel(unsigned int param);
+
+    //! Launch the force kernel
+    void launchKernel(unsigned int param,
+                      bool half,
+                      const unsigned int* d_index,
+                      unsigned int n_index);
+
+    //! Evaluate the cluster pairs of a NeighborListGPUCluster
+    void launchClusterKernel(NeighborListGPUCluster& cluster_nlist);
+
+    //! Launch the kernels of the driver function
+    /*! Derived classes override this to launch kernels that are not known at compile time, such as
+        the runtime compiled kernels of PotentialPairJITGPU.
+    */
+    virtual void computePairForcesGPU(const pair_args_t& pair_args)
+        {
+        gpu_cgpf(pair_args, this->m_params.data());
+        }
     };
 
 template<class evaluator,
@@ -101,15 +162,24 @@ PotentialPairGPU<evaluator, gpu_cgpf>::PotentialPairGPU(std::shared_ptr<SystemDe
         }
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
-    // encoded as block_size*10000 + threads_per_particle
+    // the full block size, parameter storage, and threads_per_particle matrix is searched,
+    // encoded as block_size*10000 + storage*1000 + threads_per_particle
+    // storage bit 0 reads the per type pair parameters from global memory instead of shared
+    // memory, which avoids the shared memory limit and may increase the occupancy with many types
+    // storage bit 1 evaluates each pair once with the half kernel, which trades the second
+    // evaluation of the pair for atomic adds
     std::vector<unsigned int> valid_params;
     const unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
     for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
         {
-        for (auto s : Autotuner::getTppListPow2(warp_size))
+        for (unsigned int storage = 0; storage < 4; storage++)
             {
-            valid_params.push_back(block_size * 10000 + s);
+            for (auto s : Autotuner::getTppListPow2(warp_size))
+                {
+                // only tune threads_per_particle values with compiled kernels
+                if (gpu_pair_force_has_tpp(s))
+                    valid_params.push_back(block_size * 10000 + storage * 1000 + s);
+                }
             }
         }
 
@@ -132,15 +202,146 @@ void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
     if (this->m_prof)
         this->m_prof->push(this->m_exec_conf, this->m_prof_name);
 
-    // The GPU implementation CANNOT handle a half neighborlist, error out now
-    bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
-    if (third_law)
+    auto cluster_nlist = std::dynamic_pointer_cast<NeighborListGPUCluster>(this->m_nlist);
+    if (cluster_nlist)
         {
-        this->m_exec_conf->msg->error()
-            << "PotentialPairGPU cannot handle a half neighborlist" << std::endl;
-        throw std::runtime_error("Error computing forces in PotentialPairGPU");
+#ifdef ENABLE_MPI
+        // cluster pairs mix local and ghost particles, all ghost positions must be current
+        if (this->m_comm)
+            this->m_comm->finishUpdateGhosts(timestep);
+#endif
+        launchClusterKernel(*cluster_nlist);
+        }
+    else
+        {
+        // all launches of the step use the same kernel, the half kernel adds to the forces that
+        // the previous launches wrote
+        if (!m_param)
+            this->m_tuner->begin();
+        const unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
+        const bool half = useHalfKernel(param);
+
+        if (half)
+            {
+            ArrayHandle<Scalar4> d_force(this->m_force,
+                                         access_location::device,
+                                         access_mode::overwrite);
+            ArrayHandle<Scalar> d_virial(this->m_virial,
+                                         access_location::device,
+                                         access_mode::overwrite);
+            hipMemsetAsync(d_force.data,
+                           0,
+                           sizeof(Scalar4) * this->m_force.getNumElements(),
+                           this->m_stream);
+            hipMemsetAsync(d_virial.data,
+                           0,
+                           sizeof(Scalar) * this->m_virial.getNumElements(),
+                           this->m_stream);
+            }
+
+#ifdef ENABLE_MPI
+        if (this->m_comm && this->m_comm->isGhostUpdatePending())
+            {
+            // evaluate the particles with only local neighbors while the ghost positions are in
+            // flight
+            const unsigned int n_interior = this->m_nlist->getNInteriorParticles();
+                {
+                ArrayHandle<unsigned int> d_order(this->m_nlist->getGhostPartition(),
+                                                  access_location::device,
+                                                  access_mode::read);
+                launchKernel(param, half, d_order.data, n_interior);
+                }
+
+            this->m_comm->finishUpdateGhosts(timestep);
+
+                {
+                ArrayHandle<unsigned int> d_order(this->m_nlist->getGhostPartition(),
+                                                  access_location::device,
+                                                  access_mode::read);
+                launchKernel(param,
+                             half,
+                             d_order.data + n_interior,
+                             this->m_pdata->getN() - n_interior);
+                }
+            }
+        else
+#endif
+            {
+            launchKernel(param, half, nullptr, 0);
+            }
+
+        if (!m_param)
+            this->m_tuner->end();
+        }
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+    }
+
+/*! \param half_nlist Set to true to store the neighbor list in half mode
+
+    The half list needs half the memory of the full list. The kernels evaluate it with the half
+    kernel, whatever the autotuner selects. Other GPU forces that share the neighbor list may
+    require full storage.
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+void PotentialPairGPU<evaluator, gpu_cgpf>::setHalfNList(bool half_nlist)
+    {
+    if (half_nlist
+        && (!std::dynamic_pointer_cast<NeighborListGPUBinned>(this->m_nlist)
+            || std::dynamic_pointer_cast<NeighborListGPUCluster>(this->m_nlist)))
+        {
+        throw std::invalid_argument("half_nlist requires a hoomd.md.nlist.Cell neighbor list.");
+        }
+
+    PotentialPair<evaluator>::setHalfNList(half_nlist);
+    this->m_nlist->setStorageMode(half_nlist ? NeighborList::half : NeighborList::full);
+    }
+
+/*! \param param Kernel parameter (see setTuningParam())
+    \returns True when the kernels of this step evaluate each pair once
+
+    A half neighbor list always needs the half kernel. With a full neighbor list, the autotuner
+    selects between the kernels. The half kernel scatters to particles of other GPU partitions and
+    cannot read compressed rows, so it runs only on a single GPU with the standard rows.
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+bool PotentialPairGPU<evaluator, gpu_cgpf>::useHalfKernel(unsigned int param)
+    {
+    const bool supported
+        = this->m_exec_conf->getNumActiveGPUs() == 1 && !this->m_nlist->getCompressed();
+
+    if (this->m_nlist->getStorageMode() == NeighborList::half)
+        {
+        if (!supported)
+            {
+            throw std::runtime_error("Half neighbor lists are not supported with compressed "
+                                     "neighbor lists or multiple GPUs.");
+            }
+        return true;
         }
 
+    const unsigned int storage = (param % 10000) / 1000;
+    return supported && (storage & 2);
+    }
+
+/*! \param param Kernel parameter (see setTuningParam())
+    \param half Launch the half kernel, the force arrays must be zeroed
+    \param d_index Particle indices to evaluate, or nullptr to evaluate all local particles
+    \param n_index Number of entries in \a d_index
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+void PotentialPairGPU<evaluator, gpu_cgpf>::launchKernel(unsigned int param,
+                                                         bool half,
+                                                         const unsigned int* d_index,
+                                                         unsigned int n_index)
+    {
     // access the neighbor list
     ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
                                         access_location::device,
@@ -151,6 +352,27 @@ void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
     ArrayHandle<unsigned int> d_head_list(this->m_nlist->getHeadList(),
                                           access_location::device,
                                           access_mode::read);
+    ArrayHandle<unsigned char> d_compressed_nlist(this->m_nlist->getCompressedNListArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+    ArrayHandle<size_t> d_compressed_head_list(this->m_nlist->getCompressedHeadList(),
+                                               access_location::device,
+                                               access_mode::read);
+    ArrayHandle<unsigned int> d_ex_mask(this->m_nlist->getExMaskArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                    access_location::device,
+                                    access_mode::read);
+
+    // iterate only over the cutoff shell of this potential when the rows are partitioned
+    const int shell = this->m_nlist->getShell(this->m_r_cut_nlist);
+    ArrayHandle<unsigned int> d_shell_n_neigh(this->m_nlist->getShellNNeighArray(),
+                                              access_location::device,
+                                              access_mode::read);
+    const unsigned int* n_neigh
+        = shell >= 0 ? d_shell_n_neigh.data + shell * this->m_nlist->getShellPitch()
+                     : d_n_neigh.data;
 
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
@@ -176,45 +398,139 @@ void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
 
     this->m_exec_conf->beginMultiGPU();
 
-    if (!m_param)
-        this->m_tuner->begin();
-    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
     unsigned int block_size = param / 10000;
-    unsigned int threads_per_particle = param % 10000;
-
-    gpu_cgpf(pair_args_t(d_force.data,
-                         d_virial.data,
-                         this->m_virial.getPitch(),
-                         this->m_pdata->getN(),
-                         this->m_pdata->getMaxN(),
-                         d_pos.data,
-                         d_diameter.data,
-                         d_charge.data,
-                         box,
-                         d_n_neigh.data,
-                         d_nlist.data,
-                         d_head_list.data,
-                         d_rcutsq.data,
-                         d_ronsq.data,
-                         this->m_nlist->getNListArray().getPitch(),
-                         this->m_pdata->getNTypes(),
-                         block_size,
-                         this->m_shift_mode,
-                         flags[pdata_flag::pressure_tensor],
-                         threads_per_particle,
-                         this->m_pdata->getGPUPartition(),
-                         this->m_exec_conf->dev_prop),
-             this->m_params.data());
+    unsigned int storage = (param % 10000) / 1000;
+    unsigned int threads_per_particle = param % 1000;
+
+    pair_args_t pair_args(d_force.data,
+                          d_virial.data,
+                          this->m_virial.getPitch(),
+                          this->m_pdata->getN(),
+                          this->m_pdata->getMaxN(),
+                          d_pos.data,
+                          d_diameter.data,
+                          d_charge.data,
+                          box,
+                          n_neigh,
+                          d_nlist.data,
+                          d_head_list.data,
+                          d_rcutsq.data,
+                          d_ronsq.data,
+                          this->m_nlist->getNListArray().getPitch(),
+                          this->m_pdata->getNTypes(),
+                          block_size,
+                          this->m_shift_mode,
+                          flags[pdata_flag::pressure_tensor],
+                          threads_per_particle,
+                          this->m_pdata->getGPUPartition(),
+                          this->m_exec_conf->dev_prop,
+                          d_index,
+                          n_index);
+
+    pair_args.shared_params = (storage & 1) == 0;
+    pair_args.half = half;
+    pair_args.stream = this->m_stream;
+
+    // read the compressed rows when the neighbor list builds them
+    if (this->m_nlist->getCompressed())
+        {
+        pair_args.d_compressed_nlist = d_compressed_nlist.data;
+        pair_args.d_compressed_head_list = d_compressed_head_list.data;
+        }
+
+    // skip the excluded pairs that the neighbor list left in the rows
+    if (this->m_nlist->getExclusionMasksUsed())
+        {
+        pair_args.d_ex_mask = d_ex_mask.data;
+        pair_args.d_tag = d_tag.data;
+        }
+
+    computePairForcesGPU(pair_args);
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
-    if (!m_param)
-        this->m_tuner->end();
 
     this->m_exec_conf->endMultiGPU();
+    }
 
-    if (this->m_prof)
-        this->m_prof->pop(this->m_exec_conf);
+//! Evaluate the forces with a cluster pair neighbor list
+/*! \param cluster_nlist Cluster pair neighbor list to evaluate
+
+    The cluster kernel runs a fixed block of gpu_nlist_cluster_size^2 threads per i cluster, so the
+    autotuner is not used.
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+void PotentialPairGPU<evaluator, gpu_cgpf>::launchClusterKernel(
+    NeighborListGPUCluster& cluster_nlist)
+    {
+    // access the cluster list
+    ArrayHandle<unsigned int> d_n_cluster_neigh(cluster_nlist.getNClusterNeighArray(),
+                                                access_location::device,
+                                                access_mode::read);
+    ArrayHandle<unsigned int> d_cluster_nlist(cluster_nlist.getClusterNListArray(),
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<uint64_t> d_cluster_mask(cluster_nlist.getClusterMaskArray(),
+                                         access_location::device,
+                                         access_mode::read);
+
+    ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(),
+                                   access_location::device,
+                                   access_mode::read);
+    ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(),
+                                 access_location::device,
+                                 access_mode::read);
+
+    BoxDim box = this->m_pdata->getBox();
+
+    ArrayHandle<Scalar> d_ronsq(this->m_ronsq, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_rcutsq(this->m_rcutsq, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::readwrite);
+
+    PDataFlags flags = this->m_pdata->getFlags();
+
+    this->m_exec_conf->beginMultiGPU();
+
+    pair_args_t pair_args(d_force.data,
+                          d_virial.data,
+                          this->m_virial.getPitch(),
+                          this->m_pdata->getN(),
+                          this->m_pdata->getMaxN(),
+                          d_pos.data,
+                          d_diameter.data,
+                          d_charge.data,
+                          box,
+                          nullptr,
+                          nullptr,
+                          nullptr,
+                          d_rcutsq.data,
+                          d_ronsq.data,
+                          0,
+                          this->m_pdata->getNTypes(),
+                          gpu_nlist_cluster_size * gpu_nlist_cluster_size,
+                          this->m_shift_mode,
+                          flags[pdata_flag::pressure_tensor],
+                          1,
+                          this->m_pdata->getGPUPartition(),
+                          this->m_exec_conf->dev_prop);
+    pair_args.d_n_cluster_neigh = d_n_cluster_neigh.data;
+    pair_args.d_cluster_nlist = d_cluster_nlist.data;
+    pair_args.d_cluster_mask = d_cluster_mask.data;
+    pair_args.cluster_nmax = cluster_nlist.getClusterNmax();
+    pair_args.stream = this->m_stream;
+
+    computePairForcesGPU(pair_args);
+
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    this->m_exec_conf->endMultiGPU();
     }
 
 //! Export this pair potential to python
@@ -0,0 +1,64 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PotentialPairJIT.h"
+#include "PairEvalFactory.h"
+
+#include <sstream>
+
+/*! \file PotentialPairJIT.cc
+    \brief Defines PotentialPairJIT
+*/
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighbor list to use
+    \param cpu_code C++ code to compile
+    \param compiler_args Additional arguments to pass to the compiler
+*/
+PotentialPairJIT::PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<NeighborList> nlist,
+                                   const std::string& cpu_code,
+                                   const std::vector<std::string>& compiler_args)
+    : PotentialPair<EvaluatorPairJIT>(sysdef, nlist)
+    {
+    m_factory = std::make_shared<PairEvalFactory>(cpu_code, compiler_args);
+    m_eval = reinterpret_cast<pair_jit_eval_t>(m_factory->getEval());
+
+    if (!m_eval)
+        {
+        std::ostringstream s;
+        s << "Error compiling JIT code:" << std::endl;
+        s << cpu_code << std::endl;
+        s << m_factory->getError() << std::endl;
+        throw std::runtime_error(s.str());
+        }
+
+    for (auto& param : m_params)
+        param.eval = m_eval;
+    }
+
+PotentialPairJIT::~PotentialPairJIT() { }
+
+/*! \param typ1 First type index in the pair
+    \param typ2 Second type index in the pair
+    \param param Parameter to set
+
+    The compiled function is stored alongside the user parameters.
+*/
+void PotentialPairJIT::setParams(unsigned int typ1, unsigned int typ2, const param_type& param)
+    {
+    param_type jit_param = param;
+    jit_param.eval = m_eval;
+    PotentialPair<EvaluatorPairJIT>::setParams(typ1, typ2, jit_param);
+    }
+
+void export_PotentialPairJIT(pybind11::module& m)
+    {
+    pybind11::class_<PotentialPairJIT,
+                     PotentialPair<EvaluatorPairJIT>,
+                     std::shared_ptr<PotentialPairJIT>>(m, "PotentialPairJIT")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            const std::string&,
+                            const std::vector<std::string>&>());
+    }
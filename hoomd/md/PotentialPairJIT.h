@@ -0,0 +1,54 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __POTENTIAL_PAIR_JIT_H__
+#define __POTENTIAL_PAIR_JIT_H__
+
+#include "EvaluatorPairJIT.h"
+#include "PotentialPair.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file PotentialPairJIT.h
+    \brief Declares PotentialPairJIT
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+class PairEvalFactory;
+
+//! Compute a pair potential given in C++ code at run time
+/*! The code is compiled with LLVM on construction (see PairEvalFactory) and evaluated with
+    EvaluatorPairJIT in the standard PotentialPair loop, so the runtime generated potential supports
+    all of the features of the built in pair potentials.
+*/
+class PYBIND11_EXPORT PotentialPairJIT : public PotentialPair<EvaluatorPairJIT>
+    {
+    public:
+    //! Construct the pair potential
+    PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<NeighborList> nlist,
+                     const std::string& cpu_code,
+                     const std::vector<std::string>& compiler_args);
+
+    //! Destructor
+    virtual ~PotentialPairJIT();
+
+    //! Set the pair parameters for a single type pair
+    virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param);
+
+    protected:
+    std::shared_ptr<PairEvalFactory> m_factory; //!< The JIT compiled code
+    pair_jit_eval_t m_eval;                     //!< The compiled host function
+    };
+
+//! Export PotentialPairJIT to python
+void export_PotentialPairJIT(pybind11::module& m);
+
+#endif // __POTENTIAL_PAIR_JIT_H__
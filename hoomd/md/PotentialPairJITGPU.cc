@@ -0,0 +1,307 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_HIP
+
+#include "PotentialPairJITGPU.h"
+#include "hoomd/HOOMDVersion.h"
+#include "hoomd/hpmc/JITCache.h"
+
+#include <sstream>
+
+#include "PairEvalFactory.h"
+
+/*! \file PotentialPairJITGPU.cc
+    \brief Defines PotentialPairJITGPU
+*/
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighbor list to use
+    \param cpu_code C++ code to compile for the host
+    \param compiler_args Additional arguments to pass to the host compiler
+    \param gpu_code CUDA code to compile with NVRTC
+    \param gpu_options Additional options to pass to NVRTC
+    \param compute_arch Compute architecture to compile for
+*/
+PotentialPairJITGPU::PotentialPairJITGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                         std::shared_ptr<NeighborList> nlist,
+                                         const std::string& cpu_code,
+                                         const std::vector<std::string>& compiler_args,
+                                         const std::string& gpu_code,
+                                         const std::vector<std::string>& gpu_options,
+                                         unsigned int compute_arch)
+    : PotentialPairGPU<EvaluatorPairJIT, gpu_compute_pair_jit_forces>(sysdef, nlist)
+    {
+    m_factory = std::make_shared<PairEvalFactory>(cpu_code, compiler_args);
+    m_eval = reinterpret_cast<pair_jit_eval_t>(m_factory->getEval());
+
+    if (!m_eval)
+        {
+        std::ostringstream s;
+        s << "Error compiling JIT code:" << std::endl;
+        s << cpu_code << std::endl;
+        s << m_factory->getError() << std::endl;
+        throw std::runtime_error(s.str());
+        }
+
+    for (auto& param : m_params)
+        param.eval = m_eval;
+
+#ifdef __HIP_PLATFORM_NVCC__
+    m_compile_options = {
+        "--gpu-architecture=compute_" + std::to_string(compute_arch),
+        "--std=c++14",
+#ifdef SINGLE_PRECISION
+        "-DSINGLE_PRECISION",
+#endif
+        "-DHOOMD_LLVMJIT_BUILD",
+        "-D__HIPCC__",
+        "-D__HIP_DEVICE_COMPILE__",
+        "-D__HIP_PLATFORM_NVCC__",
+    };
+    for (auto& option : gpu_options)
+        m_compile_options.push_back(option);
+
+    m_exec_conf->msg->notice(3) << "nvrtc options (notice level 5 shows code):" << std::endl;
+    for (auto& option : m_compile_options)
+        m_exec_conf->msg->notice(3) << " " << option << std::endl;
+    m_exec_conf->msg->notice(5) << gpu_code << std::endl;
+
+    // the kernels are compiled, or loaded from the cache, on first use
+    m_code = gpu_code;
+    m_kernels.resize(m_exec_conf->getNumActiveGPUs());
+#else
+    throw std::runtime_error("Runtime compiled pair potentials require a CUDA build on the GPU.");
+#endif
+    }
+
+PotentialPairJITGPU::~PotentialPairJITGPU() { }
+
+/*! \param typ1 First type index in the pair
+    \param typ2 Second type index in the pair
+    \param param Parameter to set
+
+    The compiled host function is stored alongside the user parameters.
+*/
+void PotentialPairJITGPU::setParams(unsigned int typ1, unsigned int typ2, const param_type& param)
+    {
+    param_type jit_param = param;
+    jit_param.eval = m_eval;
+    PotentialPairGPU<EvaluatorPairJIT, gpu_compute_pair_jit_forces>::setParams(typ1,
+                                                                                typ2,
+                                                                                jit_param);
+    }
+
+/*! \param pair_args Arguments prepared by PotentialPairGPU
+
+    Mirrors gpu_compute_pair_forces() and PairForceComputeKernel::launch() for the standard
+    neighbor list, launching the NVRTC instantiations of gpu_compute_pair_forces_shared_kernel().
+*/
+void PotentialPairJITGPU::computePairForcesGPU(const pair_args_t& pair_args)
+    {
+    if (pair_args.d_n_cluster_neigh)
+        {
+        throw std::runtime_error(
+            "Runtime compiled pair potentials do not support the cluster pair neighbor list.");
+        }
+
+#ifdef __HIP_PLATFORM_NVCC__
+    Index2D typpair_idx(pair_args.ntypes);
+    const size_t param_shared_bytes
+        = (2 * sizeof(Scalar) + sizeof(param_type)) * typpair_idx.getNumElements();
+
+    const unsigned int tpp = pair_args.threads_per_particle;
+    std::vector<std::string> template_args = {"EvaluatorPairJIT",
+                                              std::to_string(pair_args.shift_mode),
+                                              pair_args.compute_virial ? "1" : "0",
+                                              std::to_string(tpp),
+                                              "true"};
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = pair_args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = pair_args.gpu_partition.getRangeAndSetGPU(idev);
+
+        // an explicit list of particles is evaluated on a single GPU
+        if (pair_args.d_index)
+            {
+            if (idev > 0)
+                continue;
+            range = std::make_pair(0u, pair_args.n_index);
+            }
+
+        // fall back to reading the parameters from global memory when they do not fit
+        template_args[4] = "true";
+        const jitify::experimental::KernelInstantiation* kernel = &getKernel(idev, template_args);
+        int kernel_shared_bytes = getKernelAttribute(*kernel, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES);
+        bool shared_params = pair_args.shared_params
+                             && gpu_pair_force_params_fit_shared(pair_args,
+                                                                 param_shared_bytes,
+                                                                 kernel_shared_bytes);
+        if (!shared_params)
+            {
+            template_args[4] = "false";
+            kernel = &getKernel(idev, template_args);
+            kernel_shared_bytes = getKernelAttribute(*kernel, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES);
+            }
+
+        unsigned int max_extra_bytes = 0;
+        size_t shared_bytes = 0;
+        if (shared_params)
+            {
+            max_extra_bytes = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock
+                                                        - param_shared_bytes - kernel_shared_bytes);
+            shared_bytes = param_shared_bytes;
+            }
+
+        unsigned int max_block_size
+            = getKernelAttribute(*kernel, CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK);
+        max_block_size -= max_block_size % gpu_pair_force_max_tpp;
+        unsigned int block_size = std::min(pair_args.block_size, max_block_size);
+
+        unsigned int N = range.second - range.first;
+        unsigned int offset = range.first;
+        dim3 grid(N / (block_size / tpp) + 1, 1, 1);
+
+        const param_type* d_params = this->m_params.data();
+        CUresult res = kernel
+                           ->configure(grid,
+                                       dim3(block_size, 1, 1),
+                                       static_cast<unsigned int>(shared_bytes),
+                                       pair_args.stream)
+                           .launch(pair_args.d_force,
+                                   pair_args.d_virial,
+                                   pair_args.virial_pitch,
+                                   N,
+                                   pair_args.d_pos,
+                                   pair_args.d_diameter,
+                                   pair_args.d_charge,
+                                   pair_args.box,
+                                   pair_args.d_n_neigh,
+                                   pair_args.d_nlist,
+                                   pair_args.d_head_list,
+                                   pair_args.d_ex_mask,
+                                   pair_args.d_tag,
+                                   d_params,
+                                   pair_args.d_rcutsq,
+                                   pair_args.d_ronsq,
+                                   pair_args.ntypes,
+                                   offset,
+                                   pair_args.d_index,
+                                   pair_args.half,
+                                   pair_args.N,
+                                   max_extra_bytes);
+
+        if (res != CUDA_SUCCESS)
+            {
+            char* error;
+            cuGetErrorString(res, const_cast<const char**>(&error));
+            throw std::runtime_error("Error launching NVRTC kernel: " + std::string(error));
+            }
+        }
+#endif
+    }
+
+#ifdef __HIP_PLATFORM_NVCC__
+/*! \param idev the logical GPU id
+    \param template_args Template arguments of gpu_compute_pair_forces_shared_kernel()
+
+    Kernel instantiations are cached on disk with hpmc::detail::JITCache. NVRTC only runs when an
+    instantiation is in neither the in memory nor the on disk cache.
+*/
+const jitify::experimental::KernelInstantiation&
+PotentialPairJITGPU::getKernel(unsigned int idev, const std::vector<std::string>& template_args)
+    {
+    const std::string kernel_name = "gpu_compute_pair_forces_shared_kernel";
+
+    std::ostringstream instantiation;
+    instantiation << kernel_name << "<";
+    for (unsigned int i = 0; i < template_args.size(); ++i)
+        instantiation << (i ? "," : "") << template_args[i];
+    instantiation << ">";
+    const std::string key = instantiation.str();
+
+    auto it = m_kernels[idev].find(key);
+    if (it != m_kernels[idev].end())
+        return it->second;
+
+    // kernels are loaded into the context of the current device
+    cudaSetDevice(m_exec_conf->getGPUIds()[idev]);
+
+    // the PTX depends on the compiler, the HOOMD headers, the instantiation, and the input
+    std::ostringstream cache_key_stream;
+    cache_key_stream << "nvrtc " << CUDA_VERSION << "\n"
+                     << "HOOMD " << HOOMD_VERSION << "\n"
+                     << key << "\n";
+    for (auto& option : m_compile_options)
+        {
+        cache_key_stream << option << "\n";
+        }
+    cache_key_stream << m_code;
+    const std::string cache_key = cache_key_stream.str();
+
+    std::string serialized;
+    if (hpmc::detail::JITCache::load(cache_key, serialized))
+        {
+        try
+            {
+            auto inserted = m_kernels[idev].emplace(
+                key,
+                jitify::experimental::KernelInstantiation::deserialize(serialized));
+            m_exec_conf->msg->notice(3) << "Loaded nvrtc kernel " << key << " from "
+                                        << hpmc::detail::JITCache::getPath() << std::endl;
+            return inserted.first->second;
+            }
+        catch (const std::runtime_error&)
+            {
+            // compile the kernel again when the cache entry is unreadable
+            }
+        }
+
+    if (!m_program)
+        {
+        m_program.reset(new jitify::experimental::Program(m_code, {}, m_compile_options));
+        }
+
+    m_exec_conf->msg->notice(3) << "Compiling nvrtc kernel " << key << " on GPU " << idev
+                                << std::endl;
+    auto inserted
+        = m_kernels[idev].emplace(key, m_program->kernel(kernel_name).instantiate(template_args));
+    hpmc::detail::JITCache::store(cache_key, inserted.first->second.serialize());
+    return inserted.first->second;
+    }
+
+/*! \param kernel Kernel instantiation to query
+    \param attribute Attribute to get
+*/
+int PotentialPairJITGPU::getKernelAttribute(const jitify::experimental::KernelInstantiation& kernel,
+                                            CUfunction_attribute attribute)
+    {
+    int value = 0;
+    CUresult custatus = cuFuncGetAttribute(&value, attribute, kernel);
+    if (custatus != CUDA_SUCCESS)
+        {
+        char* error;
+        cuGetErrorString(custatus, const_cast<const char**>(&error));
+        throw std::runtime_error("cuFuncGetAttribute: " + std::string(error));
+        }
+    return value;
+    }
+#endif
+
+void export_PotentialPairJITGPU(pybind11::module& m)
+    {
+    pybind11::class_<PotentialPairJITGPU,
+                     PotentialPair<EvaluatorPairJIT>,
+                     std::shared_ptr<PotentialPairJITGPU>>(m, "PotentialPairJITGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            const std::string&,
+                            const std::vector<std::string>&,
+                            const std::string&,
+                            const std::vector<std::string>&,
+                            unsigned int>())
+        .def("setTuningParam", &PotentialPairJITGPU::setTuningParam);
+    }
+
+#endif // ENABLE_HIP
@@ -0,0 +1,121 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __POTENTIAL_PAIR_JIT_GPU_H__
+#define __POTENTIAL_PAIR_JIT_GPU_H__
+
+#ifdef ENABLE_HIP
+
+#include "EvaluatorPairJIT.h"
+#include "PotentialPairGPU.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __HIP_PLATFORM_NVCC__
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <nvrtc.h>
+
+#ifdef ENABLE_DEBUG_JIT
+#define JITIFY_PRINT_LOG 1
+#define JITIFY_PRINT_LINKER_LOG 1
+#define JITIFY_PRINT_LAUNCH 1
+#else
+#define JITIFY_PRINT_LOG 0
+#define JITIFY_PRINT_LAUNCH 0
+#endif
+#define JITIFY_PRINT_INSTANTIATION 0
+#define JITIFY_PRINT_SOURCE 0
+#define JITIFY_PRINT_PTX 0
+#define JITIFY_PRINT_HEADER_PATHS 0
+
+#undef DEVICE
+#include "hoomd/extern/jitify.hpp"
+#endif
+
+/*! \file PotentialPairJITGPU.h
+    \brief Declares PotentialPairJITGPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+class PairEvalFactory;
+
+//! Placeholder driver function, PotentialPairJITGPU launches the runtime compiled kernels itself
+inline hipError_t gpu_compute_pair_jit_forces(const pair_args_t& pair_args,
+                                              const EvaluatorPairJIT::param_type* d_params)
+    {
+    return hipErrorNotSupported;
+    }
+
+//! Compute a pair potential given in C++ code at run time on the GPU
+/*! The code is compiled with NVRTC into gpu_compute_pair_forces_shared_kernel() instantiated with
+    EvaluatorPairJIT, the same kernel that evaluates the built in pair potentials, so the runtime
+    generated potential runs at the same speed. PotentialPairGPU manages the neighbor list, the
+    overlap with the ghost communication, and the autotuner as for any other potential.
+
+    Kernel instantiations are compiled when first launched and cached in memory and on disk with
+    hpmc::detail::JITCache. The code is also compiled for the host with LLVM (see PairEvalFactory)
+    for the methods of PotentialPair that evaluate pairs on the CPU.
+
+    Only the standard neighbor list is supported: the rows of a compressed neighbor list are
+    ignored, and the cluster pair neighbor list is rejected.
+*/
+class PYBIND11_EXPORT PotentialPairJITGPU
+    : public PotentialPairGPU<EvaluatorPairJIT, gpu_compute_pair_jit_forces>
+    {
+    public:
+    //! Construct the pair potential
+    PotentialPairJITGPU(std::shared_ptr<SystemDefinition> sysdef,
+                        std::shared_ptr<NeighborList> nlist,
+                        const std::string& cpu_code,
+                        const std::vector<std::string>& compiler_args,
+                        const std::string& gpu_code,
+                        const std::vector<std::string>& gpu_options,
+                        unsigned int compute_arch);
+
+    //! Destructor
+    virtual ~PotentialPairJITGPU();
+
+    //! Set the pair parameters for a single type pair
+    virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param);
+
+    protected:
+    std::shared_ptr<PairEvalFactory> m_factory; //!< The JIT compiled host code
+    pair_jit_eval_t m_eval;                     //!< The compiled host function
+
+    //! Launch the runtime compiled kernels
+    virtual void computePairForcesGPU(const pair_args_t& pair_args);
+
+#ifdef __HIP_PLATFORM_NVCC__
+    std::string m_code;                         //!< Code to compile with NVRTC
+    std::vector<std::string> m_compile_options; //!< NVRTC options
+
+    //! The NVRTC program, created when the first kernel is compiled
+    std::unique_ptr<jitify::experimental::Program> m_program;
+
+    //! Kernel instantiations of each GPU, by template arguments
+    std::vector<std::map<std::string, jitify::experimental::KernelInstantiation>> m_kernels;
+
+    //! Get a kernel instantiation, compile it or load it from the cache when needed
+    const jitify::experimental::KernelInstantiation&
+    getKernel(unsigned int idev, const std::vector<std::string>& template_args);
+
+    //! Get a function attribute of a kernel instantiation
+    int getKernelAttribute(const jitify::experimental::KernelInstantiation& kernel,
+                           CUfunction_attribute attribute);
+#endif
+    };
+
+//! Export PotentialPairJITGPU to python
+void export_PotentialPairJITGPU(pybind11::module& m);
+
+#endif // ENABLE_HIP
+#endif // __POTENTIAL_PAIR_JIT_GPU_H__
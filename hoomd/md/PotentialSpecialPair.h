@@ -3,6 +3,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "hoomd/GlobalArray.h"
 #include <memory>
 
 #include <vector>
@@ -62,7 +63,7 @@ template<class evaluator> class PotentialSpecialPair : public ForceCompute
 #endif
 
     protected:
-    GPUArray<param_type> m_params;         //!< SpecialPair parameters per type
+    GlobalArray<param_type> m_params;      //!< SpecialPair parameters per type
     std::shared_ptr<PairData> m_pair_data; //!< Data to use in computing particle pairs
     std::string m_prof_name;               //!< Cached profiler name
 
@@ -85,7 +86,7 @@ PotentialSpecialPair<evaluator>::PotentialSpecialPair(std::shared_ptr<SystemDefi
     m_prof_name = std::string("Special pair ") + evaluator::getName();
 
     // allocate the parameters
-    GPUArray<param_type> params(m_pair_data->getNTypes(), m_exec_conf);
+    GlobalArray<param_type> params(m_pair_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
     }
 
@@ -4,10 +4,12 @@
 #ifndef __POTENTIAL_TERSOFF_H__
 #define __POTENTIAL_TERSOFF_H__
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include "NeighborList.h"
 #include "hoomd/ForceCompute.h"
@@ -27,6 +29,11 @@
 
 #include <pybind11/pybind11.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 //! Template class for computing three-body potentials
 /*! <b>Overview:</b>
     PotentialTersoff computes standard three-body potentials and forces between all particles in the
@@ -119,8 +126,23 @@ template<class evaluator> class PotentialTersoff : public ForceCompute
     // r_cut (not squared) given to the neighborlist
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+#ifdef ENABLE_TBB
+    /// Per-chunk force accumulators (n_chunks * (N + N_ghosts))
+    std::vector<Scalar4> m_chunk_force;
+
+    /// Per-chunk virial accumulators (n_chunks * 6 * (N + N_ghosts))
+    std::vector<Scalar> m_chunk_virial;
+#endif
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Run the force kernel over all local particles
+    template<class Kernel>
+    void computeChunks(const Kernel& compute_range,
+                       Scalar4* h_force,
+                       Scalar* h_virial,
+                       bool compute_virial);
     };
 
 /*! \param sysdef System to compute forces on
@@ -310,222 +332,236 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
         memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
         memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
-            {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            const unsigned int head_i = h_head_list.data[i];
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
-
-            // initialize current force and potential energy of particle i to 0
-            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pei = 0.0;
-
-            Scalar virialixx(0.0);
-            Scalar virialixy(0.0);
-            Scalar virialixz(0.0);
-            Scalar virialiyy(0.0);
-            Scalar virialiyz(0.0);
-            Scalar virializz(0.0);
-
-            // loop over all of the neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            for (unsigned int j = 0; j < size; j++)
+        // compute the forces on particles [first, last), adding the forces and virials on i, j,
+        // and k to force and virial (with pitch virial_pitch)
+        auto compute_range = [&](unsigned int first,
+                                 unsigned int last,
+                                 Scalar4* force,
+                                 Scalar* virial,
+                                 size_t virial_pitch)
+        {
+            // for each particle
+            for (unsigned int i = first; i < last; i++)
                 {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
-
-                // initialize the current force and potential energy of particle j to 0
-                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-                Scalar pej = 0.0;
-
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
-
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-                // evaluate the base repulsive and attractive terms
-                Scalar invratio = 0.0;
-                Scalar invratio2 = 0.0;
-                evaluator eval(rij_sq, rcutsq, param);
-                bool evaluated = eval.evalRepulsiveAndAttractive(invratio, invratio2);
-
-                // Even though the i-j interaction is symmetric so in principle I could consider i>j
-                // only, I have to loop over both i-j-k and j-i-k because I search only in neighbors
-                // of of the first element (since nl are type-wise I can not even merge them because
-                // i, j and k could be different types)
-                if (evaluated)
+                // access the particle's position and type (MEM TRANSFER: 4 scalars)
+                Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+                const unsigned int head_i = h_head_list.data[i];
+                // sanity check
+                assert(typei < m_pdata->getNTypes());
+
+                // initialize current force and potential energy of particle i to 0
+                Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+                Scalar pei = 0.0;
+
+                Scalar virialixx(0.0);
+                Scalar virialixy(0.0);
+                Scalar virialixz(0.0);
+                Scalar virialiyy(0.0);
+                Scalar virialiyz(0.0);
+                Scalar virializz(0.0);
+
+                // loop over all of the neighbors of this particle
+                const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                for (unsigned int j = 0; j < size; j++)
                     {
-                    // printf("\nEvaluating the pair (i,j)=(%d, %d)  from inside HOOMD CPU",i,jj);
-                    // evaluate the force and energy from the ij interaction
-                    Scalar force_divr = Scalar(0.0);
-                    Scalar potential_eng = Scalar(0.0);
-                    Scalar bij = Scalar(0.0); // not used
-                    eval.evalForceij(invratio,
-                                     invratio2,
-                                     Scalar(0.0),
-                                     Scalar(0.0),
-                                     bij,
-                                     force_divr,
-                                     potential_eng);
-
-                    // add this force to particle i
-                    fi += force_divr * dxij;
-                    pei += potential_eng;
-
-                    // add this force to particle j
-                    fj += Scalar(-1.0) * force_divr * dxij;
-                    pej += potential_eng;
-
-                    // vir contribute for i j direct interaction on particle i and j
-                    if (compute_virial)
-                        {
-                        virialixx += force_divr * dxij.x * dxij.x;
-                        virialixy += force_divr * dxij.x * dxij.y;
-                        virialixz += force_divr * dxij.x * dxij.z;
-                        virialiyy += force_divr * dxij.y * dxij.y;
-                        virialiyz += force_divr * dxij.y * dxij.z;
-                        virializz += force_divr * dxij.z * dxij.z;
-                        }
+                    // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+                    unsigned int jj = h_nlist.data[head_i + j];
+                    assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    // access the position and type of particle j
+                    Scalar3 posj
+                        = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                    unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+                    assert(typej < m_pdata->getNTypes());
+
+                    // initialize the current force and potential energy of particle j to 0
+                    Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+                    Scalar pej = 0.0;
+
+                    // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                    Scalar3 dxij = posi - posj;
+
+                    // apply periodic boundary conditions
+                    dxij = box.minImage(dxij);
+
+                    // compute rij_sq (FLOPS: 5)
+                    Scalar rij_sq = dot(dxij, dxij);
 
-                    // evaluate the force from the ik interactions
-                    for (unsigned int k = j + 1; k < size;
-                         k++) // I want to account only a single time for each triplets
+                    // get parameters for this type pair
+                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                    param_type param = h_params.data[typpair_idx];
+                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+
+                    // evaluate the base repulsive and attractive terms
+                    Scalar invratio = 0.0;
+                    Scalar invratio2 = 0.0;
+                    evaluator eval(rij_sq, rcutsq, param);
+                    bool evaluated = eval.evalRepulsiveAndAttractive(invratio, invratio2);
+
+                    // Even though the i-j interaction is symmetric so in principle I could consider
+                    // i>j only, I have to loop over both i-j-k and j-i-k because I search only in
+                    // neighbors of of the first element (since nl are type-wise I can not even
+                    // merge them because i, j and k could be different types)
+                    if (evaluated)
                         {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk
-                            = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
-
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param
-                            = h_params.data[typpair_idx]; // use this to control the species wich
-                                                          // have to interact
-
-                        // compute dr_ik
-                        Scalar3 dxik = posi - posk;
-                        // apply periodic boundary conditions
-                        dxik = box.minImage(dxik);
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
-
-                        // check if k interacts using a temporary evaluator to analyze i-k
-                        // parameters
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        temp_eval.setRik(rik_sq);
-                        bool temp_evaluated = temp_eval.areInteractive();
-
-                        // 3 Body interaction ******
-                        if (temp_evaluated)
+                        // evaluate the force and energy from the ij interaction
+                        Scalar force_divr = Scalar(0.0);
+                        Scalar potential_eng = Scalar(0.0);
+                        Scalar bij = Scalar(0.0); // not used
+                        eval.evalForceij(invratio,
+                                         invratio2,
+                                         Scalar(0.0),
+                                         Scalar(0.0),
+                                         bij,
+                                         force_divr,
+                                         potential_eng);
+
+                        // add this force to particle i
+                        fi += force_divr * dxij;
+                        pei += potential_eng;
+
+                        // add this force to particle j
+                        fj += Scalar(-1.0) * force_divr * dxij;
+                        pej += potential_eng;
+
+                        // vir contribute for i j direct interaction on particle i and j
+                        if (compute_virial)
                             {
-                            eval.setRik(rik_sq);
-                            // compute the total force and energy
-                            Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ij_vec = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ik_vec = make_scalar3(0.0, 0.0, 0.0);
-                            bool evaluatedk = eval.evalForceik(invratio,
-                                                               invratio2,
-                                                               Scalar(0.0),
-                                                               Scalar(0.0),
-                                                               force_divr_ij_vec,
-                                                               force_divr_ik_vec);
-                            // k interacts with the i-j as an additional third body
-                            if (evaluatedk)
-                                {
-                                // I stored the modulus of the force in the first component
-                                Scalar force_divr_ij = force_divr_ij_vec.x;
-                                Scalar force_divr_ik = force_divr_ik_vec.x;
+                            virialixx += force_divr * dxij.x * dxij.x;
+                            virialixy += force_divr * dxij.x * dxij.y;
+                            virialixz += force_divr * dxij.x * dxij.z;
+                            virialiyy += force_divr * dxij.y * dxij.y;
+                            virialiyz += force_divr * dxij.y * dxij.z;
+                            virializz += force_divr * dxij.z * dxij.z;
+                            }
 
-                                // add the force to particle i
-                                fi += force_divr_ij * dxij + force_divr_ik * dxik;
+                        // evaluate the force from the ik interactions
+                        for (unsigned int k = j + 1; k < size;
+                             k++) // I want to account only a single time for each triplets
+                            {
+                            // access the index of neighbor k
+                            unsigned int kk = h_nlist.data[head_i + k];
+                            assert(kk < m_pdata->getN());
 
-                                // add the force to particle j (FLOPS: 17)
-                                fj += force_divr_ij * dxij * Scalar(-1.0);
+                            // access the position and type of neighbor k
+                            Scalar3 posk
+                                = make_scalar3(h_pos.data[kk].x,
+                                               h_pos.data[kk].y,
+                                               h_pos.data[kk].z);
+                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
+                            assert(typek < m_pdata->getNTypes());
 
-                                // add the force to particle k
-                                fk += force_divr_ik * dxik * Scalar(-1.0);
+                            // access the type pair parameters for i and k
+                            typpair_idx = m_typpair_idx(typei, typek);
+                            param_type temp_param
+                                = h_params.data[typpair_idx]; // use this to control the species
+                                                              // which have to interact
+
+                            // compute dr_ik
+                            Scalar3 dxik = posi - posk;
+                            // apply periodic boundary conditions
+                            dxik = box.minImage(dxik);
+                            // compute rik_sq
+                            Scalar rik_sq = dot(dxik, dxik);
+
+                            // check if k interacts using a temporary evaluator to analyze i-k
+                            // parameters
+                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                            temp_eval.setRik(rik_sq);
+                            bool temp_evaluated = temp_eval.areInteractive();
 
-                                if (compute_virial)
+                            // 3 Body interaction ******
+                            if (temp_evaluated)
+                                {
+                                eval.setRik(rik_sq);
+                                // compute the total force and energy
+                                Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
+                                Scalar3 force_divr_ij_vec = make_scalar3(0.0, 0.0, 0.0);
+                                Scalar3 force_divr_ik_vec = make_scalar3(0.0, 0.0, 0.0);
+                                bool evaluatedk = eval.evalForceik(invratio,
+                                                                   invratio2,
+                                                                   Scalar(0.0),
+                                                                   Scalar(0.0),
+                                                                   force_divr_ij_vec,
+                                                                   force_divr_ik_vec);
+                                // k interacts with the i-j as an additional third body
+                                if (evaluatedk)
                                     {
-                                    //***look at 3 body pressure notes
-                                    // i just need a single term to account for all of the 3 body
-                                    // virial that i decide to store in the i particle's data and i
-                                    // just defined the diagonal component of pressure tensor, I
-                                    // don't know how the off diagonal terms can be included
-                                    virialixx += (force_divr_ij * dxij.x * dxij.x
-                                                  + force_divr_ik * dxik.x * dxik.x);
-                                    virialiyy += (force_divr_ij * dxij.y * dxij.y
-                                                  + force_divr_ik * dxik.y * dxik.y);
-                                    virializz += (force_divr_ij * dxij.z * dxij.z
-                                                  + force_divr_ik * dxik.z * dxik.z);
-                                    virialixy += (force_divr_ij * dxij.x * dxij.y
-                                                  + force_divr_ik * dxik.x * dxik.y);
-                                    virialixz += (force_divr_ij * dxij.x * dxij.z
-                                                  + force_divr_ik * dxik.x * dxik.z);
-                                    virialiyz += (force_divr_ij * dxij.y * dxij.z
-                                                  + force_divr_ik * dxik.y * dxik.z);
+                                    // I stored the modulus of the force in the first component
+                                    Scalar force_divr_ij = force_divr_ij_vec.x;
+                                    Scalar force_divr_ik = force_divr_ik_vec.x;
+
+                                    // add the force to particle i
+                                    fi += force_divr_ij * dxij + force_divr_ik * dxik;
+
+                                    // add the force to particle j (FLOPS: 17)
+                                    fj += force_divr_ij * dxij * Scalar(-1.0);
+
+                                    // add the force to particle k
+                                    fk += force_divr_ik * dxik * Scalar(-1.0);
+
+                                    if (compute_virial)
+                                        {
+                                        //***look at 3 body pressure notes
+                                        // i just need a single term to account for all of the 3
+                                        // body virial that i decide to store in the i particle's
+                                        // data and i just defined the diagonal component of
+                                        // pressure tensor, I don't know how the off diagonal terms
+                                        // can be included
+                                        virialixx += (force_divr_ij * dxij.x * dxij.x
+                                                      + force_divr_ik * dxik.x * dxik.x);
+                                        virialiyy += (force_divr_ij * dxij.y * dxij.y
+                                                      + force_divr_ik * dxik.y * dxik.y);
+                                        virializz += (force_divr_ij * dxij.z * dxij.z
+                                                      + force_divr_ik * dxik.z * dxik.z);
+                                        virialixy += (force_divr_ij * dxij.x * dxij.y
+                                                      + force_divr_ik * dxik.x * dxik.y);
+                                        virialixz += (force_divr_ij * dxij.x * dxij.z
+                                                      + force_divr_ik * dxik.x * dxik.z);
+                                        virialiyz += (force_divr_ij * dxij.y * dxij.z
+                                                      + force_divr_ik * dxik.y * dxik.z);
+                                        }
+
+                                    // increment the force for particle k
+                                    unsigned int mem_idx = kk;
+                                    force[mem_idx].x += fk.x;
+                                    force[mem_idx].y += fk.y;
+                                    force[mem_idx].z += fk.z;
                                     }
-
-                                // increment the force for particle k
-                                unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
                                 }
                             }
                         }
-                    }
 
-                // increment the force and potential energy for particle j
-                unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
-                }
+                    // increment the force and potential energy for particle j
+                    unsigned int mem_idx = jj;
+                    force[mem_idx].x += fj.x;
+                    force[mem_idx].y += fj.y;
+                    force[mem_idx].z += fj.z;
+                    force[mem_idx].w += pej;
+                    }
 
-            // finally, increment the force and potential energy for particle i
-            unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
+                // finally, increment the force and potential energy for particle i
+                unsigned int mem_idx = i;
+                force[mem_idx].x += fi.x;
+                force[mem_idx].y += fi.y;
+                force[mem_idx].z += fi.z;
+                force[mem_idx].w += pei;
 
-            // imcrement vir for i
-            if (compute_virial)
-                {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += virialixx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += virialixy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += virialixz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += virialiyy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += virialiyz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += virializz;
+                // imcrement vir for i
+                if (compute_virial)
+                    {
+                    virial[0 * virial_pitch + mem_idx] += virialixx;
+                    virial[1 * virial_pitch + mem_idx] += virialixy;
+                    virial[2 * virial_pitch + mem_idx] += virialixz;
+                    virial[3 * virial_pitch + mem_idx] += virialiyy;
+                    virial[4 * virial_pitch + mem_idx] += virialiyz;
+                    virial[5 * virial_pitch + mem_idx] += virializz;
+                    }
                 }
-            }
+        };
+
+        computeChunks(compute_range, h_force.data, h_virial.data, compute_virial);
         }
     else
         {
@@ -579,39 +615,92 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
         unsigned int ntypes = m_pdata->getNTypes();
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
-            {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            const unsigned int head_i = h_head_list.data[i];
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
-
-            // initialize current force and potential energy of particle i to 0
-            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pei = 0.0;
-
-            Scalar viriali_xx(0.0);
-            Scalar viriali_xy(0.0);
-            Scalar viriali_xz(0.0);
-            Scalar viriali_yy(0.0);
-            Scalar viriali_yz(0.0);
-            Scalar viriali_zz(0.0);
-
-            Scalar phi_ab[ntypes];
-
-            // reset phi
-            for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+        // compute the forces on particles [first, last), adding the forces and virials on i, j,
+        // and k to force and virial (with pitch virial_pitch)
+        auto compute_range = [&](unsigned int first,
+                                 unsigned int last,
+                                 Scalar4* force,
+                                 Scalar* virial,
+                                 size_t virial_pitch)
+        {
+            // for each particle
+            for (unsigned int i = first; i < last; i++)
                 {
-                phi_ab[typ_b] = Scalar(0.0);
-                }
+                // access the particle's position and type (MEM TRANSFER: 4 scalars)
+                Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+                const unsigned int head_i = h_head_list.data[i];
+                // sanity check
+                assert(typei < m_pdata->getNTypes());
+
+                // initialize current force and potential energy of particle i to 0
+                Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+                Scalar pei = 0.0;
+
+                Scalar viriali_xx(0.0);
+                Scalar viriali_xy(0.0);
+                Scalar viriali_xz(0.0);
+                Scalar viriali_yy(0.0);
+                Scalar viriali_yz(0.0);
+                Scalar viriali_zz(0.0);
+
+                Scalar phi_ab[ntypes];
+
+                // reset phi
+                for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                    {
+                    phi_ab[typ_b] = Scalar(0.0);
+                    }
 
-            // all neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            if (evaluator::hasPerParticleEnergy())
-                {
+                // all neighbors of this particle
+                const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                if (evaluator::hasPerParticleEnergy())
+                    {
+                    for (unsigned int j = 0; j < size; j++)
+                        {
+                        // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+                        unsigned int jj = h_nlist.data[head_i + j];
+                        assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+
+                        // access the position and type of particle j
+                        Scalar3 posj
+                            = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                        unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+                        assert(typej < m_pdata->getNTypes());
+
+                        // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                        Scalar3 dxij = posi - posj;
+
+                        // apply periodic boundary conditions
+                        dxij = box.minImage(dxij);
+
+                        // compute rij_sq (FLOPS: 5)
+                        Scalar rij_sq = dot(dxij, dxij);
+
+                        // get parameters for this type pair
+                        unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                        param_type param = h_params.data[typpair_idx];
+                        Scalar rcutsq = h_rcutsq.data[typpair_idx];
+
+                        // evaluate the scalar per-neighbor contribution
+                        evaluator eval(rij_sq, rcutsq, param);
+                        eval.evalPhi(phi_ab[typej]);
+                        }
+
+                    // self-energy
+                    for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                        {
+                        unsigned int typpair_idx = m_typpair_idx(typei, typ_b);
+                        param_type param = h_params.data[typpair_idx];
+                        Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                        evaluator eval(Scalar(0.0), rcutsq, param);
+                        Scalar energy(0.0);
+                        eval.evalSelfEnergy(energy, phi_ab[typ_b]);
+                        pei += energy;
+                        }
+                    }
+
+                // loop over all of the neighbors of this particle
                 for (unsigned int j = 0; j < size; j++)
                     {
                     // access the index of neighbor j (MEM TRANSFER: 1 scalar)
@@ -624,6 +713,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                     unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
                     assert(typej < m_pdata->getNTypes());
 
+                    // initialize the current force and potential energy of particle j to 0
+                    Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+                    Scalar pej = 0.0;
+
                     // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
                     Scalar3 dxij = posi - posj;
 
@@ -638,336 +731,387 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                     param_type param = h_params.data[typpair_idx];
                     Scalar rcutsq = h_rcutsq.data[typpair_idx];
 
-                    // evaluate the scalar per-neighbor contribution
+                    // evaluate the base repulsive and attractive terms
+                    Scalar fR = 0.0;
+                    Scalar fA = 0.0;
                     evaluator eval(rij_sq, rcutsq, param);
-                    eval.evalPhi(phi_ab[typej]);
-                    }
+                    bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
 
-                // self-energy
-                for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
-                    {
-                    unsigned int typpair_idx = m_typpair_idx(typei, typ_b);
-                    param_type param = h_params.data[typpair_idx];
-                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
-                    evaluator eval(Scalar(0.0), rcutsq, param);
-                    Scalar energy(0.0);
-                    eval.evalSelfEnergy(energy, phi_ab[typ_b]);
-                    pei += energy;
-                    }
-                }
+                    Scalar virialj_xx(0.0);
+                    Scalar virialj_xy(0.0);
+                    Scalar virialj_xz(0.0);
+                    Scalar virialj_yy(0.0);
+                    Scalar virialj_yz(0.0);
+                    Scalar virialj_zz(0.0);
 
-            // loop over all of the neighbors of this particle
-            for (unsigned int j = 0; j < size; j++)
-                {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
-
-                // initialize the current force and potential energy of particle j to 0
-                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-                Scalar pej = 0.0;
-
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
-
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-                // evaluate the base repulsive and attractive terms
-                Scalar fR = 0.0;
-                Scalar fA = 0.0;
-                evaluator eval(rij_sq, rcutsq, param);
-                bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
-
-                Scalar virialj_xx(0.0);
-                Scalar virialj_xy(0.0);
-                Scalar virialj_xz(0.0);
-                Scalar virialj_yy(0.0);
-                Scalar virialj_yz(0.0);
-                Scalar virialj_zz(0.0);
-
-                if (evaluated)
-                    {
-                    // evaluate chi
-                    Scalar chi = 0.0;
-                    if (evaluator::needsChi())
+                    if (evaluated)
                         {
-                        for (unsigned int k = 0; k < size; k++)
+                        // evaluate chi
+                        Scalar chi = 0.0;
+                        if (evaluator::needsChi())
                             {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
+                            for (unsigned int k = 0; k < size; k++)
+                                {
+                                // access the index of neighbor k
+                                unsigned int kk = h_nlist.data[head_i + k];
+                                assert(kk < m_pdata->getN());
 
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
+                                // access the position and type of neighbor k
+                                Scalar3 posk = make_scalar3(h_pos.data[kk].x,
+                                                            h_pos.data[kk].y,
+                                                            h_pos.data[kk].z);
+                                unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
+                                assert(typek < m_pdata->getNTypes());
 
-                            // access the type pair parameters for i and k
-                            typpair_idx = m_typpair_idx(typei, typek);
-                            param_type temp_param = h_params.data[typpair_idx];
+                                // access the type pair parameters for i and k
+                                typpair_idx = m_typpair_idx(typei, typek);
+                                param_type temp_param = h_params.data[typpair_idx];
 
-                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                            bool temp_evaluated = temp_eval.areInteractive();
+                                evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                                bool temp_evaluated = temp_eval.areInteractive();
 
-                            if (kk != jj && temp_evaluated)
-                                {
-                                // compute drik
-                                Scalar3 dxik = posi - posk;
+                                if (kk != jj && temp_evaluated)
+                                    {
+                                    // compute drik
+                                    Scalar3 dxik = posi - posk;
 
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
+                                    // apply periodic boundary conditions
+                                    dxik = box.minImage(dxik);
 
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                                    // compute rik_sq
+                                    Scalar rik_sq = dot(dxik, dxik);
 
-                                // compute the bond angle (if needed)
-                                Scalar cos_th = Scalar(0.0);
-                                if (evaluator::needsAngle())
-                                    cos_th = dot(dxij, dxik) / fast::sqrt(rij_sq * rik_sq);
+                                    // compute the bond angle (if needed)
+                                    Scalar cos_th = Scalar(0.0);
+                                    if (evaluator::needsAngle())
+                                        cos_th = dot(dxij, dxik) / fast::sqrt(rij_sq * rik_sq);
 
-                                // evaluate the partial chi term
-                                eval.setRik(rik_sq);
-                                if (evaluator::needsAngle())
-                                    eval.setAngle(cos_th);
+                                    // evaluate the partial chi term
+                                    eval.setRik(rik_sq);
+                                    if (evaluator::needsAngle())
+                                        eval.setAngle(cos_th);
 
-                                eval.evalChi(chi);
+                                    eval.evalChi(chi);
+                                    }
                                 }
                             }
-                        }
-
-                    // evaluate the force and energy from the ij interaction
-                    Scalar force_divr = Scalar(0.0);
-                    Scalar potential_eng = Scalar(0.0);
-                    Scalar bij = Scalar(0.0);
-                    eval.evalForceij(fR, fA, chi, phi_ab[typej], bij, force_divr, potential_eng);
-
-                    // add this force to particle i
-                    fi += force_divr * dxij;
-                    pei += potential_eng * Scalar(0.5);
-
-                    if (compute_virial)
-                        {
-                        Scalar force_div2r = Scalar(0.5) * force_divr;
-
-                        viriali_xx += force_div2r * dxij.x * dxij.x;
-                        viriali_xy += force_div2r * dxij.x * dxij.y;
-                        viriali_xz += force_div2r * dxij.x * dxij.z;
-                        viriali_yy += force_div2r * dxij.y * dxij.y;
-                        viriali_yz += force_div2r * dxij.y * dxij.z;
-                        viriali_zz += force_div2r * dxij.z * dxij.z;
-                        }
-
-                    // add this force to particle j
-                    fj += Scalar(-1.0) * force_divr * dxij;
-                    pej += potential_eng * Scalar(0.5);
-
-                    if (compute_virial)
-                        {
-                        Scalar force_div2r = Scalar(0.5) * force_divr;
-
-                        virialj_xx += force_div2r * dxij.x * dxij.x;
-                        virialj_xy += force_div2r * dxij.x * dxij.y;
-                        virialj_xz += force_div2r * dxij.x * dxij.z;
-                        virialj_yy += force_div2r * dxij.y * dxij.y;
-                        virialj_yz += force_div2r * dxij.y * dxij.z;
-                        virialj_zz += force_div2r * dxij.z * dxij.z;
-                        }
 
-                    if (evaluator::hasIkForce())
-                        {
-                        // evaluate the force from the ik interactions
-                        for (unsigned int k = 0; k < size; k++)
+                        // evaluate the force and energy from the ij interaction
+                        Scalar force_divr = Scalar(0.0);
+                        Scalar potential_eng = Scalar(0.0);
+                        Scalar bij = Scalar(0.0);
+                        eval.evalForceij(fR,
+                                         fA,
+                                         chi,
+                                         phi_ab[typej],
+                                         bij,
+                                         force_divr,
+                                         potential_eng);
+
+                        // add this force to particle i
+                        fi += force_divr * dxij;
+                        pei += potential_eng * Scalar(0.5);
+
+                        if (compute_virial)
                             {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
+                            Scalar force_div2r = Scalar(0.5) * force_divr;
+
+                            viriali_xx += force_div2r * dxij.x * dxij.x;
+                            viriali_xy += force_div2r * dxij.x * dxij.y;
+                            viriali_xz += force_div2r * dxij.x * dxij.z;
+                            viriali_yy += force_div2r * dxij.y * dxij.y;
+                            viriali_yz += force_div2r * dxij.y * dxij.z;
+                            viriali_zz += force_div2r * dxij.z * dxij.z;
+                            }
 
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
+                        // add this force to particle j
+                        fj += Scalar(-1.0) * force_divr * dxij;
+                        pej += potential_eng * Scalar(0.5);
 
-                            // access the type pair parameters for i and k
-                            typpair_idx = m_typpair_idx(typei, typek);
-                            param_type temp_param = h_params.data[typpair_idx];
-
-                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                            bool temp_evaluated = temp_eval.areInteractive();
+                        if (compute_virial)
+                            {
+                            Scalar force_div2r = Scalar(0.5) * force_divr;
+
+                            virialj_xx += force_div2r * dxij.x * dxij.x;
+                            virialj_xy += force_div2r * dxij.x * dxij.y;
+                            virialj_xz += force_div2r * dxij.x * dxij.z;
+                            virialj_yy += force_div2r * dxij.y * dxij.y;
+                            virialj_yz += force_div2r * dxij.y * dxij.z;
+                            virialj_zz += force_div2r * dxij.z * dxij.z;
+                            }
 
-                            if (kk != jj && temp_evaluated)
+                        if (evaluator::hasIkForce())
+                            {
+                            // evaluate the force from the ik interactions
+                            for (unsigned int k = 0; k < size; k++)
                                 {
-                                // create variable for the force on k
-                                Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-
-                                // compute dr_ik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
+                                // access the index of neighbor k
+                                unsigned int kk = h_nlist.data[head_i + k];
+                                assert(kk < m_pdata->getN());
 
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                                // access the position and type of neighbor k
+                                Scalar3 posk = make_scalar3(h_pos.data[kk].x,
+                                                            h_pos.data[kk].y,
+                                                            h_pos.data[kk].z);
+                                unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
+                                assert(typek < m_pdata->getNTypes());
 
-                                // compute the bond angle (if needed)
-                                Scalar cos_th = Scalar(0.0);
-                                if (evaluator::needsAngle())
-                                    cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
+                                // access the type pair parameters for i and k
+                                typpair_idx = m_typpair_idx(typei, typek);
+                                param_type temp_param = h_params.data[typpair_idx];
 
-                                // set up the evaluator
-                                eval.setRik(rik_sq);
-                                if (evaluator::needsAngle())
-                                    eval.setAngle(cos_th);
+                                evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                                bool temp_evaluated = temp_eval.areInteractive();
 
-                                // compute the total force and energy
-                                Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
-                                Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
-                                eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
-
-                                // add the force to particle i
-                                // (FLOPS: 17)
-                                fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
-                                fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
-                                fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
-
-                                // NOTE: virial for ik forces not tested
-                                if (compute_virial)
+                                if (kk != jj && temp_evaluated)
                                     {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.x;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.x;
-                                    viriali_xx += force_div2r_ij * dxij.x * dxij.x
-                                                  + force_div2r_ik * dxik.x * dxik.x;
-                                    viriali_xy += force_div2r_ij * dxij.x * dxij.y
-                                                  + force_div2r_ik * dxik.x * dxik.y;
-                                    viriali_xz += force_div2r_ij * dxij.x * dxij.z
-                                                  + force_div2r_ik * dxik.x * dxik.z;
-                                    viriali_yy += force_div2r_ij * dxij.y * dxij.y
-                                                  + force_div2r_ik * dxik.y * dxik.y;
-                                    viriali_yz += force_div2r_ij * dxij.y * dxij.z
-                                                  + force_div2r_ik * dxik.y * dxik.z;
-                                    viriali_zz += force_div2r_ij * dxij.z * dxij.z
-                                                  + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-
-                                // add the force to particle j (FLOPS: 17)
-                                fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
-                                fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
-                                fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
-
-                                // NOTE: virial for ik forces not tested
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.y;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.y;
-                                    virialj_xx += force_div2r_ij * dxij.x * dxij.x
-                                                  + force_div2r_ik * dxik.x * dxik.x;
-                                    virialj_xy += force_div2r_ij * dxij.x * dxij.y
-                                                  + force_div2r_ik * dxik.x * dxik.y;
-                                    virialj_xz += force_div2r_ij * dxij.x * dxij.z
-                                                  + force_div2r_ik * dxik.x * dxik.z;
-                                    virialj_yy += force_div2r_ij * dxij.y * dxij.y
-                                                  + force_div2r_ik * dxik.y * dxik.y;
-                                    virialj_yz += force_div2r_ij * dxij.y * dxij.z
-                                                  + force_div2r_ik * dxik.y * dxik.z;
-                                    virialj_zz += force_div2r_ij * dxij.z * dxij.z
-                                                  + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-
-                                // add the force to particle k
-                                fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
-                                fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
-                                fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
-
-                                // increment the force for particle k
-                                unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
-
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
-                                    h_virial.data[0 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.x
-                                           + force_div2r_ik * dxik.x * dxik.x;
-                                    h_virial.data[1 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.y
-                                           + force_div2r_ik * dxik.x * dxik.y;
-                                    h_virial.data[2 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.z
-                                           + force_div2r_ik * dxik.x * dxik.z;
-                                    h_virial.data[3 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.y * dxij.y
-                                           + force_div2r_ik * dxik.y * dxik.y;
-                                    h_virial.data[4 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.y * dxij.z
-                                           + force_div2r_ik * dxik.y * dxik.z;
-                                    h_virial.data[5 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.z * dxij.z
-                                           + force_div2r_ik * dxik.z * dxik.z;
+                                    // create variable for the force on k
+                                    Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
+
+                                    // compute dr_ik
+                                    Scalar3 dxik = posi - posk;
+
+                                    // apply periodic boundary conditions
+                                    dxik = box.minImage(dxik);
+
+                                    // compute rik_sq
+                                    Scalar rik_sq = dot(dxik, dxik);
+
+                                    // compute the bond angle (if needed)
+                                    Scalar cos_th = Scalar(0.0);
+                                    if (evaluator::needsAngle())
+                                        cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
+
+                                    // set up the evaluator
+                                    eval.setRik(rik_sq);
+                                    if (evaluator::needsAngle())
+                                        eval.setAngle(cos_th);
+
+                                    // compute the total force and energy
+                                    Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
+                                    Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
+                                    eval.evalForceik(fR,
+                                                     fA,
+                                                     chi,
+                                                     bij,
+                                                     force_divr_ij,
+                                                     force_divr_ik);
+
+                                    // add the force to particle i
+                                    // (FLOPS: 17)
+                                    fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
+                                    fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
+                                    fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
+
+                                    // NOTE: virial for ik forces not tested
+                                    if (compute_virial)
+                                        {
+                                        Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.x;
+                                        Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.x;
+                                        viriali_xx += force_div2r_ij * dxij.x * dxij.x
+                                                      + force_div2r_ik * dxik.x * dxik.x;
+                                        viriali_xy += force_div2r_ij * dxij.x * dxij.y
+                                                      + force_div2r_ik * dxik.x * dxik.y;
+                                        viriali_xz += force_div2r_ij * dxij.x * dxij.z
+                                                      + force_div2r_ik * dxik.x * dxik.z;
+                                        viriali_yy += force_div2r_ij * dxij.y * dxij.y
+                                                      + force_div2r_ik * dxik.y * dxik.y;
+                                        viriali_yz += force_div2r_ij * dxij.y * dxij.z
+                                                      + force_div2r_ik * dxik.y * dxik.z;
+                                        viriali_zz += force_div2r_ij * dxij.z * dxij.z
+                                                      + force_div2r_ik * dxik.z * dxik.z;
+                                        }
+
+                                    // add the force to particle j (FLOPS: 17)
+                                    fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
+                                    fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
+                                    fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
+
+                                    // NOTE: virial for ik forces not tested
+                                    if (compute_virial)
+                                        {
+                                        Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.y;
+                                        Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.y;
+                                        virialj_xx += force_div2r_ij * dxij.x * dxij.x
+                                                      + force_div2r_ik * dxik.x * dxik.x;
+                                        virialj_xy += force_div2r_ij * dxij.x * dxij.y
+                                                      + force_div2r_ik * dxik.x * dxik.y;
+                                        virialj_xz += force_div2r_ij * dxij.x * dxij.z
+                                                      + force_div2r_ik * dxik.x * dxik.z;
+                                        virialj_yy += force_div2r_ij * dxij.y * dxij.y
+                                                      + force_div2r_ik * dxik.y * dxik.y;
+                                        virialj_yz += force_div2r_ij * dxij.y * dxij.z
+                                                      + force_div2r_ik * dxik.y * dxik.z;
+                                        virialj_zz += force_div2r_ij * dxij.z * dxij.z
+                                                      + force_div2r_ik * dxik.z * dxik.z;
+                                        }
+
+                                    // add the force to particle k
+                                    fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
+                                    fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
+                                    fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
+
+                                    // increment the force for particle k
+                                    unsigned int mem_idx = kk;
+                                    force[mem_idx].x += fk.x;
+                                    force[mem_idx].y += fk.y;
+                                    force[mem_idx].z += fk.z;
+
+                                    if (compute_virial)
+                                        {
+                                        Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
+                                        Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
+                                        virial[0 * virial_pitch + mem_idx]
+                                            += force_div2r_ij * dxij.x * dxij.x
+                                               + force_div2r_ik * dxik.x * dxik.x;
+                                        virial[1 * virial_pitch + mem_idx]
+                                            += force_div2r_ij * dxij.x * dxij.y
+                                               + force_div2r_ik * dxik.x * dxik.y;
+                                        virial[2 * virial_pitch + mem_idx]
+                                            += force_div2r_ij * dxij.x * dxij.z
+                                               + force_div2r_ik * dxik.x * dxik.z;
+                                        virial[3 * virial_pitch + mem_idx]
+                                            += force_div2r_ij * dxij.y * dxij.y
+                                               + force_div2r_ik * dxik.y * dxik.y;
+                                        virial[4 * virial_pitch + mem_idx]
+                                            += force_div2r_ij * dxij.y * dxij.z
+                                               + force_div2r_ik * dxik.y * dxik.z;
+                                        virial[5 * virial_pitch + mem_idx]
+                                            += force_div2r_ij * dxij.z * dxij.z
+                                               + force_div2r_ik * dxik.z * dxik.z;
+                                        }
                                     }
                                 }
                             }
                         }
+                    // increment the force and potential energy for particle j
+                    unsigned int mem_idx = jj;
+                    force[mem_idx].x += fj.x;
+                    force[mem_idx].y += fj.y;
+                    force[mem_idx].z += fj.z;
+                    force[mem_idx].w += pej;
+
+                    if (compute_virial)
+                        {
+                        virial[0 * virial_pitch + mem_idx] += virialj_xx;
+                        virial[1 * virial_pitch + mem_idx] += virialj_xy;
+                        virial[2 * virial_pitch + mem_idx] += virialj_xz;
+                        virial[3 * virial_pitch + mem_idx] += virialj_yy;
+                        virial[4 * virial_pitch + mem_idx] += virialj_yz;
+                        virial[5 * virial_pitch + mem_idx] += virialj_zz;
+                        }
                     }
-                // increment the force and potential energy for particle j
-                unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
+                // finally, increment the force and potential energy for particle i
+                unsigned int mem_idx = i;
+                force[mem_idx].x += fi.x;
+                force[mem_idx].y += fi.y;
+                force[mem_idx].z += fi.z;
+                force[mem_idx].w += pei;
 
                 if (compute_virial)
                     {
-                    h_virial.data[0 * m_virial_pitch + mem_idx] += virialj_xx;
-                    h_virial.data[1 * m_virial_pitch + mem_idx] += virialj_xy;
-                    h_virial.data[2 * m_virial_pitch + mem_idx] += virialj_xz;
-                    h_virial.data[3 * m_virial_pitch + mem_idx] += virialj_yy;
-                    h_virial.data[4 * m_virial_pitch + mem_idx] += virialj_yz;
-                    h_virial.data[5 * m_virial_pitch + mem_idx] += virialj_zz;
+                    virial[0 * virial_pitch + mem_idx] += viriali_xx;
+                    virial[1 * virial_pitch + mem_idx] += viriali_xy;
+                    virial[2 * virial_pitch + mem_idx] += viriali_xz;
+                    virial[3 * virial_pitch + mem_idx] += viriali_yy;
+                    virial[4 * virial_pitch + mem_idx] += viriali_yz;
+                    virial[5 * virial_pitch + mem_idx] += viriali_zz;
                     }
                 }
-            // finally, increment the force and potential energy for particle i
-            unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
-
-            if (compute_virial)
-                {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += viriali_xx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += viriali_xy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += viriali_xz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += viriali_yy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += viriali_yz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += viriali_zz;
-                }
-            }
+        };
+
+        computeChunks(compute_range, h_force.data, h_virial.data, compute_virial);
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param compute_range Kernel that computes the forces on particles [first, last) and adds the
+        forces and virials on i, j, and k to the given arrays
+    \param h_force Force array to add the forces to (zeroed by the caller)
+    \param h_virial Virial array to add the virials to (zeroed by the caller)
+    \param compute_virial Whether the kernel computes the virial
+
+    With TBB, the local particles are split into one chunk per thread. Each chunk adds the forces
+    on i and its neighbors to a private accumulator, which are summed in chunk order so that the
+    result does not depend on the thread scheduling.
+*/
+template<class evaluator>
+template<class Kernel>
+void PotentialTersoff<evaluator>::computeChunks(const Kernel& compute_range,
+                                                Scalar4* h_force,
+                                                Scalar* h_virial,
+                                                bool compute_virial)
+    {
+    const unsigned int N = m_pdata->getN();
+
+#ifdef ENABLE_TBB
+    const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), N);
+    if (n_chunks > 1)
+        {
+        const unsigned int n_all = N + m_pdata->getNGhosts();
+        const unsigned int chunk_size = (N + n_chunks - 1) / n_chunks;
+
+        m_chunk_force.assign(size_t(n_chunks) * n_all, make_scalar4(0, 0, 0, 0));
+        if (compute_virial)
+            m_chunk_virial.assign(size_t(n_chunks) * 6 * n_all, Scalar(0.0));
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int chunk = r.begin(); chunk != r.end(); ++chunk)
+                            {
+                            unsigned int first = chunk * chunk_size;
+                            unsigned int last = std::min(first + chunk_size, N);
+                            compute_range(first,
+                                          last,
+                                          m_chunk_force.data() + size_t(chunk) * n_all,
+                                          compute_virial
+                                              ? m_chunk_virial.data() + size_t(chunk) * 6 * n_all
+                                              : nullptr,
+                                          n_all);
+                            }
+                    },
+                    tbb::simple_partitioner());
+
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_all),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          {
+                                          for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+                                              {
+                                              const Scalar4& f
+                                                  = m_chunk_force[size_t(chunk) * n_all + i];
+                                              h_force[i].x += f.x;
+                                              h_force[i].y += f.y;
+                                              h_force[i].z += f.z;
+                                              h_force[i].w += f.w;
+
+                                              if (compute_virial)
+                                                  {
+                                                  const Scalar* v = m_chunk_virial.data()
+                                                                    + size_t(chunk) * 6 * n_all;
+                                                  for (unsigned int k = 0; k < 6; ++k)
+                                                      h_virial[k * m_virial_pitch + i]
+                                                          += v[k * n_all + i];
+                                                  }
+                                              }
+                                          }
+                                  });
+            });
+        return;
+        }
+#endif
+
+    compute_range(0, N, h_force, h_virial, m_virial_pitch);
+    }
+
 #ifdef ENABLE_MPI
 /*! \param timestep Current time step
  */
@@ -26,6 +26,9 @@ const int gpu_tersoff_max_tpp = 32;
 const int gpu_tersoff_max_tpp = 64;
 #endif
 
+//! Number of neighbors of each particle whose separations are cached in shared memory
+const unsigned int gpu_tersoff_neighbor_cache_size = 16;
+
 //! Wraps arguments to gpu_cgpf
 struct tersoff_args_t
     {
@@ -129,6 +132,82 @@ inline __device__ float myAtomicAdd(float* address, float val)
     }
 #endif
 
+//! Synchronize the tpp threads that compute the forces on one particle
+/*! The threads of one particle are in the same warp. They exit the kernel together, so the mask
+    only includes the threads of the calling group.
+*/
+template<int tpp> __device__ inline void gpu_tersoff_sync_group()
+    {
+#if defined(__HIP_PLATFORM_NVCC__)
+    const unsigned int lane = threadIdx.x % 32;
+    const unsigned int mask
+        = (tpp >= 32) ? 0xffffffffu : (((1u << tpp) - 1u) << (lane / tpp * tpp));
+    __syncwarp(mask);
+#else
+    // wavefronts execute in lockstep, only make the shared memory writes visible
+    __threadfence_block();
+#endif
+    }
+
+//! Load a neighbor of particle i from the neighbor cache or global memory
+/*! \param k Set to the index of the neighbor
+    \param neigh_idx Index of the neighbor in the neighbor list of i
+    \param n_cached Number of neighbors of i in the cache
+    \param s_nbr_dx Cached separations and types of the neighbors of i
+    \param s_nbr_idx Cached indices of the neighbors of i
+    \param d_nlist Neighbor list
+    \param head_idx Index of the first neighbor of i in \a d_nlist
+    \param d_pos Particle positions
+    \param posi Position of particle i
+    \param box Simulation box
+
+    \returns The minimum image of posi - posk in x, y, and z and the type of k in w
+*/
+__device__ inline Scalar4 gpu_tersoff_load_neighbor(unsigned int& k,
+                                                    unsigned int neigh_idx,
+                                                    unsigned int n_cached,
+                                                    const Scalar4* s_nbr_dx,
+                                                    const unsigned int* s_nbr_idx,
+                                                    const unsigned int* d_nlist,
+                                                    unsigned int head_idx,
+                                                    const Scalar4* d_pos,
+                                                    const Scalar3& posi,
+                                                    const BoxDim& box)
+    {
+    if (neigh_idx < n_cached)
+        {
+        k = s_nbr_idx[neigh_idx];
+        return s_nbr_dx[neigh_idx];
+        }
+
+    k = __ldg(d_nlist + head_idx + neigh_idx);
+    Scalar4 postypek = __ldg(d_pos + k);
+    Scalar3 dx = box.minImage(posi - make_scalar3(postypek.x, postypek.y, postypek.z));
+    return make_scalar4(dx.x, dx.y, dx.z, postypek.w);
+    }
+
+//! Size of the dynamic shared memory of gpu_compute_triplet_forces_kernel
+/*! \param param_size Size of the evaluator parameters
+    \param ntypes Number of particle types
+    \param block_size Number of threads in the block
+    \param tpp Number of threads per particle
+*/
+inline size_t gpu_tersoff_shared_bytes(size_t param_size,
+                                       unsigned int ntypes,
+                                       unsigned int block_size,
+                                       unsigned int tpp)
+    {
+    Index2D typpair_idx(ntypes);
+    size_t bytes = (sizeof(Scalar) + param_size) * typpair_idx.getNumElements()
+                   + ntypes * block_size * sizeof(Scalar);
+
+    // the neighbor cache is aligned for Scalar4 access
+    bytes = (bytes + sizeof(Scalar4) - 1) / sizeof(Scalar4) * sizeof(Scalar4);
+    bytes += size_t(block_size / tpp) * gpu_tersoff_neighbor_cache_size
+             * (sizeof(Scalar4) + sizeof(unsigned int));
+    return bytes;
+    }
+
 //! Kernel for calculating the Tersoff forces
 /*! This kernel is called to calculate the forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -148,8 +227,7 @@ inline __device__ float myAtomicAdd(float* address, float val)
     \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei,
    typej) to access the unique value for that type pair. These values are all cached into shared
    memory for quick access, so a dynamic amount of shared memory must be allocated for this kernel
-   launch. The amount is (2*sizeof(Scalar) + sizeof(typename evaluator::param_type)) *
-   typpair_idx.getNumElements()
+   launch. The amount is given by gpu_tersoff_shared_bytes().
 
     Certain options are controlled via template parameters to avoid the performance hit when they
    are not enabled. \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
@@ -158,6 +236,11 @@ inline __device__ float myAtomicAdd(float* address, float val)
     Each block will calculate the forces on a block of particles.
     Each thread will calculate the total force on one particle.
     The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+
+    Every thread of a particle loops over all neighbors k for each of its neighbors j. The threads
+    of a particle load the minimum image separations, types, and indices of its first
+    gpu_tersoff_neighbor_cache_size neighbors into shared memory once, so the three-body loops read
+    them from the cache instead of recomputing them from the positions for every j.
 */
 template<class evaluator, unsigned char compute_virial, int tpp>
 __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
@@ -184,6 +267,15 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
 
     Scalar* s_phi_ab = s_rcutsq + num_typ_parameters;
 
+    // per particle neighbor cache, aligned for Scalar4 access
+    size_t cache_offset = (char*)(s_phi_ab + ntypes * blockDim.x) - s_data;
+    cache_offset = (cache_offset + sizeof(Scalar4) - 1) / sizeof(Scalar4) * sizeof(Scalar4);
+    Scalar4* s_nbr_dx = (Scalar4*)(&s_data[cache_offset]);
+    unsigned int* s_nbr_idx
+        = (unsigned int*)(s_nbr_dx + (blockDim.x / tpp) * gpu_tersoff_neighbor_cache_size);
+    s_nbr_dx += (threadIdx.x / tpp) * gpu_tersoff_neighbor_cache_size;
+    s_nbr_idx += (threadIdx.x / tpp) * gpu_tersoff_neighbor_cache_size;
+
     // load in the per type pair parameters
     for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
         {
@@ -215,6 +307,24 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
     Scalar4 postypei = __ldg(d_pos + idx);
     Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
 
+    // cache the neighbors of i, each thread of the group loads a strided subset
+    const unsigned int n_cached = min(n_neigh, gpu_tersoff_neighbor_cache_size);
+    const unsigned int head_i = d_head_list[idx];
+    for (unsigned int m = threadIdx.x % tpp; m < n_cached; m += tpp)
+        {
+        s_nbr_dx[m] = gpu_tersoff_load_neighbor(s_nbr_idx[m],
+                                                m,
+                                                0,
+                                                s_nbr_dx,
+                                                s_nbr_idx,
+                                                d_nlist,
+                                                head_i,
+                                                d_pos,
+                                                posi,
+                                                box);
+        }
+    gpu_tersoff_sync_group<tpp>();
+
     // initialize the force to 0
     Scalar4 forcei = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
@@ -314,33 +424,33 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                     }
 
                 // now evaluate the force from the ik interactions
-                unsigned int cur_k = 0;
-                unsigned int next_k(0);
-
                 // loop over k neighbors one by one
                 for (int neigh_idy = 0; neigh_idy < n_neigh; neigh_idy++)
                     {
-                    // read the current neighbor index and prefetch the next one
-                    cur_k = next_k;
-                    next_k = __ldg(d_nlist + head_idx + neigh_idy + 1);
+                    // read the index, separation, and type of neighbor k
+                    unsigned int cur_k;
+                    const Scalar4 dxtypek = gpu_tersoff_load_neighbor(cur_k,
+                                                                      neigh_idy,
+                                                                      n_cached,
+                                                                      s_nbr_dx,
+                                                                      s_nbr_idx,
+                                                                      d_nlist,
+                                                                      head_idx,
+                                                                      d_pos,
+                                                                      posi,
+                                                                      box);
 
                     // I continue only if k is not the same as j
                     if ((cur_k > cur_j) && (cur_j > idx))
                         {
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
-
                         // get the type pair parameters for i and k
                         typpair
-                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(dxtypek.w));
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type temp_param = s_params[typpair];
 
-                        // compute rik
-                        Scalar3 dxik = posi - posk;
-                        // apply the periodic boundary conditions
-                        dxik = box.minImage(dxik);
+                        // separation of i and k
+                        Scalar3 dxik = make_scalar3(dxtypek.x, dxtypek.y, dxtypek.z);
                         // compute rik_sq
                         Scalar rik_sq = dot(dxik, dxik);
 
@@ -581,24 +691,25 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                 if (evaluator::needsChi())
                     {
                     // compute chi
-                    unsigned int cur_k = 0;
-                    unsigned int next_k(0);
-                    next_k = __ldg(d_nlist + head_idx);
-
                     // loop over neighbors one by one
                     for (int neigh_idy = 0; neigh_idy < n_neigh; neigh_idy++)
                         {
-                        // read the current index of k and prefetch the next one
-                        cur_k = next_k;
-                        next_k = __ldg(d_nlist + head_idx + neigh_idy + 1);
-
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
+                        // read the index, separation, and type of neighbor k
+                        unsigned int cur_k;
+                        const Scalar4 dxtypek = gpu_tersoff_load_neighbor(cur_k,
+                                                                          neigh_idy,
+                                                                          n_cached,
+                                                                          s_nbr_dx,
+                                                                          s_nbr_idx,
+                                                                          d_nlist,
+                                                                          head_idx,
+                                                                          d_pos,
+                                                                          posi,
+                                                                          box);
 
                         // get the type pair parameters for i and k
                         typpair
-                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(dxtypek.w));
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type temp_param = s_params[typpair];
 
@@ -607,11 +718,8 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
 
                         if (cur_k != cur_j && temp_evaluated)
                             {
-                            // compute rik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply the periodic boundary conditions
-                            dxik = box.minImage(dxik);
+                            // separation of i and k
+                            Scalar3 dxik = make_scalar3(dxtypek.x, dxtypek.y, dxtypek.z);
 
                             // compute rik_sq
                             Scalar rik_sq = dot(dxik, dxik);
@@ -681,24 +789,25 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                 if (evaluator::hasIkForce())
                     {
                     // now evaluate the force from the ik interactions
-                    unsigned int cur_k = 0;
-                    unsigned int next_k(0);
-                    next_k = __ldg(d_nlist + head_idx);
-
                     // loop over neighbors one by one
                     for (int neigh_idy = 0; neigh_idy < n_neigh; neigh_idy++)
                         {
-                        // read the current neighbor index and prefetch the next one
-                        cur_k = next_k;
-                        next_k = __ldg(d_nlist + head_idx + neigh_idy + 1);
-
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
+                        // read the index, separation, and type of neighbor k
+                        unsigned int cur_k;
+                        const Scalar4 dxtypek = gpu_tersoff_load_neighbor(cur_k,
+                                                                          neigh_idy,
+                                                                          n_cached,
+                                                                          s_nbr_dx,
+                                                                          s_nbr_idx,
+                                                                          d_nlist,
+                                                                          head_idx,
+                                                                          d_pos,
+                                                                          posi,
+                                                                          box);
 
                         // get the type pair parameters for i and k
                         typpair
-                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(dxtypek.w));
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type temp_param = s_params[typpair];
 
@@ -710,11 +819,8 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                             Scalar4 forcek
                                 = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
-                            // compute rik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply the periodic boundary conditions
-                            dxik = box.minImage(dxik);
+                            // separation of i and k
+                            Scalar3 dxik = make_scalar3(dxtypek.x, dxtypek.y, dxtypek.z);
 
                             // compute rik_sq
                             Scalar rik_sq = dot(dxik, dxik);
@@ -934,18 +1040,20 @@ template<class evaluator, unsigned int compute_virial, int tpp> struct TersoffCo
             int run_block_size = min(pair_args.block_size, max_block_size);
 
             // size shared bytes
-            Index2D typpair_idx(pair_args.ntypes);
-            size_t shared_bytes = (sizeof(Scalar) + sizeof(typename evaluator::param_type))
-                                      * typpair_idx.getNumElements()
-                                  + pair_args.ntypes * run_block_size * sizeof(Scalar);
+            size_t shared_bytes
+                = gpu_tersoff_shared_bytes(sizeof(typename evaluator::param_type),
+                                           pair_args.ntypes,
+                                           run_block_size,
+                                           pair_args.tpp);
 
             while (shared_bytes + kernel_shared_bytes >= pair_args.devprop.sharedMemPerBlock)
                 {
                 run_block_size -= pair_args.devprop.warpSize;
 
-                shared_bytes = (sizeof(Scalar) + sizeof(typename evaluator::param_type))
-                                   * typpair_idx.getNumElements()
-                               + pair_args.ntypes * run_block_size * sizeof(Scalar);
+                shared_bytes = gpu_tersoff_shared_bytes(sizeof(typename evaluator::param_type),
+                                                        pair_args.ntypes,
+                                                        run_block_size,
+                                                        pair_args.tpp);
                 }
 
             // zero the forces
@@ -0,0 +1,203 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ReplicaExchangeUpdater.cc
+    \brief Defines the ReplicaExchangeUpdater class
+*/
+
+#include "ReplicaExchangeUpdater.h"
+#include "TwoStepLangevinBase.h"
+#include "TwoStepNVTMTK.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/Variant.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+using namespace hoomd;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param method Integration method that sets the temperature of the replica
+*/
+ReplicaExchangeUpdater::ReplicaExchangeUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                                               std::shared_ptr<IntegrationMethodTwoStep> method)
+    : Updater(sysdef), m_method(method)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ReplicaExchangeUpdater" << endl;
+
+    // validate the method
+    getMethodT();
+
+#ifdef ENABLE_MPI
+    auto mpi_conf = m_exec_conf->getMPIConfig();
+    MPI_Comm_split(mpi_conf->getHOOMDWorldCommunicator(),
+                   mpi_conf->getRank(),
+                   mpi_conf->getPartition(),
+                   &m_partition_comm);
+#endif
+    }
+
+ReplicaExchangeUpdater::~ReplicaExchangeUpdater()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ReplicaExchangeUpdater" << endl;
+
+#ifdef ENABLE_MPI
+    MPI_Comm_free(&m_partition_comm);
+#endif
+    }
+
+std::shared_ptr<Variant> ReplicaExchangeUpdater::getMethodT()
+    {
+    if (auto nvt = std::dynamic_pointer_cast<TwoStepNVTMTK>(m_method))
+        return nvt->getT();
+    if (auto langevin = std::dynamic_pointer_cast<TwoStepLangevinBase>(m_method))
+        return langevin->getT();
+
+    throw std::invalid_argument("ReplicaExchange requires an NVT, Langevin, or Brownian method.");
+    }
+
+/*! \param T New temperature of the method
+ */
+void ReplicaExchangeUpdater::setMethodT(std::shared_ptr<Variant> T)
+    {
+    if (auto nvt = std::dynamic_pointer_cast<TwoStepNVTMTK>(m_method))
+        nvt->setT(T);
+    else if (auto langevin = std::dynamic_pointer_cast<TwoStepLangevinBase>(m_method))
+        langevin->setT(T);
+    }
+
+/*! \returns The potential energy of all particles in the partition
+ */
+Scalar ReplicaExchangeUpdater::computeEnergy()
+    {
+    double energy = 0.0;
+        {
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            energy += (double)h_net_force.data[i].w;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &energy,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    energy += m_pdata->getExternalEnergy();
+    return Scalar(energy);
+    }
+
+/*! \param factor Factor to scale the velocities by
+ */
+void ReplicaExchangeUpdater::scaleVelocities(Scalar factor)
+    {
+    std::shared_ptr<ParticleGroup> group = m_method->getGroup();
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    for (unsigned int group_idx = 0; group_idx < group->getNumMembers(); group_idx++)
+        {
+        unsigned int j = group->getMemberIndex(group_idx);
+        h_vel.data[j].x *= factor;
+        h_vel.data[j].y *= factor;
+        h_vel.data[j].z *= factor;
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void ReplicaExchangeUpdater::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    if (m_prof)
+        m_prof->push("ReplicaExchange");
+
+    m_energy = computeEnergy();
+
+#ifdef ENABLE_MPI
+    auto mpi_conf = m_exec_conf->getMPIConfig();
+    const int partition = mpi_conf->getPartition();
+    const int n_partitions = mpi_conf->getNPartitions();
+
+    // pair 0-1, 2-3, ... on even sweeps and 1-2, 3-4, ... on odd sweeps
+    const bool lower = (partition + m_n_sweeps) % 2 == 0;
+    const int partner = lower ? partition + 1 : partition - 1;
+    m_n_sweeps++;
+
+    if (partner >= 0 && partner < n_partitions)
+        {
+        const Scalar kT = (*getMethodT())(timestep);
+
+        Scalar mine[2] = {m_energy, kT};
+        Scalar theirs[2];
+        MPI_Sendrecv(mine,
+                     2,
+                     MPI_HOOMD_SCALAR,
+                     partner,
+                     0,
+                     theirs,
+                     2,
+                     MPI_HOOMD_SCALAR,
+                     partner,
+                     0,
+                     m_partition_comm,
+                     MPI_STATUS_IGNORE);
+
+        int accept = 0;
+        if (lower)
+            {
+            double delta
+                = (1.0 / double(kT) - 1.0 / double(theirs[1])) * double(m_energy - theirs[0]);
+            RandomGenerator rng(Seed(RNGIdentifier::ReplicaExchangeUpdater,
+                                     timestep,
+                                     m_sysdef->getSeed()),
+                                Counter(partition));
+            accept = delta >= 0.0 || UniformDistribution<double>()(rng) < exp(delta);
+            MPI_Send(&accept, 1, MPI_INT, partner, 1, m_partition_comm);
+            }
+        else
+            {
+            MPI_Recv(&accept, 1, MPI_INT, partner, 1, m_partition_comm, MPI_STATUS_IGNORE);
+            }
+
+        m_n_attempted++;
+        if (accept)
+            {
+            m_n_accepted++;
+            setMethodT(std::make_shared<VariantConstant>(theirs[1]));
+            scaleVelocities(sqrt(theirs[1] / kT));
+            }
+        }
+#endif
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_ReplicaExchangeUpdater(py::module& m)
+    {
+    py::class_<ReplicaExchangeUpdater, Updater, std::shared_ptr<ReplicaExchangeUpdater>>(
+        m,
+        "ReplicaExchangeUpdater")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<IntegrationMethodTwoStep>>())
+        .def_property_readonly("counts", &ReplicaExchangeUpdater::getCounts)
+        .def_property_readonly("energy", &ReplicaExchangeUpdater::getEnergy);
+    }
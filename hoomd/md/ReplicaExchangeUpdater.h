@@ -0,0 +1,92 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ReplicaExchangeUpdater.h
+    \brief Declares an updater that exchanges temperatures between MPI partitions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "IntegrationMethodTwoStep.h"
+#include "hoomd/Updater.h"
+#include "hoomd/Variant.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <utility>
+
+#pragma once
+
+/// Exchanges the temperatures of replicas that run in different MPI partitions
+/** Each partition of the HOOMD world communicator (see MPIConfiguration::splitPartitions()) runs
+ * one replica, thermostatted by an NVT or Langevin integration method. Each time the updater is
+ * triggered, it attempts to swap the temperatures of pairs of neighboring partitions (0 and 1, 2
+ * and 3, ...) and alternates with the other pairs (1 and 2, 3 and 4, ...) on the next attempt. The
+ * swap of the replicas i and j is accepted with probability
+ * min(1, exp((1/kT_i - 1/kT_j) (U_i - U_j))), where U is the potential energy of the replica.
+ *
+ * Only the potential energies and the temperatures go through the communicator that connects the
+ * ranks with the same rank in each partition. The coordinates stay in place. When a swap is
+ * accepted, the method's temperature is replaced by the constant temperature of the other replica
+ * and the velocities of its group are scaled by sqrt(kT_new / kT_old).
+ *
+ * The lower partition of each pair decides, using the timestep, the seed of its simulation, and
+ * its partition index for the random number, and sends the decision to the upper partition.
+ *
+ * All partitions must attach the updater with the same trigger, because the constructor and each
+ * exchange attempt communicate with the other partitions.
+ */
+class PYBIND11_EXPORT ReplicaExchangeUpdater : public Updater
+    {
+    public:
+    /// Constructor
+    ReplicaExchangeUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                           std::shared_ptr<IntegrationMethodTwoStep> method);
+
+    /// Destructor
+    virtual ~ReplicaExchangeUpdater();
+
+    /// Attempt to exchange temperatures with a neighboring partition
+    virtual void update(uint64_t timestep);
+
+    /// Get the number of accepted and rejected exchanges of this partition
+    std::pair<unsigned int, unsigned int> getCounts()
+        {
+        return std::make_pair(m_n_accepted, m_n_attempted - m_n_accepted);
+        }
+
+    /// Get the potential energy of the replica at the last exchange attempt
+    Scalar getEnergy()
+        {
+        return m_energy;
+        }
+
+    protected:
+    std::shared_ptr<IntegrationMethodTwoStep> m_method; //!< Thermostatted integration method
+    unsigned int m_n_sweeps = 0;                        //!< Number of exchange attempts so far
+    unsigned int m_n_attempted = 0;                     //!< Exchanges attempted by this partition
+    unsigned int m_n_accepted = 0;                      //!< Exchanges accepted by this partition
+    Scalar m_energy = 0;                                //!< Potential energy at the last attempt
+
+#ifdef ENABLE_MPI
+    /// Ranks with the same rank in each partition, ordered by partition
+    MPI_Comm m_partition_comm;
+#endif
+
+    /// Get the temperature variant of the method
+    std::shared_ptr<Variant> getMethodT();
+
+    /// Set the temperature variant of the method
+    void setMethodT(std::shared_ptr<Variant> T);
+
+    /// Compute the potential energy of the replica
+    Scalar computeEnergy();
+
+    /// Scale the velocities of the method's group
+    void scaleVelocities(Scalar factor);
+    };
+
+/// Export the ReplicaExchangeUpdater to python
+void export_ReplicaExchangeUpdater(pybind11::module& m);
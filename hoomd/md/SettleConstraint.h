@@ -0,0 +1,200 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __SETTLE_CONSTRAINT_H__
+#define __SETTLE_CONSTRAINT_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+/*! \file SettleConstraint.h
+    \brief Defines the SettleConstraint class
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Analytic position and velocity constraints for rigid three site molecules
+/*! SettleConstraint holds the geometry of a rigid molecule with sites A, B, and C, where B and C
+    have the same mass and the same distance to A (e.g. the O, H, and H sites of a water model).
+
+    positions() implements SETTLE (Miyamoto and Kollman 1992). Given the constrained positions at
+    the start of the step and unconstrained displacements over the step, it replaces the
+    displacements with the ones that restore all three distances while keeping the center of mass
+    displacement and applying the constraint forces along the old bond vectors. velocities()
+    implements the velocity half of RATTLE: it removes the velocity components along the three bonds
+    by solving the 3x3 system for the constraint impulses directly.
+
+    Both operate on positions relative to site A, so the caller applies the minimum image
+    convention once per molecule.
+*/
+class SettleConstraint
+    {
+    public:
+    //! Construct the constraint
+    /*! \param m_A Mass of site A
+        \param m_B Mass of sites B and C
+        \param d_AB Distance between A and B (and A and C)
+        \param d_BC Distance between B and C
+    */
+    HOSTDEVICE SettleConstraint(Scalar m_A, Scalar m_B, Scalar d_AB, Scalar d_BC)
+        : inv_m_A(Scalar(1.0) / m_A), inv_m_B(Scalar(1.0) / m_B)
+        {
+        // canonical geometry: the center of mass at the origin, A on the +y axis, and B and C at
+        // -x and +x below it
+        Scalar total_mass = m_A + Scalar(2.0) * m_B;
+        Scalar height = fast::sqrt(d_AB * d_AB - Scalar(0.25) * d_BC * d_BC);
+        ra = Scalar(2.0) * m_B * height / total_mass;
+        rb = height - ra;
+        rc = Scalar(0.5) * d_BC;
+        w_A = m_A / total_mass;
+        w_B = m_B / total_mass;
+        }
+
+    //! Constrain the displacements of one molecule
+    /*! \param b0 Position of B relative to A at the start of the step (constrained)
+        \param c0 Position of C relative to A at the start of the step (constrained)
+        \param dA Unconstrained displacement of A, replaced with the constrained displacement
+        \param dB Unconstrained displacement of B, replaced with the constrained displacement
+        \param dC Unconstrained displacement of C, replaced with the constrained displacement
+        \returns false when the displacements are too large to constrain, true otherwise
+    */
+    HOSTDEVICE bool positions(const vec3<Scalar>& b0,
+                              const vec3<Scalar>& c0,
+                              vec3<Scalar>& dA,
+                              vec3<Scalar>& dB,
+                              vec3<Scalar>& dC) const
+        {
+        // unconstrained positions relative to their center of mass
+        vec3<Scalar> com = w_A * dA + w_B * (b0 + dB) + w_B * (c0 + dC);
+        vec3<Scalar> a1 = dA - com;
+        vec3<Scalar> b1 = b0 + dB - com;
+        vec3<Scalar> c1 = c0 + dC - com;
+
+        // frame with z normal to the old plane and x normal to z and the new position of A
+        vec3<Scalar> ez = cross(b0, c0);
+        vec3<Scalar> ex = cross(a1, ez);
+        vec3<Scalar> ey = cross(ez, ex);
+        ex *= fast::rsqrt(dot(ex, ex));
+        ey *= fast::rsqrt(dot(ey, ey));
+        ez *= fast::rsqrt(dot(ez, ez));
+
+        Scalar xb0 = dot(ex, b0);
+        Scalar yb0 = dot(ey, b0);
+        Scalar xc0 = dot(ex, c0);
+        Scalar yc0 = dot(ey, c0);
+        Scalar za1 = dot(ez, a1);
+        Scalar xb1 = dot(ex, b1);
+        Scalar yb1 = dot(ey, b1);
+        Scalar zb1 = dot(ez, b1);
+        Scalar xc1 = dot(ex, c1);
+        Scalar yc1 = dot(ey, c1);
+        Scalar zc1 = dot(ez, c1);
+
+        // rotate the canonical molecule about x and y so the z coordinates match the new positions
+        Scalar sinphi = za1 / ra;
+        Scalar tmp = Scalar(1.0) - sinphi * sinphi;
+        if (tmp <= Scalar(0.0))
+            return false;
+        Scalar cosphi = fast::sqrt(tmp);
+
+        Scalar sinpsi = (zb1 - zc1) / (Scalar(2.0) * rc * cosphi);
+        tmp = Scalar(1.0) - sinpsi * sinpsi;
+        if (tmp <= Scalar(0.0))
+            return false;
+        Scalar cospsi = fast::sqrt(tmp);
+
+        Scalar ya2 = ra * cosphi;
+        Scalar xb2 = -rc * cospsi;
+        Scalar yb2 = -rb * cosphi - rc * sinpsi * sinphi;
+        Scalar yc2 = -rb * cosphi + rc * sinpsi * sinphi;
+
+        // rotate about z so the constraint forces lie along the old bonds
+        Scalar alpha = xb2 * (xb0 - xc0) + yb0 * yb2 + yc0 * yc2;
+        Scalar beta = xb2 * (yc0 - yb0) + xb0 * yb2 + xc0 * yc2;
+        Scalar gamma = xb0 * yb1 - xb1 * yb0 + xc0 * yc1 - xc1 * yc0;
+        Scalar alpha2_beta2 = alpha * alpha + beta * beta;
+        tmp = alpha2_beta2 - gamma * gamma;
+        if (tmp <= Scalar(0.0))
+            return false;
+        Scalar sintheta = (alpha * gamma - beta * fast::sqrt(tmp)) / alpha2_beta2;
+        Scalar costheta = fast::sqrt(Scalar(1.0) - sintheta * sintheta);
+
+        vec3<Scalar> a3 = -ya2 * sintheta * ex + ya2 * costheta * ey + za1 * ez;
+        vec3<Scalar> b3 = (xb2 * costheta - yb2 * sintheta) * ex
+                          + (xb2 * sintheta + yb2 * costheta) * ey + zb1 * ez;
+        vec3<Scalar> c3 = (-xb2 * costheta - yc2 * sintheta) * ex
+                          + (-xb2 * sintheta + yc2 * costheta) * ey + zc1 * ez;
+
+        dA = a3 + com;
+        dB = b3 + com - b0;
+        dC = c3 + com - c0;
+        return true;
+        }
+
+    //! Remove the velocity components along the bonds of one molecule
+    /*! \param b Position of B relative to A (constrained)
+        \param c Position of C relative to A (constrained)
+        \param vA Velocity of A
+        \param vB Velocity of B
+        \param vC Velocity of C
+    */
+    HOSTDEVICE void velocities(const vec3<Scalar>& b,
+                               const vec3<Scalar>& c,
+                               vec3<Scalar>& vA,
+                               vec3<Scalar>& vB,
+                               vec3<Scalar>& vC) const
+        {
+        // bonds AB, BC, and CA, the impulse g_k on bond r_j - r_i adds -g_k r_k / m_i to v_i and
+        // g_k r_k / m_j to v_j
+        vec3<Scalar> r0 = b;
+        vec3<Scalar> r1 = c - b;
+        vec3<Scalar> r2 = -c;
+
+        Scalar m00 = (inv_m_A + inv_m_B) * dot(r0, r0);
+        Scalar m11 = Scalar(2.0) * inv_m_B * dot(r1, r1);
+        Scalar m22 = (inv_m_A + inv_m_B) * dot(r2, r2);
+        Scalar m01 = -inv_m_B * dot(r0, r1);
+        Scalar m02 = -inv_m_A * dot(r0, r2);
+        Scalar m12 = -inv_m_B * dot(r1, r2);
+
+        Scalar rhs0 = -dot(r0, vB - vA);
+        Scalar rhs1 = -dot(r1, vC - vB);
+        Scalar rhs2 = -dot(r2, vA - vC);
+
+        // solve the symmetric system with Cramer's rule
+        Scalar c00 = m11 * m22 - m12 * m12;
+        Scalar c01 = m02 * m12 - m01 * m22;
+        Scalar c02 = m01 * m12 - m02 * m11;
+        Scalar inv_det = Scalar(1.0) / (m00 * c00 + m01 * c01 + m02 * c02);
+
+        Scalar g0 = (rhs0 * c00 + rhs1 * c01 + rhs2 * c02) * inv_det;
+        Scalar g1 = (rhs0 * c01 + rhs1 * (m00 * m22 - m02 * m02) + rhs2 * (m01 * m02 - m00 * m12))
+                    * inv_det;
+        Scalar g2 = (rhs0 * c02 + rhs1 * (m01 * m02 - m00 * m12) + rhs2 * (m00 * m11 - m01 * m01))
+                    * inv_det;
+
+        vA += inv_m_A * (g2 * r2 - g0 * r0);
+        vB += inv_m_B * (g0 * r0 - g1 * r1);
+        vC += inv_m_B * (g1 * r1 - g2 * r2);
+        }
+
+    private:
+    Scalar inv_m_A; //!< Inverse mass of site A
+    Scalar inv_m_B; //!< Inverse mass of sites B and C
+    Scalar w_A;     //!< Mass fraction of site A
+    Scalar w_B;     //!< Mass fraction of site B
+    Scalar ra;      //!< Distance from the center of mass to A in the canonical geometry
+    Scalar rb;      //!< Distance from the center of mass to the BC bond in the canonical geometry
+    Scalar rc;      //!< Half the BC distance
+    };
+
+#undef HOSTDEVICE
+
+#endif // __SETTLE_CONSTRAINT_H__
@@ -0,0 +1,111 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __SPARSE_FORCE_ACCUMULATOR_H__
+#define __SPARSE_FORCE_ACCUMULATOR_H__
+
+#include "hoomd/HOOMDMath.h"
+
+#include <vector>
+
+/*! \file SparseForceAccumulator.h
+    \brief Declares SparseForceAccumulator
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Accumulate forces and virials on the particles touched by one thread
+/*! A thread that adds third law forces to arbitrary particles j needs its own buffer, but a dense
+    buffer over all N particles per thread makes every step zero and sum O(threads * N) values.
+    SparseForceAccumulator divides the particle indices into pages of page_size particles and
+    allocates a page, zeroed, the first time a force is added to one of its particles. Particles
+    sorted along a space filling curve keep the neighbors of a contiguous range of particles on a
+    few pages, so a thread zeroes and sums roughly the particles it touches.
+
+    The buffers persist between calls to reset() to avoid reallocating them every step.
+*/
+class SparseForceAccumulator
+    {
+    public:
+    /// log2 of the number of particles per page
+    static const unsigned int page_bits = 9;
+
+    /// Number of particles per page, also the pitch of the virial of a page
+    static const unsigned int page_size = 1u << page_bits;
+
+    //! Release all pages
+    /*! \param N Number of particles that forces may be added to
+        \param compute_virial Set to false to skip the virial buffers
+    */
+    void reset(unsigned int N, bool compute_virial)
+        {
+        m_page_slot.assign((N + page_size - 1) >> page_bits, (unsigned int)no_slot);
+        m_force.clear();
+        m_virial.clear();
+        m_compute_virial = compute_virial;
+        }
+
+    //! Get the number of pages covering the particles
+    unsigned int getNumPages() const
+        {
+        return (unsigned int)m_page_slot.size();
+        }
+
+    //! Get the accumulators of particle j, allocating its page if needed
+    /*! \param j Particle index
+        \param force Set to the force accumulator of j
+        \param virial Set to the first virial component of j, with pitch page_size
+    */
+    void locate(unsigned int j, Scalar4*& force, Scalar*& virial)
+        {
+        unsigned int& slot = m_page_slot[j >> page_bits];
+        if (slot == no_slot)
+            {
+            slot = (unsigned int)(m_force.size() >> page_bits);
+            m_force.resize(m_force.size() + page_size, make_scalar4(0, 0, 0, 0));
+            if (m_compute_virial)
+                m_virial.resize(m_virial.size() + 6 * page_size, Scalar(0.0));
+            }
+
+        const unsigned int offset = j & (page_size - 1);
+        force = m_force.data() + (size_t(slot) << page_bits) + offset;
+        virial = m_compute_virial ? m_virial.data() + size_t(slot) * 6 * page_size + offset
+                                  : nullptr;
+        }
+
+    //! Get the forces of a page, or nullptr if no force was added to it
+    const Scalar4* getPageForces(unsigned int page) const
+        {
+        const unsigned int slot = m_page_slot[page];
+        return slot == no_slot ? nullptr : m_force.data() + (size_t(slot) << page_bits);
+        }
+
+    //! Get the virials of a page with pitch page_size, or nullptr if no force was added to it
+    const Scalar* getPageVirials(unsigned int page) const
+        {
+        const unsigned int slot = m_page_slot[page];
+        return (slot == no_slot || !m_compute_virial)
+                   ? nullptr
+                   : m_virial.data() + size_t(slot) * 6 * page_size;
+        }
+
+    private:
+    /// Marks a page that has not been allocated
+    static const unsigned int no_slot = 0xffffffff;
+
+    /// Slot of each page in the buffers
+    std::vector<unsigned int> m_page_slot;
+
+    /// Forces of the allocated pages
+    std::vector<Scalar4> m_force;
+
+    /// Virials of the allocated pages (6 * page_size per page)
+    std::vector<Scalar> m_virial;
+
+    /// True when virials are accumulated
+    bool m_compute_virial = false;
+    };
+
+#endif // __SPARSE_FORCE_ACCUMULATOR_H__
@@ -3,6 +3,7 @@
 
 // Maintainer: phillicl
 
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
@@ -79,8 +80,9 @@ class PYBIND11_EXPORT TableAngleForceCompute : public ForceCompute
 
     protected:
     std::shared_ptr<AngleData> m_angle_data; //!< Angle data to use in computing angles
+    BondedForceChunks m_chunks;              //!< Per-thread force buffers
     unsigned int m_table_width;              //!< Width of the tables in memory
-    GPUArray<Scalar2> m_tables;              //!< Stored V and T tables
+    GPUArray<Scalar4> m_tables;              //!< V, T, and their increments to the next entry
     Index2D m_table_value;                   //!< Index table helper
 
     //! Actually compute the forces
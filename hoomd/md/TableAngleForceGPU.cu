@@ -46,7 +46,7 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
                                                       const unsigned int* apos_list,
                                                       const unsigned int pitch,
                                                       const unsigned int* n_angles_list,
-                                                      const Scalar2* d_tables,
+                                                      const Scalar4* d_tables,
                                                       const Index2D table_value,
                                                       const Scalar delta_th)
     {
@@ -84,10 +84,10 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
         int cur_angle_abc = apos_list[pitch * angle_idx + idx];
 
         // get the a-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 x_postype = d_pos[cur_angle_x_idx];
+        Scalar4 x_postype = __ldg(d_pos + cur_angle_x_idx);
         Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
         // get the c-particle's position (MEM TRANSFER: 16 bytes)
-        Scalar4 y_postype = d_pos[cur_angle_y_idx];
+        Scalar4 y_postype = __ldg(d_pos + cur_angle_y_idx);
         Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
 
         if (cur_angle_abc == 0)
@@ -145,20 +145,15 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
 
         // compute index into the table and read in values
         unsigned int value_i = value_f;
-        Scalar2 VT0 = __ldg(d_tables + table_value(value_i, cur_angle_type));
-        Scalar2 VT1 = __ldg(d_tables + table_value(value_i + 1, cur_angle_type));
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
+        // one load reads the values at value_i and the increments to value_i + 1
+        Scalar4 entry = __ldg(d_tables + table_value(value_i, cur_angle_type));
 
         // compute the linear interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
         // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V = entry.x + f * entry.z;
+        Scalar T = entry.y + f * entry.w;
 
         Scalar a = T * s_abbc;
         Scalar a11 = a * c_abbc / rsqab;
@@ -245,7 +240,7 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           const unsigned int* apos_list,
                                           const unsigned int pitch,
                                           const unsigned int* n_angles_list,
-                                          const Scalar2* d_tables,
+                                          const Scalar4* d_tables,
                                           const unsigned int table_width,
                                           const Index2D& table_value,
                                           const unsigned int block_size)
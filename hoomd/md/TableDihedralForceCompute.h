@@ -3,6 +3,7 @@
 
 // Maintainer: phillicl
 
+#include "BondedForceChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
@@ -86,14 +87,16 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
     */
     Scalar2 getEntry(unsigned int type, unsigned int i)
         {
-        ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
-        return h_tables.data[m_table_value(i, type)];
+        ArrayHandle<Scalar4> h_tables(m_tables, access_location::host, access_mode::read);
+        const Scalar4& entry = h_tables.data[m_table_value(i, type)];
+        return make_scalar2(entry.x, entry.y);
         }
 
     protected:
     std::shared_ptr<DihedralData> m_dihedral_data; //!< Bond data to use in computing dihedrals
+    BondedForceChunks m_chunks;                    //!< Per-thread force buffers
     unsigned int m_table_width;                    //!< Width of the tables in memory
-    GPUArray<Scalar2> m_tables;                    //!< Stored V and F tables
+    GPUArray<Scalar4> m_tables;                    //!< V, T, and their increments to next
     Index2D m_table_value;                         //!< Index table helper
 
     //! Actually compute the forces
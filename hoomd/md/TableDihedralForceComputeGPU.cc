@@ -57,7 +57,7 @@ void TableDihedralForceComputeGPU::computeForces(uint64_t timestep)
     BoxDim box = m_pdata->getBox();
 
     // access the table data
-    ArrayHandle<Scalar2> d_tables(m_tables, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_tables(m_tables, access_location::device, access_mode::read);
 
     ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
     ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
@@ -27,7 +27,7 @@ hipError_t gpu_compute_table_dihedral_forces(Scalar4* d_force,
                                              const unsigned int* dihedral_ABCD,
                                              const unsigned int pitch,
                                              const unsigned int* n_dihedrals_list,
-                                             const Scalar2* d_tables,
+                                             const Scalar4* d_tables,
                                              const unsigned int table_width,
                                              const Index2D& table_value,
                                              const unsigned int block_size);
@@ -102,10 +102,10 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
                             hoomd::Counter(ptag));
 
         // compute the random force
+        Scalar rx, ry, rz;
         UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        uniform(rx, ry, rng);
+        rz = uniform(rng);
 
         Scalar gamma;
         if (m_use_alpha)
@@ -152,8 +152,7 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
             Scalar mass = h_vel.data[j].w;
             Scalar sigma = fast::sqrt(currentTemp / mass);
             NormalDistribution<Scalar> normal(sigma);
-            h_vel.data[j].x = normal(rng);
-            h_vel.data[j].y = normal(rng);
+            normal(h_vel.data[j].x, h_vel.data[j].y, rng);
             if (D > 2)
                 h_vel.data[j].z = normal(rng);
             else
@@ -186,10 +185,14 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
 
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
+                // draw all of the unit normals needed for this particle together
+                Scalar gauss[6];
+                NormalDistribution<Scalar>()(gauss, m_noiseless_r ? 3 : 6, rng);
+
                 vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+                bf_torque.x = gauss[0] * sigma_r.x;
+                bf_torque.y = gauss[1] * sigma_r.y;
+                bf_torque.z = gauss[2] * sigma_r.z;
 
                 if (x_zero)
                     bf_torque.x = 0;
@@ -226,9 +229,9 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
                 else
                     {
                     // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
+                    p_vec.x = gauss[3] * fast::sqrt(currentTemp * I.x);
+                    p_vec.y = gauss[4] * fast::sqrt(currentTemp * I.y);
+                    p_vec.z = gauss[5] * fast::sqrt(currentTemp * I.z);
                     }
 
                 if (x_zero)
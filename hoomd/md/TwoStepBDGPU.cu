@@ -122,10 +122,10 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
         // compute the random force
         RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
                             hoomd::Counter(ptag));
+        Scalar rx, ry, rz;
         UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        uniform(rx, ry, rng);
+        rz = uniform(rng);
 
         // calculate the magnitude of the random force
         Scalar gamma;
@@ -177,8 +177,7 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
             Scalar mass = vel.w;
             Scalar sigma = fast::sqrt(T / mass);
             NormalDistribution<Scalar> normal(sigma);
-            vel.x = normal(rng);
-            vel.y = normal(rng);
+            normal(vel.x, vel.y, rng);
             if (D > 2)
                 vel.z = normal(rng);
             else
@@ -218,10 +217,14 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
 
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
+                // draw all of the unit normals needed for this particle together
+                Scalar gauss[6];
+                NormalDistribution<Scalar>()(gauss, d_noiseless_r ? 3 : 6, rng);
+
                 vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+                bf_torque.x = gauss[0] * sigma_r.x;
+                bf_torque.y = gauss[1] * sigma_r.y;
+                bf_torque.z = gauss[2] * sigma_r.z;
 
                 if (x_zero)
                     bf_torque.x = 0;
@@ -255,9 +258,9 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
                 else
                     {
                     // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(T * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(T * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(T * I.z))(rng);
+                    p_vec.x = gauss[3] * fast::sqrt(T * I.x);
+                    p_vec.y = gauss[4] * fast::sqrt(T * I.y);
+                    p_vec.z = gauss[5] * fast::sqrt(T * I.z);
                     }
 
                 if (x_zero)
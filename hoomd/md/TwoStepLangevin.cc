@@ -268,10 +268,10 @@ void TwoStepLangevin::integrateStepTwo(uint64_t timestep)
 
         // first, calculate the BD forces
         // Generate three random numbers
+        Scalar rx, ry, rz;
         hoomd::UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        uniform(rx, ry, rng);
+        rz = uniform(rng);
 
         Scalar gamma;
         if (m_use_alpha)
@@ -338,9 +338,11 @@ void TwoStepLangevin::integrateStepTwo(uint64_t timestep)
                 if (m_noiseless_r)
                     sigma_r = make_scalar3(0.0, 0.0, 0.0);
 
-                Scalar rand_x = hoomd::NormalDistribution<Scalar>(sigma_r.x)(rng);
-                Scalar rand_y = hoomd::NormalDistribution<Scalar>(sigma_r.y)(rng);
-                Scalar rand_z = hoomd::NormalDistribution<Scalar>(sigma_r.z)(rng);
+                Scalar gauss[3];
+                hoomd::NormalDistribution<Scalar>()(gauss, 3, rng);
+                Scalar rand_x = gauss[0] * sigma_r.x;
+                Scalar rand_y = gauss[1] * sigma_r.y;
+                Scalar rand_z = gauss[2] * sigma_r.z;
 
                 // check for degenerate moment of inertia
                 bool x_zero, y_zero, z_zero;
@@ -121,9 +121,9 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
                             hoomd::Counter(ptag));
         UniformDistribution<Scalar> uniform(-1, 1);
 
-        Scalar randomx = uniform(rng);
-        Scalar randomy = uniform(rng);
-        Scalar randomz = uniform(rng);
+        Scalar randomx, randomy, randomz;
+        uniform(randomx, randomy, rng);
+        randomz = uniform(rng);
 
         bd_force.x = randomx * coeff - gamma * vel.x;
         bd_force.y = randomy * coeff - gamma * vel.y;
@@ -305,9 +305,11 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
 
             RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevinAngular, timestep, seed),
                                 hoomd::Counter(ptag));
-            Scalar rand_x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-            Scalar rand_y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-            Scalar rand_z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+            Scalar gauss[3];
+            NormalDistribution<Scalar>()(gauss, 3, rng);
+            Scalar rand_x = gauss[0] * sigma_r.x;
+            Scalar rand_y = gauss[1] * sigma_r.y;
+            Scalar rand_z = gauss[2] * sigma_r.z;
 
             // check for zero moment of inertia
             bool x_zero, y_zero, z_zero;
@@ -60,7 +60,7 @@ TwoStepNPTMTK::TwoStepNPTMTK(std::shared_ptr<SystemDefinition> sysdef,
                              const bool nph)
     : IntegrationMethodTwoStep(sysdef, group), m_thermo_half_step(thermo_half_step),
       m_thermo_full_step(thermo_full_step), m_ndof(0), m_tau(tau), m_tauS(tauS), m_T(T), m_S(S),
-      m_nph(nph), m_rescale_all(false), m_gamma(0.0)
+      m_nph(nph), m_rescale_all(false), m_gamma(0.0), m_barostat_period(1)
     {
     m_exec_conf->msg->notice(5) << "Constructing TwoStepNPTMTK" << endl;
 
@@ -674,6 +674,19 @@ void TwoStepNPTMTK::updatePropagator(Scalar nuxx,
     m_mat_exp_r_int[5] = m_deltaT * exp_r_fac.z * f_r.z;                    // zz
     }
 
+/*! \param barostat_period Number of time steps between barostat updates
+
+    The barostat integrates the box degrees of freedom with a time step of barostat_period *
+    deltaT on time steps that are multiples of barostat_period and keeps them fixed on the other
+    steps, which do not need the pressure tensor.
+*/
+void TwoStepNPTMTK::setBarostatPeriod(unsigned int barostat_period)
+    {
+    if (barostat_period == 0)
+        throw std::invalid_argument("barostat_period must be positive");
+    m_barostat_period = barostat_period;
+    }
+
 // Set Flags from 6 element boolean tuple named box_df to integer flag
 void TwoStepNPTMTK::setFlags(const std::vector<bool>& value)
     {
@@ -710,6 +723,13 @@ std::vector<bool> TwoStepNPTMTK::getFlags()
 //! Helper function to advance the barostat parameters
 void TwoStepNPTMTK::advanceBarostat(uint64_t timestep)
     {
+    // the pressure is only available on barostat steps
+    if (!isBarostatStep(timestep))
+        return;
+
+    // the barostat integrates over all steps until the next barostat step
+    Scalar deltaT = m_deltaT * Scalar(m_barostat_period);
+
     // compute thermodynamic properties at full time step
     m_thermo_full_step->compute(timestep);
 
@@ -732,7 +752,7 @@ void TwoStepNPTMTK::advanceBarostat(uint64_t timestep)
     unsigned int d = m_sysdef->getNDimensions();
     Scalar W = (Scalar)(m_ndof + d) / (Scalar)d * (*m_T)(timestep)*m_tauS * m_tauS;
     Scalar mtk_term = Scalar(2.0) * m_thermo_full_step->getTranslationalKineticEnergy();
-    mtk_term *= Scalar(1.0 / 2.0) * m_deltaT / (Scalar)m_ndof / W;
+    mtk_term *= Scalar(1.0 / 2.0) * deltaT / (Scalar)m_ndof / W;
 
     couplingMode couple = getRelevantCouplings();
 
@@ -786,40 +806,37 @@ void TwoStepNPTMTK::advanceBarostat(uint64_t timestep)
 
     if (m_flags & baro_x)
         {
-        nuxx
-            += Scalar(1.0 / 2.0) * m_deltaT * m_V / W * (P_diag.x - (*m_S[0])(timestep)) + mtk_term;
+        nuxx += Scalar(1.0 / 2.0) * deltaT * m_V / W * (P_diag.x - (*m_S[0])(timestep)) + mtk_term;
         nuxx -= m_gamma * nuxx;
         }
 
     if (m_flags & baro_xy)
         {
-        nuxy += Scalar(1.0 / 2.0) * m_deltaT * m_V / W * (P.xy - (*m_S[5])(timestep));
+        nuxy += Scalar(1.0 / 2.0) * deltaT * m_V / W * (P.xy - (*m_S[5])(timestep));
         nuxy -= m_gamma * nuxy;
         }
 
     if (m_flags & baro_xz)
         {
-        nuxz += Scalar(1.0 / 2.0) * m_deltaT * m_V / W * (P.xz - (*m_S[4])(timestep));
+        nuxz += Scalar(1.0 / 2.0) * deltaT * m_V / W * (P.xz - (*m_S[4])(timestep));
         nuxz -= m_gamma * nuxz;
         }
 
     if (m_flags & baro_y)
         {
-        nuyy
-            += Scalar(1.0 / 2.0) * m_deltaT * m_V / W * (P_diag.y - (*m_S[1])(timestep)) + mtk_term;
+        nuyy += Scalar(1.0 / 2.0) * deltaT * m_V / W * (P_diag.y - (*m_S[1])(timestep)) + mtk_term;
         nuyy -= m_gamma * nuyy;
         }
 
     if (m_flags & baro_yz)
         {
-        nuyz += Scalar(1.0 / 2.0) * m_deltaT * m_V / W * (P.yz - (*m_S[3])(timestep));
+        nuyz += Scalar(1.0 / 2.0) * deltaT * m_V / W * (P.yz - (*m_S[3])(timestep));
         nuyz -= m_gamma * nuyz;
         }
 
     if (m_flags & baro_z)
         {
-        nuzz
-            += Scalar(1.0 / 2.0) * m_deltaT * m_V / W * (P_diag.z - (*m_S[2])(timestep)) + mtk_term;
+        nuzz += Scalar(1.0 / 2.0) * deltaT * m_V / W * (P_diag.z - (*m_S[2])(timestep)) + mtk_term;
         nuzz -= m_gamma * nuzz;
         }
 
@@ -1265,6 +1282,9 @@ void export_TwoStepNPTMTK(py::module& m)
         .def_property("box_dof", &TwoStepNPTMTK::getFlags, &TwoStepNPTMTK::setFlags)
         .def_property("rescale_all", &TwoStepNPTMTK::getRescaleAll, &TwoStepNPTMTK::setRescaleAll)
         .def_property("gamma", &TwoStepNPTMTK::getGamma, &TwoStepNPTMTK::setGamma)
+        .def_property("barostat_period",
+                      &TwoStepNPTMTK::getBarostatPeriod,
+                      &TwoStepNPTMTK::setBarostatPeriod)
         .def("thermalizeThermostatAndBarostatDOF",
              &TwoStepNPTMTK::thermalizeThermostatAndBarostatDOF)
         .def_property("translational_thermostat_dof",
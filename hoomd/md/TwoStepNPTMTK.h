@@ -33,6 +33,10 @@
     fully time-reversible and measure-preserving update equations (Glaser et al. 2013 to be
    published)
 
+    The barostat may be updated only every barostat_period steps. It then integrates the box
+    degrees of freedom with the longer time step and the force computes skip the virial on the
+    other steps.
+
     \cite Martyna1994
     \cite Tuckerman2006
     \cite Yu2010
@@ -124,6 +128,9 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
         {
         m_gamma = gamma;
         }
+    //! Set the number of time steps between barostat updates
+    void setBarostatPeriod(unsigned int barostat_period);
+
     //! declaration for setting the parameter couple
     void setCouple(const std::string& value);
 
@@ -166,6 +173,12 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
         return m_gamma;
         }
 
+    // Get barostat_period
+    unsigned int getBarostatPeriod()
+        {
+        return m_barostat_period;
+        }
+
     // declaration get function of couple
     std::string getCouple();
 
@@ -179,17 +192,22 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
     virtual void integrateStepTwo(uint64_t timestep);
 
     //! Get needed pdata flags
-    /*! TwoStepNPTMTK needs the pressure, so the pressure_tensor flag is set
+    /*! TwoStepNPTMTK needs the pressure on the steps the barostat is updated, so the
+        pressure_tensor flag is set on those steps
+        \param timestep Time step the flags are needed on
      */
-    virtual PDataFlags getRequestedPDataFlags()
+    virtual PDataFlags getRequestedPDataFlags(uint64_t timestep)
         {
         PDataFlags flags;
-        flags[pdata_flag::pressure_tensor] = 1;
+        if (isBarostatStep(timestep))
+            {
+            flags[pdata_flag::pressure_tensor] = 1;
+            flags[pdata_flag::external_field_virial] = 1;
+            }
         if (m_aniso)
             {
             flags[pdata_flag::rotational_kinetic_energy] = 1;
             }
-        flags[pdata_flag::external_field_virial] = 1;
         return flags;
         }
 
@@ -253,6 +271,14 @@ class PYBIND11_EXPORT TwoStepNPTMTK : public IntegrationMethodTwoStep
 
     Scalar m_gamma; //!< Optional damping factor for box degrees of freedom
 
+    unsigned int m_barostat_period; //!< Number of time steps between barostat updates
+
+    //! Test if the barostat is updated on the given time step
+    bool isBarostatStep(uint64_t timestep)
+        {
+        return timestep % m_barostat_period == 0;
+        }
+
     //! Helper function to advance the barostat parameters
     void advanceBarostat(uint64_t timestep);
 
@@ -115,51 +115,46 @@ void TwoStepNVE::integrateStepOne(uint64_t timestep)
     // perform the first half step of velocity verlet
     // r(t+deltaT) = r(t) + v(t)*deltaT + (1/2)a(t)*deltaT^2
     // v(t+deltaT/2) = v(t) + (1/2)a*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // particles may be moved slightly outside the box by this step, wrap them back into place
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+
+    forEachMember(
+        [&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        if (m_zero_force)
-            h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
-
-        Scalar dx = h_vel.data[j].x * m_deltaT
-                    + Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT * m_deltaT;
-        Scalar dy = h_vel.data[j].y * m_deltaT
-                    + Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT * m_deltaT;
-        Scalar dz = h_vel.data[j].z * m_deltaT
-                    + Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT * m_deltaT;
-
-        // limit the movement of the particles
-        if (m_limit)
-            {
-            Scalar len = sqrt(dx * dx + dy * dy + dz * dz);
-            if (len > m_limit_val)
+            if (m_zero_force)
+                h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
+
+            Scalar dx = h_vel.data[j].x * m_deltaT
+                        + Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT * m_deltaT;
+            Scalar dy = h_vel.data[j].y * m_deltaT
+                        + Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT * m_deltaT;
+            Scalar dz = h_vel.data[j].z * m_deltaT
+                        + Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT * m_deltaT;
+
+            // limit the movement of the particles
+            if (m_limit)
                 {
-                dx = dx / len * m_limit_val;
-                dy = dy / len * m_limit_val;
-                dz = dz / len * m_limit_val;
+                Scalar len = sqrt(dx * dx + dy * dy + dz * dz);
+                if (len > m_limit_val)
+                    {
+                    dx = dx / len * m_limit_val;
+                    dy = dy / len * m_limit_val;
+                    dz = dz / len * m_limit_val;
+                    }
                 }
-            }
 
-        h_pos.data[j].x += dx;
-        h_pos.data[j].y += dy;
-        h_pos.data[j].z += dz;
+            h_pos.data[j].x += dx;
+            h_pos.data[j].y += dy;
+            h_pos.data[j].z += dz;
 
-        h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
-        h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
-        h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
-        }
+            h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
+            h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
+            h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
 
-    // particles may have been moved slightly outside the box by the above steps, wrap them back
-    // into place
-    const BoxDim& box = m_pdata->getBox();
-
-    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
-
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        box.wrap(h_pos.data[j], h_image.data[j]);
-        }
+            box.wrap(h_pos.data[j], h_image.data[j]);
+        });
 
     // Integration of angular degrees of freedom using symplectic and
     // time-reversal symmetric integration scheme of Miller et al.
@@ -310,41 +305,41 @@ void TwoStepNVE::integrateStepTwo(uint64_t timestep)
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
 
     // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember(
+        [&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        if (m_zero_force)
-            {
-            h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
-            }
-        else
-            {
-            // first, calculate acceleration from the net force
-            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
-            h_accel.data[j].x = h_net_force.data[j].x * minv;
-            h_accel.data[j].y = h_net_force.data[j].y * minv;
-            h_accel.data[j].z = h_net_force.data[j].z * minv;
-            }
+            if (m_zero_force)
+                {
+                h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
+                }
+            else
+                {
+                // first, calculate acceleration from the net force
+                Scalar minv = Scalar(1.0) / h_vel.data[j].w;
+                h_accel.data[j].x = h_net_force.data[j].x * minv;
+                h_accel.data[j].y = h_net_force.data[j].y * minv;
+                h_accel.data[j].z = h_net_force.data[j].z * minv;
+                }
 
-        // then, update the velocity
-        h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
-        h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
-        h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
+            // then, update the velocity
+            h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
+            h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
+            h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
 
-        // limit the movement of the particles
-        if (m_limit)
-            {
-            Scalar vel = sqrt(h_vel.data[j].x * h_vel.data[j].x + h_vel.data[j].y * h_vel.data[j].y
-                              + h_vel.data[j].z * h_vel.data[j].z);
-            if ((vel * m_deltaT) > m_limit_val)
+            // limit the movement of the particles
+            if (m_limit)
                 {
-                h_vel.data[j].x = h_vel.data[j].x / vel * m_limit_val / m_deltaT;
-                h_vel.data[j].y = h_vel.data[j].y / vel * m_limit_val / m_deltaT;
-                h_vel.data[j].z = h_vel.data[j].z / vel * m_limit_val / m_deltaT;
+                Scalar vel
+                    = sqrt(h_vel.data[j].x * h_vel.data[j].x + h_vel.data[j].y * h_vel.data[j].y
+                           + h_vel.data[j].z * h_vel.data[j].z);
+                if ((vel * m_deltaT) > m_limit_val)
+                    {
+                    h_vel.data[j].x = h_vel.data[j].x / vel * m_limit_val / m_deltaT;
+                    h_vel.data[j].y = h_vel.data[j].y / vel * m_limit_val / m_deltaT;
+                    h_vel.data[j].z = h_vel.data[j].z / vel * m_limit_val / m_deltaT;
+                    }
                 }
-            }
-        }
+        });
 
     if (m_aniso)
         {
@@ -384,14 +384,17 @@ void TwoStepNVTMTK::integrateStepTwo(uint64_t timestep)
 
 void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, bool broadcast)
     {
-    IntegratorVariables v = getIntegratorVariables();
-    Scalar& xi = v.variable[0];
-    Scalar& eta = v.variable[1];
-
     // compute the current thermodynamic properties
     m_thermo->compute(timestep + 1);
 
-    Scalar curr_T_trans = m_thermo->getTranslationalTemperature();
+    advanceThermostat(timestep, m_thermo->getTranslationalTemperature(), broadcast);
+    }
+
+void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, Scalar curr_T_trans, bool broadcast)
+    {
+    IntegratorVariables v = getIntegratorVariables();
+    Scalar& xi = v.variable[0];
+    Scalar& eta = v.variable[1];
 
     // update the state variables Xi and eta
     Scalar xi_prime = xi
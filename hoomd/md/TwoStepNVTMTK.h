@@ -93,7 +93,7 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
     //! Get needed pdata flags
     /*! in anisotropic mode, we need the rotational kinetic energy
      */
-    virtual PDataFlags getRequestedPDataFlags()
+    virtual PDataFlags getRequestedPDataFlags(uint64_t timestep)
         {
         PDataFlags flags;
         if (m_aniso)
@@ -145,6 +145,16 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
      * \param broadcast True if we should broadcast the integrator variables via MPI
      */
     void advanceThermostat(uint64_t timestep, bool broadcast = true);
+
+    //! advance the thermostat given the current translational temperature
+    /*!\param timestep The time step
+     * \param curr_T_trans Translational temperature at timestep + 1/2
+     * \param broadcast True if we should broadcast the integrator variables via MPI
+     *
+     * The rotational thermostat reads the rotational kinetic energy from m_thermo, which must
+     * already be computed when m_aniso is set.
+     */
+    void advanceThermostat(uint64_t timestep, Scalar curr_T_trans, bool broadcast);
     };
 
 //! Exports the TwoStepNVTMTK class to python
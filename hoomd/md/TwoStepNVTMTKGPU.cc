@@ -54,6 +54,9 @@ TwoStepNVTMTKGPU::TwoStepNVTMTKGPU(std::shared_ptr<SystemDefinition> sysdef,
         new Autotuner(valid_params, 5, 100000, "nvt_mtk_angular_one", this->m_exec_conf));
     m_tuner_angular_two.reset(
         new Autotuner(valid_params, 5, 100000, "nvt_mtk_angular_two", this->m_exec_conf));
+
+    GlobalArray<Scalar> sum2K(1, m_exec_conf);
+    m_sum2K.swap(sum2K);
     }
 
 /*! \param timestep Current time step
@@ -69,6 +72,7 @@ void TwoStepNVTMTKGPU::integrateStepOne(uint64_t timestep)
         }
 
     unsigned int group_size = m_group->getNumMembers();
+    unsigned int n_partial_sum2K = 0;
 
     // profile this step
     if (m_prof)
@@ -96,9 +100,31 @@ void TwoStepNVTMTKGPU::integrateStepOne(uint64_t timestep)
                                                 access_location::device,
                                                 access_mode::read);
 
+        // one partial sum per block, for any block size the tuner chooses
+        if (!m_aniso)
+            {
+            unsigned int n_partial = group_size / m_exec_conf->dev_prop.warpSize
+                                     + m_exec_conf->getNumActiveGPUs();
+            if (m_partial_sum2K.getNumElements() < n_partial)
+                {
+                GlobalArray<Scalar> partial_sum2K(n_partial, m_exec_conf);
+                m_partial_sum2K.swap(partial_sum2K);
+                }
+            }
+
+        ArrayHandle<Scalar> d_partial_sum2K(m_partial_sum2K,
+                                            access_location::device,
+                                            access_mode::overwrite);
+        ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+
         m_exec_conf->beginMultiGPU();
 
-        // perform the update on the GPU
+        // perform the update on the GPU, summing m*v^2 for the thermostat in the same pass
         m_tuner_one->begin();
         gpu_nvt_mtk_step_one(d_pos.data,
                              d_vel.data,
@@ -110,13 +136,26 @@ void TwoStepNVTMTKGPU::integrateStepOne(uint64_t timestep)
                              m_tuner_one->getParam(),
                              m_exp_thermo_fac,
                              m_deltaT,
-                             m_group->getGPUPartition());
+                             m_group->getGPUPartition(),
+                             d_body.data,
+                             d_tag.data,
+                             m_aniso ? NULL : d_partial_sum2K.data,
+                             n_partial_sum2K);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         m_tuner_one->end();
 
         m_exec_conf->endMultiGPU();
+
+        if (!m_aniso)
+            {
+            ArrayHandle<Scalar> d_sum2K(m_sum2K, access_location::device, access_mode::overwrite);
+            gpu_nvt_mtk_reduce_sum2K(d_sum2K.data, d_partial_sum2K.data, n_partial_sum2K);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
         }
 
     if (m_aniso)
@@ -161,7 +200,36 @@ void TwoStepNVTMTKGPU::integrateStepOne(uint64_t timestep)
         }
 
     // advance thermostat
-    advanceThermostat(timestep, false);
+    if (m_aniso)
+        {
+        // the rotational thermostat needs the rotational kinetic energy from the thermo compute
+        advanceThermostat(timestep, false);
+        }
+    else
+        {
+        // use the kinetic energy summed by the step one kernel
+        Scalar sum2K;
+            {
+            ArrayHandle<Scalar> h_sum2K(m_sum2K, access_location::host, access_mode::read);
+            sum2K = h_sum2K.data[0];
+            }
+
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &sum2K,
+                          1,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        Scalar ndof = m_thermo->getTranslationalDOF();
+        Scalar curr_T_trans = ndof > 0 ? sum2K / ndof : Scalar(0.0);
+        advanceThermostat(timestep, curr_T_trans, false);
+        }
 
     // done profiling
     if (m_prof)
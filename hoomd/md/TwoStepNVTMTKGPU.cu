@@ -23,26 +23,44 @@
     \param exp_fac Velocity rescaling factor from thermostat
     \param deltaT Amount of real time to step forward in one time step
     \param offset The offset of this GPU into the list of particles
+    \param d_body Particle body id (when compute_sum2K is true)
+    \param d_tag Particle tag (when compute_sum2K is true)
+    \param d_partial_sum2K Partial sums of m*v^2 over each block (when compute_sum2K is true)
+    \param block_offset The offset of this GPU into the array of partial sums
 
     Take the first half step forward in the NVT integration.
 
+    When \a compute_sum2K is true, each block also sums m*v^2 of the updated half step velocities
+    in shared memory and writes the result to d_partial_sum2K, so that the thermostat does not need
+    a separate pass over the particle data. sizeof(Scalar)*block_size bytes of shared memory are
+    needed in this case.
+
     See gpu_nve_step_one_kernel() for some performance notes on how to handle the group data reads
    efficiently.
 */
-extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
-                                                       Scalar4* d_vel,
-                                                       const Scalar3* d_accel,
-                                                       int3* d_image,
-                                                       unsigned int* d_group_members,
-                                                       unsigned int work_size,
-                                                       BoxDim box,
-                                                       Scalar exp_fac,
-                                                       Scalar deltaT,
-                                                       unsigned int offset)
+template<bool compute_sum2K>
+__global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
+                                            Scalar4* d_vel,
+                                            const Scalar3* d_accel,
+                                            int3* d_image,
+                                            unsigned int* d_group_members,
+                                            unsigned int work_size,
+                                            BoxDim box,
+                                            Scalar exp_fac,
+                                            Scalar deltaT,
+                                            unsigned int offset,
+                                            const unsigned int* d_body,
+                                            const unsigned int* d_tag,
+                                            Scalar* d_partial_sum2K,
+                                            unsigned int block_offset)
     {
+    extern __shared__ Scalar nvt_mtk_sum2K_sdata[];
+
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
+    Scalar my_sum2K = Scalar(0.0);
+
     if (group_idx < work_size)
         {
         unsigned int idx = d_group_members[group_idx + offset];
@@ -73,6 +91,39 @@ extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
         d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
         d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, velmass.w);
         d_image[idx] = image;
+
+        // ignore rigid body constituent particles in the sum, as ComputeThermo does
+        if (compute_sum2K)
+            {
+            unsigned int body = d_body[idx];
+            if (body >= MIN_FLOPPY || body == d_tag[idx])
+                my_sum2K = velmass.w * dot(vel, vel);
+            }
+        }
+
+    if (compute_sum2K)
+        {
+        nvt_mtk_sum2K_sdata[threadIdx.x] = my_sum2K;
+        __syncthreads();
+
+        // reduce the sum in parallel, the block size is a multiple of the warp size but not
+        // necessarily a power of two
+        int offs = 1;
+        while (offs < blockDim.x)
+            offs <<= 1;
+        offs >>= 1;
+
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs && threadIdx.x + offs < blockDim.x)
+                nvt_mtk_sum2K_sdata[threadIdx.x] += nvt_mtk_sum2K_sdata[threadIdx.x + offs];
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        // write out our partial sum
+        if (threadIdx.x == 0)
+            d_partial_sum2K[block_offset + blockIdx.x] = nvt_mtk_sum2K_sdata[0];
         }
     }
 
@@ -86,6 +137,13 @@ extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
     \param block_size Size of the block to run
     \param exp_fac Thermostat rescaling factor
     \param deltaT Amount of real time to step forward in one time step
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param d_partial_sum2K Output partial sums of m*v^2, or NULL to skip them
+    \param n_partial_sum2K Output number of partial sums written to \a d_partial_sum2K
+
+    \a d_partial_sum2K must hold at least group_size / block_size + the number of active GPUs
+    elements. Reduce the partial sums with gpu_nvt_mtk_reduce_sum2K().
 */
 hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                                 Scalar4* d_vel,
@@ -97,15 +155,24 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                                 unsigned int block_size,
                                 Scalar exp_fac,
                                 Scalar deltaT,
-                                const GPUPartition& gpu_partition)
+                                const GPUPartition& gpu_partition,
+                                const unsigned int* d_body,
+                                const unsigned int* d_tag,
+                                Scalar* d_partial_sum2K,
+                                unsigned int& n_partial_sum2K)
     {
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_nvt_mtk_step_one_kernel);
+    if (d_partial_sum2K)
+        hipFuncGetAttributes(&attr, (const void*)gpu_nvt_mtk_step_one_kernel<true>);
+    else
+        hipFuncGetAttributes(&attr, (const void*)gpu_nvt_mtk_step_one_kernel<false>);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
 
+    unsigned int block_offset = 0;
+
     // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
     for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
         {
@@ -118,23 +185,123 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel, starting with offset range.first
-        hipLaunchKernelGGL((gpu_nvt_mtk_step_one_kernel),
-                           dim3(grid),
-                           dim3(threads),
-                           0,
-                           0,
-                           d_pos,
-                           d_vel,
-                           d_accel,
-                           d_image,
-                           d_group_members,
-                           nwork,
-                           box,
-                           exp_fac,
-                           deltaT,
-                           range.first);
+        if (d_partial_sum2K)
+            {
+            hipLaunchKernelGGL((gpu_nvt_mtk_step_one_kernel<true>),
+                               dim3(grid),
+                               dim3(threads),
+                               sizeof(Scalar) * run_block_size,
+                               0,
+                               d_pos,
+                               d_vel,
+                               d_accel,
+                               d_image,
+                               d_group_members,
+                               nwork,
+                               box,
+                               exp_fac,
+                               deltaT,
+                               range.first,
+                               d_body,
+                               d_tag,
+                               d_partial_sum2K,
+                               block_offset);
+            }
+        else
+            {
+            hipLaunchKernelGGL((gpu_nvt_mtk_step_one_kernel<false>),
+                               dim3(grid),
+                               dim3(threads),
+                               0,
+                               0,
+                               d_pos,
+                               d_vel,
+                               d_accel,
+                               d_image,
+                               d_group_members,
+                               nwork,
+                               box,
+                               exp_fac,
+                               deltaT,
+                               range.first,
+                               d_body,
+                               d_tag,
+                               d_partial_sum2K,
+                               block_offset);
+            }
+
+        block_offset += grid.x;
+        }
+
+    n_partial_sum2K = block_offset;
+
+    return hipSuccess;
+    }
+
+//! Reduce the partial sums of m*v^2 written by gpu_nvt_mtk_step_one_kernel
+/*! \param d_sum2K Output sum
+    \param d_partial_sum2K Partial sums
+    \param n_partial_sum2K Number of partial sums
+
+    Launch with a single block. sizeof(Scalar)*block_size bytes of shared memory are needed, and the
+    block size must be a power of two.
+*/
+__global__ void gpu_nvt_mtk_reduce_sum2K_kernel(Scalar* d_sum2K,
+                                                const Scalar* d_partial_sum2K,
+                                                unsigned int n_partial_sum2K)
+    {
+    extern __shared__ Scalar nvt_mtk_final_sum2K_sdata[];
+
+    Scalar final_sum = Scalar(0.0);
+
+    // sum up the values in the partial sum via a sliding window
+    for (int start = 0; start < n_partial_sum2K; start += blockDim.x)
+        {
+        __syncthreads();
+        if (start + threadIdx.x < n_partial_sum2K)
+            nvt_mtk_final_sum2K_sdata[threadIdx.x] = d_partial_sum2K[start + threadIdx.x];
+        else
+            nvt_mtk_final_sum2K_sdata[threadIdx.x] = Scalar(0.0);
+        __syncthreads();
+
+        // reduce the sum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                nvt_mtk_final_sum2K_sdata[threadIdx.x]
+                    += nvt_mtk_final_sum2K_sdata[threadIdx.x + offs];
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            final_sum += nvt_mtk_final_sum2K_sdata[0];
         }
 
+    if (threadIdx.x == 0)
+        *d_sum2K = final_sum;
+    }
+
+/*! \param d_sum2K Output sum of m*v^2 over the group
+    \param d_partial_sum2K Partial sums written by gpu_nvt_mtk_step_one()
+    \param n_partial_sum2K Number of partial sums
+*/
+hipError_t gpu_nvt_mtk_reduce_sum2K(Scalar* d_sum2K,
+                                    const Scalar* d_partial_sum2K,
+                                    unsigned int n_partial_sum2K)
+    {
+    const unsigned int final_block_size = 256;
+
+    hipLaunchKernelGGL((gpu_nvt_mtk_reduce_sum2K_kernel),
+                       dim3(1),
+                       dim3(final_block_size),
+                       sizeof(Scalar) * final_block_size,
+                       0,
+                       d_sum2K,
+                       d_partial_sum2K,
+                       n_partial_sum2K);
+
     return hipSuccess;
     }
 
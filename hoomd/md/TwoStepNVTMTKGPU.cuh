@@ -25,7 +25,16 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                                 unsigned int block_size,
                                 Scalar exp_fac,
                                 Scalar deltaT,
-                                const GPUPartition& gpu_partition);
+                                const GPUPartition& gpu_partition,
+                                const unsigned int* d_body,
+                                const unsigned int* d_tag,
+                                Scalar* d_partial_sum2K,
+                                unsigned int& n_partial_sum2K);
+
+//! Kernel driver to reduce the partial sums of m*v^2 from gpu_nvt_mtk_step_one
+hipError_t gpu_nvt_mtk_reduce_sum2K(Scalar* d_sum2K,
+                                    const Scalar* d_partial_sum2K,
+                                    unsigned int n_partial_sum2K);
 
 //! Kernel driver for the second part of the NVT update called by NVTUpdaterGPU
 hipError_t gpu_nvt_mtk_step_two(Scalar4* d_vel,
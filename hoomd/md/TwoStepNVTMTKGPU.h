@@ -27,7 +27,9 @@
     In order to compute efficiently and limit the number of kernel launches integrateStepOne()
    performs a first pass reduction on the sum of m*v^2 and stores the partial reductions. A second
    kernel is then launched to reduce those to a final \a sum2K, which is a scalar but stored in a
-   GPUArray for convenience.
+   GPUArray for convenience. The thermostat uses \a sum2K directly instead of computing the
+   thermodynamic properties again. When integrating rotational degrees of freedom, the thermostat
+   still needs the rotational kinetic energy from the thermo compute.
 
     \ingroup updaters
 */
@@ -72,6 +74,9 @@ class PYBIND11_EXPORT TwoStepNVTMTKGPU : public TwoStepNVTMTK
         m_tuner_angular_one; //!< Autotuner_angular for block size (angular step one kernel)
     std::unique_ptr<Autotuner>
         m_tuner_angular_two; //!< Autotuner_angular for block size (angular step two kernel)
+
+    GlobalArray<Scalar> m_partial_sum2K; //!< Partial sums of m*v^2 from the step one kernel
+    GlobalArray<Scalar> m_sum2K;         //!< Sum of m*v^2 over the group
     };
 
 //! Exports the TwoStepNVTMTKGPU class to python
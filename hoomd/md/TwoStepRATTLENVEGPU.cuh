@@ -88,12 +88,211 @@ hipError_t gpu_include_rattle_force_nve(const Scalar4* d_pos,
                                         bool zero_force,
                                         unsigned int block_size);
 
+template<class Manifold>
+hipError_t gpu_rattle_nve_step_two_include_force(const Scalar4* d_pos,
+                                                 Scalar4* d_vel,
+                                                 Scalar3* d_accel,
+                                                 Scalar4* d_net_force,
+                                                 Scalar* d_net_virial,
+                                                 unsigned int* d_group_members,
+                                                 const GPUPartition& gpu_partition,
+                                                 size_t net_virial_pitch,
+                                                 Manifold manifold,
+                                                 Scalar tolerance,
+                                                 Scalar deltaT,
+                                                 bool limit,
+                                                 Scalar limit_val,
+                                                 bool zero_force,
+                                                 unsigned int block_size);
+
 #ifdef __HIPCC__
 
 /*! \file TwoStepNVEGPU.cu
     \brief Defines GPU kernel code for NVE integration on the GPU. Used by TwoStepNVEGPU.
 */
 
+//! Takes the second half-step forward in the velocity-verlet NVE integration of one particle
+/*! \param pos Position of the particle
+    \param vel Velocity and mass of the particle, updated to t + deltaT
+    \param accel Set to the acceleration of the particle
+    \param net_force Net force on the particle
+    \param manifold Manifold the particle is confined to
+    \param tolerance Tolerance of the Newton iteration of the constraint
+    \param deltaT Amount of real time to step forward in one time step
+    \param limit If \a limit is true, then the dynamics will be limited so that particles do not
+   move a distance further than \a limit_val in one step.
+    \param limit_val Length to limit particle distance movement to
+    \param zero_force Set to true to always assign an acceleration of 0
+
+    The Newton iteration stops as soon as the residual is below the tolerance, and after at most 10
+    iterations.
+*/
+template<class Manifold>
+__device__ inline void rattle_nve_step_two_particle(const Scalar3& pos,
+                                                    Scalar4& vel,
+                                                    Scalar3& accel,
+                                                    const Scalar4& net_force,
+                                                    Manifold& manifold,
+                                                    Scalar tolerance,
+                                                    Scalar deltaT,
+                                                    bool limit,
+                                                    Scalar limit_val,
+                                                    bool zero_force)
+    {
+    accel = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+
+    if (!zero_force)
+        {
+        accel = make_scalar3(net_force.x, net_force.y, net_force.z);
+        // MEM TRANSFER: 4 bytes   FLOPS: 3
+        Scalar mass = vel.w;
+        accel.x /= mass;
+        accel.y /= mass;
+        accel.z /= mass;
+        }
+
+    // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
+
+    // update the velocity (FLOPS: 6)
+
+    Scalar mu = 0;
+    Scalar inv_alpha = -Scalar(1.0 / 2.0) * deltaT;
+    inv_alpha = Scalar(1.0) / inv_alpha;
+    Scalar mass = vel.w;
+    Scalar inv_mass = Scalar(1.0) / mass;
+
+    Scalar3 normal = manifold.derivative(pos);
+
+    Scalar3 next_vel;
+    next_vel.x = vel.x + Scalar(1.0 / 2.0) * deltaT * accel.x;
+    next_vel.y = vel.y + Scalar(1.0 / 2.0) * deltaT * accel.y;
+    next_vel.z = vel.z + Scalar(1.0 / 2.0) * deltaT * accel.z;
+
+    Scalar3 residual;
+    Scalar resid;
+    Scalar3 vel_dot;
+
+    const unsigned int maxiteration = 10;
+    unsigned int iteration = 0;
+    do
+        {
+        iteration++;
+        vel_dot.x = accel.x - mu * inv_mass * normal.x;
+        vel_dot.y = accel.y - mu * inv_mass * normal.y;
+        vel_dot.z = accel.z - mu * inv_mass * normal.z;
+
+        residual.x = vel.x - next_vel.x + Scalar(1.0 / 2.0) * deltaT * vel_dot.x;
+        residual.y = vel.y - next_vel.y + Scalar(1.0 / 2.0) * deltaT * vel_dot.y;
+        residual.z = vel.z - next_vel.z + Scalar(1.0 / 2.0) * deltaT * vel_dot.z;
+        resid = dot(normal, next_vel) * inv_mass;
+
+        Scalar ndotr = dot(normal, residual);
+        Scalar ndotn = dot(normal, normal);
+        Scalar beta = (mass * resid + ndotr) / ndotn;
+        next_vel.x = next_vel.x - normal.x * beta + residual.x;
+        next_vel.y = next_vel.y - normal.y * beta + residual.y;
+        next_vel.z = next_vel.z - normal.z * beta + residual.z;
+        mu = mu - mass * beta * inv_alpha;
+
+        resid = fabs(resid);
+        Scalar vec_norm = sqrt(dot(residual, residual));
+        if (vec_norm > resid)
+            resid = vec_norm;
+
+        } while (resid * mass > tolerance && iteration < maxiteration);
+
+    vel.x += (Scalar(1.0) / Scalar(2.0)) * (accel.x - mu * inv_mass * normal.x) * deltaT;
+    vel.y += (Scalar(1.0) / Scalar(2.0)) * (accel.y - mu * inv_mass * normal.y) * deltaT;
+    vel.z += (Scalar(1.0) / Scalar(2.0)) * (accel.z - mu * inv_mass * normal.z) * deltaT;
+
+    if (limit)
+        {
+        Scalar vel_len = sqrtf(vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
+        if ((vel_len * deltaT) > limit_val)
+            {
+            vel.x = vel.x / vel_len * limit_val / deltaT;
+            vel.y = vel.y / vel_len * limit_val / deltaT;
+            vel.z = vel.z / vel_len * limit_val / deltaT;
+            }
+        }
+    }
+
+//! Includes the RATTLE constraint force of one particle in its acceleration, force, and virial
+/*! \param pos Position of the particle
+    \param velmass Velocity and mass of the particle
+    \param accel Acceleration of the particle, updated
+    \param force Net force on the particle, updated
+    \param virial Six components of the net virial of the particle, updated
+    \param manifold Manifold the particle is confined to
+    \param tolerance Tolerance of the Newton iteration of the constraint
+    \param deltaT Amount of real time to step forward in one time step
+
+    The Newton iteration stops as soon as the residual is below the tolerance, and after at most 10
+    iterations.
+*/
+template<class Manifold>
+__device__ inline void rattle_include_force_particle(const Scalar3& pos,
+                                                     const Scalar4& velmass,
+                                                     Scalar3& accel,
+                                                     Scalar3& force,
+                                                     Scalar* virial,
+                                                     Manifold& manifold,
+                                                     Scalar tolerance,
+                                                     Scalar deltaT)
+    {
+    Scalar3 normal
+        = manifold.derivative(pos); // the normal vector to which the particles are confined.
+
+    Scalar3 vel = make_scalar3(velmass.x, velmass.y, velmass.z);
+
+    Scalar lambda = 0.0;
+    Scalar inv_mass = Scalar(1.0) / velmass.w;
+    Scalar deltaT_half = Scalar(1.0 / 2.0) * deltaT;
+    Scalar inv_alpha = -deltaT_half * deltaT * inv_mass;
+    inv_alpha = Scalar(1.0) / inv_alpha;
+
+    Scalar3 next_pos = pos;
+    Scalar3 residual;
+    Scalar resid;
+    Scalar3 half_vel;
+
+    const unsigned int maxiteration = 10;
+    unsigned int iteration = 0;
+    do
+        {
+        iteration++;
+        half_vel = vel + deltaT_half * accel - deltaT_half * inv_mass * lambda * normal;
+
+        residual = pos - next_pos + deltaT * half_vel;
+        resid = manifold.implicitFunction(next_pos);
+
+        Scalar3 next_normal = manifold.derivative(next_pos);
+        Scalar nndotr = dot(next_normal, residual);
+        Scalar nndotn = dot(next_normal, normal);
+        Scalar beta = (resid + nndotr) / nndotn;
+
+        next_pos = next_pos - beta * normal + residual;
+        lambda = lambda - beta * inv_alpha;
+
+        resid = fabs(resid);
+        Scalar vec_norm = sqrt(dot(residual, residual));
+        if (vec_norm > resid)
+            resid = vec_norm;
+
+        } while (resid > tolerance && iteration < maxiteration);
+
+    accel -= lambda * normal;
+
+    force -= inv_mass * lambda * normal;
+
+    virial[0] -= lambda * normal.x * pos.x;
+    virial[1] -= 0.5 * lambda * (normal.x * pos.y + normal.y * pos.x);
+    virial[2] -= 0.5 * lambda * (normal.x * pos.z + normal.z * pos.x);
+    virial[3] -= lambda * normal.y * pos.y;
+    virial[4] -= 0.5 * lambda * (normal.y * pos.z + normal.z * pos.y);
+    virial[5] -= lambda * normal.z * pos.z;
+    }
+
 //! Takes the second half-step forward in the velocity-verlet NVE integration on a group of
 //! particles
 /*! \param d_vel array of particle velocities
@@ -133,87 +332,25 @@ __global__ void gpu_rattle_nve_step_two_kernel(Scalar4* d_pos,
 
         Scalar3 pos = make_scalar3(d_pos[idx].x, d_pos[idx].y, d_pos[idx].z);
 
-        // read in the net forc and calculate the acceleration MEM TRANSFER: 16 bytes
-        Scalar3 accel = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
-
         // read the current particle velocity (MEM TRANSFER: 16 bytes)
         Scalar4 vel = d_vel[idx];
 
+        // read the net force (MEM TRANSFER: 16 bytes)
+        Scalar4 net_force = make_scalar4(0, 0, 0, 0);
         if (!zero_force)
-            {
-            Scalar4 net_force = d_net_force[idx];
-            accel = make_scalar3(net_force.x, net_force.y, net_force.z);
-            // MEM TRANSFER: 4 bytes   FLOPS: 3
-            Scalar mass = vel.w;
-            accel.x /= mass;
-            accel.y /= mass;
-            accel.z /= mass;
-            }
-
-        // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-
-        // update the velocity (FLOPS: 6)
-
-        Scalar mu = 0;
-        Scalar inv_alpha = -Scalar(1.0 / 2.0) * deltaT;
-        inv_alpha = Scalar(1.0) / inv_alpha;
-        Scalar mass = vel.w;
-        Scalar inv_mass = Scalar(1.0) / mass;
-
-        Scalar3 normal = manifold.derivative(pos);
-
-        Scalar3 next_vel;
-        next_vel.x = vel.x + Scalar(1.0 / 2.0) * deltaT * accel.x;
-        next_vel.y = vel.y + Scalar(1.0 / 2.0) * deltaT * accel.y;
-        next_vel.z = vel.z + Scalar(1.0 / 2.0) * deltaT * accel.z;
-
-        Scalar3 residual;
-        Scalar resid;
-        Scalar3 vel_dot;
-
-        const unsigned int maxiteration = 10;
-        unsigned int iteration = 0;
-        do
-            {
-            iteration++;
-            vel_dot.x = accel.x - mu * inv_mass * normal.x;
-            vel_dot.y = accel.y - mu * inv_mass * normal.y;
-            vel_dot.z = accel.z - mu * inv_mass * normal.z;
-
-            residual.x = vel.x - next_vel.x + Scalar(1.0 / 2.0) * deltaT * vel_dot.x;
-            residual.y = vel.y - next_vel.y + Scalar(1.0 / 2.0) * deltaT * vel_dot.y;
-            residual.z = vel.z - next_vel.z + Scalar(1.0 / 2.0) * deltaT * vel_dot.z;
-            resid = dot(normal, next_vel) * inv_mass;
-
-            Scalar ndotr = dot(normal, residual);
-            Scalar ndotn = dot(normal, normal);
-            Scalar beta = (mass * resid + ndotr) / ndotn;
-            next_vel.x = next_vel.x - normal.x * beta + residual.x;
-            next_vel.y = next_vel.y - normal.y * beta + residual.y;
-            next_vel.z = next_vel.z - normal.z * beta + residual.z;
-            mu = mu - mass * beta * inv_alpha;
-
-            resid = fabs(resid);
-            Scalar vec_norm = sqrt(dot(residual, residual));
-            if (vec_norm > resid)
-                resid = vec_norm;
-
-            } while (resid * mass > tolerance && iteration < maxiteration);
-
-        vel.x += (Scalar(1.0) / Scalar(2.0)) * (accel.x - mu * inv_mass * normal.x) * deltaT;
-        vel.y += (Scalar(1.0) / Scalar(2.0)) * (accel.y - mu * inv_mass * normal.y) * deltaT;
-        vel.z += (Scalar(1.0) / Scalar(2.0)) * (accel.z - mu * inv_mass * normal.z) * deltaT;
-
-        if (limit)
-            {
-            Scalar vel_len = sqrtf(vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
-            if ((vel_len * deltaT) > limit_val)
-                {
-                vel.x = vel.x / vel_len * limit_val / deltaT;
-                vel.y = vel.y / vel_len * limit_val / deltaT;
-                vel.z = vel.z / vel_len * limit_val / deltaT;
-                }
-            }
+            net_force = d_net_force[idx];
+
+        Scalar3 accel;
+        rattle_nve_step_two_particle(pos,
+                                     vel,
+                                     accel,
+                                     net_force,
+                                     manifold,
+                                     tolerance,
+                                     deltaT,
+                                     limit,
+                                     limit_val,
+                                     zero_force);
 
         // write out data (MEM TRANSFER: 32 bytes)
         d_vel[idx] = vel;
@@ -313,91 +450,38 @@ __global__ void gpu_include_rattle_force_nve_kernel(const Scalar4* d_pos,
         const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
-        // do velocity verlet update
-        // r(t+deltaT) = r(t) + v(t)*deltaT + (1/2)a(t)*deltaT^2
-        // v(t+deltaT/2) = v(t) + (1/2)a*deltaT
-
         // read the particle's position (MEM TRANSFER: 16 bytes)
         Scalar4 postype = d_pos[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
-        Scalar3 normal
-            = manifold.derivative(pos); // the normal vector to which the particles are confined.
-
         // read the particle's velocity and acceleration (MEM TRANSFER: 32 bytes)
         Scalar4 velmass = d_vel[idx];
-        Scalar3 vel = make_scalar3(velmass.x, velmass.y, velmass.z);
 
         Scalar3 accel = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
         if (!zero_force)
             accel = d_accel[idx];
 
-        // read the particle's velocity and acceleration (MEM TRANSFER: 32 bytes)
+        // read the particle's net force and virial (MEM TRANSFER: 64 bytes)
         Scalar4 forcetype = d_net_force[idx];
         Scalar3 force = make_scalar3(forcetype.x, forcetype.y, forcetype.z);
 
-        Scalar virial0 = d_net_virial[0 * net_virial_pitch + idx];
-        Scalar virial1 = d_net_virial[1 * net_virial_pitch + idx];
-        Scalar virial2 = d_net_virial[2 * net_virial_pitch + idx];
-        Scalar virial3 = d_net_virial[3 * net_virial_pitch + idx];
-        Scalar virial4 = d_net_virial[4 * net_virial_pitch + idx];
-        Scalar virial5 = d_net_virial[5 * net_virial_pitch + idx];
-
-        Scalar lambda = 0.0;
-        Scalar inv_mass = Scalar(1.0) / velmass.w;
-        Scalar deltaT_half = Scalar(1.0 / 2.0) * deltaT;
-        Scalar inv_alpha = -deltaT_half * deltaT * inv_mass;
-        inv_alpha = Scalar(1.0) / inv_alpha;
-
-        Scalar3 next_pos = pos;
-        Scalar3 residual;
-        Scalar resid;
-        Scalar3 half_vel;
-
-        const unsigned int maxiteration = 10;
-        unsigned int iteration = 0;
-        do
-            {
-            iteration++;
-            half_vel = vel + deltaT_half * accel - deltaT_half * inv_mass * lambda * normal;
-
-            residual = pos - next_pos + deltaT * half_vel;
-            resid = manifold.implicitFunction(next_pos);
-
-            Scalar3 next_normal = manifold.derivative(next_pos);
-            Scalar nndotr = dot(next_normal, residual);
-            Scalar nndotn = dot(next_normal, normal);
-            Scalar beta = (resid + nndotr) / nndotn;
-
-            next_pos = next_pos - beta * normal + residual;
-            lambda = lambda - beta * inv_alpha;
-
-            resid = fabs(resid);
-            Scalar vec_norm = sqrt(dot(residual, residual));
-            if (vec_norm > resid)
-                resid = vec_norm;
-
-            } while (resid > tolerance && iteration < maxiteration);
-
-        accel -= lambda * normal;
-
-        force -= inv_mass * lambda * normal;
+        Scalar virial[6];
+        for (unsigned int k = 0; k < 6; k++)
+            virial[k] = d_net_virial[k * net_virial_pitch + idx];
 
-        virial0 -= lambda * normal.x * pos.x;
-        virial1 -= 0.5 * lambda * (normal.x * pos.y + normal.y * pos.x);
-        virial2 -= 0.5 * lambda * (normal.x * pos.z + normal.z * pos.x);
-        virial3 -= lambda * normal.y * pos.y;
-        virial4 -= 0.5 * lambda * (normal.y * pos.z + normal.z * pos.y);
-        virial5 -= lambda * normal.z * pos.z;
+        rattle_include_force_particle(pos,
+                                      velmass,
+                                      accel,
+                                      force,
+                                      virial,
+                                      manifold,
+                                      tolerance,
+                                      deltaT);
 
         d_net_force[idx] = make_scalar4(force.x, force.y, force.z, forcetype.w);
         d_accel[idx] = accel;
-        d_net_virial[0 * net_virial_pitch + idx] = virial0;
-        d_net_virial[1 * net_virial_pitch + idx] = virial1;
-        d_net_virial[2 * net_virial_pitch + idx] = virial2;
-        d_net_virial[3 * net_virial_pitch + idx] = virial3;
-        d_net_virial[4 * net_virial_pitch + idx] = virial4;
-        d_net_virial[5 * net_virial_pitch + idx] = virial5;
+        for (unsigned int k = 0; k < 6; k++)
+            d_net_virial[k * net_virial_pitch + idx] = virial[k];
         }
     }
 
@@ -458,6 +542,155 @@ hipError_t gpu_include_rattle_force_nve(const Scalar4* d_pos,
     return hipSuccess;
     }
 
+//! Takes the second half-step of the NVE integration and adds the RATTLE force of the next step
+/*! \param d_pos array of particle positions
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_net_force Net force on each particle
+    \param d_net_virial Net virial of each particle
+    \param d_group_members Device array listing the indices of the members of the group to integrate
+    \param nwork Number of group members this GPU processes
+    \param offset Offset of this GPU in the list of group members
+    \param net_virial_pitch Pitch of the net virial array
+    \param manifold Manifold the particles are confined to
+    \param tolerance Tolerance of the Newton iteration of the constraint
+    \param deltaT Amount of real time to step forward in one time step
+    \param limit If \a limit is true, then the dynamics will be limited so that particles do not
+   move a distance further than \a limit_val in one step.
+    \param limit_val Length to limit particle distance movement to
+    \param zero_force Set to true to always assign an acceleration of 0 to the group
+
+    Performs gpu_rattle_nve_step_two_kernel() followed by gpu_include_rattle_force_nve_kernel() for
+    each particle with one read and one write of the particle data.
+*/
+template<class Manifold>
+__global__ void gpu_rattle_nve_step_two_include_force_kernel(const Scalar4* d_pos,
+                                                             Scalar4* d_vel,
+                                                             Scalar3* d_accel,
+                                                             Scalar4* d_net_force,
+                                                             Scalar* d_net_virial,
+                                                             unsigned int* d_group_members,
+                                                             const unsigned int nwork,
+                                                             const unsigned int offset,
+                                                             size_t net_virial_pitch,
+                                                             Manifold manifold,
+                                                             Scalar tolerance,
+                                                             Scalar deltaT,
+                                                             bool limit,
+                                                             Scalar limit_val,
+                                                             bool zero_force)
+    {
+    // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (work_idx < nwork)
+        {
+        const unsigned int group_idx = work_idx + offset;
+        unsigned int idx = d_group_members[group_idx];
+
+        Scalar4 postype = d_pos[idx];
+        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+        Scalar4 vel = d_vel[idx];
+        Scalar4 forcetype = d_net_force[idx];
+
+        Scalar3 accel;
+        rattle_nve_step_two_particle(pos,
+                                     vel,
+                                     accel,
+                                     forcetype,
+                                     manifold,
+                                     tolerance,
+                                     deltaT,
+                                     limit,
+                                     limit_val,
+                                     zero_force);
+
+        Scalar3 force = make_scalar3(forcetype.x, forcetype.y, forcetype.z);
+        Scalar virial[6];
+        for (unsigned int k = 0; k < 6; k++)
+            virial[k] = d_net_virial[k * net_virial_pitch + idx];
+
+        rattle_include_force_particle(pos,
+                                      vel,
+                                      accel,
+                                      force,
+                                      virial,
+                                      manifold,
+                                      tolerance,
+                                      deltaT);
+
+        d_vel[idx] = vel;
+        d_accel[idx] = accel;
+        d_net_force[idx] = make_scalar4(force.x, force.y, force.z, forcetype.w);
+        for (unsigned int k = 0; k < 6; k++)
+            d_net_virial[k * net_virial_pitch + idx] = virial[k];
+        }
+    }
+
+/*! This is just a driver for gpu_rattle_nve_step_two_include_force_kernel(), see it for details.
+ */
+template<class Manifold>
+hipError_t gpu_rattle_nve_step_two_include_force(const Scalar4* d_pos,
+                                                 Scalar4* d_vel,
+                                                 Scalar3* d_accel,
+                                                 Scalar4* d_net_force,
+                                                 Scalar* d_net_virial,
+                                                 unsigned int* d_group_members,
+                                                 const GPUPartition& gpu_partition,
+                                                 size_t net_virial_pitch,
+                                                 Manifold manifold,
+                                                 Scalar tolerance,
+                                                 Scalar deltaT,
+                                                 bool limit,
+                                                 Scalar limit_val,
+                                                 bool zero_force,
+                                                 unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr,
+                         (const void*)gpu_rattle_nve_step_two_include_force_kernel<Manifold>);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid((nwork / run_block_size) + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL((gpu_rattle_nve_step_two_include_force_kernel<Manifold>),
+                           dim3(grid),
+                           dim3(threads),
+                           0,
+                           0,
+                           d_pos,
+                           d_vel,
+                           d_accel,
+                           d_net_force,
+                           d_net_virial,
+                           d_group_members,
+                           nwork,
+                           range.first,
+                           net_virial_pitch,
+                           manifold,
+                           tolerance,
+                           deltaT,
+                           limit,
+                           limit_val,
+                           zero_force);
+        }
+
+    return hipSuccess;
+    }
+
 #endif
 
 #endif //__TWO_STEP_RATTLE_NVE_GPU_CUH__
@@ -45,7 +45,7 @@ class PYBIND11_EXPORT TwoStepRATTLENVEGPU : public TwoStepRATTLENVE<Manifold>
     //! Performs the first step of the integration
     virtual void integrateStepOne(uint64_t timestep);
 
-    //! Performs the second step of the integration
+    //! Performs the second step of the integration and includes the RATTLE force of the next step
     virtual void integrateStepTwo(uint64_t timestep);
 
     //! Includes the RATTLE forces to the virial/net force
@@ -75,6 +75,9 @@ class PYBIND11_EXPORT TwoStepRATTLENVEGPU : public TwoStepRATTLENVE<Manifold>
         m_tuner_angular_one; //!< Autotuner for block size (angular step one kernel)
     std::unique_ptr<Autotuner>
         m_tuner_angular_two; //!< Autotuner for block size (angular step two kernel)
+
+    /// True when integrateStepTwo() has included the RATTLE force of the next step
+    bool m_rattle_force_included = false;
     };
 
 /*! \file TwoStepRATTLENVEGPU.h
@@ -218,6 +221,7 @@ template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::integrateStepOne(ui
 template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::integrateStepTwo(uint64_t timestep)
     {
     const GlobalArray<Scalar4>& net_force = this->m_pdata->getNetForce();
+    const GlobalArray<Scalar>& net_virial = this->m_pdata->getNetVirial();
 
     // profile this step
     if (this->m_prof)
@@ -233,28 +237,32 @@ template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::integrateStepTwo(ui
                                  access_location::device,
                                  access_mode::readwrite);
 
-    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_net_virial(net_virial, access_location::device, access_mode::readwrite);
     ArrayHandle<unsigned int> d_index_array(this->m_group->getIndexArray(),
                                             access_location::device,
                                             access_mode::read);
 
-    // perform the update on the GPU
+    // IntegratorTwoStep calls includeRATTLEForce(timestep + 1) right after this method, include
+    // the RATTLE force of the next step in the same kernel
     this->m_exec_conf->beginMultiGPU();
     m_tuner_two->begin();
 
-    gpu_rattle_nve_step_two<Manifold>(d_pos.data,
-                                      d_vel.data,
-                                      d_accel.data,
-                                      d_index_array.data,
-                                      this->m_group->getGPUPartition(),
-                                      d_net_force.data,
-                                      this->m_manifold,
-                                      this->m_tolerance,
-                                      this->m_deltaT,
-                                      this->m_limit,
-                                      this->m_limit_val,
-                                      this->m_zero_force,
-                                      m_tuner_two->getParam());
+    gpu_rattle_nve_step_two_include_force<Manifold>(d_pos.data,
+                                                    d_vel.data,
+                                                    d_accel.data,
+                                                    d_net_force.data,
+                                                    d_net_virial.data,
+                                                    d_index_array.data,
+                                                    this->m_group->getGPUPartition(),
+                                                    net_virial.getPitch(),
+                                                    this->m_manifold,
+                                                    this->m_tolerance,
+                                                    this->m_deltaT,
+                                                    this->m_limit,
+                                                    this->m_limit_val,
+                                                    this->m_zero_force,
+                                                    m_tuner_two->getParam());
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -262,6 +270,8 @@ template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::integrateStepTwo(ui
     m_tuner_two->end();
     this->m_exec_conf->endMultiGPU();
 
+    m_rattle_force_included = true;
+
     if (this->m_aniso)
         {
         // second part of angular update
@@ -305,6 +315,13 @@ template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::integrateStepTwo(ui
 
 template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::includeRATTLEForce(uint64_t timestep)
     {
+    // integrateStepTwo() already included the force
+    if (m_rattle_force_included)
+        {
+        m_rattle_force_included = false;
+        return;
+        }
+
     // access all the needed data
     const GlobalArray<Scalar4>& net_force = this->m_pdata->getNetForce();
     const GlobalArray<Scalar>& net_virial = this->m_pdata->getNetVirial();
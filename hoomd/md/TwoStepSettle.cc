@@ -0,0 +1,340 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TwoStepSettle.h"
+#include "SettleConstraint.h"
+
+#include <atomic>
+#include <sstream>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file TwoStepSettle.cc
+    \brief Contains code for the TwoStepSettle class
+*/
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param group The group of particles this integration method is to work on
+    \param d_AB Distance between A and B (and A and C)
+    \param d_BC Distance between B and C
+*/
+TwoStepSettle::TwoStepSettle(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<ParticleGroup> group,
+                             Scalar d_AB,
+                             Scalar d_BC)
+    : IntegrationMethodTwoStep(sysdef, group), m_d_AB(d_AB), m_d_BC(d_BC),
+      m_molecules_changed(true)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing TwoStepSettle" << endl;
+
+    if (m_sysdef->getNDimensions() != 3)
+        {
+        throw std::runtime_error("SETTLE requires a 3D system");
+        }
+
+    if (m_sysdef->isDomainDecomposed())
+        {
+        throw std::runtime_error("SETTLE does not support domain decomposition");
+        }
+
+    setDistanceAB(d_AB);
+    setDistanceBC(d_BC);
+
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .connect<TwoStepSettle, &TwoStepSettle::slotGlobalParticleNumberChange>(this);
+    }
+
+TwoStepSettle::~TwoStepSettle()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying TwoStepSettle" << endl;
+
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .disconnect<TwoStepSettle, &TwoStepSettle::slotGlobalParticleNumberChange>(this);
+    }
+
+void TwoStepSettle::setDistanceAB(Scalar d_AB)
+    {
+    if (d_AB <= Scalar(0.5) * m_d_BC)
+        {
+        throw std::invalid_argument("d_OH must be larger than d_HH / 2");
+        }
+    m_d_AB = d_AB;
+    }
+
+void TwoStepSettle::setDistanceBC(Scalar d_BC)
+    {
+    if (d_BC <= Scalar(0.0) || d_BC >= Scalar(2.0) * m_d_AB)
+        {
+        throw std::invalid_argument("d_HH must be in the range (0, 2 d_OH)");
+        }
+    m_d_BC = d_BC;
+    }
+
+/*! The member tags are sorted, so whole molecules are consecutive triples of members.
+ */
+void TwoStepSettle::checkMolecules()
+    {
+    const unsigned int group_size = m_group->getNumMembers();
+    if (!m_molecules_changed && m_molecule_tags.getNumElements() == group_size)
+        return;
+
+    if (group_size % 3 != 0)
+        {
+        throw std::runtime_error("The SETTLE group must consist of whole three site molecules");
+        }
+
+    GlobalArray<unsigned int> molecule_tags(group_size, m_exec_conf);
+    m_molecule_tags.swap(molecule_tags);
+    TAG_ALLOCATION(m_molecule_tags);
+
+    ArrayHandle<unsigned int> h_molecule_tags(m_molecule_tags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+    for (unsigned int i = 0; i < group_size; i++)
+        {
+        unsigned int tag = m_group->getMemberTag(i);
+        if (i % 3 != 0 && tag != h_molecule_tags.data[i - 1] + 1)
+            {
+            std::ostringstream s;
+            s << "The sites of the SETTLE molecule starting at particle "
+              << h_molecule_tags.data[i - i % 3] << " must have consecutive tags";
+            throw std::runtime_error(s.str());
+            }
+        h_molecule_tags.data[i] = tag;
+        }
+
+    m_molecules_changed = false;
+    }
+
+/*! \param tag Tag of site A of the molecule
+ */
+void TwoStepSettle::throwSettleError(unsigned int tag)
+    {
+    std::ostringstream s;
+    s << "SETTLE failed to constrain the molecule starting at particle " << tag
+      << ", it moved too far in one step";
+    throw std::runtime_error(s.str());
+    }
+
+/*! \param timestep Current time step
+    \post Particle positions are moved forward to timestep+1 and velocities to timestep+1/2 per the
+   velocity verlet method, and the positions satisfy the constraints.
+*/
+void TwoStepSettle::integrateStepOne(uint64_t timestep)
+    {
+    checkMolecules();
+
+    // profile this step
+    if (m_prof)
+        m_prof->push("SETTLE step 1");
+
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
+                                 access_location::host,
+                                 access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_molecule_tags(m_molecule_tags,
+                                              access_location::host,
+                                              access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const unsigned int n_molecules = (unsigned int)m_molecule_tags.getNumElements() / 3;
+    std::atomic<unsigned int> failed_tag(UINT_MAX);
+
+    // v(t+deltaT/2) = v(t) + (1/2)a*deltaT, then move the sites by v(t+deltaT/2)*deltaT, constrain
+    // the displacements, and set v(t+deltaT/2) to the constrained displacement over deltaT
+    auto integrate_molecule = [&](unsigned int molecule)
+        {
+        unsigned int idx[3];
+        vec3<Scalar> v[3];
+        for (unsigned int k = 0; k < 3; k++)
+            {
+            idx[k] = h_rtag.data[h_molecule_tags.data[3 * molecule + k]];
+            v[k] = vec3<Scalar>(h_vel.data[idx[k]])
+                   + Scalar(1.0 / 2.0) * m_deltaT * vec3<Scalar>(h_accel.data[idx[k]]);
+            }
+
+        vec3<Scalar> pos_A(h_pos.data[idx[0]]);
+        vec3<Scalar> b0(box.minImage(vec_to_scalar3(vec3<Scalar>(h_pos.data[idx[1]]) - pos_A)));
+        vec3<Scalar> c0(box.minImage(vec_to_scalar3(vec3<Scalar>(h_pos.data[idx[2]]) - pos_A)));
+
+        vec3<Scalar> d[3] = {v[0] * m_deltaT, v[1] * m_deltaT, v[2] * m_deltaT};
+        SettleConstraint settle(h_vel.data[idx[0]].w, h_vel.data[idx[1]].w, m_d_AB, m_d_BC);
+        if (!settle.positions(b0, c0, d[0], d[1], d[2]))
+            failed_tag = h_molecule_tags.data[3 * molecule];
+
+        for (unsigned int k = 0; k < 3; k++)
+            {
+            unsigned int j = idx[k];
+            h_pos.data[j].x += d[k].x;
+            h_pos.data[j].y += d[k].y;
+            h_pos.data[j].z += d[k].z;
+            h_vel.data[j].x = d[k].x / m_deltaT;
+            h_vel.data[j].y = d[k].y / m_deltaT;
+            h_vel.data[j].z = d[k].z / m_deltaT;
+            box.wrap(h_pos.data[j], h_image.data[j]);
+            }
+        };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_molecules),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int i = r.begin(); i != r.end(); i++)
+                                      integrate_molecule(i);
+                              });
+        });
+#else
+    for (unsigned int i = 0; i < n_molecules; i++)
+        integrate_molecule(i);
+#endif
+
+    if (failed_tag != UINT_MAX)
+        throwSettleError(failed_tag);
+
+    // done profiling
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep Current time step
+    \post particle velocities are moved forward to timestep+1 and satisfy the constraints
+*/
+void TwoStepSettle::integrateStepTwo(uint64_t timestep)
+    {
+    checkMolecules();
+
+    // profile this step
+    if (m_prof)
+        m_prof->push("SETTLE step 2");
+
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
+                                 access_location::host,
+                                 access_mode::readwrite);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_molecule_tags(m_molecule_tags,
+                                              access_location::host,
+                                              access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const unsigned int n_molecules = (unsigned int)m_molecule_tags.getNumElements() / 3;
+
+    // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT, then remove the components along the
+    // bonds
+    auto integrate_molecule = [&](unsigned int molecule)
+        {
+        unsigned int idx[3];
+        vec3<Scalar> v[3];
+        for (unsigned int k = 0; k < 3; k++)
+            {
+            unsigned int j = h_rtag.data[h_molecule_tags.data[3 * molecule + k]];
+            idx[k] = j;
+
+            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
+            h_accel.data[j].x = h_net_force.data[j].x * minv;
+            h_accel.data[j].y = h_net_force.data[j].y * minv;
+            h_accel.data[j].z = h_net_force.data[j].z * minv;
+
+            v[k] = vec3<Scalar>(h_vel.data[j])
+                   + Scalar(1.0 / 2.0) * m_deltaT * vec3<Scalar>(h_accel.data[j]);
+            }
+
+        vec3<Scalar> pos_A(h_pos.data[idx[0]]);
+        vec3<Scalar> b(box.minImage(vec_to_scalar3(vec3<Scalar>(h_pos.data[idx[1]]) - pos_A)));
+        vec3<Scalar> c(box.minImage(vec_to_scalar3(vec3<Scalar>(h_pos.data[idx[2]]) - pos_A)));
+
+        SettleConstraint settle(h_vel.data[idx[0]].w, h_vel.data[idx[1]].w, m_d_AB, m_d_BC);
+        settle.velocities(b, c, v[0], v[1], v[2]);
+
+        for (unsigned int k = 0; k < 3; k++)
+            {
+            h_vel.data[idx[k]].x = v[k].x;
+            h_vel.data[idx[k]].y = v[k].y;
+            h_vel.data[idx[k]].z = v[k].z;
+            }
+        };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_molecules),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int i = r.begin(); i != r.end(); i++)
+                                      integrate_molecule(i);
+                              });
+        });
+#else
+    for (unsigned int i = 0; i < n_molecules; i++)
+        integrate_molecule(i);
+#endif
+
+    // done profiling
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param query_group The group of particles to compute the degrees of freedom for
+
+    Each molecule with all three sites in \a query_group has 6 degrees of freedom. Sites of
+    molecules that are only partially in \a query_group keep 3 degrees of freedom each.
+*/
+Scalar TwoStepSettle::getTranslationalDOF(std::shared_ptr<ParticleGroup> query_group)
+    {
+    checkMolecules();
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_molecule_tags(m_molecule_tags,
+                                              access_location::host,
+                                              access_mode::read);
+
+    Scalar dof = IntegrationMethodTwoStep::getTranslationalDOF(query_group);
+    const unsigned int n_molecules = (unsigned int)m_molecule_tags.getNumElements() / 3;
+    for (unsigned int i = 0; i < n_molecules; i++)
+        {
+        if (query_group->isMember(h_rtag.data[h_molecule_tags.data[3 * i]])
+            && query_group->isMember(h_rtag.data[h_molecule_tags.data[3 * i + 1]])
+            && query_group->isMember(h_rtag.data[h_molecule_tags.data[3 * i + 2]]))
+            {
+            dof -= Scalar(3.0);
+            }
+        }
+
+    return dof;
+    }
+
+void export_TwoStepSettle(py::module& m)
+    {
+    py::class_<TwoStepSettle, IntegrationMethodTwoStep, std::shared_ptr<TwoStepSettle>>(
+        m,
+        "TwoStepSettle")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      Scalar,
+                      Scalar>())
+        .def_property("d_OH", &TwoStepSettle::getDistanceAB, &TwoStepSettle::setDistanceAB)
+        .def_property("d_HH", &TwoStepSettle::getDistanceBC, &TwoStepSettle::setDistanceBC);
+    }
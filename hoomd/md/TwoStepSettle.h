@@ -0,0 +1,93 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "IntegrationMethodTwoStep.h"
+
+#ifndef __TWO_STEP_SETTLE_H__
+#define __TWO_STEP_SETTLE_H__
+
+/*! \file TwoStepSettle.h
+    \brief Declares the TwoStepSettle class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Integrates rigid three site molecules in the NVE ensemble with SETTLE
+/*! Implements velocity-verlet NVE integration of molecules with three sites A, B, and C (e.g. the
+    O, H, and H sites of a water model) held rigid by constraints on the AB, AC, and BC distances.
+    Step one constrains the positions with the analytic SETTLE algorithm and step two removes the
+    velocity components along the bonds analytically (the velocity half of RATTLE), so neither step
+    iterates. The math is in SettleConstraint.
+
+    The group must consist of whole molecules: the member tags are split into consecutive triples
+    (t, t+1, t+2) with A at t. The sites must not belong to any other integration method or
+    constraint. The constraint forces do not contribute to the virial.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT TwoStepSettle : public IntegrationMethodTwoStep
+    {
+    public:
+    //! Constructs the integration method and associates it with the system
+    TwoStepSettle(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<ParticleGroup> group,
+                  Scalar d_AB,
+                  Scalar d_BC);
+    virtual ~TwoStepSettle();
+
+    /// Get the AB (and AC) distance
+    Scalar getDistanceAB()
+        {
+        return m_d_AB;
+        }
+
+    /// Set the AB (and AC) distance
+    void setDistanceAB(Scalar d_AB);
+
+    /// Get the BC distance
+    Scalar getDistanceBC()
+        {
+        return m_d_BC;
+        }
+
+    /// Set the BC distance
+    void setDistanceBC(Scalar d_BC);
+
+    //! Performs the first step of the integration
+    virtual void integrateStepOne(uint64_t timestep);
+
+    //! Performs the second step of the integration
+    virtual void integrateStepTwo(uint64_t timestep);
+
+    //! Get the number of degrees of freedom granted to a given group
+    virtual Scalar getTranslationalDOF(std::shared_ptr<ParticleGroup> query_group);
+
+    protected:
+    Scalar m_d_AB; //!< Distance between A and B (and A and C)
+    Scalar m_d_BC; //!< Distance between B and C
+
+    GlobalArray<unsigned int> m_molecule_tags; //!< Tags of the A, B, and C sites of each molecule
+    bool m_molecules_changed; //!< True if the molecule list needs to be rebuilt
+
+    //! Rebuild the molecule list from the group when needed
+    void checkMolecules();
+
+    //! Throw when a molecule cannot be constrained
+    void throwSettleError(unsigned int tag);
+
+    private:
+    //! Flag the molecule list for a rebuild when particles are added or removed
+    void slotGlobalParticleNumberChange()
+        {
+        m_molecules_changed = true;
+        }
+    };
+
+//! Exports the TwoStepSettle class to python
+void export_TwoStepSettle(pybind11::module& m);
+
+#endif // #ifndef __TWO_STEP_SETTLE_H__
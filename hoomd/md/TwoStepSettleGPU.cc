@@ -0,0 +1,168 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TwoStepSettleGPU.h"
+#include "TwoStepSettleGPU.cuh"
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \file TwoStepSettleGPU.cc
+    \brief Contains code for the TwoStepSettleGPU class
+*/
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param group The group of particles this integration method is to work on
+    \param d_AB Distance between A and B (and A and C)
+    \param d_BC Distance between B and C
+*/
+TwoStepSettleGPU::TwoStepSettleGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<ParticleGroup> group,
+                                   Scalar d_AB,
+                                   Scalar d_BC)
+    : TwoStepSettle(sysdef, group, d_AB, d_BC), m_failed(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a TwoStepSettleGPU when CUDA is disabled" << endl;
+        throw std::runtime_error("Error initializing TwoStepSettleGPU");
+        }
+
+    // initialize autotuner
+    std::vector<unsigned int> valid_params;
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+        valid_params.push_back(block_size);
+
+    m_tuner_one.reset(new Autotuner(valid_params, 5, 100000, "settle_step_one", this->m_exec_conf));
+    m_tuner_two.reset(new Autotuner(valid_params, 5, 100000, "settle_step_two", this->m_exec_conf));
+
+    m_failed.resetFlags(0);
+    }
+
+/*! \param timestep Current time step
+    \post Particle positions are moved forward to timestep+1 and velocities to timestep+1/2 per the
+   velocity verlet method, and the positions satisfy the constraints.
+*/
+void TwoStepSettleGPU::integrateStepOne(uint64_t timestep)
+    {
+    checkMolecules();
+
+    // profile this step
+    if (m_prof)
+        m_prof->push(m_exec_conf, "SETTLE step 1");
+
+        {
+        // access all the needed data
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<int3> d_image(m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> d_molecule_tags(m_molecule_tags,
+                                                  access_location::device,
+                                                  access_mode::read);
+
+        m_tuner_one->begin();
+        gpu_settle_step_one(d_pos.data,
+                            d_vel.data,
+                            d_accel.data,
+                            d_image.data,
+                            d_rtag.data,
+                            d_molecule_tags.data,
+                            (unsigned int)m_molecule_tags.getNumElements() / 3,
+                            m_failed.getDeviceFlags(),
+                            m_pdata->getBox(),
+                            m_deltaT,
+                            m_d_AB,
+                            m_d_BC,
+                            m_tuner_one->getParam());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_one->end();
+        }
+
+    unsigned int failed = m_failed.readFlags();
+    if (failed)
+        {
+        m_failed.resetFlags(0);
+        throwSettleError(failed - 1);
+        }
+
+    // done profiling
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! \param timestep Current time step
+    \post particle velocities are moved forward to timestep+1 and satisfy the constraints
+*/
+void TwoStepSettleGPU::integrateStepTwo(uint64_t timestep)
+    {
+    checkMolecules();
+
+    // profile this step
+    if (m_prof)
+        m_prof->push(m_exec_conf, "SETTLE step 2");
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                 access_location::device,
+                                 access_mode::overwrite);
+    ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_molecule_tags(m_molecule_tags,
+                                              access_location::device,
+                                              access_mode::read);
+
+    m_tuner_two->begin();
+    gpu_settle_step_two(d_pos.data,
+                        d_vel.data,
+                        d_accel.data,
+                        d_net_force.data,
+                        d_rtag.data,
+                        d_molecule_tags.data,
+                        (unsigned int)m_molecule_tags.getNumElements() / 3,
+                        m_pdata->getBox(),
+                        m_deltaT,
+                        m_d_AB,
+                        m_d_BC,
+                        m_tuner_two->getParam());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_two->end();
+
+    // done profiling
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void export_TwoStepSettleGPU(py::module& m)
+    {
+    py::class_<TwoStepSettleGPU, TwoStepSettle, std::shared_ptr<TwoStepSettleGPU>>(
+        m,
+        "TwoStepSettleGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      Scalar,
+                      Scalar>());
+    }
@@ -0,0 +1,275 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "SettleConstraint.h"
+#include "TwoStepSettleGPU.cuh"
+#include "hoomd/VectorMath.h"
+
+#include <assert.h>
+
+/*! \file TwoStepSettleGPU.cu
+    \brief Defines GPU kernel code for SETTLE integration on the GPU. Used by TwoStepSettleGPU.
+*/
+
+//! Takes the first half-step forward and constrains the positions of rigid three site molecules
+/*! \param d_pos array of particle positions
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_image array of particle images
+    \param d_rtag array of particle indices by tag
+    \param d_molecule_tags Tags of the A, B, and C sites of each molecule
+    \param n_molecules Number of molecules
+    \param d_failed Set to the tag of site A + 1 of a molecule that could not be constrained
+    \param box Box dimensions for periodic boundary condition handling
+    \param deltaT timestep
+    \param d_AB Distance between A and B (and A and C)
+    \param d_BC Distance between B and C
+
+    This kernel must be executed with a 1D grid of any block size such that the number of threads is
+    greater than or equal to the number of molecules. Each thread updates the three sites of one
+    molecule.
+*/
+__global__ void gpu_settle_step_one_kernel(Scalar4* d_pos,
+                                           Scalar4* d_vel,
+                                           const Scalar3* d_accel,
+                                           int3* d_image,
+                                           const unsigned int* d_rtag,
+                                           const unsigned int* d_molecule_tags,
+                                           const unsigned int n_molecules,
+                                           unsigned int* d_failed,
+                                           BoxDim box,
+                                           Scalar deltaT,
+                                           Scalar d_AB,
+                                           Scalar d_BC)
+    {
+    unsigned int molecule = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (molecule >= n_molecules)
+        return;
+
+    // v(t+deltaT/2) = v(t) + (1/2)a*deltaT
+    unsigned int idx[3];
+    Scalar4 postype[3];
+    Scalar4 velmass[3];
+    vec3<Scalar> d[3];
+    for (unsigned int k = 0; k < 3; k++)
+        {
+        idx[k] = d_rtag[d_molecule_tags[3 * molecule + k]];
+        postype[k] = d_pos[idx[k]];
+        velmass[k] = d_vel[idx[k]];
+        d[k] = (vec3<Scalar>(velmass[k])
+                + (Scalar(1.0) / Scalar(2.0)) * deltaT * vec3<Scalar>(d_accel[idx[k]]))
+               * deltaT;
+        }
+
+    // constrain the displacements
+    vec3<Scalar> pos_A(postype[0]);
+    vec3<Scalar> b0(box.minImage(vec_to_scalar3(vec3<Scalar>(postype[1]) - pos_A)));
+    vec3<Scalar> c0(box.minImage(vec_to_scalar3(vec3<Scalar>(postype[2]) - pos_A)));
+
+    SettleConstraint settle(velmass[0].w, velmass[1].w, d_AB, d_BC);
+    if (!settle.positions(b0, c0, d[0], d[1], d[2]))
+        atomicMax(d_failed, d_molecule_tags[3 * molecule] + 1);
+
+    // move the sites and set v(t+deltaT/2) to the constrained displacement over deltaT
+    for (unsigned int k = 0; k < 3; k++)
+        {
+        Scalar3 pos
+            = make_scalar3(postype[k].x + d[k].x, postype[k].y + d[k].y, postype[k].z + d[k].z);
+        int3 image = d_image[idx[k]];
+        box.wrap(pos, image);
+
+        d_pos[idx[k]] = make_scalar4(pos.x, pos.y, pos.z, postype[k].w);
+        d_vel[idx[k]]
+            = make_scalar4(d[k].x / deltaT, d[k].y / deltaT, d[k].z / deltaT, velmass[k].w);
+        d_image[idx[k]] = image;
+        }
+    }
+
+/*! \param d_pos array of particle positions
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_image array of particle images
+    \param d_rtag array of particle indices by tag
+    \param d_molecule_tags Tags of the A, B, and C sites of each molecule
+    \param n_molecules Number of molecules
+    \param d_failed Set to the tag of site A + 1 of a molecule that could not be constrained
+    \param box Box dimensions for periodic boundary condition handling
+    \param deltaT timestep
+    \param d_AB Distance between A and B (and A and C)
+    \param d_BC Distance between B and C
+    \param block_size Size of the block to run
+
+    See gpu_settle_step_one_kernel() for full documentation, this function is just a driver.
+*/
+hipError_t gpu_settle_step_one(Scalar4* d_pos,
+                               Scalar4* d_vel,
+                               const Scalar3* d_accel,
+                               int3* d_image,
+                               const unsigned int* d_rtag,
+                               const unsigned int* d_molecule_tags,
+                               unsigned int n_molecules,
+                               unsigned int* d_failed,
+                               const BoxDim& box,
+                               Scalar deltaT,
+                               Scalar d_AB,
+                               Scalar d_BC,
+                               unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_settle_step_one_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // setup the grid to run the kernel
+    dim3 grid((n_molecules / run_block_size) + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    // run the kernel
+    hipLaunchKernelGGL((gpu_settle_step_one_kernel),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_pos,
+                       d_vel,
+                       d_accel,
+                       d_image,
+                       d_rtag,
+                       d_molecule_tags,
+                       n_molecules,
+                       d_failed,
+                       box,
+                       deltaT,
+                       d_AB,
+                       d_BC);
+
+    return hipSuccess;
+    }
+
+//! Takes the second half-step forward and constrains the velocities of rigid three site molecules
+/*! \param d_pos array of particle positions
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_net_force array of net forces
+    \param d_rtag array of particle indices by tag
+    \param d_molecule_tags Tags of the A, B, and C sites of each molecule
+    \param n_molecules Number of molecules
+    \param box Box dimensions for periodic boundary condition handling
+    \param deltaT timestep
+    \param d_AB Distance between A and B (and A and C)
+    \param d_BC Distance between B and C
+
+    This kernel must be executed with a 1D grid of any block size such that the number of threads is
+    greater than or equal to the number of molecules. Each thread updates the three sites of one
+    molecule.
+*/
+__global__ void gpu_settle_step_two_kernel(const Scalar4* d_pos,
+                                           Scalar4* d_vel,
+                                           Scalar3* d_accel,
+                                           const Scalar4* d_net_force,
+                                           const unsigned int* d_rtag,
+                                           const unsigned int* d_molecule_tags,
+                                           const unsigned int n_molecules,
+                                           BoxDim box,
+                                           Scalar deltaT,
+                                           Scalar d_AB,
+                                           Scalar d_BC)
+    {
+    unsigned int molecule = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (molecule >= n_molecules)
+        return;
+
+    // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
+    unsigned int idx[3];
+    Scalar mass[3];
+    vec3<Scalar> v[3];
+    for (unsigned int k = 0; k < 3; k++)
+        {
+        idx[k] = d_rtag[d_molecule_tags[3 * molecule + k]];
+        Scalar4 velmass = d_vel[idx[k]];
+        Scalar4 net_force = d_net_force[idx[k]];
+        mass[k] = velmass.w;
+
+        Scalar minv = Scalar(1.0) / velmass.w;
+        Scalar3 accel = make_scalar3(net_force.x * minv, net_force.y * minv, net_force.z * minv);
+        d_accel[idx[k]] = accel;
+
+        v[k] = vec3<Scalar>(velmass) + (Scalar(1.0) / Scalar(2.0)) * deltaT * vec3<Scalar>(accel);
+        }
+
+    // remove the velocity components along the bonds
+    vec3<Scalar> pos_A(d_pos[idx[0]]);
+    vec3<Scalar> b(box.minImage(vec_to_scalar3(vec3<Scalar>(d_pos[idx[1]]) - pos_A)));
+    vec3<Scalar> c(box.minImage(vec_to_scalar3(vec3<Scalar>(d_pos[idx[2]]) - pos_A)));
+
+    SettleConstraint settle(mass[0], mass[1], d_AB, d_BC);
+    settle.velocities(b, c, v[0], v[1], v[2]);
+
+    for (unsigned int k = 0; k < 3; k++)
+        d_vel[idx[k]] = make_scalar4(v[k].x, v[k].y, v[k].z, mass[k]);
+    }
+
+/*! \param d_pos array of particle positions
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_net_force array of net forces
+    \param d_rtag array of particle indices by tag
+    \param d_molecule_tags Tags of the A, B, and C sites of each molecule
+    \param n_molecules Number of molecules
+    \param box Box dimensions for periodic boundary condition handling
+    \param deltaT timestep
+    \param d_AB Distance between A and B (and A and C)
+    \param d_BC Distance between B and C
+    \param block_size Size of the block to run
+
+    See gpu_settle_step_two_kernel() for full documentation, this function is just a driver.
+*/
+hipError_t gpu_settle_step_two(const Scalar4* d_pos,
+                               Scalar4* d_vel,
+                               Scalar3* d_accel,
+                               const Scalar4* d_net_force,
+                               const unsigned int* d_rtag,
+                               const unsigned int* d_molecule_tags,
+                               unsigned int n_molecules,
+                               const BoxDim& box,
+                               Scalar deltaT,
+                               Scalar d_AB,
+                               Scalar d_BC,
+                               unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_settle_step_two_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // setup the grid to run the kernel
+    dim3 grid((n_molecules / run_block_size) + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    // run the kernel
+    hipLaunchKernelGGL((gpu_settle_step_two_kernel),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_pos,
+                       d_vel,
+                       d_accel,
+                       d_net_force,
+                       d_rtag,
+                       d_molecule_tags,
+                       n_molecules,
+                       box,
+                       deltaT,
+                       d_AB,
+                       d_BC);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,43 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TwoStepSettleGPU.cuh
+    \brief Declares GPU kernel code for SETTLE integration on the GPU. Used by TwoStepSettleGPU.
+*/
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+
+#ifndef __TWO_STEP_SETTLE_GPU_CUH__
+#define __TWO_STEP_SETTLE_GPU_CUH__
+
+//! Kernel driver for the first part of the SETTLE update called by TwoStepSettleGPU
+hipError_t gpu_settle_step_one(Scalar4* d_pos,
+                               Scalar4* d_vel,
+                               const Scalar3* d_accel,
+                               int3* d_image,
+                               const unsigned int* d_rtag,
+                               const unsigned int* d_molecule_tags,
+                               unsigned int n_molecules,
+                               unsigned int* d_failed,
+                               const BoxDim& box,
+                               Scalar deltaT,
+                               Scalar d_AB,
+                               Scalar d_BC,
+                               unsigned int block_size);
+
+//! Kernel driver for the second part of the SETTLE update called by TwoStepSettleGPU
+hipError_t gpu_settle_step_two(const Scalar4* d_pos,
+                               Scalar4* d_vel,
+                               Scalar3* d_accel,
+                               const Scalar4* d_net_force,
+                               const unsigned int* d_rtag,
+                               const unsigned int* d_molecule_tags,
+                               unsigned int n_molecules,
+                               const BoxDim& box,
+                               Scalar deltaT,
+                               Scalar d_AB,
+                               Scalar d_BC,
+                               unsigned int block_size);
+
+#endif //__TWO_STEP_SETTLE_GPU_CUH__
@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TwoStepSettle.h"
+
+#ifndef __TWO_STEP_SETTLE_GPU_H__
+#define __TWO_STEP_SETTLE_GPU_H__
+
+/*! \file TwoStepSettleGPU.h
+    \brief Declares the TwoStepSettleGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUFlags.h"
+
+//! Integrates rigid three site molecules in the NVE ensemble with SETTLE on the GPU
+/*! Implements the TwoStepSettle integration on the GPU with one thread per molecule.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT TwoStepSettleGPU : public TwoStepSettle
+    {
+    public:
+    //! Constructs the integration method and associates it with the system
+    TwoStepSettleGPU(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<ParticleGroup> group,
+                     Scalar d_AB,
+                     Scalar d_BC);
+    virtual ~TwoStepSettleGPU() {};
+
+    //! Performs the first step of the integration
+    virtual void integrateStepOne(uint64_t timestep);
+
+    //! Performs the second step of the integration
+    virtual void integrateStepTwo(uint64_t timestep);
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        TwoStepSettle::setAutotunerParams(enable, period);
+        m_tuner_one->setPeriod(period);
+        m_tuner_one->setEnabled(enable);
+        m_tuner_two->setPeriod(period);
+        m_tuner_two->setEnabled(enable);
+        }
+
+    private:
+    std::unique_ptr<Autotuner> m_tuner_one; //!< Autotuner for block size (step one kernel)
+    std::unique_ptr<Autotuner> m_tuner_two; //!< Autotuner for block size (step two kernel)
+    GPUFlags<unsigned int> m_failed;        //!< Tag of a molecule that failed to constrain + 1
+    };
+
+//! Exports the TwoStepSettleGPU class to python
+void export_TwoStepSettleGPU(pybind11::module& m);
+
+#endif // #ifndef __TWO_STEP_SETTLE_GPU_H__
@@ -41,85 +41,109 @@ void ZeroMomentumUpdater::update(uint64_t timestep)
     // calculate the average momentum
     assert(m_pdata);
 
-        {
-        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::readwrite);
-        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
-                                         access_location::host,
-                                         access_mode::read);
-        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
-                                        access_location::host,
-                                        access_mode::read);
-
-        // temp variables for holding the sums
-        Scalar sum_px = 0.0;
-        Scalar sum_py = 0.0;
-        Scalar sum_pz = 0.0;
-        unsigned int n = 0;
-
-        // add up the momentum of every free particle (including floppy body particles) and every
-        // central particle of a rigid body
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            {
-            if (h_body.data[i] >= MIN_FLOPPY || h_body.data[i] == h_tag.data[i])
-                {
-                Scalar mass = h_vel.data[i].w;
-                sum_px += mass * h_vel.data[i].x;
-                sum_py += mass * h_vel.data[i].y;
-                sum_pz += mass * h_vel.data[i].z;
-                n++;
-                }
-            }
+    // x, y, z hold the momentum sums and w the number of particles summed
+    Scalar4 sum_p = sumMomentum();
+    unsigned int n = (unsigned int)sum_p.w;
+    Scalar sum_px = sum_p.x;
+    Scalar sum_py = sum_p.y;
+    Scalar sum_pz = sum_p.z;
 
 #ifdef ENABLE_MPI
-        if (m_pdata->getDomainDecomposition())
-            {
-            MPI_Allreduce(MPI_IN_PLACE, &n, 1, MPI_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &sum_px,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &sum_py,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &sum_pz,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            }
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &n, 1, MPI_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &sum_px,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &sum_py,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &sum_pz,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
 #endif
 
-        // calculate the average
-        Scalar avg_px = sum_px / Scalar(n);
-        Scalar avg_py = sum_py / Scalar(n);
-        Scalar avg_pz = sum_pz / Scalar(n);
+    // calculate the average
+    Scalar avg_px = sum_px / Scalar(n);
+    Scalar avg_py = sum_py / Scalar(n);
+    Scalar avg_pz = sum_pz / Scalar(n);
 
-        // subtract this momentum from every free particle (including floppy body particles) and
-        // every central particle of a rigid body
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            {
-            if (h_body.data[i] >= MIN_FLOPPY || h_body.data[i] == h_tag.data[i])
-                {
-                Scalar mass = h_vel.data[i].w;
-                h_vel.data[i].x -= avg_px / mass;
-                h_vel.data[i].y -= avg_py / mass;
-                h_vel.data[i].z -= avg_pz / mass;
-                }
-            }
-        } // end GPUArray scope
+    removeMomentum(make_scalar3(avg_px, avg_py, avg_pz));
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \returns The momentum of the local free particles (including floppy body particles) and central
+    particles of rigid bodies in x, y, z and the number of these particles in w
+*/
+Scalar4 ZeroMomentumUpdater::sumMomentum()
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // temp variables for holding the sums
+    Scalar sum_px = 0.0;
+    Scalar sum_py = 0.0;
+    Scalar sum_pz = 0.0;
+    unsigned int n = 0;
+
+    // add up the momentum of every free particle (including floppy body particles) and every
+    // central particle of a rigid body
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        if (h_body.data[i] >= MIN_FLOPPY || h_body.data[i] == h_tag.data[i])
+            {
+            Scalar mass = h_vel.data[i].w;
+            sum_px += mass * h_vel.data[i].x;
+            sum_py += mass * h_vel.data[i].y;
+            sum_pz += mass * h_vel.data[i].z;
+            n++;
+            }
+        }
+
+    return make_scalar4(sum_px, sum_py, sum_pz, Scalar(n));
+    }
+
+/*! \param avg_p Average momentum to subtract
+ */
+void ZeroMomentumUpdater::removeMomentum(const Scalar3& avg_p)
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // subtract this momentum from every free particle (including floppy body particles) and
+    // every central particle of a rigid body
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        if (h_body.data[i] >= MIN_FLOPPY || h_body.data[i] == h_tag.data[i])
+            {
+            Scalar mass = h_vel.data[i].w;
+            h_vel.data[i].x -= avg_p.x / mass;
+            h_vel.data[i].y -= avg_p.y / mass;
+            h_vel.data[i].z -= avg_p.z / mass;
+            }
+        }
+    }
+
 void export_ZeroMomentumUpdater(py::module& m)
     {
     py::class_<ZeroMomentumUpdater, Updater, std::shared_ptr<ZeroMomentumUpdater>>(
@@ -35,6 +35,13 @@ class PYBIND11_EXPORT ZeroMomentumUpdater : public Updater
 
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
+
+    protected:
+    //! Sum the momentum of the local particles
+    virtual Scalar4 sumMomentum();
+
+    //! Subtract the average momentum from the local particles
+    virtual void removeMomentum(const Scalar3& avg_p);
     };
 
 //! Export the ZeroMomentumUpdater to python
@@ -0,0 +1,88 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.cc
+    \brief Defines the ZeroMomentumUpdaterGPU class
+*/
+
+#include "ZeroMomentumUpdaterGPU.h"
+#include "ZeroMomentumUpdaterGPU.cuh"
+
+#include <vector>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System to zero the momentum of
+ */
+ZeroMomentumUpdaterGPU::ZeroMomentumUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef)
+    : ZeroMomentumUpdater(sysdef)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cannot initialize ZeroMomentumUpdaterGPU on a CPU device.");
+        }
+
+    // initialize autotuner
+    std::vector<unsigned int> valid_params;
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+        valid_params.push_back(block_size);
+
+    m_tuner.reset(new Autotuner(valid_params, 5, 100000, "zero_momentum", this->m_exec_conf));
+    }
+
+ZeroMomentumUpdaterGPU::~ZeroMomentumUpdaterGPU() { }
+
+Scalar4 ZeroMomentumUpdaterGPU::sumMomentum()
+    {
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+
+    Scalar4 sum_p = gpu_zero_momentum_sum(m_pdata->getN(),
+                                          d_vel.data,
+                                          d_body.data,
+                                          d_tag.data,
+                                          m_exec_conf->getCachedAllocator());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    return sum_p;
+    }
+
+/*! \param avg_p Average momentum to subtract
+ */
+void ZeroMomentumUpdaterGPU::removeMomentum(const Scalar3& avg_p)
+    {
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+
+    m_tuner->begin();
+    gpu_zero_momentum_remove(m_pdata->getN(),
+                             d_vel.data,
+                             d_body.data,
+                             d_tag.data,
+                             avg_p,
+                             m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+void export_ZeroMomentumUpdaterGPU(py::module& m)
+    {
+    py::class_<ZeroMomentumUpdaterGPU,
+               ZeroMomentumUpdater,
+               std::shared_ptr<ZeroMomentumUpdaterGPU>>(m, "ZeroMomentumUpdaterGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>>());
+    }
@@ -0,0 +1,151 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ZeroMomentumUpdaterGPU.cuh"
+#include "hoomd/ParticleData.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <thrust/execution_policy.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/transform_reduce.h>
+#pragma GCC diagnostic pop
+
+/*! \file ZeroMomentumUpdaterGPU.cu
+    \brief Defines the GPU kernels used by ZeroMomentumUpdaterGPU
+*/
+
+namespace kernel
+    {
+//! Momentum of one particle and 1 in w, or zero when the particle is a constituent of a rigid body
+struct particle_momentum
+    {
+    particle_momentum(const Scalar4* _d_vel,
+                      const unsigned int* _d_body,
+                      const unsigned int* _d_tag)
+        : d_vel(_d_vel), d_body(_d_body), d_tag(_d_tag)
+        {
+        }
+
+    __device__ Scalar4 operator()(unsigned int idx) const
+        {
+        const unsigned int body = d_body[idx];
+        if (body >= MIN_FLOPPY || body == d_tag[idx])
+            {
+            const Scalar4 vel = d_vel[idx];
+            return make_scalar4(vel.w * vel.x, vel.w * vel.y, vel.w * vel.z, Scalar(1.0));
+            }
+        return make_scalar4(0, 0, 0, 0);
+        }
+
+    const Scalar4* d_vel;
+    const unsigned int* d_body;
+    const unsigned int* d_tag;
+    };
+
+//! Component-wise sum of two Scalar4 values
+struct scalar4_sum
+    {
+    __device__ Scalar4 operator()(const Scalar4& a, const Scalar4& b) const
+        {
+        return make_scalar4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+        }
+    };
+
+//! Kernel to subtract the average momentum
+/*! \param N Number of local particles
+    \param d_vel Particle velocities and masses
+    \param d_body Particle body ids
+    \param d_tag Particle tags
+    \param avg_p Average momentum to subtract
+*/
+__global__ void gpu_zero_momentum_remove_kernel(const unsigned int N,
+                                                Scalar4* d_vel,
+                                                const unsigned int* d_body,
+                                                const unsigned int* d_tag,
+                                                const Scalar3 avg_p)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int body = d_body[idx];
+    if (body >= MIN_FLOPPY || body == d_tag[idx])
+        {
+        Scalar4 vel = d_vel[idx];
+        Scalar mass = vel.w;
+        vel.x -= avg_p.x / mass;
+        vel.y -= avg_p.y / mass;
+        vel.z -= avg_p.z / mass;
+        d_vel[idx] = vel;
+        }
+    }
+    } // end namespace kernel
+
+/*! \param N Number of local particles
+    \param d_vel Particle velocities and masses
+    \param d_body Particle body ids
+    \param d_tag Particle tags
+    \param alloc Caching allocator for temporary storage
+    \returns The total momentum in x, y, z and the number of particles summed in w
+*/
+Scalar4 gpu_zero_momentum_sum(const unsigned int N,
+                              const Scalar4* d_vel,
+                              const unsigned int* d_body,
+                              const unsigned int* d_tag,
+                              CachedAllocator& alloc)
+    {
+    if (N == 0)
+        return make_scalar4(0, 0, 0, 0);
+
+    return thrust::transform_reduce(
+#ifdef __HIP_PLATFORM_HCC__
+        thrust::hip::par(alloc),
+#else
+        thrust::cuda::par(alloc),
+#endif
+        thrust::counting_iterator<unsigned int>(0),
+        thrust::counting_iterator<unsigned int>(N),
+        kernel::particle_momentum(d_vel, d_body, d_tag),
+        make_scalar4(0, 0, 0, 0),
+        kernel::scalar4_sum());
+    }
+
+/*! \param N Number of local particles
+    \param d_vel Particle velocities and masses
+    \param d_body Particle body ids
+    \param d_tag Particle tags
+    \param avg_p Average momentum to subtract
+    \param block_size Block size to execute
+*/
+hipError_t gpu_zero_momentum_remove(const unsigned int N,
+                                    Scalar4* d_vel,
+                                    const unsigned int* d_body,
+                                    const unsigned int* d_tag,
+                                    const Scalar3 avg_p,
+                                    const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)kernel::gpu_zero_momentum_remove_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1);
+
+    hipLaunchKernelGGL((kernel::gpu_zero_momentum_remove_kernel),
+                       dim3(grid),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_vel,
+                       d_body,
+                       d_tag,
+                       avg_p);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,31 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __ZERO_MOMENTUM_UPDATER_GPU_CUH__
+#define __ZERO_MOMENTUM_UPDATER_GPU_CUH__
+
+#include "hoomd/CachedAllocator.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file ZeroMomentumUpdaterGPU.cuh
+    \brief Declares the GPU kernel drivers used by ZeroMomentumUpdaterGPU
+*/
+
+//! Sum the momentum and count the free particles and central particles of rigid bodies
+Scalar4 gpu_zero_momentum_sum(const unsigned int N,
+                              const Scalar4* d_vel,
+                              const unsigned int* d_body,
+                              const unsigned int* d_tag,
+                              CachedAllocator& alloc);
+
+//! Subtract the average momentum from the free particles and central particles of rigid bodies
+hipError_t gpu_zero_momentum_remove(const unsigned int N,
+                                    Scalar4* d_vel,
+                                    const unsigned int* d_body,
+                                    const unsigned int* d_tag,
+                                    const Scalar3 avg_p,
+                                    const unsigned int block_size);
+
+#endif // __ZERO_MOMENTUM_UPDATER_GPU_CUH__
@@ -0,0 +1,56 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.h
+    \brief Declares the GPU implementation of ZeroMomentumUpdater
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ZeroMomentumUpdater.h"
+#include "hoomd/Autotuner.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __ZEROMOMENTUMUPDATER_GPU_H__
+#define __ZEROMOMENTUMUPDATER_GPU_H__
+
+//! Zeros the momentum of the system on the GPU
+/*! The momentum is summed with a device reduction and subtracted in a kernel, so only the total
+    momentum is copied to the host.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT ZeroMomentumUpdaterGPU : public ZeroMomentumUpdater
+    {
+    public:
+    //! Constructor
+    ZeroMomentumUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef);
+    virtual ~ZeroMomentumUpdaterGPU();
+
+    //! Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        ZeroMomentumUpdater::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    //! Sum the momentum of the local particles
+    virtual Scalar4 sumMomentum();
+
+    //! Subtract the average momentum from the local particles
+    virtual void removeMomentum(const Scalar3& avg_p);
+
+    private:
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
+    };
+
+//! Export the ZeroMomentumUpdaterGPU to python
+void export_ZeroMomentumUpdaterGPU(pybind11::module& m);
+
+#endif
@@ -18,9 +18,11 @@ from hoomd.md import improper
 from hoomd.md.integrate import Integrator
 from hoomd.md import long_range
 from hoomd.md import manifold
+from hoomd.md import mass
 from hoomd.md import minimize
 from hoomd.md import nlist
 from hoomd.md import pair
+from hoomd.md import tune
 from hoomd.md import update
 from hoomd.md import wall
 from hoomd.md import special_pair
@@ -87,3 +87,20 @@ template hipError_t gpu_include_rattle_force_nve<ManifoldDiamond>(const Scalar4*
                                                                   Scalar deltaT,
                                                                   bool zero_force,
                                                                   unsigned int block_size);
+
+template hipError_t gpu_rattle_nve_step_two_include_force<ManifoldDiamond>(
+    const Scalar4* d_pos,
+    Scalar4* d_vel,
+    Scalar3* d_accel,
+    Scalar4* d_net_force,
+    Scalar* d_net_virial,
+    unsigned int* d_group_members,
+    const GPUPartition& gpu_partition,
+    size_t net_virial_pitch,
+    ManifoldDiamond manifold,
+    Scalar eta,
+    Scalar deltaT,
+    bool limit,
+    Scalar limit_val,
+    bool zero_force,
+    unsigned int block_size);
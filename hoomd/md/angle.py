@@ -4,11 +4,9 @@
 
 """Angle potentials."""
 
-from hoomd.md import _md
 from hoomd.md.force import Force
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.parameterdicts import TypeParameterDict
-import hoomd
 
 
 class Angle(Force):
@@ -19,16 +17,15 @@ class Angle(Force):
         Users should not instantiate this class directly.
     """
 
+    _supports_run_on_host = True
+
     def _attach(self):
         # check that some angles are defined
         if self._simulation.state._cpp_sys_def.getAngleData().getNGlobal() == 0:
             self._simulation.device._cpp_msg.warning("No angles are defined.\n")
 
         # create the c++ mirror class
-        if isinstance(self._simulation.device, hoomd.device.CPU):
-            cpp_cls = getattr(_md, self._cpp_class_name)
-        else:
-            cpp_cls = getattr(_md, self._cpp_class_name + "GPU")
+        cpp_cls = self._cpp_class()
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def)
 
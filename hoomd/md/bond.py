@@ -23,12 +23,11 @@ class Bond(Force):
         Users should not instantiate this class directly.
     """
 
+    _supports_run_on_host = True
+
     def _attach(self):
         """Create the c++ mirror class."""
-        if isinstance(self._simulation.device, hoomd.device.CPU):
-            cpp_cls = getattr(_md, self._cpp_class_name)
-        else:
-            cpp_cls = getattr(_md, self._cpp_class_name + "GPU")
+        cpp_cls = self._cpp_class()
 
         # TODO remove string argument
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def)
@@ -8,10 +8,12 @@
 """Compute system properties."""
 
 from hoomd.md import _md
-from hoomd.operation import Compute
+from hoomd.operation import Compute, Writer
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.filter import ParticleFilter
 from hoomd.logging import log
 import hoomd
+import numpy
 
 
 class _Thermo(Compute):
@@ -354,3 +356,171 @@ class HarmonicAveragedThermodynamicQuantities(Compute):
         """Average pressure :math:`[\\mathrm{pressure}]`."""
         self._cpp_obj.compute(self._simulation.timestep)
         return self._cpp_obj.pressure
+
+
+class Correlator(Writer):
+    r"""Accumulate time correlation functions with a multiple tau correlator.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to sample.
+        pressure_tensor (bool): Correlate the off-diagonal components of the
+            pressure tensor. Defaults to `True`.
+        heat_flux (bool): Correlate the components of the heat flux. Defaults
+            to `False`.
+        msd (bool): Accumulate the mean squared displacement of the particles.
+            Defaults to `False`.
+        num_points (int): Number of points per level. Defaults to 16.
+        averaging (int): Number of values averaged into one value of the next
+            level. Defaults to 2.
+        num_levels (int): Number of levels. Defaults to 16.
+
+    `Correlator` samples the selected quantities each time it triggers and
+    accumulates their time correlation functions with the multiple tau
+    correlator of Ramirez et al. (J. Chem. Phys. 133, 154103, 2010). Level 0
+    keeps the last ``num_points`` samples. Each following level keeps the
+    averages of ``averaging`` consecutive values of the previous level, so the
+    correlation functions extend to ``num_points * averaging**(num_levels -
+    1)`` samples with a small, fixed amount of memory. Use the correlation
+    functions in Green-Kubo analyses without logging the sampled quantities
+    every step.
+
+    The quantities are:
+
+    * ``pressure_tensor``: :math:`\langle P_{\alpha\beta}(t_0)
+      P_{\alpha\beta}(t_0 + t) \rangle` averaged over the off-diagonal
+      components (:math:`xy`, :math:`xz`, :math:`yz` in 3D and :math:`xy` in
+      2D) of the pressure tensor of the selected particles.
+    * ``heat_flux``: :math:`\langle J_\alpha(t_0) J_\alpha(t_0 + t) \rangle`
+      averaged over the components of
+
+      .. math::
+
+          \vec{J} = \sum_{i \in \mathrm{filter}} \left( e_i \vec{v}_i +
+          \mathbf{W}_i \cdot \vec{v}_i \right),
+
+      where :math:`e_i` is the kinetic plus potential energy and
+      :math:`\mathbf{W}_i` the virial tensor of particle :math:`i`.
+    * ``msd``: :math:`\langle |\vec{r}_i(t_0 + t) - \vec{r}_i(t_0)|^2
+      \rangle` averaged over the selected particles, using the unwrapped
+      positions.
+
+    On the GPU, `Correlator` keeps the histories and correlation sums in device
+    memory, so sampling does not copy data to the host. The correlation
+    functions are copied to the host when they are read.
+
+    Note:
+        The lags of the correlation functions are reported in timesteps,
+        assuming that `Correlator` triggers at a fixed period. The lags at level
+        :math:`k > 0` are averages over windows of ``averaging**k`` samples.
+
+    Note:
+        `Correlator` does not support ``msd`` with MPI domain decomposition.
+
+    Examples::
+
+        correlator = hoomd.md.compute.Correlator(
+            trigger=hoomd.trigger.Periodic(1), filter=hoomd.filter.All(),
+            pressure_tensor=True, msd=True)
+        sim.operations.writers.append(correlator)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to sample.
+        pressure_tensor (bool): Correlate the off-diagonal components of the
+            pressure tensor (*read only*).
+        heat_flux (bool): Correlate the components of the heat flux
+            (*read only*).
+        msd (bool): Accumulate the mean squared displacement (*read only*).
+        num_points (int): Number of points per level (*read only*).
+        averaging (int): Number of values averaged into one value of the next
+            level (*read only*).
+        num_levels (int): Number of levels (*read only*).
+    """
+
+    def __init__(self,
+                 trigger,
+                 filter,
+                 pressure_tensor=True,
+                 heat_flux=False,
+                 msd=False,
+                 num_points=16,
+                 averaging=2,
+                 num_levels=16):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(filter=ParticleFilter,
+                          pressure_tensor=bool(pressure_tensor),
+                          heat_flux=bool(heat_flux),
+                          msd=bool(msd),
+                          num_points=int(num_points),
+                          averaging=int(averaging),
+                          num_levels=int(num_levels)))
+        self.filter = filter
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo_cls = _md.ComputeThermo
+            correlator_cls = _md.Correlator
+        else:
+            thermo_cls = _md.ComputeThermoGPU
+            correlator_cls = _md.CorrelatorGPU
+
+        sys_def = self._simulation.state._cpp_sys_def
+        group = self._simulation.state._get_group(self.filter)
+        thermo = thermo_cls(sys_def, group)
+        self._cpp_obj = correlator_cls(sys_def, group, thermo,
+                                       self.pressure_tensor, self.heat_flux,
+                                       self.msd, self.num_points,
+                                       self.averaging, self.num_levels)
+        super()._attach()
+
+    def _getattr_param(self, attr):
+        if attr == "filter":
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def reset(self):
+        """Discard the accumulated correlation functions."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+    @log(requires_run=True)
+    def num_samples(self):
+        """int: Number of samples accumulated."""
+        return self._cpp_obj.num_samples
+
+    @log(category='sequence', requires_run=True)
+    def lag(self):
+        """(*N_lags*, ) `numpy.ndarray` of ``float``: Lags of the correlation \
+        functions :math:`[\\mathrm{time\\ steps}]`."""
+        return numpy.array(self._cpp_obj.getLagSteps())
+
+    @log(category='sequence', requires_run=True)
+    def pressure_tensor_correlation(self):
+        """(*N_lags*, ) `numpy.ndarray` of ``float``: Autocorrelation of the \
+        off-diagonal pressure tensor components \
+        :math:`[\\mathrm{pressure}^2]`.
+
+        Empty when ``pressure_tensor`` is `False`.
+        """
+        return numpy.array(self._cpp_obj.getCorrelation(0))
+
+    @log(category='sequence', requires_run=True)
+    def heat_flux_correlation(self):
+        """(*N_lags*, ) `numpy.ndarray` of ``float``: Autocorrelation of the \
+        heat flux components \
+        :math:`[\\mathrm{energy}^2 \\cdot \\mathrm{velocity}^2]`.
+
+        Empty when ``heat_flux`` is `False`.
+        """
+        return numpy.array(self._cpp_obj.getCorrelation(1))
+
+    @log(category='sequence', requires_run=True)
+    def mean_squared_displacement(self):
+        """(*N_lags*, ) `numpy.ndarray` of ``float``: Mean squared \
+        displacement :math:`[\\mathrm{length}^2]`.
+
+        Empty when ``msd`` is `False`.
+        """
+        return numpy.array(self._cpp_obj.getCorrelation(2))
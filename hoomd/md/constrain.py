@@ -24,7 +24,7 @@ accounted for in `hoomd.md.ThermodynamicQuantities`.
 from hoomd.md import _md
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
 import hoomd
 from hoomd.operation import _HOOMDBaseObject
 
@@ -49,6 +49,10 @@ class Distance(Constraint):
 
     Args:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Solver for the constraint equation, ``"direct"`` or
+            ``"iterative"``.
+        iterations (int): Number of iterations of the ``"iterative"`` solver
+            per time step.
 
     `Distance` applies forces between particles to constrain the distances
     between particles to specific values. The algorithm implemented is described
@@ -94,14 +98,32 @@ class Distance(Constraint):
         issue a warning message. It does not influence the computation of the
         constraint force.
 
+    The ``"direct"`` solver factorizes the sparse matrix of the linear system.
+    It stores a dense matrix with one element per pair of constraints in the
+    domain, which limits it to small numbers of constraints. The
+    ``"iterative"`` solver applies `iterations` Jacobi iterations to the linear
+    system each time step, starting from the solution of the previous step. Its
+    cost and memory scale linearly with the number of constraints. It converges
+    when each constraint couples weakly to the constraints it shares particles
+    with, as in isolated dimers, water-like triangles, and chains with bond
+    angles well below 180 degrees.
+
     Attributes:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Solver for the constraint equation, ``"direct"`` or
+            ``"iterative"``.
+        iterations (int): Number of iterations of the ``"iterative"`` solver
+            per time step.
     """
 
     _cpp_class_name = "ForceDistanceConstraint"
 
-    def __init__(self, tolerance=1e-3):
-        self._param_dict.update(ParameterDict(tolerance=float(tolerance)))
+    def __init__(self, tolerance=1e-3, solver="direct", iterations=16):
+        self._param_dict.update(
+            ParameterDict(tolerance=float(tolerance),
+                          solver=OnlyFrom(["direct", "iterative"]),
+                          iterations=int(iterations)))
+        self.solver = solver
 
 
 class Rigid(Constraint):
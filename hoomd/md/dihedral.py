@@ -43,6 +43,8 @@ class Dihedral(Force):
         Users should not instantiate this class directly.
     """
 
+    _supports_run_on_host = True
+
     def _attach(self):
         # check that some dihedrals are defined
         if self._simulation.state._cpp_sys_def.getDihedralData().getNGlobal(
@@ -51,10 +53,7 @@ class Dihedral(Force):
                 "No dihedrals are defined.\n")
 
         # create the c++ mirror class
-        if isinstance(self._simulation.device, hoomd.device.CPU):
-            cpp_class = getattr(_md, self._cpp_class_name)
-        else:
-            cpp_class = getattr(_md, self._cpp_class_name + "GPU")
+        cpp_class = self._cpp_class()
 
         self._cpp_obj = cpp_class(self._simulation.state._cpp_sys_def)
         super()._attach()
@@ -7,8 +7,6 @@
 
 """External field potentials."""
 
-import hoomd
-from hoomd.md import _md
 from hoomd.md import force
 from hoomd.data.parameterdicts import TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
@@ -25,11 +23,10 @@ class Field(force.Force):
         Users should not instantiate this class directly.
     """
 
+    _supports_run_on_host = True
+
     def _attach(self):
-        if isinstance(self._simulation.device, hoomd.device.CPU):
-            cls = getattr(_md, self._cpp_class_name)
-        else:
-            cls = getattr(_md, self._cpp_class_name + "GPU")
+        cls = self._cpp_class()
 
         self._cpp_obj = cls(self._simulation.state._cpp_sys_def)
         super()._attach()
@@ -33,6 +33,51 @@ class Force(_HOOMDBaseObject):
     Initializes some loggable quantities.
     """
 
+    # Subclasses whose host implementation may compute while the GPU computes
+    # the other forces
+    _supports_run_on_host = False
+    _run_on_host = False
+
+    @property
+    def run_on_host(self):
+        """bool: Compute this force on the CPU while the GPU computes the \
+        other forces.
+
+        On GPU devices, the integrator launches the kernels of the other forces
+        first and then computes the forces with `run_on_host` on the host, so
+        that otherwise idle CPU cores share the work. This helps when the force
+        has little work for the GPU, such as external fields or small sets of
+        bonds. It has no effect on CPU devices. Bond, angle, dihedral, special
+        pair, and external field forces support `run_on_host`. It cannot be
+        changed after the force is attached.
+
+        Defaults to `False`.
+        """
+        return self._run_on_host
+
+    @run_on_host.setter
+    def run_on_host(self, value):
+        if self._attached:
+            raise RuntimeError("run_on_host cannot be set after scheduling.")
+        if value and not self._supports_run_on_host:
+            raise ValueError("{} does not support run_on_host.".format(
+                type(self).__name__))
+        self._run_on_host = bool(value)
+
+    def _cpp_class(self):
+        """Get the C++ class for the device, or the host class to run on host.
+        """
+        if (isinstance(self._simulation.device, hoomd.device.CPU)
+                or self._run_on_host):
+            return getattr(_md, self._cpp_class_name)
+        return getattr(_md, self._cpp_class_name + "GPU")
+
+    def _attach(self):
+        if (self._run_on_host
+                and not isinstance(self._simulation.device, hoomd.device.CPU)):
+            self._cpp_obj.overlap_host = True
+        super()._attach()
+
     @log(requires_run=True)
     def energy(self):
         """float: Total contribution to the potential energy of the system \
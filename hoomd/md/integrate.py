@@ -177,6 +177,31 @@ class Integrator(_DynamicIntegrator):
         rigid (hoomd.md.constrain.Rigid): A rigid bodies object defining the
             rigid bodies in the simulation.
 
+        overlap_ghost_update (bool): When True, pair forces compute the
+            particles without ghost neighbors while the ghost positions are
+            communicated between MPI ranks. Has no effect without domain
+            decomposition or with rigid bodies.
+
+        outer_forces (Sequence[hoomd.md.force.Force]): Sequence of forces
+            evaluated only every ``outer_period`` time steps. The default value
+            of ``None`` initializes an empty list.
+
+        outer_period (int): Number of time steps between evaluations of
+            ``outer_forces``.
+
+        deformation_rate (tuple[float, float, float, float, float, float]):
+            Velocity gradient of the box deformation ``(xx, yy, zz, xy, xz,
+            yz)`` :math:`[\\mathrm{time}^{-1}]`. The default value of ``(0, 0,
+            0, 0, 0, 0)`` leaves the box unchanged.
+
+        lees_edwards (bool): When True, apply the xy shear of
+            `deformation_rate` with Lees-Edwards boundary conditions instead of
+            tilting the box.
+
+        accumulate_net_force (bool): When True, forces that support it add
+            their contributions directly to the net force on time steps where
+            no operation reads the per-force arrays.
+
 
     Classes of the following modules can be used as elements in `methods`:
 
@@ -200,6 +225,68 @@ class Integrator(_DynamicIntegrator):
 
     - `hoomd.md.constrain`
 
+    .. rubric:: Multiple time steps
+
+    Forces that change slowly, such as the long range part of the electrostatic
+    interaction computed by `hoomd.md.long_range.pppm`, can be placed in
+    `outer_forces`. The integrator then evaluates them only on time steps that
+    are a multiple of `outer_period` and applies them as impulses: on those
+    steps their forces and torques are multiplied by `outer_period`, and on the
+    other steps they are left out. With velocity Verlet based methods this is
+    the impulse (r-RESPA) multiple time step scheme, with the inner time step
+    `dt` and the outer time step ``outer_period * dt``. Choose `outer_period`
+    well below the period of the fastest motion driven by the outer forces to
+    avoid resonances.
+
+    The potential energy and virial of the outer forces are included only on the
+    outer time steps. Log thermodynamic quantities on those steps.
+
+    .. rubric:: Net force accumulation
+
+    With ``accumulate_net_force=True``, pair potentials evaluated on the CPU
+    add their forces, energies, and virials directly to the net force instead
+    of storing them in their own arrays that the integrator sums afterwards.
+    This saves one pass over the particles per force on every time step.
+    Writers that log per-force quantities (`hoomd.write.GSD` with a logger,
+    `hoomd.write.Table`, and custom actions that set
+    ``Action.Flags.FORCE_ARRAYS``) request the per-force arrays on the time
+    steps they are triggered, and the integrator sums the forces as usual on
+    those steps. Accessing `hoomd.md.force.Force.forces` or
+    `hoomd.md.force.Force.energy` on other steps recomputes the force. Forces
+    in `outer_forces` on the outer time steps, forces evaluated on the GPU, and
+    other forces always compute their own arrays.
+
+    .. rubric:: Box deformation
+
+    A nonzero `deformation_rate` deforms the box continuously with the constant
+    velocity gradient :math:`\\nabla u` and integrates the SLLOD equations of
+    motion:
+
+    .. math::
+
+        \\dot{\\vec{r}} &= \\vec{v} + \\nabla u \\cdot \\vec{r} \\\\
+        m \\dot{\\vec{v}} &= \\vec{F} - m \\nabla u \\cdot \\vec{v}
+
+    where :math:`\\vec{v}` is the peculiar velocity stored in the particle data
+    and :math:`\\nabla u` is the upper triangular matrix with the diagonal
+    ``(xx, yy, zz)`` and the elements ``xy``, ``xz``, and ``yz`` above the
+    diagonal. For example, ``deformation_rate=(0, 0, 0, 0.1, 0, 0)`` shears
+    the system in the xy plane at the rate 0.1. The box deforms inside the
+    integration step, so the neighbor list accounts for the affine flow and
+    does not rebuild unless the particles move relative to it. When a tilt
+    factor exceeds half of the box, the integrator remaps the box to the
+    equivalent periodic lattice with the smallest tilt. Use this instead of
+    triggering `hoomd.update.BoxResize` every time step for shear and
+    extensional flows.
+
+    With ``lees_edwards=True``, the xy shear keeps the shape of the box and
+    instead displaces the periodic images along y by an offset in x
+    (Lees-Edwards boundary conditions). The offset wraps back into the box
+    without remapping, so the cell lists keep their shape for arbitrarily long
+    steady shear runs. Lees-Edwards boundary conditions require that the
+    domain decomposition does not split the box along x. `hoomd.State.box` does
+    not include the offset and setting it resets the offset to 0.
+
 
     Examples::
 
@@ -230,6 +317,26 @@ class Integrator(_DynamicIntegrator):
 
         rigid (hoomd.md.constrain.Rigid): The rigid body definition for the
             simulation associated with the integrator.
+
+        overlap_ghost_update (bool): When True, pair forces compute the
+            particles without ghost neighbors while the ghost positions are
+            communicated between MPI ranks.
+
+        outer_forces (list[hoomd.md.force.Force]): List of forces evaluated
+            every ``outer_period`` time steps.
+
+        outer_period (int): Number of time steps between evaluations of
+            ``outer_forces``.
+
+        deformation_rate (tuple[float, float, float, float, float, float]):
+            Velocity gradient of the box deformation ``(xx, yy, zz, xy, xz,
+            yz)`` :math:`[\\mathrm{time}^{-1}]`.
+
+        lees_edwards (bool): When True, apply the xy shear of
+            `deformation_rate` with Lees-Edwards boundary conditions.
+
+        accumulate_net_force (bool): When True, forces that support it add
+            their contributions directly to the net force.
     """
 
     def __init__(self,
@@ -238,23 +345,62 @@ class Integrator(_DynamicIntegrator):
                  forces=None,
                  constraints=None,
                  methods=None,
-                 rigid=None):
+                 rigid=None,
+                 overlap_ghost_update=False,
+                 outer_forces=None,
+                 outer_period=1,
+                 deformation_rate=(0, 0, 0, 0, 0, 0),
+                 lees_edwards=False,
+                 accumulate_net_force=False):
 
         super().__init__(forces, constraints, methods, rigid)
 
+        outer_forces = [] if outer_forces is None else outer_forces
+        self._outer_forces = syncedlist.SyncedList(
+            Force,
+            syncedlist._PartialGetAttr('_cpp_obj'),
+            iterable=outer_forces)
+
         self._param_dict.update(
             ParameterDict(
                 dt=float(dt),
-                integrate_rotational_dof=bool(integrate_rotational_dof)))
+                integrate_rotational_dof=bool(integrate_rotational_dof),
+                overlap_ghost_update=bool(overlap_ghost_update),
+                outer_period=int(outer_period),
+                deformation_rate=(float, float, float, float, float, float),
+                lees_edwards=bool(lees_edwards),
+                accumulate_net_force=bool(accumulate_net_force)))
+        self._param_dict.update(dict(deformation_rate=deformation_rate))
 
     def _attach(self):
         # initialize the reflected c++ class
         self._cpp_obj = _md.IntegratorTwoStep(
             self._simulation.state._cpp_sys_def, self.dt)
+        self.outer_forces._sync(self._simulation, self._cpp_obj.outer_forces)
         # Call attach from DynamicIntegrator which attaches forces,
         # constraint_forces, and methods, and calls super()._attach() itself.
         super()._attach()
 
+    def _detach(self):
+        self._outer_forces._unsync()
+        super()._detach()
+
+    @property
+    def outer_forces(self):
+        return self._outer_forces
+
+    @outer_forces.setter
+    def outer_forces(self, value):
+        _set_synced_list(self._outer_forces, value)
+
+    @property
+    def _children(self):
+        children = super()._children
+        children.extend(self.outer_forces)
+        for child in self.outer_forces:
+            children.extend(child._children)
+        return children
+
     def __setattr__(self, attr, value):
         """Hande group DOF update when setting integrate_rotational_dof."""
         super().__setattr__(attr, value)
@@ -6,11 +6,17 @@
 
 import hoomd
 from hoomd.md.force import Force
+from hoomd.data.typeconverter import OnlyFrom
 import math
 import numpy
 
 
-def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
+def make_pppm_coulomb_forces(nlist,
+                             resolution,
+                             order,
+                             r_cut,
+                             alpha=0,
+                             differentiation='ik'):
     """Long range Coulomb interactions evaluated using the PPPM method.
 
     Args:
@@ -23,6 +29,8 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
           space terms :math:`\\mathrm{[length]}`.
         alpha (float): Debye screening parameter
           :math:`\\mathrm{[length^{-1}]}`.
+        differentiation (str): Method used to compute the forces from the
+          mesh, either ``'ik'`` or ``'ad'``.
 
     Evaluate the potential energy :math:`U_\\mathrm{coulomb}` and apply
     the corresponding forces to the particles in the simulation.
@@ -79,6 +87,24 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
         In MPI simulations with multiple ranks, the grid resolution must be a
         power of two in each dimension.
 
+    With ``differentiation='ik'``, the reciprocal space term computes the
+    electric field on the mesh in Fourier space and performs three inverse
+    FFTs. With ``differentiation='ad'``, it computes the potential on the mesh
+    with a single inverse FFT and interpolates the forces with the gradient of
+    the assignment function. ``'ad'`` uses the optimal influence function for
+    analytic differentiation and requires ``order >= 2``. It reduces the FFT
+    cost and communication by a factor of three, but does not subtract the
+    self force, so the force on a single particle fluctuates slightly with its
+    position relative to the mesh. See `Stern, H. and Calkins, K. 2008`_.
+
+    Tip:
+        In MPI simulations on many ranks, the all-to-all communication of the
+        distributed FFT can take longer than the real space forces. The
+        reciprocal space force changes slowly, so add ``reciprocal_space_force``
+        to `hoomd.md.Integrator.outer_forces` to compute it only every
+        `hoomd.md.Integrator.outer_period` steps. Add ``real_space_force``
+        to `hoomd.md.Integrator.forces`.
+
     Returns:
         ``real_space_force``, ``reciprocal_space_force``
 
@@ -95,6 +121,8 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
     .. _D. LeBard et. al. 2012: http://dx.doi.org/10.1039/c1sm06787g
 
     .. _Salin, G and Caillol, J. 2000: http://dx.doi.org/10.1063/1.1326477
+
+    .. _Stern, H. and Calkins, K. 2008: https://doi.org/10.1063/1.2899186
     """
     real_space_force = hoomd.md.pair.Ewald(nlist)
 
@@ -108,11 +136,124 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
                                      order=order,
                                      r_cut=r_cut,
                                      alpha=0,
-                                     pair_force=real_space_force)
+                                     pair_force=real_space_force,
+                                     differentiation=differentiation)
 
     return real_space_force, reciprocal_space_force
 
 
+def tune_pppm_coulomb_parameters(simulation,
+                                 nlist,
+                                 accuracy,
+                                 r_cut,
+                                 order=(5, 6, 7),
+                                 steps=200,
+                                 max_resolution=512):
+    """Choose the fastest PPPM parameters that meet a target accuracy.
+
+    Args:
+        simulation (`hoomd.Simulation`): Simulation to tune the parameters for.
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        accuracy (float): Target RMS force error
+          :math:`\\mathrm{[force]}`.
+        r_cut (list[float]): Candidate cutoff distances between the real
+          space and reciprocal space terms :math:`\\mathrm{[length]}`.
+        order (list[int]): Candidate assignment orders
+          :math:`\\mathrm{[dimensionless]}`.
+        steps (int): Number of time steps to time each candidate.
+        max_resolution (int): Largest number of grid points to consider in
+          each direction :math:`\\mathrm{[dimensionless]}`.
+
+    For each combination of ``r_cut`` and ``order``, the error estimate that
+    `make_pppm_coulomb_forces` uses to choose the splitting parameter selects
+    the coarsest grid resolution that meets ``accuracy``. A larger ``r_cut``
+    moves work from the reciprocal space term to the real space term and allows
+    a coarser grid. `tune_pppm_coulomb_parameters` then times both forces for
+    each candidate in ``simulation`` on the current device and returns the
+    fastest.
+
+    Returns:
+        dict: The ``resolution``, ``order``, and ``r_cut`` keyword arguments
+        for `make_pppm_coulomb_forces`.
+
+    Example::
+
+        params = hoomd.md.long_range.pppm.tune_pppm_coulomb_parameters(
+            simulation=sim,
+            nlist=nlist,
+            accuracy=1e-4,
+            r_cut=[2.0, 2.5, 3.0, 3.5])
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist, **params)
+
+    Note:
+        The timing runs replace the integrator of ``simulation`` with one
+        that computes only the candidate forces and does not move the
+        particles. `tune_pppm_coulomb_parameters` restores the original
+        integrator when it completes, but the other operations in
+        ``simulation`` execute during the timing runs and the time step
+        advances. Call it before adding writers to ``simulation``.
+
+    Note:
+        The GPU kernel autotuners are still active during short timing runs.
+        Increase ``steps`` when candidates have similar performance.
+    """
+    state = simulation.state
+    box = state.box
+    L = (box.Lx, box.Ly, box.Lz)
+    N = state.N_particles
+
+    snapshot = state.get_snapshot()
+    q2 = 0.0
+    if snapshot.communicator.rank == 0:
+        q2 = float(numpy.sum(snapshot.particles.charge**2))
+    q2 = float(
+        hoomd._hoomd.mpi_bcast_str(repr(q2),
+                                   simulation.device._cpp_exec_conf))
+
+    if q2 == 0.0:
+        raise ValueError("The system has no charged particles.")
+
+    # the distributed FFT requires power of two meshes
+    sizes = _mesh_sizes(max_resolution,
+                        simulation.device.communicator.num_ranks > 1)
+
+    candidates = []
+    for rc in r_cut:
+        for o in order:
+            resolution = _coarsest_resolution(L, sizes, N, o, q2, rc,
+                                              accuracy)
+            if resolution is not None:
+                candidates.append(dict(resolution=resolution, order=o,
+                                       r_cut=rc))
+
+    if len(candidates) == 0:
+        raise RuntimeError("No PPPM parameters meet the target accuracy.")
+
+    original_integrator = simulation.operations.integrator
+    times = []
+    try:
+        for params in candidates:
+            real_space_force, reciprocal_space_force = \
+                make_pppm_coulomb_forces(nlist=nlist, **params)
+            integrator = hoomd.md.Integrator(
+                dt=0.005, forces=[real_space_force, reciprocal_space_force])
+            simulation.operations.integrator = integrator
+
+            # build the neighbor list and meshes before timing
+            simulation.run(1)
+            simulation.run(steps)
+            times.append(simulation.walltime)
+    finally:
+        simulation.operations.integrator = original_integrator
+
+    # choose on the root rank so that all ranks agree
+    best = int(
+        hoomd._hoomd.mpi_bcast_str(str(int(numpy.argmin(times))),
+                                   simulation.device._cpp_exec_conf))
+    return candidates[best]
+
+
 class Coulomb(Force):
     """Reciprocal space part of the PPPM Coulomb forces.
 
@@ -130,21 +271,33 @@ class Coulomb(Force):
           space terms :math:`\\mathrm{[length]}`.
         alpha (float): Debye screening parameter
           :math:`\\mathrm{[length^{-1}]}`.
+        differentiation (str): Method used to compute the forces from the
+          mesh, either ``'ik'`` or ``'ad'``.
     """
 
-    def __init__(self, nlist, resolution, order, r_cut, alpha, pair_force):
+    def __init__(self,
+                 nlist,
+                 resolution,
+                 order,
+                 r_cut,
+                 alpha,
+                 pair_force,
+                 differentiation='ik'):
         self._nlist = hoomd.data.typeconverter.OnlyTypes(
             hoomd.md.nlist.NList)(nlist)
         self._param_dict.update(
             hoomd.data.parameterdicts.ParameterDict(resolution=(int, int, int),
                                                     order=int,
                                                     r_cut=float,
-                                                    alpha=float))
+                                                    alpha=float,
+                                                    differentiation=OnlyFrom(
+                                                        ['ik', 'ad'])))
 
         self.resolution = resolution
         self.order = order
         self.r_cut = r_cut
         self.alpha = alpha
+        self.differentiation = differentiation
         self._pair_force = pair_force
 
     def _attach(self):
@@ -183,42 +336,7 @@ class Coulomb(Force):
         Ly = box.Ly
         Lz = box.Lz
 
-        hx = Lx / Nx
-        hy = Ly / Ny
-        hz = Lz / Nz
-
-        gew1 = 0.0
-        kappa = gew1
-        f = _diffpr(hx, hy, hz, Lx, Ly, Lz, N, order, kappa, q2, rcut)
-        hmin = min(hx, hy, hz)
-        gew2 = 10.0 / hmin
-        kappa = gew2
-        fmid = _diffpr(hx, hy, hz, Lx, Ly, Lz, N, order, kappa, q2, rcut)
-
-        if f * fmid >= 0.0:
-            raise RuntimeError("Cannot compute PPPM Coloumb forces,\n"
-                               "f*fmid >= 0.0")
-
-        if f < 0.0:
-            dgew = gew2 - gew1
-            rtb = gew1
-        else:
-            dgew = gew1 - gew2
-            rtb = gew2
-
-        ncount = 0
-
-        # iteratively compute kappa to minimize the error
-        while math.fabs(dgew) > 0.00001 and fmid != 0.0:
-            dgew *= 0.5
-            kappa = rtb + dgew
-            fmid = _diffpr(hx, hy, hz, Lx, Ly, Lz, N, order, kappa, q2, rcut)
-            if fmid <= 0.0:
-                rtb = kappa
-            ncount += 1
-            if ncount > 10000.0:
-                raise RuntimeError("Cannot compute PPPM\n"
-                                   "kappa is not converging")
+        kappa = _kappa(Lx, Ly, Lz, Nx, Ny, Nz, N, order, q2, rcut)
 
         # set parameters
         particle_types = self._simulation.state.particle_types
@@ -260,8 +378,58 @@ class Coulomb(Force):
         return [self.nlist]
 
 
+def _kappa(Lx, Ly, Lz, Nx, Ny, Nz, N, order, q2, rcut):
+    """Compute the splitting parameter that balances the estimated errors."""
+    hx = Lx / Nx
+    hy = Ly / Ny
+    hz = Lz / Nz
+
+    gew1 = 0.0
+    kappa = gew1
+    f = _diffpr(hx, hy, hz, Lx, Ly, Lz, N, order, kappa, q2, rcut)
+    hmin = min(hx, hy, hz)
+    gew2 = 10.0 / hmin
+    kappa = gew2
+    fmid = _diffpr(hx, hy, hz, Lx, Ly, Lz, N, order, kappa, q2, rcut)
+
+    if f * fmid >= 0.0:
+        raise RuntimeError("Cannot compute PPPM Coloumb forces,\n"
+                           "f*fmid >= 0.0")
+
+    if f < 0.0:
+        dgew = gew2 - gew1
+        rtb = gew1
+    else:
+        dgew = gew1 - gew2
+        rtb = gew2
+
+    ncount = 0
+
+    # iteratively compute kappa to minimize the error
+    while math.fabs(dgew) > 0.00001 and fmid != 0.0:
+        dgew *= 0.5
+        kappa = rtb + dgew
+        fmid = _diffpr(hx, hy, hz, Lx, Ly, Lz, N, order, kappa, q2, rcut)
+        if fmid <= 0.0:
+            rtb = kappa
+        ncount += 1
+        if ncount > 10000.0:
+            raise RuntimeError("Cannot compute PPPM\n"
+                               "kappa is not converging")
+
+    return kappa
+
+
 def _diffpr(hx, hy, hz, xprd, yprd, zprd, N, order, kappa, q2, rcut):
     """Part of the algorithm that computes the estimated error of the method."""
+    kspace_prec, real_prec = _prec(hx, hy, hz, xprd, yprd, zprd, N, order,
+                                   kappa, q2, rcut)
+    value = kspace_prec - real_prec
+    return value
+
+
+def _prec(hx, hy, hz, xprd, yprd, zprd, N, order, kappa, q2, rcut):
+    """Estimate the reciprocal and real space RMS force errors."""
     lprx = _rms(hx, xprd, N, order, kappa, q2)
     lpry = _rms(hy, yprd, N, order, kappa, q2)
     lprz = _rms(hz, zprd, N, order, kappa, q2)
@@ -269,8 +437,58 @@ def _diffpr(hx, hy, hz, xprd, yprd, zprd, N, order, kappa, q2, rcut):
                             + lprz * lprz) / math.sqrt(3.0)
     real_prec = 2.0 * q2 * math.exp(-kappa * kappa * rcut * rcut) / math.sqrt(
         N * rcut * xprd * yprd * zprd)
-    value = kspace_prec - real_prec
-    return value
+    return kspace_prec, real_prec
+
+
+def _estimate_error(L, resolution, N, order, q2, rcut):
+    """Estimate the total RMS force error of a PPPM parameter set."""
+    Lx, Ly, Lz = L
+    Nx, Ny, Nz = resolution
+    kappa = _kappa(Lx, Ly, Lz, Nx, Ny, Nz, N, order, q2, rcut)
+    kspace_prec, real_prec = _prec(Lx / Nx, Ly / Ny, Lz / Nz, Lx, Ly, Lz, N,
+                                   order, kappa, q2, rcut)
+    return math.sqrt(kspace_prec * kspace_prec + real_prec * real_prec)
+
+
+def _mesh_sizes(max_resolution, power_of_two):
+    """List the FFT friendly mesh sizes up to max_resolution."""
+    sizes = []
+    for n in range(2, max_resolution + 1):
+        if power_of_two:
+            if n & (n - 1) == 0:
+                sizes.append(n)
+            continue
+
+        # sizes with only the prime factors 2, 3, and 5
+        m = n
+        for p in (2, 3, 5):
+            while m % p == 0:
+                m //= p
+        if m == 1:
+            sizes.append(n)
+    return sizes
+
+
+def _coarsest_resolution(L, sizes, N, order, q2, rcut, accuracy):
+    """Find the coarsest mesh that meets the accuracy, or None."""
+    L_max = max(L)
+    for n in sizes:
+        # use the same mesh spacing in all directions
+        resolution = []
+        for length in L:
+            target = n * length / L_max
+            resolution.append(next((m for m in sizes if m >= target), None))
+        if None in resolution:
+            return None
+
+        try:
+            error = _estimate_error(L, resolution, N, order, q2, rcut)
+        except RuntimeError:
+            continue
+
+        if error <= accuracy:
+            return tuple(resolution)
+    return None
 
 
 def _rms(h, prd, N, order, kappa, q2):
@@ -13,6 +13,7 @@ from hoomd.md.force import Force
 from hoomd.md.nlist import NList
 
 validate_nlist = OnlyTypes(NList)
+validate_model = OnlyTypes(_md.MLModel)
 
 
 class Triplet(Force):
@@ -457,3 +458,78 @@ class SquareDensity(Triplet):
         params = TypeParameter('params', 'particle_types',
                                TypeParameterDict(A=0.0, B=float, len_keys=2))
         self._add_typeparam(params)
+
+
+class MLPotential(Force):
+    r"""Machine learned interatomic potential.
+
+    Args:
+        nlist (:py:class:`hoomd.md.nlist.NList`): Neighbor list
+        model (hoomd.md._md.MLModel): Model backend.
+
+    :py:class:`MLPotential` computes forces, energies, and virials with a
+    machine learned interatomic potential. The model is a C++ object that
+    derives from ``hoomd.md._md.MLModel``. Plugins provide models that evaluate
+    TorchScript, ONNX, or other inference formats. HOOMD-blue does not depend
+    on any inference library.
+
+    The model receives the particle positions and the neighbor list of all
+    local particles in one batch, without copies. On the GPU, the model
+    receives device memory when it supports it and host memory otherwise.
+    :py:class:`MLPotential` adds the cutoff radius of the model to ``nlist``
+    and switches ``nlist`` to full storage.
+
+    With MPI domain decomposition, the ghost layer covers the interaction range
+    of the model (which exceeds the cutoff radius for message passing models)
+    and the forces on ghost particles are sent back to the ranks that own them.
+
+    Warning:
+        Currently HOOMD does not support reverse force communication between MPI
+        domains on the GPU. Attempting to use this potential on the GPU with
+        MPI will result in an error.
+
+    Example::
+
+        nl = nlist.Cell(buffer=0.4)
+        mlp = md.many_body.MLPotential(nl, model=plugin.TorchModel('model.pt'))
+    """
+
+    def __init__(self, nlist, model):
+        self._nlist = validate_nlist(nlist)
+        self._model = validate_model(model)
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+        if not self.nlist._attached:
+            self.nlist._attach()
+
+        self._cpp_obj = _md.MLPotential(self._simulation.state._cpp_sys_def,
+                                        self.nlist._cpp_obj, self._model)
+
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """Neighbor list used to find the neighbors of each particle."""
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        else:
+            self._nlist = validate_nlist(value)
+
+    @property
+    def model(self):
+        """Model backend."""
+        return self._model
+
+    @property
+    def _children(self):
+        return [self._nlist]
@@ -0,0 +1,102 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Particle mass utilities.
+
+Hydrogen mass repartitioning moves mass from heavy atoms to the hydrogen atoms
+bonded to them. The total mass of each molecule is unchanged, so the
+equilibrium properties are unchanged, while the fastest bond vibrations slow
+down enough to roughly double the stable time step.
+"""
+
+import hoomd
+import numpy
+
+
+def repartition_hydrogen_mass(target, hydrogen_types=('H',), factor=3.0):
+    """Repartition the hydrogen masses along bonds.
+
+    Args:
+        target (`hoomd.Snapshot` or `hoomd.State`): System to modify.
+        hydrogen_types (list[str]): Names of the hydrogen particle types.
+        factor (float): Ratio of the new to the old hydrogen mass.
+
+    `repartition_hydrogen_mass` multiplies the mass of each particle with one
+    of the `hydrogen_types` by `factor` and subtracts the added mass from the
+    one particle of another type bonded to it. It modifies a `hoomd.Snapshot`
+    in place. When given a `hoomd.State`, it takes a snapshot, modifies it, and
+    restores the state from it. Apply it only once to a given system.
+
+    Important:
+        The fastest remaining motions are the bond vibrations of the heavy
+        atoms. Combine `repartition_hydrogen_mass` with
+        `hoomd.md.constrain.Distance` constraints on the bonds to hydrogen atoms
+        to reach time steps of about 4 fs.
+
+    Raises:
+        ValueError: When a hydrogen is not bonded to exactly one heavy atom or
+            a heavy atom would be left with a mass that is not positive.
+
+    Example::
+
+        snapshot = hoomd.Snapshot.from_gsd_snapshot(frame,
+                                                    device.communicator)
+        hoomd.md.mass.repartition_hydrogen_mass(snapshot,
+                                                hydrogen_types=['H', 'HW'])
+        sim.create_state_from_snapshot(snapshot)
+
+    Returns:
+        `hoomd.Snapshot` or `hoomd.State`: ``target``.
+    """
+    if factor <= 0:
+        raise ValueError("factor must be positive")
+
+    if isinstance(target, hoomd.State):
+        snapshot = target.get_snapshot()
+        _repartition_snapshot(snapshot, hydrogen_types, factor)
+        target.set_snapshot(snapshot)
+    else:
+        _repartition_snapshot(target, hydrogen_types, factor)
+
+    return target
+
+
+def _repartition_snapshot(snapshot, hydrogen_types, factor):
+    """Repartition the hydrogen masses in a snapshot on rank 0."""
+    if snapshot.communicator.rank != 0:
+        return
+
+    particles = snapshot.particles
+    hydrogen_typeids = [
+        particles.types.index(t) for t in hydrogen_types if t in particles.types
+    ]
+    is_hydrogen = numpy.isin(particles.typeid, hydrogen_typeids)
+    if not numpy.any(is_hydrogen):
+        return
+
+    # map each hydrogen to the heavy atom bonded to it
+    group = numpy.array(snapshot.bonds.group, dtype=numpy.int64).reshape(-1, 2)
+    heavy = numpy.full(particles.N, -1, dtype=numpy.int64)
+    n_heavy = numpy.zeros(particles.N, dtype=numpy.int64)
+    for h, other in ((group[:, 0], group[:, 1]), (group[:, 1], group[:, 0])):
+        bonded = is_hydrogen[h] & ~is_hydrogen[other]
+        heavy[h[bonded]] = other[bonded]
+        numpy.add.at(n_heavy, h[bonded], 1)
+
+    bad = numpy.flatnonzero(is_hydrogen & (n_heavy != 1))
+    if len(bad) > 0:
+        raise ValueError(f"Hydrogen {bad[0]} must be bonded to exactly one "
+                         f"heavy atom, found {n_heavy[bad[0]]}")
+
+    hydrogens = numpy.flatnonzero(is_hydrogen)
+    mass = numpy.array(particles.mass, dtype=numpy.float64)
+    delta = mass[hydrogens] * (factor - 1)
+    mass[hydrogens] += delta
+    numpy.subtract.at(mass, heavy[hydrogens], delta)
+
+    if numpy.any(mass[heavy[hydrogens]] <= 0):
+        raise ValueError("Repartitioning leaves a heavy atom with a mass that "
+                         "is not positive, use a smaller factor")
+
+    particles.mass[:] = mass
@@ -195,6 +195,9 @@ class NPT(Method):
         gamma (`float`): Dimensionless damping factor for the box degrees of
             freedom, Default to 0.
 
+        barostat_period (`int`): Number of time steps between barostat
+            updates, Default to 1.
+
     `NPT` performs constant pressure, constant temperature simulations,
     allowing for a fully deformable simulation box.
 
@@ -275,6 +278,12 @@ class NPT(Method):
     Access these quantities using `translational_thermostat_dof`,
     `rotational_thermostat_dof`, and `barostat_dof`.
 
+    `NPT` updates the barostat on time steps that are multiples of
+    `barostat_period` with a time step of ``barostat_period * dt`` and keeps the
+    box degrees of freedom fixed in between. The force computes only evaluate
+    the virial on the barostat steps, which makes the intermediate steps
+    faster. Choose `barostat_period` much smaller than ``tauS / dt``.
+
     Note:
         Coupling constant for barostat `tauS` should be set within appropriate
         range for pressure and volume to fluctuate in reasonable rate and
@@ -331,6 +340,8 @@ class NPT(Method):
         gamma (float): Dimensionless damping factor for the box degrees of
             freedom.
 
+        barostat_period (int): Number of time steps between barostat updates.
+
         translational_thermostat_dof (tuple[float, float]): Additional degrees
             of freedom for the translational thermostat (:math:`\xi`,
             :math:`\eta`)
@@ -354,7 +365,8 @@ class NPT(Method):
                  couple,
                  box_dof=[True, True, True, False, False, False],
                  rescale_all=False,
-                 gamma=0.0):
+                 gamma=0.0,
+                 barostat_period=1):
 
         # store metadata
         param_dict = ParameterDict(filter=ParticleFilter,
@@ -369,6 +381,7 @@ class NPT(Method):
                                    ] * 6,
                                    rescale_all=bool(rescale_all),
                                    gamma=float(gamma),
+                                   barostat_period=int(barostat_period),
                                    translational_thermostat_dof=(float, float),
                                    rotational_thermostat_dof=(float, float),
                                    barostat_dof=(float, float, float, float,
@@ -1224,3 +1237,90 @@ class OverdampedViscous(Method):
 
         # Attach param_dict and typeparam_dict
         super()._attach()
+
+
+class Settle(Method):
+    r"""NVE integration of rigid three site molecules with SETTLE.
+
+    Args:
+        filter (`hoomd.filter.ParticleFilter`): Subset of particles on which to
+            apply this method. Must select whole molecules.
+
+        d_OH (`float`): Distance between the first site and each of the other
+            two sites :math:`[\mathrm{length}]`.
+
+        d_HH (`float`): Distance between the second and the third site
+            :math:`[\mathrm{length}]`.
+
+    `Settle` integrates rigid three site molecules, such as the O, H, and H
+    sites of a rigid water model, with the Velocity-Verlet method. After each
+    position update, `Settle` constrains the three distances with the analytic
+    SETTLE algorithm (`Miyamoto and Kollman 1992
+    <https://doi.org/10.1002/jcc.540130805>`__) and after each velocity update
+    it removes the velocity components along the bonds analytically, as in
+    RATTLE. Neither step iterates, so the constraints hold to machine precision
+    at a fixed cost per molecule.
+
+    The particles selected by `filter` form the molecules in tag order: each
+    molecule is three consecutive tags :math:`(t, t+1, t+2)` where :math:`t` is
+    the O site. The two H sites must have the same mass. Each molecule has 6
+    translational degrees of freedom.
+
+    Do not apply any other integration method or constraint to the
+    particles in `filter`. Exclude the intramolecular pairs from the pair
+    potentials, for example by adding bonds between the sites and excluding
+    them in the neighbor list.
+
+    Note:
+        The constraint forces do not contribute to the virial, so the pressure
+        computed by `hoomd.md.compute.ThermodynamicQuantities` omits them.
+
+    Note:
+        `Settle` does not support MPI domain decomposition.
+
+    Examples::
+
+        settle = hoomd.md.methods.Settle(filter=hoomd.filter.All(),
+                                         d_OH=0.9572, d_HH=1.5139)
+        integrator = hoomd.md.Integrator(dt=0.001, methods=[settle],
+                                         forces=[lj])
+
+    Attributes:
+        filter (hoomd.filter.ParticleFilter): Subset of particles on which to
+            apply this method.
+
+        d_OH (float): Distance between the first site and each of the other
+            two sites :math:`[\mathrm{length}]`.
+
+        d_HH (float): Distance between the second and the third site
+            :math:`[\mathrm{length}]`.
+    """
+
+    def __init__(self, filter, d_OH, d_HH):
+
+        # store metadata
+        param_dict = ParameterDict(
+            filter=ParticleFilter,
+            d_OH=float,
+            d_HH=float,
+        )
+        param_dict.update(dict(filter=filter, d_OH=d_OH, d_HH=d_HH))
+
+        # set defaults
+        self._param_dict.update(param_dict)
+
+    def _attach(self):
+
+        sim = self._simulation
+        # initialize the reflected c++ class
+        if isinstance(sim.device, hoomd.device.CPU):
+            self._cpp_obj = _md.TwoStepSettle(sim.state._cpp_sys_def,
+                                              sim.state._get_group(self.filter),
+                                              self.d_OH, self.d_HH)
+        else:
+            self._cpp_obj = _md.TwoStepSettleGPU(
+                sim.state._cpp_sys_def, sim.state._get_group(self.filter),
+                self.d_OH, self.d_HH)
+
+        # Attach param_dict and typeparam_dict
+        super()._attach()
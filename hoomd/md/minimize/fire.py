@@ -70,6 +70,9 @@ class FIRE(_DynamicIntegrator):
         min_steps_conv (int):
             A minimum number of attempts before convergence criteria are
             considered.
+        stop_when_converged (bool):
+            When True, `Simulation.run <hoomd.Simulation.run>` returns on the
+            step the minimization converges.
 
     `minimize.FIRE` is an `md.Integrator` that uses the Fast Inertial Relaxation
     Engine (FIRE) algorithm to minimize the potential energy for a group of
@@ -131,6 +134,21 @@ class FIRE(_DynamicIntegrator):
         while not(fire.converged):
            sim.run(100)
 
+    Set `stop_when_converged` to relax many configurations of the same system
+    one after another with a single `Simulation` and set of operations. Each
+    call to `Simulation.run <hoomd.Simulation.run>` returns as soon as the
+    configuration converges or after ``steps`` steps::
+
+        fire = md.minimize.FIRE(dt=0.05, stop_when_converged=True)
+        fire.methods.append(md.methods.NVE(hoomd.filter.All()))
+        sim.operations.integrator = fire
+        for snapshot in snapshots:
+            sim.state.set_snapshot(snapshot)
+            fire.reset()
+            sim.run(10000)
+            converged.append(fire.converged)
+            energies.append(fire.energy)
+
     Note:
         The `minimire.FIRE` class should be used as the integrator for
         simulations, just as the standard `md.Integrator` class is (see
@@ -197,6 +215,9 @@ class FIRE(_DynamicIntegrator):
         min_steps_conv (int):
             A minimum number of attempts before convergence criteria are
             considered.
+        stop_when_converged (bool):
+            When True, `Simulation.run <hoomd.Simulation.run>` returns on the
+            step the minimization converges.
 
     """
     _cpp_class_name = "FIREEnergyMinimizer"
@@ -216,7 +237,8 @@ class FIRE(_DynamicIntegrator):
                  force_tol=0.1,
                  angmom_tol=0.1,
                  energy_tol=1e-5,
-                 min_steps_conv=10):
+                 min_steps_conv=10,
+                 stop_when_converged=False):
 
         super().__init__(forces, constraints, methods, rigid)
 
@@ -232,6 +254,7 @@ class FIRE(_DynamicIntegrator):
             angmom_tol=float(angmom_tol),
             energy_tol=float(energy_tol),
             min_steps_conv=OnlyTypes(int, preprocess=positive_real),
+            stop_when_converged=bool(stop_when_converged),
             _defaults={
                 'min_steps_adapt': 5,
                 'min_steps_conv': 10
@@ -0,0 +1,25 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PotentialPairJIT.h"
+
+#ifdef ENABLE_HIP
+#include "PotentialPairJITGPU.h"
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Create the python module
+/*! each class setup their own python exports in a function export_ClassName
+ create the hoomd python module and define the exports here.
+ */
+
+PYBIND11_MODULE(_jit, m)
+    {
+    export_PotentialPair<PotentialPair<EvaluatorPairJIT>>(m, "PotentialPairJITBase");
+    export_PotentialPairJIT(m);
+
+#if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    export_PotentialPairJITGPU(m);
+#endif
+    }
@@ -16,7 +16,9 @@
 #include "BondTablePotential.h"
 #include "ComputeThermo.h"
 #include "ComputeThermoHMA.h"
+#include "Correlator.h"
 #include "CosineSqAngleForceCompute.h"
+#include "DynamicBondUpdater.h"
 #include "EvaluatorRevCross.h"
 #include "EvaluatorSquareDensity.h"
 #include "EvaluatorTersoff.h"
@@ -35,6 +37,7 @@
 #include "ManifoldSphere.h"
 #include "ManifoldXYPlane.h"
 #include "ManifoldZCylinder.h"
+#include "MLPotential.h"
 #include "MolecularForceCompute.h"
 #include "MuellerPlatheFlow.h"
 #include "NeighborList.h"
@@ -47,8 +50,10 @@
 #include "PotentialExternal.h"
 #include "PotentialPair.h"
 #include "PotentialPairDPDThermo.h"
+#include "PotentialPairFused.h"
 #include "PotentialTersoff.h"
 #include "QuaternionMath.h"
+#include "ReplicaExchangeUpdater.h"
 #include "TableAngleForceCompute.h"
 #include "TableDihedralForceCompute.h"
 #include "TwoStepBD.h"
@@ -58,6 +63,7 @@
 #include "TwoStepNPTMTK.h"
 #include "TwoStepNVE.h"
 #include "TwoStepNVTMTK.h"
+#include "TwoStepSettle.h"
 #include "TwoStepRATTLEBD.h"
 #include "TwoStepRATTLELangevin.h"
 #include "TwoStepRATTLENVE.h"
@@ -72,6 +78,7 @@
 #include "BondTablePotentialGPU.h"
 #include "ComputeThermoGPU.h"
 #include "ComputeThermoHMAGPU.h"
+#include "CorrelatorGPU.h"
 #include "CosineSqAngleForceComputeGPU.h"
 #include "FIREEnergyMinimizerGPU.h"
 #include "ForceCompositeGPU.h"
@@ -82,6 +89,7 @@
 #include "MuellerPlatheFlowGPU.h"
 #include "NeighborListGPU.h"
 #include "NeighborListGPUBinned.h"
+#include "NeighborListGPUCluster.h"
 #include "NeighborListGPUStencil.h"
 #include "NeighborListGPUTree.h"
 #include "OPLSDihedralForceComputeGPU.h"
@@ -99,9 +107,11 @@
 #include "TwoStepNPTMTKGPU.h"
 #include "TwoStepNVEGPU.h"
 #include "TwoStepNVTMTKGPU.h"
+#include "TwoStepSettleGPU.h"
 #include "TwoStepRATTLEBDGPU.h"
 #include "TwoStepRATTLELangevinGPU.h"
 #include "TwoStepRATTLENVEGPU.h"
+#include "ZeroMomentumUpdaterGPU.h"
 #endif
 
 #include <pybind11/pybind11.h>
@@ -243,6 +253,9 @@ PYBIND11_MODULE(_md, m)
     export_ActiveRotationalDiffusionUpdater(m);
     export_ComputeThermo(m);
     export_ComputeThermoHMA(m);
+    export_Correlator(m);
+    export_DynamicBondUpdater(m);
+    export_ReplicaExchangeUpdater(m);
     export_HarmonicAngleForceCompute(m);
     export_CosineSqAngleForceCompute(m);
     export_TableAngleForceCompute(m);
@@ -267,8 +280,10 @@ PYBIND11_MODULE(_md, m)
     export_PotentialTersoff<PotentialTripletTersoff>(m, "PotentialTersoff");
     export_PotentialTersoff<PotentialTripletSquareDensity>(m, "PotentialSquareDensity");
     export_PotentialTersoff<PotentialTripletRevCross>(m, "PotentialRevCross");
+    export_MLPotential(m);
     export_PotentialPair<PotentialPairMie>(m, "PotentialPairMie");
     export_PotentialPair<PotentialPairReactionField>(m, "PotentialPairReactionField");
+    export_PotentialPair<PotentialPairDSF>(m, "PotentialPairDSF");
     export_PotentialPair<PotentialPairDLVO>(m, "PotentialPairDLVO");
     export_PotentialPair<PotentialPairFourier>(m, "PotentialPairFourier");
     export_PotentialPair<PotentialPairOPP>(m, "PotentialPairOPP");
@@ -284,12 +299,26 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPairDPDThermo<PotentialPairDPDLJThermoDPD, PotentialPairDPDLJ>(
         m,
         "PotentialPairDPDLJThermoDPD");
+    export_PotentialPairFused<EvaluatorPairLJ, EvaluatorPairYukawa>(m,
+                                                                    "PotentialPairFusedLJYukawa");
+    export_PotentialPairFused<EvaluatorPairLJ, EvaluatorPairDPDThermo>(m,
+                                                                       "PotentialPairFusedLJDPD");
+    export_PotentialPairFused<EvaluatorPairYukawa, EvaluatorPairDPDThermo>(
+        m,
+        "PotentialPairFusedYukawaDPD");
+    export_PotentialPairFused<EvaluatorPairLJ, EvaluatorPairYukawa, EvaluatorPairDPDThermo>(
+        m,
+        "PotentialPairFusedLJYukawaDPD");
     export_PotentialBond<PotentialBondHarmonic>(m, "PotentialBondHarmonic");
     export_PotentialBond<PotentialBondFENE>(m, "PotentialBondFENE");
     export_PotentialBond<PotentialBondTether>(m, "PotentialBondTether");
     export_PotentialSpecialPair<PotentialSpecialPairLJ>(m, "PotentialSpecialPairLJ");
     export_PotentialSpecialPair<PotentialSpecialPairCoulomb>(m, "PotentialSpecialPairCoulomb");
     export_NeighborList(m);
+    export_LocalNeighborListData<HOOMDHostBuffer>(m, "LocalNeighborListDataHost");
+#if ENABLE_HIP
+    export_LocalNeighborListData<HOOMDDeviceBuffer>(m, "LocalNeighborListDataDevice");
+#endif
     export_NeighborListBinned(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
@@ -313,6 +342,7 @@ PYBIND11_MODULE(_md, m)
 #ifdef ENABLE_HIP
     export_NeighborListGPU(m);
     export_NeighborListGPUBinned(m);
+    export_NeighborListGPUCluster(m);
     export_NeighborListGPUStencil(m);
     export_NeighborListGPUTree(m);
     export_ForceCompositeGPU(m);
@@ -331,6 +361,7 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPairGPU<PotentialPairReactionFieldGPU, PotentialPairReactionField>(
         m,
         "PotentialPairReactionFieldGPU");
+    export_PotentialPairGPU<PotentialPairDSFGPU, PotentialPairDSF>(m, "PotentialPairDSFGPU");
     export_PotentialPairGPU<PotentialPairDLVOGPU, PotentialPairDLVO>(m, "PotentialPairDLVOGPU");
     export_PotentialPairGPU<PotentialPairFourierGPU, PotentialPairFourier>(
         m,
@@ -397,6 +428,7 @@ PYBIND11_MODULE(_md, m)
     export_ForceDistanceConstraintGPU(m);
     export_ComputeThermoGPU(m);
     export_ComputeThermoHMAGPU(m);
+    export_CorrelatorGPU(m);
     export_PPPMForceComputeGPU(m);
     export_ActiveForceComputeGPU(m);
     export_ActiveForceConstraintComputeGPU<ManifoldZCylinder>(
@@ -448,6 +480,7 @@ PYBIND11_MODULE(_md, m)
     export_ZeroMomentumUpdater(m);
     export_TwoStepNVE(m);
     export_TwoStepNVTMTK(m);
+    export_TwoStepSettle(m);
     export_TwoStepLangevinBase(m);
     export_TwoStepLangevin(m);
     export_TwoStepBD(m);
@@ -484,12 +517,14 @@ PYBIND11_MODULE(_md, m)
 #ifdef ENABLE_HIP
     export_TwoStepNVEGPU(m);
     export_TwoStepNVTMTKGPU(m);
+    export_TwoStepSettleGPU(m);
     export_TwoStepLangevinGPU(m);
     export_TwoStepBDGPU(m);
     export_TwoStepNPTMTKGPU(m);
     export_BerendsenGPU(m);
     export_FIREEnergyMinimizerGPU(m);
     export_MuellerPlatheFlowGPU(m);
+    export_ZeroMomentumUpdaterGPU(m);
 
     export_TwoStepRATTLEBDGPU<ManifoldZCylinder>(m, "TwoStepRATTLEBDCylinderGPU");
     export_TwoStepRATTLEBDGPU<ManifoldDiamond>(m, "TwoStepRATTLEBDDiamondGPU");
@@ -9,17 +9,76 @@ efficient calculations. HOOMD-blue provides a several types of neighbor list
 construction algorithms that you can select from. Multiple pair force objects
 can share a neighbor list, or use independent neighbor list objects. When
 neighbor lists are shared, they find neighbors within the the maximum
-:math:`r_{\mathrm{cut},i,j}` over the associated pair potentials.
+:math:`r_{\mathrm{cut},i,j}` over the associated pair potentials. Shared
+neighbor lists order the neighbors of each particle by the cutoffs of the
+associated pair potentials, so that the isotropic and anisotropic pair
+potentials only iterate over the neighbors within their own cutoff.
 """
 
 import hoomd
+from hoomd.data.array import HOOMDArray, HOOMDGPUArray
+from hoomd.data.local_access import _LocalAccess
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.error import DataAccessError
 from hoomd.data.typeconverter import OnlyFrom
 from hoomd.logging import log
 from hoomd.md import _md
 from hoomd.operation import _HOOMDBaseObject
 
 
+class _NeighborListLocalAccess(_LocalAccess):
+    """Context manager access to the neighbor list arrays.
+
+    Attributes:
+        head_list ((N_particles) `hoomd.data.array` object of ``int``):
+            The index of the first neighbor of each particle in `nlist`.
+        n_neigh ((N_particles) `hoomd.data.array` object of ``int``):
+            The number of neighbors of each particle.
+        nlist ((N_elements) `hoomd.data.array` object of ``int``):
+            The local indices of the neighbors. The neighbors of particle ``i``
+            are ``nlist[head_list[i]:head_list[i] + n_neigh[i]]``. Entries
+            past the last neighbor of a particle are unused.
+    """
+    __slots__ = ('_half_nlist',)
+    _fields = {}
+    _global_fields = {
+        'head_list': 'getHeadList',
+        'n_neigh': 'getNNeigh',
+        'nlist': 'getNList'
+    }
+
+    def __init__(self, nlist):
+        super().__init__()
+        self._cpp_obj = self._cpp_cls(
+            nlist._cpp_obj,
+            nlist._simulation.state._cpp_sys_def.getParticleData())
+        self._half_nlist = self._cpp_obj.isHalfNlist()
+
+    @property
+    def half_nlist(self):
+        """bool: True when each pair is stored once, for the lower index."""
+        return self._half_nlist
+
+    def __enter__(self):
+        self._enter()
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self._exit()
+
+
+class _NeighborListLocalAccessCPU(_NeighborListLocalAccess):
+    _cpp_cls = _md.LocalNeighborListDataHost
+    _array_cls = HOOMDArray
+
+
+if hoomd.version.gpu_enabled:
+
+    class _NeighborListLocalAccessGPU(_NeighborListLocalAccess):
+        _cpp_cls = _md.LocalNeighborListDataDevice
+        _array_cls = HOOMDGPUArray
+
+
 class NList(_HOOMDBaseObject):
     r"""Base class neighbor list.
 
@@ -41,6 +100,9 @@ class NList(_HOOMDBaseObject):
     `check_dist` is `False`, `NList` always rebuilds after
     `rebuild_check_delay` time steps.
 
+    Use `hoomd.md.tune.NeighborListBuffer` to choose `buffer` and
+    `rebuild_check_delay` automatically.
+
     .. rubric:: Exclusions
 
     Neighbor lists nominally include all particles within the specified cutoff
@@ -70,6 +132,36 @@ class NList(_HOOMDBaseObject):
     largest value that any particle's diameter will achieve (where **diameter**
     is the per particle quantity stored in the `hoomd.State`).
 
+    .. rubric:: Compressed storage
+
+    Set `compressed` to `True` to also store the neighbor list in compressed
+    form. After each build, `NList` sorts the neighbors of each particle and
+    stores each neighbor as the difference to the previous one in 1 to 5
+    bytes. Nearby particles have nearby indices after the particle sort (see
+    `hoomd.tune.ParticleSorter`), so most neighbors take 1 or 2 bytes instead
+    of 4. The isotropic pair potentials in `hoomd.md.pair` decode the
+    compressed rows on the fly, which reduces the memory traffic of the pair
+    force evaluation. The compressed rows are stored in addition to the full
+    neighbor list, which all other forces read.
+
+    .. rubric:: Exclusion masks
+
+    Removing the excluded pairs from the neighbor list after each build costs
+    a pass over the neighbors of every particle with exclusions. Set
+    `mask_exclusions` to `True` to keep the excluded pairs of a particle in
+    the list when the tags of all of its excluded particles differ from its
+    own tag by at most 16, which is typical of molecules stored with
+    consecutive tags. The pair force evaluation then skips these pairs with a
+    per-particle bit mask. The rows of the other particles are filtered as
+    usual.
+
+    The masks only take effect when every force that uses the neighbor list is
+    an isotropic pair potential in `hoomd.md.pair` (except the DPD
+    thermostats) and `Cluster` is not used on the GPU. Otherwise, `NList`
+    removes all excluded pairs. When the masks are in effect, the arrays
+    provided by `cpu_local_nlist_arrays` and `gpu_local_nlist_arrays` include
+    the masked excluded pairs.
+
     Attributes:
         buffer (float): Buffer width :math:`[\mathrm{length}]`.
         exclusions (tuple[str]): Defines which particles to exlclude from the
@@ -80,10 +172,19 @@ class NList(_HOOMDBaseObject):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\mathrm{length}]`.
+        compressed (bool): Flag to enable / disable the compressed storage.
+        mask_exclusions (bool): Flag to enable / disable the exclusion masks.
     """
 
-    def __init__(self, buffer, exclusions, rebuild_check_delay, diameter_shift,
-                 check_dist, max_diameter):
+    def __init__(self,
+                 buffer,
+                 exclusions,
+                 rebuild_check_delay,
+                 diameter_shift,
+                 check_dist,
+                 max_diameter,
+                 compressed=False,
+                 mask_exclusions=False):
 
         validate_exclusions = OnlyFrom([
             'bond', 'angle', 'constraint', 'dihedral', 'special_pair', 'body',
@@ -96,6 +197,8 @@ class NList(_HOOMDBaseObject):
                                check_dist=bool(check_dist),
                                diameter_shift=bool(diameter_shift),
                                max_diameter=float(max_diameter),
+                               compressed=bool(compressed),
+                               mask_exclusions=bool(mask_exclusions),
                                _defaults={'exclusions': exclusions})
         self._param_dict.update(params)
 
@@ -108,6 +211,43 @@ class NList(_HOOMDBaseObject):
         """
         return self._cpp_obj.getSmallestRebuild()
 
+    @property
+    def cpu_local_nlist_arrays(self):
+        """Expose the neighbor list arrays on the CPU.
+
+        Provides zero-copy, read only access to the rank local neighbor list
+        from the last build through a context manager (i.e. ``with
+        nlist.cpu_local_nlist_arrays as data:``). The arrays ``head_list``,
+        ``n_neigh``, and ``nlist`` are `hoomd.data.HOOMDArray` objects that
+        also export DLPack capsules, so machine learning frameworks can wrap
+        them without a copy (e.g. ``torch.from_dlpack(data.nlist)``). Neighbors
+        are local particle indices, which match the order of
+        `hoomd.State.cpu_local_snapshot`. ``data.half_nlist`` is `True` when
+        each pair is stored only once.
+
+        Note:
+            The arrays are only valid inside the context manager.
+        """
+        if not self._attached:
+            raise DataAccessError("cpu_local_nlist_arrays")
+        return _NeighborListLocalAccessCPU(self)
+
+    @property
+    def gpu_local_nlist_arrays(self):
+        """Expose the neighbor list arrays on the GPU.
+
+        Provides zero-copy, read only access to the neighbor list on the GPU
+        through `hoomd.data.HOOMDGPUArray` objects, which export both the
+        ``__cuda_array_interface__`` and DLPack capsules. See
+        `cpu_local_nlist_arrays` for details.
+        """
+        if not self._attached:
+            raise DataAccessError("gpu_local_nlist_arrays")
+        if not isinstance(self._simulation.device, hoomd.device.GPU):
+            raise RuntimeError(
+                "Cannot access GPU neighbor list arrays on a CPU device.")
+        return _NeighborListLocalAccessGPU(self)
+
     def _remove_dependent(self, obj):
         super()._remove_dependent(obj)
         if len(self._dependents) == 0:
@@ -118,8 +258,6 @@ class NList(_HOOMDBaseObject):
             if self._added:
                 self._remove()
 
-    # TODO need to add tuning Updater for NList
-
 
 class Cell(NList):
     r"""Neighbor list computed via a cell list.
@@ -136,6 +274,10 @@ class Cell(NList):
             :math:`[\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        compressed (bool): Flag to enable / disable the compressed storage, see
+            `NList`.
+        mask_exclusions (bool): Flag to enable / disable the exclusion masks,
+            see `NList`.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -160,10 +302,18 @@ class Cell(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
-
-        super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                 deterministic=False,
+                 compressed=False,
+                 mask_exclusions=False):
+
+        super().__init__(buffer,
+                         exclusions,
+                         rebuild_check_delay,
+                         diameter_shift,
+                         check_dist,
+                         max_diameter,
+                         compressed,
+                         mask_exclusions=mask_exclusions)
 
         self._param_dict.update(
             ParameterDict(deterministic=bool(deterministic)))
@@ -195,6 +345,10 @@ class Stencil(NList):
             :math:`[\\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        compressed (bool): Flag to enable / disable the compressed storage, see
+            `NList`.
+        mask_exclusions (bool): Flag to enable / disable the exclusion masks,
+            see `NList`.
 
     `Stencil` creates a cell list based neighbor list object to which pair
     potentials can be attached for computing non-bonded pairwise interactions.
@@ -239,10 +393,18 @@ class Stencil(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
-
-        super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                 deterministic=False,
+                 compressed=False,
+                 mask_exclusions=False):
+
+        super().__init__(buffer,
+                         exclusions,
+                         rebuild_check_delay,
+                         diameter_shift,
+                         check_dist,
+                         max_diameter,
+                         compressed,
+                         mask_exclusions=mask_exclusions)
 
         params = ParameterDict(deterministic=bool(deterministic),
                                cell_width=float(cell_width))
@@ -272,6 +434,14 @@ class Tree(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\\mathrm{length}]`.
+        compressed (bool): Flag to enable / disable the compressed storage, see
+            `NList`.
+        combined (bool): When `True`, build one BVH tree for all particle
+            types on the GPU.
+        max_refits (int): Maximum number of consecutive neighbor list builds
+            that refit the BVH trees on the GPU.
+        mask_exclusions (bool): Flag to enable / disable the exclusion masks,
+            see `NList`.
 
     `Tree` creates a neighbor list using a bounding volume hierarchy (BVH) tree
     traversal. A BVH tree of axis-aligned bounding boxes is constructed per
@@ -284,6 +454,19 @@ class Tree(NList):
     BVH is created per type.) The user should carefully benchmark neighbor list
     build times to select the appropriate neighbor list construction type.
 
+    On the GPU, set ``combined`` to `True` to build one BVH tree for all
+    particle types instead. Each particle then searches the tree once, with the
+    largest cutoff of its type, which performs better when there are many types
+    or when the cutoffs of the types are similar.
+
+    On the GPU, `Tree` reuses the BVH trees between neighbor list builds when
+    the particles have not been sorted, changed type, or moved between ranks
+    since the trees were built. It refits the bounding boxes of the existing
+    trees to the current positions, which is faster than building new trees.
+    The quality of the trees decreases as the particles move, so `Tree` builds
+    new trees after ``max_refits`` consecutive refits. Set ``max_refits`` to 0
+    to always build new trees.
+
     `M.P. Howard et al. 2016 <http://dx.doi.org/10.1016/j.cpc.2016.02.003>`_
     describes the original implementation of this algorithm for HOOMD-blue.
     `M.P. Howard et al. 2019 <https://doi.org/10.1016/j.commatsci.2019.04.004>`_
@@ -293,6 +476,15 @@ class Tree(NList):
     Examples::
 
         nl_t = nlist.Tree(check_dist=False)
+
+    Note:
+        ``combined`` and ``max_refits`` have no effect on the CPU.
+
+    Attributes:
+        combined (bool): When `True`, build one BVH tree for all particle
+            types on the GPU.
+        max_refits (int): Maximum number of consecutive neighbor list builds
+            that refit the BVH trees on the GPU.
     """
 
     def __init__(self,
@@ -301,10 +493,25 @@ class Tree(NList):
                  rebuild_check_delay=1,
                  diameter_shift=False,
                  check_dist=True,
-                 max_diameter=1.0):
+                 max_diameter=1.0,
+                 compressed=False,
+                 combined=False,
+                 max_refits=4,
+                 mask_exclusions=False):
+
+        super().__init__(buffer,
+                         exclusions,
+                         rebuild_check_delay,
+                         diameter_shift,
+                         check_dist,
+                         max_diameter,
+                         compressed,
+                         mask_exclusions=mask_exclusions)
+
+        params = ParameterDict(combined=bool(combined),
+                               max_refits=int(max_refits))
 
-        super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+        self._param_dict.update(params)
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
@@ -314,3 +521,254 @@ class Tree(NList):
         self._cpp_obj = nlist_cls(self._simulation.state._cpp_sys_def,
                                   self.buffer)
         super()._attach()
+
+    def _getattr_param(self, attr):
+        # combined and max_refits have no C++ counterpart on the CPU
+        if self._attached and not hasattr(self._cpp_obj, attr):
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def _setattr_param(self, attr, value):
+        if self._attached and not hasattr(self._cpp_obj, attr):
+            self._param_dict[attr] = value
+            return
+        super()._setattr_param(attr, value)
+
+
+class Cluster(NList):
+    r"""Neighbor list of particle clusters computed via a cell list.
+
+    Args:
+        buffer (float): Buffer width :math:`[\mathrm{length}]`.
+        exclusions (tuple[str]): Defines which particles to exlclude from the
+            neighbor list, see more details in `NList`.
+        rebuild_check_delay (int): How often to attempt to rebuild the neighbor
+            list.
+        diameter_shift (bool): Flag to enable / disable diameter shifting.
+        check_dist (bool): Flag to enable / disable distance checking.
+        max_diameter (float): The maximum diameter a particle will achieve
+            :math:`[\mathrm{length}]`.
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+        compressed (bool): Flag to enable / disable the compressed storage, see
+            `NList`.
+        mask_exclusions (bool): Flag to enable / disable the exclusion masks,
+            see `NList`.
+
+    `Cluster` finds neighboring particles with a cell list in the same way as
+    `Cell` does. On the GPU, `Cluster` also groups every 8 consecutive particles
+    into a cluster. For each cluster, it lists the clusters that hold at least
+    one neighbor, along with a mask of the neighboring particle pairs. Pair
+    potentials evaluate each cluster pair together with the particles staged in
+    shared memory. This reduces the scattered memory reads of the pair force
+    evaluation and is most effective for short range potentials in
+    monodisperse systems. The particle sort (see `hoomd.tune.ParticleSorter`)
+    keeps nearby particles in the same cluster.
+
+    The isotropic pair potentials in `hoomd.md.pair` evaluate cluster pairs,
+    except for `hoomd.md.pair.DPD` and `hoomd.md.pair.DPDLJ`. All other forces
+    read the per-particle neighbor list, which `Cluster` also provides. On the
+    CPU, `Cluster` is identical to `Cell`.
+
+    Examples::
+
+        cluster = nlist.Cluster()
+
+    Attributes:
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+    """
+
+    def __init__(self,
+                 buffer=0.4,
+                 exclusions=('bond',),
+                 rebuild_check_delay=1,
+                 diameter_shift=False,
+                 check_dist=True,
+                 max_diameter=1.0,
+                 deterministic=False,
+                 compressed=False,
+                 mask_exclusions=False):
+
+        super().__init__(buffer,
+                         exclusions,
+                         rebuild_check_delay,
+                         diameter_shift,
+                         check_dist,
+                         max_diameter,
+                         compressed,
+                         mask_exclusions=mask_exclusions)
+
+        self._param_dict.update(
+            ParameterDict(deterministic=bool(deterministic)))
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            nlist_cls = _md.NeighborListBinned
+        else:
+            nlist_cls = _md.NeighborListGPUCluster
+        self._cpp_obj = nlist_cls(self._simulation.state._cpp_sys_def,
+                                  self.buffer)
+        super()._attach()
+
+
+class Auto(NList):
+    r"""Neighbor list that selects the construction algorithm automatically.
+
+    Args:
+        buffer (float): Buffer width :math:`[\mathrm{length}]`.
+        exclusions (tuple[str]): Defines which particles to exlclude from the
+            neighbor list, see more details in `NList`.
+        rebuild_check_delay (int): How often to attempt to rebuild the neighbor
+            list.
+        diameter_shift (bool): Flag to enable / disable diameter shifting.
+        check_dist (bool): Flag to enable / disable distance checking.
+        max_diameter (float): The maximum diameter a particle will achieve
+            :math:`[\mathrm{length}]`.
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+        compressed (bool): Flag to enable / disable the compressed storage, see
+            `NList`.
+        iterations (int): Number of neighbor list builds to time each
+            algorithm with. Set to 0 to select the algorithm without timing.
+        mask_exclusions (bool): Flag to enable / disable the exclusion masks,
+            see `NList`.
+
+    `Auto` builds the neighbor list with the algorithm of `Cell`, `Stencil`,
+    or `Tree`, selected when `Auto` attaches to a simulation. `Auto` first
+    ranks the algorithms from the cutoffs of the pair forces that use it and
+    the number density :math:`\rho` of the system. When the ratio of the
+    largest to the smallest :math:`r_\mathrm{list} = r_\mathrm{cut} +
+    r_\mathrm{buffer}` is at most 1.5, the cutoffs are nearly monodisperse and
+    `Cell` ranks first. Otherwise, `Stencil` with ``cell_width`` set to the
+    smallest :math:`r_\mathrm{list}` ranks first when these cells hold at least
+    one particle on average (:math:`\rho r_\mathrm{list,min}^d \ge 1`), and
+    `Tree` ranks first in more dilute systems.
+
+    When `iterations` is greater than 0, `Auto` then times `iterations`
+    neighbor list builds with each algorithm and selects the fastest. The first
+    ranked algorithm is kept unless another one is at least 10% faster.
+
+    `Auto` selects the algorithm again each time it attaches, for example
+    after the pair forces or the operations of the simulation change.
+
+    Examples::
+
+        nl = nlist.Auto()
+
+    Attributes:
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+        iterations (int): Number of neighbor list builds to time each
+            algorithm with.
+    """
+
+    def __init__(self,
+                 buffer=0.4,
+                 exclusions=('bond',),
+                 rebuild_check_delay=1,
+                 diameter_shift=False,
+                 check_dist=True,
+                 max_diameter=1.0,
+                 deterministic=False,
+                 compressed=False,
+                 iterations=10,
+                 mask_exclusions=False):
+
+        super().__init__(buffer,
+                         exclusions,
+                         rebuild_check_delay,
+                         diameter_shift,
+                         check_dist,
+                         max_diameter,
+                         compressed,
+                         mask_exclusions=mask_exclusions)
+
+        self._param_dict.update(
+            ParameterDict(deterministic=bool(deterministic),
+                          iterations=int(iterations)))
+        self._algorithm = None
+
+    @log(category='string', requires_run=True)
+    def algorithm(self):
+        """str: The selected algorithm: ``'cell'``, ``'stencil'``, or \
+        ``'tree'``."""
+        return self._algorithm
+
+    def _getattr_param(self, attr):
+        # iterations, and deterministic with Tree, have no C++ counterpart
+        if self._attached and not hasattr(self._cpp_obj, attr):
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def _setattr_param(self, attr, value):
+        if self._attached and not hasattr(self._cpp_obj, attr):
+            self._param_dict[attr] = value
+            return
+        super()._setattr_param(attr, value)
+
+    def _r_cut_matrix(self):
+        """Flattened r_cut matrix over the pair forces that use this nlist."""
+        types = self._simulation.state.particle_types
+        r_cut = [0.0] * (len(types) * len(types))
+        for force in self._dependents:
+            force_r_cut = getattr(force, 'r_cut', None)
+            if force_r_cut is None:
+                continue
+            for i, type_i in enumerate(types):
+                for j, type_j in enumerate(types):
+                    try:
+                        value = float(force_r_cut[(type_i, type_j)])
+                    except (TypeError, ValueError, KeyError):
+                        continue
+                    k = i * len(types) + j
+                    r_cut[k] = max(r_cut[k], value)
+        return r_cut
+
+    def _rank_algorithms(self, r_cut):
+        """Order the algorithms from the r_cut dispersion and the density."""
+        r_list = [r + self.buffer for r in r_cut if r > 0]
+        if len(r_list) == 0 or max(r_list) <= 1.5 * min(r_list):
+            return ['cell', 'stencil', 'tree']
+
+        state = self._simulation.state
+        density = state.N_particles / state.box.volume
+        if density * min(r_list)**state.box.dimensions >= 1:
+            return ['stencil', 'tree', 'cell']
+        return ['tree', 'stencil', 'cell']
+
+    def _make_cpp_obj(self, algorithm, r_cut):
+        cpu = isinstance(self._simulation.device, hoomd.device.CPU)
+        if algorithm == 'cell':
+            cls = _md.NeighborListBinned if cpu else _md.NeighborListGPUBinned
+        elif algorithm == 'stencil':
+            cls = _md.NeighborListStencil if cpu else _md.NeighborListGPUStencil
+        else:
+            cls = _md.NeighborListTree if cpu else _md.NeighborListGPUTree
+
+        cpp_obj = cls(self._simulation.state._cpp_sys_def, self.buffer)
+        if algorithm == 'stencil':
+            cpp_obj.cell_width = min(r + self.buffer for r in r_cut if r > 0)
+        return cpp_obj
+
+    def _attach(self):
+        r_cut = self._r_cut_matrix()
+        algorithms = self._rank_algorithms(r_cut)
+        if all(r <= 0 for r in r_cut):
+            algorithms = algorithms[:1]
+
+        selected = algorithms[0]
+        if self.iterations > 0 and len(algorithms) > 1:
+            costs = {}
+            for algorithm in algorithms:
+                cpp_obj = self._make_cpp_obj(algorithm, r_cut)
+                cpp_obj.exclusions = self.exclusions
+                cpp_obj.setBenchmarkRCut(r_cut)
+                costs[algorithm] = cpp_obj.benchmark(self.iterations)
+            fastest = min(algorithms, key=lambda a: costs[a])
+            if costs[fastest] < 0.9 * costs[selected]:
+                selected = fastest
+
+        self._algorithm = selected
+        self._cpp_obj = self._make_cpp_obj(selected, r_cut)
+        super()._attach()
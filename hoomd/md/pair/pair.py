@@ -13,6 +13,7 @@ from hoomd.md import force
 from hoomd.md.nlist import NList
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
+from hoomd.error import DataAccessError
 import numpy as np
 from hoomd.data.typeconverter import (OnlyFrom, OnlyTypes, nonnegative_real)
 
@@ -122,12 +123,101 @@ class Pair(force.Force):
         Possible values: ``"none"``, ``"shift"``, ``"xplor"``
 
         Type: `str`
+
+    .. py:attribute:: tabulate
+
+        When `True`, evaluate the potential by linear interpolation in a table
+        of ``table_width`` values of :math:`V` and :math:`F` per type pair
+        that is computed from the analytic form between ``table_r_min`` and
+        :math:`r_{\mathrm{cut}}`. Pairs outside of the table range use the
+        analytic form. Interpolation is faster for potentials that are
+        expensive to evaluate at the cost of a small error in the forces and
+        energies. Potentials that depend on the particle diameter or charge
+        do not support tabulation. Only the CPU implementation tabulates the
+        potential, *optional*: defaults to `False`.
+
+        Type: `bool`
+
+    .. py:attribute:: table_width
+
+        Number of entries in each table, *optional*: defaults to 1000.
+
+        Type: `int`
+
+    .. py:attribute:: table_r_min
+
+        Smallest distance in each table :math:`[\mathrm{length}]`,
+        *optional*: defaults to 0.5.
+
+        Type: `float`
+
+    .. py:attribute:: cell_tiles
+
+        When `True`, evaluate the pairs over the cells of a cell list as wide
+        as the largest :math:`r_{\mathrm{cut}}` instead of the rows of the
+        neighbor list. The particles of each cell are loaded into contiguous
+        tiles, which is faster for dense systems with short cutoffs. The
+        neighbor list is not built unless the simulation is domain
+        decomposed. The neighbor list is used as usual when it has
+        exclusions, filters rigid bodies, or shifts the cutoff by the
+        diameter. Only the CPU implementation uses cell tiles, *optional*:
+        defaults to `False`.
+
+        Type: `bool`
+
+    .. py:attribute:: auto_cell_tiles
+
+        When `True`, measure how often the neighbor list is rebuilt and
+        evaluate the pairs over cell tiles (see `cell_tiles`) while it is
+        rebuilt on at least half of the steps, such as in DPD or Brownian
+        dynamics runs with large time steps. The neighbor list is used again
+        when it is rebuilt on less than a quarter of the steps. Without domain
+        decomposition the neighbor list is not built while the tiles are in
+        use, so it is rebuilt for 100 steps every 1000 steps to measure the
+        rate again. Only the CPU implementation uses cell tiles, *optional*:
+        defaults to `False`.
+
+        Type: `bool`
+
+    .. py:attribute:: half_nlist
+
+        When `True`, store each pair once in the neighbor list on the GPU,
+        which halves its memory. The kernels evaluate each pair once and add
+        the reaction to the neighbor with atomic adds. Without a half neighbor
+        list, the autotuner chooses between this kernel and the one that
+        evaluates each pair on both particles. Requires a `hoomd.md.nlist.Cell`
+        neighbor list without compressed storage on a single GPU. Other GPU
+        forces that share the neighbor list, such as anisotropic pair
+        potentials, may require the full list. The CPU always stores the pairs
+        once, and `DPD` and `DPDLJ` ignore this attribute, *optional*:
+        defaults to `False`.
+
+        Type: `bool`
+
+    .. py:attribute:: reverse_ghost_forces
+
+        When `True` in MPI simulations on the CPU, evaluate each pair of a
+        local and a ghost particle only on the rank that owns the particle
+        with the lower tag and send the force on the ghost back to its owner.
+        This halves the work on pairs that cross domain boundaries. The
+        force on the ghost is added to the net force of its owner only, so
+        `forces`, `energies`, `virials`, and `cpu_local_force_arrays` of this
+        potential miss the forces on particles whose pairs were evaluated on
+        another rank. The net force, the total `energy`, and the pressure are
+        unchanged. The GPU implementation, `DPD`, and `DPDLJ` ignore this
+        attribute, *optional*: defaults to `False`.
+
+        Type: `bool`
     """
 
     # The accepted modes for the potential. Should be reset by subclasses with
     # restricted modes.
     _accepted_modes = ("none", "shift", "xplor")
 
+    # Whether the potential can be evaluated from interpolation tables. Should
+    # be reset by subclasses that compute more than pairwise functions of r.
+    _tabulate_supported = True
+
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         self._nlist = validate_nlist(nlist)
         tp_r_cut = TypeParameter(
@@ -143,6 +233,16 @@ class Pair(force.Force):
         self._param_dict.update(
             ParameterDict(mode=OnlyFrom(self._accepted_modes)))
         self.mode = mode
+        self._param_dict.update(
+            ParameterDict(cell_tiles=bool(False),
+                          auto_cell_tiles=bool(False),
+                          half_nlist=bool(False),
+                          reverse_ghost_forces=bool(False)))
+        if self._tabulate_supported:
+            self._param_dict.update(
+                ParameterDict(tabulate=bool(False),
+                              table_width=int(1000),
+                              table_r_min=float(0.5)))
 
     def compute_energy(self, tags1, tags2):
         r"""Compute the energy between two sets of particles.
@@ -211,6 +311,18 @@ class Pair(force.Force):
 
     def _attach(self):
         # create the c++ mirror class
+        self._attach_nlist()
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = getattr(_md, self._cpp_class_name)
+        else:
+            cls = getattr(_md, self._cpp_class_name + "GPU")
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def,
+                            self.nlist._cpp_obj)
+
+        super()._attach()
+
+    def _attach_nlist(self):
+        """Attach the neighbor list with the storage mode of the device."""
         if not self._nlist._added:
             self._nlist._add(self._simulation)
         else:
@@ -220,17 +332,11 @@ class Pair(force.Force):
         if not self.nlist._attached:
             self.nlist._attach()
         if isinstance(self._simulation.device, hoomd.device.CPU):
-            cls = getattr(_md, self._cpp_class_name)
             self.nlist._cpp_obj.setStorageMode(
                 _md.NeighborList.storageMode.half)
         else:
-            cls = getattr(_md, self._cpp_class_name + "GPU")
             self.nlist._cpp_obj.setStorageMode(
                 _md.NeighborList.storageMode.full)
-        self._cpp_obj = cls(self._simulation.state._cpp_sys_def,
-                            self.nlist._cpp_obj)
-
-        super()._attach()
 
     @property
     def nlist(self):
@@ -250,6 +356,18 @@ class Pair(force.Force):
             self._nlist._add(self._simulation)
         self._nlist = nlist
 
+    @property
+    def cell_tile_computes(self):
+        """int: Number of force computations that evaluated the pairs over \
+        cell tiles.
+
+        Counts the computations on this rank since the potential was attached,
+        both with `cell_tiles` and when `auto_cell_tiles` chose the tiles.
+        """
+        if not self._attached:
+            raise DataAccessError("cell_tile_computes")
+        return self._cpp_obj.getNumCellTileComputes()
+
     @property
     def _children(self):
         return [self.nlist]
@@ -428,6 +546,7 @@ class SLJ(Pair):
         slj.r_cut[('B', 'B')] = 2**(1.0/6.0)
     """
     _cpp_class_name = 'PotentialPairSLJ'
+    _tabulate_supported = False
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         if mode == 'xplor':
@@ -559,6 +678,7 @@ class Ewald(Pair):
     """
     _cpp_class_name = "PotentialPairEwald"
     _accepted_modes = ("none",)
+    _tabulate_supported = False
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0.):
         super().__init__(nlist, default_r_cut, default_r_on, 'none')
@@ -654,6 +774,7 @@ class Table(Pair):
     """
     _cpp_class_name = "PotentialPairTable"
     _accepted_modes = ("none",)
+    _tabulate_supported = False
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0.):
         super().__init__(nlist, default_r_cut, default_r_on, 'none')
@@ -808,6 +929,7 @@ class DPD(Pair):
     """
     _cpp_class_name = "PotentialPairDPDThermoDPD"
     _accepted_modes = ("none",)
+    _tabulate_supported = False
 
     def __init__(self, nlist, kT, default_r_cut=None, default_r_on=0.):
         super().__init__(nlist, default_r_cut, default_r_on, 'none')
@@ -981,6 +1103,7 @@ class DPDLJ(Pair):
     """
     _cpp_class_name = "PotentialPairDPDLJThermoDPD"
     _accepted_modes = ("none", "shifted")
+    _tabulate_supported = False
 
     def __init__(self,
                  nlist,
@@ -1450,6 +1573,7 @@ class ReactionField(Pair):
             epsilon=1.0, eps_rf=0.0, use_charge=True)
     """
     _cpp_class_name = "PotentialPairReactionField"
+    _tabulate_supported = False
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         super().__init__(nlist, default_r_cut, default_r_on, mode)
@@ -1463,6 +1587,71 @@ class ReactionField(Pair):
         self._add_typeparam(params)
 
 
+class DSF(Pair):
+    r"""Damped shifted force electrostatic pair potential.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+        default_r_on (float): Default turn-on radius :math:`[\mathrm{length}]`.
+        mode (str): Energy shifting/smoothing mode.
+
+    `DSF` specifies that a damped shifted force electrostatic pair potential
+    should be applied between every non-excluded particle pair in the
+    simulation. See `Fennell and Gezelter 2006
+    <https://doi.org/10.1063/1.2206581>`_.
+
+    .. math::
+
+        V_{\mathrm{DSF}}(r) = q_i q_j \left[
+            \frac{\mathrm{erfc}(\alpha r)}{r}
+            - \frac{\mathrm{erfc}(\alpha r_{\mathrm{cut}})}{r_{\mathrm{cut}}}
+            + \left( \frac{\mathrm{erfc}(\alpha r_{\mathrm{cut}})}
+                           {r_{\mathrm{cut}}^2}
+            + \frac{2 \alpha}{\sqrt{\pi}}
+              \frac{e^{-\alpha^2 r_{\mathrm{cut}}^2}}{r_{\mathrm{cut}}}
+              \right) (r - r_{\mathrm{cut}}) \right]
+
+    where :math:`q_i` and :math:`q_j` are the charges of the particle pair.
+    Both the potential and the force are zero at :math:`r_{\mathrm{cut}}`,
+    so the energy shifting modes have no effect.
+
+    `DSF` is a cutoff based alternative to `md.long_range.pppm` for systems
+    where the electrostatic interactions are screened over the cutoff distance.
+    Excluded pairs do not interact and need no correction, unlike the PPPM
+    reciprocal space term. `DSF` does not include the constant self energy
+    :math:`-\left(\frac{\mathrm{erfc}(\alpha r_{\mathrm{cut}})}
+    {2 r_{\mathrm{cut}}} + \frac{\alpha}{\sqrt{\pi}}\right)
+    \sum_i q_i^2` in `energy`.
+
+    See `Pair` for details on how forces are calculated.
+
+    .. py:attribute:: params
+
+        The DSF potential parameters. The dictionary has the following keys:
+
+        * ``alpha`` (`float`, **required**) - Damping parameter
+          :math:`\alpha` :math:`[\mathrm{length}^{-1}]`
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    Example::
+
+        nl = nlist.Cell()
+        dsf = pair.DSF(default_r_cut=3.0, nlist=nl)
+        dsf.params[('A', 'A')] = dict(alpha=0.2)
+    """
+    _cpp_class_name = "PotentialPairDSF"
+    _tabulate_supported = False
+
+    def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
+        super().__init__(nlist, default_r_cut, default_r_on, mode)
+        params = TypeParameter('params', 'particle_types',
+                               TypeParameterDict(alpha=float, len_keys=2))
+        self._add_typeparam(params)
+
+
 class DLVO(Pair):
     r"""DLVO colloidal interaction.
 
@@ -1535,6 +1724,7 @@ class DLVO(Pair):
     """
     _cpp_class_name = "PotentialPairDLVO"
     _accepted_modes = ("none", "shift")
+    _tabulate_supported = False
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         if mode == 'xplor':
@@ -1929,3 +2119,111 @@ class TWF(Pair):
                               alpha=float,
                               len_keys=2))
         self._add_typeparam(params)
+
+
+class Fused(force.Force):
+    r"""Evaluate several pair potentials in one pass over the neighbor list.
+
+    Args:
+        potentials (list[`Pair`]): Pair potentials to evaluate.
+
+    Each `Pair` potential reads the particle positions and the neighbor list
+    and writes its own forces, which the integrator then sums. `Fused`
+    evaluates all of the given *potentials* for each neighbor pair in a single
+    pass over the neighbor list and applies the total force. Add `Fused` to
+    the integrator's forces in place of the individual potentials.
+
+    The *potentials* must use the same neighbor list. Continue to set their
+    parameters, cutoffs, and modes through the individual potentials. The
+    `energy <hoomd.md.force.Force.energy>` and `energies
+    <hoomd.md.force.Force.energies>` of each potential remain available for
+    logging. The forces and virials of the individual potentials are zero,
+    `Fused` holds their sum.
+
+    The following combinations are supported, in any order:
+
+    * `LJ`, `Yukawa`
+    * `LJ`, `DPDConservative`
+    * `Yukawa`, `DPDConservative`
+    * `LJ`, `Yukawa`, `DPDConservative`
+
+    Note:
+        On the GPU, each potential evaluates its forces with its own kernel
+        and `Fused` sums them.
+
+    Example::
+
+        nl = nlist.Cell()
+        lj = pair.LJ(nl, default_r_cut=2.5)
+        lj.params[('A', 'A')] = {'sigma': 1.0, 'epsilon': 1.0}
+        yukawa = pair.Yukawa(nl, default_r_cut=3.0)
+        yukawa.params[('A', 'A')] = {'epsilon': 1.0, 'kappa': 1.0}
+        fused = pair.Fused(potentials=[lj, yukawa])
+        integrator.forces.append(fused)
+    """
+
+    # C++ class names of the potentials that can be fused, in the order of the
+    # arguments of the exported PotentialPairFused classes
+    _fusable = ('PotentialPairLJ', 'PotentialPairYukawa', 'PotentialPairDPD')
+
+    def __init__(self, potentials):
+        potentials = list(potentials)
+        for potential in potentials:
+            if (not isinstance(potential, Pair)
+                    or potential._cpp_class_name not in self._fusable):
+                raise ValueError(f"{potential} cannot be fused.")
+        if len({potential._cpp_class_name for potential in potentials}) \
+                != len(potentials):
+            raise ValueError("Fused potentials must be of distinct classes.")
+        if len({id(potential.nlist) for potential in potentials}) != 1:
+            raise ValueError("Fused potentials must share the neighbor list.")
+
+        # order the potentials to match the C++ template arguments
+        potentials.sort(key=lambda p: self._fusable.index(p._cpp_class_name))
+        self._cpp_class_name = "PotentialPairFused" + "".join(
+            potential._cpp_class_name[len("PotentialPair"):]
+            for potential in potentials)
+        if not hasattr(_md, self._cpp_class_name):
+            raise ValueError("Fusing these potentials is not supported.")
+        self._potentials = potentials
+
+    @property
+    def potentials(self):
+        """list[`Pair`]: The fused pair potentials."""
+        return list(self._potentials)
+
+    @property
+    def nlist(self):
+        """Neighbor list used to compute the pair potentials."""
+        return self._potentials[0].nlist
+
+    def _add(self, simulation):
+        super()._add(simulation)
+        for potential in self._potentials:
+            potential._add(simulation)
+
+    def _attach(self):
+        for potential in self._potentials:
+            if not potential._attached:
+                potential._attach()
+
+        cls = getattr(_md, self._cpp_class_name)
+        self._cpp_obj = cls(
+            self._simulation.state._cpp_sys_def, self.nlist._cpp_obj,
+            *[potential._cpp_obj for potential in self._potentials])
+
+        super()._attach()
+
+    def _detach(self):
+        super()._detach()
+        for potential in self._potentials:
+            potential._detach()
+
+    def _remove(self):
+        for potential in self._potentials:
+            potential._remove()
+        super()._remove()
+
+    @property
+    def _children(self):
+        return self.potentials + [self.nlist]
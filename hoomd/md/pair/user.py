@@ -0,0 +1,202 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""User-defined pair potentials for molecular dynamics."""
+
+import hoomd
+from hoomd import _compile
+from hoomd.md.pair.pair import Pair
+if hoomd.version.llvm_enabled:
+    from hoomd.md import _jit
+from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
+from hoomd.data.typeparam import TypeParameter
+
+
+class CPPPotential(Pair):
+    r"""Pair potential given in C++ code compiled at runtime.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        code (str): C++ code defining the body of the pair function.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+        default_r_on (float): Default turn-on radius :math:`[\mathrm{length}]`.
+        mode (str): Energy shifting/smoothing mode.
+
+    `CPPPotential` compiles the C++ code provided by the user into the same
+    pair force loop (and on the GPU, the same kernel) that evaluates the built
+    in pair potentials, so the user potential runs at the same speed. HOOMD
+    compiles the code with LLVM on the CPU and with NVRTC on NVIDIA GPUs. See
+    `Pair` for details on how forces are calculated and the available energy
+    shifting and smoothing modes.
+
+    Warning:
+        `CPPPotential` is **experimental** and subject to change in future
+        minor releases.
+
+    .. rubric:: C++ code
+
+    The code is the body of a function with the signature:
+
+    .. code::
+
+        Scalar eval(Scalar r_sq,
+                    Scalar q_i,
+                    Scalar q_j,
+                    const Scalar* params,
+                    Scalar& force_divr)
+
+    * ``r_sq`` is the squared distance between the particles.
+    * ``q_i`` and ``q_j`` are the charges of particles *i* and *j*.
+    * ``params`` holds the values of ``params[(type_i, type_j)]['params']``.
+
+    The code must set ``force_divr`` to
+    :math:`-\frac{1}{r} \frac{\partial V}{\partial r}` and return :math:`V(r)`.
+    ``Scalar`` is ``float`` or ``double``, matching the precision of the HOOMD
+    build. The functions in `HOOMDMath.h`_ (such as ``fast::sqrt``) are
+    available.
+
+    .. _HOOMDMath.h: https://github.com/glotzerlab/hoomd-blue/blob/\
+            v3.0.0-beta.9/hoomd/HOOMDMath.h
+
+    `CPPPotential` supports the standard neighbor lists on the GPU. The
+    compressed rows of a neighbor list are not used and the cluster pair
+    neighbor list is not supported.
+
+    .. rubric:: Compilation cache
+
+    Set the environment variable ``HOOMD_JIT_CACHE_DIR`` to a directory to
+    cache the compiled code on disk. Later jobs that compile the same code with
+    the same version of HOOMD-blue load it from the cache instead.
+
+    .. py:attribute:: params
+
+        The potential parameters. The dictionary has the following keys:
+
+        * ``params`` (`list` [`float`], **required**) - values available in
+          ``params`` in the C++ code, at most 8.
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    Attributes:
+        code (str): The C++ code that defines the body of the pair function.
+            After running zero or more steps, this property cannot be changed.
+
+    Example::
+
+        nl = nlist.Cell()
+        lj_code = '''
+            Scalar r2inv = Scalar(1.0) / r_sq;
+            Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar s6 = params[1] * params[1] * params[1]
+                        * params[1] * params[1] * params[1];
+            Scalar lj1 = Scalar(4.0) * params[0] * s6 * s6;
+            Scalar lj2 = Scalar(4.0) * params[0] * s6;
+            force_divr = r2inv * r6inv
+                         * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
+            return r6inv * (lj1 * r6inv - lj2);
+        '''
+        lj = pair.user.CPPPotential(nl, code=lj_code, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(params=[1.0, 1.0])
+    """
+    _tabulate_supported = False
+
+    def __init__(self,
+                 nlist,
+                 code,
+                 default_r_cut=None,
+                 default_r_on=0.,
+                 mode='none'):
+        super().__init__(nlist, default_r_cut, default_r_on, mode)
+        params = TypeParameter('params', 'particle_types',
+                               TypeParameterDict(params=[float], len_keys=2))
+        self._add_typeparam(params)
+        self._param_dict.update(ParameterDict(code=str))
+        self.code = code
+
+    def _getattr_param(self, attr):
+        if attr == 'code':
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def _attach(self):
+        if not hoomd.version.llvm_enabled:
+            raise RuntimeError("CPPPotential requires HOOMD-blue built with "
+                               "LLVM support.")
+
+        self._attach_nlist()
+        device = self._simulation.device
+        cpp_sys_def = self._simulation.state._cpp_sys_def
+
+        cpu_code = self._wrap_cpu_code(self.code)
+        cpu_include_options = _compile.get_cpu_include_options()
+
+        if isinstance(device, hoomd.device.GPU):
+            gpu_settings = _compile.get_gpu_compilation_settings(device)
+            self._cpp_obj = _jit.PotentialPairJITGPU(
+                cpp_sys_def,
+                self.nlist._cpp_obj,
+                cpu_code,
+                cpu_include_options,
+                self._wrap_gpu_code(self.code),
+                gpu_settings["includes"],
+                gpu_settings["max_arch"],
+            )
+        else:
+            self._cpp_obj = _jit.PotentialPairJIT(
+                cpp_sys_def,
+                self.nlist._cpp_obj,
+                cpu_code,
+                cpu_include_options,
+            )
+
+        # skip Pair._attach, which creates a built in pair potential
+        super(Pair, self)._attach()
+
+    @staticmethod
+    def _wrap_cpu_code(code):
+        """Wrap the provided code into a function with the expected signature.
+
+        Args:
+            code (`str`): Body of the C++ function
+        """
+        return f"""
+                #include "hoomd/HOOMDMath.h"
+
+                extern "C"
+                {{
+                Scalar eval(Scalar r_sq,
+                            Scalar q_i,
+                            Scalar q_j,
+                            const Scalar* params,
+                            Scalar& force_divr)
+                    {{
+                {code}
+                    }}
+                }}
+                """
+
+    @staticmethod
+    def _wrap_gpu_code(code):
+        """Compile the provided code into the pair force kernels.
+
+        Args:
+            code (`str`): Body of the C++ function
+        """
+        return f"""
+                #include "hoomd/HOOMDMath.h"
+
+                __device__ inline Scalar eval(Scalar r_sq,
+                                              Scalar q_i,
+                                              Scalar q_j,
+                                              const Scalar* params,
+                                              Scalar& force_divr)
+                    {{
+                {code}
+                    }}
+
+                #define HOOMD_PAIR_JIT_DEVICE
+                #include "hoomd/md/EvaluatorPairJIT.h"
+                #include "hoomd/md/PotentialPairGPU.cuh"
+                """
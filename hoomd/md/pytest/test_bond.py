@@ -136,3 +136,37 @@ def test_forces_and_energies(two_particle_snapshot_factory, simulation_factory,
         np.testing.assert_allclose(sim_forces[1], [-1 * force, 0.0, 0.0],
                                    rtol=1e-2,
                                    atol=1e-5)
+
+
+def test_run_on_host(two_particle_snapshot_factory, simulation_factory):
+    snap = two_particle_snapshot_factory(d=0.969, L=5)
+    if snap.communicator.rank == 0:
+        snap.bonds.N = 1
+        snap.bonds.types = ['bond']
+        snap.bonds.typeid[0] = 0
+        snap.bonds.group[0] = (0, 1)
+    sim = simulation_factory(snap)
+
+    harmonic = hoomd.md.bond.Harmonic()
+    harmonic.params['bond'] = dict(k=30.0, r0=1.6)
+    harmonic.run_on_host = True
+    assert harmonic.run_on_host
+
+    # forces without a host implementation do not support run_on_host
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+    with pytest.raises(ValueError):
+        lj.run_on_host = True
+
+    integrator = hoomd.md.Integrator(dt=0.005, forces=[harmonic])
+    integrator.methods.append(hoomd.md.methods.NVE(filter=hoomd.filter.All()))
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    with pytest.raises(RuntimeError):
+        harmonic.run_on_host = False
+
+    sim_forces = harmonic.forces
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(sim_forces[0], [-18.9300, 0.0, 0.0],
+                                   rtol=1e-2,
+                                   atol=1e-5)
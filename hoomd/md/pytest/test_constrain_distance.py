@@ -75,6 +75,16 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     d.tolerance = 1e-3
     assert d.tolerance == 1e-3
 
+    assert d.solver == 'direct'
+    d.solver = 'iterative'
+    assert d.solver == 'iterative'
+    with pytest.raises(ValueError):
+        d.solver = 'invalid'
+
+    assert d.iterations == 16
+    d.iterations = 8
+    assert d.iterations == 8
+
     # attached
     sim = simulation_factory(polymer_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
@@ -88,6 +98,14 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     d.tolerance = 1e-5
     assert d.tolerance == 1e-5
 
+    assert d.solver == 'iterative'
+    d.solver = 'direct'
+    assert d.solver == 'direct'
+
+    assert d.iterations == 8
+    d.iterations = 32
+    assert d.iterations == 32
+
 
 def test_pickling(simulation_factory, polymer_snapshot_factory):
     """Test that md.constrain.Distance can be pickled and unpickled."""
@@ -106,9 +124,10 @@ def test_pickling(simulation_factory, polymer_snapshot_factory):
     pickling_check(d)
 
 
-def test_basic_simulation(simulation_factory, polymer_snapshot_factory):
+@pytest.mark.parametrize("solver", ['direct', 'iterative'])
+def test_basic_simulation(simulation_factory, polymer_snapshot_factory, solver):
     """Ensure that distances are constrained in a basic simulation."""
-    d = hoomd.md.constrain.Distance()
+    d = hoomd.md.constrain.Distance(solver=solver)
 
     sim = simulation_factory(polymer_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
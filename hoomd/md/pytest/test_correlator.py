@@ -0,0 +1,113 @@
+import hoomd
+from hoomd.conftest import logging_check
+from hoomd.error import MutabilityError
+import numpy as np
+import pytest
+
+
+def test_before_attaching():
+    trigger = hoomd.trigger.Periodic(10)
+    correlator = hoomd.md.compute.Correlator(trigger,
+                                             hoomd.filter.All(),
+                                             heat_flux=True,
+                                             num_points=8,
+                                             averaging=4,
+                                             num_levels=3)
+    assert correlator.trigger is trigger
+    assert correlator.pressure_tensor
+    assert correlator.heat_flux
+    assert not correlator.msd
+    assert correlator.num_points == 8
+    assert correlator.averaging == 4
+    assert correlator.num_levels == 3
+
+
+def test_after_attaching(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[nve])
+
+    correlator = hoomd.md.compute.Correlator(hoomd.trigger.Periodic(1),
+                                             hoomd.filter.All(),
+                                             heat_flux=True,
+                                             num_points=8,
+                                             averaging=2,
+                                             num_levels=3)
+    sim.operations.writers.append(correlator)
+    sim.run(0)
+
+    assert correlator.num_points == 8
+    with pytest.raises(MutabilityError):
+        correlator.num_points = 16
+
+    sim.run(20)
+    assert correlator.num_samples == 20
+
+    # level 0 has lags 0-7, levels 1 and 2 add lags 4-7 when enough averages
+    # are available
+    lag = correlator.lag
+    np.testing.assert_allclose(lag[:8], range(8))
+    assert len(correlator.pressure_tensor_correlation) == len(lag)
+    assert len(correlator.heat_flux_correlation) == len(lag)
+    assert len(correlator.mean_squared_displacement) == 0
+
+    correlator.reset()
+    assert correlator.num_samples == 0
+
+
+@pytest.mark.serial
+def test_ballistic_msd(simulation_factory, two_particle_snapshot_factory):
+    snap = two_particle_snapshot_factory()
+    velocity = np.array([[1.0, 0.5, 0], [-0.25, 0, 2.0]])
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = velocity
+    sim = simulation_factory(snap)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    dt = 0.005
+    sim.operations.integrator = hoomd.md.Integrator(dt, methods=[nve])
+
+    correlator = hoomd.md.compute.Correlator(hoomd.trigger.Periodic(1),
+                                             hoomd.filter.All(),
+                                             pressure_tensor=False,
+                                             msd=True,
+                                             num_points=8,
+                                             averaging=2,
+                                             num_levels=4)
+    sim.operations.writers.append(correlator)
+    sim.run(2000)
+
+    # Without forces, the displacement is linear in time. The averages on the
+    # coarser levels are then displaced by the same amount as the samples.
+    lag = correlator.lag
+    expected = np.mean(np.sum(velocity**2, axis=1)) * (lag * dt)**2
+    np.testing.assert_allclose(correlator.mean_squared_displacement,
+                               expected,
+                               rtol=1e-3,
+                               atol=1e-6)
+    assert len(correlator.pressure_tensor_correlation) == 0
+
+
+def test_logging():
+    logging_check(
+        hoomd.md.compute.Correlator, ('md', 'compute'), {
+            'num_samples': {
+                'category': hoomd.logging.LoggerCategories.scalar,
+                'default': True
+            },
+            'lag': {
+                'category': hoomd.logging.LoggerCategories.sequence,
+                'default': True
+            },
+            'pressure_tensor_correlation': {
+                'category': hoomd.logging.LoggerCategories.sequence,
+                'default': True
+            },
+            'heat_flux_correlation': {
+                'category': hoomd.logging.LoggerCategories.sequence,
+                'default': True
+            },
+            'mean_squared_displacement': {
+                'category': hoomd.logging.LoggerCategories.sequence,
+                'default': True
+            }
+        })
@@ -0,0 +1,77 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+@pytest.fixture
+def bond_snapshot_factory(two_particle_snapshot_factory):
+
+    def make_snapshot():
+        snap = two_particle_snapshot_factory(d=1.2)
+        if snap.communicator.rank == 0:
+            snap.bonds.types = ['reversible']
+        return snap
+
+    return make_snapshot
+
+
+def test_before_attaching():
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    dynamic_bond = hoomd.md.update.DynamicBond(hoomd.trigger.Periodic(10),
+                                               nlist=nlist,
+                                               filter=hoomd.filter.All(),
+                                               bond_type='reversible',
+                                               r_form=1.5,
+                                               p_form=0.5,
+                                               p_break=0.1,
+                                               max_bonds=2)
+    assert dynamic_bond.nlist is nlist
+    assert dynamic_bond.bond_type == 'reversible'
+    np.testing.assert_allclose(dynamic_bond.r_form, 1.5)
+    np.testing.assert_allclose(dynamic_bond.p_form, 0.5)
+    np.testing.assert_allclose(dynamic_bond.p_break, 0.1)
+    assert dynamic_bond.max_bonds == 2
+
+
+def test_form_and_break(simulation_factory, bond_snapshot_factory, device):
+    if device.communicator.num_ranks > 1:
+        pytest.skip("DynamicBond does not support domain decomposition")
+
+    sim = simulation_factory(bond_snapshot_factory())
+    nlist = hoomd.md.nlist.Cell(buffer=0.4, exclusions=['bond'])
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    harmonic = hoomd.md.bond.Harmonic()
+    harmonic.params['reversible'] = dict(k=10.0, r0=1.2)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(0.005,
+                                                    methods=[nve],
+                                                    forces=[lj, harmonic])
+
+    dynamic_bond = hoomd.md.update.DynamicBond(hoomd.trigger.Periodic(1),
+                                               nlist=nlist,
+                                               filter=hoomd.filter.All(),
+                                               bond_type='reversible',
+                                               r_form=1.5,
+                                               p_form=1.0,
+                                               p_break=0.0)
+    sim.operations.updaters.append(dynamic_bond)
+    sim.run(0)
+    assert lj.energy != 0
+
+    # the pair forms exactly one bond and is excluded from the pair potential
+    sim.run(2)
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        assert snap.bonds.N == 1
+        assert set(snap.bonds.group[0]) == {0, 1}
+    assert lj.energy == 0
+
+    # break the bond and stop forming new ones
+    dynamic_bond.p_form = 0.0
+    dynamic_bond.p_break = 1.0
+    sim.run(1)
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        assert snap.bonds.N == 0
+    assert lj.energy != 0
@@ -2,6 +2,7 @@ import hoomd
 import numpy as np
 import pytest
 try:
+    import gsd.fl
     import gsd.hoomd
 except ImportError:
     pytest.skip("gsd not available", allow_module_level=True)
@@ -228,6 +229,209 @@ def test_write_gsd_truncate(create_md_sim, tmp_path):
                 assert_equivalent_snapshots(gsd_snap, snapshot)
 
 
+@pytest.mark.parametrize("max_queue_depth", [1, 3])
+def test_write_gsd_asynchronous(create_md_sim, tmp_path, max_queue_depth):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+    filename_sync = tmp_path / "temporary_test_file_sync.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['momentum'],
+                                 asynchronous=True,
+                                 max_queue_depth=max_queue_depth)
+    gsd_writer_sync = hoomd.write.GSD(filename=filename_sync,
+                                      trigger=hoomd.trigger.Periodic(1),
+                                      mode='wb',
+                                      dynamic=['momentum'])
+    sim.operations.writers.append(gsd_writer)
+    sim.operations.writers.append(gsd_writer_sync)
+
+    sim.run(8)
+    assert gsd_writer.asynchronous
+    assert gsd_writer.max_queue_depth == max_queue_depth
+
+    # run() flushes the queue, the file is complete here
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj, \
+                gsd.hoomd.open(name=filename_sync, mode='rb') as traj_sync:
+            assert len(traj) == 8
+            assert len(traj_sync) == 8
+            for frame, frame_sync in zip(traj, traj_sync):
+                assert frame.configuration.step == frame_sync.configuration.step
+                np.testing.assert_array_equal(frame.particles.position,
+                                              frame_sync.particles.position)
+                np.testing.assert_array_equal(frame.particles.velocity,
+                                              frame_sync.particles.velocity)
+
+    # switching to synchronous mode writes the remaining frames
+    gsd_writer.asynchronous = False
+    sim.run(2)
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj:
+            assert len(traj) == 10
+
+
+def test_write_gsd_shard(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+    filename_gather = tmp_path / "temporary_test_file_gather.gsd"
+    filename_merged = tmp_path / "temporary_test_file_merged.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(5),
+                                 mode='wb',
+                                 dynamic=['momentum'],
+                                 shard=True)
+    gsd_writer_gather = hoomd.write.GSD(filename=filename_gather,
+                                        trigger=hoomd.trigger.Periodic(5),
+                                        mode='wb',
+                                        dynamic=['momentum'])
+    sim.operations.writers.append(gsd_writer)
+    sim.operations.writers.append(gsd_writer_gather)
+
+    sim.run(20)
+    assert gsd_writer.shard
+
+    if sim.device.communicator.rank == 0:
+        hoomd.write.GSD.merge_shards(str(filename),
+                                     sim.device.communicator.num_ranks,
+                                     str(filename_merged))
+
+        with gsd.hoomd.open(name=filename_merged, mode='rb') as traj, \
+                gsd.hoomd.open(name=filename_gather, mode='rb') as traj_gather:
+            assert len(traj) == 4
+            assert len(traj_gather) == 4
+            for frame, frame_gather in zip(traj, traj_gather):
+                assert frame.configuration.step \
+                    == frame_gather.configuration.step
+                assert frame.particles.N == frame_gather.particles.N
+                np.testing.assert_array_equal(frame.particles.position,
+                                              frame_gather.particles.position)
+                np.testing.assert_array_equal(frame.particles.velocity,
+                                              frame_gather.particles.velocity)
+                np.testing.assert_array_equal(frame.particles.typeid,
+                                              frame_gather.particles.typeid)
+                np.testing.assert_array_equal(frame.bonds.group,
+                                              frame_gather.bonds.group)
+
+
+def test_write_gsd_incremental(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+    filename_full = tmp_path / "temporary_test_file_full.gsd"
+
+    sim = create_md_sim
+    dynamic = ['attribute', 'property', 'momentum', 'topology']
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(5),
+                                 mode='wb',
+                                 dynamic=dynamic,
+                                 incremental=True)
+    gsd_writer_full = hoomd.write.GSD(filename=filename_full,
+                                      trigger=hoomd.trigger.Periodic(5),
+                                      mode='wb',
+                                      dynamic=dynamic)
+    sim.operations.writers.append(gsd_writer)
+    sim.operations.writers.append(gsd_writer_full)
+
+    sim.run(15)
+    assert gsd_writer.incremental
+
+    if sim.device.communicator.rank == 0:
+        # unchanged quantities are only in frame 0
+        with gsd.fl.open(name=filename, mode='rb') as f:
+            assert f.nframes == 3
+            assert f.chunk_exists(frame=0, name='particles/typeid')
+            assert f.chunk_exists(frame=0, name='bonds/group')
+            for frame in range(1, 3):
+                assert f.chunk_exists(frame=frame, name='particles/position')
+                assert f.chunk_exists(frame=frame, name='particles/velocity')
+                assert not f.chunk_exists(frame=frame, name='particles/typeid')
+                assert not f.chunk_exists(frame=frame, name='particles/mass')
+                assert not f.chunk_exists(frame=frame, name='bonds/group')
+
+        # readers see the same trajectory
+        with gsd.hoomd.open(name=filename, mode='rb') as traj, \
+                gsd.hoomd.open(name=filename_full, mode='rb') as traj_full:
+            assert len(traj) == len(traj_full)
+            for frame, frame_full in zip(traj, traj_full):
+                np.testing.assert_array_equal(frame.particles.position,
+                                              frame_full.particles.position)
+                np.testing.assert_array_equal(frame.particles.typeid,
+                                              frame_full.particles.typeid)
+                np.testing.assert_array_equal(frame.particles.mass,
+                                              frame_full.particles.mass)
+                np.testing.assert_array_equal(frame.bonds.group,
+                                              frame_full.bonds.group)
+
+
+@pytest.mark.parametrize("asynchronous", [False, True])
+def test_write_gsd_compress(create_md_sim, simulation_factory, tmp_path,
+                            asynchronous):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+    filename_full = tmp_path / "temporary_test_file_full.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(5),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum'],
+                                 asynchronous=asynchronous,
+                                 compress=True,
+                                 position_precision=1e-3)
+    gsd_writer_full = hoomd.write.GSD(filename=filename_full,
+                                      trigger=hoomd.trigger.Periodic(5),
+                                      mode='wb',
+                                      dynamic=['property', 'momentum'])
+    sim.operations.writers.append(gsd_writer)
+    sim.operations.writers.append(gsd_writer_full)
+
+    sim.run(15)
+    assert gsd_writer.compress
+    assert gsd_writer.position_precision == 1e-3
+    assert gsd_writer.velocity_precision is None
+
+    if sim.device.communicator.rank == 0:
+        with gsd.fl.open(name=filename, mode='rb') as f:
+            assert f.nframes == 3
+            assert f.chunk_exists(frame=0, name='particles/N')
+            assert f.chunk_exists(frame=0,
+                                  name='compressed/particles/position')
+            assert not f.chunk_exists(frame=0, name='particles/position')
+
+        for frame in range(3):
+            reader = hoomd._hoomd.GSDStateReader(str(filename), frame)
+            reader_full = hoomd._hoomd.GSDStateReader(str(filename_full),
+                                                      frame)
+            np.testing.assert_allclose(
+                reader.readChunk('particles/position'),
+                reader_full.readChunk('particles/position'),
+                rtol=0,
+                atol=0.5e-3 + 1e-5)
+            for name in ['particles/velocity', 'particles/typeid']:
+                np.testing.assert_array_equal(reader.readChunk(name),
+                                              reader_full.readChunk(name))
+
+    # create_state_from_gsd reads compressed files
+    sim_compressed = simulation_factory()
+    sim_compressed.create_state_from_gsd(filename=filename, frame=2)
+    snap = sim_compressed.state.get_snapshot()
+    snap_full = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(snap.particles.position,
+                                   snap_full.particles.position,
+                                   rtol=0,
+                                   atol=0.5e-3 + 1e-5)
+        np.testing.assert_array_equal(snap.particles.typeid,
+                                      snap_full.particles.typeid)
+        np.testing.assert_array_equal(snap.bonds.group, snap_full.bonds.group)
+
+
 def test_write_gsd_dynamic(simulation_factory, create_md_sim, tmp_path):
 
     filename = tmp_path / "temporary_test_file.gsd"
@@ -1,7 +1,9 @@
+import numpy
 import pytest
 
 import hoomd
 import hoomd.md as md
+from hoomd.conftest import forces_equality_check
 
 
 def make_simulation(simulation_factory, two_particle_snapshot_factory):
@@ -48,3 +50,162 @@ def test_detaching(make_simulation, methods, forces):
     assert not integrator._forces._synced
     assert not integrator._methods._synced
     assert not integrator._contraints._synced
+
+
+def _lj_gauss():
+    nlist = md.nlist.Cell()
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    gauss = md.pair.Gauss(nlist, default_r_cut=3.0)
+    gauss.params[("A", "A")] = {"epsilon": 0.5, "sigma": 1.0}
+    return lj, gauss
+
+
+def _overlap_ghost_update(overlap):
+    lj, _ = _lj_gauss()
+    integrator = md.Integrator(0.005,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               forces=[lj],
+                               overlap_ghost_update=overlap)
+    assert integrator.overlap_ghost_update == overlap
+    return integrator
+
+
+def _outer_forces(outer):
+    lj, gauss = _lj_gauss()
+    nve = md.methods.NVE(hoomd.filter.All())
+    if outer:
+        integrator = md.Integrator(0.005,
+                                   methods=[nve],
+                                   forces=[lj],
+                                   outer_forces=[gauss])
+    else:
+        integrator = md.Integrator(0.005, methods=[nve], forces=[lj, gauss])
+    assert integrator.outer_period == 1
+    return integrator
+
+
+def _accumulate_net_force(accumulate):
+    lj, gauss = _lj_gauss()
+    integrator = md.Integrator(0.005,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               forces=[lj, gauss],
+                               accumulate_net_force=accumulate)
+    assert integrator.accumulate_net_force == accumulate
+    return integrator
+
+
+# Integrator settings that must not change the trajectory: the integrator
+# factory and the getter of the setting.
+_same_forces_cases = [
+    pytest.param(_overlap_ghost_update,
+                 lambda integrator: integrator.overlap_ghost_update,
+                 id='overlap_ghost_update'),
+    # with an outer period of 1 the outer forces are applied every step
+    pytest.param(_outer_forces,
+                 lambda integrator: len(integrator.outer_forces) == 1,
+                 id='outer_forces'),
+    pytest.param(_accumulate_net_force,
+                 lambda integrator: integrator.accumulate_net_force,
+                 id='accumulate_net_force'),
+]
+
+
+@pytest.mark.parametrize("make_integrator, toggle", _same_forces_cases)
+def test_same_forces(simulation_factory, lattice_snapshot_factory,
+                     make_integrator, toggle):
+    """Test that alternate integration paths give the same trajectory."""
+    snap = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+    forces_equality_check(simulation_factory,
+                          snap,
+                          make_integrator,
+                          toggle=toggle,
+                          steps=10,
+                          rtol=1e-5,
+                          atol=1e-5)
+
+
+def test_outer_period(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.2, r=0.1))
+    integrator = _outer_forces(True)
+    gauss = integrator.outer_forces[0]
+    sim.operations.integrator = integrator
+    sim.run(10)
+    assert integrator.outer_period == 1
+
+    integrator.outer_period = 2
+    assert integrator.outer_period == 2
+    sim.run(10)
+    assert integrator.outer_period == 2
+    assert len(integrator.outer_forces) == 1
+    assert sim.timestep % integrator.outer_period == 0
+    assert numpy.isfinite(gauss.energy)
+
+    with pytest.raises(Exception):
+        integrator.outer_period = 0
+
+
+def test_deformation_rate(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+    sim = simulation_factory(snap)
+    nlist = md.nlist.Cell()
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    integrator = md.Integrator(0.005,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               forces=[lj],
+                               deformation_rate=(0, 0, 0, 1.0, 0, 0))
+    sim.operations.integrator = integrator
+    assert integrator.deformation_rate == (0, 0, 0, 1.0, 0, 0)
+
+    L = sim.state.box.Lx
+    sim.run(20)
+    assert integrator.deformation_rate == (0, 0, 0, 1.0, 0, 0)
+    assert sim.state.box.Lx == pytest.approx(L)
+    assert sim.state.box.xy == pytest.approx(0.1)
+
+    # the tilt is remapped to the equivalent lattice when it exceeds half of
+    # the box
+    sim.run(100)
+    assert sim.state.box.xy == pytest.approx(-0.4)
+
+    integrator.deformation_rate = (0, 0, 0, 0, 0, 0)
+    sim.run(10)
+    assert sim.state.box.xy == pytest.approx(-0.4)
+    assert numpy.isfinite(lj.energy)
+
+
+def test_lees_edwards(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+    # Lees-Edwards boundary conditions require that the box is not split along x
+    sim = simulation_factory(snap, domain_decomposition=(1, None, 1))
+    nlist = md.nlist.Cell()
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    integrator = md.Integrator(0.005,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               forces=[lj],
+                               deformation_rate=(0, 0, 0, 1.0, 0, 0),
+                               lees_edwards=True)
+    sim.operations.integrator = integrator
+    assert integrator.lees_edwards
+
+    def offset():
+        pdata = sim.state._cpp_sys_def.getParticleData()
+        return pdata.getGlobalBox().getLeesEdwardsOffset()
+
+    L = sim.state.box.Lx
+    sim.run(20)
+    assert integrator.lees_edwards
+    assert sim.state.box.xy == 0
+    assert offset() == pytest.approx(0.1 * L)
+
+    # the offset wraps back into the box
+    sim.run(100)
+    assert sim.state.box.xy == 0
+    assert offset() == pytest.approx(-0.4 * L)
+    assert numpy.isfinite(lj.energy)
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        assert numpy.all(numpy.abs(snap.particles.position) <= L / 2)
@@ -0,0 +1,70 @@
+import hoomd
+import numpy
+import pytest
+
+
+@pytest.fixture(scope='session')
+def methyl_snapshot_factory(device):
+    """Make a snapshot with a heavy atom bonded to three hydrogens."""
+
+    def make_snapshot():
+        """Make the snapshot.
+
+        Place one C bonded to three H and one isolated C in a 3D box.
+        """
+        s = hoomd.Snapshot(device.communicator)
+
+        if s.communicator.rank == 0:
+            s.configuration.box = [10, 10, 10, 0, 0, 0]
+            s.particles.N = 5
+            s.particles.types = ['C', 'H']
+            s.particles.position[:] = [[0, 0, 0], [1, 0, 0], [0, 1, 0],
+                                       [0, 0, 1], [3, 3, 3]]
+            s.particles.typeid[:] = [0, 1, 1, 1, 0]
+            s.particles.mass[:] = [12.0, 1.0, 1.0, 1.0, 12.0]
+            s.bonds.N = 3
+            s.bonds.types = ['CH']
+            s.bonds.group[:] = [[0, 1], [2, 0], [0, 3]]
+
+        return s
+
+    return make_snapshot
+
+
+def test_repartition_snapshot(methyl_snapshot_factory):
+    """Test that mass moves from the heavy atom to the hydrogens."""
+    snap = methyl_snapshot_factory()
+    result = hoomd.md.mass.repartition_hydrogen_mass(snap, factor=3.0)
+    assert result is snap
+
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap.particles.mass,
+                                      [6.0, 3.0, 3.0, 3.0, 12.0])
+
+
+def test_repartition_state(simulation_factory, methyl_snapshot_factory):
+    """Test that the state is modified in place."""
+    sim = simulation_factory(methyl_snapshot_factory())
+    hoomd.md.mass.repartition_hydrogen_mass(sim.state, factor=2.0)
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap.particles.mass,
+                                      [9.0, 2.0, 2.0, 2.0, 12.0])
+
+
+def test_repartition_errors(methyl_snapshot_factory):
+    """Test that invalid topologies and factors raise errors."""
+    with pytest.raises(ValueError):
+        hoomd.md.mass.repartition_hydrogen_mass(methyl_snapshot_factory(),
+                                                factor=0)
+
+    snap = methyl_snapshot_factory()
+    if snap.communicator.rank == 0:
+        with pytest.raises(ValueError):
+            hoomd.md.mass.repartition_hydrogen_mass(snap, factor=6.0)
+
+        snap = methyl_snapshot_factory()
+        snap.bonds.N = 2
+        with pytest.raises(ValueError):
+            hoomd.md.mass.repartition_hydrogen_mass(snap)
@@ -81,6 +81,7 @@ def _method_base_params():
     npt_extra_params = {
         'rescale_all': False,
         'gamma': 0.0,
+        'barostat_period': 1,
         'translational_thermostat_dof': (0.0, 0.0),
         'rotational_thermostat_dof': (0.0, 0.0),
         'barostat_dof': (0.0, 0.0, 0.0, 0.0, 0.0, 0.0)
@@ -94,6 +95,7 @@ def _method_base_params():
         'couple': 'none',
         'rescale_all': True,
         'gamma': 2.0,
+        'barostat_period': 10,
         'translational_thermostat_dof': (0.125, 0.5),
         'rotational_thermostat_dof': (0.5, 0.25),
         'barostat_dof': (1.0, 2.0, 4.0, 6.0, 8.0, 10.0)
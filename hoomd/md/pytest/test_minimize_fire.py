@@ -74,7 +74,8 @@ def test_get_set_params(simulation_factory, two_particle_snapshot_factory):
         'force_tol': 0.1,
         'angmom_tol': 0.1,
         'energy_tol': 1e-5,
-        'min_steps_conv': 10
+        'min_steps_conv': 10,
+        'stop_when_converged': False
     }
     _assert_correct_params(fire, default_params)
 
@@ -125,6 +126,32 @@ def test_run_minimization(lattice_snapshot_factory, simulation_factory):
     fire.reset()
 
 
+def test_stop_when_converged(lattice_snapshot_factory, simulation_factory):
+    """Relax several configurations, each in a single call to run."""
+    snap = lattice_snapshot_factory(a=1.5, n=8)
+    sim = simulation_factory(snap)
+
+    lj = md.pair.LJ(default_r_cut=2.5, nlist=md.nlist.Cell())
+    lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+    nve = md.methods.NVE(hoomd.filter.All())
+
+    fire = md.minimize.FIRE(dt=0.0025,
+                            methods=[nve],
+                            forces=[lj],
+                            min_steps_conv=3,
+                            stop_when_converged=True)
+    sim.operations.integrator = fire
+
+    for a in [1.5, 1.4]:
+        sim.state.set_snapshot(lattice_snapshot_factory(a=a, n=8))
+        fire.reset()
+        start = sim.timestep
+        sim.run(100000)
+        assert fire.converged
+        assert sim.timestep - start < 100000
+        assert sim.timestep - start >= fire.min_steps_conv
+
+
 def test_pickling(lattice_snapshot_factory, simulation_factory):
     """Assert the minimizer can be pickled when attached/unattached."""
     snap = lattice_snapshot_factory(a=1.5, n=5)
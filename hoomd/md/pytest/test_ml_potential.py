@@ -0,0 +1,129 @@
+import hoomd
+from hoomd import md
+import numpy as np
+import pytest
+
+# pairs that straddle the domain boundaries and the periodic boundary and a
+# triplet, separated by more than the cutoff
+_positions = [
+    [-0.3, 1.1, 1.3],
+    [0.25, 1.2, 1.3],
+    [2.1, -0.35, 2.2],
+    [2.2, 0.3, 2.1],
+    [-2.1, -2.2, -0.3],
+    [-2.0, -2.1, 0.35],
+    [4.8, 3.1, -3.0],
+    [-4.7, 3.2, -3.1],
+    [3.0, 3.0, 3.0],
+    [3.4, 3.2, 3.0],
+    [3.1, 3.5, 3.2],
+]
+
+
+def _harmonic_reference(positions, L, k, r_cut):
+    """Evaluate U(r) = k / 2 (r_cut - r)**2 with the conventions of the model.
+
+    The particle with the lower tag receives the energy and virial of a pair.
+    """
+    N = len(positions)
+    forces = np.zeros((N, 3))
+    energies = np.zeros(N)
+    virials = np.zeros((N, 6))
+    for i in range(N):
+        for j in range(i + 1, N):
+            dx = positions[i] - positions[j]
+            dx -= L * np.round(dx / L)
+            r = np.linalg.norm(dx)
+            if r >= r_cut:
+                continue
+            f = k * (r_cut - r) / r * dx
+            forces[i] += f
+            forces[j] -= f
+            energies[i] += 0.5 * k * (r_cut - r)**2
+            virials[i] += [
+                dx[0] * f[0], dx[0] * f[1], dx[0] * f[2], dx[1] * f[1],
+                dx[1] * f[2], dx[2] * f[2]
+            ]
+    return forces, energies, virials
+
+
+def test_invalid_model():
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    with pytest.raises(ValueError):
+        hoomd.md.many_body.MLPotential(nlist, model='model.pt')
+
+
+def test_abstract_model():
+    # models are implemented in C++ by plugins
+    with pytest.raises(TypeError):
+        hoomd.md._md.MLModel()
+
+
+def test_harmonic_model(simulation_factory, device):
+    """Compare the reference model to the analytic harmonic pair potential.
+
+    Run under MPI to exercise the reverse communication of the forces that the
+    model adds to ghosts. The particles start at rest, so one NVE step moves
+    each particle by dt**2 / 2 times its net force.
+    """
+    if (isinstance(device, hoomd.device.GPU)
+            and device.communicator.num_ranks > 1):
+        pytest.skip("Reverse force communication is not available on the GPU")
+
+    L = 10
+    k = 10
+    r_cut = 1.0
+    dt = 0.005
+    positions = np.array(_positions)
+
+    snap = hoomd.Snapshot(device.communicator)
+    if snap.communicator.rank == 0:
+        snap.configuration.box = [L, L, L, 0, 0, 0]
+        snap.particles.N = len(positions)
+        snap.particles.types = ['A']
+        snap.particles.position[:] = positions
+
+    model = md._md.HarmonicMLModel(k, r_cut)
+    assert model.r_cut == r_cut
+    assert model.interaction_range == r_cut
+    assert model.k == k
+    assert not model.supports_device
+
+    mlp = md.many_body.MLPotential(md.nlist.Cell(buffer=0.4), model=model)
+    nve = md.methods.NVE(filter=hoomd.filter.All())
+    sim = simulation_factory(snap)
+    sim.operations.integrator = md.Integrator(dt, forces=[mlp], methods=[nve])
+    sim.always_compute_pressure = True
+    sim.run(0)
+
+    forces_ref, energies_ref, virials_ref = _harmonic_reference(
+        positions, L, k, r_cut)
+    assert mlp.energy == pytest.approx(np.sum(energies_ref), rel=1e-5)
+
+    forces = mlp.forces
+    energies = mlp.energies
+    virials = mlp.virials
+    sim.run(1)
+    after = sim.state.get_snapshot()
+
+    if after.communicator.rank == 0:
+        np.testing.assert_allclose(energies, energies_ref, rtol=1e-5)
+        np.testing.assert_allclose(virials,
+                                   virials_ref,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+
+        # the forces on ghosts reach the net force of their owners
+        displacement = after.particles.position - positions
+        displacement -= L * np.round(displacement / L)
+        np.testing.assert_allclose(displacement,
+                                   forces_ref * dt**2 / 2,
+                                   rtol=1e-4,
+                                   atol=1e-8)
+
+        # without domain decomposition the per-force array is complete
+        if after.communicator.num_ranks == 1:
+            np.testing.assert_allclose(forces,
+                                       forces_ref,
+                                       rtol=1e-5,
+                                       atol=1e-6)
@@ -3,15 +3,18 @@ import hoomd
 import numpy as np
 import pytest
 import random
-from hoomd.md.nlist import Cell, Stencil, Tree
+from hoomd.conftest import forces_equality_check
+from hoomd.md.nlist import Auto, Cell, Cluster, Stencil, Tree
 
 
 def _nlist_params():
     """Each entry in the lsit is a tuple (class_obj, dict(required_args))."""
     nlists = []
     nlists.append((Cell, {}))
+    nlists.append((Cluster, {}))
     nlists.append((Tree, {}))
     nlists.append((Stencil, dict(cell_width=0.5)))
+    nlists.append((Auto, {}))
     return nlists
 
 
@@ -37,7 +40,9 @@ def test_common_params(nlist_params):
         "rebuild_check_delay": 1,
         "diameter_shift": False,
         "check_dist": True,
-        "max_diameter": 1.0
+        "max_diameter": 1.0,
+        "compressed": False,
+        "mask_exclusions": False
     }
     _assert_nlist_params(nlist, default_params_dict)
     new_params_dict = {
@@ -55,7 +60,11 @@ def test_common_params(nlist_params):
         "check_dist":
             False,
         "max_diameter":
-            np.random.uniform(10.3)
+            np.random.uniform(10.3),
+        "compressed":
+            True,
+        "mask_exclusions":
+            True
     }
     for param in new_params_dict.keys():
         setattr(nlist, param, new_params_dict[param])
@@ -69,6 +78,13 @@ def test_cell_specific_params():
     _assert_nlist_params(nlist, dict(deterministic=True))
 
 
+def test_cluster_specific_params():
+    nlist = Cluster()
+    _assert_nlist_params(nlist, dict(deterministic=False))
+    nlist.deterministic = True
+    _assert_nlist_params(nlist, dict(deterministic=True))
+
+
 def test_stencil_specific_params():
     cell_width = np.random.uniform(12.1)
     nlist = Stencil(cell_width)
@@ -80,6 +96,95 @@ def test_stencil_specific_params():
     _assert_nlist_params(nlist, dict(deterministic=True, cell_width=x))
 
 
+def test_auto_specific_params():
+    nlist = Auto()
+    _assert_nlist_params(nlist, dict(deterministic=False, iterations=10))
+    nlist.deterministic = True
+    nlist.iterations = 0
+    _assert_nlist_params(nlist, dict(deterministic=True, iterations=0))
+
+
+@pytest.mark.parametrize("r_cut_B, expected", [(1.1, 'cell'),
+                                               (3.0, 'stencil')])
+def test_auto_selection(simulation_factory, lattice_snapshot_factory, r_cut_B,
+                        expected):
+    """Test that Auto ranks the algorithms and gives the same forces."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=8, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::2] = 1
+
+    def make_integrator(nlist_cls):
+        if nlist_cls is Auto:
+            nlist = Auto(iterations=0, exclusions=())
+        else:
+            nlist = Tree(exclusions=())
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1, mode='shift')
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+        lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+        lj.r_cut[('B', 'B')] = r_cut_B
+        return hoomd.md.Integrator(0.005, forces=[lj])
+
+    simulations = forces_equality_check(simulation_factory,
+                                        snap,
+                                        make_integrator,
+                                        values=(Auto, Tree))
+    nlist = simulations[0].operations.integrator.forces[0].nlist
+    assert nlist.algorithm == expected
+
+
+def test_auto_benchmark(simulation_factory, lattice_snapshot_factory):
+    """Test that Auto selects one of the algorithms after timing them."""
+    nlist = Auto(iterations=2)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.2))
+    sim.operations.integrator = integrator
+    sim.run(2)
+    assert nlist.algorithm in ('cell', 'stencil', 'tree')
+    assert nlist.iterations == 2
+
+
+def test_tree_specific_params():
+    nlist = Tree()
+    _assert_nlist_params(nlist, dict(combined=False, max_refits=4))
+    nlist.combined = True
+    nlist.max_refits = 0
+    _assert_nlist_params(nlist, dict(combined=True, max_refits=0))
+
+
+def test_tree_combined_forces(simulation_factory, lattice_snapshot_factory):
+    """Test that the combined tree gives the same forces as per-type trees."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=6, a=1.2,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::2] = 1
+
+    def make_integrator(combined):
+        nlist = Tree(exclusions=(), combined=combined)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5, mode='shift')
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+        lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+        lj.r_cut[('A', 'B')] = 1.5
+        lj.r_cut[('B', 'B')] = 0.0
+        return hoomd.md.Integrator(0.005, forces=[lj])
+
+    simulations = forces_equality_check(
+        simulation_factory,
+        snap,
+        make_integrator,
+        toggle=lambda integrator: integrator.forces[0].nlist.combined)
+
+    # rebuild the neighbor list several times to refit the trees
+    for sim in simulations:
+        sim.operations.integrator.methods.append(
+            hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+        sim.run(20)
+
+
 def test_simple_simulation(nlist_params, simulation_factory,
                            lattice_snapshot_factory):
     nlist_cls, required_args = nlist_params
@@ -120,3 +225,192 @@ def test_auto_detach_simulation(simulation_factory,
     del integrator.forces[0]
     assert not nlist._attached
     assert nlist._cpp_obj is None
+
+
+@pytest.mark.parametrize("mode", ['none', 'shift', 'xplor'])
+def test_cluster_forces(simulation_factory, lattice_snapshot_factory, mode):
+    """Test that cluster pairs give the same forces as the cell list."""
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+
+    def make_integrator(nlist_cls):
+        nlist = nlist_cls(exclusions=())
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5, default_r_on=2.0,
+                              mode=mode)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        return hoomd.md.Integrator(0.005, forces=[lj])
+
+    forces_equality_check(simulation_factory,
+                          snap,
+                          make_integrator,
+                          values=(Cell, Cluster))
+
+
+def test_compressed_forces(simulation_factory, lattice_snapshot_factory,
+                           nlist_params):
+    """Test that compressed storage gives the same forces."""
+    nlist_cls, required_args = nlist_params
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+
+    def make_integrator(compressed):
+        nlist = nlist_cls(exclusions=(), compressed=compressed,
+                          **required_args)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5, mode='shift')
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        return hoomd.md.Integrator(0.005, forces=[lj])
+
+    forces_equality_check(
+        simulation_factory,
+        snap,
+        make_integrator,
+        toggle=lambda integrator: integrator.forces[0].nlist.compressed)
+
+
+def test_mask_exclusions_forces(simulation_factory, lattice_snapshot_factory,
+                               nlist_params):
+    """Test that exclusion masks give the same forces as filtering."""
+    nlist_cls, required_args = nlist_params
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    if snap.communicator.rank == 0:
+        # chains of consecutive tags fit in the masks, the last bonds do not
+        chain = [[i, i + 1] for i in range(snap.particles.N - 1) if i % 4 != 3]
+        far = [[i, i + 100] for i in range(0, 40, 8)]
+        snap.bonds.types = ['A']
+        snap.bonds.N = len(chain) + len(far)
+        snap.bonds.group[:] = chain + far
+
+    def make_integrator(mask_exclusions):
+        nlist = nlist_cls(exclusions=('bond', '1-3'),
+                          mask_exclusions=mask_exclusions,
+                          **required_args)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5, mode='shift')
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        return hoomd.md.Integrator(0.005, forces=[lj])
+
+    forces_equality_check(
+        simulation_factory,
+        snap,
+        make_integrator,
+        toggle=lambda integrator: integrator.forces[0].nlist.mask_exclusions)
+
+
+def test_shell_forces(simulation_factory, lattice_snapshot_factory):
+    """Test that potentials with different cutoffs can share a neighbor list."""
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+
+    def make_integrator(shared):
+        nlist = Cell(exclusions=())
+        wca = hoomd.md.pair.LJ(nlist, default_r_cut=2**(1 / 6), mode='shift')
+        wca.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        yukawa = hoomd.md.pair.Yukawa(nlist if shared else Cell(exclusions=()),
+                                      default_r_cut=3.0)
+        yukawa.params[('A', 'A')] = dict(epsilon=1, kappa=1)
+        return hoomd.md.Integrator(0.005, forces=[wca, yukawa])
+
+    forces_equality_check(simulation_factory, snap, make_integrator)
+
+
+def test_local_nlist_arrays(simulation_factory, two_particle_snapshot_factory):
+    """Test access to the neighbor list arrays."""
+    nlist = Cell(exclusions=())
+    with pytest.raises(hoomd.error.DataAccessError):
+        nlist.cpu_local_nlist_arrays
+
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.0))
+    if sim.device.communicator.num_ranks > 1:
+        pytest.skip("Test the neighbors of both particles on one rank.")
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    with nlist.cpu_local_nlist_arrays as data:
+        head_list = np.array(data.head_list, copy=True)
+        n_neigh = np.array(data.n_neigh, copy=True)
+        nlist_array = np.array(data.nlist, copy=True)
+        if hasattr(np, 'from_dlpack'):
+            np.testing.assert_array_equal(np.from_dlpack(data.n_neigh),
+                                          n_neigh)
+        half_nlist = data.half_nlist
+        local_nlist = data.nlist
+
+    neighbors = [
+        list(nlist_array[head_list[i]:head_list[i] + n_neigh[i]])
+        for i in range(2)
+    ]
+    if half_nlist:
+        assert neighbors == [[1], []]
+    else:
+        assert neighbors == [[1], [0]]
+
+    with pytest.raises(hoomd.data.array.HOOMDArrayError):
+        local_nlist.__dlpack__()
+
+
+@pytest.mark.parametrize("exclusions", [['bond'], ['1-3'], ['1-4'],
+                                        ['bond', '1-3', '1-4']])
+def test_incremental_exclusions(simulation_factory, device, exclusions):
+    """Test that exclusions follow bonds added and removed during a run."""
+    if device.communicator.num_ranks > 1:
+        pytest.skip("DynamicBond does not support domain decomposition")
+
+    snap = hoomd.Snapshot(device.communicator)
+    if snap.communicator.rank == 0:
+        snap.configuration.box = [20, 20, 20, 0, 0, 0]
+        snap.particles.N = 4
+        snap.particles.types = ['A']
+        snap.particles.position[:] = [[-1.8, 0, 0], [-0.6, 0, 0], [0.6, 0, 0],
+                                      [1.8, 0, 0]]
+        snap.bonds.types = ['A']
+        snap.bonds.N = 2
+        snap.bonds.group[:] = [[0, 1], [2, 3]]
+
+    def make_lj(nlist):
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=4.0)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        return lj
+
+    def reference_energy(snapshot):
+        lj = make_lj(Cell(buffer=0.4, exclusions=exclusions))
+        sim = simulation_factory(snapshot)
+        sim.operations.integrator = hoomd.md.Integrator(0.005, forces=[lj])
+        sim.run(0)
+        return lj.energy
+
+    nlist = Cell(buffer=0.4, exclusions=exclusions)
+    lj = make_lj(nlist)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    dynamic_bond = hoomd.md.update.DynamicBond(hoomd.trigger.Periodic(1),
+                                               nlist=nlist,
+                                               filter=hoomd.filter.All(),
+                                               bond_type='A',
+                                               r_form=1.5,
+                                               p_form=1.0,
+                                               p_break=0.0,
+                                               max_bonds=2)
+    sim.operations.updaters.append(dynamic_bond)
+    sim.run(0)
+
+    # bond 1-2 joins the two bonds into a chain of four particles
+    sim.run(1)
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank == 0:
+        assert snapshot.bonds.N == 3
+    np.testing.assert_allclose(lj.energy,
+                               reference_energy(snapshot),
+                               rtol=1e-6)
+
+    # remove all bonds
+    dynamic_bond.p_form = 0.0
+    dynamic_bond.p_break = 1.0
+    sim.run(1)
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank == 0:
+        assert snapshot.bonds.N == 0
+    np.testing.assert_allclose(lj.energy,
+                               reference_energy(snapshot),
+                               rtol=1e-6)
@@ -0,0 +1,74 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test the neighbor list buffer tuner."""
+
+import hoomd
+import numpy
+import pytest
+
+
+@pytest.fixture
+def lj_simulation(simulation_factory, lattice_snapshot_factory):
+    """A Lennard-Jones liquid with a cell list."""
+    sim = simulation_factory(lattice_snapshot_factory(a=1.2, n=6))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1.5))
+    sim.operations.integrator = integrator
+    return sim, nlist
+
+
+def test_construction(lj_simulation):
+    _, nlist = lj_simulation
+    tuner = hoomd.md.tune.NeighborListBuffer(trigger=100,
+                                             nlist=nlist,
+                                             maximum_buffer=0.8)
+    assert tuner.nlist is nlist
+    assert tuner.maximum_buffer == 0.8
+    assert tuner.num_buffers == 8
+    assert tuner.tolerance == 0.2
+    assert tuner.iterations == 10
+    numpy.testing.assert_allclose(tuner.buffers,
+                                  numpy.linspace(0.1, 0.8, 8))
+
+    tuner.num_buffers = 4
+    numpy.testing.assert_allclose(tuner.buffers, [0.2, 0.4, 0.6, 0.8])
+
+    with pytest.raises(ValueError):
+        tuner.maximum_buffer = -1.0
+
+
+def test_tune(lj_simulation):
+    sim, nlist = lj_simulation
+    tuner = hoomd.md.tune.NeighborListBuffer(trigger=50,
+                                             nlist=nlist,
+                                             maximum_buffer=0.8,
+                                             num_buffers=4,
+                                             iterations=2)
+    sim.operations.tuners.append(tuner)
+
+    sim.run(101)
+    assert tuner.tuned
+    assert nlist.buffer in tuner.buffers
+    assert nlist.rebuild_check_delay >= 1
+
+    # the simulation keeps running with the tuned buffer
+    sim.run(50)
+    assert nlist.buffer in tuner.buffers
+
+
+def test_check_dist(lj_simulation):
+    sim, nlist = lj_simulation
+    nlist.check_dist = False
+    tuner = hoomd.md.tune.NeighborListBuffer(trigger=10,
+                                             nlist=nlist,
+                                             maximum_buffer=0.8)
+    sim.operations.tuners.append(tuner)
+
+    with pytest.raises(RuntimeError):
+        sim.run(11)
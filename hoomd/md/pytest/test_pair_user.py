@@ -0,0 +1,86 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test hoomd.md.pair.user.CPPPotential."""
+
+import hoomd
+import numpy as np
+import pytest
+
+# check if llvm_enabled
+llvm_disabled = not hoomd.version.llvm_enabled
+
+lj_code = '''
+    Scalar r2inv = Scalar(1.0) / r_sq;
+    Scalar r6inv = r2inv * r2inv * r2inv;
+    Scalar s6 = params[1] * params[1] * params[1]
+                * params[1] * params[1] * params[1];
+    Scalar lj1 = Scalar(4.0) * params[0] * s6 * s6;
+    Scalar lj2 = Scalar(4.0) * params[0] * s6;
+    force_divr = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv
+                                  - Scalar(6.0) * lj2);
+    return r6inv * (lj1 * r6inv - lj2);
+'''
+
+
+def test_before_attaching():
+    pot = hoomd.md.pair.user.CPPPotential(hoomd.md.nlist.Cell(),
+                                          code=lj_code,
+                                          default_r_cut=2.5)
+    pot.params[('A', 'A')] = dict(params=[1.0, 1.0])
+    assert pot.code == lj_code
+    assert pot.params[('A', 'A')]['params'] == [1.0, 1.0]
+    assert pot.r_cut[('A', 'A')] == 2.5
+
+    pot.code = 'force_divr = 0; return 0;'
+    assert pot.code == 'force_divr = 0; return 0;'
+
+
+@pytest.mark.skipif(llvm_disabled, reason='LLVM not enabled')
+@pytest.mark.parametrize("mode", ['none', 'shift', 'xplor'])
+def test_matches_lj(simulation_factory, lattice_snapshot_factory, mode):
+    """Compare the runtime compiled LJ potential with the built in one."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=5,
+                                    a=1.3,
+                                    r=0.05)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = np.arange(snap.particles.N) % 2
+    sim = simulation_factory(snap)
+
+    user = hoomd.md.pair.user.CPPPotential(hoomd.md.nlist.Cell(),
+                                           code=lj_code,
+                                           default_r_cut=2.5,
+                                           default_r_on=2.0,
+                                           mode=mode)
+    lj = hoomd.md.pair.LJ(hoomd.md.nlist.Cell(),
+                          default_r_cut=2.5,
+                          default_r_on=2.0,
+                          mode=mode)
+    for pair, (epsilon, sigma) in {
+        ('A', 'A'): (1.0, 1.0),
+        ('A', 'B'): (1.5, 0.9),
+        ('B', 'B'): (0.5, 1.1),
+    }.items():
+        user.params[pair] = dict(params=[epsilon, sigma])
+        lj.params[pair] = dict(epsilon=epsilon, sigma=sigma)
+
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.extend([user, lj])
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    user_forces = user.forces
+    lj_forces = lj.forces
+    user_energies = user.energies
+    lj_energies = lj.energies
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(user_forces,
+                                   lj_forces,
+                                   rtol=1e-4,
+                                   atol=1e-5)
+        np.testing.assert_allclose(user_energies,
+                                   lj_energies,
+                                   rtol=1e-4,
+                                   atol=1e-5)
@@ -7,7 +7,8 @@ import numpy as np
 import hoomd
 from hoomd import md
 from hoomd.logging import LoggerCategories
-from hoomd.conftest import logging_check, pickling_check
+from hoomd.conftest import (logging_check, pickling_check,
+                             forces_equality_check)
 from hoomd.error import TypeConversionError
 import pytest
 import itertools
@@ -122,6 +123,280 @@ def test_ron(simulation_factory, two_particle_snapshot_factory):
     assert _equivalent_data_structures({('A', 'A'): 1.0}, lj.r_on.to_dict())
 
 
+def _tabulated_mie(tabulate):
+    mie = md.pair.Mie(md.nlist.Cell(), default_r_cut=2.5, mode='shift')
+    mie.params[('A', 'A')] = dict(epsilon=1, sigma=1, n=14, m=7)
+    mie.tabulate = tabulate
+    mie.table_width = 4000
+    assert mie.tabulate == tabulate
+    assert mie.table_width == 4000
+    assert mie.table_r_min == 0.5
+    return md.Integrator(0.005, forces=[mie])
+
+
+def _lj_cell_tiles(mode):
+
+    def make_integrator(cell_tiles):
+        lj = md.pair.LJ(md.nlist.Cell(), default_r_cut=2.5, mode=mode)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.r_on[('A', 'A')] = 2.0
+        lj.cell_tiles = cell_tiles
+        assert lj.cell_tiles == cell_tiles
+        return md.Integrator(0.005, forces=[lj])
+
+    return make_integrator
+
+
+def _dpd_cell_tiles(cell_tiles):
+    dpd = md.pair.DPD(md.nlist.Cell(), default_r_cut=1.0, kT=1.5)
+    dpd.params[('A', 'A')] = dict(A=25, gamma=4.5)
+    dpd.cell_tiles = cell_tiles
+    return md.Integrator(0.005,
+                         forces=[dpd],
+                         methods=[md.methods.NVE(hoomd.filter.All())])
+
+
+def _half_nlist_lj(half_nlist):
+    lj = md.pair.LJ(md.nlist.Cell(), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.half_nlist = half_nlist
+    return md.Integrator(0.005, forces=[lj])
+
+
+# Settings that must not change the forces: the integrator factory, the
+# getter of the setting, the lattice constant, and the comparison options.
+_same_forces_cases = [
+    pytest.param(_tabulated_mie,
+                 lambda integrator: integrator.forces[0].tabulate,
+                 1.2,
+                 dict(rtol=1e-3, atol=(1e-3, 1e-5, 1e-3)),
+                 id='tabulate'),
+    *(pytest.param(_lj_cell_tiles(mode),
+                   lambda integrator: integrator.forces[0].cell_tiles,
+                   1.2,
+                   dict(rtol=1e-5, atol=1e-5),
+                   id=f'cell_tiles-{mode}')
+      for mode in ('none', 'shift', 'xplor')),
+    pytest.param(_dpd_cell_tiles,
+                 lambda integrator: integrator.forces[0].cell_tiles,
+                 0.8,
+                 dict(rtol=1e-5, atol=1e-5),
+                 id='dpd_cell_tiles'),
+    pytest.param(_half_nlist_lj,
+                 lambda integrator: integrator.forces[0].half_nlist,
+                 1.2,
+                 dict(rtol=1e-5, atol=1e-5),
+                 id='half_nlist'),
+]
+
+
+@pytest.mark.parametrize("make_integrator, toggle, a, options",
+                         _same_forces_cases)
+def test_same_forces(simulation_factory, lattice_snapshot_factory,
+                     make_integrator, toggle, a, options):
+    """Test that alternate evaluation paths compute the same forces."""
+    snap = lattice_snapshot_factory(n=6, a=a, r=0.1)
+    forces_equality_check(simulation_factory,
+                          snap,
+                          make_integrator,
+                          toggle=toggle,
+                          **options)
+
+
+def test_auto_cell_tiles(simulation_factory, lattice_snapshot_factory,
+                         device):
+    """Test that the automatic mode switches to cell tiles.
+
+    Without a buffer, the neighbor list is rebuilt on every step, so the
+    automatic mode chooses cell tiles after its first measurement window.
+    """
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Only the CPU evaluates cell tiles")
+
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+
+    lj = md.pair.LJ(md.nlist.Cell(buffer=0), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.auto_cell_tiles = True
+    integrator = md.Integrator(0.005, forces=[lj])
+    integrator.methods.append(md.methods.NVE(hoomd.filter.All()))
+
+    sim = simulation_factory(snap)
+    sim.operations.integrator = integrator
+    sim.run(0)
+    assert lj.cell_tile_computes == 0
+
+    sim.run(250)
+    assert lj.auto_cell_tiles
+    assert not lj.cell_tiles
+    assert lj.cell_tile_computes > 0
+
+    # the last step evaluated cell tiles
+    computes = lj.cell_tile_computes
+    sim.run(1)
+    assert lj.cell_tile_computes > computes
+    forces = lj.forces
+
+    reference = md.pair.LJ(md.nlist.Cell(), default_r_cut=2.5)
+    reference.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    reference_sim = simulation_factory(sim.state.get_snapshot())
+    reference_sim.operations.integrator = md.Integrator(0.005,
+                                                        forces=[reference])
+    reference_sim.run(0)
+    reference_forces = reference.forces
+    assert reference.cell_tile_computes == 0
+
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(forces,
+                                   reference_forces,
+                                   rtol=1e-5,
+                                   atol=1e-5)
+
+
+@pytest.mark.skipif(not hoomd.version.tbb_enabled, reason="Requires TBB")
+@pytest.mark.parametrize("mode", ['none', 'xplor'])
+def test_threads(simulation_factory, lattice_snapshot_factory, device, mode):
+    """Test that pairs evaluated by several threads match one thread.
+
+    The system spans several pages of the per-thread force accumulators. The
+    ``'xplor'`` mode evaluates the pairs one at a time instead of in batches.
+    """
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Threads are only used on the CPU")
+
+    def make_integrator(threads):
+        device.num_cpu_threads = threads
+        lj = md.pair.LJ(md.nlist.Cell(),
+                        default_r_cut=2.5,
+                        default_r_on=2.0,
+                        mode=mode)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        return md.Integrator(0.005, forces=[lj])
+
+    snap = lattice_snapshot_factory(n=12, a=1.2, r=0.1)
+    num_cpu_threads = device.num_cpu_threads
+    try:
+        forces_equality_check(simulation_factory,
+                              snap,
+                              make_integrator,
+                              values=(1, 4),
+                              rtol=1e-5,
+                              atol=1e-5)
+    finally:
+        device.num_cpu_threads = num_cpu_threads
+
+
+@pytest.mark.skipif(not hoomd.version.tbb_enabled, reason="Requires TBB")
+def test_concurrent_forces(simulation_factory, lattice_snapshot_factory,
+                           device):
+    """Test that pair forces computed concurrently match one thread.
+
+    With several threads, the integrator computes two or more pair forces as
+    nodes of one task graph and sums them after all nodes complete.
+    """
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Threads are only used on the CPU")
+
+    def make_integrator(threads):
+        device.num_cpu_threads = threads
+        nlist = md.nlist.Cell()
+        lj = md.pair.LJ(nlist, default_r_cut=2.5, mode='shift')
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        yukawa = md.pair.Yukawa(nlist, default_r_cut=3.0)
+        yukawa.params[('A', 'A')] = dict(epsilon=0.5, kappa=1)
+        return md.Integrator(0.005,
+                             forces=[lj, yukawa],
+                             methods=[md.methods.NVE(hoomd.filter.All())])
+
+    snap = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+    num_cpu_threads = device.num_cpu_threads
+    try:
+        simulations = forces_equality_check(simulation_factory,
+                                            snap,
+                                            make_integrator,
+                                            values=(1, 4),
+                                            steps=10,
+                                            rtol=1e-5,
+                                            atol=1e-5)
+    finally:
+        device.num_cpu_threads = num_cpu_threads
+
+    # the net force, energy, and virial of the local particles in tag order
+    results = []
+    for sim in simulations:
+        with sim.state.cpu_local_snapshot as data:
+            order = np.argsort(data.particles.tag)
+            results.append([
+                np.array(data.particles.net_force)[order],
+                np.array(data.particles.net_energy)[order],
+                np.array(data.particles.net_virial)[order]
+            ])
+
+    for threaded, serial in zip(results[1], results[0]):
+        np.testing.assert_allclose(threaded, serial, rtol=1e-5, atol=1e-5)
+
+
+def test_reverse_ghost_forces(simulation_factory, lattice_snapshot_factory):
+    """Test pairs with ghosts evaluated on one rank against the symmetric path.
+
+    Run under MPI to exercise the reverse communication of ghost forces. The
+    particles start at rest, so one NVE step moves each particle by
+    dt**2 / 2 times its net force.
+    """
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    dt = 0.005
+
+    results = []
+    for reverse_ghost_forces in (False, True):
+        lj = md.pair.LJ(md.nlist.Cell(), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.reverse_ghost_forces = reverse_ghost_forces
+        nve = md.methods.NVE(filter=hoomd.filter.All())
+        integrator = md.Integrator(dt, forces=[lj], methods=[nve])
+        thermo = md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.operations.computes.append(thermo)
+        sim.always_compute_pressure = True
+        sim.run(0)
+        assert lj.reverse_ghost_forces == reverse_ghost_forces
+
+        forces = lj.forces
+        energy = lj.energy
+        pressure = thermo.pressure
+        sim.run(1)
+        after = sim.state.get_snapshot()
+        if after.communicator.rank == 0:
+            L = after.configuration.box[0]
+            displacement = after.particles.position - snap.particles.position
+            displacement -= L * np.round(displacement / L)
+            results.append((forces, energy, pressure, displacement))
+
+    if results:
+        (forces, energy, pressure, displacement), reverse = results
+
+        # the per-force arrays of the symmetric path are complete
+        np.testing.assert_allclose(np.sum(forces, axis=0), [0, 0, 0],
+                                   atol=1e-3)
+        np.testing.assert_allclose(displacement,
+                                   forces * dt**2 / 2,
+                                   rtol=1e-3,
+                                   atol=1e-6)
+
+        # the reverse communication gives the same net forces and totals
+        np.testing.assert_allclose(reverse[3],
+                                   displacement,
+                                   rtol=1e-5,
+                                   atol=1e-7)
+        np.testing.assert_allclose(reverse[1], energy, rtol=1e-5)
+        np.testing.assert_allclose(reverse[2], pressure, rtol=1e-5)
+
+        # without domain decomposition the attribute has no effect
+        if snap.communicator.num_ranks == 1:
+            np.testing.assert_allclose(reverse[0], forces, rtol=1e-5)
+
+
 def _make_invalid_param_dict(valid_dict):
     """This could is fragile if multiple types are allowed for a key."""
     invalid_dicts = [valid_dict] * len(valid_dict.keys()) * 2
@@ -227,6 +502,11 @@ def _invalid_params():
     invalid_params_list.extend(
         _make_invalid_params(rf_invalid_dicts, md.pair.ReactionField, {}))
 
+    dsf_valid_dict = {"alpha": 0.5}
+    dsf_invalid_dicts = _make_invalid_param_dict(dsf_valid_dict)
+    invalid_params_list.extend(
+        _make_invalid_params(dsf_invalid_dicts, md.pair.DSF, {}))
+
     buckingham_valid_dict = {"A": 0.05, "rho": 0.5, "C": 0.05}
     buckingham_invalid_dicts = _make_invalid_param_dict(buckingham_valid_dict)
     invalid_params_list.extend(
@@ -470,6 +750,11 @@ def _valid_params(particle_types=['A', 'B']):
         paramtuple(md.pair.ReactionField,
                    dict(zip(combos, reactfield_valid_param_dicts)), {}))
 
+    dsf_arg_dict = {'alpha': [0.1, 0.5, 1.0]}
+    dsf_valid_param_dicts = _make_valid_param_dicts(dsf_arg_dict)
+    valid_params_list.append(
+        paramtuple(md.pair.DSF, dict(zip(combos, dsf_valid_param_dicts)), {}))
+
     buckingham_arg_dict = {
         'A': [.05, .025, .010],
         'rho': [.5, 1, 1.5],
@@ -642,7 +927,7 @@ def test_valid_params(valid_params):
 
 
 def _update_snap(pair_potential, snap):
-    if (any(name in str(pair_potential) for name in ['Ewald'])
+    if (any(name in str(pair_potential) for name in ['Ewald', 'DSF'])
             and snap.communicator.rank == 0):
         snap.particles.charge[:] = 1.
     if 'SLJ' in str(pair_potential) and snap.communicator.rank == 0:
@@ -1100,3 +1385,56 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(pot)
+
+
+def _fused(fused):
+    nlist = md.nlist.Cell()
+    lj = md.pair.LJ(nlist, default_r_cut=2.5, mode='shift')
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    yukawa = md.pair.Yukawa(nlist, default_r_cut=3.0)
+    yukawa.params[('A', 'A')] = dict(epsilon=0.5, kappa=1)
+    dpd = md.pair.DPDConservative(nlist, default_r_cut=1.5)
+    dpd.params[('A', 'A')] = dict(A=2)
+    if fused:
+        return md.Integrator(
+            0.005, forces=[md.pair.Fused(potentials=[dpd, lj, yukawa])])
+    return md.Integrator(0.005, forces=[lj, yukawa, dpd])
+
+
+def test_fused(simulation_factory, lattice_snapshot_factory):
+    """Test that fused potentials match the sum of the separate potentials."""
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    simulations = forces_equality_check(simulation_factory,
+                                        snap,
+                                        _fused,
+                                        sum_forces=True)
+
+    # the fused potential also provides the energies of each potential
+    results = []
+    for sim in simulations:
+        forces = sim.operations.integrator.forces
+        if isinstance(forces[0], md.pair.Fused):
+            forces = forces[0].potentials
+        forces = sorted(forces, key=lambda f: type(f).__name__)
+        energies = [f.energies for f in forces]
+        if energies[0] is not None:
+            results.append(energies)
+
+    if results:
+        for separate, combined in zip(*results):
+            np.testing.assert_allclose(combined,
+                                       separate,
+                                       rtol=1e-6,
+                                       atol=1e-9)
+
+
+def test_fused_invalid():
+    nlist = md.nlist.Cell()
+    lj = md.pair.LJ(nlist, default_r_cut=2.5)
+    gauss = md.pair.Gauss(nlist, default_r_cut=2.5)
+    with pytest.raises(ValueError):
+        md.pair.Fused(potentials=[lj, gauss])
+
+    yukawa = md.pair.Yukawa(md.nlist.Cell(), default_r_cut=2.5)
+    with pytest.raises(ValueError):
+        md.pair.Fused(potentials=[lj, yukawa])
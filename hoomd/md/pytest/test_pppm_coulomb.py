@@ -66,6 +66,12 @@ def test_attach_detach(simulation_factory,
     coulomb.alpha = 1.5
     assert coulomb.alpha == 1.5
 
+    assert coulomb.differentiation == 'ik'
+    coulomb.differentiation = 'ad'
+    assert coulomb.differentiation == 'ad'
+    with pytest.raises(ValueError):
+        coulomb.differentiation = 'fd'
+
     # attached
     sim = simulation_factory(two_charged_particle_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
@@ -83,6 +89,7 @@ def test_attach_detach(simulation_factory,
     assert coulomb.order == 4
     assert coulomb.r_cut == 2.5
     assert coulomb.alpha == 1.5
+    assert coulomb.differentiation == 'ad'
 
     assert ewald.params[('A', 'A')]['alpha'] == 1.5
 
@@ -140,3 +147,75 @@ def test_pppm_energy(simulation_factory, two_charged_particle_snapshot_factory):
     # The reference energy is from a LAMMPS simulation. The tolerance is large
     # as the PPPM parameters do not directly map between the two codes
     numpy.testing.assert_allclose(energy, -1.0021254, rtol=1e-2)
+
+
+def test_pppm_ad_forces(simulation_factory,
+                        two_charged_particle_snapshot_factory):
+    """Test that analytic differentiation matches ik differentiation."""
+    forces = {}
+    for differentiation in ('ik', 'ad'):
+        nlist = hoomd.md.nlist.Cell()
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist,
+            resolution=(64, 64, 64),
+            order=6,
+            r_cut=3.0,
+            alpha=0,
+            differentiation=differentiation)
+
+        sim = simulation_factory(two_charged_particle_snapshot_factory())
+        integrator = hoomd.md.Integrator(dt=0.005)
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        integrator.methods.append(nve)
+        integrator.forces.extend([ewald, coulomb])
+        sim.operations.integrator = integrator
+
+        sim.run(0)
+
+        ewald_forces = ewald.forces
+        coulomb_forces = coulomb.forces
+        if sim.device.communicator.rank == 0:
+            forces[differentiation] = ewald_forces + coulomb_forces
+
+    if sim.device.communicator.rank == 0:
+        # ad omits the self force correction, allow for the small difference
+        numpy.testing.assert_allclose(forces['ad'],
+                                      forces['ik'],
+                                      rtol=1e-2,
+                                      atol=1e-3)
+
+
+def test_tune_parameters(simulation_factory,
+                         two_charged_particle_snapshot_factory):
+    """Test that tune_pppm_coulomb_parameters picks valid parameters."""
+    sim = simulation_factory(two_charged_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    sim.operations.integrator = integrator
+
+    nlist = hoomd.md.nlist.Cell()
+    params = hoomd.md.long_range.pppm.tune_pppm_coulomb_parameters(
+        simulation=sim,
+        nlist=nlist,
+        accuracy=1e-3,
+        r_cut=[2.5, 3.0],
+        order=[5, 6],
+        steps=2)
+
+    assert sim.operations.integrator is integrator
+    assert params['r_cut'] in (2.5, 3.0)
+    assert params['order'] in (5, 6)
+    assert len(params['resolution']) == 3
+
+    with pytest.raises(RuntimeError):
+        hoomd.md.long_range.pppm.tune_pppm_coulomb_parameters(
+            simulation=sim,
+            nlist=nlist,
+            accuracy=1e-30,
+            r_cut=[2.5],
+            order=[5],
+            max_resolution=8)
+
+    ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+        nlist=nlist, **params)
+    integrator.forces.extend([ewald, coulomb])
+    sim.run(0)
@@ -0,0 +1,42 @@
+import hoomd
+import pytest
+
+
+def test_before_attaching():
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=1.0)
+    replica_exchange = hoomd.md.update.ReplicaExchange(
+        hoomd.trigger.Periodic(10), method=nvt)
+    assert replica_exchange.method is nvt
+
+
+def test_single_partition(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.5))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(0.005,
+                                                    methods=[nvt],
+                                                    forces=[lj])
+    replica_exchange = hoomd.md.update.ReplicaExchange(
+        hoomd.trigger.Periodic(1), method=nvt)
+    sim.operations.updaters.append(replica_exchange)
+    sim.run(5)
+
+    # a replica without a neighboring partition never exchanges
+    if sim.device.communicator.num_partitions == 1:
+        assert replica_exchange.exchanges == (0, 0)
+        assert nvt.kT(sim.timestep) == 1.0
+    assert replica_exchange.energy != 0
+
+
+def test_unsupported_method(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.5))
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[nve])
+    replica_exchange = hoomd.md.update.ReplicaExchange(
+        hoomd.trigger.Periodic(1), method=nve)
+    sim.operations.updaters.append(replica_exchange)
+
+    with pytest.raises(ValueError):
+        sim.run(0)
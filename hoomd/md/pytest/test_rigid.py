@@ -298,3 +298,101 @@ def test_setting_body_after_attaching(simulation_factory,
     # setting should be fine.
     with pytest.raises(RuntimeError):
         sim.run(1)
+
+
+
+def test_rebuild_rigid_ghosts(simulation_factory, lattice_snapshot_factory,
+                              device):
+    """Test ghost constituents rebuilt from their central particles.
+
+    Ghost updates skip the constituents that ForceComposite can place from
+    their central particles. The rods are longer than the ghost layer of the
+    constituents, so some ghost bodies are incomplete on the receiving rank
+    and are placed by the index of each constituent in the body. The ghosts,
+    forces, and trajectory must match the mode that sends all constituents.
+    """
+    if device.communicator.num_ranks < 2:
+        pytest.skip("Requires domain decomposition")
+
+    body = {
+        "constituent_types": ["B", "B", "B", "B"],
+        "positions": [[-1.5, 0, 0], [-0.5, 0, 0], [0.5, 0, 0], [1.5, 0, 0]],
+        "orientations": [(1.0, 0.0, 0.0, 0.0)] * 4,
+        "charges": [0.0] * 4,
+        "diameters": [1.0] * 4
+    }
+
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=4,
+                                    a=4,
+                                    r=0.1)
+    L = 16
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(7)
+        orientation = rng.normal(size=(snap.particles.N, 4))
+        orientation /= np.linalg.norm(orientation, axis=1)[:, np.newaxis]
+        snap.particles.orientation[:] = orientation
+        snap.particles.moment_inertia[:] = [0, 5, 5]
+
+    results = []
+    for rebuild in (False, True):
+        rigid = md.constrain.Rigid()
+        rigid.body["A"] = body
+        gauss = md.pair.Gauss(md.nlist.Cell(exclusions=['body']),
+                              default_r_cut=2.0)
+        gauss.params[('A', 'A')] = dict(epsilon=0, sigma=0.5)
+        gauss.params[('A', 'B')] = dict(epsilon=0, sigma=0.5)
+        gauss.params[('B', 'B')] = dict(epsilon=1, sigma=0.5)
+        nve = md.methods.NVE(filter=hoomd.filter.Rigid(("center",)))
+        integrator = md.Integrator(0.005,
+                                   methods=[nve],
+                                   forces=[gauss],
+                                   integrate_rotational_dof=True)
+        integrator.rigid = rigid
+
+        sim = simulation_factory(snap)
+        rigid.create_bodies(sim.state)
+        sim.operations.integrator = integrator
+        sim._system_communicator.rebuild_rigid_ghosts = rebuild
+        sim.run(20)
+
+        if isinstance(device, hoomd.device.CPU):
+            assert sim._system_communicator.rigid_ghosts_rebuilt == rebuild
+
+        with sim.state.cpu_local_snapshot as local:
+            n_local = len(local.particles.tag)
+            tag = np.array(local.particles.tag_with_ghost)
+            body_id = np.array(local.particles.body_with_ghost)
+            position = np.array(local.particles.position_with_ghost)
+            orientation = np.array(local.particles.orientation_with_ghost)
+
+        # count the ghost constituents of bodies that are incomplete here
+        ghost = np.arange(len(tag)) >= n_local
+        constituent = (body_id >= 0) & (body_id != tag)
+        body_ids, n_present = np.unique(body_id[constituent],
+                                        return_counts=True)
+        n_incomplete = np.count_nonzero(
+            np.isin(body_id[constituent & ghost], body_ids[n_present < 4]))
+
+        order = np.argsort(tag[ghost])
+        results.append(
+            (tag[ghost][order], position[ghost][order],
+             orientation[ghost][order], n_incomplete, gauss.forces,
+             sim.state.get_snapshot()))
+
+    reference, rebuilt = results
+    np.testing.assert_array_equal(rebuilt[0], reference[0])
+    delta = rebuilt[1] - reference[1]
+    delta -= L * np.round(delta / L)
+    np.testing.assert_allclose(delta, 0, atol=1e-4)
+    np.testing.assert_allclose(rebuilt[2], reference[2], atol=1e-5)
+    assert rebuilt[3] > 0
+
+    if rebuilt[4] is not None:
+        np.testing.assert_allclose(rebuilt[4], reference[4], atol=1e-4)
+        np.testing.assert_allclose(rebuilt[5].particles.position,
+                                   reference[5].particles.position,
+                                   atol=1e-5)
+        np.testing.assert_allclose(rebuilt[5].particles.orientation,
+                                   reference[5].particles.orientation,
+                                   atol=1e-5)
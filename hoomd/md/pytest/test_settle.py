@@ -0,0 +1,161 @@
+import hoomd
+from hoomd.conftest import pickling_check
+import numpy
+import pytest
+
+D_OH = 1.0
+D_HH = 1.6
+
+
+@pytest.fixture(scope='session')
+def water_snapshot_factory(device):
+    """Make a snapshot with rigid three site molecules."""
+
+    def make_snapshot(n=2, spacing=3.0):
+        """Make the snapshot.
+
+        Args:
+            n: Number of molecules along each box dimension
+            spacing: distance between the molecules
+
+        Place n**3 molecules on a cubic lattice with the sites of each molecule
+        at consecutive tags (O, H, H).
+        """
+        s = hoomd.Snapshot(device.communicator)
+
+        if s.communicator.rank == 0:
+            L = n * spacing
+            s.configuration.box = [L, L, L, 0, 0, 0]
+            s.particles.N = 3 * n**3
+            s.particles.types = ['O', 'H']
+
+            height = numpy.sqrt(D_OH**2 - (D_HH / 2)**2)
+            sites = numpy.array([[0, height, 0], [-D_HH / 2, 0, 0],
+                                 [D_HH / 2, 0, 0]])
+
+            position = []
+            for i in range(n):
+                for j in range(n):
+                    for k in range(n):
+                        center = (numpy.array([i, j, k]) + 0.5) * spacing
+                        position.extend(center - L / 2 + sites)
+
+            s.particles.position[:] = position
+            s.particles.typeid[:] = [0, 1, 1] * n**3
+            s.particles.mass[:] = [16.0, 1.0, 1.0] * n**3
+
+        return s
+
+    return make_snapshot
+
+
+def test_attach_detach(simulation_factory, water_snapshot_factory, device):
+    """Ensure that md.methods.Settle can be attached.
+
+    Also test that parameters can be set.
+    """
+    if device.communicator.num_ranks > 1:
+        pytest.skip("Settle does not support domain decomposition")
+
+    # detached
+    settle = hoomd.md.methods.Settle(filter=hoomd.filter.All(),
+                                     d_OH=D_OH,
+                                     d_HH=D_HH)
+
+    assert settle.d_OH == D_OH
+    assert settle.d_HH == D_HH
+
+    # attached
+    sim = simulation_factory(water_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005, methods=[settle])
+    sim.operations.integrator = integrator
+
+    sim.run(0)
+
+    assert settle.d_OH == D_OH
+    assert settle.d_HH == D_HH
+    settle.d_OH = 1.1
+    assert settle.d_OH == 1.1
+
+
+def test_pickling(simulation_factory, water_snapshot_factory, device):
+    """Test that md.methods.Settle can be pickled and unpickled."""
+    if device.communicator.num_ranks > 1:
+        pytest.skip("Settle does not support domain decomposition")
+
+    # detached
+    settle = hoomd.md.methods.Settle(filter=hoomd.filter.All(),
+                                     d_OH=D_OH,
+                                     d_HH=D_HH)
+    pickling_check(settle)
+
+    # attached
+    sim = simulation_factory(water_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005, methods=[settle])
+    sim.operations.integrator = integrator
+
+    sim.run(0)
+    pickling_check(settle)
+
+
+def test_basic_simulation(simulation_factory, water_snapshot_factory, device):
+    """Ensure that the molecules stay rigid in a basic simulation."""
+    if device.communicator.num_ranks > 1:
+        pytest.skip("Settle does not support domain decomposition")
+
+    sim = simulation_factory(water_snapshot_factory())
+    settle = hoomd.md.methods.Settle(filter=hoomd.filter.All(),
+                                     d_OH=D_OH,
+                                     d_HH=D_HH)
+    integrator = hoomd.md.Integrator(dt=0.005, methods=[settle])
+
+    cell = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist=cell)
+    lj.params[('O', 'O')] = dict(epsilon=1, sigma=1)
+    lj.r_cut[('O', 'O')] = 2.5
+    lj.params[('O', 'H')] = dict(epsilon=0, sigma=1)
+    lj.r_cut[('O', 'H')] = 0
+    lj.params[('H', 'H')] = dict(epsilon=0, sigma=1)
+    lj.r_cut[('H', 'H')] = 0
+    integrator.forces.append(lj)
+
+    thermo = hoomd.md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+    sim.operations.integrator = integrator
+
+    sim.state.thermalize_particle_momenta(filter=hoomd.filter.All(), kT=1.0)
+    sim.run(100)
+
+    # 6 degrees of freedom per molecule, less the conserved momentum
+    assert thermo.translational_degrees_of_freedom == 6 * 8 - 3
+
+    snap = sim.state.get_snapshot()
+
+    if snap.communicator.rank == 0:
+        # compute the site distances in unwrapped particle coordinates
+        box_lengths = snap.configuration.box[0:3]
+        r = snap.particles.position + snap.particles.image * box_lengths
+        r_O = r[0::3]
+        r_H1 = r[1::3]
+        r_H2 = r[2::3]
+
+        def distance(a, b):
+            return numpy.sqrt(numpy.sum((b - a)**2, axis=1))
+
+        numpy.testing.assert_allclose(distance(r_O, r_H1), D_OH, rtol=1e-5)
+        numpy.testing.assert_allclose(distance(r_O, r_H2), D_OH, rtol=1e-5)
+        numpy.testing.assert_allclose(distance(r_H1, r_H2), D_HH, rtol=1e-5)
+
+        # the velocities have no component along the bonds
+        v = snap.particles.velocity
+        v_O = v[0::3]
+        v_H1 = v[1::3]
+        v_H2 = v[2::3]
+        numpy.testing.assert_allclose(numpy.sum((r_H1 - r_O) * (v_H1 - v_O),
+                                                axis=1),
+                                      0,
+                                      atol=1e-5)
+        numpy.testing.assert_allclose(numpy.sum((r_H2 - r_H1) * (v_H2 - v_H1),
+                                                axis=1),
+                                      0,
+                                      atol=1e-5)
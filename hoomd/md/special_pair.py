@@ -13,11 +13,9 @@ configuration do nothing. Only when you specify an force (i.e.
 special_pairs.lj), are forces actually calculated between the listed particles.
 """
 
-from hoomd.md import _md
 from hoomd.md.force import Force
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.parameterdicts import TypeParameterDict
-import hoomd
 
 
 class SpecialPair(Force):
@@ -29,16 +27,15 @@ class SpecialPair(Force):
 
     """
 
+    _supports_run_on_host = True
+
     def _attach(self):
         # check that some bonds are defined
         if self._simulation.state._cpp_sys_def.getPairData().getNGlobal() == 0:
             self._simulation.device._cpp_msg.error("No pairs are defined.\n")
 
         # create the c++ mirror class
-        if isinstance(self._simulation.device, hoomd.device.CPU):
-            cpp_cls = getattr(_md, self._cpp_class_name)
-        else:
-            cpp_cls = getattr(_md, self._cpp_class_name + "GPU")
+        cpp_cls = self._cpp_class()
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def)
         super()._attach()
 
@@ -44,10 +44,22 @@ std::shared_ptr<Communicator>
 base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                 std::shared_ptr<DomainDecomposition> decomposition);
 
+std::shared_ptr<Communicator>
+nonpersistent_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<DomainDecomposition> decomposition);
+
+std::shared_ptr<Communicator>
+rebuild_rigid_ghosts_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                          std::shared_ptr<DomainDecomposition> decomposition);
+
 #ifdef ENABLE_HIP
 std::shared_ptr<Communicator>
 gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<DomainDecomposition> decomposition);
+
+std::shared_ptr<Communicator>
+gpu_collective_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                    std::shared_ptr<DomainDecomposition> decomposition);
 #endif
 
 void test_domain_decomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -1752,7 +1764,9 @@ void test_communicator_ghosts(communicator_creator comm_creator,
             }
         }
 
-    // update ghosts
+    // update ghosts, twice to reuse the persistent requests
+    comm->beginUpdateGhosts(0);
+    comm->finishUpdateGhosts(0);
     comm->beginUpdateGhosts(0);
     comm->finishUpdateGhosts(0);
 
@@ -3631,6 +3645,24 @@ base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
     return std::shared_ptr<Communicator>(new Communicator(sysdef, decomposition));
     }
 
+std::shared_ptr<Communicator>
+nonpersistent_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    comm->setPersistentGhostUpdate(false);
+    return comm;
+    }
+
+std::shared_ptr<Communicator>
+rebuild_rigid_ghosts_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                          std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    comm->setRebuildRigidGhosts(true);
+    return comm;
+    }
+
 #ifdef ENABLE_HIP
 std::shared_ptr<Communicator>
 gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3638,6 +3670,15 @@ gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
     {
     return std::shared_ptr<Communicator>(new CommunicatorGPU(sysdef, decomposition));
     }
+
+std::shared_ptr<Communicator>
+gpu_collective_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                    std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<CommunicatorGPU> comm(new CommunicatorGPU(sysdef, decomposition));
+    comm->setNeighborCollectives(true);
+    return comm;
+    }
 #endif
 
 UP_SUITE_BEGIN(cpu_tests);
@@ -3729,6 +3770,26 @@ UP_TEST(communicator_ghosts_test)
                                      new DomainDecomposition(exec_conf_cpu, box.getL())),
                                  make_scalar3(0.0, 0.0, 0.0));
         }
+    // test without persistent requests
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(bind(nonpersistent_communicator_creator, _1, _2),
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+    // without rigid bodies, all ghosts are updated
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(bind(rebuild_rigid_ghosts_communicator_creator, _1, _2),
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
     // triclinic box 1
         {
         BoxDim box(1.0, .1, .2, .3);
@@ -3983,6 +4044,16 @@ UP_TEST(communicator_ghosts_test_GPU)
                                      new DomainDecomposition(exec_conf_gpu, box.getL())),
                                  make_scalar3(0.0, 0.0, 0.0));
         }
+    // test with neighborhood collectives
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(bind(gpu_collective_communicator_creator, _1, _2),
+                                 exec_conf_gpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_gpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
     // triclinic box 1
         {
         BoxDim box(1.0, .1, .2, .3);
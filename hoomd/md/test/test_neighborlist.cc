@@ -10,14 +10,18 @@
 #include <memory>
 
 #include "hoomd/Initializers.h"
+#include "hoomd/SnapshotSystemData.h"
 #include "hoomd/md/NeighborList.h"
 #include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListCompression.h"
 #include "hoomd/md/NeighborListStencil.h"
 #include "hoomd/md/NeighborListTree.h"
 
 #ifdef ENABLE_HIP
 #include "hoomd/md/NeighborListGPU.h"
 #include "hoomd/md/NeighborListGPUBinned.h"
+#include "hoomd/md/NeighborListGPUCluster.cuh"
+#include "hoomd/md/NeighborListGPUCluster.h"
 #include "hoomd/md/NeighborListGPUStencil.h"
 #include "hoomd/md/NeighborListGPUTree.h"
 #endif
@@ -1355,6 +1359,329 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! Test that two neighbor lists find the same neighbors when some type pairs do not interact
+template<class NLA, class NLB>
+void neighborlist_inactive_type_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct a system of 3 types
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    snap->particle_data.type_mapping = {"A", "B", "C"};
+    for (unsigned int i = 0; i < snap->particle_data.size; i++)
+        snap->particle_data.type[i] = i % 3;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NeighborList> nlist1(new NLA(sysdef, Scalar(0.4)));
+    Index2D type_pair_idx = nlist1->getTypePairIndexer();
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(type_pair_idx.getNumElements(), exec_conf);
+        {
+        // only A-B and B-B interact, C interacts with no type
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < type_pair_idx.getNumElements(); i++)
+            h_r_cut.data[i] = 0.0;
+        h_r_cut.data[type_pair_idx(0, 1)] = 2.5;
+        h_r_cut.data[type_pair_idx(1, 0)] = 2.5;
+        h_r_cut.data[type_pair_idx(1, 1)] = 2.0;
+        }
+    nlist1->addRCutMatrix(r_cut);
+    nlist1->setStorageMode(NeighborList::full);
+
+    std::shared_ptr<NeighborList> nlist2(new NLB(sysdef, Scalar(0.4)));
+    nlist2->addRCutMatrix(r_cut);
+    nlist2->setStorageMode(NeighborList::full);
+
+    nlist1->compute(0);
+    nlist2->compute(0);
+
+    ArrayHandle<unsigned int> h_n_neigh1(nlist1->getNNeighArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<unsigned int> h_nlist1(nlist1->getNListArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<unsigned int> h_head_list1(nlist1->getHeadList(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh2(nlist2->getNNeighArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<unsigned int> h_nlist2(nlist2->getNListArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<unsigned int> h_head_list2(nlist2->getHeadList(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+        UP_ASSERT_EQUAL(h_n_neigh1.data[i], h_n_neigh2.data[i]);
+        if (type_i == 2)
+            UP_ASSERT_EQUAL(h_n_neigh2.data[i], (unsigned int)0);
+
+        std::vector<unsigned int> list1(h_nlist1.data + h_head_list1.data[i],
+                                        h_nlist1.data + h_head_list1.data[i] + h_n_neigh1.data[i]);
+        std::vector<unsigned int> list2(h_nlist2.data + h_head_list2.data[i],
+                                        h_nlist2.data + h_head_list2.data[i] + h_n_neigh2.data[i]);
+        std::sort(list1.begin(), list1.end());
+        std::sort(list2.begin(), list2.end());
+        UP_ASSERT(list1 == list2);
+
+        for (unsigned int j : list2)
+            {
+            const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+            UP_ASSERT(type_j != 2 && (type_i == 1 || type_j == 1));
+            }
+        }
+    }
+
+#ifdef ENABLE_HIP
+//! Test that the cluster pairs of a NeighborListGPUCluster hold exactly the per-particle neighbors
+template<class NL>
+void neighborlist_cluster_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NL> nlist(new NL(sysdef, Scalar(0.4)));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 3.0;
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(NeighborList::full);
+
+    for (unsigned int i = 0; i < pdata->getN() - 1; i++)
+        nlist->addExclusion(i, i + 1);
+
+    nlist->compute(0);
+
+    const unsigned int cluster_nmax = nlist->getClusterNmax();
+    ArrayHandle<unsigned int> h_n_cluster_neigh(nlist->getNClusterNeighArray(),
+                                                access_location::host,
+                                                access_mode::read);
+    ArrayHandle<unsigned int> h_cluster_nlist(nlist->getClusterNListArray(),
+                                              access_location::host,
+                                              access_mode::read);
+    ArrayHandle<uint64_t> h_cluster_mask(nlist->getClusterMaskArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    const unsigned int N = pdata->getN();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const unsigned int cluster = i / gpu_nlist_cluster_size;
+        const unsigned int a = i % gpu_nlist_cluster_size;
+
+        // expand the cluster pairs of particle i
+        std::vector<unsigned int> cluster_list;
+        for (unsigned int k = 0; k < h_n_cluster_neigh.data[cluster]; ++k)
+            {
+            const unsigned int j_cluster = h_cluster_nlist.data[cluster * cluster_nmax + k];
+            const uint64_t mask = h_cluster_mask.data[cluster * cluster_nmax + k];
+            for (unsigned int b = 0; b < gpu_nlist_cluster_size; ++b)
+                {
+                if ((mask >> (a * gpu_nlist_cluster_size + b)) & 1)
+                    cluster_list.push_back(j_cluster * gpu_nlist_cluster_size + b);
+                }
+            }
+
+        std::vector<unsigned int> ref_list(h_nlist.data + h_head_list.data[i],
+                                           h_nlist.data + h_head_list.data[i] + h_n_neigh.data[i]);
+
+        std::sort(cluster_list.begin(), cluster_list.end());
+        std::sort(ref_list.begin(), ref_list.end());
+        UP_ASSERT(cluster_list == ref_list);
+        }
+    }
+#endif
+
+//! Test that the compressed rows decode to the sorted neighbors of each particle
+template<class NL>
+void neighborlist_compressed_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(0.4)));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 3.0;
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(NeighborList::full);
+
+    for (unsigned int i = 0; i < pdata->getN() - 1; i++)
+        nlist->addExclusion(i, i + 1);
+
+    nlist->compute(0);
+
+    // store the sorted neighbors of the uncompressed list
+    const unsigned int N = pdata->getN();
+    std::vector<std::vector<unsigned int>> ref_lists(N);
+        {
+        ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(),
+                                              access_location::host,
+                                              access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            ref_lists[i].assign(h_nlist.data + h_head_list.data[i],
+                                h_nlist.data + h_head_list.data[i] + h_n_neigh.data[i]);
+            std::sort(ref_lists[i].begin(), ref_lists[i].end());
+            }
+        }
+
+    nlist->setCompressed(true);
+    UP_ASSERT(nlist->getCompressed());
+    nlist->compute(1);
+
+    ArrayHandle<unsigned char> h_compressed_nlist(nlist->getCompressedNListArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+    ArrayHandle<size_t> h_compressed_head_list(nlist->getCompressedHeadList(),
+                                               access_location::host,
+                                               access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        UP_ASSERT_EQUAL(h_n_neigh.data[i], (unsigned int)ref_lists[i].size());
+
+        // decode the compressed row, it must end where the next one starts
+        const unsigned char* packed = h_compressed_nlist.data + h_compressed_head_list.data[i];
+        std::vector<unsigned int> compressed_list;
+        unsigned int j = 0;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; ++k)
+            {
+            j += nlist_compressed_read(packed);
+            compressed_list.push_back(j);
+            }
+        UP_ASSERT(packed == h_compressed_nlist.data + h_compressed_head_list.data[i + 1]);
+        UP_ASSERT(compressed_list == ref_lists[i]);
+
+        // the uncompressed rows are sorted in place
+        std::vector<unsigned int> row(h_nlist.data + h_head_list.data[i],
+                                      h_nlist.data + h_head_list.data[i] + h_n_neigh.data[i]);
+        UP_ASSERT(row == ref_lists[i]);
+        }
+    }
+
+//! Test that the rows are partitioned into the cutoff shells of two consumers
+template<class NL> void neighborlist_shell_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    const Scalar r_buff = Scalar(0.4);
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, r_buff));
+    auto r_cut_long
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+    auto r_cut_short
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut_long, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 3.0;
+        }
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut_short, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 1.5;
+        }
+    nlist->addRCutMatrix(r_cut_long);
+    nlist->setStorageMode(NeighborList::full);
+    nlist->compute(0);
+
+    // a single consumer reads the full rows
+    UP_ASSERT_EQUAL(nlist->getShell(r_cut_long), -1);
+
+    nlist->addRCutMatrix(r_cut_short);
+    nlist->compute(1);
+
+    const int shell_long = nlist->getShell(r_cut_long);
+    const int shell_short = nlist->getShell(r_cut_short);
+    UP_ASSERT(shell_long >= 0);
+    UP_ASSERT(shell_short >= 0);
+    UP_ASSERT(shell_long != shell_short);
+
+    ArrayHandle<unsigned int> h_shell_n_neigh(nlist->getShellNNeighArray(),
+                                              access_location::host,
+                                              access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+
+    const size_t pitch = nlist->getShellPitch();
+    const Scalar rlistsq_short = (Scalar(1.5) + r_buff) * (Scalar(1.5) + r_buff);
+    const BoxDim& box = pdata->getBox();
+    unsigned int total_short = 0;
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        const unsigned int n_short = h_shell_n_neigh.data[shell_short * pitch + i];
+        UP_ASSERT_EQUAL(h_shell_n_neigh.data[shell_long * pitch + i], h_n_neigh.data[i]);
+        UP_ASSERT(n_short <= h_n_neigh.data[i]);
+        total_short += n_short;
+
+        // the short shell holds exactly the neighbors within its radius
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; ++k)
+            {
+            const unsigned int j = h_nlist.data[h_head_list.data[i] + k];
+            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 dx = box.minImage(pi - pj);
+            UP_ASSERT_EQUAL(dot(dx, dx) <= rlistsq_short, k < n_short);
+            }
+        }
+    UP_ASSERT(total_short > 0);
+    }
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template<class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1786,6 +2113,20 @@ UP_TEST(NeighborListBinned_2d)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! compressed storage test case for binned class
+UP_TEST(NeighborListBinned_compressed)
+    {
+    neighborlist_compressed_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! cutoff shell test case for binned class
+UP_TEST(NeighborListBinned_shell)
+    {
+    neighborlist_shell_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 ////////////////////
 // STENCIL CPU
 ////////////////////
@@ -1930,6 +2271,13 @@ UP_TEST(NeighborListTree_comparison)
         std::shared_ptr<ExecutionConfiguration>(
             new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! comparison test case for binned class with non-interacting types
+UP_TEST(NeighborListBinned_inactive_type)
+    {
+    neighborlist_inactive_type_test<NeighborListTree, NeighborListBinned>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 
 #ifdef ENABLE_HIP
 ///////////////
@@ -1999,6 +2347,13 @@ UP_TEST(NeighborListGPUBinned_2d)
     neighborlist_2d_tests<NeighborListGPUBinned>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+//! comparison test case for GPUBinned class with non-interacting types
+UP_TEST(NeighborListGPUBinned_inactive_type)
+    {
+    neighborlist_inactive_type_test<NeighborListBinned, NeighborListGPUBinned>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 //! comparison test case for GPUBinned class
 UP_TEST(NeighborListGPUBinned_comparison)
     {
@@ -2006,6 +2361,47 @@ UP_TEST(NeighborListGPUBinned_comparison)
         std::shared_ptr<ExecutionConfiguration>(
             new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+//! compressed storage test case for GPUBinned class
+UP_TEST(NeighborListGPUBinned_compressed)
+    {
+    neighborlist_compressed_tests<NeighborListGPUBinned>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+//! cutoff shell test case for GPUBinned class
+UP_TEST(NeighborListGPUBinned_shell)
+    {
+    neighborlist_shell_tests<NeighborListGPUBinned>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
+///////////////
+// CLUSTER GPU
+///////////////
+//! basic test case for GPUCluster class
+UP_TEST(NeighborListGPUCluster_basic)
+    {
+    neighborlist_basic_tests<NeighborListGPUCluster>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+//! exclusion test case for GPUCluster class
+UP_TEST(NeighborListGPUCluster_exclusion)
+    {
+    neighborlist_exclusion_tests<NeighborListGPUCluster>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+//! comparison test case for GPUCluster class with GPUBinned
+UP_TEST(NeighborListGPUCluster_binned_comparison)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    neighborlist_comparison_test<NeighborListGPUBinned, NeighborListGPUCluster>(exec_conf);
+    }
+//! cluster pair test case for GPUCluster class
+UP_TEST(NeighborListGPUCluster_cluster)
+    {
+    neighborlist_cluster_tests<NeighborListGPUCluster>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 
 ///////////////
 // STENCIL GPU
@@ -0,0 +1,320 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListTree.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/*! \file test_pair_batch.cc
+    \brief Compares the batched evaluation of pair potentials to the scalar evaluation
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+//! Wrap an evaluator without its batched evaluation so that PotentialPair takes the scalar path
+template<class evaluator> class ScalarEvaluator
+    {
+    public:
+    typedef typename evaluator::param_type param_type;
+
+    ScalarEvaluator(Scalar rsq, Scalar rcutsq, const param_type& params)
+        : m_eval(rsq, rcutsq, params)
+        {
+        }
+
+    static bool needsDiameter()
+        {
+        return evaluator::needsDiameter();
+        }
+
+    static bool needsCharge()
+        {
+        return evaluator::needsCharge();
+        }
+
+    void setDiameter(Scalar di, Scalar dj)
+        {
+        m_eval.setDiameter(di, dj);
+        }
+
+    void setCharge(Scalar qi, Scalar qj)
+        {
+        m_eval.setCharge(qi, qj);
+        }
+
+    bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        return m_eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+        }
+
+    static std::string getName()
+        {
+        return evaluator::getName();
+        }
+
+    std::string getShapeSpec() const
+        {
+        return m_eval.getShapeSpec();
+        }
+
+    private:
+    evaluator m_eval; //!< Wrapped evaluator
+    };
+
+//! Check that a value matches a reference up to rounding
+/*! The batched path sums the pairs in a different order, so the tolerance is relative to the
+    reference with an absolute floor for sums that cancel.
+*/
+void check_match(Scalar value, Scalar ref)
+    {
+    UP_ASSERT(std::abs(value - ref) <= tol_small * (std::abs(ref) + Scalar(1.0)));
+    }
+
+//! Compare evalForceAndEnergyBatch() to evalForceAndEnergy() pair by pair
+/*! The pairs are evaluated in blocks of pair_batch_size and the last block is padded with
+    pairs beyond the cutoff (rcutsq = 0) like PotentialPair does. Every seventh pair is a masked
+    exclusion, also with rcutsq = 0. The number of pairs is not a multiple of the block size.
+*/
+template<class evaluator>
+void batch_evaluator_test(const std::vector<typename evaluator::param_type>& params)
+    {
+    typedef typename evaluator::param_type param_type;
+    const unsigned int B = hoomd::detail::pair_batch_size;
+    const unsigned int n_pairs = 5 * B + 3;
+
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(3, 4, 5));
+    std::vector<Scalar> rsq(n_pairs), rcutsq(n_pairs);
+    std::vector<param_type> pair_params(n_pairs);
+    for (unsigned int k = 0; k < n_pairs; k++)
+        {
+        Scalar r_cut = hoomd::UniformDistribution<Scalar>(1.5, 3.0)(rng);
+        Scalar r = hoomd::UniformDistribution<Scalar>(0.8, 3.2)(rng);
+        rsq[k] = r * r;
+        rcutsq[k] = k % 7 == 6 ? Scalar(0.0) : r_cut * r_cut;
+        pair_params[k] = params[k % params.size()];
+        }
+
+    for (bool energy_shift : {false, true})
+        {
+        unsigned int n_evaluated = 0;
+        for (unsigned int first = 0; first < n_pairs; first += B)
+            {
+            const unsigned int n = std::min(B, n_pairs - first);
+            Scalar b_rsq[B], b_rcutsq[B], b_force_divr[B], b_pair_eng[B];
+            param_type b_params[B];
+            for (unsigned int l = 0; l < B; l++)
+                {
+                b_rsq[l] = l < n ? rsq[first + l] : Scalar(1.0);
+                b_rcutsq[l] = l < n ? rcutsq[first + l] : Scalar(0.0);
+                b_params[l] = l < n ? pair_params[first + l] : pair_params[first];
+                }
+
+            evaluator::template evalForceAndEnergyBatch<B>(b_rsq,
+                                                           b_rcutsq,
+                                                           b_params,
+                                                           b_force_divr,
+                                                           b_pair_eng,
+                                                           energy_shift);
+
+            for (unsigned int l = 0; l < n; l++)
+                {
+                const unsigned int k = first + l;
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq[k], rcutsq[k], pair_params[k]);
+                if (eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+                    n_evaluated++;
+                else
+                    {
+                    force_divr = Scalar(0.0);
+                    pair_eng = Scalar(0.0);
+                    }
+
+                check_match(b_force_divr[l], force_divr);
+                check_match(b_pair_eng[l], pair_eng);
+                }
+
+            // the padded lanes give exactly zero, not inf or nan
+            for (unsigned int l = n; l < B; l++)
+                {
+                UP_ASSERT(b_force_divr[l] == Scalar(0.0));
+                UP_ASSERT(b_pair_eng[l] == Scalar(0.0));
+                }
+            }
+
+        // the test covers pairs inside and beyond the cutoff
+        UP_ASSERT(n_evaluated > 0);
+        UP_ASSERT(n_evaluated < n_pairs);
+        }
+    }
+
+//! Compare PotentialPair with the batched path to PotentialPair with the scalar path
+/*! The system is a jittered simple cubic lattice of two types. The numbers of particles and of
+    neighbors are not multiples of the block size. XPLOR smoothing falls back to the scalar path
+    and must agree as well.
+*/
+template<class evaluator>
+void batch_potential_test(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                          const std::vector<typename evaluator::param_type>& params)
+    {
+    typedef PotentialPair<evaluator> batch_potential;
+    typedef PotentialPair<ScalarEvaluator<evaluator>> scalar_potential;
+    UP_ASSERT(hoomd::detail::has_eval_batch<evaluator>::value);
+    UP_ASSERT(!hoomd::detail::has_eval_batch<ScalarEvaluator<evaluator>>::value);
+
+    const unsigned int n = 6;
+    const Scalar a = Scalar(1.1);
+    const unsigned int N = n * n * n - 5;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(n * a), 2, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(6, 7, 8));
+    hoomd::UniformDistribution<Scalar> jitter(-0.1, 0.1);
+    const Scalar c = Scalar(n - 1) / 2;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pos = make_scalar3((Scalar(i % n) - c) * a,
+                                   (Scalar(i / n % n) - c) * a,
+                                   (Scalar(i / n / n) - c) * a);
+        pos.x += jitter(rng);
+        pos.y += jitter(rng);
+        pos.z += jitter(rng);
+        pdata->setPosition(i, pos);
+        pdata->setType(i, i % 2);
+        }
+
+    for (auto mode : {batch_potential::no_shift, batch_potential::shift, batch_potential::xplor})
+        {
+        std::shared_ptr<NeighborListTree> nlist_batch(new NeighborListTree(sysdef, Scalar(0.4)));
+        std::shared_ptr<NeighborListTree> nlist_scalar(
+            new NeighborListTree(sysdef, Scalar(0.4)));
+        std::shared_ptr<batch_potential> batch(new batch_potential(sysdef, nlist_batch));
+        std::shared_ptr<scalar_potential> scalar(new scalar_potential(sysdef, nlist_scalar));
+
+        batch->setShiftMode(mode);
+        scalar->setShiftMode(typename scalar_potential::energyShiftMode(mode));
+        for (unsigned int i = 0; i < 2; i++)
+            for (unsigned int j = i; j < 2; j++)
+                {
+                const typename evaluator::param_type& param = params[(i + j) % params.size()];
+                const Scalar r_cut = Scalar(2.2) + Scalar(0.2) * Scalar(i + j);
+                batch->setParams(i, j, param);
+                scalar->setParams(i, j, param);
+                batch->setRcut(i, j, r_cut);
+                scalar->setRcut(i, j, r_cut);
+                batch->setRon(i, j, r_cut - Scalar(0.5));
+                scalar->setRon(i, j, r_cut - Scalar(0.5));
+                }
+
+        batch->compute(0);
+        scalar->compute(0);
+
+        ArrayHandle<Scalar4> h_force_batch(batch->getForceArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar> h_virial_batch(batch->getVirialArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar4> h_force_scalar(scalar->getForceArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<Scalar> h_virial_scalar(scalar->getVirialArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        const size_t pitch = batch->getVirialArray().getPitch();
+        UP_ASSERT_EQUAL(pitch, scalar->getVirialArray().getPitch());
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            check_match(h_force_batch.data[i].x, h_force_scalar.data[i].x);
+            check_match(h_force_batch.data[i].y, h_force_scalar.data[i].y);
+            check_match(h_force_batch.data[i].z, h_force_scalar.data[i].z);
+            check_match(h_force_batch.data[i].w, h_force_scalar.data[i].w);
+            for (unsigned int l = 0; l < 6; l++)
+                check_match(h_virial_batch.data[l * pitch + i],
+                            h_virial_scalar.data[l * pitch + i]);
+            }
+        }
+    }
+
+//! LJ parameters, including a pair type with no interaction
+std::vector<EvaluatorPairLJ::param_type> lj_params()
+    {
+    return {EvaluatorPairLJ::param_type(1.0, 1.0),
+            EvaluatorPairLJ::param_type(1.2, 0.5),
+            EvaluatorPairLJ::param_type(1.0, 0.0)};
+    }
+
+//! Yukawa parameters
+std::vector<EvaluatorPairYukawa::param_type> yukawa_params()
+    {
+    return {EvaluatorPairYukawa::param_type(1.0, 0.5),
+            EvaluatorPairYukawa::param_type(2.0, 1.5),
+            EvaluatorPairYukawa::param_type(0.0, 1.0)};
+    }
+
+//! Morse parameters
+std::vector<EvaluatorPairMorse::param_type> morse_params()
+    {
+    return {EvaluatorPairMorse::param_type(1.0, 3.0, 1.1),
+            EvaluatorPairMorse::param_type(0.5, 2.0, 1.3),
+            EvaluatorPairMorse::param_type(0.0, 1.0, 1.0)};
+    }
+
+//! Batched LJ evaluation
+UP_TEST(EvaluatorPairLJ_batch)
+    {
+    batch_evaluator_test<EvaluatorPairLJ>(lj_params());
+    }
+
+//! Batched Yukawa evaluation
+UP_TEST(EvaluatorPairYukawa_batch)
+    {
+    batch_evaluator_test<EvaluatorPairYukawa>(yukawa_params());
+    }
+
+//! Batched Morse evaluation
+UP_TEST(EvaluatorPairMorse_batch)
+    {
+    batch_evaluator_test<EvaluatorPairMorse>(morse_params());
+    }
+
+//! PotentialPairLJ with the batched path
+UP_TEST(PotentialPairLJ_batch)
+    {
+    batch_potential_test<EvaluatorPairLJ>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        lj_params());
+    }
+
+//! PotentialPairYukawa with the batched path
+UP_TEST(PotentialPairYukawa_batch)
+    {
+    batch_potential_test<EvaluatorPairYukawa>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        yukawa_params());
+    }
+
+//! PotentialPairMorse with the batched path
+UP_TEST(PotentialPairMorse_batch)
+    {
+    batch_potential_test<EvaluatorPairMorse>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        morse_params());
+    }
@@ -0,0 +1,3 @@
+"""Tuners for MD."""
+
+from hoomd.md.tune.nlist_buffer import NeighborListBuffer
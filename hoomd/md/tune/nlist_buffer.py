@@ -0,0 +1,215 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement NeighborListBuffer."""
+
+import numpy
+
+from hoomd.custom import _InternalAction
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
+from hoomd.tune import _InternalCustomTuner
+from hoomd.md.nlist import NList
+
+
+class _InternalNeighborListBuffer(_InternalAction):
+    """Internal class for the NeighborListBuffer tuner."""
+
+    def __init__(self,
+                 nlist,
+                 maximum_buffer,
+                 num_buffers=8,
+                 tolerance=0.2,
+                 iterations=10):
+        self._simulation = None
+
+        # statistics at the last call to act
+        self._last_timestep = None
+        self._last_updates = None
+
+        # the rebuild period predicted and the density at the last tune
+        self._tuned_period = None
+        self._tuned_density = None
+
+        param_dict = ParameterDict(nlist=NList,
+                                   maximum_buffer=OnlyTypes(
+                                       float, postprocess=self._positive),
+                                   num_buffers=OnlyTypes(
+                                       int, postprocess=self._positive),
+                                   tolerance=OnlyTypes(
+                                       float, postprocess=self._positive),
+                                   iterations=OnlyTypes(
+                                       int, postprocess=self._positive))
+        param_dict.update(
+            dict(nlist=nlist,
+                 maximum_buffer=maximum_buffer,
+                 num_buffers=num_buffers,
+                 tolerance=tolerance,
+                 iterations=iterations))
+        self._param_dict.update(param_dict)
+
+    def attach(self, simulation):
+        self._simulation = simulation
+        self._last_timestep = None
+        self._last_updates = None
+        self._tuned_period = None
+        self._tuned_density = None
+
+    @property
+    def _attached(self):
+        """bool: Whether or not the tuner is attached to a simulation."""
+        return self._simulation is not None
+
+    def detach(self):
+        self._simulation = None
+
+    @property
+    def tuned(self):
+        """bool: Whether a buffer has been chosen for the current state."""
+        return self._tuned_period is not None
+
+    @property
+    def buffers(self):
+        """numpy.ndarray: The candidate buffer distances."""
+        return numpy.linspace(self.maximum_buffer / self.num_buffers,
+                              self.maximum_buffer, self.num_buffers)
+
+    def act(self, timestep=None):
+        """Tune the neighbor list buffer.
+
+        Args:
+            timestep (`int`, optional): Current simulation timestep.
+        """
+        if not self._attached or not self.nlist._attached:
+            return
+
+        if not self.nlist.check_dist:
+            raise RuntimeError("NeighborListBuffer requires check_dist=True.")
+
+        updates = self.nlist._cpp_obj.getNumUpdates()
+
+        # The statistics reset at the start of every run, there is no rebuild
+        # period to measure until the next call.
+        if (self._last_timestep is None or timestep <= self._last_timestep
+                or updates < self._last_updates):
+            self._record(timestep)
+            return
+
+        steps = timestep - self._last_timestep
+        period = steps / max(updates - self._last_updates, 1)
+
+        state = self._simulation.state
+        density = state.N_particles / state.box.volume
+
+        if (self._tuned_period is not None
+                and abs(period / self._tuned_period - 1) <= self.tolerance
+                and abs(density / self._tuned_density - 1) <= self.tolerance):
+            self._record(timestep)
+            return
+
+        self._tune(period)
+        self._tuned_density = density
+        self._record(timestep)
+
+    def _record(self, timestep):
+        self._last_timestep = timestep
+        self._last_updates = self.nlist._cpp_obj.getNumUpdates()
+
+    def _tune(self, period):
+        """Choose the buffer that minimizes the time per step.
+
+        The neighbor list build is amortized over the rebuild period, which
+        grows linearly with the buffer distance at a fixed particle mobility.
+        """
+        nlist = self.nlist
+        current = nlist.buffer
+        buffers = self.buffers
+
+        # The rebuild period cannot be extrapolated from a zero buffer, start
+        # from the middle of the range.
+        if current == 0:
+            nlist.buffer = float(buffers[len(buffers) // 2])
+            return
+
+        integrator = self._simulation.operations.integrator
+        forces = [
+            force for force in getattr(integrator, 'forces', [])
+            if getattr(force, 'nlist', None) is nlist and force._attached
+        ]
+
+        costs = []
+        for buffer in buffers:
+            nlist.buffer = float(buffer)
+            cost_nlist = nlist._cpp_obj.benchmark(self.iterations)
+            cost_forces = sum(
+                force._cpp_obj.benchmark(self.iterations) for force in forces)
+            costs.append(cost_nlist / max(1.0, period * buffer / current)
+                         + cost_forces)
+
+        best = float(buffers[numpy.argmin(costs)])
+        scale = best / current
+
+        # Check distances well before the quickest rebuild seen so far.
+        shortest = min(nlist.shortest_rebuild, period)
+        nlist.rebuild_check_delay = max(1, int(0.5 * shortest * scale))
+
+        nlist.buffer = best
+        self._tuned_period = max(1.0, period * scale)
+
+    @staticmethod
+    def _positive(value):
+        if value <= 0:
+            raise ValueError(f"{value} must be positive.")
+        return value
+
+
+class NeighborListBuffer(_InternalCustomTuner):
+    """Tune the neighbor list buffer to minimize the time per step.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): ``Trigger`` to determine when to run
+            the tuner.
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+        maximum_buffer (float): Largest buffer distance to consider
+            :math:`[\\mathrm{length}]`.
+        num_buffers (int): Number of candidate buffer distances.
+        tolerance (float): Relative change in density or rebuild period that
+            triggers a new tune.
+        iterations (int): Number of iterations to average in each benchmark.
+
+    `NeighborListBuffer` measures the mean number of steps between neighbor
+    list builds. It then benchmarks the neighbor list build and the pair forces
+    that use `nlist` at ``num_buffers`` evenly spaced buffer distances up to
+    ``maximum_buffer``. Assuming that the rebuild period grows linearly with the
+    buffer distance, it sets `nlist.buffer <hoomd.md.nlist.NList.buffer>` to the
+    candidate with the smallest neighbor list time amortized over the rebuild
+    period plus the pair force time. It also sets `rebuild_check_delay
+    <hoomd.md.nlist.NList.rebuild_check_delay>` to half of the shortest rebuild
+    period scaled to the new buffer.
+
+    After a tune, `NeighborListBuffer` tunes again only when the density or the
+    measured rebuild period drift by more than ``tolerance`` from their values
+    at the last tune, for example when the temperature changes.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): ``Trigger`` to determine when to run
+            the tuner.
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+        maximum_buffer (float): Largest buffer distance to consider
+            :math:`[\\mathrm{length}]`.
+        num_buffers (int): Number of candidate buffer distances.
+        tolerance (float): Relative change in density or rebuild period that
+            triggers a new tune.
+        iterations (int): Number of iterations to average in each benchmark.
+
+    Note:
+        `nlist` must have ``check_dist=True``.
+
+    Note:
+        In MPI simulations, each of the benchmarks reports the time of the
+        slowest rank so that all ranks choose the same buffer. Choose
+        ``maximum_buffer`` small enough that the largest cutoff plus buffer
+        fits in the local domains.
+    """
+    _internal_class = _InternalNeighborListBuffer
@@ -41,8 +41,11 @@ class ZeroMomentum(Updater):
 
     def _attach(self):
         # create the c++ mirror class
-        self._cpp_obj = _md.ZeroMomentumUpdater(
-            self._simulation.state._cpp_sys_def)
+        if isinstance(self._simulation.device, hoomd.device.GPU):
+            cpp_class = _md.ZeroMomentumUpdaterGPU
+        else:
+            cpp_class = _md.ZeroMomentumUpdater
+        self._cpp_obj = cpp_class(self._simulation.state._cpp_sys_def)
         super()._attach()
 
 
@@ -298,3 +301,211 @@ class ActiveRotationalDiffusion(Updater):
         if attr == "active_force":
             raise ValueError("active_force is not settable after construction.")
         super()._setattr_param(attr, value)
+
+
+class DynamicBond(Updater):
+    r"""Form and break bonds.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to form and break
+            bonds.
+        nlist (hoomd.md.nlist.NList): Neighbor list to find the pairs of
+            particles that form bonds.
+        filter (hoomd.filter.ParticleFilter): Particles that form bonds.
+        bond_type (str): Type of the bonds to form and break.
+        r_form (float): Distance below which pairs of particles form bonds
+            :math:`[\mathrm{length}]`.
+        p_form (float): Probability that a pair of particles closer than
+            ``r_form`` forms a bond.
+        p_break (float): Probability that a bond breaks.
+        max_bonds (int): Maximum number of bonds of type ``bond_type`` per
+            particle.
+
+    `DynamicBond` forms and breaks bonds of type ``bond_type`` to model
+    reversible bonds, such as those in vitrimers or reversibly associating
+    polymers. Each time the updater is triggered, every bond of type
+    ``bond_type`` breaks with probability ``p_break``. Then, every pair of
+    particles selected by ``filter`` that are closer than ``r_form`` forms a
+    bond with probability ``p_form``, unless the particles are bonded already
+    or either particle has ``max_bonds`` bonds of type ``bond_type``.
+
+    `DynamicBond` adds and removes the bonds one at a time. The table of bonds
+    by particle index used by the bond potentials on the GPU is edited in place
+    instead of rebuilt, and the neighbor lists update the ``'bond'``,
+    ``'1-3'``, and ``'1-4'`` exclusions of the added and removed bonds instead
+    of rebuilding all exclusions.
+
+    `DynamicBond` adds ``r_form`` to the cutoffs of ``nlist``. ``bond_type``
+    must be one of the bond types in the simulation state.
+
+    Note:
+        `DynamicBond` does not support MPI domain decomposition.
+
+    Examples::
+
+        nl = hoomd.md.nlist.Cell(buffer=0.4, exclusions=['bond'])
+        dynamic_bond = hoomd.md.update.DynamicBond(
+            trigger=hoomd.trigger.Periodic(100),
+            nlist=nl,
+            filter=hoomd.filter.All(),
+            bond_type='reversible',
+            r_form=1.2,
+            p_form=0.5,
+            p_break=0.01,
+            max_bonds=2)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to form and break
+            bonds.
+        nlist (hoomd.md.nlist.NList): Neighbor list to find the pairs of
+            particles that form bonds. This is not settable after construction.
+        filter (hoomd.filter.ParticleFilter): Particles that form bonds. This is
+            not settable after construction.
+        bond_type (str): Type of the bonds to form and break.
+        r_form (float): Distance below which pairs of particles form bonds
+            :math:`[\mathrm{length}]`.
+        p_form (float): Probability that a pair of particles closer than
+            ``r_form`` forms a bond.
+        p_break (float): Probability that a bond breaks.
+        max_bonds (int): Maximum number of bonds of type ``bond_type`` per
+            particle.
+    """
+
+    def __init__(self,
+                 trigger,
+                 nlist,
+                 filter,
+                 bond_type,
+                 r_form,
+                 p_form,
+                 p_break,
+                 max_bonds=1):
+        super().__init__(trigger)
+        self._nlist = OnlyTypes(hoomd.md.nlist.NList)(nlist)
+        param_dict = ParameterDict(filter=hoomd.filter.ParticleFilter,
+                                   bond_type=str,
+                                   r_form=float,
+                                   p_form=float,
+                                   p_break=float,
+                                   max_bonds=int)
+        param_dict.update(
+            dict(filter=filter,
+                 bond_type=bond_type,
+                 r_form=r_form,
+                 p_form=p_form,
+                 p_break=p_break,
+                 max_bonds=max_bonds))
+        self._param_dict.update(param_dict)
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        elif self._simulation != self._nlist._simulation:
+            raise SimulationDefinitionError(
+                "DynamicBond's neighbor list belongs to another simulation.")
+        if not self._nlist._attached:
+            self._nlist._attach()
+
+        self._cpp_obj = _md.DynamicBondUpdater(
+            self._simulation.state._cpp_sys_def, self._nlist._cpp_obj,
+            self._simulation.state._get_group(self.filter), self.bond_type,
+            self.r_form, self.p_form, self.p_break, self.max_bonds)
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NList: Neighbor list to find the pairs."""
+        return self._nlist
+
+    @property
+    def _children(self):
+        return [self._nlist]
+
+
+class ReplicaExchange(Updater):
+    r"""Exchange temperatures between replicas in MPI partitions.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt
+            exchanges.
+        method (hoomd.md.methods.Method): Integration method that sets the
+            temperature of this replica. Must be a `hoomd.md.methods.NVT`,
+            `hoomd.md.methods.Langevin`, or `hoomd.md.methods.Brownian`
+            method.
+
+    `ReplicaExchange` performs temperature replica exchange (parallel
+    tempering) between the partitions of the MPI communicator (see
+    ``ranks_per_partition`` in `hoomd.communicator.Communicator`). Each
+    partition runs one replica. Each time the updater is triggered, the
+    replicas in partitions 0 and 1, 2 and 3, and so on attempt to swap their
+    temperatures. The next attempt pairs partitions 1 and 2, 3 and 4, and so
+    on. A swap between replicas :math:`i` and :math:`j` is accepted with
+    probability
+
+    .. math::
+
+        \min\left(1, \exp\left[\left(\frac{1}{kT_i} - \frac{1}{kT_j}\right)
+        (U_i - U_j)\right]\right),
+
+    where :math:`U` is the potential energy of the replica.
+
+    Only the potential energies and temperatures are sent between partitions,
+    the coordinates stay in place. When a swap is accepted, ``method.kT`` is
+    set to the constant temperature of the other replica and the velocities of
+    the particles integrated by ``method`` are scaled by
+    :math:`\sqrt{kT_\mathrm{new} / kT_\mathrm{old}}`. Log ``method.kT`` to
+    follow the temperature of each replica.
+
+    Important:
+        Add `ReplicaExchange` with the same trigger to the simulations in all
+        partitions. Attaching the updater and each exchange attempt
+        communicate with the other partitions.
+
+    Example::
+
+        communicator = hoomd.communicator.Communicator(ranks_per_partition=1)
+        kT = [1.0, 1.2, 1.44, 1.73][communicator.partition]
+        nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=kT, tau=1.0)
+        replica_exchange = hoomd.md.update.ReplicaExchange(
+            trigger=hoomd.trigger.Periodic(500), method=nvt)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt
+            exchanges.
+    """
+
+    def __init__(self, trigger, method):
+        super().__init__(trigger)
+        self._method = OnlyTypes(hoomd.md.methods.Method)(method)
+
+    def _attach(self):
+        # the integrator is attached first, an unattached method does not
+        # belong to this simulation
+        if not self._method._attached:
+            raise SimulationDefinitionError(
+                "ReplicaExchange's method does not belong to the simulation "
+                "integrator.")
+        if self._method._simulation is not self._simulation:
+            raise SimulationDefinitionError(
+                "ReplicaExchange's method belongs to another simulation.")
+
+        self._cpp_obj = _md.ReplicaExchangeUpdater(
+            self._simulation.state._cpp_sys_def, self._method._cpp_obj)
+        super()._attach()
+
+    @property
+    def method(self):
+        """hoomd.md.methods.Method: Integration method of this replica."""
+        return self._method
+
+    @log(category='sequence', requires_run=True)
+    def exchanges(self):
+        """tuple[int, int]: The accepted and rejected exchanges of this \
+        partition."""
+        return self._cpp_obj.counts
+
+    @log(requires_run=True)
+    def energy(self):
+        """float: Potential energy of this replica at the last exchange \
+        attempt :math:`[\\mathrm{energy}]`."""
+        return self._cpp_obj.energy
@@ -32,6 +32,7 @@ EAMForceCompute::EAMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
     assert(m_pdata);
 
     loadFile(filename, type_of_file);
+    buildPairSplines();
 
     // initialize the number of types value
     m_ntypes = m_pdata->getNTypes();
@@ -239,6 +240,55 @@ void EAMForceCompute::loadFile(char* filename, int type_of_file)
     interpolation((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), nr, dr, &h_rphi, &h_drphi);
     }
 
+/*! Gather the coefficients of rho, rphi, and their derivatives into one contiguous table per
+    ordered type pair, in the order of the powers of the remainder.
+ */
+void EAMForceCompute::buildPairSplines()
+    {
+    ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
+
+    auto set_value = [](Scalar* c, const Scalar4& v)
+    {
+        c[0] = v.w;
+        c[1] = v.z;
+        c[2] = v.y;
+        c[3] = v.x;
+    };
+    auto set_derivative = [](Scalar* c, const Scalar4& dv)
+    {
+        c[0] = dv.z;
+        c[1] = dv.y;
+        c[2] = dv.x;
+        c[3] = Scalar(0.0);
+    };
+
+    m_pair_splines.resize(m_ntypes * m_ntypes * nr);
+    for (unsigned int typei = 0; typei < m_ntypes; typei++)
+        {
+        for (unsigned int typej = 0; typej < m_ntypes; typej++)
+            {
+            unsigned int shift
+                = (typei >= typej)
+                      ? (unsigned int)(0.5 * (2 * m_ntypes - typej - 1) * typej + typei) * nr
+                      : (unsigned int)(0.5 * (2 * m_ntypes - typei - 1) * typei + typej) * nr;
+
+            for (unsigned int n = 0; n < nr; n++)
+                {
+                EAMPairSpline& spline = m_pair_splines[(typei * m_ntypes + typej) * nr + n];
+                set_value(spline.rho_i, h_rho.data[n + nr * (typej * m_ntypes + typei)]);
+                set_value(spline.rho_j, h_rho.data[n + nr * (typei * m_ntypes + typej)]);
+                set_value(spline.rphi, h_rphi.data[n + shift]);
+                set_derivative(spline.drphi, h_drphi.data[n + shift]);
+                set_derivative(spline.drho_i, h_drho.data[n + nr * (typej * m_ntypes + typei)]);
+                set_derivative(spline.drho_j, h_drho.data[n + nr * (typei * m_ntypes + typej)]);
+                }
+            }
+        }
+    }
+
 /*! compute cubic interpolation coefficients
  \param num_all Total number of data points
  \param num_per Number of data points per chunk
@@ -289,6 +339,18 @@ void EAMForceCompute::interpolation(int num_all,
         }
     }
 
+//! Evaluate a cubic spline segment
+/*! \param c Coefficients of 1, remainder, remainder^2, and remainder^3
+    \param p Powers of the remainder: 1, remainder, remainder^2, and remainder^3
+*/
+static inline Scalar evalSpline(const Scalar* c, const Scalar* p)
+    {
+    Scalar result = Scalar(0.0);
+    for (unsigned int m = 0; m < 4; m++)
+        result += c[m] * p[m];
+    return result;
+    }
+
 /*! \post The EAM forces are computed for the given timestep. The neighborlist's
  compute method is called to ensure that it is up to date.
  \param timestep specifies the current time step of the simulation
@@ -327,15 +389,11 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     // access potential table
     ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
 
     // index and remainder
     Scalar position;           // look up position, scalar
     unsigned int int_position; // look up index for position, integer
-    unsigned int idxs;         // look up index in F, rho, rphi array, considering shift, integer
+    unsigned int idxs;         // look up index in F array, considering shift, integer
     Scalar remainder;          // look up remainder in array, integer
     Scalar4 v, dv;             // value, d(value)
 
@@ -345,10 +403,6 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     assert(h_pos.data);
     assert(h_F.data);
     assert(h_dF.data);
-    assert(h_rho.data);
-    assert(h_drho.data);
-    assert(h_rphi.data);
-    assert(h_drphi.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
@@ -368,12 +422,15 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     atomElectronDensity.resize(m_pdata->getN());
     vector<Scalar> atomDerivativeEmbeddingFunction;
     atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
     unsigned int ntypes = m_pdata->getNTypes();
 
+    // first pass: sum the electron densities and cache the pair terms that do not depend on them
+    m_pair_cache.clear();
+    m_pair_offset.resize(m_pdata->getN() + 1);
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
+        m_pair_offset[i] = (unsigned int)m_pair_cache.size();
+
         // access the particle's position and type
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
@@ -407,34 +464,45 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             // apply periodic boundary conditions
             dx = box.minImage(dx);
 
-            // start computing the force
-            // calculate r squared
+            // calculate r squared, only compute the force if the particles are closer than the
+            // cut-off
             Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
-                {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int)position;
-                int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
-                // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                                          + v.x * remainder * remainder * remainder;
-                // if third_law, pair it
-                if (third_law)
-                    {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                                              + v.x * remainder * remainder * remainder;
-                    }
-                }
+            if (rsq >= r_cut_sq)
+                continue;
+
+            // calculate position r for rho(r) and phi(r)
+            Scalar r = sqrt(rsq);
+            Scalar inverseR = Scalar(1.0) / r;
+            position = r * rdr;
+            int_position = (unsigned int)position;
+            int_position = min(int_position, nr - 1);
+            remainder = position - int_position;
+            Scalar p[4] = {Scalar(1.0), remainder, remainder * remainder, Scalar(0.0)};
+            p[3] = p[2] * remainder;
+
+            // all splines of this type pair at this r are next to each other
+            const EAMPairSpline& spline
+                = m_pair_splines[(typei * ntypes + typej) * nr + int_position];
+
+            // calculate P = sum{rho}, if third_law, pair it
+            atomElectronDensity[i] += evalSpline(spline.rho_i, p);
+            if (third_law)
+                atomElectronDensity[k] += evalSpline(spline.rho_j, p);
+
+            EAMPairCache pair;
+            pair.dx = dx;
+            pair.inv_r = inverseR;
+            // pair_eng = phi
+            pair.pair_eng = evalSpline(spline.rphi, p) * inverseR;
+            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
+            pair.derivative_phi = (evalSpline(spline.drphi, p) - pair.pair_eng) * inverseR;
+            pair.derivative_rho_i = evalSpline(spline.drho_i, p);
+            pair.derivative_rho_j = evalSpline(spline.drho_j, p);
+            pair.j = k;
+            m_pair_cache.push_back(pair);
             }
         }
+    m_pair_offset[m_pdata->getN()] = (unsigned int)m_pair_cache.size();
 
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
@@ -455,15 +523,9 @@ void EAMForceCompute::computeForces(uint64_t timestep)
                              + v.x * remainder * remainder * remainder;
         }
 
+    // second pass: combine the cached pair terms with dF/dP
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
         // initialize current particle force, potential energy, and virial to 0
         Scalar fxi = 0.0;
         Scalar fyi = 0.0;
@@ -473,72 +535,19 @@ void EAMForceCompute::computeForces(uint64_t timestep)
         for (int k = 0; k < 6; k++)
             viriali[k] = 0.0;
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
+        const Scalar dFdP_i = atomDerivativeEmbeddingFunction[i];
+        for (unsigned int n = m_pair_offset[i]; n < m_pair_offset[i + 1]; n++)
             {
-            // increment our calculation counter
-            n_calc++;
-
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
-
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
-
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-
-            // calculate position r for phi(r)
-            if (rsq >= r_cut_sq)
-                continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int)position;
-            int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
-            // calculate the shift position for type ij
-            int shift = (typei >= typej)
-                            ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
-                            : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
-            // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                               + v.x * remainder * remainder * remainder)
-                              * inverseR;
-            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi
-                = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
-            // derivativeRhoI = drho / dr of i
-            idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // derivativeRhoJ = drho / dr of j
-            idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                                       + atomDerivativeEmbeddingFunction[k] * derivativeRhoI
-                                       + derivativePhi;
+            const EAMPairCache& pair = m_pair_cache[n];
+            const Scalar3 dx = pair.dx;
+            unsigned int k = pair.j;
+
+            // fullDerivativePhi = dF/dP * drho / dr for i + dF/dP * drho / dr for j + phi
+            Scalar fullDerivativePhi = dFdP_i * pair.derivative_rho_i
+                                       + atomDerivativeEmbeddingFunction[k] * pair.derivative_rho_j
+                                       + pair.derivative_phi;
             // compute forces
-            Scalar pairForce = -fullDerivativePhi * inverseR;
+            Scalar pairForce = -fullDerivativePhi * pair.inv_r;
             viriali[0] += dx.x * dx.x * pairForce;
             viriali[1] += dx.x * dx.y * pairForce;
             viriali[2] += dx.x * dx.z * pairForce;
@@ -548,14 +557,14 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             fxi += dx.x * pairForce;
             fyi += dx.y * pairForce;
             fzi += dx.z * pairForce;
-            pei += pair_eng * 0.5;
+            pei += pair.pair_eng * 0.5;
 
             if (third_law)
                 {
                 h_force.data[k].x -= dx.x * pairForce;
                 h_force.data[k].y -= dx.y * pairForce;
                 h_force.data[k].z -= dx.z * pairForce;
-                h_force.data[k].w += pair_eng * 0.5;
+                h_force.data[k].w += pair.pair_eng * 0.5;
                 }
             }
         h_force.data[i].x += fxi;
@@ -566,13 +575,15 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             h_virial.data[k * virial_pitch + i] += viriali[k];
         }
 
-    int64_t flops = m_pdata->getN() * 5 + n_calc * (3 + 5 + 9 + 1 + 9 + 6 + 8);
+    int64_t n_pairs = (int64_t)m_pair_cache.size();
+    int64_t flops = m_pdata->getN() * 5 + n_calc * (3 + 5) + n_pairs * (9 + 1 + 30 + 6 + 8);
     if (third_law)
-        flops += n_calc * 8;
-    int64_t mem_transfer
-        = m_pdata->getN() * (5 + 4 + 10) * sizeof(Scalar) + n_calc * (1 + 3 + 1) * sizeof(Scalar);
+        flops += n_pairs * 8;
+    int64_t mem_transfer = m_pdata->getN() * (5 + 4 + 10) * sizeof(Scalar)
+                           + n_calc * (1 + 3 + 1) * sizeof(Scalar)
+                           + n_pairs * (sizeof(EAMPairSpline) + 2 * sizeof(EAMPairCache));
     if (third_law)
-        mem_transfer += n_calc * 10 * sizeof(Scalar);
+        mem_transfer += n_pairs * 10 * sizeof(Scalar);
     if (m_prof)
         m_prof->pop(flops, mem_transfer);
     }
@@ -8,6 +8,7 @@
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
+#include <vector>
 
 /*! \file EAMForceCompute.h
  \brief Declares the EAMForceCompute class
@@ -42,11 +43,44 @@
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ \b CPU implementation
+ The CPU code does not read the six arrays above in the pair loops. For each ordered pair of types,
+ m_pair_splines holds one EAMPairSpline per tabulated r with the coefficients of all the functions
+ of r that a pair needs, so a pair reads one contiguous block of memory and evaluates all splines
+ with the same powers of the remainder. The first pass over the neighbor list computes the electron
+ densities and caches the distance vector, energy, and derivatives of every pair within the cutoff
+ in m_pair_cache. The second pass only combines the cached values with dF/dP.
+
  \ingroup computes
  */
 class EAMForceCompute : public ForceCompute
     {
     public:
+    //! Spline coefficients of all functions of r for one ordered type pair and tabulated r
+    /*! Each array holds the coefficients of 1, remainder, remainder^2, and remainder^3.
+     */
+    struct EAMPairSpline
+        {
+        Scalar rho_i[4];  //!< Electron density at i due to j
+        Scalar rho_j[4];  //!< Electron density at j due to i
+        Scalar rphi[4];   //!< r * phi(r)
+        Scalar drphi[4];  //!< d(r * phi(r)) / dr
+        Scalar drho_i[4]; //!< d(rho_i) / dr
+        Scalar drho_j[4]; //!< d(rho_j) / dr
+        };
+
+    //! Values of a pair within the cutoff cached between the passes over the neighbor list
+    struct EAMPairCache
+        {
+        Scalar3 dx;              //!< Minimum image distance vector from j to i
+        Scalar inv_r;            //!< 1 / r
+        Scalar pair_eng;         //!< Pair energy phi(r)
+        Scalar derivative_phi;   //!< d(phi) / dr
+        Scalar derivative_rho_i; //!< d(rho_i) / dr
+        Scalar derivative_rho_j; //!< d(rho_j) / dr
+        unsigned int j;          //!< Index of the neighbor
+        };
+
     //! Constructs the compute
     EAMForceCompute(std::shared_ptr<SystemDefinition> sysdef, char* filename, int type_of_file);
 
@@ -87,9 +121,16 @@ class EAMForceCompute : public ForceCompute
     GPUArray<Scalar4> m_drphi; //!< derivative pair wise function and its coefficients
     GPUArray<Scalar> m_dFdP;   //!< derivative F / derivative P
 
+    std::vector<EAMPairSpline> m_pair_splines; //!< Spline tables of all ordered type pairs
+    std::vector<EAMPairCache> m_pair_cache;    //!< Pairs within the cutoff, grouped by particle
+    std::vector<unsigned int> m_pair_offset;   //!< Index of each particle's first pair in the cache
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+    //! Fill m_pair_splines from the interpolated tables
+    void buildPairSplines();
+
     //! cubic interpolation
     virtual void interpolation(int num_all,
                                int num_per,
@@ -2,12 +2,15 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 // Maintainer: joaander All developers are free to add the calls needed to export their modules
+#include "ADIOS2Writer.h"
 #include "Analyzer.h"
 #include "BondedGroupData.h"
 #include "BoxResizeUpdater.h"
 #include "CallbackAnalyzer.h"
 #include "CellList.h"
 #include "CellListStencil.h"
+#include "CheckpointReader.h"
+#include "CheckpointWriter.h"
 #include "ClockSource.h"
 #include "Compute.h"
 #include "ConstForceCompute.h"
@@ -22,6 +25,7 @@
 #include "HOOMDMath.h"
 #include "Initializers.h"
 #include "Integrator.h"
+#include "LatticeGenerator.h"
 #include "LoadBalancer.h"
 #include "Messenger.h"
 #include "ParticleData.h"
@@ -35,6 +39,8 @@
 #include "SnapshotSystemData.h"
 #include "System.h"
 #include "SystemDefinition.h"
+#include "TableFormatter.h"
+#include "TagOrderedParticleData.h"
 #include "Trigger.h"
 #include "Tuner.h"
 #include "Updater.h"
@@ -46,9 +52,11 @@
 
 // include GPU classes
 #ifdef ENABLE_HIP
+#include "BoxResizeUpdaterGPU.h"
 #include "CellListGPU.h"
 #include "LoadBalancerGPU.h"
 #include "SFCPackTunerGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
 #include <hip/hip_runtime.h>
 #endif
 
@@ -155,6 +163,16 @@ std::string mpi_bcast_str(pybind11::object string,
 #endif
     }
 
+//! broadcast bytes from root rank to all other ranks of the communicator
+pybind11::bytes mpi_bcast_bytes(pybind11::bytes data, std::shared_ptr<MPIConfiguration> mpi_conf)
+    {
+    std::string s = data;
+#ifdef ENABLE_MPI
+    bcast(s, 0, mpi_conf->getCommunicator());
+#endif
+    return pybind11::bytes(s);
+    }
+
 //! Create the python module
 /*! each class sets up its own python exports in a function export_ClassName
     create the hoomd python module and define the exports here.
@@ -176,6 +194,7 @@ PYBIND11_MODULE(_hoomd, m)
     m.def("abort_mpi", abort_mpi);
     m.def("mpi_barrier_world", mpi_barrier_world);
     m.def("mpi_bcast_str", mpi_bcast_str);
+    m.def("mpi_bcast_bytes", mpi_bcast_bytes);
 
     pybind11::class_<BuildInfo>(m, "BuildInfo")
         .def_static("getVersion", BuildInfo::getVersion)
@@ -217,6 +236,7 @@ PYBIND11_MODULE(_hoomd, m)
 #if ENABLE_HIP
     export_LocalParticleData<HOOMDDeviceBuffer>(m, "LocalParticleDataDevice");
 #endif
+    export_TagOrderedParticleData(m);
     export_MPIConfiguration(m);
     export_ExecutionConfiguration(m);
     export_SystemDefinition(m);
@@ -250,6 +270,8 @@ PYBIND11_MODULE(_hoomd, m)
 
     // initializers
     export_GSDReader(m);
+    export_CheckpointReader(m);
+    export_LatticeGenerator(m);
     getardump::export_GetarInitializer(m);
 
     // computes
@@ -270,7 +292,12 @@ PYBIND11_MODULE(_hoomd, m)
     export_DCDDumpWriter(m);
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
+#ifdef ENABLE_ADIOS2
+    export_ADIOS2Writer(m);
+#endif
+    export_CheckpointWriter(m);
     export_CallbackAnalyzer(m);
+    export_TableFormatter(m);
 
     // updaters
     export_Updater(m);
@@ -278,6 +305,10 @@ PYBIND11_MODULE(_hoomd, m)
     export_Integrator(m);
     export_BoxResizeUpdater(m);
     export_UpdaterRemoveDrift(m);
+#ifdef ENABLE_HIP
+    export_BoxResizeUpdaterGPU(m);
+    export_UpdaterRemoveDriftGPU(m);
+#endif
 
     // tuners
     export_Tuner(m);
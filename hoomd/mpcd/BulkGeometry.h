@@ -52,6 +52,18 @@ class __attribute__((visibility("default"))) BulkGeometry
         return false;
         }
 
+    //! Check if a particle cannot reach the boundary while streaming
+    /*!
+     * \param pos Current particle position
+     * \param vel Particle velocity
+     * \param dt Integration time
+     * \returns True because there is no boundary in the bulk geometry.
+     */
+    HOSTDEVICE bool cannotCollide(const Scalar3& pos, const Scalar3& vel, Scalar dt) const
+        {
+        return true;
+        }
+
     //! Check if a particle is out of bounds
     /*!
      * \param pos Current particle position
@@ -31,11 +31,27 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/SystemDefinition.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace mpcd
     {
+namespace detail
+    {
+//! Element of a sparse cell communication buffer
+/*!
+ * \tparam Element Type of the packed cell property
+ */
+template<class Element> struct SparseCellElement
+    {
+    unsigned int idx; //!< Index of the cell in the send list of the neighbor
+    Element value;    //!< Packed cell property
+    };
+    } // end namespace detail
+
 //! Communicates properties across the MPCD cell list
 class PYBIND11_EXPORT CellCommunicator
     {
@@ -125,6 +141,10 @@ class PYBIND11_EXPORT CellCommunicator
     GPUVector<unsigned char> m_recv_buf; //!< Receive buffer
     GPUArray<unsigned int> m_send_idx;   //!< Indexes of cells in send buffer
     std::vector<MPI_Request> m_reqs;     //!< MPI request objects
+    std::vector<MPI_Status> m_stats;     //!< MPI status objects
+
+    std::vector<unsigned char> m_sparse_send_buf; //!< Sparse send buffer
+    std::vector<unsigned char> m_sparse_recv_buf; //!< Staging buffer for sparse receives
 
     std::vector<unsigned int> m_neighbors; //!< Unique neighbor ranks
     std::vector<unsigned int> m_begin;     //!< Begin offset of every neighbor
@@ -154,6 +174,27 @@ class PYBIND11_EXPORT CellCommunicator
     template<typename T, class PackOpT>
     void unpackBuffer(const GPUArray<T>& props, const PackOpT op);
 
+    //! Get the location of the buffers passed to MPI
+    access_location::Enum getMPILocation() const
+        {
+#ifdef ENABLE_MPI_CUDA
+        if (m_exec_conf->isCUDAEnabled())
+            return access_location::device;
+#endif // ENABLE_MPI_CUDA
+        return access_location::host;
+        }
+
+    //! Packs the nonempty cells sent to a neighbor into the sparse send buffer
+    template<class Element>
+    size_t packSparse(const Element* send_buf, unsigned int offset, unsigned int num_send);
+
+    //! Expands a sparse message from a neighbor into the receive buffer
+    template<class Element>
+    void unpackSparse(Element* recv_buf,
+                      unsigned int offset,
+                      unsigned int num_cells,
+                      unsigned int num_bytes);
+
 #ifdef ENABLE_HIP
     std::unique_ptr<Autotuner> m_tuner_pack;   //!< Tuner for pack kernel
     std::unique_ptr<Autotuner> m_tuner_unpack; //!< Tuner for unpack kernel
@@ -180,6 +221,11 @@ class PYBIND11_EXPORT CellCommunicator
  * The data in \a props is packed into the send buffers, and nonblocking MPI
  * send / receive operations are initiated. If communication is already occurring,
  * the method returns immediately and no action is taken.
+ *
+ * When the buffers are sent from host memory, the cells sent to each neighbor whose packed
+ * value is zero are dropped if this makes the message smaller. The remaining cells are sent
+ * together with their index in the send list. Empty cells, e.g., cells without particles, hence
+ * cost no communication.
  */
 template<typename T, class PackOpT>
 void mpcd::CellCommunicator::begin(const GPUArray<T>& props, const PackOpT op)
@@ -223,17 +269,7 @@ void mpcd::CellCommunicator::begin(const GPUArray<T>& props, const PackOpT op)
     // make the MPI calls
         {
         // determine whether to use CPU or GPU CUDA buffers
-        access_location::Enum mpi_loc;
-#ifdef ENABLE_MPI_CUDA
-        if (m_exec_conf->isCUDAEnabled())
-            {
-            mpi_loc = access_location::device;
-            }
-        else
-#endif // ENABLE_MPI_CUDA
-            {
-            mpi_loc = access_location::host;
-            }
+        const access_location::Enum mpi_loc = getMPILocation();
 
         ArrayHandle<unsigned char> h_send_buf(m_send_buf, mpi_loc, access_mode::read);
         ArrayHandle<unsigned char> h_recv_buf(m_recv_buf, mpi_loc, access_mode::overwrite);
@@ -246,14 +282,33 @@ void mpcd::CellCommunicator::begin(const GPUArray<T>& props, const PackOpT op)
             cudaDeviceSynchronize();
 #endif // ENABLE_MPI_CUDA
 
+        // host buffers are sent sparsely whenever that is smaller
+        typedef mpcd::detail::SparseCellElement<typename PackOpT::element> sparse_element;
+        if (mpi_loc == access_location::host)
+            m_sparse_send_buf.resize(sizeof(sparse_element) * m_send_idx.getNumElements());
+
         m_reqs.resize(2 * m_neighbors.size());
         for (unsigned int idx = 0; idx < m_neighbors.size(); ++idx)
             {
             const unsigned int neigh = m_neighbors[idx];
             const unsigned int offset = m_begin[idx];
             const size_t num_bytes = sizeof(typename PackOpT::element) * m_num_send[idx];
-            MPI_Isend(send_buf + offset,
-                      (unsigned int)num_bytes,
+
+            const void* send_ptr = send_buf + offset;
+            size_t num_send_bytes = num_bytes;
+            if (mpi_loc == access_location::host)
+                {
+                const size_t num_sparse_bytes
+                    = sizeof(sparse_element) * packSparse(send_buf, offset, m_num_send[idx]);
+                if (num_sparse_bytes < num_bytes)
+                    {
+                    send_ptr = m_sparse_send_buf.data() + sizeof(sparse_element) * offset;
+                    num_send_bytes = num_sparse_bytes;
+                    }
+                }
+
+            MPI_Isend(send_ptr,
+                      (unsigned int)num_send_bytes,
                       MPI_BYTE,
                       neigh,
                       0,
@@ -289,13 +344,31 @@ void mpcd::CellCommunicator::finalize(const GPUArray<T>& props, const PackOpT op
         return;
 
     // finish all MPI requests
-    MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), MPI_STATUSES_IGNORE);
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
 #ifdef ENABLE_MPI_CUDA
     // MPI calls can execute in multiple streams, so force a synchronization before we move on
     if (m_exec_conf->isCUDAEnabled())
         cudaDeviceSynchronize();
 #endif // ENABLE_MPI_CUDA
 
+    // expand the sparse messages, which are shorter than the dense ones
+    if (getMPILocation() == access_location::host)
+        {
+        ArrayHandle<unsigned char> h_recv_buf(m_recv_buf,
+                                              access_location::host,
+                                              access_mode::readwrite);
+        typename PackOpT::element* recv_buf
+            = reinterpret_cast<typename PackOpT::element*>(h_recv_buf.data);
+        for (unsigned int idx = 0; idx < m_neighbors.size(); ++idx)
+            {
+            int num_bytes;
+            MPI_Get_count(&m_stats[2 * idx + 1], MPI_BYTE, &num_bytes);
+            if ((size_t)num_bytes != sizeof(typename PackOpT::element) * m_num_send[idx])
+                unpackSparse(recv_buf, m_begin[idx], m_num_send[idx], (unsigned int)num_bytes);
+            }
+        }
+
 // unpack the buffer
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
@@ -385,6 +458,74 @@ void mpcd::CellCommunicator::unpackBuffer(const GPUArray<T>& props, const PackOp
         }
     }
 
+/*!
+ * \param send_buf Dense send buffer
+ * \param offset Offset of the first cell sent to the neighbor
+ * \param num_send Number of cells sent to the neighbor
+ *
+ * \tparam Element Type of the packed cell property (inferred)
+ *
+ * \returns Number of nonempty cells packed
+ *
+ * The nonempty cells are written to \a m_sparse_send_buf, starting from element \a offset.
+ * A cell is empty if all bytes of its packed value are zero.
+ */
+template<class Element>
+size_t mpcd::CellCommunicator::packSparse(const Element* send_buf,
+                                          unsigned int offset,
+                                          unsigned int num_send)
+    {
+    mpcd::detail::SparseCellElement<Element>* sparse_buf
+        = reinterpret_cast<mpcd::detail::SparseCellElement<Element>*>(m_sparse_send_buf.data())
+          + offset;
+
+    const Element empty = Element();
+    size_t num_sparse = 0;
+    for (unsigned int i = 0; i < num_send; ++i)
+        {
+        const Element& value = send_buf[offset + i];
+        if (std::memcmp(&value, &empty, sizeof(Element)) != 0)
+            {
+            sparse_buf[num_sparse].idx = i;
+            sparse_buf[num_sparse].value = value;
+            ++num_sparse;
+            }
+        }
+    return num_sparse;
+    }
+
+/*!
+ * \param recv_buf Dense receive buffer
+ * \param offset Offset of the first cell received from the neighbor
+ * \param num_cells Number of cells received from the neighbor
+ * \param num_bytes Number of bytes received from the neighbor
+ *
+ * \tparam Element Type of the packed cell property (inferred)
+ *
+ * The sparse message stored at element \a offset of \a recv_buf is expanded in place. The cells
+ * that were not sent are zeroed, which is the value they were skipped for.
+ */
+template<class Element>
+void mpcd::CellCommunicator::unpackSparse(Element* recv_buf,
+                                          unsigned int offset,
+                                          unsigned int num_cells,
+                                          unsigned int num_bytes)
+    {
+    // stage the message since the dense cells overwrite it
+    m_sparse_recv_buf.resize(num_bytes);
+    std::memcpy(m_sparse_recv_buf.data(), recv_buf + offset, num_bytes);
+    const mpcd::detail::SparseCellElement<Element>* sparse_buf
+        = reinterpret_cast<const mpcd::detail::SparseCellElement<Element>*>(
+            m_sparse_recv_buf.data());
+
+    const unsigned int num_sparse = num_bytes / sizeof(mpcd::detail::SparseCellElement<Element>);
+    std::fill(recv_buf + offset, recv_buf + offset + num_cells, Element());
+    for (unsigned int i = 0; i < num_sparse; ++i)
+        {
+        recv_buf[offset + sparse_buf[i].idx] = sparse_buf[i].value;
+        }
+    }
+
 #ifdef ENABLE_HIP
 /*!
  * \param props Property buffer to pack
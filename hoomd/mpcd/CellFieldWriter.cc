@@ -0,0 +1,394 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/CellFieldWriter.cc
+ * \brief Definition of mpcd::CellFieldWriter
+ */
+
+#include "CellFieldWriter.h"
+#include "hoomd/GSD.h"
+#include "hoomd/HOOMDVersion.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+/*!
+ * \param sysdata MPCD system data
+ * \param thermo Cell thermo compute to sample
+ * \param fname Base file name
+ * \param num_samples Number of samples averaged in each frame
+ */
+mpcd::CellFieldWriter::CellFieldWriter(std::shared_ptr<mpcd::SystemData> sysdata,
+                                       std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                                       const std::string& fname,
+                                       unsigned int num_samples)
+    : Analyzer(sysdata->getSystemDefinition()), m_mpcd_pdata(sysdata->getParticleData()),
+      m_cl(sysdata->getCellList()), m_thermo(thermo), m_sum_momentum(m_exec_conf),
+      m_sum_thermo(m_exec_conf), m_fname(fname), m_is_open(false), m_num_samples(1), m_sample(0),
+      m_fraction(0.0), m_num_writes(0), m_cell_dim(make_uint3(0, 0, 0)),
+      m_origin_idx(make_int3(0, 0, 0)), m_cell_size(0.0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MPCD CellFieldWriter" << std::endl;
+    setNumSamples(num_samples);
+    m_rank_fname = getRankFilename(m_fname, m_exec_conf->getRank(), m_exec_conf->getNRanks());
+
+    m_thermo->getFlagsSignal()
+        .connect<mpcd::CellFieldWriter, &mpcd::CellFieldWriter::getRequestedThermoFlags>(this);
+    }
+
+mpcd::CellFieldWriter::~CellFieldWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MPCD CellFieldWriter" << std::endl;
+    m_thermo->getFlagsSignal()
+        .disconnect<mpcd::CellFieldWriter, &mpcd::CellFieldWriter::getRequestedThermoFlags>(this);
+
+    if (m_is_open)
+        gsd_close(&m_handle);
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The cell properties are computed at \a timestep and added to the sums. When the window has
+ * getNumSamples() samples, the averages and the particle subsample are written as one frame.
+ */
+void mpcd::CellFieldWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    m_thermo->compute(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "MPCD cell fields");
+
+    // start a new window if the cells have changed since the window began
+    const uint3& cell_dim = m_cl->getDim();
+    const int3& origin_idx = m_cl->getOriginIndex();
+    const Scalar cell_size = m_cl->getCellSize();
+    if (cell_dim.x != m_cell_dim.x || cell_dim.y != m_cell_dim.y || cell_dim.z != m_cell_dim.z
+        || origin_idx.x != m_origin_idx.x || origin_idx.y != m_origin_idx.y
+        || origin_idx.z != m_origin_idx.z || cell_size != m_cell_size)
+        {
+        if (m_sample > 0)
+            {
+            m_exec_conf->msg->notice(2)
+                << "mpcd: cells changed, discarding " << m_sample << " cell field samples"
+                << std::endl;
+            }
+        m_cell_dim = cell_dim;
+        m_origin_idx = origin_idx;
+        m_cell_size = cell_size;
+        resetSums();
+        }
+
+    accumulate();
+    ++m_sample;
+
+    if (m_sample == m_num_samples)
+        {
+        if (!m_is_open)
+            open();
+
+        // global configuration
+        writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, &timestep);
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        const Scalar3 L = global_box.getL();
+        float box[6] = {float(L.x),
+                        float(L.y),
+                        float(L.z),
+                        float(global_box.getTiltFactorXY()),
+                        float(global_box.getTiltFactorXZ()),
+                        float(global_box.getTiltFactorYZ())};
+        writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, box);
+
+        writeCells();
+        if (m_fraction > Scalar(0.0))
+            writeParticles();
+
+        int retval = gsd_end_frame(&m_handle);
+        hoomd::detail::GSDUtils::checkError(retval, m_rank_fname);
+        ++m_num_writes;
+
+        resetSums();
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*!
+ * \param num_samples Number of samples averaged in each frame
+ *
+ * Changing the number of samples discards the samples of the current window.
+ */
+void mpcd::CellFieldWriter::setNumSamples(unsigned int num_samples)
+    {
+    if (num_samples == 0)
+        {
+        m_exec_conf->msg->error() << "mpcd: number of cell field samples must be positive"
+                                  << std::endl;
+        throw std::runtime_error("Invalid number of cell field samples");
+        }
+    m_num_samples = num_samples;
+    m_sample = 0;
+    }
+
+/*!
+ * \param fraction Fraction of MPCD particles to write in each frame
+ */
+void mpcd::CellFieldWriter::setParticleFraction(Scalar fraction)
+    {
+    if (fraction < Scalar(0.0) || fraction > Scalar(1.0))
+        {
+        m_exec_conf->msg->error() << "mpcd: particle fraction must be between 0 and 1"
+                                  << std::endl;
+        throw std::runtime_error("Invalid MPCD particle fraction");
+        }
+    m_fraction = fraction;
+    }
+
+void mpcd::CellFieldWriter::accumulate()
+    {
+    ArrayHandle<double4> h_cell_vel(m_thermo->getCellVelocities(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<double3> h_cell_energy(m_thermo->getCellEnergies(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<double4> h_sum_momentum(m_sum_momentum,
+                                        access_location::host,
+                                        access_mode::readwrite);
+    ArrayHandle<double3> h_sum_thermo(m_sum_thermo, access_location::host, access_mode::readwrite);
+
+    const unsigned int ncells = m_cl->getNCells();
+    for (unsigned int idx = 0; idx < ncells; ++idx)
+        {
+        const double4 vel = h_cell_vel.data[idx];
+        const double3 energy = h_cell_energy.data[idx];
+        const unsigned int np = __double_as_int(energy.z);
+
+        double4 momentum = h_sum_momentum.data[idx];
+        momentum.x += vel.w * vel.x;
+        momentum.y += vel.w * vel.y;
+        momentum.z += vel.w * vel.z;
+        momentum.w += vel.w;
+        h_sum_momentum.data[idx] = momentum;
+
+        double3 thermo = h_sum_thermo.data[idx];
+        thermo.x += np;
+        // temperature is only defined for 2 or more particles
+        if (np > 1)
+            {
+            thermo.y += energy.y;
+            thermo.z += 1.0;
+            }
+        h_sum_thermo.data[idx] = thermo;
+        }
+    }
+
+void mpcd::CellFieldWriter::resetSums()
+    {
+    const unsigned int ncells = m_cl->getNCells();
+    if (ncells > m_sum_momentum.getNumElements())
+        {
+        GPUArray<double4> sum_momentum(ncells, m_exec_conf);
+        m_sum_momentum.swap(sum_momentum);
+        GPUArray<double3> sum_thermo(ncells, m_exec_conf);
+        m_sum_thermo.swap(sum_thermo);
+        }
+        {
+        ArrayHandle<double4> h_sum_momentum(m_sum_momentum,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        ArrayHandle<double3> h_sum_thermo(m_sum_thermo,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        memset(h_sum_momentum.data, 0, sizeof(double4) * m_sum_momentum.getNumElements());
+        memset(h_sum_thermo.data, 0, sizeof(double3) * m_sum_thermo.getNumElements());
+        }
+    m_sample = 0;
+    }
+
+void mpcd::CellFieldWriter::open()
+    {
+    std::ostringstream application;
+    application << "HOOMD-blue " << HOOMD_VERSION;
+    int retval = gsd_create_and_open(&m_handle,
+                                     m_rank_fname.c_str(),
+                                     application.str().c_str(),
+                                     "hoomd_mpcd_fields",
+                                     gsd_make_version(1, 0),
+                                     GSD_OPEN_APPEND,
+                                     0);
+    hoomd::detail::GSDUtils::checkError(retval, m_rank_fname);
+    m_is_open = true;
+
+    // the type names are only written in the first frame
+    const std::vector<std::string>& names = m_mpcd_pdata->getTypeNames();
+    size_t max_len = 0;
+    for (const auto& s : names)
+        max_len = std::max(max_len, s.size());
+    max_len += 1; // for null
+
+    std::vector<char> data(max_len * names.size(), 0);
+    for (unsigned int i = 0; i < names.size(); i++)
+        strncpy(&data[max_len * i], names[i].c_str(), max_len);
+    writeChunk("particles/types", GSD_TYPE_UINT8, names.size(), (uint32_t)max_len, data.data());
+    }
+
+void mpcd::CellFieldWriter::writeChunk(const char* name,
+                                       gsd_type type,
+                                       uint64_t N,
+                                       uint32_t M,
+                                       const void* data)
+    {
+    m_exec_conf->msg->notice(10) << "mpcd: writing " << name << std::endl;
+    int retval = gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+    hoomd::detail::GSDUtils::checkError(retval, m_rank_fname);
+    }
+
+/*!
+ * The owned cells are the local cells without the communication cells on the upper faces. They
+ * are written with x varying fastest, together with the global cell dimensions and the (wrapped)
+ * global index of the first owned cell.
+ */
+void mpcd::CellFieldWriter::writeCells()
+    {
+    uint3 owned_dim = m_cell_dim;
+#ifdef ENABLE_MPI
+    const std::array<unsigned int, 6>& num_comm = m_cl->getNComm();
+    owned_dim.x -= num_comm[static_cast<unsigned int>(mpcd::detail::face::east)];
+    owned_dim.y -= num_comm[static_cast<unsigned int>(mpcd::detail::face::north)];
+    owned_dim.z -= num_comm[static_cast<unsigned int>(mpcd::detail::face::up)];
+#endif // ENABLE_MPI
+    const int3 origin = m_cl->wrapGlobalCell(m_origin_idx);
+    const uint3& global_dim = m_cl->getGlobalDim();
+
+    writeChunk("cells/global_dimensions", GSD_TYPE_UINT32, 3, 1, &global_dim);
+    writeChunk("cells/dimensions", GSD_TYPE_UINT32, 3, 1, &owned_dim);
+    writeChunk("cells/origin", GSD_TYPE_INT32, 3, 1, &origin);
+    const float cell_size = float(m_cell_size);
+    writeChunk("cells/size", GSD_TYPE_FLOAT, 1, 1, &cell_size);
+    writeChunk("cells/num_samples", GSD_TYPE_UINT32, 1, 1, &m_sample);
+
+    const Index3D& ci = m_cl->getCellIndexer();
+    const unsigned int N = owned_dim.x * owned_dim.y * owned_dim.z;
+    const double volume = (m_sysdef->getNDimensions() == 3)
+                              ? double(m_cell_size) * m_cell_size * m_cell_size
+                              : double(m_cell_size) * m_cell_size;
+    std::vector<float> velocity(3 * N), density(N), temperature(N);
+        {
+        ArrayHandle<double4> h_sum_momentum(m_sum_momentum,
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<double3> h_sum_thermo(m_sum_thermo, access_location::host, access_mode::read);
+
+        unsigned int out = 0;
+        for (unsigned int k = 0; k < owned_dim.z; ++k)
+            {
+            for (unsigned int j = 0; j < owned_dim.y; ++j)
+                {
+                for (unsigned int i = 0; i < owned_dim.x; ++i)
+                    {
+                    const unsigned int idx = ci(i, j, k);
+                    const double4 momentum = h_sum_momentum.data[idx];
+                    const double3 thermo = h_sum_thermo.data[idx];
+
+                    if (momentum.w > 0.0)
+                        {
+                        velocity[3 * out] = float(momentum.x / momentum.w);
+                        velocity[3 * out + 1] = float(momentum.y / momentum.w);
+                        velocity[3 * out + 2] = float(momentum.z / momentum.w);
+                        }
+                    else
+                        {
+                        velocity[3 * out] = velocity[3 * out + 1] = velocity[3 * out + 2] = 0.0f;
+                        }
+                    density[out] = float(thermo.x / (m_sample * volume));
+                    temperature[out] = (thermo.z > 0.0) ? float(thermo.y / thermo.z) : 0.0f;
+                    ++out;
+                    }
+                }
+            }
+        }
+
+    writeChunk("cells/velocity", GSD_TYPE_FLOAT, N, 3, velocity.data());
+    writeChunk("cells/density", GSD_TYPE_FLOAT, N, 1, density.data());
+    writeChunk("cells/temperature", GSD_TYPE_FLOAT, N, 1, temperature.data());
+    }
+
+/*!
+ * A particle is written when a uniform random number drawn from its tag is less than the particle
+ * fraction. The random number does not depend on the timestep, so the subsample is the same in
+ * every frame as long as the fraction is unchanged.
+ */
+void mpcd::CellFieldWriter::writeParticles()
+    {
+    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    const uint16_t seed = m_sysdef->getSeed();
+    std::vector<float> position, velocity;
+    std::vector<unsigned int> type, tag;
+    for (unsigned int idx = 0; idx < m_mpcd_pdata->getN(); ++idx)
+        {
+        const unsigned int t = h_tag.data[idx];
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::MPCDCellFieldWriter, 0, seed),
+            hoomd::Counter(t));
+        if (hoomd::UniformDistribution<Scalar>(0, 1)(rng) >= m_fraction)
+            continue;
+
+        const Scalar4 pos = h_pos.data[idx];
+        const Scalar4 vel = h_vel.data[idx];
+        position.push_back(float(pos.x));
+        position.push_back(float(pos.y));
+        position.push_back(float(pos.z));
+        velocity.push_back(float(vel.x));
+        velocity.push_back(float(vel.y));
+        velocity.push_back(float(vel.z));
+        type.push_back(__scalar_as_int(pos.w));
+        tag.push_back(t);
+        }
+
+    const uint32_t N = (uint32_t)tag.size();
+    writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, &N);
+    writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, position.data());
+    writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, velocity.data());
+    writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, type.data());
+    writeChunk("particles/tag", GSD_TYPE_UINT32, N, 1, tag.data());
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_CellFieldWriter(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<mpcd::CellFieldWriter, Analyzer, std::shared_ptr<mpcd::CellFieldWriter>>(
+        m,
+        "CellFieldWriter")
+        .def(py::init<std::shared_ptr<mpcd::SystemData>,
+                      std::shared_ptr<mpcd::CellThermoCompute>,
+                      const std::string&,
+                      unsigned int>())
+        .def_property("num_samples",
+                      &mpcd::CellFieldWriter::getNumSamples,
+                      &mpcd::CellFieldWriter::setNumSamples)
+        .def_property("particle_fraction",
+                      &mpcd::CellFieldWriter::getParticleFraction,
+                      &mpcd::CellFieldWriter::setParticleFraction)
+        .def_property_readonly("filename", &mpcd::CellFieldWriter::getFilename)
+        .def_property_readonly("num_writes", &mpcd::CellFieldWriter::getNumWrites);
+    }
@@ -0,0 +1,154 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/CellFieldWriter.h
+ * \brief Declaration of mpcd::CellFieldWriter
+ */
+
+#ifndef MPCD_CELL_FIELD_WRITER_H_
+#define MPCD_CELL_FIELD_WRITER_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "CellThermoCompute.h"
+#include "SystemData.h"
+
+#include "hoomd/Analyzer.h"
+#include "hoomd/extern/gsd.h"
+
+#include <pybind11/pybind11.h>
+#include <string>
+
+namespace mpcd
+    {
+//! Writes time-averaged MPCD cell fields and a subsample of the MPCD particles
+/*!
+ * Writing the MPCD particles through a snapshot gathers all of them on the root rank, which is not
+ * practical for large solvents when only the flow fields are needed. The CellFieldWriter instead
+ * averages the cell properties of the CellThermoCompute over a window of samples, and each rank
+ * writes the cells it owns to its own GSD file. No particle or cell data is communicated.
+ *
+ * Each call to analyze() adds one sample. After getNumSamples() samples, a frame is written with
+ * the mass-weighted average velocity, the average number density, and the average temperature of
+ * each cell. The temperature is averaged only over the samples when the cell had at least two
+ * particles. Optionally, a random fraction of the MPCD particles is also written in each frame. The
+ * particles are chosen from their tags, so the same particles are written in every frame.
+ *
+ * The overlapping cells at the domain boundaries hold the same values on both ranks after the
+ * reduction in the CellThermoCompute. They are written by the rank on the upper side, so each rank
+ * writes its local cells without the communication cells on the east, north, and up faces. The
+ * cells are binned with the grid shift of the last collision. If the cell dimensions change during
+ * a window, the samples of that window are discarded.
+ */
+class PYBIND11_EXPORT CellFieldWriter : public Analyzer
+    {
+    public:
+    //! Constructor
+    CellFieldWriter(std::shared_ptr<mpcd::SystemData> sysdata,
+                    std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                    const std::string& fname,
+                    unsigned int num_samples);
+
+    //! Destructor
+    virtual ~CellFieldWriter();
+
+    //! Sample the cell fields and write a frame when the window is complete
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the number of samples averaged in each frame
+    unsigned int getNumSamples() const
+        {
+        return m_num_samples;
+        }
+
+    //! Set the number of samples averaged in each frame
+    void setNumSamples(unsigned int num_samples);
+
+    //! Get the fraction of MPCD particles written in each frame
+    Scalar getParticleFraction() const
+        {
+        return m_fraction;
+        }
+
+    //! Set the fraction of MPCD particles written in each frame
+    void setParticleFraction(Scalar fraction);
+
+    //! Get the base file name
+    const std::string& getFilename() const
+        {
+        return m_fname;
+        }
+
+    //! Get the file name written by a rank
+    static std::string getRankFilename(const std::string& fname,
+                                       unsigned int rank,
+                                       unsigned int nranks)
+        {
+        return (nranks > 1) ? fname + "." + std::to_string(rank) : fname;
+        }
+
+    //! Get the number of frames written
+    uint64_t getNumWrites() const
+        {
+        return m_num_writes;
+        }
+
+    protected:
+    std::shared_ptr<mpcd::ParticleData> m_mpcd_pdata;  //!< MPCD particle data
+    std::shared_ptr<mpcd::CellList> m_cl;              //!< MPCD cell list
+    std::shared_ptr<mpcd::CellThermoCompute> m_thermo; //!< Cell thermo compute to sample
+
+    GPUArray<double4> m_sum_momentum; //!< Summed momentum and mass of each cell
+    GPUArray<double3> m_sum_thermo;   //!< Summed particles, temperature, and temperature samples
+
+    //! Add the current cell properties to the sums
+    virtual void accumulate();
+
+    private:
+    std::string m_fname;        //!< Base file name
+    std::string m_rank_fname;   //!< File name written by this rank
+    gsd_handle m_handle;        //!< Handle of the file
+    bool m_is_open;             //!< True if the file has been opened
+    unsigned int m_num_samples; //!< Number of samples in each frame
+    unsigned int m_sample;      //!< Number of samples taken in the current window
+    Scalar m_fraction;          //!< Fraction of MPCD particles to write
+    uint64_t m_num_writes;      //!< Number of frames written
+    uint3 m_cell_dim;           //!< Local cell dimensions of the current window
+    int3 m_origin_idx;          //!< Global index of the first local cell of the current window
+    Scalar m_cell_size;         //!< Cell size of the current window
+
+    //! Zero the sums and start a new window
+    void resetSums();
+
+    //! Open the file written by this rank
+    void open();
+
+    //! Write a chunk to the file
+    void writeChunk(const char* name, gsd_type type, uint64_t N, uint32_t M, const void* data);
+
+    //! Write the averaged cell fields of the owned cells
+    void writeCells();
+
+    //! Write the subsample of the MPCD particles
+    void writeParticles();
+
+    //! Request the cell energies for the temperature
+    mpcd::detail::ThermoFlags getRequestedThermoFlags() const
+        {
+        mpcd::detail::ThermoFlags flags;
+        flags[mpcd::detail::thermo_options::energy] = 1;
+        return flags;
+        }
+    };
+
+namespace detail
+    {
+//! Export the CellFieldWriter to python
+void export_CellFieldWriter(pybind11::module& m);
+    } // end namespace detail
+    } // end namespace mpcd
+
+#endif // MPCD_CELL_FIELD_WRITER_H_
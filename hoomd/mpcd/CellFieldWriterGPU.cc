@@ -0,0 +1,67 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/CellFieldWriterGPU.cc
+ * \brief Definition of mpcd::CellFieldWriterGPU
+ */
+
+#include "CellFieldWriterGPU.h"
+#include "CellFieldWriterGPU.cuh"
+
+/*!
+ * \param sysdata MPCD system data
+ * \param thermo Cell thermo compute to sample
+ * \param fname Base file name
+ * \param num_samples Number of samples averaged in each frame
+ */
+mpcd::CellFieldWriterGPU::CellFieldWriterGPU(std::shared_ptr<mpcd::SystemData> sysdata,
+                                             std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                                             const std::string& fname,
+                                             unsigned int num_samples)
+    : mpcd::CellFieldWriter(sysdata, thermo, fname, num_samples)
+    {
+    m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_fields", m_exec_conf));
+    }
+
+void mpcd::CellFieldWriterGPU::accumulate()
+    {
+    ArrayHandle<double4> d_cell_vel(m_thermo->getCellVelocities(),
+                                    access_location::device,
+                                    access_mode::read);
+    ArrayHandle<double3> d_cell_energy(m_thermo->getCellEnergies(),
+                                       access_location::device,
+                                       access_mode::read);
+    ArrayHandle<double4> d_sum_momentum(m_sum_momentum,
+                                        access_location::device,
+                                        access_mode::readwrite);
+    ArrayHandle<double3> d_sum_thermo(m_sum_thermo,
+                                      access_location::device,
+                                      access_mode::readwrite);
+
+    m_tuner->begin();
+    mpcd::gpu::accumulate_cell_fields(d_sum_momentum.data,
+                                      d_sum_thermo.data,
+                                      d_cell_vel.data,
+                                      d_cell_energy.data,
+                                      m_cl->getNCells(),
+                                      m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_CellFieldWriterGPU(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<mpcd::CellFieldWriterGPU,
+               mpcd::CellFieldWriter,
+               std::shared_ptr<mpcd::CellFieldWriterGPU>>(m, "CellFieldWriterGPU")
+        .def(py::init<std::shared_ptr<mpcd::SystemData>,
+                      std::shared_ptr<mpcd::CellThermoCompute>,
+                      const std::string&,
+                      unsigned int>());
+    }
@@ -0,0 +1,97 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/CellFieldWriterGPU.cu
+ * \brief Defines GPU functions and kernels used by mpcd::CellFieldWriterGPU
+ */
+
+#include "CellFieldWriterGPU.cuh"
+
+namespace mpcd
+    {
+namespace gpu
+    {
+namespace kernel
+    {
+/*!
+ * \param d_sum_momentum Summed momentum and mass of each cell
+ * \param d_sum_thermo Summed number of particles, temperature, and temperature samples of each cell
+ * \param d_cell_vel Cell velocities and masses
+ * \param d_cell_energy Cell kinetic energies, temperatures, and numbers of particles
+ * \param num_cells Number of cells
+ *
+ * One thread is used per cell. The temperature is only added when the cell has at least two
+ * particles.
+ */
+__global__ void accumulate_cell_fields(double4* d_sum_momentum,
+                                       double3* d_sum_thermo,
+                                       const double4* d_cell_vel,
+                                       const double3* d_cell_energy,
+                                       const unsigned int num_cells)
+    {
+    // one thread per cell
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= num_cells)
+        return;
+
+    const double4 vel = d_cell_vel[idx];
+    const double3 energy = d_cell_energy[idx];
+    const unsigned int np = __double_as_int(energy.z);
+
+    double4 momentum = d_sum_momentum[idx];
+    momentum.x += vel.w * vel.x;
+    momentum.y += vel.w * vel.y;
+    momentum.z += vel.w * vel.z;
+    momentum.w += vel.w;
+    d_sum_momentum[idx] = momentum;
+
+    double3 thermo = d_sum_thermo[idx];
+    thermo.x += np;
+    if (np > 1)
+        {
+        thermo.y += energy.y;
+        thermo.z += 1.0;
+        }
+    d_sum_thermo[idx] = thermo;
+    }
+    } // end namespace kernel
+
+/*!
+ * \param d_sum_momentum Summed momentum and mass of each cell
+ * \param d_sum_thermo Summed number of particles, temperature, and temperature samples of each cell
+ * \param d_cell_vel Cell velocities and masses
+ * \param d_cell_energy Cell kinetic energies, temperatures, and numbers of particles
+ * \param num_cells Number of cells
+ * \param block_size Number of threads per block
+ *
+ * \sa kernel::accumulate_cell_fields
+ */
+cudaError_t accumulate_cell_fields(double4* d_sum_momentum,
+                                   double3* d_sum_thermo,
+                                   const double4* d_cell_vel,
+                                   const double3* d_cell_energy,
+                                   const unsigned int num_cells,
+                                   const unsigned int block_size)
+    {
+    if (num_cells == 0)
+        return cudaSuccess;
+
+    unsigned int max_block_size;
+    cudaFuncAttributes attr;
+    cudaFuncGetAttributes(&attr, (const void*)kernel::accumulate_cell_fields);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(num_cells / run_block_size + 1);
+    kernel::accumulate_cell_fields<<<grid, run_block_size>>>(d_sum_momentum,
+                                                             d_sum_thermo,
+                                                             d_cell_vel,
+                                                             d_cell_energy,
+                                                             num_cells);
+
+    return cudaSuccess;
+    }
+
+    } // end namespace gpu
+    } // end namespace mpcd
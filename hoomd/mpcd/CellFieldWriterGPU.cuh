@@ -0,0 +1,31 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef MPCD_CELL_FIELD_WRITER_GPU_CUH_
+#define MPCD_CELL_FIELD_WRITER_GPU_CUH_
+
+/*!
+ * \file mpcd/CellFieldWriterGPU.cuh
+ * \brief Declaration of CUDA kernels for mpcd::CellFieldWriterGPU
+ */
+
+#include <cuda_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+
+namespace mpcd
+    {
+namespace gpu
+    {
+//! Add the cell properties to the cell field sums
+cudaError_t accumulate_cell_fields(double4* d_sum_momentum,
+                                   double3* d_sum_thermo,
+                                   const double4* d_cell_vel,
+                                   const double3* d_cell_energy,
+                                   const unsigned int num_cells,
+                                   const unsigned int block_size);
+
+    } // end namespace gpu
+    } // end namespace mpcd
+
+#endif // MPCD_CELL_FIELD_WRITER_GPU_CUH_
@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/CellFieldWriterGPU.h
+ * \brief Declaration of mpcd::CellFieldWriterGPU
+ */
+
+#ifndef MPCD_CELL_FIELD_WRITER_GPU_H_
+#define MPCD_CELL_FIELD_WRITER_GPU_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "CellFieldWriter.h"
+#include "hoomd/Autotuner.h"
+
+namespace mpcd
+    {
+//! Writes time-averaged MPCD cell fields, sampling the cells on the GPU
+/*!
+ * The cell properties are summed on the GPU, so the cells are only copied to the host when a frame
+ * is written. See mpcd::CellFieldWriter for details.
+ */
+class PYBIND11_EXPORT CellFieldWriterGPU : public mpcd::CellFieldWriter
+    {
+    public:
+    //! Constructor
+    CellFieldWriterGPU(std::shared_ptr<mpcd::SystemData> sysdata,
+                       std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                       const std::string& fname,
+                       unsigned int num_samples);
+
+    //! Set autotuner parameters
+    /*!
+     * \param enable Enable/disable autotuning
+     * \param period period (approximate) in time steps when returning occurs
+     */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        mpcd::CellFieldWriter::setAutotunerParams(enable, period);
+
+        m_tuner->setEnabled(enable);
+        m_tuner->setPeriod(period);
+        }
+
+    protected:
+    //! Add the current cell properties to the sums on the GPU
+    virtual void accumulate();
+
+    private:
+    std::unique_ptr<::Autotuner> m_tuner; //!< Autotuner for summing the cells
+    };
+
+namespace detail
+    {
+//! Export the CellFieldWriterGPU to python
+void export_CellFieldWriterGPU(pybind11::module& m);
+    } // end namespace detail
+    } // end namespace mpcd
+
+#endif // MPCD_CELL_FIELD_WRITER_GPU_H_
@@ -18,9 +18,9 @@
 mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
     : Compute(sysdef), m_mpcd_pdata(mpcd_pdata), m_cell_size(1.0), m_cell_np_max(4),
-      m_cell_np(m_exec_conf), m_cell_list(m_exec_conf), m_embed_cell_ids(m_exec_conf),
-      m_conditions(m_exec_conf), m_needs_compute_dim(true), m_particles_sorted(false),
-      m_virtual_change(false)
+      m_cell_np(m_exec_conf), m_cell_list(m_exec_conf), m_compact(false),
+      m_cell_offsets(m_exec_conf), m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf),
+      m_needs_compute_dim(true), m_particles_sorted(false), m_virtual_change(false)
     {
     assert(m_mpcd_pdata);
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellList" << std::endl;
@@ -91,39 +91,66 @@ void mpcd::CellList::compute(uint64_t timestep)
 
     if (peekCompute(timestep))
         {
+        // embedded particles that left this rank are found while binning, so they can only be
+        // migrated on the first attempt
 #ifdef ENABLE_MPI
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
-
-        // exchange embedded particles if necessary
-        if (m_sysdef->isDomainDecomposed() && needsEmbedMigrate(timestep))
-            {
-            m_comm->forceMigrate();
-            m_comm->communicate(timestep);
-            }
-        if (m_prof)
-            m_prof->push(m_exec_conf, "MPCD cell list");
+        bool check_embed_migrate = (m_embed_group && m_sysdef->isDomainDecomposed());
 #endif // ENABLE_MPI
-
-        // resize to be able to hold the number of embedded particles
-        if (m_embed_group)
+        while (true)
             {
-            m_embed_cell_ids.resize(m_embed_group->getNumMembers());
-            }
+            // resize to be able to hold the number of embedded particles
+            if (m_embed_group)
+                {
+                m_embed_cell_ids.resize(m_embed_group->getNumMembers());
+                }
 
-        bool overflowed = false;
-        do
-            {
-            buildCellList();
+            bool overflowed = false;
+#ifdef ENABLE_MPI
+            char embed_migrate = 0;
+#endif // ENABLE_MPI
+            do
+                {
+                buildCellList();
+
+#ifdef ENABLE_MPI
+                overflowed = checkConditions(check_embed_migrate ? &embed_migrate : NULL);
+#else
+                overflowed = checkConditions(NULL);
+#endif // ENABLE_MPI
 
-            overflowed = checkConditions();
+                if (overflowed)
+                    {
+                    reallocate();
+                    resetConditions();
+                    }
+                } while (overflowed);
 
-            if (overflowed)
+#ifdef ENABLE_MPI
+            // exchange embedded particles if necessary and bin again
+            if (check_embed_migrate)
                 {
-                reallocate();
-                resetConditions();
+                check_embed_migrate = false;
+                MPI_Allreduce(MPI_IN_PLACE,
+                              &embed_migrate,
+                              1,
+                              MPI_CHAR,
+                              MPI_MAX,
+                              m_exec_conf->getMPICommunicator());
+                if (embed_migrate)
+                    {
+                    if (m_prof)
+                        m_prof->pop(m_exec_conf);
+                    resetConditions();
+                    m_comm->forceMigrate();
+                    m_comm->communicate(timestep);
+                    if (m_prof)
+                        m_prof->push(m_exec_conf, "MPCD cell list");
+                    continue;
+                    }
                 }
-            } while (overflowed);
+#endif // ENABLE_MPI
+            break;
+            }
 
         // we are finished building, explicitly mark everything (rather than using shouldCompute)
         m_first_compute = false;
@@ -138,8 +165,91 @@ void mpcd::CellList::compute(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * \returns True if the caller can fill the cell list with the current particle positions
+ *
+ * The cell list is filled outside of compute() by a kernel that also performs another operation,
+ * like streaming the particles. This is only supported when all particles in the cell list are
+ * MPCD particles owned by this rank, so there are no embedded particles, virtual particles, or
+ * communicating cells, and the cell list is not compact. Otherwise, the cell list must be built by
+ * compute().
+ *
+ * The cell list dimensions and memory are brought up to date before returning.
+ */
+bool mpcd::CellList::beginFusedBuild()
+    {
+    if (m_compact || m_embed_group || m_mpcd_pdata->getNVirtual() > 0)
+        return false;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        return false;
+#endif // ENABLE_MPI
+
+    computeDimensions();
+    return true;
+    }
+
+/*!
+ * \param timestep Timestep the cell list was filled for
+ * \returns True if the cell list is complete
+ *
+ * The condition flags are checked the same way as in compute(). If the cell list overflowed, it is
+ * reallocated and the next call to compute() rebuilds it. Otherwise, the cell list is marked as
+ * computed at \a timestep, so compute() does not rebuild it.
+ */
+bool mpcd::CellList::finishFusedBuild(uint64_t timestep)
+    {
+    if (checkConditions(NULL))
+        {
+        reallocate();
+        resetConditions();
+        m_force_compute = true;
+        m_mpcd_pdata->invalidateCellCache();
+        return false;
+        }
+
+    // the cell list accounts for any sorting or virtual particle changes that have happened
+    m_virtual_change = false;
+    m_particles_sorted = false;
+    m_first_compute = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+
+    m_mpcd_pdata->validateCellCache();
+    return true;
+    }
+
+/*!
+ * \param compact If true, store the particles of each cell contiguously
+ *
+ * The storage for the previous format is released, and the dimensions are recomputed so that the
+ * cell list is reallocated and rebuilt on the next call to compute().
+ */
+void mpcd::CellList::setCompact(bool compact)
+    {
+    if (compact == m_compact)
+        return;
+    m_compact = compact;
+
+    GPUVector<unsigned int> cell_list(m_exec_conf);
+    m_cell_list.swap(cell_list);
+    GPUVector<unsigned int> cell_offsets(m_exec_conf);
+    m_cell_offsets.swap(cell_offsets);
+
+    m_needs_compute_dim = true;
+    }
+
 void mpcd::CellList::reallocate()
     {
+    // the compact cell list is sized to the number of particles when it is built
+    if (m_compact)
+        {
+        m_exec_conf->msg->notice(6) << "Allocating compact MPCD cell list, "
+                                    << m_cell_indexer.getNumElements() << " cells." << std::endl;
+        m_cell_offsets.resize(m_cell_indexer.getNumElements() + 1);
+        return;
+        }
+
     m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << m_cell_np_max
                                 << " particles in " << m_cell_indexer.getNumElements() << " cells."
                                 << std::endl;
@@ -158,6 +268,23 @@ void mpcd::CellList::updateGlobalBox()
         throw std::runtime_error("Box must be orthorhombic");
         }
 
+#ifdef ENABLE_MPI
+    // the Lees-Edwards offset shifts the cells across the y boundary by a fraction of a cell, so
+    // the cells along x and y cannot be exchanged between ranks
+    if (global_box.getLeesEdwardsOffset() != Scalar(0.0) && m_pdata->getDomainDecomposition())
+        {
+        const Index3D& di = m_pdata->getDomainDecomposition()->getDomainIndexer();
+        if (di.getW() > 1 || di.getH() > 1)
+            {
+            m_exec_conf->msg->error()
+                << "mpcd: Lees-Edwards boundary conditions require that the box is only "
+                   "decomposed along z"
+                << std::endl;
+            throw std::runtime_error("Lees-Edwards boundary conditions not supported");
+            }
+        }
+#endif // ENABLE_MPI
+
     // box must be evenly divisible by cell size
     const Scalar3 L = global_box.getL();
     m_global_cell_dim = make_uint3((unsigned int)round(L.x / m_cell_size),
@@ -538,6 +665,15 @@ void mpcd::CellList::buildCellList()
     const BoxDim& box = m_pdata->getBox();
     const uchar3 periodic = box.getPeriodic();
 
+    unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    unsigned int N_tot = N_mpcd;
+
+    // the compact cell list holds every particle exactly once
+    if (m_compact)
+        {
+        m_cell_list.resize(N_tot + ((m_embed_group) ? m_embed_group->getNumMembers() : 0));
+        }
+
     ArrayHandle<unsigned int> h_cell_list(m_cell_list,
                                           access_location::host,
                                           access_mode::overwrite);
@@ -553,8 +689,6 @@ void mpcd::CellList::buildCellList()
     ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
                                access_location::host,
                                access_mode::readwrite);
-    unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
-    unsigned int N_tot = N_mpcd;
 
     // we can't modify the velocity of embedded particles, so we only read their position
     std::unique_ptr<ArrayHandle<unsigned int>> h_embed_cell_ids;
@@ -587,6 +721,7 @@ void mpcd::CellList::buildCellList()
 #endif // ENABLE_MPI
 
     const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
+    const Scalar le_offset = m_pdata->getGlobalBox().getLeesEdwardsOffset();
 
     for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
         {
@@ -613,15 +748,26 @@ void mpcd::CellList::buildCellList()
                                     (int)std::floor(delta.y / m_cell_size),
                                     (int)std::floor(delta.z / m_cell_size));
 
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+        // a particle shifted across the y boundary by the grid shift belongs to a cell of the
+        // periodic image, which is displaced along x by the Lees-Edwards offset
+        if (periodic.y && le_offset != Scalar(0.0))
+            {
+            if (global_bin.y == (int)n_global_cells.y)
+                global_bin.x = (int)std::floor((delta.x - le_offset) / m_cell_size);
+            else if (global_bin.y == -1)
+                global_bin.x = (int)std::floor((delta.x + le_offset) / m_cell_size);
+            }
+
+        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range,
+        // the Lees-Edwards offset up to half of the cells along x)
         // this is done using periodic from the "local" box, since this will be periodic
         // only when there is one rank along the dimension
         if (periodic.x)
             {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
+            if (global_bin.x >= (int)n_global_cells.x)
+                global_bin.x -= n_global_cells.x;
+            else if (global_bin.x < 0)
+                global_bin.x += n_global_cells.x;
             }
         if (periodic.y)
             {
@@ -652,15 +798,19 @@ void mpcd::CellList::buildCellList()
             }
 
         unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
-        unsigned int offset = h_cell_np.data[bin_idx];
-        if (offset < m_cell_np_max)
+        // the compact cell list is filled once all particles have been counted
+        if (!m_compact)
             {
-            h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
-            }
-        else
-            {
-            // overflow
-            conditions.x = std::max(conditions.x, offset + 1);
+            unsigned int offset = h_cell_np.data[bin_idx];
+            if (offset < m_cell_np_max)
+                {
+                h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
+                }
+            else
+                {
+                // overflow
+                conditions.x = std::max(conditions.x, offset + 1);
+                }
             }
 
         // stash the current particle bin into the velocity array
@@ -677,6 +827,32 @@ void mpcd::CellList::buildCellList()
         ++h_cell_np.data[bin_idx];
         }
 
+    // counting sort of the stashed bins into the compact cell list, which is only possible
+    // when every particle was binned
+    if (m_compact && conditions.y == 0 && conditions.z == 0)
+        {
+        const unsigned int n_cells = m_cell_indexer.getNumElements();
+        ArrayHandle<unsigned int> h_cell_offsets(m_cell_offsets,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        h_cell_offsets.data[0] = 0;
+        for (unsigned int cur_cell = 0; cur_cell < n_cells; ++cur_cell)
+            {
+            h_cell_offsets.data[cur_cell + 1]
+                = h_cell_offsets.data[cur_cell] + h_cell_np.data[cur_cell];
+            }
+
+        // the counter is rebuilt as the cells are filled
+        memset(h_cell_np.data, 0, sizeof(unsigned int) * n_cells);
+        for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+            {
+            const unsigned int bin_idx = (cur_p < N_mpcd)
+                                             ? __scalar_as_int(h_vel.data[cur_p].w)
+                                             : h_embed_cell_ids->data[cur_p - N_mpcd];
+            h_cell_list.data[h_cell_offsets.data[bin_idx] + h_cell_np.data[bin_idx]++] = cur_p;
+            }
+        }
+
     // write out the conditions
     m_conditions.resetFlags(conditions);
     }
@@ -711,69 +887,42 @@ void mpcd::CellList::sort(uint64_t timestep,
                                           access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN();
 
-    for (unsigned int idx = 0; idx < getNCells(); ++idx)
+    // every entry of the compact cell list holds a particle
+    if (m_compact)
         {
-        const unsigned int np = h_cell_np.data[idx];
-        for (unsigned int offset = 0; offset < np; ++offset)
+        for (unsigned int cl_idx = 0; cl_idx < m_cell_list.size(); ++cl_idx)
             {
-            const unsigned int cl_idx = m_cell_list_indexer(offset, idx);
             const unsigned int pid = h_cell_list.data[cl_idx];
-            // only update indexes of MPCD particles, not virtual or embedded particles
             if (pid < N_mpcd)
                 {
                 h_cell_list.data[cl_idx] = h_rorder.data[pid];
                 }
             }
+        return;
         }
-    }
-
-#ifdef ENABLE_MPI
-bool mpcd::CellList::needsEmbedMigrate(uint64_t timestep)
-    {
-    // no migrate needed if no embedded particles
-    if (!m_embed_group)
-        return false;
-
-    // ensure that the cell list has been sized first
-    computeDimensions();
 
-    // coverage box dimensions, assuming orthorhombic
-    const Scalar3 lo = m_cover_box.getLo();
-    const Scalar3 hi = m_cover_box.getHi();
-    const uchar3 periodic = m_cover_box.getPeriodic();
-    const unsigned int ndim = m_sysdef->getNDimensions();
-
-    // particle data
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_group(m_embed_group->getIndexArray(),
-                                      access_location::host,
-                                      access_mode::read);
-    const unsigned int N = m_embed_group->getNumMembers();
-
-    // check if any particle lies outside of the box on this rank
-    char migrate = 0;
-    for (unsigned int i = 0; i < N && !migrate; ++i)
+    for (unsigned int idx = 0; idx < getNCells(); ++idx)
         {
-        const unsigned int idx = h_group.data[i];
-        const Scalar4 postype = h_pos.data[idx];
-        const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-        if ((!periodic.x && (pos.x >= hi.x || pos.x < lo.x))
-            || (!periodic.y && (pos.y >= hi.y || pos.y < lo.y))
-            || (!periodic.z && ndim == 3 && (pos.z >= hi.z || pos.z < lo.z)))
+        const unsigned int np = h_cell_np.data[idx];
+        for (unsigned int offset = 0; offset < np; ++offset)
             {
-            migrate = 1;
+            const unsigned int cl_idx = m_cell_list_indexer(offset, idx);
+            const unsigned int pid = h_cell_list.data[cl_idx];
+            // only update indexes of MPCD particles, not virtual or embedded particles
+            if (pid < N_mpcd)
+                {
+                h_cell_list.data[cl_idx] = h_rorder.data[pid];
+                }
             }
         }
-
-    // reduce across all ranks
-    MPI_Allreduce(MPI_IN_PLACE, &migrate, 1, MPI_CHAR, MPI_MAX, m_exec_conf->getMPICommunicator());
-
-    return static_cast<bool>(migrate);
     }
-#endif // ENABLE_MPI
 
-bool mpcd::CellList::checkConditions()
+/*!
+ * \param embed_migrate If not NULL, flag set instead of raising an error when an embedded particle
+ *                      is outside the cells of this rank
+ * \returns True if the cell list overflowed
+ */
+bool mpcd::CellList::checkConditions(char* embed_migrate)
     {
     bool result = false;
 
@@ -808,6 +957,13 @@ bool mpcd::CellList::checkConditions()
     if (conditions.z)
         {
         unsigned int n = conditions.z - 1;
+        // embedded particles outside this rank need to be migrated
+        if (embed_migrate && n >= m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
+            {
+            *embed_migrate = 1;
+            return result;
+            }
+
         Scalar4 pos_empty_i;
         if (n < m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
             {
@@ -948,5 +1104,6 @@ void mpcd::detail::export_CellList(pybind11::module& m)
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<mpcd::ParticleData>>())
         .def_property("cell_size", &mpcd::CellList::getCellSize, &mpcd::CellList::setCellSize)
         .def("setEmbeddedGroup", &mpcd::CellList::setEmbeddedGroup)
-        .def("removeEmbeddedGroup", &mpcd::CellList::removeEmbeddedGroup);
+        .def("removeEmbeddedGroup", &mpcd::CellList::removeEmbeddedGroup)
+        .def_property("compact", &mpcd::CellList::isCompact, &mpcd::CellList::setCompact);
     }
@@ -52,6 +52,23 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_cell_list;
         }
 
+    //! Get the offsets of the cells into the compact cell list
+    /*!
+     * \returns Array of getNCells() + 1 offsets, where the particles in cell \a i are entries
+     *          offsets[i] to offsets[i+1] - 1 of getCellList(). The array is only valid in
+     *          compact mode.
+     */
+    const GPUArray<unsigned int>& getCellOffsets() const
+        {
+        return m_cell_offsets;
+        }
+
+    //! Get the number of entries in the compact cell list
+    unsigned int getNCompactEntries() const
+        {
+        return (unsigned int)m_cell_list.size();
+        }
+
     //! Get the number of particles per cell
     const GPUArray<unsigned int>& getCellSizeArray() const
         {
@@ -114,6 +131,25 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_cell_np_max;
         }
 
+    //! Set the cell list to store the particles in compact (CSR) format
+    /*!
+     * \param compact If true, store the particles of each cell contiguously
+     *
+     * In compact mode, the cell list has one entry per particle and getCellOffsets() gives the
+     * first entry of each cell, so there is no padding to getNmax() particles per cell and the
+     * cell list never needs to be rebuilt because it overflowed. getCellListIndexer() is not
+     * valid in compact mode.
+     *
+     * \note Calling forces a rebuild of the cell list on the next update
+     */
+    void setCompact(bool compact);
+
+    //! Check if the cell list is stored in compact format
+    bool isCompact() const
+        {
+        return m_compact;
+        }
+
     //! Set the MPCD cell size
     /*!
      * \param cell_size Grid spacing
@@ -221,11 +257,25 @@ class PYBIND11_EXPORT CellList : public Compute
         }
 
     //! Gets the cell id array for the embedded particles
-    const GPUArray<unsigned int>& getEmbeddedGroupCellIds() const
+    const GlobalArray<unsigned int>& getEmbeddedGroupCellIds() const
         {
         return m_embed_cell_ids;
         }
 
+    //! Prepare to fill the cell list outside of compute()
+    bool beginFusedBuild();
+
+#ifdef ENABLE_HIP
+    //! Get the device flags for conditions detected while filling the cell list
+    uint3* getConditionsDeviceFlags()
+        {
+        return m_conditions.getDeviceFlags();
+        }
+#endif // ENABLE_HIP
+
+    //! Finish filling the cell list outside of compute()
+    bool finishFusedBuild(uint64_t timestep);
+
     //! Get the signal for dimensions changing
     /*!
      * \returns A signal that subscribers can attach to be notified that the
@@ -253,9 +303,11 @@ class PYBIND11_EXPORT CellList : public Compute
     Index3D m_global_cell_indexer; //!< Indexer from 3D into 1D for global cell indexes
     Index2D m_cell_list_indexer;   //!< Indexer into cell list members
     unsigned int m_cell_np_max;    //!< Maximum number of particles per cell
-    GPUVector<unsigned int> m_cell_np;        //!< Number of particles per cell
-    GPUVector<unsigned int> m_cell_list;      //!< Cell list of particles
-    GPUVector<unsigned int> m_embed_cell_ids; //!< Cell ids of the embedded particles
+    GPUVector<unsigned int> m_cell_np;           //!< Number of particles per cell
+    GPUVector<unsigned int> m_cell_list;         //!< Cell list of particles
+    bool m_compact;                              //!< True if the cell list is in compact format
+    GPUVector<unsigned int> m_cell_offsets;      //!< Offsets of the cells in the compact cell list
+    GlobalVector<unsigned int> m_embed_cell_ids; //!< Cell ids of the embedded particles
     GPUFlags<uint3> m_conditions; //!< Detect conditions that might fail building cell list
 
     int3 m_origin_idx; //!< Origin as a global index
@@ -267,13 +319,10 @@ class PYBIND11_EXPORT CellList : public Compute
 
     /// The systems's communicator.
     std::shared_ptr<Communicator> m_comm;
-
-    //! Determine if embedded particles require migration
-    virtual bool needsEmbedMigrate(uint64_t timestep);
 #endif // ENABLE_MPI
 
     //! Check the condition flags
-    bool checkConditions();
+    bool checkConditions(char* embed_migrate);
 
     //! Reset the conditions array
     void resetConditions();
@@ -13,24 +13,36 @@
 
 mpcd::CellListGPU::CellListGPU(std::shared_ptr<SystemDefinition> sysdef,
                                std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
-    : mpcd::CellList(sysdef, mpcd_pdata)
+    : mpcd::CellList(sysdef, mpcd_pdata), m_gpu_partition(m_exec_conf->getGPUIds())
     {
     m_tuner_cell.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell", m_exec_conf));
+    m_tuner_fill.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_fill", m_exec_conf));
+    m_tuner_combine.reset(
+        new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_combine", m_exec_conf));
     m_tuner_sort.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_sort", m_exec_conf));
-
-#ifdef ENABLE_MPI
-    m_tuner_embed_migrate.reset(
-        new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_embed_migrate", m_exec_conf));
-
-    GPUFlags<unsigned int> migrate_flag(m_exec_conf);
-    m_migrate_flag.swap(migrate_flag);
-#endif // ENABLE_MPI
     }
 
 mpcd::CellListGPU::~CellListGPU() { }
 
 void mpcd::CellListGPU::buildCellList()
     {
+    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    unsigned int N_tot = N_mpcd;
+    if (m_embed_group)
+        N_tot += m_embed_group->getNumMembers();
+
+    // the compact cell list holds every particle exactly once
+    if (m_compact)
+        {
+        m_cell_list.resize(N_tot);
+        }
+
+    // with more than one GPU, each GPU bins its particles into its own scratch cell list
+    const unsigned int ngpu = m_exec_conf->getNumActiveGPUs();
+    m_gpu_partition.setN(N_tot);
+    if (ngpu > 1)
+        reallocateScratch(ngpu);
+
     ArrayHandle<unsigned int> d_cell_list(m_cell_list,
                                           access_location::device,
                                           access_mode::overwrite);
@@ -42,9 +54,6 @@ void mpcd::CellListGPU::buildCellList()
                                access_location::device,
                                access_mode::readwrite);
 
-    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
-    unsigned int N_tot = N_mpcd;
-
     // total effective number of cells in the global box, optionally padded by
     // extra cells in MPI simulations
     uint3 n_global_cells = m_global_cell_dim;
@@ -57,70 +66,167 @@ void mpcd::CellListGPU::buildCellList()
         n_global_cells.z += 2 * m_num_extra;
 #endif // ENABLE_MPI
 
+    std::unique_ptr<ArrayHandle<unsigned int>> d_embed_cell_ids;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_pos_embed;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_embed_member_idx;
     if (m_embed_group)
         {
-        ArrayHandle<unsigned int> d_embed_cell_ids(m_embed_cell_ids,
+        d_embed_cell_ids.reset(new ArrayHandle<unsigned int>(m_embed_cell_ids,
+                                                             access_location::device,
+                                                             access_mode::overwrite));
+        d_pos_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getPositions(),
                                                    access_location::device,
-                                                   access_mode::overwrite);
-        ArrayHandle<Scalar4> d_pos_embed(m_pdata->getPositions(),
-                                         access_location::device,
-                                         access_mode::read);
-        ArrayHandle<unsigned int> d_embed_member_idx(m_embed_group->getIndexArray(),
-                                                     access_location::device,
-                                                     access_mode::read);
-        N_tot += m_embed_group->getNumMembers();
+                                                   access_mode::read));
+        d_embed_member_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(),
+                                                               access_location::device,
+                                                               access_mode::read));
+        }
+
+    ArrayHandle<unsigned int> d_cell_np_scratch(m_cell_np_scratch,
+                                                access_location::device,
+                                                access_mode::overwrite);
+    ArrayHandle<unsigned int> d_cell_list_scratch(m_cell_list_scratch,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+    ArrayHandle<uint3> d_conditions_scratch(m_conditions_scratch,
+                                            access_location::device,
+                                            access_mode::overwrite);
+    unsigned int* d_bin_np = d_cell_np.data;
+    unsigned int* d_bin_list = (m_compact) ? NULL : d_cell_list.data;
+    uint3* d_bin_conditions = m_conditions.getDeviceFlags();
+    if (ngpu > 1)
+        {
+        cudaMemset(d_conditions_scratch.data, 0, sizeof(uint3) * ngpu);
+        d_bin_np = d_cell_np_scratch.data;
+        d_bin_list = (m_compact) ? NULL : d_cell_list_scratch.data;
+        d_bin_conditions = d_conditions_scratch.data;
+        }
 
-        m_tuner_cell->begin();
-        mpcd::gpu::compute_cell_list(d_cell_np.data,
-                                     d_cell_list.data,
-                                     m_conditions.getDeviceFlags(),
-                                     d_vel.data,
-                                     d_embed_cell_ids.data,
-                                     d_pos.data,
-                                     d_pos_embed.data,
-                                     d_embed_member_idx.data,
-                                     m_pdata->getBox().getPeriodic(),
-                                     m_origin_idx,
-                                     m_grid_shift,
-                                     m_pdata->getGlobalBox().getLo(),
-                                     n_global_cells,
-                                     m_cell_size,
-                                     m_cell_np_max,
-                                     m_cell_indexer,
-                                     m_cell_list_indexer,
-                                     N_mpcd,
-                                     N_tot,
-                                     m_tuner_cell->getParam());
+    // the compact cell list is only counted here, and filled after the offsets are known
+    m_tuner_cell->begin();
+    m_exec_conf->beginMultiGPU();
+    mpcd::gpu::compute_cell_list(d_bin_np,
+                                 d_bin_list,
+                                 d_bin_conditions,
+                                 d_vel.data,
+                                 (m_embed_group) ? d_embed_cell_ids->data : NULL,
+                                 d_pos.data,
+                                 (m_embed_group) ? d_pos_embed->data : NULL,
+                                 (m_embed_group) ? d_embed_member_idx->data : NULL,
+                                 m_pdata->getBox().getPeriodic(),
+                                 m_origin_idx,
+                                 m_grid_shift,
+                                 m_pdata->getGlobalBox().getLo(),
+                                 m_pdata->getGlobalBox().getLeesEdwardsOffset(),
+                                 n_global_cells,
+                                 m_cell_size,
+                                 m_cell_np_max,
+                                 m_cell_indexer,
+                                 m_cell_list_indexer,
+                                 N_mpcd,
+                                 m_gpu_partition,
+                                 m_tuner_cell->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_exec_conf->endMultiGPU();
+    m_tuner_cell->end();
+
+    // merge the cell lists of the GPUs on the first GPU
+    if (ngpu > 1)
+        {
+        m_tuner_combine->begin();
+        mpcd::gpu::combine_cell_lists(d_cell_np.data,
+                                      (m_compact) ? NULL : d_cell_list.data,
+                                      m_conditions.getDeviceFlags(),
+                                      d_cell_np_scratch.data,
+                                      d_cell_list_scratch.data,
+                                      d_conditions_scratch.data,
+                                      m_cell_np_max,
+                                      m_cell_list_indexer,
+                                      m_cell_indexer.getNumElements(),
+                                      ngpu,
+                                      m_tuner_combine->getParam());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
-        m_tuner_cell->end();
+        m_tuner_combine->end();
         }
-    else
+
+    if (m_compact)
         {
-        m_tuner_cell->begin();
-        mpcd::gpu::compute_cell_list(d_cell_np.data,
-                                     d_cell_list.data,
-                                     m_conditions.getDeviceFlags(),
-                                     d_vel.data,
-                                     NULL,
-                                     d_pos.data,
-                                     NULL,
-                                     NULL,
-                                     m_pdata->getBox().getPeriodic(),
-                                     m_origin_idx,
-                                     m_grid_shift,
-                                     m_pdata->getGlobalBox().getLo(),
-                                     n_global_cells,
-                                     m_cell_size,
-                                     m_cell_np_max,
-                                     m_cell_indexer,
-                                     m_cell_list_indexer,
-                                     N_mpcd,
-                                     N_tot,
-                                     m_tuner_cell->getParam());
+        const unsigned int n_cells = m_cell_indexer.getNumElements();
+        ArrayHandle<unsigned int> d_cell_offsets(m_cell_offsets,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+
+        // scan the number of particles per cell into the offsets
+        void* d_tmp = NULL;
+        size_t tmp_bytes = 0;
+        mpcd::gpu::scan_cell_offsets(d_cell_offsets.data,
+                                     d_tmp,
+                                     tmp_bytes,
+                                     d_cell_np.data,
+                                     n_cells);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        ScopedAllocation<unsigned char> d_tmp_alloc(m_exec_conf->getCachedAllocator(),
+                                                    (tmp_bytes > 0) ? tmp_bytes : 1);
+        d_tmp = (void*)d_tmp_alloc();
+
+        mpcd::gpu::scan_cell_offsets(d_cell_offsets.data,
+                                     d_tmp,
+                                     tmp_bytes,
+                                     d_cell_np.data,
+                                     n_cells);
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
-        m_tuner_cell->end();
+
+        m_tuner_fill->begin();
+        mpcd::gpu::fill_compact_cell_list(d_cell_list.data,
+                                          d_cell_np.data,
+                                          d_cell_offsets.data,
+                                          d_vel.data,
+                                          (m_embed_group) ? d_embed_cell_ids->data : NULL,
+                                          n_cells,
+                                          N_mpcd,
+                                          N_tot,
+                                          m_tuner_fill->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_fill->end();
+        }
+    }
+
+/*!
+ * \param ngpu Number of active GPUs
+ *
+ * The scratch arrays hold one copy of the number of particles per cell, the cell list, and the
+ * conditions flags for each GPU. They are only grown, and the cell list is not needed in the
+ * compact format.
+ */
+void mpcd::CellListGPU::reallocateScratch(unsigned int ngpu)
+    {
+    const size_t num_np = size_t(m_cell_indexer.getNumElements()) * ngpu;
+    if (m_cell_np_scratch.getNumElements() < num_np)
+        {
+        GlobalArray<unsigned int> cell_np_scratch(num_np, m_exec_conf);
+        m_cell_np_scratch.swap(cell_np_scratch);
+        TAG_ALLOCATION(m_cell_np_scratch);
+        }
+
+    const size_t num_list = (m_compact) ? 0 : size_t(m_cell_list_indexer.getNumElements()) * ngpu;
+    if (m_cell_list_scratch.getNumElements() < num_list)
+        {
+        GlobalArray<unsigned int> cell_list_scratch(num_list, m_exec_conf);
+        m_cell_list_scratch.swap(cell_list_scratch);
+        TAG_ALLOCATION(m_cell_list_scratch);
+        }
+
+    if (m_conditions_scratch.getNumElements() < ngpu)
+        {
+        GlobalArray<uint3> conditions_scratch(ngpu, m_exec_conf);
+        m_conditions_scratch.swap(conditions_scratch);
+        TAG_ALLOCATION(m_conditions_scratch);
         }
     }
 
@@ -151,11 +257,13 @@ void mpcd::CellListGPU::sort(uint64_t timestep,
     ArrayHandle<unsigned int> d_rorder(rorder, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_cell_np(m_cell_np, access_location::device, access_mode::read);
 
+    // every entry of the compact cell list is filled, so it is sorted as a single cell
     m_tuner_sort->begin();
     mpcd::gpu::cell_apply_sort(d_cell_list.data,
                                d_rorder.data,
-                               d_cell_np.data,
-                               m_cell_list_indexer,
+                               (m_compact) ? NULL : d_cell_np.data,
+                               (m_compact) ? Index2D((unsigned int)m_cell_list.size(), 1)
+                                           : m_cell_list_indexer,
                                m_mpcd_pdata->getN(),
                                m_tuner_sort->getParam());
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -163,43 +271,6 @@ void mpcd::CellListGPU::sort(uint64_t timestep,
     m_tuner_sort->end();
     }
 
-#ifdef ENABLE_MPI
-bool mpcd::CellListGPU::needsEmbedMigrate(uint64_t timestep)
-    {
-    // no migrate needed if no embedded particles
-    if (!m_embed_group)
-        return false;
-
-    // ensure that the cell list has been sized first
-    computeDimensions();
-
-    // particle data
-    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
-    ArrayHandle<unsigned int> d_group(m_embed_group->getIndexArray(),
-                                      access_location::device,
-                                      access_mode::read);
-
-    // check if any particles have left this rank on the gpu
-    m_tuner_embed_migrate->begin();
-    mpcd::gpu::cell_check_migrate_embed(m_migrate_flag.getDeviceFlags(),
-                                        d_pos.data,
-                                        d_group.data,
-                                        m_cover_box,
-                                        m_sysdef->getNDimensions(),
-                                        m_embed_group->getNumMembers(),
-                                        m_tuner_embed_migrate->getParam());
-    if (m_exec_conf->isCUDAErrorCheckingEnabled())
-        CHECK_CUDA_ERROR();
-    m_tuner_embed_migrate->end();
-
-    // read flags from the gpu, and reduce across all ranks
-    char migrate = static_cast<char>(m_migrate_flag.readFlags());
-    MPI_Allreduce(MPI_IN_PLACE, &migrate, 1, MPI_CHAR, MPI_MAX, m_exec_conf->getMPICommunicator());
-
-    return static_cast<bool>(migrate);
-    }
-#endif // ENABLE_MPI
-
 void mpcd::detail::export_CellListGPU(pybind11::module& m)
     {
     namespace py = pybind11;
@@ -8,7 +8,10 @@
  * \brief Defines GPU functions and kernels used by mpcd::CellListGPU
  */
 
+#include <hipcub/hipcub.hpp>
+
 #include "CellListGPU.cuh"
+#include "ParticleDataUtilities.h"
 
 namespace mpcd
     {
@@ -19,7 +22,7 @@ namespace kernel
 //! Kernel to compute the MPCD cell list on the GPU
 /*!
  * \param d_cell_np Array of number of particles per cell
- * \param d_cell_list 2D array of MPCD particles in each cell
+ * \param d_cell_list 2D array of MPCD particles in each cell, or NULL to only count
  * \param d_conditions Conditions flags for error reporting
  * \param d_vel MPCD particle velocities
  * \param d_embed_cell_ids Cell indexes of embedded particles
@@ -30,20 +33,26 @@ namespace kernel
  * \param origin_idx Global origin index for the local box
  * \param grid_shift Random grid shift vector
  * \param global_lo Lower bound of global orthorhombic simulation box
+ * \param le_offset Lees-Edwards offset of the global simulation box
  * \param n_global_cell Global dimensions of the cell list, including padding
  * \param cell_size Cell width
  * \param cell_np_max Maximum number of particles per cell
  * \param cell_indexer 3D indexer for cell id
  * \param cell_list_indexer 2D indexer for particle position in cell
  * \param N_mpcd Number of MPCD particles
- * \param N_tot Total number of particle (MPCD + embedded)
+ * \param N Number of particles to bin
+ * \param offset Index of the first particle to bin
  *
  * \b Implementation
  * One thread is launched per particle. The particle is floored into a bin subject to a random grid
  * shift. The number of particles in that bin is atomically incremented. If the addition of the
  * particle will not overflow the allocated memory, the particle is written into that bin.
  * Otherwise, a flag is set to resize the cell list and recompute. The MPCD particle's cell id is
- * stashed into the velocity array.
+ * stashed into the velocity array, or is set to mpcd::detail::NO_CELL if the particle could not be
+ * binned.
+ *
+ * If \a d_cell_list is NULL, the particles are only counted and binned. The compact cell list is
+ * then filled by fill_compact_cell_list.
  */
 __global__ void compute_cell_list(unsigned int* d_cell_np,
                                   unsigned int* d_cell_list,
@@ -57,18 +66,21 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
                                   const int3 origin_idx,
                                   const Scalar3 grid_shift,
                                   const Scalar3 global_lo,
+                                  const Scalar le_offset,
                                   const uint3 n_global_cell,
                                   const Scalar cell_size,
                                   const unsigned int cell_np_max,
                                   const Index3D cell_indexer,
                                   const Index2D cell_list_indexer,
                                   const unsigned int N_mpcd,
-                                  const unsigned int N_tot)
+                                  const unsigned int N,
+                                  const unsigned int offset)
     {
     // one thread per particle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (idx >= N_tot)
+    if (idx >= N)
         return;
+    idx += offset;
 
     Scalar4 postype_i;
     if (idx < N_mpcd)
@@ -84,6 +96,10 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
     if (isnan(pos_i.x) || isnan(pos_i.y) || isnan(pos_i.z))
         {
         (*d_conditions).y = idx + 1;
+        if (idx < N_mpcd)
+            d_vel[idx].w = __int_as_scalar(mpcd::detail::NO_CELL);
+        else
+            d_embed_cell_ids[idx - N_mpcd] = mpcd::detail::NO_CELL;
         return;
         }
 
@@ -93,15 +109,26 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
                                 std::floor(delta.y / cell_size),
                                 std::floor(delta.z / cell_size));
 
-    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+    // a particle shifted across the y boundary by the grid shift belongs to a cell of the
+    // periodic image, which is displaced along x by the Lees-Edwards offset
+    if (periodic.y && le_offset != Scalar(0.0))
+        {
+        if (global_bin.y == (int)n_global_cell.y)
+            global_bin.x = std::floor((delta.x - le_offset) / cell_size);
+        else if (global_bin.y == -1)
+            global_bin.x = std::floor((delta.x + le_offset) / cell_size);
+        }
+
+    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range,
+    // the Lees-Edwards offset up to half of the cells along x)
     // this is done using periodic from the "local" box, since this will be periodic
     // only when there is one rank along the dimension
     if (periodic.x)
         {
-        if (global_bin.x == (int)n_global_cell.x)
-            global_bin.x = 0;
-        else if (global_bin.x == -1)
-            global_bin.x = n_global_cell.x - 1;
+        if (global_bin.x >= (int)n_global_cell.x)
+            global_bin.x -= n_global_cell.x;
+        else if (global_bin.x < 0)
+            global_bin.x += n_global_cell.x;
         }
     if (periodic.y)
         {
@@ -129,19 +156,26 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
         || (bin.z < 0 || bin.z >= (int)cell_indexer.getD()))
         {
         (*d_conditions).z = idx + 1;
+        if (idx < N_mpcd)
+            d_vel[idx].w = __int_as_scalar(mpcd::detail::NO_CELL);
+        else
+            d_embed_cell_ids[idx - N_mpcd] = mpcd::detail::NO_CELL;
         return;
         }
 
     const unsigned int bin_idx = cell_indexer(bin.x, bin.y, bin.z);
-    const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
-    if (offset < cell_np_max)
-        {
-        d_cell_list[cell_list_indexer(offset, bin_idx)] = idx;
-        }
-    else
+    const unsigned int pos_in_cell = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
+    if (d_cell_list != NULL)
         {
-        // overflow
-        atomicMax(&(*d_conditions).x, offset + 1);
+        if (pos_in_cell < cell_np_max)
+            {
+            d_cell_list[cell_list_indexer(pos_in_cell, bin_idx)] = idx;
+            }
+        else
+            {
+            // overflow
+            atomicMax(&(*d_conditions).x, pos_in_cell + 1);
+            }
         }
 
     // stash the current particle bin into the velocity array
@@ -155,45 +189,115 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
         }
     }
 
+//! Kernel to fill the compact MPCD cell list on the GPU
 /*!
- * \param d_migrate_flag Flag signaling migration is required (output)
- * \param d_pos Embedded particle positions
- * \param d_group Indexes into \a d_pos for particles in embedded group
- * \param box Box covered by this domain
- * \param num_dim Dimensionality of system
- * \param N Number of particles in group
+ * \param d_cell_list Compact array of particles in each cell
+ * \param d_cell_np Array of number of particles per cell, zeroed by the caller
+ * \param d_cell_offsets Offset of each cell into \a d_cell_list
+ * \param d_vel MPCD particle velocities holding the cell ids
+ * \param d_embed_cell_ids Cell indexes of embedded particles
+ * \param N_mpcd Number of MPCD particles
+ * \param N_tot Total number of particle (MPCD + embedded)
  *
  * \b Implementation
- * Using one thread per particle, each particle position is compared to the
- * bounds of the simulation box. If a particle lies outside the box, \a d_migrate_flag
- * has its bits set using an atomicMax transaction. The caller should then trigger
- * a communication step to migrate particles to their appropriate ranks.
+ * One thread is launched per particle. The cell id stashed by compute_cell_list is read, and the
+ * number of particles in that cell is atomically incremented to claim a slot after the offset of
+ * the cell. Particles that could not be binned are skipped.
  */
-__global__ void cell_check_migrate_embed(unsigned int* d_migrate_flag,
-                                         const Scalar4* d_pos,
-                                         const unsigned int* d_group,
-                                         const BoxDim box,
-                                         const unsigned int num_dim,
-                                         const unsigned int N)
+__global__ void fill_compact_cell_list(unsigned int* d_cell_list,
+                                       unsigned int* d_cell_np,
+                                       const unsigned int* d_cell_offsets,
+                                       const Scalar4* d_vel,
+                                       const unsigned int* d_embed_cell_ids,
+                                       const unsigned int N_mpcd,
+                                       const unsigned int N_tot)
     {
-    // one thread per particle in group
-    unsigned int tid = blockIdx.x * blockDim.x + threadIdx.x;
-    if (tid >= N)
+    // one thread per particle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N_tot)
         return;
 
-    const unsigned int idx = d_group[tid];
-    const Scalar4 postype = d_pos[idx];
-    const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    const unsigned int bin_idx
+        = (idx < N_mpcd) ? __scalar_as_int(d_vel[idx].w) : d_embed_cell_ids[idx - N_mpcd];
+    if (bin_idx == mpcd::detail::NO_CELL)
+        return;
 
-    const Scalar3 lo = box.getLo();
-    const Scalar3 hi = box.getHi();
-    const uchar3 periodic = box.getPeriodic();
+    const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
+    d_cell_list[d_cell_offsets[bin_idx] + offset] = idx;
+    }
 
-    if ((!periodic.x && (pos.x >= hi.x || pos.x < lo.x))
-        || (!periodic.y && (pos.y >= hi.y || pos.y < lo.y))
-        || (!periodic.z && num_dim == 3 && (pos.z >= hi.z || pos.z < lo.z)))
+//! Kernel to combine the cell lists built on each GPU
+/*!
+ * \param d_cell_np Array of number of particles per cell (output)
+ * \param d_cell_list 2D array of MPCD particles in each cell (output), or NULL to only count
+ * \param d_conditions Conditions flags for error reporting (output)
+ * \param d_cell_np_scratch Number of particles per cell binned by each GPU
+ * \param d_cell_list_scratch Cell lists filled by each GPU
+ * \param d_conditions_scratch Conditions flags of each GPU
+ * \param cell_np_max Maximum number of particles per cell
+ * \param cell_list_indexer 2D indexer for particle position in cell
+ * \param Ncell Number of cells
+ * \param ngpu Number of GPUs
+ *
+ * \b Implementation
+ * One thread is launched per cell. The particles each GPU binned into the cell are appended to the
+ * cell in the order of the GPUs, up to \a cell_np_max entries, and the total number of particles
+ * in the cell is written. An overflow of the combined cell is flagged the same way as when the
+ * cell list is built on one GPU. The first thread also merges the conditions flags of the GPUs.
+ */
+__global__ void combine_cell_lists(unsigned int* d_cell_np,
+                                   unsigned int* d_cell_list,
+                                   uint3* d_conditions,
+                                   const unsigned int* d_cell_np_scratch,
+                                   const unsigned int* d_cell_list_scratch,
+                                   const uint3* d_conditions_scratch,
+                                   const unsigned int cell_np_max,
+                                   const Index2D cell_list_indexer,
+                                   const unsigned int Ncell,
+                                   const unsigned int ngpu)
+    {
+    // one thread per cell
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= Ncell)
+        return;
+
+    if (idx == 0)
         {
-        atomicMax(d_migrate_flag, 1);
+        uint3 conditions = make_uint3(0, 0, 0);
+        for (unsigned int igpu = 0; igpu < ngpu; ++igpu)
+            {
+            const uint3 conditions_i = d_conditions_scratch[igpu];
+            conditions.y = max(conditions.y, conditions_i.y);
+            conditions.z = max(conditions.z, conditions_i.z);
+            }
+        (*d_conditions).y = conditions.y;
+        (*d_conditions).z = conditions.z;
+        }
+
+    unsigned int np = 0;
+    for (unsigned int igpu = 0; igpu < ngpu; ++igpu)
+        {
+        const unsigned int np_i = d_cell_np_scratch[igpu * Ncell + idx];
+        if (d_cell_list != NULL)
+            {
+            const unsigned int* cell_list_i
+                = d_cell_list_scratch + igpu * cell_list_indexer.getNumElements();
+            for (unsigned int offset = 0; offset < np_i && offset < cell_np_max; ++offset)
+                {
+                if (np + offset < cell_np_max)
+                    {
+                    d_cell_list[cell_list_indexer(np + offset, idx)]
+                        = cell_list_i[cell_list_indexer(offset, idx)];
+                    }
+                }
+            }
+        np += np_i;
+        }
+    d_cell_np[idx] = np;
+
+    if (d_cell_list != NULL && np > cell_np_max)
+        {
+        atomicMax(&(*d_conditions).x, np);
         }
     }
 
@@ -214,16 +318,15 @@ __global__ void cell_apply_sort(unsigned int* d_cell_list,
     const unsigned int offset = idx - (cell * cli.getW());
 
     /* here comes some terrible execution divergence */
-    // check if the cell is filled
-    const unsigned int np = d_cell_np[cell];
-    if (offset < np)
+    // check if the cell is filled, which every entry of a compact cell list is
+    if (d_cell_np != NULL && offset >= d_cell_np[cell])
+        return;
+
+    // check if this is an MPCD particle
+    const unsigned int pid = d_cell_list[idx];
+    if (pid < N_mpcd)
         {
-        // check if this is an MPCD particle
-        const unsigned int pid = d_cell_list[idx];
-        if (pid < N_mpcd)
-            {
-            d_cell_list[idx] = d_rorder[pid];
-            }
+        d_cell_list[idx] = d_rorder[pid];
         }
     }
     } // end namespace kernel
@@ -232,7 +335,7 @@ __global__ void cell_apply_sort(unsigned int* d_cell_list,
 
 /*!
  * \param d_cell_np Array of number of particles per cell
- * \param d_cell_list 2D array of MPCD particles in each cell
+ * \param d_cell_list 2D array of MPCD particles in each cell, or NULL to only count
  * \param d_conditions Conditions flags for error reporting
  * \param d_vel MPCD particle velocities
  * \param d_embed_cell_ids Cell indexes of embedded particles
@@ -243,16 +346,22 @@ __global__ void cell_apply_sort(unsigned int* d_cell_list,
  * \param origin_idx Global origin index for the local box
  * \param grid_shift Random grid shift vector
  * \param global_lo Lower bound of global orthorhombic simulation box
+ * \param le_offset Lees-Edwards offset of the global simulation box
  * \param n_global_cell Global dimensions of the cell list, including padding
  * \param cell_size Cell width
  * \param cell_np_max Maximum number of particles per cell
  * \param cell_indexer 3D indexer for cell id
  * \param cell_list_indexer 2D indexer for particle position in cell
  * \param N_mpcd Number of MPCD particles
- * \param N_tot Total number of particle (MPCD + embedded)
+ * \param gpu_partition Partition of the particles (MPCD + embedded) between the GPUs
  * \param block_size Number of threads per block
  *
  * \returns cudaSuccess on completion, or an error on failure
+ *
+ * The particles in each range of \a gpu_partition are binned on their GPU. GPU \a i writes
+ * the \a i-th consecutive copy of \a d_cell_np, \a d_cell_list, and \a d_conditions, so these
+ * arrays must hold one copy per active GPU. With more than one GPU, the copies are merged by
+ * combine_cell_lists.
  */
 cudaError_t mpcd::gpu::compute_cell_list(unsigned int* d_cell_np,
                                          unsigned int* d_cell_list,
@@ -266,18 +375,21 @@ cudaError_t mpcd::gpu::compute_cell_list(unsigned int* d_cell_np,
                                          const int3& origin_idx,
                                          const Scalar3& grid_shift,
                                          const Scalar3& global_lo,
+                                         const Scalar le_offset,
                                          const uint3& n_global_cell,
                                          const Scalar cell_size,
                                          const unsigned int cell_np_max,
                                          const Index3D& cell_indexer,
                                          const Index2D& cell_list_indexer,
                                          const unsigned int N_mpcd,
-                                         const unsigned int N_tot,
+                                         const GPUPartition& gpu_partition,
                                          const unsigned int block_size)
     {
     // set the number of particles in each cell to zero
-    cudaError_t error
-        = cudaMemset(d_cell_np, 0, sizeof(unsigned int) * cell_indexer.getNumElements());
+    const unsigned int Ncell = cell_indexer.getNumElements();
+    cudaError_t error = cudaMemset(d_cell_np,
+                                   0,
+                                   sizeof(unsigned int) * Ncell * gpu_partition.getNumActiveGPUs());
     if (error != cudaSuccess)
         return error;
 
@@ -287,68 +399,183 @@ cudaError_t mpcd::gpu::compute_cell_list(unsigned int* d_cell_np,
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
-    dim3 grid(N_tot / run_block_size + 1);
-    mpcd::gpu::kernel::compute_cell_list<<<grid, run_block_size>>>(d_cell_np,
-                                                                   d_cell_list,
-                                                                   d_conditions,
-                                                                   d_vel,
-                                                                   d_embed_cell_ids,
-                                                                   d_pos,
-                                                                   d_pos_embed,
-                                                                   d_embed_member_idx,
-                                                                   periodic,
-                                                                   origin_idx,
-                                                                   grid_shift,
-                                                                   global_lo,
-                                                                   n_global_cell,
-                                                                   cell_size,
-                                                                   cell_np_max,
-                                                                   cell_indexer,
-                                                                   cell_list_indexer,
-                                                                   N_mpcd,
-                                                                   N_tot);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+        const unsigned int nwork = range.second - range.first;
+
+        dim3 grid(nwork / run_block_size + 1);
+        mpcd::gpu::kernel::compute_cell_list<<<grid, run_block_size>>>(
+            d_cell_np + idev * Ncell,
+            (d_cell_list != NULL) ? d_cell_list + idev * cell_list_indexer.getNumElements()
+                                  : NULL,
+            d_conditions + idev,
+            d_vel,
+            d_embed_cell_ids,
+            d_pos,
+            d_pos_embed,
+            d_embed_member_idx,
+            periodic,
+            origin_idx,
+            grid_shift,
+            global_lo,
+            le_offset,
+            n_global_cell,
+            cell_size,
+            cell_np_max,
+            cell_indexer,
+            cell_list_indexer,
+            N_mpcd,
+            nwork,
+            range.first);
+        }
 
     return cudaSuccess;
     }
 
 /*!
- * \param d_migrate_flag Flag signaling migration is required (output)
- * \param d_pos Embedded particle positions
- * \param d_group Indexes into \a d_pos for particles in embedded group
- * \param box Box covered by this domain
- * \param N Number of particles in group
+ * \param d_cell_np Array of number of particles per cell (output)
+ * \param d_cell_list 2D array of MPCD particles in each cell (output), or NULL to only count
+ * \param d_conditions Conditions flags for error reporting (output)
+ * \param d_cell_np_scratch Number of particles per cell binned by each GPU
+ * \param d_cell_list_scratch Cell lists filled by each GPU
+ * \param d_conditions_scratch Conditions flags of each GPU
+ * \param cell_np_max Maximum number of particles per cell
+ * \param cell_list_indexer 2D indexer for particle position in cell
+ * \param Ncell Number of cells
+ * \param ngpu Number of GPUs
  * \param block_size Number of threads per block
  *
- * \sa mpcd::gpu::kernel::cell_check_migrate_embed
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::kernel::combine_cell_lists
  */
-cudaError_t mpcd::gpu::cell_check_migrate_embed(unsigned int* d_migrate_flag,
-                                                const Scalar4* d_pos,
-                                                const unsigned int* d_group,
-                                                const BoxDim& box,
-                                                const unsigned int num_dim,
-                                                const unsigned int N,
-                                                const unsigned int block_size)
+cudaError_t mpcd::gpu::combine_cell_lists(unsigned int* d_cell_np,
+                                          unsigned int* d_cell_list,
+                                          uint3* d_conditions,
+                                          const unsigned int* d_cell_np_scratch,
+                                          const unsigned int* d_cell_list_scratch,
+                                          const uint3* d_conditions_scratch,
+                                          const unsigned int cell_np_max,
+                                          const Index2D& cell_list_indexer,
+                                          const unsigned int Ncell,
+                                          const unsigned int ngpu,
+                                          const unsigned int block_size)
     {
-    // ensure that the flag is always zeroed even if the caller forgets
-    cudaMemset(d_migrate_flag, 0, sizeof(unsigned int));
+    unsigned int max_block_size;
+    cudaFuncAttributes attr;
+    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::combine_cell_lists);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(Ncell / run_block_size + 1);
+    mpcd::gpu::kernel::combine_cell_lists<<<grid, run_block_size>>>(d_cell_np,
+                                                                    d_cell_list,
+                                                                    d_conditions,
+                                                                    d_cell_np_scratch,
+                                                                    d_cell_list_scratch,
+                                                                    d_conditions_scratch,
+                                                                    cell_np_max,
+                                                                    cell_list_indexer,
+                                                                    Ncell,
+                                                                    ngpu);
+
+    return cudaSuccess;
+    }
+
+/*!
+ * \param d_cell_offsets Offset of each cell into the compact cell list (output)
+ * \param d_tmp Temporary storage for the scan
+ * \param tmp_bytes Number of bytes allocated for temporary storage (output on first call)
+ * \param d_cell_np Array of number of particles per cell
+ * \param Ncell Number of cells
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \b Implementation details:
+ * CUB DeviceScan is used to perform the inclusive scan of \a d_cell_np into \a d_cell_offsets + 1.
+ * Hence, this function requires two calls. The first call sizes the temporary storage, which is
+ * returned in \a tmp_bytes. The caller must then allocate the required bytes, and call the function
+ * a second time. This performs the scan and also sets the first offset to zero.
+ */
+cudaError_t mpcd::gpu::scan_cell_offsets(unsigned int* d_cell_offsets,
+                                         void* d_tmp,
+                                         size_t& tmp_bytes,
+                                         const unsigned int* d_cell_np,
+                                         const unsigned int Ncell)
+    {
+    if (d_tmp != NULL)
+        {
+        cudaError_t error = cudaMemset(d_cell_offsets, 0, sizeof(unsigned int));
+        if (error != cudaSuccess)
+            return error;
+        }
+    cub::DeviceScan::InclusiveSum(d_tmp, tmp_bytes, d_cell_np, d_cell_offsets + 1, Ncell);
+    return cudaSuccess;
+    }
+
+/*!
+ * \param d_cell_list Compact array of particles in each cell
+ * \param d_cell_np Array of number of particles per cell
+ * \param d_cell_offsets Offset of each cell into \a d_cell_list
+ * \param d_vel MPCD particle velocities holding the cell ids
+ * \param d_embed_cell_ids Cell indexes of embedded particles
+ * \param Ncell Number of cells
+ * \param N_mpcd Number of MPCD particles
+ * \param N_tot Total number of particle (MPCD + embedded)
+ * \param block_size Number of threads per block
+ *
+ * \returns cudaSuccess on completion, or an error on failure
+ *
+ * \sa mpcd::gpu::kernel::fill_compact_cell_list
+ */
+cudaError_t mpcd::gpu::fill_compact_cell_list(unsigned int* d_cell_list,
+                                              unsigned int* d_cell_np,
+                                              const unsigned int* d_cell_offsets,
+                                              const Scalar4* d_vel,
+                                              const unsigned int* d_embed_cell_ids,
+                                              const unsigned int Ncell,
+                                              const unsigned int N_mpcd,
+                                              const unsigned int N_tot,
+                                              const unsigned int block_size)
+    {
+    // the number of particles in each cell is counted again as the cells are filled
+    cudaError_t error = cudaMemset(d_cell_np, 0, sizeof(unsigned int) * Ncell);
+    if (error != cudaSuccess)
+        return error;
 
     unsigned int max_block_size;
     cudaFuncAttributes attr;
-    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::cell_check_migrate_embed);
+    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::fill_compact_cell_list);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
-    dim3 grid(N / run_block_size + 1);
-    mpcd::gpu::kernel::cell_check_migrate_embed<<<grid, run_block_size>>>(d_migrate_flag,
-                                                                          d_pos,
-                                                                          d_group,
-                                                                          box,
-                                                                          num_dim,
-                                                                          N);
+    dim3 grid(N_tot / run_block_size + 1);
+    mpcd::gpu::kernel::fill_compact_cell_list<<<grid, run_block_size>>>(d_cell_list,
+                                                                        d_cell_np,
+                                                                        d_cell_offsets,
+                                                                        d_vel,
+                                                                        d_embed_cell_ids,
+                                                                        N_mpcd,
+                                                                        N_tot);
 
     return cudaSuccess;
     }
 
+/*!
+ * \param d_cell_list Cell list
+ * \param d_rorder Mapping of old particle indexes onto sorted particle indexes
+ * \param d_cell_np Array of number of particles per cell, or NULL if every entry is filled
+ * \param cli Cell list indexer
+ * \param N_mpcd Number of MPCD particles
+ * \param block_size Number of threads per block
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::kernel::cell_apply_sort
+ */
 cudaError_t mpcd::gpu::cell_apply_sort(unsigned int* d_cell_list,
                                        const unsigned int* d_rorder,
                                        const unsigned int* d_cell_np,
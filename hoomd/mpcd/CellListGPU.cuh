@@ -14,6 +14,7 @@
 #include <cuda_runtime.h>
 
 #include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 
@@ -34,23 +35,46 @@ cudaError_t compute_cell_list(unsigned int* d_cell_np,
                               const int3& origin_idx,
                               const Scalar3& grid_shift,
                               const Scalar3& global_lo,
+                              const Scalar le_offset,
                               const uint3& n_global_cell,
                               const Scalar cell_size,
                               const unsigned int cell_np_max,
                               const Index3D& cell_indexer,
                               const Index2D& cell_list_indexer,
                               const unsigned int N_mpcd,
-                              const unsigned int N_tot,
+                              const GPUPartition& gpu_partition,
                               const unsigned int block_size);
 
-//! Kernel driver to check if any embedded particles require migration
-cudaError_t cell_check_migrate_embed(unsigned int* d_migrate_flag,
-                                     const Scalar4* d_pos,
-                                     const unsigned int* d_group,
-                                     const BoxDim& box,
-                                     const unsigned int num_dim,
-                                     const unsigned int N,
-                                     const unsigned int block_size);
+//! Kernel driver to combine the cell lists built on each GPU
+cudaError_t combine_cell_lists(unsigned int* d_cell_np,
+                               unsigned int* d_cell_list,
+                               uint3* d_conditions,
+                               const unsigned int* d_cell_np_scratch,
+                               const unsigned int* d_cell_list_scratch,
+                               const uint3* d_conditions_scratch,
+                               const unsigned int cell_np_max,
+                               const Index2D& cell_list_indexer,
+                               const unsigned int Ncell,
+                               const unsigned int ngpu,
+                               const unsigned int block_size);
+
+//! Scans the number of particles per cell into the compact cell list offsets
+cudaError_t scan_cell_offsets(unsigned int* d_cell_offsets,
+                              void* d_tmp,
+                              size_t& tmp_bytes,
+                              const unsigned int* d_cell_np,
+                              const unsigned int Ncell);
+
+//! Kernel driver to fill the compact mpcd cell list
+cudaError_t fill_compact_cell_list(unsigned int* d_cell_list,
+                                   unsigned int* d_cell_np,
+                                   const unsigned int* d_cell_offsets,
+                                   const Scalar4* d_vel,
+                                   const unsigned int* d_embed_cell_ids,
+                                   const unsigned int Ncell,
+                                   const unsigned int N_mpcd,
+                                   const unsigned int N_tot,
+                                   const unsigned int block_size);
 
 //! Kernel drive to apply sorted order to MPCD particles in cell list
 cudaError_t cell_apply_sort(unsigned int* d_cell_list,
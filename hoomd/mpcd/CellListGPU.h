@@ -17,6 +17,8 @@
 
 #include "CellList.h"
 #include "hoomd/Autotuner.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/GlobalArray.h"
 
 namespace mpcd
     {
@@ -41,12 +43,12 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
 
         m_tuner_cell->setPeriod(period);
         m_tuner_cell->setEnabled(enable);
+        m_tuner_fill->setPeriod(period);
+        m_tuner_fill->setEnabled(enable);
+        m_tuner_combine->setPeriod(period);
+        m_tuner_combine->setEnabled(enable);
         m_tuner_sort->setPeriod(period);
         m_tuner_sort->setEnabled(enable);
-#ifdef ENABLE_MPI
-        m_tuner_embed_migrate->setPeriod(period);
-        m_tuner_embed_migrate->setEnabled(enable);
-#endif // ENABLE_MPI
         }
 
     protected:
@@ -58,18 +60,19 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
                       const GPUArray<unsigned int>& order,
                       const GPUArray<unsigned int>& rorder);
 
-#ifdef ENABLE_MPI
-    //! Determine if embedded particles require migration on the gpu
-    virtual bool needsEmbedMigrate(uint64_t timestep);
-    GPUFlags<unsigned int> m_migrate_flag; //!< Flag to signal migration is needed
-#endif                                     // ENABLE_MPI
-
     private:
-    std::unique_ptr<Autotuner> m_tuner_cell; //!< Autotuner for the cell list calculation
-    std::unique_ptr<Autotuner> m_tuner_sort; //!< Autotuner for sorting the cell list
-#ifdef ENABLE_MPI
-    std::unique_ptr<Autotuner> m_tuner_embed_migrate; //!< Autotuner for checking embedded migration
-#endif                                                // ENABLE_MPI
+    std::unique_ptr<Autotuner> m_tuner_cell;    //!< Autotuner for the cell list calculation
+    std::unique_ptr<Autotuner> m_tuner_fill;    //!< Autotuner for filling the compact cell list
+    std::unique_ptr<Autotuner> m_tuner_combine; //!< Autotuner for combining the GPU cell lists
+    std::unique_ptr<Autotuner> m_tuner_sort;    //!< Autotuner for sorting the cell list
+
+    GPUPartition m_gpu_partition;                  //!< Partition of the binned particles
+    GlobalArray<unsigned int> m_cell_np_scratch;   //!< Number of particles per cell on each GPU
+    GlobalArray<unsigned int> m_cell_list_scratch; //!< Cell list on each GPU
+    GlobalArray<uint3> m_conditions_scratch;       //!< Conditions flags on each GPU
+
+    //! Grow the per-GPU scratch arrays
+    void reallocateScratch(unsigned int ngpu);
     };
 
 namespace detail
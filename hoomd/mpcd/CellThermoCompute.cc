@@ -80,6 +80,59 @@ void mpcd::CellThermoCompute::compute(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * \returns True if the caller can accumulate the cell properties
+ *
+ * The cell properties are accumulated outside of compute() by a kernel that also fills the cell
+ * list, like when the particles are streamed. The caller sums the momentum and mass of the
+ * particles in each cell into the cell velocities and, if needsEnergy(), their kinetic energy into
+ * the first component of the cell energies. This is only supported when the cells are not
+ * communicated and there are no embedded particles.
+ *
+ * Call this method after mpcd::CellList::beginFusedBuild() so that the cell dimensions are current.
+ */
+bool mpcd::CellThermoCompute::beginFusedCompute()
+    {
+#ifdef ENABLE_MPI
+    if (m_use_mpi)
+        return false;
+#endif // ENABLE_MPI
+    if (m_cl->getEmbeddedGroup())
+        return false;
+
+    updateFlags();
+    const unsigned int ncells = m_cl->getNCells();
+    if (ncells != m_ncells_alloc)
+        {
+        reallocate(ncells);
+        }
+    return true;
+    }
+
+/*!
+ * \param timestep Timestep the cell properties were accumulated for
+ *
+ * The sums are normalized and the properties are marked as computed at \a timestep, so compute()
+ * does not recalculate them. Call this method only after mpcd::CellList::finishFusedBuild()
+ * succeeded.
+ */
+void mpcd::CellThermoCompute::finishFusedCompute(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "MPCD thermo");
+    finishFusedCellProperties();
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+
+    if (!m_callbacks.empty())
+        m_callbacks.emit(timestep);
+
+    m_first_compute = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+    m_needs_net_reduce = true;
+    }
+
 void mpcd::CellThermoCompute::computeCellProperties(uint64_t timestep)
     {
 /*
@@ -142,6 +195,7 @@ struct CellPropertySum
     /*!
      * \param cell_list_ Cell list
      * \param cell_np_ Number of particles per cell
+     * \param cell_offsets_ Offsets of the cells into a compact cell list, or NULL
      * \param cli_ Cell list indexer
      * \param vel_ MPCD particle velocities
      * \param mass_ MPCD mass
@@ -151,14 +205,15 @@ struct CellPropertySum
      */
     CellPropertySum(const unsigned int* cell_list_,
                     const unsigned int* cell_np_,
+                    const unsigned int* cell_offsets_,
                     const Index2D& cli_,
                     const Scalar4* vel_,
                     const Scalar mass_,
                     const Scalar4* embed_vel_,
                     const unsigned int* embed_idx_,
                     const unsigned int N_mpcd_)
-        : cell_list(cell_list_), cell_np(cell_np_), cli(cli_), vel(vel_), mass(mass_),
-          embed_vel(embed_vel_), embed_idx(embed_idx_), N_mpcd(N_mpcd_)
+        : cell_list(cell_list_), cell_np(cell_np_), cell_offsets(cell_offsets_), cli(cli_),
+          vel(vel_), mass(mass_), embed_vel(embed_vel_), embed_idx(embed_idx_), N_mpcd(N_mpcd_)
         {
         }
 
@@ -179,11 +234,12 @@ struct CellPropertySum
         momentum = make_double4(0.0, 0.0, 0.0, 0.0);
         ke = 0.0;
         np = cell_np[cell];
+        const unsigned int first = (cell_offsets) ? cell_offsets[cell] : cli(0, cell);
 
         for (unsigned int offset = 0; offset < np; ++offset)
             {
             // Load particle data
-            const unsigned int cur_p = cell_list[cli(offset, cell)];
+            const unsigned int cur_p = cell_list[first + offset];
             double3 vel_i;
             double mass_i;
             if (cur_p < N_mpcd)
@@ -211,9 +267,10 @@ struct CellPropertySum
             }
         }
 
-    const unsigned int* cell_list; //!< Cell list
-    const unsigned int* cell_np;   //!< Number of particles per cell
-    const Index2D cli;             //!< Cell list indexer
+    const unsigned int* cell_list;    //!< Cell list
+    const unsigned int* cell_np;      //!< Number of particles per cell
+    const unsigned int* cell_offsets; //!< Offsets of the cells into a compact cell list
+    const Index2D cli;                //!< Cell list indexer
 
     const Scalar4* vel;            //!< MPCD particle velocities
     const Scalar mass;             //!< MPCD particle mass
@@ -234,6 +291,9 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
     ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(),
+                                             access_location::host,
+                                             access_mode::read);
     const Index2D& cli = m_cl->getCellListIndexer();
 
     // MPCD particle data
@@ -267,6 +327,7 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
                                       access_mode::read);
     mpcd::detail::CellPropertySum summer(h_cell_list.data,
                                          h_cell_np.data,
+                                         (m_cl->isCompact()) ? h_cell_offsets.data : NULL,
                                          cli,
                                          h_vel.data,
                                          mpcd_mass,
@@ -343,6 +404,52 @@ void mpcd::CellThermoCompute::finishOuterCellProperties()
     }
 #endif // ENABLE_MPI
 
+void mpcd::CellThermoCompute::finishFusedCellProperties()
+    {
+    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::readwrite);
+    ArrayHandle<double3> h_cell_energy(m_cell_energy,
+                                       access_location::host,
+                                       access_mode::readwrite);
+
+    // Loop over all cells and normalize the summed quantities
+    const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
+    for (unsigned int cur_cell = 0; cur_cell < m_cl->getNCells(); ++cur_cell)
+        {
+        // average cell properties if the cell has mass
+        const double4 cell_vel = h_cell_vel.data[cur_cell];
+        double3 vel_cm = make_double3(cell_vel.x, cell_vel.y, cell_vel.z);
+        const double mass = cell_vel.w;
+
+        if (mass > 0.)
+            {
+            // average velocity is only defined when there is some mass in the cell
+            vel_cm.x /= mass;
+            vel_cm.y /= mass;
+            vel_cm.z /= mass;
+            }
+        h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+
+        if (need_energy)
+            {
+            const double ke = h_cell_energy.data[cur_cell].x;
+            double temp(0.0);
+            const unsigned int np = h_cell_np.data[cur_cell];
+            // temperature is only defined for 2 or more particles
+            if (np > 1)
+                {
+                const double ke_cm
+                    = 0.5 * mass
+                      * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
+                temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np - 1));
+                }
+            h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+            }
+        }
+    }
+
 void mpcd::CellThermoCompute::calcInnerCellProperties()
     {
     // Cell list
@@ -353,6 +460,9 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(),
+                                             access_location::host,
+                                             access_mode::read);
 
     // MPCD particle data
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
@@ -382,6 +492,7 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
                                        access_mode::readwrite);
     mpcd::detail::CellPropertySum summer(h_cell_list.data,
                                          h_cell_np.data,
+                                         (m_cl->isCompact()) ? h_cell_offsets.data : NULL,
                                          cli,
                                          h_vel.data,
                                          mpcd_mass,
@@ -41,6 +41,18 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
     //! Compute the cell thermodynamic properties
     void compute(uint64_t timestep);
 
+    //! Prepare to accumulate the cell properties outside of compute()
+    bool beginFusedCompute();
+
+    //! Finish accumulating the cell properties outside of compute()
+    void finishFusedCompute(uint64_t timestep);
+
+    //! Check if the cell energies are computed
+    bool needsEnergy() const
+        {
+        return m_flags[mpcd::detail::thermo_options::energy];
+        }
+
     //! Get the cell indexer for the attached cell list
     const Index3D& getCellIndexer() const
         {
@@ -169,6 +181,9 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
     //! Compute the net properties from the cell properties
     virtual void computeNetProperties();
 
+    //! Normalize the cell properties accumulated outside of compute()
+    virtual void finishFusedCellProperties();
+
     std::shared_ptr<mpcd::ParticleData> m_mpcd_pdata; //!< MPCD particle data
     std::shared_ptr<mpcd::CellList> m_cl;             //!< MPCD cell list
 #ifdef ENABLE_MPI
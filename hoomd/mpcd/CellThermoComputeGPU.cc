@@ -36,6 +36,8 @@ mpcd::CellThermoComputeGPU::CellThermoComputeGPU(std::shared_ptr<mpcd::SystemDat
         new Autotuner(valid_params, 5, 100000, "mpcd_cell_thermo_inner", m_exec_conf));
     m_stage_tuner.reset(
         new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_thermo_stage", m_exec_conf));
+    m_fused_end_tuner.reset(
+        new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_thermo_fused_end", m_exec_conf));
     }
 
 mpcd::CellThermoComputeGPU::~CellThermoComputeGPU() { }
@@ -57,6 +59,9 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
     ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
                                           access_location::device,
                                           access_mode::read);
+    ArrayHandle<unsigned int> d_cell_offsets(m_cl->getCellOffsets(),
+                                             access_location::device,
+                                             access_mode::read);
 
     ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
                                access_location::device,
@@ -76,6 +81,7 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
                                          d_cell_energy.data,
                                          d_cell_np.data,
                                          d_cell_list.data,
+                                         (m_cl->isCompact()) ? d_cell_offsets.data : NULL,
                                          m_cl->getCellListIndexer(),
                                          d_vel.data,
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
@@ -99,6 +105,7 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
                                          d_cell_energy.data,
                                          d_cell_np.data,
                                          d_cell_list.data,
+                                         (m_cl->isCompact()) ? d_cell_offsets.data : NULL,
                                          m_cl->getCellListIndexer(),
                                          d_vel.data,
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
@@ -154,6 +161,9 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
     ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
                                           access_location::device,
                                           access_mode::read);
+    ArrayHandle<unsigned int> d_cell_offsets(m_cl->getCellOffsets(),
+                                             access_location::device,
+                                             access_mode::read);
 
     ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
                                access_location::device,
@@ -200,6 +210,7 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
                                          d_cell_energy.data,
                                          d_cell_np.data,
                                          d_cell_list.data,
+                                         (m_cl->isCompact()) ? d_cell_offsets.data : NULL,
                                          m_cl->getCellListIndexer(),
                                          d_vel.data,
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
@@ -223,6 +234,7 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
                                          d_cell_energy.data,
                                          d_cell_np.data,
                                          d_cell_list.data,
+                                         (m_cl->isCompact()) ? d_cell_offsets.data : NULL,
                                          m_cl->getCellListIndexer(),
                                          d_vel.data,
                                          m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual(),
@@ -242,6 +254,29 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
         }
     }
 
+void mpcd::CellThermoComputeGPU::finishFusedCellProperties()
+    {
+    ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<double4> d_cell_vel(m_cell_vel, access_location::device, access_mode::readwrite);
+    ArrayHandle<double3> d_cell_energy(m_cell_energy,
+                                       access_location::device,
+                                       access_mode::readwrite);
+
+    m_fused_end_tuner->begin();
+    gpu::end_fused_cell_thermo(d_cell_vel.data,
+                               d_cell_energy.data,
+                               d_cell_np.data,
+                               m_cl->getNCells(),
+                               m_sysdef->getNDimensions(),
+                               m_flags[mpcd::detail::thermo_options::energy],
+                               m_fused_end_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_fused_end_tuner->end();
+    }
+
 void mpcd::CellThermoComputeGPU::computeNetProperties()
     {
     if (m_prof)
@@ -32,6 +32,7 @@ namespace kernel
  * \param d_cells Cell indexes to compute
  * \param d_cell_np Number of particles per cell
  * \param d_cell_list MPCD cell list
+ * \param d_cell_offsets Offsets of the cells into a compact cell list, or NULL
  * \param cli Indexer into the cell list
  * \param d_vel MPCD particle velocities
  * \param N_mpcd Number of MPCD particles
@@ -55,6 +56,7 @@ __global__ void begin_cell_thermo(double4* d_cell_vel,
                                   const unsigned int* d_cells,
                                   const unsigned int* d_cell_np,
                                   const unsigned int* d_cell_list,
+                                  const unsigned int* d_cell_offsets,
                                   const Index2D cli,
                                   const Scalar4* d_vel,
                                   const unsigned int N_mpcd,
@@ -73,10 +75,11 @@ __global__ void begin_cell_thermo(double4* d_cell_vel,
     double4 momentum = make_double4(0.0, 0.0, 0.0, 0.0);
     double ke(0.0);
 
+    const unsigned int first = (d_cell_offsets) ? d_cell_offsets[cell_id] : cli(0, cell_id);
     for (unsigned int offset = (idx % tpp); offset < np; offset += tpp)
         {
         // Load particle data
-        const unsigned int cur_p = d_cell_list[cli(offset, cell_id)];
+        const unsigned int cur_p = d_cell_list[first + offset];
         double3 vel_i;
         double mass_i;
         if (cur_p < N_mpcd)
@@ -184,6 +187,62 @@ __global__ void end_cell_thermo(double4* d_cell_vel,
         }
     }
 
+//! Finalizes cell properties that were accumulated while filling the cell list
+/*!
+ * \param d_cell_vel Cell momentum and masses (input), cell velocity and masses (output)
+ * \param d_cell_energy Cell kinetic energy (input), cell energy and temperature (output)
+ * \param d_cell_np Number of particles per cell
+ * \param Ncell Number of cells
+ * \param n_dimensions Number of dimensions in system
+ *
+ * \tparam need_energy If true, compute the cell-level energy properties.
+ *
+ * \b Implementation details:
+ * Using one thread per cell, the properties are averaged the same way as in end_cell_thermo.
+ * The number of particles in the cell is taken from the cell list because it is not accumulated.
+ */
+template<bool need_energy>
+__global__ void end_fused_cell_thermo(double4* d_cell_vel,
+                                      double3* d_cell_energy,
+                                      const unsigned int* d_cell_np,
+                                      const unsigned int Ncell,
+                                      const unsigned int n_dimensions)
+    {
+    // one thread per cell
+    unsigned int cell_id = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cell_id >= Ncell)
+        return;
+
+    // average cell properties if the cell has mass
+    const double4 cell_vel = d_cell_vel[cell_id];
+    double3 vel_cm = make_double3(cell_vel.x, cell_vel.y, cell_vel.z);
+    const double mass = cell_vel.w;
+
+    if (mass > 0.)
+        {
+        // average velocity is only defined when there is some mass in the cell
+        vel_cm.x /= mass;
+        vel_cm.y /= mass;
+        vel_cm.z /= mass;
+        }
+    d_cell_vel[cell_id] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+
+    if (need_energy)
+        {
+        const double ke = d_cell_energy[cell_id].x;
+        double temp(0.0);
+        const unsigned int np = d_cell_np[cell_id];
+        // temperature is only defined for 2 or more particles
+        if (np > 1)
+            {
+            const double ke_cm
+                = 0.5 * mass * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
+            temp = 2. * (ke - ke_cm) / (n_dimensions * (np - 1));
+            }
+        d_cell_energy[cell_id] = make_double3(ke, temp, __int_as_double(np));
+        }
+    }
+
 //! Computes the cell thermo for inner cells
 /*!
  * \param d_cell_vel Velocity and mass per cell (output)
@@ -193,6 +252,7 @@ __global__ void end_cell_thermo(double4* d_cell_vel,
  * \param offset Offset of \a inner_ci from \a ci
  * \param d_cell_np Number of particles per cell
  * \param d_cell_list MPCD cell list
+ * \param d_cell_offsets Offsets of the cells into a compact cell list, or NULL
  * \param cli Indexer into the cell list
  * \param d_vel MPCD particle velocities
  * \param N_mpcd Number of MPCD particles
@@ -221,6 +281,7 @@ __global__ void inner_cell_thermo(double4* d_cell_vel,
                                   const uint3 offset,
                                   const unsigned int* d_cell_np,
                                   const unsigned int* d_cell_list,
+                                  const unsigned int* d_cell_offsets,
                                   const Index2D cli,
                                   const Scalar4* d_vel,
                                   const unsigned int N_mpcd,
@@ -246,10 +307,11 @@ __global__ void inner_cell_thermo(double4* d_cell_vel,
     double4 momentum = make_double4(0.0, 0.0, 0.0, 0.0);
     double ke(0.0);
 
+    const unsigned int first = (d_cell_offsets) ? d_cell_offsets[cell_id] : cli(0, cell_id);
     for (unsigned int offset = (idx % tpp); offset < np; offset += tpp)
         {
         // Load particle data
-        const unsigned int cur_p = d_cell_list[cli(offset, cell_id)];
+        const unsigned int cur_p = d_cell_list[first + offset];
         double3 vel_i;
         double mass_i;
         if (cur_p < N_mpcd)
@@ -425,6 +487,7 @@ inline void launch_begin_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                            d_cells,
                                            args.cell_np,
                                            args.cell_list,
+                                           args.cell_offsets,
                                            args.cli,
                                            args.vel,
                                            args.N_mpcd,
@@ -450,6 +513,7 @@ inline void launch_begin_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                            d_cells,
                                            args.cell_np,
                                            args.cell_list,
+                                           args.cell_offsets,
                                            args.cli,
                                            args.vel,
                                            args.N_mpcd,
@@ -550,6 +614,59 @@ cudaError_t end_cell_thermo(double4* d_cell_vel,
     return cudaSuccess;
     }
 
+/*!
+ * \param d_cell_vel Cell momentum and masses (input), cell velocity and masses (output)
+ * \param d_cell_energy Cell kinetic energy (input), cell energy and temperature (output)
+ * \param d_cell_np Number of particles per cell
+ * \param Ncell Number of cells
+ * \param n_dimensions Number of dimensions in system
+ * \param need_energy If true, compute the cell-level energy properties
+ * \param block_size Number of threads per block
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::kernel::end_fused_cell_thermo
+ */
+cudaError_t end_fused_cell_thermo(double4* d_cell_vel,
+                                  double3* d_cell_energy,
+                                  const unsigned int* d_cell_np,
+                                  const unsigned int Ncell,
+                                  const unsigned int n_dimensions,
+                                  const bool need_energy,
+                                  const unsigned int block_size)
+    {
+    if (Ncell == 0)
+        return cudaSuccess;
+
+    if (need_energy)
+        {
+        unsigned int max_block_size_energy;
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::end_fused_cell_thermo<true>);
+        max_block_size_energy = attr.maxThreadsPerBlock;
+
+        unsigned int run_block_size = min(block_size, max_block_size_energy);
+        dim3 grid(Ncell / run_block_size + 1);
+        mpcd::gpu::kernel::end_fused_cell_thermo<true>
+            <<<grid, run_block_size>>>(d_cell_vel, d_cell_energy, d_cell_np, Ncell, n_dimensions);
+        }
+    else
+        {
+        unsigned int max_block_size_noenergy;
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr,
+                              (const void*)mpcd::gpu::kernel::end_fused_cell_thermo<false>);
+        max_block_size_noenergy = attr.maxThreadsPerBlock;
+
+        unsigned int run_block_size = min(block_size, max_block_size_noenergy);
+        dim3 grid(Ncell / run_block_size + 1);
+        mpcd::gpu::kernel::end_fused_cell_thermo<false>
+            <<<grid, run_block_size>>>(d_cell_vel, d_cell_energy, d_cell_np, Ncell, n_dimensions);
+        }
+
+    return cudaSuccess;
+    }
+
 //! Templated launcher for multiple threads-per-cell kernel for inner cells
 /*
  * \param args Common arguments to thermo kernels
@@ -598,6 +715,7 @@ inline void launch_inner_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                            offset,
                                            args.cell_np,
                                            args.cell_list,
+                                           args.cell_offsets,
                                            args.cli,
                                            args.vel,
                                            args.N_mpcd,
@@ -625,6 +743,7 @@ inline void launch_inner_cell_thermo(const mpcd::detail::thermo_args_t& args,
                                            offset,
                                            args.cell_np,
                                            args.cell_list,
+                                           args.cell_offsets,
                                            args.cli,
                                            args.vel,
                                            args.N_mpcd,
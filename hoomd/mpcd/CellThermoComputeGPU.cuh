@@ -57,6 +57,7 @@ struct thermo_args_t
                   double3* cell_energy_,
                   const unsigned int* cell_np_,
                   const unsigned int* cell_list_,
+                  const unsigned int* cell_offsets_,
                   const Index2D& cli_,
                   const Scalar4* vel_,
                   const unsigned int N_mpcd_,
@@ -65,23 +66,24 @@ struct thermo_args_t
                   const unsigned int* embed_idx_,
                   bool need_energy_)
         : cell_vel(cell_vel_), cell_energy(cell_energy_), cell_np(cell_np_), cell_list(cell_list_),
-          cli(cli_), vel(vel_), N_mpcd(N_mpcd_), mass(mass_), embed_vel(embed_vel_),
-          embed_idx(embed_idx_), need_energy(need_energy_)
+          cell_offsets(cell_offsets_), cli(cli_), vel(vel_), N_mpcd(N_mpcd_), mass(mass_),
+          embed_vel(embed_vel_), embed_idx(embed_idx_), need_energy(need_energy_)
         {
         }
 
     double4* cell_vel;    //!< Cell velocities (output)
     double3* cell_energy; //!< Cell energies (output)
 
-    const unsigned int* cell_np;   //!< Number of particles per cell
-    const unsigned int* cell_list; //!< MPCD cell list
-    const Index2D cli;             //!< MPCD cell list indexer
-    const Scalar4* vel;            //!< MPCD particle velocities
-    const unsigned int N_mpcd;     //!< Number of MPCD particles
-    const Scalar mass;             //!< MPCD particle mass
-    const Scalar4* embed_vel;      //!< Embedded particle velocities
-    const unsigned int* embed_idx; //!< Embedded particle indexes
-    const bool need_energy;        //!< Flag if energy calculations are required
+    const unsigned int* cell_np;      //!< Number of particles per cell
+    const unsigned int* cell_list;    //!< MPCD cell list
+    const unsigned int* cell_offsets; //!< Offsets of the cells into a compact cell list, or NULL
+    const Index2D cli;                //!< MPCD cell list indexer
+    const Scalar4* vel;               //!< MPCD particle velocities
+    const unsigned int N_mpcd;        //!< Number of MPCD particles
+    const Scalar mass;                //!< MPCD particle mass
+    const Scalar4* embed_vel;         //!< Embedded particle velocities
+    const unsigned int* embed_idx;    //!< Embedded particle indexes
+    const bool need_energy;           //!< Flag if energy calculations are required
     };
 #undef HOSTDEVICE
     } // namespace detail
@@ -104,6 +106,15 @@ cudaError_t end_cell_thermo(double4* d_cell_vel,
                             const bool need_energy,
                             const unsigned int block_size);
 
+//! Kernel driver to finalize cell properties accumulated while filling the cell list
+cudaError_t end_fused_cell_thermo(double4* d_cell_vel,
+                                  double3* d_cell_energy,
+                                  const unsigned int* d_cell_np,
+                                  const unsigned int Ncell,
+                                  const unsigned int n_dimensions,
+                                  const bool need_energy,
+                                  const unsigned int block_size);
+
 //! Kernel driver to perform cell thermo compute for inner cells
 cudaError_t inner_cell_thermo(const mpcd::detail::thermo_args_t& args,
                               const Index3D& ci,
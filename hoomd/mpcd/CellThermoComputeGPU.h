@@ -55,6 +55,9 @@ class PYBIND11_EXPORT CellThermoComputeGPU : public mpcd::CellThermoCompute
 
         m_stage_tuner->setEnabled(enable);
         m_stage_tuner->setPeriod(period);
+
+        m_fused_end_tuner->setEnabled(enable);
+        m_fused_end_tuner->setPeriod(period);
         }
 
     protected:
@@ -72,11 +75,15 @@ class PYBIND11_EXPORT CellThermoComputeGPU : public mpcd::CellThermoCompute
     //! Compute the net properties from the cell properties
     virtual void computeNetProperties();
 
+    //! Normalize the cell properties accumulated outside of compute() on the GPU
+    virtual void finishFusedCellProperties();
+
     private:
-    std::unique_ptr<Autotuner> m_begin_tuner; //!< Tuner for cell begin kernel
-    std::unique_ptr<Autotuner> m_end_tuner;   //!< Tuner for cell end kernel
-    std::unique_ptr<Autotuner> m_inner_tuner; //!< Tuner for inner cell compute kernel
-    std::unique_ptr<Autotuner> m_stage_tuner; //!< Tuner for staging net property compute
+    std::unique_ptr<Autotuner> m_begin_tuner;     //!< Tuner for cell begin kernel
+    std::unique_ptr<Autotuner> m_end_tuner;       //!< Tuner for cell end kernel
+    std::unique_ptr<Autotuner> m_inner_tuner;     //!< Tuner for inner cell compute kernel
+    std::unique_ptr<Autotuner> m_stage_tuner;     //!< Tuner for staging net property compute
+    std::unique_ptr<Autotuner> m_fused_end_tuner; //!< Tuner for fused cell end kernel
 
     GPUVector<mpcd::detail::cell_thermo_element>
         m_tmp_thermo; //!< Temporary array for holding cell data
@@ -15,6 +15,7 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "CellThermoCompute.h"
 #include "SystemData.h"
 #include <pybind11/pybind11.h>
 
@@ -43,6 +44,20 @@ class PYBIND11_EXPORT CollisionMethod
     //! Peek if a collision will occur on this timestep
     virtual bool peekCollide(uint64_t timestep) const;
 
+    //! Get the cell properties that the collision rule needs first
+    /*!
+     * \returns The cell thermo compute that rule() calculates before anything else, or a null
+     *          pointer if the collision rule needs more than the cell properties.
+     *
+     * The streaming method can accumulate these cell properties while streaming the particles
+     * before the collision. Derived classes should override this when rule() only reads the
+     * cell velocities and energies before changing the particle velocities.
+     */
+    virtual std::shared_ptr<mpcd::CellThermoCompute> getFusedThermo() const
+        {
+        return std::shared_ptr<mpcd::CellThermoCompute>();
+        }
+
     //! Sets the profiler for the integration method to use
     void setProfiler(std::shared_ptr<Profiler> prof)
         {
@@ -32,11 +32,13 @@ namespace mpcd
  * boundary and its velocity is updated according to the boundary conditions. Streaming then
  * continues until the timestep is completed.
  *
- * To facilitate this, every Geometry must supply three methods:
+ * To facilitate this, every Geometry must supply four methods:
  *  1. detectCollision(): Determines when and where a collision occurs. If one does, this method
  * moves the particle back, reflects its velocity, and gives the time still remaining to integrate.
- *  2. isOutside(): Determines whether a particles lies outside the Geometry.
- *  3. validateBox(): Checks whether the global simulation box is consistent with the streaming
+ *  2. cannotCollide(): Determines whether a particle is too far from the boundary to collide with
+ * it in the streaming interval. These particles are streamed without calling detectCollision().
+ *  3. isOutside(): Determines whether a particles lies outside the Geometry.
+ *  4. validateBox(): Checks whether the global simulation box is consistent with the streaming
  * geometry.
  *
  */
@@ -133,14 +135,22 @@ template<class Geometry> void ConfinedStreamingMethod<Geometry>::stream(uint64_t
             vel += Scalar(0.5) * m_mpcd_dt * field->evaluate(pos) / mass;
             }
 
-        // propagate the particle to its new position ballistically
-        Scalar dt_remain = m_mpcd_dt;
-        bool collide = true;
-        do
+        // propagate the particle to its new position ballistically, resolving collisions only if
+        // the particle can reach the boundary
+        if (m_geom->cannotCollide(pos, vel, m_mpcd_dt))
             {
-            pos += dt_remain * vel;
-            collide = m_geom->detectCollision(pos, vel, dt_remain);
-            } while (dt_remain > 0 && collide);
+            pos += m_mpcd_dt * vel;
+            }
+        else
+            {
+            Scalar dt_remain = m_mpcd_dt;
+            bool collide = true;
+            do
+                {
+                pos += dt_remain * vel;
+                collide = m_geom->detectCollision(pos, vel, dt_remain);
+                } while (dt_remain > 0 && collide);
+            }
         // finalize velocity update
         if (field)
             {
@@ -26,17 +26,38 @@ namespace gpu
 //! Template instantiation of bulk geometry streaming
 template cudaError_t __attribute__((visibility("default")))
 confined_stream<mpcd::detail::BulkGeometry>(const stream_args_t& args,
+                                            const GPUPartition& gpu_partition,
                                             const mpcd::detail::BulkGeometry& geom);
 
 //! Template instantiation of slit geometry streaming
 template cudaError_t __attribute__((visibility("default")))
 confined_stream<mpcd::detail::SlitGeometry>(const stream_args_t& args,
+                                            const GPUPartition& gpu_partition,
                                             const mpcd::detail::SlitGeometry& geom);
 
 //! Template instantiation of slit geometry streaming
 template cudaError_t
 confined_stream<mpcd::detail::SlitPoreGeometry>(const stream_args_t& args,
+                                                const GPUPartition& gpu_partition,
                                                 const mpcd::detail::SlitPoreGeometry& geom);
 
+//! Template instantiation of bulk geometry streaming with binning
+template cudaError_t __attribute__((visibility("default")))
+confined_stream_bin<mpcd::detail::BulkGeometry>(const stream_args_t& args,
+                                                const stream_bin_args_t& bin_args,
+                                                const mpcd::detail::BulkGeometry& geom);
+
+//! Template instantiation of slit geometry streaming with binning
+template cudaError_t __attribute__((visibility("default")))
+confined_stream_bin<mpcd::detail::SlitGeometry>(const stream_args_t& args,
+                                                const stream_bin_args_t& bin_args,
+                                                const mpcd::detail::SlitGeometry& geom);
+
+//! Template instantiation of slit pore geometry streaming with binning
+template cudaError_t
+confined_stream_bin<mpcd::detail::SlitPoreGeometry>(const stream_args_t& args,
+                                                    const stream_bin_args_t& bin_args,
+                                                    const mpcd::detail::SlitPoreGeometry& geom);
+
     } // end namespace gpu
     } // end namespace mpcd
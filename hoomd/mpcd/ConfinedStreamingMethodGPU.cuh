@@ -14,7 +14,9 @@
 #include "ExternalField.h"
 #include "ParticleDataUtilities.h"
 #include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
 
 namespace mpcd
     {
@@ -47,9 +49,62 @@ struct stream_args_t
     const unsigned int block_size;    //!< Number of threads per block
     };
 
+//! Arguments to fill the cell list and accumulate the cell properties while streaming
+struct stream_bin_args_t
+    {
+    //! Constructor
+    stream_bin_args_t(unsigned int* _d_cell_np,
+                      unsigned int* _d_cell_list,
+                      uint3* _d_conditions,
+                      double4* _d_cell_vel,
+                      double3* _d_cell_energy,
+                      const uchar3 _periodic,
+                      const int3 _origin_idx,
+                      const Scalar3 _grid_shift,
+                      const Scalar3 _global_lo,
+                      const uint3 _n_global_cell,
+                      const Scalar _cell_size,
+                      const unsigned int _cell_np_max,
+                      const Index3D& _cell_indexer,
+                      const Index2D& _cell_list_indexer,
+                      const bool _need_energy)
+        : d_cell_np(_d_cell_np), d_cell_list(_d_cell_list), d_conditions(_d_conditions),
+          d_cell_vel(_d_cell_vel), d_cell_energy(_d_cell_energy), periodic(_periodic),
+          origin_idx(_origin_idx), grid_shift(_grid_shift), global_lo(_global_lo),
+          n_global_cell(_n_global_cell), cell_size(_cell_size), cell_np_max(_cell_np_max),
+          cell_indexer(_cell_indexer), cell_list_indexer(_cell_list_indexer),
+          need_energy(_need_energy)
+        {
+        }
+
+    unsigned int* d_cell_np;          //!< Number of particles per cell
+    unsigned int* d_cell_list;        //!< Cell list of particles
+    uint3* d_conditions;              //!< Conditions flags for error reporting
+    double4* d_cell_vel;              //!< Momentum and mass per cell
+    double3* d_cell_energy;           //!< Kinetic energy per cell
+    const uchar3 periodic;            //!< Flags if local simulation is periodic
+    const int3 origin_idx;            //!< Global origin index for the local box
+    const Scalar3 grid_shift;         //!< Random grid shift vector
+    const Scalar3 global_lo;          //!< Lower bound of global orthorhombic simulation box
+    const uint3 n_global_cell;        //!< Global dimensions of the cell list
+    const Scalar cell_size;           //!< Cell width
+    const unsigned int cell_np_max;   //!< Maximum number of particles per cell
+    const Index3D& cell_indexer;      //!< 3D indexer for cell id
+    const Index2D& cell_list_indexer; //!< 2D indexer for particle position in cell
+    const bool need_energy;           //!< If true, accumulate the kinetic energy
+    };
+
 //! Kernel driver to stream particles ballistically
 template<class Geometry>
-cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom);
+cudaError_t confined_stream(const stream_args_t& args,
+                            const GPUPartition& gpu_partition,
+                            const Geometry& geom);
+
+//! Kernel driver to stream particles, fill the cell list, and accumulate the cell properties
+template<class Geometry>
+cudaError_t confined_stream_bin(const stream_args_t& args,
+                                const stream_bin_args_t& bin_args,
+                                const Geometry& geom);
 
 #ifdef __HIPCC__
 namespace kernel
@@ -62,7 +117,8 @@ namespace kernel
  * \param box Simulation box
  * \param dt Timestep to stream
  * \param field Applied external field
- * \param N Number of particles
+ * \param N Number of particles to stream
+ * \param offset Index of the first particle to stream
  * \param geom Confined geometry
  *
  * \tparam Geometry type of the confined geometry \a geom
@@ -87,12 +143,14 @@ __global__ void confined_stream(Scalar4* d_pos,
                                 const BoxDim box,
                                 const Scalar dt,
                                 const unsigned int N,
+                                const unsigned int offset,
                                 const Geometry geom)
     {
     // one thread per particle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (idx >= N)
         return;
+    idx += offset;
 
     const Scalar4 postype = d_pos[idx];
     Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -106,14 +164,22 @@ __global__ void confined_stream(Scalar4* d_pos,
         vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
         }
 
-    // propagate the particle to its new position ballistically
-    Scalar dt_remain = dt;
-    bool collide = true;
-    do
+    // propagate the particle to its new position ballistically, resolving collisions only if the
+    // particle can reach the boundary
+    if (geom.cannotCollide(pos, vel, dt))
+        {
+        pos += dt * vel;
+        }
+    else
         {
-        pos += dt_remain * vel;
-        collide = geom.detectCollision(pos, vel, dt_remain);
-        } while (dt_remain > 0 && collide);
+        Scalar dt_remain = dt;
+        bool collide = true;
+        do
+            {
+            pos += dt_remain * vel;
+            collide = geom.detectCollision(pos, vel, dt_remain);
+            } while (dt_remain > 0 && collide);
+        }
     // finalize velocity update
     if (field)
         {
@@ -128,34 +194,328 @@ __global__ void confined_stream(Scalar4* d_pos,
     d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
     }
 
+//! Kernel to stream particles, fill the cell list, and accumulate the cell properties
+/*!
+ * \param d_pos Particle positions
+ * \param d_vel Particle velocities
+ * \param d_cell_np Number of particles per cell
+ * \param d_cell_list 2D array of MPCD particles in each cell
+ * \param d_conditions Conditions flags for error reporting
+ * \param d_cell_vel Momentum and mass per cell
+ * \param d_cell_energy Kinetic energy per cell
+ * \param mass Particle mass
+ * \param field Applied external field
+ * \param box Simulation box
+ * \param dt Timestep to stream
+ * \param periodic Flags if local simulation is periodic
+ * \param origin_idx Global origin index for the local box
+ * \param grid_shift Random grid shift vector
+ * \param global_lo Lower bound of global orthorhombic simulation box
+ * \param n_global_cell Global dimensions of the cell list
+ * \param cell_size Cell width
+ * \param cell_np_max Maximum number of particles per cell
+ * \param cell_indexer 3D indexer for cell id
+ * \param cell_list_indexer 2D indexer for particle position in cell
+ * \param N Number of particles
+ * \param geom Confined geometry
+ *
+ * \tparam Geometry type of the confined geometry \a geom
+ * \tparam need_energy If true, accumulate the kinetic energy of the cell
+ *
+ * \b Implementation
+ * Using one thread per particle, the particle is streamed the same way as in confined_stream.
+ * The streamed particle is then binned the same way as in mpcd::gpu::kernel::compute_cell_list,
+ * and its momentum, mass, and optionally kinetic energy are atomically added to its cell. The
+ * cell properties still need to be normalized by the caller.
+ */
+template<class Geometry, bool need_energy>
+__global__ void confined_stream_bin(Scalar4* d_pos,
+                                    Scalar4* d_vel,
+                                    unsigned int* d_cell_np,
+                                    unsigned int* d_cell_list,
+                                    uint3* d_conditions,
+                                    double4* d_cell_vel,
+                                    double3* d_cell_energy,
+                                    const Scalar mass,
+                                    const mpcd::ExternalField* field,
+                                    const BoxDim box,
+                                    const Scalar dt,
+                                    const uchar3 periodic,
+                                    const int3 origin_idx,
+                                    const Scalar3 grid_shift,
+                                    const Scalar3 global_lo,
+                                    const uint3 n_global_cell,
+                                    const Scalar cell_size,
+                                    const unsigned int cell_np_max,
+                                    const Index3D cell_indexer,
+                                    const Index2D cell_list_indexer,
+                                    const unsigned int N,
+                                    const Geometry geom)
+    {
+    // one thread per particle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const Scalar4 postype = d_pos[idx];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    const unsigned int type = __scalar_as_int(postype.w);
+
+    const Scalar4 vel_cell = d_vel[idx];
+    Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+    // estimate next velocity based on current acceleration
+    if (field)
+        {
+        vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
+        }
+
+    // propagate the particle to its new position ballistically, resolving collisions only if the
+    // particle can reach the boundary
+    if (geom.cannotCollide(pos, vel, dt))
+        {
+        pos += dt * vel;
+        }
+    else
+        {
+        Scalar dt_remain = dt;
+        bool collide = true;
+        do
+            {
+            pos += dt_remain * vel;
+            collide = geom.detectCollision(pos, vel, dt_remain);
+            } while (dt_remain > 0 && collide);
+        }
+    // finalize velocity update
+    if (field)
+        {
+        vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
+        }
+
+    // wrap and update the position
+    int3 image = make_int3(0, 0, 0);
+    box.wrap(pos, image);
+    d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+
+    if (isnan(pos.x) || isnan(pos.y) || isnan(pos.z))
+        {
+        d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+        (*d_conditions).y = idx + 1;
+        return;
+        }
+
+    // bin particle with grid shift assuming orthorhombic box (already validated)
+    const Scalar3 delta = (pos - grid_shift) - global_lo;
+    int3 global_bin = make_int3(std::floor(delta.x / cell_size),
+                                std::floor(delta.y / cell_size),
+                                std::floor(delta.z / cell_size));
+
+    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+    if (periodic.x)
+        {
+        if (global_bin.x == (int)n_global_cell.x)
+            global_bin.x = 0;
+        else if (global_bin.x == -1)
+            global_bin.x = n_global_cell.x - 1;
+        }
+    if (periodic.y)
+        {
+        if (global_bin.y == (int)n_global_cell.y)
+            global_bin.y = 0;
+        else if (global_bin.y == -1)
+            global_bin.y = n_global_cell.y - 1;
+        }
+    if (periodic.z)
+        {
+        if (global_bin.z == (int)n_global_cell.z)
+            global_bin.z = 0;
+        else if (global_bin.z == -1)
+            global_bin.z = n_global_cell.z - 1;
+        }
+
+    // compute the local cell
+    int3 bin = make_int3(global_bin.x - origin_idx.x,
+                         global_bin.y - origin_idx.y,
+                         global_bin.z - origin_idx.z);
+
+    // validate and make sure no particles blew out of the box
+    if ((bin.x < 0 || bin.x >= (int)cell_indexer.getW())
+        || (bin.y < 0 || bin.y >= (int)cell_indexer.getH())
+        || (bin.z < 0 || bin.z >= (int)cell_indexer.getD()))
+        {
+        d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+        (*d_conditions).z = idx + 1;
+        return;
+        }
+
+    const unsigned int bin_idx = cell_indexer(bin.x, bin.y, bin.z);
+    const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
+    if (offset < cell_np_max)
+        {
+        d_cell_list[cell_list_indexer(offset, bin_idx)] = idx;
+        }
+    else
+        {
+        // overflow
+        atomicMax(&(*d_conditions).x, offset + 1);
+        }
+
+    // stash the current particle bin into the velocity array
+    d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(bin_idx));
+
+    // accumulate the cell momentum, mass, and kinetic energy
+    const double3 vel_i = make_double3(vel.x, vel.y, vel.z);
+    double4* cell_vel = d_cell_vel + bin_idx;
+    atomicAdd(&(cell_vel->x), mass * vel_i.x);
+    atomicAdd(&(cell_vel->y), mass * vel_i.y);
+    atomicAdd(&(cell_vel->z), mass * vel_i.z);
+    atomicAdd(&(cell_vel->w), (double)mass);
+    if (need_energy)
+        {
+        atomicAdd(&(d_cell_energy[bin_idx].x),
+                  0.5 * mass * (vel_i.x * vel_i.x + vel_i.y * vel_i.y + vel_i.z * vel_i.z));
+        }
+    }
+
     } // end namespace kernel
 
 /*!
  * \param args Common arguments for a streaming kernel
+ * \param gpu_partition Partition of the particles between the GPUs
  * \param geom Confined geometry
  *
  * \tparam Geometry type of the confined geometry \a geom
  *
+ * The particles in each range of \a gpu_partition are streamed on their GPU. The number of
+ * particles in \a args is not used.
+ *
  * \sa mpcd::gpu::kernel::confined_stream
  */
 template<class Geometry>
-cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom)
+cudaError_t confined_stream(const stream_args_t& args,
+                            const GPUPartition& gpu_partition,
+                            const Geometry& geom)
     {
     unsigned int max_block_size;
     cudaFuncAttributes attr;
     cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::confined_stream<Geometry>);
     max_block_size = attr.maxThreadsPerBlock;
 
+    unsigned int run_block_size = min(args.block_size, max_block_size);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+        const unsigned int nwork = range.second - range.first;
+
+        dim3 grid(nwork / run_block_size + 1);
+        mpcd::gpu::kernel::confined_stream<Geometry><<<grid, run_block_size>>>(args.d_pos,
+                                                                               args.d_vel,
+                                                                               args.mass,
+                                                                               args.field,
+                                                                               args.box,
+                                                                               args.dt,
+                                                                               nwork,
+                                                                               range.first,
+                                                                               geom);
+        }
+
+    return cudaSuccess;
+    }
+
+/*!
+ * \param args Common arguments for a streaming kernel
+ * \param bin_args Arguments to fill the cell list and accumulate the cell properties
+ * \param geom Confined geometry
+ *
+ * \tparam Geometry type of the confined geometry \a geom
+ *
+ * \sa mpcd::gpu::kernel::confined_stream_bin
+ */
+template<class Geometry>
+cudaError_t confined_stream_bin(const stream_args_t& args,
+                                const stream_bin_args_t& bin_args,
+                                const Geometry& geom)
+    {
+    // zero the number of particles and the sums in each cell
+    const unsigned int Ncell = bin_args.cell_indexer.getNumElements();
+    cudaError_t error = cudaMemset(bin_args.d_cell_np, 0, sizeof(unsigned int) * Ncell);
+    if (error != cudaSuccess)
+        return error;
+    error = cudaMemset(bin_args.d_cell_vel, 0, sizeof(double4) * Ncell);
+    if (error != cudaSuccess)
+        return error;
+    if (bin_args.need_energy)
+        {
+        error = cudaMemset(bin_args.d_cell_energy, 0, sizeof(double3) * Ncell);
+        if (error != cudaSuccess)
+            return error;
+        }
+
+    unsigned int max_block_size;
+    cudaFuncAttributes attr;
+    if (bin_args.need_energy)
+        cudaFuncGetAttributes(&attr,
+                              (const void*)mpcd::gpu::kernel::confined_stream_bin<Geometry, true>);
+    else
+        cudaFuncGetAttributes(&attr,
+                              (const void*)mpcd::gpu::kernel::confined_stream_bin<Geometry, false>);
+    max_block_size = attr.maxThreadsPerBlock;
+
     unsigned int run_block_size = min(args.block_size, max_block_size);
     dim3 grid(args.N / run_block_size + 1);
-    mpcd::gpu::kernel::confined_stream<Geometry><<<grid, run_block_size>>>(args.d_pos,
-                                                                           args.d_vel,
-                                                                           args.mass,
-                                                                           args.field,
-                                                                           args.box,
-                                                                           args.dt,
-                                                                           args.N,
-                                                                           geom);
+    if (bin_args.need_energy)
+        {
+        mpcd::gpu::kernel::confined_stream_bin<Geometry, true>
+            <<<grid, run_block_size>>>(args.d_pos,
+                                       args.d_vel,
+                                       bin_args.d_cell_np,
+                                       bin_args.d_cell_list,
+                                       bin_args.d_conditions,
+                                       bin_args.d_cell_vel,
+                                       bin_args.d_cell_energy,
+                                       args.mass,
+                                       args.field,
+                                       args.box,
+                                       args.dt,
+                                       bin_args.periodic,
+                                       bin_args.origin_idx,
+                                       bin_args.grid_shift,
+                                       bin_args.global_lo,
+                                       bin_args.n_global_cell,
+                                       bin_args.cell_size,
+                                       bin_args.cell_np_max,
+                                       bin_args.cell_indexer,
+                                       bin_args.cell_list_indexer,
+                                       args.N,
+                                       geom);
+        }
+    else
+        {
+        mpcd::gpu::kernel::confined_stream_bin<Geometry, false>
+            <<<grid, run_block_size>>>(args.d_pos,
+                                       args.d_vel,
+                                       bin_args.d_cell_np,
+                                       bin_args.d_cell_list,
+                                       bin_args.d_conditions,
+                                       bin_args.d_cell_vel,
+                                       bin_args.d_cell_energy,
+                                       args.mass,
+                                       args.field,
+                                       args.box,
+                                       args.dt,
+                                       bin_args.periodic,
+                                       bin_args.origin_idx,
+                                       bin_args.grid_shift,
+                                       bin_args.global_lo,
+                                       bin_args.n_global_cell,
+                                       bin_args.cell_size,
+                                       bin_args.cell_np_max,
+                                       bin_args.cell_indexer,
+                                       bin_args.cell_list_indexer,
+                                       args.N,
+                                       geom);
+        }
 
     return cudaSuccess;
     }
@@ -46,11 +46,18 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
         : mpcd::ConfinedStreamingMethod<Geometry>(sysdata, cur_timestep, period, phase, geom)
         {
         m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_stream", this->m_exec_conf));
+        m_tuner_bin.reset(
+            new Autotuner(32, 1024, 32, 5, 100000, "mpcd_stream_bin", this->m_exec_conf));
         }
 
     //! Implementation of the streaming rule
     virtual void stream(uint64_t timestep);
 
+    //! Stream the particles and fill the cells for the next collision
+    virtual bool streamAndBin(uint64_t timestep,
+                              uint64_t collide_timestep,
+                              std::shared_ptr<mpcd::CellThermoCompute> thermo);
+
     //! Set autotuner parameters
     /*!
      * \param enable Enable/disable autotuning
@@ -63,10 +70,13 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
         ConfinedStreamingMethod<Geometry>::setAutotunerParams(enable, period);
         m_tuner->setEnabled(enable);
         m_tuner->setPeriod(period);
+        m_tuner_bin->setEnabled(enable);
+        m_tuner_bin->setPeriod(period);
         }
 
     protected:
     std::unique_ptr<Autotuner> m_tuner;
+    std::unique_ptr<Autotuner> m_tuner_bin;
     };
 
 /*!
@@ -104,7 +114,22 @@ template<class Geometry> void ConfinedStreamingMethodGPU<Geometry>::stream(uint6
                                   m_tuner->getParam());
 
     m_tuner->begin();
-    mpcd::gpu::confined_stream<Geometry>(args, *(this->m_geom));
+    if (this->m_field)
+        {
+        // the external field is constructed in the memory of the first GPU, so only it can stream
+        GPUPartition gpu_partition(
+            std::vector<unsigned int>(1, this->m_exec_conf->getGPUIds()[0]));
+        gpu_partition.setN(this->m_mpcd_pdata->getN());
+        mpcd::gpu::confined_stream<Geometry>(args, gpu_partition, *(this->m_geom));
+        }
+    else
+        {
+        this->m_exec_conf->beginMultiGPU();
+        mpcd::gpu::confined_stream<Geometry>(args,
+                                             this->m_mpcd_pdata->getGPUPartition(),
+                                             *(this->m_geom));
+        this->m_exec_conf->endMultiGPU();
+        }
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     m_tuner->end();
@@ -115,6 +140,107 @@ template<class Geometry> void ConfinedStreamingMethodGPU<Geometry>::stream(uint6
         this->m_prof->pop(this->m_exec_conf);
     }
 
+/*!
+ * \param timestep Current time to stream
+ * \param collide_timestep Timestep of the next collision
+ * \param thermo Cell properties needed by the next collision
+ * \returns True if the particles were streamed
+ *
+ * The particles are streamed, binned into the cell list with the grid shift already set for \a
+ * collide_timestep, and their momentum and energy are summed into the cells of \a thermo in one
+ * kernel. The cell list and the cell properties are then marked as computed at \a
+ * collide_timestep, so the collision does not recompute them. If the cell list overflows, the
+ * particles are still streamed, and the cell list and cell properties are computed as usual at the
+ * collision.
+ *
+ * Nothing is done if the cell list or the cell properties cannot be filled outside of their
+ * compute(), e.g., with embedded particles or in MPI simulations.
+ */
+template<class Geometry>
+bool ConfinedStreamingMethodGPU<Geometry>::streamAndBin(
+    uint64_t timestep,
+    uint64_t collide_timestep,
+    std::shared_ptr<mpcd::CellThermoCompute> thermo)
+    {
+    if (!this->peekStream(timestep))
+        return false;
+
+    auto cl = this->m_mpcd_sys->getCellList();
+    if (!cl->beginFusedBuild() || !thermo->beginFusedCompute())
+        return false;
+
+    // advance the streaming counter
+    this->shouldStream(timestep);
+
+    if (this->m_validate_geom)
+        {
+        this->validate();
+        this->m_validate_geom = false;
+        }
+
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "MPCD stream");
+        {
+        ArrayHandle<Scalar4> d_pos(this->m_mpcd_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(this->m_mpcd_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<unsigned int> d_cell_np(cl->getCellSizeArray(),
+                                            access_location::device,
+                                            access_mode::overwrite);
+        ArrayHandle<unsigned int> d_cell_list(cl->getCellList(),
+                                              access_location::device,
+                                              access_mode::overwrite);
+        ArrayHandle<double4> d_cell_vel(thermo->getCellVelocities(),
+                                        access_location::device,
+                                        access_mode::overwrite);
+        ArrayHandle<double3> d_cell_energy(thermo->getCellEnergies(),
+                                           access_location::device,
+                                           access_mode::overwrite);
+
+        mpcd::gpu::stream_args_t args(d_pos.data,
+                                      d_vel.data,
+                                      this->m_mpcd_pdata->getMass(),
+                                      (this->m_field) ? this->m_field->get(access_location::device)
+                                                      : nullptr,
+                                      cl->getCoverageBox(),
+                                      this->m_mpcd_dt,
+                                      this->m_mpcd_pdata->getN(),
+                                      m_tuner_bin->getParam());
+        mpcd::gpu::stream_bin_args_t bin_args(d_cell_np.data,
+                                              d_cell_list.data,
+                                              cl->getConditionsDeviceFlags(),
+                                              d_cell_vel.data,
+                                              d_cell_energy.data,
+                                              this->m_pdata->getBox().getPeriodic(),
+                                              cl->getOriginIndex(),
+                                              cl->getGridShift(),
+                                              this->m_pdata->getGlobalBox().getLo(),
+                                              cl->getGlobalDim(),
+                                              cl->getCellSize(),
+                                              cl->getNmax(),
+                                              cl->getCellIndexer(),
+                                              cl->getCellListIndexer(),
+                                              thermo->needsEnergy());
+
+        m_tuner_bin->begin();
+        mpcd::gpu::confined_stream_bin<Geometry>(args, bin_args, *(this->m_geom));
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_bin->end();
+        }
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+
+    // the cell properties are only complete if every particle fit into the cell list
+    if (cl->finishFusedBuild(collide_timestep))
+        thermo->finishFusedCompute(collide_timestep);
+
+    return true;
+    }
+
 namespace detail
     {
 //! Export mpcd::StreamingMethodGPU to python
@@ -19,7 +19,8 @@
  * \param deltaT Fundamental integration timestep
  */
 mpcd::Integrator::Integrator(std::shared_ptr<mpcd::SystemData> sysdata, Scalar deltaT)
-    : IntegratorTwoStep(sysdata->getSystemDefinition(), deltaT), m_mpcd_sys(sysdata)
+    : IntegratorTwoStep(sysdata->getSystemDefinition(), deltaT), m_mpcd_sys(sysdata),
+      m_enable_fused_streaming(false)
     {
     assert(m_mpcd_sys);
     m_exec_conf->msg->notice(5) << "Constructing MPCD Integrator" << std::endl;
@@ -72,6 +73,10 @@ void mpcd::Integrator::update(uint64_t timestep)
         m_gave_warning = true;
         }
 
+    // the MPCD particles count as force time so that they are included in the load balancing
+    const bool timed = getForceTiming();
+    int64_t start = (timed) ? startForceTimer() : 0;
+
     // remove any leftover virtual particles
     if (checkCollide(timestep))
         {
@@ -101,6 +106,8 @@ void mpcd::Integrator::update(uint64_t timestep)
     // updated first
     if (m_collide)
         m_collide->collide(timestep);
+    if (timed)
+        stopForceTimer(start);
 
     // perform the first MD integration step
     if (m_prof)
@@ -126,7 +133,12 @@ void mpcd::Integrator::update(uint64_t timestep)
     // domains
     if (m_stream)
         {
-        m_stream->stream(timestep);
+        if (timed)
+            start = startForceTimer();
+        if (!streamFused(timestep))
+            m_stream->stream(timestep);
+        if (timed)
+            stopForceTimer(start);
         }
 
     // compute the net force on the MD particles
@@ -146,6 +158,45 @@ void mpcd::Integrator::update(uint64_t timestep)
         m_prof->pop();
     }
 
+/*!
+ * \param timestep Current time step of the simulation
+ * \returns True if the MPCD particles were streamed
+ *
+ * When fused streaming is enabled and the next collision occurs before the next streaming step,
+ * the streaming method also fills the cell list and accumulates the cell properties the collision
+ * needs, using the grid shift of that collision. The collision then only applies its rule to the
+ * cells. This requires a collision method that only needs the cell properties first, and no
+ * virtual particle fillers or MPCD communication, which change the particles before the collision.
+ * The streaming method falls back to returning false if it cannot fill the cells, and then the
+ * particles are streamed by the caller as usual.
+ */
+bool mpcd::Integrator::streamFused(uint64_t timestep)
+    {
+    if (!m_enable_fused_streaming || !m_collide || !m_fillers.empty())
+        return false;
+#ifdef ENABLE_MPI
+    if (m_mpcd_comm)
+        return false;
+#endif // ENABLE_MPI
+    if (!m_stream->peekStream(timestep))
+        return false;
+
+    auto thermo = m_collide->getFusedThermo();
+    if (!thermo)
+        return false;
+
+    // the next collision uses the streamed positions if it happens before the next streaming step
+    uint64_t collide_timestep = timestep + 1;
+    const uint64_t next_stream = timestep + m_stream->getPeriod();
+    while (collide_timestep <= next_stream && !m_collide->peekCollide(collide_timestep))
+        ++collide_timestep;
+    if (collide_timestep > next_stream)
+        return false;
+
+    m_collide->drawGridShift(collide_timestep);
+    return m_stream->streamAndBin(timestep, collide_timestep, thermo);
+    }
+
 /*!
  * \param deltaT new deltaT to set
  * \post \a deltaT is also set on all contained integration methods
@@ -234,6 +285,8 @@ void mpcd::detail::export_Integrator(pybind11::module& m)
         .def("removeSorter", &mpcd::Integrator::removeSorter)
         .def("addFiller", &mpcd::Integrator::addFiller)
         .def("removeAllFillers", &mpcd::Integrator::removeAllFillers)
+        .def("enableFusedStreaming", &mpcd::Integrator::enableFusedStreaming)
+        .def("getFusedStreaming", &mpcd::Integrator::getFusedStreaming)
 #ifdef ENABLE_MPI
         .def("setMPCDCommunicator", &mpcd::Integrator::setMPCDCommunicator)
 #endif // ENABLE_MPI
@@ -143,6 +143,21 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
         m_sorter.reset();
         }
 
+    //! Toggle fusing the streaming step with the cell list and cell properties of the collision
+    /*!
+     * \param enable_fused_streaming Flag to stream and fill the cells in one pass if true
+     */
+    void enableFusedStreaming(bool enable_fused_streaming)
+        {
+        m_enable_fused_streaming = enable_fused_streaming;
+        }
+
+    //! Check if the streaming step is fused with the collision
+    bool getFusedStreaming() const
+        {
+        return m_enable_fused_streaming;
+        }
+
     //! Add a virtual particle filling method
     void addFiller(std::shared_ptr<mpcd::VirtualParticleFiller> filler);
 
@@ -164,6 +179,12 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
 
     std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>
         m_fillers; //!< MPCD virtual particle fillers
+
+    bool m_enable_fused_streaming; //!< Flag to fuse streaming with the next collision
+
+    //! Stream the particles and fill the cells for the next collision
+    bool streamFused(uint64_t timestep);
+
     private:
     //! Check if a collision will occur at the current timestep
     bool checkCollide(uint64_t timestep)
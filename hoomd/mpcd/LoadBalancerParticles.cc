@@ -0,0 +1,51 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/LoadBalancerParticles.cc
+ * \brief Definition of mpcd::LoadBalancerParticles
+ */
+
+#include "LoadBalancerParticles.h"
+
+/*!
+ * \param sysdata MPCD system data
+ * \param weight Cost of one MPCD particle relative to one MD particle
+ */
+mpcd::LoadBalancerParticles::LoadBalancerParticles(std::shared_ptr<mpcd::SystemData> sysdata,
+                                                   Scalar weight)
+    : m_exec_conf(sysdata->getSystemDefinition()->getParticleData()->getExecConf()),
+      m_mpcd_pdata(sysdata->getParticleData()), m_cl(sysdata->getCellList())
+    {
+    setWeight(weight);
+    }
+
+/*!
+ * \param weight Cost of one MPCD particle relative to one MD particle
+ */
+void mpcd::LoadBalancerParticles::setWeight(Scalar weight)
+    {
+    if (weight < Scalar(0.0))
+        {
+        m_exec_conf->msg->error() << "mpcd: load balancing weight must be non-negative"
+                                  << std::endl;
+        throw std::runtime_error("Invalid MPCD load balancing weight");
+        }
+    m_weight = weight;
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_LoadBalancerParticles(pybind11::module& m)
+    {
+    namespace py = pybind11;
+
+    py::class_<mpcd::LoadBalancerParticles,
+               ::LoadBalancerParticles,
+               std::shared_ptr<mpcd::LoadBalancerParticles>>(m, "LoadBalancerParticles")
+        .def(py::init<std::shared_ptr<mpcd::SystemData>, Scalar>())
+        .def_property("weight",
+                      &mpcd::LoadBalancerParticles::getWeight,
+                      &mpcd::LoadBalancerParticles::setWeight);
+    }
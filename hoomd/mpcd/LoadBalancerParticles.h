@@ -0,0 +1,96 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/LoadBalancerParticles.h
+ * \brief Declaration of mpcd::LoadBalancerParticles
+ */
+
+#ifndef MPCD_LOAD_BALANCER_PARTICLES_H_
+#define MPCD_LOAD_BALANCER_PARTICLES_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "SystemData.h"
+
+#include "hoomd/LoadBalancer.h"
+
+#include <pybind11/pybind11.h>
+
+namespace mpcd
+    {
+//! Balances the MPCD particles together with the MD particles
+/*!
+ * The MPCD particles are usually many more than the MD particles and dominate the cost of a rank,
+ * so balancing the MD particles alone can leave the MPCD load badly distributed. This adapter adds
+ * the MPCD particles to the load of the LoadBalancer, each counting as \a weight MD particles.
+ *
+ * The domain boundaries are placed on the MPCD cell grid so that the domains hold whole cells,
+ * and the domains are kept wider than one cell plus the maximum grid shift on either side, which
+ * the MPCD communicator needs to exchange particles only with the nearest neighbors.
+ */
+class PYBIND11_EXPORT LoadBalancerParticles : public ::LoadBalancerParticles
+    {
+    public:
+    //! Constructor
+    LoadBalancerParticles(std::shared_ptr<mpcd::SystemData> sysdata, Scalar weight);
+
+    //! Destructor
+    virtual ~LoadBalancerParticles() { }
+
+    //! Get the positions of the MPCD particles
+    virtual const GlobalArray<Scalar4>& getPositions()
+        {
+        return m_mpcd_pdata->getPositions();
+        }
+
+    //! Get the number of MPCD particles owned by this rank
+    virtual unsigned int getN()
+        {
+        return m_mpcd_pdata->getN();
+        }
+
+    //! Get the number of MPCD particles owned by all ranks
+    virtual unsigned int getNGlobal()
+        {
+        return m_mpcd_pdata->getNGlobal();
+        }
+
+    //! Get the cost of one MPCD particle relative to one MD particle
+    virtual Scalar getWeight()
+        {
+        return m_weight;
+        }
+
+    //! Set the cost of one MPCD particle relative to one MD particle
+    void setWeight(Scalar weight);
+
+    //! Get the MPCD cell size
+    virtual Scalar getGridSpacing()
+        {
+        return m_cl->getCellSize();
+        }
+
+    //! Get the minimum width of a domain
+    virtual Scalar getMinDomainWidth()
+        {
+        return m_cl->getCellSize() + Scalar(2.0) * m_cl->getMaxGridShift();
+        }
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+    std::shared_ptr<mpcd::ParticleData> m_mpcd_pdata;          //!< MPCD particle data
+    std::shared_ptr<mpcd::CellList> m_cl;                      //!< MPCD cell list
+    Scalar m_weight;                                           //!< Cost of an MPCD particle
+    };
+
+namespace detail
+    {
+//! Export the LoadBalancerParticles to python
+void export_LoadBalancerParticles(pybind11::module& m);
+    } // end namespace detail
+    } // end namespace mpcd
+
+#endif // MPCD_LOAD_BALANCER_PARTICLES_H_
@@ -18,6 +18,7 @@
 
 #include <pybind11/stl.h>
 
+#include <climits>
 #include <iomanip>
 #include <random>
 using namespace std;
@@ -44,11 +45,19 @@ mpcd::ParticleData::ParticleData(unsigned int N,
                                  unsigned int ndimensions,
                                  std::shared_ptr<ExecutionConfiguration> exec_conf,
                                  std::shared_ptr<DomainDecomposition> decomposition)
-    : m_N(0), m_N_virtual(0), m_N_global(0), m_N_max(0), m_exec_conf(exec_conf), m_mass(1.0),
-      m_valid_cell_cache(false)
+    : m_N(0), m_N_virtual(0), m_N_virtual_retained(0), m_N_global(0), m_N_max(0),
+      m_exec_conf(exec_conf), m_mass(1.0), m_valid_cell_cache(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD ParticleData" << endl;
 
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
+        m_memory_advice_last_Nmax = UINT_MAX;
+        }
+#endif // ENABLE_HIP
+
     // set domain decomposition
     unsigned int my_seed = seed;
 #ifdef ENABLE_MPI
@@ -74,11 +83,19 @@ mpcd::ParticleData::ParticleData(std::shared_ptr<mpcd::ParticleDataSnapshot> sna
                                  const BoxDim& global_box,
                                  std::shared_ptr<const ExecutionConfiguration> exec_conf,
                                  std::shared_ptr<DomainDecomposition> decomposition)
-    : m_N(0), m_N_virtual(0), m_N_global(0), m_N_max(0), m_exec_conf(exec_conf), m_mass(1.0),
-      m_valid_cell_cache(false)
+    : m_N(0), m_N_virtual(0), m_N_virtual_retained(0), m_N_global(0), m_N_max(0),
+      m_exec_conf(exec_conf), m_mass(1.0), m_valid_cell_cache(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD ParticleData" << endl;
 
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
+        m_memory_advice_last_Nmax = UINT_MAX;
+        }
+#endif // ENABLE_HIP
+
 // set domain decomposition
 #ifdef ENABLE_MPI
     setupMPI(decomposition);
@@ -321,6 +338,7 @@ void mpcd::ParticleData::initializeFromSnapshot(
         }
 
     setNGlobal(nglobal);
+    setGPUAdvice();
 
     // TODO: any particle data signaling to subscribers
     }
@@ -390,6 +408,7 @@ void mpcd::ParticleData::initializeRandom(unsigned int N,
 
     // allocate and fill up with random values
     allocate(m_N);
+    setGPUAdvice();
     ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
@@ -642,15 +661,16 @@ void mpcd::ParticleData::setNGlobal(unsigned int nglobal)
 void mpcd::ParticleData::allocate(unsigned int N_max)
     {
     m_N_max = N_max;
+    m_N_virtual_retained = 0;
 
     //! Allocate the particle data
-    GPUArray<Scalar4> pos(N_max, m_exec_conf);
+    GlobalArray<Scalar4> pos(N_max, m_exec_conf);
     m_pos.swap(pos);
 
-    GPUArray<Scalar4> vel(N_max, m_exec_conf);
+    GlobalArray<Scalar4> vel(N_max, m_exec_conf);
     m_vel.swap(vel);
 
-    GPUArray<unsigned int> tag(N_max, m_exec_conf);
+    GlobalArray<unsigned int> tag(N_max, m_exec_conf);
     m_tag.swap(tag);
 
 #ifdef ENABLE_MPI
@@ -662,13 +682,13 @@ void mpcd::ParticleData::allocate(unsigned int N_max)
 #endif // ENABLE_MPI
 
     // Allocate the alternate data
-    GPUArray<Scalar4> pos_alt(N_max, m_exec_conf);
+    GlobalArray<Scalar4> pos_alt(N_max, m_exec_conf);
     m_pos_alt.swap(pos_alt);
 
-    GPUArray<Scalar4> vel_alt(N_max, m_exec_conf);
+    GlobalArray<Scalar4> vel_alt(N_max, m_exec_conf);
     m_vel_alt.swap(vel_alt);
 
-    GPUArray<unsigned int> tag_alt(N_max, m_exec_conf);
+    GlobalArray<unsigned int> tag_alt(N_max, m_exec_conf);
     m_tag_alt.swap(tag_alt);
 
 #ifdef ENABLE_MPI
@@ -751,7 +771,76 @@ void mpcd::ParticleData::resize(unsigned int N)
             }
         reallocate(N_max);
         }
+    // the retained virtual particles are displaced when the owned particles change
+    if (N != m_N)
+        m_N_virtual_retained = 0;
     m_N = N;
+    setGPUAdvice();
+    }
+
+/*!
+ * The MPCD particles are split evenly across the active GPUs. When all GPUs have concurrent access
+ * to managed memory, the particle data of each GPU is also given that GPU as its preferred
+ * location, so kernels that are launched over the partition do not fault on the other GPUs.
+ */
+void mpcd::ParticleData::setGPUAdvice()
+    {
+#ifdef ENABLE_HIP
+    if (!m_exec_conf->isCUDAEnabled())
+        return;
+
+    m_gpu_partition.setN(m_N);
+
+#ifdef __HIP_PLATFORM_NVCC__
+    // only call CUDA API when necessary
+    if (!m_exec_conf->allConcurrentManagedAccess() || m_memory_advice_last_Nmax == m_N_max)
+        return;
+    m_memory_advice_last_Nmax = m_N_max;
+
+    auto gpu_map = m_exec_conf->getGPUIds();
+    for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
+        {
+        auto range = m_gpu_partition.getRange(idev);
+        unsigned int nelem = range.second - range.first;
+
+        if (!nelem)
+            continue;
+
+        cudaMemAdvise(m_pos.get() + range.first,
+                      sizeof(Scalar4) * nelem,
+                      cudaMemAdviseSetPreferredLocation,
+                      gpu_map[idev]);
+        cudaMemAdvise(m_vel.get() + range.first,
+                      sizeof(Scalar4) * nelem,
+                      cudaMemAdviseSetPreferredLocation,
+                      gpu_map[idev]);
+        cudaMemAdvise(m_tag.get() + range.first,
+                      sizeof(unsigned int) * nelem,
+                      cudaMemAdviseSetPreferredLocation,
+                      gpu_map[idev]);
+        cudaMemAdvise(m_pos_alt.get() + range.first,
+                      sizeof(Scalar4) * nelem,
+                      cudaMemAdviseSetPreferredLocation,
+                      gpu_map[idev]);
+        cudaMemAdvise(m_vel_alt.get() + range.first,
+                      sizeof(Scalar4) * nelem,
+                      cudaMemAdviseSetPreferredLocation,
+                      gpu_map[idev]);
+        cudaMemAdvise(m_tag_alt.get() + range.first,
+                      sizeof(unsigned int) * nelem,
+                      cudaMemAdviseSetPreferredLocation,
+                      gpu_map[idev]);
+
+        // migrate data to preferred location
+        cudaMemPrefetchAsync(m_pos.get() + range.first, sizeof(Scalar4) * nelem, gpu_map[idev]);
+        cudaMemPrefetchAsync(m_vel.get() + range.first, sizeof(Scalar4) * nelem, gpu_map[idev]);
+        cudaMemPrefetchAsync(m_tag.get() + range.first,
+                             sizeof(unsigned int) * nelem,
+                             gpu_map[idev]);
+        }
+    CHECK_CUDA_ERROR();
+#endif // __HIP_PLATFORM_NVCC__
+#endif // ENABLE_HIP
     }
 
 /*!
@@ -908,6 +997,7 @@ void mpcd::ParticleData::addVirtualParticles(unsigned int N)
             N_max = ((unsigned int)(((float)N_max) * resize_factor)) + 1;
             }
         reallocate(N_max);
+        setGPUAdvice();
         }
 
     notifyNumVirtual();
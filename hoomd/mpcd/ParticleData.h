@@ -20,6 +20,7 @@
 
 #ifdef ENABLE_HIP
 #include "ParticleData.cuh"
+#include "hoomd/GPUPartition.cuh"
 #ifdef ENABLE_MPI
 #include "hoomd/Autotuner.h"
 #endif // ENABLE_MPI
@@ -31,6 +32,7 @@
 #include "hoomd/GPUArray.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/GPUVector.h"
+#include "hoomd/GlobalArray.h"
 #include "hoomd/Profiler.h"
 
 #include "hoomd/extern/nano-signal-slot/nano_signal_slot.hpp"
@@ -171,19 +173,19 @@ class PYBIND11_EXPORT ParticleData
     std::string getNameByType(unsigned int type) const;
 
     //! Get array of MPCD particle positions
-    const GPUArray<Scalar4>& getPositions() const
+    const GlobalArray<Scalar4>& getPositions() const
         {
         return m_pos;
         }
 
     //! Get array of MPCD particle velocities
-    const GPUArray<Scalar4>& getVelocities() const
+    const GlobalArray<Scalar4>& getVelocities() const
         {
         return m_vel;
         }
 
     //! Get array of MPCD particle tags
-    const GPUArray<unsigned int>& getTags() const
+    const GlobalArray<unsigned int>& getTags() const
         {
         return m_tag;
         }
@@ -209,6 +211,14 @@ class PYBIND11_EXPORT ParticleData
     //! Get the tag of the particle on the local rank
     unsigned int getTag(unsigned int idx) const;
 
+#ifdef ENABLE_HIP
+    //! Get the partition of the MPCD particles across GPUs
+    const GPUPartition& getGPUPartition() const
+        {
+        return m_gpu_partition;
+        }
+#endif // ENABLE_HIP
+
     //! Set the profiler for the particle data to use
     void setProfiler(std::shared_ptr<Profiler> prof)
         {
@@ -245,7 +255,7 @@ class PYBIND11_EXPORT ParticleData
     //! \name swap methods
     //@{
     //! Get alternate array of MPCD particle positions
-    const GPUArray<Scalar4>& getAltPositions() const
+    const GlobalArray<Scalar4>& getAltPositions() const
         {
         return m_pos_alt;
         }
@@ -254,10 +264,11 @@ class PYBIND11_EXPORT ParticleData
     void swapPositions()
         {
         m_pos.swap(m_pos_alt);
+        m_N_virtual_retained = 0;
         }
 
     //! Get alternate array of MPCD particle velocities
-    const GPUArray<Scalar4>& getAltVelocities() const
+    const GlobalArray<Scalar4>& getAltVelocities() const
         {
         return m_vel_alt;
         }
@@ -266,10 +277,11 @@ class PYBIND11_EXPORT ParticleData
     void swapVelocities()
         {
         m_vel.swap(m_vel_alt);
+        m_N_virtual_retained = 0;
         }
 
     //! Get alternate array of MPCD particle tags
-    const GPUArray<unsigned int>& getAltTags() const
+    const GlobalArray<unsigned int>& getAltTags() const
         {
         return m_tag_alt;
         }
@@ -278,6 +290,7 @@ class PYBIND11_EXPORT ParticleData
     void swapTags()
         {
         m_tag.swap(m_tag_alt);
+        m_N_virtual_retained = 0;
         }
     //@}
 
@@ -369,17 +382,32 @@ class PYBIND11_EXPORT ParticleData
     //! Allocate memory for virtual particles
     void addVirtualParticles(unsigned int N);
 
+    //! Get the number of removed virtual particles whose data is still intact
+    /*!
+     * The data of the virtual particles that were last removed is retained after the owned
+     * particles until the owned particles change, the arrays are swapped, or new virtual particles
+     * overwrite them. Virtual particle fillers use this to redraw a persistent region in place.
+     */
+    unsigned int getNVirtualRetained() const
+        {
+        return m_N_virtual_retained;
+        }
+
     //! Remove all virtual particles
     /*!
      * \post The virtual particle counter is reset to zero.
      *
      * The memory associated with the previous virtual particle allocation is not freed
-     * since the array growth is amortized in allocateVirtualParticles.
+     * since the array growth is amortized in allocateVirtualParticles. The data of the removed
+     * particles also stays in place after the owned particles, and getNVirtualRetained() reports
+     * how many of them are still intact.
      */
     void removeVirtualParticles()
         {
         const unsigned int old_N_virtual = m_N_virtual;
         m_N_virtual = 0;
+        if (old_N_virtual > 0)
+            m_N_virtual_retained = old_N_virtual;
 
         // only notify of a change if there were virtual particles that have now been removed
         if (old_N_virtual != 0)
@@ -435,27 +463,28 @@ class PYBIND11_EXPORT ParticleData
 #endif // ENABLE_MPI
 
     private:
-    unsigned int m_N;         //!< Number of MPCD particles
-    unsigned int m_N_virtual; //!< Number of virtual MPCD particles
-    unsigned int m_N_global;  //!< Total number of MPCD particles
-    unsigned int m_N_max;     //!< Maximum number of MPCD particles arrays can hold
+    unsigned int m_N;                  //!< Number of MPCD particles
+    unsigned int m_N_virtual;          //!< Number of virtual MPCD particles
+    unsigned int m_N_virtual_retained; //!< Number of removed virtual particles still in the arrays
+    unsigned int m_N_global;           //!< Total number of MPCD particles
+    unsigned int m_N_max;              //!< Maximum number of MPCD particles arrays can hold
 
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< GPU execution configuration
     std::shared_ptr<DomainDecomposition> m_decomposition;      //!< Domain decomposition
     std::shared_ptr<Profiler> m_prof;                          //!< Profiler
 
-    GPUArray<Scalar4> m_pos;                 //!< MPCD particle positions plus type
-    GPUArray<Scalar4> m_vel;                 //!< MPCD particle velocities plus cell list id
+    GlobalArray<Scalar4> m_pos;              //!< MPCD particle positions plus type
+    GlobalArray<Scalar4> m_vel;              //!< MPCD particle velocities plus cell list id
     Scalar m_mass;                           //!< MPCD particle mass
-    GPUArray<unsigned int> m_tag;            //!< MPCD particle tags
+    GlobalArray<unsigned int> m_tag;         //!< MPCD particle tags
     std::vector<std::string> m_type_mapping; //!< Type name mapping
 #ifdef ENABLE_MPI
     GPUArray<unsigned int> m_comm_flags; //!< MPCD particle communication flags
 #endif                                   // ENABLE_MPI
 
-    GPUArray<Scalar4> m_pos_alt;      //!< Alternate position array
-    GPUArray<Scalar4> m_vel_alt;      //!< Alternate velocity array
-    GPUArray<unsigned int> m_tag_alt; //!< Alternate tag array
+    GlobalArray<Scalar4> m_pos_alt;      //!< Alternate position array
+    GlobalArray<Scalar4> m_vel_alt;      //!< Alternate velocity array
+    GlobalArray<unsigned int> m_tag_alt; //!< Alternate tag array
 #ifdef ENABLE_MPI
     GPUArray<unsigned int> m_comm_flags_alt; //!< Alternate communication flags
     GPUArray<unsigned int> m_remove_ids;     //!< Partitioned indexes of particles to keep
@@ -469,6 +498,11 @@ class PYBIND11_EXPORT ParticleData
 #endif                                         // ENABLE_HIP
 #endif                                         // ENABLE_MPI
 
+#ifdef ENABLE_HIP
+    GPUPartition m_gpu_partition;           //!< Partition of the MPCD particles across GPUs
+    unsigned int m_memory_advice_last_Nmax; //!< N_max at which memory hints were last set
+#endif                                      // ENABLE_HIP
+
     bool m_valid_cell_cache;               //!< Flag for validity of cell cache
     SortSignal m_sort_signal;              //!< Signal triggered when particles are sorted
     Nano::Signal<void()> m_virtual_signal; //!< Signal for number of virtual particles changing
@@ -493,6 +527,9 @@ class PYBIND11_EXPORT ParticleData
     //! Resize the data
     void resize(unsigned int N);
 
+    //! Update the GPU partition and memory hints for the current number of particles
+    void setGPUAdvice();
+
 #ifdef ENABLE_MPI
     //! Setup MPI
     void setupMPI(std::shared_ptr<DomainDecomposition> decomposition);
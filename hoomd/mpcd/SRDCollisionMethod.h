@@ -75,6 +75,12 @@ class PYBIND11_EXPORT SRDCollisionMethod : public mpcd::CollisionMethod
         m_T = std::shared_ptr<::Variant>();
         }
 
+    //! Get the cell properties that the collision rule needs first
+    virtual std::shared_ptr<mpcd::CellThermoCompute> getFusedThermo() const
+        {
+        return m_thermo;
+        }
+
     //! Get the requested thermo flags
     mpcd::detail::ThermoFlags getRequestedThermoFlags() const
         {
@@ -125,6 +125,23 @@ class __attribute__((visibility("default"))) SlitGeometry
         return true;
         }
 
+    //! Check if a particle cannot reach the boundary while streaming
+    /*!
+     * \param pos Current particle position
+     * \param vel Particle velocity
+     * \param dt Integration time
+     * \returns True if the particle cannot collide with the walls during \a dt, and false otherwise
+     *
+     * The particle moves along a straight line until it collides, so it cannot collide if it ends
+     * up between the walls. This is the same test as detectCollision() makes, but it can be made
+     * before the particle is moved.
+     */
+    HOSTDEVICE bool cannotCollide(const Scalar3& pos, const Scalar3& vel, Scalar dt) const
+        {
+        const Scalar z = pos.z + vel.z * dt;
+        return (z <= m_H && z >= -m_H);
+        }
+
     //! Check if a particle is out of bounds
     /*!
      * \param pos Current particle position
@@ -75,8 +75,9 @@ void mpcd::SlitGeometryFiller::computeNumFill()
 
 /*!
  * \param timestep Current timestep to draw particles
+ * \param positions If true, also draw the positions and tags of the particles
  */
-void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
+void mpcd::SlitGeometryFiller::draw(uint64_t timestep, bool positions)
     {
     ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
                                access_location::host,
@@ -117,10 +118,14 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
             }
 
         const unsigned int pidx = first_idx + i;
-        h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                                        __int_as_scalar(m_type));
+        if (positions)
+            {
+            h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                            __int_as_scalar(m_type));
+            h_tag.data[pidx] = tag;
+            }
 
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
@@ -132,7 +137,6 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
                                         vel.y,
                                         vel.z,
                                         __int_as_scalar(mpcd::detail::NO_CELL));
-        h_tag.data[pidx] = tag;
         }
     }
 
@@ -41,6 +41,7 @@ class PYBIND11_EXPORT SlitGeometryFiller : public mpcd::VirtualParticleFiller
     void setGeometry(std::shared_ptr<const mpcd::detail::SlitGeometry> geom)
         {
         m_geom = geom;
+        notifyRedraw();
         }
 
     protected:
@@ -54,7 +55,20 @@ class PYBIND11_EXPORT SlitGeometryFiller : public mpcd::VirtualParticleFiller
     virtual void computeNumFill();
 
     //! Draw particles within the fill volume
-    virtual void drawParticles(uint64_t timestep);
+    virtual void drawParticles(uint64_t timestep)
+        {
+        draw(timestep, true);
+        }
+
+    //! Draw only the velocities of the particles within the fill volume
+    virtual void drawVelocities(uint64_t timestep)
+        {
+        draw(timestep, false);
+        }
+
+    private:
+    //! Draw the velocities and, optionally, the positions and tags of the fill particles
+    void draw(uint64_t timestep, bool positions);
     };
 
 namespace detail
@@ -24,8 +24,9 @@ mpcd::SlitGeometryFillerGPU::SlitGeometryFillerGPU(
 
 /*!
  * \param timestep Current timestep
+ * \param positions If true, also draw the positions and tags of the particles
  */
-void mpcd::SlitGeometryFillerGPU::drawParticles(uint64_t timestep)
+void mpcd::SlitGeometryFillerGPU::draw(uint64_t timestep, bool positions)
     {
     ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
                                access_location::device,
@@ -58,6 +59,7 @@ void mpcd::SlitGeometryFillerGPU::drawParticles(uint64_t timestep)
                                    (*m_T)(timestep),
                                    timestep,
                                    seed,
+                                   positions,
                                    m_tuner->getParam());
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
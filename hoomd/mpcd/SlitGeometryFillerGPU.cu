@@ -34,13 +34,15 @@ namespace kernel
  * \param first_idx First (local) particle index of filled particles
  * \param vel_factor Scale factor for uniform normal velocities consistent with particle mass /
  * temperature \param timestep Current timestep \param seed User seed to PRNG for drawing velocities
+ * \param positions If true, also draw the positions and tags of the particles
  *
  * \b Implementation:
  *
  * Using one thread per particle (in both slabs), the thread is assigned to fill either the lower
  * or upper region. This defines a local cuboid of volume to fill. The thread index is translated
  * into a particle tag and local particle index. A random position is drawn within the cuboid. A
- * random velocity is drawn consistent with the speed of the moving wall.
+ * random velocity is drawn consistent with the speed of the moving wall. When \a positions is
+ * false, the position and tag already in place are kept and only the velocity is drawn.
  */
 __global__ void slit_draw_particles(Scalar4* d_pos,
                                     Scalar4* d_vel,
@@ -56,7 +58,8 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
                                     const unsigned int first_idx,
                                     const Scalar vel_factor,
                                     const uint64_t timestep,
-                                    const uint16_t seed)
+                                    const uint16_t seed,
+                                    const bool positions)
     {
     // one thread per particle
     const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -81,16 +84,19 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
     // particle tag and index
     const unsigned int tag = first_tag + idx;
     const unsigned int pidx = first_idx + idx;
-    d_tag[pidx] = tag;
 
     // initialize random number generator for positions and velocity
     hoomd::RandomGenerator rng(
         hoomd::Seed(hoomd::RNGIdentifier::SlitGeometryFiller, timestep, seed),
         hoomd::Counter(tag));
-    d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                               __int_as_scalar(type));
+    if (positions)
+        {
+        d_tag[pidx] = tag;
+        d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                   __int_as_scalar(type));
+        }
 
     hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
     Scalar3 vel;
@@ -122,6 +128,7 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
  * \param kT Temperature for fill particles
  * \param timestep Current timestep
  * \param seed User seed to PRNG for drawing velocities
+ * \param positions If true, also draw the positions and tags of the particles
  * \param block_size Number of threads per block
  *
  * \sa kernel::slit_draw_particles
@@ -142,6 +149,7 @@ cudaError_t slit_draw_particles(Scalar4* d_pos,
                                 const Scalar kT,
                                 const uint64_t timestep,
                                 const uint16_t seed,
+                                const bool positions,
                                 const unsigned int block_size)
     {
     const unsigned int N_tot = N_lo + N_hi;
@@ -172,7 +180,8 @@ cudaError_t slit_draw_particles(Scalar4* d_pos,
                                                           first_idx,
                                                           vel_factor,
                                                           timestep,
-                                                          seed);
+                                                          seed,
+                                                          positions);
 
     return cudaSuccess;
     }
@@ -158,6 +158,24 @@ class __attribute__((visibility("default"))) SlitPoreGeometry
         return true;
         }
 
+    //! Check if a particle cannot reach the boundary while streaming
+    /*!
+     * \param pos Current particle position
+     * \param vel Particle velocity
+     * \param dt Integration time
+     * \returns True if the particle cannot collide with the pore during \a dt, and false otherwise
+     *
+     * The particle moves along a straight line until it collides, so it cannot collide if it
+     * starts and ends between the walls, or if it stays on one side of the pore in x.
+     */
+    HOSTDEVICE bool cannotCollide(const Scalar3& pos, const Scalar3& vel, Scalar dt) const
+        {
+        const Scalar3 end = pos + dt * vel;
+        if (pos.z <= m_H && pos.z >= -m_H && end.z <= m_H && end.z >= -m_H)
+            return true;
+        return ((pos.x >= m_L && end.x >= m_L) || (pos.x <= -m_L && end.x <= -m_L));
+        }
+
     //! Check if a particle is out of bounds
     /*!
      * \param pos Current particle position
@@ -139,12 +139,16 @@ void mpcd::SlitPoreGeometryFiller::computeNumFill()
     // size is now updated, cache the cell dimensions used
     m_needs_recompute = false;
     m_recompute_cache = make_scalar3(cell_size, max_shift, m_density);
+
+    // the fill boxes may have changed, so any kept particles must be drawn again
+    notifyRedraw();
     }
 
 /*!
  * \param timestep Current timestep to draw particles
+ * \param positions If true, also draw the positions and tags of the particles
  */
-void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
+void mpcd::SlitPoreGeometryFiller::draw(uint64_t timestep, bool positions)
     {
     // quit early if not filling to ensure we don't access any memory that hasn't been set
     if (m_N_fill == 0)
@@ -183,23 +187,27 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
             hoomd::Seed(hoomd::RNGIdentifier::SlitPoreGeometryFiller, timestep, seed),
             hoomd::Counter(tag));
 
-        // advanced past end of this box range, take the next
-        if (i >= boxlast)
+        const unsigned int pidx = first_idx + i;
+        if (positions)
             {
-            ++boxid;
-            boxlast = h_ranges.data[boxid].y;
-            const Scalar4 fillbox = h_boxes.data[boxid];
-            lo.x = fillbox.x;
-            hi.x = fillbox.y;
-            lo.z = fillbox.z;
-            hi.z = fillbox.w;
-            }
+            // advanced past end of this box range, take the next
+            if (i >= boxlast)
+                {
+                ++boxid;
+                boxlast = h_ranges.data[boxid].y;
+                const Scalar4 fillbox = h_boxes.data[boxid];
+                lo.x = fillbox.x;
+                hi.x = fillbox.y;
+                lo.z = fillbox.z;
+                hi.z = fillbox.w;
+                }
 
-        const unsigned int pidx = first_idx + i;
-        h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                                        __int_as_scalar(m_type));
+            h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                            __int_as_scalar(m_type));
+            h_tag.data[pidx] = tag;
+            }
 
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
@@ -209,7 +217,6 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
         // reference?)
         h_vel.data[pidx]
             = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
-        h_tag.data[pidx] = tag;
         }
     }
 
@@ -57,9 +57,21 @@ class PYBIND11_EXPORT SlitPoreGeometryFiller : public mpcd::VirtualParticleFille
     virtual void computeNumFill();
 
     //! Draw particles within the fill volume
-    virtual void drawParticles(uint64_t timestep);
+    virtual void drawParticles(uint64_t timestep)
+        {
+        draw(timestep, true);
+        }
+
+    //! Draw only the velocities of the particles within the fill volume
+    virtual void drawVelocities(uint64_t timestep)
+        {
+        draw(timestep, false);
+        }
 
     private:
+    //! Draw the velocities and, optionally, the positions and tags of the fill particles
+    void draw(uint64_t timestep, bool positions);
+
     bool m_needs_recompute;
     Scalar3 m_recompute_cache;
     void notifyRecompute()
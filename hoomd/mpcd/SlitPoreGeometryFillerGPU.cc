@@ -25,8 +25,9 @@ mpcd::SlitPoreGeometryFillerGPU::SlitPoreGeometryFillerGPU(
 
 /*!
  * \param timestep Current timestep
+ * \param positions If true, also draw the positions and tags of the particles
  */
-void mpcd::SlitPoreGeometryFillerGPU::drawParticles(uint64_t timestep)
+void mpcd::SlitPoreGeometryFillerGPU::draw(uint64_t timestep, bool positions)
     {
     ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
                                access_location::device,
@@ -62,6 +63,7 @@ void mpcd::SlitPoreGeometryFillerGPU::drawParticles(uint64_t timestep)
                                         (*m_T)(timestep),
                                         timestep,
                                         seed,
+                                        positions,
                                         m_tuner->getParam());
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
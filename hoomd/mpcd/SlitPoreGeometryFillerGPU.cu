@@ -33,13 +33,15 @@ namespace kernel
  * \param first_idx First (local) particle index of filled particles
  * \param vel_factor Scale factor for uniform normal velocities consistent with particle mass /
  * temperature \param timestep Current timestep \param seed User seed to PRNG for drawing velocities
+ * \param positions If true, also draw the positions and tags of the particles
  *
  * \b Implementation:
  *
  * Using one thread per particle, the thread is assigned to a fill range matching a 2d bounding box,
  * which defines a cuboid of volume to fill. The thread index is translated into a particle tag
  * and local particle index. A random position is drawn within the cuboid. A random velocity
- * is drawn consistent with the speed of the moving wall.
+ * is drawn consistent with the speed of the moving wall. When \a positions is false, the position
+ * and tag already in place are kept and only the velocity is drawn.
  */
 __global__ void slit_pore_draw_particles(Scalar4* d_pos,
                                          Scalar4* d_vel,
@@ -54,7 +56,8 @@ __global__ void slit_pore_draw_particles(Scalar4* d_pos,
                                          const unsigned int first_idx,
                                          const Scalar vel_factor,
                                          const uint64_t timestep,
-                                         const uint16_t seed)
+                                         const uint16_t seed,
+                                         const bool positions)
     {
     // num_boxes should be 6, so this will all fit in shmem
     extern __shared__ char s_data[];
@@ -76,36 +79,39 @@ __global__ void slit_pore_draw_particles(Scalar4* d_pos,
     if (idx >= N_tot)
         return;
 
-    // linear search for box matching thread (num_boxes is small)
-    Scalar3 lo = box.getLo();
-    Scalar3 hi = box.getHi();
-    for (unsigned int boxid = 0; boxid < num_boxes; ++boxid)
-        {
-        const uint2 range = s_ranges[boxid];
-        if (idx >= range.x && idx < range.y)
-            {
-            const Scalar4 fillbox = s_boxes[boxid];
-            lo.x = fillbox.x;
-            hi.x = fillbox.y;
-            lo.z = fillbox.z;
-            hi.z = fillbox.w;
-            break;
-            }
-        }
-
     // particle tag and index
     const unsigned int tag = first_tag + idx;
     const unsigned int pidx = first_idx + idx;
-    d_tag[pidx] = tag;
 
     // initialize random number generator for positions and velocity
     hoomd::RandomGenerator rng(
         hoomd::Seed(hoomd::RNGIdentifier::SlitPoreGeometryFiller, timestep, seed),
         hoomd::Counter(tag));
-    d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                               __int_as_scalar(type));
+    if (positions)
+        {
+        // linear search for box matching thread (num_boxes is small)
+        Scalar3 lo = box.getLo();
+        Scalar3 hi = box.getHi();
+        for (unsigned int boxid = 0; boxid < num_boxes; ++boxid)
+            {
+            const uint2 range = s_ranges[boxid];
+            if (idx >= range.x && idx < range.y)
+                {
+                const Scalar4 fillbox = s_boxes[boxid];
+                lo.x = fillbox.x;
+                hi.x = fillbox.y;
+                lo.z = fillbox.z;
+                hi.z = fillbox.w;
+                break;
+                }
+            }
+
+        d_tag[pidx] = tag;
+        d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                   __int_as_scalar(type));
+        }
 
     hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
     Scalar3 vel;
@@ -133,6 +139,7 @@ __global__ void slit_pore_draw_particles(Scalar4* d_pos,
  * \param kT Temperature for fill particles
  * \param timestep Current timestep
  * \param seed User seed to PRNG for drawing velocities
+ * \param positions If true, also draw the positions and tags of the particles
  * \param block_size Number of threads per block
  *
  * \sa kernel::slit_pore_draw_particles
@@ -152,6 +159,7 @@ cudaError_t slit_pore_draw_particles(Scalar4* d_pos,
                                      const Scalar kT,
                                      const uint64_t timestep,
                                      const uint16_t seed,
+                                     const bool positions,
                                      const unsigned int block_size)
     {
     if (N_tot == 0)
@@ -181,7 +189,8 @@ cudaError_t slit_pore_draw_particles(Scalar4* d_pos,
                                                                              first_idx,
                                                                              vel_factor,
                                                                              timestep,
-                                                                             seed);
+                                                                             seed,
+                                                                             positions);
 
     return cudaSuccess;
     }
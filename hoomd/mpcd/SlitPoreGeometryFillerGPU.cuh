@@ -37,6 +37,7 @@ cudaError_t slit_pore_draw_particles(Scalar4* d_pos,
                                      const Scalar kT,
                                      const uint64_t timestep,
                                      const uint16_t seed,
+                                     const bool positions,
                                      const unsigned int block_size);
 
     } // end namespace gpu
@@ -48,10 +48,22 @@ class PYBIND11_EXPORT SlitPoreGeometryFillerGPU : public mpcd::SlitPoreGeometryF
 
     protected:
     //! Draw particles within the fill volume on the GPU
-    virtual void drawParticles(uint64_t timestep);
+    virtual void drawParticles(uint64_t timestep)
+        {
+        draw(timestep, true);
+        }
+
+    //! Draw only the velocities of the particles within the fill volume on the GPU
+    virtual void drawVelocities(uint64_t timestep)
+        {
+        draw(timestep, false);
+        }
 
     private:
     std::unique_ptr<::Autotuner> m_tuner; //!< Autotuner for drawing particles
+
+    //! Draw the velocities and, optionally, the positions and tags of the fill particles
+    void draw(uint64_t timestep, bool positions);
     };
 
 namespace detail
@@ -87,14 +87,18 @@ void mpcd::Sorter::computeOrder(uint64_t timestep)
     // loop through the cell list to generate the sorting order for MPCD particles
     ArrayHandle<unsigned int> h_order(m_order, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_rorder(m_rorder, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_offsets(m_cl->getCellOffsets(),
+                                             access_location::host,
+                                             access_mode::read);
     const unsigned int N_mpcd = m_mpcd_pdata->getN();
     unsigned int cur_p = 0;
     for (unsigned int idx = 0; idx < m_cl->getNCells(); ++idx)
         {
         const unsigned int np = h_cell_np.data[idx];
+        const unsigned int first = (m_cl->isCompact()) ? h_cell_offsets.data[idx] : cli(0, idx);
         for (unsigned int offset = 0; offset < np; ++offset)
             {
-            const unsigned int pid = h_cell_list.data[cli(offset, idx)];
+            const unsigned int pid = h_cell_list.data[first + offset];
             // only count MPCD particles, and skip embedded particles
             if (pid < N_mpcd)
                 {
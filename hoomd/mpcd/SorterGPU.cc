@@ -46,7 +46,9 @@ void mpcd::SorterGPU::computeOrder(uint64_t timestep)
         m_prof->push(m_exec_conf, "MPCD sort");
         }
 
-    // fill the empty cell list entries with a sentinel larger than number of MPCD particles
+    // fill the empty cell list entries with a sentinel larger than number of MPCD particles,
+    // which the compact cell list does not have
+    if (!m_cl->isCompact())
         {
         ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
                                               access_location::device,
@@ -72,11 +74,13 @@ void mpcd::SorterGPU::computeOrder(uint64_t timestep)
                                               access_location::device,
                                               access_mode::read);
         ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::overwrite);
-        const unsigned int num_select
-            = mpcd::gpu::sort_cell_compact(d_order.data,
-                                           d_cell_list.data,
-                                           m_cl->getCellListIndexer().getNumElements(),
-                                           m_mpcd_pdata->getN());
+        const unsigned int num_entries = (m_cl->isCompact())
+                                             ? m_cl->getNCompactEntries()
+                                             : m_cl->getCellListIndexer().getNumElements();
+        const unsigned int num_select = mpcd::gpu::sort_cell_compact(d_order.data,
+                                                                     d_cell_list.data,
+                                                                     num_entries,
+                                                                     m_mpcd_pdata->getN());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         if (num_select != m_mpcd_pdata->getN())
@@ -15,6 +15,7 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "CellThermoCompute.h"
 #include "ExternalField.h"
 #include "SystemData.h"
 #include "hoomd/GPUPolymorph.h"
@@ -42,6 +43,24 @@ class PYBIND11_EXPORT StreamingMethod
     //! Implementation of the streaming rule
     virtual void stream(uint64_t timestep) { }
 
+    //! Stream the particles and fill the cells for the next collision
+    /*!
+     * \param timestep Current time to stream
+     * \param collide_timestep Timestep of the next collision
+     * \param thermo Cell properties needed by the next collision
+     * \returns True if the particles were streamed
+     *
+     * Derived classes can override this to stream the particles, fill the cell list, and
+     * accumulate the cell properties of \a thermo for \a collide_timestep in one pass. The
+     * default implementation does nothing, and the caller should use stream() instead.
+     */
+    virtual bool streamAndBin(uint64_t timestep,
+                              uint64_t collide_timestep,
+                              std::shared_ptr<mpcd::CellThermoCompute> thermo)
+        {
+        return false;
+        }
+
     //! Peek if the next step requires streaming
     virtual bool peekStream(uint64_t timestep) const;
 
@@ -94,6 +113,12 @@ class PYBIND11_EXPORT StreamingMethod
     //! Set the period of the streaming method
     void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+    //! Get the period of the streaming method
+    unsigned int getPeriod() const
+        {
+        return m_period;
+        }
+
     protected:
     std::shared_ptr<mpcd::SystemData> m_mpcd_sys;              //!< MPCD system data
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< HOOMD system definition
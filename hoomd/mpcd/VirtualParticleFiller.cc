@@ -17,7 +17,8 @@ mpcd::VirtualParticleFiller::VirtualParticleFiller(std::shared_ptr<mpcd::SystemD
     : m_sysdef(sysdata->getSystemDefinition()), m_pdata(m_sysdef->getParticleData()),
       m_exec_conf(m_pdata->getExecConf()), m_mpcd_pdata(sysdata->getParticleData()),
       m_cl(sysdata->getCellList()), m_density(density), m_type(type), m_T(T), m_N_fill(0),
-      m_first_tag(0)
+      m_first_tag(0), m_persistent(false), m_needs_redraw(true), m_last_N_fill(0),
+      m_last_first_idx(0), m_last_first_tag(0), m_last_cell(make_scalar2(0, 0))
     {
     }
 
@@ -44,15 +45,54 @@ void mpcd::VirtualParticleFiller::fill(uint64_t timestep)
 #endif // ENABLE_MPI
     m_first_tag += m_mpcd_pdata->getNGlobal() + m_mpcd_pdata->getNVirtualGlobal();
 
+    // check if the particles from the last fill are still in place before they are overwritten
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    const bool keep = m_persistent && canKeepParticles(first_idx);
+
     // add the new virtual particles locally
     m_mpcd_pdata->addVirtualParticles(m_N_fill);
 
     // draw the particles consistent with those tags
-    drawParticles(timestep);
+    if (keep)
+        {
+        drawVelocities(timestep);
+        }
+    else
+        {
+        drawParticles(timestep);
+
+        m_last_N_fill = m_N_fill;
+        m_last_first_idx = first_idx;
+        m_last_first_tag = m_first_tag;
+        m_last_box = m_pdata->getBox();
+        m_last_cell = make_scalar2(m_cl->getCellSize(), m_cl->getMaxGridShift());
+        m_needs_redraw = false;
+        }
 
     m_mpcd_pdata->invalidateCellCache();
     }
 
+/*!
+ * \param first_idx First index of the particles to fill
+ * 
+eturns True if the positions and tags drawn in the last fill are still valid
+ *
+ * The particles can be kept when they have the same index and tag range as in the last fill, the
+ * fill region has not changed, and the particle data has retained them since they were removed.
+ */
+bool mpcd::VirtualParticleFiller::canKeepParticles(unsigned int first_idx) const
+    {
+    if (m_needs_redraw || m_N_fill != m_last_N_fill || first_idx != m_last_first_idx
+        || m_first_tag != m_last_first_tag)
+        return false;
+
+    if (first_idx + m_N_fill > m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtualRetained())
+        return false;
+
+    return m_pdata->getBox() == m_last_box && m_cl->getCellSize() == m_last_cell.x
+           && m_cl->getMaxGridShift() == m_last_cell.y;
+    }
+
 void mpcd::VirtualParticleFiller::setDensity(Scalar density)
     {
     if (density <= Scalar(0.0))
@@ -61,6 +101,7 @@ void mpcd::VirtualParticleFiller::setDensity(Scalar density)
         throw std::runtime_error("Invalid virtual particle density");
         }
     m_density = density;
+    m_needs_redraw = true;
     }
 
 void mpcd::VirtualParticleFiller::setType(unsigned int type)
@@ -72,6 +113,7 @@ void mpcd::VirtualParticleFiller::setType(unsigned int type)
         throw std::runtime_error("Invalid type id");
         }
     m_type = type;
+    m_needs_redraw = true;
     }
 
 /*!
@@ -89,5 +131,8 @@ void mpcd::detail::export_VirtualParticleFiller(pybind11::module& m)
                       std::shared_ptr<::Variant>>())
         .def("setDensity", &mpcd::VirtualParticleFiller::setDensity)
         .def("setType", &mpcd::VirtualParticleFiller::setType)
-        .def("setTemperature", &mpcd::VirtualParticleFiller::setTemperature);
+        .def("setTemperature", &mpcd::VirtualParticleFiller::setTemperature)
+        .def_property("persistent",
+                      &mpcd::VirtualParticleFiller::getPersistent,
+                      &mpcd::VirtualParticleFiller::setPersistent);
     }
@@ -30,6 +30,11 @@ namespace mpcd
  * class must then implement two methods:
  *  1. computeNumFill(), which is the number of virtual particles to add.
  *  2. drawParticles(), which is the rule to determine where to put the particles.
+ *
+ * A persistent filler keeps the positions and tags of the virtual particles it drew last, and
+ * only redraws their velocities with drawVelocities() while the fill region, the owned particles,
+ * and the tag range are unchanged. Deriving classes can override drawVelocities() to skip drawing
+ * the positions.
  */
 class PYBIND11_EXPORT VirtualParticleFiller
     {
@@ -71,6 +76,19 @@ class PYBIND11_EXPORT VirtualParticleFiller
         m_T = T;
         }
 
+    //! Get whether the virtual particles are kept between fills
+    bool getPersistent() const
+        {
+        return m_persistent;
+        }
+
+    //! Set whether the virtual particles are kept between fills
+    void setPersistent(bool persistent)
+        {
+        m_persistent = persistent;
+        m_needs_redraw = true;
+        }
+
     protected:
     std::shared_ptr<::SystemDefinition> m_sysdef;              //!< HOOMD system definition
     std::shared_ptr<::ParticleData> m_pdata;                   //!< HOOMD particle data
@@ -86,11 +104,42 @@ class PYBIND11_EXPORT VirtualParticleFiller
     unsigned int m_N_fill;    //!< Number of particles to fill locally
     unsigned int m_first_tag; //!< First tag of locally held particles
 
+    bool m_persistent;   //!< If true, keep the positions of the virtual particles between fills
+    bool m_needs_redraw; //!< If true, the positions must be drawn on the next fill
+
     //! Compute the total number of particles to fill
     virtual void computeNumFill() { }
 
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep) { }
+
+    //! Draw only the velocities of the particles within the fill volume
+    /*!
+     * \param timestep Current timestep
+     *
+     * The positions and tags of the particles are still the ones from the last drawParticles().
+     * The default implementation redraws the particles completely.
+     */
+    virtual void drawVelocities(uint64_t timestep)
+        {
+        drawParticles(timestep);
+        }
+
+    //! Signal that the positions must be drawn on the next fill
+    void notifyRedraw()
+        {
+        m_needs_redraw = true;
+        }
+
+    private:
+    unsigned int m_last_N_fill;    //!< Number of particles filled last time
+    unsigned int m_last_first_idx; //!< First index of particles filled last time
+    unsigned int m_last_first_tag; //!< First tag of particles filled last time
+    BoxDim m_last_box;             //!< Local box of the last fill
+    Scalar2 m_last_cell;           //!< Cell size and max grid shift of the last fill
+
+    //! Check if the particles drawn last time can be kept
+    bool canKeepParticles(unsigned int first_idx) const;
     };
 
 namespace detail
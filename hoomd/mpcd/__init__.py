@@ -104,7 +104,9 @@ from hoomd.mpcd import force
 from hoomd.mpcd import init
 from hoomd.mpcd import integrate
 from hoomd.mpcd import stream
+from hoomd.mpcd import tune
 from hoomd.mpcd import update
+from hoomd.mpcd import write
 
 
 class integrator():
@@ -178,17 +180,30 @@ class integrator():
         False: _md.IntegratorAnisotropicMode.Isotropic
     }
 
-    def set_params(self, dt=None, aniso=None):
+    def set_params(self, dt=None, aniso=None, fused_streaming=None):
         """ Changes parameters of an existing integration mode.
 
         Args:
             dt (float): New time step delta (if set) (in time units).
             aniso (bool): Anisotropic integration mode (bool), default None (autodetect).
+            fused_streaming (bool): If True, fill the cells for the next collision
+                while streaming.
+
+        With *fused_streaming*, the GPU streaming step before a collision also
+        bins the particles into the cells and sums the cell momentum and energy,
+        so the :py:class:`~hoomd.mpcd.collide.srd` collision only rotates the
+        cell velocities. This saves the separate passes over the particles that
+        build the cell list and compute the cell properties. The cell sums are
+        accumulated with atomic operations, so they are not bitwise
+        reproducible. Streaming is not fused for other collision methods, with
+        virtual particles or embedded particles, in MPI simulations with more
+        than one rank, or on the CPU.
 
         Examples::
 
             integrator.set_params(dt=0.007)
             integrator.set_params(dt=0.005, aniso=False)
+            integrator.set_params(fused_streaming=True)
 
         """
         self.check_initialization()
@@ -210,6 +225,9 @@ class integrator():
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+        if fused_streaming is not None:
+            self.cpp_integrator.enableFusedStreaming(fused_streaming)
+
     def update_methods(self):
         self.check_initialization()
 
@@ -241,11 +241,13 @@ class system():
 
         self.data.initializeFromSnapshot(snapshot.sys_snap)
 
-    def set_params(self, cell=None):
+    def set_params(self, cell=None, compact_cells=None):
         R""" Set parameters of the MPCD system
 
         Args:
             cell (float): Edge length of an MPCD cell.
+            compact_cells (bool): If True, store the particles of each cell
+                contiguously in the cell list.
 
         Every MPCD system is given a cell list for binning particles (see
         :py:mod:`.mpcd.collide`). The size of the cell list sets the length
@@ -255,10 +257,26 @@ class system():
         has a different fundamental unit of length, you can adjust the
         cell size, but be aware that this will also change the fluid properties.
 
+        By default, the cell list reserves the same number of entries for every
+        cell and grows when any cell overflows. With *compact_cells*, the
+        particles are counted into their cells first and then placed one after
+        the other, so the cell list has exactly one entry per particle and never
+        needs to be rebuilt. This saves most of the memory of the cell list for
+        large systems. Set the period of :py:class:`.update.sort` to the
+        collision period to also keep the particles in cell order.
+
+        Examples::
+
+            mpcd_sys.set_params(cell=1.0)
+            mpcd_sys.set_params(compact_cells=True)
+
         """
         if cell is not None:
             self.cell.cell_size = cell
 
+        if compact_cells is not None:
+            self.cell.compact = compact_cells
+
     def take_snapshot(self, particles=True):
         R""" Takes a snapshot of the current state of the MPCD system
 
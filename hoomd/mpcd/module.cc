@@ -21,8 +21,15 @@
 #include "CellThermoComputeGPU.h"
 #endif // ENABLE_HIP
 
+// analyzers
+#include "CellFieldWriter.h"
+#ifdef ENABLE_HIP
+#include "CellFieldWriterGPU.h"
+#endif // ENABLE_HIP
+
 // integration
 #include "Integrator.h"
+#include "LoadBalancerParticles.h"
 
 // Collision methods
 #include "ATCollisionMethod.h"
@@ -123,7 +130,13 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_CellThermoComputeGPU(m);
 #endif // ENABLE_HIP
 
+    mpcd::detail::export_CellFieldWriter(m);
+#ifdef ENABLE_HIP
+    mpcd::detail::export_CellFieldWriterGPU(m);
+#endif // ENABLE_HIP
+
     mpcd::detail::export_Integrator(m);
+    mpcd::detail::export_LoadBalancerParticles(m);
 
     mpcd::detail::export_CollisionMethod(m);
     mpcd::detail::export_ATCollisionMethod(m);
@@ -322,7 +322,7 @@ class slit(_streaming_method):
             hoomd.context.current.system.getCurrentTimeStep(), self.period, 0,
             _mpcd.SlitGeometry(H, V, bc))
 
-    def set_filler(self, density, kT, seed, type='A'):
+    def set_filler(self, density, kT, seed, type='A', persistent=False):
         r""" Add virtual particles to slit channel.
 
         Args:
@@ -330,6 +330,8 @@ class slit(_streaming_method):
             kT (float): Temperature of virtual particles.
             seed (int): Seed to pseudo-random number generator for virtual particles.
             type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, keep the positions of the virtual
+                particles between collisions and only redraw their velocities.
 
         The virtual particle filler draws particles within the volume *outside* the
         slit walls that could be overlapped by any cell that is partially *inside*
@@ -346,6 +348,12 @@ class slit(_streaming_method):
 
             slit.set_filler(density=5.0, kT=1.0, seed=42)
 
+        With *persistent*, the virtual particles keep their positions until the
+        fill region, the MPCD particles on the rank, or the virtual particle
+        tags change, which saves drawing and writing the positions at each
+        collision. The cell assignment of the virtual particles still changes
+        with the random grid shift.
+
         .. versionadded:: 2.6
 
         """
@@ -366,6 +374,7 @@ class slit(_streaming_method):
             self._filler.setType(type_id)
             self._filler.setTemperature(T.cpp_variant)
             self._filler.setSeed(seed)
+        self._filler.persistent = persistent
 
     def remove_filler(self):
         """ Remove the virtual particle filler.
@@ -468,7 +477,7 @@ class slit_pore(_streaming_method):
             hoomd.context.current.system.getCurrentTimeStep(), self.period, 0,
             _mpcd.SlitPoreGeometry(H, L, bc))
 
-    def set_filler(self, density, kT, seed, type='A'):
+    def set_filler(self, density, kT, seed, type='A', persistent=False):
         r""" Add virtual particles to slit pore.
 
         Args:
@@ -476,6 +485,8 @@ class slit_pore(_streaming_method):
             kT (float): Temperature of virtual particles.
             seed (int): Seed to pseudo-random number generator for virtual particles.
             type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, keep the positions of the virtual
+                particles between collisions and only redraw their velocities.
 
         The virtual particle filler draws particles within the volume *outside* the
         slit pore boundaries that could be overlapped by any cell that is partially *inside*
@@ -491,6 +502,12 @@ class slit_pore(_streaming_method):
 
             slit_pore.set_filler(density=5.0, kT=1.0, seed=42)
 
+        With *persistent*, the virtual particles keep their positions until the
+        fill region, the MPCD particles on the rank, or the virtual particle
+        tags change, which saves drawing and writing the positions at each
+        collision. The cell assignment of the virtual particles still changes
+        with the random grid shift.
+
         """
         type_id = hoomd.context.current.mpcd.particles.getTypeByName(type)
         T = hoomd.variant._setup_variant_input(kT)
@@ -508,6 +525,7 @@ class slit_pore(_streaming_method):
             self._filler.setType(type_id)
             self._filler.setTemperature(T.cpp_variant)
             self._filler.setSeed(seed)
+        self._filler.persistent = persistent
 
     def remove_filler(self):
         """ Remove the virtual particle filler.
@@ -17,10 +17,15 @@
 HOOMD_UP_MAIN()
 
 //! Test for correct calculation of MPCD grid dimensions
+/*!
+ * If \a sparse is true, only the cells with a global x index that is a multiple of 3 are filled, so
+ * most of the communicated cells are empty.
+ */
 void cell_communicator_reduce_test(std::shared_ptr<ExecutionConfiguration> exec_conf,
                                    bool mpi_x,
                                    bool mpi_y,
-                                   bool mpi_z)
+                                   bool mpi_z,
+                                   bool sparse = false)
     {
     if (exec_conf->getPartition() != 0)
         return;
@@ -79,6 +84,11 @@ void cell_communicator_reduce_test(std::shared_ptr<ExecutionConfiguration> exec_
                     global_cell.x += 1;
                     global_cell.y += 1;
                     global_cell.z += 1;
+                    if (sparse && global_cell.x % 3 != 0)
+                        {
+                        global_cell.x = 0;
+                        global_cell.z = 0;
+                        }
 
                     h_props.data[ci(i, j, k)] = make_double3(global_cell.x,
                                                              global_cell.y,
@@ -254,6 +264,28 @@ UP_TEST(mpcd_cell_communicator_overdecompose)
     cell_communicator_overdecompose_test(exec_conf_cpu);
     }
 
+//! reduction test case with mostly empty cells, which are communicated sparsely
+UP_TEST(mpcd_cell_communicator_sparse)
+    {
+    if (!exec_conf_cpu)
+        {
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+        }
+
+    // mpi in 1d
+        {
+        exec_conf_cpu->getMPIConfig()->splitPartitions(2);
+        cell_communicator_reduce_test(exec_conf_cpu, true, false, false, true);
+        cell_communicator_reduce_test(exec_conf_cpu, false, true, false, true);
+        }
+    // mpi in 3d
+        {
+        exec_conf_cpu->getMPIConfig()->splitPartitions(8);
+        cell_communicator_reduce_test(exec_conf_cpu, true, true, true, true);
+        }
+    }
+
 #ifdef ENABLE_HIP
 //! dimension test case for MPCD CellList class
 UP_TEST(mpcd_cell_communicator_gpu)
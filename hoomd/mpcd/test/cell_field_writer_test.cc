@@ -0,0 +1,138 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/mpcd/CellFieldWriter.h"
+#ifdef ENABLE_HIP
+#include "hoomd/mpcd/CellFieldWriterGPU.h"
+#include "hoomd/mpcd/CellThermoComputeGPU.h"
+#endif // ENABLE_HIP
+
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/test/upp11_config.h"
+
+#include <cstdio>
+#include <vector>
+
+HOOMD_UP_MAIN()
+
+//! Read a chunk of the first frame
+template<class T>
+std::vector<T> read_chunk(gsd_handle& handle, const char* name, unsigned int N)
+    {
+    const gsd_index_entry* entry = gsd_find_chunk(&handle, 0, name);
+    UP_ASSERT(entry != nullptr);
+    UP_ASSERT_EQUAL(entry->N * entry->M, N);
+    std::vector<T> data(N);
+    UP_ASSERT_EQUAL(gsd_read_chunk(&handle, data.data(), entry), GSD_SUCCESS);
+    return data;
+    }
+
+//! Test that the cell fields are averaged over the window and written
+template<class CT, class W>
+void cell_field_writer_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(2.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // two particles in cell (0,0,0) and one in cell (0,1,1)
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(3);
+
+        mpcd_snap->position[0] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        mpcd_snap->position[1] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        mpcd_snap->position[2] = vec3<Scalar>(-0.5, 0.5, 0.5);
+
+        mpcd_snap->velocity[0] = vec3<Scalar>(2.0, 0.0, 0.0);
+        mpcd_snap->velocity[1] = vec3<Scalar>(1.0, 0.0, 0.0);
+        mpcd_snap->velocity[2] = vec3<Scalar>(1.0, -1.0, 4.0);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+    std::shared_ptr<CT> thermo = std::make_shared<CT>(mpcd_sys);
+
+    const std::string fname("test_mpcd_cell_fields.gsd");
+        {
+        std::shared_ptr<mpcd::CellFieldWriter> writer
+            = std::make_shared<W>(mpcd_sys, thermo, fname, 2);
+        writer->setParticleFraction(1.0);
+
+        // first sample does not write
+        writer->analyze(0);
+        UP_ASSERT_EQUAL(writer->getNumWrites(), 0);
+
+        // change the velocity of the lone particle, and take the second sample
+            {
+            ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            h_vel.data[2].x = 3.0;
+            }
+        pdata->invalidateCellCache();
+        writer->analyze(1);
+        UP_ASSERT_EQUAL(writer->getNumWrites(), 1);
+        }
+
+    gsd_handle handle;
+    UP_ASSERT_EQUAL(gsd_open(&handle, fname.c_str(), GSD_OPEN_READONLY), GSD_SUCCESS);
+    UP_ASSERT_EQUAL(gsd_get_nframes(&handle), 1);
+
+    auto dim = read_chunk<unsigned int>(handle, "cells/dimensions", 3);
+    UP_ASSERT_EQUAL(dim[0], 2);
+    UP_ASSERT_EQUAL(dim[1], 2);
+    UP_ASSERT_EQUAL(dim[2], 2);
+    auto num_samples = read_chunk<unsigned int>(handle, "cells/num_samples", 1);
+    UP_ASSERT_EQUAL(num_samples[0], 2);
+
+    auto velocity = read_chunk<float>(handle, "cells/velocity", 3 * 8);
+    auto density = read_chunk<float>(handle, "cells/density", 8);
+    auto temperature = read_chunk<float>(handle, "cells/temperature", 8);
+
+    // cell (0,0,0) is unchanged between the samples
+    CHECK_CLOSE(velocity[0], 1.5, tol);
+    CHECK_SMALL(velocity[1], tol_small);
+    CHECK_SMALL(velocity[2], tol_small);
+    CHECK_CLOSE(density[0], 2.0, tol);
+    CHECK_CLOSE(temperature[0], 2.0 * 0.5 * 0.5 / 3.0, tol);
+
+    // cell (0,1,1) is averaged, and has no temperature with one particle
+    const unsigned int idx = 0 + 2 * (1 + 2 * 1);
+    CHECK_CLOSE(velocity[3 * idx], 2.0, tol);
+    CHECK_CLOSE(velocity[3 * idx + 1], -1.0, tol);
+    CHECK_CLOSE(velocity[3 * idx + 2], 4.0, tol);
+    CHECK_CLOSE(density[idx], 1.0, tol);
+    CHECK_SMALL(temperature[idx], tol_small);
+
+    // empty cell (1,1,1)
+    CHECK_SMALL(velocity[3 * 7], tol_small);
+    CHECK_SMALL(density[7], tol_small);
+
+    // all particles are written with a fraction of 1
+    auto N = read_chunk<unsigned int>(handle, "particles/N", 1);
+    UP_ASSERT_EQUAL(N[0], 3);
+    auto tag = read_chunk<unsigned int>(handle, "particles/tag", 3);
+    UP_ASSERT_EQUAL(tag[0], 0);
+    UP_ASSERT_EQUAL(tag[1], 1);
+    UP_ASSERT_EQUAL(tag[2], 2);
+
+    gsd_close(&handle);
+    std::remove(fname.c_str());
+    }
+
+//! Test cell field writer on the CPU
+UP_TEST(mpcd_cell_field_writer)
+    {
+    cell_field_writer_test<mpcd::CellThermoCompute, mpcd::CellFieldWriter>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#ifdef ENABLE_HIP
+//! Test cell field writer on the GPU
+UP_TEST(mpcd_cell_field_writer_gpu)
+    {
+    cell_field_writer_test<mpcd::CellThermoComputeGPU, mpcd::CellFieldWriterGPU>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
+#endif // ENABLE_HIP
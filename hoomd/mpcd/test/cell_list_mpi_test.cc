@@ -10,6 +10,7 @@
 
 #include "hoomd/Communicator.h"
 #include "hoomd/SnapshotSystemData.h"
+#include "hoomd/filter/ParticleFilterAll.h"
 #include "hoomd/mpcd/Communicator.h"
 #include "hoomd/test/upp11_config.h"
 
@@ -1438,6 +1439,79 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
         }
     }
 
+//! Test that embedded particles leaving a rank are migrated when the cell list is built
+template<class CL>
+void celllist_embed_migrate_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    UP_ASSERT_EQUAL(exec_conf->getNRanks(), 8);
+
+    // one embedded particle in the middle of each rank, with tags ordered the same as the ranks
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(6.0);
+    snap->particle_data.type_mapping.push_back("A");
+        {
+        SnapshotParticleData<Scalar>& pdata_snap = snap->particle_data;
+        pdata_snap.resize(8);
+        pdata_snap.pos[0] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        pdata_snap.pos[1] = vec3<Scalar>(0.5, -0.5, -0.5);
+        pdata_snap.pos[2] = vec3<Scalar>(-0.5, 0.5, -0.5);
+        pdata_snap.pos[3] = vec3<Scalar>(0.5, 0.5, -0.5);
+        pdata_snap.pos[4] = vec3<Scalar>(-0.5, -0.5, 0.5);
+        pdata_snap.pos[5] = vec3<Scalar>(0.5, -0.5, 0.5);
+        pdata_snap.pos[6] = vec3<Scalar>(-0.5, 0.5, 0.5);
+        pdata_snap.pos[7] = vec3<Scalar>(0.5, 0.5, 0.5);
+        }
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, snap->global_box.getL(), 2, 2, 2));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+    std::shared_ptr<Communicator> pdata_comm(new Communicator(sysdef, decomposition));
+    sysdef->setCommunicator(pdata_comm);
+    std::shared_ptr<ParticleData> embed_pdata = sysdef->getParticleData();
+    std::shared_ptr<ParticleGroup> group(
+        new ParticleGroup(sysdef, std::make_shared<ParticleFilterAll>()));
+
+    auto mpcd_snap = std::make_shared<mpcd::ParticleDataSnapshot>(0);
+    auto pdata = std::make_shared<mpcd::ParticleData>(mpcd_snap,
+                                                      snap->global_box,
+                                                      exec_conf,
+                                                      decomposition);
+
+    std::shared_ptr<mpcd::CellList> cl(new CL(sysdef, pdata));
+    cl->setEmbeddedGroup(group);
+
+    // move each particle across the x boundary, out of the cells covered by its rank
+        {
+        UP_ASSERT_EQUAL(embed_pdata->getN(), 1);
+        ArrayHandle<Scalar4> h_pos(embed_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[0].x = (h_pos.data[0].x < 0) ? Scalar(1.0) : Scalar(-1.0);
+        }
+    cl->compute(0);
+
+    // each rank now owns the particle of its neighbor in x
+    const unsigned int my_rank = exec_conf->getRank();
+    UP_ASSERT_EQUAL(embed_pdata->getN(), 1);
+    UP_ASSERT_EQUAL(group->getNumMembers(), 1);
+        {
+        ArrayHandle<unsigned int> h_tag(embed_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        UP_ASSERT_EQUAL(h_tag.data[0], my_rank ^ 1);
+
+        // the origins of the - and + halves are -1 and 2, so the particle is in local cell 3 or 2
+        // along x, and 3 or 1 along y and z
+        ArrayHandle<unsigned int> h_embed_cell_ids(cl->getEmbeddedGroupCellIds(),
+                                                   access_location::host,
+                                                   access_mode::read);
+        Index3D ci = cl->getCellIndexer();
+        const unsigned int bin_x = (my_rank & 1) ? 2 : 3;
+        const unsigned int bin_y = (my_rank & 2) ? 1 : 3;
+        const unsigned int bin_z = (my_rank & 4) ? 1 : 3;
+        UP_ASSERT_EQUAL(h_embed_cell_ids.data[0], ci(bin_x, bin_y, bin_z));
+        }
+    }
+
 //! dimension test case for MPCD CellList class
 UP_TEST(mpcd_cell_list_dimensions)
     {
@@ -1482,6 +1556,13 @@ UP_TEST(mpcd_cell_list_edge_test)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! embedded particle migration test case for MPCD CellList class
+UP_TEST(mpcd_cell_list_embed_migrate_test)
+    {
+    celllist_embed_migrate_test<mpcd::CellList>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! dimension test case for MPCD CellListGPU class
 UP_TEST(mpcd_cell_list_gpu_dimensions)
@@ -1526,4 +1607,11 @@ UP_TEST(mpcd_cell_list_gpu_edge_test)
     celllist_edge_test<mpcd::CellListGPU>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! embedded particle migration test case for MPCD CellListGPU class
+UP_TEST(mpcd_cell_list_gpu_embed_migrate_test)
+    {
+    celllist_embed_migrate_test<mpcd::CellListGPU>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif // ENABLE_HIP
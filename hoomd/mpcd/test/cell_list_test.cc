@@ -661,6 +661,119 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
         }
     }
 
+//! Test that the compact cell list holds the same particles as the padded cell list
+template<class CL> void celllist_compact_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // setup a system with embedded particles in half of the cells
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(2.0);
+        {
+        SnapshotParticleData<Scalar>& pdata_snap = snap->particle_data;
+        pdata_snap.type_mapping.push_back("A");
+        pdata_snap.type_mapping.push_back("B");
+        pdata_snap.resize(4);
+        pdata_snap.pos[0] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        pdata_snap.pos[1] = vec3<Scalar>(0.5, 0.5, -0.5);
+        pdata_snap.pos[2] = vec3<Scalar>(0.5, -0.5, 0.5);
+        pdata_snap.pos[3] = vec3<Scalar>(0.5, 0.5, 0.5);
+        pdata_snap.type[0] = 1;
+        pdata_snap.type[1] = 0;
+        pdata_snap.type[2] = 1;
+        pdata_snap.type[3] = 1;
+        }
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // put more MPCD particles into the first cell than the padded cell list initially holds
+    std::shared_ptr<mpcd::ParticleData> pdata_10;
+        {
+        auto mpcd_snap = std::make_shared<mpcd::ParticleDataSnapshot>(10);
+        mpcd_snap->position[0] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        mpcd_snap->position[1] = vec3<Scalar>(0.5, 0.5, 0.5);
+        mpcd_snap->position[2] = vec3<Scalar>(-0.6, -0.4, -0.5);
+        mpcd_snap->position[3] = vec3<Scalar>(-0.5, 0.5, -0.5);
+        mpcd_snap->position[4] = vec3<Scalar>(-0.4, -0.6, -0.5);
+        mpcd_snap->position[5] = vec3<Scalar>(-0.5, -0.5, -0.6);
+        mpcd_snap->position[6] = vec3<Scalar>(0.5, -0.5, 0.5);
+        mpcd_snap->position[7] = vec3<Scalar>(-0.5, -0.5, -0.4);
+        mpcd_snap->position[8] = vec3<Scalar>(-0.3, -0.3, -0.3);
+        mpcd_snap->position[9] = vec3<Scalar>(0.5, 0.5, 0.6);
+
+        pdata_10 = std::make_shared<mpcd::ParticleData>(mpcd_snap, snap->global_box, exec_conf);
+        }
+
+    std::shared_ptr<ParticleFilter> selector_B(new ParticleFilterType({"B"}));
+    std::shared_ptr<ParticleGroup> group_B(new ParticleGroup(sysdef, selector_B));
+
+    std::shared_ptr<mpcd::CellList> cl(new CL(sysdef, pdata_10));
+    cl->setEmbeddedGroup(group_B);
+    cl->compute(0);
+
+    std::shared_ptr<mpcd::CellList> cl_compact(new CL(sysdef, pdata_10));
+    cl_compact->setEmbeddedGroup(group_B);
+    cl_compact->setCompact(true);
+    UP_ASSERT(cl_compact->isCompact());
+    cl_compact->compute(0);
+
+    // the compact cell list has one entry per particle
+    CHECK_EQUAL_UINT(cl_compact->getNCompactEntries(), 13);
+
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list(cl->getCellList(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_compact_np(cl_compact->getCellSizeArray(),
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_compact_list(cl_compact->getCellList(),
+                                                 access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> h_compact_offsets(cl_compact->getCellOffsets(),
+                                                    access_location::host,
+                                                    access_mode::read);
+
+        Index3D ci = cl_compact->getCellIndexer();
+        CHECK_EQUAL_UINT(h_compact_np.data[ci(0, 0, 0)], 7);
+        CHECK_EQUAL_UINT(h_compact_np.data[ci(1, 1, 1)], 3);
+
+        // compare the particles in each cell after sorting, since the order within a cell is
+        // not guaranteed on the GPU
+        const Index2D& cli = cl->getCellListIndexer();
+        CHECK_EQUAL_UINT(h_compact_offsets.data[0], 0);
+        for (unsigned int cell = 0; cell < cl_compact->getNCells(); ++cell)
+            {
+            const unsigned int np = h_compact_np.data[cell];
+            CHECK_EQUAL_UINT(np, h_cell_np.data[cell]);
+            CHECK_EQUAL_UINT(h_compact_offsets.data[cell + 1], h_compact_offsets.data[cell] + np);
+
+            std::vector<unsigned int> padded(np), compact(np);
+            for (unsigned int offset = 0; offset < np; ++offset)
+                {
+                padded[offset] = h_cell_list.data[cli(offset, cell)];
+                compact[offset] = h_compact_list.data[h_compact_offsets.data[cell] + offset];
+                }
+            sort(padded.begin(), padded.end());
+            sort(compact.begin(), compact.end());
+            UP_ASSERT_EQUAL(compact, padded);
+            }
+        }
+
+    // switching back to the padded cell list rebuilds it
+    cl_compact->setCompact(false);
+    UP_ASSERT(!cl_compact->isCompact());
+    cl_compact->compute(1);
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl_compact->getCellSizeArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        Index3D ci = cl_compact->getCellIndexer();
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(0, 0, 0)], 7);
+        UP_ASSERT(cl_compact->getNmax() >= 7);
+        }
+    }
+
 //! dimension test case for MPCD CellList class
 UP_TEST(mpcd_cell_list_dimensions)
     {
@@ -689,6 +802,13 @@ UP_TEST(mpcd_cell_list_embed_test)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! compact cell list test case for MPCD CellList class
+UP_TEST(mpcd_cell_list_compact_test)
+    {
+    celllist_compact_test<mpcd::CellList>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! dimension test case for MPCD CellListGPU class
 UP_TEST(mpcd_cell_list_gpu_dimensions)
@@ -717,4 +837,11 @@ UP_TEST(mpcd_cell_list_gpu_embed_test)
     celllist_embed_test<mpcd::CellListGPU>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! compact cell list test case for MPCD CellListGPU class
+UP_TEST(mpcd_cell_list_gpu_compact_test)
+    {
+    celllist_compact_test<mpcd::CellListGPU>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif // ENABLE_HIP
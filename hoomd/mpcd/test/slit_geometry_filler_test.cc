@@ -136,9 +136,60 @@ template<class F> void slit_fill_basic_test(std::shared_ptr<ExecutionConfigurati
         }
 
     /*
-     * Test the average properties of the virtual particles.
+     * Persistent virtual particles keep their positions and only redraw their velocities.
      */
     mpcd_sys->getCellList()->setCellSize(2.0);
+    filler->setPersistent(true);
+    pdata->removeVirtualParticles();
+    filler->fill(3);
+    std::vector<Scalar4> pos_old(pdata->getNVirtual());
+    std::vector<Scalar4> vel_old(pdata->getNVirtual());
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < pdata->getNVirtual(); ++i)
+            {
+            pos_old[i] = h_pos.data[pdata->getN() + i];
+            vel_old[i] = h_vel.data[pdata->getN() + i];
+            }
+        }
+    pdata->removeVirtualParticles();
+    UP_ASSERT_EQUAL(pdata->getNVirtualRetained(), pos_old.size());
+    filler->fill(4);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), pos_old.size());
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        unsigned int N_moved(0), N_redrawn(0);
+        for (unsigned int i = 0; i < pdata->getNVirtual(); ++i)
+            {
+            const unsigned int pidx = pdata->getN() + i;
+            UP_ASSERT_EQUAL(h_tag.data[pidx], pidx);
+            if (h_pos.data[pidx].x != pos_old[i].x || h_pos.data[pidx].y != pos_old[i].y
+                || h_pos.data[pidx].z != pos_old[i].z)
+                ++N_moved;
+            if (h_vel.data[pidx].x != vel_old[i].x)
+                ++N_redrawn;
+            }
+        UP_ASSERT_EQUAL(N_moved, 0);
+        UP_ASSERT_EQUAL(N_redrawn, pos_old.size());
+        }
+    // changing the fill region draws new positions
+    mpcd_sys->getCellList()->setCellSize(1.0);
+    pdata->removeVirtualParticles();
+    filler->fill(5);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 2 * (20 * 20 / 2) * 2);
+    mpcd_sys->getCellList()->setCellSize(2.0);
+    filler->setPersistent(false);
+
+    /*
+     * Test the average properties of the virtual particles.
+     */
     unsigned int N_lo(0), N_hi(0);
     Scalar3 v_lo = make_scalar3(0, 0, 0);
     Scalar3 v_hi = make_scalar3(0, 0, 0);
@@ -146,7 +197,7 @@ template<class F> void slit_fill_basic_test(std::shared_ptr<ExecutionConfigurati
     for (unsigned int t = 0; t < 500; ++t)
         {
         pdata->removeVirtualParticles();
-        filler->fill(3 + t);
+        filler->fill(6 + t);
 
         ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
         ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
@@ -5,7 +5,9 @@
 
 #include "hoomd/mpcd/ConfinedStreamingMethod.h"
 #include "hoomd/mpcd/StreamingGeometry.h"
+#include "utils.h"
 #ifdef ENABLE_HIP
+#include "hoomd/mpcd/CellThermoComputeGPU.h"
 #include "hoomd/mpcd/ConfinedStreamingMethodGPU.h"
 #endif // ENABLE_HIP
 
@@ -113,6 +115,134 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
         }
     }
 
+#ifdef ENABLE_HIP
+//! Test that streaming and filling the cells in one pass matches the separate steps
+void streaming_method_fused_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(10.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // 4 particle system, with 3 particles streaming into the same cell
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(4);
+
+        mpcd_snap->position[0] = vec3<Scalar>(0.1, 0.2, 0.3);
+        mpcd_snap->position[1] = vec3<Scalar>(0.4, 0.5, 0.6);
+        mpcd_snap->position[2] = vec3<Scalar>(0.6, 0.8, 0.1);
+        mpcd_snap->position[3] = vec3<Scalar>(4.9, -4.9, 2.0);
+
+        mpcd_snap->velocity[0] = vec3<Scalar>(1.0, 0.0, 0.0);
+        mpcd_snap->velocity[1] = vec3<Scalar>(0.0, 2.0, 0.0);
+        mpcd_snap->velocity[2] = vec3<Scalar>(0.0, 0.0, 3.0);
+        mpcd_snap->velocity[3] = vec3<Scalar>(1.0, -1.0, 2.0);
+        }
+    auto ref_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    auto fused_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+    typedef mpcd::ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry> method;
+    auto ref_stream = std::make_shared<method>(ref_sys, 0, 1, -1, geom);
+    auto fused_stream = std::make_shared<method>(fused_sys, 0, 1, -1, geom);
+    ref_stream->setDeltaT(0.1);
+    fused_stream->setDeltaT(0.1);
+
+    auto ref_thermo = std::make_shared<mpcd::CellThermoComputeGPU>(ref_sys);
+    auto fused_thermo = std::make_shared<mpcd::CellThermoComputeGPU>(fused_sys);
+    AllThermoRequest ref_req(ref_thermo);
+    AllThermoRequest fused_req(fused_thermo);
+
+    const Scalar3 shift = make_scalar3(-0.3, 0.1, -0.2);
+    ref_sys->getCellList()->setGridShift(shift);
+    fused_sys->getCellList()->setGridShift(shift);
+
+    // stream and then compute the cells separately
+    ref_stream->stream(0);
+    ref_thermo->compute(1);
+
+    // stream and fill the cells in one pass
+    UP_ASSERT(fused_stream->streamAndBin(0, 1, fused_thermo));
+
+    // the cells are already computed at the collision, so changing the velocities has no effect
+        {
+        ArrayHandle<Scalar4> h_vel(fused_sys->getParticleData()->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        const Scalar4 vel_3 = h_vel.data[3];
+        h_vel.data[3] = make_scalar4(0.0, 0.0, 0.0, vel_3.w);
+        }
+    fused_thermo->compute(1);
+        {
+        ArrayHandle<Scalar4> h_vel(fused_sys->getParticleData()->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_ref_vel(ref_sys->getParticleData()->getVelocities(),
+                                       access_location::host,
+                                       access_mode::read);
+        h_vel.data[3] = h_ref_vel.data[3];
+        }
+
+        {
+        ArrayHandle<Scalar4> h_ref_pos(ref_sys->getParticleData()->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_ref_vel(ref_sys->getParticleData()->getVelocities(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_pos(fused_sys->getParticleData()->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_vel(fused_sys->getParticleData()->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < 4; ++i)
+            {
+            CHECK_CLOSE(h_pos.data[i].x, h_ref_pos.data[i].x, tol);
+            CHECK_CLOSE(h_pos.data[i].y, h_ref_pos.data[i].y, tol);
+            CHECK_CLOSE(h_pos.data[i].z, h_ref_pos.data[i].z, tol);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_vel.data[i].w), __scalar_as_int(h_ref_vel.data[i].w));
+            }
+        }
+
+        {
+        ArrayHandle<unsigned int> h_ref_np(ref_sys->getCellList()->getCellSizeArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<double4> h_ref_cell_vel(ref_thermo->getCellVelocities(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<double3> h_ref_cell_energy(ref_thermo->getCellEnergies(),
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_np(fused_sys->getCellList()->getCellSizeArray(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<double4> h_cell_vel(fused_thermo->getCellVelocities(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<double3> h_cell_energy(fused_thermo->getCellEnergies(),
+                                           access_location::host,
+                                           access_mode::read);
+        for (unsigned int i = 0; i < fused_sys->getCellList()->getNCells(); ++i)
+            {
+            UP_ASSERT_EQUAL(h_np.data[i], h_ref_np.data[i]);
+            CHECK_CLOSE(h_cell_vel.data[i].x, h_ref_cell_vel.data[i].x, tol);
+            CHECK_CLOSE(h_cell_vel.data[i].y, h_ref_cell_vel.data[i].y, tol);
+            CHECK_CLOSE(h_cell_vel.data[i].z, h_ref_cell_vel.data[i].z, tol);
+            CHECK_CLOSE(h_cell_vel.data[i].w, h_ref_cell_vel.data[i].w, tol);
+            CHECK_CLOSE(h_cell_energy.data[i].x, h_ref_cell_energy.data[i].x, tol);
+            CHECK_CLOSE(h_cell_energy.data[i].y, h_ref_cell_energy.data[i].y, tol);
+            UP_ASSERT_EQUAL(__double_as_int(h_cell_energy.data[i].z),
+                            __double_as_int(h_ref_cell_energy.data[i].z));
+            }
+        }
+    CHECK_CLOSE(fused_thermo->getTemperature(), ref_thermo->getTemperature(), tol);
+    }
+#endif // ENABLE_HIP
+
 //! basic test case for MPCD StreamingMethod class
 UP_TEST(mpcd_streaming_method_basic)
     {
@@ -128,4 +258,11 @@ UP_TEST(mpcd_streaming_method_setup)
     streaming_method_basic_test<method>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
+
+//! test case for streaming and filling the cells in one pass
+UP_TEST(mpcd_streaming_method_fused)
+    {
+    streaming_method_fused_test(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
 #endif // ENABLE_HIP
@@ -0,0 +1,95 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+R""" MPCD tuners
+
+Balance the MPI domains for the MPCD particles.
+
+"""
+
+import hoomd
+
+from . import _mpcd
+
+
+class LoadBalancer(hoomd.tune.LoadBalancer):
+    R""" Balance the MPCD and MD particles between the MPI domains.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            perform load balancing.
+        system (:py:class:`hoomd.mpcd.data.system`): MPCD system to balance.
+        weight (float): Cost of one MPCD particle relative to one MD
+            particle.
+        x (`bool`): Balance the **x** direction when `True`.
+        y (`bool`): Balance the **y** direction when `True`.
+        z (`bool`): Balance the **z** direction when `True`.
+        tolerance (`float`): Load imbalance tolerance.
+        max_iterations (`int`): Maximum number of iterations to
+            attempt in a single step.
+        cost (`str`): Quantity to balance, ``'particles'`` or ``'time'``.
+
+    `LoadBalancer` works like `hoomd.tune.LoadBalancer`, but adds the MPCD
+    particles to the load of each rank. Each MPCD particle counts as *weight*
+    MD particles, so the load of rank :math:`i` is
+
+    .. math::
+
+        N_i + w N_{\mathrm{MPCD},i}
+
+    where :math:`N_{\mathrm{MPCD},i}` is the number of MPCD particles that
+    rank :math:`i` owns and :math:`w` is the *weight*. The MPCD solvent usually
+    outnumbers the solute, so balancing the MD particles alone can leave the
+    solvent unevenly distributed. With *cost* ``'time'``, the measured time of
+    the MPCD collisions and streaming is included in the cost of the rank.
+
+    The domain boundaries are placed on the MPCD cell grid, and each domain is
+    kept at least one cell plus the maximum grid shift on either side wide, so
+    that the MPCD particles are only exchanged with the nearest neighbors.
+
+    Example::
+
+        balancer = mpcd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(1000),
+                                          system=s,
+                                          weight=0.2)
+        sim.operations.tuners.append(balancer)
+
+    Attributes:
+        weight (float): Cost of one MPCD particle relative to one MD particle.
+
+    """
+
+    def __init__(self,
+                 trigger,
+                 system,
+                 weight=1.0,
+                 x=True,
+                 y=True,
+                 z=True,
+                 tolerance=1.02,
+                 max_iterations=1,
+                 cost='particles'):
+        super().__init__(trigger, x, y, z, tolerance, max_iterations, cost)
+        self._mpcd_system = system
+        self._weight = float(weight)
+        self._particles = None
+
+    def _attach(self):
+        super()._attach()
+        self._particles = _mpcd.LoadBalancerParticles(self._mpcd_system.data,
+                                                      self._weight)
+        self._cpp_obj.setParticles(self._particles)
+
+    def _detach(self):
+        self._particles = None
+        super()._detach()
+
+    @property
+    def weight(self):
+        return self._weight
+
+    @weight.setter
+    def weight(self, value):
+        self._weight = float(value)
+        if self._particles is not None:
+            self._particles.weight = self._weight
@@ -0,0 +1,103 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+R""" MPCD writers
+
+Write MPCD cell fields and solvent particles without gathering the MPCD snapshot.
+
+"""
+
+import hoomd
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.operation import Writer
+
+from . import _mpcd
+
+
+class CellFields(Writer):
+    R""" Write time-averaged MPCD cell fields.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample the cells.
+        system (:py:class:`hoomd.mpcd.data.system`): MPCD system to write.
+        filename (str): Base file name to write.
+        num_samples (int): Number of samples averaged in each frame.
+        particle_fraction (float): Fraction of the MPCD particles to write in
+            each frame.
+
+    Each time `CellFields` triggers, it samples the mass-weighted velocity, the
+    number density, and the temperature of the MPCD cells. After *num_samples*
+    samples, it writes their averages as one frame. The temperature of a cell
+    is averaged over the samples when the cell had at least two particles.
+
+    Each MPI rank writes the cells it owns to its own GSD file
+    ``f'{filename}.{rank}'`` (or *filename* on a single rank), so neither the
+    cells nor the particles are gathered. The files use the schema
+    ``hoomd_mpcd_fields``. Each frame has the chunks:
+
+    * ``configuration/step`` and ``configuration/box``.
+    * ``cells/global_dimensions``: Number of cells in the global box.
+    * ``cells/dimensions`` and ``cells/origin``: Number of cells written by
+      this rank and the global index of the first one.
+    * ``cells/size`` and ``cells/num_samples``.
+    * ``cells/velocity``, ``cells/density``, and ``cells/temperature``: The
+      averages, with the x index varying fastest.
+
+    When *particle_fraction* is positive, each frame also has the positions,
+    velocities, type ids, and tags of a random subsample of the MPCD particles
+    in ``particles/``. The subsample is chosen from the particle tags, so the
+    same particles are written in every frame.
+
+    Example::
+
+        fields = mpcd.write.CellFields(trigger=hoomd.trigger.Periodic(10),
+                                       system=s,
+                                       filename='fields.gsd',
+                                       num_samples=100,
+                                       particle_fraction=0.001)
+        sim.operations.writers.append(fields)
+
+    Note:
+        The cells are binned with the random grid shift of the last collision.
+
+    Attributes:
+        filename (str): Base file name to write.
+        num_samples (int): Number of samples averaged in each frame.
+        particle_fraction (float): Fraction of the MPCD particles to write in
+            each frame.
+
+    """
+
+    def __init__(self,
+                 trigger,
+                 system,
+                 filename,
+                 num_samples=1,
+                 particle_fraction=0.0):
+        super().__init__(trigger)
+        self._mpcd_system = system
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          num_samples=int(num_samples),
+                          particle_fraction=float(particle_fraction)))
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_class = _mpcd.CellFieldWriter
+        else:
+            cpp_class = _mpcd.CellFieldWriterGPU
+        # all ranks must write next to the file of rank 0
+        filename = _hoomd.mpi_bcast_str(self.filename,
+                                        self._simulation.device._cpp_exec_conf)
+        self._cpp_obj = cpp_class(self._mpcd_system.data,
+                                  self._mpcd_system._thermo, filename,
+                                  self.num_samples)
+        super()._attach()
+
+    @property
+    def num_writes(self):
+        """int: Number of frames written since the writer was attached."""
+        if not self._attached:
+            return 0
+        return self._cpp_obj.num_writes
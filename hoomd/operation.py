@@ -222,6 +222,9 @@ class _HOOMDBaseObject(_HOOMDGetSetAttrBase,
             except (AttributeError):
                 self._param_dict[attr] = old_value
                 raise MutabilityError(attr)
+            # the new trigger may be active before the step System skips to
+            if attr == 'trigger':
+                self._simulation._cpp_sys.resetTriggerSteps()
 
     def _detach(self):
         if self._attached:
@@ -356,6 +359,8 @@ class _TriggeredOperation(Operation):
                 # location (python's is), replace with new trigger
                 if op is self._cpp_obj and trigger is old_trigger:
                     triggered_ops[index] = (op, new_trigger)
+            # the new trigger may be active before the step System skips to
+            sys.resetTriggerSteps()
 
     def _attach(self):
         super()._attach()
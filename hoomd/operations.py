@@ -29,6 +29,26 @@ def _triggered_op_conversion(value):
     return (value._cpp_obj, value.trigger)
 
 
+class _TriggeredSyncedList(syncedlist.SyncedList):
+    """Synced list of operations that `hoomd.Simulation.run` triggers.
+
+    System skips the steps before the first step on which any trigger may be
+    active. Added operations may be active earlier, so the lists reset these
+    bounds when synced. Removing operations leaves bounds that are too early,
+    which are harmless.
+    """
+
+    def __setitem__(self, index, value):
+        super().__setitem__(index, value)
+        if self._synced:
+            self._simulation._cpp_sys.resetTriggerSteps()
+
+    def insert(self, index, value):
+        super().insert(index, value)
+        if self._synced:
+            self._simulation._cpp_sys.resetTriggerSteps()
+
+
 class Operations(Collection):
     """A mutable collection of operations which act on a `hoomd.Simulation`.
 
@@ -68,10 +88,10 @@ class Operations(Collection):
     def __init__(self):
         self._scheduled = False
         self._simulation = None
-        self._updaters = syncedlist.SyncedList(Updater,
-                                               _triggered_op_conversion)
-        self._writers = syncedlist.SyncedList(Writer, _triggered_op_conversion)
-        self._tuners = syncedlist.SyncedList(
+        self._updaters = _TriggeredSyncedList(Updater,
+                                              _triggered_op_conversion)
+        self._writers = _TriggeredSyncedList(Writer, _triggered_op_conversion)
+        self._tuners = _TriggeredSyncedList(
             Tuner, syncedlist._PartialGetAttr('_cpp_obj'))
         self._computes = syncedlist.SyncedList(
             Compute, syncedlist._PartialGetAttr('_cpp_obj'))
@@ -42,6 +42,16 @@ class DummyCppObj:
     def getTypeParam(self, type_):  # noqa: N802
         return self._dict[type_]
 
+    def setTypeParamBulk(self, types, values):  # noqa: N802
+        self.bulk_calls = getattr(self, 'bulk_calls', 0) + 1
+        for i, type_ in enumerate(types):
+            if isinstance(values, dict):
+                self._dict[type_] = {
+                    name: column[i] for name, column in values.items()
+                }
+            else:
+                self._dict[type_] = values[i]
+
     @property
     def param1(self):
         return self._param1
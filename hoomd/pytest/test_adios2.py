@@ -0,0 +1,75 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+def test_not_enabled(simulation_factory, two_particle_snapshot_factory,
+                     tmp_path):
+    if hoomd.version.adios2_enabled:
+        pytest.skip("HOOMD-blue is built with ADIOS2")
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    writer = hoomd.write.ADIOS2(filename=tmp_path / "test.bp",
+                                trigger=hoomd.trigger.Periodic(1))
+    sim.operations.writers.append(writer)
+    with pytest.raises(RuntimeError):
+        sim.run(0)
+
+
+def test_attributes():
+    writer = hoomd.write.ADIOS2(filename="test.bp",
+                                trigger=hoomd.trigger.Periodic(10),
+                                engine='SST',
+                                parameters=dict(RendezvousReaderCount=0),
+                                dynamic=['momentum'])
+    assert writer.filename == "test.bp"
+    assert writer.engine == 'SST'
+    assert writer.parameters == dict(RendezvousReaderCount='0')
+    assert list(writer.dynamic) == ['momentum']
+
+    with pytest.raises(ValueError):
+        hoomd.write.ADIOS2(filename="test.bp",
+                           trigger=hoomd.trigger.Periodic(10),
+                           dynamic=['topology'])
+
+
+def test_write(simulation_factory, lattice_snapshot_factory, tmp_path):
+    if not hoomd.version.adios2_enabled:
+        pytest.skip("HOOMD-blue is not built with ADIOS2")
+    adios2 = pytest.importorskip("adios2")
+    if not hasattr(adios2, 'Stream'):
+        pytest.skip("adios2 Python package is too old")
+
+    snap = lattice_snapshot_factory(n=4, a=2.0)
+    sim = simulation_factory(snap)
+    filename = str(tmp_path / "test.bp")
+
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger.add(sim, quantities=['timestep'])
+    timestep_name = '/'.join(('log',) + next(iter(logger.keys())))
+    writer = hoomd.write.ADIOS2(filename=filename,
+                                trigger=hoomd.trigger.Periodic(1),
+                                log=logger)
+    sim.operations.writers.append(writer)
+    sim.run(3)
+
+    # close the engine
+    sim.operations.writers.remove(writer)
+    del writer
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        steps = []
+        with adios2.Stream(filename, 'r') as stream:
+            for _ in stream.steps():
+                steps.append(int(stream.read('configuration/step')))
+                assert int(stream.read(timestep_name)) == steps[-1]
+
+                tag = stream.read('particles/tag')
+                position = stream.read('particles/position')
+                np.testing.assert_array_equal(np.sort(tag),
+                                              np.arange(snap.particles.N))
+                np.testing.assert_allclose(position[np.argsort(tag)],
+                                           snap.particles.position,
+                                           rtol=1e-6)
+        assert len(steps) == 3
@@ -0,0 +1,141 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+import threading
+
+import numpy
+import pytest
+
+import hoomd
+import hoomd.write
+from hoomd.conftest import operation_pickling_check
+from hoomd.logging import LoggerCategories
+
+
+def count_particles(timestep, data):
+    return timestep, len(data['position']), data['box'].Lx
+
+
+def test_attributes():
+    analyzer = hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(10),
+                                         count_particles,
+                                         quantities=['position', 'tag'])
+    assert analyzer.analyze is count_particles
+    assert analyzer.quantities == ('position', 'tag')
+    assert analyzer.max_queue_depth == 2
+    assert analyzer.num_pending == 0
+
+    analyzer.max_queue_depth = 4
+    assert analyzer.max_queue_depth == 4
+
+    with pytest.raises(ValueError):
+        analyzer.max_queue_depth = 0
+    with pytest.raises(ValueError):
+        hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(10),
+                                  count_particles,
+                                  quantities=['net_force'])
+    with pytest.raises(ValueError):
+        hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(10), 42)
+
+
+def test_analyze(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(L=20))
+
+    timesteps = []
+
+    def analyze(timestep, data):
+        timesteps.append(timestep)
+        return count_particles(timestep, data)
+
+    analyzer = hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(1), analyze)
+    sim.operations.writers.append(analyzer)
+    sim.run(5)
+    analyzer.wait()
+
+    # the analyses run in the order of submission
+    assert timesteps == [1, 2, 3, 4, 5]
+    assert analyzer.num_pending == 0
+    assert analyzer.result_timestep == 5
+    timestep, N, Lx = analyzer.result
+    assert timestep == 5
+    assert Lx == 20
+    with sim.state.cpu_local_snapshot as snap:
+        assert N == len(snap.particles.position)
+
+
+@pytest.mark.serial
+def test_data_is_copied(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(d=1))
+    sim.operations.writers.append(
+        hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(1),
+                                  lambda timestep, data: data,
+                                  quantities=['position', 'tag']))
+    sim.run(1)
+    analyzer = sim.operations.writers[0]
+    analyzer.wait()
+
+    data = analyzer.result
+    with sim.state.cpu_local_snapshot as snap:
+        numpy.testing.assert_allclose(data['position'], snap.particles.position)
+        numpy.testing.assert_array_equal(data['tag'], snap.particles.tag)
+        snap.particles.position[:, 0] += 1
+
+    # the copy does not change with the simulation
+    with sim.state.cpu_local_snapshot as snap:
+        assert not numpy.allclose(data['position'], snap.particles.position)
+
+
+def test_bounded_queue(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    release = threading.Event()
+
+    def analyze(timestep, data):
+        release.wait()
+        return timestep
+
+    analyzer = hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(1),
+                                         analyze,
+                                         max_queue_depth=3)
+    sim.operations.writers.append(analyzer)
+
+    # the analyses are blocked, so the run fills the queue and then waits
+    timer = threading.Timer(0.5, release.set)
+    timer.start()
+    sim.run(10)
+    timer.join()
+    assert analyzer.num_pending <= 3
+
+    analyzer.wait()
+    assert analyzer.result == 10
+
+
+def test_exception(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+
+    def analyze(timestep, data):
+        raise ValueError("analysis failed")
+
+    analyzer = hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(1), analyze)
+    sim.operations.writers.append(analyzer)
+
+    with pytest.raises(ValueError):
+        sim.run(1)
+        analyzer.wait()
+
+
+def test_logging():
+    analyzer = hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(1),
+                                         count_particles)
+    assert set(analyzer._export_dict.keys()) == {'result'}
+    quantity = analyzer._export_dict['result']
+    assert quantity.category == LoggerCategories.object
+    assert quantity.default
+    assert quantity.namespace[-1] == 'AsyncAnalyzer'
+
+
+def test_pickling(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    analyzer = hoomd.write.AsyncAnalyzer(hoomd.trigger.Periodic(1),
+                                         count_particles)
+    operation_pickling_check(analyzer, sim)
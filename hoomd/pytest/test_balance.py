@@ -34,6 +34,10 @@ def test_balance_properties():
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.cost == 'particles'
+    balance.cost = 'time'
+    assert balance.cost == 'time'
+
 
 def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -72,6 +76,10 @@ def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.cost == 'particles'
+    balance.cost = 'time'
+    assert balance.cost == 'time'
+
     sim.operations.tuners.remove(balance)
 
 
@@ -111,3 +119,52 @@ def test_balance_action(device, simulation_factory, lattice_snapshot_factory):
 
     # the load balance should move the split place down toward the particles
     assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+
+
+def test_balance_time(device, simulation_factory, lattice_snapshot_factory):
+    """Test that the load balancer runs when balancing the force time."""
+    snapshot = lattice_snapshot_factory(n=10)
+    sim = simulation_factory(snapshot)
+    N = sim.state.N_particles
+
+    integrator = hoomd.md.Integrator(dt=0.005)
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=1.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.NVE(filter=hoomd.filter.All()))
+    sim.operations.integrator = integrator
+
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(2),
+                                      tolerance=0.5,
+                                      cost='time')
+    sim.operations.tuners.append(balance)
+    sim.run(6)
+
+    assert balance.cost == 'time'
+    assert sim.state.N_particles == N
+
+
+def test_split_fractions(device, lattice_snapshot_factory):
+    """Test that split_fractions places the boundaries at the quantiles."""
+    snapshot = lattice_snapshot_factory(n=10)
+    if snapshot.communicator.rank == 0:
+        # move the particles into the lower 40% of the box in x
+        box = snapshot.configuration.box
+        snapshot.particles.position[:, 0] = (
+            snapshot.particles.position[:, 0] + box[0] / 2) * 0.4 - box[0] / 2
+
+    fractions = hoomd.tune.split_fractions(snapshot, (2, 1, 2))
+    assert len(fractions[0]) == 2
+    assert len(fractions[1]) == 1
+    assert len(fractions[2]) == 2
+    for f in fractions:
+        assert sum(f) == pytest.approx(1.0)
+
+    if snapshot.communicator.rank == 0:
+        assert fractions[0][0] < 0.3
+        assert fractions[2][0] == pytest.approx(0.5, abs=0.06)
+
+    with pytest.raises(ValueError):
+        hoomd.tune.split_fractions(snapshot, (0, 1, 1))
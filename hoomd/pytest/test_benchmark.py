@@ -0,0 +1,112 @@
+import json
+
+import pytest
+
+import hoomd
+import hoomd.benchmark
+from hoomd.benchmark.__main__ import main
+
+if not hoomd.version.md_built:
+    pytest.skip("The benchmark workloads require hoomd.md",
+                allow_module_level=True)
+
+
+def test_run_benchmark(device):
+    sim = hoomd.benchmark.lj_liquid(device, N=1000)
+    result = hoomd.benchmark.run_benchmark(sim,
+                                           steps=10,
+                                           warmup_steps=10,
+                                           repeat=2,
+                                           compute_iterations=2)
+
+    assert result['N'] == 1000
+    assert result['steps'] == 10
+    assert len(result['tps']) == 2
+    assert result['tps_mean'] > 0
+    assert 'LJ' in result['compute_ms']
+    assert 'Cell' in result['compute_ms']
+    assert result['max_rss_bytes'] > 0
+
+
+@pytest.mark.parametrize('name', ['polymer_melt', 'pppm_electrolyte'])
+def test_workloads(device, name):
+    sim = hoomd.benchmark.workloads[name](device, N=1000)
+    sim.run(10)
+    assert sim.state.N_particles == 1000
+
+
+@pytest.mark.parametrize('name', [
+    'mpcd_srd', 'mpcd_at', 'mpcd_couette', 'mpcd_slit_pore', 'mpcd_polymer'
+])
+def test_mpcd_workloads(device, name):
+    if not hoomd.version.mpcd_built:
+        pytest.skip("The MPCD workloads require hoomd.mpcd")
+
+    kwargs = {}
+    if name == 'mpcd_polymer':
+        kwargs = dict(N_polymer=40, chain_length=4)
+    sim = hoomd.benchmark.workloads[name](device, N=5000, **kwargs)
+    result = hoomd.benchmark.run_benchmark(sim,
+                                           steps=10,
+                                           warmup_steps=0,
+                                           repeat=1,
+                                           compute_iterations=1)
+
+    assert result['N_mpcd'] > 4000
+    assert result['N_mpcd'] == sim.operations.integrator.N_mpcd
+    assert result['pups_mean'] == pytest.approx(
+        result['tps_mean'] * (result['N'] + result['N_mpcd']))
+
+
+def test_cli(tmp_path):
+    output = tmp_path / 'benchmark.json'
+    main([
+        '--workloads', 'lj_liquid_0.6', '-N', '1000', '--steps', '10',
+        '--warmup-steps', '0', '--repeat', '1', '--output',
+        str(output)
+    ])
+
+    if hoomd.communicator.Communicator().rank == 0:
+        results = json.loads(output.read_text())
+        assert results['hoomd']['version'] == hoomd.version.version
+        assert results['workloads']['lj_liquid_0.6']['N'] == 1000
+
+
+def test_scaling_rank(device, tmp_path):
+    from hoomd.benchmark import scaling
+
+    if device.communicator.num_ranks > 1:
+        pytest.skip("The ranks do not share tmp_path")
+
+    scaling.run_scaling_rank(device,
+                             'lj_liquid_0.6',
+                             str(tmp_path),
+                             N=1000,
+                             steps=10,
+                             warmup_steps=0)
+    result = json.loads((tmp_path / 'rank0.json').read_text())
+    assert result['N'] == 1000
+    assert result['N_local'] == 1000
+    assert result['tps'] > 0
+    assert set(result['comm_time']) == set(scaling.communication_phases)
+
+
+def test_scaling_efficiency():
+    from hoomd.benchmark import scaling
+
+    points = [
+        dict(num_ranks=1, tps=100.0),
+        dict(num_ranks=2, tps=180.0),
+        dict(num_ranks=4, tps=200.0)
+    ]
+    assert scaling.parallel_efficiency(points) == pytest.approx(
+        [1.0, 0.9, 0.5])
+
+    baseline = dict(workloads=dict(
+        lj=[dict(num_ranks=n, efficiency=e) for n, e in [(1, 1.0), (2, 0.9)]]))
+    results = dict(workloads=dict(
+        lj=[dict(num_ranks=n, efficiency=e) for n, e in [(1, 1.0), (2, 0.7)]]))
+    assert scaling.compare_scaling(baseline, baseline) == []
+    regressions = scaling.compare_scaling(results, baseline, tolerance=0.1)
+    assert len(regressions) == 1
+    assert 'lj on 2 ranks' in regressions[0]
@@ -0,0 +1,148 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+import numpy
+import pytest
+
+import hoomd
+import hoomd.write
+from hoomd.conftest import operation_pickling_check
+
+
+class Identity:
+
+    def __init__(self, x):
+        self.x = x
+
+    def __call__(self):
+        return self.x
+
+    def __eq__(self, other):
+        return self.x == other.x
+
+
+class Counter:
+
+    def __init__(self, values):
+        self.values = values
+        self.i = -1
+
+    def __call__(self):
+        self.i += 1
+        return self.values[self.i % len(self.values)]
+
+    def __eq__(self, other):
+        return self.values == other.values
+
+
+@pytest.fixture
+def logger():
+    logger = hoomd.logging.Logger(categories=['scalar', 'sequence'])
+    logger[('dummy', 'loggable', 'int')] = (Identity(42), 'scalar')
+    logger[('dummy', 'loggable', 'float')] = (Counter([1.0, -1.0]), 'scalar')
+    logger[('dummy', 'loggable', 'vector')] = (Identity([1.5, 2.5, 3.5]),
+                                               'sequence')
+    return logger
+
+
+def test_invalid_logger():
+    with pytest.raises(ValueError):
+        hoomd.write.BinaryLog(1, hoomd.logging.Logger(categories=['string']),
+                              'log.bin')
+    with pytest.raises(ValueError):
+        hoomd.write.BinaryLog(1, hoomd.logging.Logger(), 'log.bin')
+
+
+@pytest.mark.serial
+def test_records(tmp_path, logger):
+    filename = str(tmp_path / 'log.bin')
+    writer = hoomd.write.BinaryLog(1, logger, filename, buffer_size=3)
+    for timestep in range(10):
+        writer.write(timestep)
+
+    # full buffers are written, the last record is still buffered
+    assert len(hoomd.write.BinaryLog.read(filename)) == 9
+    writer.flush()
+
+    data = hoomd.write.BinaryLog.read(filename)
+    assert data.dtype.names == ('timestep', 'dummy/loggable/int',
+                                'dummy/loggable/float',
+                                'dummy/loggable/vector')
+    numpy.testing.assert_array_equal(data['timestep'], range(10))
+    assert data['dummy/loggable/int'].dtype == numpy.int64
+    numpy.testing.assert_array_equal(data['dummy/loggable/int'], 42)
+    numpy.testing.assert_array_equal(data['dummy/loggable/float'],
+                                     [1.0, -1.0] * 5)
+    assert data['dummy/loggable/vector'].shape == (10, 3)
+    numpy.testing.assert_array_equal(data['dummy/loggable/vector'][-1],
+                                     [1.5, 2.5, 3.5])
+
+
+@pytest.mark.serial
+def test_append(tmp_path, logger):
+    filename = str(tmp_path / 'log.bin')
+    writer = hoomd.write.BinaryLog(1, logger, filename, mode='wb')
+    writer.write(0)
+    writer.flush()
+
+    writer = hoomd.write.BinaryLog(1, logger, filename, mode='ab')
+    writer.write(1)
+    writer.flush()
+    data = hoomd.write.BinaryLog.read(filename)
+    numpy.testing.assert_array_equal(data['timestep'], [0, 1])
+
+    # partial records from interrupted writes are dropped when appending
+    with open(filename, 'ab') as f:
+        f.write(b'\0' * 5)
+    writer = hoomd.write.BinaryLog(1, logger, filename, mode='ab')
+    writer.write(2)
+    writer.flush()
+    data = hoomd.write.BinaryLog.read(filename)
+    numpy.testing.assert_array_equal(data['timestep'], [0, 1, 2])
+
+    # the quantities in the file must match
+    other_logger = hoomd.logging.Logger(categories=['scalar'])
+    other_logger[('dummy', 'other')] = (Identity(1.0), 'scalar')
+    writer = hoomd.write.BinaryLog(1, other_logger, filename, mode='ab')
+    writer.write(3)
+    with pytest.raises(RuntimeError):
+        writer.flush()
+
+    with pytest.raises(FileExistsError):
+        writer = hoomd.write.BinaryLog(1, logger, filename, mode='xb')
+        writer.write(0)
+        writer.flush()
+
+
+def test_quantities_cannot_change(tmp_path, logger):
+    writer = hoomd.write.BinaryLog(1, logger, str(tmp_path / 'log.bin'))
+    writer.write(0)
+    logger[('dummy', 'new')] = (Identity(1.0), 'scalar')
+    with pytest.raises(RuntimeError):
+        writer.write(1)
+
+
+def test_accumulator(tmp_path, logger):
+    writer = hoomd.write.BinaryLog(1,
+                                   logger,
+                                   str(tmp_path / 'log.bin'),
+                                   max_lag=2)
+    for timestep in range(100):
+        writer.write(timestep)
+
+    mean = writer.mean
+    assert set(mean.keys()) == {'dummy/loggable/int', 'dummy/loggable/float'}
+    assert mean['dummy/loggable/int'] == pytest.approx(42)
+    assert mean['dummy/loggable/float'] == pytest.approx(0)
+
+    acf = writer.autocorrelation
+    numpy.testing.assert_allclose(acf['dummy/loggable/int'], 0, atol=1e-8)
+    numpy.testing.assert_allclose(acf['dummy/loggable/float'], [1, -1, 1])
+
+
+def test_pickling(simulation_factory, two_particle_snapshot_factory, logger,
+                  tmp_path):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    writer = hoomd.write.BinaryLog(1, logger, str(tmp_path / 'log.bin'))
+    operation_pickling_check(writer, sim)
@@ -0,0 +1,92 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+def assert_same_snapshots(a, b):
+    assert a.configuration.box == b.configuration.box
+    assert a.particles.N == b.particles.N
+    assert a.particles.types == b.particles.types
+    for name in ('position', 'velocity', 'acceleration', 'typeid', 'mass',
+                 'charge', 'diameter', 'image', 'body', 'orientation',
+                 'angmom', 'moment_inertia'):
+        np.testing.assert_array_equal(getattr(a.particles, name),
+                                      getattr(b.particles, name))
+    assert a.bonds.N == b.bonds.N
+    assert a.bonds.types == b.bonds.types
+    np.testing.assert_array_equal(a.bonds.typeid, b.bonds.typeid)
+    np.testing.assert_array_equal(a.bonds.group, b.bonds.group)
+
+
+@pytest.fixture
+def checkpoint_snapshot(lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=4, r=0.1)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(seed=4)
+        snap.particles.typeid[:] = rng.integers(0, 2, snap.particles.N)
+        snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+        snap.particles.charge[:] = rng.normal(size=snap.particles.N)
+        snap.particles.image[:] = rng.integers(-2, 3, (snap.particles.N, 3))
+        snap.bonds.N = 2
+        snap.bonds.types = ['b']
+        snap.bonds.typeid[:] = [0, 0]
+        snap.bonds.group[:] = [[0, 1], [2, 3]]
+    return snap
+
+
+def test_attach(simulation_factory, checkpoint_snapshot, tmp_path):
+    filename = str(tmp_path / "checkpoint")
+    sim = simulation_factory(checkpoint_snapshot)
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(5),
+                                        filename=filename)
+    sim.operations.writers.append(checkpoint)
+    assert checkpoint.num_writes == 0
+
+    sim.run(10)
+    assert checkpoint.num_writes == 2
+    assert checkpoint.filename == filename
+
+
+def test_restart(simulation_factory, checkpoint_snapshot, tmp_path):
+    filename = str(tmp_path / "checkpoint")
+    sim = simulation_factory(checkpoint_snapshot)
+    sim.seed = 12
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(1),
+                                        filename=filename)
+    sim.operations.writers.append(checkpoint)
+    sim.run(3)
+    snap = sim.state.get_snapshot()
+
+    restarted = simulation_factory()
+    restarted.create_state_from_checkpoint(filename)
+    assert restarted.timestep == sim.timestep
+    assert restarted.seed == 12
+
+    restarted_snap = restarted.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        assert_same_snapshots(snap, restarted_snap)
+
+
+@pytest.mark.skipif(not hoomd.version.md_built, reason="MD not built")
+def test_restore_operations(simulation_factory, checkpoint_snapshot, tmp_path):
+    filename = str(tmp_path / "checkpoint")
+
+    def make_integrator():
+        nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+        return hoomd.md.Integrator(dt=0.001, methods=[nvt])
+
+    sim = simulation_factory(checkpoint_snapshot)
+    sim.operations.integrator = make_integrator()
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(5),
+                                        filename=filename)
+    sim.operations.writers.append(checkpoint)
+    sim.run(5)
+    method = sim.operations.integrator.methods[0]
+    dof = method.translational_thermostat_dof
+
+    restarted = simulation_factory()
+    restarted.create_state_from_checkpoint(filename)
+    restarted.operations.integrator = make_integrator()
+    hoomd.write.Checkpoint.restore_operations(restarted, filename)
+    restarted_method = restarted.operations.integrator.methods[0]
+    assert restarted_method.translational_thermostat_dof == pytest.approx(dof)
@@ -44,6 +44,37 @@ def test_write(simulation_factory, two_particle_snapshot_factory, tmp_path):
                 np.testing.assert_allclose(traj[i].position[j], positions[i][j])
 
 
+def test_header_update_period(simulation_factory,
+                               two_particle_snapshot_factory, tmp_path):
+    filename = tmp_path / "temporary_test_file.dcd"
+    sim = simulation_factory(two_particle_snapshot_factory())
+    dcd_dump = hoomd.write.DCD(filename=filename,
+                               trigger=hoomd.trigger.Periodic(1),
+                               filter=hoomd.filter.Tags([1]),
+                               header_update_period=4)
+    sim.operations.add(dcd_dump)
+    sim.run(10)
+    assert dcd_dump.header_update_period == 4
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        data = np.fromfile(filename, dtype=np.uint8)
+        header = data[:272].view(np.uint32)
+        # Simulation.run updates the number of frames and the last step
+        assert header[2] == 10
+        assert header[5] == 10
+        # only the selected particle is written
+        assert header[67] == 1
+
+        # the last frame holds the coordinates of particle 1
+        frame_size = 56 + 3 * 12
+        frame = data[272 + 9 * frame_size:272 + 10 * frame_size]
+        coords = frame[56:].view(np.float32).reshape(3, 3)[:, 1]
+        np.testing.assert_allclose(coords,
+                                   snap.particles.position[1],
+                                   rtol=1e-6)
+
+
 def test_pickling(simulation_factory, two_particle_snapshot_factory, tmp_path):
     filename = tmp_path / "temporary_test_file.dcd"
     sim = simulation_factory(two_particle_snapshot_factory())
@@ -1,4 +1,6 @@
 import hoomd
+import json
+import numpy
 import pytest
 
 
@@ -48,6 +50,89 @@ def test_common_properties(device, tmp_path):
                               num_cpu_threads=10)
 
 
+def test_msg_buffered_per_rank(device, tmp_path):
+    assert not device.msg_buffered
+    assert not device.msg_per_rank
+
+    device.msg_buffered = True
+    assert device.msg_buffered
+
+    filename = str(tmp_path / "messages.txt")
+    device.msg_per_rank = True
+    device.msg_file = filename
+    device.notice_level = 2
+    device._cpp_msg.notice(1, "buffered notice\n")
+    device.msg_buffered = False
+    assert not device.msg_buffered
+
+    rank = device.communicator.rank
+    with open(f'{filename}.{rank}') as f:
+        assert f.read() == "buffered notice\n"
+
+    device.msg_file = None
+
+
+def test_pin_cpu_threads():
+    cores = hoomd.device.CPU().cpu_cores
+    assert all(isinstance(core, int) for core in cores)
+
+    device = hoomd.device.CPU(pin_cpu_threads=True)
+    if not hoomd.version.tbb_enabled:
+        assert not device.pin_cpu_threads
+        return
+
+    assert device.pin_cpu_threads
+    device.num_cpu_threads = 2
+    assert device.pin_cpu_threads
+    device.pin_cpu_threads = False
+    assert not device.pin_cpu_threads
+
+
+def test_host_memory_placement(lattice_snapshot_factory):
+    device = hoomd.device.CPU()
+    assert not device.huge_pages
+    assert not device.numa_first_touch
+
+    device.huge_pages = True
+    device.numa_first_touch = True
+    assert device.huge_pages
+    assert device.numa_first_touch
+
+    # arrays allocated with the options hold the snapshot data
+    snap = lattice_snapshot_factory(n=20)
+    sim = hoomd.Simulation(device=device)
+    sim.create_state_from_snapshot(snap)
+    snap_out = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap_out.particles.position,
+                                      snap.particles.position)
+
+
+def test_trace(simulation_factory, lattice_snapshot_factory, tmp_path):
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.tuners[0].trigger = hoomd.trigger.Periodic(1)
+    filename = str(tmp_path / 'trace.json')
+
+    with sim.device.trace(filename):
+        sim.run(5)
+
+    if sim.device.communicator.rank == 0:
+        with open(filename) as f:
+            trace = json.load(f)
+
+        names = [
+            event['name']
+            for event in trace['traceEvents']
+            if event['pid'] == 0 and event['ph'] == 'X'
+        ]
+        assert names.count('Tuners') == 5
+        assert names.count('Integrator') == 5
+        assert names.count('SFCPack') == 5
+        for event in trace['traceEvents']:
+            if event['ph'] == 'X':
+                assert event['dur'] >= 0
+
+
 def _assert_gpu_properties(dev, mem_traceback, gpu_error_checking):
     """Assert properties specific to GPU objects are correct."""
     assert dev.memory_traceback == mem_traceback
@@ -74,6 +159,23 @@ def test_gpu_specific_properties(device):
     assert c[1] >= 0
 
 
+@pytest.mark.gpu
+def test_autotuner_search(device, simulation_factory,
+                          lattice_snapshot_factory):
+    assert device.autotuner_search == 'exhaustive'
+
+    with pytest.raises(ValueError):
+        device.autotuner_search = 'random'
+
+    device.autotuner_search = 'adaptive'
+    try:
+        assert device.autotuner_search == 'adaptive'
+        sim = simulation_factory(lattice_snapshot_factory())
+        sim.run(100)
+    finally:
+        device.autotuner_search = 'exhaustive'
+
+
 @pytest.mark.gpu
 def test_other_gpu_specifics(device):
     # make sure GPU is available and auto-select gives a GPU
@@ -1,6 +1,7 @@
+import hoomd
 import pytest
 from hoomd.filter import (Type, Tags, SetDifference, Union, Intersection, All,
-                          Null, Rigid)
+                          Null, Rigid, Expression)
 from hoomd.snapshot import Snapshot
 from copy import deepcopy
 from itertools import combinations
@@ -107,6 +108,42 @@ def test_tags_filter(make_filter_snapshot, simulation_factory, tag_indices):
     assert tag_filter(sim.state) == indices
 
 
+@pytest.mark.serial
+def test_expression_filter(make_filter_snapshot, simulation_factory):
+    particle_types = ['A', 'B']
+    N = 20
+    filter_snapshot = make_filter_snapshot(n=N, particle_types=particle_types)
+    if filter_snapshot.communicator.rank == 0:
+        filter_snapshot.particles.typeid[:] = np.arange(N) % 2
+        filter_snapshot.particles.velocity[:] = np.random.uniform(-2,
+                                                                  2,
+                                                                  size=(N, 3))
+    sim = simulation_factory(filter_snapshot)
+
+    s = sim.state.get_snapshot()
+    pos = s.particles.position
+    vel = s.particles.velocity
+    typeid = s.particles.typeid
+    tags = np.arange(N)
+
+    def check(filter_, selected):
+        assert filter_(sim.state) == list(tags[selected])
+
+    check(Expression('z > wall', parameters=dict(wall=1.5)), pos[:, 2] > 1.5)
+    check(Expression("type == 'B'"), typeid == 1)
+    check(Expression('-2 < x <= 3 and not tag == 4'),
+          (-2 < pos[:, 0]) & (pos[:, 0] <= 3) & (tags != 4))
+    check(Expression("type != 'A' or sqrt(vx*vx + vy*vy + vz*vz) > 2"),
+          (typeid != 0) | (np.linalg.norm(vel, axis=1) > 2))
+    check(Expression('abs(y - 1) / 2 < 3 * mass'),
+          np.abs(pos[:, 1] - 1) / 2 < 3)
+
+    with pytest.raises(ValueError):
+        Expression('unknown > 1')
+    with pytest.raises(ValueError):
+        Expression('x ** 2 > 1')
+
+
 _set_indices = [([0, 3, 8], [1, 6, 7, 9], [2, 4, 5]),
                 ([2, 3, 5, 7, 8], [0, 1, 4], [6, 9]),
                 ([3], [0, 7, 8], [1, 2, 4, 5, 6, 9])]
@@ -205,6 +242,7 @@ _filter_classes = [
     SetDifference,
     Union,
     Intersection,
+    Expression,
 ]
 
 _constructor_args = [
@@ -215,6 +253,7 @@ _constructor_args = [
     (Tags([1, 4, 5]), Type({'a'})),
     (Tags([1, 4, 5]), Type({'a'})),
     (Tags([1, 4, 5]), Type({'a'})),
+    ("x > a and type == 'A'", {'a': 1.0}),
 ]
 
 
@@ -227,3 +266,50 @@ def test_pickling(constructor, args):
     pickled_filter = pickle.loads(pickle.dumps(filter_))
     assert pickled_filter == filter_
     assert hash(pickled_filter) == hash(filter_)
+
+
+# the tags cross the 32 bit words of the device bitmasks
+_mask_tags = [0, 1, 30, 31, 32, 33, 63, 64, 70, 74]
+
+_mask_filters = [
+    All(),
+    Type(['A']),
+    Type(['A', 'C']),
+    Tags(_mask_tags),
+    Union(Type(['B']), Tags(_mask_tags)),
+    Intersection(Type(['A', 'B']), Tags(_mask_tags)),
+    SetDifference(All(), Tags(_mask_tags)),
+    Intersection(Union(Type(['A']), Type(['C'])), Tags(list(range(40)))),
+    # filters without a bitmask fall back to the host selection
+    Union(Type(['C']), Rigid(('center',))),
+]
+
+
+@pytest.mark.gpu
+@pytest.mark.parametrize('filter_', _mask_filters, ids=str)
+def test_device_mask_selection(make_filter_snapshot, simulation_factory,
+                               device, filter_):
+    """Test that groups selected on the GPU match the CPU selection."""
+    particle_types = ['A', 'B', 'C']
+    N = 75
+    snap = make_filter_snapshot(n=N, particle_types=particle_types)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = np.random.randint(0, 3, size=N)
+        snap.particles.mass[:] = np.arange(N) + 1
+
+    sim = simulation_factory(snap)
+    group = sim.state._get_group(filter_)
+
+    cpu = hoomd.device.CPU(communicator=device.communicator)
+    cpu_sim = hoomd.Simulation(cpu)
+    cpu_sim.create_state_from_snapshot(snap)
+    cpu_group = cpu_sim.state._get_group(filter_)
+
+    # the member tags are global and sorted on every rank
+    np.testing.assert_array_equal(group.member_tags, cpu_group.member_tags)
+    assert group.getNumMembersGlobal() == cpu_group.getNumMembersGlobal()
+    assert group.getNumMembersGlobal() > 0
+
+    # the total mass sums the local members found with the membership flags,
+    # and each particle has a distinct mass
+    assert group.getTotalMass() == cpu_group.getTotalMass()
@@ -504,6 +504,21 @@ class TestLocalSnapshots:
                 with pytest.raises(RuntimeError):
                     sim.state.set_snapshot(base_snapshot)
 
+    def test_dlpack(self, base_simulation):
+        if not hasattr(np, 'from_dlpack'):
+            pytest.skip("NumPy does not support DLPack.")
+        sim = base_simulation()
+        with sim.state.cpu_local_snapshot as data:
+            position = data.particles.position
+            assert position.__dlpack_device__() == (1, 0)
+            np.testing.assert_array_equal(np.from_dlpack(position),
+                                          np.array(position, copy=True))
+            # the exported tensor aliases the buffer
+            assert np.shares_memory(np.from_dlpack(position),
+                                    position._coerce_to_ndarray())
+        with pytest.raises(hoomd.data.array.HOOMDArrayError):
+            position.__dlpack__()
+
     @pytest.fixture
     def base_simulation(self, simulation_factory, base_snapshot):
         """Creates the simulation from the base_snapshot."""
@@ -120,6 +120,61 @@ def test_tps(simulation_factory, lattice_snapshot_factory):
     assert sim.tps > 0
 
 
+def test_timings(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory()
+    assert not sim.profiling
+    assert sim.timings == {}
+
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.tuners[0].trigger = hoomd.trigger.Periodic(1)
+    sim.run(10)
+    assert sim.timings == {}
+
+    sim.profiling = True
+    assert sim.profiling
+    sim.run(10)
+
+    timings = sim.timings
+    assert timings['SFCPack']['count'] == 10
+    assert timings['SFCPack']['wall_time'] > 0
+    assert timings['SFCPack']['gpu_time'] >= 0
+    gpu_times = timings['SFCPack']['gpu_time_per_device']
+    if isinstance(sim.device, hoomd.device.GPU):
+        assert len(gpu_times) == len(sim.device.devices)
+    else:
+        assert gpu_times == []
+    assert sim.timing_names == list(timings.keys())
+    assert len(sim.timing_wall_time) == len(timings)
+    assert len(sim.timing_gpu_time) == len(timings)
+
+    hw_counters = timings['SFCPack']['hw_counters']
+    if hoomd.version.papi_enabled:
+        assert all(value >= 0 for value in hw_counters.values())
+    else:
+        assert hw_counters == {}
+    assert len(sim.timing_cache_misses) == len(timings)
+    assert len(sim.timing_dram_bytes) == len(timings)
+    assert len(sim.timing_fp_ops) == len(timings)
+
+
+def test_memory_usage(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.run(1)
+
+    memory_usage = sim.memory_usage
+    particle_data = memory_usage['ParticleData']
+    if isinstance(sim.device, hoomd.device.GPU):
+        assert particle_data['host_bytes'] + particle_data['device_bytes'] > 0
+    else:
+        assert particle_data['host_bytes'] > 0
+        assert particle_data['device_bytes'] == 0
+    assert particle_data['peak_host_bytes'] >= particle_data['host_bytes']
+    assert particle_data['peak_device_bytes'] >= particle_data['device_bytes']
+    assert sim.memory_usage_names == list(memory_usage.keys())
+    assert len(sim.memory_usage_host_bytes) == len(memory_usage)
+    assert len(sim.memory_usage_device_bytes) == len(memory_usage)
+
+
 def test_timestep(simulation_factory, lattice_snapshot_factory):
     sim = simulation_factory()
     assert sim.timestep is None
@@ -198,6 +253,26 @@ def test_state_from_gsd(device, simulation_factory, lattice_snapshot_factory,
         assert_equivalent_snapshots(snap, sim.state.get_snapshot())
 
 
+@skip_gsd
+def test_gsd_map_chunk(device, lattice_snapshot_factory, tmp_path):
+    filename = tmp_path / "temporary_test_file.gsd"
+    snap = lattice_snapshot_factory(n=10, particle_types=['A', 'B'])
+    if device.communicator.rank != 0:
+        return
+
+    with gsd.hoomd.open(name=filename, mode='wb') as f:
+        f.append(make_gsd_snapshot(snap))
+
+    reader = hoomd._hoomd.GSDStateReader(str(filename), 0)
+    position = reader.mapChunk('particles/position')
+    typeid = reader.mapChunk('particles/typeid')
+    del reader
+
+    assert not position.flags.writeable
+    np.testing.assert_array_equal(position, snap.particles.position)
+    np.testing.assert_array_equal(typeid, snap.particles.typeid)
+
+
 @skip_gsd
 def test_state_from_gsd_snapshot(simulation_factory, lattice_snapshot_factory,
                                  device, state_args, tmp_path):
@@ -225,6 +300,58 @@ def test_state_from_gsd_snapshot(simulation_factory, lattice_snapshot_factory,
         assert_equivalent_snapshots(snap, sim.state.get_snapshot())
 
 
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_state_from_lattice(device, dimensions):
+    if dimensions == 2:
+        unit_cell = hoomd.Box.square(1.5)
+        n = (4, 3, 1)
+    else:
+        unit_cell = hoomd.Box(Lx=1.5, Ly=1.2, Lz=1.0, xy=0.1, xz=0.2, yz=0.3)
+        n = (4, 3, 2)
+    positions = [(0, 0, 0), (0.5, 0.5, 0.5)]
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_lattice(unit_cell=unit_cell,
+                                  positions=positions,
+                                  n=n,
+                                  typeid=[0, 1],
+                                  particle_types=['A', 'B'])
+    assert sim.timestep == 0
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        assert snap.configuration.dimensions == dimensions
+        np.testing.assert_allclose(snap.configuration.box, [
+            unit_cell.Lx * n[0], unit_cell.Ly * n[1], unit_cell.Lz * n[2],
+            unit_cell.xy, unit_cell.xz, unit_cell.yz
+        ])
+        assert snap.particles.N == n[0] * n[1] * n[2] * len(positions)
+        assert snap.particles.types == ['A', 'B']
+
+        box = sim.state.box
+        expected = []
+        for k in range(n[2]):
+            for j in range(n[1]):
+                for i in range(n[0]):
+                    for p in positions:
+                        # same as BoxDim::makeCoordinates
+                        f = np.array([(i + p[0]) / n[0], (j + p[1]) / n[1],
+                                      (k + p[2]) / n[2]])
+                        v = (f - 0.5) * box.L
+                        v[0] += box.xy * v[1] + box.xz * v[2]
+                        v[1] += box.yz * v[2]
+                        expected.append(v)
+        expected = np.array(expected)
+
+        np.testing.assert_allclose(snap.particles.position,
+                                   expected,
+                                   atol=1e-5)
+        np.testing.assert_array_equal(snap.particles.typeid,
+                                      [0, 1] * (n[0] * n[1] * n[2]))
+        np.testing.assert_array_equal(snap.particles.mass, 1.0)
+        np.testing.assert_array_equal(snap.particles.velocity, 0.0)
+
+
 def test_writer_order(simulation_factory, two_particle_snapshot_factory):
     """Ensure that writers run at the end of the loop step."""
 
@@ -287,7 +414,49 @@ def test_writer_order_initial(simulation_factory,
     ]
 
 
-def test_large_timestep(simulation_factory, lattice_snapshot_factory):
+class _RecordingTrigger(hoomd.trigger.Trigger):
+    """Periodic trigger that records the steps on which it is evaluated."""
+
+    def __init__(self, period):
+        hoomd.trigger.Trigger.__init__(self)
+        self.period = period
+        self.steps = []
+
+    def compute(self, timestep):
+        self.steps.append(timestep)
+        return timestep % self.period == 0
+
+    def next_step(self, timestep):
+        return -(-timestep // self.period) * self.period
+
+
+@pytest.mark.parametrize("change", ['trigger', 'append'])
+def test_trigger_change_during_run(simulation_factory,
+                                   two_particle_snapshot_factory, change):
+    """Test operations that change triggers or add operations during a run."""
+
+    recorder = _RecordingTrigger(period=2)
+    updater = hoomd.update.FilterUpdater(hoomd.trigger.Periodic(1000),
+                                         [hoomd.filter.All()])
+
+    class Change(hoomd.custom.Action):
+
+        def act(self, timestep):
+            if change == 'trigger':
+                updater.trigger = recorder
+            else:
+                sim.operations.updaters.append(
+                    hoomd.update.FilterUpdater(recorder, [hoomd.filter.All()]))
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.updaters.append(updater)
+    sim.operations.writers.append(
+        hoomd.write.CustomWriter(action=Change(),
+                                 trigger=hoomd.trigger.On(5)))
+
+    # the writer acts on step 5, the updaters run on steps 0 to 9
+    sim.run(10)
+    assert recorder.steps == [6, 8]
     """Test that simluations suport large timestep values."""
     sim = simulation_factory()
     sim.timestep = 2**64 - 100
@@ -26,6 +26,49 @@ def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
     assert sorter.grid == 32
 
 
+def test_disorder_threshold(simulation_factory, lattice_snapshot_factory):
+    """Test that ParticleSorter skips sorts while the particles are ordered."""
+    sorter = hoomd.tune.ParticleSorter(trigger=1)
+    assert sorter.disorder_threshold == 0
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    sim.operations.tuners.clear()
+    sim.operations.tuners.append(sorter)
+    sim.run(2)
+    assert sorter.num_sorts == 2
+    assert 0 <= sorter.disorder <= 1
+
+    # the particles do not move, so they stay in order after the last sort
+    sorter.disorder_threshold = 0.25
+    assert sorter.disorder_threshold == 0.25
+    sim.run(5)
+    assert sorter.num_sorts == 2
+    assert sorter.disorder == 0
+
+
+def test_sort_by_type(simulation_factory, lattice_snapshot_factory):
+    """Test that ParticleSorter sorts by type within each cell."""
+    sorter = hoomd.tune.ParticleSorter(trigger=1, grid=2, sort_by_type=True)
+    assert sorter.sort_by_type
+
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=8)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = [i % 2 for i in range(snap.particles.N)]
+
+    sim = simulation_factory(snap)
+    sim.operations.tuners.clear()
+    sim.operations.tuners.append(sorter)
+    sim.run(1)
+    assert sorter.sort_by_type
+    assert sorter.num_sorts == 1
+
+    # types are contiguous within the cells, so the order has few type changes
+    with sim.state.cpu_local_snapshot as local_snap:
+        typeid = local_snap.particles.typeid
+        n_changes = sum(typeid[1:] != typeid[:-1])
+        assert n_changes < 2 * 2**3
+
+
 def test_default_sorter(simulation_factory, two_particle_snapshot_factory):
     """Test that the default Simulation includes a ParticleSorter."""
     sim = simulation_factory(two_particle_snapshot_factory())
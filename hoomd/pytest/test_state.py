@@ -173,6 +173,77 @@ def test_modify_snapshot(simulation_factory, snap):
     assert_snapshots_equal(snap, snap2)
 
 
+def test_particle_chunks(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=5, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = [i % 2 for i in range(snap.particles.N)]
+        snap.particles.charge[:] = numpy.arange(snap.particles.N)
+    sim = simulation_factory(snap)
+    snap = sim.state.get_snapshot()
+
+    with pytest.raises(ValueError):
+        next(sim.state.particle_chunks(chunk_size=0))
+
+    chunks = list(sim.state.particle_chunks(chunk_size=7))
+    assert len(chunks) == (sim.state.N_particles + 6) // 7
+    if snap.communicator.rank != 0:
+        return
+
+    tags = numpy.concatenate([tags for tags, _ in chunks])
+    numpy.testing.assert_array_equal(tags, numpy.arange(snap.particles.N))
+    for attr in ('position', 'typeid', 'velocity', 'mass', 'orientation',
+                 'angmom', 'moment_inertia', 'charge', 'diameter', 'image',
+                 'body'):
+        values = numpy.concatenate(
+            [getattr(particles, attr) for _, particles in chunks])
+        numpy.testing.assert_allclose(values, getattr(snap.particles, attr))
+
+    # default fields take no memory and are read-only
+    _, particles = chunks[0]
+    assert particles.N == 7
+    assert not particles.velocity.flags.writeable
+    assert particles.velocity.shape == (7, 3)
+    assert particles.charge.flags.writeable
+
+
+def test_tag_ordered_particles(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=5, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = [i % 2 for i in range(snap.particles.N)]
+        snap.particles.charge[:] = numpy.arange(snap.particles.N)
+    sim = simulation_factory(snap)
+
+    if snap.communicator.num_ranks > 1:
+        with pytest.raises(RuntimeError):
+            sim.state.tag_ordered_particles.position
+        return
+
+    particles = sim.state.tag_ordered_particles
+    assert particles is sim.state.tag_ordered_particles
+    snap = sim.state.get_snapshot()
+    for attr in ('position', 'typeid', 'velocity', 'mass', 'orientation',
+                 'angmom', 'moment_inertia', 'charge', 'diameter', 'image',
+                 'body'):
+        numpy.testing.assert_allclose(getattr(particles, attr),
+                                      getattr(snap.particles, attr))
+
+    charge = particles.charge
+    assert not charge.flags.writeable
+    assert particles.charge is charge
+
+    # the sorter reorders the particles, the view stays in tag order
+    sim.operations.tuners[0].trigger = 1
+    sim.run(1)
+    snap2 = sim.state.get_snapshot()
+    numpy.testing.assert_allclose(particles.position,
+                                  snap2.particles.position)
+    numpy.testing.assert_allclose(particles.charge, snap.particles.charge)
+
+    with sim.state.cpu_local_snapshot:
+        with pytest.raises(RuntimeError):
+            particles.position
+
+
 def test_thermalize_particle_velocity(simulation_factory,
                                       lattice_snapshot_factory):
     snap = lattice_snapshot_factory()
@@ -202,3 +202,20 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory, logger):
     sim = simulation_factory(two_particle_snapshot_factory())
     table = hoomd.write.Table(1, logger)
     operation_pickling_check(table, sim)
+
+
+def test_formatter():
+    fmt = hoomd._hoomd.TableFormatter(True, 10)
+    assert fmt.formatNumber(5, 10) == '    5     '
+    assert fmt.formatNumber(1.5, 10) == ' 1.50000  '
+    assert fmt.formatNumber(-1234567.0, 10) == '-1.2346e+06'
+    assert fmt.formatString('abcdefghijkl', 10) == ' efghijkl '
+
+    fmt = hoomd._hoomd.TableFormatter(False, 4)
+    assert fmt.formatNumber(1.5, 10) == '  1.500   '
+    assert fmt.formatString('abcdefghijkl', 10) == 'abcdefghijkl'
+
+    fmt.appendHeader(['a', 'b'], [3, 3], ' ')
+    fmt.appendRow([1, 'x'], [3, 3], ' ')
+    assert fmt.takeOutput() == ' a   b \n 1   x \n'
+    assert fmt.takeOutput() == ''
@@ -32,7 +32,7 @@ class CustomTrigger(hoomd.trigger.Trigger):
 _classes = [
     hoomd.trigger.Periodic, hoomd.trigger.Before, hoomd.trigger.After,
     hoomd.trigger.On, hoomd.trigger.Not, hoomd.trigger.And, hoomd.trigger.Or,
-    CustomTrigger
+    hoomd.trigger.Schedule, CustomTrigger
 ]
 
 # List of kwargs for the class constructors
@@ -53,6 +53,8 @@ _kwargs = [{
 }, {
     'triggers': ((hoomd.trigger.Periodic(10, 1), hoomd.trigger.Before(100)),
                  (hoomd.trigger.After(100), hoomd.trigger.On(101)))
+}, {
+    'stages': ([(5, 10), (100, 0), (200, 25), (10000000000, 3)], [(0, 1)])
 }, {}]
 
 
@@ -86,7 +88,8 @@ def test_properties(cls, kwargs):
 _strings_beginning = ("hoomd.trigger.Periodic(", "hoomd.trigger.Before(",
                       "hoomd.trigger.After(", "hoomd.trigger.On(",
                       "hoomd.trigger.Not(", "hoomd.trigger.And(",
-                      "hoomd.trigger.Or(", "CustomTrigger()")
+                      "hoomd.trigger.Or(", "hoomd.trigger.Schedule(",
+                      "CustomTrigger()")
 
 
 # Trigger instanace for the first arguments in _kwargs
@@ -110,6 +113,9 @@ _eval_funcs = [
     lambda x: not (x - 1) % 10 == 0,  # not
     lambda x: (x - 1) % 10 == 0 and x < 100,  # and
     lambda x: (x - 1) % 10 == 0 or x < 100,  # or
+    lambda x: ((5 <= x < 100 and (x - 5) % 10 == 0) or  # schedule
+               (200 <= x < 10000000000 and (x - 200) % 25 == 0) or
+               (x >= 10000000000 and (x - 10000000000) % 3 == 0)),
     lambda x: (x**(1 / 2)).is_integer()
 ]
 
@@ -125,6 +131,35 @@ def test_eval(trigger, eval_func):
         assert trigger(i) == eval_func(i)
 
 
+@pytest.mark.parametrize('trigger', triggers(), ids=_test_name)
+def test_next_step(trigger):
+    for start in itertools.chain(range(0, 200, 7),
+                                 range(10000000000, 10000000200, 7)):
+        next_step = hoomd._hoomd._test_trigger_next_step(trigger, start)
+        assert next_step >= start
+        # the trigger is inactive until the next step
+        for i in range(start, min(next_step, start + 1000)):
+            assert not trigger(i)
+        if next_step != hoomd.trigger.Trigger.never:
+            assert next_step - start < 1000
+
+
+@pytest.mark.parametrize('trigger, next_steps',
+                         ((hoomd.trigger.Periodic(456, 18), [18, 474, 474]),
+                          (hoomd.trigger.Before(100), [0, 19, -1]),
+                          (hoomd.trigger.After(100), [101, 101, 101]),
+                          (hoomd.trigger.On(100), [100, 100, -1]),
+                          (hoomd.trigger.Schedule([(5, 10), (100, 0),
+                                                   (200, 25)]), [5, 25, 200])),
+                         ids=_test_name)
+def test_next_step_exact(trigger, next_steps):
+    never = hoomd.trigger.Trigger.never
+    for start, expected in zip([0, 19, 101], next_steps):
+        if expected == -1:
+            expected = never
+        assert trigger.next_step(start) == expected
+
+
 @pytest.mark.parametrize('trigger', triggers(), ids=_test_name)
 def test_pickling(trigger):
     pkled_trigger = pickle.loads(pickle.dumps(trigger))
@@ -137,3 +172,10 @@ def test_custom():
     # test that the custom trigger can be called from c++
     assert hoomd._hoomd._test_trigger_call(c, 0)
     assert not hoomd._hoomd._test_trigger_call(c, 250000000001)
+
+
+def test_schedule_invalid():
+    with pytest.raises(ValueError):
+        hoomd.trigger.Schedule([])
+    with pytest.raises(ValueError):
+        hoomd.trigger.Schedule([(100, 10), (50, 1)])
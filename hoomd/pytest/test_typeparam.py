@@ -3,6 +3,7 @@ from hoomd.data.typeparam import TypeParameter
 from hoomd.data.parameterdicts import TypeParameterDict
 from hoomd.pytest.dummy import DummyCppObj, DummySimulation
 from pytest import fixture, raises
+import numpy as np
 
 
 @fixture(scope='function')
@@ -66,6 +67,27 @@ def test_default(all_):
     assert all_.default['foo'] == 1
 
 
+def test_set_array(all_):
+    values = np.array([(2, 3), (5, 6)], dtype=[('bar', int), ('foo', int)])
+    all_.set_array(['A', 'C'], values)
+    assert all_['A'] == dict(bar=2, foo=3)
+    assert all_['C'] == dict(bar=5, foo=6)
+
+    # fields that are not given take the default
+    all_.set_array(['B'], np.array([(7,)], dtype=[('bar', int)]))
+    assert all_['B'] == dict(bar=7, foo=1)
+
+    with raises(ValueError):
+        all_.set_array(['A', 'B'], values[:1])
+
+
+def test_attached_set_array_bulk(attached):
+    calls = attached.param_dict._cpp_obj.bulk_calls
+    values = np.array([(2, 3), (5, 6)], dtype=[('bar', int), ('foo', int)])
+    attached.set_array(['A', 'B'], values)
+    assert attached.param_dict._cpp_obj.bulk_calls == calls + 1
+
+
 def test_type_checking(all_):
     bad_inputs = [dict(), dict(A=4), ['A', 4]]
     for input_ in bad_inputs:
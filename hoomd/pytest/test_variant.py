@@ -14,7 +14,7 @@ import pytest
 
 _classes = [
     hoomd.variant.Constant, hoomd.variant.Ramp, hoomd.variant.Cycle,
-    hoomd.variant.Power
+    hoomd.variant.Power, hoomd.variant.PiecewiseLinear
 ]
 
 _test_kwargs = [
@@ -46,6 +46,12 @@ _test_kwargs = [
         'power': np.linspace(2, 5, 3),
         't_start': (0, 10, 10000000000),
         't_ramp': (10, 20, 2000000000000)
+    },
+    # PiecewiseLinear: first args points=[(0, 1), (10, 3), (30, 2)]
+    {
+        'points': ([(0, 1.0), (10, 3.0), (30, 2.0)],
+                   [(5, 2.0), (100, 0.5), (101, 4.0), (10000000000, 1.0)],
+                   [(20, 7.0)])
     }
 ]
 
@@ -82,6 +88,7 @@ _expected_min_max = [
     (1., 3.),
     (2., 5.),
     (1., 10.),
+    (1., 3.),
 ]
 
 _single_kwargs = [next(_to_kwargs(kwargs)) for kwargs in _test_kwargs]
@@ -167,7 +174,23 @@ def cycle_eval(A, B, t_start, t_A, t_AB, t_BA, t_B):
     return expected_value
 
 
-_eval_constructors = [constant_eval, ramp_eval, cycle_eval, power_eval]
+def piecewise_linear_eval(points):
+
+    def expected_value(timestep):
+        if timestep <= points[0][0]:
+            return points[0][1]
+        for (t_a, v_a), (t_b, v_b) in zip(points[:-1], points[1:]):
+            if timestep < t_b:
+                frac = (timestep - t_a) / (t_b - t_a)
+                return (v_b * frac) + ((1 - frac) * v_a)
+        return points[-1][1]
+
+    return expected_value
+
+
+_eval_constructors = [
+    constant_eval, ramp_eval, cycle_eval, power_eval, piecewise_linear_eval
+]
 
 
 @pytest.mark.parametrize('variant, evaluator, kwargs',
@@ -232,3 +255,10 @@ def test_custom():
     for i in range(0, 10000, 100):
         assert (hoomd._hoomd._test_variant_call(pkled_variant,
                                                 i) == float(i)**(1 / 2))
+
+
+def test_piecewise_linear_invalid():
+    with pytest.raises(ValueError):
+        hoomd.variant.PiecewiseLinear([])
+    with pytest.raises(ValueError):
+        hoomd.variant.PiecewiseLinear([(10, 1.0), (10, 2.0)])
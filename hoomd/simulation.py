@@ -180,23 +180,164 @@ class Simulation(metaclass=Loggable):
             automatically selected direction. The default value of ``(None,
             None, None)`` will automatically select the number of domains in all
             directions.
+
+        When running on more than one MPI rank, the ranks first read the
+        particle positions in parallel to assign particles to domains. Then each
+        rank reads only the properties of its own particles from the file with
+        MPI-IO, so no rank holds the entire frame in memory.
         """
         if self._state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
+        distributed = self.device.communicator.num_ranks > 1
         # Grab snapshot and timestep
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
-                                  abs(frame), frame < 0)
+                                  abs(frame), frame < 0, distributed)
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
         self._state = State(self, snapshot, domain_decomposition)
+        if distributed:
+            reader.readLocal(self._state._cpp_sys_def)
 
         reader.clearSnapshot()
 
         self._init_system(step)
 
+    def create_state_from_checkpoint(self, filename):
+        """Create the simulation state from a checkpoint.
+
+        Args:
+            filename (str): Base file name given to `hoomd.write.Checkpoint`.
+
+        Restores the particles, topology, time step, random number seed, and
+        domain decomposition saved by `hoomd.write.Checkpoint` exactly. When
+        the simulation runs on the same number of MPI ranks that wrote the
+        checkpoint, each rank reads its own particles from its own file. On a
+        different number of ranks, rank 0 reads all files and the particles
+        are distributed to domains chosen as in `create_state_from_snapshot`.
+
+        Note:
+            Call `hoomd.write.Checkpoint.restore_operations` after adding the
+            integrator to restore the HPMC move sizes and the thermostat state.
+        """
+        if self._state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+        filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
+        reader = _hoomd.CheckpointReader(self.device._cpp_exec_conf, filename)
+
+        local = reader.canRestoreLocal()
+        snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(not local),
+                                               self.device.communicator)
+        if local and reader.getNRanks() > 1:
+            domain_decomposition = tuple(
+                reader.getFractions(i) for i in range(3))
+        else:
+            domain_decomposition = (None, None, None)
+
+        step = reader.getTimeStep() if self.timestep is None else self.timestep
+        self._state = State(self, snapshot, domain_decomposition)
+        if local:
+            reader.restoreLocal(self._state._cpp_sys_def)
+        reader.restoreIntegratorData(self._state._cpp_sys_def)
+
+        if self._seed is None:
+            self._seed = reader.getSeed()
+        self._init_system(step)
+
+    def create_state_from_lattice(self,
+                                  unit_cell,
+                                  positions,
+                                  n,
+                                  typeid=None,
+                                  particle_types=('A',),
+                                  domain_decomposition=(None, None, None)):
+        """Create the simulation state with particles on a lattice.
+
+        Args:
+            unit_cell (`hoomd.Box` or `box_like`): The unit cell of the
+                lattice.
+
+            positions (list[tuple[float, float, float]]): Positions of the
+                particles in the unit cell in fractional coordinates of the
+                unit cell, each in the range [0, 1).
+
+            n (int or tuple[int, int, int]): Number of times to replicate the
+                unit cell along each lattice vector. Provide a single integer
+                to replicate the same number of times in every direction.
+
+            typeid (list[int]): Type id of the particle at each position.
+                Defaults to 0 for all positions.
+
+            particle_types (list[str]): Names of the particle types.
+
+            domain_decomposition (tuple): Choose how to distribute the state
+                across MPI ranks with domain decomposition. See
+                `create_state_from_snapshot`.
+
+        The simulation box is the unit cell with its lengths multiplied by
+        ``n`` and the same tilt factors. Particles have unit mass and diameter,
+        the identity orientation, and zero velocity. Each MPI rank places only
+        the particles in its own domain, so `create_state_from_lattice` is much
+        faster than `create_state_from_snapshot` for large systems. The
+        particle tags are ordered by unit cell, with the first lattice vector
+        varying fastest, then by position in the unit cell.
+
+        For 2D systems, set ``unit_cell`` to a 2D box and ``n[2]`` to 1. The
+        third fractional coordinate of the positions is ignored.
+
+        When `timestep` is `None` before calling, `create_state_from_lattice`
+        sets `timestep` to 0.
+
+        Example::
+
+            sim.create_state_from_lattice(
+                unit_cell=hoomd.Box.cube(1.6796),
+                positions=[(0, 0, 0), (0.5, 0.5, 0), (0.5, 0, 0.5),
+                           (0, 0.5, 0.5)],
+                n=100)
+        """
+        if self._state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+
+        unit_cell = hoomd.Box.from_box(unit_cell)
+        if isinstance(n, int):
+            n = (n, n, n)
+        n = tuple(int(v) for v in n)
+        if len(n) != 3:
+            raise ValueError("n must be an integer or a tuple of 3 integers.")
+        if unit_cell.is2D and n[2] != 1:
+            raise ValueError("2D lattices must have n[2] == 1.")
+
+        positions = [tuple(float(v) for v in p) for p in positions]
+        if typeid is None:
+            typeid = [0] * len(positions)
+        typeid = [int(t) for t in typeid]
+
+        generator = _hoomd.LatticeGenerator(self.device._cpp_exec_conf,
+                                            positions, typeid, *n)
+
+        # the snapshot only sets up the box, types, and domain decomposition
+        snapshot = Snapshot(self.device.communicator)
+        if snapshot.communicator.rank == 0:
+            snapshot.configuration.box = hoomd.Box(Lx=unit_cell.Lx * n[0],
+                                                   Ly=unit_cell.Ly * n[1],
+                                                   Lz=unit_cell.Lz * n[2],
+                                                   xy=unit_cell.xy,
+                                                   xz=unit_cell.xz,
+                                                   yz=unit_cell.yz)
+            snapshot.particles.types = list(particle_types)
+
+        self._state = State(self, snapshot, domain_decomposition)
+        generator.initializeLocal(self._state._cpp_sys_def)
+
+        step = 0
+        if self.timestep is not None:
+            step = self.timestep
+
+        self._init_system(step)
+
     def create_state_from_snapshot(self,
                                    snapshot,
                                    domain_decomposition=(None, None, None)):
@@ -366,6 +507,143 @@ class Simulation(metaclass=Loggable):
             if value:
                 self._state._cpp_sys_def.getParticleData().setPressureFlag()
 
+    @property
+    def profiling(self):
+        """bool: Record per operation timings during `run` (defaults to \
+        ``False``).
+
+        When `profiling` is `True`, operations record the time they spend in
+        each call, which `timings` reports. With a GPU device, the timed
+        regions synchronize the GPU, which reduces performance.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return False
+        else:
+            return self._cpp_sys.getProfilerEnabled()
+
+    @profiling.setter
+    def profiling(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        else:
+            self._cpp_sys.enableProfiler(bool(value))
+
+    @log(category='object')
+    def timings(self):
+        """dict: Per operation timings of the last `run`.
+
+        The keys are the names of the profiled regions. Nested regions are
+        joined by ``/``, for example ``'Integrate/Pair lj'``. Each value is a
+        `dict` with the keys:
+
+        * ``count`` (`int`) - number of times the region executed.
+        * ``wall_time`` (`float`) - total wall clock time
+          :math:`[\\mathrm{s}]`, including nested regions.
+        * ``gpu_time`` (`float`) - total GPU time measured with events
+          :math:`[\\mathrm{s}]` on the slowest GPU (0 on the CPU).
+        * ``gpu_time_per_device`` (`list[float]`) - total GPU time
+          :math:`[\\mathrm{s}]` on each active GPU (empty on the CPU).
+        * ``flop_count`` (`int`) - estimated floating point operations.
+        * ``byte_count`` (`int`) - estimated bytes of memory moved.
+        * ``hw_counters`` (`dict` [`str`, `int`]) - hardware counters measured
+          on the CPU thread that executes the region (empty unless
+          `hoomd.version.papi_enabled`): ``cache_misses`` (L2),
+          ``llc_misses`` (last level cache), ``dram_bytes`` (64 bytes per last
+          level cache miss), ``fp_ops`` (double precision floating point
+          operations), ``cycles``, and ``instructions``. Counters that the CPU
+          does not provide are left out.
+
+        `timings` is empty unless `profiling` was enabled for the last `run`.
+
+        Note:
+            The timings reset at the beginning of each call to `run`.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return {}
+
+        profiler = self._cpp_sys.getProfiler()
+        if profiler is None:
+            return {}
+        return dict(profiler.getTimings())
+
+    @log(category='strings')
+    def timing_names(self):
+        """list[str]: Names of the regions in `timings`."""
+        return list(self.timings.keys())
+
+    @log(category='sequence')
+    def timing_wall_time(self):
+        """list[float]: ``wall_time`` of each region in `timing_names` \
+        :math:`[\\mathrm{s}]`."""
+        return [value['wall_time'] for value in self.timings.values()]
+
+    @log(category='sequence')
+    def timing_gpu_time(self):
+        """list[float]: ``gpu_time`` of each region in `timing_names` \
+        :math:`[\\mathrm{s}]`."""
+        return [value['gpu_time'] for value in self.timings.values()]
+
+    def _timing_hw_counter(self, name):
+        return [
+            value['hw_counters'].get(name, 0)
+            for value in self.timings.values()
+        ]
+
+    @log(category='sequence')
+    def timing_cache_misses(self):
+        """list[int]: ``hw_counters['cache_misses']`` of each region in \
+        `timing_names` (0 when not available)."""
+        return self._timing_hw_counter('cache_misses')
+
+    @log(category='sequence')
+    def timing_dram_bytes(self):
+        """list[int]: ``hw_counters['dram_bytes']`` of each region in \
+        `timing_names` :math:`[\\mathrm{bytes}]` (0 when not available)."""
+        return self._timing_hw_counter('dram_bytes')
+
+    @log(category='sequence')
+    def timing_fp_ops(self):
+        """list[int]: ``hw_counters['fp_ops']`` of each region in \
+        `timing_names` (0 when not available)."""
+        return self._timing_hw_counter('fp_ops')
+
+    @log(category='object')
+    def memory_usage(self):
+        """dict: Memory held by each owner on this rank.
+
+        The keys are the names of the C++ classes that own the arrays, such as
+        ``'ParticleData'``. Arrays without an owner count towards
+        ``'untagged'``. On the GPU, ``'CachedAllocator'`` reports the memory
+        held by the cache of temporary buffers. Each value is a `dict` with the
+        keys:
+
+        * ``host_bytes`` (`int`) - host memory currently held.
+        * ``device_bytes`` (`int`) - device and managed memory currently held.
+        * ``peak_host_bytes`` (`int`) - largest host memory held at once.
+        * ``peak_device_bytes`` (`int`) - largest device and managed memory
+          held at once.
+
+        Note:
+            MPI ranks report their own memory usage.
+        """
+        return dict(self._device._cpp_exec_conf.getMemoryUsage())
+
+    @log(category='strings')
+    def memory_usage_names(self):
+        """list[str]: Names of the owners in `memory_usage`."""
+        return list(self.memory_usage.keys())
+
+    @log(category='sequence')
+    def memory_usage_host_bytes(self):
+        """list[int]: ``host_bytes`` of each owner in `memory_usage_names`."""
+        return [value['host_bytes'] for value in self.memory_usage.values()]
+
+    @log(category='sequence')
+    def memory_usage_device_bytes(self):
+        """list[int]: ``device_bytes`` of each owner in \
+        `memory_usage_names`."""
+        return [value['device_bytes'] for value in self.memory_usage.values()]
+
     def run(self, steps, write_at_start=False):
         """Advance the simulation a number of steps.
 
@@ -418,6 +696,18 @@ class Simulation(metaclass=Loggable):
         Warning:
             Using ``write_at_start=True`` in subsequent
             calls to `run` will result in duplicate output frames.
+
+        Note:
+            An integrator may end the run before ``steps`` steps. For example,
+            `hoomd.md.minimize.FIRE` does when its ``stop_when_converged`` is
+            `True` and the minimization converges.
+
+        Note:
+            `run` releases the Python global interpreter lock while the C++
+            operations execute, so other Python threads continue to run. It
+            acquires the lock to call custom actions, custom triggers, and
+            other Python callbacks, and checks for signals (such as Ctrl-C)
+            every 100 milliseconds.
         """
         # check if initialization has occurred
         if not hasattr(self, '_cpp_sys'):
@@ -435,6 +725,11 @@ class Simulation(metaclass=Loggable):
 
         self._cpp_sys.run(steps_int, write_at_start)
 
+        # complete the output of writers that buffer their output
+        for writer in self.operations.writers:
+            if isinstance(writer, (hoomd.write.GSD, hoomd.write.DCD)):
+                writer.flush()
+
 
 def _match_class_path(obj, *matches):
     return any(cls.__module__ + '.' + cls.__name__ in matches
@@ -9,7 +9,7 @@ from collections import defaultdict
 from . import _hoomd
 from hoomd.box import Box
 from hoomd.snapshot import Snapshot
-from hoomd.data import LocalSnapshot, LocalSnapshotGPU
+from hoomd.data import LocalSnapshot, LocalSnapshotGPU, TagOrderedParticles
 import hoomd
 import math
 import collections.abc
@@ -215,7 +215,8 @@ class State:
     local and ghost particles) and *global* snapshots that collect the entire
     state on rank 0. See `State.cpu_local_snapshot`, `State.gpu_local_snapshot`,
     `State.get_snapshot`, and `State.set_snapshot` for information about
-    these data access patterns.
+    these data access patterns. `State.tag_ordered_particles` provides cheap
+    repeated read-only access to the particle data in snapshot order.
 
     .. _Kamberaj 2005: http://dx.doi.org/10.1063/1.1906216
     """
@@ -245,6 +246,9 @@ class State:
         # implemented __hash__ and __eq__ from causing cache errors.
         self._groups = defaultdict(dict)
 
+        # Created on first use, keeps its buffers between reads.
+        self._tag_ordered_particles = None
+
     def get_snapshot(self):
         """Make a copy of the simulation current state.
 
@@ -597,6 +601,77 @@ class State:
         else:
             return LocalSnapshotGPU(self)
 
+    @property
+    def tag_ordered_particles(self):
+        """hoomd.data.TagOrderedParticles: Read particle data in tag order.
+
+        `State.tag_ordered_particles` exposes read-only arrays of the particle
+        properties in the same order as `State.get_snapshot`, without copying
+        the whole state. The arrays are gathered again only when the particles
+        were sorted or the property changed, so analysis code that reads the
+        state on every step pays far less than it would for a snapshot.
+
+        .. code-block:: python
+
+            velocity = sim.state.tag_ordered_particles.velocity
+
+        Note:
+            `State.tag_ordered_particles` is not available in domain decomposed
+            simulations. Use `State.get_snapshot` or `State.cpu_local_snapshot`
+            there.
+        """
+        if self._tag_ordered_particles is None:
+            self._tag_ordered_particles = TagOrderedParticles(self)
+        return self._tag_ordered_particles
+
+    def particle_chunks(self, chunk_size=1048576):
+        """Iterate over the particle data in chunks of tags.
+
+        Args:
+            chunk_size (int): Number of tags in each chunk.
+
+        Yields:
+            tuple[numpy.ndarray, particles]: The tags of the particles in the
+            chunk and their properties, with the same attributes as
+            `hoomd.Snapshot.particles`.
+
+        `State.particle_chunks` gathers the particles with tags in
+        ``[0, chunk_size)``, ``[chunk_size, 2 * chunk_size)``, and so on, on the
+        root rank, one chunk at a time. Use it to write or analyze large systems
+        with memory proportional to *chunk_size* instead of the number of
+        particles:
+
+        .. code-block:: python
+
+            for tags, particles in sim.state.particle_chunks():
+                if sim.device.communicator.rank == 0:
+                    process(tags, particles.position)
+
+        Properties in which all particles of a chunk hold the default value
+        (e.g. zero velocity or unit mass) take no memory. They read as
+        read-only arrays that repeat the default value.
+
+        Note:
+            All MPI ranks must iterate over the chunks together. The chunks are
+            empty on the other ranks.
+
+        Warning:
+            Do not advance the simulation or modify the state while iterating.
+        """
+        if self._in_context_manager:
+            raise RuntimeError(
+                "Cannot take particle chunks inside a local snapshot.")
+        if chunk_size < 1:
+            raise ValueError("chunk_size must be positive.")
+
+        pdata = self._cpp_sys_def.getParticleData()
+        if pdata.getNGlobal() == 0:
+            return
+        n_tags = pdata.getMaximumTag() + 1
+        for tag_begin in range(0, n_tags, chunk_size):
+            yield pdata.takeSnapshotChunk(tag_begin,
+                                          min(tag_begin + chunk_size, n_tags))
+
     def thermalize_particle_momenta(self, filter, kT):
         """Assign random values to particle momenta.
 
@@ -0,0 +1,76 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/AutotunerCache.h"
+
+using namespace std;
+
+/*! \file test_autotuner_cache.cc
+    \brief Implements unit tests for AutotunerCache
+    \ingroup unit_tests
+*/
+
+//! Create an empty temporary directory for the cache
+static string make_cache_dir()
+    {
+    char name[] = "/tmp/hoomd_autotuner_cache_XXXXXX";
+    UP_ASSERT(mkdtemp(name) != nullptr);
+    return string(name) + "/cache";
+    }
+
+//! Stored entries can be loaded
+UP_TEST(autotuner_cache_round_trip)
+    {
+    AutotunerCache::setPath(make_cache_dir());
+
+    unsigned int param = 0;
+    UP_ASSERT(!AutotunerCache::load("tuner a", param));
+
+    AutotunerCache::store("tuner a", 256);
+    AutotunerCache::store("tuner b", 64);
+    UP_ASSERT(AutotunerCache::load("tuner a", param));
+    UP_ASSERT_EQUAL(param, (unsigned int)256);
+    UP_ASSERT(AutotunerCache::load("tuner b", param));
+    UP_ASSERT_EQUAL(param, (unsigned int)64);
+
+    // later results replace earlier ones
+    AutotunerCache::store("tuner a", 128);
+    UP_ASSERT(AutotunerCache::load("tuner a", param));
+    UP_ASSERT_EQUAL(param, (unsigned int)128);
+
+    AutotunerCache::setPath("");
+    }
+
+//! The cache is disabled when the path is empty
+UP_TEST(autotuner_cache_disabled)
+    {
+    AutotunerCache::setPath("");
+    AutotunerCache::store("tuner a", 256);
+
+    unsigned int param = 0;
+    UP_ASSERT(!AutotunerCache::load("tuner a", param));
+    }
+
+//! Similar particle numbers share a system key
+UP_TEST(autotuner_cache_system_key)
+    {
+    AutotunerCache::setSystem(1000, 2);
+    string key_1000 = AutotunerCache::getSystemKey();
+    AutotunerCache::setSystem(1023, 2);
+    UP_ASSERT_EQUAL(AutotunerCache::getSystemKey(), key_1000);
+    AutotunerCache::setSystem(1024, 2);
+    UP_ASSERT(AutotunerCache::getSystemKey() != key_1000);
+    AutotunerCache::setSystem(1000, 3);
+    UP_ASSERT(AutotunerCache::getSystemKey() != key_1000);
+    }
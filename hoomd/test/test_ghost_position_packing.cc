@@ -0,0 +1,79 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/GhostPositionPacking.h"
+
+using namespace std;
+
+/*! \file test_ghost_position_packing.cc
+    \brief Implements unit tests for the fixed-point ghost position encoding
+    \ingroup unit_tests
+*/
+
+//! Encoding for the domain [lo, hi) (fractions) of a decomposition along x with a window of
+//! 2^-window_exp box lengths
+GhostPositionPacking make_packing(unsigned int bits, int window_exp, double lo, double hi)
+    {
+    GhostPositionPacking p;
+    p.bits = bits;
+    for (unsigned int d = 0; d < 3; ++d)
+        {
+        p.steps[d] = std::ldexp(1.0, int(bits) + (d == 0 ? window_exp : 0));
+        double center = d == 0 ? 0.5 * (lo + hi) : 0.5;
+        p.center[d] = (int64_t)std::floor(center * p.steps[d] + 0.5);
+        }
+    return p;
+    }
+
+//! Ghosts decode to within half a quantization step
+UP_TEST(ghost_position_packing_roundtrip)
+    {
+    BoxDim box(20.0);
+
+    // four domains along x, the window (half a box length) covers a domain and its ghost layers
+    GhostPositionPacking sender = make_packing(16, 1, 0.0, 0.25);
+    GhostPositionPacking receiver = make_packing(16, 1, 0.25, 0.5);
+
+    Scalar4 pos = make_scalar4(-5.3, 1.25, -7.9, __int_as_scalar(3));
+    uint3 packed = packGhostPosition(sender, box, pos);
+    Scalar4 unpacked = unpackGhostPosition(receiver, box, packed);
+
+    Scalar tol_x = Scalar(0.5 * 20.0 / receiver.steps[0]) + Scalar(1e-5);
+    Scalar tol_yz = Scalar(0.5 * 20.0 / receiver.steps[1]) + Scalar(1e-5);
+    UP_ASSERT(std::abs(unpacked.x - pos.x) <= tol_x);
+    UP_ASSERT(std::abs(unpacked.y - pos.y) <= tol_yz);
+    UP_ASSERT(std::abs(unpacked.z - pos.z) <= tol_yz);
+    UP_ASSERT_EQUAL(__scalar_as_int(unpacked.w), 3);
+    }
+
+//! Ghosts received across the periodic boundary decode into the image next to the receiver
+UP_TEST(ghost_position_packing_periodic)
+    {
+    BoxDim box(20.0);
+
+    GhostPositionPacking sender = make_packing(16, 1, 0.75, 1.0);
+    GhostPositionPacking receiver = make_packing(16, 1, 0.0, 0.25);
+
+    Scalar4 pos = make_scalar4(9.7, 0.0, 0.0, __int_as_scalar(0));
+    Scalar4 unpacked = unpackGhostPosition(receiver, box, packGhostPosition(sender, box, pos));
+
+    Scalar tol = Scalar(0.5 * 20.0 / receiver.steps[0]) + Scalar(1e-5);
+    UP_ASSERT(std::abs(unpacked.x - (pos.x - Scalar(20.0))) <= tol);
+
+    // the image the sender wraps the ghost into does not change the encoding
+    Scalar4 wrapped = make_scalar4(pos.x - Scalar(20.0), 0.0, 0.0, __int_as_scalar(0));
+    uint3 packed = packGhostPosition(sender, box, pos);
+    uint3 packed_wrapped = packGhostPosition(sender, box, wrapped);
+    UP_ASSERT_EQUAL(packed.x, packed_wrapped.x);
+    UP_ASSERT_EQUAL(packed.y, packed_wrapped.y);
+    }
@@ -12,6 +12,7 @@
 #include "hoomd/GPUVector.h"
 
 #ifdef ENABLE_HIP
+#include "hoomd/MemoryPool.h"
 #include "test_gpu_array.cuh"
 #endif
 
@@ -450,4 +451,38 @@ UP_TEST(GPUVector_basic_tests)
     UP_ASSERT_EQUAL((unsigned int)v2[2], (unsigned int)3);
     UP_ASSERT_EQUAL((unsigned int)v2[3], (unsigned int)3);
     }
+
+//! Tests that freed device memory returns to the pool
+UP_TEST(GPUArray_memory_pool_tests)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    MemoryPool& pool = exec_conf->getMemoryPool();
+
+    // the size classes hold the requested size, with at most 25% overhead
+    UP_ASSERT_EQUAL(MemoryPool::getSizeClass(1), (size_t)512);
+    UP_ASSERT_EQUAL(MemoryPool::getSizeClass(1024), (size_t)1024);
+    UP_ASSERT_EQUAL(MemoryPool::getSizeClass(1025), (size_t)1280);
+    UP_ASSERT_EQUAL(MemoryPool::getSizeClass(3000), (size_t)3072);
+
+    size_t cached_bytes = pool.getCachedBytes();
+    size_t num_misses = pool.getNumMisses();
+
+    unsigned int* first_ptr;
+        {
+        GPUArray<unsigned int> a(1000, exec_conf);
+        ArrayHandle<unsigned int> d_handle(a, access_location::device, access_mode::overwrite);
+        first_ptr = d_handle.data;
+        }
+
+    // the block is cached and serves the next array of the same size class
+    UP_ASSERT(pool.getCachedBytes() > cached_bytes);
+    size_t num_hits = pool.getNumHits();
+
+    GPUArray<unsigned int> b(900, exec_conf);
+    ArrayHandle<unsigned int> d_handle(b, access_location::device, access_mode::overwrite);
+    UP_ASSERT_EQUAL(d_handle.data, first_ptr);
+    UP_ASSERT_EQUAL(pool.getNumHits(), num_hits + 1);
+    UP_ASSERT_EQUAL(pool.getNumMisses(), num_misses + 1);
+    }
 #endif
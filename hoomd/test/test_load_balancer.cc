@@ -365,6 +365,156 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1, 0, 1));
     }
 
+//! Other particles for the load balancer that are always owned by the rank whose domain has them
+class test_particles : public LoadBalancerParticles
+    {
+    public:
+    //! Constructor
+    /*!
+     * \param pdata Particle data to take the local box from
+     * \param pos Positions of all the particles
+     * \param grid_spacing Spacing of the grid for the boundaries
+     */
+    test_particles(std::shared_ptr<ParticleData> pdata,
+                   const std::vector<Scalar3>& pos,
+                   Scalar grid_spacing)
+        : m_pdata(pdata), m_global_pos(pos), m_pos(pos.size(), pdata->getExecConf()),
+          m_grid_spacing(grid_spacing)
+        {
+        }
+
+    const GlobalArray<Scalar4>& getPositions()
+        {
+        select();
+        return m_pos;
+        }
+
+    unsigned int getN()
+        {
+        return select();
+        }
+
+    unsigned int getNGlobal()
+        {
+        return (unsigned int)m_global_pos.size();
+        }
+
+    Scalar getWeight()
+        {
+        return Scalar(1.0);
+        }
+
+    Scalar getGridSpacing()
+        {
+        return m_grid_spacing;
+        }
+
+    Scalar getMinDomainWidth()
+        {
+        return Scalar(0.0);
+        }
+
+    private:
+    std::shared_ptr<ParticleData> m_pdata;
+    std::vector<Scalar3> m_global_pos;
+    GlobalArray<Scalar4> m_pos;
+    Scalar m_grid_spacing;
+
+    //! Select the particles in the local box, which migrates them with the domains
+    unsigned int select()
+        {
+        const BoxDim box = m_pdata->getBox();
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        unsigned int N = 0;
+        for (const auto& pos : m_global_pos)
+            {
+            const Scalar3 f = box.makeFraction(pos);
+            if (f.x >= Scalar(0.0) && f.x < Scalar(1.0) && f.y >= Scalar(0.0) && f.y < Scalar(1.0)
+                && f.z >= Scalar(0.0) && f.z < Scalar(1.0))
+                {
+                h_pos.data[N++] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(0));
+                }
+            }
+        return N;
+        }
+    };
+
+template<class LB>
+void test_load_balancer_particles(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    // create a system with one particle in the middle of each domain
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8, // number of particles
+                                                                  BoxDim(2.0),
+                                                                  1, // number of particle types
+                                                                  0, // number of bond types
+                                                                  0, // number of angle types
+                                                                  0, // number of dihedral types
+                                                                  0, // number of dihedral types
+                                                                  exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+    for (unsigned int i = 0; i < 8; ++i)
+        {
+        pdata->setPosition(i,
+                           make_scalar3((i & 1) ? 0.5 : -0.5,
+                                        (i & 2) ? 0.5 : -0.5,
+                                        (i & 4) ? 0.5 : -0.5),
+                           false);
+        }
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+    sysdef->setCommunicator(comm);
+
+    pdata->initializeFromSnapshot(snap);
+    comm->migrateParticles();
+
+    // the other particles are all in the upper half along x, so the MD particles alone are balanced
+    std::vector<Scalar3> pos;
+    for (unsigned int i = 0; i < 8; ++i)
+        {
+        pos.push_back(make_scalar3((i & 1) ? 0.75 : 0.25,
+                                   (i & 2) ? 0.5 : -0.5,
+                                   (i & 4) ? 0.5 : -0.5));
+        }
+    auto particles = std::make_shared<test_particles>(pdata, pos, Scalar(0.2));
+    UP_ASSERT_EQUAL(particles->getN(), (decomposition->getGridPos().x == 1) ? 2 : 0);
+
+    auto trigger = std::make_shared<PeriodicTrigger>(1);
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef, trigger));
+    lb->enableDimension(1, false);
+    lb->enableDimension(2, false);
+    lb->setParticles(particles);
+
+    for (unsigned int t = 0; t < 20; ++t)
+        {
+        lb->update(t);
+        }
+
+    // the boundary is on the grid between the other particles at x = 0.25 and the MD particles
+    vector<Scalar> frac_x = decomposition->getCumulativeFractions(0);
+    MY_CHECK_CLOSE(frac_x[1], 0.7, tol);
+
+    // each rank owns one MD particle and one other particle
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(particles->getN(), 1);
+    }
+
 //! Tests basic particle redistribution
 UP_TEST(LoadBalancer_test_basic)
     {
@@ -404,6 +554,14 @@ UP_TEST(LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0, -.6, .7, .5));
     }
 
+//! Tests balancing other particles together with the MD particles
+UP_TEST(LoadBalancer_test_particles)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    test_load_balancer_particles<LoadBalancer>(exec_conf);
+    }
+
 #ifdef ENABLE_HIP
 //! Tests basic particle redistribution on the GPU
 UP_TEST(LoadBalancerGPU_test_basic)
@@ -443,6 +601,14 @@ UP_TEST(LoadBalancerGPU_test_ghost)
     // triclinic box 2
     test_load_balancer_ghost<LoadBalancerGPU>(exec_conf, BoxDim(1.0, -.6, .7, .5));
     }
+
+//! Tests balancing other particles together with the MD particles on the GPU
+UP_TEST(LoadBalancerGPU_test_particles)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    test_load_balancer_particles<LoadBalancerGPU>(exec_conf);
+    }
 #endif // ENABLE_HIP
 
 #endif // ENABLE_MPI
@@ -169,3 +169,52 @@ UP_TEST(Messenger_file)
 
     unlink("test_messenger_output");
     }
+
+UP_TEST(Messenger_buffered)
+    {
+    Messenger msg;
+    ostringstream strm;
+    msg.setNoticeStream(strm);
+    msg.setErrorStream(strm);
+    msg.setErrorPrefix("err");
+    msg.setBuffered(true);
+    UP_ASSERT(msg.getBuffered());
+
+    // notices go to the buffer, errors wait for the buffered notices
+    msg.notice(1) << "1" << endl;
+    msg.notice(1) << "2" << endl;
+    msg.error() << "3" << endl;
+    msg.notice(1) << "4" << endl;
+    msg.flush();
+    UP_ASSERT_EQUAL(strm.str(), string("1\n2\nerr: 3\n4\n"));
+
+    // turning buffering off writes the remaining notices
+    msg.notice(1) << "5" << endl;
+    msg.setBuffered(false);
+    UP_ASSERT(!msg.getBuffered());
+    UP_ASSERT_EQUAL(strm.str(), string("1\n2\nerr: 3\n4\n5\n"));
+    UP_ASSERT_EQUAL(&(msg.notice(1)), &strm);
+
+    UP_ASSERT(msg.isNoticeEnabled(2));
+    UP_ASSERT(!msg.isNoticeEnabled(3));
+    }
+
+UP_TEST(Messenger_file_per_rank)
+    {
+        {
+        Messenger msg;
+        msg.setBuffered(true);
+        msg.openFile("test_messenger_rank", true);
+        UP_ASSERT(msg.getPerRank());
+        msg.noticeStr(1, "Notice 1\n");
+        }
+
+    UP_ASSERT(filesystem::exists("test_messenger_rank.0"));
+    ifstream f("test_messenger_rank.0");
+    string line;
+    getline(f, line);
+    UP_ASSERT_EQUAL(line, "Notice 1");
+    f.close();
+
+    unlink("test_messenger_rank.0");
+    }
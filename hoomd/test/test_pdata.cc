@@ -614,6 +614,64 @@ UP_TEST(ParticleData_test)
         }
     }
 
+//! Checks that the structure of arrays position copy follows writes to the positions
+UP_TEST(ParticleData_positions_soa)
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    ParticleData pdata(3, box, 2, exec_conf);
+
+    Scalar tol = Scalar(1e-6);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        for (unsigned int i = 0; i < 3; i++)
+            h_pos.data[i]
+                = make_scalar4(Scalar(i), Scalar(i + 1), Scalar(i + 2), __int_as_scalar(i % 2));
+        }
+
+    const pdata_positions_soa& soa = pdata.getPositionsSoA();
+    UP_ASSERT_EQUAL(soa.x.size(), size_t(3));
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        MY_CHECK_CLOSE(soa.x[i], Scalar(i), tol);
+        MY_CHECK_CLOSE(soa.y[i], Scalar(i + 1), tol);
+        MY_CHECK_CLOSE(soa.z[i], Scalar(i + 2), tol);
+        UP_ASSERT_EQUAL(soa.type[i], i % 2);
+        }
+
+    // reading the positions keeps the copy, writing them triggers a rebuild
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::read);
+        }
+    UP_ASSERT_EQUAL(pdata.getPositionsSoA().x.data(), soa.x.data());
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[1].x = Scalar(4.0);
+        }
+    MY_CHECK_CLOSE(pdata.getPositionsSoA().x[1], 4.0, tol);
+
+    // swapping in the alternate positions also triggers a rebuild
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_alt(pdata.getAltPositions(),
+                                       access_location::host,
+                                       access_mode::overwrite);
+        for (unsigned int i = 0; i < 3; i++)
+            h_pos_alt.data[i] = h_pos.data[2 - i];
+        }
+    pdata.swapPositions();
+    MY_CHECK_CLOSE(pdata.getPositionsSoA().x[0], 2.0, tol);
+    MY_CHECK_CLOSE(pdata.getPositionsSoA().x[2], 0.0, tol);
+    UP_ASSERT_EQUAL(pdata.getPositionsSoA().type[2], 0u);
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST(Random_test)
     {
@@ -24,6 +24,14 @@ Example:
 
             def compute(self, timestep):
                 return (timestep**(1 / 2)).is_integer()
+
+`hoomd.Simulation` evaluates a user defined trigger on every step. Override
+`Trigger.next_step` to tell it the steps on which the trigger cannot be active,
+so that it can skip them::
+
+            def next_step(self, timestep):
+                root = math.isqrt(timestep)
+                return root**2 if root**2 == timestep else (root + 1)**2
 """
 
 from hoomd import _hoomd
@@ -78,6 +86,23 @@ class Trigger(_hoomd.Trigger):
 
             Returns:
                 bool: `True` when the trigger is active, `False` when it is not.
+
+        next_step(timestep):
+            Find the first step at which the trigger may be active.
+
+            Args:
+                timestep (int): The first timestep to consider.
+
+            Returns:
+                int: A step *n* >= *timestep* such that the trigger is not
+                active on any step from *timestep* to *n* - 1, or
+                `Trigger.never` when it is never active again. The trigger
+                is still evaluated on step *n*, so *n* may be a lower bound.
+                The base class returns *timestep*.
+
+    Attributes:
+        never (int): Value of `next_step` when the trigger is never active
+            again.
     """
 
     def __getstate__(self):
@@ -380,3 +405,47 @@ class Or(_hoomd.OrTrigger, Trigger):
     def __eq__(self, other):
         """Test for equivalent triggers."""
         return isinstance(other, Or) and self.triggers == other.triggers
+
+
+class Schedule(_hoomd.ScheduleTrigger, Trigger):
+    """Trigger periodically with a period that changes in stages.
+
+    Args:
+        stages (`list` [`tuple` [`int`, `int`]]): The (first step, period) of
+            each stage in increasing order of first step.
+
+    Each stage begins on its first step and triggers every *period* steps
+    from there until the next stage begins. A stage with a period of 0 does
+    not trigger. `hoomd.trigger.Schedule` is not active before the first
+    stage::
+
+        first, period = stages[i]  # the last stage with first <= t
+        return period != 0 and (t - first) % period == 0
+
+    `hoomd.trigger.Schedule` evaluates in C++. It replaces an `Or` of
+    `And` combinations of `After`, `Before`, and `Periodic` triggers, and
+    avoids the Python callback that a custom `Trigger` makes on every step.
+
+    Example::
+
+            # write every 10 steps for the first 1000 steps, then every 1000
+            # steps, and stop writing at step 100000.
+            trigger = hoomd.trigger.Schedule([(0, 10), (1000, 1000),
+                                              (100000, 0)])
+
+    Attributes:
+        stages (`list` [`tuple` [`int`, `int`]]): The (first step, period) of
+            each stage.
+    """
+
+    def __init__(self, stages):
+        Trigger.__init__(self)
+        _hoomd.ScheduleTrigger.__init__(self, stages)
+
+    def __str__(self):
+        """Human readable representation of the trigger as a string."""
+        return f"hoomd.trigger.Schedule(stages={self.stages})"
+
+    def __eq__(self, other):
+        """Test for equivalent triggers."""
+        return isinstance(other, Schedule) and self.stages == other.stages
@@ -5,7 +5,7 @@
 """Tuners."""
 
 from hoomd.tune.sorter import ParticleSorter
-from hoomd.tune.balance import LoadBalancer
+from hoomd.tune.balance import LoadBalancer, split_fractions
 from hoomd.tune.custom_tuner import CustomTuner, _InternalCustomTuner
 from hoomd.tune.attr_tuner import (ManualTuneDefinition, SolverStep,
                                    ScaleSolver, SecantSolver)
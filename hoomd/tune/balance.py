@@ -1,10 +1,12 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
 import hoomd
+import numpy
 
 
 class LoadBalancer(Tuner):
@@ -19,6 +21,7 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        cost (`str`): Quantity to balance, ``'particles'`` or ``'time'``.
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -48,6 +51,25 @@ class LoadBalancer(Tuner):
     significantly more pair force neighbors than others, this estimate of the
     load imbalance may not produce the optimal results.
 
+    Set *cost* to ``'time'`` to balance the measured cost of the particles
+    instead. `LoadBalancer` then times the force computes (including the
+    neighbor lists) of the integrator on each rank and weights the particles on
+    rank :math:`i` by :math:`w_i`, the time per particle on rank :math:`i` since
+    the previous balancing step divided by the average time per particle:
+
+    .. math::
+
+        I = \frac{w_i N_i}{\sum_j w_j N_j / P}
+
+    The weights are 1 until the forces have been timed for at least one step.
+    On the GPU, the timing synchronizes with the device after every force
+    compute, which may slow down the simulation slightly. Operations that
+    communicate between ranks in their force computes (such as
+    `hoomd.md.long_range.pppm`) include the time spent waiting for other ranks
+    in the measured cost. The MPCD integrator also includes the time spent on
+    the MPCD particles, so use `hoomd.mpcd.tune.LoadBalancer` to balance the
+    MPCD particles with the MD particles.
+
     A load balancing adjustment is only performed when the maximum load
     imbalance exceeds a *tolerance*. The ideal load balance is 1.0, so setting
     *tolerance* less than 1.0 will force an adjustment every update. The load
@@ -82,6 +104,7 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        cost (`str`): Quantity to balance, ``'particles'`` or ``'time'``.
     """
 
     def __init__(self,
@@ -90,18 +113,21 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 cost='particles'):
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
                         max_iterations=max_iterations,
+                        cost=cost,
                         trigger=trigger)
         self._param_dict = ParameterDict(x=bool,
                                          y=bool,
                                          z=bool,
                                          max_iterations=int,
                                          tolerance=float,
+                                         cost=OnlyFrom(['particles', 'time']),
                                          trigger=Trigger)
         self._param_dict.update(defaults)
 
@@ -113,5 +139,89 @@ class LoadBalancer(Tuner):
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
                                 self.trigger)
+        self._cpp_obj.setSystem(self._simulation._cpp_sys)
 
         super()._attach()
+
+
+# smallest fraction of the box split_fractions assigns to a domain
+_min_fraction = 1e-6
+
+
+def split_fractions(snapshot, grid):
+    """Compute domain decomposition fractions that balance a snapshot.
+
+    Args:
+        snapshot (hoomd.Snapshot): Snapshot to balance.
+        grid (tuple[int, int, int]): Number of domains in the x, y, and z
+            directions.
+
+    Returns:
+        tuple[list[float], list[float], list[float]]: The fraction of the
+        simulation box to include in each domain, suitable for the
+        ``domain_decomposition`` argument of
+        `hoomd.Simulation.create_state_from_snapshot`.
+
+    `split_fractions` places the domain boundaries along each direction at the
+    quantiles of the particle positions so that every slab of domains holds
+    the same number of particles. Use it to start a strongly inhomogeneous
+    system (e.g. a droplet or a vapor-liquid slab) close to balance instead of
+    waiting for `LoadBalancer` to move the boundaries 5% at a time.
+
+    The domain decomposition is a Cartesian grid, so the boundaries along one
+    direction are the same for all domains in the other directions. The
+    particle counts of individual domains are balanced only when the density
+    varies along one direction, or separably along each.
+
+    Note:
+        The fractions do not account for the minimum domain width set by the
+        ghost layer. Domains that are too narrow for the interactions cause an
+        error when the simulation runs.
+
+    Note:
+        The particle positions are only available on rank 0. `split_fractions`
+        returns evenly spaced fractions on the other ranks, and the domain
+        decomposition uses the fractions from rank 0.
+
+    Example::
+
+        fractions = hoomd.tune.split_fractions(snapshot, (2, 2, 4))
+        simulation.create_state_from_snapshot(
+            snapshot, domain_decomposition=fractions)
+    """
+    grid = tuple(int(n) for n in grid)
+    if len(grid) != 3 or min(grid) < 1:
+        raise ValueError("grid must be 3 positive integers.")
+
+    fractions = [[1.0 / n] * n for n in grid]
+    if snapshot.communicator.rank != 0 or snapshot.particles.N == 0:
+        return tuple(fractions)
+
+    box = snapshot.configuration.box
+    if box[2] == 0 and grid[2] != 1:
+        raise ValueError("2D boxes cannot be decomposed in z.")
+
+    # fractional coordinates in the global box, as in BoxDim::makeFraction
+    L = numpy.array(box[0:3], dtype=numpy.float64)
+    xy, xz, yz = box[3:6]
+    pos = numpy.array(snapshot.particles.position, dtype=numpy.float64)
+    delta = pos + L / 2
+    delta[:, 0] -= (xz - yz * xy) * pos[:, 2] + xy * pos[:, 1]
+    delta[:, 1] -= yz * pos[:, 2]
+
+    for dim, n in enumerate(grid):
+        if n == 1:
+            continue
+
+        f = numpy.clip(delta[:, dim] / L[dim], 0.0, 1.0)
+        cuts = numpy.quantile(f, numpy.arange(1, n) / n)
+
+        # keep every domain a nonzero width when many particles share a plane
+        bounds = [0.0] + [float(c) for c in cuts] + [1.0]
+        for i in range(1, n):
+            bounds[i] = max(bounds[i], bounds[i - 1] + _min_fraction)
+        for i in range(n - 1, 0, -1):
+            bounds[i] = min(bounds[i], bounds[i + 1] - _min_fraction)
+        fractions[dim] = [bounds[i + 1] - bounds[i] for i in range(n)]
+
+    return tuple(fractions)
@@ -2,6 +2,7 @@
 
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyTypes
+from hoomd.logging import log
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
@@ -20,11 +21,28 @@ class ParticleSorter(Tuner):
             value of `None` sets ``grid=4096`` in 2D simulations and
             ``grid=256`` in 3D simulations.
 
+        disorder_threshold (float): Sort only when the disorder of the
+            particle order exceeds this value. The default value of 0 sorts on
+            every triggered timestep.
+
+        sort_by_type (bool): Order particles by type within each cell of the
+            space-filling curve. Defaults to `False`.
+
     `ParticleSorter` improves simulation performance by sorting the particles in
     memory along a space-filling curve. This takes particles that are close in
     space and places them close in memory, leading to a higher rate of
     cache hits when computing pair potentials.
 
+    Each sort reorders all particle data in memory and forces the neighbor
+    lists to rebuild. Set `disorder_threshold` to sort only when the particles
+    have moved far enough out of order to pay for the sort. On each triggered
+    timestep, `ParticleSorter` then measures the `disorder`: the fraction of
+    consecutive particles in memory that are out of space-filling curve order.
+    The disorder is 0 right after a sort and approaches 1/2 for a random order.
+    Pair with a frequent trigger, such as ``trigger=50`` with
+    ``disorder_threshold=0.1``, so that the sorter adapts to the rate at which
+    the system diffuses.
+
     Note:
         New `hoomd.Operations` instances include a `ParticleSorter`
         constructed with default parameters.
@@ -37,17 +55,45 @@ class ParticleSorter(Tuner):
             of `grid` provide more accurate space-filling curves, but consume
             more memory (``grid**D * 4`` bytes, where *D* is the dimensionality
             of the system).
+
+        disorder_threshold (float): Sort only when the disorder of the
+            particle order exceeds this value. Set to 0 to sort on every
+            triggered timestep.
+
+        sort_by_type (bool): Order particles by type within each cell of the
+            space-filling curve. Threads that evaluate neighboring particles
+            on the GPU then share type parameters, which helps pair potentials
+            in systems with many types. The number of types times ``grid**D``
+            must be less than :math:`2^{32}`.
     """
 
-    def __init__(self, trigger=200, grid=None):
+    def __init__(self,
+                 trigger=200,
+                 grid=None,
+                 disorder_threshold=0.,
+                 sort_by_type=False):
         self._param_dict = ParameterDict(
             trigger=Trigger,
             grid=OnlyTypes(int,
                            postprocess=ParticleSorter._to_power_of_two,
                            preprocess=ParticleSorter._natural_number,
-                           allow_none=True))
+                           allow_none=True),
+            disorder_threshold=float,
+            sort_by_type=bool)
         self.trigger = trigger
         self.grid = grid
+        self.disorder_threshold = disorder_threshold
+        self.sort_by_type = sort_by_type
+
+    @log(requires_run=True)
+    def disorder(self):
+        """float: Disorder measured on the last triggered timestep."""
+        return self._cpp_obj.disorder
+
+    @log(requires_run=True)
+    def num_sorts(self):
+        """int: Number of times the particles have been sorted."""
+        return self._cpp_obj.num_sorts
 
     @staticmethod
     def _to_power_of_two(value):
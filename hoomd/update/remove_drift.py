@@ -44,9 +44,9 @@ class RemoveDrift(Updater):
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.GPU):
-            self._simulation.device._cpp_msg.warning(
-                "Falling back on CPU. No GPU implementation available.\n")
-
-        self._cpp_obj = _hoomd.UpdaterRemoveDrift(
-            self._simulation.state._cpp_sys_def, self.reference_positions)
+            cpp_class = _hoomd.UpdaterRemoveDriftGPU
+        else:
+            cpp_class = _hoomd.UpdaterRemoveDrift
+        self._cpp_obj = cpp_class(self._simulation.state._cpp_sys_def,
+                                  self.reference_positions)
         super()._attach()
@@ -188,3 +188,36 @@ class Power(_hoomd.VariantPower, Variant):
         _hoomd.VariantPower.__init__(self, A, B, power, t_start, t_ramp)
 
     __eq__ = Variant._private_eq
+
+
+class PiecewiseLinear(_hoomd.VariantPiecewiseLinear, Variant):
+    """A piecewise linear function.
+
+    Args:
+        points (`list` [`tuple` [`int`, `float`]]): The (time step, value)
+            points in increasing order of time step.
+
+    `PiecewiseLinear` holds the value of the first point until its time step.
+    Then it interpolates linearly between consecutive points and holds the
+    value of the last point after its time step.
+
+    Use `PiecewiseLinear` for schedules with several stages, such as
+    annealing protocols. It evaluates in C++, so it avoids the Python callback
+    that a custom `Variant` makes on every time step.
+
+    Example::
+
+        kT = hoomd.variant.PiecewiseLinear([(0, 2.0), (10000, 2.0),
+                                            (50000, 0.5), (60000, 1.0)])
+
+    Attributes:
+        points (`list` [`tuple` [`int`, `float`]]): The (time step, value)
+            points.
+    """
+    _eq_attrs = ("points",)
+
+    def __init__(self, points):
+        Variant.__init__(self)
+        _hoomd.VariantPiecewiseLinear.__init__(self, points)
+
+    __eq__ = Variant._private_eq
@@ -5,6 +5,9 @@
 """Version and build information.
 
 Attributes:
+    adios2_enabled (bool): ``True`` when this build supports the
+        `hoomd.write.ADIOS2` writer.
+
     build_dir (str): The directory where this build was compiled.
 
     compile_date (str): The date this build was compiled.
@@ -46,6 +49,9 @@ Attributes:
 
     mpi_enabled (bool): ``True`` when this build supports MPI parallel runs.
 
+    papi_enabled (bool): ``True`` when the profiler samples hardware counters
+        with PAPI.
+
     source_dir (str): The source directory.
 
     tbb_enabled (bool): ``True`` when this build supports TBB threads.
@@ -55,6 +61,7 @@ Attributes:
 from hoomd import _hoomd
 
 from hoomd.version_config import (
+    adios2_enabled,
     build_dir,
     compile_date,
     cuda_include_path,
@@ -67,6 +74,7 @@ from hoomd.version_config import (
     md_built,
     metal_built,
     mpcd_built,
+    papi_enabled,
 )
 
 version = _hoomd.BuildInfo.getVersion()
@@ -4,6 +4,10 @@
 
 """Writers."""
 
+from hoomd.write.adios2 import ADIOS2
+from hoomd.write.async_analyzer import AsyncAnalyzer
+from hoomd.write.binary_log import BinaryLog
+from hoomd.write.checkpoint import Checkpoint
 from hoomd.write.custom_writer import CustomWriter
 from hoomd.write.gsd import GSD
 from hoomd.write.dcd import DCD
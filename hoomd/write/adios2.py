@@ -0,0 +1,132 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Stream simulation data through ADIOS2."""
+
+import hoomd
+from hoomd import _hoomd
+from hoomd.data.typeconverter import OnlyFrom
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.filter import ParticleFilter, All
+from hoomd.logging import Logger
+from hoomd.operation import Writer
+from hoomd.write.gsd import _array_to_strings, _GSDLogWriter
+
+
+class ADIOS2(Writer):
+    """Write or stream particle data with ADIOS2.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): File or stream name to write.
+        filter (hoomd.filter.ParticleFilter): Select the particles to write.
+            Defaults to `hoomd.filter.All`.
+        engine (str): ADIOS2 engine. Defaults to ``'BP5'``.
+        parameters (dict[str, str]): ADIOS2 engine parameters. Defaults to
+            `None` (no parameters).
+        dynamic (list[str]): Quantity categories to save in every step.
+            Defaults to ``['property']``.
+        log (hoomd.logging.Logger): Provide log quantities to write. Defaults to
+            `None`.
+
+    `ADIOS2` writes one ADIOS2 step each time it triggers. The ADIOS2 engine
+    selects the output: ``'BP4'`` and ``'BP5'`` write files, ``'SST'`` streams
+    the steps to a reader that runs concurrently with the simulation
+    (in-transit analysis), and ``'HDF5'`` writes a parallel HDF5 file. See the
+    `ADIOS2 documentation <https://adios2.readthedocs.io/>`__ for the engines
+    and their parameters.
+
+    Each MPI rank puts the selected particles that it owns into the global
+    arrays of the step, so `ADIOS2` does not gather the particles to one rank.
+    The particles are not in tag order, the array ``particles/tag`` holds the
+    tag of each particle.
+
+    The particle quantities have the same names, types, and categories as in
+    `GSD`, see `GSD` for the list. ``dynamic`` selects the categories written
+    in every step (**property** is always dynamic), `ADIOS2` writes all
+    categories in the first step. **topology** is not supported. Rank 0 also
+    writes ``configuration/step``, ``configuration/box``,
+    ``configuration/dimensions`` (first step), and the logged quantities in the
+    same namespace as `GSD`. The particle type names are stored in the
+    attribute ``particles/types``.
+
+    Note:
+        `ADIOS2` is only available when HOOMD-blue is built with ADIOS2 (see
+        `hoomd.version.adios2_enabled`).
+
+    Attributes:
+        filename (str): File or stream name to write.
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filter (hoomd.filter.ParticleFilter): Select the particles to write.
+        engine (str): ADIOS2 engine.
+        parameters (dict[str, str]): ADIOS2 engine parameters.
+        dynamic (list[str]): Quantity categories to save in every step.
+    """
+
+    def __init__(self,
+                 trigger,
+                 filename,
+                 filter=All(),
+                 engine='BP5',
+                 parameters=None,
+                 dynamic=None,
+                 log=None):
+
+        super().__init__(trigger)
+
+        dynamic_validation = OnlyFrom(['attribute', 'property', 'momentum'],
+                                      preprocess=_array_to_strings)
+
+        dynamic = ['property'] if dynamic is None else dynamic
+        parameters = {} if parameters is None else parameters
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          filter=ParticleFilter,
+                          engine=str(engine),
+                          parameters=dict,
+                          dynamic=[dynamic_validation],
+                          _defaults=dict(filter=filter,
+                                         parameters={
+                                             str(k): str(v)
+                                             for k, v in parameters.items()
+                                         },
+                                         dynamic=dynamic)))
+
+        self._log = None if log is None else _GSDLogWriter(log)
+
+    def _attach(self):
+        if not hoomd.version.adios2_enabled:
+            raise RuntimeError("ADIOS2 requires HOOMD-blue built with ADIOS2 "
+                               "support.")
+
+        dynamic_quantities = ['property'] + list(self.dynamic)
+
+        self._cpp_obj = _hoomd.ADIOS2Writer(
+            self._simulation.state._cpp_sys_def, self.filename,
+            self._simulation.state._get_group(self.filter), self.engine,
+            self.parameters)
+
+        self._cpp_obj.setWriteAttribute('attribute' in dynamic_quantities)
+        self._cpp_obj.setWriteProperty('property' in dynamic_quantities)
+        self._cpp_obj.setWriteMomentum('momentum' in dynamic_quantities)
+        self._cpp_obj.log_writer = self.log
+        super()._attach()
+
+    @property
+    def log(self):
+        """hoomd.logging.Logger: Provide log quantities to write.
+
+        May be `None`.
+        """
+        return self._log
+
+    @log.setter
+    def log(self, log):
+        if log is not None and isinstance(log, Logger):
+            log = _GSDLogWriter(log)
+        else:
+            raise ValueError("ADIOS2.log can only be set with a Logger.")
+        if self._attached:
+            self._cpp_obj.log_writer = log
+        self._log = log
@@ -0,0 +1,231 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement AsyncAnalyzer."""
+
+from collections import deque
+from concurrent.futures import Executor, ThreadPoolExecutor
+import copy
+
+import numpy
+
+from hoomd.custom.custom_action import _InternalAction
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
+from hoomd.logging import log
+from hoomd.write.custom_writer import _InternalCustomWriter
+
+
+class _AsyncAnalyzerInternal(_InternalAction):
+    """Internal class for the AsyncAnalyzer writer."""
+
+    _valid_quantities = ('position', 'typeid', 'velocity', 'mass',
+                         'orientation', 'angmom', 'moment_inertia', 'charge',
+                         'diameter', 'image', 'tag', 'body')
+
+    def __init__(self,
+                 analyze,
+                 quantities=('position',),
+                 max_queue_depth=2,
+                 executor=None):
+        if not callable(analyze):
+            raise ValueError("analyze must be callable.")
+        if executor is not None and not isinstance(executor, Executor):
+            raise ValueError(
+                "executor must be a concurrent.futures.Executor or None.")
+        quantities = tuple(str(q) for q in quantities)
+        for quantity in quantities:
+            if quantity not in self._valid_quantities:
+                raise ValueError(f"{quantity} is not a particle quantity. "
+                                 f"Choose from {self._valid_quantities}.")
+
+        self._analyze = analyze
+        self._quantities = quantities
+        self._user_executor = executor
+        self._executor = None
+        self._simulation = None
+        self._pending = deque()
+        self._result = None
+        self._result_timestep = None
+
+        param_dict = ParameterDict(
+            max_queue_depth=OnlyTypes(int, postprocess=self._positive))
+        param_dict['max_queue_depth'] = max_queue_depth
+        self._param_dict.update(param_dict)
+
+    def attach(self, simulation):
+        self._simulation = simulation
+        if self._user_executor is None:
+            self._executor = ThreadPoolExecutor(max_workers=1)
+        else:
+            self._executor = self._user_executor
+
+    @property
+    def _attached(self):
+        return self._simulation is not None
+
+    def detach(self):
+        self.wait()
+        if self._user_executor is None and self._executor is not None:
+            self._executor.shutdown()
+        self._executor = None
+        self._simulation = None
+
+    @property
+    def analyze(self):
+        """callable: Function that analyzes the particle data."""
+        return self._analyze
+
+    @property
+    def quantities(self):
+        """tuple[str]: Particle quantities copied for the analysis."""
+        return self._quantities
+
+    @property
+    def num_pending(self):
+        """int: Number of analyses submitted that have not been collected."""
+        return len(self._pending)
+
+    @log(category='object', requires_run=True)
+    def result(self):
+        """Any: Result of the most recently completed analysis."""
+        self._collect(block=False)
+        return self._result
+
+    @property
+    def result_timestep(self):
+        """int: Timestep of the data analyzed in `result`.
+
+        `None` until an analysis completes.
+        """
+        self._collect(block=False)
+        return self._result_timestep
+
+    def act(self, timestep):
+        """Copy the particle data and submit it for analysis.
+
+        Args:
+            timestep (int): The current timestep in a simulation.
+        """
+        if not self._attached:
+            return
+
+        # the queue is bounded, wait for the oldest analyses to make room
+        self._collect(block=False)
+        while len(self._pending) >= self.max_queue_depth:
+            self._collect_oldest()
+
+        data = self._copy_data()
+        future = self._executor.submit(self._analyze, timestep, data)
+        self._pending.append((timestep, future))
+
+    def wait(self):
+        """Wait for all submitted analyses to complete."""
+        while len(self._pending) > 0:
+            self._collect_oldest()
+
+    def _copy_data(self):
+        """Copy the selected quantities of the local particles."""
+        with self._simulation.state.cpu_local_snapshot as snap:
+            data = {
+                quantity: numpy.array(getattr(snap.particles, quantity),
+                                      copy=True)
+                for quantity in self._quantities
+            }
+            data['box'] = snap.global_box
+        return data
+
+    def _collect(self, block):
+        """Store the results of the analyses that have completed in order."""
+        while len(self._pending) > 0 and (block or self._pending[0][1].done()):
+            self._collect_oldest()
+
+    def _collect_oldest(self):
+        timestep, future = self._pending.popleft()
+        # re-raises exceptions from the analysis on the simulation thread
+        self._result = future.result()
+        self._result_timestep = timestep
+
+    def __getstate__(self):
+        state = copy.copy(self.__dict__)
+        state['_user_executor'] = None
+        state['_executor'] = None
+        state['_simulation'] = None
+        state['_pending'] = deque()
+        return state
+
+    @staticmethod
+    def _positive(value):
+        if value <= 0:
+            raise ValueError(f"{value} must be positive.")
+        return value
+
+
+class AsyncAnalyzer(_InternalCustomWriter):
+    """Analyze copies of the particle data concurrently with the simulation.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to copy the
+            particle data.
+        analyze (callable): Function called as ``analyze(timestep, data)``
+            that returns the result of the analysis.
+        quantities (`list` [`str`]): Names of the particle quantities to copy
+            (any of ``position``, ``typeid``, ``velocity``, ``mass``,
+            ``orientation``, ``angmom``, ``moment_inertia``, ``charge``,
+            ``diameter``, ``image``, ``tag``, and ``body``).
+        max_queue_depth (int): Maximum number of analyses in flight.
+        executor (concurrent.futures.Executor): Executor that runs the
+            analyses. Defaults to a single worker thread.
+
+    `hoomd.write.CustomWriter` actions run in the timestep loop, so expensive
+    analysis stalls the simulation. When `AsyncAnalyzer` triggers, it instead
+    copies the selected quantities of the local particles to host memory (a
+    `dict` of `numpy.ndarray` keyed by quantity name, plus ``box``, the
+    global `hoomd.Box`). It submits the copy to *executor* and returns to the
+    simulation immediately. The executor calls *analyze* while the simulation
+    continues, because `hoomd.Simulation.run` releases the global interpreter
+    lock while the C++ operations execute.
+
+    At most *max_queue_depth* analyses are in flight. When the queue is full,
+    `AsyncAnalyzer` waits for the oldest one to complete before copying the
+    data again. The default of 2 double buffers the data: the simulation can
+    copy a frame while the previous one is analyzed.
+
+    The results are collected in the order of submission. `result` is the
+    result of the most recently completed analysis, and it is loggable, so
+    a `hoomd.logging.Logger` records it with the other quantities as the
+    results arrive. Exceptions raised by *analyze* are raised again on the
+    simulation thread when the result is collected. Call `wait` to collect
+    all results, for example at the end of a run. `AsyncAnalyzer` also waits
+    for all analyses when it is removed from the simulation.
+
+    Example::
+
+        def rdf(timestep, data):
+            return numpy.histogram(pair_distances(data['position'],
+                                                  data['box']),
+                                   bins=100)[0]
+
+        analyzer = hoomd.write.AsyncAnalyzer(
+            trigger=hoomd.trigger.Periodic(1000),
+            analyze=rdf,
+            quantities=['position'])
+        sim.operations.writers.append(analyzer)
+        sim.run(100000)
+        analyzer.wait()
+
+    Tip:
+        Pure python analysis competes with the other python operations for
+        the interpreter lock. Pass a `concurrent.futures.ProcessPoolExecutor`
+        as *executor* to analyze in other processes, in which case *analyze*
+        must be picklable.
+
+    Note:
+        In MPI simulations, each rank analyzes the particles in its local
+        domain.
+
+    Attributes:
+        max_queue_depth (int): Maximum number of analyses in flight.
+    """
+    _internal_class = _AsyncAnalyzerInternal
@@ -0,0 +1,382 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement BinaryLog."""
+
+import copy
+import json
+import os
+import struct
+
+import numpy
+
+from hoomd.custom import Action
+from hoomd.custom.custom_action import _InternalAction
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom, OnlyTypes
+from hoomd.logging import LoggerCategories, Logger
+from hoomd.write.custom_writer import _InternalCustomWriter
+
+_MAGIC = b'HOOMDLOG'
+_VERSION = 1
+# magic, format version, and length of the JSON description of the records
+_PREAMBLE = struct.Struct('<8sII')
+
+
+def _write_header(fh, dtype):
+    """Write the file header that describes the records with *dtype*."""
+    fields = []
+    for name in dtype.names:
+        field = dtype.fields[name][0]
+        if field.subdtype is None:
+            fields.append(dict(name=name, format=field.str, shape=[]))
+        else:
+            fields.append(
+                dict(name=name,
+                     format=field.subdtype[0].str,
+                     shape=list(field.subdtype[1])))
+    description = json.dumps(dict(fields=fields)).encode('utf-8')
+    # pad the header so that the records are 8 byte aligned
+    padding = -(_PREAMBLE.size + len(description)) % 8
+    description += b' ' * padding
+    fh.write(_PREAMBLE.pack(_MAGIC, _VERSION, len(description)))
+    fh.write(description)
+
+
+def _read_header(fh):
+    """Read the file header.
+
+    Returns:
+        tuple[numpy.dtype, int]: The record type and the offset of the first
+        record.
+    """
+    preamble = fh.read(_PREAMBLE.size)
+    if len(preamble) != _PREAMBLE.size:
+        raise RuntimeError("The file is not a BinaryLog file.")
+    magic, version, length = _PREAMBLE.unpack(preamble)
+    if magic != _MAGIC:
+        raise RuntimeError("The file is not a BinaryLog file.")
+    if version != _VERSION:
+        raise RuntimeError(f"Unsupported BinaryLog version {version}.")
+
+    fields = json.loads(fh.read(length).decode('utf-8'))['fields']
+    dtype = numpy.dtype([(f['name'], f['format'], tuple(f['shape']))
+                         for f in fields])
+    return dtype, _PREAMBLE.size + length
+
+
+def _field_format(value):
+    """Choose the fixed width storage of a logged value."""
+    value = numpy.asarray(value)
+    if value.dtype.kind in 'biu':
+        return '<i8', value.shape
+    if value.dtype.kind == 'f':
+        return '<f8', value.shape
+    raise ValueError(f"BinaryLog cannot store values of type {value.dtype}.")
+
+
+class _BinaryLogInternal(_InternalAction):
+    """Implements the logic for the binary logger backend.
+
+    Records are collected in a list in `~.act` and converted to a numpy
+    structured array when the buffer is flushed. The logged quantities and
+    their shapes are fixed at the first call.
+    """
+
+    _invalid_logger_categories = LoggerCategories.any([
+        'object', 'particle', 'bond', 'angle', 'dihedral', 'improper', 'pair',
+        'constraint', 'string', 'strings'
+    ])
+
+    flags = [
+        Action.Flags.ROTATIONAL_KINETIC_ENERGY, Action.Flags.PRESSURE_TENSOR,
+        Action.Flags.EXTERNAL_FIELD_VIRIAL, Action.Flags.FORCE_ARRAYS
+    ]
+
+    _skip_for_equality = {"_comm", "_entries", "_file", "_rows"}
+
+    def __init__(self,
+                 logger,
+                 filename,
+                 mode='ab',
+                 buffer_size=1000,
+                 max_lag=None):
+
+        param_dict = ParameterDict(
+            filename=str,
+            mode=OnlyFrom(['wb', 'xb', 'ab']),
+            buffer_size=OnlyTypes(int, postprocess=self._positive),
+            max_lag=OnlyTypes(int, allow_none=True, postprocess=self._positive),
+            logger=Logger)
+        param_dict.update(
+            dict(filename=filename,
+                 mode=mode,
+                 buffer_size=buffer_size,
+                 max_lag=max_lag,
+                 logger=logger))
+        self._param_dict = param_dict
+
+        if (logger.categories & (LoggerCategories.scalar
+                                 | LoggerCategories.sequence)
+                == LoggerCategories.NONE
+                or logger.categories & self._invalid_logger_categories
+                !=  # noqa: W504 (yapf formats this incorrectly
+                LoggerCategories.NONE):
+            raise ValueError("Given Logger must have only the scalar and "
+                             "sequence categories set.")
+
+        self._dtype = None
+        self._names = None
+        self._entries = None
+        self._rows = []
+        self._file = None
+        self._comm = None
+
+        # running average and autocorrelation of the scalar quantities
+        self._scalar_columns = None
+        self._num_samples = 0
+        self._sum = None
+        self._history = None
+        self._correlation = None
+        self._num_correlation = None
+
+    def _setattr_param(self, attr, value):
+        """Makes self._param_dict attributes read only."""
+        raise ValueError("Attribute {} is read-only.".format(attr))
+
+    def attach(self, simulation):
+        self._comm = simulation.device._comm
+
+    def detach(self):
+        self.flush()
+        if self._file is not None:
+            self._file.close()
+            self._file = None
+        self._comm = None
+
+    @property
+    def _is_root(self):
+        return self._comm is None or self._comm.rank == 0
+
+    def act(self, timestep):
+        """Buffer a record and write the buffer when it is full."""
+        # All ranks evaluate the quantities, which may reduce over MPI ranks.
+        entries = self.logger._entries()
+        values = [entry()[0] for _, entry in entries]
+
+        if entries is not self._entries:
+            names = ['/'.join(namespace) for namespace, _ in entries]
+            if self._dtype is None:
+                self._initialize(names, values)
+            elif names != self._names:
+                raise RuntimeError(
+                    "The quantities logged by BinaryLog cannot change.")
+            self._entries = entries
+
+        if self.max_lag is not None:
+            self._accumulate(values)
+
+        if self._is_root:
+            self._rows.append((timestep, *values))
+            if len(self._rows) >= self.buffer_size:
+                self.flush()
+
+    def flush(self):
+        """Write the buffered records to the file."""
+        if len(self._rows) == 0:
+            return
+        if self._file is None:
+            self._open()
+        records = numpy.array(self._rows, dtype=self._dtype)
+        self._file.write(records.tobytes())
+        self._file.flush()
+        self._rows = []
+
+    def _initialize(self, names, values):
+        if len(names) == 0:
+            raise RuntimeError("BinaryLog has no quantities to log.")
+        self._names = names
+        self._dtype = numpy.dtype([('timestep', '<u8')]
+                                  + [(name, *_field_format(value))
+                                     for name, value in zip(names, values)])
+        self._scalar_columns = [
+            i for i, name in enumerate(names)
+            if self._dtype.fields[name][0].shape == ()
+        ]
+
+    def _open(self):
+        filename = self.filename
+        if (self.mode == 'ab' and os.path.exists(filename)
+                and os.path.getsize(filename) > 0):
+            self._file = open(filename, 'r+b')
+            dtype, offset = _read_header(self._file)
+            if dtype != self._dtype:
+                self._file.close()
+                self._file = None
+                raise RuntimeError(
+                    f"The quantities in {filename} do not match the logged "
+                    f"quantities.")
+            # drop a partial record left by an interrupted write
+            num_records = (os.path.getsize(filename) - offset) \
+                // self._dtype.itemsize
+            self._file.truncate(offset + num_records * self._dtype.itemsize)
+            self._file.seek(0, os.SEEK_END)
+        else:
+            self._file = open(filename, 'xb' if self.mode == 'xb' else 'wb')
+            _write_header(self._file, self._dtype)
+
+    def _accumulate(self, values):
+        x = numpy.array([values[i] for i in self._scalar_columns],
+                        dtype=numpy.float64)
+        num_lags = self.max_lag + 1
+        if self._history is None or len(self._history) != num_lags:
+            self._num_samples = 0
+            self._sum = numpy.zeros_like(x)
+            self._history = numpy.zeros((num_lags, len(x)))
+            self._correlation = numpy.zeros((num_lags, len(x)))
+            self._num_correlation = numpy.zeros(num_lags, dtype=numpy.int64)
+
+        # the history is a ring buffer of the last max_lag + 1 samples
+        position = self._num_samples % num_lags
+        self._history[position] = x
+        available = min(self._num_samples + 1, num_lags)
+        previous = (position - numpy.arange(available)) % num_lags
+        self._correlation[:available] += self._history[previous] * x
+        self._num_correlation[:available] += 1
+        self._sum += x
+        self._num_samples += 1
+
+    @property
+    def mean(self):
+        """dict[str, float]: Running average of each scalar quantity."""
+        if self._num_samples == 0:
+            return {}
+        mean = self._sum / self._num_samples
+        return {
+            self._names[i]: mean[j] for j, i in enumerate(self._scalar_columns)
+        }
+
+    @property
+    def autocorrelation(self):
+        """dict[str, numpy.ndarray]: Autocorrelation of each scalar quantity.
+
+        Element *k* is the covariance of samples *k* records apart.
+        """
+        if self._num_samples == 0:
+            return {}
+        mean = self._sum / self._num_samples
+        used = self._num_correlation > 0
+        acf = self._correlation[used] / self._num_correlation[used, None] \
+            - mean**2
+        return {
+            self._names[i]: acf[:, j]
+            for j, i in enumerate(self._scalar_columns)
+        }
+
+    def __getstate__(self):
+        state = copy.copy(self.__dict__)
+        state.pop('_comm', None)
+        state['_entries'] = None
+        state['_file'] = None
+        state['_rows'] = []
+        return state
+
+    @staticmethod
+    def _positive(value):
+        if value <= 0:
+            raise ValueError(f"{value} must be positive.")
+        return value
+
+
+class BinaryLog(_InternalCustomWriter):
+    """Write scalar and sequence quantities to a columnar binary file.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to record the
+            logged quantities.
+        logger (hoomd.logging.Logger): The logger to query for output. Set
+            the 'scalar' and/or 'sequence' categories and no others.
+        filename (str): File name to write.
+        mode (str): The file open mode. ``'ab'`` appends to an existing file
+            with the same quantities, ``'wb'`` overwrites the file, and
+            ``'xb'`` fails if the file exists. Defaults to ``'ab'``.
+        buffer_size (int): Number of records to buffer before writing them to
+            the file. Defaults to 1000.
+        max_lag (int): When not `None`, accumulate the running average and the
+            autocorrelation of the scalar quantities up to *max_lag* records
+            apart. Defaults to `None`.
+
+    `BinaryLog` writes quantities logged every few steps more compactly and
+    with less overhead than `Table` or the ``log`` chunks of `GSD`. Each call
+    appends one fixed width record with the timestep (``uint64``) and one
+    field per logged quantity, named by the quantity's namespace joined with
+    ``/``. Integer quantities are stored as ``int64`` and floating point
+    quantities as ``float64``. Sequence quantities are stored as fixed shape
+    arrays.
+
+    The first record fixes the names and shapes of the quantities. Changing
+    the quantities in the logger afterwards raises an error. The records are
+    buffered and written every *buffer_size* calls, and when the writer is
+    removed from the simulation. Call `flush` to write them sooner.
+
+    Read the file with `read`, which maps the records to a numpy structured
+    array::
+
+        data = hoomd.write.BinaryLog.read('log.bin')
+        pressure = data['md/compute/ThermodynamicQuantities/pressure']
+
+    Example::
+
+        logger = hoomd.logging.Logger(categories=['scalar'])
+        logger.add(thermo, quantities=['pressure', 'potential_energy'])
+        binary_log = hoomd.write.BinaryLog(trigger=hoomd.trigger.Periodic(5),
+                                           logger=logger,
+                                           filename='log.bin',
+                                           max_lag=100)
+        sim.operations.writers.append(binary_log)
+
+    File format:
+        The file begins with 8 bytes ``HOOMDLOG``, the little endian
+        ``uint32`` format version and header length, and a UTF-8 JSON header
+        describing the fields of the records (name, numpy type string, and
+        shape). The records follow, starting at an 8 byte aligned offset.
+
+    Note:
+        In MPI simulations, only rank 0 writes the file. Every rank
+        accumulates `mean` and `autocorrelation`.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to record the
+            logged quantities.
+        logger (hoomd.logging.Logger): The logger to query for output.
+        filename (str): File name to write.
+        mode (str): The file open mode.
+        buffer_size (int): Number of records to buffer before writing them to
+            the file.
+        max_lag (int): Maximum lag of the autocorrelation, or `None` when
+            the accumulator is disabled.
+    """
+    _internal_class = _BinaryLogInternal
+
+    @staticmethod
+    def read(filename):
+        """Read the records of a file.
+
+        Args:
+            filename (str): File to read.
+
+        Returns:
+            numpy.ndarray: A read only structured array (memory mapped from the
+            file) with one element per record.
+        """
+        with open(filename, 'rb') as fh:
+            dtype, offset = _read_header(fh)
+        num_records = (os.path.getsize(filename) - offset) // dtype.itemsize
+        if num_records == 0:
+            return numpy.empty(0, dtype=dtype)
+        return numpy.memmap(filename,
+                            dtype=dtype,
+                            mode='r',
+                            offset=offset,
+                            shape=(num_records,))
@@ -0,0 +1,170 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Write checkpoints for exact restarts."""
+
+import sys
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.operation import Writer
+import hoomd
+
+# Parameters of the MD integration methods that hold the thermostat and
+# barostat state.
+_method_state_params = ('translational_thermostat_dof',
+                        'rotational_thermostat_dof', 'barostat_dof')
+
+
+def _hpmc_integrator(integrator):
+    """Return the integrator when it is a HPMC integrator, otherwise None."""
+    # hoomd.hpmc is imported lazily, the integrator can only be a HPMC
+    # integrator when it has been imported
+    if ('hoomd.hpmc' in sys.modules
+            and isinstance(integrator, hoomd.hpmc.integrate.HPMCIntegrator)):
+        return integrator
+    return None
+
+
+class _CheckpointStateWriter:
+    """Collect the operation state for `Checkpoint`.
+
+    The C++ checkpoint writer calls `state` on the root rank each time it
+    writes a checkpoint.
+    """
+
+    def __init__(self, simulation):
+        self._simulation = simulation
+
+    def state(self):
+        """Get the operation state as a dict of lists of floats."""
+        state = dict()
+        integrator = self._simulation.operations.integrator
+        if integrator is None:
+            return state
+
+        hpmc = _hpmc_integrator(integrator)
+        if hpmc is not None:
+            for particle_type in self._simulation.state.particle_types:
+                state[f'hpmc/d/{particle_type}'] = [hpmc.d[particle_type]]
+                state[f'hpmc/a/{particle_type}'] = [hpmc.a[particle_type]]
+
+        for i, method in enumerate(getattr(integrator, 'methods', [])):
+            for param in _method_state_params:
+                if param in method._param_dict:
+                    state[f'md/methods/{i}/{param}'] = [
+                        float(v) for v in getattr(method, param)
+                    ]
+
+        return state
+
+
+class Checkpoint(Writer):
+    r"""Write checkpoints that restart the simulation exactly.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): Base file name of the checkpoint.
+
+    `Checkpoint` saves the complete simulation state each time it triggers, in
+    a form that `Simulation.create_state_from_checkpoint` restores without
+    loss. Each MPI rank writes the particles it owns to the file
+    ``f'{filename}.{rank}'`` in the precision of the simulation, without
+    communicating particle data. Rank 0 also writes the bonds, angles,
+    dihedrals, impropers, constraints, and pairs, the random number seed, and
+    the state of the operations:
+
+    * The HPMC move sizes ``d`` and ``a``.
+    * The thermostat and barostat degrees of freedom of the MD integration
+      methods.
+
+    Restart a simulation with `Simulation.create_state_from_checkpoint`, add
+    the same operations that were present when the checkpoint was written, and
+    call `restore_operations`:
+
+    .. code-block:: python
+
+        sim.create_state_from_checkpoint('checkpoint')
+        sim.operations.integrator = integrator
+        hoomd.write.Checkpoint.restore_operations(sim, 'checkpoint')
+
+    Each rank first writes its checkpoint to ``f'{filename}.{rank}.tmp'`` and
+    then replaces the previous checkpoint with it, so the checkpoint files are
+    complete even when the simulation ends during a write.
+
+    When the simulation restarts on the same number of MPI ranks, each rank
+    reads its own particles from its own file. On a different number of ranks,
+    rank 0 reads all files and distributes the particles to the new domains.
+
+    Note:
+        Neighbor lists and the ghost particles are not saved. They are rebuilt
+        on the first step after the restart.
+
+    Note:
+        Checkpoint files use the GSD container format with the schema
+        ``hoomd_checkpoint``. `Simulation.create_state_from_gsd` cannot read
+        them. Use `hoomd.write.GSD` to write trajectories for analysis.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): Base file name of the checkpoint.
+    """
+
+    def __init__(self, trigger, filename):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(filename=str(filename)))
+
+    def _attach(self):
+        # all ranks must write next to the file of rank 0
+        filename = _hoomd.mpi_bcast_str(self.filename,
+                                        self._simulation.device._cpp_exec_conf)
+        self._cpp_obj = _hoomd.CheckpointWriter(
+            self._simulation.state._cpp_sys_def, filename)
+        self._cpp_obj.state_writer = _CheckpointStateWriter(self._simulation)
+        super()._attach()
+
+    @property
+    def num_writes(self):
+        """int: Number of checkpoints written since the simulation started."""
+        if not self._attached:
+            return 0
+        return self._cpp_obj.num_writes
+
+    @staticmethod
+    def restore_operations(simulation, filename):
+        """Restore the operation state saved in a checkpoint.
+
+        Args:
+            simulation (Simulation): Simulation to restore. Its integrator and
+                integration methods must be the same as when the checkpoint
+                was written.
+            filename (str): Base file name of the checkpoint.
+
+        Restores the HPMC move sizes and the thermostat and barostat degrees
+        of freedom of the MD integration methods. Call `restore_operations`
+        after `Simulation.create_state_from_checkpoint` and after setting the
+        integrator.
+        """
+        device = simulation.device
+        filename = _hoomd.mpi_bcast_str(filename, device._cpp_exec_conf)
+        reader = _hoomd.CheckpointReader(device._cpp_exec_conf, filename)
+        state = reader.getOperationState()
+
+        integrator = simulation.operations.integrator
+        if integrator is None:
+            return
+
+        hpmc = _hpmc_integrator(integrator)
+        if hpmc is not None:
+            for particle_type in simulation.state.particle_types:
+                for param in ('d', 'a'):
+                    key = f'hpmc/{param}/{particle_type}'
+                    if key in state:
+                        getattr(hpmc, param)[particle_type] = state[key][0]
+
+        for i, method in enumerate(getattr(integrator, 'methods', [])):
+            for param in _method_state_params:
+                key = f'md/methods/{i}/{param}'
+                if key in state and param in method._param_dict:
+                    setattr(method, param, tuple(state[key]))
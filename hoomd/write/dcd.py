@@ -34,11 +34,20 @@ class DCD(Writer):
             *unwrap_full* is True.
         angle_z (bool): When True, the particle orientation angle is written to
             the z component (only useful for 2D simulations)
+        header_update_period (int): Number of frames between updates of the
+            number of frames in the file header. Defaults to 1.
 
     On each timestep where `DCD` triggers, it writes the simulation snapshot to
     the specified file in the DCD file format. DCD only stores particle
     positions, in distance units.
 
+    `DCD` gathers only the positions of the selected particles to the root rank
+    (or, with *unwrap_rigid*, the positions of all particles). The DCD file
+    header records the number of frames in the file. Set
+    *header_update_period* to update the header less often when writing many
+    small frames. `Simulation.run` calls `flush` before it returns, so the
+    header is up to date at the end of every run.
+
     Examples::
 
         writer = hoomd.write.DCD("trajectory.dcd", hoomd.trigger.Periodic(1000))
@@ -71,6 +80,8 @@ class DCD(Writer):
             *unwrap_full* is True.
         angle_z (bool): When True, the particle orientation angle is written to
             the z component
+        header_update_period (int): Number of frames between updates of the
+            number of frames in the file header.
     """
 
     def __init__(self,
@@ -80,7 +91,8 @@ class DCD(Writer):
                  overwrite=False,
                  unwrap_full=False,
                  unwrap_rigid=False,
-                 angle_z=False):
+                 angle_z=False,
+                 header_update_period=1):
 
         # initialize base class
         super().__init__(trigger)
@@ -90,7 +102,8 @@ class DCD(Writer):
                           overwrite=bool(overwrite),
                           unwrap_full=bool(unwrap_full),
                           unwrap_rigid=bool(unwrap_rigid),
-                          angle_z=bool(angle_z)))
+                          angle_z=bool(angle_z),
+                          header_update_period=int(header_update_period)))
         self.filter = filter
 
     def _attach(self):
@@ -99,3 +112,12 @@ class DCD(Writer):
             self._simulation.state._cpp_sys_def, self.filename,
             int(self.trigger.period), group, self.overwrite)
         super()._attach()
+
+    def flush(self):
+        """Update the number of frames in the file header.
+
+        Only has an effect when ``header_update_period`` is greater than 1.
+        `Simulation.run` calls `flush` before it returns.
+        """
+        if self._attached:
+            self._cpp_obj.flush()
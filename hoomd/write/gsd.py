@@ -6,7 +6,7 @@
 from collections.abc import Mapping, Collection
 from hoomd import _hoomd
 from hoomd.util import dict_flatten
-from hoomd.data.typeconverter import OnlyFrom, RequiredArg
+from hoomd.data.typeconverter import OnlyFrom, OnlyTypes, RequiredArg
 from hoomd.filter import ParticleFilter, All
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.logging import Logger, LoggerCategories
@@ -42,6 +42,22 @@ class GSD(Writer):
             Defaults to ``['property']``.
         log (hoomd.logging.Logger): Provide log quantities to write. Defaults to
             `None`.
+        asynchronous (bool): When `True`, write frames in a background thread.
+            Defaults to `False`.
+        max_queue_depth (int): Maximum number of frames waiting to be written
+            in asynchronous mode. Defaults to 2.
+        shard (bool): When `True`, each MPI rank writes the particles it owns
+            to its own file. Defaults to `False`.
+        incremental (bool): When `True`, omit dynamic quantities that are
+            unchanged since frame 0. Defaults to `False`.
+        compress (bool): When `True`, compress the particle quantities.
+            Defaults to `False`.
+        position_precision (float): Store positions rounded to a multiple of
+            this value when ``compress`` is `True`
+            :math:`[\mathrm{length}]`. Defaults to `None` (lossless).
+        velocity_precision (float): Store velocities rounded to a multiple of
+            this value when ``compress`` is `True`
+            :math:`[\mathrm{velocity}]`. Defaults to `None` (lossless).
 
     `GSD` writes a simulation snapshot to the specified file each time it
     triggers. `GSD` can store all particle, bond, angle, dihedral, improper,
@@ -123,6 +139,45 @@ class GSD(Writer):
         will write out all of the selected particles in ascending tag order and
         will **not** write out **topology**.
 
+    When ``asynchronous`` is `True`, `GSD` copies each frame to a buffer and
+    returns to the simulation while a background thread writes the buffer to
+    the file. When ``max_queue_depth`` frames are waiting to be written,
+    `GSD` waits for the oldest to finish before copying the next.
+    `Simulation.run` calls `flush` before it returns, so the file contains all
+    frames at the end of every run.
+
+    When ``incremental`` is `True`, `GSD` omits particle quantities from
+    frames after frame 0 when they are identical to the values in frame 0, and
+    omits the **topology** when no bonds, angles, dihedrals, impropers,
+    constraints, or pairs have been added or removed since frame 0. Readers
+    use the data in frame 0 for the omitted quantities, so the trajectory
+    contains the same values in a smaller file. `GSD` keeps a copy of the
+    particle quantities in frame 0 in memory to compare against. ``incremental``
+    has no effect when ``truncate`` or ``shard`` is `True`.
+
+    By default, `GSD` gathers the selected particles to the root rank, which
+    writes the file. When ``shard`` is `True`, each rank writes the particles it
+    owns to the file ``f'{filename}.{rank}'`` without communicating particle
+    data. Each frame of a shard contains the chunk ``particles/tag`` with the
+    tags of its particles and all **attribute**, **property**, and
+    **momentum** quantities. The shard of rank 0 also contains the topology,
+    logged quantities, and operation-specific state. Use `merge_shards` to
+    combine the shards into a single file.
+
+    When ``compress`` is `True`, `GSD` compresses each particle quantity
+    (except ``particles/N`` and ``particles/types``) with LZ4 and stores it in
+    the chunk ``compressed/{name}`` instead of ``{name}``. Integer quantities
+    are stored losslessly. When ``position_precision`` (or
+    ``velocity_precision``) is set, `GSD` rounds each position (velocity)
+    component to the nearest multiple of the precision before compressing, so
+    the stored values differ from the simulation by at most half the precision.
+    Quantities that do not compress, or that are too large to round to the
+    given precision, are stored uncompressed. In asynchronous mode the
+    background thread compresses the frames. `Simulation.create_state_from_gsd`
+    and `hoomd.write.GSD` in ``'ab'`` mode read compressed files, the ``gsd``
+    Python package and other GSD readers do not. ``compress`` cannot be
+    combined with ``shard``.
+
     Tip:
         All logged data chunks must be present in the first frame in the gsd
         file to provide the default value. To achieve this, set the `log`
@@ -141,6 +196,20 @@ class GSD(Writer):
         truncate (bool): When `True`, truncate the file and write a new frame 0
             each time this operation triggers.
         dynamic (list[str]): Quantity categories to save in every frame.
+        asynchronous (bool): When `True`, write frames in a background thread.
+        max_queue_depth (int): Maximum number of frames waiting to be written
+            in asynchronous mode.
+        shard (bool): When `True`, each MPI rank writes the particles it owns
+            to its own file.
+        incremental (bool): When `True`, omit dynamic quantities that are
+            unchanged since frame 0.
+        compress (bool): When `True`, compress the particle quantities.
+        position_precision (float): Store positions rounded to a multiple of
+            this value when ``compress`` is `True`
+            :math:`[\mathrm{length}]`.
+        velocity_precision (float): Store velocities rounded to a multiple of
+            this value when ``compress`` is `True`
+            :math:`[\mathrm{velocity}]`.
     """
 
     def __init__(self,
@@ -150,10 +219,20 @@ class GSD(Writer):
                  mode='ab',
                  truncate=False,
                  dynamic=None,
-                 log=None):
+                 log=None,
+                 asynchronous=False,
+                 max_queue_depth=2,
+                 shard=False,
+                 incremental=False,
+                 compress=False,
+                 position_precision=None,
+                 velocity_precision=None):
 
         super().__init__(trigger)
 
+        if shard and compress:
+            raise ValueError("GSD: compress cannot be combined with shard.")
+
         dynamic_validation = OnlyFrom(
             ['attribute', 'property', 'momentum', 'topology'],
             preprocess=_array_to_strings)
@@ -165,8 +244,26 @@ class GSD(Writer):
                           mode=str(mode),
                           truncate=bool(truncate),
                           dynamic=[dynamic_validation],
+                          asynchronous=bool(asynchronous),
+                          max_queue_depth=int(max_queue_depth),
+                          shard=bool(shard),
+                          incremental=bool(incremental),
                           _defaults=dict(filter=filter, dynamic=dynamic)))
 
+        param_dict = ParameterDict(
+            compress=bool,
+            position_precision=OnlyTypes(float,
+                                         allow_none=True,
+                                         postprocess=self._positive),
+            velocity_precision=OnlyTypes(float,
+                                         allow_none=True,
+                                         postprocess=self._positive))
+        param_dict.update(
+            dict(compress=compress,
+                 position_precision=position_precision,
+                 velocity_precision=velocity_precision))
+        self._param_dict.update(param_dict)
+
         self._log = None if log is None else _GSDLogWriter(log)
 
     def _attach(self):
@@ -185,7 +282,7 @@ class GSD(Writer):
         self._cpp_obj = _hoomd.GSDDumpWriter(
             self._simulation.state._cpp_sys_def, self.filename,
             self._simulation.state._get_group(self.filter), self.mode,
-            self.truncate)
+            self.truncate, self.shard)
 
         self._cpp_obj.setWriteAttribute('attribute' in dynamic_quantities)
         self._cpp_obj.setWriteProperty('property' in dynamic_quantities)
@@ -194,6 +291,21 @@ class GSD(Writer):
         self._cpp_obj.log_writer = self.log
         super()._attach()
 
+    @staticmethod
+    def _positive(value):
+        if value <= 0:
+            raise ValueError(f"Expected a positive precision, got {value}.")
+        return value
+
+    def flush(self):
+        """Wait until all frames are written to the file.
+
+        Only has an effect when ``asynchronous`` is `True`. `Simulation.run`
+        calls `flush` before it returns.
+        """
+        if self._attached:
+            self._cpp_obj.flush()
+
     @staticmethod
     def write(state, filename, filter=All(), mode='wb', log=None):
         """Write the given simulation state out to a GSD file.
@@ -212,12 +324,55 @@ class GSD(Writer):
             raise ValueError(f"Invalid GSD.write file mode: {mode}")
 
         writer = _hoomd.GSDDumpWriter(state._cpp_sys_def, filename,
-                                      state._get_group(filter), mode, False)
+                                      state._get_group(filter), mode, False,
+                                      False)
 
         if log is not None:
             writer.log_writer = _GSDLogWriter(log)
         writer.analyze(state._simulation.timestep)
 
+    @staticmethod
+    def merge_shards(filename, num_shards, output):
+        """Combine the shards written with ``shard=True`` into one file.
+
+        Args:
+            filename (str): File name given to `GSD`.
+            num_shards (int): Number of shards (the number of MPI ranks that
+                wrote them).
+            output (str): File name to write.
+
+        `merge_shards` writes the particles of each frame in ascending tag
+        order, as `GSD` does when ``shard`` is `False`. Call `merge_shards`
+        from a single process after the simulation completes. It requires the
+        ``gsd`` Python package.
+        """
+        import gsd.fl
+
+        shards = [
+            gsd.fl.open(name=f'{filename}.{rank}', mode='rb')
+            for rank in range(num_shards)
+        ]
+        names = set()
+        for shard in shards:
+            names.update(shard.find_matching_chunk_names(''))
+        particle_names = sorted(
+            name for name in names if name.startswith('particles/')
+            and name not in ('particles/N', 'particles/types', 'particles/tag'))
+
+        root = shards[0]
+        try:
+            with gsd.fl.open(name=str(output),
+                             mode='wb',
+                             application=root.application,
+                             schema=root.schema,
+                             schema_version=root.schema_version) as f:
+                for frame in range(root.nframes):
+                    _merge_shard_frame(f, shards, frame, names,
+                                       particle_names)
+        finally:
+            for shard in shards:
+                shard.close()
+
     @property
     def log(self):
         """hoomd.logging.Logger: Provide log quantities to write.
@@ -237,6 +392,62 @@ class GSD(Writer):
         self._log = log
 
 
+# Values of the particle chunks that shards omit when all particles have them
+_particle_chunk_defaults = {
+    'particles/typeid': 0,
+    'particles/mass': 1,
+    'particles/charge': 0,
+    'particles/diameter': 1,
+    'particles/body': -1,
+    'particles/moment_inertia': 0,
+    'particles/orientation': [1, 0, 0, 0],
+    'particles/velocity': 0,
+    'particles/angmom': 0,
+    'particles/image': 0,
+}
+
+
+def _merge_shard_frame(f, shards, frame, names, particle_names):
+    """Write one frame of a sharded trajectory to the open file ``f``."""
+    tags = []
+    for shard in shards:
+        if shard.chunk_exists(frame, 'particles/tag'):
+            tags.append(shard.read_chunk(frame, 'particles/tag'))
+        else:
+            tags.append(np.zeros(0, dtype=np.uint32))
+    order = np.argsort(np.concatenate(tags), kind='stable')
+
+    # shard 0 holds the chunks that are not per particle
+    root = shards[0]
+    for name in sorted(names):
+        if (not name.startswith('particles/') or name == 'particles/types') \
+                and root.chunk_exists(frame, name):
+            f.write_chunk(name, root.read_chunk(frame, name))
+    f.write_chunk('particles/N', np.array([len(order)], dtype=np.uint32))
+
+    for name in particle_names:
+        found = [shard.read_chunk(frame, name)
+                 for shard in shards
+                 if shard.chunk_exists(frame, name)]
+        if len(found) == 0:
+            continue
+
+        # fill in shards that omitted the chunk because all values are default
+        arrays = []
+        for shard, shard_tags in zip(shards, tags):
+            if shard.chunk_exists(frame, name):
+                arrays.append(shard.read_chunk(frame, name))
+            else:
+                shape = (len(shard_tags),) + found[0].shape[1:]
+                arrays.append(
+                    np.full(shape,
+                            _particle_chunk_defaults.get(name, 0),
+                            dtype=found[0].dtype))
+        f.write_chunk(name, np.concatenate(arrays)[order])
+
+    f.end_frame()
+
+
 def _iterable_is_incomplete(iterable):
     """Checks that any nested attribute has no instances of RequiredArg.
 
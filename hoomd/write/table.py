@@ -6,16 +6,14 @@
 
 from abc import ABCMeta, abstractmethod
 import copy
-from numbers import Integral
-from math import log10
 from sys import stdout
 
+from hoomd import _hoomd
 from hoomd.write.custom_writer import _InternalCustomWriter
 from hoomd.custom.custom_action import _InternalAction
 from hoomd.logging import LoggerCategories, Logger
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyTypes
-from hoomd.util import dict_flatten
 from hoomd.custom import Action
 
 
@@ -52,115 +50,13 @@ def _ensure_writable(fh):
     return fh
 
 
-class _Formatter:
-    """Internal class for number and string formatting for Table object.
-
-    Main method is ``__call__``. It takes a value with the corresponding column
-    width and outputs the string to use for that column. Some of these
-    parameters are not currently used in the _InternalTable class, but are
-    available in the _Formatter class, meaning that adding these features later
-    would be fairly simple. I (Brandon Butler) did not think they were worth
-    complicating the Table Logger any more than it currently is though, so they
-    are not used now.
-
-    Args:
-        pretty (bool): whether to attempt to make output pretty (more readable).
-        max_precision (int): The max length for formatting a number or string.
-        max_decimals_pretty (int): The maximum number of decimals. This is
-            required to ensure that the decimals don't eat up all space in a
-            pretty print.
-        pad (str, optional): What to pad extra column space with, defaults to
-            space.
-        align (str, optional): What type of alignment to use, defaults to
-            centered ('^').
-    """
-
-    def __init__(self,
-                 pretty=True,
-                 max_precision=15,
-                 max_decimals_pretty=5,
-                 pad=" ",
-                 align="^"):
-        self.generate_fmt_strings(pad, align)
-        self.pretty = pretty
-        self.precision = max_precision - 1
-        self.max_decimals_pretty = max_decimals_pretty
-
-    def generate_fmt_strings(self, pad, align):
-        base = "{:" + pad + align
-        self._num_format = base + "{width}{type}}"
-        self._str_format = base + "{width}}"
-
-    def __call__(self, value, column_width):
-        if isinstance(value, str):
-            return self.format_str(value, column_width)
-        else:
-            return self.format_num(value, column_width)
-
-    def format_num(self, value, column_width):
-        # Always output full integer values
-        if isinstance(value, Integral):
-            return self._num_format.format(value, width=column_width, type="d")
-        # For floating point numbers
-        else:
-            # The minimum length representation if greater than one than the
-            # smallest representation is to write the number without any
-            # infomration past the decimal point. For values less than 1 the
-            # smallest is 0.xxx. The plus one is for the decimal point. We
-            # already attempt to print out as many decimal points as possible so
-            # we only need to determine the minumum size to the left of the
-            # decimal point including the decimal point.
-            min_len_repr = int(log10(max(abs(value), 1))) + 1
-            if value < 0:
-                min_len_repr += 1  # add 1 for the negative sign
-            # Use scientific formatting
-            if not min_len_repr < 6 or min_len_repr > column_width:
-                # Determine the number of decimals to use
-                if self.pretty:
-                    decimals = min(max(column_width - 6, 1),
-                                   self.max_decimals_pretty)
-                else:
-                    decimals = max(self.precision, 0)
-                type_fmt = "." + str(decimals) + "e"
-            # Use regular formatting
-            else:
-                # Determine the number of decimals to use
-                if self.pretty:
-                    decimals = min(max(column_width - min_len_repr - 2, 1),
-                                   self.max_decimals_pretty)
-                else:
-                    decimals = max(self.precision - min_len_repr + 1, 0)
-                type_fmt = "." + str(decimals) + "f"
-
-            return self._num_format.format(value,
-                                           width=column_width,
-                                           type=type_fmt)
-
-    def format_str(self, value, column_width):
-        if self.pretty and len(value) > column_width:
-            truncate_to = max(1, column_width - 2)
-            return self._str_format.format(value[-truncate_to:],
-                                           width=column_width)
-        else:
-            return self._str_format.format(value, width=column_width)
-
-    def __eq__(self, other):
-        if not isinstance(other, _Formatter):
-            return NotImplemented
-        return (self.pretty == other.pretty
-                and self.precision == other.precision
-                and self.max_decimals_pretty == other.max_decimals_pretty
-                and self._num_format == other._num_format
-                and self._str_format == other._str_format)
-
-
 class _TableInternal(_InternalAction):
     """Implements the logic for a simple text based logger backend.
 
-    This currently has to check the logged quantities every time to ensure it
-    has not changed since the last run of `~.act`. Performance could be
-    improved by allowing for writing of data without checking for a change in
-    logged quantities, but would be more fragile.
+    The logger caches its flattened entries until quantities are added or
+    removed, so `~.act` only regenerates the headers when that list changes.
+    The values of a row are formatted in one call to the C++
+    ``TableFormatter``.
     """
 
     _invalid_logger_categories = LoggerCategories.any([
@@ -170,10 +66,10 @@ class _TableInternal(_InternalAction):
 
     flags = [
         Action.Flags.ROTATIONAL_KINETIC_ENERGY, Action.Flags.PRESSURE_TENSOR,
-        Action.Flags.EXTERNAL_FIELD_VIRIAL
+        Action.Flags.EXTERNAL_FIELD_VIRIAL, Action.Flags.FORCE_ARRAYS
     ]
 
-    _skip_for_equality = {"_comm"}
+    _skip_for_equality = {"_comm", "_entries"}
 
     def __init__(self,
                  logger,
@@ -217,7 +113,9 @@ class _TableInternal(_InternalAction):
                 "Given Logger must have the scalar categories set.")
 
         self._cur_headers_with_width = dict()
-        self._fmt = _Formatter(pretty, max_precision)
+        self._fmt = _hoomd.TableFormatter(pretty, max_precision)
+        self._entries = None
+        self._widths = []
         self._comm = None
 
     def _setattr_param(self, attr, value):
@@ -230,13 +128,6 @@ class _TableInternal(_InternalAction):
     def detach(self):
         self._comm = None
 
-    def _get_log_dict(self):
-        """Get a flattened dict for writing to output."""
-        return {
-            key: value[0]
-            for key, value in dict_flatten(self.logger.log()).items()
-        }
-
     def _update_headers(self, new_keys):
         """Update headers and write the current headers to output.
 
@@ -255,10 +146,9 @@ class _TableInternal(_InternalAction):
             header_dict[namespace] = column_size
             header_output_list.append((header, column_size))
         self._cur_headers_with_width = header_dict
-        self.output.write(
-            self.delimiter.join((self._fmt.format_str(hdr, width)
-                                 for hdr, width in header_output_list)))
-        self.output.write('\n')
+        self._widths = list(header_dict.values())
+        self._fmt.appendHeader([hdr for hdr, _ in header_output_list],
+                               self._widths, self.delimiter)
 
     @staticmethod
     def _determine_header(namespace, sep, max_len):
@@ -274,37 +164,36 @@ class _TableInternal(_InternalAction):
                 index -= 1
             return sep.join(namespace[index:])
 
-    def _write_row(self, data):
-        """Write a row of data to output."""
-        headers = self._cur_headers_with_width
-        self.output.write(
-            self.delimiter.join(
-                (self._fmt(data[k], headers[k]) for k in headers)))
-        self.output.write('\n')
-
     def act(self, timestep=None):
         """Write row to designated output.
 
         Will also write header when logged quantities are determined to have
         changed.
         """
-        output_dict = self._get_log_dict()
+        # All ranks evaluate the quantities, which may reduce over MPI ranks.
+        entries = self.logger._entries()
+        values = [entry()[0] for _, entry in entries]
         if self._comm is not None and self._comm.rank == 0:
             # determine if a header needs to be written. This is always the case
             # for the first call of act, and if the logged quantities change
             # within a run.
-            new_keys = output_dict.keys()
-            if new_keys != self._cur_headers_with_width.keys():
-                self._update_headers(new_keys)
+            if entries is not self._entries:
+                self._entries = entries
+                new_keys = [namespace for namespace, _ in entries]
+                if new_keys != list(self._cur_headers_with_width.keys()):
+                    self._update_headers(new_keys)
 
             # Write the data and flush. We must flush to ensure that the data
             # isn't merely stored in Python ready to be written later.
-            self._write_row(output_dict)
+            self._fmt.appendRow(values, self._widths, self.delimiter)
+            self.output.write(self._fmt.takeOutput())
             self.output.flush()
 
     def __getstate__(self):
         state = copy.copy(self.__dict__)
         state.pop('_comm', None)
+        # the cached entries belong to the logger
+        state['_entries'] = None
         # This is to handle when the output specified is just stdout. By default
         # file objects like this are not picklable, so we need to handle it
         # differently. We let `None` represent stdout in the state dictionary.